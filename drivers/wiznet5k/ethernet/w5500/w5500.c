@@ -166,18 +166,45 @@ void     WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, uint16_t len)
 }
 
 
+// 16-bit registers are big-endian and the address increments within a frame,
+// so both bytes are read or written in one SPI frame rather than two.
+uint16_t WIZCHIP_READ16(uint32_t AddrSel)
+{
+   uint8_t buf[2];
+   WIZCHIP_READ_BUF(AddrSel, buf, 2);
+   return ((uint16_t)buf[0] << 8) | buf[1];
+}
+
+void     WIZCHIP_WRITE16(uint32_t AddrSel, uint16_t wb)
+{
+   uint8_t spi_data[5];
+
+   WIZCHIP_CRITICAL_ENTER();
+   WIZCHIP.CS._select();
+
+   AddrSel |= (_W5500_SPI_WRITE_ | _W5500_SPI_VDM_OP_);
+
+   spi_data[0] = (AddrSel & 0x00FF0000) >> 16;
+   spi_data[1] = (AddrSel & 0x0000FF00) >> 8;
+   spi_data[2] = (AddrSel & 0x000000FF) >> 0;
+   spi_data[3] = wb >> 8;
+   spi_data[4] = wb;
+   Chip_SSP_WriteFrames_Blocking(LPC_SSP0, spi_data, 5);
+
+   WIZCHIP.CS._deselect();
+   WIZCHIP_CRITICAL_EXIT();
+}
+
 uint16_t getSn_TX_FSR(uint8_t sn)
 {
    uint16_t val=0,val1=0;
 
    do
    {
-      val1 = WIZCHIP_READ(Sn_TX_FSR(sn));
-      val1 = (val1 << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_TX_FSR(sn),1));
+      val1 = WIZCHIP_READ16(Sn_TX_FSR(sn));
       if (val1 != 0)
       {
-        val = WIZCHIP_READ(Sn_TX_FSR(sn));
-        val = (val << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_TX_FSR(sn),1));
+        val = WIZCHIP_READ16(Sn_TX_FSR(sn));
       }
    }while (val != val1);
    return val;
@@ -190,12 +217,10 @@ uint16_t getSn_RX_RSR(uint8_t sn)
 
    do
    {
-      val1 = WIZCHIP_READ(Sn_RX_RSR(sn));
-      val1 = (val1 << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_RX_RSR(sn),1));
+      val1 = WIZCHIP_READ16(Sn_RX_RSR(sn));
       if (val1 != 0)
       {
-        val = WIZCHIP_READ(Sn_RX_RSR(sn));
-        val = (val << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_RX_RSR(sn),1));
+        val = WIZCHIP_READ16(Sn_RX_RSR(sn));
       }
    }while (val != val1);
    return val;
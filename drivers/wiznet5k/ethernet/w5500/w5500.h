@@ -1219,6 +1219,22 @@ void     WIZCHIP_READ_BUF (uint32_t AddrSel, uint8_t* pBuf, uint16_t len);
  */
 void     WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, uint16_t len);
 
+/**
+ * @ingroup Basic_IO_function
+ * @brief It reads a 16-bit register from WIZCHIP in one SPI frame.
+ * @param AddrSel Address of the register's high byte.
+ * @return The value of the register.
+ */
+uint16_t WIZCHIP_READ16(uint32_t AddrSel);
+
+/**
+ * @ingroup Basic_IO_function
+ * @brief It writes a 16-bit register of WIZCHIP in one SPI frame.
+ * @param AddrSel Address of the register's high byte.
+ * @param wb Value to write.
+ */
+void     WIZCHIP_WRITE16(uint32_t AddrSel, uint16_t wb);
+
 /////////////////////////////////
 // Common Register I/O function //
 /////////////////////////////////
@@ -1881,7 +1897,7 @@ uint16_t getSn_TX_FSR(uint8_t sn);
  * @return uint16_t. Value of @ref Sn_TX_RD.
  */
 #define getSn_TX_RD(sn) \
-		((WIZCHIP_READ(Sn_TX_RD(sn)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_TX_RD(sn),1)))
+		WIZCHIP_READ16(Sn_TX_RD(sn))
 
 /**
  * @ingroup Socket_register_access_function
@@ -1890,10 +1906,8 @@ uint16_t getSn_TX_FSR(uint8_t sn);
  * @param (uint16_t)txwr Value to set @ref Sn_TX_WR
  * @sa GetSn_TX_WR()
  */
-#define setSn_TX_WR(sn, txwr) { \
-		WIZCHIP_WRITE(Sn_TX_WR(sn),   (uint8_t)(txwr>>8)); \
-		WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(Sn_TX_WR(sn),1), (uint8_t) txwr); \
-		}
+#define setSn_TX_WR(sn, txwr) \
+		WIZCHIP_WRITE16(Sn_TX_WR(sn), txwr)
 
 /**
  * @ingroup Socket_register_access_function
@@ -1903,7 +1917,7 @@ uint16_t getSn_TX_FSR(uint8_t sn);
  * @sa setSn_TX_WR()
  */
 #define getSn_TX_WR(sn) \
-		((WIZCHIP_READ(Sn_TX_WR(sn)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_TX_WR(sn),1)))
+		WIZCHIP_READ16(Sn_TX_WR(sn))
 
 
 /**
@@ -1922,10 +1936,8 @@ uint16_t getSn_RX_RSR(uint8_t sn);
  * @param (uint16_t)rxrd Value to set @ref Sn_RX_RD
  * @sa getSn_RX_RD()
  */
-#define setSn_RX_RD(sn, rxrd) { \
-		WIZCHIP_WRITE(Sn_RX_RD(sn),   (uint8_t)(rxrd>>8)); \
-		WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(Sn_RX_RD(sn),1), (uint8_t) rxrd); \
-	}
+#define setSn_RX_RD(sn, rxrd) \
+		WIZCHIP_WRITE16(Sn_RX_RD(sn), rxrd)
 
 /**
  * @ingroup Socket_register_access_function
@@ -1935,7 +1947,7 @@ uint16_t getSn_RX_RSR(uint8_t sn);
  * @sa setSn_RX_RD()
  */
 #define getSn_RX_RD(sn) \
-		((WIZCHIP_READ(Sn_RX_RD(sn)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_RX_RD(sn),1)))
+		WIZCHIP_READ16(Sn_RX_RD(sn))
 
 /**
  * @ingroup Socket_register_access_function
@@ -1944,7 +1956,7 @@ uint16_t getSn_RX_RSR(uint8_t sn);
  * @return uint16_t. Value of @ref Sn_RX_WR.
  */
 #define getSn_RX_WR(sn) \
-		((WIZCHIP_READ(Sn_RX_WR(sn)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(Sn_RX_WR(sn),1)))
+		WIZCHIP_READ16(Sn_RX_WR(sn))
 
 
 /**
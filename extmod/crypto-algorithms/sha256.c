@@ -14,6 +14,7 @@
 
 /*************************** HEADER FILES ***************************/
 #include <stdlib.h>
+#include <string.h>
 #include "sha256.h"
 
 /****************************** MACROS ******************************/
@@ -97,17 +98,30 @@ void sha256_init(CRYAL_SHA256_CTX *ctx)
 
 void sha256_update(CRYAL_SHA256_CTX *ctx, const BYTE data[], size_t len)
 {
-	WORD i;
-
-	for (i = 0; i < len; ++i) {
-		ctx->data[ctx->datalen] = data[i];
-		ctx->datalen++;
-		if (ctx->datalen == 64) {
-			sha256_transform(ctx, ctx->data);
-			ctx->bitlen += 512;
-			ctx->datalen = 0;
-		}
+	size_t n;
+
+	// Top up a partly filled block first, then hash whole blocks straight
+	// from the input rather than copying them in a byte at a time.
+	if (ctx->datalen > 0) {
+		n = 64 - ctx->datalen;
+		if (n > len)
+			n = len;
+		memcpy(ctx->data + ctx->datalen, data, n);
+		ctx->datalen += n;
+		data += n;
+		len -= n;
+		if (ctx->datalen < 64)
+			return;
+		sha256_transform(ctx, ctx->data);
+		ctx->bitlen += 512;
+		ctx->datalen = 0;
+	}
+	for (; len >= 64; data += 64, len -= 64) {
+		sha256_transform(ctx, data);
+		ctx->bitlen += 512;
 	}
+	memcpy(ctx->data, data, len);
+	ctx->datalen = len;
 }
 
 void sha256_final(CRYAL_SHA256_CTX *ctx, BYTE hash[])
@@ -29,6 +29,7 @@
 #include <errno.h> // for declaration of global errno variable
 #include <fcntl.h>
 
+#include "py/gc.h"
 #include "py/runtime.h"
 #include "py/stream.h"
 
@@ -63,6 +64,38 @@ void __dbpanic(DB *db) {
     printf("__dbpanic(%p)\n", db);
 }
 
+#if MICROPY_BTREE_GC_MALLOC
+// Berkeley DB's allocations for ports without a C heap. They are reachable from the btree
+// object's DB pointer, so they live as long as it does.
+void *btree_malloc(size_t size) {
+    void *p = gc_alloc(size, false, true);
+    if (p == NULL) {
+        errno = ENOMEM;
+    }
+    return p;
+}
+
+void *btree_calloc(size_t nmemb, size_t size) {
+    void *p = btree_malloc(nmemb * size);
+    if (p != NULL) {
+        memset(p, 0, nmemb * size);
+    }
+    return p;
+}
+
+void *btree_realloc(void *ptr, size_t size) {
+    void *p = gc_realloc(ptr, size, true);
+    if (p == NULL) {
+        errno = ENOMEM;
+    }
+    return p;
+}
+
+void btree_free(void *ptr) {
+    gc_free(ptr);
+}
+#endif
+
 STATIC mp_obj_btree_t *btree_new(DB *db) {
     mp_obj_btree_t *o = m_new_obj(mp_obj_btree_t);
     o->base.type = &btree_type;
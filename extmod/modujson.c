@@ -25,9 +25,9 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/objlist.h"
-#include "py/objstringio.h"
 #include "py/parsenum.h"
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -36,10 +36,43 @@
 
 #if MICROPY_PY_UJSON
 
+// dump() collects output in a fixed-size buffer and writes it to the stream a
+// block at a time, rather than making a write call for every token.
+typedef struct _ujson_dump_buf_t {
+    mp_obj_t stream_obj;
+    size_t len;
+    char buf[128];
+} ujson_dump_buf_t;
+
+STATIC void ujson_dump_flush(ujson_dump_buf_t *b) {
+    if (b->len > 0) {
+        mp_stream_write(b->stream_obj, b->buf, b->len, MP_STREAM_RW_WRITE);
+        b->len = 0;
+    }
+}
+
+STATIC void ujson_dump_strn(void *data, const char *str, size_t len) {
+    ujson_dump_buf_t *b = data;
+    if (b->len + len > sizeof(b->buf)) {
+        ujson_dump_flush(b);
+        if (len > sizeof(b->buf)) {
+            // too big to be worth copying
+            mp_stream_write(b->stream_obj, str, len, MP_STREAM_RW_WRITE);
+            return;
+        }
+    }
+    memcpy(b->buf + b->len, str, len);
+    b->len += len;
+}
+
 STATIC mp_obj_t mod_ujson_dump(mp_obj_t obj, mp_obj_t stream) {
     mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
-    mp_print_t print = {MP_OBJ_TO_PTR(stream), mp_stream_write_adaptor};
+    ujson_dump_buf_t b;
+    b.stream_obj = stream;
+    b.len = 0;
+    mp_print_t print = {&b, ujson_dump_strn};
     mp_obj_print_helper(&print, obj, PRINT_JSON);
+    ujson_dump_flush(&b);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_ujson_dump_obj, mod_ujson_dump);
@@ -71,27 +104,200 @@ typedef struct _ujson_stream_t {
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     int errcode;
     byte cur;
+    // Unread input.  A stream is read a block at a time into buf, so there is
+    // one read call per block rather than per byte.  For loads() these point
+    // straight at the string and read is NULL.
+    const byte *pos;
+    const byte *end;
+    byte buf[64];
 } ujson_stream_t;
 
 #define S_EOF (0) // null is not allowed in json stream so is ok as EOF marker
-#define S_END(s) ((s).cur == S_EOF)
-#define S_CUR(s) ((s).cur)
-#define S_NEXT(s) (ujson_stream_next(&(s)))
+#define S_END(s) ((s)->cur == S_EOF)
+#define S_CUR(s) ((s)->cur)
+#define S_NEXT(s) (ujson_stream_next(s))
 
 STATIC byte ujson_stream_next(ujson_stream_t *s) {
-    mp_uint_t ret = s->read(s->stream_obj, &s->cur, 1, &s->errcode);
-    if (s->errcode != 0) {
-        mp_raise_OSError(s->errcode);
-    }
-    if (ret == 0) {
-        s->cur = S_EOF;
+    if (s->pos == s->end) {
+        if (s->read == NULL) {
+            s->cur = S_EOF;
+            return s->cur;
+        }
+        mp_uint_t ret = s->read(s->stream_obj, s->buf, sizeof(s->buf), &s->errcode);
+        if (s->errcode != 0) {
+            mp_raise_OSError(s->errcode);
+        }
+        if (ret == 0) {
+            s->cur = S_EOF;
+            return s->cur;
+        }
+        s->pos = s->buf;
+        s->end = s->buf + ret;
     }
+    s->cur = *s->pos++;
     return s->cur;
 }
 
-STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
-    const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
-    ujson_stream_t s = {stream_obj, stream_p->read, 0, 0};
+STATIC NORETURN void ujson_fail(void) {
+    mp_raise_ValueError(translate("syntax error in JSON"));
+}
+
+// Commas and colons are treated as whitespace.
+STATIC bool ujson_is_sep(byte c) {
+    return c == ',' || c == ':' || unichar_isspace(c);
+}
+
+STATIC void ujson_skip_sep(ujson_stream_t *s) {
+    while (ujson_is_sep(S_CUR(s))) {
+        S_NEXT(s);
+    }
+}
+
+// Decode a string, whose opening quote has been consumed, into vstr.
+STATIC void ujson_parse_str(ujson_stream_t *s, vstr_t *vstr) {
+    vstr_reset(vstr);
+    for (; !S_END(s) && S_CUR(s) != '"';) {
+        byte c = S_CUR(s);
+        if (c == '\\') {
+            c = S_NEXT(s);
+            switch (c) {
+                case 'b': c = 0x08; break;
+                case 'f': c = 0x0c; break;
+                case 'n': c = 0x0a; break;
+                case 'r': c = 0x0d; break;
+                case 't': c = 0x09; break;
+                case 'u': {
+                    mp_uint_t num = 0;
+                    for (int i = 0; i < 4; i++) {
+                        c = (S_NEXT(s) | 0x20) - '0';
+                        if (c > 9) {
+                            c -= ('a' - ('9' + 1));
+                        }
+                        num = (num << 4) | c;
+                    }
+                    vstr_add_char(vstr, num);
+                    goto str_cont;
+                }
+            }
+        }
+        vstr_add_byte(vstr, c);
+    str_cont:
+        S_NEXT(s);
+    }
+    if (S_END(s)) {
+        ujson_fail();
+    }
+    S_NEXT(s);
+}
+
+// Consume one value, however deeply nested, without creating any objects.
+STATIC void ujson_skip_value(ujson_stream_t *s) {
+    size_t depth = 0;
+    do {
+        byte c = S_CUR(s);
+        switch (c) {
+            case S_EOF:
+                ujson_fail();
+            case '"':
+                while (S_NEXT(s) != '"') {
+                    if (S_CUR(s) == '\\') {
+                        S_NEXT(s);
+                    }
+                    if (S_END(s)) {
+                        ujson_fail();
+                    }
+                }
+                S_NEXT(s);
+                break;
+            case '[':
+            case '{':
+                depth += 1;
+                S_NEXT(s);
+                break;
+            case ']':
+            case '}':
+                if (depth == 0) {
+                    ujson_fail();
+                }
+                depth -= 1;
+                S_NEXT(s);
+                break;
+            default:
+                // a literal or number, or the separators between items
+                do {
+                    c = S_NEXT(s);
+                } while (c != S_EOF && c != '"' && c != '[' && c != '{' && c != ']' && c != '}'
+                    && !ujson_is_sep(c));
+                break;
+        }
+    } while (depth > 0);
+}
+
+// Advance to the start of the value that path leads to.  Everything before it
+// is skipped over without being parsed into objects.
+STATIC void ujson_follow_path(ujson_stream_t *s, mp_obj_t path, vstr_t *vstr) {
+    size_t path_len;
+    mp_obj_t *path_items;
+    mp_obj_get_array(path, &path_len, &path_items);
+    for (size_t i = 0; i < path_len; i++) {
+        mp_obj_t elem = path_items[i];
+        ujson_skip_sep(s);
+        // A document that is truncated or malformed where the path leads is a
+        // syntax error, as it would be without a path, rather than a missing
+        // key or index.
+        if (S_CUR(s) == '[') {
+            mp_int_t index;
+            if (!mp_obj_get_int_maybe(elem, &index)) {
+                ujson_skip_value(s);
+                // raises the usual TypeError
+                mp_obj_get_int(elem);
+            }
+            S_NEXT(s);
+            for (mp_int_t n = 0;; n++) {
+                ujson_skip_sep(s);
+                if (S_CUR(s) == ']') {
+                    mp_raise_IndexError(translate("index out of range"));
+                }
+                if (n == index) {
+                    break;
+                }
+                ujson_skip_value(s);
+            }
+        } else if (S_CUR(s) == '{') {
+            S_NEXT(s);
+            for (;;) {
+                ujson_skip_sep(s);
+                if (S_CUR(s) == '}') {
+                    nlr_raise(mp_obj_new_exception_arg1(&mp_type_KeyError, elem));
+                }
+                if (S_CUR(s) != '"') {
+                    ujson_fail();
+                }
+                S_NEXT(s);
+                ujson_parse_str(s, vstr);
+                ujson_skip_sep(s);
+                if (MP_OBJ_IS_STR(elem)) {
+                    size_t len;
+                    const char *key = mp_obj_str_get_data(elem, &len);
+                    if (len == vstr->len && memcmp(key, vstr->buf, len) == 0) {
+                        break;
+                    }
+                }
+                ujson_skip_value(s);
+            }
+        } else {
+            byte c = S_CUR(s);
+            if (c != '"' && c != '-' && !unichar_isdigit(c) && c != 't' && c != 'f' && c != 'n') {
+                ujson_fail();
+            }
+            ujson_skip_value(s);
+            // can't index into a primitive
+            nlr_raise(mp_obj_new_exception_arg1(&mp_type_KeyError, elem));
+        }
+    }
+}
+
+STATIC mp_obj_t ujson_load(ujson_stream_t *s, mp_obj_t path) {
     vstr_t vstr;
     vstr_init(&vstr, 8);
     mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
@@ -101,6 +307,9 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
     mp_obj_type_t *stack_top_type = NULL;
     mp_obj_t stack_key = MP_OBJ_NULL;
     S_NEXT(s);
+    if (path != mp_const_none) {
+        ujson_follow_path(s, path, &vstr);
+    }
     for (;;) {
         cont:
         if (S_END(s)) {
@@ -143,40 +352,8 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
                 }
                 break;
             case '"':
-                vstr_reset(&vstr);
-                for (; !S_END(s) && S_CUR(s) != '"';) {
-                    byte c = S_CUR(s);
-                    if (c == '\\') {
-                        c = S_NEXT(s);
-                        switch (c) {
-                            case 'b': c = 0x08; break;
-                            case 'f': c = 0x0c; break;
-                            case 'n': c = 0x0a; break;
-                            case 'r': c = 0x0d; break;
-                            case 't': c = 0x09; break;
-                            case 'u': {
-                                mp_uint_t num = 0;
-                                for (int i = 0; i < 4; i++) {
-                                    c = (S_NEXT(s) | 0x20) - '0';
-                                    if (c > 9) {
-                                        c -= ('a' - ('9' + 1));
-                                    }
-                                    num = (num << 4) | c;
-                                }
-                                vstr_add_char(&vstr, num);
-                                goto str_cont;
-                            }
-                        }
-                    }
-                    vstr_add_byte(&vstr, c);
-                str_cont:
-                    S_NEXT(s);
-                }
-                if (S_END(s)) {
-                    goto fail;
-                }
-                S_NEXT(s);
-                next = mp_obj_new_str(vstr.buf, vstr.len);
+                ujson_parse_str(s, &vstr);
+                next = mp_obj_new_str_cached(vstr.buf, vstr.len);
                 break;
             case '-':
             case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': {
@@ -262,13 +439,15 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
         }
     }
     success:
-    // eat trailing whitespace
-    while (unichar_isspace(S_CUR(s))) {
-        S_NEXT(s);
-    }
-    if (!S_END(s)) {
-        // unexpected chars
-        goto fail;
+    if (path == mp_const_none) {
+        // eat trailing whitespace
+        while (unichar_isspace(S_CUR(s))) {
+            S_NEXT(s);
+        }
+        if (!S_END(s)) {
+            // unexpected chars
+            goto fail;
+        }
     }
     if (stack_top == MP_OBJ_NULL || stack.len != 0) {
         // not exactly 1 object
@@ -278,18 +457,45 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
     return stack_top;
 
     fail:
-    mp_raise_ValueError(translate("syntax error in JSON"));
+    ujson_fail();
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_load_obj, mod_ujson_load);
 
-STATIC mp_obj_t mod_ujson_loads(mp_obj_t obj) {
+STATIC const mp_arg_t ujson_load_args[] = {
+    { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ },
+    { MP_QSTR_path, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+};
+
+STATIC mp_obj_t mod_ujson_load(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_stream, ARG_path };
+    mp_arg_val_t args[MP_ARRAY_SIZE(ujson_load_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(ujson_load_args), ujson_load_args, args);
+
+    mp_obj_t stream_obj = args[ARG_stream].u_obj;
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
+    ujson_stream_t s;
+    s.stream_obj = stream_obj;
+    s.read = stream_p->read;
+    s.errcode = 0;
+    s.pos = s.end = s.buf;
+    return ujson_load(&s, args[ARG_path].u_obj);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(mod_ujson_load_obj, 1, mod_ujson_load);
+
+STATIC mp_obj_t mod_ujson_loads(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_str, ARG_path };
+    mp_arg_val_t args[MP_ARRAY_SIZE(ujson_load_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(ujson_load_args), ujson_load_args, args);
+
     size_t len;
-    const char *buf = mp_obj_str_get_data(obj, &len);
-    vstr_t vstr = {len, len, (char*)buf, true};
-    mp_obj_stringio_t sio = {{&mp_type_stringio}, &vstr, 0, MP_OBJ_NULL};
-    return mod_ujson_load(MP_OBJ_FROM_PTR(&sio));
+    const char *buf = mp_obj_str_get_data(args[ARG_str].u_obj, &len);
+    ujson_stream_t s;
+    s.read = NULL;
+    s.errcode = 0;
+    s.pos = (const byte*)buf;
+    s.end = s.pos + len;
+    return ujson_load(&s, args[ARG_path].u_obj);
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_loads_obj, mod_ujson_loads);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(mod_ujson_loads_obj, 1, mod_ujson_loads);
 
 STATIC const mp_rom_map_elem_t mp_module_ujson_globals_table[] = {
 #if CIRCUITPY
@@ -43,6 +43,7 @@
 
 typedef struct _mp_obj_re_t {
     mp_obj_base_t base;
+    bool has_loop;
     ByteProg re;
 } mp_obj_re_t;
 
@@ -171,6 +172,37 @@ STATIC void re_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
     mp_printf(print, "<re %p>", self);
 }
 
+// The backtracking matcher recurses once per repetition of a loop, using C
+// stack in proportion to the subject and, with nested loops, time exponential
+// in it.  Patterns with loops run on the Pike VM instead, which takes linear
+// time and memory fixed by the pattern.  The rest never repeat, so they run
+// on the backtracking matcher, which is quicker for them.
+STATIC int ure_exec_prog(mp_obj_re_t *self, Subject *subj, const char **caps, int caps_num, bool is_anchored) {
+    if (self->has_loop) {
+        return re1_5_pikevm(&self->re, subj, caps, caps_num, is_anchored);
+    }
+    return re1_5_recursiveloopprog(&self->re, subj, caps, caps_num, is_anchored);
+}
+
+// Run the pattern over subj, which lies within str, and return a match
+// object or None.
+STATIC mp_obj_t ure_exec_subject(mp_obj_re_t *self, mp_obj_t str, Subject *subj, bool is_anchored) {
+    int caps_num = (self->re.sub + 1) * 2;
+    mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, char*, caps_num);
+    // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
+    memset((char*)match->caps, 0, caps_num * sizeof(char*));
+    int res = ure_exec_prog(self, subj, match->caps, caps_num, is_anchored);
+    if (res == 0) {
+        m_del_var(mp_obj_match_t, char*, caps_num, match);
+        return mp_const_none;
+    }
+
+    match->base.type = &match_type;
+    match->num_matches = caps_num / 2; // caps_num counts start and end pointers
+    match->str = str;
+    return MP_OBJ_FROM_PTR(match);
+}
+
 STATIC mp_obj_t ure_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     (void)n_args;
     mp_obj_re_t *self = MP_OBJ_TO_PTR(args[0]);
@@ -207,20 +239,7 @@ STATIC mp_obj_t ure_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
         subj.end = (const char *)endpos_ptr;
     }
 #endif
-    int caps_num = (self->re.sub + 1) * 2;
-    mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, char*, caps_num);
-    // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
-    memset((char*)match->caps, 0, caps_num * sizeof(char*));
-    int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, is_anchored);
-    if (res == 0) {
-        m_del_var(mp_obj_match_t, char*, caps_num, match);
-        return mp_const_none;
-    }
-
-    match->base.type = &match_type;
-    match->num_matches = caps_num / 2; // caps_num counts start and end pointers
-    match->str = args[1];
-    return MP_OBJ_FROM_PTR(match);
+    return ure_exec_subject(self, args[1], &subj, is_anchored);
 }
 
 STATIC mp_obj_t re_match(size_t n_args, const mp_obj_t *args) {
@@ -252,7 +271,7 @@ STATIC mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     while (true) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char**)caps, 0, caps_num * sizeof(char*));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, caps, caps_num, false);
+        int res = ure_exec_prog(self, &subj, caps, caps_num, false);
 
         // if we didn't have a match, or had an empty match, it's time to stop
         if (!res || caps[0] == caps[1]) {
@@ -278,6 +297,53 @@ STATIC mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_split_obj, 2, 3, re_split);
 
+#if MICROPY_PY_URE_FINDITER
+
+typedef struct _mp_obj_re_finditer_t {
+    mp_obj_base_t base;
+    mp_fun_1_t iternext;
+    mp_obj_t re;
+    mp_obj_t str;
+    // offset of where the next search starts, or past the end once done
+    size_t pos;
+} mp_obj_re_finditer_t;
+
+STATIC mp_obj_t re_finditer_iternext(mp_obj_t self_in) {
+    mp_obj_re_finditer_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t len;
+    const char *str = mp_obj_str_get_data(self->str, &len);
+    if (self->pos > len) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    Subject subj = {str + self->pos, str + len};
+    mp_obj_t match_in = ure_exec_subject(MP_OBJ_TO_PTR(self->re), self->str, &subj, false);
+    if (match_in == mp_const_none) {
+        self->pos = len + 1;
+        return MP_OBJ_STOP_ITERATION;
+    }
+    mp_obj_match_t *match = MP_OBJ_TO_PTR(match_in);
+    self->pos = match->caps[1] - str;
+    if (match->caps[0] == match->caps[1]) {
+        // step over an empty match so the next search can't find it again
+        self->pos += 1;
+    }
+    return match_in;
+}
+
+STATIC mp_obj_t re_finditer(mp_obj_t self_in, mp_obj_t str) {
+    mp_obj_str_get_str(str);
+    mp_obj_re_finditer_t *o = m_new_obj(mp_obj_re_finditer_t);
+    o->base.type = &mp_type_polymorph_iter;
+    o->iternext = re_finditer_iternext;
+    o->re = self_in;
+    o->str = str;
+    o->pos = 0;
+    return MP_OBJ_FROM_PTR(o);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(re_finditer_obj, re_finditer);
+
+#endif
+
 #if MICROPY_PY_URE_SUB
 
 STATIC mp_obj_t re_sub_helper(mp_obj_t self_in, size_t n_args, const mp_obj_t *args) {
@@ -307,7 +373,7 @@ STATIC mp_obj_t re_sub_helper(mp_obj_t self_in, size_t n_args, const mp_obj_t *a
     for (;;) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char*)match->caps, 0, caps_num * sizeof(char*));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, false);
+        int res = ure_exec_prog(self, &subj, match->caps, caps_num, false);
 
         // If we didn't have a match, or had an empty match, it's time to stop
         if (!res || match->caps[0] == match->caps[1]) {
@@ -396,6 +462,9 @@ STATIC const mp_rom_map_elem_t re_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_match), MP_ROM_PTR(&re_match_obj) },
     { MP_ROM_QSTR(MP_QSTR_search), MP_ROM_PTR(&re_search_obj) },
     { MP_ROM_QSTR(MP_QSTR_split), MP_ROM_PTR(&re_split_obj) },
+    #if MICROPY_PY_URE_FINDITER
+    { MP_ROM_QSTR(MP_QSTR_finditer), MP_ROM_PTR(&re_finditer_obj) },
+    #endif
     #if MICROPY_PY_URE_SUB
     { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&re_sub_obj) },
     #endif
@@ -414,6 +483,37 @@ STATIC const mp_obj_type_t re_type = {
     .locals_dict = (void*)&re_locals_dict,
 };
 
+// Whether the program jumps backwards anywhere after the search prefix.
+STATIC bool ure_prog_has_loop(ByteProg *prog) {
+    const char *pc = prog->insts + NON_ANCHORED_PREFIX;
+    const char *end = prog->insts + prog->bytelen;
+    while (pc < end) {
+        switch (*pc) {
+            case Jmp:
+            case Split:
+            case RSplit:
+                if ((signed char)pc[1] < 0) {
+                    return true;
+                }
+                pc += 2;
+                break;
+            case Class:
+            case ClassNot:
+                pc += (unsigned char)pc[1] * 2 + 2;
+                break;
+            case Char:
+            case NamedClass:
+            case Save:
+                pc += 2;
+                break;
+            default:
+                pc += 1;
+                break;
+        }
+    }
+    return false;
+}
+
 STATIC mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
     const char *re_str = mp_obj_str_get_str(args[0]);
     int size = re1_5_sizecode(re_str);
@@ -431,16 +531,54 @@ STATIC mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
 error:
         mp_raise_ValueError(translate("Error in regex"));
     }
+    o->has_loop = ure_prog_has_loop(&o->re);
     if (flags & FLAG_DEBUG) {
         re1_5_dumpcode(&o->re);
     }
     return MP_OBJ_FROM_PTR(o);
 }
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_compile_obj, 1, 2, mod_re_compile);
+
+#if MICROPY_PY_URE_CACHE_SIZE
+// The module-level functions take the pattern as a string.  The most recently
+// used patterns are kept compiled, most recent first, so that calling them in
+// a loop doesn't compile the pattern every time.
+STATIC mp_obj_t ure_compile_cached(mp_obj_t pattern) {
+    mp_obj_t *cache = MP_STATE_VM(ure_cache);
+    mp_obj_t re;
+    size_t i;
+    for (i = 0; i < MICROPY_PY_URE_CACHE_SIZE - 1; i++) {
+        if (cache[2 * i] == MP_OBJ_NULL) {
+            break;
+        }
+        if (cache[2 * i] == pattern
+            || (mp_obj_get_type(cache[2 * i]) == mp_obj_get_type(pattern) && mp_obj_equal(cache[2 * i], pattern))) {
+            re = cache[2 * i + 1];
+            goto found;
+        }
+    }
+    re = mod_re_compile(1, &pattern);
+found:
+    memmove(cache + 2, cache, i * 2 * sizeof(mp_obj_t));
+    cache[0] = pattern;
+    cache[1] = re;
+    return re;
+}
+#else
+#define ure_compile_cached(pattern) mod_re_compile(1, &(pattern))
+#endif
+
+STATIC mp_obj_t mod_re_compile_cached(size_t n_args, const mp_obj_t *args) {
+    if (n_args > 1) {
+        // flags are rare enough not to be worth caching
+        return mod_re_compile(n_args, args);
+    }
+    return ure_compile_cached(args[0]);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_compile_obj, 1, 2, mod_re_compile_cached);
 
 STATIC mp_obj_t mod_re_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     (void)n_args;
-    mp_obj_t self = mod_re_compile(1, args);
+    mp_obj_t self = ure_compile_cached(args[0]);
 
     const mp_obj_t args2[] = {self, args[1]};
     mp_obj_t match = ure_exec(is_anchored, 2, args2);
@@ -459,12 +597,19 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_search_obj, 2, 4, mod_re_search);
 
 #if MICROPY_PY_URE_SUB
 STATIC mp_obj_t mod_re_sub(size_t n_args, const mp_obj_t *args) {
-    mp_obj_t self = mod_re_compile(1, args);
+    mp_obj_t self = ure_compile_cached(args[0]);
     return re_sub_helper(self, n_args, args);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_sub_obj, 3, 5, mod_re_sub);
 #endif
 
+#if MICROPY_PY_URE_FINDITER
+STATIC mp_obj_t mod_re_finditer(mp_obj_t pattern, mp_obj_t str) {
+    return re_finditer(ure_compile_cached(pattern), str);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(mod_re_finditer_obj, mod_re_finditer);
+#endif
+
 STATIC const mp_rom_map_elem_t mp_module_re_globals_table[] = {
 #if CIRCUITPY
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_re) },
@@ -477,6 +622,9 @@ STATIC const mp_rom_map_elem_t mp_module_re_globals_table[] = {
     #if MICROPY_PY_URE_SUB
     { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&mod_re_sub_obj) },
     #endif
+    #if MICROPY_PY_URE_FINDITER
+    { MP_ROM_QSTR(MP_QSTR_finditer), MP_ROM_PTR(&mod_re_finditer_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_DEBUG), MP_ROM_INT(FLAG_DEBUG) },
 };
 
@@ -491,9 +639,12 @@ const mp_obj_module_t mp_module_ure = {
 // only if module is enabled by config setting.
 
 #define re1_5_fatal(x) assert(!x)
+#define re1_5_alloc(n) mp_local_alloc(n)
+#define re1_5_free(p) mp_local_free(p)
 #include "re1.5/compilecode.c"
 #include "re1.5/dumpcode.c"
 #include "re1.5/recursiveloop.c"
+#include "re1.5/pike.c"
 #include "re1.5/charclass.c"
 
 #endif //MICROPY_PY_URE
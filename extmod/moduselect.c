@@ -174,6 +174,9 @@ STATIC mp_obj_t select_select(uint n_args, const mp_obj_t *args) {
             return mp_obj_new_tuple(3, list_array);
         }
         MICROPY_EVENT_POLL_HOOK
+        #ifdef MICROPY_EVENT_WAIT_HOOK
+        MICROPY_EVENT_WAIT_HOOK
+        #endif
     }
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_select_select_obj, 3, 4, select_select);
@@ -254,6 +257,9 @@ STATIC mp_uint_t poll_poll_internal(uint n_args, const mp_obj_t *args) {
             break;
         }
         MICROPY_EVENT_POLL_HOOK
+        #ifdef MICROPY_EVENT_WAIT_HOOK
+        MICROPY_EVENT_WAIT_HOOK
+        #endif
     }
 
     return n_ready;
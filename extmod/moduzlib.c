@@ -49,6 +49,10 @@ typedef struct _mp_obj_decompio_t {
     mp_obj_t src_stream;
     TINF_DATA decomp;
     bool eof;
+    // a seekable src_stream is read a block at a time into src_buf, and
+    // anything uzlib didn't use is given back before returning to the caller
+    bool seekable;
+    byte src_buf[128];
 } mp_obj_decompio_t;
 
 STATIC int read_src_stream(TINF_DATA *data) {
@@ -58,15 +62,33 @@ STATIC int read_src_stream(TINF_DATA *data) {
 
     const mp_stream_p_t *stream = mp_get_stream(self->src_stream);
     int err;
-    byte c;
-    mp_uint_t out_sz = stream->read(self->src_stream, &c, 1, &err);
+    // Without seek we can't give back what uzlib doesn't use, so only read
+    // the byte it asks for.
+    mp_uint_t size = self->seekable ? sizeof(self->src_buf) : 1;
+    mp_uint_t out_sz = stream->read(self->src_stream, self->src_buf, size, &err);
     if (out_sz == MP_STREAM_ERROR) {
         mp_raise_OSError(err);
     }
     if (out_sz == 0) {
         nlr_raise(mp_obj_new_exception(&mp_type_EOFError));
     }
-    return c;
+    // uzlib takes bytes from source until source_limit before calling back
+    data->source = self->src_buf + 1;
+    data->source_limit = self->src_buf + out_sz;
+    return self->src_buf[0];
+}
+
+// Seek a seekable source back over the bytes uzlib hasn't taken, so it is
+// left just after the compressed data consumed so far.
+STATIC void decompio_unread(mp_obj_decompio_t *self) {
+    mp_off_t unread = self->decomp.source_limit - self->decomp.source;
+    self->decomp.source = self->decomp.source_limit = NULL;
+    if (unread > 0) {
+        const mp_stream_p_t *stream = mp_get_stream(self->src_stream);
+        struct mp_stream_seek_t seek_s = {.offset = -unread, .whence = MP_SEEK_CUR};
+        int err;
+        stream->ioctl(self->src_stream, MP_STREAM_SEEK, (mp_uint_t)(uintptr_t)&seek_s, &err);
+    }
 }
 
 STATIC mp_obj_t decompio_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
@@ -79,6 +101,14 @@ STATIC mp_obj_t decompio_make_new(const mp_obj_type_t *type, size_t n_args, cons
     o->src_stream = args[0];
     o->eof = false;
 
+    const mp_stream_p_t *stream = mp_get_stream(o->src_stream);
+    o->seekable = false;
+    if (stream->ioctl != NULL) {
+        struct mp_stream_seek_t seek_s = {.offset = 0, .whence = MP_SEEK_CUR};
+        int err;
+        o->seekable = stream->ioctl(o->src_stream, MP_STREAM_SEEK, (mp_uint_t)(uintptr_t)&seek_s, &err) != MP_STREAM_ERROR;
+    }
+
     mp_int_t dict_opt = 0;
     int dict_sz;
     if (n_args > 1) {
@@ -92,16 +122,24 @@ STATIC mp_obj_t decompio_make_new(const mp_obj_type_t *type, size_t n_args, cons
         }
         dict_sz = 1 << (dict_opt - 16);
     } else if (dict_opt >= 0) {
-        dict_opt = uzlib_zlib_parse_header(&o->decomp);
-        if (dict_opt < 0) {
+        int header_opt = uzlib_zlib_parse_header(&o->decomp);
+        if (header_opt < 0) {
 header_error:
             mp_raise_ValueError(translate("compression header"));
         }
+        // A nonzero wbits caps the window, to keep within a memory budget.
+        // A stream that refers back further than that fails to decompress.
+        if (dict_opt == 0 || dict_opt > header_opt) {
+            dict_opt = header_opt;
+        }
         dict_sz = 1 << dict_opt;
     } else {
         dict_sz = 1 << -dict_opt;
     }
 
+    if (o->seekable) {
+        decompio_unread(o);
+    }
     uzlib_uncompress_init(&o->decomp, m_new(byte, dict_sz), dict_sz);
     return MP_OBJ_FROM_PTR(o);
 }
@@ -118,6 +156,9 @@ STATIC mp_uint_t decompio_read(mp_obj_t o_in, void *buf, mp_uint_t size, int *er
     if (st == TINF_DONE) {
         o->eof = true;
     }
+    if (o->seekable) {
+        decompio_unread(o);
+    }
     if (st < 0) {
         *errcode = MP_EINVAL;
         return MP_STREAM_ERROR;
@@ -203,8 +244,172 @@ error:
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_uzlib_decompress_obj, 1, 3, mod_uzlib_decompress);
 
+// A small compressor: greedy LZ77 matching over a hash of the next three
+// bytes, written out as a single block with the fixed Huffman codes.  That
+// needs no code tables in the output and no more RAM than the hash table.
+
+#define UZLIB_COMP_HASH_BITS (10)
+
+typedef struct _uzlib_comp_t {
+    vstr_t *vstr;
+    uint32_t bits;
+    uint8_t nbits;
+} uzlib_comp_t;
+
+// Lengths 3..258 and distances 1..32768 are sent as a code for a range
+// starting at one of these bases, then extra bits for the offset within it.
+STATIC const uint16_t comp_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+STATIC const uint16_t comp_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+
+STATIC void comp_put_bits(uzlib_comp_t *c, uint32_t bits, uint8_t n) {
+    c->bits |= bits << c->nbits;
+    c->nbits += n;
+    while (c->nbits >= 8) {
+        vstr_add_byte(c->vstr, c->bits);
+        c->bits >>= 8;
+        c->nbits -= 8;
+    }
+}
+
+// Huffman codes go out most significant bit first, other fields least first.
+STATIC void comp_put_code(uzlib_comp_t *c, uint32_t code, uint8_t n) {
+    uint32_t rev = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        rev = (rev << 1) | (code & 1);
+        code >>= 1;
+    }
+    comp_put_bits(c, rev, n);
+}
+
+STATIC void comp_literal(uzlib_comp_t *c, byte b) {
+    if (b < 144) {
+        comp_put_code(c, 0x30 + b, 8);
+    } else {
+        comp_put_code(c, 0x190 + b - 144, 9);
+    }
+}
+
+STATIC void comp_match(uzlib_comp_t *c, size_t len, size_t dist) {
+    size_t i = 28;
+    while (comp_len_base[i] > len) {
+        i--;
+    }
+    size_t sym = 257 + i;
+    if (sym < 280) {
+        comp_put_code(c, sym - 256, 7);
+    } else {
+        comp_put_code(c, 0xc0 + sym - 280, 8);
+    }
+    if (i >= 8 && i < 28) {
+        comp_put_bits(c, len - comp_len_base[i], (i - 4) / 4);
+    }
+    i = 29;
+    while (comp_dist_base[i] > dist) {
+        i--;
+    }
+    comp_put_code(c, i, 5);
+    if (i >= 4) {
+        comp_put_bits(c, dist - comp_dist_base[i], (i - 2) / 2);
+    }
+}
+
+STATIC uint32_t comp_adler32(const byte *data, size_t len) {
+    uint32_t a = 1, b = 0;
+    while (len > 0) {
+        // the sums can't overflow over this many bytes before being reduced
+        size_t n = len < 5552 ? len : 5552;
+        len -= n;
+        while (n--) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+// Append the deflate stream for data to vstr, using a window of 2**wbits.
+STATIC void comp_deflate(vstr_t *vstr, const byte *data, size_t len, int wbits) {
+    uzlib_comp_t c = {vstr, 0, 0};
+    size_t window = 1 << wbits;
+    // position + 1 of the last place each hash was seen, 0 for none
+    size_t *table = m_new0(size_t, 1 << UZLIB_COMP_HASH_BITS);
+
+    // a single final block using the fixed codes
+    comp_put_bits(&c, 1, 1);
+    comp_put_bits(&c, 1, 2);
+    size_t i = 0;
+    while (i < len) {
+        size_t match_len = 0;
+        size_t match_dist = 0;
+        if (len - i >= 3) {
+            uint32_t h = ((data[i] << 16) | (data[i + 1] << 8) | data[i + 2]) * 2654435761u;
+            h >>= 32 - UZLIB_COMP_HASH_BITS;
+            size_t cand = table[h];
+            table[h] = i + 1;
+            if (cand != 0 && i - (cand - 1) <= window) {
+                const byte *p = data + cand - 1;
+                size_t max = len - i < 258 ? len - i : 258;
+                while (match_len < max && p[match_len] == data[i + match_len]) {
+                    match_len++;
+                }
+                match_dist = i - (cand - 1);
+            }
+        }
+        if (match_len >= 3) {
+            comp_match(&c, match_len, match_dist);
+            i += match_len;
+        } else {
+            comp_literal(&c, data[i]);
+            i++;
+        }
+    }
+    // end of block, then pad to a byte boundary
+    comp_put_code(&c, 0, 7);
+    comp_put_bits(&c, 0, 7);
+    m_del(size_t, table, 1 << UZLIB_COMP_HASH_BITS);
+}
+STATIC mp_obj_t mod_uzlib_compress(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
+    mp_int_t wbits = 15;
+    if (n_args > 1) {
+        wbits = mp_obj_get_int(args[1]);
+    }
+    bool is_zlib = wbits >= 0;
+    if (!is_zlib) {
+        wbits = -wbits;
+    }
+    wbits = MAX(9, MIN(wbits, 15));
+
+    vstr_t vstr;
+    vstr_init(&vstr, bufinfo.len / 2 + 16);
+    if (is_zlib) {
+        byte cmf = 0x08 | ((wbits - 8) << 4);
+        vstr_add_byte(&vstr, cmf);
+        vstr_add_byte(&vstr, (31 - (cmf << 8) % 31) % 31);
+    }
+    comp_deflate(&vstr, bufinfo.buf, bufinfo.len, wbits);
+    if (is_zlib) {
+        uint32_t adler = comp_adler32(bufinfo.buf, bufinfo.len);
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            vstr_add_byte(&vstr, adler >> shift);
+        }
+    }
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_uzlib_compress_obj, 1, 2, mod_uzlib_compress);
+
 STATIC const mp_rom_map_elem_t mp_module_uzlib_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uzlib) },
+    { MP_ROM_QSTR(MP_QSTR_compress), MP_ROM_PTR(&mod_uzlib_compress_obj) },
     { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&mod_uzlib_decompress_obj) },
     { MP_ROM_QSTR(MP_QSTR_DecompIO), MP_ROM_PTR(&decompio_type) },
 };
@@ -0,0 +1,163 @@
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Pike VM: runs every thread of the program in lock step over the input, so
+// it takes time linear in the input and memory fixed by the program, where
+// the backtracking matchers recurse once per repetition.  Threads are kept
+// in priority order and a pc is only ever added once per step, which gives
+// the same leftmost, greedy-or-lazy-as-written results as backtracking.
+
+#include "re1.5.h"
+
+#ifndef re1_5_alloc
+#define re1_5_alloc(n) malloc(n)
+#define re1_5_free(p) free(p)
+#endif
+
+typedef struct ThreadList ThreadList;
+struct ThreadList
+{
+	int n;
+	// each thread is its pc followed by its nsubp captures
+	const char **t;
+};
+
+typedef struct PikeVM PikeVM;
+struct PikeVM
+{
+	ByteProg *prog;
+	Subject *input;
+	int nsubp;
+	// which pcs have been added in this step
+	char *marks;
+	// captures of the thread being followed
+	const char **sub;
+};
+
+static void
+addthread(PikeVM *vm, ThreadList *l, const char *pc, const char *sp)
+{
+	int off;
+	const char *old;
+	const char **t;
+
+	re1_5_stack_chk();
+
+	if(vm->marks[pc - vm->prog->insts])
+		return;
+	vm->marks[pc - vm->prog->insts] = 1;
+
+	switch(*pc) {
+	case Jmp:
+		addthread(vm, l, pc + 2 + (signed char)pc[1], sp);
+		return;
+	case Split:
+		addthread(vm, l, pc + 2, sp);
+		addthread(vm, l, pc + 2 + (signed char)pc[1], sp);
+		return;
+	case RSplit:
+		addthread(vm, l, pc + 2 + (signed char)pc[1], sp);
+		addthread(vm, l, pc + 2, sp);
+		return;
+	case Save:
+		off = (unsigned char)pc[1];
+		if(off >= vm->nsubp) {
+			addthread(vm, l, pc + 2, sp);
+			return;
+		}
+		old = vm->sub[off];
+		vm->sub[off] = sp;
+		addthread(vm, l, pc + 2, sp);
+		vm->sub[off] = old;
+		return;
+	case Bol:
+		if(sp == vm->input->begin)
+			addthread(vm, l, pc + 1, sp);
+		return;
+	case Eol:
+		if(sp == vm->input->end)
+			addthread(vm, l, pc + 1, sp);
+		return;
+	}
+
+	// a consumer or Match, which waits for the next step
+	t = l->t + l->n++ * (1 + vm->nsubp);
+	t[0] = pc;
+	memcpy(t + 1, vm->sub, vm->nsubp * sizeof(*t));
+}
+
+int
+re1_5_pikevm(ByteProg *prog, Subject *input, const char **subp, int nsubp, int is_anchored)
+{
+	int i, matched = 0;
+	int tsize = 1 + nsubp;
+	const char *sp, *pc, **t;
+	ThreadList lists[2], *clist = &lists[0], *nlist = &lists[1], *tmp;
+	PikeVM vm;
+
+	// There are at most as many threads as instructions
+	size_t nbytes = (2 * prog->len * tsize + nsubp) * sizeof(*t) + prog->bytelen;
+	void *mem = re1_5_alloc(nbytes);
+	clist->t = mem;
+	nlist->t = clist->t + prog->len * tsize;
+	vm.sub = nlist->t + prog->len * tsize;
+	vm.marks = (char*)(vm.sub + nsubp);
+	vm.prog = prog;
+	vm.input = input;
+	vm.nsubp = nsubp;
+
+	memset(vm.sub, 0, nsubp * sizeof(*t));
+	memset(vm.marks, 0, prog->bytelen);
+	clist->n = 0;
+	addthread(&vm, clist, HANDLE_ANCHORED(prog->insts, is_anchored), input->begin);
+
+	for(sp = input->begin; clist->n > 0; sp++) {
+		nlist->n = 0;
+		memset(vm.marks, 0, prog->bytelen);
+		for(i = 0; i < clist->n; i++) {
+			t = clist->t + i * tsize;
+			pc = t[0];
+			if(inst_is_consumer(*pc) && sp >= input->end)
+				continue;
+			switch(*pc) {
+			case Char:
+				if(*sp != pc[1])
+					continue;
+				pc += 2;
+				break;
+			case Any:
+				pc += 1;
+				break;
+			case Class:
+			case ClassNot:
+				if(!_re1_5_classmatch(pc + 1, sp))
+					continue;
+				pc += (unsigned char)pc[1] * 2 + 2;
+				break;
+			case NamedClass:
+				if(!_re1_5_namedclassmatch(pc + 1, sp))
+					continue;
+				pc += 2;
+				break;
+			case Match:
+				matched = 1;
+				memcpy(subp, t + 1, nsubp * sizeof(*t));
+				// the threads after this one have lower priority
+				goto cut;
+			default:
+				re1_5_fatal("pikevm");
+			}
+			vm.sub = t + 1;
+			addthread(&vm, nlist, pc, sp + 1);
+		}
+	cut:
+		if(sp >= input->end)
+			break;
+		tmp = clist;
+		clist = nlist;
+		nlist = tmp;
+	}
+
+	re1_5_free(mem);
+	return matched;
+}
@@ -32,6 +32,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "py/mphal.h"
 
@@ -53,6 +54,58 @@ STATIC fs_user_mount_t *disk_get_device(void *bdev) {
     return (fs_user_mount_t*)bdev;
 }
 
+#if MICROPY_FATFS_SECTOR_CACHE
+// Sectors recently read into a volume's window, shared by all volumes. FatFs
+// only keeps one sector per volume in its window so following a cluster chain
+// or scanning a directory would otherwise read the same FAT sectors again and
+// again.
+typedef struct {
+    fs_user_mount_t *vfs;
+    DWORD sector;
+    uint32_t last_used;
+    BYTE data[_MAX_SS];
+} sector_cache_entry_t;
+
+STATIC sector_cache_entry_t sector_cache[MICROPY_FATFS_SECTOR_CACHE];
+STATIC uint32_t sector_cache_use_count;
+
+STATIC sector_cache_entry_t *sector_cache_lookup(fs_user_mount_t *vfs, DWORD sector) {
+    for (size_t i = 0; i < MICROPY_FATFS_SECTOR_CACHE; i++) {
+        if (sector_cache[i].vfs == vfs && sector_cache[i].sector == sector) {
+            return &sector_cache[i];
+        }
+    }
+    return NULL;
+}
+
+STATIC void sector_cache_store(fs_user_mount_t *vfs, DWORD sector, const BYTE *buff) {
+    sector_cache_entry_t *entry = &sector_cache[0];
+    for (size_t i = 0; i < MICROPY_FATFS_SECTOR_CACHE; i++) {
+        if (sector_cache[i].vfs == NULL) {
+            entry = &sector_cache[i];
+            break;
+        }
+        if (sector_cache[i].last_used < entry->last_used) {
+            entry = &sector_cache[i];
+        }
+    }
+    entry->vfs = vfs;
+    entry->sector = sector;
+    entry->last_used = ++sector_cache_use_count;
+    memcpy(entry->data, buff, SECSIZE(&vfs->fatfs));
+}
+
+// Drops the volume's sectors. A new volume may reuse the memory of an old one
+// so this is done whenever one is mounted.
+STATIC void sector_cache_invalidate(fs_user_mount_t *vfs) {
+    for (size_t i = 0; i < MICROPY_FATFS_SECTOR_CACHE; i++) {
+        if (sector_cache[i].vfs == vfs) {
+            sector_cache[i].vfs = NULL;
+        }
+    }
+}
+#endif
+
 /*-----------------------------------------------------------------------*/
 /* Read Sector(s)                                                        */
 /*-----------------------------------------------------------------------*/
@@ -69,6 +122,20 @@ DRESULT disk_read (
         return RES_PARERR;
     }
 
+    #if MICROPY_FATFS_SECTOR_CACHE
+    // FAT and directory sectors are always read into the window. Larger file
+    // reads go straight to the caller's buffer and aren't worth keeping.
+    bool cacheable = count == 1 && buff == vfs->fatfs.win;
+    if (cacheable) {
+        sector_cache_entry_t *entry = sector_cache_lookup(vfs, sector);
+        if (entry != NULL) {
+            entry->last_used = ++sector_cache_use_count;
+            memcpy(buff, entry->data, SECSIZE(&vfs->fatfs));
+            return RES_OK;
+        }
+    }
+    #endif
+
     if (vfs->flags & FSUSER_NATIVE) {
         mp_uint_t (*f)(uint8_t*, uint32_t, uint32_t) = (void*)(uintptr_t)vfs->readblocks[2];
         if (f(buff, sector, count) != 0) {
@@ -91,6 +158,12 @@ DRESULT disk_read (
         }
     }
 
+    #if MICROPY_FATFS_SECTOR_CACHE
+    if (cacheable) {
+        sector_cache_store(vfs, sector, buff);
+    }
+    #endif
+
     return RES_OK;
 }
 
@@ -137,6 +210,15 @@ DRESULT disk_write (
         }
     }
 
+    #if MICROPY_FATFS_SECTOR_CACHE
+    for (UINT i = 0; i < count; i++) {
+        sector_cache_entry_t *entry = sector_cache_lookup(vfs, sector + i);
+        if (entry != NULL) {
+            memcpy(entry->data, buff + i * SECSIZE(&vfs->fatfs), SECSIZE(&vfs->fatfs));
+        }
+    }
+    #endif
+
     return RES_OK;
 }
 
@@ -224,6 +306,10 @@ DRESULT disk_ioctl (
             return RES_OK;
 
         case IOCTL_INIT:
+            #if MICROPY_FATFS_SECTOR_CACHE
+            sector_cache_invalidate(vfs);
+            #endif
+            // Fall through.
         case IOCTL_STATUS: {
             DSTATUS stat;
             if (ret != mp_const_none && MP_OBJ_SMALL_INT_VALUE(ret) != 0) {
@@ -28,6 +28,7 @@
 #if MICROPY_VFS && MICROPY_VFS_FAT
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -65,6 +66,52 @@ STATIC void file_obj_print(const mp_print_t *print, mp_obj_t self_in, mp_print_k
     mp_printf(print, "<io.%s %p>", mp_obj_get_type_str(self_in), MP_OBJ_TO_PTR(self_in));
 }
 
+// Number of entries in the table used to measure a file's cluster chain. It
+// holds a file in up to four fragments, so most files need only one walk.
+#define FAST_SEEK_TEMP_TABLE_LEN (10)
+
+// Give FatFs a cluster link map table for the file so f_lseek can find any
+// cluster directly instead of following the FAT chain from the start of the
+// file. If the table can't be built the file is still usable, just slower.
+STATIC void file_obj_start_fast_seek(pyb_file_obj_t *self) {
+    DWORD temp_table[FAST_SEEK_TEMP_TABLE_LEN];
+    temp_table[0] = FAST_SEEK_TEMP_TABLE_LEN;
+    self->fp.cltbl = temp_table;
+    FRESULT res = f_lseek(&self->fp, CREATE_LINKMAP);
+    self->fp.cltbl = NULL;
+    if (res != FR_OK && res != FR_NOT_ENOUGH_CORE) {
+        return;
+    }
+    // temp_table[0] now holds the number of entries the table needs.
+    DWORD size = temp_table[0];
+    DWORD *table = m_new_maybe(DWORD, size);
+    if (table == NULL) {
+        return;
+    }
+    if (res == FR_OK) {
+        memcpy(table, temp_table, size * sizeof(DWORD));
+    } else {
+        table[0] = size;
+        self->fp.cltbl = table;
+        if (f_lseek(&self->fp, CREATE_LINKMAP) != FR_OK) {
+            self->fp.cltbl = NULL;
+            m_del(DWORD, table, size);
+            return;
+        }
+    }
+    self->fp.cltbl = table;
+}
+
+// FatFs can't allocate clusters while fast seek is on, so drop the table
+// before anything that grows the file.
+STATIC void file_obj_stop_fast_seek(pyb_file_obj_t *self) {
+    DWORD *table = self->fp.cltbl;
+    if (table != NULL) {
+        self->fp.cltbl = NULL;
+        m_del(DWORD, table, table[0]);
+    }
+}
+
 STATIC mp_uint_t file_obj_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *errcode) {
     pyb_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
     UINT sz_out;
@@ -78,6 +125,9 @@ STATIC mp_uint_t file_obj_read(mp_obj_t self_in, void *buf, mp_uint_t size, int
 
 STATIC mp_uint_t file_obj_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
     pyb_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (f_tell(&self->fp) + size > f_size(&self->fp)) {
+        file_obj_stop_fast_seek(self);
+    }
     UINT sz_out;
     FRESULT res = f_write(&self->fp, buf, size, &sz_out);
     if (res != FR_OK) {
@@ -104,21 +154,25 @@ STATIC mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg,
 
     if (request == MP_STREAM_SEEK) {
         struct mp_stream_seek_t *s = (struct mp_stream_seek_t*)(uintptr_t)arg;
+        FSIZE_t offset = s->offset;
 
         switch (s->whence) {
-            case 0: // SEEK_SET
-                f_lseek(&self->fp, s->offset);
-                break;
-
             case 1: // SEEK_CUR
-                f_lseek(&self->fp, f_tell(&self->fp) + s->offset);
+                offset += f_tell(&self->fp);
                 break;
 
             case 2: // SEEK_END
-                f_lseek(&self->fp, f_size(&self->fp) + s->offset);
+                offset += f_size(&self->fp);
                 break;
         }
 
+        // Fast seek clips at the end of the file but a normal seek on a
+        // writable file extends it.
+        if (offset > f_size(&self->fp) && (self->fp.flag & FA_WRITE) != 0) {
+            file_obj_stop_fast_seek(self);
+        }
+        f_lseek(&self->fp, offset);
+
         s->offset = f_tell(&self->fp);
         return 0;
 
@@ -134,6 +188,7 @@ STATIC mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg,
         // if fs==NULL then the file is closed and in that case this method is a no-op
         if (self->fp.obj.fs != NULL) {
             FRESULT res = f_close(&self->fp);
+            file_obj_stop_fast_seek(self);
             if (res != FR_OK) {
                 *errcode = fresult_to_errno_table[res];
                 return MP_STREAM_ERROR;
@@ -201,22 +256,10 @@ STATIC mp_obj_t file_open(fs_user_mount_t *vfs, const mp_obj_type_t *type, mp_ar
         m_del_obj(pyb_file_obj_t, o);
         mp_raise_OSError(fresult_to_errno_table[res]);
     }
-    // If we're reading, turn on fast seek.
-    if (mode == FA_READ) {
-        // one call to determine how much space we need.
-        DWORD temp_table[2];
-        temp_table[0] = 2;
-        o->fp.cltbl = temp_table;
-        f_lseek(&o->fp, CREATE_LINKMAP);
-        DWORD size = (temp_table[0] + 1) * 2;
-        o->fp.cltbl = m_malloc_maybe(size * sizeof(DWORD), false);
-        if (o->fp.cltbl != NULL) {
-            o->fp.cltbl[0] = size;
-            res = f_lseek(&o->fp, CREATE_LINKMAP);
-            if (res != FR_OK) {
-                o->fp.cltbl = NULL;
-            }
-        }
+    // Turn on fast seek for files that keep their existing contents. 'w' and
+    // 'a' files start out empty or only ever grow, so there is nothing to map.
+    if (mode == FA_READ || mode == (FA_READ | FA_WRITE)) {
+        file_obj_start_fast_seek(o);
     }
 
     // for 'a' mode, we must begin at the end of the file
@@ -0,0 +1,503 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/mpconfig.h"
+#if MICROPY_VFS_LFS
+
+#if !MICROPY_VFS
+#error "with MICROPY_VFS_LFS enabled, must also enable MICROPY_VFS"
+#endif
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/runtime.h"
+#include "extmod/vfs_lfs.h"
+
+// The smallest read and program littlefs does. Some QSPI peripherals can only
+// program whole words so keep it a multiple of four.
+#define VFS_LFS_IO_SIZE (16)
+
+// Erases of a metadata block before littlefs moves it somewhere else to even
+// out the wear.
+#define VFS_LFS_BLOCK_CYCLES (500)
+
+// littlefs errors are negative errno values except for corruption.
+void vfs_lfs_raise_error(int res) {
+    if (res == LFS_ERR_CORRUPT) {
+        mp_raise_OSError(MP_EIO);
+    }
+    mp_raise_OSError(-res);
+}
+
+STATIC int lfs_bdev_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size) {
+    mp_obj_vfs_lfs_t *self = c->context;
+    return self->bdev->read(block, off, buffer, size) ? LFS_ERR_OK : LFS_ERR_IO;
+}
+
+STATIC int lfs_bdev_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size) {
+    mp_obj_vfs_lfs_t *self = c->context;
+    return self->bdev->program(block, off, buffer, size) ? LFS_ERR_OK : LFS_ERR_IO;
+}
+
+STATIC int lfs_bdev_erase(const struct lfs_config *c, lfs_block_t block) {
+    mp_obj_vfs_lfs_t *self = c->context;
+    return self->bdev->erase(block) ? LFS_ERR_OK : LFS_ERR_IO;
+}
+
+STATIC int lfs_bdev_sync(const struct lfs_config *c) {
+    (void)c;
+    // Programs go straight to the device.
+    return LFS_ERR_OK;
+}
+
+int vfs_lfs_init(mp_obj_vfs_lfs_t *self, const vfs_lfs_block_device_t *bdev, bool format) {
+    self->base.type = &mp_lfs_vfs_type;
+    self->bdev = bdev;
+    self->readonly = false;
+    self->cur_dir[0] = '\0';
+
+    struct lfs_config *config = &self->config;
+    memset(config, 0, sizeof(*config));
+    config->context = self;
+    config->read = lfs_bdev_read;
+    config->prog = lfs_bdev_prog;
+    config->erase = lfs_bdev_erase;
+    config->sync = lfs_bdev_sync;
+    config->read_size = VFS_LFS_IO_SIZE;
+    config->prog_size = VFS_LFS_IO_SIZE;
+    config->block_size = bdev->block_size;
+    config->block_count = bdev->block_count();
+    config->block_cycles = VFS_LFS_BLOCK_CYCLES;
+    config->cache_size = MICROPY_VFS_LFS_CACHE_SIZE;
+    config->lookahead_size = MICROPY_VFS_LFS_LOOKAHEAD_SIZE;
+    // Buffers are given rather than allocated so that the filesystem doesn't
+    // depend on the heap.
+    config->read_buffer = self->read_buffer;
+    config->prog_buffer = self->prog_buffer;
+    config->lookahead_buffer = self->lookahead_buffer;
+
+    int res = lfs_mount(&self->lfs, config);
+    if (res != LFS_ERR_OK && format) {
+        res = lfs_format(&self->lfs, config);
+        if (res == LFS_ERR_OK) {
+            res = lfs_mount(&self->lfs, config);
+        }
+    }
+    return res;
+}
+
+const char *vfs_lfs_make_path(mp_obj_vfs_lfs_t *self, const char *path, char *buf) {
+    if (path[0] == '/') {
+        return path;
+    }
+    size_t dir_len = strlen(self->cur_dir);
+    if (path[0] == '\0') {
+        return dir_len == 0 ? "/" : self->cur_dir;
+    }
+    if (dir_len == 0) {
+        return path;
+    }
+    size_t path_len = strlen(path);
+    if (dir_len + 1 + path_len > MICROPY_ALLOC_PATH_MAX) {
+        mp_raise_OSError(MP_EINVAL);
+    }
+    memcpy(buf, self->cur_dir, dir_len);
+    buf[dir_len] = '/';
+    memcpy(buf + dir_len + 1, path, path_len + 1);
+    return buf;
+}
+
+STATIC void verify_fs_writable(mp_obj_vfs_lfs_t *self) {
+    if (self->readonly) {
+        mp_raise_OSError(MP_EROFS);
+    }
+}
+
+STATIC mp_import_stat_t lfs_vfs_import_stat(void *vfs_in, const char *path) {
+    mp_obj_vfs_lfs_t *self = vfs_in;
+    char buf[MICROPY_ALLOC_PATH_MAX + 1];
+    struct lfs_info info;
+    if (lfs_stat(&self->lfs, vfs_lfs_make_path(self, path, buf), &info) == LFS_ERR_OK) {
+        if (info.type == LFS_TYPE_DIR) {
+            return MP_IMPORT_STAT_DIR;
+        } else {
+            return MP_IMPORT_STAT_FILE;
+        }
+    }
+    return MP_IMPORT_STAT_NO_EXIST;
+}
+
+typedef struct _mp_vfs_lfs_ilistdir_it_t {
+    mp_obj_base_t base;
+    mp_obj_vfs_lfs_t *vfs;
+    bool is_str;
+    bool open;
+    lfs_dir_t dir;
+} mp_vfs_lfs_ilistdir_it_t;
+
+// littlefs keeps a list of its open directories so one must be closed before
+// the iterator is freed.
+STATIC mp_obj_t lfs_vfs_ilistdir_it_del(mp_obj_t self_in) {
+    mp_vfs_lfs_ilistdir_it_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->open) {
+        lfs_dir_close(&self->vfs->lfs, &self->dir);
+        self->open = false;
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(lfs_vfs_ilistdir_it_del_obj, lfs_vfs_ilistdir_it_del);
+
+STATIC mp_obj_t lfs_vfs_ilistdir_it_iternext(mp_obj_t self_in) {
+    mp_vfs_lfs_ilistdir_it_t *self = MP_OBJ_TO_PTR(self_in);
+
+    while (self->open) {
+        struct lfs_info info;
+        if (lfs_dir_read(&self->vfs->lfs, &self->dir, &info) <= 0) {
+            // stop on error or end of dir
+            break;
+        }
+        if (strcmp(info.name, ".") == 0 || strcmp(info.name, "..") == 0) {
+            continue;
+        }
+
+        // make 4-tuple with info about this entry
+        size_t len = strlen(info.name);
+        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(4, NULL));
+        if (self->is_str) {
+            t->items[0] = mp_obj_new_str(info.name, len);
+        } else {
+            t->items[0] = mp_obj_new_bytes((const byte*)info.name, len);
+        }
+        if (info.type == LFS_TYPE_DIR) {
+            t->items[1] = MP_OBJ_NEW_SMALL_INT(MP_S_IFDIR);
+        } else {
+            t->items[1] = MP_OBJ_NEW_SMALL_INT(MP_S_IFREG);
+        }
+        t->items[2] = MP_OBJ_NEW_SMALL_INT(0); // no inode number
+        t->items[3] = mp_obj_new_int_from_uint(info.size);
+
+        return MP_OBJ_FROM_PTR(t);
+    }
+
+    lfs_vfs_ilistdir_it_del(self_in);
+
+    return MP_OBJ_STOP_ITERATION;
+}
+
+STATIC const mp_rom_map_elem_t lfs_vfs_ilistdir_it_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&lfs_vfs_ilistdir_it_del_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(lfs_vfs_ilistdir_it_locals_dict, lfs_vfs_ilistdir_it_locals_dict_table);
+
+STATIC const mp_obj_type_t lfs_vfs_ilistdir_it_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_iterator,
+    .getiter = mp_identity_getiter,
+    .iternext = lfs_vfs_ilistdir_it_iternext,
+    .locals_dict = (mp_obj_dict_t*)&lfs_vfs_ilistdir_it_locals_dict,
+};
+
+STATIC mp_obj_t lfs_vfs_ilistdir_func(size_t n_args, const mp_obj_t *args) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(args[0]);
+    bool is_str_type = true;
+    const char *path;
+    if (n_args == 2) {
+        if (mp_obj_get_type(args[1]) == &mp_type_bytes) {
+            is_str_type = false;
+        }
+        path = mp_obj_str_get_str(args[1]);
+    } else {
+        path = "";
+    }
+    char buf[MICROPY_ALLOC_PATH_MAX + 1];
+    path = vfs_lfs_make_path(self, path, buf);
+
+    // Create a new iterator object to list the dir
+    mp_vfs_lfs_ilistdir_it_t *iter = m_new_obj_with_finaliser(mp_vfs_lfs_ilistdir_it_t);
+    iter->base.type = &lfs_vfs_ilistdir_it_type;
+    iter->vfs = self;
+    iter->is_str = is_str_type;
+    iter->open = false;
+    int res = lfs_dir_open(&self->lfs, &iter->dir, path);
+    if (res != LFS_ERR_OK) {
+        vfs_lfs_raise_error(res);
+    }
+    iter->open = true;
+
+    return MP_OBJ_FROM_PTR(iter);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(lfs_vfs_ilistdir_obj, 1, 2, lfs_vfs_ilistdir_func);
+
+STATIC mp_obj_t lfs_vfs_remove_internal(mp_obj_t vfs_in, mp_obj_t path_in, uint8_t type) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(vfs_in);
+    verify_fs_writable(self);
+    char buf[MICROPY_ALLOC_PATH_MAX + 1];
+    const char *path = vfs_lfs_make_path(self, mp_obj_str_get_str(path_in), buf);
+
+    struct lfs_info info;
+    int res = lfs_stat(&self->lfs, path, &info);
+    if (res != LFS_ERR_OK) {
+        vfs_lfs_raise_error(res);
+    }
+
+    // check if path is a file or directory
+    if (info.type != type) {
+        mp_raise_OSError(type == LFS_TYPE_DIR ? MP_ENOTDIR : MP_EISDIR);
+    }
+    res = lfs_remove(&self->lfs, path);
+    if (res != LFS_ERR_OK) {
+        vfs_lfs_raise_error(res);
+    }
+    return mp_const_none;
+}
+
+STATIC mp_obj_t lfs_vfs_remove(mp_obj_t vfs_in, mp_obj_t path_in) {
+    return lfs_vfs_remove_internal(vfs_in, path_in, LFS_TYPE_REG);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(lfs_vfs_remove_obj, lfs_vfs_remove);
+
+STATIC mp_obj_t lfs_vfs_rmdir(mp_obj_t vfs_in, mp_obj_t path_in) {
+    return lfs_vfs_remove_internal(vfs_in, path_in, LFS_TYPE_DIR);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(lfs_vfs_rmdir_obj, lfs_vfs_rmdir);
+
+STATIC mp_obj_t lfs_vfs_rename(mp_obj_t vfs_in, mp_obj_t path_in, mp_obj_t path_out) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(vfs_in);
+    verify_fs_writable(self);
+    char old_buf[MICROPY_ALLOC_PATH_MAX + 1];
+    char new_buf[MICROPY_ALLOC_PATH_MAX + 1];
+    const char *old_path = vfs_lfs_make_path(self, mp_obj_str_get_str(path_in), old_buf);
+    const char *new_path = vfs_lfs_make_path(self, mp_obj_str_get_str(path_out), new_buf);
+
+    // Refuse to move a directory into itself, the same as the FAT filesystem.
+    struct lfs_info info;
+    int res = lfs_stat(&self->lfs, old_path, &info);
+    if (res != LFS_ERR_OK) {
+        vfs_lfs_raise_error(res);
+    }
+    size_t old_len = strlen(old_path);
+    if (info.type == LFS_TYPE_DIR &&
+            strlen(new_path) > old_len &&
+            new_path[old_len] == '/' &&
+            strncmp(old_path, new_path, old_len) == 0) {
+        mp_raise_OSError(MP_EINVAL);
+    }
+
+    // littlefs replaces an existing file at new_path itself.
+    res = lfs_rename(&self->lfs, old_path, new_path);
+    if (res != LFS_ERR_OK) {
+        vfs_lfs_raise_error(res);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(lfs_vfs_rename_obj, lfs_vfs_rename);
+
+STATIC mp_obj_t lfs_vfs_mkdir(mp_obj_t vfs_in, mp_obj_t path_o) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(vfs_in);
+    verify_fs_writable(self);
+    char buf[MICROPY_ALLOC_PATH_MAX + 1];
+    int res = lfs_mkdir(&self->lfs, vfs_lfs_make_path(self, mp_obj_str_get_str(path_o), buf));
+    if (res != LFS_ERR_OK) {
+        vfs_lfs_raise_error(res);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(lfs_vfs_mkdir_obj, lfs_vfs_mkdir);
+
+/// Change current directory.
+STATIC mp_obj_t lfs_vfs_chdir(mp_obj_t vfs_in, mp_obj_t path_in) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(vfs_in);
+    char buf[MICROPY_ALLOC_PATH_MAX + 1];
+    const char *path = vfs_lfs_make_path(self, mp_obj_str_get_str(path_in), buf);
+
+    // littlefs has no current directory so keep our own, with . and ..
+    // resolved so that getcwd returns a plain path.
+    char new_dir[MICROPY_ALLOC_PATH_MAX + 1];
+    size_t len = 0;
+    while (*path != '\0') {
+        while (*path == '/') {
+            path++;
+        }
+        const char *end = path;
+        while (*end != '\0' && *end != '/') {
+            end++;
+        }
+        size_t part_len = end - path;
+        if (part_len == 0 || (part_len == 1 && path[0] == '.')) {
+            // nothing to add
+        } else if (part_len == 2 && path[0] == '.' && path[1] == '.') {
+            while (len > 0 && new_dir[len - 1] != '/') {
+                len--;
+            }
+            if (len > 0) {
+                len--;
+            }
+        } else {
+            if (len + 1 + part_len > MICROPY_ALLOC_PATH_MAX) {
+                mp_raise_OSError(MP_EINVAL);
+            }
+            new_dir[len++] = '/';
+            memcpy(new_dir + len, path, part_len);
+            len += part_len;
+        }
+        path = end;
+    }
+    new_dir[len] = '\0';
+
+    if (len > 0) {
+        struct lfs_info info;
+        int res = lfs_stat(&self->lfs, new_dir, &info);
+        if (res != LFS_ERR_OK) {
+            vfs_lfs_raise_error(res);
+        }
+        if (info.type != LFS_TYPE_DIR) {
+            mp_raise_OSError(MP_ENOTDIR);
+        }
+    }
+    memcpy(self->cur_dir, new_dir, len + 1);
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(lfs_vfs_chdir_obj, lfs_vfs_chdir);
+
+/// Get the current directory.
+STATIC mp_obj_t lfs_vfs_getcwd(mp_obj_t vfs_in) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(vfs_in);
+    if (self->cur_dir[0] == '\0') {
+        return MP_OBJ_NEW_QSTR(MP_QSTR__slash_);
+    }
+    return mp_obj_new_str(self->cur_dir, strlen(self->cur_dir));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(lfs_vfs_getcwd_obj, lfs_vfs_getcwd);
+
+/// \function stat(path)
+/// Get the status of a file or directory.
+STATIC mp_obj_t lfs_vfs_stat(mp_obj_t vfs_in, mp_obj_t path_in) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(vfs_in);
+    char buf[MICROPY_ALLOC_PATH_MAX + 1];
+    const char *path = vfs_lfs_make_path(self, mp_obj_str_get_str(path_in), buf);
+
+    struct lfs_info info;
+    int res = lfs_stat(&self->lfs, path, &info);
+    if (res != LFS_ERR_OK) {
+        vfs_lfs_raise_error(res);
+    }
+
+    mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(10, NULL));
+    mp_int_t mode = 0;
+    if (info.type == LFS_TYPE_DIR) {
+        mode |= MP_S_IFDIR;
+    } else {
+        mode |= MP_S_IFREG;
+    }
+    t->items[0] = MP_OBJ_NEW_SMALL_INT(mode); // st_mode
+    t->items[1] = MP_OBJ_NEW_SMALL_INT(0); // st_ino
+    t->items[2] = MP_OBJ_NEW_SMALL_INT(0); // st_dev
+    t->items[3] = MP_OBJ_NEW_SMALL_INT(0); // st_nlink
+    t->items[4] = MP_OBJ_NEW_SMALL_INT(0); // st_uid
+    t->items[5] = MP_OBJ_NEW_SMALL_INT(0); // st_gid
+    t->items[6] = mp_obj_new_int_from_uint(info.size); // st_size
+    // littlefs doesn't keep timestamps.
+    t->items[7] = MP_OBJ_NEW_SMALL_INT(0); // st_atime
+    t->items[8] = MP_OBJ_NEW_SMALL_INT(0); // st_mtime
+    t->items[9] = MP_OBJ_NEW_SMALL_INT(0); // st_ctime
+
+    return MP_OBJ_FROM_PTR(t);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(lfs_vfs_stat_obj, lfs_vfs_stat);
+
+// Get the status of a VFS.
+STATIC mp_obj_t lfs_vfs_statvfs(mp_obj_t vfs_in, mp_obj_t path_in) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(vfs_in);
+    (void)path_in;
+
+    lfs_ssize_t used = lfs_fs_size(&self->lfs);
+    if (used < 0) {
+        vfs_lfs_raise_error(used);
+    }
+
+    mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(10, NULL));
+
+    t->items[0] = MP_OBJ_NEW_SMALL_INT(self->config.block_size); // f_bsize
+    t->items[1] = t->items[0]; // f_frsize
+    t->items[2] = MP_OBJ_NEW_SMALL_INT(self->config.block_count); // f_blocks
+    t->items[3] = MP_OBJ_NEW_SMALL_INT(self->config.block_count - used); // f_bfree
+    t->items[4] = t->items[3]; // f_bavail
+    t->items[5] = MP_OBJ_NEW_SMALL_INT(0); // f_files
+    t->items[6] = MP_OBJ_NEW_SMALL_INT(0); // f_ffree
+    t->items[7] = MP_OBJ_NEW_SMALL_INT(0); // f_favail
+    t->items[8] = MP_OBJ_NEW_SMALL_INT(0); // f_flags
+    t->items[9] = MP_OBJ_NEW_SMALL_INT(LFS_NAME_MAX); // f_namemax
+
+    return MP_OBJ_FROM_PTR(t);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(lfs_vfs_statvfs_obj, lfs_vfs_statvfs);
+
+STATIC mp_obj_t vfs_lfs_mount(mp_obj_t self_in, mp_obj_t readonly, mp_obj_t mkfs) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(self_in);
+    (void)mkfs;
+    // The filesystem was mounted, and formatted if needed, by vfs_lfs_init.
+    self->readonly = mp_obj_is_true(readonly);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(vfs_lfs_mount_obj, vfs_lfs_mount);
+
+STATIC mp_obj_t vfs_lfs_umount(mp_obj_t self_in) {
+    (void)self_in;
+    // keep littlefs mounted internally so the VFS methods can still be used
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(lfs_vfs_umount_obj, vfs_lfs_umount);
+
+STATIC const mp_rom_map_elem_t lfs_vfs_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_open), MP_ROM_PTR(&lfs_vfs_open_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ilistdir), MP_ROM_PTR(&lfs_vfs_ilistdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mkdir), MP_ROM_PTR(&lfs_vfs_mkdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rmdir), MP_ROM_PTR(&lfs_vfs_rmdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_chdir), MP_ROM_PTR(&lfs_vfs_chdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_getcwd), MP_ROM_PTR(&lfs_vfs_getcwd_obj) },
+    { MP_ROM_QSTR(MP_QSTR_remove), MP_ROM_PTR(&lfs_vfs_remove_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rename), MP_ROM_PTR(&lfs_vfs_rename_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stat), MP_ROM_PTR(&lfs_vfs_stat_obj) },
+    { MP_ROM_QSTR(MP_QSTR_statvfs), MP_ROM_PTR(&lfs_vfs_statvfs_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mount), MP_ROM_PTR(&vfs_lfs_mount_obj) },
+    { MP_ROM_QSTR(MP_QSTR_umount), MP_ROM_PTR(&lfs_vfs_umount_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(lfs_vfs_locals_dict, lfs_vfs_locals_dict_table);
+
+STATIC const mp_vfs_proto_t lfs_vfs_proto = {
+    .import_stat = lfs_vfs_import_stat,
+};
+
+const mp_obj_type_t mp_lfs_vfs_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_VfsLfs,
+    .protocol = &lfs_vfs_proto,
+    .locals_dict = (mp_obj_dict_t*)&lfs_vfs_locals_dict,
+};
+
+#endif // MICROPY_VFS_LFS
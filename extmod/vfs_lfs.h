@@ -0,0 +1,91 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_EXTMOD_VFS_LFS_H
+#define MICROPY_INCLUDED_EXTMOD_VFS_LFS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "lib/littlefs/lfs.h"
+#include "extmod/vfs.h"
+
+// Bytes littlefs reads and programs at a time through its caches. It must
+// divide the block size of every device the filesystem is used on.
+#ifndef MICROPY_VFS_LFS_CACHE_SIZE
+#define MICROPY_VFS_LFS_CACHE_SIZE (256)
+#endif
+
+// Each byte of lookahead tracks whether eight blocks are free.
+#ifndef MICROPY_VFS_LFS_LOOKAHEAD_SIZE
+#define MICROPY_VFS_LFS_LOOKAHEAD_SIZE (16)
+#endif
+
+// A block device that littlefs talks to directly. Blocks are whole erase
+// blocks; littlefs reads and programs parts of them and erases them itself.
+// The functions return true on success.
+typedef struct {
+    uint32_t block_size;
+    uint32_t (*block_count)(void);
+    bool (*read)(uint32_t block, uint32_t offset, uint8_t* dest, uint32_t length);
+    bool (*program)(uint32_t block, uint32_t offset, const uint8_t* src, uint32_t length);
+    bool (*erase)(uint32_t block);
+} vfs_lfs_block_device_t;
+
+typedef struct _mp_obj_vfs_lfs_t {
+    mp_obj_base_t base;
+    const vfs_lfs_block_device_t* bdev;
+    bool readonly;
+    struct lfs_config config;
+    lfs_t lfs;
+    uint8_t read_buffer[MICROPY_VFS_LFS_CACHE_SIZE];
+    uint8_t prog_buffer[MICROPY_VFS_LFS_CACHE_SIZE];
+    uint32_t lookahead_buffer[MICROPY_VFS_LFS_LOOKAHEAD_SIZE / sizeof(uint32_t)];
+    // Absolute path of the current directory without a trailing /. Empty for
+    // the root.
+    char cur_dir[MICROPY_ALLOC_PATH_MAX + 1];
+} mp_obj_vfs_lfs_t;
+
+extern const mp_obj_type_t mp_lfs_vfs_type;
+extern const mp_obj_type_t mp_type_vfs_lfs_fileio;
+extern const mp_obj_type_t mp_type_vfs_lfs_textio;
+
+MP_DECLARE_CONST_FUN_OBJ_3(lfs_vfs_open_obj);
+
+// Sets up a filesystem object for the device and mounts it, formatting the
+// device first when format is true and there is no valid filesystem on it.
+// The object can live outside of the heap so that it stays mounted between
+// VM runs. Returns 0 or a negative littlefs error.
+int vfs_lfs_init(mp_obj_vfs_lfs_t* self, const vfs_lfs_block_device_t* bdev, bool format);
+
+// Builds the littlefs path for a path relative to the filesystem's current
+// directory. Returns the path itself when it is already absolute.
+const char* vfs_lfs_make_path(mp_obj_vfs_lfs_t* self, const char* path, char* buf);
+
+NORETURN void vfs_lfs_raise_error(int res);
+
+#endif  // MICROPY_INCLUDED_EXTMOD_VFS_LFS_H
@@ -0,0 +1,238 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/mpconfig.h"
+#if MICROPY_VFS && MICROPY_VFS_LFS
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "py/mperrno.h"
+#include "extmod/vfs_lfs.h"
+
+typedef struct _mp_obj_vfs_lfs_file_t {
+    mp_obj_base_t base;
+    mp_obj_vfs_lfs_t *vfs;
+    bool open;
+    lfs_file_t file;
+    struct lfs_file_config config;
+    // littlefs's cache for the file, given to it so that files don't need
+    // littlefs to allocate memory.
+    uint8_t buffer[MICROPY_VFS_LFS_CACHE_SIZE];
+} mp_obj_vfs_lfs_file_t;
+
+STATIC void file_obj_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    mp_printf(print, "<io.%s %p>", mp_obj_get_type_str(self_in), MP_OBJ_TO_PTR(self_in));
+}
+
+STATIC mp_uint_t file_obj_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *errcode) {
+    mp_obj_vfs_lfs_file_t *self = MP_OBJ_TO_PTR(self_in);
+    lfs_ssize_t sz_out = lfs_file_read(&self->vfs->lfs, &self->file, buf, size);
+    if (sz_out < 0) {
+        *errcode = sz_out == LFS_ERR_CORRUPT ? MP_EIO : -sz_out;
+        return MP_STREAM_ERROR;
+    }
+    return sz_out;
+}
+
+STATIC mp_uint_t file_obj_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
+    mp_obj_vfs_lfs_file_t *self = MP_OBJ_TO_PTR(self_in);
+    lfs_ssize_t sz_out = lfs_file_write(&self->vfs->lfs, &self->file, buf, size);
+    if (sz_out < 0) {
+        *errcode = sz_out == LFS_ERR_CORRUPT ? MP_EIO : -sz_out;
+        return MP_STREAM_ERROR;
+    }
+    return sz_out;
+}
+
+STATIC mp_obj_t file_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return mp_stream_close(args[0]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(file_obj___exit___obj, 4, 4, file_obj___exit__);
+
+STATIC mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    mp_obj_vfs_lfs_file_t *self = MP_OBJ_TO_PTR(o_in);
+    lfs_t *lfs = &self->vfs->lfs;
+
+    int res;
+    if (request == MP_STREAM_SEEK) {
+        struct mp_stream_seek_t *s = (struct mp_stream_seek_t*)(uintptr_t)arg;
+        // SEEK_SET, SEEK_CUR and SEEK_END have the same values in littlefs.
+        lfs_soff_t offset = lfs_file_seek(lfs, &self->file, s->offset, s->whence);
+        if (offset < 0) {
+            res = offset;
+        } else {
+            s->offset = offset;
+            return 0;
+        }
+
+    } else if (request == MP_STREAM_FLUSH) {
+        res = lfs_file_sync(lfs, &self->file);
+
+    } else if (request == MP_STREAM_CLOSE) {
+        // littlefs keeps a list of its open files so this must always run
+        // before the file object is freed.
+        if (!self->open) {
+            return 0;
+        }
+        self->open = false;
+        res = lfs_file_close(lfs, &self->file);
+
+    } else {
+        *errcode = MP_EINVAL;
+        return MP_STREAM_ERROR;
+    }
+
+    if (res < 0) {
+        *errcode = res == LFS_ERR_CORRUPT ? MP_EIO : -res;
+        return MP_STREAM_ERROR;
+    }
+    return 0;
+}
+
+STATIC mp_obj_t file_open(mp_obj_vfs_lfs_t *vfs, mp_obj_t path_in, mp_obj_t mode_in) {
+    const mp_obj_type_t *type = &mp_type_vfs_lfs_textio;
+    int flags = 0;
+    bool update = false;
+    const char *mode_s = mp_obj_str_get_str(mode_in);
+    while (*mode_s) {
+        switch (*mode_s++) {
+            case 'r':
+                flags |= LFS_O_RDONLY;
+                break;
+            case 'w':
+                flags |= LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC;
+                break;
+            case 'x':
+                flags |= LFS_O_WRONLY | LFS_O_CREAT | LFS_O_EXCL;
+                break;
+            case 'a':
+                flags |= LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND;
+                break;
+            case '+':
+                update = true;
+                break;
+            #if MICROPY_PY_IO_FILEIO
+            case 'b':
+                type = &mp_type_vfs_lfs_fileio;
+                break;
+            #endif
+            case 't':
+                type = &mp_type_vfs_lfs_textio;
+                break;
+        }
+    }
+    if (update) {
+        flags |= LFS_O_RDWR;
+    } else if ((flags & LFS_O_RDWR) == 0) {
+        flags |= LFS_O_RDONLY;
+    }
+    if ((flags & LFS_O_WRONLY) != 0 && vfs->readonly) {
+        mp_raise_OSError(MP_EROFS);
+    }
+
+    mp_obj_vfs_lfs_file_t *o = m_new_obj_with_finaliser(mp_obj_vfs_lfs_file_t);
+    o->base.type = type;
+    o->vfs = vfs;
+    o->open = false;
+    memset(&o->config, 0, sizeof(o->config));
+    o->config.buffer = o->buffer;
+
+    char buf[MICROPY_ALLOC_PATH_MAX + 1];
+    const char *path = vfs_lfs_make_path(vfs, mp_obj_str_get_str(path_in), buf);
+    int res = lfs_file_opencfg(&vfs->lfs, &o->file, path, flags, &o->config);
+    if (res != LFS_ERR_OK) {
+        m_del_obj(mp_obj_vfs_lfs_file_t, o);
+        vfs_lfs_raise_error(res);
+    }
+    o->open = true;
+
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC const mp_rom_map_elem_t rawfile_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&mp_stream_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readlines), MP_ROM_PTR(&mp_stream_unbuffered_readlines_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&mp_stream_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR_seek), MP_ROM_PTR(&mp_stream_seek_obj) },
+    { MP_ROM_QSTR(MP_QSTR_tell), MP_ROM_PTR(&mp_stream_tell_obj) },
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&mp_identity_obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&file_obj___exit___obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(rawfile_locals_dict, rawfile_locals_dict_table);
+
+#if MICROPY_PY_IO_FILEIO
+STATIC const mp_stream_p_t fileio_stream_p = {
+    .read = file_obj_read,
+    .write = file_obj_write,
+    .ioctl = file_obj_ioctl,
+};
+
+const mp_obj_type_t mp_type_vfs_lfs_fileio = {
+    { &mp_type_type },
+    .name = MP_QSTR_FileIO,
+    .print = file_obj_print,
+    .getiter = mp_identity_getiter,
+    .iternext = mp_stream_unbuffered_iter,
+    .protocol = &fileio_stream_p,
+    .locals_dict = (mp_obj_dict_t*)&rawfile_locals_dict,
+};
+#endif
+
+STATIC const mp_stream_p_t textio_stream_p = {
+    .read = file_obj_read,
+    .write = file_obj_write,
+    .ioctl = file_obj_ioctl,
+    .is_text = true,
+};
+
+const mp_obj_type_t mp_type_vfs_lfs_textio = {
+    { &mp_type_type },
+    .name = MP_QSTR_TextIOWrapper,
+    .print = file_obj_print,
+    .getiter = mp_identity_getiter,
+    .iternext = mp_stream_unbuffered_iter,
+    .protocol = &textio_stream_p,
+    .locals_dict = (mp_obj_dict_t*)&rawfile_locals_dict,
+};
+
+// Factory function for I/O stream classes
+STATIC mp_obj_t lfs_vfs_open(mp_obj_t self_in, mp_obj_t path, mp_obj_t mode) {
+    mp_obj_vfs_lfs_t *self = MP_OBJ_TO_PTR(self_in);
+    return file_open(self, path, mode);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(lfs_vfs_open_obj, lfs_vfs_open);
+
+#endif // MICROPY_VFS && MICROPY_VFS_LFS
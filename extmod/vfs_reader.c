@@ -34,22 +34,28 @@
 
 #if MICROPY_READER_VFS
 
+// Used when the heap can't spare MICROPY_READER_VFS_BUF_SIZE bytes.
+#define MP_READER_VFS_MIN_BUF_SIZE (24)
+
 typedef struct _mp_reader_vfs_t {
     mp_obj_t file;
+    uint16_t size;
     uint16_t len;
     uint16_t pos;
-    byte buf[24];
+    bool eof;
+    byte buf[];
 } mp_reader_vfs_t;
 
 STATIC mp_uint_t mp_reader_vfs_readbyte(void *data) {
     mp_reader_vfs_t *reader = (mp_reader_vfs_t*)data;
     if (reader->pos >= reader->len) {
-        if (reader->len < sizeof(reader->buf)) {
+        if (reader->eof) {
             return MP_READER_EOF;
         } else {
             int errcode;
-            reader->len = mp_stream_rw(reader->file, reader->buf, sizeof(reader->buf),
+            reader->len = mp_stream_rw(reader->file, reader->buf, reader->size,
                 &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+            reader->eof = reader->len < reader->size;
             if (errcode != 0) {
                 // TODO handle errors properly
                 return MP_READER_EOF;
@@ -66,18 +72,31 @@ STATIC mp_uint_t mp_reader_vfs_readbyte(void *data) {
 STATIC void mp_reader_vfs_close(void *data) {
     mp_reader_vfs_t *reader = (mp_reader_vfs_t*)data;
     mp_stream_close(reader->file);
-    m_del_obj(mp_reader_vfs_t, reader);
+    m_del_var(mp_reader_vfs_t, byte, reader->size, reader);
 }
 
 void mp_reader_new_file(mp_reader_t *reader, const char *filename) {
-    mp_reader_vfs_t *rf = m_new_obj(mp_reader_vfs_t);
+    uint16_t size = MICROPY_READER_VFS_BUF_SIZE;
+    mp_reader_vfs_t *rf = m_new_obj_var_maybe(mp_reader_vfs_t, byte, size);
+    if (rf == NULL) {
+        size = MP_READER_VFS_MIN_BUF_SIZE;
+        rf = m_new_obj_var(mp_reader_vfs_t, byte, size);
+    }
     mp_obj_t arg = mp_obj_new_str(filename, strlen(filename));
     rf->file = mp_vfs_open(1, &arg, (mp_map_t*)&mp_const_empty_map);
     int errcode;
-    rf->len = mp_stream_rw(rf->file, rf->buf, sizeof(rf->buf), &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+    rf->len = mp_stream_rw(rf->file, rf->buf, size, &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
     if (errcode != 0) {
         mp_raise_OSError(errcode);
     }
+    rf->eof = rf->len < size;
+    if (rf->eof && rf->len < size / 2) {
+        // The whole file fit so give back the rest of the buffer while it's compiled. Shrinking
+        // never moves the block.
+        (void)m_renew_maybe(byte, rf, sizeof(mp_reader_vfs_t) + size, sizeof(mp_reader_vfs_t) + rf->len, false);
+        size = rf->len;
+    }
+    rf->size = size;
     rf->pos = 0;
     reader->data = rf;
     reader->readbyte = mp_reader_vfs_readbyte;
@@ -3346,7 +3346,7 @@ FRESULT f_read (
     FATFS *fs;
     DWORD clst, sect;
     FSIZE_t remain;
-    UINT rcnt, cc, csect;
+    UINT rcnt, cc, csect, ncl;
     BYTE *rbuff = (BYTE*)buff;
 
 
@@ -3383,8 +3383,22 @@ FRESULT f_read (
             sect += csect;
             cc = btr / SS(fs);                  /* When remaining bytes >= sector size, */
             if (cc) {                           /* Read maximum contiguous sectors directly */
-                if (csect + cc > fs->csize) {   /* Clip at cluster boundary */
-                    cc = fs->csize - csect;
+                if (csect + cc > fs->csize) {   /* Clip at cluster boundary unless the following clusters are contiguous */
+                    ncl = 1;
+                    while ((ncl + 1) * fs->csize <= csect + cc) {
+#if _USE_FASTSEEK
+                        if (fp->cltbl) {
+                            clst = clmt_clust(fp, fp->fptr + ((FSIZE_t)ncl * fs->csize - csect) * SS(fs));
+                        } else
+#endif
+                        {
+                            clst = get_fat(&fp->obj, fp->clust);
+                        }
+                        if (clst != fp->clust + 1) break;   /* End of the fragment (errors are caught on the next cluster) */
+                        fp->clust = clst;
+                        ncl++;
+                    }
+                    cc = ncl * fs->csize - csect;
                 }
                 if (disk_read(fs->drv, rbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
 #if !_FS_READONLY && _FS_MINIMIZE <= 2          /* Replace one of the read sectors with cached data if it contains a dirty sector */
@@ -39,6 +39,7 @@
 #include "py/repl.h"
 #include "py/gc.h"
 #include "py/stackctrl.h"
+#include "py/mpthread.h"
 
 #include "lib/mp-readline/readline.h"
 #include "lib/utils/pyexec.h"
@@ -51,6 +52,7 @@
 #include "supervisor/port.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/shared/autoreload.h"
+#include "supervisor/shared/performance.h"
 #include "supervisor/shared/translate.h"
 #include "supervisor/shared/rgb_led_status.h"
 #include "supervisor/shared/safe_mode.h"
@@ -66,6 +68,13 @@
 #include "shared-module/board/__init__.h"
 #endif
 
+#if CIRCUITPY_STARTUP_PROFILE
+#include "supervisor/shared/profile.h"
+#define STARTUP_PROFILE_MARK(name) supervisor_profile_mark(name)
+#else
+#define STARTUP_PROFILE_MARK(name)
+#endif
+
 void do_str(const char *src, mp_parse_input_kind_t input_kind) {
     mp_lexer_t *lex = mp_lexer_new_from_str_len(MP_QSTR__lt_stdin_gt_, src, strlen(src), 0);
     if (lex == NULL) {
@@ -86,12 +95,21 @@ void do_str(const char *src, mp_parse_input_kind_t input_kind) {
     }
 }
 
+#if MICROPY_GC_MAX_AREAS > 1
+// Memory freed between supervisor allocations that the heap uses as well while the VM runs.
+static supervisor_allocation* heap_holes[MICROPY_GC_MAX_AREAS - 1];
+#endif
+
 void start_mp(supervisor_allocation* heap) {
     reset_status_led();
     autoreload_stop();
 
     background_tasks_reset();
 
+    #if MICROPY_PY_THREAD
+    mp_thread_init();
+    #endif
+
     // Stack limit should be less than real stack size, so we have a chance
     // to recover from limit hit.  (Limit is measured in bytes.)
     mp_stack_ctrl_init();
@@ -103,16 +121,44 @@ void start_mp(supervisor_allocation* heap) {
     mp_stack_fill_with_sentinel();
 #endif
 
-    // Sync the file systems in case any used RAM from the GC to cache. As soon
-    // as we re-init the GC all bets are off on the cache.
-    filesystem_flush();
+    // The file systems were synced by the caller before allocating the heap, so
+    // nothing can be cached in it yet.
 
     // Clear the readline history. It references the heap we're about to destroy.
     readline_init0();
 
+    uint32_t* heap_start = heap->ptr;
+    #if MICROPY_ENABLE_PYSTACK
+    if (pystack_alloc != NULL) {
+        mp_pystack_init(pystack_alloc->ptr, pystack_alloc->ptr + pystack_alloc->length / 4);
+    } else {
+        // There wasn't room for the Python stack on its own so take it from the heap.
+        mp_pystack_init(heap_start, heap_start + CIRCUITPY_DEFAULT_PYSTACK_SIZE / 4);
+        heap_start += CIRCUITPY_DEFAULT_PYSTACK_SIZE / 4;
+    }
+    #endif
+
     #if MICROPY_ENABLE_GC
-    gc_init(heap->ptr, heap->ptr + heap->length / 4);
+    #if MICROPY_GC_MAX_AREAS > 1
+    gc_area_t areas[MICROPY_GC_MAX_AREAS];
+    areas[0].start = heap_start;
+    areas[0].end = heap->ptr + heap->length / 4;
+    size_t n_areas = 1;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(heap_holes); i++) {
+        heap_holes[i] = allocate_largest_hole(1024);
+        if (heap_holes[i] == NULL) {
+            break;
+        }
+        areas[n_areas].start = heap_holes[i]->ptr;
+        areas[n_areas].end = heap_holes[i]->ptr + heap_holes[i]->length / 4;
+        n_areas++;
+    }
+    gc_init_areas(areas, n_areas);
+    #else
+    gc_init(heap_start, heap->ptr + heap->length / 4);
     #endif
+    #endif
+    STARTUP_PROFILE_MARK("gc_init");
     mp_init();
     mp_obj_list_init(mp_sys_path, 0);
     mp_obj_list_append(mp_sys_path, MP_OBJ_NEW_QSTR(MP_QSTR_)); // current dir (or base dir of the script)
@@ -127,9 +173,14 @@ void start_mp(supervisor_allocation* heap) {
     #if CIRCUITPY_NETWORK
     network_module_init();
     #endif
+    STARTUP_PROFILE_MARK("mp_init");
 }
 
 void stop_mp(void) {
+    #if MICROPY_PY_THREAD
+    mp_thread_deinit();
+    #endif
+
     #if CIRCUITPY_NETWORK
     network_module_deinit();
     #endif
@@ -142,6 +193,11 @@ void stop_mp(void) {
         vfs = vfs->next;
     }
     MP_STATE_VM(vfs_mount_table) = vfs;
+    // Start the next VM in CIRCUITPY, which comes after any other supervisor
+    // mounts.
+    while (vfs != NULL && vfs->next != NULL) {
+        vfs = vfs->next;
+    }
     MP_STATE_VM(vfs_cur) = vfs;
     #endif
 
@@ -180,16 +236,31 @@ void cleanup_after_vm(supervisor_allocation* heap) {
     // Turn off the display and flush the fileystem before the heap disappears.
     #if CIRCUITPY_DISPLAYIO
     reset_displays();
+    STARTUP_PROFILE_MARK("reset_displays");
     #endif
+    mp_hal_stdout_flush();
     filesystem_flush();
+    STARTUP_PROFILE_MARK("filesystem_flush");
     stop_mp();
     free_memory(heap);
+    #if MICROPY_GC_MAX_AREAS > 1
+    for (size_t i = 0; i < MP_ARRAY_SIZE(heap_holes); i++) {
+        if (heap_holes[i] != NULL) {
+            free_memory(heap_holes[i]);
+            heap_holes[i] = NULL;
+        }
+    }
+    #endif
     supervisor_move_memory();
+    STARTUP_PROFILE_MARK("stop_mp");
 
     reset_port();
+    supervisor_performance_reset();
+    STARTUP_PROFILE_MARK("reset_port");
     reset_board_busses();
     reset_board();
     reset_status_led();
+    STARTUP_PROFILE_MARK("reset_board");
 }
 
 bool run_code_py(safe_mode_t safe_mode) {
@@ -224,8 +295,10 @@ bool run_code_py(safe_mode_t safe_mode) {
         static const char *double_extension_filenames[] = STRING_LIST("code.txt.py", "code.py.txt", "code.txt.txt","code.py.py",
                                                     "main.txt.py", "main.py.txt", "main.txt.txt","main.py.py");
 
+        STARTUP_PROFILE_MARK("wait");
         stack_resize();
         filesystem_flush();
+        STARTUP_PROFILE_MARK("filesystem_flush");
         supervisor_allocation* heap = allocate_remaining_memory();
         start_mp(heap);
         found_main = maybe_run_list(supported_filenames, &result);
@@ -235,6 +308,11 @@ bool run_code_py(safe_mode_t safe_mode) {
                 serial_write_compressed(translate("WARNING: Your code filename has two extensions\n"));
             }
         }
+        #if CIRCUITPY_STARTUP_PROFILE
+        supervisor_profile_mark("code.py");
+        supervisor_profile_print();
+        supervisor_profile_reset();
+        #endif
         cleanup_after_vm(heap);
 
         if (result.return_code & PYEXEC_FORCED_EXIT) {
@@ -286,6 +364,7 @@ bool run_code_py(safe_mode_t safe_mode) {
         serial_connected_before_animation = serial_connected();
 
         tick_rgb_status_animation(&animation);
+        port_sleep_until_interrupt();
     }
 }
 
@@ -302,7 +381,7 @@ void __attribute__ ((noinline)) run_boot_py(safe_mode_t safe_mode) {
         boot_output_file = &file_pointer;
 
         // Get the base filesystem.
-        FATFS *fs = &((fs_user_mount_t *) MP_STATE_VM(vfs_mount_table)->obj)->fatfs;
+        FATFS *fs = &filesystem_circuitpy()->fatfs;
 
         bool have_boot_py = first_existing_file_in_list(boot_py_filenames) != NULL;
 
@@ -354,9 +433,11 @@ void __attribute__ ((noinline)) run_boot_py(safe_mode_t safe_mode) {
         // TODO(tannewt): Re-add support for flashing boot error output.
         bool found_boot = maybe_run_list(boot_py_filenames, NULL);
         (void) found_boot;
+        STARTUP_PROFILE_MARK("boot.py");
 
         #ifdef CIRCUITPY_BOOT_OUTPUT_FILE
         if (!skip_boot_output) {
+            mp_hal_stdout_flush();
             f_close(boot_output_file);
             filesystem_flush();
         }
@@ -380,6 +461,7 @@ int run_repl(void) {
     } else {
         exit_code = pyexec_friendly_repl();
     }
+    STARTUP_PROFILE_MARK("repl");
     cleanup_after_vm(heap);
     autoreload_resume();
     return exit_code;
@@ -391,14 +473,20 @@ int __attribute__((used)) main(void) {
     // initialise the cpu and peripherals
     safe_mode_t safe_mode = port_init();
 
+    #if CIRCUITPY_STARTUP_PROFILE
+    supervisor_profile_reset();
+    #endif
+
     // Turn on LEDs
     init_status_leds();
     rgb_led_status_init();
+    STARTUP_PROFILE_MARK("status_leds");
 
     // Wait briefly to give a reset window where we'll enter safe mode after the reset.
     if (safe_mode == NO_SAFE_MODE) {
         safe_mode = wait_for_safe_mode_reset();
     }
+    STARTUP_PROFILE_MARK("safe_mode_wait");
 
     stack_init();
 
@@ -406,10 +494,12 @@ int __attribute__((used)) main(void) {
     // A power brownout here could make it appear as if there's
     // no SPI flash filesystem, and we might erase the existing one.
     filesystem_init(safe_mode == NO_SAFE_MODE, false);
+    STARTUP_PROFILE_MARK("filesystem_init");
 
     // Reset everything and prep MicroPython to run boot.py.
     reset_port();
     reset_board();
+    STARTUP_PROFILE_MARK("reset_port");
 
     // Turn on autoreload by default but before boot.py in case it wants to change it.
     autoreload_enable();
@@ -423,6 +513,7 @@ int __attribute__((used)) main(void) {
 
     // Start serial and HID after giving boot.py a chance to tweak behavior.
     serial_init();
+    STARTUP_PROFILE_MARK("serial_init");
 
     // Boot script is finished, so now go into REPL/main mode.
     int exit_code = PYEXEC_FORCED_EXIT;
@@ -455,9 +546,16 @@ void gc_collect(void) {
     // This collects root pointers from the VFS mount table. Some of them may
     // have lost their references in the VM even though they are mounted.
     gc_collect_root((void**)&MP_STATE_VM(vfs_mount_table), sizeof(mp_vfs_mount_t) / sizeof(mp_uint_t));
+    board_gc_collect();
+
+    #if MICROPY_PY_THREAD
+    void* stack_end = mp_thread_gc_others(&_estack);
+    #else
+    void* stack_end = &_estack;
+    #endif
     // This naively collects all object references from an approximate stack
     // range.
-    gc_collect_root((void**)sp, ((uint32_t)&_estack - sp) / sizeof(uint32_t));
+    gc_collect_root((void**)sp, ((uint32_t)stack_end - sp) / sizeof(uint32_t));
     gc_collect_end();
 }
 
@@ -109,6 +109,7 @@ STATIC int usage(char **argv) {
 "-msmall-int-bits=number : set the maximum bits used to encode a small-int\n"
 "-mno-unicode : don't support unicode in compiled strings\n"
 "-mcache-lookup-bc : cache map lookups in the bytecode\n"
+"-mconst-tuple : load tuples of constants as constant objects\n"
 "\n"
 "Implementation specific options:\n", argv[0]
 );
@@ -193,6 +194,7 @@ MP_NOINLINE int main_(int argc, char **argv) {
     mp_dynamic_compiler.small_int_bits = 31;
     mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode = 0;
     mp_dynamic_compiler.py_builtins_str_unicode = 1;
+    mp_dynamic_compiler.comp_const_tuple = 0;
 
     const char *input_file = NULL;
     const char *output_file = NULL;
@@ -240,6 +242,10 @@ MP_NOINLINE int main_(int argc, char **argv) {
                 mp_dynamic_compiler.py_builtins_str_unicode = 0;
             } else if (strcmp(argv[a], "-municode") == 0) {
                 mp_dynamic_compiler.py_builtins_str_unicode = 1;
+            } else if (strcmp(argv[a], "-mno-const-tuple") == 0) {
+                mp_dynamic_compiler.comp_const_tuple = 0;
+            } else if (strcmp(argv[a], "-mconst-tuple") == 0) {
+                mp_dynamic_compiler.comp_const_tuple = 1;
             } else {
                 return usage(argv);
             }
@@ -25,6 +25,7 @@
  */
 
 #include "audio_dma.h"
+#include "tick.h"
 #include "samd/clocks.h"
 #include "samd/events.h"
 #include "samd/dma.h"
@@ -34,9 +35,17 @@
 
 #include "py/mpstate.h"
 #include "py/runtime.h"
+#include "supervisor/shared/performance.h"
 
 static audio_dma_t* audio_dma_state[AUDIO_DMA_CHANNEL_COUNT];
 
+static uint64_t audio_dma_now_us(void) {
+    uint64_t ms;
+    uint32_t us_until_ms;
+    current_tick(&ms, &us_until_ms);
+    return ms * 1000 + (1000 - us_until_ms);
+}
+
 // This cannot be in audio_dma_state because it's volatile.
 static volatile bool audio_dma_pending[AUDIO_DMA_CHANNEL_COUNT];
 
@@ -50,10 +59,15 @@ uint8_t find_free_audio_dma_channel(void) {
     return channel;
 }
 
+// Converting between signed and unsigned samples only flips the top bit of each sample, so the
+// conversion is a single XOR. Whole words are flipped at a time when the samples are contiguous,
+// either into one of our own buffers or straight back into the sample's.
 void audio_dma_convert_signed(audio_dma_t* dma, uint8_t* buffer, uint32_t buffer_length,
                               uint8_t** output_buffer, uint32_t* output_buffer_length,
                               uint8_t* output_spacing) {
-    if (dma->first_buffer_free) {
+    if (dma->convert_in_place) {
+        *output_buffer = buffer;
+    } else if (dma->first_buffer_free) {
         *output_buffer = dma->first_buffer;
     } else {
         *output_buffer = dma->second_buffer;
@@ -63,23 +77,31 @@ void audio_dma_convert_signed(audio_dma_t* dma, uint8_t* buffer, uint32_t buffer
     if (dma->signed_to_unsigned || dma->unsigned_to_signed) {
         *output_buffer_length = buffer_length / dma->spacing;
         *output_spacing = 1;
-        uint32_t out_i = 0;
-        if (dma->bytes_per_sample == 1) {
+        if (dma->spacing == 1 && ((uint32_t) buffer) % sizeof(uint32_t) == 0) {
+            uint32_t flip = 0x80008000;
+            if (dma->bytes_per_sample == 1) {
+                flip = 0x80808080;
+            }
+            uint32_t word_count = buffer_length / sizeof(uint32_t);
+            uint32_t* in = (uint32_t*) buffer;
+            uint32_t* out = (uint32_t*) *output_buffer;
+            for (uint32_t i = 0; i < word_count; i++) {
+                out[i] = in[i] ^ flip;
+            }
+            // Any trailing bytes are still whole samples.
+            for (uint32_t i = word_count * sizeof(uint32_t); i < buffer_length; i++) {
+                (*output_buffer)[i] = buffer[i] ^ (uint8_t) (flip >> (8 * (i % sizeof(uint32_t))));
+            }
+        } else if (dma->bytes_per_sample == 1) {
+            uint32_t out_i = 0;
             for (uint32_t i = 0; i < buffer_length; i += dma->spacing) {
-                if (dma->signed_to_unsigned) {
-                    ((uint8_t*) *output_buffer)[out_i] = ((int8_t*) buffer)[i] + 0x80;
-                } else {
-                    ((int8_t*) *output_buffer)[out_i] = ((uint8_t*) buffer)[i] - 0x80;
-                }
+                (*output_buffer)[out_i] = buffer[i] ^ 0x80;
                 out_i += 1;
             }
         } else if (dma->bytes_per_sample == 2) {
+            uint32_t out_i = 0;
             for (uint32_t i = 0; i < buffer_length / 2; i += dma->spacing) {
-                if (dma->signed_to_unsigned) {
-                    ((uint16_t*) *output_buffer)[out_i] = ((int16_t*) buffer)[i] + 0x8000;
-                } else {
-                    ((int16_t*) *output_buffer)[out_i] = ((uint16_t*) buffer)[i] - 0x8000;
-                }
+                ((uint16_t*) *output_buffer)[out_i] = ((uint16_t*) buffer)[i] ^ 0x8000;
                 out_i += 1;
             }
         }
@@ -117,6 +139,10 @@ void audio_dma_load_next_block(audio_dma_t* dma) {
         &output_spacing);
 
     descriptor->BTCNT.reg = output_buffer_length / dma->beat_size / output_spacing;
+    // Every beat is one frame.
+    if (dma->sample_rate > 0) {
+        dma->queued_block_us = (uint64_t) descriptor->BTCNT.reg * 1000000 / dma->sample_rate;
+    }
     descriptor->SRCADDR.reg = ((uint32_t) output_buffer) + output_buffer_length;
     if (get_buffer_result == GET_BUFFER_DONE) {
         if (dma->loop) {
@@ -165,9 +191,14 @@ audio_dma_result audio_dma_setup_playback(audio_dma_t* dma,
     dma->dma_channel = dma_channel;
     dma->signed_to_unsigned = false;
     dma->unsigned_to_signed = false;
+    dma->convert_in_place = false;
     dma->second_descriptor = NULL;
     dma->spacing = 1;
     dma->first_descriptor_free = true;
+    dma->underruns = 0;
+    dma->min_slack_us = -1;
+    dma->sample_rate = audiosample_sample_rate(sample);
+    dma->queued_block_us = 0;
     audiosample_reset_buffer(sample, single_channel, audio_channel);
 
     bool single_buffer;
@@ -178,17 +209,23 @@ audio_dma_result audio_dma_setup_playback(audio_dma_t* dma,
     uint8_t output_spacing = dma->spacing;
     if (output_signed != samples_signed) {
         output_spacing = 1;
-        max_buffer_length /= dma->spacing;
-        dma->first_buffer = (uint8_t*) m_malloc(max_buffer_length, false);
-        if (dma->first_buffer == NULL) {
-            return AUDIO_DMA_MEMORY_ERROR;
-        }
-        dma->first_buffer_free = true;
-        if (!single_buffer) {
-            dma->second_buffer = (uint8_t*) m_malloc(max_buffer_length, false);
-            if (dma->second_buffer == NULL) {
+        // RawSample buffers are the user's and get played again when looping. Other samples
+        // refill their buffers each time so contiguous samples can be converted where they are.
+        dma->convert_in_place = dma->spacing == 1 &&
+                                !MP_OBJ_IS_TYPE(sample, &audioio_rawsample_type);
+        if (!dma->convert_in_place) {
+            max_buffer_length /= dma->spacing;
+            dma->first_buffer = (uint8_t*) m_malloc(max_buffer_length, false);
+            if (dma->first_buffer == NULL) {
                 return AUDIO_DMA_MEMORY_ERROR;
             }
+            dma->first_buffer_free = true;
+            if (!single_buffer) {
+                dma->second_buffer = (uint8_t*) m_malloc(max_buffer_length, false);
+                if (dma->second_buffer == NULL) {
+                    return AUDIO_DMA_MEMORY_ERROR;
+                }
+            }
         }
         dma->signed_to_unsigned = !output_signed && samples_signed;
         dma->unsigned_to_signed = output_signed && !samples_signed;
@@ -252,6 +289,7 @@ audio_dma_result audio_dma_setup_playback(audio_dma_t* dma,
     }
 
     dma_configure(dma_channel, dma_trigger_source, true);
+    dma->last_poll_us = audio_dma_now_us();
     dma_enable_channel(dma_channel);
 
     return AUDIO_DMA_OK;
@@ -296,6 +334,14 @@ void audio_dma_reset(void) {
     }
 }
 
+uint32_t audio_dma_get_underruns(audio_dma_t* dma) {
+    return dma->underruns;
+}
+
+int32_t audio_dma_get_min_slack_us(audio_dma_t* dma) {
+    return dma->min_slack_us;
+}
+
 bool audio_dma_get_playing(audio_dma_t* dma) {
     if (dma->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
         return false;
@@ -321,15 +367,34 @@ void audio_dma_background(void) {
             continue;
         }
 
-        bool block_done = event_interrupt_active(dma->event_channel);
-        if (!block_done) {
-            continue;
-        }
-
         // audio_dma_load_next_block() can call Python code, which can call audio_dma_background()
         // recursively at the next background processing time. So disallow recursive calls to here.
         audio_dma_pending[i] = true;
-        audio_dma_load_next_block(dma);
+        // Check for overflow first because seeing the block finish clears it.
+        bool missed_block = event_interrupt_overflow(dma->event_channel);
+        bool block_done = event_interrupt_active(dma->event_channel);
+        if (block_done) {
+            if (missed_block) {
+                dma->underruns++;
+            }
+            // The block that just started must be replaced before it finishes. It started no
+            // earlier than the last time we found the DMA still busy, so this is a lower bound.
+            uint64_t deadline = dma->last_poll_us + dma->queued_block_us;
+            // Decoding long blocks speeds up when the CPU has been slowed down.
+            supervisor_performance_boost();
+            audio_dma_load_next_block(dma);
+            supervisor_performance_unboost();
+            uint64_t now = audio_dma_now_us();
+            int32_t slack = now < deadline ? (int32_t) (deadline - now) : 0;
+            if (dma->min_slack_us < 0 || slack < dma->min_slack_us) {
+                dma->min_slack_us = slack;
+            }
+            dma->last_poll_us = now;
+        } else {
+            dma->last_poll_us = audio_dma_now_us();
+            // Let the sample read ahead while the DMA is busy with the current block.
+            audiosample_background(dma->sample);
+        }
         audio_dma_pending[i] = false;
     }
 }
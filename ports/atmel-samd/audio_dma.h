@@ -44,11 +44,22 @@ typedef struct {
     bool single_channel;
     bool signed_to_unsigned;
     bool unsigned_to_signed;
+    // The sample's buffers are refilled on every load so the conversion can overwrite them
+    // instead of copying into first_buffer and second_buffer.
+    bool convert_in_place;
     bool first_buffer_free;
     uint8_t* first_buffer;
     uint8_t* second_buffer;
     bool first_descriptor_free;
     DmacDescriptor* second_descriptor;
+    // Playback health since playback was set up. A block underruns when the DMA finishes the one
+    // after it before it is reloaded, so stale data plays. Slack is how long a reload had left
+    // before it would have been late.
+    uint32_t underruns;
+    int32_t min_slack_us;
+    uint32_t sample_rate;
+    uint32_t queued_block_us;
+    uint64_t last_poll_us;
 } audio_dma_t;
 
 typedef enum {
@@ -88,6 +99,9 @@ bool audio_dma_get_playing(audio_dma_t* dma);
 void audio_dma_pause(audio_dma_t* dma);
 void audio_dma_resume(audio_dma_t* dma);
 bool audio_dma_get_paused(audio_dma_t* dma);
+uint32_t audio_dma_get_underruns(audio_dma_t* dma);
+// Negative until a block has been reloaded during playback.
+int32_t audio_dma_get_min_slack_us(audio_dma_t* dma);
 
 void audio_dma_background(void);
 
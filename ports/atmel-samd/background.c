@@ -28,20 +28,59 @@
 #include "audio_dma.h"
 #include "tick.h"
 #include "supervisor/filesystem.h"
+#include "supervisor/serial.h"
 #include "supervisor/usb.h"
 
 #include "py/runtime.h"
 #include "shared-module/network/__init__.h"
 #include "supervisor/shared/stack.h"
 
+#if CIRCUITPY_ANALOGIO
+#include "common-hal/analogio/AnalogIn.h"
+#endif
+
+#if CIRCUITPY_AUDIOBUSIO
+#include "common-hal/audiobusio/PDMIn.h"
+#endif
+
+#if CIRCUITPY_BUSIO
+#include "common-hal/busio/UART.h"
+#endif
+
+#if CIRCUITPY_KEYPAD
+#include "shared-module/keypad/__init__.h"
+#endif
+
+#if CIRCUITPY_NVM
+#include "common-hal/nvm/ByteArray.h"
+#endif
+
+#if CIRCUITPY_PEW
+#include "shared-module/_pew/PewPew.h"
+#endif
+
+#if CIRCUITPY_PULSEIO
+#include "common-hal/pulseio/PulseIn.h"
+#endif
+
 #ifdef CIRCUITPY_DISPLAYIO
 #include "shared-module/displayio/__init__.h"
 #endif
 
+#if CIRCUITPY_ROTARYIO
+#include "common-hal/rotaryio/IncrementalEncoder.h"
+#endif
+
+#if CIRCUITPY_TOUCHIO
+#include "common-hal/touchio/TouchIn.h"
+#endif
+
 volatile uint64_t last_finished_tick = 0;
 
 bool stack_ok_so_far = true;
 
+volatile uint8_t background_tasks_pending = 0;
+
 static bool running_background_tasks = false;
 
 void background_tasks_reset(void) {
@@ -53,12 +92,41 @@ void run_background_tasks(void) {
     if (running_background_tasks) {
         return;
     }
+    // Clear it first so a request made while the tasks run isn't lost.
+    background_tasks_pending = 0;
     assert_heap_ok();
     running_background_tasks = true;
 
     #if (defined(SAMD21) && defined(PIN_PA02)) || defined(SAMD51)
     audio_dma_background();
     #endif
+    #if CIRCUITPY_AUDIOBUSIO
+    pdmin_background();
+    #endif
+    #if CIRCUITPY_ANALOGIO
+    analogin_background();
+    #endif
+    #if CIRCUITPY_BUSIO
+    uart_background();
+    #endif
+    #if CIRCUITPY_PEW
+    pew_background();
+    #endif
+    #if CIRCUITPY_PULSEIO
+    pulsein_background();
+    #endif
+    #if CIRCUITPY_ROTARYIO
+    incrementalencoder_background();
+    #endif
+    #if CIRCUITPY_TOUCHIO
+    touchin_background();
+    #endif
+    #if CIRCUITPY_KEYPAD
+    keypad_background();
+    #endif
+    #if CIRCUITPY_NVM
+    nvm_bytearray_background();
+    #endif
     #if CIRCUITPY_DISPLAYIO
     displayio_refresh_displays();
     #endif
@@ -67,6 +135,7 @@ void run_background_tasks(void) {
     network_module_background();
     #endif
     filesystem_background();
+    mp_hal_stdout_flush();
     usb_background();
     running_background_tasks = false;
     assert_heap_ok();
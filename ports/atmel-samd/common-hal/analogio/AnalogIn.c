@@ -34,18 +34,46 @@
 #include "py/binary.h"
 #include "py/mphal.h"
 
+#include "audio_dma.h"
+#include "timer_handler.h"
+
 #include "samd/adc.h"
+#include "samd/dma.h"
+#include "samd/events.h"
+#include "samd/timers.h"
 #include "shared-bindings/analogio/AnalogIn.h"
 #include "supervisor/shared/translate.h"
 
 #include "atmel_start_pins.h"
 #include "hal/include/hal_adc_sync.h"
+#include "hal/utils/include/utils.h"
 #include "hpl/gclk/hpl_gclk_base.h"
 
 #ifdef SAMD21
 #include "hpl/pm/hpl_pm_base.h"
 #endif
 
+// Samples per DMA block. The background task has one block's time, 5ms at 100kHz, to copy a
+// finished block out before the DMA comes back around to it.
+#define SAMPLES_PER_BLOCK 512
+
+#ifdef SAMD21
+#define MAX_SAMPLE_RATE 100000
+#define FIRST_TC_GEN_ID EVSYS_ID_GEN_TC3_OVF
+static const uint8_t adc_dma_triggers[] = { ADC_DMAC_ID_RESRDY };
+static const uint8_t adc_start_users[] = { EVSYS_ID_USER_ADC_START };
+#endif
+#ifdef SAMD51
+#define MAX_SAMPLE_RATE 250000
+#define FIRST_TC_GEN_ID EVSYS_ID_GEN_TC0_OVF
+static const uint8_t adc_dma_triggers[] = { ADC0_DMAC_ID_RESRDY, ADC1_DMAC_ID_RESRDY };
+static const uint8_t adc_start_users[] = { EVSYS_ID_USER_ADC0_START, EVSYS_ID_USER_ADC1_START };
+#endif
+
+// Each ADC can only sample one pin in the background. The objects are kept alive by the
+// playing_audio root pointer for their DMA channel.
+static analogio_analogin_obj_t* active_samplers[ADC_INST_NUM];
+
 void common_hal_analogio_analogin_construct(analogio_analogin_obj_t* self,
         const mcu_pin_obj_t *pin) {
     uint8_t adc_index;
@@ -68,8 +96,10 @@ void common_hal_analogio_analogin_construct(analogio_analogin_obj_t* self,
 
     static Adc* adc_insts[] = ADC_INSTS;
     self->instance = adc_insts[adc_index];
+    self->adc_index = adc_index;
     self->channel = adc_channel;
     self->pin = pin;
+    self->sampling = false;
 }
 
 bool common_hal_analogio_analogin_deinited(analogio_analogin_obj_t *self) {
@@ -80,36 +110,72 @@ void common_hal_analogio_analogin_deinit(analogio_analogin_obj_t *self) {
     if (common_hal_analogio_analogin_deinited(self)) {
         return;
     }
+    common_hal_analogio_analogin_stop(self);
     reset_pin_number(self->pin->number);
     self->pin = mp_const_none;
 }
 
-void analogin_reset() {
+static void stop_sampling_hardware(analogio_analogin_obj_t* self) {
+    disable_event_channel(self->timer_event_channel);
+    disable_event_user(adc_start_users[self->adc_index]);
+    disable_event_channel(self->event_channel);
+    tc_set_enable(tc_insts[self->tc_index], false);
+    dma_disable_channel(self->dma_channel);
+    self->instance->CTRLA.bit.ENABLE = 0;
+    #ifdef SAMD21
+    while (self->instance->STATUS.bit.SYNCBUSY == 1) {}
+    #endif
+    #ifdef SAMD51
+    while (self->instance->SYNCBUSY.bit.ENABLE == 1) {}
+    #endif
+    self->instance->EVCTRL.reg = 0;
 }
 
-uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t *self) {
-    // Something else might have used the ADC in a different way,
-    // so we completely re-initialize it.
-
-    struct adc_sync_descriptor adc;
+void analogin_reset() {
+    for (uint8_t i = 0; i < ADC_INST_NUM; i++) {
+        if (active_samplers[i] != NULL) {
+            stop_sampling_hardware(active_samplers[i]);
+            tc_reset(tc_insts[active_samplers[i]->tc_index]);
+            active_samplers[i] = NULL;
+        }
+    }
+}
 
-    samd_peripherals_adc_setup(&adc, self->instance);
+// Sets up the ADC the same way for single reads and sampling. The ADC is left enabled.
+static void configure_adc(analogio_analogin_obj_t *self, struct adc_sync_descriptor* adc) {
+    samd_peripherals_adc_setup(adc, self->instance);
 
     // Full scale is 3.3V (VDDANA) = 65535.
 
     // On SAMD21, INTVCC1 is 0.5*VDDANA. On SAMD51, INTVCC1 is 1*VDDANA.
     // So on SAMD21 only, divide the input by 2, so full scale will match 0.5*VDDANA.
-    adc_sync_set_reference(&adc, ADC_REFCTRL_REFSEL_INTVCC1_Val);
+    adc_sync_set_reference(adc, ADC_REFCTRL_REFSEL_INTVCC1_Val);
     #ifdef SAMD21
-    adc_sync_set_channel_gain(&adc, self->channel, ADC_INPUTCTRL_GAIN_DIV2_Val);
+    adc_sync_set_channel_gain(adc, self->channel, ADC_INPUTCTRL_GAIN_DIV2_Val);
     #endif
 
-    adc_sync_set_resolution(&adc, ADC_CTRLB_RESSEL_12BIT_Val);
+    adc_sync_set_resolution(adc, ADC_CTRLB_RESSEL_12BIT_Val);
 
-    adc_sync_enable_channel(&adc, self->channel);
+    adc_sync_enable_channel(adc, self->channel);
 
     // We need to set the inputs because the above channel enable only enables the ADC.
-    adc_sync_set_inputs(&adc, self->channel, ADC_INPUTCTRL_MUXNEG_GND_Val, self->channel);
+    adc_sync_set_inputs(adc, self->channel, ADC_INPUTCTRL_MUXNEG_GND_Val, self->channel);
+}
+
+uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t *self) {
+    analogio_analogin_obj_t* sampler = active_samplers[self->adc_index];
+    if (sampler == self) {
+        // Reading RESULT ourselves would steal a sample from the DMA.
+        return self->last_value;
+    } else if (sampler != NULL) {
+        mp_raise_RuntimeError(translate("ADC in use"));
+    }
+
+    // Something else might have used the ADC in a different way,
+    // so we completely re-initialize it.
+
+    struct adc_sync_descriptor adc;
+    configure_adc(self, &adc);
 
     // Read twice and discard first result, as recommended in section 14 of
     // http://www.atmel.com/images/Atmel-42645-ADC-Configurations-with-Examples_ApplicationNote_AT11481.pdf
@@ -129,3 +195,238 @@ uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t *self) {
 float common_hal_analogio_analogin_get_reference_voltage(analogio_analogin_obj_t *self) {
     return 3.3f;
 }
+
+static void setup_descriptor(analogio_analogin_obj_t* self, DmacDescriptor* descriptor,
+                             uint16_t* block, DmacDescriptor* next) {
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_BLOCKACT_NOACT |
+                             DMAC_BTCTRL_EVOSEL_BLOCK |
+                             DMAC_BTCTRL_DSTINC |
+                             DMAC_BTCTRL_BEATSIZE_HWORD;
+    descriptor->BTCNT.reg = SAMPLES_PER_BLOCK;
+    descriptor->SRCADDR.reg = (uint32_t) &self->instance->RESULT.reg;
+    descriptor->DSTADDR.reg = (uint32_t) (block + SAMPLES_PER_BLOCK);
+    descriptor->DESCADDR.reg = (uint32_t) next;
+}
+
+static void start_sampling_hardware(analogio_analogin_obj_t* self) {
+    struct adc_sync_descriptor adc;
+    configure_adc(self, &adc);
+
+    // Conversions are started by the timer event from now on. The prescaler can only be
+    // changed while the ADC is off.
+    Adc* instance = self->instance;
+    instance->CTRLA.bit.ENABLE = 0;
+    #ifdef SAMD21
+    while (instance->STATUS.bit.SYNCBUSY == 1) {}
+    // 48MHz / 32 is within the 2.1MHz ADC clock limit.
+    instance->CTRLB.bit.PRESCALER = ADC_CTRLB_PRESCALER_DIV32_Val;
+    while (instance->STATUS.bit.SYNCBUSY == 1) {}
+    #endif
+    #ifdef SAMD51
+    while (instance->SYNCBUSY.bit.ENABLE == 1) {}
+    instance->CTRLA.bit.PRESCALER = ADC_CTRLA_PRESCALER_DIV8_Val;
+    #endif
+    instance->EVCTRL.reg = ADC_EVCTRL_STARTEI;
+
+    DmacDescriptor* first_descriptor = dma_descriptor(self->dma_channel);
+    setup_descriptor(self, first_descriptor, self->blocks, self->second_descriptor);
+    setup_descriptor(self, self->second_descriptor, self->blocks + SAMPLES_PER_BLOCK,
+                     first_descriptor);
+    dma_configure(self->dma_channel, adc_dma_triggers[self->adc_index], true);
+    init_event_channel_interrupt(self->event_channel, CORE_GCLK,
+                                 EVSYS_ID_GEN_DMAC_CH_0 + self->dma_channel);
+    self->next_block = 0;
+    dma_enable_channel(self->dma_channel);
+
+    instance->CTRLA.bit.ENABLE = 1;
+    #ifdef SAMD21
+    while (instance->STATUS.bit.SYNCBUSY == 1) {}
+    #endif
+    #ifdef SAMD51
+    while (instance->SYNCBUSY.bit.ENABLE == 1) {}
+    #endif
+
+    connect_event_user_to_channel(adc_start_users[self->adc_index], self->timer_event_channel);
+    init_async_event_channel(self->timer_event_channel, FIRST_TC_GEN_ID + 3 * self->tc_index);
+    tc_set_enable(tc_insts[self->tc_index], true);
+}
+
+// Runs the timer at the closest rate it can to the one asked for and returns that rate.
+static uint32_t configure_timer(analogio_analogin_obj_t* self, uint32_t sample_rate) {
+    // We use GCLK0 for SAMD21 and GCLK1 for SAMD51 because they both run at 48mhz.
+    uint8_t tc_gclk = 0;
+    #ifdef SAMD51
+    tc_gclk = 1;
+    #endif
+    set_timer_handler(true, self->tc_index, TC_HANDLER_NO_INTERRUPT);
+    turn_on_clocks(true, self->tc_index, tc_gclk);
+
+    uint32_t system_clock = 48000000;
+    uint32_t top;
+    uint8_t divisor;
+    for (divisor = 0; divisor < 8; divisor++) {
+        top = (system_clock / prescaler[divisor] + sample_rate / 2) / sample_rate - 1;
+        if (top < (1u << 16)) {
+            break;
+        }
+    }
+
+    Tc* t = tc_insts[self->tc_index];
+    tc_set_enable(t, false);
+    tc_reset(t);
+    #ifdef SAMD51
+    t->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+    #endif
+    #ifdef SAMD21
+    t->COUNT16.CTRLA.bit.WAVEGEN = TC_CTRLA_WAVEGEN_MFRQ_Val;
+    #endif
+    t->COUNT16.CTRLA.bit.PRESCALER = divisor;
+    t->COUNT16.EVCTRL.reg = TC_EVCTRL_OVFEO;
+    t->COUNT16.CC[0].reg = top;
+    tc_wait_for_sync(t);
+    return system_clock / prescaler[divisor] / (top + 1);
+}
+
+void common_hal_analogio_analogin_start(analogio_analogin_obj_t* self, uint32_t sample_rate,
+                                        uint32_t buffer_length) {
+    common_hal_analogio_analogin_stop(self);
+
+    if (sample_rate > MAX_SAMPLE_RATE) {
+        mp_raise_ValueError_varg(translate("Sample rate too high. It must be less than %d"),
+                                 MAX_SAMPLE_RATE);
+    }
+    if (active_samplers[self->adc_index] != NULL) {
+        mp_raise_RuntimeError(translate("ADC in use"));
+    }
+
+    self->blocks = m_malloc(2 * SAMPLES_PER_BLOCK * sizeof(uint16_t), false);
+    self->second_descriptor = m_malloc(sizeof(DmacDescriptor), false);
+    self->ring = m_malloc(buffer_length * sizeof(uint16_t), false);
+
+    self->dma_channel = find_free_audio_dma_channel();
+    if (self->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    }
+    turn_on_event_system();
+    self->event_channel = find_sync_event_channel();
+    if (self->event_channel >= EVSYS_SYNCH_NUM) {
+        mp_raise_RuntimeError(translate("All sync event channels in use"));
+    }
+    // Claim the sync channel before looking for the async one so we don't get it twice.
+    init_event_channel_interrupt(self->event_channel, CORE_GCLK,
+                                 EVSYS_ID_GEN_DMAC_CH_0 + self->dma_channel);
+    self->timer_event_channel = find_async_event_channel();
+    if (self->timer_event_channel >= EVSYS_CHANNELS) {
+        disable_event_channel(self->event_channel);
+        mp_raise_RuntimeError(translate("All event channels in use"));
+    }
+    self->tc_index = find_free_timer();
+    if (self->tc_index == 0xff) {
+        disable_event_channel(self->event_channel);
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+
+    self->ring_length = buffer_length;
+    self->ring_start = 0;
+    self->ring_count = 0;
+    self->overruns = 0;
+    self->last_value = 0;
+
+    self->sample_rate = configure_timer(self, sample_rate);
+    start_sampling_hardware(self);
+    self->sampling = true;
+    active_samplers[self->adc_index] = self;
+
+    // The background task finds us through the root pointer, which also keeps our buffers alive
+    // while the DMA writes to them.
+    MP_STATE_PORT(playing_audio)[self->dma_channel] = self;
+}
+
+void common_hal_analogio_analogin_stop(analogio_analogin_obj_t* self) {
+    if (!self->sampling) {
+        return;
+    }
+    stop_sampling_hardware(self);
+    tc_reset(tc_insts[self->tc_index]);
+    active_samplers[self->adc_index] = NULL;
+    MP_STATE_PORT(playing_audio)[self->dma_channel] = NULL;
+    self->sampling = false;
+    self->blocks = NULL;
+    self->second_descriptor = NULL;
+    self->ring = NULL;
+}
+
+bool common_hal_analogio_analogin_get_sampling(analogio_analogin_obj_t* self) {
+    return self->sampling;
+}
+
+uint32_t common_hal_analogio_analogin_get_sample_rate(analogio_analogin_obj_t* self) {
+    return self->sample_rate;
+}
+
+uint32_t common_hal_analogio_analogin_get_overruns(analogio_analogin_obj_t* self) {
+    return self->overruns;
+}
+
+uint32_t common_hal_analogio_analogin_readinto(analogio_analogin_obj_t* self,
+        uint16_t* output_buffer, uint32_t output_buffer_length) {
+    if (!self->sampling) {
+        return 0;
+    }
+    uint32_t count = min(output_buffer_length, self->ring_count);
+    for (uint32_t i = 0; i < count; i++) {
+        output_buffer[i] = self->ring[self->ring_start];
+        self->ring_start++;
+        if (self->ring_start == self->ring_length) {
+            self->ring_start = 0;
+        }
+    }
+    self->ring_count -= count;
+    return count;
+}
+
+// Copies a finished block into the ring, scaled to 16 bits. Samples that don't fit are dropped
+// and counted.
+static void copy_block(analogio_analogin_obj_t* self, uint16_t* block) {
+    uint32_t space = self->ring_length - self->ring_count;
+    uint32_t count = min(space, (uint32_t) SAMPLES_PER_BLOCK);
+    if (count < SAMPLES_PER_BLOCK) {
+        self->overruns++;
+    }
+    uint32_t end = self->ring_start + self->ring_count;
+    if (end >= self->ring_length) {
+        end -= self->ring_length;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        self->ring[end] = block[i] << 4;
+        end++;
+        if (end == self->ring_length) {
+            end = 0;
+        }
+    }
+    self->ring_count += count;
+    self->last_value = block[SAMPLES_PER_BLOCK - 1] << 4;
+}
+
+void analogin_background(void) {
+    for (uint8_t i = 0; i < ADC_INST_NUM; i++) {
+        analogio_analogin_obj_t* self = active_samplers[i];
+        if (self == NULL) {
+            continue;
+        }
+        if (event_interrupt_overflow(self->event_channel)) {
+            // A block was overwritten before we got to it so we no longer know which block the DMA
+            // is filling. Start again from the first one.
+            self->overruns++;
+            stop_sampling_hardware(self);
+            start_sampling_hardware(self);
+            continue;
+        }
+        if (!event_interrupt_active(self->event_channel)) {
+            continue;
+        }
+        copy_block(self, self->blocks + self->next_block * SAMPLES_PER_BLOCK);
+        self->next_block = 1 - self->next_block;
+    }
+}
@@ -35,9 +35,29 @@ typedef struct {
     mp_obj_base_t base;
     const mcu_pin_obj_t * pin;
     Adc* instance;
+    uint8_t adc_index;
     uint8_t channel;
+    // Continuous sampling state. A timer event starts each conversion, the DMA loops over two
+    // blocks of results and the background task copies each finished block into the ring.
+    bool sampling;
+    uint8_t tc_index;
+    uint8_t timer_event_channel;
+    uint8_t dma_channel;
+    uint8_t event_channel;
+    uint8_t next_block;
+    uint32_t sample_rate;
+    uint16_t* blocks;
+    DmacDescriptor* second_descriptor;
+    uint16_t* ring;
+    uint32_t ring_length;
+    uint32_t ring_start;
+    uint32_t ring_count;
+    uint32_t overruns;
+    uint16_t last_value;
 } analogio_analogin_obj_t;
 
 void analogin_reset(void);
 
+void analogin_background(void);
+
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_ANALOGIO_ANALOGIN_H
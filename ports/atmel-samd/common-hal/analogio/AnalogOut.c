@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "lib/utils/interrupt_char.h"
 #include "py/mperrno.h"
 #include "py/runtime.h"
 
@@ -44,11 +45,136 @@
 #include "hpl/pm/hpl_pm_base.h"
 #endif
 
+#include "audio_dma.h"
+#include "timer_handler.h"
+
+#include "samd/dma.h"
+#include "samd/timers.h"
+
+#if (defined(SAMD21) && defined(PIN_PA02)) || defined(SAMD51)
+// Playback writes straight into DATA on every overflow of a timer running at the sample rate, so
+// the DAC itself stays configured as it is for value.
+#ifdef SAMD21
+#define MAX_SAMPLE_RATE 350000
+#endif
+#ifdef SAMD51
+#define MAX_SAMPLE_RATE 1000000
+#endif
+
+static volatile void* dac_data_register(analogio_analogout_obj_t* self) {
+    #ifdef SAMD21
+    return &DAC->DATA.reg;
+    #endif
+    #ifdef SAMD51
+    return &DAC->DATA[self->channel].reg;
+    #endif
+}
+
+static DmacDescriptor* stream_descriptor(analogio_analogout_obj_t* self, uint8_t index) {
+    if (index == 0) {
+        return dma_descriptor(self->dma_channel);
+    }
+    return self->second_descriptor;
+}
+
+static void setup_stream_descriptor(analogio_analogout_obj_t* self, DmacDescriptor* descriptor,
+                                    const uint8_t* data, uint32_t sample_count,
+                                    uint8_t bytes_per_sample, bool loop) {
+    uint32_t beat_size = DMAC_BTCTRL_BEATSIZE_HWORD;
+    uint32_t destination = (uint32_t) dac_data_register(self);
+    if (bytes_per_sample == 1) {
+        beat_size = DMAC_BTCTRL_BEATSIZE_BYTE;
+        // DATA is left adjusted so a byte goes in the top half.
+        destination += 1;
+    }
+    descriptor->BTCTRL.reg = beat_size | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = sample_count;
+    // The source address is the end of the block when incrementing.
+    descriptor->SRCADDR.reg = ((uint32_t) data) + sample_count * bytes_per_sample;
+    descriptor->DSTADDR.reg = destination;
+    descriptor->DESCADDR.reg = loop ? (uint32_t) descriptor : 0;
+    descriptor->BTCTRL.bit.VALID = true;
+}
+
+// True once the DMA has moved on to the most recently queued descriptor, so the other one is free
+// to be rewritten. The write-back descriptor is the copy the DMA fetched for the block in flight.
+static bool active_descriptor_started(analogio_analogout_obj_t* self) {
+    DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+    DmacDescriptor* active = stream_descriptor(self, self->active_descriptor);
+    return write_back[self->dma_channel].SRCADDR.reg == active->SRCADDR.reg &&
+           write_back[self->dma_channel].DESCADDR.reg == active->DESCADDR.reg;
+}
+
+static void set_timer_frequency(Tc* timer, uint32_t frequency) {
+    uint32_t system_clock = 48000000;
+    uint32_t new_top;
+    uint8_t new_divisor;
+    for (new_divisor = 0; new_divisor < 8; new_divisor++) {
+        new_top = (system_clock / prescaler[new_divisor] / frequency) - 1;
+        if (new_top < (1u << 16)) {
+            break;
+        }
+    }
+    timer->COUNT16.CTRLA.bit.PRESCALER = new_divisor;
+    timer->COUNT16.CC[0].reg = new_top;
+}
+
+// Claim a timer and a DMA channel and set the timer up for the sample rate. It is left stopped.
+static void claim_stream(analogio_analogout_obj_t* self, uint32_t sample_rate) {
+    Tc* tc = NULL;
+    uint8_t tc_index = TC_INST_NUM;
+    for (uint8_t i = TC_INST_NUM; i > 0; i--) {
+        if (tc_insts[i - 1]->COUNT16.CTRLA.bit.ENABLE == 0) {
+            tc = tc_insts[i - 1];
+            tc_index = i - 1;
+            break;
+        }
+    }
+    if (tc == NULL) {
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+    uint8_t dma_channel = find_free_audio_dma_channel();
+    if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    }
+    if (self->second_descriptor == NULL) {
+        self->second_descriptor = (DmacDescriptor*) m_malloc(sizeof(DmacDescriptor), false);
+    }
+    self->tc_index = tc_index;
+    self->dma_channel = dma_channel;
+    MP_STATE_PORT(analogout_streams)[self->channel] = self;
+
+    // Use the 48mhz clocks on both the SAMD21 and 51 so the period math is the same.
+    set_timer_handler(true, tc_index, TC_HANDLER_NO_INTERRUPT);
+    #ifdef SAMD21
+    turn_on_clocks(true, tc_index, 0);
+    #endif
+    #ifdef SAMD51
+    turn_on_clocks(true, tc_index, 1);
+    #endif
+    // Resetting the timer also drops any DMA request left over from earlier use.
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    #ifdef SAMD21
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_WAVEGEN_MFRQ;
+    #endif
+    #ifdef SAMD51
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16;
+    tc->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+    #endif
+    set_timer_frequency(tc, sample_rate);
+}
+#endif
+
 void common_hal_analogio_analogout_construct(analogio_analogout_obj_t* self,
         const mcu_pin_obj_t *pin) {
     #if defined(SAMD21) && !defined(PIN_PA02)
     mp_raise_NotImplementedError(translate("No DAC on chip"));
     #else
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->tc_index = TC_INST_NUM;
+    self->second_descriptor = NULL;
+
     if (pin->number != PIN_PA02
     #ifdef SAMD51
         && pin->number != PIN_PA05
@@ -108,11 +234,97 @@ bool common_hal_analogio_analogout_deinited(analogio_analogout_obj_t *self) {
     return self->deinited;
 }
 
+void common_hal_analogio_analogout_play(analogio_analogout_obj_t *self, mp_obj_t buffer,
+        const uint8_t* data, uint32_t sample_count, uint8_t bytes_per_sample,
+        uint32_t sample_rate, bool loop) {
+    #if (defined(SAMD21) && defined(PIN_PA02)) || defined(SAMD51)
+    if (sample_rate > MAX_SAMPLE_RATE) {
+        mp_raise_ValueError_varg(translate("Sample rate too high. It must be less than %d"), MAX_SAMPLE_RATE);
+    }
+    if (sample_count > 0xffff) {
+        mp_raise_ValueError_varg(translate("%q length must be <= %d"), MP_QSTR_buffer, 0xffff);
+    }
+
+    // A looping buffer at the same rate is replaced without a gap: the DMA fetches its descriptor
+    // again at the end of the current pass and follows it on to the new buffer.
+    if (self->loop && self->sample_rate == sample_rate &&
+        common_hal_analogio_analogout_get_playing(self)) {
+        // Wait for the previous replacement to start so the other descriptor is free.
+        while (!active_descriptor_started(self)) {
+            #ifdef MICROPY_VM_HOOK_LOOP
+            MICROPY_VM_HOOK_LOOP ;
+            #endif
+            if (mp_hal_is_interrupted()) {
+                return;
+            }
+        }
+        uint8_t next = 1 - self->active_descriptor;
+        DmacDescriptor* descriptor = stream_descriptor(self, next);
+        setup_stream_descriptor(self, descriptor, data, sample_count, bytes_per_sample, loop);
+        self->buffers[next] = buffer;
+        stream_descriptor(self, self->active_descriptor)->DESCADDR.reg = (uint32_t) descriptor;
+        self->active_descriptor = next;
+        self->loop = loop;
+        return;
+    }
+
+    common_hal_analogio_analogout_stop(self);
+    claim_stream(self, sample_rate);
+    self->sample_rate = sample_rate;
+    self->loop = loop;
+    self->active_descriptor = 0;
+    self->buffers[0] = buffer;
+    self->buffers[1] = NULL;
+    setup_stream_descriptor(self, dma_descriptor(self->dma_channel), data, sample_count,
+                            bytes_per_sample, loop);
+    dma_configure(self->dma_channel, TC_OVF_DMA_TRIGGER(self->tc_index), false);
+    dma_enable_channel(self->dma_channel);
+
+    // Enabling the timer starts it counting from zero so the first value is written one sample
+    // period from now.
+    tc_set_enable(tc_insts[self->tc_index], true);
+    #endif
+}
+
+void common_hal_analogio_analogout_stop(analogio_analogout_obj_t *self) {
+    #if (defined(SAMD21) && defined(PIN_PA02)) || defined(SAMD51)
+    if (self->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    dma_disable_channel(self->dma_channel);
+    dma_descriptor(self->dma_channel)->BTCTRL.bit.VALID = false;
+    tc_reset(tc_insts[self->tc_index]);
+    MP_STATE_PORT(analogout_streams)[self->channel] = NULL;
+    self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->tc_index = TC_INST_NUM;
+    self->buffers[0] = NULL;
+    self->buffers[1] = NULL;
+    self->loop = false;
+    #endif
+}
+
+bool common_hal_analogio_analogout_get_playing(analogio_analogout_obj_t *self) {
+    #if (defined(SAMD21) && defined(PIN_PA02)) || defined(SAMD51)
+    if (self->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return false;
+    }
+    // The channel disables itself after the last block of a buffer that doesn't loop.
+    if (!dma_channel_enabled(self->dma_channel)) {
+        common_hal_analogio_analogout_stop(self);
+        return false;
+    }
+    return true;
+    #else
+    return false;
+    #endif
+}
+
 void common_hal_analogio_analogout_deinit(analogio_analogout_obj_t *self) {
     #if (defined(SAMD21) && defined(PIN_PA02)) || defined(SAMD51)
     if (common_hal_analogio_analogout_deinited(self)) {
         return;
     }
+    common_hal_analogio_analogout_stop(self);
     dac_sync_disable_channel(&self->descriptor, self->channel);
     reset_pin_number(PIN_PA02);
     // Only deinit the DAC on the SAMD51 if both outputs are free.
@@ -133,12 +345,21 @@ void common_hal_analogio_analogout_set_value(analogio_analogout_obj_t *self,
     #if defined(SAMD21) && !defined(PIN_PA02)
     return;
     #endif
+    common_hal_analogio_analogout_stop(self);
     // Input is 16 bit so make sure and set LEFTADJ to 1 so it takes the top
     // bits. This is currently done in asf4_conf/*/hpl_dac_config.h.
     dac_sync_write(&self->descriptor, self->channel, &value, 1);
 }
 
 void analogout_reset(void) {
+    #if (defined(SAMD21) && defined(PIN_PA02)) || defined(SAMD51)
+    for (uint8_t i = 0; i < ANALOGOUT_STREAM_COUNT; i++) {
+        analogio_analogout_obj_t* self = MP_STATE_PORT(analogout_streams)[i];
+        if (self != NULL) {
+            common_hal_analogio_analogout_stop(self);
+        }
+    }
+    #endif
     // audioout_reset also resets the DAC, and does a smooth ramp down to avoid clicks
     // if it was enabled, so do that instead if AudioOut is enabled.
 #if CIRCUITPY_AUDIOIO
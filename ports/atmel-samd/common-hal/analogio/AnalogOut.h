@@ -38,6 +38,16 @@ typedef struct {
     struct dac_sync_descriptor descriptor;
     uint8_t channel;
     bool deinited;
+    // Streamed playback. A timer overflow triggers each DMA write to the DAC. The DMA channel's
+    // own descriptor and second_descriptor take turns so that a looping buffer can be replaced
+    // at the end of a pass. buffers keeps what each descriptor reads from alive.
+    uint8_t dma_channel;
+    uint8_t tc_index;
+    uint8_t active_descriptor;
+    bool loop;
+    uint32_t sample_rate;
+    DmacDescriptor* second_descriptor;
+    mp_obj_t buffers[2];
 } analogio_analogout_obj_t;
 
 void analogout_reset(void);
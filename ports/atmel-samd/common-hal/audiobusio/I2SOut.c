@@ -384,3 +384,11 @@ bool common_hal_audiobusio_i2sout_get_playing(audiobusio_i2sout_obj_t* self) {
     }
     return still_playing;
 }
+
+uint32_t common_hal_audiobusio_i2sout_get_underruns(audiobusio_i2sout_obj_t* self) {
+    return audio_dma_get_underruns(&self->dma);
+}
+
+int32_t common_hal_audiobusio_i2sout_get_min_slack_us(audiobusio_i2sout_obj_t* self) {
+    return audio_dma_get_min_slack_us(&self->dma);
+}
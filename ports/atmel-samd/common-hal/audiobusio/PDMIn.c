@@ -53,6 +53,9 @@
 
 #define OVERSAMPLING 64
 #define SAMPLES_PER_BUFFER 32
+// Continuous recording uses longer blocks because the background task may not run as often as
+// the busy loop in record_to_buffer().
+#define STREAM_SAMPLES_PER_BLOCK 128
 
 // MEMS microphones must be clocked at at least 1MHz.
 #define MIN_MIC_CLOCK 1000000
@@ -216,6 +219,7 @@ void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t* self,
 
     self->bytes_per_sample = oversample >> 3;
     self->bit_depth = bit_depth;
+    self->streaming = false;
 }
 
 bool common_hal_audiobusio_pdmin_deinited(audiobusio_pdmin_obj_t* self) {
@@ -226,6 +230,7 @@ void common_hal_audiobusio_pdmin_deinit(audiobusio_pdmin_obj_t* self) {
     if (common_hal_audiobusio_pdmin_deinited(self)) {
         return;
     }
+    common_hal_audiobusio_pdmin_stop(self);
 
     i2s_set_serializer_enable(self->serializer, false);
     i2s_set_clock_unit_enable(self->clock_unit, false);
@@ -318,7 +323,7 @@ static void setup_dma(audiobusio_pdmin_obj_t* self, uint32_t length,
 // higher sample rate than specified.  Then after the audio is
 // recorded, a more expensive filter non-real-time filter could be
 // used to down-sample and low-pass.
-uint16_t sinc_filter [OVERSAMPLING] = {
+static const uint16_t sinc_filter [OVERSAMPLING] = {
     0, 2, 9, 21, 39, 63, 94, 132,
     179, 236, 302, 379, 467, 565, 674, 792,
     920, 1055, 1196, 1341, 1487, 1633, 1776, 1913,
@@ -329,24 +334,41 @@ uint16_t sinc_filter [OVERSAMPLING] = {
     94, 63, 39, 21, 9, 2, 0, 0
 };
 
-#define REPEAT_16_TIMES(X) X X X X X X X X X X X X X X X X
+// The filter is applied four PDM bits at a time. Each nibble of the PDM data looks up the sum of
+// the coefficients for its set bits, so a sample is 16 table reads rather than 64 tests and adds.
+#define FILTER_NIBBLES (OVERSAMPLING / 4)
+
+typedef uint16_t filter_table_t[FILTER_NIBBLES][16];
+
+static void build_filter_table(filter_table_t table) {
+    for (uint8_t nibble = 0; nibble < FILTER_NIBBLES; nibble++) {
+        const uint16_t *coefficients = sinc_filter + nibble * 4;
+        for (uint8_t bits = 0; bits < 16; bits++) {
+            uint16_t sum = 0;
+            // The most significant bit is the earliest one.
+            for (uint8_t i = 0; i < 4; i++) {
+                if (bits & (0x8 >> i)) {
+                    sum += coefficients[i];
+                }
+            }
+            table[nibble][bits] = sum;
+        }
+    }
+}
 
-static uint16_t filter_sample(uint32_t pdm_samples[4]) {
+static uint16_t filter_sample(filter_table_t table, uint32_t pdm_samples[4]) {
     uint16_t running_sum = 0;
-    const uint16_t *filter_ptr = sinc_filter;
+    uint16_t (*nibble_table)[16] = table;
     for (uint8_t i = 0; i < OVERSAMPLING/16; i++) {
         // The sample is 16-bits right channel in the upper two bytes and 16-bits left channel
         // in the lower two bytes.
         // We just ignore the upper bits
         uint32_t pdm_sample = pdm_samples[i];
-        REPEAT_16_TIMES( {
-                if (pdm_sample & 0x8000) {
-                    running_sum += *filter_ptr;
-                }
-                filter_ptr++;
-                pdm_sample <<= 1;
-            }
-            )
+        running_sum += nibble_table[0][(pdm_sample >> 12) & 0xf];
+        running_sum += nibble_table[1][(pdm_sample >> 8) & 0xf];
+        running_sum += nibble_table[2][(pdm_sample >> 4) & 0xf];
+        running_sum += nibble_table[3][pdm_sample & 0xf];
+        nibble_table += 4;
     }
     return running_sum;
 }
@@ -355,6 +377,9 @@ static uint16_t filter_sample(uint32_t pdm_samples[4]) {
 // output_buffer_length is the number of slots, not the number of bytes.
 uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* self,
         uint16_t* output_buffer, uint32_t output_buffer_length) {
+    if (self->streaming) {
+        mp_raise_RuntimeError(translate("PDMIn is already recording"));
+    }
     uint8_t dma_channel = find_free_audio_dma_channel();
     uint8_t event_channel = find_sync_event_channel();
     if (event_channel >= EVSYS_SYNCH_NUM) {
@@ -369,6 +394,9 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* se
     uint32_t first_buffer[words_per_buffer];
     uint32_t second_buffer[words_per_buffer];
 
+    filter_table_t filter_table;
+    build_filter_table(filter_table);
+
     turn_on_event_system();
 
     COMPILER_ALIGNED(16) DmacDescriptor second_descriptor;
@@ -429,7 +457,7 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* se
         uint32_t samples_to_process = min(remaining_samples_needed, samples_gathered);
         for (uint32_t i = 0; i < samples_to_process; i++) {
             // Call filter_sample just one place so it can be inlined.
-            uint16_t value = filter_sample(buffer + i * words_per_sample);
+            uint16_t value = filter_sample(filter_table, buffer + i * words_per_sample);
             if (self->bit_depth == 8) {
                 // Truncate to 8 bits.
                 ((uint8_t*) output_buffer)[values_output] = value >> 8;
@@ -473,6 +501,159 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* se
     return values_output;
 }
 
+static void start_stream_dma(audiobusio_pdmin_obj_t* self) {
+    uint8_t words_per_sample = self->bytes_per_sample / 2;
+    uint32_t words_per_block = STREAM_SAMPLES_PER_BLOCK * words_per_sample;
+    // Asking for more than two blocks links the second descriptor back to the first so the DMA
+    // never stops.
+    setup_dma(self, 2 * STREAM_SAMPLES_PER_BLOCK + 1, dma_descriptor(self->dma_channel),
+              self->second_descriptor, words_per_block, words_per_sample,
+              self->blocks, self->blocks + words_per_block);
+
+    uint8_t trigger_source = I2S_DMAC_ID_RX_0;
+    #ifdef SAMD21
+    trigger_source += self->serializer;
+    #endif
+
+    dma_configure(self->dma_channel, trigger_source, true);
+    init_event_channel_interrupt(self->event_channel, CORE_GCLK,
+                                 EVSYS_ID_GEN_DMAC_CH_0 + self->dma_channel);
+    self->next_block = 0;
+    // Turn on serializer now to get it in sync with DMA.
+    i2s_set_serializer_enable(self->serializer, true);
+    dma_enable_channel(self->dma_channel);
+}
+
+static void stop_stream_dma(audiobusio_pdmin_obj_t* self) {
+    disable_event_channel(self->event_channel);
+    dma_disable_channel(self->dma_channel);
+    i2s_set_serializer_enable(self->serializer, false);
+}
+
+void common_hal_audiobusio_pdmin_start(audiobusio_pdmin_obj_t* self, uint32_t buffer_length) {
+    common_hal_audiobusio_pdmin_stop(self);
+
+    self->dma_channel = find_free_audio_dma_channel();
+    if (self->dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    }
+    self->event_channel = find_sync_event_channel();
+    if (self->event_channel >= EVSYS_SYNCH_NUM) {
+        mp_raise_RuntimeError(translate("All sync event channels in use"));
+    }
+
+    uint32_t words_per_block = STREAM_SAMPLES_PER_BLOCK * self->bytes_per_sample / 2;
+    self->blocks = m_malloc(2 * words_per_block * sizeof(uint32_t), false);
+    self->second_descriptor = m_malloc(sizeof(DmacDescriptor), false);
+    self->filter_table = m_malloc(sizeof(filter_table_t), false);
+    self->ring = m_malloc(buffer_length * sizeof(uint16_t), false);
+    build_filter_table(self->filter_table);
+    self->ring_length = buffer_length;
+    self->ring_start = 0;
+    self->ring_count = 0;
+    self->overruns = 0;
+
+    turn_on_event_system();
+    start_stream_dma(self);
+    self->streaming = true;
+
+    // The background task finds us through the root pointer, which also keeps our buffers alive
+    // while the DMA writes to them.
+    MP_STATE_PORT(playing_audio)[self->dma_channel] = self;
+}
+
+void common_hal_audiobusio_pdmin_stop(audiobusio_pdmin_obj_t* self) {
+    if (!self->streaming) {
+        return;
+    }
+    stop_stream_dma(self);
+    MP_STATE_PORT(playing_audio)[self->dma_channel] = NULL;
+    self->streaming = false;
+    self->blocks = NULL;
+    self->second_descriptor = NULL;
+    self->filter_table = NULL;
+    self->ring = NULL;
+}
+
+bool common_hal_audiobusio_pdmin_get_recording(audiobusio_pdmin_obj_t* self) {
+    return self->streaming;
+}
+
+uint32_t common_hal_audiobusio_pdmin_get_overruns(audiobusio_pdmin_obj_t* self) {
+    return self->overruns;
+}
+
+uint32_t common_hal_audiobusio_pdmin_readinto(audiobusio_pdmin_obj_t* self,
+        uint16_t* output_buffer, uint32_t output_buffer_length) {
+    if (!self->streaming) {
+        return 0;
+    }
+    uint32_t count = min(output_buffer_length, self->ring_count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t value = self->ring[self->ring_start];
+        if (self->bit_depth == 8) {
+            ((uint8_t*) output_buffer)[i] = value >> 8;
+        } else {
+            output_buffer[i] = value;
+        }
+        self->ring_start++;
+        if (self->ring_start == self->ring_length) {
+            self->ring_start = 0;
+        }
+    }
+    self->ring_count -= count;
+    return count;
+}
+
+// Filters a finished block into the ring. Samples that don't fit are dropped and counted.
+static void filter_block(audiobusio_pdmin_obj_t* self, uint32_t* block) {
+    uint8_t words_per_sample = self->bytes_per_sample / 2;
+    uint32_t space = self->ring_length - self->ring_count;
+    uint32_t count = min(space, (uint32_t) STREAM_SAMPLES_PER_BLOCK);
+    if (count < STREAM_SAMPLES_PER_BLOCK) {
+        self->overruns++;
+    }
+    uint32_t end = self->ring_start + self->ring_count;
+    if (end >= self->ring_length) {
+        end -= self->ring_length;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        self->ring[end] = filter_sample(self->filter_table, block + i * words_per_sample);
+        end++;
+        if (end == self->ring_length) {
+            end = 0;
+        }
+    }
+    self->ring_count += count;
+}
+
+// WARN(tannewt): DO NOT print from here. Printing calls background tasks such as this and causes a
+// stack overflow.
+
+void pdmin_background(void) {
+    for (uint8_t i = 0; i < AUDIO_DMA_CHANNEL_COUNT; i++) {
+        mp_obj_t obj = MP_STATE_PORT(playing_audio)[i];
+        if (obj == NULL || !MP_OBJ_IS_TYPE(obj, &audiobusio_pdmin_type)) {
+            continue;
+        }
+        audiobusio_pdmin_obj_t* self = MP_OBJ_TO_PTR(obj);
+        if (event_interrupt_overflow(self->event_channel)) {
+            // A block was overwritten before we got to it so we no longer know which block the DMA
+            // is filling. Start again from the first one.
+            self->overruns++;
+            stop_stream_dma(self);
+            start_stream_dma(self);
+            continue;
+        }
+        if (!event_interrupt_active(self->event_channel)) {
+            continue;
+        }
+        uint32_t words_per_block = STREAM_SAMPLES_PER_BLOCK * self->bytes_per_sample / 2;
+        filter_block(self, self->blocks + self->next_block * words_per_block);
+        self->next_block = 1 - self->next_block;
+    }
+}
+
 void common_hal_audiobusio_pdmin_record_to_file(audiobusio_pdmin_obj_t* self, uint8_t* buffer, uint32_t length) {
 
 }
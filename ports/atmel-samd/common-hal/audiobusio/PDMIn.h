@@ -42,6 +42,20 @@ typedef struct {
     uint8_t bytes_per_sample;
     uint8_t bit_depth;
     uint8_t gclk;
+    // Continuous recording state. The DMA loops over two blocks of PDM data and the background
+    // task filters each finished block into the ring.
+    bool streaming;
+    uint8_t dma_channel;
+    uint8_t event_channel;
+    uint8_t next_block;
+    uint32_t* blocks;
+    DmacDescriptor* second_descriptor;
+    uint16_t (*filter_table)[16];
+    uint16_t* ring;
+    uint32_t ring_length;
+    uint32_t ring_start;
+    uint32_t ring_count;
+    uint32_t overruns;
 } audiobusio_pdmin_obj_t;
 
 void pdmin_reset(void);
@@ -473,3 +473,22 @@ bool common_hal_audioio_audioout_get_playing(audioio_audioout_obj_t* self) {
     }
     return now_playing;
 }
+
+uint32_t common_hal_audioio_audioout_get_underruns(audioio_audioout_obj_t* self) {
+    uint32_t underruns = audio_dma_get_underruns(&self->left_dma);
+    #ifdef SAMD51
+    underruns += audio_dma_get_underruns(&self->right_dma);
+    #endif
+    return underruns;
+}
+
+int32_t common_hal_audioio_audioout_get_min_slack_us(audioio_audioout_obj_t* self) {
+    int32_t slack = audio_dma_get_min_slack_us(&self->left_dma);
+    #ifdef SAMD51
+    int32_t right_slack = audio_dma_get_min_slack_us(&self->right_dma);
+    if (slack < 0 || (right_slack >= 0 && right_slack < slack)) {
+        slack = right_slack;
+    }
+    #endif
+    return slack;
+}
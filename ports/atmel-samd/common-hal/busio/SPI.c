@@ -229,6 +229,9 @@ void common_hal_busio_spi_construct(busio_spi_obj_t *self,
         claim_pin(miso);
     }
 
+    self->write_in_progress = false;
+    self->write_buffer = MP_OBJ_NULL;
+
     spi_m_sync_enable(&self->spi_desc);
 }
 
@@ -248,6 +251,7 @@ void common_hal_busio_spi_deinit(busio_spi_obj_t *self) {
     if (common_hal_busio_spi_deinited(self)) {
         return;
     }
+    common_hal_busio_spi_finish_write(self);
     allow_reset_sercom(self->spi_desc.dev.prvt);
 
     spi_m_sync_disable(&self->spi_desc);
@@ -322,6 +326,87 @@ bool common_hal_busio_spi_write(busio_spi_obj_t *self,
     return status >= 0; // Status is number of chars read or an error code < 0.
 }
 
+bool common_hal_busio_spi_start_write(busio_spi_obj_t *self,
+        const uint8_t *data, size_t len) {
+    // Borrow an idle audio DMA channel, starting from the last one because audio allocates from
+    // the first. The shared channel can't be used because other SPI and QSPI transfers may happen
+    // before this one is finished.
+    uint8_t channel = AUDIO_DMA_CHANNEL_COUNT;
+    for (uint8_t i = AUDIO_DMA_CHANNEL_COUNT; i > 0; i--) {
+        if (!dma_channel_enabled(i - 1)) {
+            channel = i - 1;
+            break;
+        }
+    }
+    if (len < 16 || len > 0xffff || channel == AUDIO_DMA_CHANNEL_COUNT) {
+        return common_hal_busio_spi_write(self, data, len);
+    }
+
+    Sercom* sercom = self->spi_desc.dev.prvt;
+    Sercom *sercom_instances[SERCOM_INST_NUM] = SERCOM_INSTS;
+    uint8_t sercom_index = 0;
+    for (uint8_t i = 0; i < SERCOM_INST_NUM; i++) {
+        if (sercom_instances[i] == sercom) {
+            sercom_index = i;
+            break;
+        }
+    }
+
+    DmacDescriptor* descriptor = dma_descriptor(channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = len;
+    // The source address is the end of the block when incrementing.
+    descriptor->SRCADDR.reg = ((uint32_t) data) + len;
+    descriptor->DSTADDR.reg = (uint32_t) &sercom->SPI.DATA.reg;
+    descriptor->DESCADDR.reg = 0;
+
+    dma_configure(channel, SERCOM0_DMAC_ID_TX + 2 * sercom_index, false);
+    dma_enable_channel(channel);
+    self->write_dma_channel = channel;
+    self->write_in_progress = true;
+    return true;
+}
+
+bool common_hal_busio_spi_finish_write(busio_spi_obj_t *self) {
+    if (!self->write_in_progress) {
+        return true;
+    }
+    uint32_t status;
+    do {
+        status = dma_transfer_status(self->write_dma_channel);
+    } while ((status & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0);
+    dma_disable_channel(self->write_dma_channel);
+    self->write_in_progress = false;
+    self->write_buffer = MP_OBJ_NULL;
+
+    Sercom* sercom = self->spi_desc.dev.prvt;
+    // Wait for the last byte to shift out.
+    while (sercom->SPI.INTFLAG.bit.TXC == 0) {}
+    // Nothing was read so the receive buffer overflowed. Drain it and clear the error.
+    while (sercom->SPI.INTFLAG.bit.RXC == 1) {
+        sercom->SPI.DATA.reg;
+    }
+    sercom->SPI.STATUS.bit.BUFOVF = 1;
+    sercom->SPI.INTFLAG.reg = SERCOM_SPI_INTFLAG_ERROR;
+    return (status & DMAC_CHINTFLAG_TERR) == 0;
+}
+
+bool common_hal_busio_spi_start_write_obj(busio_spi_obj_t *self, mp_obj_t buffer,
+        const uint8_t *data, size_t len) {
+    bool ok = common_hal_busio_spi_start_write(self, data, len);
+    if (self->write_in_progress) {
+        self->write_buffer = buffer;
+    }
+    return ok;
+}
+
+bool common_hal_busio_spi_write_in_progress(busio_spi_obj_t *self) {
+    if (!self->write_in_progress) {
+        return false;
+    }
+    return (dma_transfer_status(self->write_dma_channel) & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0;
+}
+
 bool common_hal_busio_spi_read(busio_spi_obj_t *self,
         uint8_t *data, size_t len, uint8_t write_value) {
     if (len == 0) {
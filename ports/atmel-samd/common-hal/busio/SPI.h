@@ -40,6 +40,9 @@ typedef struct {
     uint8_t clock_pin;
     uint8_t MOSI_pin;
     uint8_t MISO_pin;
+    bool write_in_progress;
+    uint8_t write_dma_channel;
+    mp_obj_t write_buffer;
 } busio_spi_obj_t;
 
 void reset_sercoms(void);
@@ -24,6 +24,9 @@
  * THE SOFTWARE.
  */
 
+#include <stddef.h>
+#include <string.h>
+
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/busio/UART.h"
 
@@ -33,6 +36,7 @@
 #include "py/mperrno.h"
 #include "py/runtime.h"
 #include "py/stream.h"
+#include "supervisor/port.h"
 #include "supervisor/shared/translate.h"
 
 #include "tick.h"
@@ -44,18 +48,48 @@
 #include "hal/include/hal_usart_async.h"
 #include "hal/include/hpl_usart_async.h"
 
+#include "samd/dma.h"
 #include "samd/sercom.h"
 
+// UARTs receiving by DMA, indexed by channel, so the ring positions can be kept up to date in the
+// background.
+static busio_uart_obj_t* rx_dma_uarts[AUDIO_DMA_CHANNEL_COUNT];
+
 // Do-nothing callback needed so that usart_async code will enable rx interrupts.
 // See comment below re usart_async_register_callback()
 static void usart_async_rxc_callback(const struct usart_async_descriptor *const descr) {
     // Nothing needs to be done by us.
 }
 
+// Start sending the next contiguous run of queued characters, if nothing is being sent already.
+// Called with interrupts disabled or from the tx done interrupt.
+static void tx_start_next(busio_uart_obj_t *self) {
+    ringbuf_t* tx_buffer = &self->tx_buffer;
+    if (self->tx_sending > 0 || tx_buffer->iget == tx_buffer->iput) {
+        return;
+    }
+    if (tx_buffer->iput > tx_buffer->iget) {
+        self->tx_sending = tx_buffer->iput - tx_buffer->iget;
+    } else {
+        self->tx_sending = tx_buffer->size - tx_buffer->iget;
+    }
+    struct io_descriptor *io;
+    usart_async_get_io_descriptor(&self->usart_desc, &io);
+    io_write(io, tx_buffer->buf + tx_buffer->iget, self->tx_sending);
+}
+
+static void usart_async_txc_callback(const struct usart_async_descriptor *const descr) {
+    busio_uart_obj_t* self = (busio_uart_obj_t*) ((uint8_t*) descr - offsetof(busio_uart_obj_t, usart_desc));
+    ringbuf_t* tx_buffer = &self->tx_buffer;
+    tx_buffer->iget = (tx_buffer->iget + self->tx_sending) % tx_buffer->size;
+    self->tx_sending = 0;
+    tx_start_next(self);
+}
+
 void common_hal_busio_uart_construct(busio_uart_obj_t *self,
         const mcu_pin_obj_t * tx, const mcu_pin_obj_t * rx, uint32_t baudrate,
         uint8_t bits, uart_parity_t parity, uint8_t stop, mp_float_t timeout,
-        uint8_t receiver_buffer_size) {
+        uint16_t receiver_buffer_size, uint16_t transmitter_buffer_size) {
     Sercom* sercom = NULL;
     uint8_t sercom_index = 255; // Unset index
     uint32_t rx_pinmux = 0;
@@ -76,6 +110,8 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     self->baudrate = baudrate;
     self->character_bits = bits;
     self->timeout_ms = timeout * 1000;
+    self->rx_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    self->rx_overruns = 0;
 
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
@@ -150,6 +186,20 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
         self->buffer = NULL;
     }
 
+    self->tx_sending = 0;
+    if (have_tx && transmitter_buffer_size > 0) {
+        // One more than asked for because a full ringbuf_t always has an empty slot.
+        ringbuf_alloc(&self->tx_buffer, transmitter_buffer_size + 1, true);
+        if (self->tx_buffer.buf == NULL) {
+            common_hal_busio_uart_deinit(self);
+            mp_raise_msg(&mp_type_MemoryError, translate("Failed to allocate TX buffer"));
+        }
+    } else {
+        self->tx_buffer.buf = NULL;
+        self->tx_buffer.size = 0;
+        self->tx_buffer.iget = self->tx_buffer.iput = 0;
+    }
+
     if (usart_async_init(usart_desc_p, sercom, self->buffer, self->buffer_length, NULL) != ERR_NONE) {
         mp_raise_ValueError(translate("Could not initialize UART"));
     }
@@ -202,7 +252,25 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     // Different read function behavior in some asynchronous drivers. As of this writing:
     // http://start.atmel.com/static/help/index.html?GUID-79201A5A-226F-4FBB-B0B8-AB0BE0554836
     // Look at the ASFv4 code example for async USART.
-    usart_async_register_callback(usart_desc_p, USART_ASYNC_RXC_CB, usart_async_rxc_callback);
+    //
+    // Characters are received straight into the buffer by DMA instead when an idle channel can be
+    // borrowed, so rx interrupts are only needed without one. Borrow from the last channel like
+    // SPI because audio allocates from the first.
+    uint8_t rx_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    if (have_rx && self->buffer_length > 0) {
+        for (uint8_t i = AUDIO_DMA_CHANNEL_COUNT; i > 0; i--) {
+            if (!dma_channel_enabled(i - 1) && rx_dma_uarts[i - 1] == NULL) {
+                rx_dma_channel = i - 1;
+                break;
+            }
+        }
+    }
+    if (have_rx && rx_dma_channel == AUDIO_DMA_CHANNEL_COUNT) {
+        usart_async_register_callback(usart_desc_p, USART_ASYNC_RXC_CB, usart_async_rxc_callback);
+    }
+    if (self->tx_buffer.size > 0) {
+        usart_async_register_callback(usart_desc_p, USART_ASYNC_TXC_CB, usart_async_txc_callback);
+    }
 
 
     if (have_tx) {
@@ -226,6 +294,104 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     }
 
     usart_async_enable(usart_desc_p);
+
+    if (rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        // The descriptor links back to itself so the buffer is refilled forever as a ring.
+        DmacDescriptor* descriptor = dma_descriptor(rx_dma_channel);
+        descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_DSTINC;
+        descriptor->BTCNT.reg = self->buffer_length;
+        descriptor->SRCADDR.reg = (uint32_t) &sercom->USART.DATA.reg;
+        // The destination address is the end of the block when incrementing.
+        descriptor->DSTADDR.reg = ((uint32_t) self->buffer) + self->buffer_length;
+        descriptor->DESCADDR.reg = (uint32_t) descriptor;
+
+        // The write-back count is only updated once the channel runs, so make sure it doesn't
+        // hold a stale position from the channel's last user.
+        DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+        write_back[rx_dma_channel].BTCNT.reg = self->buffer_length;
+
+        self->rx_dma_write_index = 0;
+        self->rx_dma_read_index = 0;
+        self->rx_dma_available = 0;
+        self->rx_dma_channel = rx_dma_channel;
+        rx_dma_uarts[rx_dma_channel] = self;
+        dma_configure(rx_dma_channel, SERCOM0_DMAC_ID_RX + 2 * sercom_index, false);
+        dma_enable_channel(rx_dma_channel);
+    }
+}
+
+// Number of characters the receive DMA will write before it wraps back to the start of the ring.
+static uint32_t rx_dma_remaining(uint8_t channel) {
+    uint32_t active = DMAC->ACTIVE.reg;
+    if ((active & DMAC_ACTIVE_ABUSY) != 0 &&
+        (active & DMAC_ACTIVE_ID_Msk) >> DMAC_ACTIVE_ID_Pos == channel) {
+        return (active & DMAC_ACTIVE_BTCNT_Msk) >> DMAC_ACTIVE_BTCNT_Pos;
+    }
+    DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+    return write_back[channel].BTCNT.reg;
+}
+
+// Catch up with the characters the DMA has written since the last call. This must happen before
+// the DMA can lap the ring, which uart_background() does between reads. If the unread characters
+// fill the ring they may already have been overwritten, so they are dropped and counted as an
+// overrun.
+static void rx_dma_update(busio_uart_obj_t *self) {
+    uint32_t length = self->buffer_length;
+    uint32_t write_index = (length - rx_dma_remaining(self->rx_dma_channel)) % length;
+    self->rx_dma_available += (write_index + length - self->rx_dma_write_index) % length;
+    self->rx_dma_write_index = write_index;
+
+    Sercom* sercom = self->usart_desc.device.hw;
+    if (sercom->USART.STATUS.bit.BUFOVF) {
+        // The DMA didn't keep up, so characters were lost before they reached the ring.
+        sercom->USART.STATUS.reg = SERCOM_USART_STATUS_BUFOVF;
+        self->rx_overruns++;
+    }
+    if (self->rx_dma_available >= length) {
+        self->rx_dma_read_index = write_index;
+        self->rx_dma_available = 0;
+        self->rx_overruns++;
+    }
+}
+
+// Copy out as many received characters as are available, up to len.
+static size_t rx_dma_read(busio_uart_obj_t *self, uint8_t *data, size_t len) {
+    rx_dma_update(self);
+    size_t count = MIN(len, self->rx_dma_available);
+    size_t first = MIN(count, self->buffer_length - self->rx_dma_read_index);
+    memcpy(data, self->buffer + self->rx_dma_read_index, first);
+    memcpy(data + first, self->buffer, count - first);
+    self->rx_dma_read_index = (self->rx_dma_read_index + count) % self->buffer_length;
+    self->rx_dma_available -= count;
+    return count;
+}
+
+static void rx_dma_stop(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    dma_disable_channel(self->rx_dma_channel);
+    dma_descriptor(self->rx_dma_channel)->BTCTRL.bit.VALID = false;
+    rx_dma_uarts[self->rx_dma_channel] = NULL;
+    self->rx_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+}
+
+void uart_reset(void) {
+    for (uint8_t i = 0; i < AUDIO_DMA_CHANNEL_COUNT; i++) {
+        if (rx_dma_uarts[i] != NULL) {
+            dma_disable_channel(i);
+            dma_descriptor(i)->BTCTRL.bit.VALID = false;
+            rx_dma_uarts[i] = NULL;
+        }
+    }
+}
+
+void uart_background(void) {
+    for (uint8_t i = 0; i < AUDIO_DMA_CHANNEL_COUNT; i++) {
+        if (rx_dma_uarts[i] != NULL) {
+            rx_dma_update(rx_dma_uarts[i]);
+        }
+    }
 }
 
 bool common_hal_busio_uart_deinited(busio_uart_obj_t *self) {
@@ -238,6 +404,7 @@ void common_hal_busio_uart_deinit(busio_uart_obj_t *self) {
     }
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
+    rx_dma_stop(self);
     usart_async_disable(usart_desc_p);
     usart_async_deinit(usart_desc_p);
     reset_pin_number(self->rx_pin);
@@ -269,7 +436,12 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
     // Busy-wait until timeout or until we've read enough chars.
     while (ticks_ms - start_ticks <= self->timeout_ms) {
         // Read as many chars as we can right now, up to len.
-        size_t num_read = io_read(io, data, len);
+        size_t num_read;
+        if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+            num_read = rx_dma_read(self, data, len);
+        } else {
+            num_read = io_read(io, data, len);
+        }
 
         // Advance pointer in data buffer, and decrease how many chars left to read.
         data += num_read;
@@ -295,6 +467,7 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
         if (self->timeout_ms == 0) {
             break;
         }
+        port_sleep_until_interrupt();
     }
 
     if (total_read == 0) {
@@ -305,6 +478,45 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
     return total_read;
 }
 
+// Queue characters to be sent in the background, waiting only while the buffer is full.
+static size_t tx_queue(busio_uart_obj_t *self, const uint8_t *data, size_t len, int *errcode) {
+    ringbuf_t* tx_buffer = &self->tx_buffer;
+    size_t total_queued = 0;
+    uint64_t start_ticks = ticks_ms;
+    while (true) {
+        common_hal_mcu_disable_interrupts();
+        size_t num_queued = ringbuf_put_n(tx_buffer, data, len);
+        tx_start_next(self);
+        common_hal_mcu_enable_interrupts();
+
+        data += num_queued;
+        len -= num_queued;
+        total_queued += num_queued;
+        if (len == 0) {
+            break;
+        }
+        if (num_queued > 0) {
+            // Reset the timeout whenever there was room for more.
+            start_ticks = ticks_ms;
+        }
+        if (ticks_ms - start_ticks >= self->timeout_ms) {
+            break;
+        }
+        #ifdef MICROPY_VM_HOOK_LOOP
+            MICROPY_VM_HOOK_LOOP
+            if (mp_hal_is_interrupted()) {
+                break;
+            }
+        #endif
+    }
+
+    if (total_queued == 0) {
+        *errcode = MP_EAGAIN;
+        return MP_STREAM_ERROR;
+    }
+    return total_queued;
+}
+
 // Write characters.
 size_t common_hal_busio_uart_write(busio_uart_obj_t *self, const uint8_t *data, size_t len, int *errcode) {
     if (self->tx_pin == NO_PIN) {
@@ -314,6 +526,10 @@ size_t common_hal_busio_uart_write(busio_uart_obj_t *self, const uint8_t *data,
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
 
+    if (self->tx_buffer.size > 0) {
+        return tx_queue(self, data, len, errcode);
+    }
+
     struct io_descriptor *io;
     usart_async_get_io_descriptor(usart_desc_p, &io);
 
@@ -365,6 +581,10 @@ void common_hal_busio_uart_set_baudrate(busio_uart_obj_t *self, uint32_t baudrat
 }
 
 uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        rx_dma_update(self);
+        return self->rx_dma_available;
+    }
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
     struct usart_async_status async_status;
@@ -373,16 +593,42 @@ uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *self) {
 }
 
 void common_hal_busio_uart_clear_rx_buffer(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        rx_dma_update(self);
+        self->rx_dma_read_index = self->rx_dma_write_index;
+        self->rx_dma_available = 0;
+        return;
+    }
     // This assignment is only here because the usart_async routines take a *const argument.
     struct usart_async_descriptor * const usart_desc_p = (struct usart_async_descriptor * const) &self->usart_desc;
     usart_async_flush_rx_buffer(usart_desc_p);
 
 }
 
+uint32_t common_hal_busio_uart_tx_characters_waiting(busio_uart_obj_t *self) {
+    if (self->tx_buffer.size == 0) {
+        return 0;
+    }
+    common_hal_mcu_disable_interrupts();
+    uint32_t count = ringbuf_count(&self->tx_buffer);
+    common_hal_mcu_enable_interrupts();
+    return count;
+}
+
+uint32_t common_hal_busio_uart_get_rx_overruns(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        rx_dma_update(self);
+    }
+    return self->rx_overruns;
+}
+
 bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self) {
     if (self->tx_pin == NO_PIN) {
         return false;
     }
+    if (self->tx_buffer.size > 0) {
+        return ringbuf_count(&self->tx_buffer) < self->tx_buffer.size - 1;
+    }
     // This assignment is only here because the usart_async routines take a *const argument.
     const struct _usart_async_device * const usart_device_p =
         (struct _usart_async_device * const) &self->usart_desc.device;
@@ -32,6 +32,7 @@
 #include "hal/include/hal_usart_async.h"
 
 #include "py/obj.h"
+#include "py/ringbuf.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -44,6 +45,20 @@ typedef struct {
     uint32_t timeout_ms;
     uint32_t buffer_length;
     uint8_t* buffer;
+    // DMA channel filling buffer as a ring, or AUDIO_DMA_CHANNEL_COUNT when receiving through
+    // usart_async interrupts instead.
+    uint8_t rx_dma_channel;
+    uint16_t rx_dma_write_index;
+    uint16_t rx_dma_read_index;
+    uint32_t rx_dma_available;
+    uint32_t rx_overruns;
+    // Characters queued by write(). The ones from iget are being sent by usart_async until its tx
+    // done callback starts the next chunk.
+    ringbuf_t tx_buffer;
+    uint16_t tx_sending;
 } busio_uart_obj_t;
 
+void uart_reset(void);
+void uart_background(void);
+
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_BUSIO_UART_H
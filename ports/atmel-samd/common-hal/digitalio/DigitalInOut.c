@@ -184,3 +184,13 @@ digitalio_pull_t common_hal_digitalio_digitalinout_get_pull(
         }
     }
 }
+
+bool common_hal_digitalio_digitalinout_get_registers(digitalio_digitalinout_obj_t* self,
+        digitalinout_registers_t* registers) {
+    PortGroup *const port = &PORT->Group[GPIO_PORT(self->pin->number)];
+    registers->set = &port->OUTSET.reg;
+    registers->clear = &port->OUTCLR.reg;
+    registers->input = &port->IN.reg;
+    registers->mask = 1U << GPIO_PIN(self->pin->number);
+    return true;
+}
@@ -31,8 +31,129 @@
 #include "common-hal/microcontroller/Pin.h"
 #include "py/runtime.h"
 #include "shared-bindings/digitalio/DigitalInOut.h"
+#include "shared-bindings/microcontroller/__init__.h"
 
+#include "audio_dma.h"
+#include "samd/dma.h"
+#include "samd/events.h"
+#include "samd/timers.h"
 #include "tick.h"
+#include "timer_handler.h"
+
+#ifdef SAMD51
+// Only the first four DMA channels can generate events.
+#define EVENT_DMA_CHANNEL_COUNT (4)
+// 48MHz timer ticks from a byte reaching the bus to WR rising, and from WR rising to the request
+// for the next byte.
+#define WRITE_LOW_TICKS (2)
+#define WRITE_HIGH_TICKS (1)
+
+// Each byte the DMA puts on the bus pulls WR low, through a PORT event, and restarts a one shot
+// timer. Part way through, the timer raises WR through another PORT event and latches the byte.
+// The timer's end requests the next byte. Each step waits for the one before, so DMA latency
+// slows the bus down rather than corrupting it.
+static bool start_write(displayio_parallelbus_obj_t* self, const uint8_t* data, uint32_t len) {
+    if (len < 16 || len > 0xffff) {
+        return false;
+    }
+    // Borrow an idle audio DMA channel, starting from the last one because audio allocates from
+    // the first.
+    uint8_t dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    for (uint8_t i = MIN(AUDIO_DMA_CHANNEL_COUNT, EVENT_DMA_CHANNEL_COUNT); i > 0; i--) {
+        if (!dma_channel_enabled(i - 1)) {
+            dma_channel = i - 1;
+            break;
+        }
+    }
+    uint8_t tc_index = find_free_timer();
+    if (dma_channel == AUDIO_DMA_CHANNEL_COUNT || tc_index == 0xff) {
+        return false;
+    }
+    turn_on_event_system();
+    uint8_t low_event_channel = find_async_event_channel();
+    if (low_event_channel >= EVSYS_CHANNELS) {
+        return false;
+    }
+    // Claim the first channel before looking for the second so we don't get it twice.
+    init_async_event_channel(low_event_channel, EVSYS_ID_GEN_DMAC_CH_0 + dma_channel);
+    uint8_t high_event_channel = find_async_event_channel();
+    if (high_event_channel >= EVSYS_CHANNELS) {
+        disable_event_channel(low_event_channel);
+        return false;
+    }
+    init_async_event_channel(high_event_channel, EVSYS_ID_GEN_TC0_MC_1 + 3 * tc_index);
+    connect_event_user_to_channel(EVSYS_ID_USER_PORT_EV_0, low_event_channel);
+    connect_event_user_to_channel(EVSYS_ID_USER_TC0_EVU + tc_index, low_event_channel);
+    connect_event_user_to_channel(EVSYS_ID_USER_PORT_EV_1, high_event_channel);
+
+    uint8_t write_pin = self->write.pin->number % 32;
+    self->write_group->EVCTRL.reg = PORT_EVCTRL_PID0(write_pin) |
+                                    PORT_EVCTRL_EVACT0(PORT_EVCTRL_EVACT0_CLR_Val) |
+                                    PORT_EVCTRL_PORTEI0 |
+                                    PORT_EVCTRL_PID1(write_pin) |
+                                    PORT_EVCTRL_EVACT1(PORT_EVCTRL_EVACT1_SET_Val) |
+                                    PORT_EVCTRL_PORTEI1;
+
+    set_timer_handler(true, tc_index, TC_HANDLER_NO_INTERRUPT);
+    turn_on_clocks(true, tc_index, 1);
+    Tc* tc = tc_insts[tc_index];
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    tc->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+    tc->COUNT16.CC[0].reg = WRITE_LOW_TICKS + WRITE_HIGH_TICKS;
+    tc->COUNT16.CC[1].reg = WRITE_LOW_TICKS;
+    tc->COUNT16.EVCTRL.reg = TC_EVCTRL_EVACT_RETRIGGER | TC_EVCTRL_TCEI | TC_EVCTRL_MCEO1;
+    tc->COUNT16.CTRLBSET.reg = TC_CTRLBSET_ONESHOT;
+    tc_wait_for_sync(tc);
+
+    DmacDescriptor* descriptor = dma_descriptor(dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_EVOSEL_BEAT |
+                             DMAC_BTCTRL_BEATSIZE_BYTE |
+                             DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = len;
+    // The source address is the end of the block when incrementing.
+    descriptor->SRCADDR.reg = ((uint32_t) data) + len;
+    descriptor->DSTADDR.reg = (uint32_t) self->bus;
+    descriptor->DESCADDR.reg = 0;
+    dma_configure(dma_channel, TC_OVF_DMA_TRIGGER(tc_index), true);
+    dma_enable_channel(dma_channel);
+
+    // The first run of the timer requests the first byte.
+    tc_set_enable(tc, true);
+
+    self->write_dma_channel = dma_channel;
+    self->write_tc_index = tc_index;
+    self->write_low_event_channel = low_event_channel;
+    self->write_high_event_channel = high_event_channel;
+    self->write_in_progress = true;
+    return true;
+}
+#endif
+
+static void finish_write(displayio_parallelbus_obj_t* self) {
+    #ifdef SAMD51
+    if (!self->write_in_progress) {
+        return;
+    }
+    while ((dma_transfer_status(self->write_dma_channel) &
+            (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) == 0) {}
+    // The last byte is latched when WR rises a few timer ticks after its transfer.
+    common_hal_mcu_delay_us(1);
+    dma_disable_channel(self->write_dma_channel);
+
+    Tc* tc = tc_insts[self->write_tc_index];
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    self->write_group->EVCTRL.reg = 0;
+    disable_event_user(EVSYS_ID_USER_PORT_EV_0);
+    disable_event_user(EVSYS_ID_USER_PORT_EV_1);
+    disable_event_user(EVSYS_ID_USER_TC0_EVU + self->write_tc_index);
+    disable_event_channel(self->write_low_event_channel);
+    disable_event_channel(self->write_high_event_channel);
+    self->write_in_progress = false;
+    #endif
+}
 
 void common_hal_displayio_parallelbus_construct(displayio_parallelbus_obj_t* self,
     const mcu_pin_obj_t* data0, const mcu_pin_obj_t* command, const mcu_pin_obj_t* chip_select,
@@ -81,6 +202,7 @@ void common_hal_displayio_parallelbus_construct(displayio_parallelbus_obj_t* sel
     self->data0_pin = data_pin;
     self->write_group = &PORT->Group[write->number / 32];
     self->write_mask = 1 << (write->number % 32);
+    self->write_in_progress = false;
 
     never_reset_pin_number(command->number);
     never_reset_pin_number(chip_select->number);
@@ -93,6 +215,7 @@ void common_hal_displayio_parallelbus_construct(displayio_parallelbus_obj_t* sel
 }
 
 void common_hal_displayio_parallelbus_deinit(displayio_parallelbus_obj_t* self) {
+    finish_write(self);
     for (uint8_t i = 0; i < 8; i++) {
         reset_pin_number(self->data0_pin + i);
     }
@@ -112,7 +235,15 @@ bool common_hal_displayio_parallelbus_begin_transaction(mp_obj_t obj) {
 
 void common_hal_displayio_parallelbus_send(mp_obj_t obj, bool command, uint8_t *data, uint32_t data_length) {
     displayio_parallelbus_obj_t* self = MP_OBJ_TO_PTR(obj);
+    // Let the previous data finish before changing the command line.
+    finish_write(self);
     common_hal_digitalio_digitalinout_set_value(&self->command, !command);
+    #ifdef SAMD51
+    // Data is written in the background so the caller can prepare the next chunk meanwhile.
+    if (!command && start_write(self, data, data_length)) {
+        return;
+    }
+    #endif
     uint32_t* clear_write = (uint32_t*) &self->write_group->OUTCLR.reg;
     uint32_t* set_write = (uint32_t*) &self->write_group->OUTSET.reg;
     uint32_t mask = self->write_mask;
@@ -125,5 +256,6 @@ void common_hal_displayio_parallelbus_send(mp_obj_t obj, bool command, uint8_t *
 
 void common_hal_displayio_parallelbus_end_transaction(mp_obj_t obj) {
     displayio_parallelbus_obj_t* self = MP_OBJ_TO_PTR(obj);
+    finish_write(self);
     common_hal_digitalio_digitalinout_set_value(&self->chip_select, true);
 }
@@ -40,6 +40,11 @@ typedef struct {
     uint8_t data0_pin;
     PortGroup* write_group;
     uint32_t write_mask;
+    bool write_in_progress;
+    uint8_t write_dma_channel;
+    uint8_t write_tc_index;
+    uint8_t write_low_event_channel;
+    uint8_t write_high_event_channel;
 } displayio_parallelbus_obj_t;
 
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_DISPLAYIO_PARALLELBUS_H
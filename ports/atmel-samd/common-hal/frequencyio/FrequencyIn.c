@@ -35,7 +35,9 @@
 #include "timer_handler.h"
 #include "background.h"
 
+#include "audio_dma.h"
 #include "samd/clocks.h"
+#include "samd/dma.h"
 #include "samd/timers.h"
 #include "samd/events.h"
 #include "samd/pins.h"
@@ -55,6 +57,11 @@ static frequencyio_frequencyin_obj_t *active_frequencyins[TC_INST_NUM];
 volatile uint8_t reference_tc = 0xff;
 #ifdef SAMD51
 static uint8_t dpll_gclk;
+
+// Reciprocal counting stamps edges with a free running count of the DPLL1 clock.
+#define STAMP_CLOCK_HZ (32768 * 3000)
+// The stamp counter wraps after about 43 seconds, after which the age of an edge is unknown.
+#define STAMP_MAX_AGE_MS (40000)
 #endif
 
 void frequencyin_emergency_cancel_capture(uint8_t index) {
@@ -93,7 +100,7 @@ void frequencyin_interrupt_handler(uint8_t index) {
     current_tick(&current_ms, &current_us);
 
     for (uint8_t i = 0; i <= (TC_INST_NUM - 1); i++) {
-        if (active_frequencyins[i] != NULL) {
+        if (active_frequencyins[i] != NULL && !active_frequencyins[i]->reciprocal) {
             frequencyio_frequencyin_obj_t* self = active_frequencyins[i];
             Tc* tc = tc_insts[self->tc_index];
 
@@ -244,9 +251,104 @@ void frequencyin_samd51_stop_dpll() {
     }
     dpll_gclk = 0xff;
 }
+
+// Two TCs pair into a 32-bit counter: an even one, which is used, and the odd one after it.
+static uint8_t find_free_timer_pair(void) {
+    for (uint8_t i = 0; i + 1 < TC_INST_NUM; i += 2) {
+        if (!tc_insts[i]->COUNT16.CTRLA.bit.ENABLE && !tc_insts[i + 1]->COUNT16.CTRLA.bit.ENABLE) {
+            return i;
+        }
+    }
+    return 0xff;
+}
+
+static uint32_t read_stamp_counter(Tc* tc) {
+    tc->COUNT32.CTRLBSET.bit.CMD = TC_CTRLBSET_CMD_READSYNC_Val;
+    while ((tc->COUNT32.SYNCBUSY.bit.COUNT == 1) ||
+           (tc->COUNT32.CTRLBSET.bit.CMD == TC_CTRLBSET_CMD_READSYNC_Val)) {
+    }
+    return tc->COUNT32.COUNT.reg;
+}
+
+// Forget every stamp. Real edges never repeat a stamp, so filling the ring with the current
+// count marks each entry as one to stop at.
+static void clear_stamps(frequencyio_frequencyin_obj_t* self) {
+    uint32_t now = read_stamp_counter(tc_insts[self->tc_index]);
+    for (uint8_t i = 0; i < FREQUENCYIN_STAMP_COUNT; i++) {
+        self->stamps[i] = now;
+    }
+    self->cleared_stamp = now;
+    self->newest_stamp = now;
+    self->newest_ms = ticks_ms;
+}
+
+static void start_stamp_dma(frequencyio_frequencyin_obj_t* self, Tc* tc) {
+    DmacDescriptor* descriptor = dma_descriptor(self->dma_channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID |
+                             DMAC_BTCTRL_BLOCKACT_NOACT |
+                             DMAC_BTCTRL_EVOSEL_BLOCK |
+                             DMAC_BTCTRL_DSTINC |
+                             DMAC_BTCTRL_BEATSIZE_WORD;
+    descriptor->BTCNT.reg = FREQUENCYIN_STAMP_COUNT;
+    descriptor->SRCADDR.reg = (uint32_t) &tc->COUNT32.CC[0].reg;
+    // With DSTINC, DSTADDR is the end of the block.
+    descriptor->DSTADDR.reg = (uint32_t) (self->stamps + FREQUENCYIN_STAMP_COUNT);
+    descriptor->DESCADDR.reg = (uint32_t) descriptor;
+    dma_configure(self->dma_channel, TC_MC0_DMA_TRIGGER(self->tc_index), false);
+    dma_enable_channel(self->dma_channel);
+}
+
+// The frequency over the newest edges that span at least capture_period, computed from whole
+// periods so that the sub-count phase of the first and last edge doesn't matter.
+static float reciprocal_frequency(frequencyio_frequencyin_obj_t* self) {
+    DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+    uint16_t remaining = write_back[self->dma_channel].BTCNT.reg;
+    uint32_t now = read_stamp_counter(tc_insts[self->tc_index]);
+
+    uint8_t index = (2 * FREQUENCYIN_STAMP_COUNT - 1 - remaining) % FREQUENCYIN_STAMP_COUNT;
+    uint32_t newest = self->stamps[index];
+    if (newest != self->newest_stamp) {
+        self->newest_stamp = newest;
+        self->newest_ms = ticks_ms;
+    }
+    if (newest == self->cleared_stamp || ticks_ms - self->newest_ms > STAMP_MAX_AGE_MS) {
+        return 0;
+    }
+
+    uint32_t window = self->capture_period * (STAMP_CLOCK_HZ / 1000);
+    uint32_t span = 0;
+    uint8_t periods = 0;
+    for (uint8_t i = 1; i < FREQUENCYIN_STAMP_COUNT && span < window; i++) {
+        index = (index + FREQUENCYIN_STAMP_COUNT - 1) % FREQUENCYIN_STAMP_COUNT;
+        uint32_t stamp = self->stamps[index];
+        uint32_t new_span = newest - stamp;
+        // Stop at a cleared entry, or at one the DMA has overwritten with a newer edge.
+        if (stamp == self->cleared_stamp || new_span <= span || new_span >= 0x80000000) {
+            break;
+        }
+        span = new_span;
+        periods++;
+    }
+    if (periods == 0) {
+        return 0;
+    }
+
+    // Once no edge has arrived for two average periods the signal has slowed or stopped, so
+    // report the rate the time since the last edge allows for instead.
+    uint32_t elapsed = now - newest;
+    if ((uint64_t) elapsed * periods > 2 * (uint64_t) span) {
+        return (float) STAMP_CLOCK_HZ / elapsed;
+    }
+    return (float) STAMP_CLOCK_HZ * periods / span;
+}
 #endif
 
-void common_hal_frequencyio_frequencyin_construct(frequencyio_frequencyin_obj_t* self, const mcu_pin_obj_t* pin, const uint16_t capture_period) {
+void common_hal_frequencyio_frequencyin_construct(frequencyio_frequencyin_obj_t* self, const mcu_pin_obj_t* pin, const uint16_t capture_period, bool reciprocal) {
+    #ifdef SAMD21
+    if (reciprocal) {
+        mp_raise_NotImplementedError(translate("Reciprocal counting is not supported"));
+    }
+    #endif
 
     if (!pin->has_extint) {
         mp_raise_RuntimeError(translate("No hardware support on pin"));
@@ -265,13 +367,35 @@ void common_hal_frequencyio_frequencyin_construct(frequencyio_frequencyin_obj_t*
         mp_raise_RuntimeError(translate("EXTINT channel already in use"));
     }
 
-    uint8_t timer_index = find_free_timer();
-    if (timer_index == 0xff) {
-        mp_raise_RuntimeError(translate("All timers in use"));
+    uint8_t timer_index;
+    #ifdef SAMD51
+    uint8_t dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    if (reciprocal) {
+        timer_index = find_free_timer_pair();
+        if (timer_index == 0xff) {
+            mp_raise_RuntimeError(translate("All timers in use"));
+        }
+        dma_channel = find_free_audio_dma_channel();
+        if (dma_channel >= AUDIO_DMA_CHANNEL_COUNT) {
+            mp_raise_RuntimeError(translate("No DMA channel found"));
+        }
+        self->stamps = m_new(uint32_t, FREQUENCYIN_STAMP_COUNT);
+    } else
+    #endif
+    {
+        timer_index = find_free_timer();
+        if (timer_index == 0xff) {
+            mp_raise_RuntimeError(translate("All timers in use"));
+        }
+        self->stamps = NULL;
     }
     Tc *tc = tc_insts[timer_index];
 
     self->tc_index = timer_index;
+    self->reciprocal = reciprocal;
+    #ifdef SAMD51
+    self->dma_channel = dma_channel;
+    #endif
     self->pin = pin->number;
     self->channel = pin->extint_channel;
     self->errored_too_fast = false;
@@ -301,6 +425,10 @@ void common_hal_frequencyio_frequencyin_construct(frequencyio_frequencyin_obj_t*
     }
     set_timer_handler(timer_index, dpll_gclk, TC_HANDLER_NO_INTERRUPT);
     turn_on_clocks(true, timer_index, dpll_gclk);
+    if (reciprocal) {
+        // The odd TC of a pair is clocked with the even one but still needs its bus clock.
+        turn_on_clocks(true, timer_index + 1, dpll_gclk);
+    }
     #endif
 
     // Ensure EIC is on
@@ -351,9 +479,18 @@ void common_hal_frequencyio_frequencyin_construct(frequencyio_frequencyin_obj_t*
     #endif
 
     #ifdef SAMD51
-    tc->COUNT16.EVCTRL.reg = TC_EVCTRL_EVACT(TC_EVCTRL_EVACT_COUNT_Val) | TC_EVCTRL_TCEI;
-    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
-                            TC_CTRLA_PRESCALER_DIV1;
+    if (reciprocal) {
+        // Each edge copies the free running count into CC0, and the capture triggers DMA
+        // into the stamp ring, so no interrupts are needed.
+        tc->COUNT32.EVCTRL.reg = TC_EVCTRL_EVACT(TC_EVCTRL_EVACT_STAMP_Val) | TC_EVCTRL_TCEI;
+        tc->COUNT32.CTRLA.reg = TC_CTRLA_MODE_COUNT32 |
+                                TC_CTRLA_PRESCALER_DIV1 |
+                                TC_CTRLA_CAPTEN0;
+    } else {
+        tc->COUNT16.EVCTRL.reg = TC_EVCTRL_EVACT(TC_EVCTRL_EVACT_COUNT_Val) | TC_EVCTRL_TCEI;
+        tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
+                                TC_CTRLA_PRESCALER_DIV1;
+    }
     #endif
 
     NVIC_EnableIRQ(self->TC_IRQ);
@@ -362,6 +499,17 @@ void common_hal_frequencyio_frequencyin_construct(frequencyio_frequencyin_obj_t*
 
     tc_set_enable(tc, true);
 
+    #ifdef SAMD51
+    if (reciprocal) {
+        // The odd TC's registers don't affect the pair, but find_free_timer() only checks
+        // ENABLE so set it to keep the TC from being handed out.
+        tc_insts[timer_index + 1]->COUNT16.CTRLA.bit.ENABLE = 1;
+        clear_stamps(self);
+        start_stamp_dma(self, tc);
+        return;
+    }
+    #endif
+
     // setup reference TC if not already
     if (reference_tc == 0xff) {
         reference_tc = find_free_timer();
@@ -410,8 +558,20 @@ void common_hal_frequencyio_frequencyin_deinit(frequencyio_frequencyin_obj_t* se
 
     // turn off the TC we were using
     Tc *tc = tc_insts[self->tc_index];
+    #ifdef SAMD51
+    if (self->reciprocal) {
+        dma_disable_channel(self->dma_channel);
+        dma_descriptor(self->dma_channel)->BTCTRL.bit.VALID = false;
+        self->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    }
+    #endif
     tc_set_enable(tc, false);
     tc_reset(tc);
+    #ifdef SAMD51
+    if (self->reciprocal) {
+        tc_reset(tc_insts[self->tc_index + 1]);
+    }
+    #endif
     NVIC_DisableIRQ(self->TC_IRQ);
     NVIC_ClearPendingIRQ(self->TC_IRQ);
 
@@ -434,7 +594,12 @@ void common_hal_frequencyio_frequencyin_deinit(frequencyio_frequencyin_obj_t* se
     }
 }
 
-uint32_t common_hal_frequencyio_frequencyin_get_item(frequencyio_frequencyin_obj_t* self) {
+float common_hal_frequencyio_frequencyin_get_item(frequencyio_frequencyin_obj_t* self) {
+    #ifdef SAMD51
+    if (self->reciprocal) {
+        return reciprocal_frequency(self);
+    }
+    #endif
     NVIC_DisableIRQ(self->TC_IRQ);
     #ifdef SAMD21
     NVIC_DisableIRQ(EIC_IRQn);
@@ -505,10 +670,22 @@ void common_hal_frequencyio_frequencyin_resume(frequencyio_frequencyin_obj_t* se
     EIC->EVCTRL.bit.EXTINTEO = masked_value | (1 << self->channel);
     #endif
     self->errored_too_fast = false;
+    #ifdef SAMD51
+    if (self->reciprocal) {
+        // Don't count the pause as a period.
+        clear_stamps(self);
+    }
+    #endif
     return;
 }
 
 void common_hal_frequencyio_frequencyin_clear(frequencyio_frequencyin_obj_t* self) {
+    #ifdef SAMD51
+    if (self->reciprocal) {
+        clear_stamps(self);
+        return;
+    }
+    #endif
     NVIC_DisableIRQ(self->TC_IRQ);
     #ifdef SAMD21
     NVIC_DisableIRQ(EIC_IRQn);
@@ -532,6 +709,10 @@ void common_hal_frequencyio_frequencyin_clear(frequencyio_frequencyin_obj_t* sel
     return;
 }
 
+bool common_hal_frequencyio_frequencyin_get_reciprocal(frequencyio_frequencyin_obj_t *self) {
+    return self->reciprocal;
+}
+
 uint16_t common_hal_frequencyio_frequencyin_get_capture_period(frequencyio_frequencyin_obj_t *self) {
     return self->capture_period;
 }
@@ -545,3 +726,11 @@ void common_hal_frequencyio_frequencyin_set_capture_period(frequencyio_frequency
 
     common_hal_frequencyio_frequencyin_clear(self);
 }
+
+void frequencyin_reset(void) {
+    for (uint8_t i = 0; i < TC_INST_NUM; i++) {
+        if (active_frequencyins[i] != NULL) {
+            common_hal_frequencyio_frequencyin_deinit(active_frequencyins[i]);
+        }
+    }
+}
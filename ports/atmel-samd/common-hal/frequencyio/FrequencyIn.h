@@ -31,6 +31,9 @@
 
 #include "py/obj.h"
 
+// Edge time stamps kept for reciprocal counting.
+#define FREQUENCYIN_STAMP_COUNT (64)
+
 typedef struct {
     mp_obj_base_t base;
     uint8_t tc_index;
@@ -44,10 +47,18 @@ typedef struct {
     uint32_t capture_period;
     uint8_t TC_IRQ;
     volatile bool errored_too_fast;
+    bool reciprocal;
+    uint8_t dma_channel;
+    // Ring of TC captures, one per rising edge, filled by DMA.
+    uint32_t* stamps;
+    uint32_t cleared_stamp;
+    uint32_t newest_stamp;
+    uint64_t newest_ms;
 } frequencyio_frequencyin_obj_t;
 
 void frequencyin_interrupt_handler(uint8_t index);
 void frequencyin_emergency_cancel_capture(uint8_t index);
+void frequencyin_reset(void);
 void frequencyin_reference_tc_init(void);
 void frequencyin_reference_tc_enable(bool enable);
 bool frequencyin_reference_tc_enabled(void);
@@ -24,6 +24,8 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "shared-bindings/i2cslave/I2CSlave.h"
 #include "common-hal/busio/I2C.h"
 
@@ -35,9 +37,70 @@
 #include "hal/include/hal_gpio.h"
 #include "peripherals/samd/sercom.h"
 
+#ifdef SAMD21
+#define FIRST_SERCOM_IRQ SERCOM0_IRQn
+#define SERCOM_IRQ_LINES (1)
+#define VECTOR_TABLE_ALIGNMENT (256)
+#endif
+#ifdef SAMD51
+#define FIRST_SERCOM_IRQ SERCOM0_0_IRQn
+#define SERCOM_IRQ_LINES (4)
+#define VECTOR_TABLE_ALIGNMENT (1024)
+#endif
+
+#define VECTOR_COUNT (16 + PERIPH_COUNT_IRQn)
+#define REGISTER_MODE_INTERRUPTS (SERCOM_I2CS_INTENSET_AMATCH | SERCOM_I2CS_INTENSET_DRDY | \
+                                  SERCOM_I2CS_INTENSET_PREC | SERCOM_I2CS_INTENSET_ERROR)
+
+// ASF4 owns the SERCOM interrupt vectors for its USART driver, so register
+// mode runs from a copy of the vector table in RAM with the slave's SERCOM
+// lines pointed at i2c_slave_irq_handler.
+static uint32_t ram_vectors[VECTOR_COUNT] __attribute__((aligned(VECTOR_TABLE_ALIGNMENT)));
+static const uint32_t *flash_vectors = NULL;
+
+static void i2c_slave_irq_handler(void);
+
+static void set_sercom_vectors(uint8_t sercom_index, bool register_mode) {
+    if (flash_vectors == NULL) {
+        flash_vectors = (const uint32_t *) SCB->VTOR;
+        memcpy(ram_vectors, flash_vectors, sizeof(ram_vectors));
+        __DSB();
+        SCB->VTOR = (uint32_t) ram_vectors;
+        __DSB();
+    }
+    for (uint8_t i = 0; i < SERCOM_IRQ_LINES; i++) {
+        IRQn_Type irq = FIRST_SERCOM_IRQ + sercom_index * SERCOM_IRQ_LINES + i;
+        NVIC_DisableIRQ(irq);
+        NVIC_ClearPendingIRQ(irq);
+        if (register_mode) {
+            ram_vectors[16 + irq] = (uint32_t) i2c_slave_irq_handler;
+            NVIC_EnableIRQ(irq);
+        } else {
+            ram_vectors[16 + irq] = flash_vectors[16 + irq];
+        }
+    }
+}
+
+static void register_mode_deinit(i2cslave_i2c_slave_obj_t *self) {
+    self->sercom->I2CS.INTENCLR.reg = REGISTER_MODE_INTERRUPTS;
+    set_sercom_vectors(self->sercom_index, false);
+    MP_STATE_PORT(i2cslave_register_slaves)[self->sercom_index] = NULL;
+    self->registers = NULL;
+}
+
+void i2cslave_reset(void) {
+    for (uint8_t i = 0; i < SERCOM_INST_NUM; i++) {
+        i2cslave_i2c_slave_obj_t *self = MP_STATE_PORT(i2cslave_register_slaves)[i];
+        if (self != NULL) {
+            register_mode_deinit(self);
+        }
+    }
+}
+
 void common_hal_i2cslave_i2c_slave_construct(i2cslave_i2c_slave_obj_t *self,
         const mcu_pin_obj_t *scl, const mcu_pin_obj_t *sda,
-        uint8_t *addresses, unsigned int num_addresses, bool smbus) {
+        uint8_t *addresses, unsigned int num_addresses, bool smbus,
+        uint8_t *registers, size_t registers_len) {
     uint8_t sercom_index;
     uint32_t sda_pinmux, scl_pinmux;
     Sercom *sercom = samd_i2c_get_sercom(scl, sda, &sercom_index, &sda_pinmux, &scl_pinmux);
@@ -45,6 +108,8 @@ void common_hal_i2cslave_i2c_slave_construct(i2cslave_i2c_slave_obj_t *self,
         mp_raise_ValueError(translate("Invalid pins"));
     }
     self->sercom = sercom;
+    self->sercom_index = sercom_index;
+    self->registers = NULL;
 
     gpio_set_pin_function(sda->number, GPIO_PIN_FUNCTION_OFF);
     gpio_set_pin_function(scl->number, GPIO_PIN_FUNCTION_OFF);
@@ -92,6 +157,21 @@ void common_hal_i2cslave_i2c_slave_construct(i2cslave_i2c_slave_obj_t *self,
     sercom->I2CS.CTRLA.bit.SCLSM = 0; // Clock stretch before ack
     sercom->I2CS.CTRLA.bit.MODE = 0x04; // Slave mode
     sercom->I2CS.CTRLA.bit.ENABLE = 1;
+
+    if (registers != NULL) {
+        self->registers = registers;
+        self->registers_len = registers_len;
+        self->register_pointer = 0;
+        self->expect_register_pointer = false;
+        self->transmitting = false;
+        self->current_write.length = 0;
+        self->writes_head = 0;
+        self->writes_tail = 0;
+        MP_STATE_PORT(i2cslave_register_slaves)[sercom_index] = self;
+        sercom->I2CS.INTFLAG.reg = REGISTER_MODE_INTERRUPTS;
+        sercom->I2CS.INTENSET.reg = REGISTER_MODE_INTERRUPTS;
+        set_sercom_vectors(sercom_index, true);
+    }
 }
 
 bool common_hal_i2cslave_i2c_slave_deinited(i2cslave_i2c_slave_obj_t *self) {
@@ -103,6 +183,9 @@ void common_hal_i2cslave_i2c_slave_deinit(i2cslave_i2c_slave_obj_t *self) {
         return;
     }
 
+    if (self->registers != NULL) {
+        register_mode_deinit(self);
+    }
     self->sercom->I2CS.CTRLA.bit.ENABLE = 0;
 
     reset_pin_number(self->sda_pin);
@@ -250,3 +333,102 @@ void common_hal_i2cslave_i2c_slave_close(i2cslave_i2c_slave_obj_t *self) {
         mp_raise_OSError(MP_EIO);
     }
 }
+
+// Queues the bytes stored since the register pointer was last set. The queue
+// is only written here and only read by the VM, so no locking is needed.
+static void i2c_slave_finish_write(i2cslave_i2c_slave_obj_t *self) {
+    if (self->current_write.length == 0) {
+        return;
+    }
+    uint8_t next = (self->writes_head + 1) % I2CSLAVE_WRITE_QUEUE_LEN;
+    if (next != self->writes_tail) {
+        self->writes[self->writes_head] = self->current_write;
+        self->writes_head = next;
+    }
+    self->current_write.length = 0;
+}
+
+static bool i2c_slave_address_matches(i2cslave_i2c_slave_obj_t *self, uint8_t address) {
+    for (unsigned int i = 0; i < self->num_addresses; i++) {
+        if (address == self->addresses[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Serves register mode transfers: the first byte written after the address
+// sets the register pointer, later bytes are stored or read from there on
+// with auto-increment. Bytes beyond the buffer are dropped or read as 0xff.
+static void i2c_slave_irq_handler(void) {
+    uint8_t irq = (__get_IPSR() & 0x1ff) - 16;
+    uint8_t sercom_index = (irq - FIRST_SERCOM_IRQ) / SERCOM_IRQ_LINES;
+    i2cslave_i2c_slave_obj_t *self = MP_STATE_PORT(i2cslave_register_slaves)[sercom_index];
+    Sercom *sercom = sercom_insts[sercom_index];
+    if (self == NULL) {
+        sercom->I2CS.INTENCLR.reg = REGISTER_MODE_INTERRUPTS;
+        return;
+    }
+
+    uint8_t flags = sercom->I2CS.INTFLAG.reg;
+    if (flags & SERCOM_I2CS_INTFLAG_ERROR) {
+        sercom->I2CS.INTFLAG.reg = SERCOM_I2CS_INTFLAG_ERROR;
+        i2c_slave_finish_write(self);
+    }
+
+    if (flags & SERCOM_I2CS_INTFLAG_AMATCH) {
+        // A repeated start ends a write without a stop condition.
+        i2c_slave_finish_write(self);
+        bool match = i2c_slave_address_matches(self, sercom->I2CS.DATA.reg >> 1);
+        self->transmitting = sercom->I2CS.STATUS.bit.DIR;
+        self->writing = false;
+        self->expect_register_pointer = match && !self->transmitting;
+        common_hal_i2cslave_i2c_slave_ack(self, match);
+    } else if (flags & SERCOM_I2CS_INTFLAG_DRDY) {
+        if (self->transmitting) {
+            // RXNACK carries over from the previous transfer, so only
+            // check it once a byte has been sent in this one.
+            if (self->writing && sercom->I2CS.STATUS.bit.RXNACK) {
+                sercom->I2CS.CTRLB.bit.CMD = 0x02; // Wait for a start or stop
+                self->writing = false;
+                return;
+            }
+            uint8_t data = 0xff;
+            if (self->register_pointer < self->registers_len) {
+                data = self->registers[self->register_pointer];
+            }
+            self->register_pointer++;
+            self->writing = true;
+            sercom->I2CS.DATA.reg = data;
+        } else {
+            uint8_t data = sercom->I2CS.DATA.reg;
+            if (self->expect_register_pointer) {
+                self->register_pointer = data;
+                self->expect_register_pointer = false;
+                self->current_write.start = data;
+                self->current_write.length = 0;
+            } else {
+                if (self->register_pointer < self->registers_len) {
+                    self->registers[self->register_pointer] = data;
+                    self->current_write.length++;
+                }
+                self->register_pointer++;
+            }
+            common_hal_i2cslave_i2c_slave_ack(self, true);
+        }
+    } else if (flags & SERCOM_I2CS_INTFLAG_PREC) {
+        sercom->I2CS.INTFLAG.reg = SERCOM_I2CS_INTFLAG_PREC;
+        self->writing = false;
+        i2c_slave_finish_write(self);
+    }
+}
+
+bool common_hal_i2cslave_i2c_slave_get_write(i2cslave_i2c_slave_obj_t *self, uint8_t *start, size_t *length) {
+    if (self->writes_tail == self->writes_head) {
+        return false;
+    }
+    *start = self->writes[self->writes_tail].start;
+    *length = self->writes[self->writes_tail].length;
+    self->writes_tail = (self->writes_tail + 1) % I2CSLAVE_WRITE_QUEUE_LEN;
+    return true;
+}
@@ -30,6 +30,14 @@
 #include "common-hal/microcontroller/Pin.h"
 #include "py/obj.h"
 
+// Number of completed master writes remembered in register mode.
+#define I2CSLAVE_WRITE_QUEUE_LEN (8)
+
+typedef struct {
+    uint8_t start;
+    uint16_t length;
+} i2cslave_register_write_t;
+
 typedef struct {
     mp_obj_base_t base;
 
@@ -37,9 +45,23 @@ typedef struct {
     unsigned int num_addresses;
 
     Sercom *sercom;
+    uint8_t sercom_index;
     uint8_t scl_pin;
     uint8_t sda_pin;
     bool writing;
+
+    // Register mode, served from the SERCOM interrupt.
+    uint8_t *registers;
+    size_t registers_len;
+    uint8_t register_pointer;
+    bool expect_register_pointer;
+    bool transmitting;
+    i2cslave_register_write_t current_write;
+    i2cslave_register_write_t writes[I2CSLAVE_WRITE_QUEUE_LEN];
+    volatile uint8_t writes_head;
+    volatile uint8_t writes_tail;
 } i2cslave_i2c_slave_obj_t;
 
+void i2cslave_reset(void);
+
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_BUSIO_I2C_SLAVE_H
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "common-hal/interruptio/PinInterrupt.h"
+
+#include "atmel_start_pins.h"
+
+#include "eic_handler.h"
+#include "samd/external_interrupts.h"
+#include "py/mpstate.h"
+#include "py/runtime.h"
+#include "shared-bindings/interruptio/PinInterrupt.h"
+#include "supervisor/shared/translate.h"
+
+void common_hal_interruptio_pininterrupt_construct(interruptio_pininterrupt_obj_t* self,
+    const mcu_pin_obj_t* pin, mp_obj_t handler, bool rising, bool falling, digitalio_pull_t pull) {
+    if (!pin->has_extint) {
+        mp_raise_RuntimeError(translate("No hardware support on pin"));
+    }
+    if (eic_get_enable()) {
+        if (!eic_channel_free(pin->extint_channel)) {
+            mp_raise_RuntimeError(translate("A hardware interrupt channel is already in use"));
+        }
+    } else {
+        turn_on_external_interrupt_controller();
+    }
+
+    self->handler = handler;
+    self->missed = 0;
+    self->eic_channel = pin->extint_channel;
+    self->pin = pin->number;
+
+    gpio_set_pin_direction(self->pin, GPIO_DIRECTION_IN);
+    gpio_set_pin_function(self->pin, GPIO_PIN_FUNCTION_A);
+    if (pull == PULL_UP) {
+        gpio_set_pin_pull_mode(self->pin, GPIO_PULL_UP);
+    } else if (pull == PULL_DOWN) {
+        gpio_set_pin_pull_mode(self->pin, GPIO_PULL_DOWN);
+    } else {
+        gpio_set_pin_pull_mode(self->pin, GPIO_PULL_OFF);
+    }
+
+    set_eic_channel_data(self->eic_channel, (void*) self);
+    // The interrupt handler only knows the channel so keep the object alive from here.
+    MP_STATE_PORT(pin_interrupts)[self->eic_channel] = self;
+
+    claim_pin(pin);
+
+    uint32_t sense = EIC_CONFIG_SENSE0_BOTH_Val;
+    if (!falling) {
+        sense = EIC_CONFIG_SENSE0_RISE_Val;
+    } else if (!rising) {
+        sense = EIC_CONFIG_SENSE0_FALL_Val;
+    }
+    set_eic_handler(self->eic_channel, EIC_HANDLER_PIN_INTERRUPT);
+    turn_on_eic_channel(self->eic_channel, sense);
+}
+
+bool common_hal_interruptio_pininterrupt_deinited(interruptio_pininterrupt_obj_t* self) {
+    return self->pin == NO_PIN;
+}
+
+void common_hal_interruptio_pininterrupt_deinit(interruptio_pininterrupt_obj_t* self) {
+    if (common_hal_interruptio_pininterrupt_deinited(self)) {
+        return;
+    }
+
+    set_eic_handler(self->eic_channel, EIC_HANDLER_NO_INTERRUPT);
+    turn_off_eic_channel(self->eic_channel);
+    MP_STATE_PORT(pin_interrupts)[self->eic_channel] = NULL;
+
+    reset_pin_number(self->pin);
+    self->pin = NO_PIN;
+}
+
+bool common_hal_interruptio_pininterrupt_get_value(interruptio_pininterrupt_obj_t* self) {
+    return gpio_get_pin_level(self->pin);
+}
+
+uint32_t common_hal_interruptio_pininterrupt_get_missed(interruptio_pininterrupt_obj_t* self) {
+    return self->missed;
+}
+
+void pininterrupt_interrupt_handler(uint8_t channel) {
+    interruptio_pininterrupt_obj_t* self = get_eic_channel_data(channel);
+
+    // Nothing is allocated here. The handler gets the (already allocated) PinInterrupt and runs
+    // from the VM at its next pending check.
+    if (!mp_sched_schedule(self->handler, MP_OBJ_FROM_PTR(self))) {
+        self->missed += 1;
+    }
+}
+
+void pininterrupt_reset(void) {
+    for (uint8_t i = 0; i < EIC_EXTINT_NUM; i++) {
+        MP_STATE_PORT(pin_interrupts)[i] = NULL;
+    }
+}
@@ -82,6 +82,9 @@ void common_hal_mcu_on_next_reset(mcu_runmode_t runmode) {
 }
 
 void common_hal_mcu_reset(void) {
+    #if CIRCUITPY_NVM
+    nvm_bytearray_flush();
+    #endif
     reset();
 }
 
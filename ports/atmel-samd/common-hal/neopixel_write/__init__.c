@@ -25,12 +25,22 @@
  */
 #include "hpl_gpio.h"
 
+#include "py/gc.h"
 #include "py/mphal.h"
 
 #include "shared-bindings/neopixel_write/__init__.h"
 
 #include "tick.h"
 
+#include "hal/include/hal_gpio.h"
+#include "samd/dma.h"
+#include "samd/sercom.h"
+
+// Send through a free SERCOM's SPI output with DMA when the pin has one, leaving interrupts on.
+#ifndef NEOPIXEL_SPI_DMA
+#define NEOPIXEL_SPI_DMA (CIRCUITPY_FULL_BUILD)
+#endif
+
 #ifdef SAMD51
 #include "hri/hri_cmcc_d51.h"
 #include "hri/hri_nvmctrl_d51.h"
@@ -56,6 +66,98 @@
 uint64_t next_start_tick_ms = 0;
 uint32_t next_start_tick_us = 1000;
 
+// The next write must wait for the pixels to latch the data just sent.
+static void set_next_start_tick(void) {
+    current_tick(&next_start_tick_ms, &next_start_tick_us);
+    if (next_start_tick_us < 100) {
+        next_start_tick_ms += 1;
+        next_start_tick_us = 100 - next_start_tick_us;
+    } else {
+        next_start_tick_us -= 100;
+    }
+}
+
+#if NEOPIXEL_SPI_DMA
+// Each pixel bit is sent as three SPI bits at 2.4MHz, 100 for a zero and 110 for a one, which
+// gives the 0.42us and 0.83us high times within a 1.25us bit. This is the encoding of each nibble.
+static const uint16_t spi_nibbles[16] = {
+    0x924, 0x926, 0x934, 0x936, 0x9a4, 0x9a6, 0x9b4, 0x9b6,
+    0xd24, 0xd26, 0xd34, 0xd36, 0xda4, 0xda6, 0xdb4, 0xdb6,
+};
+
+static bool write_spi_dma(const mcu_pin_obj_t* pin, const uint8_t *pixels, uint32_t numBytes) {
+    // Allocating is only possible while the VM is running, which is when there are enough pixels
+    // for this to matter. The status pixel is bit-banged at other times.
+    if (MP_STATE_MEM(gc_pool_start) == 0) {
+        return false;
+    }
+
+    Sercom* sercom = NULL;
+    uint8_t sercom_index = 0;
+    uint32_t pinmux = 0;
+    uint8_t dopo = 0;
+    uint8_t dipo = 0;
+    for (int i = 0; i < NUM_SERCOMS_PER_PIN && sercom == NULL; i++) {
+        sercom_index = pin->sercom[i].index;
+        if (sercom_index >= SERCOM_INST_NUM || sercom_insts[sercom_index]->SPI.CTRLA.bit.ENABLE != 0) {
+            continue;
+        }
+        // The clock comes out of a pad that isn't connected to a pin. Nothing is received, so the
+        // input pad just has to differ from the output ones.
+        uint8_t data_pad = pin->sercom[i].pad;
+        for (uint8_t clock_pad = 1; clock_pad <= 3; clock_pad += 2) {
+            dopo = samd_peripherals_get_spi_dopo(clock_pad, data_pad);
+            if (dopo <= 0x3) {
+                sercom = sercom_insts[sercom_index];
+                pinmux = PINMUX(pin->number, (i == 0) ? MUX_C : MUX_D);
+                while (dipo == data_pad || dipo == clock_pad) {
+                    dipo++;
+                }
+                break;
+            }
+        }
+    }
+    if (sercom == NULL) {
+        return false;
+    }
+
+    uint32_t encoded_length = numBytes * 3;
+    uint8_t* encoded = m_new_maybe(uint8_t, encoded_length);
+    if (encoded == NULL) {
+        return false;
+    }
+    uint8_t* out = encoded;
+    for (uint32_t i = 0; i < numBytes; i++) {
+        uint32_t bits = spi_nibbles[pixels[i] >> 4] << 12 | spi_nibbles[pixels[i] & 0xf];
+        *out++ = bits >> 16;
+        *out++ = bits >> 8;
+        *out++ = bits;
+    }
+
+    samd_peripherals_sercom_clock_init(sercom, sercom_index);
+    sercom->SPI.CTRLA.bit.SWRST = 1;
+    while (sercom->SPI.SYNCBUSY.bit.SWRST || sercom->SPI.CTRLA.bit.SWRST) {}
+    sercom->SPI.CTRLA.reg = SERCOM_SPI_CTRLA_MODE(0x3) |
+                            SERCOM_SPI_CTRLA_DOPO(dopo) |
+                            SERCOM_SPI_CTRLA_DIPO(dipo);
+    sercom->SPI.BAUD.reg = samd_peripherals_spi_baudrate_to_baud_reg_value(2400000);
+    sercom->SPI.CTRLA.bit.ENABLE = 1;
+    while (sercom->SPI.SYNCBUSY.bit.ENABLE) {}
+
+    gpio_set_pin_function(pin->number, pinmux);
+    if (sercom_dma_write(sercom, encoded, encoded_length) >= 0) {
+        // Wait for the last bits to shift out.
+        while (sercom->SPI.INTFLAG.bit.TXC == 0) {}
+    }
+    set_next_start_tick();
+    gpio_set_pin_function(pin->number, GPIO_PIN_FUNCTION_OFF);
+
+    sercom->SPI.CTRLA.bit.SWRST = 1;
+    m_del(uint8_t, encoded, encoded_length);
+    return true;
+}
+#endif
+
 void common_hal_neopixel_write(const digitalio_digitalinout_obj_t* digitalinout, uint8_t *pixels, uint32_t numBytes) {
     // This is adapted directly from the Adafruit NeoPixel library SAMD21G18A code:
     // https://github.com/adafruit/Adafruit_NeoPixel/blob/master/Adafruit_NeoPixel.cpp
@@ -67,9 +169,18 @@ void common_hal_neopixel_write(const digitalio_digitalinout_obj_t* digitalinout,
     // future ms tick.
     wait_until(next_start_tick_ms, next_start_tick_us);
 
+    #if NEOPIXEL_SPI_DMA
+    if (write_spi_dma(digitalinout->pin, pixels, numBytes)) {
+        return;
+    }
+    #endif
+
     // Turn off interrupts of any kind during timing-sensitive code.
     mp_hal_disable_all_interrupts();
 
+    // The delays below count cycles at full speed.
+    uint8_t cpu_divider = tick_begin_full_speed();
+
 
     #ifdef SAMD21
     // Make sure the NVM cache is consistently timed.
@@ -174,15 +285,11 @@ void common_hal_neopixel_write(const digitalio_digitalinout_obj_t* digitalinout,
 
     #endif
 
+    tick_end_full_speed(cpu_divider);
+
     // ticks_ms may be out of date at this point because we stopped the
     // interrupt. We'll risk it anyway.
-    current_tick(&next_start_tick_ms, &next_start_tick_us);
-    if (next_start_tick_us < 100) {
-        next_start_tick_ms += 1;
-        next_start_tick_us = 100 - next_start_tick_us;
-    } else {
-        next_start_tick_us -= 100;
-    }
+    set_next_start_tick();
 
     // Turn on interrupts after timing-sensitive code.
     mp_hal_enable_all_interrupts();
@@ -29,27 +29,94 @@
 #include "hal_flash.h"
 
 #include "supervisor/shared/stack.h"
+#include "tick.h"
 
 #include <stdint.h>
 #include <string.h>
 
+// Writes are combined in a copy of one flash page and only programmed once
+// another page is written to, the page has been left alone for
+// NVM_FLUSH_DELAY_MS or the VM ends. A page whose update only clears bits
+// is programmed without erasing its row first.
+#define NVM_FLUSH_DELAY_MS (100)
+
+static uint8_t page_cache[FLASH_PAGE_SIZE];
+static uint32_t cached_page_address;
+static bool page_dirty = false;
+static uint64_t last_write_ms;
+
+static void write_cached_page(void) {
+    // We don't use features that use any advanced NVMCTRL features so we can fake the descriptor
+    // whenever we need it instead of storing it long term.
+    struct flash_descriptor desc;
+    desc.dev.hw = NVMCTRL;
+
+    const uint8_t *flash = (const uint8_t *) cached_page_address;
+    bool needs_erase = false;
+    for (uint32_t i = 0; i < FLASH_PAGE_SIZE; i++) {
+        if ((flash[i] & page_cache[i]) != page_cache[i]) {
+            needs_erase = true;
+            break;
+        }
+    }
+    if (needs_erase) {
+        flash_write(&desc, cached_page_address, page_cache, FLASH_PAGE_SIZE);
+    } else {
+        flash_append(&desc, cached_page_address, page_cache, FLASH_PAGE_SIZE);
+    }
+    page_dirty = false;
+}
+
+void nvm_bytearray_flush(void) {
+    if (page_dirty) {
+        write_cached_page();
+    }
+}
+
+void nvm_bytearray_background(void) {
+    if (page_dirty && ticks_ms - last_write_ms >= NVM_FLUSH_DELAY_MS) {
+        write_cached_page();
+    }
+}
+
 uint32_t common_hal_nvm_bytearray_get_length(nvm_bytearray_obj_t *self) {
     return self->len;
 }
 
 bool common_hal_nvm_bytearray_set_bytes(nvm_bytearray_obj_t *self,
         uint32_t start_index, uint8_t* values, uint32_t len) {
-    // We don't use features that use any advanced NVMCTRL features so we can fake the descriptor
-    // whenever we need it instead of storing it long term.
-    struct flash_descriptor desc;
-    desc.dev.hw = NVMCTRL;
-    flash_write(&desc, (uint32_t) self->start_address + start_index, values, len);
+    uint32_t address = (uint32_t) self->start_address + start_index;
+    while (len > 0) {
+        uint32_t offset = address % FLASH_PAGE_SIZE;
+        uint32_t page_address = address - offset;
+        uint32_t write_len = MIN(len, FLASH_PAGE_SIZE - offset);
+        if (!page_dirty || page_address != cached_page_address) {
+            nvm_bytearray_flush();
+            memcpy(page_cache, (uint8_t *) page_address, FLASH_PAGE_SIZE);
+            cached_page_address = page_address;
+        }
+        memcpy(page_cache + offset, values, write_len);
+        page_dirty = true;
+        address += write_len;
+        values += write_len;
+        len -= write_len;
+    }
+    last_write_ms = ticks_ms;
     assert_heap_ok();
     return true;
 }
 
-// NVM memory is memory mapped so reading it is easy.
+// NVM memory is memory mapped so reading it is easy, apart from a page that
+// hasn't been written out yet.
 void common_hal_nvm_bytearray_get_bytes(nvm_bytearray_obj_t *self,
     uint32_t start_index, uint32_t len, uint8_t* values) {
-    memcpy(values, self->start_address + start_index, len);
+    uint32_t address = (uint32_t) self->start_address + start_index;
+    memcpy(values, (uint8_t *) address, len);
+    if (!page_dirty || address >= cached_page_address + FLASH_PAGE_SIZE ||
+        address + len <= cached_page_address) {
+        return;
+    }
+    uint32_t first = MAX(address, cached_page_address);
+    uint32_t last = MIN(address + len, cached_page_address + FLASH_PAGE_SIZE);
+    memcpy(values + (first - address), page_cache + (first - cached_page_address), last - first);
 }
@@ -30,10 +30,10 @@
 #include "py/runtime.h"
 #include "common-hal/pulseio/PWMOut.h"
 #include "shared-bindings/pulseio/PWMOut.h"
-#include "shared-bindings/microcontroller/Processor.h"
 #include "timer_handler.h"
 
 #include "atmel_start_pins.h"
+#include "peripheral_clk_config.h"
 #include "hal/utils/include/utils_repeat_macro.h"
 #include "samd/timers.h"
 #include "supervisor/shared/translate.h"
@@ -48,6 +48,12 @@
 static uint32_t tcc_periods[TCC_INST_NUM];
 static uint32_t tc_periods[TC_INST_NUM];
 
+#ifdef SAMD21
+// SAMD21 TCs have no buffered compare registers, so a new duty cycle is held
+// here until the counter wraps instead of landing mid-period.
+static uint16_t tc_pending_duty[TC_INST_NUM];
+#endif
+
 uint32_t target_tcc_frequencies[TCC_INST_NUM];
 uint8_t tcc_refcount[TCC_INST_NUM];
 
@@ -226,8 +232,9 @@ pwmout_result_t common_hal_pulseio_pwmout_construct(pulseio_pwmout_obj_t* self,
             const uint8_t _tcc_sizes[TCC_INST_NUM] = TCC_SIZES;
             resolution = _tcc_sizes[timer->index];
         }
-        // First determine the divisor that gets us the highest resolution.
-        uint32_t system_clock = common_hal_mcu_processor_get_frequency();
+        // First determine the divisor that gets us the highest resolution. The timers run from
+        // the main clock, which stays at full speed when the CPU is slowed down.
+        uint32_t system_clock = CONF_CPU_FREQUENCY;
         uint32_t top;
         uint8_t divisor;
         for (divisor = 0; divisor < 8; divisor++) {
@@ -237,7 +244,11 @@ pwmout_result_t common_hal_pulseio_pwmout_construct(pulseio_pwmout_obj_t* self,
             }
         }
 
+        #ifdef SAMD21
+        set_timer_handler(timer->is_tc, timer->index, TC_HANDLER_PWMOUT);
+        #else
         set_timer_handler(timer->is_tc, timer->index, TC_HANDLER_NO_INTERRUPT);
+        #endif
         // We use the zeroeth clock on either port to go full speed.
         turn_on_clocks(timer->is_tc, timer->index, 0);
 
@@ -249,6 +260,7 @@ pwmout_result_t common_hal_pulseio_pwmout_construct(pulseio_pwmout_obj_t* self,
                                     TC_CTRLA_PRESCALER(divisor) |
                                     TC_CTRLA_WAVEGEN_MPWM;
             tc->COUNT16.CC[0].reg = top;
+            tc_enable_interrupts(timer->index);
             #endif
             #ifdef SAMD51
 
@@ -301,6 +313,9 @@ void common_hal_pulseio_pwmout_deinit(pulseio_pwmout_obj_t* self) {
     const pin_timer_t* t = self->timer;
     if (t->is_tc) {
         Tc* tc = tc_insts[t->index];
+        #ifdef SAMD21
+        tc_disable_interrupts(t->index);
+        #endif
         tc_set_enable(tc, false);
         tc->COUNT16.CTRLA.bit.SWRST = true;
         tc_wait_for_sync(tc);
@@ -321,38 +336,94 @@ void common_hal_pulseio_pwmout_deinit(pulseio_pwmout_obj_t* self) {
     self->pin = mp_const_none;
 }
 
+#ifdef SAMD21
+void pwmout_interrupt_handler(uint8_t index) {
+    Tc* tc = tc_insts[index];
+    if (!tc->COUNT16.INTFLAG.bit.OVF) {
+        return;
+    }
+    tc->COUNT16.CC[1].reg = tc_pending_duty[index];
+    tc->COUNT16.INTENCLR.reg = TC_INTENCLR_OVF;
+    tc->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+}
+#endif
+
+// Writes into the CC buffer register, which will be transferred to the CC
+// register on an UPDATE (when period is finished). The caller must have
+// locked out updates with tcc_lock_update().
+static void set_tcc_duty_cycle(const pin_timer_t* t, uint16_t duty) {
+    uint32_t adjusted_duty = ((uint64_t) tcc_periods[t->index]) * duty / 0xffff;
+    uint8_t channel = tcc_channel(t);
+    Tcc* tcc = tcc_insts[t->index];
+    #ifdef SAMD21
+    tcc->CCB[channel].reg = adjusted_duty;
+    #endif
+    #ifdef SAMD51
+    tcc->CCBUF[channel].reg = adjusted_duty;
+    #endif
+}
+
+// Lock out double-buffering while updating the CCB values so that they all
+// take effect on the same UPDATE.
+static void tcc_lock_update(Tcc* tcc) {
+    // Do clock domain syncing as necessary.
+    while (tcc->SYNCBUSY.reg != 0) {}
+    tcc->CTRLBSET.bit.LUPD = 1;
+}
+
+static void tcc_unlock_update(Tcc* tcc) {
+    tcc->CTRLBCLR.bit.LUPD = 1;
+}
+
 extern void common_hal_pulseio_pwmout_set_duty_cycle(pulseio_pwmout_obj_t* self, uint16_t duty) {
     const pin_timer_t* t = self->timer;
     if (t->is_tc) {
         uint16_t adjusted_duty = tc_periods[t->index] * duty / 0xffff;
+        Tc* tc = tc_insts[t->index];
         #ifdef SAMD21
-        tc_insts[t->index]->COUNT16.CC[t->wave_output].reg = adjusted_duty;
+        if (tc->COUNT16.CTRLA.bit.ENABLE == 0) {
+            tc->COUNT16.CC[t->wave_output].reg = adjusted_duty;
+            return;
+        }
+        tc->COUNT16.INTENCLR.reg = TC_INTENCLR_OVF;
+        tc_pending_duty[t->index] = adjusted_duty;
+        tc->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+        tc->COUNT16.INTENSET.reg = TC_INTENSET_OVF;
         #endif
         #ifdef SAMD51
-        Tc* tc = tc_insts[t->index];
         while (tc->COUNT16.SYNCBUSY.bit.CC1 != 0) {}
         tc->COUNT16.CCBUF[1].reg = adjusted_duty;
         #endif
     } else {
-        uint32_t adjusted_duty = ((uint64_t) tcc_periods[t->index]) * duty / 0xffff;
-        uint8_t channel = tcc_channel(t);
         Tcc* tcc = tcc_insts[t->index];
+        tcc_lock_update(tcc);
+        set_tcc_duty_cycle(t, duty);
+        tcc_unlock_update(tcc);
+    }
+}
 
-        // Write into the CC buffer register, which will be transferred to the
-        // CC register on an UPDATE (when period is finished).
-        // Do clock domain syncing as necessary.
-
-        while (tcc->SYNCBUSY.reg != 0) {}
-
-        // Lock out double-buffering while updating the CCB value.
-        tcc->CTRLBSET.bit.LUPD = 1;
-        #ifdef SAMD21
-        tcc->CCB[channel].reg = adjusted_duty;
-        #endif
-        #ifdef SAMD51
-        tcc->CCBUF[channel].reg = adjusted_duty;
-        #endif
-        tcc->CTRLBCLR.bit.LUPD = 1;
+void common_hal_pulseio_pwmout_set_duty_cycles(pulseio_pwmout_obj_t** pwms,
+        const uint16_t* duty_cycles, size_t count) {
+    uint32_t locked = 0;
+    for (size_t i = 0; i < count; i++) {
+        const pin_timer_t* t = pwms[i]->timer;
+        if (!t->is_tc && (locked & (1 << t->index)) == 0) {
+            tcc_lock_update(tcc_insts[t->index]);
+            locked |= 1 << t->index;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        const pin_timer_t* t = pwms[i]->timer;
+        if (t->is_tc) {
+            common_hal_pulseio_pwmout_set_duty_cycle(pwms[i], duty_cycles[i]);
+        } else {
+            set_tcc_duty_cycle(t, duty_cycles[i]);
+        }
+    }
+    for (uint8_t i = 0; i < TCC_INST_NUM; i++) {
+        if ((locked & (1 << i)) != 0) {
+            tcc_unlock_update(tcc_insts[i]);
+        }
     }
 }
 
@@ -362,6 +433,11 @@ uint16_t common_hal_pulseio_pwmout_get_duty_cycle(pulseio_pwmout_obj_t* self) {
         Tc* tc = tc_insts[t->index];
         tc_wait_for_sync(tc);
         uint16_t cv = tc->COUNT16.CC[t->wave_output].reg;
+        #ifdef SAMD21
+        if (tc->COUNT16.INTENSET.bit.OVF) {
+            cv = tc_pending_duty[t->index];
+        }
+        #endif
         return cv * 0xffff / tc_periods[t->index];
     } else {
         Tcc* tcc = tcc_insts[t->index];
@@ -406,7 +482,7 @@ void common_hal_pulseio_pwmout_set_frequency(pulseio_pwmout_obj_t* self,
     } else {
         resolution = 24;
     }
-    uint32_t system_clock = common_hal_mcu_processor_get_frequency();
+    uint32_t system_clock = CONF_CPU_FREQUENCY;
     uint32_t new_top;
     uint8_t new_divisor;
     for (new_divisor = 0; new_divisor < 8; new_divisor++) {
@@ -454,7 +530,7 @@ void common_hal_pulseio_pwmout_set_frequency(pulseio_pwmout_obj_t* self,
 }
 
 uint32_t common_hal_pulseio_pwmout_get_frequency(pulseio_pwmout_obj_t* self) {
-    uint32_t system_clock = common_hal_mcu_processor_get_frequency();
+    uint32_t system_clock = CONF_CPU_FREQUENCY;
     const pin_timer_t* t = self->timer;
     uint8_t divisor;
     uint32_t top;
@@ -39,5 +39,6 @@ typedef struct {
 } pulseio_pwmout_obj_t;
 
 void pwmout_reset(void);
+void pwmout_interrupt_handler(uint8_t index);
 
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_PULSEIO_PWMOUT_H
@@ -36,13 +36,41 @@
 #include "mpconfigport.h"
 #include "py/gc.h"
 #include "py/runtime.h"
+#include "samd/clocks.h"
+#include "samd/dma.h"
+#include "samd/events.h"
 #include "samd/external_interrupts.h"
 #include "samd/pins.h"
+#include "samd/timers.h"
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/pulseio/PulseIn.h"
 #include "supervisor/shared/translate.h"
 
 #include "tick.h"
+#include "timer_handler.h"
+
+// When a timer, an event channel and a DMA channel are free, edges are timestamped in hardware
+// instead of by interrupt. The EIC sends an event on both edges to a TC which captures its counter,
+// and the DMA copies each capture straight into the pulse buffer. The raw captures are turned into
+// durations in place later, so nothing runs per edge. The TC counts at 3MHz from a 48MHz clock
+// and its overflow interrupt, every ~22ms, extends the 16 bit captures.
+#define CAPTURE_TICKS_PER_US 3
+
+#ifdef SAMD21
+#define FIRST_TC_MC0_TRIGGER TC3_DMAC_ID_MC_0
+#define FIRST_TC_EVENT_USER EVSYS_ID_USER_TC3_EVU
+#define FIRST_TC_IRQ TC3_IRQn
+#endif
+#ifdef SAMD51
+#define FIRST_TC_MC0_TRIGGER TC0_DMAC_ID_MC_0
+#define FIRST_TC_EVENT_USER EVSYS_ID_USER_TC0_EVU
+#define FIRST_TC_IRQ TC0_IRQn
+#endif
+// Each TC has three DMA triggers: OVF, MC0 and MC1.
+#define TC_DMA_TRIGGER_STRIDE 3
+
+// PulseIns capturing in hardware, indexed by TC.
+static pulseio_pulsein_obj_t* capture_pulseins[TC_INST_NUM];
 
 static void pulsein_set_config(pulseio_pulsein_obj_t* self, bool first_edge) {
     uint32_t sense_setting;
@@ -106,6 +134,245 @@ void pulsein_interrupt_handler(uint8_t channel) {
     self->last_us = current_us;
 }
 
+static bool capture_enabled(pulseio_pulsein_obj_t* self) {
+    return self->tc_index != 0xff;
+}
+
+static void capture_set_event_output(pulseio_pulsein_obj_t* self, bool enable) {
+    uint32_t mask = 1 << self->channel;
+    eic_set_enable(false);
+    if (enable) {
+        EIC->EVCTRL.reg |= mask << EIC_EVCTRL_EXTINTEO_Pos;
+    } else {
+        EIC->EVCTRL.reg &= ~(mask << EIC_EVCTRL_EXTINTEO_Pos);
+    }
+    eic_set_enable(true);
+}
+
+// Ring index the DMA will write the next capture to.
+static uint16_t capture_write_index(pulseio_pulsein_obj_t* self) {
+    uint32_t remaining;
+    uint32_t active = DMAC->ACTIVE.reg;
+    if ((active & DMAC_ACTIVE_ABUSY) != 0 &&
+        (active & DMAC_ACTIVE_ID_Msk) >> DMAC_ACTIVE_ID_Pos == self->dma_channel) {
+        remaining = (active & DMAC_ACTIVE_BTCNT_Msk) >> DMAC_ACTIVE_BTCNT_Pos;
+    } else {
+        DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+        remaining = write_back[self->dma_channel].BTCNT.reg;
+    }
+    return (self->maxlen - remaining) % self->maxlen;
+}
+
+// Convert the captures the DMA has written since the last call into durations. Must be called
+// with interrupts disabled, and at least once per timer overflow, which the overflow interrupt
+// guarantees. An overflow that hasn't been counted yet only applies to the captures taken after
+// it, which are the ones with small counter values.
+static void capture_update(pulseio_pulsein_obj_t* self) {
+    // Read the write index before the overflow flag so that every capture being converted
+    // happened before the flag was sampled.
+    uint16_t write_index = capture_write_index(self);
+    bool overflow_pending = tc_insts[self->tc_index]->COUNT16.INTFLAG.bit.OVF;
+    while (self->captured != write_index) {
+        uint16_t i = self->captured;
+        uint16_t count = self->buffer[i];
+        uint32_t epoch = self->overflows;
+        if (overflow_pending && count < 0x8000) {
+            epoch++;
+        }
+        uint32_t timestamp = (epoch << 16) | count;
+        self->captured = (i + 1) % self->maxlen;
+
+        if (self->skip_edge) {
+            // The pin wasn't idle when we started so this edge ends a partial pulse.
+            self->skip_edge = false;
+        } else if (self->first_edge) {
+            self->first_edge = false;
+            self->start = self->captured;
+            self->len = 0;
+        } else {
+            uint32_t duration = (timestamp - self->last_capture + CAPTURE_TICKS_PER_US / 2) /
+                CAPTURE_TICKS_PER_US;
+            self->buffer[i] = duration < 0xffff ? duration : 0xffff;
+            if (self->len < self->maxlen) {
+                self->len++;
+            } else {
+                self->start = (self->start + 1) % self->maxlen;
+            }
+        }
+        self->last_capture = timestamp;
+    }
+}
+
+// Drain captures and read the duration at index in the ring. While the ring is full the DMA keeps
+// overwriting the oldest entry so retry if a capture landed while it was being read. The caller
+// must have disabled interrupts and checked index against len.
+static uint16_t capture_get(pulseio_pulsein_obj_t* self, uint16_t index) {
+    uint16_t value;
+    do {
+        capture_update(self);
+        value = self->buffer[(self->start + index) % self->maxlen];
+    } while (capture_write_index(self) != self->captured);
+    return value;
+}
+
+// Restart the DMA at the start of the ring with nothing captured.
+static void capture_start(pulseio_pulsein_obj_t* self) {
+    dma_disable_channel(self->dma_channel);
+
+    // The descriptor links back to itself so the ring is refilled forever.
+    DmacDescriptor* descriptor = dma_descriptor(self->dma_channel);
+    Tc* tc = tc_insts[self->tc_index];
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_HWORD | DMAC_BTCTRL_DSTINC;
+    descriptor->BTCNT.reg = self->maxlen;
+    descriptor->SRCADDR.reg = (uint32_t) &tc->COUNT16.CC[0].reg;
+    // The destination address is the end of the block when incrementing.
+    descriptor->DSTADDR.reg = ((uint32_t) self->buffer) + self->maxlen * sizeof(uint16_t);
+    descriptor->DESCADDR.reg = (uint32_t) descriptor;
+    DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+    write_back[self->dma_channel].BTCNT.reg = self->maxlen;
+
+    self->captured = 0;
+    self->start = 0;
+    self->len = 0;
+    self->first_edge = true;
+    self->skip_edge = gpio_get_pin_level(self->pin) != self->idle_state;
+
+    // Throw away any capture left from before so it doesn't trigger the DMA.
+    (void) tc->COUNT16.CC[0].reg;
+    tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+    dma_configure(self->dma_channel, FIRST_TC_MC0_TRIGGER + TC_DMA_TRIGGER_STRIDE * self->tc_index,
+                  false);
+    dma_enable_channel(self->dma_channel);
+}
+
+// Try to set up hardware capture, leaving tc_index at 0xff if anything it needs is taken.
+static void capture_construct(pulseio_pulsein_obj_t* self) {
+    self->tc_index = 0xff;
+    if (self->maxlen == 0) {
+        return;
+    }
+    // Borrow from the last DMA channel like SPI because audio allocates from the first.
+    uint8_t dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    for (uint8_t i = AUDIO_DMA_CHANNEL_COUNT; i > 0; i--) {
+        if (!dma_channel_enabled(i - 1)) {
+            dma_channel = i - 1;
+            break;
+        }
+    }
+    if (dma_channel == AUDIO_DMA_CHANNEL_COUNT) {
+        return;
+    }
+    turn_on_event_system();
+    uint8_t event_channel = find_async_event_channel();
+    if (event_channel >= EVSYS_CHANNELS) {
+        return;
+    }
+    uint8_t tc_index = find_free_timer();
+    if (tc_index == 0xff) {
+        return;
+    }
+
+    self->tc_index = tc_index;
+    self->event_channel = event_channel;
+    self->dma_channel = dma_channel;
+    self->overflows = 0;
+    capture_pulseins[tc_index] = self;
+
+    // We use GCLK0 for SAMD21 and GCLK1 for SAMD51 because they both run at 48mhz.
+    set_timer_handler(true, tc_index, TC_HANDLER_PULSEIN);
+    #ifdef SAMD21
+    turn_on_clocks(true, tc_index, 0);
+    #endif
+    #ifdef SAMD51
+    turn_on_clocks(true, tc_index, 1);
+    #endif
+
+    Tc* tc = tc_insts[tc_index];
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    #ifdef SAMD21
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
+                            TC_CTRLA_PRESCALER_DIV16;
+    tc->COUNT16.CTRLC.reg = TC_CTRLC_CPTEN0;
+    tc->COUNT16.EVCTRL.reg = TC_EVCTRL_TCEI | TC_EVCTRL_EVACT_OFF;
+    #endif
+    #ifdef SAMD51
+    tc->COUNT16.EVCTRL.reg = TC_EVCTRL_TCEI | TC_EVCTRL_EVACT_OFF;
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
+                            TC_CTRLA_PRESCALER_DIV16 |
+                            TC_CTRLA_CAPTEN0;
+    #endif
+    tc->COUNT16.INTENSET.reg = TC_INTENSET_OVF;
+    NVIC_ClearPendingIRQ(FIRST_TC_IRQ + tc_index);
+    NVIC_EnableIRQ(FIRST_TC_IRQ + tc_index);
+    tc_set_enable(tc, true);
+
+    connect_event_user_to_channel(FIRST_TC_EVENT_USER + tc_index, event_channel);
+    init_async_event_channel(event_channel, EVSYS_ID_GEN_EIC_EXTINT_0 + self->channel);
+
+    // Edge detection needs the EIC clock so make sure the channel isn't asynchronous.
+    #ifdef SAMD51
+    eic_set_enable(false);
+    EIC->ASYNCH.reg &= ~(1 << self->channel);
+    eic_set_enable(true);
+    #endif
+    configure_eic_channel(self->channel, EIC_CONFIG_SENSE0_BOTH_Val);
+
+    capture_start(self);
+    capture_set_event_output(self, true);
+}
+
+static void capture_deinit(pulseio_pulsein_obj_t* self) {
+    capture_set_event_output(self, false);
+    disable_event_channel(self->event_channel);
+    disable_event_user(FIRST_TC_EVENT_USER + self->tc_index);
+
+    dma_disable_channel(self->dma_channel);
+    dma_descriptor(self->dma_channel)->BTCTRL.bit.VALID = false;
+
+    Tc* tc = tc_insts[self->tc_index];
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    NVIC_DisableIRQ(FIRST_TC_IRQ + self->tc_index);
+    NVIC_ClearPendingIRQ(FIRST_TC_IRQ + self->tc_index);
+    set_timer_handler(true, self->tc_index, TC_HANDLER_NO_INTERRUPT);
+
+    capture_pulseins[self->tc_index] = NULL;
+    self->tc_index = 0xff;
+}
+
+void pulsein_timer_interrupt_handler(uint8_t index) {
+    pulseio_pulsein_obj_t* self = capture_pulseins[index];
+    Tc* tc = tc_insts[index];
+    if (self == NULL || !tc->COUNT16.INTFLAG.bit.OVF) {
+        return;
+    }
+    capture_update(self);
+    tc->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+    self->overflows++;
+}
+
+void pulsein_reset(void) {
+    for (uint8_t i = 0; i < TC_INST_NUM; i++) {
+        if (capture_pulseins[i] != NULL) {
+            dma_disable_channel(capture_pulseins[i]->dma_channel);
+            dma_descriptor(capture_pulseins[i]->dma_channel)->BTCTRL.bit.VALID = false;
+            capture_pulseins[i] = NULL;
+        }
+    }
+}
+
+// Keep up with bursts of edges between overflows so the DMA doesn't lap the unconverted captures.
+void pulsein_background(void) {
+    for (uint8_t i = 0; i < TC_INST_NUM; i++) {
+        if (capture_pulseins[i] != NULL) {
+            common_hal_mcu_disable_interrupts();
+            capture_update(capture_pulseins[i]);
+            common_hal_mcu_enable_interrupts();
+        }
+    }
+}
+
 void common_hal_pulseio_pulsein_construct(pulseio_pulsein_obj_t* self,
         const mcu_pin_obj_t* pin, uint16_t maxlen, bool idle_state) {
     if (!pin->has_extint) {
@@ -137,12 +404,18 @@ void common_hal_pulseio_pulsein_construct(pulseio_pulsein_obj_t* self,
         turn_on_external_interrupt_controller();
     }
 
+    gpio_set_pin_direction(pin->number, GPIO_DIRECTION_IN);
     gpio_set_pin_function(pin->number, GPIO_PIN_FUNCTION_A);
 
-    turn_on_cpu_interrupt(self->channel);
-
     claim_pin(pin);
 
+    capture_construct(self);
+    if (capture_enabled(self)) {
+        return;
+    }
+
+    turn_on_cpu_interrupt(self->channel);
+
     // Set config will enable the EIC.
     pulsein_set_config(self, true);
 }
@@ -155,6 +428,9 @@ void common_hal_pulseio_pulsein_deinit(pulseio_pulsein_obj_t* self) {
     if (common_hal_pulseio_pulsein_deinited(self)) {
         return;
     }
+    if (capture_enabled(self)) {
+        capture_deinit(self);
+    }
     set_eic_handler(self->channel, EIC_HANDLER_NO_INTERRUPT);
     turn_off_eic_channel(self->channel);
     reset_pin_number(self->pin);
@@ -162,6 +438,10 @@ void common_hal_pulseio_pulsein_deinit(pulseio_pulsein_obj_t* self) {
 }
 
 void common_hal_pulseio_pulsein_pause(pulseio_pulsein_obj_t* self) {
+    if (capture_enabled(self)) {
+        capture_set_event_output(self, false);
+        return;
+    }
     uint32_t mask = 1 << self->channel;
     EIC->INTENCLR.reg = mask << EIC_INTENSET_EXTINT_Pos;
 }
@@ -183,6 +463,14 @@ void common_hal_pulseio_pulsein_resume(pulseio_pulsein_obj_t* self,
         gpio_set_pin_level(self->pin, self->idle_state);
     }
 
+    if (capture_enabled(self)) {
+        gpio_set_pin_direction(self->pin, GPIO_DIRECTION_IN);
+        gpio_set_pin_function(self->pin, GPIO_PIN_FUNCTION_A);
+        capture_start(self);
+        capture_set_event_output(self, true);
+        return;
+    }
+
     // Reconfigure the pin and make sure its set to detect the first edge.
     self->first_edge = true;
     self->last_ms = 0;
@@ -198,17 +486,34 @@ void common_hal_pulseio_pulsein_resume(pulseio_pulsein_obj_t* self,
 
 void common_hal_pulseio_pulsein_clear(pulseio_pulsein_obj_t* self) {
     common_hal_mcu_disable_interrupts();
+    if (capture_enabled(self)) {
+        // The DMA position can't move, so start the ring wherever the captures are up to.
+        capture_update(self);
+        self->start = self->captured;
+        self->len = 0;
+        common_hal_mcu_enable_interrupts();
+        return;
+    }
     self->start = 0;
     self->len = 0;
     common_hal_mcu_enable_interrupts();
 }
 
 uint16_t common_hal_pulseio_pulsein_popleft(pulseio_pulsein_obj_t* self) {
+    common_hal_mcu_disable_interrupts();
+    if (capture_enabled(self)) {
+        capture_update(self);
+    }
     if (self->len == 0) {
+        common_hal_mcu_enable_interrupts();
         mp_raise_IndexError(translate("pop from an empty PulseIn"));
     }
-    common_hal_mcu_disable_interrupts();
-    uint16_t value = self->buffer[self->start];
+    uint16_t value;
+    if (capture_enabled(self)) {
+        value = capture_get(self, 0);
+    } else {
+        value = self->buffer[self->start];
+    }
     self->start = (self->start + 1) % self->maxlen;
     self->len--;
     common_hal_mcu_enable_interrupts();
@@ -221,17 +526,28 @@ uint16_t common_hal_pulseio_pulsein_get_maxlen(pulseio_pulsein_obj_t* self) {
 }
 
 uint16_t common_hal_pulseio_pulsein_get_len(pulseio_pulsein_obj_t* self) {
+    if (capture_enabled(self)) {
+        common_hal_mcu_disable_interrupts();
+        capture_update(self);
+        common_hal_mcu_enable_interrupts();
+    }
     return self->len;
 }
 
 bool common_hal_pulseio_pulsein_get_paused(pulseio_pulsein_obj_t* self) {
     uint32_t mask = 1 << self->channel;
+    if (capture_enabled(self)) {
+        return (EIC->EVCTRL.reg & (mask << EIC_EVCTRL_EXTINTEO_Pos)) == 0;
+    }
     return (EIC->INTENSET.reg & (mask << EIC_INTENSET_EXTINT_Pos)) == 0;
 }
 
 uint16_t common_hal_pulseio_pulsein_get_item(pulseio_pulsein_obj_t* self,
         int16_t index) {
     common_hal_mcu_disable_interrupts();
+    if (capture_enabled(self)) {
+        capture_update(self);
+    }
     if (index < 0) {
         index += self->len;
     }
@@ -239,7 +555,12 @@ uint16_t common_hal_pulseio_pulsein_get_item(pulseio_pulsein_obj_t* self,
         common_hal_mcu_enable_interrupts();
         mp_raise_IndexError(translate("index out of range"));
     }
-    uint16_t value = self->buffer[(self->start + index) % self->maxlen];
+    uint16_t value;
+    if (capture_enabled(self)) {
+        value = capture_get(self, index);
+    } else {
+        value = self->buffer[(self->start + index) % self->maxlen];
+    }
     common_hal_mcu_enable_interrupts();
     return value;
 }
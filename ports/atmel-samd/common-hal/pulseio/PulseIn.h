@@ -44,10 +44,20 @@ typedef struct {
     volatile uint64_t last_ms;
     volatile uint16_t last_us;
     volatile bool errored_too_fast;
+    // Hardware capture state. tc_index is 0xff when edges are timed by interrupt instead.
+    uint8_t tc_index;
+    uint8_t event_channel;
+    uint8_t dma_channel;
+    volatile bool skip_edge;
+    volatile uint16_t captured;
+    volatile uint16_t overflows;
+    volatile uint32_t last_capture;
 } pulseio_pulsein_obj_t;
 
 void pulsein_reset(void);
+void pulsein_background(void);
 
 void pulsein_interrupt_handler(uint8_t channel);
+void pulsein_timer_interrupt_handler(uint8_t index);
 
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_PULSEIO_PULSEIN_H
@@ -31,9 +31,11 @@
 #include "hal/include/hal_gpio.h"
 
 #include "mpconfigport.h"
+#include "samd/dma.h"
 #include "samd/pins.h"
 #include "samd/timers.h"
 #include "py/gc.h"
+#include "py/misc.h"
 #include "py/runtime.h"
 #include "shared-bindings/pulseio/PulseOut.h"
 #include "supervisor/shared/translate.h"
@@ -51,6 +53,25 @@ static volatile uint16_t pulse_index = 0;
 static uint16_t pulse_length;
 static volatile uint32_t current_compare = 0;
 
+// When two DMA channels are free the pulses are streamed instead of sent from the interrupt. The
+// timer runs in match frequency mode so each period is one pulse, and on every overflow one
+// channel loads the next period into CC0 while the other writes the pin config that gates the
+// carrier. Both buffers live in MP_STATE_PORT(pulseout_dma_buffer) so they survive a looping send.
+#ifdef SAMD21
+#define FIRST_TC_OVF_TRIGGER TC3_DMAC_ID_OVF
+#endif
+#ifdef SAMD51
+#define FIRST_TC_OVF_TRIGGER TC0_DMAC_ID_OVF
+#endif
+// Each TC has three DMA triggers: OVF, MC0 and MC1.
+#define TC_DMA_TRIGGER_STRIDE 3
+// A period must be long enough for the DMA to load the next one before the counter passes it.
+#define MIN_PERIOD_TICKS 2
+
+static uint8_t period_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+static uint8_t pincfg_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+static size_t dma_buffer_length;
+
 static void turn_on(__IO PORT_PINCFG_Type * pincfg) {
     pincfg->reg = PORT_PINCFG_PMUXEN;
 }
@@ -89,12 +110,138 @@ void pulseout_interrupt_handler(uint8_t index) {
     tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
 }
 
+static void stop_dma_channel(uint8_t channel) {
+    dma_disable_channel(channel);
+    dma_descriptor(channel)->BTCTRL.bit.VALID = false;
+}
+
 void pulseout_reset() {
+    if (period_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        stop_dma_channel(period_dma_channel);
+        stop_dma_channel(pincfg_dma_channel);
+        period_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+        pincfg_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    }
+    MP_STATE_PORT(pulseout_dma_buffer) = NULL;
     refcount = 0;
     pulseout_tc_index = 0xff;
     active_pincfg = NULL;
 }
 
+// Reset the shared timer and set it up for either interrupt driven or streamed pulses. It is left
+// stopped.
+static void configure_timer(Tc* tc, bool streaming) {
+    tc_set_enable(tc, false);
+    tc_reset(tc);
+    #ifdef SAMD21
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
+                            TC_CTRLA_PRESCALER_DIV64 |
+                            (streaming ? TC_CTRLA_WAVEGEN_MFRQ : TC_CTRLA_WAVEGEN_NFRQ);
+    #endif
+    #ifdef SAMD51
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV64;
+    tc->COUNT16.WAVE.reg = streaming ? TC_WAVE_WAVEGEN_MFRQ : TC_WAVE_WAVEGEN_NFRQ;
+    #endif
+}
+
+static void configure_dma_channel(uint8_t channel, uint32_t beatsize, const void* source,
+                                  size_t length, volatile void* destination, bool loop) {
+    DmacDescriptor* descriptor = dma_descriptor(channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | beatsize | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = length;
+    // The source address is the end of the block when incrementing.
+    uint32_t beat_bytes = beatsize == DMAC_BTCTRL_BEATSIZE_HWORD ? 2 : 1;
+    descriptor->SRCADDR.reg = ((uint32_t) source) + length * beat_bytes;
+    descriptor->DSTADDR.reg = (uint32_t) destination;
+    descriptor->DESCADDR.reg = loop ? (uint32_t) descriptor : 0;
+    dma_configure(channel, FIRST_TC_OVF_TRIGGER + TC_DMA_TRIGGER_STRIDE * pulseout_tc_index,
+                  false);
+}
+
+static uint16_t period_ticks(uint16_t duration) {
+    uint32_t ticks = duration * 3 / 4;
+    if (ticks < MIN_PERIOD_TICKS) {
+        ticks = MIN_PERIOD_TICKS;
+    }
+    return ticks - 1;
+}
+
+// Stop a streamed send, returning the timer to interrupt driven mode.
+static void stop_streaming(void) {
+    Tc* tc = tc_insts[pulseout_tc_index];
+    stop_dma_channel(period_dma_channel);
+    stop_dma_channel(pincfg_dma_channel);
+    period_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    pincfg_dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    turn_off(active_pincfg);
+    configure_timer(tc, false);
+    tc_set_enable(tc, true);
+    tc->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_STOP;
+    m_del(uint8_t, MP_STATE_PORT(pulseout_dma_buffer), dma_buffer_length);
+    MP_STATE_PORT(pulseout_dma_buffer) = NULL;
+    active_pincfg = NULL;
+}
+
+// Start streaming the pulses by DMA. Returns false, having done nothing, if the DMA channels or
+// buffer aren't available.
+static bool start_streaming(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length,
+                            bool loop) {
+    // Borrow from the last channels like SPI because audio allocates from the first.
+    uint8_t channels[2];
+    uint8_t found = 0;
+    for (uint8_t i = AUDIO_DMA_CHANNEL_COUNT; i > 0 && found < 2; i--) {
+        if (!dma_channel_enabled(i - 1)) {
+            channels[found++] = i - 1;
+        }
+    }
+    if (found < 2) {
+        return false;
+    }
+    // Periods first so they stay halfword aligned, then the pin configs.
+    size_t buffer_length = length * (sizeof(uint16_t) + sizeof(uint8_t));
+    uint8_t* buffer = m_new_maybe(uint8_t, buffer_length);
+    if (buffer == NULL) {
+        return false;
+    }
+    uint16_t* periods = (uint16_t*) buffer;
+    uint8_t* pincfgs = buffer + length * sizeof(uint16_t);
+    // Entry i is loaded when pulse i ends. Even pulses are on, and once a single send is done the
+    // pin stays off while the timer runs out a final long period.
+    for (uint16_t i = 0; i < length; i++) {
+        uint16_t next = i + 1;
+        if (next == length && !loop) {
+            periods[i] = 0xffff;
+            pincfgs[i] = PORT_PINCFG_RESETVALUE;
+            continue;
+        }
+        next %= length;
+        periods[i] = period_ticks(pulses[next]);
+        pincfgs[i] = next % 2 == 0 ? PORT_PINCFG_PMUXEN : PORT_PINCFG_RESETVALUE;
+    }
+
+    MP_STATE_PORT(pulseout_dma_buffer) = buffer;
+    dma_buffer_length = buffer_length;
+    period_dma_channel = channels[0];
+    pincfg_dma_channel = channels[1];
+    active_pincfg = self->pincfg;
+
+    // Resetting the timer also drops any DMA request left over from earlier use.
+    Tc* tc = tc_insts[pulseout_tc_index];
+    configure_timer(tc, true);
+    tc->COUNT16.CC[0].reg = period_ticks(pulses[0]);
+    configure_dma_channel(period_dma_channel, DMAC_BTCTRL_BEATSIZE_HWORD, periods, length,
+                          &tc->COUNT16.CC[0].reg, loop);
+    configure_dma_channel(pincfg_dma_channel, DMAC_BTCTRL_BEATSIZE_BYTE, pincfgs, length,
+                          &self->pincfg->reg, loop);
+    dma_enable_channel(period_dma_channel);
+    dma_enable_channel(pincfg_dma_channel);
+
+    // Enabling the timer starts it counting from zero.
+    turn_on(active_pincfg);
+    tc_set_enable(tc, true);
+    return true;
+}
+
 void common_hal_pulseio_pulseout_construct(pulseio_pulseout_obj_t* self,
                                             const pulseio_pwmout_obj_t* carrier) {
     if (refcount == 0) {
@@ -124,17 +271,7 @@ void common_hal_pulseio_pulseout_construct(pulseio_pulseout_obj_t* self,
         #endif
 
 
-        #ifdef SAMD21
-        tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
-                                TC_CTRLA_PRESCALER_DIV64 |
-                                TC_CTRLA_WAVEGEN_NFRQ;
-        #endif
-        #ifdef SAMD51
-        tc_reset(tc);
-        tc_set_enable(tc, false);
-        tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV64;
-        tc->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_NFRQ;
-        #endif
+        configure_timer(tc, false);
 
         tc_set_enable(tc, true);
         tc->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_STOP;
@@ -162,6 +299,8 @@ void common_hal_pulseio_pulseout_deinit(pulseio_pulseout_obj_t* self) {
     if (common_hal_pulseio_pulseout_deinited(self)) {
         return;
     }
+    common_hal_pulseio_pulseout_stop(self);
+
     PortGroup *const port_base = &PORT->Group[GPIO_PORT(self->pin)];
     port_base->DIRCLR.reg = 1 << (self->pin % 32);
 
@@ -175,10 +314,42 @@ void common_hal_pulseio_pulseout_deinit(pulseio_pulseout_obj_t* self) {
     self->pin = NO_PIN;
 }
 
-void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length) {
+void common_hal_pulseio_pulseout_stop(pulseio_pulseout_obj_t* self) {
+    if (active_pincfg == self->pincfg && period_dma_channel < AUDIO_DMA_CHANNEL_COUNT) {
+        stop_streaming();
+    }
+}
+
+void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length, bool loop) {
+    // A new send replaces our own looping one.
+    common_hal_pulseio_pulseout_stop(self);
     if (active_pincfg != NULL) {
         mp_raise_RuntimeError(translate("Another send is already active"));
     }
+    if (loop && length % 2 != 0) {
+        mp_raise_ValueError(translate("loop needs an even number of pulses"));
+    }
+    if (length == 0) {
+        return;
+    }
+
+    if (start_streaming(self, pulses, length, loop)) {
+        if (loop) {
+            return;
+        }
+        while (dma_channel_enabled(pincfg_dma_channel)) {
+            // Do other things while we wait. The DMA sends the signal.
+            #ifdef MICROPY_VM_HOOK_LOOP
+                MICROPY_VM_HOOK_LOOP
+            #endif
+        }
+        stop_streaming();
+        return;
+    }
+    if (loop) {
+        mp_raise_RuntimeError(translate("All DMA channels in use"));
+    }
+
     active_pincfg = self->pincfg;
     pulse_buffer = pulses;
     pulse_index = 0;
@@ -29,18 +29,119 @@
 #include "atmel_start_pins.h"
 
 #include "eic_handler.h"
+#include "samd/clocks.h"
 #include "samd/external_interrupts.h"
+#include "py/mphal.h"
 #include "py/runtime.h"
 #include "supervisor/shared/translate.h"
 
+#ifdef SAMD51
+// The PDEC decodes one encoder in hardware, counting each edge without interrupting the CPU.
+// Its QDI0 and QDI1 inputs are on peripheral function G of these pin pairs. (PA24 and PA25 also
+// have them but are used for USB.)
+static const uint8_t pdec_pins[][2] = {
+    {PIN_PB22, PIN_PB23},
+    #if defined(PIN_PB18) && defined(PIN_PB19)
+    {PIN_PB18, PIN_PB19},
+    #endif
+};
+
+// Adds quarter steps to the position, rounding towards zero like the interrupt handler.
+static void add_quarters(rotaryio_incrementalencoder_obj_t* self, mp_int_t quarters) {
+    quarters += self->quarter_count;
+    self->position += quarters / 4;
+    self->quarter_count = quarters % 4;
+}
+
+static rotaryio_incrementalencoder_obj_t* pdec_encoder = NULL;
+
+// Returns whether the PDEC is free and can read the pins, and whether they're the wrong way
+// round so that the PDEC has to swap its inputs.
+static bool pdec_can_decode(const mcu_pin_obj_t* pin_a, const mcu_pin_obj_t* pin_b, bool* swap) {
+    if (pdec_encoder != NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < MP_ARRAY_SIZE(pdec_pins); i++) {
+        if (pin_a->number == pdec_pins[i][0] && pin_b->number == pdec_pins[i][1]) {
+            *swap = false;
+            return true;
+        }
+        if (pin_a->number == pdec_pins[i][1] && pin_b->number == pdec_pins[i][0]) {
+            *swap = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void pdec_construct(rotaryio_incrementalencoder_obj_t* self, bool swap) {
+    gpio_set_pin_function(self->pin_a, GPIO_PIN_FUNCTION_G);
+    gpio_set_pin_pull_mode(self->pin_a, GPIO_PULL_UP);
+    gpio_set_pin_function(self->pin_b, GPIO_PIN_FUNCTION_G);
+    gpio_set_pin_pull_mode(self->pin_b, GPIO_PULL_UP);
+
+    MCLK->APBCMASK.bit.PDEC_ = true;
+    // GCLK1 runs at 48mhz.
+    connect_gclk_to_peripheral(1, PDEC_GCLK_ID);
+
+    PDEC->CTRLA.bit.SWRST = 1;
+    while (PDEC->SYNCBUSY.bit.SWRST == 1) {}
+
+    // Count every edge of both inputs. The longest angular count makes COUNT a plain 16 bit
+    // counter, which we widen by reading it often enough that it can't wrap in between.
+    PDEC->CTRLA.reg = PDEC_CTRLA_MODE_QDEC | PDEC_CTRLA_CONF_X4 | PDEC_CTRLA_ANGULAR(7) |
+        PDEC_CTRLA_PINEN0 | PDEC_CTRLA_PINEN1 | (swap ? PDEC_CTRLA_SWAP : 0);
+    PDEC->CTRLA.bit.ENABLE = 1;
+    while (PDEC->SYNCBUSY.bit.ENABLE == 1) {}
+    PDEC->CTRLBSET.reg = PDEC_CTRLBSET_CMD_START;
+    while (PDEC->SYNCBUSY.bit.CTRLB == 1) {}
+
+    self->pdec = true;
+    self->pdec_count = 0;
+    pdec_encoder = self;
+}
+
+static void pdec_update(rotaryio_incrementalencoder_obj_t* self) {
+    PDEC->CTRLBSET.reg = PDEC_CTRLBSET_CMD_READSYNC;
+    while (PDEC->SYNCBUSY.bit.CTRLB == 1) {}
+    while (PDEC->SYNCBUSY.bit.COUNT == 1) {}
+    uint16_t count = PDEC->COUNT.reg;
+    add_quarters(self, (int16_t) (count - self->pdec_count));
+    self->pdec_count = count;
+}
+
+static void pdec_deinit(void) {
+    PDEC->CTRLA.bit.ENABLE = 0;
+    while (PDEC->SYNCBUSY.bit.ENABLE == 1) {}
+    MCLK->APBCMASK.bit.PDEC_ = false;
+    pdec_encoder = NULL;
+}
+#endif
+
 void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencoder_obj_t* self,
     const mcu_pin_obj_t* pin_a, const mcu_pin_obj_t* pin_b) {
-    if (!pin_a->has_extint || !pin_a->has_extint) {
-        mp_raise_RuntimeError(translate("Both pins must support hardware interrupts"));
+    self->pin_a = pin_a->number;
+    self->pin_b = pin_b->number;
+    self->position = 0;
+    self->quarter_count = 0;
+    self->velocity_position = 0;
+    self->velocity_ms = mp_hal_ticks_ms();
+    self->velocity = 0;
+
+    #ifdef SAMD51
+    bool swap;
+    self->pdec = pdec_can_decode(pin_a, pin_b, &swap);
+    if (self->pdec) {
+        pdec_construct(self, swap);
+        claim_pin(pin_a);
+        claim_pin(pin_b);
+        return;
     }
+    #endif
 
-    // TODO: The SAMD51 has a peripheral dedicated to quadrature encoder debugging. Use it instead
-    // of the external interrupt.
+    if (!pin_a->has_extint || !pin_b->has_extint) {
+        mp_raise_RuntimeError(translate("Both pins must support hardware interrupts"));
+    }
 
     if (eic_get_enable()) {
         if (!eic_channel_free(pin_a->extint_channel) || !eic_channel_free(pin_b->extint_channel)) {
@@ -53,8 +154,6 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
     // These default settings apply when the EIC isn't yet enabled.
     self->eic_channel_a = pin_a->extint_channel;
     self->eic_channel_b = pin_b->extint_channel;
-    self->pin_a = pin_a->number;
-    self->pin_b = pin_b->number;
 
     gpio_set_pin_function(self->pin_a, GPIO_PIN_FUNCTION_A);
     gpio_set_pin_pull_mode(self->pin_a, GPIO_PULL_UP);
@@ -65,9 +164,6 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
     set_eic_channel_data(self->eic_channel_a, (void*) self);
     set_eic_channel_data(self->eic_channel_b, (void*) self);
 
-    self->position = 0;
-    self->quarter_count = 0;
-
     // Top two bits of self->last_state don't matter, because they'll be gone as soon as
     // interrupt handler is called.
     self->last_state =
@@ -93,11 +189,18 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
         return;
     }
 
-    set_eic_handler(self->eic_channel_a, EIC_HANDLER_NO_INTERRUPT);
-    turn_off_eic_channel(self->eic_channel_a);
+    #ifdef SAMD51
+    if (self->pdec) {
+        pdec_deinit();
+    } else
+    #endif
+    {
+        set_eic_handler(self->eic_channel_a, EIC_HANDLER_NO_INTERRUPT);
+        turn_off_eic_channel(self->eic_channel_a);
 
-    set_eic_handler(self->eic_channel_b, EIC_HANDLER_NO_INTERRUPT);
-    turn_off_eic_channel(self->eic_channel_b);
+        set_eic_handler(self->eic_channel_b, EIC_HANDLER_NO_INTERRUPT);
+        turn_off_eic_channel(self->eic_channel_b);
+    }
 
     reset_pin_number(self->pin_a);
     self->pin_a = NO_PIN;
@@ -107,14 +210,52 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
 }
 
 mp_int_t common_hal_rotaryio_incrementalencoder_get_position(rotaryio_incrementalencoder_obj_t* self) {
+    #ifdef SAMD51
+    if (self->pdec) {
+        pdec_update(self);
+    }
+    #endif
     return self->position;
 }
 
 void common_hal_rotaryio_incrementalencoder_set_position(rotaryio_incrementalencoder_obj_t* self,
         mp_int_t new_position) {
+    mp_int_t position = common_hal_rotaryio_incrementalencoder_get_position(self);
+    // Move the velocity's starting point along too so setting the position isn't movement.
+    self->velocity_position += new_position - position;
     self->position = new_position;
 }
 
+mp_float_t common_hal_rotaryio_incrementalencoder_get_velocity(rotaryio_incrementalencoder_obj_t* self) {
+    mp_int_t position = common_hal_rotaryio_incrementalencoder_get_position(self);
+    mp_uint_t now = mp_hal_ticks_ms();
+    mp_uint_t elapsed = now - self->velocity_ms;
+    // Keep the last result until some time has passed.
+    if (elapsed > 0) {
+        self->velocity = (position - self->velocity_position) * MICROPY_FLOAT_CONST(1000.0) / elapsed;
+        self->velocity_position = position;
+        self->velocity_ms = now;
+    }
+    return self->velocity;
+}
+
+void incrementalencoder_background(void) {
+    #ifdef SAMD51
+    // At full speed the 16 bit PDEC count wraps far less often than once a millisecond.
+    if (pdec_encoder != NULL) {
+        pdec_update(pdec_encoder);
+    }
+    #endif
+}
+
+void incrementalencoder_reset(void) {
+    #ifdef SAMD51
+    if (pdec_encoder != NULL) {
+        pdec_deinit();
+    }
+    #endif
+}
+
 void incrementalencoder_interrupt_handler(uint8_t channel) {
     rotaryio_incrementalencoder_obj_t* self = get_eic_channel_data(channel);
 
@@ -39,10 +39,20 @@ typedef struct {
     uint8_t eic_channel_b:4;
     uint8_t last_state:4;   // <old A><old B><new A><new B>
     int8_t quarter_count:4; // count intermediate transitions between detents
+    #ifdef SAMD51
+    bool pdec;              // counted by the PDEC peripheral instead of EIC interrupts
+    uint16_t pdec_count;    // PDEC count already added to quarter_count and position
+    #endif
     mp_int_t position;
+    // position and time when velocity was last read
+    mp_int_t velocity_position;
+    mp_uint_t velocity_ms;
+    mp_float_t velocity;
 } rotaryio_incrementalencoder_obj_t;
 
 
 void incrementalencoder_interrupt_handler(uint8_t channel);
+void incrementalencoder_background(void);
+void incrementalencoder_reset(void);
 
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_ROTARYIO_INCREMENTALENCODER_H
@@ -27,6 +27,7 @@
 #include <stdbool.h>
 #include "shared-bindings/supervisor/Runtime.h"
 #include "supervisor/serial.h"
+#include "supervisor/usb.h"
 
 bool common_hal_get_serial_connected(void) {
     return (bool) serial_connected();
@@ -35,3 +36,7 @@ bool common_hal_get_serial_connected(void) {
 bool common_hal_get_serial_bytes_available(void) {
     return (bool) serial_bytes_available();
 }
+
+void common_hal_get_usb_msc_throughput(uint32_t* read_rate, uint32_t* write_rate) {
+    usb_msc_throughput(read_rate, write_rate);
+}
@@ -25,6 +25,7 @@
  */
 
 #include "py/mphal.h"
+#include "py/runtime.h"
 
 #include "shared-bindings/time/__init__.h"
 
@@ -34,6 +35,23 @@ inline uint64_t common_hal_time_monotonic() {
     return ticks_ms;
 }
 
+uint64_t common_hal_time_monotonic_ns(void) {
+    uint64_t ms;
+    uint32_t us_until_ms;
+    current_tick(&ms, &us_until_ms);
+    // us_until_ms counts down from 1000 to the next tick.
+    return 1000000ull * ms + 1000ull * (1000 - us_until_ms);
+}
+
 void common_hal_time_delay_ms(uint32_t delay) {
+    #if MICROPY_ENABLE_SCHEDULER
+    // Run queued interrupt handlers as they arrive rather than after the whole sleep.
+    uint64_t end = ticks_ms + delay;
+    while (ticks_ms < end) {
+        mp_hal_delay_ms(1);
+        mp_handle_pending();
+    }
+    #else
     mp_hal_delay_ms(delay);
+    #endif
 }
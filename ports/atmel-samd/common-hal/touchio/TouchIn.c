@@ -46,7 +46,54 @@
 
 bool touch_enabled = false;
 
+// Each conversion moves the filtered reading a quarter of the way to it.
+#define FILTER_SHIFT (2)
+// While the pad isn't touched, the baseline moves 1/256 of the way to the filtered reading.
+#define BASELINE_SHIFT (8)
+
+// Values of converting_channel besides the Y line of a channel being scanned.
+#define NO_CONVERSION (0xff)
+#define BLOCKING_CONVERSION (0xfe)
+
+// The background task converts each channel in turn, starting the next as soon as it finds the
+// last one finished, so reading a TouchIn never waits for the PTC.
+static uint8_t converting_channel = NO_CONVERSION;
+static uint8_t last_channel = 0;
+
+static touchio_touchin_obj_t* get_channel(uint8_t yline) {
+    return MP_OBJ_TO_PTR(MP_STATE_PORT(touchin_channels)[yline]);
+}
+
+static bool touched(touchio_touchin_obj_t *self) {
+    return (int32_t) (self->filtered >> TOUCHIN_FILTER_FRACTION_BITS) >
+        (int32_t) (self->baseline >> TOUCHIN_FILTER_FRACTION_BITS) + self->threshold_offset;
+}
+
+static void add_reading(touchio_touchin_obj_t *self, uint16_t reading) {
+    int32_t scaled = reading << TOUCHIN_FILTER_FRACTION_BITS;
+    self->filtered += (scaled - (int32_t) self->filtered) >> FILTER_SHIFT;
+    if (self->filtered < self->baseline) {
+        // Readings only drop below the baseline once it's too high so catch up right away.
+        self->baseline = self->filtered;
+    } else if (!touched(self)) {
+        self->baseline += (self->filtered - self->baseline) >> BASELINE_SHIFT;
+    }
+}
+
+// Waits for a background conversion to finish, and records it, so the PTC can be used.
+static void finish_conversion(void) {
+    if (converting_channel >= TOUCHIN_CHANNEL_COUNT) {
+        return;
+    }
+    while (!adafruit_ptc_is_conversion_finished(PTC)) {}
+    add_reading(get_channel(converting_channel), adafruit_ptc_get_conversion_result(PTC));
+    converting_channel = NO_CONVERSION;
+}
+
 static uint16_t get_raw_reading(touchio_touchin_obj_t *self) {
+    finish_conversion();
+    // Keep the background task, which may run below, off the PTC.
+    converting_channel = BLOCKING_CONVERSION;
     adafruit_ptc_start_conversion(PTC, &self->config);
 
     while (!adafruit_ptc_is_conversion_finished(PTC)) {
@@ -56,9 +103,32 @@ static uint16_t get_raw_reading(touchio_touchin_obj_t *self) {
         #endif
     }
 
+    converting_channel = NO_CONVERSION;
     return adafruit_ptc_get_conversion_result(PTC);
 }
 
+void touchin_background(void) {
+    if (converting_channel == BLOCKING_CONVERSION) {
+        return;
+    }
+    if (converting_channel != NO_CONVERSION) {
+        if (!adafruit_ptc_is_conversion_finished(PTC)) {
+            return;
+        }
+        finish_conversion();
+    }
+    for (uint8_t i = 1; i <= TOUCHIN_CHANNEL_COUNT; i++) {
+        uint8_t yline = (last_channel + i) % TOUCHIN_CHANNEL_COUNT;
+        touchio_touchin_obj_t *self = get_channel(yline);
+        if (self != NULL) {
+            adafruit_ptc_start_conversion(PTC, &self->config);
+            converting_channel = yline;
+            last_channel = yline;
+            return;
+        }
+    }
+}
+
 void common_hal_touchio_touchin_construct(touchio_touchin_obj_t* self,
         const mcu_pin_obj_t *pin) {
     if (!pin->has_touch) {
@@ -86,6 +156,7 @@ void common_hal_touchio_touchin_construct(touchio_touchin_obj_t* self,
     self->config.pin = pin->number;
     self->config.yline = pin->touch_y_line;
 
+    finish_conversion();
     adafruit_ptc_init(PTC, &self->config);
 
     // Initial values for pins will vary, depending on what peripherals the pins
@@ -95,7 +166,12 @@ void common_hal_touchio_touchin_construct(touchio_touchin_obj_t* self,
     // For simple finger touch, the values may vary as much as a factor of two,
     // but for touches using fruit or other objects, the difference is much less.
 
-    self->threshold = get_raw_reading(self) + 100;
+    self->filtered = get_raw_reading(self) << TOUCHIN_FILTER_FRACTION_BITS;
+    self->baseline = self->filtered;
+    self->threshold_offset = 100;
+
+    // Start scanning in the background. The Y line is unique to the pin.
+    MP_STATE_PORT(touchin_channels)[self->config.yline] = self;
     #endif
 }
 
@@ -110,11 +186,21 @@ void common_hal_touchio_touchin_deinit(touchio_touchin_obj_t* self) {
     }
     // We leave the clocks running because they may be in use by others.
 
+    if (converting_channel == self->config.yline) {
+        finish_conversion();
+    }
+    MP_STATE_PORT(touchin_channels)[self->config.yline] = NULL;
+
     reset_pin_number(self->config.pin);
     self->config.pin = NO_PIN;
 }
 
 void touchin_reset() {
+    converting_channel = NO_CONVERSION;
+    for (uint8_t i = 0; i < TOUCHIN_CHANNEL_COUNT; i++) {
+        MP_STATE_PORT(touchin_channels)[i] = NULL;
+    }
+
     Ptc* ptc = ((Ptc *) PTC);
     if (ptc->CTRLA.bit.ENABLE == 1) {
         ptc->CTRLA.bit.ENABLE = 0;
@@ -126,18 +212,25 @@ void touchin_reset() {
 }
 
 bool common_hal_touchio_touchin_get_value(touchio_touchin_obj_t *self) {
-    uint16_t reading = get_raw_reading(self);
-    return reading > self->threshold;
+    return touched(self);
 }
 
 uint16_t common_hal_touchio_touchin_get_raw_value(touchio_touchin_obj_t *self) {
-    return get_raw_reading(self);
+    return self->filtered >> TOUCHIN_FILTER_FRACTION_BITS;
 }
 
 uint16_t common_hal_touchio_touchin_get_threshold(touchio_touchin_obj_t *self) {
-    return self->threshold;
+    int32_t threshold = (int32_t) (self->baseline >> TOUCHIN_FILTER_FRACTION_BITS) + self->threshold_offset;
+    if (threshold < 0) {
+        return 0;
+    }
+    if (threshold > UINT16_MAX) {
+        return UINT16_MAX;
+    }
+    return threshold;
 }
 
 void common_hal_touchio_touchin_set_threshold(touchio_touchin_obj_t *self, uint16_t new_threshold) {
-    self->threshold = new_threshold;
+    // Kept relative to the baseline so the threshold follows drift in the untouched reading.
+    self->threshold_offset = new_threshold - (int32_t) (self->baseline >> TOUCHIN_FILTER_FRACTION_BITS);
 }
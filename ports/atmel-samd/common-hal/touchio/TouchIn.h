@@ -34,12 +34,23 @@
 
 #include "py/obj.h"
 
+// Fixed point fraction bits of the filtered readings.
+#define TOUCHIN_FILTER_FRACTION_BITS (8)
+
 typedef struct {
     mp_obj_base_t base;
     struct adafruit_ptc_config config;
-    uint16_t threshold;
+    // The background task keeps these up to date. Both are readings scaled up by
+    // 1 << TOUCHIN_FILTER_FRACTION_BITS: filtered follows each conversion quickly and
+    // baseline follows it slowly while the pad isn't touched.
+    uint32_t filtered;
+    uint32_t baseline;
+    // How far above the baseline a reading must be to count as a touch.
+    int32_t threshold_offset;
 } touchio_touchin_obj_t;
 
 void touchin_reset(void);
 
+void touchin_background(void);
+
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_COMMON_HAL_TOUCHIO_TOUCHIN_H
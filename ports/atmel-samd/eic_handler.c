@@ -24,6 +24,7 @@
  * THE SOFTWARE.
  */
 
+#include "common-hal/interruptio/PinInterrupt.h"
 #include "common-hal/pulseio/PulseIn.h"
 #include "common-hal/rotaryio/IncrementalEncoder.h"
 #include "shared-bindings/microcontroller/__init__.h"
@@ -52,6 +53,12 @@ void shared_eic_handler(uint8_t channel) {
         break;
 #endif
 
+#if CIRCUITPY_INTERRUPTIO
+    case EIC_HANDLER_PIN_INTERRUPT:
+        pininterrupt_interrupt_handler(channel);
+        break;
+#endif
+
     default:
         break;
     }
@@ -29,6 +29,7 @@
 #define EIC_HANDLER_NO_INTERRUPT 0x0
 #define EIC_HANDLER_PULSEIN 0x1
 #define EIC_HANDLER_INCREMENTAL_ENCODER 0x2
+#define EIC_HANDLER_PIN_INTERRUPT 0x3
 
 void set_eic_handler(uint8_t channel, uint8_t eic_handler);
 void shared_eic_handler(uint8_t channel);
@@ -42,6 +42,8 @@
 #define MICROPY_PY_IO                               (0)
 #define MICROPY_PY_UJSON                            (0)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS          (0)
+// compile imports a statement at a time, so larger modules fit in RAM
+#define MICROPY_COMP_STREAM_IMPORT                  (1)
 #define MICROPY_PY_UERRNO_LIST \
     X(EPERM) \
     X(ENOENT) \
@@ -62,13 +64,18 @@
 #define SPI_FLASH_MAX_BAUDRATE 24000000
 // 24kiB stack
 #define CIRCUITPY_DEFAULT_STACK_SIZE                0x6000
+#define CIRCUITPY_DEFAULT_PYSTACK_SIZE              4096
 #define MICROPY_PY_BUILTINS_NOTIMPLEMENTED          (1)
 #define MICROPY_PY_COLLECTIONS_ORDEREDDICT          (1)
 #define MICROPY_PY_FUNCTION_ATTRS                   (1)
 #define MICROPY_PY_IO                               (1)
 #define MICROPY_PY_UJSON                            (1)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS          (1)
+#define MICROPY_OPT_MAP_LOOKUP_SITE_CACHE           (1)
 //      MICROPY_PY_UERRNO_LIST - Use the default
+// Run the interpreter loop and other hot paths from RAM, which has no flash wait states. The
+// linker script copies .ramfunc in with .data and the linker adds veneers for calls from flash.
+#define MP_RAMFUNC __attribute__((section(".ramfunc"), noinline))
 #endif
 
 // Turning off audioio, audiobusio, and touchio as necessary
@@ -78,8 +85,58 @@
 
 #include "py/circuitpy_mpconfig.h"
 
+#if CIRCUITPY_INTERRUPTIO
+// The scheduler queue is filled from interrupt handlers so guard it by masking them. Saving
+// PRIMASK keeps this safe inside common_hal_mcu_disable_interrupts() sections too.
+static inline uint32_t samd_begin_atomic_section(void) {
+    uint32_t state = __get_PRIMASK();
+    __disable_irq();
+    return state;
+}
+#define MICROPY_BEGIN_ATOMIC_SECTION() samd_begin_atomic_section()
+#define MICROPY_END_ATOMIC_SECTION(state) __set_PRIMASK(state)
+// Keeps PinInterrupt objects alive while their EIC channel can still fire.
+#define PIN_INTERRUPT_ROOT_POINTERS mp_obj_t pin_interrupts[EIC_EXTINT_NUM];
+#else
+#define PIN_INTERRUPT_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_TOUCHIO
+// One for each PTC Y line.
+#define TOUCHIN_CHANNEL_COUNT (16)
+// Keeps TouchIn objects alive while the background task scans them.
+#define TOUCHIN_ROOT_POINTERS mp_obj_t touchin_channels[TOUCHIN_CHANNEL_COUNT];
+#else
+#define TOUCHIN_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_I2CSLAVE
+// Keeps I2CSlave objects alive while their SERCOM serves register mode.
+#define I2CSLAVE_ROOT_POINTERS mp_obj_t i2cslave_register_slaves[SERCOM_INST_NUM];
+#else
+#define I2CSLAVE_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_ANALOGIO
+// One for each DAC output.
+#ifdef SAMD51
+#define ANALOGOUT_STREAM_COUNT (2)
+#else
+#define ANALOGOUT_STREAM_COUNT (1)
+#endif
+// Keeps AnalogOut objects and the buffers they play alive while the DMA streams them.
+#define ANALOGOUT_ROOT_POINTERS mp_obj_t analogout_streams[ANALOGOUT_STREAM_COUNT];
+#else
+#define ANALOGOUT_ROOT_POINTERS
+#endif
+
 #define MICROPY_PORT_ROOT_POINTERS \
     CIRCUITPY_COMMON_ROOT_POINTERS \
-    mp_obj_t playing_audio[AUDIO_DMA_CHANNEL_COUNT];
+    mp_obj_t playing_audio[AUDIO_DMA_CHANNEL_COUNT]; \
+    uint8_t* pulseout_dma_buffer; \
+    PIN_INTERRUPT_ROOT_POINTERS \
+    TOUCHIN_ROOT_POINTERS \
+    I2CSLAVE_ROOT_POINTERS \
+    ANALOGOUT_ROOT_POINTERS
 
 #endif  // __INCLUDED_MPCONFIGPORT_H
@@ -18,13 +18,34 @@ endif
 ifeq ($(CHIP_FAMILY),samd21)
 # frequencyio not yet verified as working on SAMD21.
 CIRCUITPY_FRQUENCYIO = 0
+ifndef CIRCUITPY_SELECT
+CIRCUITPY_SELECT = 0
+endif
+USB_CDC_RX_BUFSIZE ?= 128
+USB_CDC_TX_BUFSIZE ?= 128
 endif
 
 # Put samd51-only choices here.
 ifeq ($(CHIP_FAMILY),samd51)
 CIRCUITPY_SAMD = 1
+INTERNAL_LIBM_VFP = 1
+ifndef CIRCUITPY_ENABLE_MPY_NATIVE
+CIRCUITPY_ENABLE_MPY_NATIVE = 1
+endif
+ifndef CIRCUITPY_INTERRUPTIO
+CIRCUITPY_INTERRUPTIO = 1
+endif
+ifndef CIRCUITPY_BTREE
+CIRCUITPY_BTREE = 1
+endif
+USB_CDC_RX_BUFSIZE ?= 256
+# Big enough to keep printing while the host is between polls.
+USB_CDC_TX_BUFSIZE ?= 1024
 endif
 
 INTERNAL_LIBM = 1
 
 USB_SERIAL_NUMBER_LENGTH = 32
+
+# USB_CDC_RX_BUFSIZE and USB_CDC_TX_BUFSIZE size the USB serial FIFOs. Boards may override the
+# per chip defaults above.
@@ -30,10 +30,12 @@
 #include "lib/utils/interrupt_char.h"
 #include "py/mphal.h"
 #include "py/mpstate.h"
+#include "py/mpthread.h"
 #include "py/runtime.h"
 #include "py/smallint.h"
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/time/__init__.h"
+#include "supervisor/port.h"
 #include "supervisor/shared/autoreload.h"
 
 #include "hal/include/hal_atomic.h"
@@ -62,7 +64,15 @@ void mp_hal_delay_ms(mp_uint_t delay) {
             break;
         }
         duration = (ticks_ms - start_tick);
-        // TODO(tannewt): Go to sleep for a little while while we wait.
+        if (duration < delay) {
+            #if MICROPY_PY_THREAD
+            // Other threads get the time this one would have slept.
+            if (mp_thread_yield()) {
+                continue;
+            }
+            #endif
+            port_sleep_until_interrupt();
+        }
     }
 }
 
@@ -70,13 +80,13 @@ void mp_hal_delay_ms(mp_uint_t delay) {
 // Do a simple timing loop to wait for a certain number of microseconds.
 // Can be used when interrupts are disabled, which makes tick_delay() unreliable.
 //
-// Testing done at 48 MHz on SAMD21 and 120 MHz on SAMD51, multiplication and division cancel out.
-// But get the frequency just in case.
+// Testing done at 48 MHz on SAMD21 and 120 MHz on SAMD51. The CPU may run slower than that
+// for power saving, so scale by the current frequency.
 #ifdef SAMD21
-#define DELAY_LOOP_ITERATIONS_PER_US ( (10U*48000000U) / common_hal_mcu_processor_get_frequency())
+#define DELAY_LOOP_ITERATIONS_PER_US (common_hal_mcu_processor_get_frequency() / (48000000U / 10U))
 #endif
 #ifdef SAMD51
-#define DELAY_LOOP_ITERATIONS_PER_US ( (30U*120000000U) / common_hal_mcu_processor_get_frequency())
+#define DELAY_LOOP_ITERATIONS_PER_US (common_hal_mcu_processor_get_frequency() / (120000000U / 30U))
 #endif
 
 void mp_hal_delay_us(mp_uint_t delay) {
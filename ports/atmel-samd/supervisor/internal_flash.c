@@ -79,6 +79,13 @@ void supervisor_flash_flush(void) {
 void supervisor_flash_release_cache(void) {
 }
 
+void supervisor_flash_start_flush(void) {
+    supervisor_flash_flush();
+}
+
+void supervisor_flash_background(void) {
+}
+
 void flash_flush(void) {
     supervisor_flash_flush();
 }
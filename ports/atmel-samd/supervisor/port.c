@@ -48,10 +48,15 @@
 #include "common-hal/audiobusio/I2SOut.h"
 #include "common-hal/audioio/AudioOut.h"
 #include "common-hal/busio/SPI.h"
+#include "common-hal/busio/UART.h"
+#include "common-hal/frequencyio/FrequencyIn.h"
+#include "common-hal/i2cslave/I2CSlave.h"
 #include "common-hal/microcontroller/Pin.h"
+#include "common-hal/nvm/ByteArray.h"
 #include "common-hal/pulseio/PulseIn.h"
 #include "common-hal/pulseio/PulseOut.h"
 #include "common-hal/pulseio/PWMOut.h"
+#include "common-hal/rotaryio/IncrementalEncoder.h"
 #include "common-hal/rtc/RTC.h"
 #include "common-hal/touchio/TouchIn.h"
 #include "samd/cache.h"
@@ -74,6 +79,16 @@
 #if CIRCUITPY_GAMEPADSHIFT
 #include "shared-module/gamepadshift/__init__.h"
 #endif
+#if CIRCUITPY_INTERRUPTIO
+#include "common-hal/interruptio/PinInterrupt.h"
+#include "shared-module/interruptio/__init__.h"
+#endif
+#if CIRCUITPY_KEYPAD
+#include "shared-module/keypad/__init__.h"
+#endif
+#if CIRCUITPY_PROFILER
+#include "shared-module/profiler/__init__.h"
+#endif
 #include "shared-module/_pew/PewPew.h"
 
 extern volatile bool mp_msc_enabled;
@@ -199,10 +214,21 @@ safe_mode_t port_init(void) {
 }
 
 void reset_port(void) {
+#if CIRCUITPY_I2CSLAVE
+    i2cslave_reset();
+#endif
     reset_sercoms();
+#if CIRCUITPY_NVM
+    nvm_bytearray_flush();
+#endif
+#if CIRCUITPY_BUSIO
+    uart_reset();
+#endif
 
-#if CIRCUITPY_AUDIOIO
+#if CIRCUITPY_AUDIOIO || CIRCUITPY_AUDIOBUSIO
     audio_dma_reset();
+#endif
+#if CIRCUITPY_AUDIOIO
     audioout_reset();
 #endif
 #if CIRCUITPY_AUDIOBUSIO
@@ -212,9 +238,16 @@ void reset_port(void) {
 
 #if CIRCUITPY_TOUCHIO
     touchin_reset();
+#endif
+#if CIRCUITPY_ROTARYIO
+    incrementalencoder_reset();
+#endif
+#if CIRCUITPY_FREQUENCYIO
+    frequencyin_reset();
 #endif
     eic_reset();
 #if CIRCUITPY_PULSEIO
+    pulsein_reset();
     pulseout_reset();
     pwmout_reset();
 #endif
@@ -238,6 +271,16 @@ void reset_port(void) {
 #if CIRCUITPY_PEW
     pew_reset();
 #endif
+#if CIRCUITPY_INTERRUPTIO
+    interruptio_reset();
+    pininterrupt_reset();
+#endif
+#if CIRCUITPY_KEYPAD
+    keypad_reset();
+#endif
+#if CIRCUITPY_PROFILER
+    profiler_reset();
+#endif
 
     reset_event_system();
 
@@ -266,6 +309,28 @@ void reset_cpu(void) {
     reset();
 }
 
+void port_sleep_until_interrupt(void) {
+    // Idle sleep only stops the CPU clock so the tick, DMA and USB keep running and wake us.
+    __WFI();
+}
+
+void port_set_performance(mcu_performance_t level) {
+    // Only the CPU and bus clocks are divided. Peripherals run from their own generic clocks,
+    // which keep their frequencies. USB needs its bus clock above 8 MHz.
+    uint8_t divider = 1;
+    if (level == PERFORMANCE_NORMAL) {
+        divider = 2;
+    } else if (level == PERFORMANCE_LOW) {
+        #ifdef SAMD21
+        divider = 4;
+        #endif
+        #ifdef SAMD51
+        divider = 8;
+        #endif
+    }
+    tick_set_cpu_divider(divider);
+}
+
 // Place the word to save 8k from the end of RAM so we and the bootloader don't clobber it.
 #ifdef SAMD21
 uint32_t* safe_word = (uint32_t*) (HMCRAMC0_ADDR + HMCRAMC0_SIZE - 0x2000);
@@ -39,7 +39,58 @@
 #include "atmel_start_pins.h"
 #include "hal_gpio.h"
 
+// True while the QSPI is left set up to read flash through the QSPI_AHB window
+// so that reads don't need to send an instruction frame each time.
+static bool memory_mapped = false;
+
+// Set up a read memory transfer that lasts until the next command so that
+// flash can be read from QSPI_AHB like memory. The peripheral sends a new read
+// instruction whenever the AHB address isn't the next one.
+static void start_memory_mapped(void) {
+    if (memory_mapped) {
+        return;
+    }
+    // Clear anything cached from before the flash was last changed.
+    samd_peripherals_disable_and_clear_cache();
+
+    #ifdef EXTERNAL_FLASH_QSPI_DUAL
+    QSPI->INSTRCTRL.bit.INSTR = CMD_DUAL_READ;
+    uint32_t mode = QSPI_INSTRFRAME_WIDTH_DUAL_OUTPUT;
+    #else
+    QSPI->INSTRCTRL.bit.INSTR = CMD_QUAD_READ;
+    uint32_t mode = QSPI_INSTRFRAME_WIDTH_QUAD_OUTPUT;
+    #endif
+
+    QSPI->INSTRFRAME.reg = mode |
+                           QSPI_INSTRFRAME_ADDRLEN_24BITS |
+                           QSPI_INSTRFRAME_TFRTYPE_READMEMORY |
+                           QSPI_INSTRFRAME_INSTREN |
+                           QSPI_INSTRFRAME_ADDREN |
+                           QSPI_INSTRFRAME_DATAEN |
+                           QSPI_INSTRFRAME_DUMMYLEN(8);
+
+    // Dummy read of INSTRFRAME needed to synchronize.
+    (volatile uint32_t) QSPI->INSTRFRAME.reg;
+
+    samd_peripherals_enable_cache();
+    memory_mapped = true;
+}
+
+// End the read memory transfer before sending any other instruction.
+static void end_memory_mapped(void) {
+    if (!memory_mapped) {
+        return;
+    }
+    QSPI->CTRLA.reg = QSPI_CTRLA_ENABLE | QSPI_CTRLA_LASTXFER;
+
+    while( !QSPI->INTFLAG.bit.INSTREND );
+
+    QSPI->INTFLAG.reg = QSPI_INTFLAG_INSTREND;
+    memory_mapped = false;
+}
+
 bool spi_flash_command(uint8_t command) {
+    end_memory_mapped();
     QSPI->INSTRCTRL.bit.INSTR = command;
 
     QSPI->INSTRFRAME.reg = QSPI_INSTRFRAME_WIDTH_SINGLE_BIT_SPI |
@@ -57,6 +108,7 @@ bool spi_flash_command(uint8_t command) {
 }
 
 bool spi_flash_read_command(uint8_t command, uint8_t* response, uint32_t length) {
+    end_memory_mapped();
     samd_peripherals_disable_and_clear_cache();
 
     QSPI->INSTRCTRL.bit.INSTR = command;
@@ -86,6 +138,7 @@ bool spi_flash_read_command(uint8_t command, uint8_t* response, uint32_t length)
 }
 
 bool spi_flash_write_command(uint8_t command, uint8_t* data, uint32_t length) {
+    end_memory_mapped();
     samd_peripherals_disable_and_clear_cache();
 
     QSPI->INSTRCTRL.bit.INSTR = command;
@@ -117,6 +170,7 @@ bool spi_flash_write_command(uint8_t command, uint8_t* data, uint32_t length) {
 }
 
 bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+    end_memory_mapped();
     QSPI->INSTRCTRL.bit.INSTR = command;
     QSPI->INSTRADDR.bit.ADDR = address;
 
@@ -136,6 +190,7 @@ bool spi_flash_sector_command(uint8_t command, uint32_t address) {
 }
 
 bool spi_flash_write_data(uint32_t address, uint8_t* data, uint32_t length) {
+    end_memory_mapped();
     samd_peripherals_disable_and_clear_cache();
 
     QSPI->INSTRCTRL.bit.INSTR = CMD_PAGE_PROGRAM;
@@ -164,39 +219,18 @@ bool spi_flash_write_data(uint32_t address, uint8_t* data, uint32_t length) {
 }
 
 bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t length) {
-    samd_peripherals_disable_and_clear_cache();
-
-    #ifdef EXTERNAL_FLASH_QSPI_DUAL
-    QSPI->INSTRCTRL.bit.INSTR = CMD_DUAL_READ;
-    uint32_t mode = QSPI_INSTRFRAME_WIDTH_DUAL_OUTPUT;
-    #else
-    QSPI->INSTRCTRL.bit.INSTR = CMD_QUAD_READ;
-    uint32_t mode = QSPI_INSTRFRAME_WIDTH_QUAD_OUTPUT;
-    #endif
-
-    QSPI->INSTRFRAME.reg = mode |
-                           QSPI_INSTRFRAME_ADDRLEN_24BITS |
-                           QSPI_INSTRFRAME_TFRTYPE_READMEMORY |
-                           QSPI_INSTRFRAME_INSTREN |
-                           QSPI_INSTRFRAME_ADDREN |
-                           QSPI_INSTRFRAME_DATAEN |
-                           QSPI_INSTRFRAME_DUMMYLEN(8);
-
+    start_memory_mapped();
     memcpy(data, ((uint8_t *) QSPI_AHB) + address, length);
     // TODO(tannewt): Fix DMA and enable it.
     // qspi_dma_read(address, data, length);
-
-    QSPI->CTRLA.reg = QSPI_CTRLA_ENABLE | QSPI_CTRLA_LASTXFER;
-
-    while( !QSPI->INTFLAG.bit.INSTREND );
-
-    QSPI->INTFLAG.reg = QSPI_INTFLAG_INSTREND;
-
-    samd_peripherals_enable_cache();
-
     return true;
 }
 
+const uint8_t* spi_flash_memory_map(uint32_t address, uint32_t length) {
+    (void) length;
+    start_memory_mapped();
+    return ((const uint8_t *) QSPI_AHB) + address;
+}
 
 void spi_flash_init(void) {
     MCLK->APBCMASK.bit.QSPI_ = true;
@@ -204,6 +238,7 @@ void spi_flash_init(void) {
     MCLK->AHBMASK.bit.QSPI_2X_ = false; // Only true if we are doing DDR.
 
     QSPI->CTRLA.reg = QSPI_CTRLA_SWRST;
+    memory_mapped = false;
     // We don't need to wait because we're running as fast as the CPU.
 
     // Slow, good for debugging with Saleae
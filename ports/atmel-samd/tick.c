@@ -39,22 +39,77 @@
 #if CIRCUITPY_GAMEPADSHIFT
 #include "shared-module/gamepadshift/__init__.h"
 #endif
+
+#if CIRCUITPY_INTERRUPTIO
+#include "shared-module/interruptio/__init__.h"
+#endif
+
+#if CIRCUITPY_PROFILER
+#include "shared-module/profiler/__init__.h"
+#endif
 // Global millisecond tick count
 volatile uint64_t ticks_ms = 0;
 
+// The CPU runs at CONF_CPU_FREQUENCY divided by this. SysTick counts CPU cycles, so a new
+// divider waits for the tick, when the counter has just reloaded and the millisecond being timed
+// hasn't started yet.
+static uint8_t cpu_divider = 1;
+static volatile uint8_t next_cpu_divider = 1;
+
+static void set_cpu_clock_divider(uint8_t divider) {
+    #ifdef SAMD21
+    // The APB clocks mustn't be faster than the CPU, so slow them first and speed them up last.
+    uint8_t shift = __builtin_ctz(divider);
+    if (divider > cpu_divider) {
+        PM->APBASEL.reg = shift;
+        PM->APBBSEL.reg = shift;
+        PM->APBCSEL.reg = shift;
+    }
+    PM->INTFLAG.reg = PM_INTFLAG_CKRDY;
+    PM->CPUSEL.reg = shift;
+    while (PM->INTFLAG.bit.CKRDY == 0) {}
+    if (divider < cpu_divider) {
+        PM->APBASEL.reg = shift;
+        PM->APBBSEL.reg = shift;
+        PM->APBCSEL.reg = shift;
+    }
+    #endif
+    #ifdef SAMD51
+    MCLK->INTFLAG.reg = MCLK_INTFLAG_CKRDY;
+    MCLK->CPUDIV.reg = MCLK_CPUDIV_DIV(divider);
+    while (MCLK->INTFLAG.bit.CKRDY == 0) {}
+    #endif
+    cpu_divider = divider;
+}
+
 void SysTick_Handler(void) {
     // SysTick interrupt handler called when the SysTick timer reaches zero
-    // (every millisecond).
-    common_hal_mcu_disable_interrupts();
+    // (every millisecond). It runs at the highest priority so nothing can interrupt the
+    // 64-bit increment. Readers in lower priority code guard their own reads.
     ticks_ms += 1;
 
     // Read the control register to reset the COUNTFLAG.
     (void) SysTick->CTRL;
-    common_hal_mcu_enable_interrupts();
+
+    if (next_cpu_divider != cpu_divider) {
+        set_cpu_clock_divider(next_cpu_divider);
+        // Writing VAL restarts the count from the new LOAD. Only the few cycles since the reload
+        // are lost.
+        SysTick->LOAD = CONF_CPU_FREQUENCY / cpu_divider / 1000 - 1;
+        SysTick->VAL = 0;
+    }
+
+    background_tasks_pending = 1;
 
     #ifdef CIRCUITPY_AUTORELOAD_DELAY_MS
         autoreload_tick();
     #endif
+    #if CIRCUITPY_INTERRUPTIO
+    interruptio_tick();
+    #endif
+    #if CIRCUITPY_PROFILER
+    profiler_tick();
+    #endif
     #ifdef CIRCUITPY_GAMEPAD_TICKS
     if (!(ticks_ms & CIRCUITPY_GAMEPAD_TICKS)) {
         #if CIRCUITPY_GAMEPAD
@@ -89,6 +144,28 @@ void tick_init() {
     #endif
 }
 
+void tick_set_cpu_divider(uint8_t divider) {
+    next_cpu_divider = divider;
+}
+
+uint32_t tick_cpu_frequency(void) {
+    return CONF_CPU_FREQUENCY / cpu_divider;
+}
+
+uint8_t tick_begin_full_speed(void) {
+    uint8_t divider = cpu_divider;
+    if (divider != 1) {
+        set_cpu_clock_divider(1);
+    }
+    return divider;
+}
+
+void tick_end_full_speed(uint8_t divider) {
+    if (divider != 1) {
+        set_cpu_clock_divider(divider);
+    }
+}
+
 void tick_delay(uint32_t us) {
     uint32_t ticks_per_us = common_hal_mcu_processor_get_frequency() / 1000 / 1000;
     uint32_t us_until_next_tick = SysTick->VAL / ticks_per_us;
@@ -34,6 +34,16 @@ extern struct timer_descriptor ms_timer;
 
 void tick_init(void);
 
+// Switches the CPU clock to CONF_CPU_FREQUENCY divided by 1, 2, 4 or 8 at the next tick.
+void tick_set_cpu_divider(uint8_t divider);
+// The frequency the CPU and SysTick run at now.
+uint32_t tick_cpu_frequency(void);
+
+// For cycle counted code with interrupts off. Runs the CPU at full speed without retiming the
+// tick, and returns what to pass to tick_end_full_speed to put the clock back.
+uint8_t tick_begin_full_speed(void);
+void tick_end_full_speed(uint8_t divider);
+
 void tick_delay(uint32_t us);
 
 void current_tick(uint64_t* ms, uint32_t* us_until_ms);
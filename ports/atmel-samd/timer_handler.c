@@ -29,7 +29,9 @@
 
 #include "timer_handler.h"
 
+#include "common-hal/pulseio/PulseIn.h"
 #include "common-hal/pulseio/PulseOut.h"
+#include "common-hal/pulseio/PWMOut.h"
 #include "shared-module/_pew/PewPew.h"
 #include "common-hal/frequencyio/FrequencyIn.h"
 
@@ -60,6 +62,16 @@ void shared_timer_handler(bool is_tc, uint8_t index) {
                 frequencyin_interrupt_handler(index);
             #endif
                 break;
+            case TC_HANDLER_PULSEIN:
+            #if CIRCUITPY_PULSEIO
+                pulsein_timer_interrupt_handler(index);
+            #endif
+                break;
+            case TC_HANDLER_PWMOUT:
+            #if CIRCUITPY_PULSEIO && defined(SAMD21)
+                pwmout_interrupt_handler(index);
+            #endif
+                break;
             default:
                 break;
         }
@@ -30,6 +30,18 @@
 #define TC_HANDLER_PULSEOUT 0x1
 #define TC_HANDLER_PEW 0x2
 #define TC_HANDLER_FREQUENCYIN 0x3
+#define TC_HANDLER_PULSEIN 0x4
+#define TC_HANDLER_PWMOUT 0x5
+
+// The DMA triggers for the overflow and capture channel 0 of tc_insts[index]. Each TC has
+// three in order: OVF, MC0 and MC1.
+#ifdef SAMD21
+#define TC_OVF_DMA_TRIGGER(index) (TC3_DMAC_ID_OVF + 3 * (index))
+#endif
+#ifdef SAMD51
+#define TC_OVF_DMA_TRIGGER(index) (TC0_DMAC_ID_OVF + 3 * (index))
+#endif
+#define TC_MC0_DMA_TRIGGER(index) (TC_OVF_DMA_TRIGGER(index) + 1)
 
 void set_timer_handler(bool is_tc, uint8_t index, uint8_t timer_handler);
 void shared_timer_handler(bool is_tc, uint8_t index);
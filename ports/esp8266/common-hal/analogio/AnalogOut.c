@@ -49,3 +49,15 @@ void common_hal_analogio_analogout_deinit(analogio_analogout_obj_t *self) {
 void common_hal_analogio_analogout_set_value(analogio_analogout_obj_t *self,
         uint16_t value) {
 }
+
+void common_hal_analogio_analogout_play(analogio_analogout_obj_t *self, mp_obj_t buffer,
+        const uint8_t* data, uint32_t sample_count, uint8_t bytes_per_sample,
+        uint32_t sample_rate, bool loop) {
+}
+
+void common_hal_analogio_analogout_stop(analogio_analogout_obj_t *self) {
+}
+
+bool common_hal_analogio_analogout_get_playing(analogio_analogout_obj_t *self) {
+    return false;
+}
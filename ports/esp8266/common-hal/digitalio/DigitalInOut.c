@@ -226,3 +226,16 @@ digitalio_pull_t common_hal_digitalio_digitalinout_get_pull(
     }
     return PULL_NONE;
 }
+
+bool common_hal_digitalio_digitalinout_get_registers(digitalio_digitalinout_obj_t* self,
+        digitalinout_registers_t* registers) {
+    // GPIO16 is in the RTC block and has no set and clear registers.
+    if (self->pin->gpio_number == 16) {
+        return false;
+    }
+    registers->set = (volatile uint32_t*) (PERIPHS_GPIO_BASEADDR + GPIO_OUT_W1TS_ADDRESS);
+    registers->clear = (volatile uint32_t*) (PERIPHS_GPIO_BASEADDR + GPIO_OUT_W1TC_ADDRESS);
+    registers->input = (volatile uint32_t*) (PERIPHS_GPIO_BASEADDR + GPIO_IN_ADDRESS);
+    registers->mask = 1 << self->pin->gpio_number;
+    return true;
+}
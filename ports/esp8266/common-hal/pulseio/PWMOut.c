@@ -103,6 +103,15 @@ void common_hal_pulseio_pwmout_set_duty_cycle(pulseio_pwmout_obj_t* self, uint16
     pwm_start();
 }
 
+void common_hal_pulseio_pwmout_set_duty_cycles(pulseio_pwmout_obj_t** pwms,
+        const uint16_t* duty_cycles, size_t count) {
+    // pwm_start() applies every pending duty at once.
+    for (size_t i = 0; i < count; i++) {
+        pwm_set_duty(duty_cycles[i] >> 6, pwms[i]->channel);
+    }
+    pwm_start();
+}
+
 uint16_t common_hal_pulseio_pwmout_get_duty_cycle(pulseio_pwmout_obj_t* self) {
     return pwm_get_duty(self->channel) << 6;
 }
@@ -54,8 +54,15 @@ void common_hal_pulseio_pulseout_deinit(pulseio_pulseout_obj_t* self) {
     pulseout_set(self, true);
 }
 
+void common_hal_pulseio_pulseout_stop(pulseio_pulseout_obj_t* self) {
+    // Sends finish before returning so there is never anything to stop.
+}
+
 void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self,
-        uint16_t* pulses, uint16_t length) {
+        uint16_t* pulses, uint16_t length, bool loop) {
+    if (loop) {
+        mp_raise_NotImplementedError(translate("loop is not supported"));
+    }
     for (uint16_t i = 0; i<length; i++) {
         pulseout_set(self, i % 2 == 0);
         ets_delay_us(pulses[i]);
@@ -35,6 +35,10 @@ inline uint64_t common_hal_time_monotonic() {
     return ((uint64_t)system_time_high_word << 32 | (uint64_t)system_get_time()) / 1000;
 }
 
+uint64_t common_hal_time_monotonic_ns(void) {
+    return ((uint64_t)system_time_high_word << 32 | (uint64_t)system_get_time()) * 1000;
+}
+
 void common_hal_time_delay_ms(uint32_t delay) {
     mp_hal_delay_ms(delay);
 }
@@ -0,0 +1,265 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "audio_dma.h"
+
+#include "shared-module/audioio/__init__.h"
+#include "tick.h"
+
+#include "py/mpstate.h"
+#include "py/runtime.h"
+
+// Enough for about 12ms of 44.1kHz stereo and small enough to allocate for every output.
+#define AUDIO_DMA_BUFFER_LENGTH (1024)
+// Shorter buffers than this leave too little time to refill them between background tasks.
+#define AUDIO_DMA_MIN_BUFFER_LENGTH (32)
+
+static uint64_t audio_dma_now_us(void) {
+    uint64_t ms;
+    uint32_t us_until_ms;
+    current_tick(&ms, &us_until_ms);
+    return ms * 1000 + (1000 - us_until_ms);
+}
+
+static void fill_quiescent(audio_dma_t* dma, uint16_t* buffer, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        buffer[i] = dma->quiescent_value;
+    }
+}
+
+// Reads one sample as signed 16-bit.
+static inline int16_t read_sample(audio_dma_t* dma, uint8_t* data) {
+    if (dma->bytes_per_sample == 2) {
+        uint16_t value = *((uint16_t*) data);
+        if (!dma->samples_signed) {
+            value ^= 0x8000;
+        }
+        return (int16_t) value;
+    }
+    uint8_t value = *data;
+    if (!dma->samples_signed) {
+        value ^= 0x80;
+    }
+    return (int16_t) (value << 8);
+}
+
+static inline uint16_t output_value(audio_dma_t* dma, int32_t value) {
+    if (dma->output_scale == 0) {
+        return (uint16_t) value;
+    }
+    return (((uint32_t) (value + 0x8000) * dma->output_scale) >> 16) | dma->output_flags;
+}
+
+static bool convert_into_buffer(audio_dma_t* dma, uint8_t index) {
+    uint16_t* output = dma->buffer[index];
+    uint32_t output_length = dma->buffer_length;
+    if (dma->paused) {
+        fill_quiescent(dma, output, output_length);
+        return true;
+    }
+    uint32_t frame_size = dma->bytes_per_sample * dma->sample_channel_count;
+    uint32_t i = 0;
+    while (i < output_length && !dma->done) {
+        if (dma->sample_data >= dma->sample_end) {
+            if (!dma->more_data) {
+                if (!dma->loop) {
+                    dma->done = true;
+                    break;
+                }
+                audiosample_reset_buffer(dma->sample, false, 0);
+            }
+            uint8_t* buffer;
+            uint32_t buffer_length;
+            audioio_get_buffer_result_t result = audiosample_get_buffer(dma->sample, false, 0,
+                                                                        &buffer, &buffer_length);
+            if (result == GET_BUFFER_ERROR || (buffer_length == 0 && !dma->more_data)) {
+                // Stop rather than loop forever over a sample with nothing in it.
+                dma->done = true;
+                break;
+            }
+            dma->more_data = result == GET_BUFFER_MORE_DATA;
+            dma->sample_data = buffer;
+            dma->sample_end = buffer + buffer_length - (buffer_length % frame_size);
+            continue;
+        }
+        uint8_t* data = dma->sample_data;
+        uint8_t* second_channel = data + (dma->sample_channel_count - 1) * dma->bytes_per_sample;
+        int32_t left = read_sample(dma, data);
+        int32_t right = read_sample(dma, second_channel);
+        if (dma->output_channel_count == 1) {
+            output[i++] = output_value(dma, (left + right) / 2);
+        } else {
+            output[i++] = output_value(dma, left);
+            output[i++] = output_value(dma, right);
+        }
+        dma->sample_data += frame_size;
+    }
+    fill_quiescent(dma, output + i, output_length - i);
+    return i > 0;
+}
+
+bool audio_dma_fill_buffer(audio_dma_t* dma, uint8_t index) {
+    bool filled = convert_into_buffer(dma, index);
+    // The other buffer started playing at some point after the last idle poll, so it's done no
+    // earlier than a buffer's time after that.
+    uint64_t now = audio_dma_now_us();
+    int64_t slack = (int64_t) (dma->last_poll_us + dma->buffer_us) - (int64_t) now;
+    if (slack < 0) {
+        dma->underruns++;
+        slack = 0;
+    }
+    if (dma->min_slack_us < 0 || slack < dma->min_slack_us) {
+        dma->min_slack_us = slack;
+    }
+    // The next deadline is a buffer's time after this one's at the earliest.
+    dma->last_poll_us = now;
+    return filled;
+}
+
+void audio_dma_idle(audio_dma_t* dma) {
+    dma->last_poll_us = audio_dma_now_us();
+}
+
+// Playback should be shutdown before calling this.
+audio_dma_result audio_dma_setup_playback(audio_dma_t* dma,
+                                          mp_obj_t sample,
+                                          bool loop,
+                                          uint8_t output_channel_count,
+                                          uint16_t output_scale,
+                                          uint16_t output_flags,
+                                          uint16_t quiescent_value,
+                                          uint8_t slot,
+                                          mp_obj_t owner) {
+    if (slot >= AUDIO_DMA_CHANNEL_COUNT || MP_STATE_PORT(playing_audio)[slot] != NULL) {
+        return AUDIO_DMA_DMA_BUSY;
+    }
+    dma->sample = sample;
+    dma->loop = loop;
+    dma->output_channel_count = output_channel_count;
+    dma->output_scale = output_scale;
+    dma->output_flags = output_flags;
+    dma->quiescent_value = quiescent_value;
+    dma->sample_channel_count = audiosample_channel_count(sample);
+    dma->bytes_per_sample = audiosample_bits_per_sample(sample) / 8;
+    dma->more_data = true;
+    dma->done = false;
+    dma->paused = false;
+    dma->sample_data = NULL;
+    dma->sample_end = NULL;
+    audiosample_reset_buffer(sample, false, 0);
+
+    bool single_buffer;
+    uint32_t max_buffer_length;
+    uint8_t spacing;
+    audiosample_get_buffer_structure(sample, false, &single_buffer, &dma->samples_signed,
+                                     &max_buffer_length, &spacing);
+
+    // Match the buffers to the sample's so that small sample buffers give low latency. Keep a whole
+    // number of frames in each buffer.
+    uint32_t buffer_length = max_buffer_length / (dma->bytes_per_sample * dma->sample_channel_count) *
+                             output_channel_count;
+    if (buffer_length < AUDIO_DMA_MIN_BUFFER_LENGTH) {
+        buffer_length = AUDIO_DMA_MIN_BUFFER_LENGTH;
+    } else if (buffer_length > AUDIO_DMA_BUFFER_LENGTH) {
+        buffer_length = AUDIO_DMA_BUFFER_LENGTH;
+    }
+    dma->buffer_length = buffer_length - buffer_length % output_channel_count;
+    uint32_t sample_rate = audiosample_sample_rate(sample);
+    dma->buffer_us = 0;
+    if (sample_rate > 0) {
+        dma->buffer_us = (uint64_t) (dma->buffer_length / output_channel_count) * 1000000 /
+                         sample_rate;
+    }
+    dma->underruns = 0;
+    dma->min_slack_us = -1;
+    for (uint8_t i = 0; i < 2; i++) {
+        if (dma->buffer[i] == NULL) {
+            dma->buffer[i] = (uint16_t*) m_malloc_maybe(AUDIO_DMA_BUFFER_LENGTH * sizeof(uint16_t),
+                                                        false);
+        }
+        if (dma->buffer[i] == NULL) {
+            return AUDIO_DMA_MEMORY_ERROR;
+        }
+    }
+
+    // Keep the owner alive because it holds the buffers the peripheral is reading.
+    dma->slot = slot;
+    MP_STATE_PORT(playing_audio)[slot] = owner;
+
+    convert_into_buffer(dma, 0);
+    convert_into_buffer(dma, 1);
+    // The peripheral starts right after this.
+    dma->last_poll_us = audio_dma_now_us();
+    return AUDIO_DMA_OK;
+}
+
+void audio_dma_stop(audio_dma_t* dma) {
+    if (dma->slot < AUDIO_DMA_CHANNEL_COUNT) {
+        MP_STATE_PORT(playing_audio)[dma->slot] = NULL;
+    }
+    dma->slot = AUDIO_DMA_CHANNEL_COUNT;
+    dma->sample = NULL;
+    dma->paused = false;
+}
+
+// Pausing keeps the peripheral running on quiescent values so that resuming doesn't click.
+void audio_dma_pause(audio_dma_t* dma) {
+    dma->paused = true;
+}
+
+void audio_dma_resume(audio_dma_t* dma) {
+    dma->paused = false;
+}
+
+bool audio_dma_get_paused(audio_dma_t* dma) {
+    return audio_dma_get_playing(dma) && dma->paused;
+}
+
+void audio_dma_init(audio_dma_t* dma) {
+    dma->slot = AUDIO_DMA_CHANNEL_COUNT;
+    dma->sample = NULL;
+    dma->buffer[0] = NULL;
+    dma->buffer[1] = NULL;
+}
+
+void audio_dma_reset(void) {
+    for (uint8_t i = 0; i < AUDIO_DMA_CHANNEL_COUNT; i++) {
+        MP_STATE_PORT(playing_audio)[i] = NULL;
+    }
+}
+
+bool audio_dma_get_playing(audio_dma_t* dma) {
+    return dma->slot < AUDIO_DMA_CHANNEL_COUNT;
+}
+
+uint32_t audio_dma_get_underruns(audio_dma_t* dma) {
+    return dma->underruns;
+}
+
+int32_t audio_dma_get_min_slack_us(audio_dma_t* dma) {
+    return dma->min_slack_us;
+}
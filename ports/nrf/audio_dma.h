@@ -0,0 +1,106 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_NRF_AUDIO_DMA_H
+#define MICROPY_INCLUDED_NRF_AUDIO_DMA_H
+
+#include "extmod/vfs_fat.h"
+#include "py/obj.h"
+#include "shared-module/audioio/RawSample.h"
+#include "shared-module/audioio/WaveFile.h"
+
+// EasyDMA can only read RAM and the peripherals want fixed size 16-bit values, so samples are
+// converted into a pair of buffers that the peripheral alternates between. One is refilled from
+// the background while the other plays.
+typedef struct {
+    mp_obj_t sample;
+    uint16_t* buffer[2];
+    uint16_t buffer_length; // Values in each buffer.
+    // Zero to output signed 16-bit values. Otherwise values are unsigned from zero to output_scale
+    // and have output_flags ORed in.
+    uint16_t output_scale;
+    uint16_t output_flags;
+    uint16_t quiescent_value; // Value output once the sample is done and while paused.
+    uint8_t slot;
+    uint8_t output_channel_count;
+    uint8_t sample_channel_count;
+    uint8_t bytes_per_sample;
+    bool samples_signed;
+    bool loop;
+    bool more_data;
+    bool done;
+    bool paused;
+    uint8_t* sample_data;
+    uint8_t* sample_end;
+    // Playback health. Slack is how long before the output needed it that a buffer was refilled,
+    // measured from the last background poll that found nothing to refill.
+    uint32_t underruns;
+    int32_t min_slack_us;
+    uint32_t buffer_us; // Time to play one buffer.
+    uint64_t last_poll_us;
+} audio_dma_t;
+
+typedef enum {
+    AUDIO_DMA_OK,
+    AUDIO_DMA_DMA_BUSY,
+    AUDIO_DMA_MEMORY_ERROR,
+} audio_dma_result;
+
+void audio_dma_init(audio_dma_t* dma);
+void audio_dma_reset(void);
+
+// This sets everything up and fills both buffers but doesn't start the peripheral.
+// Sample is the python object for the sample to play.
+// loop is true if we should loop the sample.
+// output_channel_count is 1 or 2. Mono samples are duplicated into both channels and stereo
+//   samples are averaged into one.
+// output_scale, output_flags and quiescent_value describe the output values. See audio_dma_t.
+// slot is the index of the output in MP_STATE_PORT(playing_audio) and owner is the object kept
+//   alive there while playing.
+audio_dma_result audio_dma_setup_playback(audio_dma_t* dma,
+                                          mp_obj_t sample,
+                                          bool loop,
+                                          uint8_t output_channel_count,
+                                          uint16_t output_scale,
+                                          uint16_t output_flags,
+                                          uint16_t quiescent_value,
+                                          uint8_t slot,
+                                          mp_obj_t owner);
+// Refills the given buffer once the peripheral is done with it. Returns false once the sample is
+// over and the buffer is only quiescent values.
+bool audio_dma_fill_buffer(audio_dma_t* dma, uint8_t index);
+// Call from the background when neither buffer needs refilling.
+void audio_dma_idle(audio_dma_t* dma);
+uint32_t audio_dma_get_underruns(audio_dma_t* dma);
+// Negative until a buffer has been refilled.
+int32_t audio_dma_get_min_slack_us(audio_dma_t* dma);
+void audio_dma_stop(audio_dma_t* dma);
+bool audio_dma_get_playing(audio_dma_t* dma);
+void audio_dma_pause(audio_dma_t* dma);
+void audio_dma_resume(audio_dma_t* dma);
+bool audio_dma_get_paused(audio_dma_t* dma);
+
+#endif  // MICROPY_INCLUDED_NRF_AUDIO_DMA_H
@@ -26,13 +26,28 @@
 
 #include "py/runtime.h"
 #include "supervisor/filesystem.h"
+#include "supervisor/serial.h"
 #include "supervisor/usb.h"
 #include "supervisor/shared/stack.h"
 
+#if CIRCUITPY_AUDIOIO
+#include "common-hal/audioio/AudioOut.h"
+#endif
+
+#if CIRCUITPY_AUDIOBUSIO
+#include "common-hal/audiobusio/I2SOut.h"
+#endif
+
+#if CIRCUITPY_KEYPAD
+#include "shared-module/keypad/__init__.h"
+#endif
+
 #ifdef CIRCUITPY_DISPLAYIO
 #include "shared-module/displayio/__init__.h"
 #endif
 
+volatile uint8_t background_tasks_pending = 0;
+
 static bool running_background_tasks = false;
 
 void background_tasks_reset(void) {
@@ -44,10 +59,23 @@ void run_background_tasks(void) {
     if (running_background_tasks) {
         return;
     }
+    // Clear it first so a request made while the tasks run isn't lost.
+    background_tasks_pending = 0;
     running_background_tasks = true;
     filesystem_background();
+    mp_hal_stdout_flush();
     usb_background();
 
+    #if CIRCUITPY_AUDIOIO
+    audioout_background();
+    #endif
+    #if CIRCUITPY_AUDIOBUSIO
+    i2sout_background();
+    #endif
+    #if CIRCUITPY_KEYPAD
+    keypad_background();
+    #endif
+
     #ifdef CIRCUITPY_DISPLAYIO
     displayio_refresh_displays();
     #endif
@@ -42,45 +42,96 @@ nrf_nvic_state_t nrf_nvic_state = { 0 };
 // Flag indicating progress of internal flash operation.
 sd_flash_operation_status_t sd_flash_operation_status;
 
+uint16_t ble_drv_att_mtu = BLE_GATT_ATT_MTU_DEFAULT;
+
 __attribute__((aligned(4)))
-static uint8_t m_ble_evt_buf[sizeof(ble_evt_t) + (BLE_GATT_ATT_MTU_DEFAULT)];
+static uint8_t m_ble_evt_buf[sizeof(ble_evt_t) + (BLE_GATT_ATT_MTU_THROUGHPUT)];
 
 void ble_drv_reset() {
     // Linked list items will be gc'd.
-    MP_STATE_VM(ble_drv_evt_handler_entries) = NULL;
+    for (size_t i = 0; i < BLE_DRV_EVT_GROUP_COUNT; i++) {
+        MP_STATE_VM(ble_drv_evt_handler_entries)[i] = NULL;
+    }
     sd_flash_operation_status = SD_FLASH_OPERATION_DONE;
 }
 
 void ble_drv_add_event_handler(ble_drv_evt_handler_t func, void *param) {
-    ble_drv_evt_handler_entry_t *it = MP_STATE_VM(ble_drv_evt_handler_entries);
-    while (it != NULL) {
-        // If event handler and its corresponding param are already on the list, don't add again.
-        if ((it->func == func) && (it->param == param)) {
-            return;
+    ble_drv_add_filtered_event_handler(func, param, BLE_DRV_EVT_ALL, BLE_GATT_HANDLE_INVALID);
+}
+
+void ble_drv_add_filtered_event_handler(ble_drv_evt_handler_t func, void *param, uint8_t evt_groups, uint16_t attr_handle) {
+    for (size_t group = 0; group < BLE_DRV_EVT_GROUP_COUNT; group++) {
+        if ((evt_groups & (1 << group)) == 0) {
+            continue;
+        }
+
+        ble_drv_evt_handler_entry_t *it = MP_STATE_VM(ble_drv_evt_handler_entries)[group];
+        while (it != NULL) {
+            // If event handler and its corresponding param are already on the list, don't add again.
+            if ((it->func == func) && (it->param == param)) {
+                break;
+            }
+            it = it->next;
+        }
+        if (it != NULL) {
+            continue;
         }
-        it = it->next;
-    }
 
-    // Add a new handler to the front of the list
-    ble_drv_evt_handler_entry_t *handler = m_new_ll(ble_drv_evt_handler_entry_t, 1);
-    handler->next = MP_STATE_VM(ble_drv_evt_handler_entries);
-    handler->param = param;
-    handler->func = func;
+        // Add a new handler to the front of the list
+        ble_drv_evt_handler_entry_t *handler = m_new_ll(ble_drv_evt_handler_entry_t, 1);
+        handler->next = MP_STATE_VM(ble_drv_evt_handler_entries)[group];
+        handler->param = param;
+        handler->func = func;
+        handler->attr_handle = attr_handle;
 
-    MP_STATE_VM(ble_drv_evt_handler_entries) = handler;
+        MP_STATE_VM(ble_drv_evt_handler_entries)[group] = handler;
+    }
 }
 
 void ble_drv_remove_event_handler(ble_drv_evt_handler_t func, void *param) {
-    ble_drv_evt_handler_entry_t *it = MP_STATE_VM(ble_drv_evt_handler_entries);
-    ble_drv_evt_handler_entry_t **prev = &MP_STATE_VM(ble_drv_evt_handler_entries);
-    while (it != NULL) {
-        if ((it->func == func) && (it->param == param)) {
-            // Splice out the matching handler.
-            *prev = it->next;
-            return;
+    for (size_t group = 0; group < BLE_DRV_EVT_GROUP_COUNT; group++) {
+        ble_drv_evt_handler_entry_t *it = MP_STATE_VM(ble_drv_evt_handler_entries)[group];
+        ble_drv_evt_handler_entry_t **prev = &MP_STATE_VM(ble_drv_evt_handler_entries)[group];
+        while (it != NULL) {
+            if ((it->func == func) && (it->param == param)) {
+                // Splice out the matching handler.
+                *prev = it->next;
+                break;
+            }
+            prev = &(it->next);
+            it = it->next;
         }
-        prev = &(it->next);
-        it = it->next;
+    }
+}
+
+STATIC size_t evt_group(uint16_t evt_id) {
+    if (evt_id >= BLE_L2CAP_EVT_BASE) {
+        return 4;
+    } else if (evt_id >= BLE_GATTS_EVT_BASE) {
+        return 3;
+    } else if (evt_id >= BLE_GATTC_EVT_BASE) {
+        return 2;
+    } else if (evt_id >= BLE_GAP_EVT_BASE) {
+        return 1;
+    }
+    return 0;
+}
+
+// The attribute handle a GATT event is about, or BLE_GATT_HANDLE_INVALID if it isn't about one.
+STATIC uint16_t evt_attr_handle(ble_evt_t *ble_evt) {
+    switch (ble_evt->header.evt_id) {
+    case BLE_GATTS_EVT_WRITE:
+        return ble_evt->evt.gatts_evt.params.write.handle;
+    case BLE_GATTS_EVT_HVC:
+        return ble_evt->evt.gatts_evt.params.hvc.handle;
+    case BLE_GATTC_EVT_READ_RSP:
+        return ble_evt->evt.gattc_evt.params.read_rsp.handle;
+    case BLE_GATTC_EVT_WRITE_RSP:
+        return ble_evt->evt.gattc_evt.params.write_rsp.handle;
+    case BLE_GATTC_EVT_HVX:
+        return ble_evt->evt.gattc_evt.params.hvx.handle;
+    default:
+        return BLE_GATT_HANDLE_INVALID;
     }
 }
 
@@ -126,9 +177,13 @@ void SD_EVT_IRQHandler(void) {
             break;
         }
 
-        ble_drv_evt_handler_entry_t *it = MP_STATE_VM(ble_drv_evt_handler_entries);
+        ble_evt_t *ble_evt = (ble_evt_t *)m_ble_evt_buf;
+        const uint16_t attr_handle = evt_attr_handle(ble_evt);
+        ble_drv_evt_handler_entry_t *it = MP_STATE_VM(ble_drv_evt_handler_entries)[evt_group(ble_evt->header.evt_id)];
         while (it != NULL) {
-            it->func((ble_evt_t *)m_ble_evt_buf, it->param);
+            if (it->attr_handle == BLE_GATT_HANDLE_INVALID || it->attr_handle == attr_handle) {
+                it->func(ble_evt, it->param);
+            }
             it = it->next;
         }
     }
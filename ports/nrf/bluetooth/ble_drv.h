@@ -42,6 +42,16 @@
 
 #define BLE_CONN_CFG_TAG_CUSTOM 1
 
+// The SoftDevice is configured for the largest ATT MTU and a longer connection event so
+// notifications can carry 244 bytes each and several can go out per connection event. The
+// defaults are used instead if the RAM reserved for the SoftDevice is too small.
+#define BLE_GATT_ATT_MTU_THROUGHPUT 247
+// In 1.25ms units.
+#define BLE_GAP_EVENT_LENGTH_THROUGHPUT 6
+
+// The ATT MTU the SoftDevice was configured with.
+extern uint16_t ble_drv_att_mtu;
+
 #define MSEC_TO_UNITS(TIME, RESOLUTION) (((TIME) * 1000) / (RESOLUTION))
 // 0.625 msecs (625 usecs)
 #define ADV_INTERVAL_UNIT_FLOAT_SECS (0.000625)
@@ -50,6 +60,15 @@
 
 typedef void (*ble_drv_evt_handler_t)(ble_evt_t*, void*);
 
+// Groups of events a handler can ask for, to be or'ed together. A handler is only called for
+// events in the groups it was added for.
+#define BLE_DRV_EVT_COMMON (1 << 0)
+#define BLE_DRV_EVT_GAP    (1 << 1)
+#define BLE_DRV_EVT_GATTC  (1 << 2)
+#define BLE_DRV_EVT_GATTS  (1 << 3)
+#define BLE_DRV_EVT_L2CAP  (1 << 4)
+#define BLE_DRV_EVT_ALL    ((1 << BLE_DRV_EVT_GROUP_COUNT) - 1)
+
 typedef enum {
     SD_FLASH_OPERATION_DONE,
     SD_FLASH_OPERATION_IN_PROGRESS,
@@ -63,10 +82,15 @@ typedef struct ble_drv_evt_handler_entry {
     struct ble_drv_evt_handler_entry *next;
     void *param;
     ble_drv_evt_handler_t func;
+    // BLE_GATT_HANDLE_INVALID, or only call func for events about this attribute.
+    uint16_t attr_handle;
 } ble_drv_evt_handler_entry_t;
 
 void ble_drv_reset(void);
 void ble_drv_add_event_handler(ble_drv_evt_handler_t func, void *param);
+// Only call func for events in evt_groups. If attr_handle isn't BLE_GATT_HANDLE_INVALID, only
+// call it for GATT events that name that attribute handle.
+void ble_drv_add_filtered_event_handler(ble_drv_evt_handler_t func, void *param, uint8_t evt_groups, uint16_t attr_handle);
 void ble_drv_remove_event_handler(ble_drv_evt_handler_t func, void *param);
 
 #endif // MICROPY_INCLUDED_NRF_BLUETOOTH_BLE_DRV_H
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "ble_gatt_cache.h"
+#include "peripherals/nrf/nvm.h"
+#include "py/misc.h"
+#include "py/runtime.h"
+
+#define BLE_GATT_CACHE_MAGIC 0x43544147  // "GATC"
+
+// defined in linker
+extern uint32_t __fatfs_flash_start_addr[];
+extern uint32_t __fatfs_flash_length[];
+
+#define BLE_GATT_CACHE_START_ADDR ((uint32_t)__fatfs_flash_start_addr + \
+     (uint32_t)__fatfs_flash_length - CIRCUITPY_INTERNAL_NVM_SIZE - CIRCUITPY_BLE_CONFIG_SIZE)
+#define BLE_GATT_CACHE_PAGES (CIRCUITPY_BLE_CONFIG_SIZE / FLASH_PAGE_SIZE)
+
+STATIC const ble_gatt_cache_t *cache_page(size_t i) {
+    return (const ble_gatt_cache_t *) (BLE_GATT_CACHE_START_ADDR + i * FLASH_PAGE_SIZE);
+}
+
+STATIC bool same_peer(const ble_gatt_cache_t *table, uint8_t address_type, const uint8_t *address) {
+    return table->magic == BLE_GATT_CACHE_MAGIC &&
+        table->address_type == address_type &&
+        memcmp(table->address, address, sizeof(table->address)) == 0;
+}
+
+const ble_gatt_cache_t *ble_gatt_cache_find(uint8_t address_type, const uint8_t *address, const uint8_t *hash) {
+    for (size_t i = 0; i < BLE_GATT_CACHE_PAGES; i++) {
+        const ble_gatt_cache_t *table = cache_page(i);
+        if (same_peer(table, address_type, address)) {
+            if (memcmp(table->hash, hash, BLE_GATT_CACHE_HASH_LENGTH) == 0) {
+                return table;
+            }
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+void ble_gatt_cache_store(ble_gatt_cache_t *table) {
+    MP_STATIC_ASSERT(sizeof(ble_gatt_cache_t) <= FLASH_PAGE_SIZE);
+
+    if (BLE_GATT_CACHE_PAGES == 0) {
+        return;
+    }
+
+    // Use the peer's own page if it has one, otherwise an unused page, otherwise the oldest.
+    size_t page = 0;
+    uint32_t oldest_sequence = UINT32_MAX;
+    uint32_t newest_sequence = 0;
+    bool found = false;
+    for (size_t i = 0; i < BLE_GATT_CACHE_PAGES; i++) {
+        const ble_gatt_cache_t *stored = cache_page(i);
+        if (stored->magic != BLE_GATT_CACHE_MAGIC) {
+            if (!found) {
+                page = i;
+                oldest_sequence = 0;
+            }
+            continue;
+        }
+        newest_sequence = MAX(newest_sequence, stored->sequence);
+        if (found) {
+            continue;
+        }
+        if (same_peer(stored, table->address_type, table->address)) {
+            page = i;
+            found = true;
+        } else if (stored->sequence < oldest_sequence) {
+            page = i;
+            oldest_sequence = stored->sequence;
+        }
+    }
+
+    table->magic = BLE_GATT_CACHE_MAGIC;
+    table->sequence = newest_sequence + 1;
+
+    uint8_t *buffer = m_new(uint8_t, FLASH_PAGE_SIZE);
+    memset(buffer, 0xff, FLASH_PAGE_SIZE);
+    memcpy(buffer, table, sizeof(ble_gatt_cache_t));
+    nrf_nvm_safe_flash_page_write((uint32_t) cache_page(page), buffer);
+    m_del(uint8_t, buffer, FLASH_PAGE_SIZE);
+}
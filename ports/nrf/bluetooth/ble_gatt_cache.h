@@ -0,0 +1,85 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_NRF_BLUETOOTH_BLE_GATT_CACHE_H
+#define MICROPY_INCLUDED_NRF_BLUETOOTH_BLE_GATT_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Remote GATT tables discovered as a central are kept in the CIRCUITPY_BLE_CONFIG_SIZE bytes of
+// flash reserved below the nvm region, one flash page per peer. A table is only reused when the
+// peer's Database Hash characteristic still has the value it had when the table was stored.
+
+#define BLE_GATT_CACHE_HASH_LENGTH 16
+#define BLE_GATT_CACHE_MAX_SERVICES 24
+#define BLE_GATT_CACHE_MAX_CHARACTERISTICS 160
+
+// Characteristic property bits.
+#define BLE_GATT_CACHE_PROP_BROADCAST         (1 << 0)
+#define BLE_GATT_CACHE_PROP_INDICATE          (1 << 1)
+#define BLE_GATT_CACHE_PROP_NOTIFY            (1 << 2)
+#define BLE_GATT_CACHE_PROP_READ              (1 << 3)
+#define BLE_GATT_CACHE_PROP_WRITE             (1 << 4)
+#define BLE_GATT_CACHE_PROP_WRITE_NO_RESPONSE (1 << 5)
+
+// UUIDs are stored little-endian as encoded by sd_ble_uuid_encode() because the SoftDevice's
+// vendor UUID indices don't survive a reset.
+typedef struct {
+    uint16_t start_handle;
+    uint16_t end_handle;
+    uint8_t uuid_len;
+    uint8_t uuid[16];
+} ble_gatt_cache_service_t;
+
+typedef struct {
+    uint16_t handle_value;
+    uint8_t service_index;
+    uint8_t props;
+    uint8_t uuid_len;
+    uint8_t uuid[16];
+} ble_gatt_cache_characteristic_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    uint8_t address_type;
+    uint8_t address[6];
+    uint8_t hash[BLE_GATT_CACHE_HASH_LENGTH];
+    uint8_t service_count;
+    uint16_t characteristic_count;
+    ble_gatt_cache_service_t services[BLE_GATT_CACHE_MAX_SERVICES];
+    ble_gatt_cache_characteristic_t characteristics[BLE_GATT_CACHE_MAX_CHARACTERISTICS];
+} ble_gatt_cache_t;
+
+// The stored table for the peer, or NULL if there isn't one or its hash differs. The result
+// points into flash.
+const ble_gatt_cache_t *ble_gatt_cache_find(uint8_t address_type, const uint8_t *address, const uint8_t *hash);
+
+// Write table to flash, replacing the peer's earlier table or else the least recently stored one.
+void ble_gatt_cache_store(ble_gatt_cache_t *table);
+
+#endif // MICROPY_INCLUDED_NRF_BLUETOOTH_BLE_GATT_CACHE_H
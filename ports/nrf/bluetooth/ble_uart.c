@@ -29,15 +29,19 @@
 
 #include "ble.h"
 #include "ble_uart.h"
-#include "ringbuffer.h"
+#include "nrf_nvic.h"
+#include "nrf_soc.h"
+#include "py/ringbuf.h"
 #include "py/mphal.h"
 #include "py/runtime.h"
+#include "lib/oofatfs/ff.h"
 #include "lib/utils/interrupt_char.h"
 #include "shared-bindings/bleio/Adapter.h"
 #include "shared-bindings/bleio/Characteristic.h"
 #include "shared-bindings/bleio/Device.h"
 #include "shared-bindings/bleio/Service.h"
 #include "shared-bindings/bleio/UUID.h"
+#include "supervisor/filesystem.h"
 
 #if (MICROPY_PY_BLE_NUS == 1)
 
@@ -46,29 +50,139 @@ static const char NUS_UUID[] = "6e400001-b5a3-f393-e0a9-e50e24dcca9e";
 
 #define NUS_RX_UUID 0x0002
 #define NUS_TX_UUID 0x0003
-#define BUFFER_SIZE 128
-
-ringBuffer_typedef(uint8_t, ringbuffer_t);
+#define FILE_UUID 0x0004
+#define RX_BUFFER_SIZE 1024
+#define TX_BUFFER_SIZE 1024
+#define MAX_PACKET_LEN (BLE_GATT_ATT_MTU_THROUGHPUT - 3)
+
+// Files are written to CIRCUITPY through the file characteristic. Each write to it starts with a
+// command byte:
+//   0x01 <path>  creates or truncates the file at path, such as "/code.py", and opens it
+//   0x02 <data>  appends data to the open file
+//   0x03         closes the file and flushes the filesystem
+// Writes are carried out while the REPL waits for input. The characteristic notifies a status byte
+// and the number of bytes written to the file so far as a little endian uint32 after the file is
+// opened, after every FILESYSTEM_BLOCK_SIZE bytes and after it is closed. The status is 0 when all
+// is well, a FATFS FRESULT when the filesystem fails, or FILE_STATUS_REJECTED when the filesystem
+// can't be written by Python or a write arrived that there was no room for. A failure closes the
+// file. Clients must not have more than FILE_WINDOW bytes beyond the count last notified in flight.
+#define FILE_OPEN 0x01
+#define FILE_DATA 0x02
+#define FILE_CLOSE 0x03
+#define FILE_STATUS_REJECTED 0xff
+#define FILE_WINDOW (4 * FILESYSTEM_BLOCK_SIZE)
+// Room for FILE_WINDOW bytes sent in the smallest writes, each queued with a two byte length.
+#define FILE_QUEUE_SIZE (3 * FILE_WINDOW / 2)
 
 static bleio_device_obj_t m_device;
 static bleio_service_obj_t *m_nus;
 static bleio_characteristic_obj_t *m_tx_chara;
 static bleio_characteristic_obj_t *m_rx_chara;
+static bleio_characteristic_obj_t *m_file_chara;
 
 static volatile bool m_cccd_enabled;
 
-static uint8_t m_rx_ring_buffer_data[BUFFER_SIZE];
-static ringbuffer_t m_rx_ring_buffer = {
-    .size = sizeof(m_rx_ring_buffer_data) + 1,
-    .elems = m_rx_ring_buffer_data,
-};
+static uint8_t m_rx_ring_buffer_data[RX_BUFFER_SIZE];
+static ringbuf_t m_rx_ring_buffer = {m_rx_ring_buffer_data, sizeof(m_rx_ring_buffer_data)};
+
+// Console output waits here until it can be sent in as few notifications as possible.
+static uint8_t m_tx_ring_buffer_data[TX_BUFFER_SIZE];
+static ringbuf_t m_tx_ring_buffer = {m_tx_ring_buffer_data, sizeof(m_tx_ring_buffer_data)};
+static uint8_t m_tx_packet[MAX_PACKET_LEN];
+static uint16_t m_tx_packet_len;
+static bool m_tx_packet_pending;
+// Notifications handed to the SoftDevice that haven't been sent yet.
+static uint8_t m_tx_in_flight;
+
+static uint8_t m_file_queue_data[FILE_QUEUE_SIZE];
+static ringbuf_t m_file_queue = {m_file_queue_data, sizeof(m_file_queue_data)};
+// Set by the event handler for the main context to close the file.
+static volatile bool m_file_overflowed;
+static volatile bool m_file_disconnected;
+static FIL m_file;
+static bool m_file_open;
+static uint32_t m_file_written;
+static uint8_t m_file_block[FILESYSTEM_BLOCK_SIZE];
+static size_t m_file_block_len;
+// Only the latest status matters, so an unsent one is replaced rather than queued.
+static uint8_t m_file_status[5];
+static bool m_file_status_pending;
+
+// Returns false when the SoftDevice's queue is full.
+STATIC bool notify(bleio_characteristic_obj_t *characteristic, uint8_t *data, uint16_t len) {
+    ble_gatts_hvx_params_t hvx_params = {
+        .handle = characteristic->handle,
+        .type = BLE_GATT_HVX_NOTIFICATION,
+        .offset = 0,
+        .p_len = &len,
+        .p_data = data,
+    };
+    const uint32_t err_code = sd_ble_gatts_hvx(m_device.conn_handle, &hvx_params);
+    if (err_code == NRF_ERROR_RESOURCES) {
+        return false;
+    }
+    // Other failures mean the central has disconnected or unsubscribed, so there's no point in
+    // trying again.
+    if (err_code == NRF_SUCCESS) {
+        m_tx_in_flight++;
+    }
+    return true;
+}
+
+// Hand the file status and console output to the SoftDevice until its queue is full. Full packets
+// are sent straight away, but a partial one waits until nothing else is in flight so that small
+// writes, such as echoed characters, are gathered into one notification. Called from the event
+// handler and, with the SoftDevice events locked out, from the main context.
+STATIC void tx_drain(void) {
+    if (m_file_status_pending) {
+        if (!notify(m_file_chara, m_file_status, sizeof(m_file_status))) {
+            return;
+        }
+        m_file_status_pending = false;
+    }
+
+    while (true) {
+        if (!m_tx_packet_pending) {
+            const size_t max_len = MIN(m_device.att_mtu - 3, MAX_PACKET_LEN);
+            const size_t count = ringbuf_count(&m_tx_ring_buffer);
+            if (count == 0 || (count < max_len && m_tx_in_flight > 0)) {
+                return;
+            }
+            m_tx_packet_len = ringbuf_get_n(&m_tx_ring_buffer, m_tx_packet, max_len);
+            m_tx_packet_pending = true;
+        }
+        if (!notify(m_tx_chara, m_tx_packet, m_tx_packet_len)) {
+            // Try again on the next BLE_GATTS_EVT_HVN_TX_COMPLETE.
+            return;
+        }
+        m_tx_packet_pending = false;
+    }
+}
 
 STATIC void on_ble_evt(ble_evt_t *ble_evt, void *param) {
     switch (ble_evt->header.evt_id) {
         case BLE_GAP_EVT_DISCONNECTED:
         {
+            // Output for this connection is dropped, and so is any file being sent.
+            m_cccd_enabled = false;
+            ringbuf_clear(&m_tx_ring_buffer);
+            m_tx_packet_pending = false;
+            m_tx_in_flight = 0;
+            m_file_status_pending = false;
+            ringbuf_clear(&m_file_queue);
+            m_file_disconnected = true;
+
             mp_obj_t device_obj = MP_OBJ_FROM_PTR(&m_device);
-            mp_call_function_0(mp_load_attr(device_obj, qstr_from_str("start_advertising")));
+            mp_call_function_0(mp_load_attr(device_obj, MP_QSTR_start_advertising));
+            break;
+        }
+
+        case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+        {
+            const uint8_t count = ble_evt->evt.gatts_evt.params.hvn_tx_complete.count;
+            // The count includes notifications sent through bleio on the same connection.
+            m_tx_in_flight = count < m_tx_in_flight ? m_tx_in_flight - count : 0;
+            tx_drain();
             break;
         }
 
@@ -77,23 +191,198 @@ STATIC void on_ble_evt(ble_evt_t *ble_evt, void *param) {
             ble_gatts_evt_write_t *write = &ble_evt->evt.gatts_evt.params.write;
 
             if (write->handle == m_tx_chara->cccd_handle) {
-                m_cccd_enabled = true;
+                m_cccd_enabled = write->len > 0 && (write->data[0] & BLE_GATT_HVX_NOTIFICATION);
             } else if (write->handle == m_rx_chara->handle) {
-                for (size_t i = 0; i < write->len; ++i) {
+                // Queue the runs of characters between interrupt characters. The oldest
+                // characters are dropped when the buffer is full.
+                size_t start = 0;
 #if MICROPY_KBD_EXCEPTION
+                for (size_t i = 0; i < write->len; ++i) {
                     if (write->data[i] == mp_interrupt_char) {
+                        ringbuf_put_n_overwrite(&m_rx_ring_buffer, write->data + start, i - start);
                         mp_keyboard_interrupt();
-                    } else
-#endif
-                    {
-                        bufferWrite(&m_rx_ring_buffer, write->data[i]);
+                        start = i + 1;
                     }
                 }
+#endif
+                ringbuf_put_n_overwrite(&m_rx_ring_buffer, write->data + start, write->len - start);
+            } else if (write->handle == m_file_chara->handle && write->len > 0) {
+                // Filesystem calls can't be made here, so the write is queued with its length.
+                if (ringbuf_num_empty(&m_file_queue) >= write->len + 2) {
+                    uint8_t len_bytes[2] = { write->len & 0xff, write->len >> 8 };
+                    ringbuf_put_n(&m_file_queue, len_bytes, 2);
+                    ringbuf_put_n(&m_file_queue, write->data, write->len);
+                } else {
+                    m_file_overflowed = true;
+                }
+            }
+            break;
+        }
+    }
+}
+
+STATIC void file_transfer_set_status(uint8_t status) {
+    if (!ble_uart_connected()) {
+        return;
+    }
+    uint8_t is_nested_critical_region;
+    sd_nvic_critical_region_enter(&is_nested_critical_region);
+
+    m_file_status[0] = status;
+    m_file_status[1] = m_file_written & 0xff;
+    m_file_status[2] = (m_file_written >> 8) & 0xff;
+    m_file_status[3] = (m_file_written >> 16) & 0xff;
+    m_file_status[4] = m_file_written >> 24;
+    m_file_status_pending = true;
+    tx_drain();
+
+    sd_nvic_critical_region_exit(is_nested_critical_region);
+}
+
+STATIC void file_transfer_fail(uint8_t status) {
+    if (m_file_open) {
+        f_close(&m_file);
+        m_file_open = false;
+    }
+    file_transfer_set_status(status);
+}
+
+// Writes out the buffered block, which is only partial at the end of the file.
+STATIC FRESULT file_transfer_write_block(void) {
+    UINT written;
+    FRESULT result = f_write(&m_file, m_file_block, m_file_block_len, &written);
+    if (result == FR_OK && written < m_file_block_len) {
+        // The filesystem is full.
+        result = FR_DENIED;
+    }
+    m_file_written += written;
+    m_file_block_len = 0;
+    return result;
+}
+
+STATIC void file_transfer_open(const char *path) {
+    if (m_file_open) {
+        f_close(&m_file);
+        m_file_open = false;
+    }
+    m_file_written = 0;
+    m_file_block_len = 0;
+
+    fs_user_mount_t *vfs = filesystem_circuitpy();
+    if (vfs == NULL || !filesystem_is_writable_by_python(vfs)) {
+        file_transfer_set_status(FILE_STATUS_REJECTED);
+        return;
+    }
+    FRESULT result = f_open(&vfs->fatfs, &m_file, path, FA_WRITE | FA_CREATE_ALWAYS);
+    m_file_open = result == FR_OK;
+    file_transfer_set_status(result);
+}
+
+STATIC void file_transfer_append(const uint8_t *data, size_t len) {
+    if (!m_file_open) {
+        // The failure has already been reported.
+        return;
+    }
+    while (len > 0) {
+        const size_t n = MIN(len, FILESYSTEM_BLOCK_SIZE - m_file_block_len);
+        memcpy(m_file_block + m_file_block_len, data, n);
+        m_file_block_len += n;
+        data += n;
+        len -= n;
+        if (m_file_block_len == FILESYSTEM_BLOCK_SIZE) {
+            FRESULT result = file_transfer_write_block();
+            if (result != FR_OK) {
+                file_transfer_fail(result);
+                return;
             }
+            file_transfer_set_status(FR_OK);
+        }
+    }
+}
+
+STATIC void file_transfer_close(void) {
+    if (!m_file_open) {
+        file_transfer_set_status(FILE_STATUS_REJECTED);
+        return;
+    }
+    FRESULT result = file_transfer_write_block();
+    FRESULT close_result = f_close(&m_file);
+    m_file_open = false;
+    filesystem_flush();
+    file_transfer_set_status(result != FR_OK ? result : close_result);
+}
+
+// Carries out the queued writes to the file characteristic. Only called while the REPL waits for
+// input, so no Python code is using the filesystem.
+STATIC void file_transfer_task(void) {
+    if (m_file_disconnected) {
+        m_file_disconnected = false;
+        // No one is left to tell.
+        if (m_file_open) {
+            f_close(&m_file);
+            m_file_open = false;
+        }
+    }
+
+    // One more byte so that a path can be terminated.
+    uint8_t data[MAX_PACKET_LEN + 1];
+    while (true) {
+        size_t len = 0;
+        uint8_t is_nested_critical_region;
+        sd_nvic_critical_region_enter(&is_nested_critical_region);
+        // Checked along with taking each write so that none after a dropped one reach the file.
+        const bool overflowed = m_file_overflowed;
+        m_file_overflowed = false;
+        uint8_t len_bytes[2];
+        if (!overflowed && ringbuf_get_n(&m_file_queue, len_bytes, 2) == 2) {
+            len = len_bytes[0] | (len_bytes[1] << 8);
+            ringbuf_get_n(&m_file_queue, data, len);
+        }
+        sd_nvic_critical_region_exit(is_nested_critical_region);
+        if (overflowed) {
+            file_transfer_fail(FILE_STATUS_REJECTED);
+            continue;
+        }
+        if (len == 0) {
+            return;
+        }
+
+        switch (data[0]) {
+            case FILE_OPEN:
+                data[len] = '\0';
+                file_transfer_open((const char *) data + 1);
+                break;
+
+            case FILE_DATA:
+                file_transfer_append(data + 1, len - 1);
+                break;
+
+            case FILE_CLOSE:
+                file_transfer_close();
+                break;
+
+            default:
+                file_transfer_fail(FILE_STATUS_REJECTED);
+                break;
         }
     }
 }
 
+// The characteristics' 16-bit UUIDs are on the NUS base UUID, registered for the service.
+STATIC bleio_characteristic_obj_t *new_characteristic(bleio_uuid_obj_t *nus_uuid, mp_int_t uuid16, bleio_characteristic_properties_t props) {
+    bleio_uuid_obj_t *uuid = MP_OBJ_TO_PTR(mp_call_function_1(MP_OBJ_FROM_PTR(&bleio_uuid_type), mp_obj_new_int(uuid16)));
+    uuid->nrf_ble_uuid.type = nus_uuid->nrf_ble_uuid.type;
+
+    // Large enough for whatever MTU is negotiated.
+    const mp_obj_t args[] = {
+        MP_OBJ_FROM_PTR(uuid),
+        MP_OBJ_NEW_QSTR(MP_QSTR_max_length), MP_OBJ_NEW_SMALL_INT(ble_drv_att_mtu - 3),
+    };
+    bleio_characteristic_obj_t *characteristic = MP_OBJ_TO_PTR(mp_call_function_n_kw(MP_OBJ_FROM_PTR(&bleio_characteristic_type), 1, 1, args));
+    characteristic->props = props;
+    return characteristic;
+}
+
 void ble_uart_init(void) {
     mp_obj_t device_obj = MP_OBJ_FROM_PTR(&m_device);
     m_device.base.type = &bleio_device_type;
@@ -101,38 +390,33 @@ void ble_uart_init(void) {
     m_device.notif_handler = mp_const_none;
     m_device.conn_handler = mp_const_none;
     m_device.conn_handle = 0xFFFF;
+    m_device.att_mtu = BLE_GATT_ATT_MTU_DEFAULT;
     m_device.is_peripheral = true;
-    m_device.name = mp_obj_new_str(default_name, strlen(default_name), false);
+    m_device.name = mp_obj_new_str(default_name, strlen(default_name));
     common_hal_bleio_adapter_get_address(&m_device.address);
 
-    mp_obj_t nus_uuid_str = mp_obj_new_str(NUS_UUID, strlen(NUS_UUID), false);
-    mp_obj_t nus_uuid_obj = bleio_uuid_type.make_new(&bleio_uuid_type, 1, 0, &nus_uuid_str);
-    mp_obj_t nus_obj = bleio_service_type.make_new(&bleio_service_type, 1, 0, &nus_uuid_obj);
+    mp_obj_t nus_uuid_str = mp_obj_new_str(NUS_UUID, strlen(NUS_UUID));
+    mp_obj_t nus_uuid_obj = mp_call_function_1(MP_OBJ_FROM_PTR(&bleio_uuid_type), nus_uuid_str);
+    bleio_uuid_obj_t *nus_uuid = MP_OBJ_TO_PTR(nus_uuid_obj);
+
+    m_tx_chara = new_characteristic(nus_uuid, NUS_TX_UUID,
+        (bleio_characteristic_properties_t) { .notify = true });
+    m_rx_chara = new_characteristic(nus_uuid, NUS_RX_UUID,
+        (bleio_characteristic_properties_t) { .write = true, .write_no_response = true });
+    m_file_chara = new_characteristic(nus_uuid, FILE_UUID,
+        (bleio_characteristic_properties_t) { .write = true, .write_no_response = true, .notify = true });
+
+    mp_obj_t characteristics[] = {
+        MP_OBJ_FROM_PTR(m_tx_chara), MP_OBJ_FROM_PTR(m_rx_chara), MP_OBJ_FROM_PTR(m_file_chara),
+    };
+    mp_obj_t nus_obj = mp_call_function_2(MP_OBJ_FROM_PTR(&bleio_service_type), nus_uuid_obj,
+        mp_obj_new_tuple(MP_ARRAY_SIZE(characteristics), characteristics));
     m_nus = MP_OBJ_TO_PTR(nus_obj);
-    mp_call_function_1(mp_load_attr(device_obj, qstr_from_str("add_service")), nus_obj);
-
-    mp_obj_t tx_uuid_int = mp_obj_new_int(NUS_TX_UUID);
-    mp_obj_t tx_uuid_obj = bleio_uuid_type.make_new(&bleio_uuid_type, 1, 0, &tx_uuid_int);
-    mp_obj_t tx_obj = bleio_characteristic_type.make_new(&bleio_characteristic_type, 1, 0, &tx_uuid_obj);
-    m_tx_chara = MP_OBJ_TO_PTR(tx_obj);
-    m_tx_chara->uuid->type = UUID_TYPE_128BIT;
-    m_tx_chara->uuid->uuid_vs_idx = m_nus->uuid->uuid_vs_idx;
-    m_tx_chara->props.notify = true;
-    mp_call_function_1(mp_load_attr(nus_obj, qstr_from_str("add_characteristic")), tx_obj);
-
-    mp_obj_t rx_uuid_int = mp_obj_new_int(NUS_RX_UUID);
-    mp_obj_t rx_uuid_obj = bleio_uuid_type.make_new(&bleio_uuid_type, 1, 0, &rx_uuid_int);
-    mp_obj_t rx_obj = bleio_characteristic_type.make_new(&bleio_characteristic_type, 1, 0, &rx_uuid_obj);
-    m_rx_chara = MP_OBJ_TO_PTR(rx_obj);
-    m_rx_chara->uuid->type = UUID_TYPE_128BIT;
-    m_rx_chara->uuid->uuid_vs_idx = m_nus->uuid->uuid_vs_idx;
-    m_rx_chara->props.write = true;
-    m_rx_chara->props.write_wo_resp = true;
-    mp_call_function_1(mp_load_attr(nus_obj, qstr_from_str("add_characteristic")), rx_obj);
-
-    mp_call_function_0(mp_load_attr(device_obj, qstr_from_str("start_advertising")));
-
-    ble_drv_add_event_handler(on_ble_evt, &m_device);
+    mp_call_function_1(mp_load_attr(device_obj, MP_QSTR_add_service), nus_obj);
+
+    mp_call_function_0(mp_load_attr(device_obj, MP_QSTR_start_advertising));
+
+    ble_drv_add_filtered_event_handler(on_ble_evt, &m_device, BLE_DRV_EVT_GAP | BLE_DRV_EVT_GATTS, BLE_GATT_HANDLE_INVALID);
 
     m_cccd_enabled = false;
 
@@ -148,19 +432,18 @@ bool ble_uart_connected(void) {
 }
 
 char ble_uart_rx_chr(void) {
-    while (isBufferEmpty(&m_rx_ring_buffer)) {
+    while (ringbuf_count(&m_rx_ring_buffer) == 0) {
+        file_transfer_task();
 #ifdef MICROPY_VM_HOOK_LOOP
     MICROPY_VM_HOOK_LOOP
 #endif
     }
 
-    uint8_t byte;
-    bufferRead(&m_rx_ring_buffer, byte);
-    return (int)byte;
+    return ringbuf_get(&m_rx_ring_buffer);
 }
 
 bool ble_uart_stdin_any(void) {
-    return !isBufferEmpty(&m_rx_ring_buffer);
+    return ringbuf_count(&m_rx_ring_buffer) > 0;
 }
 
 void ble_uart_stdout_tx_str(const char *text) {
@@ -172,24 +455,26 @@ int mp_hal_stdin_rx_chr(void) {
 }
 
 void mp_hal_stdout_tx_strn(const char *str, size_t len) {
-    size_t send_len;
-
     while (len > 0) {
-        if (len >= BLE_GATT_ATT_MTU_DEFAULT - 3) {
-            send_len = (BLE_GATT_ATT_MTU_DEFAULT - 3);
-        } else {
-            send_len = len;
+        // Output is dropped when no one is listening rather than holding up the code printing it.
+        if (!ble_uart_connected() || !m_cccd_enabled) {
+            return;
         }
 
-        mp_buffer_info_t bufinfo = {
-            .buf = (uint8_t*)str,
-            .len = send_len,
-        };
-
-        common_hal_bleio_characteristic_write_value(m_tx_chara, &bufinfo);
+        uint8_t is_nested_critical_region;
+        sd_nvic_critical_region_enter(&is_nested_critical_region);
+        const size_t queued = ringbuf_put_n(&m_tx_ring_buffer, (const uint8_t *) str, len);
+        tx_drain();
+        sd_nvic_critical_region_exit(is_nested_critical_region);
 
-        len -= send_len;
-        str += send_len;
+        len -= queued;
+        str += queued;
+        if (len > 0) {
+            // Wait for BLE_GATTS_EVT_HVN_TX_COMPLETE to make room.
+#ifdef MICROPY_VM_HOOK_LOOP
+    MICROPY_VM_HOOK_LOOP
+#endif
+        }
     }
 }
 
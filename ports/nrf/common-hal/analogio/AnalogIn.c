@@ -27,6 +27,7 @@
 
 #include "common-hal/analogio/AnalogIn.h"
 #include "py/runtime.h"
+#include "shared-bindings/analogio/AnalogIn.h"
 #include "supervisor/shared/translate.h"
 
 #include "nrfx_saadc.h"
@@ -110,3 +111,28 @@ uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t *self) {
 float common_hal_analogio_analogin_get_reference_voltage(analogio_analogin_obj_t *self) {
     return 3.3f;
 }
+
+void common_hal_analogio_analogin_start(analogio_analogin_obj_t* self, uint32_t sample_rate,
+                                        uint32_t buffer_length) {
+    mp_raise_NotImplementedError(translate("Background sampling is not supported"));
+}
+
+void common_hal_analogio_analogin_stop(analogio_analogin_obj_t* self) {
+}
+
+bool common_hal_analogio_analogin_get_sampling(analogio_analogin_obj_t* self) {
+    return false;
+}
+
+uint32_t common_hal_analogio_analogin_get_sample_rate(analogio_analogin_obj_t* self) {
+    return 0;
+}
+
+uint32_t common_hal_analogio_analogin_get_overruns(analogio_analogin_obj_t* self) {
+    return 0;
+}
+
+uint32_t common_hal_analogio_analogin_readinto(analogio_analogin_obj_t* self,
+        uint16_t* output_buffer, uint32_t output_buffer_length) {
+    return 0;
+}
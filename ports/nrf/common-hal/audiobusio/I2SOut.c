@@ -0,0 +1,275 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stdint.h>
+#include "nrf.h"
+
+#include "py/runtime.h"
+#include "common-hal/audiobusio/I2SOut.h"
+#include "shared-bindings/audiobusio/I2SOut.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-module/audioio/__init__.h"
+#include "supervisor/shared/translate.h"
+
+#include "nrf_gpio.h"
+
+// The I2S output uses the first playing_audio slot.
+#define I2SOUT_SLOT (0)
+
+#define MCK_CLOCK_FREQ (32000000)
+// Samples are always sent as 16-bit stereo so there are 32 bit clocks per frame.
+#define MIN_RATIO (32)
+
+typedef struct {
+    uint16_t divisor;
+    uint32_t mckfreq;
+} mck_divisor_t;
+
+// The MCK divisors the peripheral supports. The sample rate is MCK over the ratio.
+STATIC const mck_divisor_t mck_divisors[] = {
+    { 8, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV8 },
+    { 10, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV10 },
+    { 11, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV11 },
+    { 15, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV15 },
+    { 16, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV16 },
+    { 21, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV21 },
+    { 23, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV23 },
+    { 30, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV30 },
+    { 31, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV31 },
+    { 32, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV32 },
+    { 42, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV42 },
+    { 63, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV63 },
+    { 125, I2S_CONFIG_MCKFREQ_MCKFREQ_32MDIV125 },
+};
+
+typedef struct {
+    uint16_t ratio;
+    uint8_t config;
+} ratio_t;
+
+STATIC const ratio_t ratios[] = {
+    { 32, I2S_CONFIG_RATIO_RATIO_32X },
+    { 48, I2S_CONFIG_RATIO_RATIO_48X },
+    { 64, I2S_CONFIG_RATIO_RATIO_64X },
+    { 96, I2S_CONFIG_RATIO_RATIO_96X },
+    { 128, I2S_CONFIG_RATIO_RATIO_128X },
+    { 192, I2S_CONFIG_RATIO_RATIO_192X },
+    { 256, I2S_CONFIG_RATIO_RATIO_256X },
+    { 384, I2S_CONFIG_RATIO_RATIO_384X },
+    { 512, I2S_CONFIG_RATIO_RATIO_512X },
+};
+
+static audiobusio_i2sout_obj_t* active_i2sout;
+
+// The clocks only approximate most sample rates so find the closest one.
+STATIC void choose_clocks(uint32_t sample_rate, uint32_t* mckfreq, uint8_t* ratio) {
+    uint32_t best_error = UINT32_MAX;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(mck_divisors); i++) {
+        for (size_t j = 0; j < MP_ARRAY_SIZE(ratios); j++) {
+            uint32_t rate = MCK_CLOCK_FREQ / mck_divisors[i].divisor / ratios[j].ratio;
+            uint32_t error = rate > sample_rate ? rate - sample_rate : sample_rate - rate;
+            if (error < best_error) {
+                best_error = error;
+                *mckfreq = mck_divisors[i].mckfreq;
+                *ratio = ratios[j].config;
+            }
+        }
+    }
+}
+
+void i2sout_reset(void) {
+    NRF_I2S->TASKS_STOP = 1;
+    NRF_I2S->ENABLE = I2S_ENABLE_ENABLE_Disabled << I2S_ENABLE_ENABLE_Pos;
+    NRF_I2S->PSEL.MCK = 0xFFFFFFFF;
+    NRF_I2S->PSEL.SCK = 0xFFFFFFFF;
+    NRF_I2S->PSEL.LRCK = 0xFFFFFFFF;
+    NRF_I2S->PSEL.SDOUT = 0xFFFFFFFF;
+    NRF_I2S->PSEL.SDIN = 0xFFFFFFFF;
+    active_i2sout = NULL;
+}
+
+void common_hal_audiobusio_i2sout_construct(audiobusio_i2sout_obj_t* self,
+        const mcu_pin_obj_t* bit_clock, const mcu_pin_obj_t* word_select,
+        const mcu_pin_obj_t* data, bool left_justified) {
+    if (active_i2sout != NULL) {
+        mp_raise_msg_varg(&mp_type_RuntimeError, translate("%q in use"), MP_QSTR_I2SOut);
+    }
+    active_i2sout = self;
+
+    self->bit_clock_pin_number = bit_clock->number;
+    self->word_select_pin_number = word_select->number;
+    self->data_pin_number = data->number;
+    claim_pin(bit_clock);
+    claim_pin(word_select);
+    claim_pin(data);
+    self->left_justified = left_justified;
+    self->playing = false;
+    self->stopping = false;
+    audio_dma_init(&self->dma);
+
+    NRF_I2S->PSEL.MCK = 0xFFFFFFFF;
+    NRF_I2S->PSEL.SCK = self->bit_clock_pin_number;
+    NRF_I2S->PSEL.LRCK = self->word_select_pin_number;
+    NRF_I2S->PSEL.SDOUT = self->data_pin_number;
+    NRF_I2S->PSEL.SDIN = 0xFFFFFFFF;
+
+    NRF_I2S->CONFIG.MODE = I2S_CONFIG_MODE_MODE_Master;
+    NRF_I2S->CONFIG.RXEN = I2S_CONFIG_RXEN_RXEN_Disabled;
+    NRF_I2S->CONFIG.TXEN = I2S_CONFIG_TXEN_TXEN_Enabled;
+    NRF_I2S->CONFIG.MCKEN = I2S_CONFIG_MCKEN_MCKEN_Enabled;
+    NRF_I2S->CONFIG.SWIDTH = I2S_CONFIG_SWIDTH_SWIDTH_16Bit;
+    NRF_I2S->CONFIG.ALIGN = I2S_CONFIG_ALIGN_ALIGN_Left;
+    if (left_justified) {
+        NRF_I2S->CONFIG.FORMAT = I2S_CONFIG_FORMAT_FORMAT_Aligned;
+    } else {
+        NRF_I2S->CONFIG.FORMAT = I2S_CONFIG_FORMAT_FORMAT_I2S;
+    }
+    NRF_I2S->CONFIG.CHANNELS = I2S_CONFIG_CHANNELS_CHANNELS_Stereo;
+}
+
+bool common_hal_audiobusio_i2sout_deinited(audiobusio_i2sout_obj_t* self) {
+    return self->data_pin_number == NO_PIN;
+}
+
+void common_hal_audiobusio_i2sout_deinit(audiobusio_i2sout_obj_t* self) {
+    if (common_hal_audiobusio_i2sout_deinited(self)) {
+        return;
+    }
+    common_hal_audiobusio_i2sout_stop(self);
+    i2sout_reset();
+
+    reset_pin_number(self->bit_clock_pin_number);
+    self->bit_clock_pin_number = NO_PIN;
+    reset_pin_number(self->word_select_pin_number);
+    self->word_select_pin_number = NO_PIN;
+    reset_pin_number(self->data_pin_number);
+    self->data_pin_number = NO_PIN;
+}
+
+void common_hal_audiobusio_i2sout_play(audiobusio_i2sout_obj_t* self,
+                                       mp_obj_t sample, bool loop) {
+    if (self->playing) {
+        common_hal_audiobusio_i2sout_stop(self);
+    }
+    if (audiosample_channel_count(sample) > 2) {
+        mp_raise_ValueError(translate("Too many channels in sample."));
+    }
+
+    uint32_t mckfreq;
+    uint8_t ratio;
+    choose_clocks(audiosample_sample_rate(sample), &mckfreq, &ratio);
+    NRF_I2S->CONFIG.MCKFREQ = mckfreq;
+    NRF_I2S->CONFIG.RATIO = ratio;
+
+    audio_dma_result result = audio_dma_setup_playback(&self->dma, sample, loop, 2, 0, 0, 0,
+                                                       I2SOUT_SLOT, self);
+    if (result == AUDIO_DMA_DMA_BUSY) {
+        common_hal_audiobusio_i2sout_stop(self);
+        mp_raise_RuntimeError(translate("No DMA channel found"));
+    } else if (result == AUDIO_DMA_MEMORY_ERROR) {
+        common_hal_audiobusio_i2sout_stop(self);
+        mp_raise_RuntimeError(translate("Unable to allocate buffers for signed conversion"));
+    }
+
+    // TXD.PTR is double buffered. TXPTRUPD means the peripheral has taken the last pointer we
+    // gave it, so the buffer before that one is free again.
+    NRF_I2S->TXD.PTR = (uint32_t) self->dma.buffer[0];
+    NRF_I2S->RXTXD.MAXCNT = self->dma.buffer_length / 2;
+    self->next_buffer = 1;
+    self->next_buffer_filled = true;
+    self->stopping = false;
+    self->playing = true;
+    NRF_I2S->EVENTS_TXPTRUPD = 0;
+    NRF_I2S->EVENTS_STOPPED = 0;
+    NRF_I2S->ENABLE = I2S_ENABLE_ENABLE_Enabled << I2S_ENABLE_ENABLE_Pos;
+    NRF_I2S->TASKS_START = 1;
+}
+
+void common_hal_audiobusio_i2sout_pause(audiobusio_i2sout_obj_t* self) {
+    audio_dma_pause(&self->dma);
+}
+
+void common_hal_audiobusio_i2sout_resume(audiobusio_i2sout_obj_t* self) {
+    audio_dma_resume(&self->dma);
+}
+
+bool common_hal_audiobusio_i2sout_get_paused(audiobusio_i2sout_obj_t* self) {
+    return self->playing && audio_dma_get_paused(&self->dma);
+}
+
+uint32_t common_hal_audiobusio_i2sout_get_underruns(audiobusio_i2sout_obj_t* self) {
+    return audio_dma_get_underruns(&self->dma);
+}
+
+int32_t common_hal_audiobusio_i2sout_get_min_slack_us(audiobusio_i2sout_obj_t* self) {
+    return audio_dma_get_min_slack_us(&self->dma);
+}
+
+void common_hal_audiobusio_i2sout_stop(audiobusio_i2sout_obj_t* self) {
+    if (!self->playing) {
+        return;
+    }
+    NRF_I2S->TASKS_STOP = 1;
+    NRF_I2S->ENABLE = I2S_ENABLE_ENABLE_Disabled << I2S_ENABLE_ENABLE_Pos;
+    self->playing = false;
+    self->stopping = false;
+    audio_dma_stop(&self->dma);
+}
+
+bool common_hal_audiobusio_i2sout_get_playing(audiobusio_i2sout_obj_t* self) {
+    return self->playing;
+}
+
+// WARN(tannewt): DO NOT print from here. Printing calls background tasks such as this and causes a
+// stack overflow.
+
+void i2sout_background(void) {
+    audiobusio_i2sout_obj_t* self = active_i2sout;
+    if (self == NULL || !self->playing) {
+        return;
+    }
+    if (NRF_I2S->EVENTS_TXPTRUPD == 0) {
+        audio_dma_idle(&self->dma);
+        // Let the sample read ahead while the peripheral is busy with the current buffer.
+        audiosample_background(self->dma.sample);
+        return;
+    }
+    NRF_I2S->EVENTS_TXPTRUPD = 0;
+    if (self->stopping) {
+        // The buffer with the last of the sample has played.
+        common_hal_audiobusio_i2sout_stop(self);
+        return;
+    }
+    // Refill the buffer the peripheral just finished, unless it's the second one filled at the
+    // start. Stop once the peripheral has moved past the last buffer with data in it.
+    if (!self->next_buffer_filled && !audio_dma_fill_buffer(&self->dma, self->next_buffer)) {
+        self->stopping = true;
+    }
+    self->next_buffer_filled = false;
+    NRF_I2S->TXD.PTR = (uint32_t) self->dma.buffer[self->next_buffer];
+    self->next_buffer = 1 - self->next_buffer;
+}
@@ -0,0 +1,280 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stdint.h>
+#include "nrf.h"
+
+#include "py/runtime.h"
+#include "common-hal/audioio/AudioOut.h"
+#include "common-hal/pulseio/PWMOut.h"
+#include "shared-bindings/audioio/AudioOut.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-module/audioio/__init__.h"
+#include "supervisor/shared/translate.h"
+
+#include "nrf_gpio.h"
+
+#define PWM_CLOCK_FREQ (16000000)
+
+// Each sample is repeated so that the PWM frequency is at least this, well above hearing.
+#define MIN_PWM_FREQ (62500)
+// The smallest COUNTERTOP leaves five bits of resolution.
+#define MIN_COUNTERTOP (32)
+
+// The I2S output uses the first playing_audio slot.
+#define FIRST_AUDIOOUT_SLOT (1)
+#define AUDIOOUT_COUNT (AUDIO_DMA_CHANNEL_COUNT - FIRST_AUDIOOUT_SLOT)
+
+static audioio_audioout_obj_t* active_audioouts[AUDIOOUT_COUNT];
+
+static void hold_quiescent(audioio_audioout_obj_t* self) {
+    NRF_PWM_Type* pwm = self->pwm;
+    uint16_t duty = ((uint32_t) self->quiescent_value * pwm->COUNTERTOP / 0xffff) | (1 << 15);
+    self->quiescent_duty[0] = duty;
+    self->quiescent_duty[1] = duty;
+
+    // The PWM keeps outputting the last value of a sequence once it ends.
+    pwm->SHORTS = 0;
+    pwm->LOOP = 0;
+    pwm->SEQ[0].PTR = (uint32_t) self->quiescent_duty;
+    pwm->SEQ[0].CNT = self->right_channel_number == NO_PIN ? 1 : 2;
+    pwm->SEQ[0].REFRESH = 0;
+    pwm->SEQ[0].ENDDELAY = 0;
+    pwm->EVENTS_SEQEND[0] = 0;
+    pwm->EVENTS_SEQEND[1] = 0;
+    pwm->TASKS_SEQSTART[0] = 1;
+}
+
+static void disconnect_pins(NRF_PWM_Type* pwm) {
+    pwm->TASKS_STOP = 1;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(pwm->PSEL.OUT); i++) {
+        pwm->PSEL.OUT[i] = 0xFFFFFFFF;
+    }
+}
+
+void audioout_reset(void) {
+    for (size_t i = 0; i < AUDIOOUT_COUNT; i++) {
+        if (active_audioouts[i] != NULL) {
+            disconnect_pins(active_audioouts[i]->pwm);
+        }
+        active_audioouts[i] = NULL;
+    }
+}
+
+void common_hal_audioio_audioout_construct(audioio_audioout_obj_t* self,
+        const mcu_pin_obj_t* left_channel, const mcu_pin_obj_t* right_channel,
+        uint16_t quiescent_value) {
+    if (left_channel == right_channel) {
+        mp_raise_ValueError(translate("Cannot output both channels on the same pin"));
+    }
+
+    self->slot = AUDIOOUT_COUNT;
+    for (size_t i = 0; i < AUDIOOUT_COUNT; i++) {
+        if (active_audioouts[i] == NULL) {
+            self->slot = i;
+            break;
+        }
+    }
+    NRF_PWM_Type* pwm = NULL;
+    if (self->slot < AUDIOOUT_COUNT) {
+        pwm = pwmout_allocate_exclusive();
+    }
+    if (pwm == NULL) {
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+    active_audioouts[self->slot] = self;
+    self->pwm = pwm;
+    audio_dma_init(&self->dma);
+    self->playing = false;
+    self->stopping = false;
+    self->quiescent_value = quiescent_value;
+
+    self->left_channel_number = left_channel->number;
+    claim_pin(left_channel);
+    nrf_gpio_cfg_output(self->left_channel_number);
+    self->right_channel_number = NO_PIN;
+    if (right_channel != NULL) {
+        self->right_channel_number = right_channel->number;
+        claim_pin(right_channel);
+        nrf_gpio_cfg_output(self->right_channel_number);
+    }
+
+    // Mono uses one value for every channel. Stereo uses one value for channels 0 and 1 and the
+    // next for channels 2 and 3.
+    pwm->PRESCALER = PWM_PRESCALER_PRESCALER_DIV_1;
+    pwm->COUNTERTOP = PWM_CLOCK_FREQ / MIN_PWM_FREQ;
+    pwm->MODE = PWM_MODE_UPDOWN_Up;
+    if (right_channel == NULL) {
+        pwm->DECODER = PWM_DECODER_LOAD_Common | PWM_DECODER_MODE_RefreshCount;
+    } else {
+        pwm->DECODER = PWM_DECODER_LOAD_Grouped | PWM_DECODER_MODE_RefreshCount;
+    }
+    pwm->PSEL.OUT[0] = self->left_channel_number;
+    if (right_channel != NULL) {
+        pwm->PSEL.OUT[2] = self->right_channel_number;
+    }
+    pwm->ENABLE = PWM_ENABLE_ENABLE_Enabled << PWM_ENABLE_ENABLE_Pos;
+    hold_quiescent(self);
+}
+
+bool common_hal_audioio_audioout_deinited(audioio_audioout_obj_t* self) {
+    return self->pwm == NULL;
+}
+
+void common_hal_audioio_audioout_deinit(audioio_audioout_obj_t* self) {
+    if (common_hal_audioio_audioout_deinited(self)) {
+        return;
+    }
+    common_hal_audioio_audioout_stop(self);
+
+    disconnect_pins(self->pwm);
+    pwmout_free_exclusive(self->pwm);
+    self->pwm = NULL;
+    active_audioouts[self->slot] = NULL;
+
+    reset_pin_number(self->left_channel_number);
+    self->left_channel_number = NO_PIN;
+    reset_pin_number(self->right_channel_number);
+    self->right_channel_number = NO_PIN;
+}
+
+void common_hal_audioio_audioout_play(audioio_audioout_obj_t* self,
+                                      mp_obj_t sample, bool loop) {
+    if (self->playing) {
+        common_hal_audioio_audioout_stop(self);
+    }
+    if (audiosample_channel_count(sample) > 2) {
+        mp_raise_ValueError(translate("Too many channels in sample."));
+    }
+    uint32_t sample_rate = audiosample_sample_rate(sample);
+    uint32_t max_sample_rate = PWM_CLOCK_FREQ / MIN_COUNTERTOP;
+    if (sample_rate == 0 || sample_rate > max_sample_rate) {
+        mp_raise_ValueError_varg(translate("Sample rate too high. It must be less than %d"),
+                                 max_sample_rate);
+    }
+    uint32_t repeats = (MIN_PWM_FREQ + sample_rate - 1) / sample_rate;
+    uint16_t countertop = PWM_CLOCK_FREQ / (sample_rate * repeats);
+
+    NRF_PWM_Type* pwm = self->pwm;
+    pwm->SHORTS = 0;
+    pwm->COUNTERTOP = countertop;
+    uint8_t output_channel_count = self->right_channel_number == NO_PIN ? 1 : 2;
+    uint16_t quiescent_duty = ((uint32_t) self->quiescent_value * countertop / 0xffff) | (1 << 15);
+    audio_dma_result result = audio_dma_setup_playback(&self->dma, sample, loop,
+        output_channel_count, countertop, 1 << 15, quiescent_duty,
+        FIRST_AUDIOOUT_SLOT + self->slot, self);
+    if (result != AUDIO_DMA_OK) {
+        audio_dma_stop(&self->dma);
+        hold_quiescent(self);
+        if (result == AUDIO_DMA_DMA_BUSY) {
+            mp_raise_RuntimeError(translate("No DMA channel found"));
+        } else if (result == AUDIO_DMA_MEMORY_ERROR) {
+            mp_raise_RuntimeError(translate("Unable to allocate buffers for signed conversion"));
+        }
+    }
+
+    // Each loop plays sequence 0 and then 1, and the short starts the next loop. The background
+    // refills each buffer once its sequence ends.
+    for (uint8_t i = 0; i < 2; i++) {
+        pwm->SEQ[i].PTR = (uint32_t) self->dma.buffer[i];
+        pwm->SEQ[i].CNT = self->dma.buffer_length;
+        pwm->SEQ[i].REFRESH = repeats - 1;
+        pwm->SEQ[i].ENDDELAY = 0;
+        pwm->EVENTS_SEQEND[i] = 0;
+    }
+    pwm->LOOP = 1;
+    pwm->SHORTS = PWM_SHORTS_LOOPSDONE_SEQSTART0_Msk;
+    self->stopping = false;
+    self->playing = true;
+    pwm->TASKS_SEQSTART[0] = 1;
+}
+
+void common_hal_audioio_audioout_stop(audioio_audioout_obj_t* self) {
+    if (!self->playing) {
+        return;
+    }
+    self->playing = false;
+    self->stopping = false;
+    audio_dma_stop(&self->dma);
+    hold_quiescent(self);
+}
+
+bool common_hal_audioio_audioout_get_playing(audioio_audioout_obj_t* self) {
+    return self->playing;
+}
+
+void common_hal_audioio_audioout_pause(audioio_audioout_obj_t* self) {
+    audio_dma_pause(&self->dma);
+}
+
+void common_hal_audioio_audioout_resume(audioio_audioout_obj_t* self) {
+    audio_dma_resume(&self->dma);
+}
+
+bool common_hal_audioio_audioout_get_paused(audioio_audioout_obj_t* self) {
+    return self->playing && audio_dma_get_paused(&self->dma);
+}
+
+uint32_t common_hal_audioio_audioout_get_underruns(audioio_audioout_obj_t* self) {
+    return audio_dma_get_underruns(&self->dma);
+}
+
+int32_t common_hal_audioio_audioout_get_min_slack_us(audioio_audioout_obj_t* self) {
+    return audio_dma_get_min_slack_us(&self->dma);
+}
+
+// WARN(tannewt): DO NOT print from here. Printing calls background tasks such as this and causes a
+// stack overflow.
+
+void audioout_background(void) {
+    for (size_t i = 0; i < AUDIOOUT_COUNT; i++) {
+        audioio_audioout_obj_t* self = active_audioouts[i];
+        if (self == NULL || !self->playing) {
+            continue;
+        }
+        NRF_PWM_Type* pwm = self->pwm;
+        bool sequence_done = false;
+        for (uint8_t seq = 0; seq < 2 && self->playing; seq++) {
+            if (pwm->EVENTS_SEQEND[seq] == 0) {
+                continue;
+            }
+            sequence_done = true;
+            pwm->EVENTS_SEQEND[seq] = 0;
+            if (self->stopping) {
+                // The other sequence had the last of the sample and has now played.
+                common_hal_audioio_audioout_stop(self);
+            } else if (!audio_dma_fill_buffer(&self->dma, seq)) {
+                self->stopping = true;
+            }
+        }
+        if (!sequence_done && self->playing) {
+            audio_dma_idle(&self->dma);
+            // Let the sample read ahead while the PWM is busy with the current buffer.
+            audiosample_background(self->dma.sample);
+        }
+    }
+}
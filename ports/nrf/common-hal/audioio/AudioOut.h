@@ -0,0 +1,55 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_NRF_COMMON_HAL_AUDIOIO_AUDIOOUT_H
+#define MICROPY_INCLUDED_NRF_COMMON_HAL_AUDIOIO_AUDIOOUT_H
+
+#include "nrf.h"
+
+#include "audio_dma.h"
+#include "py/obj.h"
+
+// There is no DAC so audio is output as PWM at a high enough frequency to be filtered out.
+typedef struct {
+    mp_obj_base_t base;
+    NRF_PWM_Type* pwm;
+    uint8_t left_channel_number;
+    uint8_t right_channel_number;
+    uint8_t slot;
+    bool playing;
+    bool stopping;
+    uint16_t quiescent_value;
+    // PWM values output while nothing is playing.
+    uint16_t quiescent_duty[2];
+    audio_dma_t dma;
+} audioio_audioout_obj_t;
+
+void audioout_reset(void);
+
+void audioout_background(void);
+
+#endif // MICROPY_INCLUDED_NRF_COMMON_HAL_AUDIOIO_AUDIOOUT_H
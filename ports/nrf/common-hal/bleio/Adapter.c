@@ -43,34 +43,27 @@ STATIC void softdevice_assert_handler(uint32_t id, uint32_t pc, uint32_t info) {
                       translate("Soft device assert, id: 0x%08lX, pc: 0x%08lX"), id, pc);
 }
 
-STATIC uint32_t ble_stack_enable(void) {
-    nrf_clock_lf_cfg_t clock_config = {
-        .source = NRF_CLOCK_LF_SRC_XTAL,
-        .accuracy = NRF_CLOCK_LF_ACCURACY_20_PPM
-    };
-
-    uint32_t err_code = sd_softdevice_enable(&clock_config, softdevice_assert_handler);
-    if (err_code != NRF_SUCCESS)
-        return err_code;
-
-    err_code = sd_nvic_EnableIRQ(SD_EVT_IRQn);
-    if (err_code != NRF_SUCCESS)
-        return err_code;
-
-    // Start with no event handlers, etc.
-    ble_drv_reset();
-
+STATIC uint32_t ble_stack_configure(uint16_t att_mtu, uint16_t event_length) {
+    uint32_t err_code;
     uint32_t app_ram_start;
     app_ram_start = 0x20004000;
 
     ble_cfg_t ble_conf;
+    memset(&ble_conf, 0, sizeof(ble_conf));
     ble_conf.conn_cfg.conn_cfg_tag = BLE_CONN_CFG_TAG_CUSTOM;
     ble_conf.conn_cfg.params.gap_conn_cfg.conn_count = BLE_GAP_CONN_COUNT_DEFAULT;
-    ble_conf.conn_cfg.params.gap_conn_cfg.event_length = BLE_GAP_EVENT_LENGTH_DEFAULT;
+    ble_conf.conn_cfg.params.gap_conn_cfg.event_length = event_length;
     err_code = sd_ble_cfg_set(BLE_CONN_CFG_GAP, &ble_conf, app_ram_start);
     if (err_code != NRF_SUCCESS)
         return err_code;
 
+    memset(&ble_conf, 0, sizeof(ble_conf));
+    ble_conf.conn_cfg.conn_cfg_tag = BLE_CONN_CFG_TAG_CUSTOM;
+    ble_conf.conn_cfg.params.gatt_conn_cfg.att_mtu = att_mtu;
+    err_code = sd_ble_cfg_set(BLE_CONN_CFG_GATT, &ble_conf, app_ram_start);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
     memset(&ble_conf, 0, sizeof(ble_conf));
     ble_conf.gap_cfg.role_count_cfg.periph_role_count = 1;
     ble_conf.gap_cfg.role_count_cfg.central_role_count = 1;
@@ -86,10 +79,45 @@ STATIC uint32_t ble_stack_enable(void) {
         return err_code;
 
     err_code = sd_ble_enable(&app_ram_start);
+    if (err_code == NRF_SUCCESS) {
+        ble_drv_att_mtu = att_mtu;
+    }
 
     return err_code;
 }
 
+STATIC uint32_t ble_stack_enable(void) {
+    nrf_clock_lf_cfg_t clock_config = {
+        .source = NRF_CLOCK_LF_SRC_XTAL,
+        .accuracy = NRF_CLOCK_LF_ACCURACY_20_PPM
+    };
+
+    uint32_t err_code = sd_softdevice_enable(&clock_config, softdevice_assert_handler);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    err_code = sd_nvic_EnableIRQ(SD_EVT_IRQn);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    // Start with no event handlers, etc.
+    ble_drv_reset();
+
+    err_code = ble_stack_configure(BLE_GATT_ATT_MTU_THROUGHPUT, BLE_GAP_EVENT_LENGTH_THROUGHPUT);
+    if (err_code == NRF_ERROR_NO_MEM) {
+        // The larger buffers don't fit in the RAM reserved for the SoftDevice.
+        err_code = ble_stack_configure(BLE_GATT_ATT_MTU_DEFAULT, BLE_GAP_EVENT_LENGTH_DEFAULT);
+    }
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    // Let connection events run past their configured length while there is data to send.
+    ble_opt_t opt;
+    memset(&opt, 0, sizeof(opt));
+    opt.common_opt.conn_evt_ext.enable = 1;
+    return sd_ble_opt_set(BLE_COMMON_OPT_CONN_EVT_EXT, &opt);
+}
+
 void common_hal_bleio_adapter_set_enabled(bool enabled) {
     const bool is_enabled = common_hal_bleio_adapter_get_enabled();
 
@@ -29,17 +29,21 @@
 
 #include "ble_drv.h"
 #include "ble_gatts.h"
+#include "nrf_nvic.h"
 #include "nrf_soc.h"
 
+#include "py/gc.h"
 #include "py/runtime.h"
 #include "common-hal/bleio/__init__.h"
 #include "common-hal/bleio/Characteristic.h"
 #include "shared-module/bleio/Characteristic.h"
 
+// Notifications queued per characteristic by queue_notification().
+#define NOTIFY_QUEUE_PACKETS (2 * MAX_TX_IN_PROGRESS)
+
 STATIC volatile bleio_characteristic_obj_t *m_read_characteristic;
-STATIC volatile uint8_t m_tx_in_progress;
 // Serialize gattc writes that send a response. This might be done per object?
-STATIC nrf_mutex_t *m_write_mutex;
+STATIC volatile bool m_write_in_progress;
 
 STATIC uint16_t get_cccd(bleio_characteristic_obj_t *characteristic) {
     const uint16_t conn_handle = common_hal_bleio_device_get_conn_handle(characteristic->service->device);
@@ -118,20 +122,57 @@ STATIC void gatts_notify_indicate(bleio_characteristic_obj_t *characteristic, mp
         .p_data = bufinfo->buf,
     };
 
-    while (m_tx_in_progress >= MAX_TX_IN_PROGRESS) {
+    const uint16_t conn_handle = common_hal_bleio_device_get_conn_handle(characteristic->service->device);
+    uint32_t err_code;
+    // RESOURCES means the SoftDevice's notification queue is full and BUSY means an
+    // indication is still waiting to be confirmed. Both clear as packets go out.
+    while (true) {
+        err_code = sd_ble_gatts_hvx(conn_handle, &hvx_params);
+        if (err_code != NRF_ERROR_RESOURCES && err_code != NRF_ERROR_BUSY) {
+            break;
+        }
+        hvx_len = bufinfo->len;
 #ifdef MICROPY_VM_HOOK_LOOP
     MICROPY_VM_HOOK_LOOP
 #endif
     }
-
-    const uint16_t conn_handle = common_hal_bleio_device_get_conn_handle(characteristic->service->device);
-    m_tx_in_progress++;
-    const uint32_t err_code = sd_ble_gatts_hvx(conn_handle, &hvx_params);
     if (err_code != NRF_SUCCESS) {
-        m_tx_in_progress--;
         mp_raise_OSError_msg_varg(translate("Failed to notify or indicate attribute value, err 0x%04x"), err_code);
     }
+}
+
+// Hand queued notifications to the SoftDevice until its queue is full. Called from the
+// event handler and, with the SoftDevice events locked out, from queue_notification().
+STATIC void notify_queue_drain(bleio_characteristic_obj_t *characteristic) {
+    const uint16_t conn_handle = common_hal_bleio_device_get_conn_handle(characteristic->service->device);
+
+    while (true) {
+        if (!characteristic->notify_packet_pending) {
+            uint8_t len_bytes[2];
+            if (ringbuf_get_n(&characteristic->notify_queue, len_bytes, 2) < 2) {
+                return;
+            }
+            characteristic->notify_packet_len = len_bytes[0] | (len_bytes[1] << 8);
+            ringbuf_get_n(&characteristic->notify_queue, characteristic->notify_packet, characteristic->notify_packet_len);
+            characteristic->notify_packet_pending = true;
+        }
 
+        uint16_t hvx_len = characteristic->notify_packet_len;
+        ble_gatts_hvx_params_t hvx_params = {
+            .handle = characteristic->handle,
+            .type = BLE_GATT_HVX_NOTIFICATION,
+            .offset = 0,
+            .p_len = &hvx_len,
+            .p_data = characteristic->notify_packet,
+        };
+        if (sd_ble_gatts_hvx(conn_handle, &hvx_params) == NRF_ERROR_RESOURCES) {
+            // Try again on the next BLE_GATTS_EVT_HVN_TX_COMPLETE.
+            return;
+        }
+        // Sent, or it can't be sent because the central has disconnected or unsubscribed.
+        // Either way it's done with.
+        characteristic->notify_packet_pending = false;
+    }
 }
 
 STATIC void gattc_read(bleio_characteristic_obj_t *characteristic) {
@@ -167,46 +208,57 @@ STATIC void gattc_write(bleio_characteristic_obj_t *characteristic, mp_buffer_in
     if (characteristic->props.write_no_response) {
         write_params.write_op = BLE_GATT_OP_WRITE_CMD;
 
-        err_code = sd_mutex_acquire(m_write_mutex);
+        // Write commands are queued by the SoftDevice, so only wait when its queue is full.
+        while ((err_code = sd_ble_gattc_write(conn_handle, &write_params)) == NRF_ERROR_RESOURCES) {
+#ifdef MICROPY_VM_HOOK_LOOP
+    MICROPY_VM_HOOK_LOOP
+#endif
+        }
         if (err_code != NRF_SUCCESS) {
-            mp_raise_OSError_msg_varg(translate("Failed to acquire mutex, err 0x%04x"), err_code);
+            mp_raise_OSError_msg_varg(translate("Failed to write attribute value, err 0x%04x"), err_code);
         }
+        return;
+    }
+
+    // Only one write request can be outstanding; wait for the previous one's response.
+    while (m_write_in_progress) {
+#ifdef MICROPY_VM_HOOK_LOOP
+    MICROPY_VM_HOOK_LOOP
+#endif
     }
 
+    m_write_in_progress = true;
     err_code = sd_ble_gattc_write(conn_handle, &write_params);
     if (err_code != NRF_SUCCESS) {
+        m_write_in_progress = false;
         mp_raise_OSError_msg_varg(translate("Failed to write attribute value, err 0x%04x"), err_code);
     }
 
-    while (sd_mutex_acquire(m_write_mutex) == NRF_ERROR_SOC_MUTEX_ALREADY_TAKEN) {
+    while (m_write_in_progress) {
 #ifdef MICROPY_VM_HOOK_LOOP
     MICROPY_VM_HOOK_LOOP
 #endif
     }
-
-    err_code = sd_mutex_release(m_write_mutex);
-    if (err_code != NRF_SUCCESS) {
-        mp_raise_OSError_msg_varg(translate("Failed to release mutex, err 0x%04x"), err_code);
-    }
 }
 
 STATIC void characteristic_on_ble_evt(ble_evt_t *ble_evt, void *param) {
+    bleio_characteristic_obj_t *characteristic = (bleio_characteristic_obj_t *) param;
+
     switch (ble_evt->header.evt_id) {
     case BLE_GATTS_EVT_HVN_TX_COMPLETE:
-    {
-        uint8_t count = ble_evt->evt.gatts_evt.params.hvn_tx_complete.count;
-        // Don't underflow the count.
-        if (count >= m_tx_in_progress) {
-            m_tx_in_progress = 0;
-        } else {
-            m_tx_in_progress -= count;
+        // Room has been made in the SoftDevice's queue.
+        if (characteristic->notify_queue.buf != NULL) {
+            notify_queue_drain(characteristic);
         }
         break;
-    }
 
     case BLE_GATTC_EVT_READ_RSP:
     {
         ble_gattc_evt_read_rsp_t *response = &ble_evt->evt.gattc_evt.params.read_rsp;
+        // Every characteristic's handler sees the response; only the first one stores it.
+        if (m_read_characteristic == NULL) {
+            break;
+        }
         m_read_characteristic->value_data = mp_obj_new_bytearray(response->len, response->data);
         // Flag to busy-wait loop that we've read the characteristic.
         m_read_characteristic = NULL;
@@ -215,7 +267,7 @@ STATIC void characteristic_on_ble_evt(ble_evt_t *ble_evt, void *param) {
 
     case BLE_GATTC_EVT_WRITE_RSP:
         // Someone else can write now.
-        sd_mutex_release(m_write_mutex);
+        m_write_in_progress = false;
         break;
 
         // For debugging.
@@ -226,14 +278,18 @@ STATIC void characteristic_on_ble_evt(ble_evt_t *ble_evt, void *param) {
 
 }
 
-void common_hal_bleio_characteristic_construct(bleio_characteristic_obj_t *self, bleio_uuid_obj_t *uuid, bleio_characteristic_properties_t props) {
+void common_hal_bleio_characteristic_construct(bleio_characteristic_obj_t *self, bleio_uuid_obj_t *uuid, bleio_characteristic_properties_t props, uint16_t max_length) {
     self->service = NULL;
     self->uuid = uuid;
     self->value_data = NULL;
     self->props = props;
+    self->max_length = max_length;
     self->handle = BLE_GATT_HANDLE_INVALID;
+    self->notify_queue.buf = NULL;
+    self->notify_packet = NULL;
+    self->notify_packet_pending = false;
 
-    ble_drv_add_event_handler(characteristic_on_ble_evt, self);
+    ble_drv_add_filtered_event_handler(characteristic_on_ble_evt, self, BLE_DRV_EVT_GATTC | BLE_DRV_EVT_GATTS, BLE_GATT_HANDLE_INVALID);
 
 }
 
@@ -285,3 +341,41 @@ void common_hal_bleio_characteristic_set_value(bleio_characteristic_obj_t *self,
         break;
     }
 }
+
+bool common_hal_bleio_characteristic_queue_notification(bleio_characteristic_obj_t *self, mp_buffer_info_t *bufinfo) {
+    if (common_hal_bleio_device_get_gatt_role(self->service->device) != GATT_ROLE_SERVER ||
+        !self->props.notify) {
+        mp_raise_ValueError(translate("Characteristic does not notify"));
+    }
+    if (bufinfo->len > self->max_length) {
+        mp_raise_ValueError(translate("Value length > max_length"));
+    }
+
+    if (!(get_cccd(self) & BLE_GATT_HVX_NOTIFICATION)) {
+        // No one is listening, so just update the local value, as setting value would.
+        gatts_write(self, bufinfo);
+        return true;
+    }
+
+    if (self->notify_queue.buf == NULL) {
+        // true means long-lived, so it won't be moved.
+        ringbuf_alloc(&self->notify_queue, NOTIFY_QUEUE_PACKETS * (self->max_length + 2) + 1, true);
+        self->notify_packet = gc_alloc(self->max_length, false, true);
+    }
+
+    // Lock out the event handler, which also drains the queue.
+    uint8_t is_nested_critical_region;
+    sd_nvic_critical_region_enter(&is_nested_critical_region);
+
+    const bool queued = ringbuf_num_empty(&self->notify_queue) >= bufinfo->len + 2;
+    if (queued) {
+        const uint8_t len_bytes[2] = { bufinfo->len & 0xff, bufinfo->len >> 8 };
+        ringbuf_put_n(&self->notify_queue, len_bytes, 2);
+        ringbuf_put_n(&self->notify_queue, bufinfo->buf, bufinfo->len);
+        notify_queue_drain(self);
+    }
+
+    sd_nvic_critical_region_exit(is_nested_critical_region);
+
+    return queued;
+}
@@ -27,6 +27,7 @@
 #ifndef MICROPY_INCLUDED_COMMON_HAL_BLEIO_CHARACTERISTIC_H
 #define MICROPY_INCLUDED_COMMON_HAL_BLEIO_CHARACTERISTIC_H
 
+#include "py/ringbuf.h"
 #include "shared-module/bleio/Characteristic.h"
 #include "shared-module/bleio/Service.h"
 #include "common-hal/bleio/UUID.h"
@@ -38,9 +39,16 @@ typedef struct {
     mp_obj_t value_data;
     uint16_t handle;
     bleio_characteristic_properties_t props;
+    uint16_t max_length;
     uint16_t user_desc_handle;
     uint16_t cccd_handle;
     uint16_t sccd_handle;
+    // Queued notifications, each stored as a two byte length followed by the value. The
+    // oldest one is moved to notify_packet until the SoftDevice accepts it.
+    ringbuf_t notify_queue;
+    uint8_t *notify_packet;
+    uint16_t notify_packet_len;
+    bool notify_packet_pending;
 } bleio_characteristic_obj_t;
 
 #endif // MICROPY_INCLUDED_COMMON_HAL_BLEIO_CHARACTERISTIC_H
@@ -50,9 +50,7 @@ STATIC void characteristic_buffer_on_ble_evt(ble_evt_t *ble_evt, void *param) {
             // Push all the data onto the ring buffer.
             uint8_t is_nested_critical_region;
             sd_nvic_critical_region_enter(&is_nested_critical_region);
-            for (size_t i = 0; i < evt_write->len; i++) {
-                ringbuf_put(&self->ringbuf, evt_write->data[i]);
-            }
+            ringbuf_put_n(&self->ringbuf, evt_write->data, evt_write->len);
             sd_nvic_critical_region_exit(is_nested_critical_region);
             break;
         }
@@ -73,7 +71,10 @@ void common_hal_bleio_characteristic_buffer_construct(bleio_characteristic_buffe
     // true means long-lived, so it won't be moved.
     ringbuf_alloc(&self->ringbuf, buffer_size, true);
 
-    ble_drv_add_event_handler(characteristic_buffer_on_ble_evt, self);
+    // Only writes to the characteristic are of interest. Its handle isn't known until its
+    // Service has been added, so until then the handler checks the handle itself.
+    ble_drv_add_filtered_event_handler(characteristic_buffer_on_ble_evt, self, BLE_DRV_EVT_GATTS,
+                                       characteristic->handle);
 
 }
 
@@ -95,10 +96,7 @@ int common_hal_bleio_characteristic_buffer_read(bleio_characteristic_buffer_obj_
     uint8_t is_nested_critical_region;
     sd_nvic_critical_region_enter(&is_nested_critical_region);
 
-    size_t rx_bytes = MIN(ringbuf_count(&self->ringbuf), len);
-    for ( size_t i = 0; i < rx_bytes; i++ ) {
-        data[i] = ringbuf_get(&self->ringbuf);
-    }
+    size_t rx_bytes = ringbuf_get_n(&self->ringbuf, data, len);
 
     // Writes now OK.
     sd_nvic_critical_region_exit(is_nested_critical_region);
@@ -29,6 +29,7 @@
 
 #include "ble.h"
 #include "ble_drv.h"
+#include "ble_gatt_cache.h"
 #include "ble_hci.h"
 #include "nrf_soc.h"
 #include "py/objstr.h"
@@ -38,6 +39,7 @@
 #include "shared-bindings/bleio/Device.h"
 #include "shared-bindings/bleio/Service.h"
 #include "shared-bindings/bleio/UUID.h"
+#include "supervisor/port.h"
 
 #define BLE_MIN_CONN_INTERVAL        MSEC_TO_UNITS(15, UNIT_0_625_MS)
 #define BLE_MAX_CONN_INTERVAL        MSEC_TO_UNITS(300, UNIT_0_625_MS)
@@ -52,10 +54,17 @@
 #define BLE_GAP_ADV_MAX_SIZE         31
 #endif
 
+// The Database Hash characteristic, which changes whenever a server's GATT table does.
+#define BLE_UUID_GATT_DATABASE_HASH 0x2B2A
+
 static bleio_service_obj_t *m_char_discovery_service;
 static volatile bool m_discovery_successful;
 static nrf_mutex_t *m_discovery_mutex;
 
+static volatile bool m_hash_read_done;
+static volatile bool m_hash_read_successful;
+static uint8_t m_hash[BLE_GATT_CACHE_HASH_LENGTH];
+
 #if (BLUETOOTH_SD == 140)
 static uint8_t m_adv_handle = BLE_GAP_ADV_SET_HANDLE_NOT_SET;
 
@@ -273,6 +282,7 @@ STATIC bool discover_services(bleio_device_obj_t *device, uint16_t start_handle)
 #ifdef MICROPY_VM_HOOK_LOOP
     MICROPY_VM_HOOK_LOOP
 #endif
+        port_sleep_until_interrupt();
     }
 
     err_code = sd_mutex_release(m_discovery_mutex);
@@ -306,6 +316,7 @@ STATIC bool discover_characteristics(bleio_device_obj_t *device, bleio_service_o
 #ifdef MICROPY_VM_HOOK_LOOP
     MICROPY_VM_HOOK_LOOP
 #endif
+        port_sleep_until_interrupt();
     }
 
     err_code = sd_mutex_release(m_discovery_mutex);
@@ -316,23 +327,47 @@ STATIC bool discover_characteristics(bleio_device_obj_t *device, bleio_service_o
     return m_discovery_successful;
 }
 
-STATIC void on_primary_srv_discovery_rsp(ble_gattc_evt_prim_srvc_disc_rsp_t *response, bleio_device_obj_t *device) {
-    for (size_t i = 0; i < response->count; ++i) {
-        ble_gattc_service_t *gattc_service = &response->services[i];
+STATIC void add_discovered_service(bleio_device_obj_t *device, ble_gattc_service_t *gattc_service) {
+    bleio_service_obj_t *service = m_new_obj(bleio_service_obj_t);
+    service->base.type = &bleio_service_type;
+    service->device = device;
+    service->char_list = mp_obj_new_list(0, NULL);
+    service->start_handle = gattc_service->handle_range.start_handle;
+    service->end_handle = gattc_service->handle_range.end_handle;
+    service->handle = gattc_service->handle_range.start_handle;
+
+    bleio_uuid_obj_t *uuid = m_new_obj(bleio_uuid_obj_t);
+    bleio_uuid_construct_from_nrf_ble_uuid(uuid, &gattc_service->uuid);
+    service->uuid = uuid;
 
-        bleio_service_obj_t *service = m_new_obj(bleio_service_obj_t);
-        service->base.type = &bleio_service_type;
-        service->device = device;
-        service->char_list = mp_obj_new_list(0, NULL);
-        service->start_handle = gattc_service->handle_range.start_handle;
-        service->end_handle = gattc_service->handle_range.end_handle;
-        service->handle = gattc_service->handle_range.start_handle;
+    mp_obj_list_append(device->service_list, service);
+}
 
-        bleio_uuid_obj_t *uuid = m_new_obj(bleio_uuid_obj_t);
-        bleio_uuid_construct_from_nrf_ble_uuid(uuid, &gattc_service->uuid);
-        service->uuid = uuid;
+STATIC void add_discovered_characteristic(bleio_service_obj_t *service, ble_gattc_char_t *gattc_char) {
+    bleio_characteristic_obj_t *characteristic = m_new_obj(bleio_characteristic_obj_t);
+    characteristic->base.type = &bleio_characteristic_type;
+
+    bleio_uuid_obj_t *uuid = m_new_obj(bleio_uuid_obj_t);
+    uuid->base.type = &bleio_uuid_type;
+    bleio_uuid_construct_from_nrf_ble_uuid(uuid, &gattc_char->uuid);
+    characteristic->uuid = uuid;
+
+    characteristic->props.broadcast = gattc_char->char_props.broadcast;
+    characteristic->props.indicate = gattc_char->char_props.indicate;
+    characteristic->props.notify = gattc_char->char_props.notify;
+    characteristic->props.read = gattc_char->char_props.read;
+    characteristic->props.write = gattc_char->char_props.write;
+    characteristic->props.write_no_response = gattc_char->char_props.write_wo_resp;
+    characteristic->max_length = ble_drv_att_mtu - 3;
+    characteristic->handle = gattc_char->handle_value;
+    characteristic->service = service;
+
+    mp_obj_list_append(service->char_list, MP_OBJ_FROM_PTR(characteristic));
+}
 
-        mp_obj_list_append(device->service_list, service);
+STATIC void on_primary_srv_discovery_rsp(ble_gattc_evt_prim_srvc_disc_rsp_t *response, bleio_device_obj_t *device) {
+    for (size_t i = 0; i < response->count; ++i) {
+        add_discovered_service(device, &response->services[i]);
     }
 
     if (response->count > 0) {
@@ -347,26 +382,7 @@ STATIC void on_primary_srv_discovery_rsp(ble_gattc_evt_prim_srvc_disc_rsp_t *res
 
 STATIC void on_char_discovery_rsp(ble_gattc_evt_char_disc_rsp_t *response, bleio_device_obj_t *device) {
     for (size_t i = 0; i < response->count; ++i) {
-        ble_gattc_char_t *gattc_char = &response->chars[i];
-
-        bleio_characteristic_obj_t *characteristic = m_new_obj(bleio_characteristic_obj_t);
-        characteristic->base.type = &bleio_characteristic_type;
-
-        bleio_uuid_obj_t *uuid = m_new_obj(bleio_uuid_obj_t);
-        uuid->base.type = &bleio_uuid_type;
-        bleio_uuid_construct_from_nrf_ble_uuid(uuid, &gattc_char->uuid);
-        characteristic->uuid = uuid;
-
-        characteristic->props.broadcast = gattc_char->char_props.broadcast;
-        characteristic->props.indicate = gattc_char->char_props.indicate;
-        characteristic->props.notify = gattc_char->char_props.notify;
-        characteristic->props.read = gattc_char->char_props.read;
-        characteristic->props.write = gattc_char->char_props.write;
-        characteristic->props.write_no_response = gattc_char->char_props.write_wo_resp;
-        characteristic->handle = gattc_char->handle_value;
-        characteristic->service = m_char_discovery_service;
-
-        mp_obj_list_append(m_char_discovery_service->char_list, MP_OBJ_FROM_PTR(characteristic));
+        add_discovered_characteristic(m_char_discovery_service, &response->chars[i]);
     }
 
     if (response->count > 0) {
@@ -379,6 +395,145 @@ STATIC void on_char_discovery_rsp(ble_gattc_evt_char_disc_rsp_t *response, bleio
     }
 }
 
+STATIC void on_hash_read_rsp(ble_gattc_evt_t *gattc_evt) {
+    if (gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS &&
+        gattc_evt->params.char_val_by_uuid_read_rsp.value_len == BLE_GATT_CACHE_HASH_LENGTH) {
+        ble_gattc_handle_value_t iter = { .handle = 0, .p_value = NULL };
+        if (sd_ble_gattc_evt_char_val_by_uuid_read_rsp_iter(gattc_evt, &iter) == NRF_SUCCESS) {
+            memcpy(m_hash, iter.p_value, BLE_GATT_CACHE_HASH_LENGTH);
+            m_hash_read_successful = true;
+        }
+    }
+    m_hash_read_done = true;
+}
+
+// Read the server's Database Hash into m_hash. Servers older than Bluetooth 5.1 don't have one.
+STATIC bool read_database_hash(bleio_device_obj_t *device) {
+    ble_uuid_t uuid = {
+        .uuid = BLE_UUID_GATT_DATABASE_HASH,
+        .type = BLE_UUID_TYPE_BLE,
+    };
+    ble_gattc_handle_range_t handle_range = {
+        .start_handle = BLE_GATT_HANDLE_START,
+        .end_handle = BLE_GATT_HANDLE_END,
+    };
+
+    m_hash_read_done = false;
+    m_hash_read_successful = false;
+    if (sd_ble_gattc_char_value_by_uuid_read(device->conn_handle, &uuid, &handle_range) != NRF_SUCCESS) {
+        return false;
+    }
+    while (!m_hash_read_done && device->conn_handle != BLE_CONN_HANDLE_INVALID) {
+#ifdef MICROPY_VM_HOOK_LOOP
+    MICROPY_VM_HOOK_LOOP
+#endif
+        port_sleep_until_interrupt();
+    }
+    return m_hash_read_successful;
+}
+
+// Rebuild the service list from the table stored for this server, if its hash still matches.
+STATIC bool load_cached_gatt_table(bleio_device_obj_t *device) {
+    const ble_gatt_cache_t *table = ble_gatt_cache_find(device->address.type, device->address.value, m_hash);
+    if (table == NULL) {
+        return false;
+    }
+
+    // Check that every 128-bit UUID's base is registered before making any objects.
+    ble_uuid_t uuid;
+    for (size_t i = 0; i < table->service_count; i++) {
+        const ble_gatt_cache_service_t *cached = &table->services[i];
+        if (sd_ble_uuid_decode(cached->uuid_len, cached->uuid, &uuid) != NRF_SUCCESS) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < table->characteristic_count; i++) {
+        const ble_gatt_cache_characteristic_t *cached = &table->characteristics[i];
+        if (cached->service_index >= table->service_count ||
+            sd_ble_uuid_decode(cached->uuid_len, cached->uuid, &uuid) != NRF_SUCCESS) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < table->service_count; i++) {
+        const ble_gatt_cache_service_t *cached = &table->services[i];
+        ble_gattc_service_t gattc_service = {
+            .handle_range = {
+                .start_handle = cached->start_handle,
+                .end_handle = cached->end_handle,
+            },
+        };
+        sd_ble_uuid_decode(cached->uuid_len, cached->uuid, &gattc_service.uuid);
+        add_discovered_service(device, &gattc_service);
+    }
+
+    const mp_obj_list_t *service_list = MP_OBJ_TO_PTR(device->service_list);
+    for (size_t i = 0; i < table->characteristic_count; i++) {
+        const ble_gatt_cache_characteristic_t *cached = &table->characteristics[i];
+        ble_gattc_char_t gattc_char;
+        memset(&gattc_char, 0, sizeof(gattc_char));
+        sd_ble_uuid_decode(cached->uuid_len, cached->uuid, &gattc_char.uuid);
+        gattc_char.char_props.broadcast = (cached->props & BLE_GATT_CACHE_PROP_BROADCAST) != 0;
+        gattc_char.char_props.indicate = (cached->props & BLE_GATT_CACHE_PROP_INDICATE) != 0;
+        gattc_char.char_props.notify = (cached->props & BLE_GATT_CACHE_PROP_NOTIFY) != 0;
+        gattc_char.char_props.read = (cached->props & BLE_GATT_CACHE_PROP_READ) != 0;
+        gattc_char.char_props.write = (cached->props & BLE_GATT_CACHE_PROP_WRITE) != 0;
+        gattc_char.char_props.write_wo_resp = (cached->props & BLE_GATT_CACHE_PROP_WRITE_NO_RESPONSE) != 0;
+        gattc_char.handle_value = cached->handle_value;
+        add_discovered_characteristic(service_list->items[cached->service_index], &gattc_char);
+    }
+
+    return true;
+}
+
+STATIC void store_gatt_table(bleio_device_obj_t *device) {
+    const mp_obj_list_t *service_list = MP_OBJ_TO_PTR(device->service_list);
+    if (service_list->len > BLE_GATT_CACHE_MAX_SERVICES) {
+        return;
+    }
+
+    ble_gatt_cache_t *table = m_new_obj(ble_gatt_cache_t);
+    table->address_type = device->address.type;
+    memcpy(table->address, device->address.value, BLEIO_ADDRESS_BYTES);
+    memcpy(table->hash, m_hash, BLE_GATT_CACHE_HASH_LENGTH);
+    table->service_count = service_list->len;
+    table->characteristic_count = 0;
+
+    bool fits = true;
+    for (size_t i = 0; i < service_list->len && fits; i++) {
+        bleio_service_obj_t *service = service_list->items[i];
+        ble_gatt_cache_service_t *cached_service = &table->services[i];
+        cached_service->start_handle = service->start_handle;
+        cached_service->end_handle = service->end_handle;
+        sd_ble_uuid_encode(&service->uuid->nrf_ble_uuid, &cached_service->uuid_len, cached_service->uuid);
+
+        const mp_obj_list_t *char_list = MP_OBJ_TO_PTR(service->char_list);
+        for (size_t j = 0; j < char_list->len; j++) {
+            if (table->characteristic_count == BLE_GATT_CACHE_MAX_CHARACTERISTICS) {
+                fits = false;
+                break;
+            }
+            bleio_characteristic_obj_t *characteristic = char_list->items[j];
+            ble_gatt_cache_characteristic_t *cached = &table->characteristics[table->characteristic_count++];
+            cached->handle_value = characteristic->handle;
+            cached->service_index = i;
+            cached->props =
+                (characteristic->props.broadcast ? BLE_GATT_CACHE_PROP_BROADCAST : 0) |
+                (characteristic->props.indicate ? BLE_GATT_CACHE_PROP_INDICATE : 0) |
+                (characteristic->props.notify ? BLE_GATT_CACHE_PROP_NOTIFY : 0) |
+                (characteristic->props.read ? BLE_GATT_CACHE_PROP_READ : 0) |
+                (characteristic->props.write ? BLE_GATT_CACHE_PROP_WRITE : 0) |
+                (characteristic->props.write_no_response ? BLE_GATT_CACHE_PROP_WRITE_NO_RESPONSE : 0);
+            sd_ble_uuid_encode(&characteristic->uuid->nrf_ble_uuid, &cached->uuid_len, cached->uuid);
+        }
+    }
+
+    if (fits) {
+        ble_gatt_cache_store(table);
+    }
+    m_del_obj(ble_gatt_cache_t, table);
+}
+
 STATIC void on_adv_report(ble_gap_evt_adv_report_t *report, bleio_device_obj_t *device) {
     uint32_t err_code;
 
@@ -430,9 +585,21 @@ STATIC void on_ble_evt(ble_evt_t *ble_evt, void *device_in) {
         {
             ble_gap_conn_params_t conn_params;
             device->conn_handle = ble_evt->evt.gap_evt.conn_handle;
+            device->att_mtu = BLE_GATT_ATT_MTU_DEFAULT;
 
             sd_ble_gap_ppcp_get(&conn_params);
             sd_ble_gap_conn_param_update(ble_evt->evt.gap_evt.conn_handle, &conn_params);
+
+            // Ask for the 2M PHY, longer link layer packets and a larger MTU.
+            ble_gap_phys_t const phys = {
+                .rx_phys = BLE_GAP_PHY_2MBPS,
+                .tx_phys = BLE_GAP_PHY_2MBPS,
+            };
+            sd_ble_gap_phy_update(device->conn_handle, &phys);
+            sd_ble_gap_data_length_update(device->conn_handle, NULL, NULL);
+            if (ble_drv_att_mtu > BLE_GATT_ATT_MTU_DEFAULT) {
+                sd_ble_gattc_exchange_mtu_request(device->conn_handle, ble_drv_att_mtu);
+            }
             break;
         }
 
@@ -452,13 +619,22 @@ STATIC void on_ble_evt(ble_evt_t *ble_evt, void *device_in) {
             on_char_discovery_rsp(&ble_evt->evt.gattc_evt.params.char_disc_rsp, device);
             break;
 
+        case BLE_GATTC_EVT_CHAR_VAL_BY_UUID_READ_RSP:
+            on_hash_read_rsp(&ble_evt->evt.gattc_evt);
+            break;
+
         case BLE_GATTS_EVT_SYS_ATTR_MISSING:
             sd_ble_gatts_sys_attr_set(ble_evt->evt.gatts_evt.conn_handle, NULL, 0, 0);
             break;
 
 #if (BLE_API_VERSION == 4)
         case BLE_GATTS_EVT_EXCHANGE_MTU_REQUEST:
-            sd_ble_gatts_exchange_mtu_reply(device->conn_handle, BLE_GATT_ATT_MTU_DEFAULT);
+            sd_ble_gatts_exchange_mtu_reply(device->conn_handle, ble_drv_att_mtu);
+            device->att_mtu = MIN(ble_evt->evt.gatts_evt.params.exchange_mtu_request.client_rx_mtu, ble_drv_att_mtu);
+            break;
+
+        case BLE_GATTC_EVT_EXCHANGE_MTU_RSP:
+            device->att_mtu = MIN(ble_evt->evt.gattc_evt.params.exchange_mtu_rsp.server_rx_mtu, ble_drv_att_mtu);
             break;
 #endif
 
@@ -472,6 +648,20 @@ STATIC void on_ble_evt(ble_evt_t *ble_evt, void *device_in) {
             sd_ble_gap_conn_param_update(device->conn_handle, &request->conn_params);
             break;
         }
+
+        case BLE_GAP_EVT_PHY_UPDATE_REQUEST:
+        {
+            ble_gap_phys_t const phys = {
+                .rx_phys = BLE_GAP_PHY_AUTO,
+                .tx_phys = BLE_GAP_PHY_AUTO,
+            };
+            sd_ble_gap_phy_update(device->conn_handle, &phys);
+            break;
+        }
+
+        case BLE_GAP_EVT_DATA_LENGTH_UPDATE_REQUEST:
+            sd_ble_gap_data_length_update(device->conn_handle, NULL, NULL);
+            break;
     }
 }
 
@@ -500,7 +690,7 @@ void common_hal_bleio_device_add_service(bleio_device_obj_t *device, bleio_servi
 
 void common_hal_bleio_device_start_advertising(bleio_device_obj_t *device, bool connectable, mp_buffer_info_t *raw_data) {
     if (connectable) {
-        ble_drv_add_event_handler(on_ble_evt, device);
+        ble_drv_add_filtered_event_handler(on_ble_evt, device, BLE_DRV_EVT_GAP | BLE_DRV_EVT_GATTC | BLE_DRV_EVT_GATTS, BLE_GATT_HANDLE_INVALID);
     }
 
     const uint32_t err_code = set_advertisement_data(device, connectable, raw_data);
@@ -527,7 +717,7 @@ void common_hal_bleio_device_stop_advertising(bleio_device_obj_t *device) {
 }
 
 void common_hal_bleio_device_connect(bleio_device_obj_t *device) {
-    ble_drv_add_event_handler(on_ble_evt, device);
+    ble_drv_add_filtered_event_handler(on_ble_evt, device, BLE_DRV_EVT_GAP | BLE_DRV_EVT_GATTC | BLE_DRV_EVT_GATTS, BLE_GATT_HANDLE_INVALID);
 
     ble_gap_scan_params_t scan_params = {
         .interval = MSEC_TO_UNITS(100, UNIT_0_625_MS),
@@ -567,6 +757,12 @@ void common_hal_bleio_device_connect(bleio_device_obj_t *device) {
         }
     }
 
+    // A server with an unchanged Database Hash has the same GATT table as last time.
+    const bool have_hash = read_database_hash(device);
+    if (have_hash && load_cached_gatt_table(device)) {
+        return;
+    }
+
     // find services
     bool found_service = discover_services(device, BLE_GATT_HANDLE_START);
     while (found_service) {
@@ -594,6 +790,10 @@ void common_hal_bleio_device_connect(bleio_device_obj_t *device) {
             found_char = discover_characteristics(device, service, next_handle);
         }
     }
+
+    if (have_hash) {
+        store_gatt_table(device);
+    }
 }
 
 void common_hal_bleio_device_disconnect(bleio_device_obj_t *device) {
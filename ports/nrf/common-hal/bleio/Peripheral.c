@@ -235,6 +235,14 @@ STATIC void peripheral_on_ble_evt(ble_evt_t *ble_evt, void *self_in) {
         self->conn_handle = ble_evt->evt.gap_evt.conn_handle;
         sd_ble_gap_ppcp_get(&conn_params);
         sd_ble_gap_conn_param_update(ble_evt->evt.gap_evt.conn_handle, &conn_params);
+
+        // Ask for the 2M PHY and longer link layer packets. The central may refuse either.
+        ble_gap_phys_t const phys = {
+            .rx_phys = BLE_GAP_PHY_2MBPS,
+            .tx_phys = BLE_GAP_PHY_2MBPS,
+        };
+        sd_ble_gap_phy_update(self->conn_handle, &phys);
+        sd_ble_gap_data_length_update(self->conn_handle, NULL, NULL);
         break;
     }
 
@@ -271,7 +279,7 @@ STATIC void peripheral_on_ble_evt(ble_evt_t *ble_evt, void *self_in) {
         break;
 
     case BLE_GATTS_EVT_EXCHANGE_MTU_REQUEST: {
-        sd_ble_gatts_exchange_mtu_reply(self->conn_handle, BLE_GATT_ATT_MTU_DEFAULT);
+        sd_ble_gatts_exchange_mtu_reply(self->conn_handle, ble_drv_att_mtu);
         break;
     }
 
@@ -324,7 +332,7 @@ bool common_hal_bleio_peripheral_get_connected(bleio_peripheral_obj_t *self) {
 
 void common_hal_bleio_peripheral_start_advertising(bleio_peripheral_obj_t *self, bool connectable, mp_buffer_info_t *raw_data) {
     if (connectable) {
-        ble_drv_add_event_handler(peripheral_on_ble_evt, self);
+        ble_drv_add_filtered_event_handler(peripheral_on_ble_evt, self, BLE_DRV_EVT_GAP | BLE_DRV_EVT_GATTS, BLE_GATT_HANDLE_INVALID);
     }
 
     const uint32_t err_code = set_advertisement_data(self, connectable, raw_data);
@@ -29,12 +29,15 @@
 
 #include "ble_drv.h"
 #include "ble_gap.h"
+#include "nrf_nvic.h"
+#include "lib/utils/interrupt_char.h"
 #include "py/mphal.h"
 #include "py/runtime.h"
 #include "shared-bindings/bleio/Adapter.h"
 #include "shared-bindings/bleio/ScanEntry.h"
 #include "shared-bindings/bleio/Scanner.h"
 #include "shared-module/bleio/ScanEntry.h"
+#include "tick.h"
 
 #if (BLUETOOTH_SD == 140)
 static uint8_t m_scan_buffer_data[BLE_GAP_SCAN_BUFFER_MIN];
@@ -45,6 +48,77 @@ static ble_data_t m_scan_buffer = {
 };
 #endif
 
+#define AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE  0x02
+#define AD_TYPE_16BIT_SERVICE_UUID_COMPLETE        0x03
+#define AD_TYPE_128BIT_SERVICE_UUID_MORE_AVAILABLE 0x06
+#define AD_TYPE_128BIT_SERVICE_UUID_COMPLETE       0x07
+#define AD_TYPE_MANUFACTURER_SPECIFIC_DATA         0xff
+
+// True if the advertising data has a field of the given type whose contents start with prefix,
+// or, when uuid_size is non-zero, a list of UUIDs of that size that contains prefix.
+STATIC bool ad_field_matches(const uint8_t *data, uint16_t len, uint8_t type,
+                             const uint8_t *prefix, uint8_t prefix_len, uint8_t uuid_size) {
+    uint16_t i = 0;
+    while (i + 1 < len) {
+        const uint8_t field_len = data[i];
+        if (field_len == 0 || i + 1 + field_len > len) {
+            // Padding or a malformed field; nothing more to look at.
+            return false;
+        }
+        const uint8_t *field = &data[i + 2];
+        const uint8_t field_data_len = field_len - 1;
+        if (data[i + 1] == type) {
+            if (uuid_size == 0) {
+                if (field_data_len >= prefix_len && memcmp(field, prefix, prefix_len) == 0) {
+                    return true;
+                }
+            } else {
+                for (uint8_t j = 0; j + uuid_size <= field_data_len; j += uuid_size) {
+                    if (memcmp(&field[j], prefix, uuid_size) == 0) {
+                        return true;
+                    }
+                }
+            }
+        }
+        i += field_len + 1;
+    }
+    return false;
+}
+
+STATIC bool report_passes_filters(bleio_scanner_obj_t *scanner, ble_gap_evt_adv_report_t *report,
+                                  const uint8_t *data, uint16_t len) {
+    if (report->rssi < scanner->minimum_rssi) {
+        return false;
+    }
+
+    // The prefix is in the order the address is written, most significant byte first.
+    for (uint8_t i = 0; i < scanner->address_prefix_len; i++) {
+        if (report->peer_addr.addr[BLEIO_ADDRESS_BYTES - 1 - i] != scanner->address_prefix[i]) {
+            return false;
+        }
+    }
+
+    if (scanner->uuid_filter_len == 2 &&
+        !ad_field_matches(data, len, AD_TYPE_16BIT_SERVICE_UUID_COMPLETE, scanner->uuid_filter, 2, 2) &&
+        !ad_field_matches(data, len, AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE, scanner->uuid_filter, 2, 2)) {
+        return false;
+    }
+    if (scanner->uuid_filter_len == 16 &&
+        !ad_field_matches(data, len, AD_TYPE_128BIT_SERVICE_UUID_COMPLETE, scanner->uuid_filter, 16, 16) &&
+        !ad_field_matches(data, len, AD_TYPE_128BIT_SERVICE_UUID_MORE_AVAILABLE, scanner->uuid_filter, 16, 16)) {
+        return false;
+    }
+
+    if (scanner->manufacturer_prefix_len > 0 &&
+        !ad_field_matches(data, len, AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+                          scanner->manufacturer_prefix, scanner->manufacturer_prefix_len, 0)) {
+        return false;
+    }
+
+    return true;
+}
+
+// Runs in the SoftDevice event interrupt, so it only copies into the preallocated records.
 STATIC void on_ble_evt(ble_evt_t *ble_evt, void *scanner_in) {
     bleio_scanner_obj_t *scanner = (bleio_scanner_obj_t*)scanner_in;
     ble_gap_evt_adv_report_t *report = &ble_evt->evt.gap_evt.params.adv_report;
@@ -53,32 +127,88 @@ STATIC void on_ble_evt(ble_evt_t *ble_evt, void *scanner_in) {
         return;
     }
 
-    // TODO: Don't add new entry for each item, group by address and update
-    bleio_scanentry_obj_t *entry = m_new_obj(bleio_scanentry_obj_t);
-    entry->base.type = &bleio_scanentry_type;
-    entry->rssi = report->rssi;
-
-    entry->address.type = report->peer_addr.addr_type;
-    memcpy(entry->address.value, report->peer_addr.addr, BLEIO_ADDRESS_BYTES);
-
 #if (BLUETOOTH_SD == 140)
-    entry->data = mp_obj_new_bytearray(report->data.len, report->data.p_data);
+    const uint8_t *data = report->data.p_data;
+    uint16_t len = report->data.len;
 #else
-    entry->data = mp_obj_new_bytearray(report->dlen, report->data);
+    const uint8_t *data = report->data;
+    uint16_t len = report->dlen;
 #endif
 
-    mp_obj_list_append(scanner->adv_reports, entry);
+    if (report_passes_filters(scanner, report, data, len)) {
+        // Replace an unread report from the same address, or take the next free record.
+        bleio_scan_record_t *record = NULL;
+        for (uint16_t i = 0; i < scanner->records_count; i++) {
+            bleio_scan_record_t *r = &scanner->records[(scanner->records_start + i) % scanner->records_size];
+            if (r->address_type == report->peer_addr.addr_type &&
+                memcmp(r->address, report->peer_addr.addr, BLEIO_ADDRESS_BYTES) == 0) {
+                record = r;
+                break;
+            }
+        }
+        if (record == NULL && scanner->records_count < scanner->records_size) {
+            record = &scanner->records[(scanner->records_start + scanner->records_count) % scanner->records_size];
+            record->address_type = report->peer_addr.addr_type;
+            memcpy(record->address, report->peer_addr.addr, BLEIO_ADDRESS_BYTES);
+            scanner->records_count++;
+        }
+        // If all the records are full the report is dropped.
+        if (record != NULL) {
+            record->rssi = report->rssi;
+            record->data_len = MIN(len, BLEIO_SCAN_DATA_MAX);
+            memcpy(record->data, data, record->data_len);
+        }
+    }
 
 #if (BLUETOOTH_SD == 140)
-    const uint32_t err_code = sd_ble_gap_scan_start(NULL, &m_scan_buffer);
-    if (err_code != NRF_SUCCESS) {
-        mp_raise_OSError_msg_varg(translate("Failed to continue scanning, err 0x%04x"), err_code);
-    }
+    // Scanning pauses after each report until the buffer is handed back. There's no one to
+    // report a failure to from here; the scan simply ends early.
+    sd_ble_gap_scan_start(NULL, &m_scan_buffer);
 #endif
 }
 
+// Turn the stored reports into ScanEntry objects, updating the entry already in the results
+// for an address seen in an earlier batch.
+STATIC void scanner_collect_records(bleio_scanner_obj_t *self) {
+    while (self->records_count > 0) {
+        bleio_scan_record_t record;
+        uint8_t is_nested_critical_region;
+        sd_nvic_critical_region_enter(&is_nested_critical_region);
+        record = self->records[self->records_start];
+        self->records_start = (self->records_start + 1) % self->records_size;
+        self->records_count--;
+        sd_nvic_critical_region_exit(is_nested_critical_region);
+
+        bleio_scanentry_obj_t *entry = NULL;
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_list_get(self->adv_reports, &len, &items);
+        for (size_t i = 0; i < len; i++) {
+            bleio_scanentry_obj_t *existing = MP_OBJ_TO_PTR(items[i]);
+            if (existing->address.type == record.address_type &&
+                memcmp(existing->address.value, record.address, BLEIO_ADDRESS_BYTES) == 0) {
+                entry = existing;
+                break;
+            }
+        }
+        if (entry == NULL) {
+            entry = m_new_obj(bleio_scanentry_obj_t);
+            entry->base.type = &bleio_scanentry_type;
+            entry->address.type = record.address_type;
+            memcpy(entry->address.value, record.address, BLEIO_ADDRESS_BYTES);
+            mp_obj_list_append(self->adv_reports, entry);
+        }
+
+        entry->rssi = record.rssi;
+        entry->data = mp_obj_new_bytearray(record.data_len, record.data);
+    }
+}
+
 void common_hal_bleio_scanner_scan(bleio_scanner_obj_t *self, mp_int_t timeout) {
-    ble_drv_add_event_handler(on_ble_evt, self);
+    self->records_start = 0;
+    self->records_count = 0;
+
+    ble_drv_add_filtered_event_handler(on_ble_evt, self, BLE_DRV_EVT_GAP, BLE_GATT_HANDLE_INVALID);
 
     ble_gap_scan_params_t scan_params = {
         .interval = MSEC_TO_UNITS(self->interval, UNIT_0_625_MS),
@@ -98,11 +228,23 @@ void common_hal_bleio_scanner_scan(bleio_scanner_obj_t *self, mp_int_t timeout)
 #endif
 
     if (err_code != NRF_SUCCESS) {
+        ble_drv_remove_event_handler(on_ble_evt, self);
         mp_raise_OSError_msg_varg(translate("Failed to start scanning, err 0x%04x"), err_code);
     }
 
-    if (timeout > 0) {
-        mp_hal_delay_ms(timeout);
-        sd_ble_gap_scan_stop();
+    // Collect reports in batches while scanning so the records don't fill up.
+    uint64_t start_ticks = ticks_ms;
+    while (ticks_ms - start_ticks < (uint64_t) timeout) {
+#ifdef MICROPY_VM_HOOK_LOOP
+        MICROPY_VM_HOOK_LOOP
+#endif
+        if (mp_hal_is_interrupted()) {
+            break;
+        }
+        scanner_collect_records(self);
     }
+
+    sd_ble_gap_scan_stop();
+    ble_drv_remove_event_handler(on_ble_evt, self);
+    scanner_collect_records(self);
 }
@@ -77,7 +77,7 @@ void common_hal_bleio_service_add_all_characteristics(bleio_service_obj_t *self)
             .p_uuid = &uuid,
             .p_attr_md = &attr_md,
             .init_len = sizeof(uint8_t),
-            .max_len = GATT_MAX_DATA_LENGTH,
+            .max_len = characteristic->max_length,
         };
 
         ble_gatts_char_handles_t handles;
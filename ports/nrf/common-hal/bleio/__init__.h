@@ -32,10 +32,6 @@
 
 #include "shared-module/bleio/__init__.h"
 
-// We assume variable length data.
-// 20 bytes max (23 - 3).
-#define GATT_MAX_DATA_LENGTH (BLE_GATT_ATT_MTU_DEFAULT - 3)
-
 gatt_role_t common_hal_bleio_device_get_gatt_role(mp_obj_t device);
 uint16_t common_hal_bleio_device_get_conn_handle(mp_obj_t device);
 
@@ -168,6 +168,9 @@ void common_hal_busio_spi_construct(busio_spi_obj_t *self, const mcu_pin_obj_t *
         common_hal_busio_spi_deinit(self);
         mp_raise_OSError(MP_EIO);
     }
+
+    self->write_in_progress = false;
+    self->write_buffer = MP_OBJ_NULL;
 }
 
 bool common_hal_busio_spi_deinited(busio_spi_obj_t *self) {
@@ -178,6 +181,7 @@ void common_hal_busio_spi_deinit(busio_spi_obj_t *self) {
     if (common_hal_busio_spi_deinited(self))
         return;
 
+    common_hal_busio_spi_finish_write(self);
     nrfx_spim_uninit(&self->spim_peripheral->spim);
 
     reset_pin_number(self->clock_pin_number);
@@ -250,6 +254,50 @@ bool common_hal_busio_spi_write(busio_spi_obj_t *self, const uint8_t *data, size
     return true;
 }
 
+bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len) {
+    // Short writes aren't worth doing in the background. EasyDMA can only read from RAM and
+    // max_xfer_size is the width of its MAXCNT register in bits.
+    if (len < 16 || len >= (1u << self->spim_peripheral->max_xfer_size) || !nrfx_is_in_ram(data)) {
+        return common_hal_busio_spi_write(self, data, len);
+    }
+
+    // The driver is in blocking mode so start the transfer directly and poll for its end later.
+    NRF_SPIM_Type* spim = self->spim_peripheral->spim.p_reg;
+    nrf_spim_tx_buffer_set(spim, data, len);
+    nrf_spim_rx_buffer_set(spim, NULL, 0);
+    nrf_spim_event_clear(spim, NRF_SPIM_EVENT_END);
+    nrf_spim_task_trigger(spim, NRF_SPIM_TASK_START);
+    self->write_in_progress = true;
+    return true;
+}
+
+bool common_hal_busio_spi_finish_write(busio_spi_obj_t *self) {
+    if (!self->write_in_progress) {
+        return true;
+    }
+    NRF_SPIM_Type* spim = self->spim_peripheral->spim.p_reg;
+    while (!nrf_spim_event_check(spim, NRF_SPIM_EVENT_END)) {}
+    nrf_spim_event_clear(spim, NRF_SPIM_EVENT_END);
+    self->write_in_progress = false;
+    self->write_buffer = MP_OBJ_NULL;
+    return true;
+}
+
+bool common_hal_busio_spi_start_write_obj(busio_spi_obj_t *self, mp_obj_t buffer, const uint8_t *data, size_t len) {
+    bool ok = common_hal_busio_spi_start_write(self, data, len);
+    if (self->write_in_progress) {
+        self->write_buffer = buffer;
+    }
+    return ok;
+}
+
+bool common_hal_busio_spi_write_in_progress(busio_spi_obj_t *self) {
+    if (!self->write_in_progress) {
+        return false;
+    }
+    return !nrf_spim_event_check(self->spim_peripheral->spim.p_reg, NRF_SPIM_EVENT_END);
+}
+
 bool common_hal_busio_spi_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value) {
     if (len == 0)
         return true;
@@ -43,6 +43,8 @@ typedef struct {
     uint8_t clock_pin_number;
     uint8_t MOSI_pin_number;
     uint8_t MISO_pin_number;
+    bool write_in_progress;
+    mp_obj_t write_buffer;
 } busio_spi_obj_t;
 
 void spi_reset(void);
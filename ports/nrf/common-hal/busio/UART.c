@@ -33,6 +33,7 @@
 #include "py/mperrno.h"
 #include "py/runtime.h"
 #include "py/stream.h"
+#include "supervisor/port.h"
 #include "supervisor/shared/translate.h"
 
 #include "tick.h"
@@ -92,26 +93,58 @@ static uint32_t get_nrf_baud (uint32_t baudrate) {
     } while (true);
 }
 
+// ringbuf_put_n_overwrite() drops the oldest characters to make room when the buffer is full.
+static void count_rx_overrun(busio_uart_obj_t* self, size_t len) {
+    if (ringbuf_count(&self->rbuf) + len >= self->rbuf.size) {
+        self->rx_overruns++;
+    }
+}
+
+// Start sending the next contiguous run of queued characters, if nothing is being sent already.
+// Called with the UARTE interrupt disabled or from it.
+static void tx_start_next(busio_uart_obj_t* self) {
+    ringbuf_t* tx_buffer = &self->tx_buffer;
+    if (self->tx_sending > 0 || tx_buffer->iget == tx_buffer->iput) {
+        return;
+    }
+    size_t len;
+    if (tx_buffer->iput > tx_buffer->iget) {
+        len = tx_buffer->iput - tx_buffer->iget;
+    } else {
+        len = tx_buffer->size - tx_buffer->iget;
+    }
+    self->tx_sending = MIN(len, (1 << UARTE0_EASYDMA_MAXCNT_SIZE) - 1);
+    (void) nrfx_uarte_tx(self->uarte, tx_buffer->buf + tx_buffer->iget, self->tx_sending);
+}
+
 static void uart_callback_irq (const nrfx_uarte_event_t * event, void * context) {
     busio_uart_obj_t* self = (busio_uart_obj_t*) context;
 
     switch ( event->type ) {
         case NRFX_UARTE_EVT_RX_DONE:
-            ringbuf_put_n(&self->rbuf, event->data.rxtx.p_data, event->data.rxtx.bytes);
+            count_rx_overrun(self, event->data.rxtx.bytes);
+            ringbuf_put_n_overwrite(&self->rbuf, event->data.rxtx.p_data, event->data.rxtx.bytes);
 
             // keep receiving
             (void) nrfx_uarte_rx(self->uarte, &self->rx_char, 1);
         break;
 
         case NRFX_UARTE_EVT_TX_DONE:
-            // nothing to do
+            if (self->tx_sending > 0) {
+                self->tx_buffer.iget = (self->tx_buffer.iget + self->tx_sending) % self->tx_buffer.size;
+                self->tx_sending = 0;
+                tx_start_next(self);
+            }
         break;
 
         case NRFX_UARTE_EVT_ERROR:
             // Possible Error source is Overrun, Parity, Framing, Break
-            // uint32_t errsrc = event->data.error.error_mask;
+            if (event->data.error.error_mask & NRF_UARTE_ERROR_OVERRUN_MASK) {
+                self->rx_overruns++;
+            }
 
-            ringbuf_put_n(&self->rbuf, event->data.error.rxtx.p_data, event->data.error.rxtx.bytes);
+            count_rx_overrun(self, event->data.error.rxtx.bytes);
+            ringbuf_put_n_overwrite(&self->rbuf, event->data.error.rxtx.p_data, event->data.error.rxtx.bytes);
 
             // Keep receiving
             (void) nrfx_uarte_rx(self->uarte, &self->rx_char, 1);
@@ -131,7 +164,7 @@ void uart_reset(void) {
 void common_hal_busio_uart_construct (busio_uart_obj_t *self,
                                       const mcu_pin_obj_t * tx, const mcu_pin_obj_t * rx, uint32_t baudrate,
                                       uint8_t bits, uart_parity_t parity, uint8_t stop, mp_float_t timeout,
-                                      uint8_t receiver_buffer_size) {
+                                      uint16_t receiver_buffer_size, uint16_t transmitter_buffer_size) {
     // Find a free UART peripheral.
     self->uarte = NULL;
     for (size_t i = 0 ; i < MP_ARRAY_SIZE(nrfx_uartes); i++) {
@@ -192,6 +225,21 @@ void common_hal_busio_uart_construct (busio_uart_obj_t *self,
         claim_pin(rx);
     }
 
+    self->tx_sending = 0;
+    if ( tx != mp_const_none && transmitter_buffer_size > 0 ) {
+        // One more than asked for because a full ringbuf_t always has an empty slot.
+        ringbuf_alloc(&self->tx_buffer, transmitter_buffer_size + 1, true);
+
+        if ( !self->tx_buffer.buf ) {
+            nrfx_uarte_uninit(self->uarte);
+            mp_raise_msg(&mp_type_MemoryError, translate("Failed to allocate TX buffer"));
+        }
+    } else {
+        self->tx_buffer.buf = NULL;
+        self->tx_buffer.size = 0;
+        self->tx_buffer.iput = self->tx_buffer.iget = 0;
+    }
+
     if ( tx != mp_const_none ) {
         self->tx_pin_number = tx->number;
         claim_pin(tx);
@@ -201,6 +249,7 @@ void common_hal_busio_uart_construct (busio_uart_obj_t *self,
 
     self->baudrate = baudrate;
     self->timeout_ms = timeout * 1000;
+    self->rx_overruns = 0;
 
     // Initial wait for incoming byte
     _VERIFY_ERR(nrfx_uarte_rx(self->uarte, &self->rx_char, 1));
@@ -221,6 +270,12 @@ void common_hal_busio_uart_deinit(busio_uart_obj_t *self) {
         gc_free(self->rbuf.buf);
         self->rbuf.size = 0;
         self->rbuf.iput = self->rbuf.iget = 0;
+
+        gc_free(self->tx_buffer.buf);
+        self->tx_buffer.buf = NULL;
+        self->tx_buffer.size = 0;
+        self->tx_buffer.iput = self->tx_buffer.iget = 0;
+        self->tx_sending = 0;
     }
 }
 
@@ -242,23 +297,60 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
             return 0;
         }
 #endif
+        port_sleep_until_interrupt();
     }
 
     // prevent conflict with uart irq
     NVIC_DisableIRQ(nrfx_get_irq_number(self->uarte->p_reg));
 
     // copy received data
-    rx_bytes = ringbuf_count(&self->rbuf);
-    rx_bytes = MIN(rx_bytes, len);
-    for ( uint16_t i = 0; i < rx_bytes; i++ ) {
-        data[i] = ringbuf_get(&self->rbuf);
-    }
+    rx_bytes = ringbuf_get_n(&self->rbuf, data, len);
 
     NVIC_EnableIRQ(nrfx_get_irq_number(self->uarte->p_reg));
 
     return rx_bytes;
 }
 
+// Queue characters to be sent in the background, waiting only while the buffer is full.
+static size_t tx_queue(busio_uart_obj_t *self, const uint8_t *data, size_t len, int *errcode) {
+    size_t total_queued = 0;
+    uint64_t start_ticks = ticks_ms;
+    while ( true ) {
+        // prevent conflict with uart irq
+        NVIC_DisableIRQ(nrfx_get_irq_number(self->uarte->p_reg));
+        size_t num_queued = ringbuf_put_n(&self->tx_buffer, data, len);
+        tx_start_next(self);
+        NVIC_EnableIRQ(nrfx_get_irq_number(self->uarte->p_reg));
+
+        data += num_queued;
+        len -= num_queued;
+        total_queued += num_queued;
+        if ( len == 0 ) {
+            break;
+        }
+        if ( num_queued > 0 ) {
+            // Reset the timeout whenever there was room for more.
+            start_ticks = ticks_ms;
+        }
+        if ( !(ticks_ms - start_ticks < self->timeout_ms) ) {
+            break;
+        }
+#ifdef MICROPY_VM_HOOK_LOOP
+        MICROPY_VM_HOOK_LOOP ;
+        // Allow user to break out of a timeout with a KeyboardInterrupt.
+        if ( mp_hal_is_interrupted() ) {
+            break;
+        }
+#endif
+    }
+
+    if ( total_queued == 0 ) {
+        *errcode = MP_EAGAIN;
+        return MP_STREAM_ERROR;
+    }
+    return total_queued;
+}
+
 // Write characters.
 size_t common_hal_busio_uart_write (busio_uart_obj_t *self, const uint8_t *data, size_t len, int *errcode) {
     if ( nrf_uarte_tx_pin_get(self->uarte->p_reg) == NRF_UARTE_PSEL_DISCONNECTED ) {
@@ -267,6 +359,10 @@ size_t common_hal_busio_uart_write (busio_uart_obj_t *self, const uint8_t *data,
 
     if ( len == 0 ) return 0;
 
+    if ( self->tx_buffer.size > 0 ) {
+        return tx_queue(self, data, len, errcode);
+    }
+
     uint64_t start_ticks = ticks_ms;
 
     // Wait for on-going transfer to complete
@@ -327,6 +423,17 @@ void common_hal_busio_uart_clear_rx_buffer(busio_uart_obj_t *self) {
     NVIC_EnableIRQ(nrfx_get_irq_number(self->uarte->p_reg));
 }
 
+uint32_t common_hal_busio_uart_tx_characters_waiting(busio_uart_obj_t *self) {
+    return ringbuf_count(&self->tx_buffer);
+}
+
+uint32_t common_hal_busio_uart_get_rx_overruns(busio_uart_obj_t *self) {
+    return self->rx_overruns;
+}
+
 bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self) {
+    if ( self->tx_buffer.size > 0 ) {
+        return ringbuf_count(&self->tx_buffer) < self->tx_buffer.size - 1;
+    }
     return !nrfx_uarte_tx_in_progress(self->uarte);
 }
@@ -43,6 +43,12 @@ typedef struct {
 
     ringbuf_t rbuf;
     uint8_t rx_char; // EasyDMA buf
+    uint32_t rx_overruns;
+
+    // Characters queued by write(). The ones from iget are being sent by EasyDMA until the TX_DONE
+    // event starts the next chunk.
+    ringbuf_t tx_buffer;
+    uint16_t tx_sending;
 
     uint8_t tx_pin_number;
     uint8_t rx_pin_number;
@@ -156,3 +156,14 @@ digitalio_pull_t common_hal_digitalio_digitalinout_get_pull(
             return PULL_NONE;
     }
 }
+
+bool common_hal_digitalio_digitalinout_get_registers(digitalio_digitalinout_obj_t* self,
+        digitalinout_registers_t* registers) {
+    uint32_t pin = self->pin->number;
+    NRF_GPIO_Type *reg = nrf_gpio_pin_port_decode(&pin);
+    registers->set = &reg->OUTSET;
+    registers->clear = &reg->OUTCLR;
+    registers->input = &reg->IN;
+    registers->mask = 1UL << pin;
+    return true;
+}
@@ -57,6 +57,9 @@ STATIC uint16_t pwm_seq[MP_ARRAY_SIZE(pwms)][CHANNELS_PER_PWM];
 
 static uint8_t never_reset_pwm[MP_ARRAY_SIZE(pwms)];
 
+// PWMs handed out whole by pwmout_allocate_exclusive(). PWMOut won't share their channels.
+static bool exclusive_pwm[MP_ARRAY_SIZE(pwms)];
+
 void common_hal_pulseio_pwmout_never_reset(pulseio_pwmout_obj_t *self) {
     for(size_t i=0; i < MP_ARRAY_SIZE(pwms); i++) {
         NRF_PWM_Type* pwm = pwms[i];
@@ -77,32 +80,58 @@ void common_hal_pulseio_pwmout_reset_ok(pulseio_pwmout_obj_t *self) {
     }
 }
 
+STATIC void reset_single_pwm(size_t i) {
+    NRF_PWM_Type* pwm = pwms[i];
+
+    pwm->ENABLE          = 0;
+    pwm->MODE            = PWM_MODE_UPDOWN_Up;
+    pwm->DECODER         = PWM_DECODER_LOAD_Individual;
+    pwm->LOOP            = 0;
+    pwm->SHORTS          = 0;
+    pwm->PRESCALER       = PWM_PRESCALER_PRESCALER_DIV_1; // default is 500 hz
+    pwm->COUNTERTOP      = (PWM_MAX_FREQ/500);                // default is 500 hz
+
+    pwm->SEQ[0].PTR      = (uint32_t) pwm_seq[i];
+    pwm->SEQ[0].CNT      = CHANNELS_PER_PWM; // default mode is Individual --> count must be 4
+    pwm->SEQ[0].REFRESH  = 0;
+    pwm->SEQ[0].ENDDELAY = 0;
+
+    pwm->SEQ[1].PTR      = 0;
+    pwm->SEQ[1].CNT      = 0;
+    pwm->SEQ[1].REFRESH  = 0;
+    pwm->SEQ[1].ENDDELAY = 0;
+
+    for(int ch =0; ch < CHANNELS_PER_PWM; ch++) {
+        pwm_seq[i][ch] = (1 << 15); // polarity = 0
+    }
+
+    exclusive_pwm[i] = false;
+}
+
 void pwmout_reset(void) {
     for(size_t i=0; i < MP_ARRAY_SIZE(pwms); i++) {
         if (never_reset_pwm[i] > 0) {
             continue;
         }
+        reset_single_pwm(i);
+    }
+}
+
+NRF_PWM_Type* pwmout_allocate_exclusive(void) {
+    for(size_t i=0; i < MP_ARRAY_SIZE(pwms); i++) {
         NRF_PWM_Type* pwm = pwms[i];
+        if (!exclusive_pwm[i] && (pwm->ENABLE & PWM_ENABLE_ENABLE_Msk) == 0) {
+            exclusive_pwm[i] = true;
+            return pwm;
+        }
+    }
+    return NULL;
+}
 
-        pwm->ENABLE          = 0;
-        pwm->MODE            = PWM_MODE_UPDOWN_Up;
-        pwm->DECODER         = PWM_DECODER_LOAD_Individual;
-        pwm->LOOP            = 0;
-        pwm->PRESCALER       = PWM_PRESCALER_PRESCALER_DIV_1; // default is 500 hz
-        pwm->COUNTERTOP      = (PWM_MAX_FREQ/500);                // default is 500 hz
-
-        pwm->SEQ[0].PTR      = (uint32_t) pwm_seq[i];
-        pwm->SEQ[0].CNT      = CHANNELS_PER_PWM; // default mode is Individual --> count must be 4
-        pwm->SEQ[0].REFRESH  = 0;
-        pwm->SEQ[0].ENDDELAY = 0;
-
-        pwm->SEQ[1].PTR      = 0;
-        pwm->SEQ[1].CNT      = 0;
-        pwm->SEQ[1].REFRESH  = 0;
-        pwm->SEQ[1].ENDDELAY = 0;
-
-        for(int ch =0; ch < CHANNELS_PER_PWM; ch++) {
-            pwm_seq[i][ch] = (1 << 15); // polarity = 0
+void pwmout_free_exclusive(NRF_PWM_Type* pwm) {
+    for(size_t i=0; i < MP_ARRAY_SIZE(pwms); i++) {
+        if (pwms[i] == pwm) {
+            reset_single_pwm(i);
         }
     }
 }
@@ -150,6 +179,9 @@ pwmout_result_t common_hal_pulseio_pwmout_construct(pulseio_pwmout_obj_t* self,
     NRF_PWM_Type* pwm;
 
     for (size_t i = 0 ; i < MP_ARRAY_SIZE(pwms); i++) {
+        if (exclusive_pwm[i]) {
+            continue;
+        }
         pwm = pwms[i];
         pwm_already_in_use = pwm->ENABLE & SPIM_ENABLE_ENABLE_Msk;
         if (pwm_already_in_use) {
@@ -238,15 +270,36 @@ void common_hal_pulseio_pwmout_deinit(pulseio_pwmout_obj_t* self) {
     nrf_pwm_disable(pwm);
 }
 
-void common_hal_pulseio_pwmout_set_duty_cycle(pulseio_pwmout_obj_t* self, uint16_t duty_cycle) {
+STATIC void write_duty_cycle(pulseio_pwmout_obj_t* self, uint16_t duty_cycle) {
     self->duty_cycle = duty_cycle;
 
     uint16_t* p_value = ((uint16_t*)self->pwm->SEQ[0].PTR) + self->channel;
     *p_value = ((duty_cycle * self->pwm->COUNTERTOP) / 0xFFFF) | (1 << 15);
+}
 
+void common_hal_pulseio_pwmout_set_duty_cycle(pulseio_pwmout_obj_t* self, uint16_t duty_cycle) {
+    write_duty_cycle(self, duty_cycle);
     self->pwm->TASKS_SEQSTART[0] = 1;
 }
 
+void common_hal_pulseio_pwmout_set_duty_cycles(pulseio_pwmout_obj_t** pwms,
+        const uint16_t* duty_cycles, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        write_duty_cycle(pwms[i], duty_cycles[i]);
+    }
+    // Restart each PWM's sequence once so that channels sharing it pick up
+    // their new values together.
+    for (size_t i = 0; i < count; i++) {
+        bool started = false;
+        for (size_t j = 0; j < i && !started; j++) {
+            started = pwms[j]->pwm == pwms[i]->pwm;
+        }
+        if (!started) {
+            pwms[i]->pwm->TASKS_SEQSTART[0] = 1;
+        }
+    }
+}
+
 uint16_t common_hal_pulseio_pwmout_get_duty_cycle(pulseio_pwmout_obj_t* self) {
     return self->duty_cycle;
 }
@@ -41,5 +41,8 @@ typedef struct {
 } pulseio_pwmout_obj_t;
 
 void pwmout_reset(void);
+// Claims a whole PWM that isn't in use, such as for audio, or returns NULL if there isn't one.
+NRF_PWM_Type* pwmout_allocate_exclusive(void);
+void pwmout_free_exclusive(NRF_PWM_Type* pwm);
 
 #endif // MICROPY_INCLUDED_NRF_COMMON_HAL_PULSEIO_PWMOUT_H
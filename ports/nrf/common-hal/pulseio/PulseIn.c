@@ -37,7 +37,14 @@
 #include "shared-bindings/pulseio/PulseIn.h"
 
 #include "tick.h"
+#include "nrf/timers.h"
 #include "nrfx_gpiote.h"
+#include "nrfx/hal/nrf_ppi.h"
+
+#ifdef SOFTDEVICE_PRESENT
+#include "nrf_sdm.h"
+#include "nrf_soc.h"
+#endif
 
 // obj array to map pin -> self since nrfx hide the mapping
 static pulseio_pulsein_obj_t* _objs[GPIOTE_CH_NUM];
@@ -53,6 +60,95 @@ static int _find_pulsein_obj(pulseio_pulsein_obj_t* obj) {
     return -1;
 }
 
+// Edges are timestamped in hardware when possible: PPI connects each pin's GPIOTE event to a
+// capture task of a shared 16MHz timer, using the capture channel with the same index as the
+// object. The interrupt then only reads the captured value, so its latency doesn't matter.
+// Objects beyond the timer's capture channels fall back to reading the tick in the interrupt.
+static nrfx_timer_t* _capture_timer = NULL;
+#define CAPTURE_TICKS_PER_US 16
+// PPI channels below the ones reserved by the SoftDevice.
+#define CAPTURE_PPI_CHANNEL_FIRST 0
+
+static bool _capture_available(int idx) {
+    return _capture_timer != NULL && idx >= 0 && idx < _capture_timer->cc_channel_count;
+}
+
+static void _capture_timer_handler(nrf_timer_event_t event_type, void *p_context) {
+    // Only capture tasks are used so there are no events to handle.
+}
+
+static void _ppi_enable(uint8_t channel, uint32_t event_address, uint32_t task_address) {
+#ifdef SOFTDEVICE_PRESENT
+    uint8_t sd_en = false;
+    (void) sd_softdevice_is_enabled(&sd_en);
+    if (sd_en) {
+        sd_ppi_channel_assign(channel, (const volatile void*) event_address,
+                              (const volatile void*) task_address);
+        sd_ppi_channel_enable_set(1 << channel);
+        return;
+    }
+#endif
+    nrf_ppi_channel_endpoint_setup((nrf_ppi_channel_t) channel, event_address, task_address);
+    nrf_ppi_channel_enable((nrf_ppi_channel_t) channel);
+}
+
+static void _ppi_disable(uint8_t channel) {
+#ifdef SOFTDEVICE_PRESENT
+    uint8_t sd_en = false;
+    (void) sd_softdevice_is_enabled(&sd_en);
+    if (sd_en) {
+        sd_ppi_channel_enable_clr(1 << channel);
+        return;
+    }
+#endif
+    nrf_ppi_channel_disable((nrf_ppi_channel_t) channel);
+}
+
+// Connect the pin's GPIOTE event to its capture channel. The GPIOTE channel can change whenever
+// the pin is reinitialized so this must follow every nrfx_gpiote_in_init().
+static void _capture_connect(pulseio_pulsein_obj_t* self) {
+    int idx = _find_pulsein_obj(self);
+    if (!_capture_available(idx)) {
+        return;
+    }
+    _ppi_enable(CAPTURE_PPI_CHANNEL_FIRST + idx, nrfx_gpiote_in_event_addr_get(self->pin),
+                nrfx_timer_capture_task_address_get(_capture_timer, (uint32_t) idx));
+}
+
+// Start the capture timer for the first object, unless no timer is free.
+static void _capture_timer_start(void) {
+    if (_capture_timer != NULL) {
+        return;
+    }
+    _capture_timer = nrf_peripherals_allocate_timer();
+    if (_capture_timer == NULL) {
+        return;
+    }
+    nrfx_timer_config_t timer_config = {
+        .frequency = NRF_TIMER_FREQ_16MHz,
+        .mode = NRF_TIMER_MODE_TIMER,
+        .bit_width = NRF_TIMER_BIT_WIDTH_32,
+        .interrupt_priority = NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY,
+        .p_context = NULL,
+    };
+    nrfx_timer_init(_capture_timer, &timer_config, &_capture_timer_handler);
+    nrfx_timer_enable(_capture_timer);
+}
+
+// Stop the capture timer once the last object has gone.
+static void _capture_timer_stop(void) {
+    if (_capture_timer == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < NRFX_ARRAY_SIZE(_objs); i++) {
+        if (_objs[i] != NULL) {
+            return;
+        }
+    }
+    nrf_peripherals_free_timer(_capture_timer);
+    _capture_timer = NULL;
+}
+
 static void _pulsein_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
     // Grab the current time first.
     uint32_t current_us;
@@ -63,21 +159,43 @@ static void _pulsein_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action
     current_us = 1000 - current_us;
 
     pulseio_pulsein_obj_t* self = NULL;
-    for(size_t i = 0; i < NRFX_ARRAY_SIZE(_objs); i++ ) {
-        if ( _objs[i] && _objs[i]->pin == pin ) {
-            self = _objs[i];
+    size_t idx;
+    for(idx = 0; idx < NRFX_ARRAY_SIZE(_objs); idx++ ) {
+        if ( _objs[idx] && _objs[idx]->pin == pin ) {
+            self = _objs[idx];
             break;
         }
     }
     if ( !self ) return;
 
+    bool captured = _capture_available(idx);
+    uint32_t capture = 0;
+    if (captured) {
+        capture = nrfx_timer_capture_get(_capture_timer, (nrf_timer_cc_channel_t) idx);
+    }
+
     if (self->first_edge) {
         // first pulse is opposite state from idle
         bool state = nrf_gpio_pin_read(self->pin);
         if ( self->idle_state != state ) {
             self->first_edge = false;
         }
-    }else {
+    } else if (captured) {
+        uint32_t total_diff = (capture - self->last_capture + CAPTURE_TICKS_PER_US / 2) /
+            CAPTURE_TICKS_PER_US;
+        uint16_t duration = 0xffff;
+        if (total_diff < duration) {
+            duration = total_diff;
+        }
+
+        uint16_t i = (self->start + self->len) % self->maxlen;
+        self->buffer[i] = duration;
+        if (self->len < self->maxlen) {
+            self->len++;
+        } else {
+            self->start++;
+        }
+    } else {
         uint32_t ms_diff = current_ms - self->last_ms;
         uint16_t us_diff = current_us - self->last_us;
         uint32_t total_diff = us_diff;
@@ -106,6 +224,7 @@ static void _pulsein_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action
 
     self->last_ms = current_ms;
     self->last_us = current_us;
+    self->last_capture = capture;
 }
 
 void pulsein_reset(void) {
@@ -114,6 +233,14 @@ void pulsein_reset(void) {
     }
     nrfx_gpiote_init();
 
+    if (_capture_timer != NULL) {
+        for (size_t i = 0; i < _capture_timer->cc_channel_count; i++) {
+            _ppi_disable(CAPTURE_PPI_CHANNEL_FIRST + i);
+        }
+        // timers_reset() frees the timer itself.
+        _capture_timer = NULL;
+    }
+
     memset(_objs, 0, sizeof(_objs));
 }
 
@@ -149,6 +276,8 @@ void common_hal_pulseio_pulsein_construct(pulseio_pulsein_obj_t* self, const mcu
         .skip_gpio_setup = false
     };
     nrfx_gpiote_in_init(self->pin, &cfg, _pulsein_handler);
+    _capture_timer_start();
+    _capture_connect(self);
     nrfx_gpiote_in_event_enable(self->pin, true);
 }
 
@@ -169,7 +298,11 @@ void common_hal_pulseio_pulsein_deinit(pulseio_pulsein_obj_t* self) {
     if ( idx < 0 ) {
         mp_raise_NotImplementedError(NULL);
     }
+    if (_capture_available(idx)) {
+        _ppi_disable(CAPTURE_PPI_CHANNEL_FIRST + idx);
+    }
     _objs[idx] = NULL;
+    _capture_timer_stop();
 
     reset_pin_number(self->pin);
     self->pin = NO_PIN;
@@ -203,6 +336,7 @@ void common_hal_pulseio_pulsein_resume(pulseio_pulsein_obj_t* self, uint16_t tri
             .skip_gpio_setup = false
         };
         nrfx_gpiote_in_init(self->pin, &cfg, _pulsein_handler);
+        _capture_connect(self);
     }
 
     self->first_edge = true;
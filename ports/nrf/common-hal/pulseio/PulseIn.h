@@ -46,6 +46,7 @@ typedef struct {
     volatile uint16_t len;
     volatile uint16_t last_us;
     volatile uint64_t last_ms;
+    volatile uint32_t last_capture;
 } pulseio_pulsein_obj_t;
 
 void pulsein_reset(void);
@@ -141,7 +141,14 @@ void common_hal_pulseio_pulseout_deinit(pulseio_pulseout_obj_t* self) {
     }
 }
 
-void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length) {
+void common_hal_pulseio_pulseout_stop(pulseio_pulseout_obj_t* self) {
+    // Sends finish before returning so there is never anything to stop.
+}
+
+void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self, uint16_t* pulses, uint16_t length, bool loop) {
+    if (loop) {
+        mp_raise_NotImplementedError(translate("loop is not supported"));
+    }
     pulse_array = pulses;
     pulse_array_index = 0;
     pulse_array_length = length;
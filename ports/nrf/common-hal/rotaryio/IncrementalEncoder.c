@@ -27,6 +27,7 @@
 #include "common-hal/rotaryio/IncrementalEncoder.h"
 #include "nrfx_gpiote.h"
 
+#include "py/mphal.h"
 #include "py/runtime.h"
 
 #include <stdio.h>
@@ -60,11 +61,87 @@ static void _intr_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
     }
 }
 
+// The QDEC decodes one encoder on any pins in hardware. It samples the pins every 128us and
+// only interrupts when a report of 10 samples has seen movement.
+static rotaryio_incrementalencoder_obj_t *qdec_encoder = NULL;
+
+// Adds quarter steps to the position, rounding towards zero like the GPIOTE handler.
+static void add_quarters(rotaryio_incrementalencoder_obj_t *self, mp_int_t quarters) {
+    quarters += self->quarter;
+    self->position += quarters / 4;
+    self->quarter = quarters % 4;
+}
+
+void QDEC_IRQHandler(void) {
+    if (NRF_QDEC->EVENTS_REPORTRDY) {
+        NRF_QDEC->EVENTS_REPORTRDY = 0;
+        NRF_QDEC->TASKS_READCLRACC = 1;
+        if (qdec_encoder != NULL) {
+            add_quarters(qdec_encoder, (int32_t) NRF_QDEC->ACCREAD);
+        }
+    }
+}
+
+// Adds the movement the QDEC has counted since its last report.
+static void qdec_update(rotaryio_incrementalencoder_obj_t *self) {
+    NVIC_DisableIRQ(QDEC_IRQn);
+    NRF_QDEC->TASKS_READCLRACC = 1;
+    add_quarters(self, (int32_t) NRF_QDEC->ACCREAD);
+    NVIC_EnableIRQ(QDEC_IRQn);
+}
+
+static void qdec_construct(rotaryio_incrementalencoder_obj_t *self) {
+    // The QDEC doesn't configure the pins itself.
+    nrf_gpio_cfg_input(self->pin_a, NRF_GPIO_PIN_PULLUP);
+    nrf_gpio_cfg_input(self->pin_b, NRF_GPIO_PIN_PULLUP);
+
+    NRF_QDEC->PSEL.A = self->pin_a;
+    NRF_QDEC->PSEL.B = self->pin_b;
+    NRF_QDEC->PSEL.LED = QDEC_PSEL_LED_CONNECT_Disconnected << QDEC_PSEL_LED_CONNECT_Pos;
+    NRF_QDEC->SAMPLEPER = QDEC_SAMPLEPER_SAMPLEPER_128us;
+    NRF_QDEC->REPORTPER = QDEC_REPORTPER_REPORTPER_10Smpl;
+    NRF_QDEC->DBFEN = 0;
+    NRF_QDEC->EVENTS_REPORTRDY = 0;
+    NRF_QDEC->INTENSET = QDEC_INTENSET_REPORTRDY_Msk;
+
+    self->qdec = true;
+    qdec_encoder = self;
+
+    NVIC_SetPriority(QDEC_IRQn, 7);
+    NVIC_ClearPendingIRQ(QDEC_IRQn);
+    NVIC_EnableIRQ(QDEC_IRQn);
+
+    NRF_QDEC->ENABLE = 1;
+    NRF_QDEC->TASKS_START = 1;
+}
+
+static void qdec_deinit(void) {
+    NRF_QDEC->TASKS_STOP = 1;
+    NRF_QDEC->ENABLE = 0;
+    NRF_QDEC->INTENCLR = QDEC_INTENCLR_REPORTRDY_Msk;
+    NVIC_DisableIRQ(QDEC_IRQn);
+    qdec_encoder = NULL;
+}
+
 void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencoder_obj_t* self,
     const mcu_pin_obj_t* pin_a, const mcu_pin_obj_t* pin_b) {
 
     self->pin_a = pin_a->number;
     self->pin_b = pin_b->number;
+    self->quarter = 0;
+    self->position = 0;
+    self->velocity_position = 0;
+    self->velocity_ms = mp_hal_ticks_ms();
+    self->velocity = 0;
+    self->qdec = false;
+
+    // Use the QDEC for the first encoder, and GPIOTE interrupts once it's taken.
+    if (qdec_encoder == NULL) {
+        qdec_construct(self);
+        claim_pin(pin_a);
+        claim_pin(pin_b);
+        return;
+    }
 
     _objs[self->pin_a] = self;
     _objs[self->pin_b] = self;
@@ -93,13 +170,17 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
     if (common_hal_rotaryio_incrementalencoder_deinited(self)) {
         return;
     }
-    _objs[self->pin_a] = NULL;
-    _objs[self->pin_b] = NULL;
-
-    nrfx_gpiote_in_event_disable(self->pin_a);
-    nrfx_gpiote_in_event_disable(self->pin_b);
-    nrfx_gpiote_in_uninit(self->pin_a);
-    nrfx_gpiote_in_uninit(self->pin_b);
+    if (self->qdec) {
+        qdec_deinit();
+    } else {
+        _objs[self->pin_a] = NULL;
+        _objs[self->pin_b] = NULL;
+
+        nrfx_gpiote_in_event_disable(self->pin_a);
+        nrfx_gpiote_in_event_disable(self->pin_b);
+        nrfx_gpiote_in_uninit(self->pin_a);
+        nrfx_gpiote_in_uninit(self->pin_b);
+    }
     reset_pin_number(self->pin_a);
     reset_pin_number(self->pin_b);
     self->pin_a = NO_PIN;
@@ -107,10 +188,35 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
 }
 
 mp_int_t common_hal_rotaryio_incrementalencoder_get_position(rotaryio_incrementalencoder_obj_t* self) {
+    if (self->qdec) {
+        qdec_update(self);
+    }
     return self->position;
 }
 
 void common_hal_rotaryio_incrementalencoder_set_position(rotaryio_incrementalencoder_obj_t* self,
         mp_int_t new_position) {
+    mp_int_t position = common_hal_rotaryio_incrementalencoder_get_position(self);
+    // Move the velocity's starting point along too so setting the position isn't movement.
+    self->velocity_position += new_position - position;
     self->position = new_position;
 }
+
+mp_float_t common_hal_rotaryio_incrementalencoder_get_velocity(rotaryio_incrementalencoder_obj_t* self) {
+    mp_int_t position = common_hal_rotaryio_incrementalencoder_get_position(self);
+    mp_uint_t now = mp_hal_ticks_ms();
+    mp_uint_t elapsed = now - self->velocity_ms;
+    // Keep the last result until some time has passed.
+    if (elapsed > 0) {
+        self->velocity = (position - self->velocity_position) * MICROPY_FLOAT_CONST(1000.0) / elapsed;
+        self->velocity_position = position;
+        self->velocity_ms = now;
+    }
+    return self->velocity;
+}
+
+void incrementalencoder_reset(void) {
+    if (qdec_encoder != NULL) {
+        qdec_deinit();
+    }
+}
@@ -37,10 +37,16 @@ typedef struct {
     uint8_t pin_b;
     uint8_t state;
     int8_t quarter;
+    bool qdec;              // counted by the QDEC peripheral instead of GPIOTE interrupts
     mp_int_t position;
+    // position and time when velocity was last read
+    mp_int_t velocity_position;
+    mp_uint_t velocity_ms;
+    mp_float_t velocity;
 } rotaryio_incrementalencoder_obj_t;
 
 
 void incrementalencoder_interrupt_handler(uint8_t channel);
+void incrementalencoder_reset(void);
 
 #endif // MICROPY_INCLUDED_NRF_COMMON_HAL_ROTARYIO_INCREMENTALENCODER_H
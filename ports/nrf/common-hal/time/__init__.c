@@ -26,12 +26,22 @@
 
 #include "py/mphal.h"
 
+#include "shared-bindings/time/__init__.h"
+
 #include "tick.h"
 
 uint64_t common_hal_time_monotonic(void) {
     return ticks_ms;
 }
 
+uint64_t common_hal_time_monotonic_ns(void) {
+    uint64_t ms;
+    uint32_t us_until_ms;
+    current_tick(&ms, &us_until_ms);
+    // us_until_ms counts down from 1000 to the next tick.
+    return 1000000ull * ms + 1000ull * (1000 - us_until_ms);
+}
+
 void common_hal_time_delay_ms(uint32_t delay) {
     mp_hal_delay_ms(delay);
 }
@@ -30,6 +30,7 @@
 
 #include "ble_drv.h"
 
+#define MICROPY_OPT_MAP_LOOKUP_SITE_CACHE        (1)
 #define MICROPY_PY_COLLECTIONS_ORDEREDDICT       (1)
 #define MICROPY_PY_FUNCTION_ATTRS                (1)
 #define MICROPY_PY_IO                            (1)
@@ -48,13 +49,25 @@
     #endif
 #endif
 
+// Hot paths marked MP_RAMFUNC are copied to RAM with .data by boards/common.ld.
+#define MP_RAMFUNC __attribute__((section(".ramfunc"), noinline))
+
 // 24kiB stack
 #define CIRCUITPY_DEFAULT_STACK_SIZE            0x6000
+#define CIRCUITPY_DEFAULT_PYSTACK_SIZE          4096
+
+// One I2S output followed by one audio output for each of the four PWMs.
+#define AUDIO_DMA_CHANNEL_COUNT                 (5)
+
+// Common, GAP, GATT client, GATT server and L2CAP SoftDevice events each have their own list
+// of event handlers.
+#define BLE_DRV_EVT_GROUP_COUNT                 (5)
 
 #include "py/circuitpy_mpconfig.h"
 
 #define MICROPY_PORT_ROOT_POINTERS \
     CIRCUITPY_COMMON_ROOT_POINTERS \
-    ble_drv_evt_handler_entry_t* ble_drv_evt_handler_entries; \
+    ble_drv_evt_handler_entry_t* ble_drv_evt_handler_entries[BLE_DRV_EVT_GROUP_COUNT]; \
+    mp_obj_t playing_audio[AUDIO_DMA_CHANNEL_COUNT]; \
 
 #endif  // NRF5_MPCONFIGPORT_H__
@@ -4,17 +4,23 @@
 MPY_TOOL_LONGINT_IMPL = -mlongint-impl=mpz
 
 INTERNAL_LIBM = 1
+# Every nRF52 has a Cortex-M4F.
+INTERNAL_LIBM_VFP = 1
 
 USB_SERIAL_NUMBER_LENGTH = 16
 
+# Sizes of the USB serial FIFOs. Boards may override them.
+USB_CDC_RX_BUFSIZE ?= 1024
+USB_CDC_TX_BUFSIZE ?= 1024
+
 # All nRF ports have longints.
 LONGINT_IMPL = MPZ
 
-# No DAC, so no regular audio.
-CIRCUITPY_AUDIOIO = 0
+# No DAC, so audioio.AudioOut outputs PWM.
+CIRCUITPY_AUDIOIO = 1
 
-# No I2S yet.
-CIRCUITPY_AUDIOBUSIO = 0
+# I2SOut only. PDMIn isn't implemented yet.
+CIRCUITPY_AUDIOBUSIO = 1
 
 # No I2CSlave implementation
 CIRCUITPY_I2CSLAVE = 0
@@ -28,6 +34,16 @@ CIRCUITPY_RTC = 1
 # frequencyio not yet implemented
 CIRCUITPY_FREQUENCYIO = 0
 
+# All nRF52840 boards have room for the native emitter.
+ifndef CIRCUITPY_ENABLE_MPY_NATIVE
+CIRCUITPY_ENABLE_MPY_NATIVE = 1
+endif
+
+# They have room for btree as well.
+ifndef CIRCUITPY_BTREE
+CIRCUITPY_BTREE = 1
+endif
+
 # CircuitPython doesn't yet support NFC so force the NFC antenna pins to be GPIO.
 # See https://github.com/adafruit/circuitpython/issues/1300
 # Defined here because system_nrf52840.c doesn't #include any of our own include files.
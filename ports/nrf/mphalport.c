@@ -29,7 +29,9 @@
 
 #include "py/mphal.h"
 #include "py/mpstate.h"
+#include "py/mpthread.h"
 #include "py/gc.h"
+#include "supervisor/port.h"
 
 /*------------------------------------------------------------------*/
 /* delay
@@ -47,6 +49,14 @@ void mp_hal_delay_ms(mp_uint_t delay) {
             break;
         }
         duration = (ticks_ms - start_tick);
-        // TODO(tannewt): Go to sleep for a little while while we wait.
+        if (duration < delay) {
+            #if MICROPY_PY_THREAD
+            // Other threads get the time this one would have slept.
+            if (mp_thread_yield()) {
+                continue;
+            }
+            #endif
+            port_sleep_until_interrupt();
+        }
     }
 }
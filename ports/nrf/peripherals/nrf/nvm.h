@@ -31,4 +31,9 @@
 #define CIRCUITPY_INTERNAL_NVM_SIZE (0)
 #endif
 
+// Flash below the nvm region for bleio's cache of remote GATT tables, one page per peer.
+#ifndef CIRCUITPY_BLE_CONFIG_SIZE
+#define CIRCUITPY_BLE_CONFIG_SIZE (0)
+#endif
+
 void nrf_nvm_safe_flash_page_write(uint32_t page_addr, uint8_t *data);
@@ -31,6 +31,7 @@
 #include "nrfx/hal/nrf_power.h"
 #include "nrfx/drivers/include/nrfx_power.h"
 
+#include "audio_dma.h"
 #include "nrf/cache.h"
 #include "nrf/clocks.h"
 #include "nrf/power.h"
@@ -38,6 +39,8 @@
 
 #include "shared-module/gamepad/__init__.h"
 #include "common-hal/microcontroller/Pin.h"
+#include "common-hal/audiobusio/I2SOut.h"
+#include "common-hal/audioio/AudioOut.h"
 #include "common-hal/bleio/__init__.h"
 #include "common-hal/busio/I2C.h"
 #include "common-hal/busio/SPI.h"
@@ -45,11 +48,25 @@
 #include "common-hal/pulseio/PWMOut.h"
 #include "common-hal/pulseio/PulseOut.h"
 #include "common-hal/pulseio/PulseIn.h"
+#include "common-hal/rotaryio/IncrementalEncoder.h"
 #include "common-hal/rtc/RTC.h"
 #include "tick.h"
 
+#ifdef BLUETOOTH_SD
+#include "nrf_sdm.h"
+#include "nrf_soc.h"
+#endif
+
 #include "shared-bindings/rtc/__init__.h"
 
+#if CIRCUITPY_KEYPAD
+#include "shared-module/keypad/__init__.h"
+#endif
+
+#if CIRCUITPY_PROFILER
+#include "shared-module/profiler/__init__.h"
+#endif
+
 static void power_warning_handler(void) {
     reset_into_safe_mode(BROWNOUT);
 }
@@ -93,17 +110,42 @@ void reset_port(void) {
     i2c_reset();
     spi_reset();
     uart_reset();
+
+    #if CIRCUITPY_AUDIOBUSIO
+    i2sout_reset();
+    #endif
+
+    #if CIRCUITPY_AUDIOIO
+    audioout_reset();
+    #endif
+
+    #if CIRCUITPY_AUDIOIO || CIRCUITPY_AUDIOBUSIO
+    audio_dma_reset();
+    #endif
+
     pwmout_reset();
     pulseout_reset();
     pulsein_reset();
     timers_reset();
 
+    #if CIRCUITPY_ROTARYIO
+    incrementalencoder_reset();
+    #endif
+
     #if CIRCUITPY_RTC
     rtc_reset();
     #endif
 
     bleio_reset();
 
+    #if CIRCUITPY_KEYPAD
+    keypad_reset();
+    #endif
+
+    #if CIRCUITPY_PROFILER
+    profiler_reset();
+    #endif
+
     reset_all_pins();
 }
 
@@ -118,6 +160,24 @@ void reset_cpu(void) {
     NVIC_SystemReset();
 }
 
+void port_sleep_until_interrupt(void) {
+    #ifdef BLUETOOTH_SD
+    uint8_t sd_en = 0;
+    (void) sd_softdevice_is_enabled(&sd_en);
+    if (sd_en) {
+        // The SoftDevice owns the sleep instructions while it is enabled.
+        sd_app_evt_wait();
+        return;
+    }
+    #endif
+    __WFI();
+}
+
+void port_set_performance(mcu_performance_t level) {
+    // The nRF52 CPU only runs at 64 MHz. Sleeping between interrupts is what saves power.
+    (void) level;
+}
+
 extern uint32_t _ebss;
 // Place the word to save just after our BSS section that gets blanked.
 void port_set_saved_word(uint32_t value) {
@@ -90,6 +90,10 @@ bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t length) {
     return nrfx_qspi_read(data, length, address) == NRFX_SUCCESS;
 }
 
+const uint8_t* spi_flash_memory_map(uint32_t address, uint32_t length) {
+    return NULL;
+}
+
 void spi_flash_init(void) {
     // Init QSPI flash
     nrfx_qspi_config_t qspi_cfg = {
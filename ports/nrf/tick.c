@@ -29,6 +29,9 @@
 #include "supervisor/shared/autoreload.h"
 #include "supervisor/filesystem.h"
 #include "shared-module/gamepad/__init__.h"
+#if CIRCUITPY_PROFILER
+#include "shared-module/profiler/__init__.h"
+#endif
 #include "shared-bindings/microcontroller/Processor.h"
 #include "nrf.h"
 
@@ -39,6 +42,7 @@ void SysTick_Handler(void) {
     // SysTick interrupt handler called when the SysTick timer reaches zero
     // (every millisecond).
     ticks_ms += 1;
+    background_tasks_pending = 1;
 
 #if CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS > 0
     filesystem_tick();
@@ -46,6 +50,9 @@ void SysTick_Handler(void) {
 #ifdef CIRCUITPY_AUTORELOAD_DELAY_MS
     autoreload_tick();
 #endif
+#if CIRCUITPY_PROFILER
+    profiler_tick();
+#endif
 #ifdef CIRCUITPY_GAMEPAD_TICKS
     if (!(ticks_ms & CIRCUITPY_GAMEPAD_TICKS)) {
         gamepad_tick();
@@ -74,8 +81,24 @@ void tick_delay(uint32_t us) {
 // us counts down!
 void current_tick(uint64_t* ms, uint32_t* us_until_ms) {
     uint32_t ticks_per_us = common_hal_mcu_processor_get_frequency() / 1000 / 1000;
-    *ms = ticks_ms;
-    *us_until_ms = SysTick->VAL / ticks_per_us;
+
+    // Interrupts can't be turned off around this because the SoftDevice may need them. Read again
+    // if the tick ran in the middle instead.
+    uint64_t current_ms;
+    uint32_t current_us;
+    bool tick_pending;
+    do {
+        current_ms = ticks_ms;
+        current_us = SysTick->VAL;
+        tick_pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    } while (current_ms != ticks_ms);
+    // When called from a higher priority interrupt the counter can wrap before ticks_ms catches
+    // up. A counter that is still near zero wrapped after it was read.
+    if (tick_pending && current_us > ticks_per_us) {
+        current_ms++;
+    }
+    *ms = current_ms;
+    *us_until_ms = current_us / ticks_per_us;
 }
 
 void wait_until(uint64_t ms, uint32_t us_until_ms) {
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "background.h"
+
+#include "lib/utils/interrupt_char.h"
+#include "py/mpstate.h"
+#include "py/runtime.h"
+#include "supervisor/shared/autoreload.h"
+#include "supervisor/shared/performance.h"
+#include "supervisor/usb.h"
+#include "tick.h"
+
+#if CIRCUITPY_DISPLAYIO
+#include "shared-module/displayio/__init__.h"
+#endif
+
+// Never set because the unix port doesn't reload. displayio checks it before refreshing.
+volatile bool reload_requested = false;
+
+static uint64_t last_finished_tick = 0;
+
+static bool running_background_tasks = false;
+
+void run_background_tasks(void) {
+    // The microcontroller ports run the tasks at most once per tick, so do the same rather than on
+    // every backwards jump.
+    if (running_background_tasks || ticks_ms == last_finished_tick) {
+        return;
+    }
+    running_background_tasks = true;
+
+    #if CIRCUITPY_DISPLAYIO
+    displayio_refresh_displays();
+    #endif
+
+    running_background_tasks = false;
+    last_finished_tick = ticks_ms;
+}
+
+// The unix port handles ctrl-c itself so it doesn't use lib/utils/interrupt_char.c.
+bool mp_hal_is_interrupted(void) {
+    return MP_STATE_VM(mp_pending_exception) == MP_OBJ_FROM_PTR(&MP_STATE_VM(mp_kbd_exception));
+}
+
+void usb_background(void) {
+}
+
+// The host's clock speed isn't ours to change.
+void supervisor_performance_boost(void) {
+}
+
+void supervisor_performance_unboost(void) {
+}
@@ -29,6 +29,10 @@
 #include "py/mpstate.h"
 #include "py/gc.h"
 
+#if CIRCUITPY_DISPLAYIO
+#include "shared-module/displayio/__init__.h"
+#endif
+
 #if MICROPY_ENABLE_GC
 
 // Even if we have specific support for an architecture, it is
@@ -164,6 +168,10 @@ void gc_collect(void) {
 
     gc_collect_start();
     gc_collect_regs_and_stack();
+    #if CIRCUITPY_DISPLAYIO
+    // Displays live outside the heap but hold on to the groups they show.
+    gc_collect_root((void**)displays, sizeof(displays) / (sizeof(mp_uint_t)));
+    #endif
     #if MICROPY_PY_THREAD
     mp_thread_gc_others();
     #endif
@@ -70,9 +70,28 @@
 #ifndef MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (1)
 #endif
+#define MICROPY_OPT_MAP_LOOKUP_CACHE (1)
+#define MICROPY_QSTR_HASH_INDEX (1)
+#define MICROPY_OPT_VM_FAST_PATHS (1)
+#define MICROPY_OPT_MAP_LOOKUP_SITE_CACHE (1)
+#define MICROPY_OPT_MPZ_KARATSUBA (1)
+#define MICROPY_OPT_MPZ_MONTGOMERY (1)
+#define MICROPY_GC_INCREMENTAL_SWEEP (1)
+#if !MICROPY_PY_THREAD
+#define MICROPY_GC_COMPACT (1)
+#define MICROPY_OPT_STR_INDEX_CACHE (1)
+#endif
+#define MICROPY_GC_ALLOC_PROFILER (1)
+#define MICROPY_GC_HEAP_SNAPSHOT (1)
+#define MICROPY_GC_MARK_STACK_DIVISOR (64)
+#define MICROPY_GC_MINOR_COLLECT (1)
+#define MICROPY_GC_OBJ_FREELIST (1)
+#define MICROPY_STR_INTERN_CACHE (32)
+#define MICROPY_EXC_MSG_CACHE (8)
 #define MICROPY_CAN_OVERRIDE_BUILTINS (1)
 #define MICROPY_PY_FUNCTION_ATTRS   (1)
 #define MICROPY_PY_DESCRIPTORS      (1)
+#define MICROPY_PY_SLOTS            (1)
 #define MICROPY_PY_BUILTINS_STR_UNICODE (1)
 #define MICROPY_PY_BUILTINS_STR_CENTER (1)
 #define MICROPY_PY_BUILTINS_STR_PARTITION (1)
@@ -122,6 +141,8 @@
 #define MICROPY_PY_UZLIB            (1)
 #define MICROPY_PY_UJSON            (1)
 #define MICROPY_PY_URE              (1)
+#define MICROPY_PY_URE_FINDITER     (1)
+#define MICROPY_PY_URE_CACHE_SIZE   (4)
 #define MICROPY_PY_UHEAPQ           (1)
 #define MICROPY_PY_UTIMEQ           (1)
 #define MICROPY_PY_UHASHLIB         (1)
@@ -168,6 +189,7 @@ extern const struct _mp_print_t mp_stderr_print;
 #define MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF   (1)
 #define MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE  (256)
 #define MICROPY_KBD_EXCEPTION       (1)
+#define MICROPY_PREALLOC_OSERROR    (1)
 #define MICROPY_ASYNC_KBD_INTR      (1)
 
 extern const struct _mp_obj_module_t mp_module_machine;
@@ -179,6 +201,8 @@ extern const struct _mp_obj_module_t mp_module_termios;
 extern const struct _mp_obj_module_t mp_module_socket;
 extern const struct _mp_obj_module_t mp_module_ffi;
 extern const struct _mp_obj_module_t mp_module_jni;
+extern const struct _mp_obj_module_t displayio_module;
+extern const struct _mp_obj_module_t audioio_module;
 
 #if MICROPY_PY_UOS_VFS
 #define MICROPY_PY_UOS_DEF { MP_ROM_QSTR(MP_QSTR_uos), MP_ROM_PTR(&mp_module_uos_vfs) },
@@ -215,6 +239,16 @@ extern const struct _mp_obj_module_t mp_module_jni;
 #else
 #define MICROPY_PY_USELECT_DEF
 #endif
+#if CIRCUITPY_DISPLAYIO
+#define MICROPY_PY_DISPLAYIO_DEF { MP_ROM_QSTR(MP_QSTR_displayio), MP_ROM_PTR(&displayio_module) },
+#else
+#define MICROPY_PY_DISPLAYIO_DEF
+#endif
+#if CIRCUITPY_AUDIOIO
+#define MICROPY_PY_AUDIOIO_DEF { MP_ROM_QSTR(MP_QSTR_audioio), MP_ROM_PTR(&audioio_module) },
+#else
+#define MICROPY_PY_AUDIOIO_DEF
+#endif
 
 #define MICROPY_PORT_BUILTIN_MODULES \
     MICROPY_PY_FFI_DEF \
@@ -225,6 +259,8 @@ extern const struct _mp_obj_module_t mp_module_jni;
     MICROPY_PY_UOS_DEF \
     MICROPY_PY_USELECT_DEF \
     MICROPY_PY_TERMIOS_DEF \
+    MICROPY_PY_DISPLAYIO_DEF \
+    MICROPY_PY_AUDIOIO_DEF \
 
 // type definitions for the specific machine
 
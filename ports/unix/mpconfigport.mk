@@ -40,3 +40,7 @@ MICROPY_PY_JNI = 0
 # Avoid using system libraries, use copies bundled with MicroPython
 # as submodules (currently affects only libffi).
 MICROPY_STANDALONE = 0
+
+# displayio and audioio with host stand-ins for displays and audio output.
+# Use "make sim" rather than setting this directly.
+MICROPY_SIM = 0
@@ -0,0 +1,61 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// This config builds displayio and audioio on the host so that rendering and mixing can be
+// measured and profiled without hardware. Displays draw into displayio.VirtualBus framebuffers and
+// audio is pulled out of audioio.VirtualOut. Classes that need hardware are left out.
+
+#define MICROPY_VFS                    (1)
+#define MICROPY_PY_UOS_VFS             (1)
+
+#define CIRCUITPY_AUDIOIO              (1)
+#define CIRCUITPY_DIGITALIO            (0)
+#define CIRCUITPY_DISPLAYIO            (1)
+#define CIRCUITPY_DISPLAY_LIMIT        (1)
+#define CIRCUITPY_MICROCONTROLLER      (0)
+#define CIRCUITPY_PULSEIO              (0)
+#define CIRCUITPY_SIMULATOR            (1)
+
+#include <mpconfigport.h>
+
+#define MICROPY_READER_VFS             (1)
+#define MICROPY_VFS_POSIX              (1)
+#undef MICROPY_VFS_FAT
+// OnDiskBitmap and WaveFile read through FatFs, so their files must be on a VfsFat block device.
+#define MICROPY_VFS_FAT                (1)
+
+#define mp_type_fileio mp_type_vfs_posix_fileio
+#define mp_type_textio mp_type_vfs_posix_textio
+
+// use vfs's functions for import stat and builtin open
+#define mp_import_stat mp_vfs_import_stat
+#define mp_builtin_open mp_vfs_open
+#define mp_builtin_open_obj mp_vfs_open_obj
+
+// Refresh displays in the background as the microcontroller ports do.
+void run_background_tasks(void);
+#define MICROPY_VM_HOOK_LOOP run_background_tasks();
+#define MICROPY_VM_HOOK_RETURN run_background_tasks();
@@ -29,7 +29,7 @@
 #define CHAR_CTRL_C (3)
 #endif
 
-void mp_hal_set_interrupt_char(char c);
+void mp_hal_set_interrupt_char(int c);
 
 void mp_hal_stdio_mode_raw(void);
 void mp_hal_stdio_mode_orig(void);
@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include "py/objstr.h"
 #include "py/runtime.h"
 
 #include "supervisor/shared/translate.h"
@@ -85,60 +86,105 @@ void mp_arg_check_num_kw_array(size_t n_args, size_t n_kw, size_t n_args_min, si
     }
 }
 
+STATIC void arg_parse_one(const mp_arg_t *allowed, mp_obj_t given_arg, mp_arg_val_t *out_val) {
+    if ((allowed->flags & MP_ARG_KIND_MASK) == MP_ARG_BOOL) {
+        out_val->u_bool = mp_obj_is_true(given_arg);
+    } else if ((allowed->flags & MP_ARG_KIND_MASK) == MP_ARG_INT) {
+        out_val->u_int = mp_obj_get_int(given_arg);
+    } else {
+        assert((allowed->flags & MP_ARG_KIND_MASK) == MP_ARG_OBJ);
+        out_val->u_obj = given_arg;
+    }
+}
+
+NORETURN STATIC void arg_error_required(qstr qst) {
+    if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
+        mp_arg_error_terse_mismatch();
+    } else {
+        mp_raise_TypeError_varg(translate("'%q' argument required"), qst);
+    }
+}
+
+NORETURN STATIC void arg_error_extra_keyword(void) {
+    if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
+        mp_arg_error_terse_mismatch();
+    } else {
+        // TODO better error message
+        mp_raise_TypeError(translate("extra keyword arguments given"));
+    }
+}
+
 void mp_arg_parse_all(size_t n_pos, const mp_obj_t *pos, mp_map_t *kws, size_t n_allowed, const mp_arg_t *allowed, mp_arg_val_t *out_vals) {
-    size_t pos_found = 0, kws_found = 0;
-    for (size_t i = 0; i < n_allowed; i++) {
-        mp_obj_t given_arg;
-        if (i < n_pos) {
-            if (allowed[i].flags & MP_ARG_KW_ONLY) {
-                goto extra_positional;
-            }
-            pos_found++;
-            given_arg = pos[i];
-        } else {
-            mp_map_elem_t *kw = mp_map_lookup(kws, MP_OBJ_NEW_QSTR(allowed[i].qst), MP_MAP_LOOKUP);
-            if (kw == NULL) {
-                if (allowed[i].flags & MP_ARG_REQUIRED) {
-                    if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
-                        mp_arg_error_terse_mismatch();
-                    } else {
-                        mp_raise_TypeError_varg(
-                            translate("'%q' argument required"), allowed[i].qst);
-                    }
-                }
-                out_vals[i] = allowed[i].defval;
-                continue;
-            } else {
-                kws_found++;
-                given_arg = kw->value;
-            }
+    // positional args fill the first slots
+    if (n_pos > n_allowed) {
+        goto extra_positional;
+    }
+    for (size_t i = 0; i < n_pos; i++) {
+        if (allowed[i].flags & MP_ARG_KW_ONLY) {
+            goto extra_positional;
         }
-        if ((allowed[i].flags & MP_ARG_KIND_MASK) == MP_ARG_BOOL) {
-            out_vals[i].u_bool = mp_obj_is_true(given_arg);
-        } else if ((allowed[i].flags & MP_ARG_KIND_MASK) == MP_ARG_INT) {
-            out_vals[i].u_int = mp_obj_get_int(given_arg);
-        } else {
-            assert((allowed[i].flags & MP_ARG_KIND_MASK) == MP_ARG_OBJ);
-            out_vals[i].u_obj = given_arg;
+        arg_parse_one(&allowed[i], pos[i], &out_vals[i]);
+    }
+
+    // the rest start with their defaults, and count those that must be given
+    size_t n_required = 0;
+    for (size_t i = n_pos; i < n_allowed; i++) {
+        out_vals[i] = allowed[i].defval;
+        if (allowed[i].flags & MP_ARG_REQUIRED) {
+            n_required++;
         }
     }
-    if (pos_found < n_pos) {
-        extra_positional:
-        if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
-            mp_arg_error_terse_mismatch();
-        } else {
-            // TODO better error message
-            mp_raise_TypeError(translate("extra positional arguments given"));
+
+    // Match each keyword given to its slot by comparing qstrs with the const
+    // allowed table, rather than looking every allowed name up in the map.
+    // Calls with only positional args skip this entirely.
+    if (kws->used > 0) {
+        for (size_t k = 0; k < kws->alloc; k++) {
+            if (!MP_MAP_SLOT_IS_FILLED(kws, k)) {
+                continue;
+            }
+            mp_obj_t key = kws->table[k].key;
+            qstr qst = MP_QSTR_NULL;
+            if (MP_OBJ_IS_QSTR(key)) {
+                qst = MP_OBJ_QSTR_VALUE(key);
+            } else if (MP_OBJ_IS_STR(key)) {
+                // from a **kwargs dict; a name that isn't a qstr can't be allowed
+                GET_STR_DATA_LEN(key, str, len);
+                qst = qstr_find_strn((const char*)str, len);
+            }
+            size_t i = n_pos;
+            while (i < n_allowed && allowed[i].qst != qst) {
+                i++;
+            }
+            if (i == n_allowed || qst == MP_QSTR_NULL) {
+                // unknown, or for a slot already filled positionally
+                arg_error_extra_keyword();
+            }
+            arg_parse_one(&allowed[i], kws->table[k].value, &out_vals[i]);
+            if (allowed[i].flags & MP_ARG_REQUIRED) {
+                n_required--;
+            }
         }
     }
-    if (kws_found < kws->used) {
-        if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
-            mp_arg_error_terse_mismatch();
-        } else {
-            // TODO better error message
-            mp_raise_TypeError(translate("extra keyword arguments given"));
+
+    if (n_required > 0) {
+        // find the first required arg that wasn't given, for the error message
+        for (size_t i = n_pos; i < n_allowed; i++) {
+            if ((allowed[i].flags & MP_ARG_REQUIRED)
+                && mp_map_lookup(kws, MP_OBJ_NEW_QSTR(allowed[i].qst), MP_MAP_LOOKUP) == NULL) {
+                arg_error_required(allowed[i].qst);
+            }
         }
     }
+    return;
+
+extra_positional:
+    if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
+        mp_arg_error_terse_mismatch();
+    } else {
+        // TODO better error message
+        mp_raise_TypeError(translate("extra positional arguments given"));
+    }
 }
 
 void mp_arg_parse_all_kw_array(size_t n_pos, size_t n_kw, const mp_obj_t *args, size_t n_allowed, const mp_arg_t *allowed, mp_arg_val_t *out_vals) {
@@ -294,6 +294,57 @@ continue2:;
     dump_args(code_state->state, n_state);
 }
 
+// Find the source line of the opcode at ip in the given bytecode, using the
+// line-number table in its code info.  The block and file names are returned
+// through block_name and source_file.
+size_t mp_bytecode_get_source_line(const byte *bytecode, const byte *ip, qstr *block_name, qstr *source_file) {
+    const byte *info = bytecode;
+    info = mp_decode_uint_skip(info); // skip n_state
+    info = mp_decode_uint_skip(info); // skip n_exc_stack
+    info++; // skip scope_params
+    info++; // skip n_pos_args
+    info++; // skip n_kwonly_args
+    info++; // skip n_def_pos_args
+    size_t bc = ip - info;
+    size_t code_info_size = mp_decode_uint_value(info);
+    info = mp_decode_uint_skip(info); // skip code_info_size
+    bc -= code_info_size;
+    #if MICROPY_PERSISTENT_CODE
+    *block_name = info[0] | (info[1] << 8);
+    *source_file = info[2] | (info[3] << 8);
+    info += 4;
+    #else
+    *block_name = mp_decode_uint_value(info);
+    info = mp_decode_uint_skip(info);
+    *source_file = mp_decode_uint_value(info);
+    info = mp_decode_uint_skip(info);
+    #endif
+    size_t source_line = 1;
+    size_t c;
+    while ((c = *info)) {
+        size_t b, l;
+        if ((c & 0x80) == 0) {
+            // 0b0LLBBBBB encoding
+            b = c & 0x1f;
+            l = c >> 5;
+            info += 1;
+        } else {
+            // 0b1LLLBBBB 0bLLLLLLLL encoding (l's LSB in second byte)
+            b = c & 0xf;
+            l = ((c << 4) & 0x700) | info[1];
+            info += 2;
+        }
+        if (bc >= b) {
+            bc -= b;
+            source_line += l;
+        } else {
+            // found source line corresponding to bytecode offset
+            break;
+        }
+    }
+    return source_line;
+}
+
 #if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_PERSISTENT_CODE_SAVE
 
 // The following table encodes the number of bytes that a specific opcode
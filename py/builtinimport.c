@@ -38,8 +38,33 @@
 #include "py/builtin.h"
 #include "py/frozenmod.h"
 
+#if MICROPY_MODULE_COMPILE_CACHE
+#include "py/reader.h"
+#include "py/stream.h"
+#include "extmod/vfs.h"
+#endif
+
 #include "supervisor/shared/translate.h"
 
+#if CIRCUITPY_AUTO_BOOST
+#include "supervisor/shared/performance.h"
+#endif
+
+#if CIRCUITPY_STARTUP_PROFILE
+#include "supervisor/shared/profile.h"
+
+STATIC qstr profile_module_name(mp_obj_t module_obj) {
+    mp_obj_dict_t *globals = mp_obj_module_get_globals(module_obj);
+    return mp_obj_str_get_qstr(mp_obj_dict_get(MP_OBJ_FROM_PTR(globals), MP_OBJ_NEW_QSTR(MP_QSTR___name__)));
+}
+
+#define PROFILE_START(start) uint64_t start = supervisor_profile_ticks()
+#define PROFILE_ADD(stage, module_obj, start) supervisor_profile_add(stage, profile_module_name(module_obj), start)
+#else
+#define PROFILE_START(start)
+#define PROFILE_ADD(stage, module_obj, start)
+#endif
+
 #if MICROPY_DEBUG_VERBOSE // print debugging info
 #define DEBUG_PRINT (1)
 #define DEBUG_printf DEBUG_printf
@@ -149,7 +174,11 @@ STATIC void do_load_from_lexer(mp_obj_t module_obj, mp_lexer_t *lex) {
 
     // parse, compile and execute the module in its context
     mp_obj_dict_t *mod_globals = mp_obj_module_get_globals(module_obj);
+    #if MICROPY_COMP_STREAM_IMPORT
+    mp_parse_compile_execute_stream(lex, mod_globals);
+    #else
     mp_parse_compile_execute(lex, MP_PARSE_FILE_INPUT, mod_globals, mod_globals);
+    #endif
     mp_obj_module_set_globals(module_obj, make_dict_long_lived(mod_globals, 10));
 }
 #endif
@@ -191,7 +220,159 @@ STATIC void do_execute_raw_code(mp_obj_t module_obj, mp_raw_code_t *raw_code, co
 }
 #endif
 
-STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
+#if MICROPY_MODULE_COMPILE_CACHE
+// Compiled .py modules are cached as .mpy files in a hidden directory next to
+// the source, so /lib/foo.py is cached in /lib/.mpy_cache/foo.mpy. Each cache
+// file starts with the size and mtime of the source it was compiled from, and
+// is ignored once either changes. Any failure to read or write the cache (for
+// example because the filesystem is read-only while USB is connected) simply
+// falls back to compiling the source.
+#define COMPILE_CACHE_DIR ".mpy_cache"
+#define COMPILE_CACHE_STAMP_LEN (8)
+
+STATIC bool compile_cache_stamp(const char *file_str, byte *stamp) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_obj_t *items;
+        mp_obj_get_array_fixed_n(mp_vfs_stat(mp_obj_new_str(file_str, strlen(file_str))), 10, &items);
+        uint32_t size = mp_obj_get_int_truncated(items[6]);
+        uint32_t mtime = mp_obj_get_int_truncated(items[8]);
+        nlr_pop();
+        for (size_t i = 0; i < 4; i++) {
+            stamp[i] = size >> (8 * i);
+            stamp[4 + i] = mtime >> (8 * i);
+        }
+        return true;
+    }
+    return false;
+}
+
+STATIC void compile_cache_path(vstr_t *cache, vstr_t *file) {
+    const char *file_str = vstr_str(file);
+    const char *base = file_str + file->len;
+    while (base > file_str && base[-1] != PATH_SEP_CHAR) {
+        base--;
+    }
+    vstr_add_strn(cache, file_str, base - file_str);
+    vstr_add_str(cache, COMPILE_CACHE_DIR);
+    vstr_add_char(cache, PATH_SEP_CHAR);
+    // Replace the trailing "py" with "mpy".
+    vstr_add_strn(cache, base, file_str + file->len - 2 - base);
+    vstr_add_str(cache, "mpy");
+}
+
+STATIC mp_raw_code_t *compile_cache_load(const char *cache_str, const byte *stamp) {
+    mp_raw_code_t *raw_code = NULL;
+    mp_reader_t reader;
+    volatile bool reader_open = false;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_reader_new_file(&reader, cache_str);
+        reader_open = true;
+        bool fresh = true;
+        for (size_t i = 0; i < COMPILE_CACHE_STAMP_LEN; i++) {
+            if (reader.readbyte(reader.data) != stamp[i]) {
+                fresh = false;
+                break;
+            }
+        }
+        if (fresh) {
+            // This also catches caches written by an incompatible version.
+            // The reader is closed once the load completes.
+            raw_code = mp_raw_code_load(&reader);
+        } else {
+            reader.close(reader.data);
+        }
+        nlr_pop();
+    } else if (reader_open) {
+        reader.close(reader.data);
+    }
+    return raw_code;
+}
+
+STATIC void compile_cache_print_strn(void *env, const char *str, size_t len) {
+    mp_stream_write(MP_OBJ_FROM_PTR(env), str, len, MP_STREAM_RW_WRITE);
+}
+
+STATIC void compile_cache_save(vstr_t *cache, const byte *stamp, mp_raw_code_t *raw_code) {
+    size_t cache_len = cache->len;
+    // Write to a temporary file first so that an interrupted write never
+    // leaves a truncated cache behind to be loaded later.
+    vstr_add_str(cache, ".tmp");
+    mp_obj_t tmp_path = mp_obj_new_str(vstr_str(cache), cache->len);
+    mp_obj_t cache_path = mp_obj_new_str(vstr_str(cache), cache_len);
+    vstr_cut_tail_bytes(cache, cache->len - cache_len);
+
+    mp_obj_t volatile f = MP_OBJ_NULL;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        const char *cache_str = vstr_str(cache);
+        const char *dir_end = cache_str + cache_len;
+        while (*--dir_end != PATH_SEP_CHAR) {
+        }
+        mp_obj_t dir_path = mp_obj_new_str(cache_str, dir_end - cache_str);
+        if (mp_import_stat_any(mp_obj_str_get_str(dir_path)) != MP_IMPORT_STAT_DIR) {
+            mp_vfs_mkdir(dir_path);
+        }
+
+        mp_obj_t args[2] = { tmp_path, MP_OBJ_NEW_QSTR(MP_QSTR_wb) };
+        f = mp_vfs_open(2, args, (mp_map_t*)&mp_const_empty_map);
+        mp_print_t print = {MP_OBJ_TO_PTR(f), compile_cache_print_strn};
+        print.print_strn(print.data, (const char*)stamp, COMPILE_CACHE_STAMP_LEN);
+        mp_raw_code_save(raw_code, &print);
+        mp_obj_t f_done = f;
+        f = MP_OBJ_NULL;
+        mp_stream_close(f_done);
+
+        if (mp_import_stat_any(vstr_null_terminated_str(cache)) == MP_IMPORT_STAT_FILE) {
+            mp_vfs_remove(cache_path);
+        }
+        mp_vfs_rename(tmp_path, cache_path);
+        nlr_pop();
+    } else {
+        // Best effort: don't leave a partial temporary file behind.
+        if (nlr_push(&nlr) == 0) {
+            if (f != MP_OBJ_NULL) {
+                mp_stream_close(f);
+            }
+            mp_vfs_remove(tmp_path);
+            nlr_pop();
+        }
+    }
+}
+
+STATIC void do_load_from_compile_cache(mp_obj_t module_obj, vstr_t *file) {
+    char *file_str = vstr_null_terminated_str(file);
+    byte stamp[COMPILE_CACHE_STAMP_LEN];
+    if (!compile_cache_stamp(file_str, stamp)) {
+        do_load_from_lexer(module_obj, mp_lexer_new_from_file(file_str));
+        return;
+    }
+
+    vstr_t cache;
+    vstr_init(&cache, file->len + sizeof(COMPILE_CACHE_DIR) + 6);
+    compile_cache_path(&cache, file);
+    PROFILE_START(load_start);
+    mp_raw_code_t *raw_code = compile_cache_load(vstr_null_terminated_str(&cache), stamp);
+    if (raw_code == NULL) {
+        mp_lexer_t *lex = mp_lexer_new_from_file(file_str);
+        qstr source_name = lex->source_name;
+        mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+        raw_code = mp_compile_to_raw_code(&parse_tree, source_name, MP_EMIT_OPT_NONE, false);
+        PROFILE_ADD("compile", module_obj, load_start);
+        PROFILE_START(save_start);
+        compile_cache_save(&cache, stamp, raw_code);
+        PROFILE_ADD("cache_save", module_obj, save_start);
+    } else {
+        PROFILE_ADD("cache_load", module_obj, load_start);
+    }
+    vstr_clear(&cache);
+
+    do_execute_raw_code(module_obj, raw_code, file_str);
+}
+#endif
+
+STATIC void do_load_module(mp_obj_t module_obj, vstr_t *file) {
     #if MICROPY_MODULE_FROZEN || MICROPY_PERSISTENT_CODE_LOAD || MICROPY_ENABLE_COMPILER
     char *file_str = vstr_null_terminated_str(file);
     #endif
@@ -232,7 +413,9 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     // the correct format and, if so, load and execute the file.
     #if MICROPY_PERSISTENT_CODE_LOAD
     if (file_str[file->len - 3] == 'm') {
+        PROFILE_START(load_start);
         mp_raw_code_t *raw_code = mp_raw_code_load_file(file_str);
+        PROFILE_ADD("load", module_obj, load_start);
         do_execute_raw_code(module_obj, raw_code, file_str);
         return;
     }
@@ -241,8 +424,12 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     // If we can compile scripts then load the file and compile and execute it.
     #if MICROPY_ENABLE_COMPILER
     {
+        #if MICROPY_MODULE_COMPILE_CACHE
+        do_load_from_compile_cache(module_obj, file);
+        #else
         mp_lexer_t *lex = mp_lexer_new_from_file(file_str);
         do_load_from_lexer(module_obj, lex);
+        #endif
         return;
     }
     #else
@@ -252,6 +439,27 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     #endif
 }
 
+STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
+    // The import time includes running the module, and so any modules it imports.
+    PROFILE_START(import_start);
+    #if CIRCUITPY_AUTO_BOOST
+    // Import at full speed when the CPU has been slowed down, even if the module raises.
+    supervisor_performance_boost();
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        do_load_module(module_obj, file);
+        nlr_pop();
+    } else {
+        supervisor_performance_unboost();
+        nlr_jump(nlr.ret_val);
+    }
+    supervisor_performance_unboost();
+    #else
+    do_load_module(module_obj, file);
+    #endif
+    PROFILE_ADD("import", module_obj, import_start);
+}
+
 STATIC void chop_component(const char *start, const char **end) {
     const char *p = *end;
     while (p > start) {
@@ -77,6 +77,7 @@ ifneq ($(FROZEN_MPY_DIRS),)
 CFLAGS += -DMICROPY_QSTR_EXTRA_POOL=mp_qstr_frozen_const_pool
 CFLAGS += -DMICROPY_MODULE_FROZEN_MPY
 CFLAGS += -Wno-error=lto-type-mismatch
+MPY_CROSS_FLAGS += -mconst-tuple
 endif
 
 
@@ -102,6 +103,9 @@ endif
 ifeq ($(CIRCUITPY_ANALOGIO),1)
 SRC_PATTERNS += analogio/%
 endif
+ifeq ($(CIRCUITPY_ARRAYOPS),1)
+SRC_PATTERNS += arrayops/%
+endif
 ifeq ($(CIRCUITPY_AUDIOBUSIO),1)
 SRC_PATTERNS += audiobusio/%
 endif
@@ -138,6 +142,12 @@ endif
 ifeq ($(CIRCUITPY_I2CSLAVE),1)
 SRC_PATTERNS += i2cslave/%
 endif
+ifeq ($(CIRCUITPY_INTERRUPTIO),1)
+SRC_PATTERNS += interruptio/%
+endif
+ifeq ($(CIRCUITPY_KEYPAD),1)
+SRC_PATTERNS += keypad/%
+endif
 ifeq ($(CIRCUITPY_MATH),1)
 SRC_PATTERNS += math/%
 endif
@@ -159,6 +169,9 @@ endif
 ifeq ($(CIRCUITPY_PIXELBUF),1)
 SRC_PATTERNS += _pixelbuf/%
 endif
+ifeq ($(CIRCUITPY_PROFILER),1)
+SRC_PATTERNS += profiler/%
+endif
 ifeq ($(CIRCUITPY_PULSEIO),1)
 SRC_PATTERNS += pulseio/%
 endif
@@ -195,6 +208,9 @@ endif
 ifeq ($(CIRCUITPY_UHEAP),1)
 SRC_PATTERNS += uheap/%
 endif
+ifeq ($(CIRCUITPY_USB_CDC_DATA),1)
+SRC_PATTERNS += usb_cdc/%
+endif
 ifeq ($(CIRCUITPY_USB_HID),1)
 SRC_PATTERNS += usb_hid/%
 endif
@@ -241,6 +257,8 @@ $(filter $(SRC_PATTERNS), \
 	frequencyio/FrequencyIn.c \
 	i2cslave/I2CSlave.c \
 	i2cslave/__init__.c \
+	interruptio/PinInterrupt.c \
+	interruptio/__init__.c \
 	microcontroller/Pin.c \
 	microcontroller/Processor.c \
 	microcontroller/__init__.c \
@@ -271,7 +289,9 @@ $(filter $(SRC_PATTERNS), \
 	digitalio/Direction.c \
 	digitalio/DriveMode.c \
 	digitalio/Pull.c \
+	displayio/RefreshStats.c \
 	fontio/Glyph.c \
+	microcontroller/Performance.c \
 	microcontroller/RunMode.c \
 	math/__init__.c \
 	supervisor/__init__.c \
@@ -297,9 +317,13 @@ $(filter $(SRC_PATTERNS), \
 	_stage/Layer.c \
 	_stage/Text.c \
 	_stage/__init__.c \
+	arrayops/__init__.c \
 	audioio/__init__.c \
+	audioio/BiquadFilter.c \
+	audioio/Echo.c \
 	audioio/Mixer.c \
 	audioio/RawSample.c \
+	audioio/Synthesizer.c \
 	audioio/WaveFile.c \
 	bitbangio/I2C.c \
 	bitbangio/OneWire.c \
@@ -307,6 +331,7 @@ $(filter $(SRC_PATTERNS), \
 	bitbangio/__init__.c \
 	board/__init__.c \
 	busio/OneWire.c \
+	digitalio/Port.c \
 	displayio/Bitmap.c \
 	displayio/ColorConverter.c \
 	displayio/Display.c \
@@ -314,20 +339,32 @@ $(filter $(SRC_PATTERNS), \
 	displayio/Group.c \
 	displayio/OnDiskBitmap.c \
 	displayio/Palette.c \
+	displayio/RLEBitmap.c \
 	displayio/Shape.c \
 	displayio/TileGrid.c \
 	displayio/__init__.c \
 	fontio/BuiltinFont.c \
+	fontio/PCFFont.c \
 	fontio/__init__.c \
 	gamepad/GamePad.c \
 	gamepad/__init__.c \
 	gamepadshift/GamePadShift.c \
 	gamepadshift/__init__.c \
+	interruptio/TimerInterrupt.c \
+	interruptio/__init__.c \
+	keypad/Event.c \
+	keypad/EventQueue.c \
+	keypad/KeyMatrix.c \
+	keypad/ShiftRegisterKeys.c \
+	keypad/__init__.c \
 	os/__init__.c \
+	profiler/__init__.c \
 	random/__init__.c \
 	socket/__init__.c \
 	network/__init__.c \
 	storage/__init__.c \
+	storage/RAMDisk.c \
+	struct/Struct.c \
 	struct/__init__.c \
 	terminalio/Terminal.c \
 	terminalio/__init__.c \
@@ -344,7 +381,6 @@ $(addprefix lib/,\
 	libm/roundf.c \
 	libm/fmodf.c \
 	libm/nearbyintf.c \
-	libm/ef_sqrt.c \
 	libm/kf_rem_pio2.c \
 	libm/kf_sin.c \
 	libm/kf_cos.c \
@@ -360,4 +396,10 @@ $(addprefix lib/,\
 	libm/atanf.c \
 	libm/atan2f.c \
 	)
+# Chips with a single precision FPU do sqrtf in one instruction.
+ifeq ($(INTERNAL_LIBM_VFP),1)
+SRC_LIBM += lib/libm/thumb_vfp_sqrtf.c
+else
+SRC_LIBM += lib/libm/ef_sqrt.c
+endif
 endif
@@ -28,6 +28,7 @@
 // sure that the same feature set and settings are used, such as in atmel-samd
 // and nrf.
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifndef __INCLUDED_MPCONFIG_CIRCUITPY_H
@@ -57,21 +58,32 @@
 #define MICROPY_COMP_TRIPLE_TUPLE_ASSIGN (0)
 #define MICROPY_DEBUG_PRINTERS           (0)
 #define MICROPY_EMIT_INLINE_THUMB        (0)
-#define MICROPY_EMIT_THUMB               (0)
+// Enables @micropython.native and @micropython.viper. Set per port/board in *.mk files.
+#define MICROPY_EMIT_THUMB               (CIRCUITPY_ENABLE_MPY_NATIVE)
 #define MICROPY_EMIT_X64                 (0)
 #define MICROPY_ENABLE_DOC_STRING        (0)
 #define MICROPY_ENABLE_FINALISER         (1)
 #define MICROPY_ENABLE_GC                (1)
+// Python frames and call arguments go on their own stack, allocated by the
+// supervisor, instead of alloca on the C stack or the heap.
+#define MICROPY_ENABLE_PYSTACK           (1)
+#ifndef CIRCUITPY_DEFAULT_PYSTACK_SIZE
+#define CIRCUITPY_DEFAULT_PYSTACK_SIZE   (1536)
+#endif
 #define MICROPY_ENABLE_SOURCE_LINE       (1)
 #define MICROPY_ERROR_REPORTING          (MICROPY_ERROR_REPORTING_NORMAL)
+#define MICROPY_FLOAT_FAST_DECIMAL       (1)
 #define MICROPY_FLOAT_HIGH_QUALITY_HASH  (0)
 #define MICROPY_FLOAT_IMPL               (MICROPY_FLOAT_IMPL_FLOAT)
 #define MICROPY_GC_ALLOC_THRESHOLD       (0)
 #define MICROPY_HELPER_LEXER_UNIX        (0)
 #define MICROPY_HELPER_REPL              (1)
 #define MICROPY_KBD_EXCEPTION            (1)
+#define MICROPY_PREALLOC_OSERROR         (1)
 #define MICROPY_MEM_STATS                (0)
 #define MICROPY_NONSTANDARD_TYPECODES    (0)
+#define MICROPY_OPT_MAP_LOOKUP_CACHE     (1)
+#define MICROPY_OPT_STR_INDEX_CACHE      (1)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
 
 #define MICROPY_PY_ARRAY                 (1)
@@ -136,6 +148,7 @@
 #define MICROPY_VFS                 (1)
 #define MICROPY_VFS_FAT             (MICROPY_VFS)
 #define MICROPY_READER_VFS          (MICROPY_VFS)
+#define MICROPY_READER_VFS_BUF_SIZE (FILESYSTEM_BLOCK_SIZE)
 
 
 // type definitions for the specific machine
@@ -159,6 +172,11 @@ typedef long mp_off_t;
 
 #define MP_PLAT_PRINT_STRN(str, len) mp_hal_stdout_tx_strn_cooked(str, len)
 
+// Native code stays around as long as the function that owns it, so allocate it
+// long-lived. gc_make_long_lived can't move it later because the function's const
+// table points into the same block.
+#define MP_PLAT_ALLOC_EXEC(min_size, ptr, size) do { *ptr = m_malloc(min_size, true); *size = min_size; } while (0)
+
 #define mp_type_fileio mp_type_vfs_fat_fileio
 #define mp_type_textio mp_type_vfs_fat_textio
 
@@ -186,6 +204,7 @@ typedef long mp_off_t;
 #define MICROPY_PY_BUILTINS_STR_CENTER        (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_STR_PARTITION     (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_STR_SPLITLINES    (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PY_SLOTS                      (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_UERRNO                     (CIRCUITPY_FULL_BUILD)
 // Opposite setting is deliberate.
 #define MICROPY_PY_UERRNO_ERRORCODE           (!CIRCUITPY_FULL_BUILD)
@@ -193,6 +212,29 @@ typedef long mp_off_t;
 #define MICROPY_PY_URE_MATCH_GROUPS           (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_URE_MATCH_SPAN_START_END   (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_URE_SUB                    (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PY_URE_FINDITER               (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PY_URE_CACHE_SIZE             (4)
+#define MICROPY_PY_USELECT                    (CIRCUITPY_SELECT)
+#define MICROPY_PY_UTIMEQ                     (CIRCUITPY_SELECT)
+#define MICROPY_OPT_COMPUTED_GOTO             (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_VM_FAST_PATHS             (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_MPZ_KARATSUBA             (CIRCUITPY_FULL_BUILD)
+#define MICROPY_OPT_MPZ_MONTGOMERY            (CIRCUITPY_FULL_BUILD)
+#define MICROPY_QSTR_HASH_INDEX               (CIRCUITPY_FULL_BUILD)
+#define MICROPY_STR_INTERN_CACHE              (CIRCUITPY_FULL_BUILD ? 32 : 0)
+#define MICROPY_EXC_MSG_CACHE                 (CIRCUITPY_FULL_BUILD ? 8 : 0)
+#define MICROPY_GC_INCREMENTAL_SWEEP          (CIRCUITPY_FULL_BUILD)
+#define MICROPY_GC_COMPACT                    (CIRCUITPY_FULL_BUILD && !CIRCUITPY_THREAD)
+#define MICROPY_GC_MARK_STACK_DIVISOR         (CIRCUITPY_FULL_BUILD ? 64 : 0)
+#define MICROPY_GC_MAX_AREAS                  (4)
+#define MICROPY_GC_MINOR_COLLECT              (CIRCUITPY_FULL_BUILD)
+#define MICROPY_GC_OBJ_FREELIST               (CIRCUITPY_FULL_BUILD)
+#define MICROPY_GC_HEAP_SNAPSHOT              (CIRCUITPY_FULL_BUILD)
+#define MICROPY_FATFS_SECTOR_CACHE            (CIRCUITPY_FULL_BUILD ? 4 : 0)
+#define MICROPY_MODULE_COMPILE_CACHE          (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PERSISTENT_CODE_SAVE          (MICROPY_MODULE_COMPILE_CACHE)
+// Imports run at full speed when microcontroller.cpu.performance has slowed the CPU.
+#define CIRCUITPY_AUTO_BOOST                  (1)
 
 // LONGINT_IMPL_xxx are defined in the Makefile.
 //
@@ -221,6 +263,13 @@ extern const struct _mp_obj_module_t analogio_module;
 #define ANALOGIO_MODULE
 #endif
 
+#if CIRCUITPY_ARRAYOPS
+#define ARRAYOPS_MODULE        { MP_OBJ_NEW_QSTR(MP_QSTR_arrayops), (mp_obj_t)&arrayops_module },
+extern const struct _mp_obj_module_t arrayops_module;
+#else
+#define ARRAYOPS_MODULE
+#endif
+
 #if CIRCUITPY_AUDIOBUSIO
 #define AUDIOBUSIO_MODULE        { MP_OBJ_NEW_QSTR(MP_QSTR_audiobusio), (mp_obj_t)&audiobusio_module },
 extern const struct _mp_obj_module_t audiobusio_module;
@@ -342,6 +391,30 @@ extern const struct _mp_obj_module_t i2cslave_module;
 #define I2CSLAVE_MODULE
 #endif
 
+#if CIRCUITPY_INTERRUPTIO
+extern const struct _mp_obj_module_t interruptio_module;
+#define INTERRUPTIO_MODULE     { MP_OBJ_NEW_QSTR(MP_QSTR_interruptio), (mp_obj_t)&interruptio_module },
+// Interrupt handlers queue Python calls through the scheduler. Ports must also define
+// MICROPY_BEGIN_ATOMIC_SECTION so queueing from an interrupt is safe.
+#define MICROPY_ENABLE_SCHEDULER (1)
+#define MICROPY_SCHEDULER_DEPTH (8)
+#define CIRCUITPY_INTERRUPTIO_TIMERS (4)
+#define INTERRUPTIO_ROOT_POINTERS mp_obj_t timer_interrupts[CIRCUITPY_INTERRUPTIO_TIMERS];
+#else
+#define INTERRUPTIO_MODULE
+#define INTERRUPTIO_ROOT_POINTERS
+#endif
+
+#if CIRCUITPY_KEYPAD
+extern const struct _mp_obj_module_t keypad_module;
+#define KEYPAD_MODULE          { MP_OBJ_NEW_QSTR(MP_QSTR_keypad), (mp_obj_t)&keypad_module },
+#define CIRCUITPY_KEYPAD_SCANNERS (4)
+#define KEYPAD_ROOT_POINTERS mp_obj_t keypad_scanners[CIRCUITPY_KEYPAD_SCANNERS];
+#else
+#define KEYPAD_MODULE
+#define KEYPAD_ROOT_POINTERS
+#endif
+
 #if CIRCUITPY_MATH
 extern const struct _mp_obj_module_t math_module;
 #define MATH_MODULE            { MP_OBJ_NEW_QSTR(MP_QSTR_math), (mp_obj_t)&math_module },
@@ -408,6 +481,16 @@ extern const struct _mp_obj_module_t pixelbuf_module;
 #define PIXELBUF_MODULE
 #endif
 
+#if CIRCUITPY_PROFILER
+extern const struct _mp_obj_module_t profiler_module;
+#define PROFILER_MODULE        { MP_OBJ_NEW_QSTR(MP_QSTR_profiler), (mp_obj_t)&profiler_module },
+// Samples are attributed to the line of the bytecode being run.
+#define MICROPY_TRACK_CODE_STATE (1)
+#define CIRCUITPY_PROFILER_LINES (64)
+#else
+#define PROFILER_MODULE
+#endif
+
 #if CIRCUITPY_PULSEIO
 extern const struct _mp_obj_module_t pulseio_module;
 #define PULSEIO_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_pulseio), (mp_obj_t)&pulseio_module },
@@ -494,6 +577,13 @@ extern const struct _mp_obj_module_t uheap_module;
 #define UHEAP_MODULE
 #endif
 
+#if CIRCUITPY_USB_CDC_DATA
+extern const struct _mp_obj_module_t usb_cdc_module;
+#define USB_CDC_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_usb_cdc),(mp_obj_t)&usb_cdc_module },
+#else
+#define USB_CDC_MODULE
+#endif
+
 #if CIRCUITPY_USB_HID
 extern const struct _mp_obj_module_t usb_hid_module;
 #define USB_HID_MODULE         { MP_OBJ_NEW_QSTR(MP_QSTR_usb_hid),(mp_obj_t)&usb_hid_module },
@@ -534,6 +624,12 @@ extern const struct _mp_obj_module_t ustack_module;
 #define RE_MODULE
 #endif
 
+#if MICROPY_PY_USELECT
+#define SELECT_MODULE { MP_ROM_QSTR(MP_QSTR_select), MP_ROM_PTR(&mp_module_uselect) },
+#else
+#define SELECT_MODULE
+#endif
+
 // Define certain native modules with weak links so they can be replaced with Python
 // implementations. This list may grow over time.
 #define MICROPY_PORT_BUILTIN_MODULE_WEAK_LINKS \
@@ -554,6 +650,7 @@ extern const struct _mp_obj_module_t ustack_module;
 // Some are omitted because they're in MICROPY_PORT_BUILTIN_MODULE_WEAK_LINKS above.
 #define MICROPY_PORT_BUILTIN_MODULES_STRONG_LINKS \
     ANALOGIO_MODULE \
+    ARRAYOPS_MODULE \
     AUDIOBUSIO_MODULE \
     AUDIOIO_MODULE \
     BITBANGIO_MODULE \
@@ -569,7 +666,9 @@ extern const struct _mp_obj_module_t ustack_module;
     GAMEPAD_MODULE \
     GAMEPADSHIFT_MODULE \
     I2CSLAVE_MODULE \
+    INTERRUPTIO_MODULE \
     JSON_MODULE \
+    KEYPAD_MODULE \
     MATH_MODULE \
     MICROCONTROLLER_MODULE \
     NEOPIXEL_WRITE_MODULE \
@@ -578,18 +677,21 @@ extern const struct _mp_obj_module_t ustack_module;
       WIZNET_MODULE \
     PEW_MODULE \
     PIXELBUF_MODULE \
+    PROFILER_MODULE \
     PULSEIO_MODULE \
     RANDOM_MODULE \
     RE_MODULE \
     ROTARYIO_MODULE \
     RTC_MODULE \
     SAMD_MODULE \
+    SELECT_MODULE \
     STAGE_MODULE \
     STORAGE_MODULE \
     STRUCT_MODULE \
     SUPERVISOR_MODULE \
     TOUCHIO_MODULE \
     UHEAP_MODULE \
+    USB_CDC_MODULE \
     USB_HID_MODULE \
     USB_MIDI_MODULE \
     USTACK_MODULE \
@@ -619,6 +721,8 @@ extern const struct _mp_obj_module_t ustack_module;
     vstr_t *repl_line; \
     mp_obj_t rtc_time_source; \
     GAMEPAD_ROOT_POINTERS \
+    INTERRUPTIO_ROOT_POINTERS \
+    KEYPAD_ROOT_POINTERS \
     mp_obj_t pew_singleton; \
     mp_obj_t terminal_tilegrid_tiles; \
     BOARD_I2C_ROOT_POINTER \
@@ -628,13 +732,39 @@ extern const struct _mp_obj_module_t ustack_module;
 
 void run_background_tasks(void);
 
+// Set every tick, and by anything else that wants its background work done soon.
+// run_background_tasks() clears it. The VM hooks only test it so tight loops don't call into
+// every background task on every backwards jump and return.
+extern volatile uint8_t background_tasks_pending;
+
+#if CIRCUITPY_THREAD
+// Threads take turns whenever the GIL is released. See supervisor/shared/thread.c.
+#define MICROPY_PY_THREAD (1)
+#define MICROPY_PY_THREAD_GIL (1)
+#define MICROPY_MPTHREADPORT_H "supervisor/shared/thread.h"
+bool mp_thread_yield(void);
+#define MICROPY_THREAD_YIELD() mp_thread_yield()
+#else
 // TODO: Used in wiznet5k driver, but may not be needed in the long run.
 #define MICROPY_THREAD_YIELD()
+#endif
+
+#define MICROPY_VM_HOOK_LOOP if (background_tasks_pending) { run_background_tasks(); }
+#define MICROPY_VM_HOOK_RETURN if (background_tasks_pending) { run_background_tasks(); }
+
+void port_sleep_until_interrupt(void);
 
-#define MICROPY_VM_HOOK_LOOP run_background_tasks();
-#define MICROPY_VM_HOOK_RETURN run_background_tasks();
+// Long running C loops use this to keep background work going.
+#define MICROPY_EVENT_POLL_HOOK MICROPY_VM_HOOK_LOOP
+// Blocking waits such as select.poll() also take queued callbacks and ctrl-C and then sleep until
+// the next interrupt. The tick makes that at most a millisecond, so timeouts stay accurate.
+#define MICROPY_EVENT_WAIT_HOOK \
+    mp_handle_pending(); \
+    port_sleep_until_interrupt();
 
 #define CIRCUITPY_AUTORELOAD_DELAY_MS 500
+// Saves that arrive in several pieces can stretch the delay up to this long.
+#define CIRCUITPY_AUTORELOAD_MAX_DELAY_MS (4 * CIRCUITPY_AUTORELOAD_DELAY_MS)
 #define CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS 1000
 #define CIRCUITPY_BOOT_OUTPUT_FILE "/boot_out.txt"
 
@@ -51,6 +51,11 @@ CIRCUITPY_ANALOGIO = 1
 endif
 CFLAGS += -DCIRCUITPY_ANALOGIO=$(CIRCUITPY_ANALOGIO)
 
+ifndef CIRCUITPY_ARRAYOPS
+CIRCUITPY_ARRAYOPS = $(CIRCUITPY_FULL_BUILD)
+endif
+CFLAGS += -DCIRCUITPY_ARRAYOPS=$(CIRCUITPY_ARRAYOPS)
+
 ifndef CIRCUITPY_AUDIOBUSIO
 CIRCUITPY_AUDIOBUSIO = $(CIRCUITPY_FULL_BUILD)
 endif
@@ -77,6 +82,19 @@ CIRCUITPY_BOARD = 1
 endif
 CFLAGS += -DCIRCUITPY_BOARD=$(CIRCUITPY_BOARD)
 
+# btree key-value store on a file, from the lib/berkeley-db-1.xx submodule. Explicitly enabled
+# for ports with room for it.
+ifndef CIRCUITPY_BTREE
+CIRCUITPY_BTREE = 0
+endif
+CFLAGS += -DCIRCUITPY_BTREE=$(CIRCUITPY_BTREE)
+MICROPY_PY_BTREE = $(CIRCUITPY_BTREE)
+# Default to pages the size of a FAT sector so that writing a page rewrites one sector. There is
+# no C heap, so Berkeley DB allocates its pages on the GC heap.
+BTREE_PAGESIZE ?= 512
+BTREE_DEFS_EXTRA += -DDEFPSIZE=$(BTREE_PAGESIZE) -DMINCACHE=3 -DMICROPY_BTREE_GC_MALLOC=1 \
+	-Dmalloc=btree_malloc -Dcalloc=btree_calloc -Drealloc=btree_realloc -Dfree=btree_free
+
 ifndef CIRCUITPY_BUSIO
 CIRCUITPY_BUSIO = 1
 endif
@@ -92,6 +110,13 @@ CIRCUITPY_DISPLAYIO = $(CIRCUITPY_FULL_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_DISPLAYIO=$(CIRCUITPY_DISPLAYIO)
 
+# Enables the Thumb-2 native emitter (@micropython.native and @micropython.viper).
+# Costs about 20kB of flash so only turned on by ports for the larger chips.
+ifndef CIRCUITPY_ENABLE_MPY_NATIVE
+CIRCUITPY_ENABLE_MPY_NATIVE = 0
+endif
+CFLAGS += -DCIRCUITPY_ENABLE_MPY_NATIVE=$(CIRCUITPY_ENABLE_MPY_NATIVE)
+
 ifndef CIRCUITPY_FREQUENCYIO
 CIRCUITPY_FREQUENCYIO = $(CIRCUITPY_FULL_BUILD)
 endif
@@ -112,6 +137,17 @@ CIRCUITPY_I2CSLAVE = $(CIRCUITPY_FULL_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_I2CSLAVE=$(CIRCUITPY_I2CSLAVE)
 
+# Opt-in: turns on the scheduler so interrupts can queue Python calls.
+ifndef CIRCUITPY_INTERRUPTIO
+CIRCUITPY_INTERRUPTIO = 0
+endif
+CFLAGS += -DCIRCUITPY_INTERRUPTIO=$(CIRCUITPY_INTERRUPTIO)
+
+ifndef CIRCUITPY_KEYPAD
+CIRCUITPY_KEYPAD = $(CIRCUITPY_FULL_BUILD)
+endif
+CFLAGS += -DCIRCUITPY_KEYPAD=$(CIRCUITPY_KEYPAD)
+
 ifndef CIRCUITPY_MATH
 CIRCUITPY_MATH = 1
 endif
@@ -148,6 +184,23 @@ CIRCUITPY_PIXELBUF = $(CIRCUITPY_FULL_BUILD)
 endif
 CFLAGS += -DCIRCUITPY_PIXELBUF=$(CIRCUITPY_PIXELBUF)
 
+# Opt-in sampling profiler. Keeping track of the running bytecode costs a little on every call.
+ifndef CIRCUITPY_PROFILER
+CIRCUITPY_PROFILER = 0
+endif
+CFLAGS += -DCIRCUITPY_PROFILER=$(CIRCUITPY_PROFILER)
+
+# Optional profile of the C functions the CPU is busiest in, used to move the hottest into RAM on
+# ports whose linker scripts include ramfunc_profile.ld. See tools/gen_ramfunc_profile.py for the
+# format. The ELF that was profiled supplies function sizes. Build from scratch after changing it.
+ifndef CIRCUITPY_RAMFUNC_PROFILE_ELF
+CIRCUITPY_RAMFUNC_PROFILE_ELF = $(basename $(CIRCUITPY_RAMFUNC_PROFILE)).elf
+endif
+# Bytes of RAM the profiled functions may take.
+ifndef CIRCUITPY_RAMFUNC_BUDGET
+CIRCUITPY_RAMFUNC_BUDGET = 8192
+endif
+
 ifndef CIRCUITPY_PULSEIO
 CIRCUITPY_PULSEIO = 1
 endif
@@ -177,11 +230,31 @@ endif
 CFLAGS += -DCIRCUITPY_SAMD=$(CIRCUITPY_SAMD)
 
 # Currently always off.
+# select.poll() plus utimeq and time.ticks_*(), the C pieces an asyncio style event loop needs.
+ifndef CIRCUITPY_SELECT
+CIRCUITPY_SELECT = $(CIRCUITPY_FULL_BUILD)
+endif
+CFLAGS += -DCIRCUITPY_SELECT=$(CIRCUITPY_SELECT)
+
+# Host only classes that stand in for hardware: displayio.VirtualBus and audioio.VirtualOut.
+# Only the unix port's sim build turns it on.
+ifndef CIRCUITPY_SIMULATOR
+CIRCUITPY_SIMULATOR = 0
+endif
+CFLAGS += -DCIRCUITPY_SIMULATOR=$(CIRCUITPY_SIMULATOR)
+
 ifndef CIRCUITPY_STAGE
 CIRCUITPY_STAGE = 0
 endif
 CFLAGS += -DCIRCUITPY_STAGE=$(CIRCUITPY_STAGE)
 
+# Time each phase of starting and reloading and each import. The times are printed after code.py
+# finishes and are available from supervisor.startup_profile().
+ifndef CIRCUITPY_STARTUP_PROFILE
+CIRCUITPY_STARTUP_PROFILE = 0
+endif
+CFLAGS += -DCIRCUITPY_STARTUP_PROFILE=$(CIRCUITPY_STARTUP_PROFILE)
+
 ifndef CIRCUITPY_STORAGE
 CIRCUITPY_STORAGE = 1
 endif
@@ -197,6 +270,12 @@ CIRCUITPY_SUPERVISOR = 1
 endif
 CFLAGS += -DCIRCUITPY_SUPERVISOR=$(CIRCUITPY_SUPERVISOR)
 
+# Cooperative _thread. It can't be combined with heap compaction.
+ifndef CIRCUITPY_THREAD
+CIRCUITPY_THREAD = 0
+endif
+CFLAGS += -DCIRCUITPY_THREAD=$(CIRCUITPY_THREAD)
+
 ifndef CIRCUITPY_TIME
 CIRCUITPY_TIME = 1
 endif
@@ -218,6 +297,12 @@ CIRCUITPY_USB_HID = 1
 endif
 CFLAGS += -DCIRCUITPY_USB_HID=$(CIRCUITPY_USB_HID)
 
+# Second USB serial interface for binary data. Off by default because it uses two more endpoints.
+ifndef CIRCUITPY_USB_CDC_DATA
+CIRCUITPY_USB_CDC_DATA = 0
+endif
+CFLAGS += -DCIRCUITPY_USB_CDC_DATA=$(CIRCUITPY_USB_CDC_DATA)
+
 ifndef CIRCUITPY_USB_MIDI
 CIRCUITPY_USB_MIDI = 1
 endif
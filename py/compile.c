@@ -34,6 +34,7 @@
 #include "py/emit.h"
 #include "py/compile.h"
 #include "py/runtime.h"
+#include "py/objtuple.h"
 #include "py/asmbase.h"
 
 #include "supervisor/shared/translate.h"
@@ -262,7 +263,120 @@ STATIC void compile_delete_id(compiler_t *comp, qstr qst) {
     }
 }
 
+STATIC mp_obj_t get_const_object(mp_parse_node_struct_t *pns);
+STATIC bool c_tuple_const(mp_parse_node_t pn, mp_parse_node_struct_t *pns_list, mp_obj_t *o);
+
+// Whether pn is a constant that can be an item of a constant tuple; if o is
+// not NULL then the item's object is also created and stored there.
+STATIC bool c_tuple_const_item(mp_parse_node_t pn, mp_obj_t *o) {
+    mp_obj_t obj;
+    if (MP_PARSE_NODE_IS_SMALL_INT(pn)) {
+        mp_int_t arg = MP_PARSE_NODE_LEAF_SMALL_INT(pn);
+        obj = MP_OBJ_NEW_SMALL_INT(arg);
+        #if MICROPY_DYNAMIC_COMPILER
+        mp_uint_t sign_mask = -(1 << (mp_dynamic_compiler.small_int_bits - 1));
+        if ((arg & sign_mask) != 0 && (arg & sign_mask) != sign_mask && o != NULL) {
+            // doesn't fit in the target runtime's small-int
+            obj = mp_obj_new_int_from_ll(arg);
+        }
+        #endif
+    } else if (MP_PARSE_NODE_IS_LEAF(pn)) {
+        uintptr_t arg = MP_PARSE_NODE_LEAF_ARG(pn);
+        switch (MP_PARSE_NODE_LEAF_KIND(pn)) {
+            case MP_PARSE_NODE_STRING:
+                obj = MP_OBJ_NEW_QSTR(arg);
+                break;
+            case MP_PARSE_NODE_BYTES:
+                if (o == NULL) {
+                    return true;
+                } else {
+                    size_t len;
+                    const byte *data = qstr_data(arg, &len);
+                    obj = mp_obj_new_bytes(data, len);
+                }
+                break;
+            case MP_PARSE_NODE_TOKEN:
+                if (arg == MP_TOKEN_KW_NONE) {
+                    obj = mp_const_none;
+                } else if (arg == MP_TOKEN_KW_FALSE) {
+                    obj = mp_const_false;
+                } else if (arg == MP_TOKEN_KW_TRUE) {
+                    obj = mp_const_true;
+                } else if (arg == MP_TOKEN_ELLIPSIS) {
+                    obj = MP_OBJ_FROM_PTR(&mp_const_ellipsis_obj);
+                } else {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pn, PN_const_object)) {
+        obj = get_const_object((mp_parse_node_struct_t*)pn);
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pn, PN_atom_paren)) {
+        // a nested tuple, laid out as in compile_atom_paren
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t*)pn;
+        if (MP_PARSE_NODE_IS_NULL(pns->nodes[0])) {
+            return c_tuple_const(MP_PARSE_NODE_NULL, NULL, o);
+        }
+        pns = (mp_parse_node_struct_t*)pns->nodes[0];
+        if (MP_PARSE_NODE_IS_STRUCT(pns->nodes[1])) {
+            mp_parse_node_struct_t *pns2 = (mp_parse_node_struct_t*)pns->nodes[1];
+            if (MP_PARSE_NODE_STRUCT_KIND(pns2) == PN_testlist_comp_3b) {
+                return c_tuple_const(pns->nodes[0], NULL, o);
+            } else if (MP_PARSE_NODE_STRUCT_KIND(pns2) == PN_testlist_comp_3c) {
+                return c_tuple_const(pns->nodes[0], pns2, o);
+            } else if (MP_PARSE_NODE_STRUCT_KIND(pns2) == PN_comp_for) {
+                return false;
+            }
+        }
+        return c_tuple_const(MP_PARSE_NODE_NULL, pns, o);
+    } else {
+        return false;
+    }
+    if (o != NULL) {
+        *o = obj;
+    }
+    return true;
+}
+
+// Whether the tuple with items pn and pns_list (as passed to c_tuple) is made
+// only of constants; if o is not NULL then the tuple is also created.
+STATIC bool c_tuple_const(mp_parse_node_t pn, mp_parse_node_struct_t *pns_list, mp_obj_t *o) {
+    size_t first = MP_PARSE_NODE_IS_NULL(pn) ? 0 : 1;
+    size_t n = pns_list == NULL ? 0 : MP_PARSE_NODE_STRUCT_NUM_NODES(pns_list);
+    mp_obj_tuple_t *tuple = NULL;
+    if (o != NULL) {
+        tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(first + n, NULL));
+        *o = MP_OBJ_FROM_PTR(tuple);
+    }
+    if (first && !c_tuple_const_item(pn, tuple == NULL ? NULL : &tuple->items[0])) {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!c_tuple_const_item(pns_list->nodes[i], tuple == NULL ? NULL : &tuple->items[first + i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 STATIC void c_tuple(compiler_t *comp, mp_parse_node_t pn, mp_parse_node_struct_t *pns_list) {
+    if (MICROPY_COMP_CONST_TUPLE_DYNAMIC
+        && (!MP_PARSE_NODE_IS_NULL(pn) || pns_list != NULL)
+        && c_tuple_const(pn, pns_list, NULL)) {
+        // load the tuple as a single constant object
+        // (but only create the actual object on the last pass)
+        if (comp->pass != MP_PASS_EMIT) {
+            EMIT_ARG(load_const_obj, mp_const_none);
+        } else {
+            mp_obj_t tuple;
+            c_tuple_const(pn, pns_list, &tuple);
+            EMIT_ARG(load_const_obj, tuple);
+        }
+        return;
+    }
+
     int total = 0;
     if (!MP_PARSE_NODE_IS_NULL(pn)) {
         compile_node(comp, pn);
@@ -1231,7 +1345,35 @@ STATIC void compile_assert_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
     EMIT_ARG(label_assign, l_end);
 }
 
+// With -O2, "if cond: break" and "if cond: continue" with nothing to unwind
+// compile to a single conditional jump instead of jumping over a jump.
+STATIC bool compile_if_break_cont(compiler_t *comp, mp_parse_node_struct_t *pns) {
+    if (MP_STATE_VM(mp_optimise_value) < 2
+        || !(MP_PARSE_NODE_IS_NULL(pns->nodes[2]) && MP_PARSE_NODE_IS_NULL(pns->nodes[3]))
+        || comp->cur_except_level != comp->break_continue_except_level) {
+        return false;
+    }
+    uint label;
+    if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], PN_break_stmt)) {
+        label = comp->break_label;
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], PN_continue_stmt)) {
+        label = comp->continue_label;
+    } else {
+        return false;
+    }
+    if (label == INVALID_LABEL || (label & MP_EMIT_BREAK_FROM_FOR)) {
+        // let compile_break_cont_stmt report the error, or pop the iterator
+        return false;
+    }
+    c_if_cond(comp, pns->nodes[0], true, label);
+    return true;
+}
+
 STATIC void compile_if_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
+    if (compile_if_break_cont(comp, pns)) {
+        return;
+    }
+
     uint l_end = comp_next_label(comp);
 
     // optimisation: don't emit anything when "if False"
@@ -3259,7 +3401,7 @@ STATIC void scope_compute_things(scope_t *scope) {
                     id_info_t temp = *id_param; *id_param = *id; *id = temp;
                 }
                 break;
-            } else if (id_param == NULL && id->flags == ID_FLAG_IS_PARAM) {
+            } else if (id_param == NULL && (id->flags & (ID_FLAG_IS_PARAM | ID_FLAG_IS_STAR_PARAM | ID_FLAG_IS_DBL_STAR_PARAM)) == ID_FLAG_IS_PARAM) {
                 id_param = id;
             }
         }
@@ -3327,6 +3469,48 @@ STATIC void scope_compute_things(scope_t *scope) {
     }
 }
 
+// A parameter that's closed over but never rebound, either in its own function or through
+// nonlocal in an inner one, doesn't need a cell: closures can capture its value directly and
+// every scope loads it as a fast local.  Scopes are linked parents first.
+STATIC void scope_compute_by_value(scope_t *scope_head) {
+    for (scope_t *s = scope_head; s != NULL; s = s->next) {
+        for (int i = 0; i < s->id_info_len; i++) {
+            id_info_t *id = &s->id_info[i];
+            if (id->kind == ID_INFO_KIND_CELL && (id->flags & (ID_FLAG_IS_PARAM | ID_FLAG_IS_MODIFIED)) == ID_FLAG_IS_PARAM) {
+                id->flags |= ID_FLAG_IS_BY_VALUE;
+            }
+        }
+    }
+
+    // a store to a free variable rebinds the cell in the scope that owns it
+    for (scope_t *s = scope_head; s != NULL; s = s->next) {
+        for (int i = 0; i < s->id_info_len; i++) {
+            id_info_t *id = &s->id_info[i];
+            if (id->kind == ID_INFO_KIND_FREE && (id->flags & ID_FLAG_IS_MODIFIED)) {
+                for (scope_t *p = s->parent; p != NULL; p = p->parent) {
+                    id_info_t *id2 = scope_find(p, id->qst);
+                    if (id2 != NULL && id2->kind != ID_INFO_KIND_FREE) {
+                        id2->flags &= ~ID_FLAG_IS_BY_VALUE;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (scope_t *s = scope_head; s != NULL; s = s->next) {
+        for (int i = 0; i < s->id_info_len; i++) {
+            id_info_t *id = &s->id_info[i];
+            if (id->kind == ID_INFO_KIND_FREE) {
+                id_info_t *id2 = scope_find(s->parent, id->qst);
+                if (id2 != NULL && (id2->flags & ID_FLAG_IS_BY_VALUE)) {
+                    id->flags |= ID_FLAG_IS_BY_VALUE;
+                }
+            }
+        }
+    }
+}
+
 #if !MICROPY_PERSISTENT_CODE_SAVE
 STATIC
 #endif
@@ -3372,6 +3556,9 @@ mp_raw_code_t *mp_compile_to_raw_code(mp_parse_tree_t *parse_tree, qstr source_f
     for (scope_t *s = comp->scope_head; s != NULL && comp->compile_error == MP_OBJ_NULL; s = s->next) {
         scope_compute_things(s);
     }
+    if (comp->compile_error == MP_OBJ_NULL) {
+        scope_compute_by_value(comp->scope_head);
+    }
 
     // set max number of labels now that it's calculated
     emit_bc_set_max_num_labels(emit_bc, max_num_labels);
@@ -50,5 +50,9 @@ mp_raw_code_t *mp_compile_to_raw_code(mp_parse_tree_t *parse_tree, qstr source_f
 
 // this is implemented in runtime.c
 mp_obj_t mp_parse_compile_execute(mp_lexer_t *lex, mp_parse_input_kind_t parse_input_kind, mp_obj_dict_t *globals, mp_obj_dict_t *locals);
+#if MICROPY_COMP_STREAM_IMPORT
+// runs file input in globals one top-level statement at a time
+void mp_parse_compile_execute_stream(mp_lexer_t *lex, mp_obj_dict_t *globals);
+#endif
 
 #endif // MICROPY_INCLUDED_PY_COMPILE_H
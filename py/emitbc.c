@@ -39,6 +39,9 @@
 #define BYTES_FOR_INT ((BYTES_PER_WORD * 8 + 6) / 7)
 #define DUMMY_DATA_SIZE (BYTES_FOR_INT)
 
+// with -O2, the number of labels at one offset that are recorded for jump threading
+#define MAX_LABELS_HERE (4)
+
 struct _emit_t {
     // Accessed as mp_obj_t, so must be aligned as such, and we rely on the
     // memory allocator returning a suitably aligned pointer.
@@ -47,6 +50,7 @@ struct _emit_t {
 
     pass_kind_t pass : 8;
     mp_uint_t last_emit_was_return_value : 8;
+    mp_uint_t code_is_dead : 8;
 
     int stack_size;
 
@@ -58,6 +62,15 @@ struct _emit_t {
     mp_uint_t max_num_labels;
     mp_uint_t *label_offsets;
 
+    // with -O2, for each label that is directly followed by an unconditional
+    // jump this holds the label jumped to, otherwise -1
+    mp_uint_t *label_jumps;
+    // with -O2, whether each label is the target of reachable code, as found
+    // by MP_PASS_STACK_SIZE and then relied on by the later passes
+    byte *label_used;
+    mp_uint_t num_labels_here;
+    mp_uint_t labels_here[MAX_LABELS_HERE];
+
     size_t code_info_offset;
     size_t code_info_size;
     size_t bytecode_offset;
@@ -80,10 +93,18 @@ emit_t *emit_bc_new(void) {
 void emit_bc_set_max_num_labels(emit_t *emit, mp_uint_t max_num_labels) {
     emit->max_num_labels = max_num_labels;
     emit->label_offsets = m_new(mp_uint_t, emit->max_num_labels);
+    if (MP_STATE_VM(mp_optimise_value) >= 2) {
+        emit->label_jumps = m_new(mp_uint_t, emit->max_num_labels);
+        emit->label_used = m_new(byte, emit->max_num_labels);
+    }
 }
 
 void emit_bc_free(emit_t *emit) {
     m_del(mp_uint_t, emit->label_offsets, emit->max_num_labels);
+    if (emit->label_jumps != NULL) {
+        m_del(mp_uint_t, emit->label_jumps, emit->max_num_labels);
+        m_del(byte, emit->label_used, emit->max_num_labels);
+    }
     m_del_obj(emit_t, emit);
 }
 
@@ -171,6 +192,11 @@ STATIC void emit_write_code_info_bytes_lines(emit_t *emit, mp_uint_t bytes_to_sk
 // all functions must go through this one to emit byte code
 STATIC byte *emit_get_cur_to_write_bytecode(emit_t *emit, int num_bytes_to_write) {
     //printf("emit %d\n", num_bytes_to_write);
+    if (emit->code_is_dead) {
+        // unreachable code is dropped, but still goes through the stack accounting
+        return emit->dummy_data;
+    }
+    emit->num_labels_here = 0;
     if (emit->pass < MP_PASS_EMIT) {
         emit->bytecode_offset += num_bytes_to_write;
         return emit->dummy_data;
@@ -254,7 +280,9 @@ STATIC void emit_write_bytecode_byte_obj(emit_t *emit, byte b, mp_obj_t obj) {
     #else
     // aligns the pointer so it is friendly to GC
     emit_write_bytecode_byte(emit, b);
-    emit->bytecode_offset = (size_t)MP_ALIGN(emit->bytecode_offset, sizeof(mp_obj_t));
+    if (!emit->code_is_dead) {
+        emit->bytecode_offset = (size_t)MP_ALIGN(emit->bytecode_offset, sizeof(mp_obj_t));
+    }
     mp_obj_t *c = (mp_obj_t*)emit_get_cur_to_write_bytecode(emit, sizeof(mp_obj_t));
     // Verify thar c is already uint-aligned
     assert(c == MP_ALIGN(c, sizeof(mp_obj_t)));
@@ -270,7 +298,9 @@ STATIC void emit_write_bytecode_byte_raw_code(emit_t *emit, byte b, mp_raw_code_
     #else
     // aligns the pointer so it is friendly to GC
     emit_write_bytecode_byte(emit, b);
-    emit->bytecode_offset = (size_t)MP_ALIGN(emit->bytecode_offset, sizeof(void*));
+    if (!emit->code_is_dead) {
+        emit->bytecode_offset = (size_t)MP_ALIGN(emit->bytecode_offset, sizeof(void*));
+    }
     void **c = (void**)emit_get_cur_to_write_bytecode(emit, sizeof(void*));
     // Verify thar c is already uint-aligned
     assert(c == MP_ALIGN(c, sizeof(void*)));
@@ -278,11 +308,18 @@ STATIC void emit_write_bytecode_byte_raw_code(emit_t *emit, byte b, mp_raw_code_
     #endif
 }
 
+STATIC void emit_bc_use_label(emit_t *emit, mp_uint_t label) {
+    if (emit->pass == MP_PASS_STACK_SIZE && emit->label_used != NULL && !emit->code_is_dead) {
+        emit->label_used[label] = true;
+    }
+}
+
 // unsigned labels are relative to ip following this instruction, stored as 16 bits
 STATIC void emit_write_bytecode_byte_unsigned_label(emit_t *emit, byte b1, mp_uint_t label) {
     mp_uint_t bytecode_offset;
     if (emit->pass < MP_PASS_EMIT) {
         bytecode_offset = 0;
+        emit_bc_use_label(emit, label);
     } else {
         bytecode_offset = emit->label_offsets[label] - emit->bytecode_offset - 3;
     }
@@ -292,12 +329,31 @@ STATIC void emit_write_bytecode_byte_unsigned_label(emit_t *emit, byte b1, mp_ui
     c[2] = bytecode_offset >> 8;
 }
 
+// with -O2, follow a chain of jumps to jumps through to its final label
+STATIC mp_uint_t emit_bc_thread_label(emit_t *emit, mp_uint_t label) {
+    // the bound stops a loop that jumps to itself, eg "while True: pass"
+    for (int i = 0; i < 8 && emit->label_jumps[label] != (mp_uint_t)-1; i++) {
+        label = emit->label_jumps[label];
+    }
+    return label;
+}
+
 // signed labels are relative to ip following this instruction, stored as 16 bits, in excess
 STATIC void emit_write_bytecode_byte_signed_label(emit_t *emit, byte b1, mp_uint_t label) {
     int bytecode_offset;
     if (emit->pass < MP_PASS_EMIT) {
         bytecode_offset = 0;
+        emit_bc_use_label(emit, label);
+        if (b1 == MP_BC_JUMP && emit->label_jumps != NULL && !emit->code_is_dead) {
+            // the labels just assigned all lead straight to this jump
+            for (mp_uint_t i = 0; i < emit->num_labels_here; i++) {
+                emit->label_jumps[emit->labels_here[i]] = label;
+            }
+        }
     } else {
+        if (emit->label_jumps != NULL) {
+            label = emit_bc_thread_label(emit, label);
+        }
         bytecode_offset = emit->label_offsets[label] - emit->bytecode_offset - 3 + 0x8000;
     }
     byte *c = emit_get_cur_to_write_bytecode(emit, 3);
@@ -310,6 +366,8 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->pass = pass;
     emit->stack_size = 0;
     emit->last_emit_was_return_value = false;
+    emit->code_is_dead = false;
+    emit->num_labels_here = 0;
     emit->scope = scope;
     emit->last_source_line_offset = 0;
     emit->last_source_line = 1;
@@ -319,6 +377,12 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
         memset(emit->label_offsets, -1, emit->max_num_labels * sizeof(mp_uint_t));
     }
     #endif
+    if (pass < MP_PASS_EMIT && emit->label_jumps != NULL) {
+        memset(emit->label_jumps, -1, emit->max_num_labels * sizeof(mp_uint_t));
+        if (pass == MP_PASS_STACK_SIZE) {
+            memset(emit->label_used, 0, emit->max_num_labels);
+        }
+    }
     emit->bytecode_offset = 0;
     emit->code_info_offset = 0;
 
@@ -358,7 +422,7 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     // bytecode prelude: initialise closed over variables
     for (int i = 0; i < scope->id_info_len; i++) {
         id_info_t *id = &scope->id_info[i];
-        if (id->kind == ID_INFO_KIND_CELL) {
+        if (id->kind == ID_INFO_KIND_CELL && !(id->flags & ID_FLAG_IS_BY_VALUE)) {
             assert(id->local_num < 255);
             emit_write_bytecode_byte(emit, id->local_num); // write the local which should be converted to a cell
         }
@@ -468,6 +532,15 @@ static inline void emit_bc_pre(emit_t *emit, mp_int_t stack_size_delta) {
     mp_emit_bc_adjust_stack_size(emit, stack_size_delta);
 }
 
+// Called after an instruction that never falls through.  With -O2 the code
+// that follows, up to the next label, can't be reached and isn't written out.
+// The same decision is made in every pass so label offsets stay consistent.
+STATIC void emit_bc_end_of_flow(emit_t *emit) {
+    if (MP_STATE_VM(mp_optimise_value) >= 2) {
+        emit->code_is_dead = true;
+    }
+}
+
 void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t source_line) {
     //printf("source: line %d -> %d  offset %d -> %d\n", emit->last_source_line, source_line, emit->last_source_line_offset, emit->bytecode_offset);
 #if MICROPY_ENABLE_SOURCE_LINE
@@ -494,6 +567,14 @@ void mp_emit_bc_label_assign(emit_t *emit, mp_uint_t l) {
         return;
     }
     assert(l < emit->max_num_labels);
+    // code after a label that is jumped to is reachable again; until
+    // MP_PASS_STACK_SIZE has found the jumps, assume every label is
+    if (emit->pass == MP_PASS_STACK_SIZE || emit->label_used == NULL || emit->label_used[l]) {
+        emit->code_is_dead = false;
+    }
+    if (emit->num_labels_here < MAX_LABELS_HERE) {
+        emit->labels_here[emit->num_labels_here++] = l;
+    }
     if (emit->pass < MP_PASS_EMIT) {
         // assign label offset
         assert(emit->label_offsets[l] == (mp_uint_t)-1);
@@ -681,6 +762,7 @@ void mp_emit_bc_rot_three(emit_t *emit) {
 void mp_emit_bc_jump(emit_t *emit, mp_uint_t label) {
     emit_bc_pre(emit, 0);
     emit_write_bytecode_byte_signed_label(emit, MP_BC_JUMP, label);
+    emit_bc_end_of_flow(emit);
 }
 
 void mp_emit_bc_pop_jump_if(emit_t *emit, bool cond, mp_uint_t label) {
@@ -717,6 +799,7 @@ void mp_emit_bc_unwind_jump(emit_t *emit, mp_uint_t label, mp_uint_t except_dept
         emit_write_bytecode_byte_signed_label(emit, MP_BC_UNWIND_JUMP, label & ~MP_EMIT_BREAK_FROM_FOR);
         emit_write_bytecode_byte(emit, ((label & MP_EMIT_BREAK_FROM_FOR) ? 0x80 : 0) | except_depth);
     }
+    emit_bc_end_of_flow(emit);
 }
 
 void mp_emit_bc_setup_block(emit_t *emit, mp_uint_t label, int kind) {
@@ -885,12 +968,14 @@ void mp_emit_bc_return_value(emit_t *emit) {
     emit_bc_pre(emit, -1);
     emit->last_emit_was_return_value = true;
     emit_write_bytecode_byte(emit, MP_BC_RETURN_VALUE);
+    emit_bc_end_of_flow(emit);
 }
 
 void mp_emit_bc_raise_varargs(emit_t *emit, mp_uint_t n_args) {
     assert(n_args <= 2);
     emit_bc_pre(emit, -n_args);
     emit_write_bytecode_byte_byte(emit, MP_BC_RAISE_VARARGS, n_args);
+    emit_bc_end_of_flow(emit);
 }
 
 void mp_emit_bc_yield(emit_t *emit, int kind) {
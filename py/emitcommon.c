@@ -53,6 +53,7 @@ void mp_emit_common_get_id_for_modification(scope_t *scope, qstr qst) {
         // rebind as a local variable
         id->kind = ID_INFO_KIND_LOCAL;
     }
+    id->flags |= ID_FLAG_IS_MODIFIED;
 }
 
 void mp_emit_common_id_op(emit_t *emit, const mp_emit_method_table_id_ops_t *emit_method_table, scope_t *scope, qstr qst) {
@@ -66,7 +67,7 @@ void mp_emit_common_id_op(emit_t *emit, const mp_emit_method_table_id_ops_t *emi
         emit_method_table->global(emit, qst, MP_EMIT_IDOP_GLOBAL_NAME);
     } else if (id->kind == ID_INFO_KIND_GLOBAL_EXPLICIT) {
         emit_method_table->global(emit, qst, MP_EMIT_IDOP_GLOBAL_GLOBAL);
-    } else if (id->kind == ID_INFO_KIND_LOCAL) {
+    } else if (id->kind == ID_INFO_KIND_LOCAL || (id->flags & ID_FLAG_IS_BY_VALUE)) {
         emit_method_table->local(emit, qst, id->local_num, MP_EMIT_IDOP_LOCAL_FAST);
     } else {
         assert(id->kind == ID_INFO_KIND_CELL || id->kind == ID_INFO_KIND_FREE);
@@ -401,7 +401,7 @@ STATIC void emit_native_end_pass(emit_t *emit) {
         // bytecode prelude: initialise closed over variables
         for (int i = 0; i < emit->scope->id_info_len; i++) {
             id_info_t *id = &emit->scope->id_info[i];
-            if (id->kind == ID_INFO_KIND_CELL) {
+            if (id->kind == ID_INFO_KIND_CELL && !(id->flags & ID_FLAG_IS_BY_VALUE)) {
                 assert(id->local_num < 255);
                 mp_asm_base_data(&emit->as->base, 1, id->local_num); // write the local which should be converted to a cell
             }
@@ -445,7 +445,7 @@ STATIC void emit_native_end_pass(emit_t *emit) {
 
         mp_emit_glue_assign_native(emit->scope->raw_code,
             emit->do_viper_types ? MP_CODE_NATIVE_VIPER : MP_CODE_NATIVE_PY,
-            f, f_len, (mp_uint_t*)((byte*)f + emit->const_table_offset),
+            f, f_len, (mp_uint_t*)(void*)((byte*)f + emit->const_table_offset),
             emit->scope->num_pos_args, emit->scope->scope_flags, type_sig);
     }
 }
@@ -28,8 +28,10 @@
 #if MICROPY_FLOAT_IMPL != MICROPY_FLOAT_IMPL_NONE
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
 #include "py/formatfloat.h"
 
@@ -89,6 +91,421 @@ static inline int fp_isless1(float x) { union floatbits fb = {x}; return fb.u <
 
 #endif
 
+#if MICROPY_FLOAT_FAST_DECIMAL
+
+// Conversion between floats and decimal with integer arithmetic. Intermediate values are held
+// as a 64 bit mantissa with its top bit set and a binary exponent, which is enough to get every
+// digit of a single precision float right without the software float operations the generic
+// code uses.
+typedef struct _ext_float_t {
+    uint64_t m;
+    int e;
+    bool inexact;
+} ext_float_t;
+
+// 10^(16 * i) for i = -4 to 3, truncated so that an inexact result is never too big
+static const ext_float_t pow10_big[] = {
+    {0xa87fea27a539e9a5ULL, -276, true},
+    {0xbb127c53b17ec159ULL, -223, true},
+    {0xcfb11ead453994baULL, -170, true},
+    {0xe69594bec44de15bULL, -117, true},
+    {0x8000000000000000ULL, -63, false},
+    {0x8e1bc9bf04000000ULL, -10, false},
+    {0x9dc5ada82b70b59dULL, 43, true},
+    {0xaf298d050e4395d6ULL, 96, true},
+};
+
+#if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_C
+// Float objects keep 30 bits, so the last 2 bits of the mantissa are always zero and
+// neighbouring floats are 4 units in the last place apart. Decimals are rounded straight to
+// 30 bits, since rounding to 32 bits first would round ties a second time.
+#define FLOAT_ULP_SHIFT (2)
+#else
+#define FLOAT_ULP_SHIFT (0)
+#endif
+
+static const uint64_t pow10_int[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL,
+};
+
+// m must not be zero.
+static ext_float_t ext_from_uint(uint64_t m, int e) {
+    for (int shift = 32; shift > 0; shift >>= 1) {
+        if ((m >> (64 - shift)) == 0) {
+            m <<= shift;
+            e -= shift;
+        }
+    }
+    ext_float_t x = {m, e, false};
+    return x;
+}
+
+static ext_float_t ext_mul(ext_float_t a, ext_float_t b) {
+    uint64_t a_lo = (uint32_t)a.m;
+    uint64_t a_hi = a.m >> 32;
+    uint64_t b_lo = (uint32_t)b.m;
+    uint64_t b_hi = b.m >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    uint64_t hi = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+    uint64_t lo = (cross << 32) | (uint32_t)lo_lo;
+    ext_float_t x = {hi, a.e + b.e + 64, a.inexact || b.inexact};
+    // the product of two normalized mantissas needs at most one more shift
+    if ((hi >> 63) == 0) {
+        x.m = (hi << 1) | (lo >> 63);
+        x.e -= 1;
+        lo <<= 1;
+    }
+    if (lo != 0) {
+        x.inexact = true;
+    }
+    return x;
+}
+
+// Returns 10^k for -64 <= k < 64.
+static ext_float_t ext_pow10(int k) {
+    int big = (k + 64) >> 4;
+    ext_float_t small = ext_from_uint(pow10_int[(k + 64) & 15], 0);
+    if (big == 4) {
+        return small;
+    }
+    return ext_mul(pow10_big[big], small);
+}
+
+// Returns floor(log10(2^b)), using 78913 / 2^18 which is just below log10(2).
+static int floor_log10_pow2(int b) {
+    if (b >= 0) {
+        return (b * 78913) >> 18;
+    }
+    return -((-b * 78913 + (1 << 18) - 1) >> 18);
+}
+
+// Splits f, which must be positive and finite, into *m * 2^*e.
+static void float_split(float f, uint32_t *m, int *e) {
+    union floatbits fb = {f};
+    uint32_t exp = (fb.u & FLT_EXP_MASK) >> 23;
+    *m = fb.u & FLT_MAN_MASK;
+    if (exp == 0) {
+        *e = -149;
+    } else {
+        *m |= 1 << 23;
+        *e = exp - 150;
+    }
+}
+
+mp_float_t mp_float_from_decimal(uint64_t mant, int exp10) {
+    static const float pow10_exact[] = {1e0F, 1e1F, 1e2F, 1e3F, 1e4F, 1e5F, 1e6F, 1e7F, 1e8F, 1e9F, 1e10F};
+    if (mant == 0 || exp10 < -64) {
+        return 0;
+    }
+    if (exp10 > 39) {
+        return INFINITY;
+    }
+    if (FLOAT_ULP_SHIFT == 0 && mant < (1 << 24) && exp10 >= -10 && exp10 <= 10) {
+        // both are exact as floats so a single operation rounds correctly
+        if (exp10 < 0) {
+            return (float)mant / pow10_exact[-exp10];
+        }
+        return (float)mant * pow10_exact[exp10];
+    }
+
+    ext_float_t x;
+    if (exp10 < 0 && exp10 >= -18 && mant % (pow10_int[-exp10] >> -exp10) == 0) {
+        // dividing by 5^-exp10 is exact, so ties between floats round correctly
+        x = ext_from_uint(mant / (pow10_int[-exp10] >> -exp10), exp10);
+    } else {
+        x = ext_mul(ext_from_uint(mant, 0), ext_pow10(exp10));
+    }
+    int b = x.e + 63;
+    if (b > 127) {
+        return INFINITY;
+    }
+    // keep 24 bits, or 22 for 30-bit floats, or fewer for a subnormal, and round half to even
+    int shift = (b >= -126 ? 40 : -x.e - 149) + FLOAT_ULP_SHIFT;
+    uint64_t m;
+    if (shift >= 64) {
+        m = (shift == 64 && (x.m > (1ULL << 63) || x.inexact)) ? 1 : 0;
+    } else {
+        m = x.m >> shift;
+        uint64_t rest = x.m & ((1ULL << shift) - 1);
+        uint64_t half = 1ULL << (shift - 1);
+        if (rest > half || (rest == half && (x.inexact || (m & 1)))) {
+            m++;
+        }
+    }
+    m <<= FLOAT_ULP_SHIFT;
+    // a mantissa that rounded up to the next power of 2 carries into the exponent
+    union floatbits fb;
+    fb.u = b >= -126 ? ((uint32_t)(b + 126) << 23) + (uint32_t)m : (uint32_t)m;
+    return fb.f;
+}
+
+// Sets *digits to the first 18 significant digits of f, which must be positive and finite, and
+// returns the decimal exponent of the first one. *tail is set if the digits that follow may not
+// all be zero.
+static int float_digits18(float f, uint64_t *digits, bool *tail) {
+    uint32_t m;
+    int e;
+    float_split(f, &m, &e);
+    ext_float_t x = ext_from_uint(m, e);
+    int e10 = floor_log10_pow2(x.e + 63);
+    for (;;) {
+        ext_float_t y = ext_mul(x, ext_pow10(17 - e10));
+        uint64_t d = y.e <= -4 ? y.m >> -y.e : pow10_int[18];
+        if (d >= pow10_int[18]) {
+            e10++;
+        } else if (d < pow10_int[17]) {
+            e10--;
+        } else {
+            *digits = d;
+            *tail = y.inexact || (y.m << (64 + y.e)) != 0;
+            return e10;
+        }
+    }
+}
+
+// Rounds 18 digits to n of them, for 0 <= n <= 17, with half to even. The result has n + 1
+// digits if it rounded up to a power of 10.
+static uint64_t round_digits(uint64_t digits, bool tail, int n) {
+    uint64_t div = pow10_int[18 - n];
+    uint64_t q = digits / div;
+    uint64_t r = digits % div;
+    uint64_t half = div / 2;
+    if (r > half || (r == half && (tail || (q & 1)))) {
+        q++;
+    }
+    return q;
+}
+
+// Sets *q to the fewest digits that are closer to f than to any other float, picking the closest
+// to f if there is a choice, and returns the decimal exponent of the first digit.
+static int float_shortest(float f, uint64_t *q, int *nd) {
+    uint32_t m;
+    int e;
+    float_split(f, &m, &e);
+    // the midpoints to the neighbouring floats, which are closer below a power of 2
+    union floatbits fb = {f};
+    uint64_t v = 4 * (uint64_t)m;
+    uint64_t upper = v + (2 << FLOAT_ULP_SHIFT);
+    uint64_t lower = v - (((fb.u & FLT_MAN_MASK) == 0 && (fb.u & FLT_EXP_MASK) > (1 << 23) ? 1 : 2) << FLOAT_ULP_SHIFT);
+
+    // scale so that v is at least 10^8, which leaves several integers between the midpoints,
+    // then work in fixed point with 28 fraction bits
+    ext_float_t x = ext_from_uint(v, e - 2);
+    int k = floor_log10_pow2(x.e + 63) - 8;
+    ext_float_t scale = ext_pow10(-k);
+    x = ext_mul(x, scale);
+    ext_float_t xu = ext_mul(ext_from_uint(upper, e - 2), scale);
+    ext_float_t xl = ext_mul(ext_from_uint(lower, e - 2), scale);
+    uint64_t fv = x.m >> -(x.e + 28);
+    // stay a few units inside the midpoints to allow for the error in the scaling
+    uint64_t lo = ((xl.m >> -(xl.e + 28)) + 4 + (1 << 28) - 1) >> 28;
+    uint64_t hi = ((xu.m >> -(xu.e + 28)) - 4) >> 28;
+
+    // find the largest power of 10 with a multiple between the midpoints
+    uint64_t div = 1;
+    while ((lo + div * 10 - 1) / (div * 10) <= hi / (div * 10)) {
+        div *= 10;
+        k++;
+    }
+    uint64_t n_lo = (lo + div - 1) / div;
+    uint64_t n_hi = hi / div;
+    uint64_t n = (fv + (div << 27)) / (div << 28);
+    if (n < n_lo) {
+        n = n_lo;
+    } else if (n > n_hi) {
+        n = n_hi;
+    }
+    // a midpoint reads back as f when its mantissa is even, and large floats have midpoints
+    // with few digits, so check whether one that the margins left out is shorter
+    while (div * 10 <= (fv >> 28)) {
+        uint64_t n10 = (fv + (div * 10 << 27)) / (div * 10 << 28);
+        if (mp_float_from_decimal(n10, k + 1) != f) {
+            break;
+        }
+        n = n10;
+        div *= 10;
+        k++;
+    }
+    while (n % 10 == 0) {
+        n /= 10;
+        k++;
+    }
+    *q = n;
+    *nd = 1;
+    while (*nd < 18 && n >= pow10_int[*nd]) {
+        (*nd)++;
+    }
+    return k + *nd - 1;
+}
+
+// Writes the nd digits of q, which are d.ddd * 10^e10, with frac digits after the decimal point
+// and in exponent form if e_char is set. Digits past the end of q are zero.
+static char *write_digits(char *s, uint64_t q, int nd, int e10, int frac, char e_char) {
+    char digits[18];
+    for (int i = nd - 1; i >= 0; i--) {
+        digits[i] = '0' + q % 10;
+        q /= 10;
+    }
+    int first = e_char ? 0 : e10;
+    if (first < 0) {
+        first = 0;
+    }
+    for (int pos = first; pos >= -frac; pos--) {
+        int i = e_char ? -pos : e10 - pos;
+        *s++ = i >= 0 && i < nd ? digits[i] : '0';
+        if (pos == 0 && frac > 0) {
+            *s++ = '.';
+        }
+    }
+    if (e_char) {
+        *s++ = e_char;
+        if (e10 < 0) {
+            *s++ = '-';
+            e10 = -e10;
+        } else {
+            *s++ = '+';
+        }
+        *s++ = '0' + e10 / 10;
+        *s++ = '0' + e10 % 10;
+    }
+    return s;
+}
+
+// Rounds the 18 digits, whose first is at 10^e10, to n significant digits. Returns the decimal
+// exponent of the first digit of the result.
+static int round_to(uint64_t digits, bool tail, int e10, int n, uint64_t *q, int *nd) {
+    if (digits == 0 || n < 0) {
+        *q = 0;
+        *nd = 1;
+        return 0;
+    }
+    if (n > 17) {
+        n = 17;
+    }
+    *q = round_digits(digits, tail, n);
+    *nd = n;
+    if (*q == pow10_int[n]) {
+        // rounded up to a power of 10
+        *q = 1;
+        *nd = 1;
+        return e10 + 1;
+    }
+    if (*q == 0) {
+        *nd = 1;
+        return 0;
+    }
+    return e10;
+}
+
+// Formats f, which must be positive and finite or zero, into at most buf_remaining characters.
+static char *format_decimal(char *s, int buf_remaining, float f, char fmt, int prec) {
+    char e_char = 'E' | (fmt & 0x20);
+    fmt |= 0x20;
+    if (prec < 0) {
+        prec = 6;
+    }
+    uint64_t digits = 0;
+    bool tail = false;
+    int e10 = 0;
+    if (!fp_iszero(f)) {
+        e10 = float_digits18(f, &digits, &tail);
+    }
+    uint64_t q;
+    int nd;
+    int e;
+
+    if (fmt == 'r') {
+        // the shortest digits, laid out like 'g' with prec setting where exponents start
+        if (digits == 0) {
+            q = 0;
+            nd = 1;
+            e = 0;
+        } else {
+            e = float_shortest(f, &q, &nd);
+        }
+        int frac = nd - 1 - e;
+        if (e >= -4 && e < prec && (e < 0 ? 1 - e : e + 1) + (frac > 0 ? frac + 1 : 0) <= buf_remaining) {
+            return write_digits(s, q, nd, e, frac > 0 ? frac : 0, '\0');
+        }
+        if (nd + 5 <= buf_remaining) {
+            return write_digits(s, q, nd, e, nd - 1, e_char);
+        }
+        fmt = 'g';
+        prec = buf_remaining - (FPMIN_BUF_SIZE - 1);
+    }
+
+    if (fmt == 'f') {
+        for (;;) {
+            e = round_to(digits, tail, e10, e10 + 1 + prec, &q, &nd);
+            int int_len = e < 0 ? 1 : e + 1;
+            if (int_len > buf_remaining) {
+                // too big to write out so use the exponent form
+                fmt = 'e';
+                break;
+            }
+            if (int_len + (prec > 0 ? prec + 1 : 0) <= buf_remaining) {
+                return write_digits(s, q, nd, e, prec, '\0');
+            }
+            prec = buf_remaining - int_len - 1;
+            if (prec < 0) {
+                prec = 0;
+            }
+        }
+    }
+
+    if (fmt == 'e') {
+        if (prec > buf_remaining - FPMIN_BUF_SIZE) {
+            prec = buf_remaining - FPMIN_BUF_SIZE;
+        }
+        if (prec < 0) {
+            prec = 0;
+        }
+        e = round_to(digits, tail, e10, prec + 1, &q, &nd);
+        return write_digits(s, q, nd, e, prec, e_char);
+    }
+
+    // 'g' uses prec significant digits and drops trailing zeros
+    if (prec + (FPMIN_BUF_SIZE - 1) > buf_remaining) {
+        prec = buf_remaining - (FPMIN_BUF_SIZE - 1);
+    }
+    if (prec < 1) {
+        prec = 1;
+    }
+    e = round_to(digits, tail, e10, prec, &q, &nd);
+    char *start = s;
+    if (e < -4 || e >= prec) {
+        s = write_digits(s, q, nd, e, prec - 1, e_char);
+    } else {
+        s = write_digits(s, q, nd, e, prec - 1 - e, '\0');
+    }
+    // remove trailing zeros and a trailing decimal point from the digits, before any exponent
+    char *exp_start = memchr(start, e_char, s - start);
+    if (exp_start == NULL) {
+        exp_start = s;
+    }
+    if (memchr(start, '.', exp_start - start) != NULL) {
+        char *d = exp_start;
+        while (d[-1] == '0') {
+            d--;
+        }
+        if (d[-1] == '.') {
+            d--;
+        }
+        size_t exp_len = s - exp_start;
+        memmove(d, exp_start, exp_len);
+        s = d + exp_len;
+    }
+    return s;
+}
+
+#else
+
 static const FPTYPE g_pos_pow[] = {
     #if FPDECEXP > 32
     1e256, 1e128, 1e64,
@@ -102,6 +519,8 @@ static const FPTYPE g_neg_pow[] = {
     1e-32, 1e-16, 1e-8, 1e-4, 1e-2, 1e-1
 };
 
+#endif
+
 int mp_format_float(FPTYPE f, char *buf, size_t buf_size, char fmt, int prec, char sign) {
 
     char *s = buf;
@@ -149,6 +568,9 @@ int mp_format_float(FPTYPE f, char *buf, size_t buf_size, char fmt, int prec, ch
         }
     }
 
+    #if MICROPY_FLOAT_FAST_DECIMAL
+    s = format_decimal(s, buf_remaining, f, fmt, prec);
+    #else
     if (prec < 0) {
         prec = 6;
     }
@@ -418,6 +840,7 @@ int mp_format_float(FPTYPE f, char *buf, size_t buf_size, char fmt, int prec, ch
         *s++ = '0' + ((e / 10) % 10);
         *s++ = '0' + (e % 10);
     }
+    #endif
     *s = '\0';
 
     // verify that we did not overrun the input buffer
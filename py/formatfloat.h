@@ -32,4 +32,9 @@
 int mp_format_float(mp_float_t f, char *buf, size_t bufSize, char fmt, int prec, char sign);
 #endif
 
+#if MICROPY_FLOAT_FAST_DECIMAL
+// Returns mant * 10^exp10 rounded to the nearest float.
+mp_float_t mp_float_from_decimal(uint64_t mant, int exp10);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_FORMATFLOAT_H
@@ -29,6 +29,12 @@
 #include <string.h>
 
 #include "py/gc.h"
+#include "py/bc.h"
+#include "py/objlist.h"
+#include "py/objmodule.h"
+#include "py/objstr.h"
+#include "py/objtuple.h"
+#include "py/objtype.h"
 #include "py/runtime.h"
 
 #include "supervisor/shared/safe_mode.h"
@@ -77,8 +83,55 @@
 #define ATB_HEAD_TO_MARK(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] |= (AT_MARK << BLOCK_SHIFT(block)); } while (0)
 #define ATB_MARK_TO_HEAD(block) do { MP_STATE_MEM(gc_alloc_table_start)[(block) / BLOCKS_PER_ATB] &= (~(AT_TAIL << BLOCK_SHIFT(block))); } while (0)
 
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// While an incremental sweep is in progress the live blocks that haven't been
+// swept yet are still marked.
+#define ATB_IS_ALLOCATED_HEAD(block) (ATB_GET_KIND(block) == AT_HEAD || ATB_GET_KIND(block) == AT_MARK)
+#else
+#define ATB_IS_ALLOCATED_HEAD(block) (ATB_GET_KIND(block) == AT_HEAD)
+#endif
+
+#if MICROPY_GC_MAX_AREAS > 1
+// Blocks are numbered through the pools of all the areas in address order, so
+// that everything that works with block numbers, and compares pointers to find
+// which part of the heap they're in, sees one heap.  Only converting between
+// blocks and pointers needs to know where each area is.
+STATIC size_t gc_block_from_ptr(const void *ptr) {
+    size_t i = MP_STATE_MEM(gc_n_areas) - 1;
+    while (i > 0 && (const byte*)ptr < MP_STATE_MEM(gc_area_start)[i]) {
+        i--;
+    }
+    return MP_STATE_MEM(gc_area_first_block)[i] + ((const byte*)ptr - MP_STATE_MEM(gc_area_start)[i]) / BYTES_PER_BLOCK;
+}
+
+STATIC uintptr_t gc_ptr_from_block(size_t block) {
+    size_t i = MP_STATE_MEM(gc_n_areas) - 1;
+    while (i > 0 && block < MP_STATE_MEM(gc_area_first_block)[i]) {
+        i--;
+    }
+    return (uintptr_t)MP_STATE_MEM(gc_area_start)[i] + (block - MP_STATE_MEM(gc_area_first_block)[i]) * BYTES_PER_BLOCK;
+}
+
+STATIC bool gc_ptr_in_pool(const void *ptr) {
+    if ((const byte*)ptr < MP_STATE_MEM(gc_pool_start) || (const byte*)ptr >= MP_STATE_MEM(gc_pool_end)) {
+        return false;
+    }
+    for (size_t i = 0; i < MP_STATE_MEM(gc_n_areas); i++) {
+        if ((const byte*)ptr >= MP_STATE_MEM(gc_area_start)[i] && (const byte*)ptr < MP_STATE_MEM(gc_area_end)[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#define BLOCK_FROM_PTR(ptr) gc_block_from_ptr(ptr)
+#define PTR_FROM_BLOCK(block) gc_ptr_from_block(block)
+#define PTR_IN_POOL(ptr) gc_ptr_in_pool(ptr)
+#else
 #define BLOCK_FROM_PTR(ptr) (((byte*)(ptr) - MP_STATE_MEM(gc_pool_start)) / BYTES_PER_BLOCK)
 #define PTR_FROM_BLOCK(block) (((block) * BYTES_PER_BLOCK + (uintptr_t)MP_STATE_MEM(gc_pool_start)))
+#define PTR_IN_POOL(ptr) ((const void*)(ptr) >= (void*)MP_STATE_MEM(gc_pool_start) && (const void*)(ptr) < (void*)MP_STATE_MEM(gc_pool_end))
+#endif
 #define ATB_FROM_BLOCK(bl) ((bl) / BLOCKS_PER_ATB)
 
 #if MICROPY_ENABLE_FINALISER
@@ -111,24 +164,132 @@ void __attribute__ ((noinline)) gc_log_change(uint32_t start_block, uint32_t len
 #pragma GCC pop_options
 #endif
 
+#if MICROPY_GC_OBJ_FREELIST
+// Forget all freelisted objects and which types have freelists.
+STATIC void gc_freelist_clear(void) {
+    memset(MP_STATE_MEM(gc_freelist_type), 0, sizeof(MP_STATE_MEM(gc_freelist_type)));
+    memset(MP_STATE_MEM(gc_freelist_len), 0, sizeof(MP_STATE_MEM(gc_freelist_len)));
+    memset(MP_STATE_VM(gc_freelist), 0, sizeof(MP_STATE_VM(gc_freelist)));
+}
+#endif
+
+// Move the first free ATB indices back to atb_index if they are after it,
+// because n_blocks blocks there have been freed.  Only the indices for
+// allocations that fit in the freed blocks move, so that freeing a small
+// object doesn't send every larger allocation back over the start of the
+// heap.  A bigger run made by merging with free neighbours is still found
+// after the next collection, which resets all the indices.
+STATIC void gc_lower_first_free(size_t atb_index, size_t n_blocks) {
+    for (size_t i = 0; i < MICROPY_GC_ATB_INDICES && i < n_blocks; i++) {
+        if (atb_index < MP_STATE_MEM(gc_first_free_atb_index)[i]) {
+            MP_STATE_MEM(gc_first_free_atb_index)[i] = atb_index;
+        }
+    }
+}
+
+#if MICROPY_GC_MAX_AREAS > 1
+// Record the pools of the heap in address order. The other areas' pools are
+// given by their start and length in ATBs, and follow the first area's.
+STATIC void gc_setup_areas(byte **starts, size_t *atb_lens, size_t n) {
+    size_t n_areas = 0;
+    for (size_t i = 0; i < n; i++) {
+        byte *area_start = starts[i];
+        byte *area_end = area_start + atb_lens[i] * BLOCKS_PER_ATB * BYTES_PER_BLOCK;
+        size_t j = n_areas++;
+        for (; j > 0 && MP_STATE_MEM(gc_area_start)[j - 1] > area_start; j--) {
+            MP_STATE_MEM(gc_area_start)[j] = MP_STATE_MEM(gc_area_start)[j - 1];
+            MP_STATE_MEM(gc_area_end)[j] = MP_STATE_MEM(gc_area_end)[j - 1];
+        }
+        MP_STATE_MEM(gc_area_start)[j] = area_start;
+        MP_STATE_MEM(gc_area_end)[j] = area_end;
+    }
+    MP_STATE_MEM(gc_n_areas) = n_areas;
+
+    size_t block = 0;
+    for (size_t i = 0; i < n_areas; i++) {
+        MP_STATE_MEM(gc_area_first_block)[i] = block;
+        block += (MP_STATE_MEM(gc_area_end)[i] - MP_STATE_MEM(gc_area_start)[i]) / BYTES_PER_BLOCK;
+        if (i > 0) {
+            // Take the first block to separate this area from the one before.
+            memset(MP_STATE_MEM(gc_area_start)[i], 0, BYTES_PER_BLOCK);
+            ATB_FREE_TO_HEAD(MP_STATE_MEM(gc_area_first_block)[i]);
+        }
+    }
+    MP_STATE_MEM(gc_pool_start) = MP_STATE_MEM(gc_area_start)[0];
+    MP_STATE_MEM(gc_pool_end) = MP_STATE_MEM(gc_area_end)[n_areas - 1];
+}
+
+void gc_init(void *start, void *end) {
+    gc_area_t area = {start, end};
+    gc_init_areas(&area, 1);
+}
+
+// TODO waste less memory; currently requires that all entries in alloc_table have a corresponding block in pool
+void gc_init_areas(const gc_area_t *areas, size_t n_areas) {
+    void *start = areas[0].start;
+    void *end = areas[0].end;
+#else
 // TODO waste less memory; currently requires that all entries in alloc_table have a corresponding block in pool
 void gc_init(void *start, void *end) {
+#endif
     // align end pointer on block boundary
     end = (void*)((uintptr_t)end & (~(BYTES_PER_BLOCK - 1)));
     DEBUG_printf("Initializing GC heap: %p..%p = " UINT_FMT " bytes\n", start, end, (byte*)end - (byte*)start);
 
     // calculate parameters for GC (T=total, A=alloc table, F=finaliser table, P=pool; all in bytes):
+    #if MICROPY_GC_MARK_STACK_DIVISOR
+    // Use a mark stack in proportion to the heap, taken from the start of the
+    // area, if it's bigger than the one in the state.
+    start = (void*)(((uintptr_t)start + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1));
+    size_t stack_len = ((byte*)end - (byte*)start) / (MICROPY_GC_MARK_STACK_DIVISOR * BYTES_PER_BLOCK + sizeof(size_t));
+    if (stack_len > MICROPY_ALLOC_GC_STACK_SIZE) {
+        MP_STATE_MEM(gc_mark_stack) = (size_t*)start;
+        MP_STATE_MEM(gc_mark_stack_len) = stack_len;
+        start = (byte*)start + stack_len * sizeof(size_t);
+    } else {
+        MP_STATE_MEM(gc_mark_stack) = MP_STATE_MEM(gc_stack);
+        MP_STATE_MEM(gc_mark_stack_len) = MICROPY_ALLOC_GC_STACK_SIZE;
+    }
+    DEBUG_printf("  mark stack of " UINT_FMT " entries\n", MP_STATE_MEM(gc_mark_stack_len));
+    #endif
+
     // T = A + F + P
     //     F = A * BLOCKS_PER_ATB / BLOCKS_PER_FTB
     //     P = A * BLOCKS_PER_ATB * BYTES_PER_BLOCK
     // => T = A * (1 + BLOCKS_PER_ATB / BLOCKS_PER_FTB + BLOCKS_PER_ATB * BYTES_PER_BLOCK)
     size_t total_byte_len = (byte*)end - (byte*)start;
+    #if MICROPY_GC_MAX_AREAS > 1
+    // The pools of the other areas are made of whole ATBs of blocks, and their
+    // part of the tables comes out of this area.
+    byte *pool_starts[MICROPY_GC_MAX_AREAS];
+    size_t pool_atb_lens[MICROPY_GC_MAX_AREAS];
+    size_t n_pools = 1;
+    size_t extra_atb_len = 0;
+    for (size_t i = 1; i < n_areas && n_pools < MICROPY_GC_MAX_AREAS; i++) {
+        byte *pool = (byte*)(((uintptr_t)areas[i].start + BYTES_PER_BLOCK - 1) & ~(BYTES_PER_BLOCK - 1));
+        if ((byte*)areas[i].end < pool + 2 * BLOCKS_PER_ATB * BYTES_PER_BLOCK) {
+            continue;
+        }
+        pool_starts[n_pools] = pool;
+        pool_atb_lens[n_pools] = ((byte*)areas[i].end - pool) / (BLOCKS_PER_ATB * BYTES_PER_BLOCK);
+        extra_atb_len += pool_atb_lens[n_pools++];
+    }
+    total_byte_len -= extra_atb_len;
+    #if MICROPY_ENABLE_FINALISER
+    total_byte_len -= extra_atb_len * BLOCKS_PER_ATB / BLOCKS_PER_FTB + 1;
+    #endif
+    #endif
 #if MICROPY_ENABLE_FINALISER
     MP_STATE_MEM(gc_alloc_table_byte_len) = total_byte_len * BITS_PER_BYTE / (BITS_PER_BYTE + BITS_PER_BYTE * BLOCKS_PER_ATB / BLOCKS_PER_FTB + BITS_PER_BYTE * BLOCKS_PER_ATB * BYTES_PER_BLOCK);
 #else
     MP_STATE_MEM(gc_alloc_table_byte_len) = total_byte_len / (1 + BITS_PER_BYTE / 2 * BYTES_PER_BLOCK);
 #endif
 
+    size_t first_atb_len = MP_STATE_MEM(gc_alloc_table_byte_len);
+    #if MICROPY_GC_MAX_AREAS > 1
+    MP_STATE_MEM(gc_alloc_table_byte_len) += extra_atb_len;
+    #endif
+
     MP_STATE_MEM(gc_alloc_table_start) = (byte*)start;
 
 #if MICROPY_ENABLE_FINALISER
@@ -136,7 +297,7 @@ void gc_init(void *start, void *end) {
     MP_STATE_MEM(gc_finaliser_table_start) = MP_STATE_MEM(gc_alloc_table_start) + MP_STATE_MEM(gc_alloc_table_byte_len);
 #endif
 
-    size_t gc_pool_block_len = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    size_t gc_pool_block_len = first_atb_len * BLOCKS_PER_ATB;
     MP_STATE_MEM(gc_pool_start) = (byte*)end - gc_pool_block_len * BYTES_PER_BLOCK;
     MP_STATE_MEM(gc_pool_end) = end;
 
@@ -152,14 +313,29 @@ void gc_init(void *start, void *end) {
     memset(MP_STATE_MEM(gc_finaliser_table_start), 0, gc_finaliser_table_byte_len);
 #endif
 
-    // Set first free ATB index to the start of the heap.
-    MP_STATE_MEM(gc_first_free_atb_index) = 0;
+    #if MICROPY_GC_MAX_AREAS > 1
+    pool_starts[0] = MP_STATE_MEM(gc_pool_start);
+    pool_atb_lens[0] = first_atb_len;
+    gc_setup_areas(pool_starts, pool_atb_lens, n_pools);
+    #endif
+
+    // Set first free ATB indices to the start of the heap.
+    gc_lower_first_free(0, MICROPY_GC_ATB_INDICES);
     // Set last free ATB index to the end of the heap.
     MP_STATE_MEM(gc_last_free_atb_index) = MP_STATE_MEM(gc_alloc_table_byte_len) - 1;
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // No sweep in progress.
+    MP_STATE_MEM(gc_sweep_block) = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    MP_STATE_MEM(gc_sweep_incrementally) = false;
+    #endif
     // Set the lowest long lived ptr to the end of the heap to start. This will be lowered as long
     // lived objects are allocated.
     MP_STATE_MEM(gc_lowest_long_lived_ptr) = (void*) PTR_FROM_BLOCK(MP_STATE_MEM(gc_alloc_table_byte_len * BLOCKS_PER_ATB));
 
+    #if MICROPY_GC_OBJ_FREELIST
+    gc_freelist_clear();
+    #endif
+
     // unlock the GC
     MP_STATE_MEM(gc_lock_depth) = 0;
 
@@ -172,6 +348,16 @@ void gc_init(void *start, void *end) {
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
 
+    #if MICROPY_GC_MINOR_COLLECT
+    MP_STATE_MEM(gc_collect_minor) = false;
+    MP_STATE_MEM(gc_minor_count) = 0;
+    #endif
+
+    #if MICROPY_GC_ALLOC_PROFILER
+    MP_STATE_MEM(gc_profile_enabled) = false;
+    MP_STATE_VM(gc_profile_pending) = NULL;
+    #endif
+
     #if MICROPY_PY_THREAD
     mp_thread_mutex_init(&MP_STATE_MEM(gc_mutex));
     #endif
@@ -212,8 +398,7 @@ bool gc_is_locked(void) {
 // ptr should be of type void*
 #define VERIFY_PTR(ptr) ( \
         ((uintptr_t)(ptr) & (BYTES_PER_BLOCK - 1)) == 0      /* must be aligned on a block */ \
-        && ptr >= (void*)MP_STATE_MEM(gc_pool_start)     /* must be above start of pool */ \
-        && ptr < (void*)MP_STATE_MEM(gc_pool_end)        /* must be below end of pool */ \
+        && PTR_IN_POOL(ptr)                                 /* must be in the pool */ \
     )
 
 #ifndef TRACE_MARK
@@ -228,8 +413,18 @@ bool gc_is_locked(void) {
 // children: mark the unmarked child blocks and put those newly marked
 // blocks on the stack. When all children have been checked, pop off the
 // topmost block on the stack and repeat with that one.
-STATIC void gc_mark_subtree(size_t block) {
+#if MICROPY_GC_MARK_STACK_DIVISOR
+#define GC_STACK (MP_STATE_MEM(gc_mark_stack))
+#define GC_STACK_LEN (MP_STATE_MEM(gc_mark_stack_len))
+#else
+#define GC_STACK (MP_STATE_MEM(gc_stack))
+#define GC_STACK_LEN (MICROPY_ALLOC_GC_STACK_SIZE)
+#endif
+
+MP_RAMFUNC STATIC void gc_mark_subtree(size_t block) {
     // Start with the block passed in the argument.
+    size_t *stack = GC_STACK;
+    size_t stack_len = GC_STACK_LEN;
     size_t sp = 0;
     for (;;) {
         // work out number of consecutive blocks in the chain starting with this one
@@ -249,10 +444,15 @@ STATIC void gc_mark_subtree(size_t block) {
                     // an unmarked head, mark it, and push it on gc stack
                     TRACE_MARK(childblock, ptr);
                     ATB_HEAD_TO_MARK(childblock);
-                    if (sp < MICROPY_ALLOC_GC_STACK_SIZE) {
-                        MP_STATE_MEM(gc_stack)[sp++] = childblock;
+                    if (sp < stack_len) {
+                        stack[sp++] = childblock;
                     } else {
+                        // Remember where the rescan for children that
+                        // weren't traced has to start from.
                         MP_STATE_MEM(gc_stack_overflow) = 1;
+                        if (childblock < MP_STATE_MEM(gc_stack_overflow_block)) {
+                            MP_STATE_MEM(gc_stack_overflow_block) = childblock;
+                        }
                     }
                 }
             }
@@ -264,16 +464,19 @@ STATIC void gc_mark_subtree(size_t block) {
         }
 
         // pop the next block off the stack
-        block = MP_STATE_MEM(gc_stack)[--sp];
+        block = stack[--sp];
     }
 }
 
 STATIC void gc_deal_with_stack_overflow(void) {
     while (MP_STATE_MEM(gc_stack_overflow)) {
         MP_STATE_MEM(gc_stack_overflow) = 0;
+        size_t block = MP_STATE_MEM(gc_stack_overflow_block);
+        MP_STATE_MEM(gc_stack_overflow_block) = (size_t)-1;
 
-        // scan entire memory looking for blocks which have been marked but not their children
-        for (size_t block = 0; block < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; block++) {
+        // Scan memory from the first block that was dropped from the stack,
+        // looking for blocks which have been marked but not their children.
+        for (; block < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; block++) {
             // trace (again) if mark bit set
             if (ATB_GET_KIND(block) == AT_MARK) {
                 gc_mark_subtree(block);
@@ -282,15 +485,71 @@ STATIC void gc_deal_with_stack_overflow(void) {
     }
 }
 
-STATIC void gc_sweep(void) {
-    #if MICROPY_PY_GC_COLLECT_RETVAL
-    MP_STATE_MEM(gc_collected) = 0;
+#if MICROPY_GC_OBJ_FREELIST
+// Called by the sweep for an unmarked head. Keeps it, rather than freeing it,
+// if it is a short lived one block object of a type with a freelist that has
+// room. Everything but the type is cleared so the freelist, which is a root,
+// doesn't hold on to what the dead object referred to.
+STATIC bool gc_freelist_keep(size_t block) {
+    #if MICROPY_ENABLE_FINALISER
+    if (FTB_GET(block)) {
+        return false;
+    }
     #endif
+    if (block + 1 < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB && ATB_GET_KIND(block + 1) == AT_TAIL) {
+        return false;
+    }
+    mp_obj_base_t *obj = (mp_obj_base_t*)PTR_FROM_BLOCK(block);
+    if (obj->type == NULL || (void*)obj >= MP_STATE_MEM(gc_lowest_long_lived_ptr)) {
+        return false;
+    }
+    for (size_t i = 0; i < MICROPY_GC_OBJ_FREELIST_TYPES; i++) {
+        if (MP_STATE_MEM(gc_freelist_type)[i] == obj->type) {
+            uint8_t len = MP_STATE_MEM(gc_freelist_len)[i];
+            if (len == MICROPY_GC_OBJ_FREELIST_DEPTH) {
+                return false;
+            }
+            memset((byte*)obj + sizeof(mp_obj_base_t), 0, BYTES_PER_BLOCK - sizeof(mp_obj_base_t));
+            MP_STATE_VM(gc_freelist)[i][len] = obj;
+            MP_STATE_MEM(gc_freelist_len)[i] = len + 1;
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+// Sweep from the given block up to at least end_block. The sweep only stops at
+// the start of an allocation so that it never leaves the tails of a freed
+// block behind. Returns the block after the last one swept.
+STATIC size_t gc_sweep_blocks(size_t block, size_t end_block) {
+    size_t max_block = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
     // free unmarked heads and their tails
     int free_tail = 0;
-    for (size_t block = 0; block < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; block++) {
+    for (; block < max_block && (block < end_block || ATB_GET_KIND(block) == AT_TAIL); block++) {
+        // Skip over four free blocks at a time.
+        if ((block & (BLOCKS_PER_ATB - 1)) == 0 && MP_STATE_MEM(gc_alloc_table_start)[block / BLOCKS_PER_ATB] == 0) {
+            block += BLOCKS_PER_ATB - 1;
+            continue;
+        }
+        // Likewise when none of four blocks are unmarked heads or the tails
+        // of an allocation being freed, just unmark the marked heads.
+        if ((block & (BLOCKS_PER_ATB - 1)) == 0 && !free_tail) {
+            byte a = MP_STATE_MEM(gc_alloc_table_start)[block / BLOCKS_PER_ATB];
+            if ((a & ~(a >> 1) & 0x55) == 0) {
+                MP_STATE_MEM(gc_alloc_table_start)[block / BLOCKS_PER_ATB] = a & ~((a & (a >> 1) & 0x55) << 1);
+                block += BLOCKS_PER_ATB - 1;
+                continue;
+            }
+        }
         switch (ATB_GET_KIND(block)) {
             case AT_HEAD:
+                #if MICROPY_GC_OBJ_FREELIST
+                if (gc_freelist_keep(block)) {
+                    free_tail = 0;
+                    break;
+                }
+                #endif
 #if MICROPY_ENABLE_FINALISER
                 if (FTB_GET(block)) {
                     mp_obj_base_t *obj = (mp_obj_base_t*)PTR_FROM_BLOCK(block);
@@ -343,10 +602,272 @@ STATIC void gc_sweep(void) {
                 break;
         }
     }
+    return block;
+}
+
+STATIC void gc_sweep(void) {
+    #if MICROPY_PY_GC_COLLECT_RETVAL
+    MP_STATE_MEM(gc_collected) = 0;
+    #endif
+    gc_sweep_blocks(0, MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB);
+}
+
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// Continue an incremental sweep for n_blocks or so. The GC must be entered.
+STATIC void gc_sweep_step(size_t n_blocks) {
+    size_t start = MP_STATE_MEM(gc_sweep_block);
+    size_t max_block = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    if (start >= max_block) {
+        return;
+    }
+    // As in a full collection, finalisers can't allocate while sweeping.
+    MP_STATE_MEM(gc_lock_depth)++;
+    size_t end = gc_sweep_blocks(start, n_blocks < max_block - start ? start + n_blocks : max_block);
+    MP_STATE_MEM(gc_sweep_block) = end;
+    MP_STATE_MEM(gc_lock_depth)--;
+
+    // Make sure gc_alloc looks at the blocks that were just freed.
+    gc_lower_first_free(start / BLOCKS_PER_ATB, MICROPY_GC_ATB_INDICES);
+    if ((end - 1) / BLOCKS_PER_ATB > MP_STATE_MEM(gc_last_free_atb_index)) {
+        MP_STATE_MEM(gc_last_free_atb_index) = (end - 1) / BLOCKS_PER_ATB;
+    }
+}
+
+STATIC void gc_sweep_finish(void) {
+    gc_sweep_step(MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB);
+}
+#endif
+
+#if MICROPY_GC_COMPACT
+// Compaction needs to know which allocations are only ever referenced from
+// places it can update. The objects below keep their references in fixed
+// fields and slots, so anything referenced from nowhere else can be copied
+// lower in the heap and those references rewritten. Every other word in the
+// heap and the roots is treated conservatively and pins what it points into.
+//
+// While compacting, MARK is used for allocations that belong to exactly one
+// known object (a list's items, a map's table or a str's data) and the
+// finaliser bit of known objects and their storage records that they're
+// pinned. Neither bit can be otherwise set for those blocks.
+
+#if MICROPY_PY_THREAD
+#error "MICROPY_GC_COMPACT is not supported with MICROPY_PY_THREAD"
+#endif
+#if !MICROPY_ENABLE_FINALISER
+#error "MICROPY_GC_COMPACT requires MICROPY_ENABLE_FINALISER"
+#endif
+
+// The first word of an allocation left behind by a move. Its second word is
+// the new address.
+STATIC const byte gc_compact_moved;
+#define GC_COMPACT_IS_MOVED(ptr) (((const void**)(ptr))[0] == &gc_compact_moved)
+
+typedef struct _gc_compact_holder_t {
+    // Field that points at storage owned by the object, or NULL.
+    void **field;
+    // The object's references: either the filled slots of a map's table or
+    // an array of objects.
+    mp_map_elem_t *table;
+    mp_obj_t *items;
+    size_t len;
+} gc_compact_holder_t;
+
+STATIC size_t gc_compact_n_bytes(size_t block) {
+    size_t n_blocks = 0;
+    do {
+        n_blocks += 1;
+    } while (ATB_GET_KIND(block + n_blocks) == AT_TAIL);
+    return n_blocks * BYTES_PER_BLOCK;
+}
+
+// Returns the size of the allocation starting at ptr, or 0 if there isn't one.
+STATIC size_t gc_compact_storage_n_bytes(const void *ptr) {
+    if (VERIFY_PTR(ptr)) {
+        size_t block = BLOCK_FROM_PTR(ptr);
+        if (ATB_GET_KIND(block) == AT_HEAD || ATB_GET_KIND(block) == AT_MARK) {
+            return gc_compact_n_bytes(block);
+        }
+    }
+    return 0;
+}
+
+// Objects that can be moved. None of them have finalisers or are referred to
+// by address from outside the heap other than through the roots.
+STATIC bool gc_compact_is_movable_type(const mp_obj_type_t *type) {
+    return type == &mp_type_list
+           || type == &mp_type_tuple
+           || type == &mp_type_dict
+           #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
+           || type == &mp_type_ordereddict
+           #endif
+           || type == &mp_type_str
+           || type == &mp_type_bytes
+           #if MICROPY_PY_BUILTINS_FLOAT
+           || type == &mp_type_float
+           #endif
+           ;
 }
 
+// Classes defined in Python are always allocated on the heap.
+STATIC bool gc_compact_is_instance_type(const mp_obj_type_t *type) {
+    if (gc_compact_storage_n_bytes(type) < sizeof(mp_obj_type_t)) {
+        return false;
+    }
+    return type->base.type == &mp_type_type && mp_obj_is_instance_type(type);
+}
+
+// Fills in h if the object of n_bytes at o is one whose references are known.
+STATIC bool gc_compact_get_holder(mp_obj_base_t *o, size_t n_bytes, gc_compact_holder_t *h) {
+    const mp_obj_type_t *type = o->type;
+    mp_map_t *map = NULL;
+    h->field = NULL;
+    h->table = NULL;
+    h->items = NULL;
+    h->len = 0;
+    if (type == &mp_type_list) {
+        mp_obj_list_t *list = (mp_obj_list_t*)o;
+        if (n_bytes < sizeof(mp_obj_list_t)) {
+            return false;
+        }
+        h->field = (void**)&list->items;
+        h->items = list->items;
+        h->len = MIN(list->len, gc_compact_storage_n_bytes(list->items) / sizeof(mp_obj_t));
+    } else if (type == &mp_type_tuple) {
+        mp_obj_tuple_t *tuple = (mp_obj_tuple_t*)o;
+        if (n_bytes < sizeof(mp_obj_tuple_t)) {
+            return false;
+        }
+        h->items = tuple->items;
+        h->len = MIN(tuple->len, (n_bytes - sizeof(mp_obj_tuple_t)) / sizeof(mp_obj_t));
+    } else if (type == &mp_type_dict
+               #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
+               || type == &mp_type_ordereddict
+               #endif
+               ) {
+        if (n_bytes < sizeof(mp_obj_dict_t)) {
+            return false;
+        }
+        map = &((mp_obj_dict_t*)o)->map;
+    } else if (type == &mp_type_str || type == &mp_type_bytes) {
+        mp_obj_str_t *str = (mp_obj_str_t*)o;
+        if (n_bytes < sizeof(mp_obj_str_t)) {
+            return false;
+        }
+        h->field = (void**)&str->data;
+    } else if (gc_compact_is_instance_type(type)) {
+        if (n_bytes < sizeof(mp_obj_instance_t)) {
+            return false;
+        }
+        map = &((mp_obj_instance_t*)o)->members;
+    } else {
+        return false;
+    }
+    if (map != NULL) {
+        h->field = (void**)&map->table;
+        h->table = map->table;
+        h->len = MIN(map->alloc, gc_compact_storage_n_bytes(map->table) / sizeof(mp_map_elem_t));
+    }
+    return true;
+}
+
+// Dicts and lists that are part of the roots rather than on the heap.
+#define GC_COMPACT_MAX_ROOT_HOLDERS (4)
+STATIC size_t gc_compact_root_holders(gc_compact_holder_t *holders) {
+    size_t n = 0;
+    n += gc_compact_get_holder(&MP_STATE_VM(mp_loaded_modules_dict).base, sizeof(mp_obj_dict_t), &holders[n]);
+    n += gc_compact_get_holder(&MP_STATE_VM(dict_main).base, sizeof(mp_obj_dict_t), &holders[n]);
+    n += gc_compact_get_holder(&MP_STATE_VM(mp_sys_path_obj).base, sizeof(mp_obj_list_t), &holders[n]);
+    n += gc_compact_get_holder(&MP_STATE_VM(mp_sys_argv_obj).base, sizeof(mp_obj_list_t), &holders[n]);
+    return n;
+}
+
+STATIC void gc_compact_visit_slots(const gc_compact_holder_t *h, void (*visit)(mp_obj_t *slot)) {
+    if (h->table != NULL) {
+        for (size_t i = 0; i < h->len; i++) {
+            mp_map_elem_t *elem = &h->table[i];
+            if (elem->key != MP_OBJ_NULL && elem->key != MP_OBJ_SENTINEL) {
+                visit(&elem->key);
+                visit(&elem->value);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < h->len; i++) {
+            visit(&h->items[i]);
+        }
+    }
+}
+
+// Pin the known object or storage that ptr points into, if any.
+STATIC void gc_compact_pin(const void *ptr) {
+    if (!PTR_IN_POOL(ptr)) {
+        return;
+    }
+    size_t block = BLOCK_FROM_PTR(ptr);
+    size_t kind;
+    while ((kind = ATB_GET_KIND(block)) == AT_TAIL) {
+        block--;
+    }
+    if (kind == AT_MARK
+        || (kind == AT_HEAD && gc_compact_is_movable_type(((mp_obj_base_t*)PTR_FROM_BLOCK(block))->type))) {
+        FTB_SET(block);
+    }
+}
+
+// A slot that points at storage is an object reference in name only.
+STATIC void gc_compact_pin_slot(mp_obj_t *slot) {
+    void *ptr = MP_OBJ_TO_PTR(*slot);
+    if (MP_OBJ_IS_OBJ(*slot) && VERIFY_PTR(ptr) && ATB_GET_KIND(BLOCK_FROM_PTR(ptr)) == AT_MARK) {
+        FTB_SET(BLOCK_FROM_PTR(ptr));
+    }
+}
+
+STATIC void gc_compact_pin_holder(const gc_compact_holder_t *h) {
+    if (h->field != NULL && !(VERIFY_PTR(*h->field) && ATB_GET_KIND(BLOCK_FROM_PTR(*h->field)) == AT_MARK)) {
+        gc_compact_pin(*h->field);
+    }
+    gc_compact_visit_slots(h, gc_compact_pin_slot);
+}
+
+// Pin everything referred to from the heap other than through known fields
+// and slots. The roots have already been scanned.
+STATIC void gc_compact_pin_heap(void) {
+    gc_compact_holder_t holders[GC_COMPACT_MAX_ROOT_HOLDERS];
+    for (size_t i = gc_compact_root_holders(holders); i-- > 0;) {
+        gc_compact_pin_holder(&holders[i]);
+    }
+
+    size_t max_block = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    for (size_t block = 0; block < max_block; block++) {
+        if (ATB_GET_KIND(block) != AT_HEAD) {
+            // Storage is only referred to from its known slots.
+            continue;
+        }
+        size_t n_bytes = gc_compact_n_bytes(block);
+        void **ptrs = (void**)PTR_FROM_BLOCK(block);
+        gc_compact_holder_t h;
+        bool holder = gc_compact_get_holder((mp_obj_base_t*)ptrs, n_bytes, &h);
+        for (size_t i = 0; i < n_bytes / sizeof(void*); i++) {
+            if (holder && (&ptrs[i] == h.field
+                           || ((mp_obj_t*)&ptrs[i] >= h.items && (mp_obj_t*)&ptrs[i] < h.items + h.len))) {
+                continue;
+            }
+            gc_compact_pin(ptrs[i]);
+        }
+        if (holder) {
+            gc_compact_pin_holder(&h);
+        }
+    }
+}
+#endif
+
 // Mark can handle NULL pointers because it verifies the pointer is within the heap bounds.
 STATIC void gc_mark(void* ptr) {
+    #if MICROPY_GC_COMPACT
+    if (MP_STATE_MEM(gc_compact_pinning)) {
+        gc_compact_pin(ptr);
+        return;
+    }
+    #endif
     if (VERIFY_PTR(ptr)) {
         size_t block = BLOCK_FROM_PTR(ptr);
         if (ATB_GET_KIND(block) == AT_HEAD) {
@@ -358,13 +879,69 @@ STATIC void gc_mark(void* ptr) {
     }
 }
 
+#if MICROPY_GC_MINOR_COLLECT
+// A minor collection takes everything in the long lived part of the heap to
+// be alive without tracing it, and scans it for pointers to the rest of the
+// heap as if it were a root. There's no write barrier to keep a remembered
+// set with, so all of it is scanned, but that's a linear pass rather than a
+// trace and the long lived objects themselves are never freed.
+STATIC void gc_mark_long_lived(void) {
+    size_t first_block = BLOCK_FROM_PTR(MP_STATE_MEM(gc_lowest_long_lived_ptr));
+    size_t max_block = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    byte *atb = MP_STATE_MEM(gc_alloc_table_start);
+
+    // Mark all the heads first so that scanning doesn't trace into them.
+    size_t block = first_block;
+    for (; block < max_block && (block & (BLOCKS_PER_ATB - 1)) != 0; block++) {
+        if (ATB_GET_KIND(block) == AT_HEAD) {
+            ATB_HEAD_TO_MARK(block);
+        }
+    }
+    for (size_t i = block / BLOCKS_PER_ATB; i < MP_STATE_MEM(gc_alloc_table_byte_len); i++) {
+        byte a = atb[i];
+        atb[i] = a | ((a & ~(a >> 1) & 0x55) << 1);
+    }
+
+    // Then mark what they point to in the short lived part.
+    for (block = first_block; block < max_block; block++) {
+        if (ATB_GET_KIND(block) == AT_MARK) {
+            size_t n_blocks = 0;
+            do {
+                n_blocks += 1;
+            } while (block + n_blocks < max_block && ATB_GET_KIND(block + n_blocks) == AT_TAIL);
+            gc_collect_root((void**)PTR_FROM_BLOCK(block), n_blocks * BYTES_PER_BLOCK / sizeof(void*));
+            block += n_blocks - 1;
+        }
+    }
+}
+#endif
+
 void gc_collect_start(void) {
     GC_ENTER();
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // Marking needs every block to have been swept since the last collection.
+    gc_sweep_finish();
+    #endif
     MP_STATE_MEM(gc_lock_depth)++;
     #if MICROPY_GC_ALLOC_THRESHOLD
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
     MP_STATE_MEM(gc_stack_overflow) = 0;
+    MP_STATE_MEM(gc_stack_overflow_block) = (size_t)-1;
+    #if MICROPY_GC_ALLOC_PROFILER
+    // The bytecode of the cached line may be freed.
+    MP_STATE_MEM(gc_profile_last_ip) = NULL;
+    #endif
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    // So may the cached str, and its memory be reused for another.
+    MP_STATE_VM(str_index_cache).data = NULL;
+    #endif
+
+    #if MICROPY_GC_MINOR_COLLECT
+    if (MP_STATE_MEM(gc_collect_minor)) {
+        gc_mark_long_lived();
+    }
+    #endif
 
     // Trace root pointers.  This relies on the root pointers being organised
     // correctly in the mp_state_ctx structure.  We scan nlr_top, dict_locals,
@@ -376,6 +953,14 @@ void gc_collect_start(void) {
 
     gc_mark(MP_STATE_MEM(permanent_pointers));
 
+    #if MICROPY_GC_MAX_AREAS > 1
+    // The first block of each area after the lowest is kept allocated so that
+    // no allocation or run of free blocks crosses from one area to the next.
+    for (size_t i = 1; i < MP_STATE_MEM(gc_n_areas); i++) {
+        gc_mark(MP_STATE_MEM(gc_area_start)[i]);
+    }
+    #endif
+
     #if MICROPY_ENABLE_PYSTACK
     // Trace root pointers from the Python stack.
     ptrs = (void**)(void*)MP_STATE_THREAD(pystack_start);
@@ -391,9 +976,28 @@ void gc_collect_root(void **ptrs, size_t len) {
 }
 
 void gc_collect_end(void) {
+    #if MICROPY_GC_COMPACT
+    if (MP_STATE_MEM(gc_compact_pinning)) {
+        gc_compact_pin_heap();
+        MP_STATE_MEM(gc_lock_depth)--;
+        GC_EXIT();
+        return;
+    }
+    #endif
     gc_deal_with_stack_overflow();
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    if (MP_STATE_MEM(gc_sweep_incrementally)) {
+        #if MICROPY_PY_GC_COLLECT_RETVAL
+        MP_STATE_MEM(gc_collected) = 0;
+        #endif
+        MP_STATE_MEM(gc_sweep_block) = 0;
+    } else {
+        gc_sweep();
+    }
+    #else
     gc_sweep();
-    MP_STATE_MEM(gc_first_free_atb_index) = 0;
+    #endif
+    gc_lower_first_free(0, MICROPY_GC_ATB_INDICES);
     MP_STATE_MEM(gc_last_free_atb_index) = MP_STATE_MEM(gc_alloc_table_byte_len) - 1;
     MP_STATE_MEM(gc_lock_depth)--;
     GC_EXIT();
@@ -401,14 +1005,26 @@ void gc_collect_end(void) {
 
 void gc_sweep_all(void) {
     GC_ENTER();
+    #if MICROPY_GC_OBJ_FREELIST
+    // Everything is to be freed.
+    gc_freelist_clear();
+    #endif
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_finish();
+    #endif
     MP_STATE_MEM(gc_lock_depth)++;
     MP_STATE_MEM(gc_stack_overflow) = 0;
+    MP_STATE_MEM(gc_stack_overflow_block) = (size_t)-1;
     gc_collect_end();
 }
 
 void gc_info(gc_info_t *info) {
     GC_ENTER();
-    info->total = MP_STATE_MEM(gc_pool_end) - MP_STATE_MEM(gc_pool_start);
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // Count garbage left by an unfinished sweep as free.
+    gc_sweep_finish();
+    #endif
+    info->total = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB * BYTES_PER_BLOCK;
     info->used = 0;
     info->free = 0;
     info->max_free = 0;
@@ -470,6 +1086,206 @@ void gc_info(gc_info_t *info) {
     GC_EXIT();
 }
 
+// The number of free blocks at the low (bits 0-3) and high (bits 4-7) end of an
+// ATB byte, indexed by a nibble with a bit set for each of its blocks in use.
+STATIC const byte gc_free_at_ends[16] = {
+    0x44, 0x30, 0x21, 0x20, 0x12, 0x10, 0x11, 0x10,
+    0x03, 0x00, 0x01, 0x00, 0x02, 0x00, 0x01, 0x00,
+};
+
+#if MICROPY_GC_ALLOC_PROFILER
+// The profiler counts each allocation against the line of Python being run
+// and against the type of the object allocated.  The type is only filled in
+// by the caller after gc_alloc returns, so the last allocation is remembered
+// and its first word looked at when the next allocation is made.  That word
+// is only followed when it can be read safely: either it's on the heap, or
+// it's between the lowest and highest static types that gc_profile_start can
+// find, which are all in the same read-only section.
+
+STATIC void gc_profile_widen_types(const void *type) {
+    if (type < MP_STATE_MEM(gc_profile_types_lo)) {
+        MP_STATE_MEM(gc_profile_types_lo) = type;
+    }
+    if (type > MP_STATE_MEM(gc_profile_types_hi)) {
+        MP_STATE_MEM(gc_profile_types_hi) = type;
+    }
+}
+
+STATIC bool gc_profile_is_type(const mp_obj_type_t *type) {
+    if (((uintptr_t)type & (sizeof(void*) - 1)) != 0) {
+        return false;
+    }
+    if (!VERIFY_PTR((const void*)type)
+        && ((const void*)type < MP_STATE_MEM(gc_profile_types_lo)
+            || (const void*)type > MP_STATE_MEM(gc_profile_types_hi))) {
+        return false;
+    }
+    return type->base.type == &mp_type_type;
+}
+
+// Count the allocation made before this one against its type.
+STATIC void gc_profile_count_pending(void) {
+    void *ptr = MP_STATE_VM(gc_profile_pending);
+    if (ptr == NULL) {
+        return;
+    }
+    MP_STATE_VM(gc_profile_pending) = NULL;
+    gc_profile_type_t *types = MP_STATE_VM(gc_profile_types);
+    size_t i = 0;
+    size_t kind = ATB_GET_KIND(BLOCK_FROM_PTR(ptr));
+    const mp_obj_type_t *type = ((mp_obj_base_t*)ptr)->type;
+    if ((kind == AT_HEAD || kind == AT_MARK) && gc_profile_is_type(type)) {
+        size_t start = 1 + ((uintptr_t)type / sizeof(void*)) % (MICROPY_GC_ALLOC_PROFILER_TYPES - 1);
+        for (size_t j = start;;) {
+            if (types[j].type == type || types[j].type == NULL) {
+                types[j].type = type;
+                i = j;
+                break;
+            }
+            if (++j == MICROPY_GC_ALLOC_PROFILER_TYPES) {
+                j = 1;
+            }
+            if (j == start) {
+                // The table is full.
+                break;
+            }
+        }
+    }
+    types[i].count += 1;
+    types[i].bytes += MP_STATE_VM(gc_profile_pending_bytes);
+}
+
+STATIC size_t gc_profile_line_slot(const mp_code_state_t *code_state) {
+    if (code_state->ip == MP_STATE_MEM(gc_profile_last_ip)) {
+        return MP_STATE_MEM(gc_profile_last_line);
+    }
+    qstr block_name, source_file;
+    size_t line = mp_bytecode_get_source_line(code_state->fun_bc->bytecode, code_state->ip, &block_name, &source_file);
+    gc_profile_line_t *lines = MP_STATE_MEM(gc_profile_lines);
+    size_t start = 1 + (source_file * 31 + line) % (MICROPY_GC_ALLOC_PROFILER_LINES - 1);
+    size_t i = 0;
+    for (size_t j = start;;) {
+        if ((lines[j].source_file == source_file && lines[j].line == line) || lines[j].line == 0) {
+            lines[j].source_file = source_file;
+            lines[j].line = line;
+            i = j;
+            break;
+        }
+        if (++j == MICROPY_GC_ALLOC_PROFILER_LINES) {
+            j = 1;
+        }
+        if (j == start) {
+            break;
+        }
+    }
+    MP_STATE_MEM(gc_profile_last_ip) = code_state->ip;
+    MP_STATE_MEM(gc_profile_last_line) = i;
+    return i;
+}
+
+STATIC void gc_profile_alloc(void *ptr, size_t n_bytes) {
+    gc_profile_count_pending();
+    MP_STATE_VM(gc_profile_pending) = ptr;
+    MP_STATE_VM(gc_profile_pending_bytes) = n_bytes;
+
+    const mp_code_state_t *code_state = MP_STATE_THREAD(current_code_state);
+    size_t i = code_state == NULL ? 0 : gc_profile_line_slot(code_state);
+    MP_STATE_MEM(gc_profile_lines)[i].count += 1;
+    MP_STATE_MEM(gc_profile_lines)[i].bytes += n_bytes;
+}
+
+void gc_profile_start(void) {
+    GC_ENTER();
+    memset(MP_STATE_VM(gc_profile_types), 0, sizeof(MP_STATE_VM(gc_profile_types)));
+    memset(MP_STATE_MEM(gc_profile_lines), 0, sizeof(MP_STATE_MEM(gc_profile_lines)));
+    MP_STATE_VM(gc_profile_pending) = NULL;
+    MP_STATE_MEM(gc_profile_last_ip) = NULL;
+
+    // The core types and those in the builtin modules mark out the section
+    // that static types are in.
+    MP_STATE_MEM(gc_profile_types_lo) = &mp_type_type;
+    MP_STATE_MEM(gc_profile_types_hi) = &mp_type_type;
+    static const mp_obj_type_t *const core_types[] = {
+        &mp_type_object, &mp_type_NoneType, &mp_type_bool, &mp_type_int, &mp_type_str,
+        &mp_type_bytes, &mp_type_list, &mp_type_tuple, &mp_type_dict, &mp_type_module,
+        &mp_type_fun_bc, &mp_type_gen_instance, &mp_type_BaseException,
+    };
+    for (size_t i = 0; i < MP_ARRAY_SIZE(core_types); i++) {
+        gc_profile_widen_types(core_types[i]);
+    }
+    for (size_t i = 0; i < mp_builtin_module_map.alloc; i++) {
+        mp_obj_t module = mp_builtin_module_map.table[i].value;
+        if (module == MP_OBJ_NULL || !MP_OBJ_IS_TYPE(module, &mp_type_module)) {
+            continue;
+        }
+        mp_map_t *globals = &((mp_obj_module_t*)MP_OBJ_TO_PTR(module))->globals->map;
+        for (size_t j = 0; j < globals->alloc; j++) {
+            mp_obj_t value = globals->table[j].value;
+            if (value != MP_OBJ_NULL && MP_OBJ_IS_TYPE(value, &mp_type_type)
+                && !VERIFY_PTR(MP_OBJ_TO_PTR(value))) {
+                gc_profile_widen_types(MP_OBJ_TO_PTR(value));
+            }
+        }
+    }
+
+    MP_STATE_MEM(gc_profile_enabled) = true;
+    GC_EXIT();
+}
+
+void gc_profile_stop(void) {
+    GC_ENTER();
+    MP_STATE_MEM(gc_profile_enabled) = false;
+    gc_profile_count_pending();
+    GC_EXIT();
+}
+#endif
+
+#if MICROPY_GC_OBJ_FREELIST
+void *gc_freelist_alloc(size_t n_bytes, const void *type) {
+    if (n_bytes > BYTES_PER_BLOCK) {
+        return NULL;
+    }
+    // Most allocations find the freelist empty, so look without taking the
+    // GC lock first and check again with it.
+    size_t i = 0;
+    for (; i < MICROPY_GC_OBJ_FREELIST_TYPES; i++) {
+        if (MP_STATE_MEM(gc_freelist_type)[i] == type) {
+            if (MP_STATE_MEM(gc_freelist_len)[i] == 0) {
+                return NULL;
+            }
+            break;
+        }
+        if (MP_STATE_MEM(gc_freelist_type)[i] == NULL) {
+            break;
+        }
+    }
+    if (i == MICROPY_GC_OBJ_FREELIST_TYPES) {
+        return NULL;
+    }
+    GC_ENTER();
+    if (MP_STATE_MEM(gc_lock_depth) > 0) {
+        GC_EXIT();
+        return NULL;
+    }
+    void *ptr = NULL;
+    if (MP_STATE_MEM(gc_freelist_type)[i] == NULL) {
+        // Start a freelist for the type, which the next sweep will fill.
+        MP_STATE_MEM(gc_freelist_type)[i] = type;
+    } else if (MP_STATE_MEM(gc_freelist_type)[i] == type && MP_STATE_MEM(gc_freelist_len)[i] > 0) {
+        uint8_t len = --MP_STATE_MEM(gc_freelist_len)[i];
+        ptr = MP_STATE_VM(gc_freelist)[i][len];
+        MP_STATE_VM(gc_freelist)[i][len] = NULL;
+    }
+    #if MICROPY_GC_ALLOC_PROFILER
+    if (ptr != NULL && MP_STATE_MEM(gc_profile_enabled)) {
+        gc_profile_alloc(ptr, BYTES_PER_BLOCK);
+    }
+    #endif
+    GC_EXIT();
+    return ptr;
+}
+#endif
+
 // We place long lived objects at the end of the heap rather than the start. This reduces
 // fragmentation by localizing the heap churn to one portion of memory (the start of the heap.)
 void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
@@ -493,11 +1309,20 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
         return NULL;
     }
 
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // Do a slice of any sweep left over from the last collection.
+    gc_sweep_step(MICROPY_GC_SWEEP_STEP_BLOCKS);
+    size_t sweep_step = MICROPY_GC_SWEEP_STEP_BLOCKS;
+    #endif
+
     size_t found_block = 0xffffffff;
     size_t end_block;
     size_t start_block;
     size_t n_free;
     bool collected = !MP_STATE_MEM(gc_auto_collect_enabled);
+    #if MICROPY_GC_MINOR_COLLECT
+    bool minor_collected = false;
+    #endif
 
     #if MICROPY_GC_ALLOC_THRESHOLD
     if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
@@ -510,21 +1335,80 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     #endif
 
     bool keep_looking = true;
+    size_t first_free_index = MIN(n_blocks, MICROPY_GC_ATB_INDICES) - 1;
 
     // When we start searching on the other side of the crossover block we make sure to
     // perform a collect. That way we'll get the closest free block in our section.
     size_t crossover_block = BLOCK_FROM_PTR(MP_STATE_MEM(gc_lowest_long_lived_ptr));
     while (keep_looking) {
         int8_t direction = 1;
-        size_t start = MP_STATE_MEM(gc_first_free_atb_index);
+        size_t start = MP_STATE_MEM(gc_first_free_atb_index)[first_free_index];
         if (long_lived) {
             direction = -1;
             start = MP_STATE_MEM(gc_last_free_atb_index);
         }
         n_free = 0;
         // look for a run of n_blocks available blocks
-        for (size_t i = start; keep_looking && MP_STATE_MEM(gc_first_free_atb_index) <= i && i <= MP_STATE_MEM(gc_last_free_atb_index); i += direction) {
+        for (size_t i = start; keep_looking && MP_STATE_MEM(gc_first_free_atb_index)[first_free_index] <= i && i <= MP_STATE_MEM(gc_last_free_atb_index); i += direction) {
+            #if MICROPY_GC_INCREMENTAL_SWEEP
+            // Sweep ahead of the search as it reaches the unswept part of the
+            // heap, rather than searching it and then starting over.
+            if (direction == 1 && i * BLOCKS_PER_ATB >= MP_STATE_MEM(gc_sweep_block)) {
+                gc_sweep_step(sweep_step);
+            }
+            #endif
             byte a = MP_STATE_MEM(gc_alloc_table_start)[i];
+            // Handle four free blocks at once.
+            if (a == 0) {
+                if (n_free + BLOCKS_PER_ATB >= n_blocks) {
+                    size_t needed = n_blocks - n_free;
+                    found_block = i * BLOCKS_PER_ATB + (direction == 1 ? needed - 1 : BLOCKS_PER_ATB - needed);
+                    n_free = n_blocks;
+                    keep_looking = false;
+                } else {
+                    n_free += BLOCKS_PER_ATB;
+                }
+                continue;
+            }
+            // Otherwise work out which of the four blocks are in use and look
+            // for a run using that, unless we're at the crossover and must stop
+            // at the first block in use.
+            size_t first_block = i * BLOCKS_PER_ATB;
+            if (collected ||
+                    (direction == 1 && first_block + BLOCKS_PER_ATB - 1 < crossover_block) ||
+                    (direction == -1 && first_block >= crossover_block)) {
+                byte used = (a | (a >> 1)) & 0x55;
+                used = (used | (used >> 1)) & 0x33;
+                used = (used | (used >> 2)) & 0x0f;
+                size_t low_free = gc_free_at_ends[used] & 0xf;
+                size_t high_free = gc_free_at_ends[used] >> 4;
+                // Does the run we're in finish in this byte?
+                size_t needed = n_blocks - n_free;
+                if ((direction == 1 ? low_free : high_free) >= needed) {
+                    found_block = first_block + (direction == 1 ? needed - 1 : BLOCKS_PER_ATB - needed);
+                    n_free = n_blocks;
+                    keep_looking = false;
+                    continue;
+                }
+                // Is there a run in the middle of this byte?
+                if (n_blocks < BLOCKS_PER_ATB) {
+                    byte run = (1 << n_blocks) - 1;
+                    for (size_t k = 0; keep_looking && k <= BLOCKS_PER_ATB - n_blocks; k++) {
+                        size_t j = direction == 1 ? k : BLOCKS_PER_ATB - n_blocks - k;
+                        if ((used & (run << j)) == 0) {
+                            found_block = first_block + j + (direction == 1 ? n_blocks - 1 : 0);
+                            n_free = n_blocks;
+                            keep_looking = false;
+                        }
+                    }
+                    if (!keep_looking) {
+                        continue;
+                    }
+                }
+                // Start a new run with the free blocks at the far end.
+                n_free = direction == 1 ? high_free : low_free;
+                continue;
+            }
             // Four ATB states are packed into a single byte.
             int j = 0;
             if (direction == -1) {
@@ -552,14 +1436,49 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
             break;
         }
 
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        // Sweeping more of the heap is cheaper than collecting again. Long
+        // lived allocations come from the end of the heap so sweep all of it.
+        if (MP_STATE_MEM(gc_sweep_block) < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB) {
+            gc_sweep_step(long_lived ? MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB : sweep_step);
+            sweep_step *= 2;
+            keep_looking = true;
+            continue;
+        }
+        #endif
+
         GC_EXIT();
         // nothing found!
         if (collected) {
             return NULL;
         }
         DEBUG_printf("gc_alloc(" UINT_FMT "): no free mem, triggering GC\n", n_bytes);
-        gc_collect();
+        #if MICROPY_GC_MINOR_COLLECT
+        // Try collecting just the short lived part of the heap first, unless
+        // that's already been done or it's time for a full collection.
+        if (!minor_collected && !long_lived
+            && MP_STATE_MEM(gc_lowest_long_lived_ptr) < (void*)MP_STATE_MEM(gc_pool_end)
+            && MP_STATE_MEM(gc_minor_count) < MICROPY_GC_MINOR_PER_FULL) {
+            MP_STATE_MEM(gc_minor_count)++;
+            MP_STATE_MEM(gc_collect_minor) = true;
+            minor_collected = true;
+        } else {
+            MP_STATE_MEM(gc_minor_count) = 0;
+            collected = true;
+        }
+        #else
         collected = true;
+        #endif
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        MP_STATE_MEM(gc_sweep_incrementally) = true;
+        gc_collect();
+        MP_STATE_MEM(gc_sweep_incrementally) = false;
+        #else
+        gc_collect();
+        #endif
+        #if MICROPY_GC_MINOR_COLLECT
+        MP_STATE_MEM(gc_collect_minor) = false;
+        #endif
         // Try again since we've hopefully freed up space.
         keep_looking = true;
         GC_ENTER();
@@ -567,16 +1486,22 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     assert(found_block != 0xffffffff);
 
     // Found free space ending at found_block inclusive.
-    // Also, set last free ATB index to block after last block we found, for start of
-    // next scan.  To reduce fragmentation, we only do this if we were looking
-    // for a single free block, which guarantees that there are no free blocks
-    // before this one.  Also, whenever we free or shrink a block we must check
-    // if this index needs adjusting (see gc_realloc and gc_free).
+    // Also, set the first free ATB index for this size to the block after the
+    // last block we found, for start of next scan, since there is no run of
+    // this many free blocks before it.  The same holds for all larger sizes,
+    // but not for the last index if we were looking for more blocks than it
+    // tracks.  Also, whenever we free or shrink a block we must check if these
+    // indices need adjusting (see gc_realloc and gc_free).
     if (!long_lived) {
         end_block = found_block;
         start_block = found_block - n_free + 1;
-        if (n_blocks == 1) {
-            MP_STATE_MEM(gc_first_free_atb_index) = (found_block + 1) / BLOCKS_PER_ATB;
+        if (n_blocks <= MICROPY_GC_ATB_INDICES) {
+            size_t next_free_atb = (found_block + 1) / BLOCKS_PER_ATB;
+            for (size_t i = first_free_index; i < MICROPY_GC_ATB_INDICES; i++) {
+                if (MP_STATE_MEM(gc_first_free_atb_index)[i] < next_free_atb) {
+                    MP_STATE_MEM(gc_first_free_atb_index)[i] = next_free_atb;
+                }
+            }
         }
     } else {
         start_block = found_block;
@@ -592,6 +1517,12 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
 
     // mark first block as used head
     ATB_FREE_TO_HEAD(start_block);
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    if (start_block >= MP_STATE_MEM(gc_sweep_block)) {
+        // Not swept yet, so it must be marked to survive the rest of the sweep.
+        ATB_HEAD_TO_MARK(start_block);
+    }
+    #endif
 
     // mark rest of blocks as used tail
     // TODO for a run of many blocks can make this more efficient
@@ -601,7 +1532,7 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
 
     // get pointer to first block
     // we must create this pointer before unlocking the GC so a collection can find it
-    void *ret_ptr = (void*)(MP_STATE_MEM(gc_pool_start) + start_block * BYTES_PER_BLOCK);
+    void *ret_ptr = (void*)PTR_FROM_BLOCK(start_block);
     DEBUG_printf("gc_alloc(%p)\n", ret_ptr);
 
     // If the allocation was long live then update the lowest value. Its used to trigger early
@@ -615,6 +1546,12 @@ void *gc_alloc(size_t n_bytes, bool has_finaliser, bool long_lived) {
     MP_STATE_MEM(gc_alloc_amount) += n_blocks;
     #endif
 
+    #if MICROPY_GC_ALLOC_PROFILER
+    if (MP_STATE_MEM(gc_profile_enabled)) {
+        gc_profile_alloc(ret_ptr, n_blocks * BYTES_PER_BLOCK);
+    }
+    #endif
+
     GC_EXIT();
 
     #if MICROPY_GC_CONSERVATIVE_CLEAR
@@ -671,22 +1608,25 @@ void gc_free(void *ptr) {
 
     DEBUG_printf("gc_free(%p)\n", ptr);
 
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    if (ptr == MP_STATE_VM(str_index_cache).data) {
+        MP_STATE_VM(str_index_cache).data = NULL;
+    }
+    #endif
+
     if (ptr == NULL) {
         GC_EXIT();
     } else {
         // get the GC block number corresponding to this pointer
         assert(VERIFY_PTR(ptr));
         size_t block = BLOCK_FROM_PTR(ptr);
-        assert(ATB_GET_KIND(block) == AT_HEAD);
+        assert(ATB_IS_ALLOCATED_HEAD(block));
 
         #if MICROPY_ENABLE_FINALISER
         FTB_CLEAR(block);
         #endif
 
         // set the last_free pointer to this block if it's earlier in the heap
-        if (block / BLOCKS_PER_ATB < MP_STATE_MEM(gc_first_free_atb_index)) {
-            MP_STATE_MEM(gc_first_free_atb_index) = block / BLOCKS_PER_ATB;
-        }
         if (block / BLOCKS_PER_ATB > MP_STATE_MEM(gc_last_free_atb_index)) {
             MP_STATE_MEM(gc_last_free_atb_index) = block / BLOCKS_PER_ATB;
         }
@@ -695,11 +1635,15 @@ void gc_free(void *ptr) {
             #ifdef LOG_HEAP_ACTIVITY
             gc_log_change(block, 0);
             #endif
+        size_t start_block = block;
         do {
             ATB_ANY_TO_FREE(block);
             block += 1;
         } while (ATB_GET_KIND(block) == AT_TAIL);
 
+        // set the first free pointers to this block if it's earlier in the heap
+        gc_lower_first_free(start_block / BLOCKS_PER_ATB, block - start_block);
+
         GC_EXIT();
 
         #if EXTENSIVE_HEAP_PROFILING
@@ -712,7 +1656,7 @@ size_t gc_nbytes(const void *ptr) {
     GC_ENTER();
     if (VERIFY_PTR(ptr)) {
         size_t block = BLOCK_FROM_PTR(ptr);
-        if (ATB_GET_KIND(block) == AT_HEAD) {
+        if (ATB_IS_ALLOCATED_HEAD(block)) {
             // work out number of consecutive blocks in the chain starting with this on
             size_t n_blocks = 0;
             do {
@@ -825,7 +1769,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     // get the GC block number corresponding to this pointer
     assert(VERIFY_PTR(ptr));
     size_t block = BLOCK_FROM_PTR(ptr);
-    assert(ATB_GET_KIND(block) == AT_HEAD);
+    assert(ATB_IS_ALLOCATED_HEAD(block));
 
     // compute number of new blocks that are requested
     size_t new_blocks = (n_bytes + BYTES_PER_BLOCK - 1) / BYTES_PER_BLOCK;
@@ -870,9 +1814,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
         }
 
         // set the last_free pointer to end of this block if it's earlier in the heap
-        if ((block + new_blocks) / BLOCKS_PER_ATB < MP_STATE_MEM(gc_first_free_atb_index)) {
-            MP_STATE_MEM(gc_first_free_atb_index) = (block + new_blocks) / BLOCKS_PER_ATB;
-        }
+        gc_lower_first_free((block + new_blocks) / BLOCKS_PER_ATB, n_blocks - new_blocks);
         if ((block + new_blocks) / BLOCKS_PER_ATB > MP_STATE_MEM(gc_last_free_atb_index)) {
             MP_STATE_MEM(gc_last_free_atb_index) = (block + new_blocks) / BLOCKS_PER_ATB;
         }
@@ -977,6 +1919,156 @@ bool gc_never_free(void *ptr) {
     return true;
 }
 
+#if MICROPY_GC_COMPACT
+// Calls visit for every object on the heap or in the roots whose references
+// are known, skipping any that have been moved.
+STATIC void gc_compact_each_holder(void (*visit)(gc_compact_holder_t *h)) {
+    gc_compact_holder_t holders[GC_COMPACT_MAX_ROOT_HOLDERS];
+    for (size_t i = gc_compact_root_holders(holders); i-- > 0;) {
+        visit(&holders[i]);
+    }
+    size_t max_block = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    for (size_t block = 0; block < max_block; block++) {
+        gc_compact_holder_t h;
+        if (ATB_GET_KIND(block) == AT_HEAD
+            && gc_compact_get_holder((mp_obj_base_t*)PTR_FROM_BLOCK(block), gc_compact_n_bytes(block), &h)) {
+            visit(&h);
+        }
+    }
+}
+
+// Mark storage that has a single known owner and isn't an object itself.
+STATIC void gc_compact_claim_storage(gc_compact_holder_t *h) {
+    if (h->field == NULL || !VERIFY_PTR(*h->field)) {
+        return;
+    }
+    size_t block = BLOCK_FROM_PTR(*h->field);
+    if (ATB_GET_KIND(block) == AT_MARK) {
+        // Shared with another owner.
+        FTB_SET(block);
+    } else if (ATB_GET_KIND(block) == AT_HEAD && !FTB_GET(block)) {
+        mp_obj_base_t *o = (mp_obj_base_t*)*h->field;
+        gc_compact_holder_t storage_h;
+        if (!gc_compact_is_movable_type(o->type) && !gc_compact_get_holder(o, gc_compact_n_bytes(block), &storage_h)) {
+            ATB_HEAD_TO_MARK(block);
+        }
+    }
+}
+
+// Returns the final address of an allocation that may have been moved.
+STATIC void *gc_compact_forward(void *ptr) {
+    while (gc_compact_storage_n_bytes(ptr) != 0 && GC_COMPACT_IS_MOVED(ptr)) {
+        ptr = ((void**)ptr)[1];
+    }
+    return ptr;
+}
+
+// Copies the allocation starting at block lower down the heap, leaving a
+// forwarding address behind. Returns false if there's no room for it there.
+STATIC bool gc_compact_move(size_t block) {
+    void *ptr = (void*)PTR_FROM_BLOCK(block);
+    size_t n_bytes = gc_compact_n_bytes(block);
+    void *new_ptr = gc_alloc(n_bytes, false, false);
+    if (new_ptr == NULL) {
+        return false;
+    }
+    if (new_ptr > ptr) {
+        gc_free(new_ptr);
+        return false;
+    }
+    memcpy(new_ptr, ptr, n_bytes);
+    ((const void**)ptr)[0] = &gc_compact_moved;
+    ((void**)ptr)[1] = new_ptr;
+
+    // The copy stays where it is and keeps being storage if it was.
+    size_t new_block = BLOCK_FROM_PTR(new_ptr);
+    FTB_SET(new_block);
+    if (ATB_GET_KIND(block) == AT_MARK) {
+        ATB_HEAD_TO_MARK(new_block);
+    }
+    return true;
+}
+
+STATIC void gc_compact_fix_field(gc_compact_holder_t *h) {
+    if (h->field != NULL) {
+        *h->field = gc_compact_forward(*h->field);
+    }
+}
+
+STATIC void gc_compact_fix_slot(mp_obj_t *slot) {
+    if (MP_OBJ_IS_OBJ(*slot)) {
+        void *ptr = MP_OBJ_TO_PTR(*slot);
+        void *new_ptr = gc_compact_forward(ptr);
+        if (new_ptr != ptr) {
+            *slot = MP_OBJ_FROM_PTR(new_ptr);
+        }
+    }
+}
+
+STATIC void gc_compact_fix_slots(gc_compact_holder_t *h) {
+    gc_compact_visit_slots(h, gc_compact_fix_slot);
+}
+
+void gc_compact(void) {
+    if (gc_is_locked()) {
+        return;
+    }
+    #if MICROPY_GC_OBJ_FREELIST
+    // Don't let freelisted objects pin anything.
+    gc_freelist_clear();
+    #endif
+    // Start from a heap that only holds live allocations.
+    gc_collect();
+    bool auto_collect_enabled = MP_STATE_MEM(gc_auto_collect_enabled);
+    MP_STATE_MEM(gc_auto_collect_enabled) = false;
+
+    gc_compact_each_holder(gc_compact_claim_storage);
+
+    // Find everything that is referred to from places that can't be updated
+    // by scanning the same roots as a collection.
+    MP_STATE_MEM(gc_compact_pinning) = true;
+    gc_collect();
+    MP_STATE_MEM(gc_compact_pinning) = false;
+
+    // Move the highest allocations first so that the free memory they leave
+    // joins up with the space above them. Long-lived allocations stay put.
+    size_t block = BLOCK_FROM_PTR(MP_STATE_MEM(gc_lowest_long_lived_ptr));
+    while (block-- > 0) {
+        size_t kind = ATB_GET_KIND(block);
+        if ((kind == AT_MARK && !FTB_GET(block))
+            || (kind == AT_HEAD && !FTB_GET(block)
+                && gc_compact_is_movable_type(((mp_obj_base_t*)PTR_FROM_BLOCK(block))->type))) {
+            gc_compact_move(block);
+        }
+    }
+
+    // Point everything at the copies. Fields are done first so that the
+    // slots of moved storage are found at its new address.
+    gc_compact_each_holder(gc_compact_fix_field);
+    gc_compact_each_holder(gc_compact_fix_slots);
+
+    // Free what was left behind and clear the pins.
+    size_t max_block = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    for (block = 0; block < max_block; block++) {
+        size_t kind = ATB_GET_KIND(block);
+        if (kind == AT_MARK) {
+            FTB_CLEAR(block);
+            ATB_MARK_TO_HEAD(block);
+        } else if (kind != AT_HEAD) {
+            continue;
+        }
+        void *ptr = (void*)PTR_FROM_BLOCK(block);
+        if (GC_COMPACT_IS_MOVED(ptr)) {
+            gc_free(ptr);
+        } else if (gc_compact_is_movable_type(((mp_obj_base_t*)ptr)->type)) {
+            FTB_CLEAR(block);
+        }
+    }
+
+    MP_STATE_MEM(gc_auto_collect_enabled) = auto_collect_enabled;
+}
+#endif
+
 void gc_dump_info(void) {
     gc_info_t info;
     gc_info(&info);
@@ -1051,7 +2143,7 @@ void gc_dump_alloc_table(void) {
             case AT_HEAD: {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wcast-align"
-                void **ptr = (void**)(MP_STATE_MEM(gc_pool_start) + bl * BYTES_PER_BLOCK);
+                void **ptr = (void**)PTR_FROM_BLOCK(bl);
 #pragma GCC diagnostic pop
                 if (*ptr == &mp_type_tuple) { c = 'T'; }
                 else if (*ptr == &mp_type_list) { c = 'L'; }
@@ -1099,6 +2191,98 @@ void gc_dump_alloc_table(void) {
     GC_EXIT();
 }
 
+#if MICROPY_GC_HEAP_SNAPSHOT
+// The snapshot is gathered here so that it reaches the output in a few large
+// writes rather than one per word.
+typedef struct _gc_snapshot_out_t {
+    const mp_print_t *print;
+    size_t len;
+    byte buf[256];
+} gc_snapshot_out_t;
+
+STATIC void gc_snapshot_flush(gc_snapshot_out_t *out) {
+    if (out->len > 0) {
+        out->print->print_strn(out->print->data, (const char*)out->buf, out->len);
+        out->len = 0;
+    }
+}
+
+STATIC void gc_snapshot_write(gc_snapshot_out_t *out, const void *data, size_t len) {
+    const byte *src = data;
+    while (len > 0) {
+        size_t n = MIN(len, sizeof(out->buf) - out->len);
+        memcpy(out->buf + out->len, src, n);
+        out->len += n;
+        src += n;
+        len -= n;
+        if (out->len == sizeof(out->buf)) {
+            gc_snapshot_flush(out);
+        }
+    }
+}
+
+STATIC void gc_snapshot_write_word(gc_snapshot_out_t *out, uintptr_t word) {
+    gc_snapshot_write(out, &word, sizeof(word));
+}
+
+// Write the layout of the heap for tools/analyze_heap_dump.py.  It's all in
+// the native byte order, with words the size of a pointer:
+//   "MPHS", version (1 byte), word size (1 byte), bytes per block (2 bytes)
+//   words: ATB length, FTB length, lowest long lived pointer, number of areas
+//   words for each area: start of its pool, number of blocks in it
+//   words: address of the root pointers, number of root pointers
+//   the ATB, then the FTB
+//   the root pointers
+//   the first word, usually the type, of each allocated block in block order
+// The blocks are numbered through the areas in order.  The heap mustn't
+// change while it's written, so the caller locks the GC.
+void gc_dump_snapshot(const mp_print_t *print) {
+    gc_snapshot_out_t out = {print, 0, {0}};
+    const size_t atb_len = MP_STATE_MEM(gc_alloc_table_byte_len);
+    #if MICROPY_ENABLE_FINALISER
+    const size_t ftb_len = (atb_len * BLOCKS_PER_ATB + BLOCKS_PER_FTB - 1) / BLOCKS_PER_FTB;
+    #else
+    const size_t ftb_len = 0;
+    #endif
+    const byte header[] = {'M', 'P', 'H', 'S', 1, sizeof(uintptr_t), BYTES_PER_BLOCK & 0xff, BYTES_PER_BLOCK >> 8};
+    gc_snapshot_write(&out, header, sizeof(header));
+    gc_snapshot_write_word(&out, atb_len);
+    gc_snapshot_write_word(&out, ftb_len);
+    gc_snapshot_write_word(&out, (uintptr_t)MP_STATE_MEM(gc_lowest_long_lived_ptr));
+    #if MICROPY_GC_MAX_AREAS > 1
+    gc_snapshot_write_word(&out, MP_STATE_MEM(gc_n_areas));
+    for (size_t i = 0; i < MP_STATE_MEM(gc_n_areas); i++) {
+        gc_snapshot_write_word(&out, (uintptr_t)MP_STATE_MEM(gc_area_start)[i]);
+        gc_snapshot_write_word(&out, (MP_STATE_MEM(gc_area_end)[i] - MP_STATE_MEM(gc_area_start)[i]) / BYTES_PER_BLOCK);
+    }
+    #else
+    gc_snapshot_write_word(&out, 1);
+    gc_snapshot_write_word(&out, (uintptr_t)MP_STATE_MEM(gc_pool_start));
+    gc_snapshot_write_word(&out, atb_len * BLOCKS_PER_ATB);
+    #endif
+
+    // The same root pointers as gc_collect_start traces.
+    void **roots = (void**)(void*)&mp_state_ctx + offsetof(mp_state_ctx_t, thread.dict_locals) / sizeof(void*);
+    size_t n_roots = (offsetof(mp_state_ctx_t, vm.qstr_last_chunk) - offsetof(mp_state_ctx_t, thread.dict_locals)) / sizeof(void*);
+    gc_snapshot_write_word(&out, (uintptr_t)roots);
+    gc_snapshot_write_word(&out, n_roots);
+
+    gc_snapshot_write(&out, MP_STATE_MEM(gc_alloc_table_start), atb_len);
+    #if MICROPY_ENABLE_FINALISER
+    gc_snapshot_write(&out, MP_STATE_MEM(gc_finaliser_table_start), ftb_len);
+    #endif
+    gc_snapshot_write(&out, roots, n_roots * sizeof(void*));
+
+    for (size_t bl = 0; bl < atb_len * BLOCKS_PER_ATB; bl++) {
+        size_t kind = ATB_GET_KIND(bl);
+        if (kind == AT_HEAD || kind == AT_MARK) {
+            gc_snapshot_write_word(&out, *(uintptr_t*)PTR_FROM_BLOCK(bl));
+        }
+    }
+    gc_snapshot_flush(&out);
+}
+#endif
+
 #if DEBUG_PRINT
 void gc_test(void) {
     mp_uint_t len = 500;
@@ -30,8 +30,22 @@
 
 #include "py/mpconfig.h"
 #include "py/misc.h"
+#include "py/mpprint.h"
 
 void gc_init(void *start, void *end);
+
+#if MICROPY_GC_MAX_AREAS > 1
+typedef struct _gc_area_t {
+    void *start;
+    void *end;
+} gc_area_t;
+
+// Like gc_init but the heap also uses up to MICROPY_GC_MAX_AREAS - 1 more
+// areas of memory after the first.  Areas too small to be worth using are
+// skipped.
+void gc_init_areas(const gc_area_t *areas, size_t n_areas);
+#endif
+
 void gc_deinit(void);
 
 // These lock/unlock functions can be nested.
@@ -61,6 +75,20 @@ void *gc_realloc(void *ptr, size_t n_bytes, bool allow_move);
 // very sparingly because it can leak memory.
 bool gc_never_free(void *ptr);
 
+// Returns a dead object of the given type kept by the sweep, or NULL if there
+// is none, in which case the type gets a freelist for later sweeps to fill.
+// Only the first word of the object is set. See MICROPY_GC_OBJ_FREELIST.
+void *gc_freelist_alloc(size_t n_bytes, const void *type);
+
+// Moves objects that are only referenced from known slots lower in the heap
+// to join up free memory. See MICROPY_GC_COMPACT.
+void gc_compact(void);
+
+// Start counting allocations by type and line, clearing any earlier counts,
+// and stop again. See MICROPY_GC_ALLOC_PROFILER.
+void gc_profile_start(void);
+void gc_profile_stop(void);
+
 typedef struct _gc_info_t {
     size_t total;
     size_t used;
@@ -75,4 +103,8 @@ void gc_info(gc_info_t *info);
 void gc_dump_info(void);
 void gc_dump_alloc_table(void);
 
+// Writes the allocation tables, the root pointers and the type of every
+// object to print in a compact binary form. See MICROPY_GC_HEAP_SNAPSHOT.
+void gc_dump_snapshot(const mp_print_t *print);
+
 #endif // MICROPY_INCLUDED_PY_GC_H
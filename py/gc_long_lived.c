@@ -28,6 +28,9 @@
 #include "py/gc_long_lived.h"
 #include "py/gc.h"
 #include "py/mpstate.h"
+#include "py/objint.h"
+#include "py/objlist.h"
+#include "py/objtuple.h"
 
 mp_obj_fun_bc_t *make_fun_bc_long_lived(mp_obj_fun_bc_t *fun_bc, uint8_t max_depth) {
     #ifndef MICROPY_ENABLE_GC
@@ -119,11 +122,42 @@ mp_obj_str_t *make_str_long_lived(mp_obj_str_t *str) {
     return gc_make_long_lived(str);
 }
 
+mp_obj_tuple_t *make_tuple_long_lived(mp_obj_tuple_t *tuple, uint8_t max_depth) {
+    #ifndef MICROPY_ENABLE_GC
+    return tuple;
+    #endif
+    if (max_depth == 0) {
+        return tuple;
+    }
+    // The items are stored inline so update them before the tuple is copied.
+    for (size_t i = 0; i < tuple->len; i++) {
+        tuple->items[i] = make_obj_long_lived(tuple->items[i], max_depth - 1);
+    }
+    return gc_make_long_lived(tuple);
+}
+
+mp_obj_list_t *make_list_long_lived(mp_obj_list_t *list, uint8_t max_depth) {
+    #ifndef MICROPY_ENABLE_GC
+    return list;
+    #endif
+    if (max_depth == 0) {
+        return list;
+    }
+    for (size_t i = 0; i < list->len; i++) {
+        list->items[i] = make_obj_long_lived(list->items[i], max_depth - 1);
+    }
+    // The item array belongs to this list alone so it can always move with it.
+    list->items = gc_make_long_lived(list->items);
+    return gc_make_long_lived(list);
+}
+
 mp_obj_t make_obj_long_lived(mp_obj_t obj, uint8_t max_depth){
     #ifndef MICROPY_ENABLE_GC
     return obj;
     #endif
-    if (obj == NULL) {
+    if (obj == NULL || !MP_OBJ_IS_OBJ(obj) || gc_nbytes(MP_OBJ_TO_PTR(obj)) == 0) {
+        // Small ints and qstrs aren't on the heap, and neither are frozen
+        // constants such as strings, big ints and tuples in ROM.
         return obj;
     }
     if (MP_OBJ_IS_TYPE(obj, &mp_type_fun_bc)) {
@@ -135,6 +169,25 @@ mp_obj_t make_obj_long_lived(mp_obj_t obj, uint8_t max_depth){
     } else if (MP_OBJ_IS_TYPE(obj, &mp_type_str) || MP_OBJ_IS_TYPE(obj, &mp_type_bytes)) {
         mp_obj_str_t *str = MP_OBJ_TO_PTR(obj);
         return MP_OBJ_FROM_PTR(make_str_long_lived(str));
+    } else if (MP_OBJ_IS_TYPE(obj, &mp_type_tuple)) {
+        mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(obj);
+        return MP_OBJ_FROM_PTR(make_tuple_long_lived(tuple, max_depth));
+    } else if (MP_OBJ_IS_TYPE(obj, &mp_type_list)) {
+        mp_obj_list_t *list = MP_OBJ_TO_PTR(obj);
+        return MP_OBJ_FROM_PTR(make_list_long_lived(list, max_depth));
+    } else if (MP_OBJ_IS_TYPE(obj, &mp_type_dict)) {
+        return MP_OBJ_FROM_PTR(make_dict_long_lived(MP_OBJ_TO_PTR(obj), max_depth));
+    } else if (MP_OBJ_IS_TYPE(obj, &mp_type_staticmethod) || MP_OBJ_IS_TYPE(obj, &mp_type_classmethod)) {
+        mp_obj_static_class_method_t *method = MP_OBJ_TO_PTR(obj);
+        method->fun = make_obj_long_lived(method->fun, max_depth);
+        return gc_make_long_lived(method);
+    #if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ
+    } else if (MP_OBJ_IS_TYPE(obj, &mp_type_int)) {
+        // Large constants in lookup tables; the digits belong to this int alone.
+        mp_obj_int_t *big = MP_OBJ_TO_PTR(obj);
+        big->mpz.dig = gc_make_long_lived(big->mpz.dig);
+        return gc_make_long_lived(big);
+    #endif
     } else if (MP_OBJ_IS_TYPE(obj, &mp_type_type)) {
         // Types are already long lived during creation.
         return obj;
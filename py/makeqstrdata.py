@@ -341,6 +341,8 @@ def print_qstr_data(encoding_table, qcfgs, qstrs, i18ns):
         print('QDEF(MP_QSTR_%s, %s)' % (ident, qbytes))
         total_qstr_size += len(qstr)
 
+    print_qstr_hash_index(cfg_bytes_hash, qstrs)
+
     total_text_size = 0
     total_text_compressed_size = 0
     for original, translation in i18ns:
@@ -359,6 +361,30 @@ def print_qstr_data(encoding_table, qcfgs, qstrs, i18ns):
     print("// {} bytes worth of translations compressed".format(total_text_compressed_size))
     print("// {} bytes saved".format(total_text_size - total_text_compressed_size))
 
+def print_qstr_hash_index(cfg_bytes_hash, qstrs):
+    # Group the qstrs by the low bits of their hash so that qstr_find_strn only
+    # needs to compare against one bucket of the const pool. Each QHASH_BUCKET
+    # gives the index of the first QHASH_ENTRY in that bucket, and a final one
+    # marks the end of the last bucket.
+    n_buckets = 1
+    while n_buckets < len(qstrs) // 4 and n_buckets < (1 << (8 * cfg_bytes_hash)):
+        n_buckets *= 2
+    buckets = [[] for _ in range(n_buckets)]
+    for order, ident, qstr in sorted(qstrs.values(), key=lambda x: x[0]):
+        qhash = compute_hash(bytes_cons(qstr, 'utf8'), cfg_bytes_hash)
+        buckets[qhash & (n_buckets - 1)].append(ident)
+
+    print('#ifdef QHASH_ENTRY')
+    start = 0
+    for bucket in buckets:
+        print('QHASH_BUCKET(%d)' % start)
+        start += len(bucket)
+    print('QHASH_BUCKET(%d)' % start)
+    for bucket in buckets:
+        for ident in bucket:
+            print('QHASH_ENTRY(MP_QSTR_%s)' % ident)
+    print('#endif')
+
 def print_qstr_enums(qstrs):
     # print out the starter of the generated C header file
     print('// This file was automatically generated by makeqstrdata.py')
@@ -91,6 +91,22 @@ void *m_malloc(size_t num_bytes, bool long_lived) {
     return ptr;
 }
 
+#if MICROPY_ENABLE_GC && MICROPY_GC_OBJ_FREELIST
+void *m_malloc_from_freelist(size_t num_bytes, const void *obj_type) {
+    void *ptr = gc_freelist_alloc(num_bytes, obj_type);
+    if (ptr == NULL) {
+        return m_malloc(num_bytes, false);
+    }
+#if MICROPY_MEM_STATS
+    MP_STATE_MEM(total_bytes_allocated) += num_bytes;
+    MP_STATE_MEM(current_bytes_allocated) += num_bytes;
+    UPDATE_PEAK();
+#endif
+    DEBUG_printf("malloc %d : %p\n", num_bytes, ptr);
+    return ptr;
+}
+#endif
+
 void *m_malloc_maybe(size_t num_bytes, bool long_lived) {
     void *ptr = malloc_ll(num_bytes, long_lived);
 #if MICROPY_MEM_STATS
@@ -40,6 +40,17 @@
 #define DEBUG_printf(...) (void)0
 #endif
 
+#if MICROPY_OPT_MAP_LOOKUP_CACHE
+// The cache maps a key's address to the position it was last found at in some
+// map.  A hit is only used after checking that the slot really holds the key,
+// so collisions between maps just fall back to the normal search.
+#define MAP_CACHE_OFFSET(index) ((((uintptr_t)(index)) >> 2) % MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE)
+#define MAP_CACHE_ENTRY(index) (MP_STATE_VM(map_lookup_cache)[MAP_CACHE_OFFSET(index)])
+#define MAP_CACHE_SET(index, pos) MAP_CACHE_ENTRY(index) = (pos) & 0xff
+#else
+#define MAP_CACHE_SET(index, pos)
+#endif
+
 // Fixed empty map. Useful when need to call kw-receiving functions
 // without any keywords from C, etc.
 const mp_map_t mp_const_empty_map = {
@@ -76,15 +87,140 @@ STATIC size_t get_hash_alloc_greater_or_equal_to(size_t x) {
 /******************************************************************************/
 /* map                                                                        */
 
+// A map that isn't a fixed table keeps its entries packed at the start of
+// map->table in insertion order, so iteration visits them in that order.
+//
+// Small maps, which are most instance and class dicts, are just that array
+// and are searched linearly: comparing a few qstr pointers is quicker than
+// hashing, and there's no index to pay for.  Removing an entry moves the later
+// ones down.
+//
+// Larger maps also have an index after the alloc entries: a word holding the
+// index mask, a word holding the number of entries used so far, and then a
+// power of two number of hash slots.  Each slot holds the position of an entry
+// or one of the markers below and is 8, 16 or 32 bits wide depending on alloc.
+// Removing an entry leaves MP_OBJ_SENTINEL as its key until the table is next
+// rebuilt.  Each entry added since the last rebuild fills at most one slot
+// and there are more slots than entries, so a search always ends at an empty
+// slot.
+#define MAP_LINEAR_MAX (8)
+#define MAP_INDEX_EMPTY ((size_t)-1)
+#define MAP_INDEX_DELETED ((size_t)-2)
+
+static inline bool map_is_indexed(size_t alloc) {
+    return alloc > MAP_LINEAR_MAX;
+}
+
+STATIC size_t map_index_n_slots(size_t alloc) {
+    size_t n_slots = 16;
+    while (n_slots < alloc + alloc / 4 + 1) {
+        n_slots <<= 1;
+    }
+    return n_slots;
+}
+
+STATIC size_t map_index_slot_size(size_t alloc) {
+    if (alloc < 0xfe) {
+        return 1;
+    } else if (alloc < 0xfffe) {
+        return 2;
+    } else {
+        return 4;
+    }
+}
+
+STATIC size_t map_table_n_bytes(size_t alloc) {
+    size_t n_bytes = alloc * sizeof(mp_map_elem_t);
+    if (map_is_indexed(alloc)) {
+        n_bytes += 2 * sizeof(size_t) + map_index_n_slots(alloc) * map_index_slot_size(alloc);
+    }
+    return n_bytes;
+}
+
+static inline size_t *map_index_header(const mp_map_t *map) {
+    return (size_t*)&map->table[map->alloc];
+}
+#define MAP_INDEX_MASK(map) (map_index_header(map)[0])
+#define MAP_INDEX_FILLED(map) (map_index_header(map)[1])
+
+static inline size_t map_index_get(const mp_map_t *map, size_t pos) {
+    const void *index = map_index_header(map) + 2;
+    size_t alloc = map->alloc;
+    if (alloc < 0xfe) {
+        uint8_t v = ((const uint8_t*)index)[pos];
+        return v >= 0xfe ? (size_t)(v - 0x100) : v;
+    } else if (alloc < 0xfffe) {
+        uint16_t v = ((const uint16_t*)index)[pos];
+        return v >= 0xfffe ? (size_t)(v - 0x10000) : v;
+    } else {
+        uint32_t v = ((const uint32_t*)index)[pos];
+        return v >= 0xfffffffe ? (size_t)(int32_t)v : v;
+    }
+}
+
+static inline void map_index_set(const mp_map_t *map, size_t pos, size_t value) {
+    void *index = map_index_header(map) + 2;
+    size_t alloc = map->alloc;
+    if (alloc < 0xfe) {
+        ((uint8_t*)index)[pos] = value;
+    } else if (alloc < 0xfffe) {
+        ((uint16_t*)index)[pos] = value;
+    } else {
+        ((uint32_t*)index)[pos] = value;
+    }
+}
+
+STATIC mp_uint_t map_hash(mp_obj_t key) {
+    // fast path for the common case of qstr
+    if (MP_OBJ_IS_QSTR(key)) {
+        return qstr_hash(MP_OBJ_QSTR_VALUE(key));
+    } else {
+        return MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, key));
+    }
+}
+
+// The probe sequence is CPython's.  Mixing in the high bits of the hash keeps
+// keys whose hashes share their low bits, such as object addresses, from all
+// following the same chain.
+#define MAP_PROBE_NEXT(pos, perturb, mask) do { \
+        perturb >>= 5; \
+        pos = (pos * 5 + 1 + perturb) & (mask); \
+    } while (0)
+
+// Fills the index from scratch for the packed entries in the table.
+STATIC void map_index_build(mp_map_t *map) {
+    size_t mask = map_index_n_slots(map->alloc) - 1;
+    MAP_INDEX_MASK(map) = mask;
+    MAP_INDEX_FILLED(map) = map->used;
+    // MAP_INDEX_EMPTY has all bits set for every slot size
+    memset(map_index_header(map) + 2, 0xff, (mask + 1) * map_index_slot_size(map->alloc));
+    for (size_t i = 0; i < map->used; i++) {
+        mp_uint_t perturb = map_hash(map->table[i].key);
+        size_t pos = perturb & mask;
+        while (map_index_get(map, pos) != MAP_INDEX_EMPTY) {
+            MAP_PROBE_NEXT(pos, perturb, mask);
+        }
+        map_index_set(map, pos, i);
+    }
+}
+
+STATIC void map_table_free(mp_map_t *map) {
+    if (!map->is_fixed) {
+        m_del(byte, map->table, map_table_n_bytes(map->alloc));
+    }
+}
+
 void mp_map_init(mp_map_t *map, size_t n) {
+    map->used = 0;
+    map->alloc = n;
     if (n == 0) {
-        map->alloc = 0;
         map->table = NULL;
     } else {
-        map->alloc = n;
-        map->table = m_new0(mp_map_elem_t, map->alloc);
+        map->table = (mp_map_elem_t*)m_new0(byte, map_table_n_bytes(n));
+        if (map_is_indexed(n)) {
+            map_index_build(map);
+        }
     }
-    map->used = 0;
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
     map->is_ordered = 0;
@@ -99,18 +235,37 @@ void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
     map->table = (mp_map_elem_t*)table;
 }
 
+void mp_map_init_copy(mp_map_t *map, const mp_map_t *src) {
+    if (src->is_ordered) {
+        // a fixed table has no index, so make the copy a table of its own
+        mp_map_init(map, src->used);
+        if (src->used != 0) {
+            memcpy(map->table, src->table, src->used * sizeof(mp_map_elem_t));
+            map->used = src->used;
+            if (map_is_indexed(map->alloc)) {
+                map_index_build(map);
+            }
+        }
+    } else {
+        mp_map_init(map, 0);
+        if (src->alloc != 0) {
+            map->alloc = src->alloc;
+            map->table = (mp_map_elem_t*)m_new(byte, map_table_n_bytes(src->alloc));
+            memcpy(map->table, src->table, map_table_n_bytes(src->alloc));
+            map->used = src->used;
+        }
+    }
+    map->all_keys_are_qstrs = src->all_keys_are_qstrs;
+}
+
 // Differentiate from mp_map_clear() - semantics is different
 void mp_map_deinit(mp_map_t *map) {
-    if (!map->is_fixed) {
-        m_del(mp_map_elem_t, map->table, map->alloc);
-    }
+    map_table_free(map);
     map->used = map->alloc = 0;
 }
 
 void mp_map_clear(mp_map_t *map) {
-    if (!map->is_fixed) {
-        m_del(mp_map_elem_t, map->table, map->alloc);
-    }
+    map_table_free(map);
     map->alloc = 0;
     map->used = 0;
     map->all_keys_are_qstrs = 1;
@@ -118,23 +273,32 @@ void mp_map_clear(mp_map_t *map) {
     map->table = NULL;
 }
 
+// Moves the live entries into a new table, dropping removed ones.  The table
+// only grows if removing entries wouldn't free up enough room.
 STATIC void mp_map_rehash(mp_map_t *map) {
     size_t old_alloc = map->alloc;
-    size_t new_alloc = get_hash_alloc_greater_or_equal_to(map->alloc + 1);
+    size_t old_filled = map_is_indexed(old_alloc) ? MAP_INDEX_FILLED(map) : map->used;
+    size_t new_alloc = old_alloc;
+    if (!map_is_indexed(old_alloc) || map->used + map->used / 4 >= old_alloc) {
+        new_alloc = get_hash_alloc_greater_or_equal_to(old_alloc + 1);
+    }
     DEBUG_printf("mp_map_rehash(%p): " UINT_FMT " -> " UINT_FMT "\n", map, old_alloc, new_alloc);
     mp_map_elem_t *old_table = map->table;
-    mp_map_elem_t *new_table = m_new0(mp_map_elem_t, new_alloc);
+    mp_map_elem_t *new_table = (mp_map_elem_t*)m_new0(byte, map_table_n_bytes(new_alloc));
     // If we reach this point, table resizing succeeded, now we can edit the old map.
-    map->alloc = new_alloc;
-    map->used = 0;
-    map->all_keys_are_qstrs = 1;
-    map->table = new_table;
-    for (size_t i = 0; i < old_alloc; i++) {
+    size_t n = 0;
+    for (size_t i = 0; i < old_filled; i++) {
         if (old_table[i].key != MP_OBJ_NULL && old_table[i].key != MP_OBJ_SENTINEL) {
-            mp_map_lookup(map, old_table[i].key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = old_table[i].value;
+            new_table[n++] = old_table[i];
         }
     }
-    m_del(mp_map_elem_t, old_table, old_alloc);
+    map->alloc = new_alloc;
+    map->table = new_table;
+    map->is_ordered = 0;
+    if (map_is_indexed(new_alloc)) {
+        map_index_build(map);
+    }
+    m_del(byte, old_table, map_table_n_bytes(old_alloc));
 }
 
 // MP_MAP_LOOKUP behaviour:
@@ -143,7 +307,7 @@ STATIC void mp_map_rehash(mp_map_t *map) {
 //  - returns slot, with key non-null and value=MP_OBJ_NULL if it was added
 // MP_MAP_LOOKUP_REMOVE_IF_FOUND behaviour:
 //  - returns NULL if not found, else the slot if was found in with key null and value non-null
-mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind) {
+MP_RAMFUNC mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind) {
     // If the map is a fixed array then we must only be called for a lookup
     assert(!map->is_fixed || lookup_kind == MP_MAP_LOOKUP);
 
@@ -166,11 +330,29 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
         }
     }
 
-    // if the map is an ordered array then we must do a brute force linear search
-    if (map->is_ordered) {
-        for (mp_map_elem_t *elem = &map->table[0], *top = &map->table[map->used]; elem < top; elem++) {
+    #if MICROPY_OPT_MAP_LOOKUP_CACHE
+    // Try the position this key was last found at.  Removal is excluded so that
+    // the linear and indexed paths below handle the bookkeeping.
+    if (lookup_kind != MP_MAP_LOOKUP_REMOVE_IF_FOUND && map->alloc) {
+        size_t pos = MAP_CACHE_ENTRY(index) % map->alloc;
+        if (!map->is_ordered || pos < map->used) {
+            mp_map_elem_t *slot = &map->table[pos];
+            if (slot->key == index) {
+                return slot;
+            }
+        }
+    }
+    #endif
+
+    // fixed tables and small maps are searched linearly
+    if (map->is_ordered || !map_is_indexed(map->alloc)) {
+        if (!map->is_ordered && !MP_OBJ_IS_QSTR(index)) {
+            // raise for an unhashable key just as the indexed path would
+            map_hash(index);
+        }
+        mp_map_elem_t *top = &map->table[map->used];
+        for (mp_map_elem_t *elem = &map->table[0]; elem < top; elem++) {
             if (elem->key == index || (!compare_only_ptrs && mp_obj_equal(elem->key, index))) {
-                #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
                 if (MP_UNLIKELY(lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND)) {
                     // remove the found element by moving the rest of the array down
                     mp_obj_t value = elem->value;
@@ -180,119 +362,91 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
                     elem = &map->table[map->used];
                     elem->key = MP_OBJ_NULL;
                     elem->value = value;
+                } else {
+                    MAP_CACHE_SET(index, elem - map->table);
                 }
-                #endif
                 return elem;
             }
         }
-        #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
         if (MP_LIKELY(lookup_kind != MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)) {
             return NULL;
         }
         if (map->used == map->alloc) {
-            // TODO: Alloc policy
-            map->alloc += 4;
-            map->table = m_renew(mp_map_elem_t, map->table, map->used, map->alloc);
-            mp_seq_clear(map->table, map->used, map->alloc, sizeof(*map->table));
+            mp_map_rehash(map);
+            if (map_is_indexed(map->alloc)) {
+                return mp_map_lookup(map, index, lookup_kind);
+            }
         }
-        mp_map_elem_t *elem = map->table + map->used++;
+        mp_map_elem_t *elem = &map->table[map->used++];
         elem->key = index;
+        elem->value = MP_OBJ_NULL;
         if (!MP_OBJ_IS_QSTR(index)) {
             map->all_keys_are_qstrs = 0;
         }
+        MAP_CACHE_SET(index, elem - map->table);
         return elem;
-        #else
-        return NULL;
-        #endif
     }
 
-    // map is a hash table (not an ordered array), so do a hash lookup
+    // map is big enough to have an index, so do a hash lookup
 
-    if (map->alloc == 0) {
-        if (lookup_kind == MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
-            mp_map_rehash(map);
-        } else {
-            return NULL;
-        }
-    }
-
-    // get hash of index, with fast path for common case of qstr
-    mp_uint_t hash;
-    if (MP_OBJ_IS_QSTR(index)) {
-        hash = qstr_hash(MP_OBJ_QSTR_VALUE(index));
-    } else {
-        hash = MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, index));
-    }
-
-    size_t pos = hash % map->alloc;
-    size_t start_pos = pos;
-    mp_map_elem_t *avail_slot = NULL;
+    mp_uint_t hash = map_hash(index);
+    mp_uint_t perturb = hash;
+    size_t mask = MAP_INDEX_MASK(map);
+    size_t pos = hash & mask;
+    size_t avail_pos = MAP_INDEX_EMPTY;
     for (;;) {
-        mp_map_elem_t *slot = &map->table[pos];
-        if (slot->key == MP_OBJ_NULL) {
-            // found NULL slot, so index is not in table
-            if (lookup_kind == MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
-                map->used += 1;
-                if (avail_slot == NULL) {
-                    avail_slot = slot;
-                }
-                avail_slot->key = index;
-                avail_slot->value = MP_OBJ_NULL;
-                if (!MP_OBJ_IS_QSTR(index)) {
-                    map->all_keys_are_qstrs = 0;
-                }
-                return avail_slot;
-            } else {
-                return NULL;
-            }
-        } else if (slot->key == MP_OBJ_SENTINEL) {
-            // found deleted slot, remember for later
-            if (avail_slot == NULL) {
-                avail_slot = slot;
+        size_t entry = map_index_get(map, pos);
+        if (entry == MAP_INDEX_EMPTY) {
+            // found an empty slot, so index is not in the table
+            break;
+        } else if (entry == MAP_INDEX_DELETED) {
+            // found a deleted slot, remember it in case we add
+            if (avail_pos == MAP_INDEX_EMPTY) {
+                avail_pos = pos;
             }
-        } else if (slot->key == index || (!compare_only_ptrs && mp_obj_equal(slot->key, index))) {
-            // found index
-            // Note: CPython does not replace the index; try x={True:'true'};x[1]='one';x
-            if (lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND) {
-                // delete element in this slot
-                map->used--;
-                if (map->table[(pos + 1) % map->alloc].key == MP_OBJ_NULL) {
-                    // optimisation if next slot is empty
-                    slot->key = MP_OBJ_NULL;
-                } else {
+        } else {
+            mp_map_elem_t *slot = &map->table[entry];
+            if (slot->key == index || (!compare_only_ptrs && mp_obj_equal(slot->key, index))) {
+                // found index
+                // Note: CPython does not replace the index; try x={True:'true'};x[1]='one';x
+                if (lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND) {
+                    // delete the element, keeping slot->value so that the
+                    // caller can access it if needed
+                    map->used--;
+                    map_index_set(map, pos, MAP_INDEX_DELETED);
                     slot->key = MP_OBJ_SENTINEL;
-                }
-                // keep slot->value so that caller can access it if needed
-            }
-            return slot;
-        }
-
-        // not yet found, keep searching in this table
-        pos = (pos + 1) % map->alloc;
-
-        if (pos == start_pos) {
-            // search got back to starting position, so index is not in table
-            if (lookup_kind == MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
-                if (avail_slot != NULL) {
-                    // there was an available slot, so use that
-                    map->used++;
-                    avail_slot->key = index;
-                    avail_slot->value = MP_OBJ_NULL;
-                    if (!MP_OBJ_IS_QSTR(index)) {
-                        map->all_keys_are_qstrs = 0;
-                    }
-                    return avail_slot;
                 } else {
-                    // not enough room in table, rehash it
-                    mp_map_rehash(map);
-                    // restart the search for the new element
-                    start_pos = pos = hash % map->alloc;
+                    MAP_CACHE_SET(index, entry);
                 }
-            } else {
-                return NULL;
+                return slot;
             }
         }
+        MAP_PROBE_NEXT(pos, perturb, mask);
+    }
+
+    if (lookup_kind != MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
+        return NULL;
+    }
+    if (MAP_INDEX_FILLED(map) == map->alloc) {
+        // no room at the end of the table, so rebuild it and search again
+        // for where the new element goes in the new index
+        mp_map_rehash(map);
+        return mp_map_lookup(map, index, lookup_kind);
+    }
+    if (avail_pos == MAP_INDEX_EMPTY) {
+        avail_pos = pos;
+    }
+    size_t entry = MAP_INDEX_FILLED(map)++;
+    map_index_set(map, avail_pos, entry);
+    map->used++;
+    mp_map_elem_t *slot = &map->table[entry];
+    slot->key = index;
+    slot->value = MP_OBJ_NULL;
+    if (!MP_OBJ_IS_QSTR(index)) {
+        map->all_keys_are_qstrs = 0;
     }
+    MAP_CACHE_SET(index, entry);
+    return slot;
 }
 
 /******************************************************************************/
@@ -90,6 +90,13 @@ typedef unsigned int uint;
 #define m_del_var(obj_type, var_type, var_num, ptr) ((void)(var_num), m_free(ptr))
 #endif
 #define m_del_obj(type, ptr) (m_del(type, ptr, 1))
+#if MICROPY_ENABLE_GC && MICROPY_GC_OBJ_FREELIST
+// Like m_new_obj but reuses a dead object of the given type when the GC has one.
+#define m_new_obj_from_freelist(type, obj_type) ((type*)(m_malloc_from_freelist(sizeof(type), (obj_type))))
+void *m_malloc_from_freelist(size_t num_bytes, const void *obj_type);
+#else
+#define m_new_obj_from_freelist(type, obj_type) m_new_obj(type)
+#endif
 
 void *m_malloc(size_t num_bytes, bool long_lived);
 void *m_malloc_maybe(size_t num_bytes, bool long_lived);
@@ -31,6 +31,7 @@
 #include "py/objint.h"
 #include "py/objstr.h"
 #include "py/objtype.h"
+#include "py/objgenerator.h"
 #include "py/runtime.h"
 #include "py/builtin.h"
 #include "py/stream.h"
@@ -314,6 +315,10 @@ MP_DEFINE_CONST_FUN_OBJ_KW(mp_builtin_min_obj, 1, mp_builtin_min);
 #endif
 
 STATIC mp_obj_t mp_builtin_next(mp_obj_t o) {
+    if (MP_OBJ_IS_TYPE(o, &mp_type_gen_instance)) {
+        // a generator's return value must reach the caller in the StopIteration
+        return mp_obj_gen_send(o, mp_const_none);
+    }
     mp_obj_t ret = mp_iternext_allow_raise(o);
     if (ret == MP_OBJ_STOP_ITERATION) {
         mp_raise_msg(&mp_type_StopIteration, NULL);
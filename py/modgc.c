@@ -27,6 +27,8 @@
 #include "py/mpstate.h"
 #include "py/obj.h"
 #include "py/gc.h"
+#include "py/runtime.h"
+#include "py/stream.h"
 
 #if MICROPY_PY_GC && MICROPY_ENABLE_GC
 
@@ -41,6 +43,15 @@ STATIC mp_obj_t py_gc_collect(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(gc_collect_obj, py_gc_collect);
 
+#if MICROPY_GC_COMPACT
+// compact(): move objects down the heap to join up the free memory
+STATIC mp_obj_t py_gc_compact(void) {
+    gc_compact();
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_compact_obj, py_gc_compact);
+#endif
+
 // disable(): disable the garbage collector
 STATIC mp_obj_t gc_disable(void) {
     MP_STATE_MEM(gc_auto_collect_enabled) = 0;
@@ -95,10 +106,115 @@ STATIC mp_obj_t gc_threshold(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_threshold_obj, 0, 1, gc_threshold);
 #endif
 
+#if MICROPY_GC_ALLOC_PROFILER
+// alloc_profile(enable): start counting allocations afresh, or stop
+STATIC mp_obj_t gc_alloc_profile(mp_obj_t enable) {
+    if (mp_obj_is_true(enable)) {
+        gc_profile_start();
+    } else {
+        gc_profile_stop();
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(gc_alloc_profile_obj, gc_alloc_profile);
+
+STATIC mp_obj_t gc_alloc_stat(size_t count, size_t bytes) {
+    mp_obj_t items[2] = {mp_obj_new_int_from_uint(count), mp_obj_new_int_from_uint(bytes)};
+    return mp_obj_new_tuple(2, items);
+}
+
+// alloc_stats(): return dicts of (count, bytes) allocated by type and by
+// (file, line), with None for allocations that couldn't be attributed
+STATIC mp_obj_t gc_alloc_stats(void) {
+    // Don't count the allocations made here.
+    bool enabled = MP_STATE_MEM(gc_profile_enabled);
+    gc_profile_stop();
+
+    mp_obj_t by_type = mp_obj_new_dict(0);
+    for (size_t i = 0; i < MICROPY_GC_ALLOC_PROFILER_TYPES; i++) {
+        gc_profile_type_t *t = &MP_STATE_VM(gc_profile_types)[i];
+        if (t->count > 0) {
+            mp_obj_t key = i == 0 ? mp_const_none : MP_OBJ_FROM_PTR(t->type);
+            mp_obj_dict_store(by_type, key, gc_alloc_stat(t->count, t->bytes));
+        }
+    }
+    mp_obj_t by_line = mp_obj_new_dict(0);
+    for (size_t i = 0; i < MICROPY_GC_ALLOC_PROFILER_LINES; i++) {
+        gc_profile_line_t *l = &MP_STATE_MEM(gc_profile_lines)[i];
+        if (l->count > 0) {
+            mp_obj_t key = mp_const_none;
+            if (i != 0) {
+                mp_obj_t items[2] = {MP_OBJ_NEW_QSTR(l->source_file), MP_OBJ_NEW_SMALL_INT(l->line)};
+                key = mp_obj_new_tuple(2, items);
+            }
+            mp_obj_dict_store(by_line, key, gc_alloc_stat(l->count, l->bytes));
+        }
+    }
+
+    MP_STATE_MEM(gc_profile_enabled) = enabled;
+    mp_obj_t items[2] = {by_type, by_line};
+    return mp_obj_new_tuple(2, items);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_alloc_stats_obj, gc_alloc_stats);
+#endif
+
+#if MICROPY_GC_HEAP_SNAPSHOT
+// Without a stream the snapshot goes to the console as lines of hex, which
+// survive being captured from a terminal.
+STATIC void gc_dump_heap_hex_strn(void *data, const char *str, size_t len) {
+    size_t *column = data;
+    for (size_t i = 0; i < len; i++) {
+        mp_printf(&mp_plat_print, "%02x", (byte)str[i]);
+        if (++*column == 32) {
+            mp_print_str(&mp_plat_print, "\n");
+            *column = 0;
+        }
+    }
+}
+
+// dump_heap([stream]): write a snapshot of the heap for tools/analyze_heap_dump.py
+STATIC mp_obj_t gc_dump_heap(size_t n_args, const mp_obj_t *args) {
+    size_t column = 0;
+    mp_print_t print = {&column, gc_dump_heap_hex_strn};
+    if (n_args > 0) {
+        mp_get_stream_raise(args[0], MP_STREAM_OP_WRITE);
+        print.data = MP_OBJ_TO_PTR(args[0]);
+        print.print_strn = mp_stream_write_adaptor;
+    }
+
+    // The stream can't be allowed to change the heap while it's written.
+    gc_lock();
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        gc_dump_snapshot(&print);
+        nlr_pop();
+        gc_unlock();
+    } else {
+        gc_unlock();
+        nlr_jump(nlr.ret_val);
+    }
+    if (n_args == 0 && column > 0) {
+        mp_print_str(&mp_plat_print, "\n");
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_dump_heap_obj, 0, 1, gc_dump_heap);
+#endif
+
 STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_gc) },
+    #if MICROPY_GC_ALLOC_PROFILER
+    { MP_ROM_QSTR(MP_QSTR_alloc_profile), MP_ROM_PTR(&gc_alloc_profile_obj) },
+    { MP_ROM_QSTR(MP_QSTR_alloc_stats), MP_ROM_PTR(&gc_alloc_stats_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&gc_collect_obj) },
+    #if MICROPY_GC_COMPACT
+    { MP_ROM_QSTR(MP_QSTR_compact), MP_ROM_PTR(&gc_compact_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_disable), MP_ROM_PTR(&gc_disable_obj) },
+    #if MICROPY_GC_HEAP_SNAPSHOT
+    { MP_ROM_QSTR(MP_QSTR_dump_heap), MP_ROM_PTR(&gc_dump_heap_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_enable), MP_ROM_PTR(&gc_enable_obj) },
     { MP_ROM_QSTR(MP_QSTR_isenabled), MP_ROM_PTR(&gc_isenabled_obj) },
     { MP_ROM_QSTR(MP_QSTR_mem_free), MP_ROM_PTR(&gc_mem_free_obj) },
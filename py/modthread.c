@@ -163,6 +163,9 @@ STATIC void *thread_entry(void *args_in) {
 
     mp_state_thread_t ts;
     mp_thread_set_state(&ts);
+    #if MICROPY_TRACK_CODE_STATE
+    ts.current_code_state = NULL;
+    #endif
 
     mp_stack_set_top(&ts + 1); // need to include ts in root-pointer scan
     mp_stack_set_limit(args->stack_size);
@@ -40,7 +40,7 @@
 // to another, you must rebuild from scratch using "-B" switch to make.
 
 #ifdef MP_CONFIGFILE
-#include "mpconfigport_coverage.h"
+#include MP_CONFIGFILE
 #else
 #include <mpconfigport.h>
 #endif
@@ -111,6 +111,22 @@
 #define MICROPY_ALLOC_GC_STACK_SIZE (64)
 #endif
 
+// If non-zero, gc_init takes a mark stack with one entry for this many heap
+// blocks from the start of the memory it's given, when that's bigger than
+// MICROPY_ALLOC_GC_STACK_SIZE.  Deeply nested data then rarely overflows the
+// stack, which makes the GC rescan the heap for blocks it didn't trace.
+#ifndef MICROPY_GC_MARK_STACK_DIVISOR
+#define MICROPY_GC_MARK_STACK_DIVISOR (0)
+#endif
+
+// Maximum number of separate areas of memory the heap can be made of, which
+// are given to gc_init_areas.  The allocation tables for all of them go at the
+// start of the first, and the first block of each of the others is taken to
+// keep allocations from spanning two areas.
+#ifndef MICROPY_GC_MAX_AREAS
+#define MICROPY_GC_MAX_AREAS (1)
+#endif
+
 // Be conservative and always clear to zero newly (re)allocated memory in the GC.
 // This helps eliminate stray pointers that hold on to memory that's no longer
 // used.  It decreases performance due to unnecessary memory clearing.
@@ -127,6 +143,99 @@
 #define MICROPY_GC_ALLOC_THRESHOLD (1)
 #endif
 
+// Number of allocation sizes, in blocks, that the GC tracks a separate first
+// free block for.  Searches for a multi-block allocation then start past the
+// small holes that single block allocations leave behind.
+#ifndef MICROPY_GC_ATB_INDICES
+#define MICROPY_GC_ATB_INDICES (8)
+#endif
+
+// Whether collections triggered by a failed allocation only mark the heap and
+// leave the sweep to be done a slice at a time by subsequent allocations.
+// This shortens the pause of an automatic collection to the mark phase.
+// Explicit calls to gc.collect() still sweep the whole heap.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP
+#define MICROPY_GC_INCREMENTAL_SWEEP (0)
+#endif
+
+// Number of blocks swept by each allocation while an incremental sweep is in
+// progress.
+#ifndef MICROPY_GC_SWEEP_STEP_BLOCKS
+#define MICROPY_GC_SWEEP_STEP_BLOCKS (256)
+#endif
+
+// Whether collections made by gc_alloc when it runs out of memory should
+// first only try to free memory in the short lived part of the heap.  The
+// long lived part is taken to be alive and is scanned for pointers rather
+// than traced.  If that doesn't free enough memory a full collection is
+// done, as it is after every MICROPY_GC_MINOR_PER_FULL minor ones.
+#ifndef MICROPY_GC_MINOR_COLLECT
+#define MICROPY_GC_MINOR_COLLECT (0)
+#endif
+
+#ifndef MICROPY_GC_MINOR_PER_FULL
+#define MICROPY_GC_MINOR_PER_FULL (8)
+#endif
+
+// Whether to provide gc.compact(), which moves lists, tuples, dicts, strings
+// and the storage of lists, dicts and instance members down the heap to join
+// up free space. Only allocations referenced solely from the slots of those
+// objects are moved; anything else referring to an allocation pins it.
+// Requires the finaliser table, which is borrowed to record pinned blocks,
+// and can't be used with threads.
+#ifndef MICROPY_GC_COMPACT
+#define MICROPY_GC_COMPACT (0)
+#endif
+
+// Whether the sweep keeps a few dead objects of frequently made, one block
+// types (floats and bound methods) in per-type freelists rather than freeing
+// them, so that making another object of the type doesn't search the heap.
+// Objects in a freelist are held from the root pointers.
+#ifndef MICROPY_GC_OBJ_FREELIST
+#define MICROPY_GC_OBJ_FREELIST (0)
+#endif
+
+// Number of types that can have a freelist
+#ifndef MICROPY_GC_OBJ_FREELIST_TYPES
+#define MICROPY_GC_OBJ_FREELIST_TYPES (4)
+#endif
+
+// Number of objects each freelist holds at most
+#ifndef MICROPY_GC_OBJ_FREELIST_DEPTH
+#define MICROPY_GC_OBJ_FREELIST_DEPTH (16)
+#endif
+
+// Whether to provide gc.alloc_profile() and gc.alloc_stats(), which count
+// heap allocations by the type of object allocated and by the line of Python
+// that allocated it.  When the profiler is stopped it costs one test per
+// allocation.  The tables below are fixed size; allocations that don't fit in
+// them are counted together.
+#ifndef MICROPY_GC_ALLOC_PROFILER
+#define MICROPY_GC_ALLOC_PROFILER (0)
+#endif
+
+// Whether to provide gc.dump_heap(), which writes a binary snapshot of the
+// heap's layout and object types for tools/analyze_heap_dump.py
+#ifndef MICROPY_GC_HEAP_SNAPSHOT
+#define MICROPY_GC_HEAP_SNAPSHOT (0)
+#endif
+
+// Number of types the allocation profiler can tell apart
+#ifndef MICROPY_GC_ALLOC_PROFILER_TYPES
+#define MICROPY_GC_ALLOC_PROFILER_TYPES (32)
+#endif
+
+// Number of source lines the allocation profiler can tell apart
+#ifndef MICROPY_GC_ALLOC_PROFILER_LINES
+#define MICROPY_GC_ALLOC_PROFILER_LINES (64)
+#endif
+
+// Whether the VM keeps MP_STATE_THREAD(current_code_state) pointing at the
+// innermost bytecode being run, for profilers to find the current line
+#ifndef MICROPY_TRACK_CODE_STATE
+#define MICROPY_TRACK_CODE_STATE (MICROPY_GC_ALLOC_PROFILER)
+#endif
+
 // Number of bytes to allocate initially when creating new chunks to store
 // interned string data.  Smaller numbers lead to more chunks being needed
 // and more wastage at the end of the chunk.  Larger numbers lead to wasted
@@ -141,6 +250,14 @@
 #define MICROPY_QSTR_POOL_MAX_ENTRIES (64)
 #endif
 
+// Whether qstr_find_strn uses hash indexes instead of scanning every qstr. The
+// const pool index is generated by makeqstrdata.py and costs about 2 bytes of
+// ROM per qstr. Dynamic pools get an index of 2 bytes of RAM per entry, which
+// requires MICROPY_QSTR_POOL_MAX_ENTRIES to be at most 255.
+#ifndef MICROPY_QSTR_HASH_INDEX
+#define MICROPY_QSTR_HASH_INDEX (0)
+#endif
+
 // Initial amount for lexer indentation level
 #ifndef MICROPY_ALLOC_LEXER_INDENT_INIT
 #define MICROPY_ALLOC_LEXER_INDENT_INIT (10)
@@ -331,9 +448,11 @@
 #if MICROPY_DYNAMIC_COMPILER
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC (mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode)
 #define MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC (mp_dynamic_compiler.py_builtins_str_unicode)
+#define MICROPY_COMP_CONST_TUPLE_DYNAMIC (mp_dynamic_compiler.comp_const_tuple)
 #else
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 #define MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC MICROPY_PY_BUILTINS_STR_UNICODE
+#define MICROPY_COMP_CONST_TUPLE_DYNAMIC MICROPY_COMP_CONST_TUPLE
 #endif
 
 // Whether to enable constant folding; eg 1+2 rewritten as 3
@@ -369,6 +488,22 @@
 #define MICROPY_COMP_RETURN_IF_EXPR (0)
 #endif
 
+// Whether a tuple display whose items are all constants, eg (1, 'a', None),
+// is built once by the compiler and loaded as a constant object instead of
+// being built by BUILD_TUPLE each time it is evaluated.  Mostly useful with
+// mpy-cross -mconst-tuple, where frozen modules then keep such tuples in ROM.
+#ifndef MICROPY_COMP_CONST_TUPLE
+#define MICROPY_COMP_CONST_TUPLE (0)
+#endif
+
+// Whether imported .py files are parsed, compiled and run one top-level
+// statement at a time, so peak RAM is set by the largest function or class
+// rather than the whole module.  A syntax error is then only raised once the
+// statements before it have run, and the file stays open while they run.
+#ifndef MICROPY_COMP_STREAM_IMPORT
+#define MICROPY_COMP_STREAM_IMPORT (0)
+#endif
+
 /*****************************************************************************/
 /* Internal debugging stuff                                                  */
 
@@ -407,12 +542,94 @@
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (0)
 #endif
 
+// Whether to cache the last found position of a key in mp_map_lookup, keyed by
+// the key's address.  Helps fixed ROM maps (module and type globals) and
+// ordered maps the most since they would otherwise need a linear search.
+// Costs MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE bytes of RAM in mp_state_vm_t.
+#ifndef MICROPY_OPT_MAP_LOOKUP_CACHE
+#define MICROPY_OPT_MAP_LOOKUP_CACHE (0)
+#endif
+
+// Number of entries in the map lookup cache
+#ifndef MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE
+#define MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE (128)
+#endif
+
+// Whether the VM handles small int + - and comparisons, and loads of instance
+// members, inline instead of calling mp_binary_op and mp_load_attr.  Costs a
+// few hundred bytes of code ROM.
+#ifndef MICROPY_OPT_VM_FAST_PATHS
+#define MICROPY_OPT_VM_FAST_PATHS (0)
+#endif
+
+// Whether to cache map positions for LOAD_NAME, LOAD_GLOBAL, LOAD_ATTR,
+// LOAD_METHOD and STORE_ATTR in a table indexed by bytecode address.  Has
+// no effect when MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE is enabled.  Costs
+// MICROPY_OPT_MAP_LOOKUP_SITE_CACHE_SIZE bytes of RAM in mp_state_vm_t.
+#ifndef MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+#define MICROPY_OPT_MAP_LOOKUP_SITE_CACHE (0)
+#endif
+
+// Number of entries in the map lookup site cache
+#ifndef MICROPY_OPT_MAP_LOOKUP_SITE_CACHE_SIZE
+#define MICROPY_OPT_MAP_LOOKUP_SITE_CACHE_SIZE (256)
+#endif
+
+// Whether to remember the character count and some character positions of
+// the most recently indexed long str, so that indexing it again starts from
+// a nearby known position instead of walking the UTF-8 from the start, and
+// ASCII-only strings are indexed by byte.  Only used with
+// MICROPY_PY_BUILTINS_STR_UNICODE.  Costs about 2 words of RAM per checkpoint
+// in mp_state_vm_t.
+#ifndef MICROPY_OPT_STR_INDEX_CACHE
+#define MICROPY_OPT_STR_INDEX_CACHE (0)
+#endif
+
+// Number of evenly spaced character positions kept by the str index cache
+#ifndef MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS
+#define MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS (8)
+#endif
+
+// Number of short str objects created by ujson and stream readline that are
+// remembered so that equal strings made later share one object, which also
+// lets dict lookups match them by pointer.  The entries are root pointers, so
+// this costs a word of RAM each plus the strings they keep alive.  0 disables.
+#ifndef MICROPY_STR_INTERN_CACHE
+#define MICROPY_STR_INTERN_CACHE (0)
+#endif
+
+// Longest str, in bytes, that is put in the str intern cache
+#ifndef MICROPY_STR_INTERN_CACHE_MAX_LEN
+#define MICROPY_STR_INTERN_CACHE_MAX_LEN (16)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
 #define MICROPY_OPT_MPZ_BITWISE (0)
 #endif
 
+// Whether to multiply large mpz integers with Karatsuba's algorithm once both
+// operands have at least MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD digits.  Costs
+// about 600 bytes of Thumb2 code plus a temporary heap buffer of roughly four
+// times the operand length per multiply.
+#ifndef MICROPY_OPT_MPZ_KARATSUBA
+#define MICROPY_OPT_MPZ_KARATSUBA (0)
+#endif
+
+// Smallest operand length, in mpz digits, at which Karatsuba is used.  Must be
+// at least 4; below about 20 the bookkeeping outweighs the saved multiplies.
+#ifndef MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD
+#define MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD (32)
+#endif
+
+// Whether pow(a, b, m) with an odd multi-digit modulus uses Montgomery
+// multiplication instead of a full division per step.  Costs about 700 bytes
+// of Thumb2 code.
+#ifndef MICROPY_OPT_MPZ_MONTGOMERY
+#define MICROPY_OPT_MPZ_MONTGOMERY (0)
+#endif
+
 /*****************************************************************************/
 /* Python internal features                                                  */
 
@@ -433,11 +650,23 @@
 #define MICROPY_READER_VFS (0)
 #endif
 
+// Size of the buffer the VFS reader reads files through while importing them. A sector or more
+// saves a filesystem read per few bytes. If the heap can't spare it the reader uses 24 bytes.
+#ifndef MICROPY_READER_VFS_BUF_SIZE
+#define MICROPY_READER_VFS_BUF_SIZE (24)
+#endif
+
 // Number of VFS mounts to persist across soft-reset.
 #ifndef MICROPY_FATFS_NUM_PERSISTENT
 #define MICROPY_FATFS_NUM_PERSISTENT (0)
 #endif
 
+// Number of FAT and directory sectors to keep in ram on top of the one window
+// sector each FatFs volume has. Each takes MICROPY_FATFS_MAX_SS bytes.
+#ifndef MICROPY_FATFS_SECTOR_CACHE
+#define MICROPY_FATFS_SECTOR_CACHE (0)
+#endif
+
 // Hook for the VM at the start of the opcode loop (can contain variable
 // definitions usable by the other hook functions)
 #ifndef MICROPY_VM_HOOK_INIT
@@ -496,11 +725,25 @@
 #   endif
 #endif
 
+// Number of exception messages without format arguments whose decompressed
+// str is kept, so that raising the same translated message again skips the
+// Huffman decoding and shares the str.  Costs 2 words of RAM per entry, which
+// are root pointers, plus the strs they keep alive.  0 disables.
+#ifndef MICROPY_EXC_MSG_CACHE
+#define MICROPY_EXC_MSG_CACHE (0)
+#endif
+
 // Whether to provide the mp_kbd_exception object, and micropython.kbd_intr function
 #ifndef MICROPY_KBD_EXCEPTION
 #define MICROPY_KBD_EXCEPTION (0)
 #endif
 
+// Whether mp_raise_OSError raises EAGAIN and ETIMEDOUT errors using preallocated
+// exception objects, so that polling loops which expect them don't allocate
+#ifndef MICROPY_PREALLOC_OSERROR
+#define MICROPY_PREALLOC_OSERROR (0)
+#endif
+
 // Prefer to raise KeyboardInterrupt asynchronously (from signal or interrupt
 // handler) - if supported by a particular port.
 #ifndef MICROPY_ASYNC_KBD_INTR
@@ -604,6 +847,18 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_COMPLEX (MICROPY_PY_BUILTINS_FLOAT)
 #endif
 
+// Whether to convert single precision floats to and from decimal with integer arithmetic
+// instead of float operations, which are slow with software floating point. With this,
+// repr of a float gives the fewest digits that parse back to the same float.
+// Only supported with MICROPY_FLOAT_IMPL_FLOAT.
+#ifndef MICROPY_FLOAT_FAST_DECIMAL
+#define MICROPY_FLOAT_FAST_DECIMAL (0)
+#endif
+
+#if MICROPY_FLOAT_FAST_DECIMAL && MICROPY_FLOAT_IMPL != MICROPY_FLOAT_IMPL_FLOAT
+#error MICROPY_FLOAT_FAST_DECIMAL requires MICROPY_FLOAT_IMPL_FLOAT
+#endif
+
 // Whether to provide a high-quality hash for float and complex numbers.
 // Otherwise the default is a very simple but correct hashing function.
 #ifndef MICROPY_FLOAT_HIGH_QUALITY_HASH
@@ -663,6 +918,13 @@ typedef double mp_float_t;
 #define MICROPY_MODULE_FROZEN (MICROPY_MODULE_FROZEN_STR || MICROPY_MODULE_FROZEN_MPY)
 #endif
 
+// Whether imported .py files are compiled once and cached as .mpy files on
+// the filesystem. Requires MICROPY_VFS, MICROPY_PERSISTENT_CODE_LOAD and
+// MICROPY_PERSISTENT_CODE_SAVE.
+#ifndef MICROPY_MODULE_COMPILE_CACHE
+#define MICROPY_MODULE_COMPILE_CACHE (0)
+#endif
+
 // Whether you can override builtins in the builtins module
 #ifndef MICROPY_CAN_OVERRIDE_BUILTINS
 #define MICROPY_CAN_OVERRIDE_BUILTINS (0)
@@ -712,6 +974,12 @@ typedef double mp_float_t;
 #define MICROPY_VFS_FAT (0)
 #endif
 
+// Support for VFS littlefs component, to mount a littlefs filesystem within
+// VFS. Needs the littlefs library in lib/littlefs.
+#ifndef MICROPY_VFS_LFS
+#define MICROPY_VFS_LFS (0)
+#endif
+
 /*****************************************************************************/
 /* Fine control over Python builtins, classes, modules, etc                  */
 
@@ -741,6 +1009,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_DELATTR_SETATTR (0)
 #endif
 
+// Whether to support __slots__ in classes, which stores the named instance
+// attributes inline in the instance instead of in its members map
+#ifndef MICROPY_PY_SLOTS
+#define MICROPY_PY_SLOTS (0)
+#endif
+
 // Support for async/await/async for/async with
 #ifndef MICROPY_PY_ASYNC_AWAIT
 #define MICROPY_PY_ASYNC_AWAIT (1)
@@ -1181,6 +1455,15 @@ typedef double mp_float_t;
 #define MICROPY_PY_URE_SUB (0)
 #endif
 
+#ifndef MICROPY_PY_URE_FINDITER
+#define MICROPY_PY_URE_FINDITER (0)
+#endif
+
+// Number of patterns the module-level ure functions keep compiled
+#ifndef MICROPY_PY_URE_CACHE_SIZE
+#define MICROPY_PY_URE_CACHE_SIZE (0)
+#endif
+
 #ifndef MICROPY_PY_UHEAPQ
 #define MICROPY_PY_UHEAPQ (0)
 #endif
@@ -1430,6 +1713,12 @@ typedef double mp_float_t;
 #define MP_ALWAYSINLINE __attribute__((always_inline))
 #endif
 
+// Modifier for hot functions which should run from RAM rather than flash. Ports
+// whose startup copies .ramfunc sections into RAM define this.
+#ifndef MP_RAMFUNC
+#define MP_RAMFUNC
+#endif
+
 // Condition is likely to be true, to help branch prediction
 #ifndef MP_LIKELY
 #define MP_LIKELY(x) __builtin_expect((x), 1)
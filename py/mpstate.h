@@ -46,6 +46,7 @@ typedef struct mp_dynamic_compiler_t {
     uint8_t small_int_bits; // must be <= host small_int_bits
     bool opt_cache_map_lookup_in_bytecode;
     bool py_builtins_str_unicode;
+    bool comp_const_tuple;
 } mp_dynamic_compiler_t;
 extern mp_dynamic_compiler_t mp_dynamic_compiler;
 #endif
@@ -60,6 +61,49 @@ typedef struct _mp_sched_item_t {
     mp_obj_t arg;
 } mp_sched_item_t;
 
+#if MICROPY_GC_ALLOC_PROFILER
+// Allocation counts kept by the allocation profiler.  Slot 0 of each table
+// holds allocations that couldn't be attributed to a type or a line.
+typedef struct _gc_profile_type_t {
+    const mp_obj_type_t *type;
+    size_t count;
+    size_t bytes;
+} gc_profile_type_t;
+
+typedef struct _gc_profile_line_t {
+    qstr source_file;
+    size_t line;
+    size_t count;
+    size_t bytes;
+} gc_profile_line_t;
+#endif
+
+#if MICROPY_OPT_STR_INDEX_CACHE
+// A character index and the byte offset of that character's lead byte.
+typedef struct _mp_str_index_pos_t {
+    size_t index;
+    size_t offset;
+} mp_str_index_pos_t;
+
+// Positions of characters in the most recently indexed long str, see
+// objstrunicode.c.  data is cleared whenever it may have been freed.
+typedef struct _mp_str_index_cache_t {
+    const byte *data;
+    size_t len;
+    size_t charlen;
+    mp_str_index_pos_t last;
+    mp_str_index_pos_t checkpoints[MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS];
+} mp_str_index_cache_t;
+#endif
+
+#if MICROPY_EXC_MSG_CACHE
+// A translated exception message and the str it decompressed to.
+typedef struct _mp_exc_msg_cache_entry_t {
+    const compressed_string_t *msg;
+    mp_obj_t str;
+} mp_exc_msg_cache_entry_t;
+#endif
+
 // This structure hold information about the memory allocation system.
 typedef struct _mp_state_mem_t {
     #if MICROPY_MEM_STATS
@@ -75,11 +119,26 @@ typedef struct _mp_state_mem_t {
     #endif
     byte *gc_pool_start;
     byte *gc_pool_end;
+    #if MICROPY_GC_MAX_AREAS > 1
+    // The pools of the heap's areas in address order, and the number of the
+    // first block in each. gc_pool_start and gc_pool_end span all of them.
+    size_t gc_n_areas;
+    byte *gc_area_start[MICROPY_GC_MAX_AREAS];
+    byte *gc_area_end[MICROPY_GC_MAX_AREAS];
+    size_t gc_area_first_block[MICROPY_GC_MAX_AREAS];
+    #endif
 
     void *gc_lowest_long_lived_ptr;
 
     int gc_stack_overflow;
+    // The lowest block dropped from the stack when it overflowed.
+    size_t gc_stack_overflow_block;
     size_t gc_stack[MICROPY_ALLOC_GC_STACK_SIZE];
+    #if MICROPY_GC_MARK_STACK_DIVISOR
+    // The stack in use, either gc_stack or one taken from the heap area.
+    size_t *gc_mark_stack;
+    size_t gc_mark_stack_len;
+    #endif
     uint16_t gc_lock_depth;
 
     // This variable controls auto garbage collection.  If set to false then the
@@ -92,9 +151,50 @@ typedef struct _mp_state_mem_t {
     size_t gc_alloc_threshold;
     #endif
 
-    size_t gc_first_free_atb_index;
+    // Searches for n blocks start at gc_first_free_atb_index[n - 1]; the last
+    // entry is used for all larger allocations.
+    size_t gc_first_free_atb_index[MICROPY_GC_ATB_INDICES];
     size_t gc_last_free_atb_index;
 
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // The next block to sweep, or the number of blocks in the heap when no
+    // sweep is in progress.
+    size_t gc_sweep_block;
+    // Set by gc_alloc around its own collections so that gc_collect_end does
+    // not sweep and leaves it to later allocations to do a piece at a time.
+    bool gc_sweep_incrementally;
+    #endif
+
+    #if MICROPY_GC_MINOR_COLLECT
+    // Set by gc_alloc around its own collections when only the short lived
+    // part of the heap is to be collected.
+    bool gc_collect_minor;
+    // Minor collections since the last full one.
+    uint8_t gc_minor_count;
+    #endif
+
+    #if MICROPY_GC_OBJ_FREELIST
+    // The type each freelist holds, NULL for unused freelists.
+    const void *gc_freelist_type[MICROPY_GC_OBJ_FREELIST_TYPES];
+    uint8_t gc_freelist_len[MICROPY_GC_OBJ_FREELIST_TYPES];
+    #endif
+
+    #if MICROPY_GC_COMPACT
+    // Set while gc.compact() runs a collection to find pinned blocks.
+    bool gc_compact_pinning;
+    #endif
+
+    #if MICROPY_GC_ALLOC_PROFILER
+    bool gc_profile_enabled;
+    // Static types lie between these addresses, see gc_profile_start.
+    const void *gc_profile_types_lo;
+    const void *gc_profile_types_hi;
+    // The line slot found for the last opcode that allocated.
+    const byte *gc_profile_last_ip;
+    size_t gc_profile_last_line;
+    gc_profile_line_t gc_profile_lines[MICROPY_GC_ALLOC_PROFILER_LINES];
+    #endif
+
     #if MICROPY_PY_GC_COLLECT_RETVAL
     size_t gc_collected;
     #endif
@@ -138,6 +238,12 @@ typedef struct _mp_state_vm_t {
     mp_obj_exception_t mp_kbd_exception;
     #endif
 
+    #if MICROPY_PREALLOC_OSERROR
+    // exception objects of type OSError, for EAGAIN and ETIMEDOUT
+    mp_obj_exception_t mp_eagain_exception;
+    mp_obj_exception_t mp_etimedout_exception;
+    #endif
+
     // exception object of type ReloadException
     mp_obj_exception_t mp_reload_exception;
 
@@ -168,6 +274,29 @@ typedef struct _mp_state_vm_t {
     mp_obj_dict_t *mp_module_builtins_override_dict;
     #endif
 
+    #if MICROPY_GC_ALLOC_PROFILER
+    // The last allocation, whose type is counted once the next one is made.
+    void *gc_profile_pending;
+    size_t gc_profile_pending_bytes;
+    // Holds on to the types, some of which may be on the heap.
+    gc_profile_type_t gc_profile_types[MICROPY_GC_ALLOC_PROFILER_TYPES];
+    #endif
+
+    #if MICROPY_GC_OBJ_FREELIST
+    // Dead objects kept by the sweep for reuse, see gc_freelist_alloc.
+    void *gc_freelist[MICROPY_GC_OBJ_FREELIST_TYPES][MICROPY_GC_OBJ_FREELIST_DEPTH];
+    #endif
+
+    #if MICROPY_STR_INTERN_CACHE
+    // Recently made short str objects, indexed by hash, see mp_obj_new_str_cached.
+    mp_obj_t str_intern_cache[MICROPY_STR_INTERN_CACHE];
+    #endif
+
+    #if MICROPY_EXC_MSG_CACHE
+    // Recently raised exception messages, see mp_obj_new_exception_msg.
+    mp_exc_msg_cache_entry_t exc_msg_cache[MICROPY_EXC_MSG_CACHE];
+    #endif
+
     // include any root pointers defined by a port
     MICROPY_PORT_ROOT_POINTERS
 
@@ -182,6 +311,11 @@ typedef struct _mp_state_vm_t {
     mp_obj_t dupterm_arr_obj;
     #endif
 
+    #if MICROPY_PY_URE && MICROPY_PY_URE_CACHE_SIZE
+    // pattern and compiled regex pairs, most recently used first
+    mp_obj_t ure_cache[MICROPY_PY_URE_CACHE_SIZE * 2];
+    #endif
+
     #if MICROPY_PY_LWIP_SLIP
     mp_obj_t lwip_slip_stream;
     #endif
@@ -201,6 +335,21 @@ typedef struct _mp_state_vm_t {
     size_t qstr_last_alloc;
     size_t qstr_last_used;
 
+    #if MICROPY_OPT_MAP_LOOKUP_CACHE
+    // Recently found positions of keys in maps, see mp_map_lookup.
+    uint8_t map_lookup_cache[MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+    // Map positions found by the VM's name and attribute opcodes, see vm.c.
+    uint8_t map_lookup_site_cache[MICROPY_OPT_MAP_LOOKUP_SITE_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    // Not a root pointer: the cached str may be collected, see gc_collect_start.
+    mp_str_index_cache_t str_index_cache;
+    #endif
+
     #if MICROPY_PY_THREAD
     // This is a global mutex used to make qstr interning thread-safe.
     mp_thread_mutex_t qstr_mutex;
@@ -246,6 +395,11 @@ typedef struct _mp_state_thread_t {
     uint8_t *pystack_cur;
     #endif
 
+    #if MICROPY_TRACK_CODE_STATE
+    // The innermost bytecode being run, for profilers.
+    const struct _mp_code_state_t *current_code_state;
+    #endif
+
     ////////////////////////////////////////////////////////////
     // START ROOT POINTER SECTION
     // Everything that needs GC scanning must start here, and
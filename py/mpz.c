@@ -449,6 +449,100 @@ STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
     return ilen;
 }
 
+#if MICROPY_OPT_MPZ_KARATSUBA
+
+/* computes i = i + j
+   assumes ilen >= jlen and that the sum fits in ilen digits
+   only propagates the carry as far as it goes, unlike mpn_add
+*/
+STATIC void mpn_add_inpl(mpz_dig_t *idig, size_t ilen, const mpz_dig_t *jdig, size_t jlen) {
+    mpz_dbl_dig_t carry = 0;
+
+    ilen -= jlen;
+
+    for (; jlen > 0; --jlen, ++idig, ++jdig) {
+        carry += (mpz_dbl_dig_t)*idig + (mpz_dbl_dig_t)*jdig;
+        *idig = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+
+    for (; carry != 0 && ilen > 0; --ilen, ++idig) {
+        carry += *idig;
+        *idig = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+}
+
+/* returns the number of scratch digits mpn_mul_kara needs for jlen x klen
+   the z1 product is always the largest sub-problem, so only that path is followed
+*/
+STATIC size_t mpn_mul_kara_scratch(size_t jlen, size_t klen) {
+    if (klen < MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD) {
+        return 0;
+    }
+    size_t h = (jlen + 1) / 2;
+    if (klen <= h) {
+        return 2 * klen + mpn_mul_kara_scratch(klen, klen);
+    }
+    return 4 * h + 4 + mpn_mul_kara_scratch(h + 1, h + 1);
+}
+
+/* computes i = j * k using Karatsuba above MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD digits
+   writes all jlen + klen digits of i, including any leading zeros
+   assumes jlen >= klen; j, k need not be normalised
+   assumes scratch has mpn_mul_kara_scratch(jlen, klen) digits; i can't overlap j, k or scratch
+*/
+STATIC void mpn_mul_kara(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *kdig, size_t klen, mpz_dig_t *scratch) {
+    if (klen < MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD) {
+        memset(idig, 0, (jlen + klen) * sizeof(mpz_dig_t));
+        mpn_mul(idig, jdig, jlen, kdig, klen);
+        return;
+    }
+
+    size_t h = (jlen + 1) / 2;
+
+    if (klen <= h) {
+        // operands are unbalanced: multiply j in klen-digit blocks so each
+        // sub-product is balanced, and accumulate them into i
+        mpz_dig_t *tdig = scratch;
+        scratch += 2 * klen;
+        memset(idig, 0, (jlen + klen) * sizeof(mpz_dig_t));
+        for (size_t pos = 0; pos < jlen; pos += klen) {
+            size_t blen = MIN(klen, jlen - pos);
+            mpn_mul_kara(tdig, kdig, klen, jdig + pos, blen, scratch);
+            mpn_add_inpl(idig + pos, jlen + klen - pos, tdig, klen + blen);
+        }
+        return;
+    }
+
+    // split j = j1 * B^h + j0 and k = k1 * B^h + k0, then
+    // j * k = z2 * B^2h + (z1 - z2 - z0) * B^h + z0
+    // where z0 = j0 * k0, z2 = j1 * k1 and z1 = (j0 + j1) * (k0 + k1)
+    mpz_dig_t *sjdig = scratch;
+    mpz_dig_t *skdig = sjdig + h + 1;
+    mpz_dig_t *z1dig = skdig + h + 1;
+    scratch = z1dig + 2 * h + 2;
+
+    // z0 and z2 go straight into their final place in i
+    mpn_mul_kara(idig, jdig, h, kdig, h, scratch);
+    mpn_mul_kara(idig + 2 * h, jdig + h, jlen - h, kdig + h, klen - h, scratch);
+
+    sjdig[h] = 0;
+    mpn_add(sjdig, jdig, h, jdig + h, jlen - h);
+    skdig[h] = 0;
+    mpn_add(skdig, kdig, h, kdig + h, klen - h);
+    mpn_mul_kara(z1dig, sjdig, h + 1, skdig, h + 1, scratch);
+
+    size_t z0len = mpn_remove_trailing_zeros(idig, idig + 2 * h);
+    size_t z2len = mpn_remove_trailing_zeros(idig + 2 * h, idig + jlen + klen);
+    size_t z1len = mpn_sub(z1dig, z1dig, 2 * h + 2, idig, z0len);
+    z1len = mpn_sub(z1dig, z1dig, z1len, idig + 2 * h, z2len);
+
+    mpn_add_inpl(idig + h, jlen + klen - h, z1dig, z1len);
+}
+
+#endif
+
 /* natural_div - quo * den + new_num = old_num (ie num is replaced with rem)
    assumes den != 0
    assumes num_dig has enough memory to be extended by 1 digit
@@ -855,6 +949,11 @@ size_t mpz_set_from_str(mpz_t *z, const char *str, size_t len, bool neg, unsigne
         z->neg = 0;
     }
 
+    // accumulate as many characters as fit in one digit, so the bignum is
+    // multiplied once per chunk rather than once per character
+    mpz_dig_t chunk_mul = 1;
+    mpz_dig_t chunk_val = 0;
+
     z->len = 0;
     for (; cur < top; ++cur) { // XXX UTF8 next char
         //mp_uint_t v = char_to_numeric(cur#); // XXX UTF8 get char
@@ -871,7 +970,16 @@ size_t mpz_set_from_str(mpz_t *z, const char *str, size_t len, bool neg, unsigne
         if (v >= base) {
             break;
         }
-        z->len = mpn_mul_dig_add_dig(z->dig, z->len, base, v);
+        if (chunk_mul > DIG_MASK / base) {
+            z->len = mpn_mul_dig_add_dig(z->dig, z->len, chunk_mul, chunk_val);
+            chunk_mul = 1;
+            chunk_val = 0;
+        }
+        chunk_mul *= base;
+        chunk_val = chunk_val * base + v;
+    }
+    if (chunk_mul > 1) {
+        z->len = mpn_mul_dig_add_dig(z->dig, z->len, chunk_mul, chunk_val);
     }
 
     return cur - str;
@@ -1313,8 +1421,24 @@ void mpz_mul_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs) {
     }
 
     mpz_need_dig(dest, lhs->len + rhs->len); // min mem l+r-1, max mem l+r
-    memset(dest->dig, 0, dest->alloc * sizeof(mpz_dig_t));
-    dest->len = mpn_mul(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len);
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    if (MIN(lhs->len, rhs->len) >= MICROPY_OPT_MPZ_KARATSUBA_THRESHOLD) {
+        if (lhs->len < rhs->len) {
+            const mpz_t *t = lhs;
+            lhs = rhs;
+            rhs = t;
+        }
+        size_t scratch_len = mpn_mul_kara_scratch(lhs->len, rhs->len);
+        mpz_dig_t *scratch = m_new(mpz_dig_t, scratch_len);
+        mpn_mul_kara(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len, scratch);
+        m_del(mpz_dig_t, scratch, scratch_len);
+        dest->len = mpn_remove_trailing_zeros(dest->dig, dest->dig + lhs->len + rhs->len);
+    } else
+    #endif
+    {
+        memset(dest->dig, 0, dest->alloc * sizeof(mpz_dig_t));
+        dest->len = mpn_mul(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len);
+    }
 
     if (lhs->neg == rhs->neg) {
         dest->neg = 0;
@@ -1359,6 +1483,137 @@ void mpz_pow_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs) {
     mpz_free(n);
 }
 
+#if MICROPY_OPT_MPZ_MONTGOMERY
+
+/* returns -m0^-1 mod DIG_BASE
+   assumes m0 is odd
+*/
+STATIC mpz_dig_t mpn_mont_minv(mpz_dig_t m0) {
+    // Newton iteration, each step doubles the number of correct low bits
+    // (m0 is its own inverse mod 8, so start with 3 correct bits)
+    mpz_dbl_dig_t x = m0;
+    for (int bits = 3; bits < DIG_SIZE; bits *= 2) {
+        x = (x * ((2 - (mpz_dbl_dig_t)m0 * x) & DIG_MASK)) & DIG_MASK;
+    }
+    return (0 - x) & DIG_MASK;
+}
+
+/* computes i = j * k / R mod m, where R = DIG_BASE ** mlen
+   all of i, j, k, m have exactly mlen digits; assumes j, k < m
+   assumes t has mlen + 2 digits; can have i, j, k pointing to same memory
+*/
+STATIC void mpn_mont_mul(mpz_dig_t *idig, const mpz_dig_t *jdig, const mpz_dig_t *kdig, const mpz_dig_t *mdig, size_t mlen, mpz_dig_t minv, mpz_dig_t *tdig) {
+    memset(tdig, 0, (mlen + 2) * sizeof(mpz_dig_t));
+
+    for (size_t i = 0; i < mlen; ++i) {
+        // t += j[i] * k
+        mpz_dbl_dig_t carry = 0;
+        for (size_t n = 0; n < mlen; ++n) {
+            carry += (mpz_dbl_dig_t)tdig[n] + (mpz_dbl_dig_t)jdig[i] * (mpz_dbl_dig_t)kdig[n];
+            tdig[n] = carry & DIG_MASK;
+            carry >>= DIG_SIZE;
+        }
+        carry += tdig[mlen];
+        tdig[mlen] = carry & DIG_MASK;
+        tdig[mlen + 1] = carry >> DIG_SIZE;
+
+        // t = (t + u * m) / DIG_BASE, with u chosen so the low digit cancels
+        mpz_dig_t u = ((mpz_dbl_dig_t)tdig[0] * minv) & DIG_MASK;
+        carry = ((mpz_dbl_dig_t)tdig[0] + (mpz_dbl_dig_t)u * (mpz_dbl_dig_t)mdig[0]) >> DIG_SIZE;
+        for (size_t n = 1; n < mlen; ++n) {
+            carry += (mpz_dbl_dig_t)tdig[n] + (mpz_dbl_dig_t)u * (mpz_dbl_dig_t)mdig[n];
+            tdig[n - 1] = carry & DIG_MASK;
+            carry >>= DIG_SIZE;
+        }
+        carry += tdig[mlen];
+        tdig[mlen - 1] = carry & DIG_MASK;
+        tdig[mlen] = tdig[mlen + 1] + (carry >> DIG_SIZE);
+    }
+
+    // t < 2m, so at most one subtraction brings it into range
+    bool ge = tdig[mlen] != 0;
+    if (!ge) {
+        ge = true;
+        for (size_t n = mlen; n-- > 0;) {
+            if (tdig[n] != mdig[n]) {
+                ge = tdig[n] > mdig[n];
+                break;
+            }
+        }
+    }
+    if (ge) {
+        mpz_dbl_dig_signed_t borrow = 0;
+        for (size_t n = 0; n < mlen; ++n) {
+            borrow += (mpz_dbl_dig_t)tdig[n] - (mpz_dbl_dig_t)mdig[n];
+            tdig[n] = borrow & DIG_MASK;
+            borrow >>= DIG_SIZE;
+        }
+    }
+
+    memcpy(idig, tdig, mlen * sizeof(mpz_dig_t));
+}
+
+/* computes dest = (lhs ** rhs) % mod using Montgomery multiplication
+   assumes rhs > 0 and mod is odd, positive and at least 2 digits
+   can have dest, lhs, rhs the same; mod can't be the same as dest
+*/
+STATIC void mpz_pow3_mont(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs, const mpz_t *mod) {
+    size_t mlen = mod->len;
+
+    // convert lhs and 1 into Montgomery form, x * R mod m
+    mpz_t quo, x, one;
+    mpz_init_zero(&quo);
+    mpz_init_zero(&x);
+    mpz_init_from_int(&one, 1);
+    mpz_divmod_inpl(&quo, &x, lhs, mod);
+    mpz_shl_inpl(&x, &x, mlen * DIG_SIZE);
+    mpz_divmod_inpl(&quo, &x, &x, mod);
+    mpz_shl_inpl(&one, &one, mlen * DIG_SIZE);
+    mpz_divmod_inpl(&quo, &one, &one, mod);
+
+    // fixed-size working buffers: base, accumulator and montmul temporary
+    size_t buf_len = 3 * mlen + 2;
+    mpz_dig_t *buf = m_new0(mpz_dig_t, buf_len);
+    mpz_dig_t *xdig = buf;
+    mpz_dig_t *adig = buf + mlen;
+    mpz_dig_t *tdig = buf + 2 * mlen;
+    memcpy(xdig, x.dig, x.len * sizeof(mpz_dig_t));
+    memcpy(adig, one.dig, one.len * sizeof(mpz_dig_t));
+    mpz_deinit(&quo);
+    mpz_deinit(&x);
+    mpz_deinit(&one);
+
+    mpz_dig_t minv = mpn_mont_minv(mod->dig[0]);
+
+    for (size_t i = 0; i < rhs->len; ++i) {
+        mpz_dig_t d = rhs->dig[i];
+        for (size_t b = 0; b < DIG_SIZE; ++b) {
+            if ((d & 1) != 0) {
+                mpn_mont_mul(adig, adig, xdig, mod->dig, mlen, minv, tdig);
+            }
+            d >>= 1;
+            if (d == 0 && i + 1 == rhs->len) {
+                break;
+            }
+            mpn_mont_mul(xdig, xdig, xdig, mod->dig, mlen, minv, tdig);
+        }
+    }
+
+    // convert out of Montgomery form by multiplying by plain 1
+    memset(xdig, 0, mlen * sizeof(mpz_dig_t));
+    xdig[0] = 1;
+    mpn_mont_mul(adig, adig, xdig, mod->dig, mlen, minv, tdig);
+
+    mpz_need_dig(dest, mlen);
+    memcpy(dest->dig, adig, mlen * sizeof(mpz_dig_t));
+    dest->len = mpn_remove_trailing_zeros(dest->dig, dest->dig + mlen);
+    dest->neg = 0;
+
+    m_del(mpz_dig_t, buf, buf_len);
+}
+
+#endif
+
 /* computes dest = (lhs ** rhs) % mod
    can have dest, lhs, rhs the same; mod can't be the same as dest
 */
@@ -1368,6 +1623,13 @@ void mpz_pow3_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs, const mpz_t
         return;
     }
 
+    #if MICROPY_OPT_MPZ_MONTGOMERY
+    if (rhs->len != 0 && mod->neg == 0 && mod->len >= 2 && (mod->dig[0] & 1) != 0) {
+        mpz_pow3_mont(dest, lhs, rhs, mod);
+        return;
+    }
+    #endif
+
     mpz_set_from_int(dest, 1);
 
     if (rhs->len == 0) {
@@ -1671,39 +1933,51 @@ size_t mpz_as_str_inpl(const mpz_t *i, unsigned int base, const char *prefix, ch
     mpz_dig_t *dig = m_new(mpz_dig_t, ilen);
     memcpy(dig, i->dig, ilen * sizeof(mpz_dig_t));
 
+    // divide by the largest power of base that fits in a digit, so each pass
+    // over the digits yields several characters instead of one
+    mpz_dbl_dig_t chunk_div = base;
+    unsigned int chunk_chars = 1;
+    while (chunk_div * base <= DIG_BASE) {
+        chunk_div *= base;
+        ++chunk_chars;
+    }
+
     // convert
     char *last_comma = str;
+    size_t dlen = ilen;
     bool done;
     do {
-        mpz_dig_t *d = dig + ilen;
+        mpz_dig_t *d = dig + dlen;
         mpz_dbl_dig_t a = 0;
 
         // compute next remainder
         while (--d >= dig) {
             a = (a << DIG_SIZE) | *d;
-            *d = a / base;
-            a %= base;
+            *d = a / chunk_div;
+            a %= chunk_div;
         }
+        dlen = mpn_remove_trailing_zeros(dig, dig + dlen);
+
+        // convert remainder to characters, stopping at the leading digit of
+        // the number on the last chunk
+        for (unsigned int n = 0; n < chunk_chars; ++n) {
+            mpz_dbl_dig_t c = a % base + '0';
+            a /= base;
+            if (c > '9') {
+                c += base_char - '9' - 1;
+            }
+            *s++ = c;
 
-        // convert to character
-        a += '0';
-        if (a > '9') {
-            a += base_char - '9' - 1;
-        }
-        *s++ = a;
-
-        // check if number is zero
-        done = true;
-        for (d = dig; d < dig + ilen; ++d) {
-            if (*d != 0) {
-                done = false;
+            // check if number is zero
+            done = dlen == 0 && a == 0;
+            if (comma && (s - last_comma) == 3) {
+                *s++ = comma;
+                last_comma = s;
+            }
+            if (done) {
                 break;
             }
         }
-        if (comma && (s - last_comma) == 3) {
-            *s++ = comma;
-            last_comma = s;
-        }
     }
     while (!done);
 
@@ -85,11 +85,6 @@ STATIC mp_obj_t dict_make_new(const mp_obj_type_t *type, size_t n_args, const mp
     mp_obj_t dict_out = mp_obj_new_dict(0);
     mp_obj_dict_t *dict = MP_OBJ_TO_PTR(dict_out);
     dict->base.type = type;
-    #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
-    if (type == &mp_type_ordereddict) {
-        dict->map.is_ordered = 1;
-    }
-    #endif
     if (n_args > 0 || kw_args != NULL) {
         mp_obj_t args2[2] = {dict_out, NULL}; // args[0] is always valid, even if it's not a positional arg
         if (n_args > 0) {
@@ -218,14 +213,10 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(dict_clear_obj, dict_clear);
 STATIC mp_obj_t dict_copy(mp_obj_t self_in) {
     mp_check_self(MP_OBJ_IS_DICT_TYPE(self_in));
     mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
-    mp_obj_t other_out = mp_obj_new_dict(self->map.alloc);
+    mp_obj_t other_out = mp_obj_new_dict(0);
     mp_obj_dict_t *other = MP_OBJ_TO_PTR(other_out);
     other->base.type = self->base.type;
-    other->map.used = self->map.used;
-    other->map.all_keys_are_qstrs = self->map.all_keys_are_qstrs;
-    other->map.is_fixed = 0;
-    other->map.is_ordered = self->map.is_ordered;
-    memcpy(other->map.table, self->map.table, self->map.alloc * sizeof(mp_map_elem_t));
+    mp_map_init_copy(&other->map, &self->map);
     return other_out;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(dict_copy_obj, dict_copy);
@@ -309,15 +300,17 @@ STATIC mp_obj_t dict_popitem(mp_obj_t self_in) {
     mp_check_self(MP_OBJ_IS_DICT_TYPE(self_in));
     mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
     mp_ensure_not_fixed(self);
-    size_t cur = 0;
-    mp_map_elem_t *next = dict_iter_next(self, &cur);
-    if (next == NULL) {
+    if (self->map.used == 0) {
         mp_raise_msg(&mp_type_KeyError, translate("popitem(): dictionary is empty"));
     }
-    self->map.used--;
-    mp_obj_t items[] = {next->key, next->value};
-    next->key = MP_OBJ_SENTINEL; // must mark key as sentinel to indicate that it was deleted
-    next->value = MP_OBJ_NULL;
+    // pop the most recently added item, as CPython does, so that no entries
+    // have to move down
+    size_t pos = self->map.alloc;
+    while (!MP_MAP_SLOT_IS_FILLED(&self->map, --pos)) {
+    }
+    mp_map_elem_t *last = &self->map.table[pos];
+    mp_obj_t items[] = {last->key, last->value};
+    mp_map_lookup(&self->map, last->key, MP_MAP_LOOKUP_REMOVE_IF_FOUND);
     mp_obj_t tuple = mp_obj_new_tuple(2, items);
 
     return tuple;
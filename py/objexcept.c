@@ -29,6 +29,7 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include "py/bc.h"
 #include "py/objlist.h"
 #include "py/objnamedtuple.h"
 #include "py/objstr.h"
@@ -43,6 +44,13 @@
 // Number of items per traceback entry (file, line, block)
 #define TRACEBACK_ENTRY_LEN (3)
 
+// Marker stored in place of the block name of a traceback entry recorded by
+// mp_obj_exception_add_traceback_bc.  Such an entry holds the bytecode and the
+// offset of the ip within it, and is only decoded to (file, line, block) when
+// the traceback is read, so exceptions that are caught and discarded never pay
+// for the line-number lookup.
+#define TRACEBACK_ENTRY_LAZY ((size_t)-1)
+
 // Number of traceback entries to reserve in the emergency exception buffer
 #define EMG_TRACEBACK_ALLOC (2 * TRACEBACK_ENTRY_LEN)
 
@@ -340,7 +348,26 @@ mp_obj_t mp_obj_new_exception_args(const mp_obj_type_t *exc_type, size_t n_args,
 }
 
 mp_obj_t mp_obj_new_exception_msg(const mp_obj_type_t *exc_type, const compressed_string_t *msg) {
+    #if MICROPY_EXC_MSG_CACHE
+    // The message has no arguments so its str never changes: reuse the one
+    // made the last time it was raised instead of decompressing it again.
+    mp_exc_msg_cache_entry_t *entry = &MP_STATE_VM(exc_msg_cache)[((uintptr_t)msg >> 1) % MICROPY_EXC_MSG_CACHE];
+    if (entry->msg == msg) {
+        return mp_obj_exception_make_new(exc_type, 1, &entry->str, NULL);
+    }
+    mp_obj_t exc = mp_obj_new_exception_msg_varg(exc_type, msg);
+    mp_obj_exception_t *self = MP_OBJ_TO_PTR(exc);
+    // Only cache a complete str on the heap, not one in the emergency
+    // exception buffer or left empty because memory ran out.
+    if (self->args->len == 1 && gc_nbytes(MP_OBJ_TO_PTR(self->args->items[0])) != 0
+        && ((mp_obj_str_t*)MP_OBJ_TO_PTR(self->args->items[0]))->data != NULL) {
+        entry->msg = msg;
+        entry->str = self->args->items[0];
+    }
+    return exc;
+    #else
     return mp_obj_new_exception_msg_varg(exc_type, msg);
+    #endif
 }
 
 // The following struct and function implement a simple printer that conservatively
@@ -410,6 +437,10 @@ mp_obj_t mp_obj_new_exception_msg_vlist(const mp_obj_type_t *exc_type, const com
         o_str_buf = (byte*)&o_str[1];
         o_str_alloc = (uint8_t*)MP_STATE_VM(mp_emergency_exception_buf)
             + mp_emergency_exception_buf_size - o_str_buf;
+        #if MICROPY_OPT_STR_INDEX_CACHE
+        // The message of an earlier exception in the buffer may be cached.
+        MP_STATE_VM(str_index_cache).data = NULL;
+        #endif
     }
     #endif
 
@@ -488,10 +519,8 @@ void mp_obj_exception_clear_traceback(mp_obj_t self_in) {
     self->traceback_data = NULL;
 }
 
-void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qstr block) {
-    GET_NATIVE_EXCEPTION(self, self_in);
-
-    // append this traceback info to traceback data
+// Reserve room for one more traceback entry, returning NULL if there is none.
+STATIC size_t *traceback_new_entry(mp_obj_exception_t *self) {
     // if memory allocation fails (eg because gc is locked), just return
 
     if (self->traceback_data == NULL) {
@@ -505,11 +534,11 @@ void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qs
                 self->traceback_alloc = EMG_TRACEBACK_ALLOC;
             } else {
                 // Can't allocate and no room in emergency buffer
-                return;
+                return NULL;
             }
             #else
             // Can't allocate
-            return;
+            return NULL;
             #endif
         } else {
             // Allocated the traceback data on the heap
@@ -520,14 +549,14 @@ void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qs
         #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
         if (self->traceback_data == (size_t*)MP_STATE_VM(mp_emergency_exception_buf)) {
             // Can't resize the emergency buffer
-            return;
+            return NULL;
         }
         #endif
         // be conservative with growing traceback data
         size_t *tb_data = m_renew_maybe(size_t, self->traceback_data, self->traceback_alloc,
             self->traceback_alloc + TRACEBACK_ENTRY_LEN, true);
         if (tb_data == NULL) {
-            return;
+            return NULL;
         }
         self->traceback_data = tb_data;
         self->traceback_alloc += TRACEBACK_ENTRY_LEN;
@@ -535,11 +564,47 @@ void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qs
 
     size_t *tb_data = &self->traceback_data[self->traceback_len];
     self->traceback_len += TRACEBACK_ENTRY_LEN;
+    return tb_data;
+}
+
+void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qstr block) {
+    GET_NATIVE_EXCEPTION(self, self_in);
+
+    // append this traceback info to traceback data
+    size_t *tb_data = traceback_new_entry(self);
+    if (tb_data == NULL) {
+        return;
+    }
     tb_data[0] = file;
     tb_data[1] = line;
     tb_data[2] = block;
 }
 
+void mp_obj_exception_add_traceback_bc(mp_obj_t self_in, const byte *bytecode, const byte *ip) {
+    GET_NATIVE_EXCEPTION(self, self_in);
+
+    size_t *tb_data = traceback_new_entry(self);
+    if (tb_data == NULL) {
+        return;
+    }
+    #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
+    if (self->traceback_data == (size_t*)MP_STATE_VM(mp_emergency_exception_buf)) {
+        // The emergency buffer is shared, so don't leave it holding the only
+        // reference to the bytecode; decode the entry now.
+        qstr block, file;
+        tb_data[1] = mp_bytecode_get_source_line(bytecode, ip, &block, &file);
+        tb_data[0] = file;
+        tb_data[2] = block;
+        return;
+    }
+    #endif
+    // The traceback data is on the heap, so this keeps the bytecode alive
+    // until the entry is decoded.
+    tb_data[0] = (size_t)bytecode;
+    tb_data[1] = ip - bytecode;
+    tb_data[2] = TRACEBACK_ENTRY_LAZY;
+}
+
 void mp_obj_exception_get_traceback(mp_obj_t self_in, size_t *n, size_t **values) {
     GET_NATIVE_EXCEPTION(self, self_in);
 
@@ -547,6 +612,16 @@ void mp_obj_exception_get_traceback(mp_obj_t self_in, size_t *n, size_t **values
         *n = 0;
         *values = NULL;
     } else {
+        for (size_t i = 0; i < self->traceback_len; i += TRACEBACK_ENTRY_LEN) {
+            size_t *tb_data = &self->traceback_data[i];
+            if (tb_data[2] == TRACEBACK_ENTRY_LAZY) {
+                const byte *bytecode = (const byte*)tb_data[0];
+                qstr block, file;
+                tb_data[1] = mp_bytecode_get_source_line(bytecode, bytecode + tb_data[1], &block, &file);
+                tb_data[0] = file;
+                tb_data[2] = block;
+            }
+        }
         *n = self->traceback_len;
         *values = self->traceback_data;
     }
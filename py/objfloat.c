@@ -125,7 +125,12 @@ STATIC void float_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t
     char buf[32];
     const int precision = 16;
 #endif
+    #if MICROPY_FLOAT_FAST_DECIMAL
+    // 'r' gives the shortest digits that read back as the same float
+    mp_format_float(o_val, buf, sizeof(buf), 'r', precision, '\0');
+    #else
     mp_format_float(o_val, buf, sizeof(buf), 'g', precision, '\0');
+    #endif
     mp_print_str(print, buf);
     if (strchr(buf, '.') == NULL && strchr(buf, 'e') == NULL && strchr(buf, 'n') == NULL) {
         // Python floats always have decimal point (unless inf or nan)
@@ -201,7 +206,7 @@ const mp_obj_type_t mp_type_float = {
 #if MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_C && MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_D
 
 mp_obj_t mp_obj_new_float(mp_float_t value) {
-    mp_obj_float_t *o = m_new(mp_obj_float_t, 1);
+    mp_obj_float_t *o = m_new_obj_from_freelist(mp_obj_float_t, &mp_type_float);
     o->base.type = &mp_type_float;
     o->value = value;
     return MP_OBJ_FROM_PTR(o);
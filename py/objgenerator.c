@@ -39,10 +39,8 @@
 /******************************************************************************/
 /* generator wrapper                                                          */
 
-typedef struct _mp_obj_gen_wrap_t {
-    mp_obj_base_t base;
-    mp_obj_t *fun;
-} mp_obj_gen_wrap_t;
+// A generator function is a mp_obj_fun_bc_t whose type is changed to
+// mp_type_gen_wrap, so defining one doesn't need a separate wrapper object.
 
 typedef struct _mp_obj_gen_instance_t {
     mp_obj_base_t base;
@@ -51,9 +49,8 @@ typedef struct _mp_obj_gen_instance_t {
 } mp_obj_gen_instance_t;
 
 STATIC mp_obj_t gen_wrap_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
-    mp_obj_gen_wrap_t *self = MP_OBJ_TO_PTR(self_in);
-    mp_obj_fun_bc_t *self_fun = (mp_obj_fun_bc_t*)self->fun;
-    assert(self_fun->base.type == &mp_type_fun_bc);
+    mp_obj_fun_bc_t *self_fun = MP_OBJ_TO_PTR(self_in);
+    assert(self_fun->base.type == &mp_type_gen_wrap);
 
     // bytecode prelude: get state size and exception stack size
     size_t n_state = mp_decode_uint_value(self_fun->bytecode);
@@ -78,13 +75,6 @@ const mp_obj_type_t mp_type_gen_wrap = {
     .unary_op = mp_generic_unary_op,
 };
 
-mp_obj_t mp_obj_new_gen_wrap(mp_obj_t fun) {
-    mp_obj_gen_wrap_t *o = m_new_obj(mp_obj_gen_wrap_t);
-    o->base.type = &mp_type_gen_wrap;
-    o->fun = MP_OBJ_TO_PTR(fun);
-    return MP_OBJ_FROM_PTR(o);
-}
-
 /******************************************************************************/
 /* generator instance                                                         */
 
@@ -130,7 +120,13 @@ mp_vm_return_kind_t mp_obj_gen_resume(mp_obj_t self_in, mp_obj_t send_value, mp_
     self->code_state.old_globals = mp_globals_get();
     mp_globals_set(self->globals);
     self->globals = NULL;
+    #if MICROPY_TRACK_CODE_STATE
+    const mp_code_state_t *caller_code_state = MP_STATE_THREAD(current_code_state);
+    #endif
     mp_vm_return_kind_t ret_kind = mp_execute_bytecode(&self->code_state, throw_value);
+    #if MICROPY_TRACK_CODE_STATE
+    MP_STATE_THREAD(current_code_state) = caller_code_state;
+    #endif
     self->globals = mp_globals_get();
     mp_globals_set(self->code_state.old_globals);
 
@@ -194,10 +190,27 @@ STATIC mp_obj_t gen_resume_and_raise(mp_obj_t self_in, mp_obj_t send_value, mp_o
 }
 
 STATIC mp_obj_t gen_instance_iternext(mp_obj_t self_in) {
-    return gen_resume_and_raise(self_in, mp_const_none, MP_OBJ_NULL);
+    // Everything that goes through iternext (for loops, list(), etc.) discards
+    // the generator's return value, so finish without allocating a
+    // StopIteration to carry it.  next() goes through mp_obj_gen_send instead.
+    mp_obj_t ret;
+    switch (mp_obj_gen_resume(self_in, mp_const_none, MP_OBJ_NULL, &ret)) {
+        case MP_VM_RETURN_YIELD:
+            return ret;
+
+        case MP_VM_RETURN_EXCEPTION:
+            if (!mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(mp_obj_get_type(ret)), MP_OBJ_FROM_PTR(&mp_type_StopIteration))) {
+                nlr_raise(ret);
+            }
+            return MP_OBJ_STOP_ITERATION;
+
+        case MP_VM_RETURN_NORMAL:
+        default:
+            return MP_OBJ_STOP_ITERATION;
+    }
 }
 
-STATIC mp_obj_t gen_instance_send(mp_obj_t self_in, mp_obj_t send_value) {
+mp_obj_t mp_obj_gen_send(mp_obj_t self_in, mp_obj_t send_value) {
     mp_obj_t ret = gen_resume_and_raise(self_in, send_value, MP_OBJ_NULL);
     if (ret == MP_OBJ_STOP_ITERATION) {
         nlr_raise(mp_obj_new_exception(&mp_type_StopIteration));
@@ -206,7 +219,7 @@ STATIC mp_obj_t gen_instance_send(mp_obj_t self_in, mp_obj_t send_value) {
     }
 }
 
-STATIC MP_DEFINE_CONST_FUN_OBJ_2(gen_instance_send_obj, gen_instance_send);
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(gen_instance_send_obj, mp_obj_gen_send);
 
 STATIC mp_obj_t gen_instance_close(mp_obj_t self_in);
 STATIC mp_obj_t gen_instance_throw(size_t n_args, const mp_obj_t *args) {
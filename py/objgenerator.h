@@ -30,5 +30,6 @@
 #include "py/runtime.h"
 
 mp_vm_return_kind_t mp_obj_gen_resume(mp_obj_t self_in, mp_obj_t send_val, mp_obj_t throw_val, mp_obj_t *ret_val);
+mp_obj_t mp_obj_gen_send(mp_obj_t self_in, mp_obj_t send_value);
 
 #endif // MICROPY_INCLUDED_PY_OBJGENERATOR_H
@@ -29,7 +29,6 @@
 
 #include "py/objlist.h"
 #include "py/runtime.h"
-#include "py/stackctrl.h"
 
 #include "supervisor/shared/translate.h"
 
@@ -286,35 +285,249 @@ STATIC mp_obj_t list_pop(size_t n_args, const mp_obj_t *args) {
     return ret;
 }
 
-STATIC void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj_t binop_less_result) {
-    MP_STACK_CHECK();
-    while (head < tail) {
-        mp_obj_t *h = head - 1;
-        mp_obj_t *t = tail;
-        mp_obj_t v = key_fn == MP_OBJ_NULL ? tail[0] : mp_call_function_1(key_fn, tail[0]); // get pivot using key_fn
-        for (;;) {
-            do ++h; while (h < t && mp_binary_op(MP_BINARY_OP_LESS, key_fn == MP_OBJ_NULL ? h[0] : mp_call_function_1(key_fn, h[0]), v) == binop_less_result);
-            do --t; while (h < t && mp_binary_op(MP_BINARY_OP_LESS, v, key_fn == MP_OBJ_NULL ? t[0] : mp_call_function_1(key_fn, t[0])) == binop_less_result);
-            if (h >= t) break;
-            mp_obj_t x = h[0];
-            h[0] = t[0];
-            t[0] = x;
+// list.sort is a simplified timsort. It finds the runs that are already in
+// order, or in strictly reverse order. It extends short runs to a minimum
+// length with a binary insertion sort. Then it merges runs pairwise, keeping
+// the run lengths balanced so the stack of pending runs stays short. The
+// sort is stable. It uses a buffer of at most half the list, plus one key
+// per item when there's a key function.
+
+// Lists shorter than this are sorted with a binary insertion sort alone,
+// without allocating a merge buffer.
+#define LIST_SORT_MIN_MERGE (32)
+
+// This is enough runs for any list that fits in memory. Each pending run is
+// longer than the two above it on the stack combined, so their lengths grow
+// at least as fast as the Fibonacci numbers.
+#define LIST_SORT_MAX_RUNS (sizeof(size_t) * 11)
+
+enum {
+    LIST_SORT_CMP_OBJ,
+    LIST_SORT_CMP_SMALL_INT,
+    #if MICROPY_PY_BUILTINS_FLOAT
+    LIST_SORT_CMP_FLOAT,
+    #endif
+};
+
+typedef struct _list_sort_t {
+    // What's compared: the items themselves, or their keys if there's a
+    // key function. With a key function, the items are in values and move
+    // with their keys. Otherwise values is NULL.
+    mp_obj_t *keys;
+    mp_obj_t *values;
+    mp_obj_t *buf_keys;
+    mp_obj_t *buf_values;
+    uint8_t cmp;
+    bool reverse;
+    // The elements of the merge in progress that are only in the buffer,
+    // and where they go if a comparison raises and the merge is abandoned.
+    size_t buf_start;
+    size_t buf_end;
+    size_t gap;
+} list_sort_t;
+
+STATIC bool list_sort_less(const list_sort_t *sort, mp_obj_t a, mp_obj_t b) {
+    if (sort->reverse) {
+        mp_obj_t t = a;
+        a = b;
+        b = t;
+    }
+    switch (sort->cmp) {
+        case LIST_SORT_CMP_SMALL_INT:
+            return MP_OBJ_SMALL_INT_VALUE(a) < MP_OBJ_SMALL_INT_VALUE(b);
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case LIST_SORT_CMP_FLOAT:
+            return mp_obj_float_get(a) < mp_obj_float_get(b);
+        #endif
+        default:
+            return mp_obj_is_true(mp_binary_op(MP_BINARY_OP_LESS, a, b));
+    }
+}
+
+STATIC void list_sort_move(list_sort_t *sort, size_t dest, size_t src, size_t n) {
+    memmove(sort->keys + dest, sort->keys + src, n * sizeof(mp_obj_t));
+    if (sort->values != NULL) {
+        memmove(sort->values + dest, sort->values + src, n * sizeof(mp_obj_t));
+    }
+}
+
+// Copy n elements between the list and the buffer.
+STATIC void list_sort_to_buf(list_sort_t *sort, size_t buf, size_t src, size_t n) {
+    memcpy(sort->buf_keys + buf, sort->keys + src, n * sizeof(mp_obj_t));
+    if (sort->values != NULL) {
+        memcpy(sort->buf_values + buf, sort->values + src, n * sizeof(mp_obj_t));
+    }
+}
+
+STATIC void list_sort_from_buf(list_sort_t *sort, size_t dest, size_t buf, size_t n) {
+    memcpy(sort->keys + dest, sort->buf_keys + buf, n * sizeof(mp_obj_t));
+    if (sort->values != NULL) {
+        memcpy(sort->values + dest, sort->buf_values + buf, n * sizeof(mp_obj_t));
+    }
+}
+
+// Return the length of the run starting at lo. A descending run is reversed
+// in place. Only strictly descending runs count, so equal elements stay in
+// order.
+STATIC size_t list_sort_count_run(list_sort_t *sort, size_t lo, size_t hi) {
+    mp_obj_t *keys = sort->keys;
+    size_t i = lo + 1;
+    if (i == hi) {
+        return 1;
+    }
+    if (list_sort_less(sort, keys[i], keys[lo])) {
+        for (i++; i < hi && list_sort_less(sort, keys[i], keys[i - 1]); i++) {
         }
-        mp_obj_t x = h[0];
-        h[0] = tail[0];
-        tail[0] = x;
-        // do the smaller recursive call first, to keep stack within O(log(N))
-        if (t - head < tail - h - 1) {
-            mp_quicksort(head, t, key_fn, binop_less_result);
-            head = h + 1;
-        } else {
-            mp_quicksort(h + 1, tail, key_fn, binop_less_result);
-            tail = t;
+        for (size_t l = lo, r = i - 1; l < r; l++, r--) {
+            mp_obj_t t = keys[l];
+            keys[l] = keys[r];
+            keys[r] = t;
+            if (sort->values != NULL) {
+                t = sort->values[l];
+                sort->values[l] = sort->values[r];
+                sort->values[r] = t;
+            }
+        }
+    } else {
+        for (i++; i < hi && !list_sort_less(sort, keys[i], keys[i - 1]); i++) {
+        }
+    }
+    return i - lo;
+}
+
+// Sort [lo, hi), given that [lo, start) is already sorted. Each element goes
+// after any equal ones. It is moved only once its place is found, so the list
+// is intact if a comparison raises.
+STATIC void list_sort_insertion(list_sort_t *sort, size_t lo, size_t start, size_t hi) {
+    mp_obj_t *keys = sort->keys;
+    for (; start < hi; start++) {
+        mp_obj_t key = keys[start];
+        size_t l = lo;
+        size_t r = start;
+        while (l < r) {
+            size_t m = l + (r - l) / 2;
+            if (list_sort_less(sort, key, keys[m])) {
+                r = m;
+            } else {
+                l = m + 1;
+            }
+        }
+        if (l < start) {
+            mp_obj_t value = sort->values == NULL ? MP_OBJ_NULL : sort->values[start];
+            list_sort_move(sort, l + 1, l, start - l);
+            keys[l] = key;
+            if (sort->values != NULL) {
+                sort->values[l] = value;
+            }
+        }
+    }
+}
+
+// Merge the sorted runs [lo, mid) and [mid, hi). The shorter run is copied
+// to the buffer.
+STATIC void list_sort_merge(list_sort_t *sort, size_t lo, size_t mid, size_t hi) {
+    mp_obj_t *keys = sort->keys;
+    mp_obj_t *buf = sort->buf_keys;
+    sort->buf_start = 0;
+    if (mid - lo <= hi - mid) {
+        // Merge forwards. Take from the left run, which is in the buffer,
+        // unless the right one is less.
+        list_sort_to_buf(sort, 0, lo, mid - lo);
+        sort->buf_end = mid - lo;
+        sort->gap = lo;
+        size_t r = mid;
+        while (sort->buf_start < sort->buf_end && r < hi) {
+            if (list_sort_less(sort, keys[r], buf[sort->buf_start])) {
+                list_sort_move(sort, sort->gap++, r++, 1);
+            } else {
+                list_sort_from_buf(sort, sort->gap++, sort->buf_start++, 1);
+            }
         }
+    } else {
+        // Merge backwards. Take from the left run unless the right one, which
+        // is in the buffer, is less.
+        list_sort_to_buf(sort, 0, mid, hi - mid);
+        sort->buf_end = hi - mid;
+        sort->gap = mid;
+        size_t l = mid;
+        while (sort->buf_end > 0 && l > lo) {
+            if (list_sort_less(sort, buf[sort->buf_end - 1], keys[l - 1])) {
+                l--;
+                list_sort_move(sort, l + sort->buf_end, l, 1);
+            } else {
+                sort->buf_end--;
+                list_sort_from_buf(sort, l + sort->buf_end, sort->buf_end, 1);
+            }
+            sort->gap = l;
+        }
+    }
+    // Whatever's left in the buffer fills the gap.
+    list_sort_from_buf(sort, sort->gap, sort->buf_start, sort->buf_end - sort->buf_start);
+    sort->buf_end = sort->buf_start;
+}
+
+STATIC void list_sort_runs(list_sort_t *sort, size_t n) {
+    if (n < LIST_SORT_MIN_MERGE) {
+        list_sort_insertion(sort, 0, list_sort_count_run(sort, 0, n), n);
+        return;
+    }
+
+    // Pick a minimum run length between LIST_SORT_MIN_MERGE / 2 and
+    // LIST_SORT_MIN_MERGE. It divides n into a power of 2 runs, or slightly
+    // fewer, so the merges are balanced.
+    size_t min_run = n;
+    size_t extra = 0;
+    while (min_run >= LIST_SORT_MIN_MERGE) {
+        extra |= min_run & 1;
+        min_run >>= 1;
+    }
+    min_run += extra;
+
+    // The pending runs, which together cover [0, lo).
+    size_t run_len[LIST_SORT_MAX_RUNS];
+    size_t runs = 0;
+    for (size_t lo = 0; lo < n;) {
+        size_t len = list_sort_count_run(sort, lo, n);
+        if (len < min_run) {
+            size_t forced = MIN(min_run, n - lo);
+            list_sort_insertion(sort, lo, lo + len, lo + forced);
+            len = forced;
+        }
+        run_len[runs] = len;
+        runs++;
+        lo += len;
+
+        // Merge until each pending run is longer than the next one, and
+        // longer than the next two combined.
+        while (runs > 1) {
+            size_t i = runs - 2;
+            if ((i > 0 && run_len[i - 1] <= run_len[i] + run_len[i + 1])
+                || (i > 1 && run_len[i - 2] <= run_len[i - 1] + run_len[i])) {
+                if (run_len[i - 1] < run_len[i + 1]) {
+                    i--;
+                }
+            } else if (run_len[i] > run_len[i + 1]) {
+                break;
+            }
+            size_t start = 0;
+            for (size_t j = 0; j < i; j++) {
+                start += run_len[j];
+            }
+            list_sort_merge(sort, start, start + run_len[i], start + run_len[i] + run_len[i + 1]);
+            run_len[i] += run_len[i + 1];
+            for (size_t j = i + 1; j < runs - 1; j++) {
+                run_len[j] = run_len[j + 1];
+            }
+            runs--;
+        }
+    }
+    while (runs > 1) {
+        runs--;
+        list_sort_merge(sort, n - run_len[runs - 1] - run_len[runs], n - run_len[runs], n);
+        run_len[runs - 1] += run_len[runs];
     }
 }
 
-// TODO Python defines sort to be stable but ours is not
 mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_PTR(&mp_const_none_obj)} },
@@ -331,10 +544,81 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     mp_check_self(MP_OBJ_IS_TYPE(pos_args[0], &mp_type_list));
     mp_obj_list_t *self = MP_OBJ_TO_PTR(pos_args[0]);
 
-    if (self->len > 1) {
-        mp_quicksort(self->items, self->items + self->len - 1,
-                     args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
-                     args.reverse.u_bool ? mp_const_false : mp_const_true);
+    size_t n = self->len;
+    if (n < 2) {
+        return mp_const_none;
+    }
+
+    list_sort_t sort;
+    sort.reverse = args.reverse.u_bool;
+    sort.values = NULL;
+    sort.buf_keys = NULL;
+    sort.buf_values = NULL;
+    sort.buf_start = sort.buf_end = sort.gap = 0;
+    size_t key_alloc = 0;
+    mp_obj_t *key_array = NULL;
+    if (args.key.u_obj != mp_const_none) {
+        // Call the key function once per item. The list is read again
+        // afterwards in case the key function changed it.
+        key_alloc = n;
+        key_array = m_new(mp_obj_t, key_alloc);
+        for (size_t i = 0; i < n && i < self->len; i++) {
+            key_array[i] = mp_call_function_1(args.key.u_obj, self->items[i]);
+        }
+        n = MIN(n, self->len);
+        sort.keys = key_array;
+        sort.values = self->items;
+    } else {
+        sort.keys = self->items;
+    }
+
+    // Compare without mp_binary_op if all the keys are small ints, or all
+    // are floats.
+    sort.cmp = LIST_SORT_CMP_SMALL_INT;
+    for (size_t i = 0; i < n && sort.cmp == LIST_SORT_CMP_SMALL_INT; i++) {
+        if (!MP_OBJ_IS_SMALL_INT(sort.keys[i])) {
+            sort.cmp = LIST_SORT_CMP_OBJ;
+        }
+    }
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (sort.cmp == LIST_SORT_CMP_OBJ) {
+        sort.cmp = LIST_SORT_CMP_FLOAT;
+        for (size_t i = 0; i < n && sort.cmp == LIST_SORT_CMP_FLOAT; i++) {
+            if (!mp_obj_is_float(sort.keys[i])) {
+                sort.cmp = LIST_SORT_CMP_OBJ;
+            }
+        }
+    }
+    #endif
+
+    size_t buf_alloc = 0;
+    if (n >= LIST_SORT_MIN_MERGE) {
+        buf_alloc = key_array == NULL ? n / 2 : 2 * (n / 2);
+        sort.buf_keys = m_new_maybe(mp_obj_t, buf_alloc);
+        sort.buf_values = sort.buf_keys + n / 2;
+    }
+
+    mp_obj_t exc = MP_OBJ_NULL;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        if (n >= LIST_SORT_MIN_MERGE && sort.buf_keys == NULL) {
+            // Without room for a merge buffer, fall back to sorting the whole
+            // list by insertion, which is slow but needs no memory.
+            list_sort_insertion(&sort, 0, 1, n);
+        } else {
+            list_sort_runs(&sort, n);
+        }
+        nlr_pop();
+    } else {
+        // Put back any elements that were in the buffer when a comparison
+        // raised, so the list keeps all of its items.
+        list_sort_from_buf(&sort, sort.gap, sort.buf_start, sort.buf_end - sort.buf_start);
+        exc = MP_OBJ_FROM_PTR(nlr.ret_val);
+    }
+    m_del(mp_obj_t, sort.buf_keys, buf_alloc);
+    m_del(mp_obj_t, key_array, key_alloc);
+    if (exc != MP_OBJ_NULL) {
+        nlr_jump(MP_OBJ_TO_PTR(exc));
     }
 
     return mp_const_none;
@@ -463,9 +463,25 @@ STATIC mp_obj_t str_join(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_t *seq_items;
 
     if (!MP_OBJ_IS_TYPE(arg, &mp_type_list) && !MP_OBJ_IS_TYPE(arg, &mp_type_tuple)) {
-        // arg is not a list nor a tuple, try to convert it to a list
-        // TODO: Try to optimize?
-        arg = mp_type_list.make_new(&mp_type_list, 1, &arg, NULL);
+        // arg is not a list nor a tuple, so append each item as it comes
+        // instead of collecting them all in a list first
+        vstr_t vstr;
+        vstr_init(&vstr, 16);
+        mp_obj_iter_buf_t iter_buf;
+        mp_obj_t iterable = mp_getiter(arg, &iter_buf);
+        mp_obj_t item;
+        for (size_t i = 0; (item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION; i++) {
+            if (mp_obj_get_type(item) != self_type) {
+                mp_raise_TypeError(
+                    translate("join expects a list of str/bytes objects consistent with self object"));
+            }
+            if (i > 0) {
+                vstr_add_strn(&vstr, (const char*)sep_str, sep_len);
+            }
+            GET_STR_DATA_LEN(item, s, l);
+            vstr_add_strn(&vstr, (const char*)s, l);
+        }
+        return mp_obj_new_str_from_vstr(self_type, &vstr);
     }
     mp_obj_get_array(arg, &seq_len, &seq_items);
 
@@ -945,10 +961,14 @@ STATIC NORETURN void terse_str_format_value_error(void) {
 #define terse_str_format_value_error()
 #endif
 
-STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *arg_i, size_t n_args, const mp_obj_t *args, mp_map_t *kwargs) {
+// Initial size of the result of formatting a pattern of the given length
+// with n_args arguments, enough for short values without reallocating.
+#define STR_FORMAT_ALLOC(len, n_args) ((len) + 8 * (n_args) + 1)
+
+STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *arg_i, size_t n_args, const mp_obj_t *args, mp_map_t *kwargs, size_t alloc) {
     vstr_t vstr;
     mp_print_t print;
-    vstr_init_print(&vstr, 16, &print);
+    vstr_init_print(&vstr, alloc, &print);
 
     for (; str < top; str++) {
         if (*str == '}') {
@@ -964,7 +984,12 @@ STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *ar
             }
         }
         if (*str != '{') {
-            vstr_add_byte(&vstr, *str);
+            // Copy the text up to the next brace in one go.
+            const char *text = str;
+            while (str + 1 < top && str[1] != '{' && str[1] != '}') {
+                str++;
+            }
+            vstr_add_strn(&vstr, text, str + 1 - text);
             continue;
         }
 
@@ -1095,8 +1120,11 @@ STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *ar
             arg = args[(*arg_i) + 1];
             (*arg_i)++;
         }
-        if (!format_spec && !conversion) {
-            conversion = 's';
+        if (!format_spec) {
+            // The converted value is the output, so print it straight into
+            // the result instead of converting it to a str first.
+            mp_obj_print_helper(&print, arg, conversion == 'r' ? PRINT_REPR : PRINT_STR);
+            continue;
         }
         if (conversion) {
             mp_print_kind_t print_kind;
@@ -1131,9 +1159,19 @@ STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *ar
             // precision   ::=  integer
             // type        ::=  "b" | "c" | "d" | "e" | "E" | "f" | "F" | "g" | "G" | "n" | "o" | "s" | "x" | "X" | "%"
 
-            // recursively call the formatter to format any nested specifiers
-            MP_STACK_CHECK();
-            vstr_t format_spec_vstr = mp_obj_str_format_helper(format_spec, str, arg_i, n_args, args, kwargs);
+            // A short specifier without nested fields is parsed from a copy on
+            // the stack. Otherwise, recursively call the formatter to format
+            // the nested specifiers.
+            vstr_t format_spec_vstr;
+            char format_spec_buf[16];
+            if ((size_t)(str - format_spec) < sizeof(format_spec_buf)
+                && memchr(format_spec, '{', str - format_spec) == NULL) {
+                vstr_init_fixed_buf(&format_spec_vstr, sizeof(format_spec_buf), format_spec_buf);
+                vstr_add_strn(&format_spec_vstr, format_spec, str - format_spec);
+            } else {
+                MP_STACK_CHECK();
+                format_spec_vstr = mp_obj_str_format_helper(format_spec, str, arg_i, n_args, args, kwargs, 16);
+            }
             const char *s = vstr_null_terminated_str(&format_spec_vstr);
             const char *stop = s + format_spec_vstr.len;
             if (isalignment(*s)) {
@@ -1389,7 +1427,8 @@ mp_obj_t mp_obj_str_format(size_t n_args, const mp_obj_t *args, mp_map_t *kwargs
 
     GET_STR_DATA_LEN(args[0], str, len);
     int arg_i = 0;
-    vstr_t vstr = mp_obj_str_format_helper((const char*)str, (const char*)str + len, &arg_i, n_args, args, kwargs);
+    vstr_t vstr = mp_obj_str_format_helper((const char*)str, (const char*)str + len, &arg_i, n_args, args, kwargs,
+        STR_FORMAT_ALLOC(len, n_args - 1));
     return mp_obj_new_str_from_vstr(&mp_type_str, &vstr);
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(str_format_obj, 1, mp_obj_str_format);
@@ -1403,12 +1442,17 @@ STATIC mp_obj_t str_modulo_format(mp_obj_t pattern, size_t n_args, const mp_obj_
     size_t arg_i = 0;
     vstr_t vstr;
     mp_print_t print;
-    vstr_init_print(&vstr, 16, &print);
+    vstr_init_print(&vstr, STR_FORMAT_ALLOC(len, n_args), &print);
 
     for (const byte *top = str + len; str < top; str++) {
         mp_obj_t arg = MP_OBJ_NULL;
         if (*str != '%') {
-            vstr_add_byte(&vstr, *str);
+            // Copy the text up to the next % in one go.
+            const byte *text = str;
+            while (str + 1 < top && str[1] != '%') {
+                str++;
+            }
+            vstr_add_strn(&vstr, (const char*)text, str + 1 - text);
             continue;
         }
         if (++str >= top) {
@@ -1545,15 +1589,20 @@ not_enough_args:
             case 'r':
             case 's':
             {
-                vstr_t arg_vstr;
-                mp_print_t arg_print;
-                vstr_init_print(&arg_vstr, 16, &arg_print);
                 mp_print_kind_t print_kind = (*str == 'r' ? PRINT_REPR : PRINT_STR);
                 if (print_kind == PRINT_STR && is_bytes && MP_OBJ_IS_TYPE(arg, &mp_type_bytes)) {
                     // If we have something like b"%s" % b"1", bytes arg should be
                     // printed undecorated.
                     print_kind = PRINT_RAW;
                 }
+                if (width == 0 && prec < 0) {
+                    // Nothing to pad or truncate, so print straight into the result.
+                    mp_obj_print_helper(&print, arg, print_kind);
+                    break;
+                }
+                vstr_t arg_vstr;
+                mp_print_t arg_print;
+                vstr_init_print(&arg_vstr, 16, &arg_print);
                 mp_obj_print_helper(&arg_print, arg, print_kind);
                 uint vlen = arg_vstr.len;
                 if (prec < 0) {
@@ -2073,6 +2122,31 @@ mp_obj_t mp_obj_new_str(const char* data, size_t len) {
     }
 }
 
+#if MICROPY_STR_INTERN_CACHE
+// Like mp_obj_new_str, but a short str that isn't a qstr is looked up in, and
+// otherwise added to, a small cache indexed by hash, so that strings that keep
+// turning up at runtime (eg dict keys parsed from JSON) share one object.  The
+// cache is checked first as it's much cheaper than searching the qstr pools.
+mp_obj_t mp_obj_new_str_cached(const char* data, size_t len) {
+    if (len > MICROPY_STR_INTERN_CACHE_MAX_LEN) {
+        return mp_obj_new_str(data, len);
+    }
+    mp_uint_t hash = qstr_compute_hash((const byte*)data, len);
+    mp_obj_t *slot = &MP_STATE_VM(str_intern_cache)[hash % MICROPY_STR_INTERN_CACHE];
+    if (*slot != MP_OBJ_NULL) {
+        const mp_obj_str_t *o = MP_OBJ_TO_PTR(*slot);
+        if (o->hash == hash && o->len == len && memcmp(o->data, data, len) == 0) {
+            return *slot;
+        }
+    }
+    mp_obj_t o = mp_obj_new_str(data, len);
+    if (!MP_OBJ_IS_QSTR(o)) {
+        *slot = o;
+    }
+    return o;
+}
+#endif
+
 mp_obj_t mp_obj_str_intern(mp_obj_t str) {
     GET_STR_DATA_LEN(str, data, len);
     return mp_obj_new_str_via_qstr((const char*)data, len);
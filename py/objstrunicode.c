@@ -100,13 +100,127 @@ STATIC void uni_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
     }
 }
 
+#if MICROPY_OPT_STR_INDEX_CACHE
+
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+#error "MICROPY_OPT_STR_INDEX_CACHE requires MICROPY_PY_THREAD_GIL"
+#endif
+#if !MICROPY_ENABLE_GC
+#error "MICROPY_OPT_STR_INDEX_CACHE requires MICROPY_ENABLE_GC"
+#endif
+
+// Shorter strings are quick enough to walk that caching them would only
+// evict a more useful entry.
+#define STR_INDEX_CACHE_MIN_LEN (32)
+
+// Return the index cache filled in for the given str data, or NULL if the str
+// is too short to be worth caching.  Filling it in costs one pass over the
+// data, which counts the characters and notes a checkpoint each time another
+// 1/MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS of the bytes has been passed.
+STATIC mp_str_index_cache_t *str_index_cache(const byte *data, size_t len) {
+    if (len < STR_INDEX_CACHE_MIN_LEN) {
+        return NULL;
+    }
+    mp_str_index_cache_t *cache = &MP_STATE_VM(str_index_cache);
+    if (cache->data == data && cache->len == len) {
+        return cache;
+    }
+    size_t charlen = 0;
+    size_t n = 0;
+    size_t next_offset = 0;
+    for (size_t offset = 0; offset < len; offset++) {
+        if (UTF8_IS_CONT(data[offset])) {
+            continue;
+        }
+        if (offset >= next_offset && n < MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS) {
+            cache->checkpoints[n].index = charlen;
+            cache->checkpoints[n].offset = offset;
+            n++;
+            next_offset = n * len / MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS;
+        }
+        charlen++;
+    }
+    // Lengths can be such that the last few checkpoints are never reached.
+    for (; n < MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS; n++) {
+        cache->checkpoints[n] = cache->checkpoints[n - 1];
+    }
+    cache->data = data;
+    cache->len = len;
+    cache->charlen = charlen;
+    cache->last = cache->checkpoints[0];
+    return cache;
+}
+
+// Return the byte offset of the character at index, which must be less than
+// cache->charlen, walking from the closest of the last position looked up
+// and the checkpoints.
+STATIC size_t str_index_cache_offset(mp_str_index_cache_t *cache, size_t index) {
+    if (cache->charlen == cache->len) {
+        // ASCII only.
+        return index;
+    }
+    mp_str_index_pos_t pos = cache->checkpoints[0];
+    for (size_t n = 1; n < MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS && cache->checkpoints[n].index <= index; n++) {
+        pos = cache->checkpoints[n];
+    }
+    if (cache->last.index <= index ? cache->last.index > pos.index : cache->last.index - index < index - pos.index) {
+        pos = cache->last;
+    }
+    const byte *data = cache->data;
+    while (pos.index < index) {
+        pos.index++;
+        do {
+            pos.offset++;
+        } while (UTF8_IS_CONT(data[pos.offset]));
+    }
+    while (pos.index > index) {
+        pos.index--;
+        do {
+            pos.offset--;
+        } while (UTF8_IS_CONT(data[pos.offset]));
+    }
+    cache->last = pos;
+    return pos.offset;
+}
+
+// Return the number of characters that start before offset, which must be at
+// most cache->len.
+STATIC size_t str_index_cache_index(mp_str_index_cache_t *cache, size_t offset) {
+    if (cache->charlen == cache->len) {
+        return offset;
+    }
+    mp_str_index_pos_t pos = cache->checkpoints[0];
+    for (size_t n = 1; n < MICROPY_OPT_STR_INDEX_CACHE_CHECKPOINTS && cache->checkpoints[n].offset <= offset; n++) {
+        pos = cache->checkpoints[n];
+    }
+    if (cache->last.offset <= offset && cache->last.offset > pos.offset) {
+        pos = cache->last;
+    }
+    const byte *data = cache->data;
+    for (; pos.offset < offset; pos.offset++) {
+        if (!UTF8_IS_CONT(data[pos.offset])) {
+            pos.index++;
+        }
+    }
+    return pos.index;
+}
+
+#endif // MICROPY_OPT_STR_INDEX_CACHE
+
 STATIC mp_obj_t uni_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
     GET_STR_DATA_LEN(self_in, str_data, str_len);
     switch (op) {
         case MP_UNARY_OP_BOOL:
             return mp_obj_new_bool(str_len != 0);
-        case MP_UNARY_OP_LEN:
+        case MP_UNARY_OP_LEN: {
+            #if MICROPY_OPT_STR_INDEX_CACHE
+            mp_str_index_cache_t *cache = str_index_cache(str_data, str_len);
+            if (cache != NULL) {
+                return MP_OBJ_NEW_SMALL_INT(cache->charlen);
+            }
+            #endif
             return MP_OBJ_NEW_SMALL_INT(utf8_charlen(str_data, str_len));
+        }
         default:
             return MP_OBJ_NULL; // op not supported
     }
@@ -122,6 +236,13 @@ size_t str_offset_to_index(const mp_obj_type_t *type, const byte *self_data, siz
         return offset;
     }
 
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    mp_str_index_cache_t *cache = str_index_cache(self_data, self_len);
+    if (cache != NULL) {
+        return str_index_cache_index(cache, offset);
+    }
+    #endif
+
     size_t index_val = 0;
     const byte *s = self_data;
     for (size_t i = 0; i < offset; i++, s++) {
@@ -154,6 +275,30 @@ const byte *str_index_to_ptr(const mp_obj_type_t *type, const byte *self_data, s
         mp_raise_TypeError_varg(translate("string indices must be integers, not %s"), mp_obj_get_type_str(index));
     }
     const byte *s, *top = self_data + self_len;
+
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    // With the character count known the index can be bounds-checked up front.
+    mp_str_index_cache_t *cache = str_index_cache(self_data, self_len);
+    if (cache != NULL) {
+        if (i < 0) {
+            i += cache->charlen;
+            if (i < 0) {
+                if (is_slice) {
+                    return self_data;
+                }
+                mp_raise_IndexError(translate("string index out of range"));
+            }
+        }
+        if ((size_t)i >= cache->charlen) {
+            if (is_slice) {
+                return top;
+            }
+            mp_raise_IndexError(translate("string index out of range"));
+        }
+        return self_data + str_index_cache_offset(cache, i);
+    }
+    #endif
+
     if (i < 0)
     {
         // Negative indexing is performed by counting from the end of the string.
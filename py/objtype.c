@@ -49,6 +49,7 @@
 
 #define TYPE_FLAG_IS_SUBCLASSED (0x0001)
 #define TYPE_FLAG_HAS_SPECIAL_ACCESSORS (0x0002)
+#define TYPE_FLAG_HAS_SLOTS (0x0004)
 
 STATIC mp_obj_t static_class_method_make_new(const mp_obj_type_t *self_in, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args);
 
@@ -105,9 +106,18 @@ STATIC
 mp_obj_instance_t *mp_obj_new_instance(const mp_obj_type_t *class, const mp_obj_type_t **native_base) {
     size_t num_native_bases = instance_count_native_bases(class, native_base);
     assert(num_native_bases < 2);
-    mp_obj_instance_t *o = m_new_obj_var(mp_obj_instance_t, mp_obj_t, num_native_bases);
+    size_t num_slots = 0;
+    #if MICROPY_PY_SLOTS
+    if (class->flags & TYPE_FLAG_HAS_SLOTS) {
+        num_slots = ((const mp_obj_slots_type_t*)class)->num_slots;
+    }
+    #endif
+    mp_obj_instance_t *o = m_new_obj_var(mp_obj_instance_t, mp_obj_t, num_native_bases + num_slots);
     o->base.type = class;
     mp_map_init(&o->members, 0);
+    for (size_t i = 0; i < num_slots; i++) {
+        o->subobj[num_native_bases + i] = MP_OBJ_NULL;
+    }
     // Initialise the native base-class slot (should be 1 at most) with a valid
     // object.  It doesn't matter which object, so long as it can be uniquely
     // distinguished from a native class that is initialised.
@@ -117,6 +127,26 @@ mp_obj_instance_t *mp_obj_new_instance(const mp_obj_type_t *class, const mp_obj_
     return o;
 }
 
+#if MICROPY_PY_SLOTS
+mp_obj_t *mp_obj_instance_get_slot(mp_obj_instance_t *self, qstr attr) {
+    if (!(self->base.type->flags & TYPE_FLAG_HAS_SLOTS)) {
+        return NULL;
+    }
+    const mp_obj_slots_type_t *type = (const mp_obj_slots_type_t*)self->base.type;
+    for (size_t i = 0; i < type->num_slots; i++) {
+        if (type->names[i] == attr) {
+            return &self->subobj[type->first_slot + i];
+        }
+    }
+    return NULL;
+}
+
+STATIC bool instance_has_dict(mp_obj_instance_t *self) {
+    return !(self->base.type->flags & TYPE_FLAG_HAS_SLOTS)
+        || ((const mp_obj_slots_type_t*)self->base.type)->has_dict;
+}
+#endif
+
 // TODO
 // This implements depth-first left-to-right MRO, which is not compliant with Python3 MRO
 // http://python-history.blogspot.com/2010/06/method-resolution-order.html
@@ -584,6 +614,13 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
     assert(mp_obj_is_instance_type(mp_obj_get_type(self_in)));
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
 
+    #if MICROPY_PY_SLOTS
+    mp_obj_t *slot = mp_obj_instance_get_slot(self, attr);
+    if (slot != NULL && *slot != MP_OBJ_NULL) {
+        dest[0] = *slot;
+        return;
+    }
+    #endif
     mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
     if (elem != NULL) {
         // object member, always treated as a value
@@ -591,7 +628,11 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
         return;
     }
 #if MICROPY_CPYTHON_COMPAT
+    #if MICROPY_PY_SLOTS
+    if (attr == MP_QSTR___dict__ && instance_has_dict(self)) {
+    #else
     if (attr == MP_QSTR___dict__) {
+    #endif
         // Create a new dict with a copy of the instance's map items.
         // This creates, unlike CPython, a 'read-only' __dict__: modifying
         // it will not result in modifications to the actual instance members.
@@ -792,6 +833,21 @@ STATIC bool mp_obj_instance_store_attr(mp_obj_t self_in, qstr attr, mp_obj_t val
 
 skip_special_accessors:
 
+    #if MICROPY_PY_SLOTS
+    mp_obj_t *slot = mp_obj_instance_get_slot(self, attr);
+    if (slot != NULL) {
+        if (value == MP_OBJ_NULL && *slot == MP_OBJ_NULL) {
+            // can't delete a slot that isn't set
+            return false;
+        }
+        *slot = value;
+        return true;
+    }
+    if (!instance_has_dict(self)) {
+        return false;
+    }
+    #endif
+
     if (value == MP_OBJ_NULL) {
         // delete attribute
         mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
@@ -1113,6 +1169,10 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
 
     // Basic validation of base classes
     uint16_t base_flags = 0;
+    #if MICROPY_PY_SLOTS
+    const mp_obj_slots_type_t *base_slots = NULL;
+    bool base_has_dict = false;
+    #endif
     size_t bases_len;
     mp_obj_t *bases_items;
     mp_obj_tuple_get(bases_tuple, &bases_len, &bases_items);
@@ -1136,9 +1196,59 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
             base_flags |= t->flags & TYPE_FLAG_HAS_SPECIAL_ACCESSORS;
         }
         #endif
+        #if MICROPY_PY_SLOTS
+        if (mp_obj_is_instance_type(t)) {
+            if (!(t->flags & TYPE_FLAG_HAS_SLOTS)) {
+                base_has_dict = true;
+            } else if (base_slots == NULL) {
+                base_slots = (const mp_obj_slots_type_t*)t;
+                base_has_dict |= base_slots->has_dict;
+            } else {
+                mp_raise_TypeError(translate("multiple bases have instance lay-out conflict"));
+            }
+        }
+        #endif
     }
 
+    #if MICROPY_PY_SLOTS
+    // The slots of a class are those of its base followed by its own.  Its
+    // instances only go without a dict if every class along the way has
+    // __slots__, and none of them names __dict__.
+    size_t num_base_slots = base_slots == NULL ? 0 : base_slots->num_slots;
+    size_t num_own_slots = 0;
+    mp_obj_t *own_slots = NULL;
+    mp_map_elem_t *slots_elem = mp_map_lookup(mp_obj_dict_get_map(locals_dict), MP_OBJ_NEW_QSTR(MP_QSTR___slots__), MP_MAP_LOOKUP);
+    if (slots_elem != NULL) {
+        if (MP_OBJ_IS_STR(slots_elem->value)) {
+            num_own_slots = 1;
+            own_slots = &slots_elem->value;
+        } else {
+            mp_obj_get_array(slots_elem->value, &num_own_slots, &own_slots);
+        }
+    }
+    mp_obj_type_t *o;
+    if (slots_elem != NULL || base_slots != NULL) {
+        mp_obj_slots_type_t *st = m_malloc0(sizeof(mp_obj_slots_type_t) + (num_base_slots + num_own_slots) * sizeof(qstr), true);
+        st->has_dict = slots_elem == NULL || base_has_dict;
+        for (size_t i = 0; i < num_base_slots; i++) {
+            st->names[st->num_slots++] = base_slots->names[i];
+        }
+        for (size_t i = 0; i < num_own_slots; i++) {
+            qstr slot_name = mp_obj_str_get_qstr(own_slots[i]);
+            if (slot_name == MP_QSTR___dict__) {
+                st->has_dict = true;
+            } else {
+                st->names[st->num_slots++] = slot_name;
+            }
+        }
+        o = &st->type;
+        base_flags |= TYPE_FLAG_HAS_SLOTS;
+    } else {
+        o = m_new0_ll(mp_obj_type_t, 1);
+    }
+    #else
     mp_obj_type_t *o = m_new0_ll(mp_obj_type_t, 1);
+    #endif
     o->base.type = &mp_type_type;
     o->flags = base_flags;
     o->name = name;
@@ -1179,6 +1289,11 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
     if (num_native_bases > 1) {
         mp_raise_TypeError(translate("multiple bases have instance lay-out conflict"));
     }
+    #if MICROPY_PY_SLOTS
+    if (o->flags & TYPE_FLAG_HAS_SLOTS) {
+        ((mp_obj_slots_type_t*)o)->first_slot = num_native_bases;
+    }
+    #endif
 
     mp_map_t *locals_map = &o->locals_dict->map;
     #if ENABLE_SPECIAL_ACCESSORS
@@ -37,6 +37,23 @@ typedef struct _mp_obj_instance_t {
     // TODO maybe cache __getattr__ and __setattr__ for efficient lookup of them
 } mp_obj_instance_t;
 
+#if MICROPY_PY_SLOTS
+// A class that defines or inherits __slots__ is allocated as one of these.
+// Its instances keep the slot attributes in subobj, after the native base
+// object if there is one, instead of in members.
+typedef struct _mp_obj_slots_type_t {
+    mp_obj_type_t type;
+    uint16_t num_slots;
+    uint8_t first_slot;     // index in subobj of names[0]
+    bool has_dict;          // instances can also have attributes outside the slots
+    qstr names[];
+} mp_obj_slots_type_t;
+
+// Returns the slot holding attr, which is MP_OBJ_NULL while unset, or NULL if
+// attr isn't a slot of the instance's class.
+mp_obj_t *mp_obj_instance_get_slot(mp_obj_instance_t *self, qstr attr);
+#endif
+
 #if MICROPY_CPYTHON_COMPAT
 // this is needed for object.__new__
 mp_obj_instance_t *mp_obj_new_instance(const mp_obj_type_t *cls, const mp_obj_type_t **native_base);
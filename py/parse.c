@@ -241,6 +241,11 @@ typedef struct _parser_t {
     #if MICROPY_COMP_CONST
     mp_map_t consts;
     #endif
+
+    #if MICROPY_COMP_STREAM_IMPORT
+    mp_parse_stmt_cb_t stmt_cb;
+    void *stmt_env;
+    #endif
 } parser_t;
 
 STATIC const uint16_t *get_rule_arg(uint8_t r_id) {
@@ -601,6 +606,43 @@ STATIC bool fold_logical_constants(parser_t *parser, uint8_t rule_id, size_t *nu
         pop_result(parser);
         push_result_node(parser, pn);
         return true;
+
+    } else if (rule_id == RULE_comparison && MP_STATE_VM(mp_optimise_value) >= 2) {
+        // with -O2, fold comparisons of integers, eg X < 3 where X is a const
+        mp_obj_t lhs;
+        if (!mp_parse_node_get_int_maybe(peek_result(parser, *num_args - 1), &lhs)) {
+            return false;
+        }
+        bool result = true;
+        for (ssize_t i = *num_args - 2; i >= 1; i -= 2) {
+            mp_parse_node_t pn_op = peek_result(parser, i);
+            mp_obj_t rhs;
+            if (!MP_PARSE_NODE_IS_TOKEN(pn_op)
+                || !mp_parse_node_get_int_maybe(peek_result(parser, i - 1), &rhs)) {
+                return false;
+            }
+            mp_binary_op_t op;
+            switch (MP_PARSE_NODE_LEAF_ARG(pn_op)) {
+                case MP_TOKEN_OP_LESS: op = MP_BINARY_OP_LESS; break;
+                case MP_TOKEN_OP_MORE: op = MP_BINARY_OP_MORE; break;
+                case MP_TOKEN_OP_DBL_EQUAL: op = MP_BINARY_OP_EQUAL; break;
+                case MP_TOKEN_OP_LESS_EQUAL: op = MP_BINARY_OP_LESS_EQUAL; break;
+                case MP_TOKEN_OP_MORE_EQUAL: op = MP_BINARY_OP_MORE_EQUAL; break;
+                case MP_TOKEN_OP_NOT_EQUAL: op = MP_BINARY_OP_NOT_EQUAL; break;
+                default: return false; // in, is
+            }
+            // a chained comparison is true only if every link is
+            if (mp_binary_op(op, lhs, rhs) == mp_const_false) {
+                result = false;
+            }
+            lhs = rhs;
+        }
+        for (size_t i = *num_args; i > 0; i--) {
+            pop_result(parser);
+        }
+        push_result_node(parser, mp_parse_node_new_leaf(MP_PARSE_NODE_TOKEN,
+            result ? MP_TOKEN_KW_TRUE : MP_TOKEN_KW_FALSE));
+        return true;
     }
 
     return false;
@@ -835,7 +877,40 @@ STATIC void push_result_rule(parser_t *parser, size_t src_line, uint8_t rule_id,
     push_result_node(parser, (mp_parse_node_t)pn);
 }
 
-mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
+// truncate the chunk being filled and link it into the tree's chain of chunks
+STATIC void parser_finish_chunk(parser_t *parser) {
+    if (parser->cur_chunk != NULL) {
+        (void)m_renew_maybe(byte, parser->cur_chunk,
+            sizeof(mp_parse_chunk_t) + parser->cur_chunk->alloc,
+            sizeof(mp_parse_chunk_t) + parser->cur_chunk->union_.used,
+            false);
+        parser->cur_chunk->alloc = parser->cur_chunk->union_.used;
+        parser->cur_chunk->union_.next = parser->tree.chunk;
+        parser->tree.chunk = parser->cur_chunk;
+        parser->cur_chunk = NULL;
+    }
+}
+
+#if MICROPY_COMP_STREAM_IMPORT
+// Hand the top-level statement on top of the result stack, and all the parse
+// chunks, which hold nothing else, over to the callback.
+STATIC void parser_emit_stmt(parser_t *parser) {
+    mp_parse_node_t pn = pop_result(parser);
+    assert(parser->result_stack_top == 0);
+    parser_finish_chunk(parser);
+    mp_parse_tree_t tree = parser->tree;
+    parser->tree.chunk = NULL;
+    if (MP_PARSE_NODE_IS_STRUCT(pn) && !MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_pass_stmt)) {
+        tree.root = pn;
+        parser->stmt_cb(parser->stmt_env, &tree);
+    } else {
+        // a blank line or a discarded doc string, with nothing to run
+        mp_parse_tree_clear(&tree);
+    }
+}
+#endif
+
+STATIC mp_parse_tree_t parse_input(mp_lexer_t *lex, mp_parse_input_kind_t input_kind, mp_parse_stmt_cb_t stmt_cb, void *stmt_env) {
 
     // initialise parser and allocate memory for its stacks
 
@@ -877,6 +952,14 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     mp_map_init(&parser.consts, 0);
     #endif
 
+    #if MICROPY_COMP_STREAM_IMPORT
+    parser.stmt_cb = stmt_cb;
+    parser.stmt_env = stmt_env;
+    #else
+    (void)stmt_cb;
+    (void)stmt_env;
+    #endif
+
     // work out the top-level rule to use, and push it on the stack
     size_t top_level_rule;
     switch (input_kind) {
@@ -1113,6 +1196,14 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
                             }
                         } else {
                             assert((arg & RULE_ARG_KIND_MASK) == RULE_ARG_RULE);
+                            #if MICROPY_COMP_STREAM_IMPORT
+                            if (rule_id == RULE_file_input_2 && i > 0 && parser.stmt_cb != NULL) {
+                                // the top-level statement just parsed is compiled and run
+                                // now, so that only one statement's nodes are ever in RAM
+                                parser_emit_stmt(&parser);
+                                i = 0;
+                            }
+                            #endif
                             push_rule(&parser, rule_src_line, rule_id, i + 1); // save this list-rule
                             push_rule_from_arg(&parser, arg); // push child of list-rule
                             goto next_rule;
@@ -1149,15 +1240,7 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     #endif
 
     // truncate final chunk and link into chain of chunks
-    if (parser.cur_chunk != NULL) {
-        (void)m_renew_maybe(byte, parser.cur_chunk,
-            sizeof(mp_parse_chunk_t) + parser.cur_chunk->alloc,
-            sizeof(mp_parse_chunk_t) + parser.cur_chunk->union_.used,
-            false);
-        parser.cur_chunk->alloc = parser.cur_chunk->union_.used;
-        parser.cur_chunk->union_.next = parser.tree.chunk;
-        parser.tree.chunk = parser.cur_chunk;
-    }
+    parser_finish_chunk(&parser);
 
     if (
         lex->tok_kind != MP_TOKEN_END // check we are at the end of the token stream
@@ -1195,6 +1278,18 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     return parser.tree;
 }
 
+mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
+    return parse_input(lex, input_kind, NULL, NULL);
+}
+
+#if MICROPY_COMP_STREAM_IMPORT
+void mp_parse_stream(mp_lexer_t *lex, mp_parse_stmt_cb_t stmt_cb, void *stmt_env) {
+    mp_parse_tree_t tree = parse_input(lex, MP_PARSE_FILE_INPUT, stmt_cb, stmt_env);
+    // every statement has been passed on, so this is just an empty file_input
+    mp_parse_tree_clear(&tree);
+}
+#endif
+
 void mp_parse_tree_clear(mp_parse_tree_t *tree) {
     mp_parse_chunk_t *chunk = tree->chunk;
     while (chunk != NULL) {
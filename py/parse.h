@@ -104,4 +104,13 @@ typedef struct _mp_parse_t {
 mp_parse_tree_t mp_parse(struct _mp_lexer_t *lex, mp_parse_input_kind_t input_kind);
 void mp_parse_tree_clear(mp_parse_tree_t *tree);
 
+// called with each top-level statement of streamed input; it takes ownership of tree
+typedef void (*mp_parse_stmt_cb_t)(void *env, mp_parse_tree_t *tree);
+
+#if MICROPY_COMP_STREAM_IMPORT
+// Parse file input one top-level statement at a time, passing each one to
+// stmt_cb before the next is parsed; the lexer is freed as for mp_parse.
+void mp_parse_stream(struct _mp_lexer_t *lex, mp_parse_stmt_cb_t stmt_cb, void *stmt_env);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_PARSE_H
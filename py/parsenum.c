@@ -31,6 +31,7 @@
 #include "py/parsenumbase.h"
 #include "py/parsenum.h"
 #include "py/smallint.h"
+#include "py/formatfloat.h"
 
 #include "supervisor/shared/translate.h"
 
@@ -185,6 +186,15 @@ mp_obj_t mp_parse_num_decimal(const char *str, size_t len, bool allow_imag, bool
 #define DEC_VAL_MAX 1e200
 #define SMALL_NORMAL_VAL (1e-307)
 #define SMALL_NORMAL_EXP (-307)
+#endif
+
+#if MICROPY_FLOAT_FAST_DECIMAL
+// the digits are collected in an integer and converted to a float in one step at the end
+typedef uint64_t dec_mant_t;
+#undef DEC_VAL_MAX
+#define DEC_VAL_MAX (100000000000000000ULL)
+#else
+typedef mp_float_t dec_mant_t;
 #endif
 
     const char *top = str + len;
@@ -233,6 +243,7 @@ mp_obj_t mp_parse_num_decimal(const char *str, size_t len, bool allow_imag, bool
         bool exp_neg = false;
         int exp_val = 0;
         int exp_extra = 0;
+        dec_mant_t dec_mant = 0;
         while (str < top) {
             unsigned int dig = *str++;
             if ('0' <= dig && dig <= '9') {
@@ -245,14 +256,14 @@ mp_obj_t mp_parse_num_decimal(const char *str, size_t len, bool allow_imag, bool
                         exp_val = 10 * exp_val + dig;
                     }
                 } else {
-                    if (dec_val < DEC_VAL_MAX) {
-                        // dec_val won't overflow so keep accumulating
-                        dec_val = 10 * dec_val + dig;
+                    if (dec_mant < DEC_VAL_MAX) {
+                        // dec_mant won't overflow so keep accumulating
+                        dec_mant = 10 * dec_mant + dig;
                         if (in == PARSE_DEC_IN_FRAC) {
                             --exp_extra;
                         }
                     } else {
-                        // dec_val might overflow and we anyway can't represent more digits
+                        // dec_mant might overflow and we anyway can't represent more digits
                         // of precision, so ignore the digit and just adjust the exponent
                         if (in == PARSE_DEC_IN_INTG) {
                             ++exp_extra;
@@ -291,13 +302,19 @@ mp_obj_t mp_parse_num_decimal(const char *str, size_t len, bool allow_imag, bool
             exp_val = -exp_val;
         }
 
-        // apply the exponent, making sure it's not a subnormal value
+        // apply the exponent
         exp_val += exp_extra;
+        #if MICROPY_FLOAT_FAST_DECIMAL
+        dec_val = mp_float_from_decimal(dec_mant, exp_val);
+        #else
+        // making sure it's not a subnormal value
+        dec_val = dec_mant;
         if (exp_val < SMALL_NORMAL_EXP) {
             exp_val -= SMALL_NORMAL_EXP;
             dec_val *= SMALL_NORMAL_VAL;
         }
         dec_val *= MICROPY_FLOAT_C_FUN(pow)(10, exp_val);
+        #endif
     }
 
     // negate value if needed
@@ -41,7 +41,7 @@
 #include "py/smallint.h"
 
 // The current version of .mpy files
-#define MPY_VERSION (3)
+#define MPY_VERSION (4)
 
 // The feature flags byte encodes the compile-time config options that
 // affect the generate bytecode.
@@ -101,6 +101,7 @@ STATIC void extract_prelude(const byte **ip, const byte **ip2, bytecode_prelude_
 #if MICROPY_PERSISTENT_CODE_LOAD
 
 #include "py/parsenum.h"
+#include "py/objtuple.h"
 
 STATIC int read_byte(mp_reader_t *reader) {
     return reader->readbyte(reader->data);
@@ -124,18 +125,56 @@ STATIC size_t read_uint(mp_reader_t *reader) {
     return unum;
 }
 
+// A .mpy file starts with a table of every qstr it uses, each with its 16 bit hash, and refers to
+// qstrs everywhere else by their index in the table. Loading then interns each qstr once without
+// hashing it, and the bytecode only needs the indices swapped for qstrs.
+typedef struct _qstr_table_t {
+    qstr *qstrs;
+    size_t len;
+} qstr_table_t;
+
+STATIC NORETURN void raise_incompatible(void) {
+    mp_raise_ValueError(translate("Incompatible .mpy file. Please update all .mpy files. See http://adafru.it/mpy-update for more info."));
+}
+
 STATIC qstr load_qstr(mp_reader_t *reader) {
+    byte hash[2];
+    read_bytes(reader, hash, sizeof(hash));
     size_t len = read_uint(reader);
     char str[len];
     read_bytes(reader, (byte*)str, len);
-    qstr qst = qstr_from_strn(str, len);
-    return qst;
+    return qstr_from_strn_hash16(str, len, hash[0] | (hash[1] << 8));
+}
+
+STATIC qstr get_qstr(const qstr_table_t *table, size_t index) {
+    if (index >= table->len) {
+        raise_incompatible();
+    }
+    return table->qstrs[index];
+}
+
+STATIC void link_qstr(const qstr_table_t *table, byte *ip) {
+    qstr qst = get_qstr(table, ip[0] | (ip[1] << 8));
+    ip[0] = qst;
+    ip[1] = qst >> 8;
 }
 
 STATIC mp_obj_t load_obj(mp_reader_t *reader) {
     byte obj_type = read_byte(reader);
     if (obj_type == 'e') {
         return MP_OBJ_FROM_PTR(&mp_const_ellipsis_obj);
+    } else if (obj_type == 'n') {
+        return mp_const_none;
+    } else if (obj_type == 'F' || obj_type == 'T') {
+        return mp_obj_new_bool(obj_type == 'T');
+    } else if (obj_type == 't') {
+        // a constant tuple, its items follow as nested objects
+        size_t len = read_uint(reader);
+        mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(len, NULL));
+        for (size_t i = 0; i < len; ++i) {
+            tuple->items[i] = load_obj(reader);
+        }
+        return MP_OBJ_FROM_PTR(tuple);
     } else {
         size_t len = read_uint(reader);
         vstr_t vstr;
@@ -152,23 +191,25 @@ STATIC mp_obj_t load_obj(mp_reader_t *reader) {
     }
 }
 
-STATIC void load_bytecode_qstrs(mp_reader_t *reader, byte *ip, byte *ip_top) {
+STATIC void link_bytecode_qstrs(const qstr_table_t *table, byte *ip, byte *ip_top) {
     while (ip < ip_top) {
         size_t sz;
         uint f = mp_opcode_format(ip, &sz);
         if (f == MP_OPCODE_QSTR) {
-            qstr qst = load_qstr(reader);
-            ip[1] = qst;
-            ip[2] = qst >> 8;
+            link_qstr(table, ip + 1);
         }
         ip += sz;
     }
 }
 
-STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader) {
+// Nested code (functions, methods) outlives the import once the module globals
+// are made long-lived, so it is loaded straight into the long-lived part of the
+// heap rather than being copied there afterwards.  The outermost module code is
+// only run once and stays short-lived.
+STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader, const qstr_table_t *table, bool long_lived) {
     // load bytecode
     size_t bc_len = read_uint(reader);
-    byte *bytecode = m_new(byte, bc_len);
+    byte *bytecode = m_malloc(bc_len, long_lived);
     read_bytes(reader, bytecode, bc_len);
 
     // extract prelude
@@ -177,26 +218,24 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader) {
     bytecode_prelude_t prelude;
     extract_prelude(&ip, &ip2, &prelude);
 
-    // load qstrs and link global qstr ids into bytecode
-    qstr simple_name = load_qstr(reader);
-    qstr source_file = load_qstr(reader);
-    ((byte*)ip2)[0] = simple_name; ((byte*)ip2)[1] = simple_name >> 8;
-    ((byte*)ip2)[2] = source_file; ((byte*)ip2)[3] = source_file >> 8;
-    load_bytecode_qstrs(reader, (byte*)ip, bytecode + bc_len);
+    // link global qstr ids into bytecode in place of the qstr table indices
+    link_qstr(table, (byte*)ip2); // simple_name
+    link_qstr(table, (byte*)ip2 + 2); // source_file
+    link_bytecode_qstrs(table, (byte*)ip, bytecode + bc_len);
 
     // load constant table
     size_t n_obj = read_uint(reader);
     size_t n_raw_code = read_uint(reader);
-    mp_uint_t *const_table = m_new(mp_uint_t, prelude.n_pos_args + prelude.n_kwonly_args + n_obj + n_raw_code);
+    mp_uint_t *const_table = m_malloc(sizeof(mp_uint_t) * (prelude.n_pos_args + prelude.n_kwonly_args + n_obj + n_raw_code), long_lived);
     mp_uint_t *ct = const_table;
     for (size_t i = 0; i < prelude.n_pos_args + prelude.n_kwonly_args; ++i) {
-        *ct++ = (mp_uint_t)MP_OBJ_NEW_QSTR(load_qstr(reader));
+        *ct++ = (mp_uint_t)MP_OBJ_NEW_QSTR(get_qstr(table, read_uint(reader)));
     }
     for (size_t i = 0; i < n_obj; ++i) {
         *ct++ = (mp_uint_t)load_obj(reader);
     }
     for (size_t i = 0; i < n_raw_code; ++i) {
-        *ct++ = (mp_uint_t)(uintptr_t)load_raw_code(reader);
+        *ct++ = (mp_uint_t)(uintptr_t)load_raw_code(reader, table, true);
     }
 
     // create raw_code and return it
@@ -220,9 +259,16 @@ mp_raw_code_t *mp_raw_code_load(mp_reader_t *reader) {
         || header[1] != MPY_VERSION
         || header[2] != MPY_FEATURE_FLAGS
         || header[3] > mp_small_int_bits()) {
-        mp_raise_ValueError(translate("Incompatible .mpy file. Please update all .mpy files. See http://adafru.it/mpy-update for more info."));
+        raise_incompatible();
+    }
+    qstr_table_t table;
+    table.len = read_uint(reader);
+    table.qstrs = m_new(qstr, table.len);
+    for (size_t i = 0; i < table.len; ++i) {
+        table.qstrs[i] = load_qstr(reader);
     }
-    mp_raw_code_t *rc = load_raw_code(reader);
+    mp_raw_code_t *rc = load_raw_code(reader, &table, false);
+    m_del(qstr, table.qstrs, table.len);
     reader->close(reader->data);
     return rc;
 }
@@ -261,13 +307,45 @@ STATIC void mp_print_uint(mp_print_t *print, size_t n) {
     print->print_strn(print->data, (char*)p, buf + sizeof(buf) - p);
 }
 
+// The qstrs a .mpy file uses, in the order they are first used.
+typedef struct _save_qstr_table_t {
+    qstr *qstrs;
+    size_t len;
+    size_t alloc;
+} save_qstr_table_t;
+
+// Returns the index of qst in the table, adding it if it isn't there yet.
+STATIC size_t qstr_table_index(save_qstr_table_t *table, qstr qst) {
+    for (size_t i = 0; i < table->len; ++i) {
+        if (table->qstrs[i] == qst) {
+            return i;
+        }
+    }
+    if (table->len == table->alloc) {
+        table->qstrs = m_renew(qstr, table->qstrs, table->alloc, table->alloc * 2);
+        table->alloc *= 2;
+    }
+    table->qstrs[table->len] = qst;
+    return table->len++;
+}
+
 STATIC void save_qstr(mp_print_t *print, qstr qst) {
     size_t len;
     const byte *str = qstr_data(qst, &len);
+    uint16_t hash = qstr_compute_hash16(str, len);
+    byte hash_bytes[2] = {hash, hash >> 8};
+    mp_print_bytes(print, hash_bytes, sizeof(hash_bytes));
     mp_print_uint(print, len);
     mp_print_bytes(print, str, len);
 }
 
+// Swaps the qstr at ip for its index in the table.
+STATIC void unlink_qstr(save_qstr_table_t *table, byte *ip) {
+    size_t index = qstr_table_index(table, ip[0] | (ip[1] << 8));
+    ip[0] = index;
+    ip[1] = index >> 8;
+}
+
 STATIC void save_obj(mp_print_t *print, mp_obj_t o) {
     if (MP_OBJ_IS_STR_OR_BYTES(o)) {
         byte obj_type;
@@ -284,11 +362,25 @@ STATIC void save_obj(mp_print_t *print, mp_obj_t o) {
     } else if (MP_OBJ_TO_PTR(o) == &mp_const_ellipsis_obj) {
         byte obj_type = 'e';
         mp_print_bytes(print, &obj_type, 1);
+    } else if (o == mp_const_none || o == mp_const_false || o == mp_const_true) {
+        // these only appear as items of a constant tuple
+        byte obj_type = o == mp_const_none ? 'n' : o == mp_const_true ? 'T' : 'F';
+        mp_print_bytes(print, &obj_type, 1);
+    } else if (MP_OBJ_IS_TYPE(o, &mp_type_tuple)) {
+        byte obj_type = 't';
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_tuple_get(o, &len, &items);
+        mp_print_bytes(print, &obj_type, 1);
+        mp_print_uint(print, len);
+        for (size_t i = 0; i < len; ++i) {
+            save_obj(print, items[i]);
+        }
     } else {
         // we save numbers using a simplistic text representation
         // TODO could be improved
         byte obj_type;
-        if (MP_OBJ_IS_TYPE(o, &mp_type_int)) {
+        if (MP_OBJ_IS_SMALL_INT(o) || MP_OBJ_IS_TYPE(o, &mp_type_int)) {
             obj_type = 'i';
         #if MICROPY_PY_BUILTINS_COMPLEX
         } else if (MP_OBJ_IS_TYPE(o, &mp_type_complex)) {
@@ -309,37 +401,43 @@ STATIC void save_obj(mp_print_t *print, mp_obj_t o) {
     }
 }
 
-STATIC void save_bytecode_qstrs(mp_print_t *print, const byte *ip, const byte *ip_top) {
+STATIC void unlink_bytecode_qstrs(save_qstr_table_t *table, byte *ip, const byte *ip_top) {
     while (ip < ip_top) {
         size_t sz;
         uint f = mp_opcode_format(ip, &sz);
         if (f == MP_OPCODE_QSTR) {
-            qstr qst = ip[1] | (ip[2] << 8);
-            save_qstr(print, qst);
+            unlink_qstr(table, ip + 1);
         }
         ip += sz;
     }
 }
 
-STATIC void save_raw_code(mp_print_t *print, mp_raw_code_t *rc) {
+// Saves rc with its qstrs replaced by their indices in the table, adding any new ones to the table.
+// Running it with a null print only fills the table.
+STATIC void save_raw_code(mp_print_t *print, save_qstr_table_t *table, mp_raw_code_t *rc) {
     if (rc->kind != MP_CODE_BYTECODE) {
         mp_raise_ValueError(translate("can only save bytecode"));
     }
 
-    // save bytecode
-    mp_print_uint(print, rc->data.u_byte.bc_len);
-    mp_print_bytes(print, rc->data.u_byte.bytecode, rc->data.u_byte.bc_len);
+    // copy the bytecode so that its qstrs can be swapped for table indices
+    size_t bc_len = rc->data.u_byte.bc_len;
+    byte *bytecode = m_new(byte, bc_len);
+    memcpy(bytecode, rc->data.u_byte.bytecode, bc_len);
 
     // extract prelude
-    const byte *ip = rc->data.u_byte.bytecode;
+    const byte *ip = bytecode;
     const byte *ip2;
     bytecode_prelude_t prelude;
     extract_prelude(&ip, &ip2, &prelude);
 
-    // save qstrs
-    save_qstr(print, ip2[0] | (ip2[1] << 8)); // simple_name
-    save_qstr(print, ip2[2] | (ip2[3] << 8)); // source_file
-    save_bytecode_qstrs(print, ip, rc->data.u_byte.bytecode + rc->data.u_byte.bc_len);
+    unlink_qstr(table, (byte*)ip2); // simple_name
+    unlink_qstr(table, (byte*)ip2 + 2); // source_file
+    unlink_bytecode_qstrs(table, (byte*)ip, bytecode + bc_len);
+
+    // save bytecode
+    mp_print_uint(print, bc_len);
+    mp_print_bytes(print, bytecode, bc_len);
+    m_del(byte, bytecode, bc_len);
 
     // save constant table
     mp_print_uint(print, rc->data.u_byte.n_obj);
@@ -347,16 +445,22 @@ STATIC void save_raw_code(mp_print_t *print, mp_raw_code_t *rc) {
     const mp_uint_t *const_table = rc->data.u_byte.const_table;
     for (uint i = 0; i < prelude.n_pos_args + prelude.n_kwonly_args; ++i) {
         mp_obj_t o = (mp_obj_t)*const_table++;
-        save_qstr(print, MP_OBJ_QSTR_VALUE(o));
+        mp_print_uint(print, qstr_table_index(table, MP_OBJ_QSTR_VALUE(o)));
     }
     for (uint i = 0; i < rc->data.u_byte.n_obj; ++i) {
         save_obj(print, (mp_obj_t)*const_table++);
     }
     for (uint i = 0; i < rc->data.u_byte.n_raw_code; ++i) {
-        save_raw_code(print, (mp_raw_code_t*)(uintptr_t)*const_table++);
+        save_raw_code(print, table, (mp_raw_code_t*)(uintptr_t)*const_table++);
     }
 }
 
+STATIC void null_print_strn(void *env, const char *str, size_t len) {
+    (void)env;
+    (void)str;
+    (void)len;
+}
+
 void mp_raw_code_save(mp_raw_code_t *rc, mp_print_t *print) {
     // header contains:
     //  byte  'M'
@@ -372,7 +476,20 @@ void mp_raw_code_save(mp_raw_code_t *rc, mp_print_t *print) {
     };
     mp_print_bytes(print, header, sizeof(header));
 
-    save_raw_code(print, rc);
+    // collect the qstrs first because the table comes before the code
+    save_qstr_table_t table;
+    table.alloc = 16;
+    table.len = 0;
+    table.qstrs = m_new(qstr, table.alloc);
+    mp_print_t null_print = {NULL, null_print_strn};
+    save_raw_code(&null_print, &table, rc);
+
+    mp_print_uint(print, table.len);
+    for (size_t i = 0; i < table.len; ++i) {
+        save_qstr(print, table.qstrs[i]);
+    }
+    save_raw_code(print, &table, rc);
+    m_del(qstr, table.qstrs, table.alloc);
 }
 
 // here we define mp_raw_code_save_file depending on the port
@@ -397,6 +514,23 @@ void mp_raw_code_save_file(mp_raw_code_t *rc, const char *filename) {
     close(fd);
 }
 
+#elif MICROPY_VFS
+
+#include "py/stream.h"
+#include "extmod/vfs.h"
+
+STATIC void stream_print_strn(void *env, const char *str, size_t len) {
+    mp_stream_write(MP_OBJ_FROM_PTR(env), str, len, MP_STREAM_RW_WRITE);
+}
+
+void mp_raw_code_save_file(mp_raw_code_t *rc, const char *filename) {
+    mp_obj_t args[2] = { mp_obj_new_str(filename, strlen(filename)), MP_OBJ_NEW_QSTR(MP_QSTR_wb) };
+    mp_obj_t file = mp_vfs_open(2, args, (mp_map_t*)&mp_const_empty_map);
+    mp_print_t stream_print = {MP_OBJ_TO_PTR(file), stream_print_strn};
+    mp_raw_code_save(rc, &stream_print);
+    mp_stream_close(file);
+}
+
 #else
 #error mp_raw_code_save_file not implemented for this platform
 #endif
@@ -33,8 +33,8 @@
 #include "py/qstr.h"
 #include "py/gc.h"
 
-// NOTE: we are using linear arrays to store and search for qstr's (unique strings, interned strings)
-// ultimately we will replace this with a static hash table of some kind
+// NOTE: we are using linear arrays to store qstr's (unique strings, interned strings)
+// and search them linearly unless MICROPY_QSTR_HASH_INDEX is enabled
 // also probably need to include the length in the string data, to allow null bytes in the string
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
@@ -82,13 +82,18 @@
 #endif
 
 // this must match the equivalent function in makeqstrdata.py
-mp_uint_t qstr_compute_hash(const byte *data, size_t len) {
+uint16_t qstr_compute_hash16(const byte *data, size_t len) {
     // djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
-    mp_uint_t hash = 5381;
+    // Only the low bits feed into higher ones so truncating to 16 bits gives the same low bits.
+    uint16_t hash = 5381;
     for (const byte *top = data + len; data < top; data++) {
         hash = ((hash << 5) + hash) ^ (*data); // hash * 33 ^ data
     }
-    hash &= Q_HASH_MASK;
+    return hash;
+}
+
+STATIC mp_uint_t hash_from_hash16(uint16_t hash16) {
+    mp_uint_t hash = hash16 & Q_HASH_MASK;
     // Make sure that valid hash is never zero, zero means "hash not computed"
     if (hash == 0) {
         hash++;
@@ -96,6 +101,10 @@ mp_uint_t qstr_compute_hash(const byte *data, size_t len) {
     return hash;
 }
 
+mp_uint_t qstr_compute_hash(const byte *data, size_t len) {
+    return hash_from_hash16(qstr_compute_hash16(data, len));
+}
+
 const qstr_pool_t mp_qstr_const_pool = {
     NULL,               // no previous pool
     0,                  // no previous pool
@@ -119,6 +128,62 @@ extern const qstr_pool_t MICROPY_QSTR_EXTRA_POOL;
 #define CONST_POOL mp_qstr_const_pool
 #endif
 
+#if MICROPY_QSTR_HASH_INDEX
+
+#if MICROPY_QSTR_POOL_MAX_ENTRIES > 255
+#error MICROPY_QSTR_HASH_INDEX requires MICROPY_QSTR_POOL_MAX_ENTRIES <= 255
+#endif
+
+// The const pool's qstrs grouped into buckets by hash, generated by makeqstrdata.py.
+// Bucket b holds the qstrs const_pool_hash_entries[const_pool_hash_buckets[b]] up to
+// (but not including) const_pool_hash_entries[const_pool_hash_buckets[b + 1]].
+STATIC const uint16_t const_pool_hash_buckets[] = {
+#ifndef NO_QSTR
+#define QDEF(id, str)
+#define TRANSLATION(id, length, compressed...)
+#define QHASH_BUCKET(start) start,
+#define QHASH_ENTRY(id)
+#include "genhdr/qstrdefs.generated.h"
+#undef QHASH_ENTRY
+#undef QHASH_BUCKET
+#undef TRANSLATION
+#undef QDEF
+#endif
+};
+
+STATIC const uint16_t const_pool_hash_entries[] = {
+#ifndef NO_QSTR
+#define QDEF(id, str)
+#define TRANSLATION(id, length, compressed...)
+#define QHASH_BUCKET(start)
+#define QHASH_ENTRY(id) id,
+#include "genhdr/qstrdefs.generated.h"
+#undef QHASH_ENTRY
+#undef QHASH_BUCKET
+#undef TRANSLATION
+#undef QDEF
+#endif
+};
+
+#define CONST_POOL_HASH_MASK (MP_ARRAY_SIZE(const_pool_hash_buckets) - 2)
+
+// Dynamic pools keep an open addressed table of 2 * alloc bytes after their qstrs.
+// Each slot holds the index in the pool plus one, or zero when empty.
+#define POOL_HASH_INDEX(pool) ((byte*)&(pool)->qstrs[(pool)->alloc])
+#define POOL_HASH_INDEX_LEN(pool) (2 * (pool)->alloc)
+
+STATIC void pool_hash_index_add(qstr_pool_t *pool, size_t index, mp_uint_t hash) {
+    byte *slots = POOL_HASH_INDEX(pool);
+    size_t n_slots = POOL_HASH_INDEX_LEN(pool);
+    size_t pos = hash % n_slots;
+    while (slots[pos] != 0) {
+        pos = (pos + 1) % n_slots;
+    }
+    slots[pos] = index + 1;
+}
+
+#endif
+
 void qstr_init(void) {
     MP_STATE_VM(last_pool) = (qstr_pool_t*)&CONST_POOL; // we won't modify the const_pool since it has no allocated room left
     MP_STATE_VM(qstr_last_chunk) = NULL;
@@ -148,7 +213,12 @@ STATIC qstr qstr_add(const byte *q_ptr) {
         if (new_pool_length > MICROPY_QSTR_POOL_MAX_ENTRIES) {
             new_pool_length = MICROPY_QSTR_POOL_MAX_ENTRIES;
         }
+        #if MICROPY_QSTR_HASH_INDEX
+        // the hash index is stored after the qstr pointers, two bytes per entry
+        qstr_pool_t *pool = m_new_ll_obj_var_maybe(qstr_pool_t, byte, sizeof(const char*) * new_pool_length + 2 * new_pool_length);
+        #else
         qstr_pool_t *pool = m_new_ll_obj_var_maybe(qstr_pool_t, const char*, new_pool_length);
+        #endif
         if (pool == NULL) {
             QSTR_EXIT();
             m_malloc_fail(new_pool_length);
@@ -157,23 +227,55 @@ STATIC qstr qstr_add(const byte *q_ptr) {
         pool->total_prev_len = MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len;
         pool->alloc = new_pool_length;
         pool->len = 0;
+        #if MICROPY_QSTR_HASH_INDEX
+        memset(POOL_HASH_INDEX(pool), 0, POOL_HASH_INDEX_LEN(pool));
+        #endif
         MP_STATE_VM(last_pool) = pool;
         DEBUG_printf("QSTR: allocate new pool of size %d\n", MP_STATE_VM(last_pool)->alloc);
     }
 
     // add the new qstr
+    #if MICROPY_QSTR_HASH_INDEX
+    pool_hash_index_add(MP_STATE_VM(last_pool), MP_STATE_VM(last_pool)->len, Q_GET_HASH(q_ptr));
+    #endif
     MP_STATE_VM(last_pool)->qstrs[MP_STATE_VM(last_pool)->len++] = q_ptr;
 
     // return id for the newly-added qstr
     return MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len - 1;
 }
 
-qstr qstr_find_strn(const char *str, size_t str_len) {
-    // work out hash of str
-    mp_uint_t str_hash = qstr_compute_hash((const byte*)str, str_len);
+STATIC qstr find_strn_with_hash(const char *str, size_t str_len, mp_uint_t str_hash) {
+    #if MICROPY_QSTR_HASH_INDEX
+    // pools are dynamically allocated (and so have a hash index) until the const pool is reached
+    bool dynamic_pool = MP_STATE_VM(last_pool) != &CONST_POOL;
+    #endif
 
     // search pools for the data
     for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+        #if MICROPY_QSTR_HASH_INDEX
+        if (dynamic_pool) {
+            const byte *slots = POOL_HASH_INDEX(pool);
+            size_t n_slots = POOL_HASH_INDEX_LEN(pool);
+            for (size_t pos = str_hash % n_slots; slots[pos] != 0; pos = (pos + 1) % n_slots) {
+                const byte *q = pool->qstrs[slots[pos] - 1];
+                if (Q_GET_HASH(q) == str_hash && Q_GET_LENGTH(q) == str_len && memcmp(Q_GET_DATA(q), str, str_len) == 0) {
+                    return pool->total_prev_len + slots[pos] - 1;
+                }
+            }
+            dynamic_pool = pool->prev != &CONST_POOL;
+            continue;
+        }
+        if (pool == &mp_qstr_const_pool) {
+            size_t bucket = str_hash & CONST_POOL_HASH_MASK;
+            for (size_t i = const_pool_hash_buckets[bucket]; i < const_pool_hash_buckets[bucket + 1]; i++) {
+                const byte *q = pool->qstrs[const_pool_hash_entries[i]];
+                if (Q_GET_HASH(q) == str_hash && Q_GET_LENGTH(q) == str_len && memcmp(Q_GET_DATA(q), str, str_len) == 0) {
+                    return const_pool_hash_entries[i];
+                }
+            }
+            continue;
+        }
+        #endif
         for (const byte **q = pool->qstrs, **q_top = pool->qstrs + pool->len; q < q_top; q++) {
             if (Q_GET_HASH(*q) == str_hash && Q_GET_LENGTH(*q) == str_len && memcmp(Q_GET_DATA(*q), str, str_len) == 0) {
                 return pool->total_prev_len + (q - pool->qstrs);
@@ -185,14 +287,18 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
     return 0;
 }
 
+qstr qstr_find_strn(const char *str, size_t str_len) {
+    return find_strn_with_hash(str, str_len, qstr_compute_hash((const byte*)str, str_len));
+}
+
 qstr qstr_from_str(const char *str) {
     return qstr_from_strn(str, strlen(str));
 }
 
-qstr qstr_from_strn(const char *str, size_t len) {
+STATIC qstr from_strn_with_hash(const char *str, size_t len, mp_uint_t hash) {
     assert(len < (1 << (8 * MICROPY_QSTR_BYTES_IN_LEN)));
     QSTR_ENTER();
-    qstr q = qstr_find_strn(str, len);
+    qstr q = find_strn_with_hash(str, len, hash);
     if (q == 0) {
         // qstr does not exist in interned pool so need to add it
 
@@ -237,7 +343,6 @@ qstr qstr_from_strn(const char *str, size_t len) {
         MP_STATE_VM(qstr_last_used) += n_bytes;
 
         // store the interned strings' data
-        mp_uint_t hash = qstr_compute_hash((const byte*)str, len);
         Q_SET_HASH(q_ptr, hash);
         Q_SET_LENGTH(q_ptr, len);
         memcpy(q_ptr + MICROPY_QSTR_BYTES_IN_HASH + MICROPY_QSTR_BYTES_IN_LEN, str, len);
@@ -248,6 +353,14 @@ qstr qstr_from_strn(const char *str, size_t len) {
     return q;
 }
 
+qstr qstr_from_strn(const char *str, size_t len) {
+    return from_strn_with_hash(str, len, qstr_compute_hash((const byte*)str, len));
+}
+
+qstr qstr_from_strn_hash16(const char *str, size_t len, uint16_t hash16) {
+    return from_strn_with_hash(str, len, hash_from_hash16(hash16));
+}
+
 mp_uint_t qstr_hash(qstr q) {
     return Q_GET_HASH(find_qstr(q));
 }
@@ -284,6 +397,9 @@ void qstr_pool_info(size_t *n_pool, size_t *n_qstr, size_t *n_str_data_bytes, si
         *n_total_bytes += gc_nbytes(pool); // this counts actual bytes used in heap
         #else
         *n_total_bytes += sizeof(qstr_pool_t) + sizeof(qstr) * pool->alloc;
+        #if MICROPY_QSTR_HASH_INDEX
+        *n_total_bytes += POOL_HASH_INDEX_LEN(pool);
+        #endif
         #endif
     }
     *n_total_bytes += *n_str_data_bytes;
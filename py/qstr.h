@@ -61,10 +61,12 @@ typedef struct _qstr_pool_t {
 void qstr_init(void);
 
 mp_uint_t qstr_compute_hash(const byte *data, size_t len);
+uint16_t qstr_compute_hash16(const byte *data, size_t len); // independent of MICROPY_QSTR_BYTES_IN_HASH
 qstr qstr_find_strn(const char *str, size_t str_len); // returns MP_QSTR_NULL if not found
 
 qstr qstr_from_str(const char *str);
 qstr qstr_from_strn(const char *str, size_t len);
+qstr qstr_from_strn_hash16(const char *str, size_t len, uint16_t hash16); // hash16 from qstr_compute_hash16
 
 mp_uint_t qstr_hash(qstr q);
 const char *qstr_str(qstr q);
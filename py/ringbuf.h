@@ -27,8 +27,10 @@
 #define MICROPY_INCLUDED_PY_RINGBUF_H
 
 #include "py/gc.h"
+#include "py/misc.h"
 
 #include <stdint.h>
+#include <string.h>
 
 typedef struct _ringbuf_t {
     uint8_t *buf;
@@ -88,15 +90,59 @@ static inline void ringbuf_clear(ringbuf_t *r)
     r->iput = r->iget = 0;
 }
 
-// will overwrite old data
-static inline void ringbuf_put_n(ringbuf_t* r, uint8_t* buf, uint8_t bufsize)
+static inline uint16_t ringbuf_num_empty(ringbuf_t *r)
 {
-    for(uint8_t i=0; i < bufsize; i++) {
-        if ( ringbuf_put(r, buf[i]) < 0 ) {
-            // if full overwrite old data
-            (void) ringbuf_get(r);
-            ringbuf_put(r, buf[i]);
+    return r->size - 1 - ringbuf_count(r);
+}
+
+// Copies in as much of buf as fits, with at most two memcpy calls. Returns the number of bytes
+// copied.
+static inline size_t ringbuf_put_n(ringbuf_t* r, const uint8_t* buf, size_t len)
+{
+    len = MIN(len, ringbuf_num_empty(r));
+    size_t first = MIN(len, (size_t) (r->size - r->iput));
+    memcpy(r->buf + r->iput, buf, first);
+    memcpy(r->buf, buf + first, len - first);
+    uint32_t iput_new = r->iput + len;
+    if (iput_new >= r->size) {
+        iput_new -= r->size;
+    }
+    r->iput = iput_new;
+    return len;
+}
+
+// Copies out up to len bytes, with at most two memcpy calls. Returns the number of bytes copied.
+static inline size_t ringbuf_get_n(ringbuf_t* r, uint8_t* buf, size_t len)
+{
+    len = MIN(len, ringbuf_count(r));
+    size_t first = MIN(len, (size_t) (r->size - r->iget));
+    memcpy(buf, r->buf + r->iget, first);
+    memcpy(buf + first, r->buf, len - first);
+    uint32_t iget_new = r->iget + len;
+    if (iget_new >= r->size) {
+        iget_new -= r->size;
+    }
+    r->iget = iget_new;
+    return len;
+}
+
+// Like ringbuf_put_n() but drops the oldest data to make room for all of buf. Only the end of buf
+// is kept when it is bigger than the buffer.
+static inline void ringbuf_put_n_overwrite(ringbuf_t* r, const uint8_t* buf, size_t len)
+{
+    size_t capacity = r->size - 1;
+    if (len > capacity) {
+        buf += len - capacity;
+        len = capacity;
+    }
+    size_t empty = ringbuf_num_empty(r);
+    if (len > empty) {
+        uint32_t iget_new = r->iget + (len - empty);
+        if (iget_new >= r->size) {
+            iget_new -= r->size;
         }
+        r->iget = iget_new;
     }
+    ringbuf_put_n(r, buf, len);
 }
 #endif // MICROPY_INCLUDED_PY_RINGBUF_H
@@ -46,6 +46,7 @@
 #include "py/builtin.h"
 #include "py/stackctrl.h"
 #include "py/gc.h"
+#include "py/mperrno.h"
 
 #include "supervisor/shared/translate.h"
 
@@ -58,6 +59,19 @@
 #define DEBUG_OP_printf(...) (void)0
 #endif
 
+#if MICROPY_PREALLOC_OSERROR
+STATIC const mp_rom_obj_tuple_t oserror_eagain_args = {{&mp_type_tuple}, 1, {MP_ROM_INT(MP_EAGAIN)}};
+STATIC const mp_rom_obj_tuple_t oserror_etimedout_args = {{&mp_type_tuple}, 1, {MP_ROM_INT(MP_ETIMEDOUT)}};
+
+STATIC void init_oserror(mp_obj_exception_t *exc, const mp_rom_obj_tuple_t *args) {
+    exc->base.type = &mp_type_OSError;
+    exc->traceback_alloc = 0;
+    exc->traceback_len = 0;
+    exc->traceback_data = NULL;
+    exc->args = (mp_obj_tuple_t*)args;
+}
+#endif
+
 const mp_obj_module_t mp_module___main__ = {
     .base = { &mp_type_module },
     .globals = (mp_obj_dict_t*)&MP_STATE_VM(dict_main),
@@ -73,6 +87,22 @@ void mp_init(void) {
     MP_STATE_VM(sched_sp) = 0;
     #endif
 
+    #if MICROPY_OPT_MAP_LOOKUP_CACHE
+    memset(MP_STATE_VM(map_lookup_cache), 0, sizeof(MP_STATE_VM(map_lookup_cache)));
+    #endif
+
+    #if MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+    memset(MP_STATE_VM(map_lookup_site_cache), 0, sizeof(MP_STATE_VM(map_lookup_site_cache)));
+    #endif
+
+    #if MICROPY_OPT_STR_INDEX_CACHE
+    MP_STATE_VM(str_index_cache).data = NULL;
+    #endif
+
+    #if MICROPY_TRACK_CODE_STATE
+    MP_STATE_THREAD(current_code_state) = NULL;
+    #endif
+
 #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
     mp_init_emergency_exception_buf();
 #endif
@@ -86,6 +116,11 @@ void mp_init(void) {
     MP_STATE_VM(mp_kbd_exception).args = (mp_obj_tuple_t*)&mp_const_empty_tuple_obj;
     #endif
 
+    #if MICROPY_PREALLOC_OSERROR
+    init_oserror(&MP_STATE_VM(mp_eagain_exception), &oserror_eagain_args);
+    init_oserror(&MP_STATE_VM(mp_etimedout_exception), &oserror_etimedout_args);
+    #endif
+
     MP_STATE_VM(mp_reload_exception).base.type = &mp_type_ReloadException;
     MP_STATE_VM(mp_reload_exception).traceback_alloc = 0;
     MP_STATE_VM(mp_reload_exception).traceback_len = 0;
@@ -125,6 +160,18 @@ void mp_init(void) {
     MP_STATE_VM(dupterm_arr_obj) = MP_OBJ_NULL;
     #endif
 
+    #if MICROPY_PY_URE && MICROPY_PY_URE_CACHE_SIZE
+    memset(MP_STATE_VM(ure_cache), 0, sizeof(MP_STATE_VM(ure_cache)));
+    #endif
+
+    #if MICROPY_STR_INTERN_CACHE
+    memset(MP_STATE_VM(str_intern_cache), 0, sizeof(MP_STATE_VM(str_intern_cache)));
+    #endif
+
+    #if MICROPY_EXC_MSG_CACHE
+    memset(MP_STATE_VM(exc_msg_cache), 0, sizeof(MP_STATE_VM(exc_msg_cache)));
+    #endif
+
     #ifdef MICROPY_FSUSERMOUNT
     // zero out the pointers to the user-mounted devices
     memset(MP_STATE_VM(fs_user_mount) + MICROPY_FATFS_NUM_PERSISTENT, 0,
@@ -1071,18 +1118,25 @@ void mp_load_method_maybe(mp_obj_t obj, qstr attr, mp_obj_t *dest) {
         dest[0] = MP_OBJ_FROM_PTR(&mp_builtin_next_obj);
         dest[1] = obj;
 
-    } else if (type->attr != NULL) {
-        // this type can do its own load, so call it
-        type->attr(obj, attr, dest);
-
-    } else if (type->locals_dict != NULL) {
-        // generic method lookup
-        // this is a lookup in the object (ie not class or type)
-        assert(type->locals_dict->base.type == &mp_type_dict); // MicroPython restriction, for now
-        mp_map_t *locals_map = &type->locals_dict->map;
-        mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
-        if (elem != NULL) {
-            mp_convert_member_lookup(obj, type, elem->value, dest);
+    } else {
+        if (type->attr != NULL) {
+            // this type can do its own load, so call it
+            type->attr(obj, attr, dest);
+            if (dest[1] != MP_OBJ_SENTINEL) {
+                return;
+            }
+            // the handler passed this name on to the generic lookup
+            dest[1] = MP_OBJ_NULL;
+        }
+        if (type->locals_dict != NULL) {
+            // generic method lookup
+            // this is a lookup in the object (ie not class or type)
+            assert(type->locals_dict->base.type == &mp_type_dict); // MicroPython restriction, for now
+            mp_map_t *locals_map = &type->locals_dict->map;
+            mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+            if (elem != NULL) {
+                mp_convert_member_lookup(obj, type, elem->value, dest);
+            }
         }
     }
 }
@@ -1130,6 +1184,7 @@ void mp_load_method_protected(mp_obj_t obj, qstr attr, mp_obj_t *dest, bool catc
 void mp_store_attr(mp_obj_t base, qstr attr, mp_obj_t value) {
     DEBUG_OP_printf("store attr %p.%s <- %p\n", base, qstr_str(attr), value);
     mp_obj_type_t *type = mp_obj_get_type(base);
+    bool generic = true;
     if (type->attr != NULL) {
         mp_obj_t dest[2] = {MP_OBJ_SENTINEL, value};
         type->attr(base, attr, dest);
@@ -1137,8 +1192,11 @@ void mp_store_attr(mp_obj_t base, qstr attr, mp_obj_t value) {
             // success
             return;
         }
+        // the handler may pass this name on to the generic lookup
+        generic = dest[1] == MP_OBJ_SENTINEL;
+    }
     #if MICROPY_PY_BUILTINS_PROPERTY
-    } else if (type->locals_dict != NULL) {
+    if (generic && type->locals_dict != NULL) {
         // generic method lookup
         // this is a lookup in the object (ie not class or type)
         assert(type->locals_dict->base.type == &mp_type_dict); // Micro Python restriction, for now
@@ -1166,8 +1224,10 @@ void mp_store_attr(mp_obj_t base, qstr attr, mp_obj_t value) {
                 return;
             }
         }
-    #endif
     }
+    #else
+    (void)generic;
+    #endif
     if (MICROPY_ERROR_REPORTING == MICROPY_ERROR_REPORTING_TERSE) {
         mp_raise_AttributeError(translate("no such attribute"));
     } else {
@@ -1501,6 +1561,39 @@ mp_obj_t mp_parse_compile_execute(mp_lexer_t *lex, mp_parse_input_kind_t parse_i
     }
 }
 
+#if MICROPY_COMP_STREAM_IMPORT
+STATIC void compile_execute_stmt(void *env, mp_parse_tree_t *tree) {
+    qstr source_name = (qstr)(uintptr_t)env;
+    mp_obj_t module_fun = mp_compile(tree, source_name, MP_EMIT_OPT_NONE, false);
+    mp_call_function_0(module_fun);
+}
+
+void mp_parse_compile_execute_stream(mp_lexer_t *lex, mp_obj_dict_t *globals) {
+    // save context
+    mp_obj_dict_t *volatile old_globals = mp_globals_get();
+    mp_obj_dict_t *volatile old_locals = mp_locals_get();
+
+    // set new context
+    mp_globals_set(globals);
+    mp_locals_set(globals);
+
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_parse_stream(lex, compile_execute_stmt, (void*)(uintptr_t)lex->source_name);
+
+        // finish nlr block, restore context
+        nlr_pop();
+        mp_globals_set(old_globals);
+        mp_locals_set(old_locals);
+    } else {
+        // exception; restore context and re-raise same exception
+        mp_globals_set(old_globals);
+        mp_locals_set(old_locals);
+        nlr_jump(nlr.ret_val);
+    }
+}
+#endif
+
 #endif // MICROPY_ENABLE_COMPILER
 
 NORETURN void m_malloc_fail(size_t num_bytes) {
@@ -1571,6 +1664,19 @@ NORETURN void mp_raise_TypeError_varg(const compressed_string_t *fmt, ...) {
 }
 
 NORETURN void mp_raise_OSError(int errno_) {
+    #if MICROPY_PREALLOC_OSERROR
+    mp_obj_exception_t *exc = NULL;
+    if (errno_ == MP_EAGAIN) {
+        exc = &MP_STATE_VM(mp_eagain_exception);
+    } else if (errno_ == MP_ETIMEDOUT) {
+        exc = &MP_STATE_VM(mp_etimedout_exception);
+    }
+    if (exc != NULL) {
+        // the object is reused, so drop the traceback from its last raise
+        mp_obj_exception_clear_traceback(MP_OBJ_FROM_PTR(exc));
+        nlr_raise(MP_OBJ_FROM_PTR(exc));
+    }
+    #endif
     nlr_raise(mp_obj_new_exception_arg1(&mp_type_OSError, MP_OBJ_NEW_SMALL_INT(errno_)));
 }
 
@@ -41,6 +41,8 @@ enum {
     ID_FLAG_IS_PARAM = 0x01,
     ID_FLAG_IS_STAR_PARAM = 0x02,
     ID_FLAG_IS_DBL_STAR_PARAM = 0x04,
+    ID_FLAG_IS_MODIFIED = 0x08, // stored to or deleted in this scope
+    ID_FLAG_IS_BY_VALUE = 0x10, // a CELL/FREE that's never rebound, so closures capture its value and not a cell
 };
 
 typedef struct _id_info_t {
@@ -247,12 +247,44 @@ void mp_stream_write_adaptor(void *self, const char *buf, size_t len) {
     mp_stream_write(MP_OBJ_FROM_PTR(self), buf, len, MP_STREAM_RW_WRITE);
 }
 
-STATIC mp_obj_t stream_write_method(size_t n_args, const mp_obj_t *args) {
+// Narrow bufinfo to the optional start= and end= keyword arguments, which
+// follow slice rules. This lets a loop write or fill part of a buffer
+// without allocating a memoryview slice on every iteration.
+STATIC void stream_buffer_bounds(mp_buffer_info_t *bufinfo, mp_map_t *kw_args) {
+    if (kw_args == NULL || kw_args->used == 0) {
+        return;
+    }
+    mp_int_t len = bufinfo->len;
+    mp_int_t bounds[2] = {0, len};
+    const qstr names[2] = {MP_QSTR_start, MP_QSTR_end};
+    size_t found = 0;
+    for (size_t i = 0; i < 2; i++) {
+        mp_map_elem_t *elem = mp_map_lookup(kw_args, MP_OBJ_NEW_QSTR(names[i]), MP_MAP_LOOKUP);
+        if (elem == NULL) {
+            continue;
+        }
+        found++;
+        mp_int_t value = mp_obj_get_int(elem->value);
+        if (value < 0) {
+            value += len;
+        }
+        bounds[i] = MIN(MAX(value, 0), len);
+    }
+    if (found != kw_args->used) {
+        mp_raise_TypeError(translate("unexpected keyword argument"));
+    }
+    bufinfo->buf = (byte*)bufinfo->buf + bounds[0];
+    bufinfo->len = bounds[1] > bounds[0] ? bounds[1] - bounds[0] : 0;
+}
+
+STATIC mp_obj_t stream_write_method(size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, NULL, 2, 4, false);
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_READ);
     if (!mp_get_stream(args[0])->is_text && MP_OBJ_IS_STR(args[1])) {
         mp_raise_ValueError(translate("string not supported; use bytes or bytearray"));
     }
+    stream_buffer_bounds(&bufinfo, kw_args);
     size_t max_len = (size_t)-1;
     size_t off = 0;
     if (n_args == 3) {
@@ -267,7 +299,7 @@ STATIC mp_obj_t stream_write_method(size_t n_args, const mp_obj_t *args) {
     bufinfo.len -= off;
     return mp_stream_write(args[0], (byte*)bufinfo.buf + off, MIN(bufinfo.len, max_len), MP_STREAM_RW_WRITE);
 }
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_write_obj, 2, 4, stream_write_method);
+MP_DEFINE_CONST_FUN_OBJ_KW(mp_stream_write_obj, 2, stream_write_method);
 
 STATIC mp_obj_t stream_write1_method(mp_obj_t self_in, mp_obj_t arg) {
     mp_buffer_info_t bufinfo;
@@ -276,9 +308,11 @@ STATIC mp_obj_t stream_write1_method(mp_obj_t self_in, mp_obj_t arg) {
 }
 MP_DEFINE_CONST_FUN_OBJ_2(mp_stream_write1_obj, stream_write1_method);
 
-STATIC mp_obj_t stream_readinto(size_t n_args, const mp_obj_t *args) {
+STATIC mp_obj_t stream_readinto(size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, NULL, 2, 3, false);
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+    stream_buffer_bounds(&bufinfo, kw_args);
 
     // CPython extension: if 2nd arg is provided, that's max len to read,
     // instead of full buffer. Similar to
@@ -305,7 +339,7 @@ STATIC mp_obj_t stream_readinto(size_t n_args, const mp_obj_t *args) {
         return MP_OBJ_NEW_SMALL_INT(out_sz);
     }
 }
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_readinto_obj, 2, 3, stream_readinto);
+MP_DEFINE_CONST_FUN_OBJ_KW(mp_stream_readinto_obj, 2, stream_readinto);
 
 STATIC mp_obj_t stream_readall(mp_obj_t self_in) {
     const mp_stream_p_t *stream_p = mp_get_stream(self_in);
@@ -397,6 +431,14 @@ done:
         }
     }
 
+    #if MICROPY_STR_INTERN_CACHE
+    if (STREAM_CONTENT_TYPE(stream_p) == &mp_type_str && vstr.len <= MICROPY_STR_INTERN_CACHE_MAX_LEN) {
+        mp_obj_t line = mp_obj_new_str_cached(vstr.buf, vstr.len);
+        vstr_clear(&vstr);
+        return line;
+    }
+    #endif
+
     return mp_obj_new_str_from_vstr(STREAM_CONTENT_TYPE(stream_p), &vstr);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_unbuffered_readline_obj, 1, 2, stream_unbuffered_readline);
@@ -34,6 +34,7 @@
 #include "py/runtime.h"
 #include "py/bc0.h"
 #include "py/bc.h"
+#include "py/smallint.h"
 
 #if 0
 #define TRACE(ip) printf("sp=%d ", (int)(sp - &code_state->state[0] + 1)); mp_bytecode_print2(ip, 1, code_state->fun_bc->const_table);
@@ -96,6 +97,9 @@
 #define CLEAR_SYS_EXC_INFO()
 #endif
 
+// Entering a try, finally or with block only pushes a handler record onto exc_stack. The single
+// nlr_buf of the outer loop below catches exceptions for all of them and the handler records say
+// where to resume, so no registers are saved per block.
 #define PUSH_EXC_BLOCK(with_or_finally) do { \
     DECODE_ULABEL; /* except labels are always forward */ \
     ++exc_sp; \
@@ -110,13 +114,71 @@
     exc_sp--; /* pop back to previous exception handler */ \
     CLEAR_SYS_EXC_INFO() /* just clear sys.exc_info(), not compliant, but it shouldn't be used in 1st place */
 
+#if MICROPY_OPT_VM_FAST_PATHS
+// Handle the most common binary ops on two small ints without going through
+// mp_binary_op.  Returns MP_OBJ_NULL if the op should take the normal path.
+// Kept out of line because inlining it into mp_execute_bytecode slows down
+// unrelated opcodes, in particular function calls.
+STATIC MP_NOINLINE mp_obj_t vm_small_int_binary_op(mp_uint_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    if (!MP_OBJ_IS_SMALL_INT(lhs) || !MP_OBJ_IS_SMALL_INT(rhs)) {
+        return MP_OBJ_NULL;
+    }
+    mp_int_t lhs_val = MP_OBJ_SMALL_INT_VALUE(lhs);
+    mp_int_t rhs_val = MP_OBJ_SMALL_INT_VALUE(rhs);
+    switch (op) {
+        case MP_BINARY_OP_ADD:
+        case MP_BINARY_OP_INPLACE_ADD:
+            // can't overflow mp_int_t, but the result may not fit in a small int
+            lhs_val += rhs_val;
+            break;
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+            lhs_val -= rhs_val;
+            break;
+        case MP_BINARY_OP_LESS: return mp_obj_new_bool(lhs_val < rhs_val);
+        case MP_BINARY_OP_MORE: return mp_obj_new_bool(lhs_val > rhs_val);
+        case MP_BINARY_OP_LESS_EQUAL: return mp_obj_new_bool(lhs_val <= rhs_val);
+        case MP_BINARY_OP_MORE_EQUAL: return mp_obj_new_bool(lhs_val >= rhs_val);
+        case MP_BINARY_OP_EQUAL: return mp_obj_new_bool(lhs_val == rhs_val);
+        case MP_BINARY_OP_NOT_EQUAL: return mp_obj_new_bool(lhs_val != rhs_val);
+        default:
+            return MP_OBJ_NULL;
+    }
+    if (!MP_SMALL_INT_FITS(lhs_val)) {
+        return MP_OBJ_NULL;
+    }
+    return MP_OBJ_NEW_SMALL_INT(lhs_val);
+}
+#endif
+
+#if MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+// Map lookup hints for the name and attribute opcodes, indexed by the address of
+// the opcode.  Unlike MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE this doesn't change
+// the bytecode, so it works with .mpy files from mpy-cross and with frozen code
+// in ROM.  A hint is only used after checking the slot holds the key.
+#define SITE_CACHE_HINT(site) (MP_STATE_VM(map_lookup_site_cache)[((uintptr_t)(site)) % MICROPY_OPT_MAP_LOOKUP_SITE_CACHE_SIZE])
+
+STATIC MP_NOINLINE mp_map_elem_t *vm_site_cache_lookup(mp_map_t *map, qstr qst, const byte *site) {
+    mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
+    size_t x = SITE_CACHE_HINT(site);
+    if (x < (map->is_ordered ? map->used : map->alloc) && map->table[x].key == key) {
+        return &map->table[x];
+    }
+    mp_map_elem_t *elem = mp_map_lookup(map, key, MP_MAP_LOOKUP);
+    if (elem != NULL) {
+        SITE_CACHE_HINT(site) = (elem - &map->table[0]) & 0xff;
+    }
+    return elem;
+}
+#endif
+
 // fastn has items in reverse order (fastn[0] is local[0], fastn[-1] is local[1], etc)
 // sp points to bottom of stack which grows up
 // returns:
 //  MP_VM_RETURN_NORMAL, sp valid, return value in *sp
 //  MP_VM_RETURN_YIELD, ip, sp valid, yielded value in *sp
 //  MP_VM_RETURN_EXCEPTION, exception in fastn[0]
-mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp_obj_t inject_exc) {
+MP_RAMFUNC mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp_obj_t inject_exc) {
 #define SELECTIVE_EXC_IP (0)
 #if SELECTIVE_EXC_IP
 #define MARK_EXC_IP_SELECTIVE() { code_state->ip = ip; } /* stores ip 1 byte past last opcode */
@@ -170,11 +232,16 @@ run_code_state: ;
     volatile int gil_divisor = MICROPY_PY_THREAD_GIL_VM_DIVISOR;
     #endif
 
-    // outer exception handling loop
+    // outer exception handling loop, which pushes the nlr_buf once per call and again only after
+    // an exception is caught
     for (;;) {
         nlr_buf_t nlr;
 outer_dispatch_loop:
         if (nlr_push(&nlr) == 0) {
+            #if MICROPY_TRACK_CODE_STATE
+            // Profilers attribute allocations and samples to this code state's current line.
+            MP_STATE_THREAD(current_code_state) = code_state;
+            #endif
             // local variables that are not visible to the exception handler
             const byte *ip = code_state->ip;
             mp_obj_t *sp = code_state->sp;
@@ -270,6 +337,13 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_NAME): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    #if MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+                    mp_map_elem_t *elem = vm_site_cache_lookup(&mp_locals_get()->map, qst, ip);
+                    if (elem != NULL) {
+                        PUSH(elem->value);
+                        DISPATCH();
+                    }
+                    #endif
                     PUSH(mp_load_name(qst));
                     DISPATCH();
                 }
@@ -299,6 +373,13 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_GLOBAL): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    #if MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+                    mp_map_elem_t *elem = vm_site_cache_lookup(&mp_globals_get()->map, qst, ip);
+                    if (elem != NULL) {
+                        PUSH(elem->value);
+                        DISPATCH();
+                    }
+                    #endif
                     PUSH(mp_load_global(qst));
                     DISPATCH();
                 }
@@ -328,6 +409,30 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_ATTR): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    #if MICROPY_OPT_VM_FAST_PATHS || MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+                    // mp_obj_instance_load_attr looks in the instance members first, so do
+                    // that here and skip the generic attribute machinery when it hits.
+                    mp_obj_t top = TOP();
+                    if (mp_obj_is_instance_type(mp_obj_get_type(top))) {
+                        mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
+                        #if MICROPY_PY_SLOTS
+                        mp_obj_t *slot = mp_obj_instance_get_slot(self, qst);
+                        if (slot != NULL && *slot != MP_OBJ_NULL) {
+                            SET_TOP(*slot);
+                            DISPATCH();
+                        }
+                        #endif
+                        #if MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+                        mp_map_elem_t *elem = vm_site_cache_lookup(&self->members, qst, ip);
+                        #else
+                        mp_map_elem_t *elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
+                        #endif
+                        if (elem != NULL) {
+                            SET_TOP(elem->value);
+                            DISPATCH();
+                        }
+                    }
+                    #endif
                     SET_TOP(mp_load_attr(TOP(), qst));
                     DISPATCH();
                 }
@@ -365,6 +470,39 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    #if MICROPY_OPT_MAP_LOOKUP_SITE_CACHE
+                    // A plain function defined in the instance's own class, and not shadowed
+                    // by an instance member, binds to self exactly as mp_load_method would.
+                    mp_obj_type_t *type = mp_obj_get_type(*sp);
+                    if (mp_obj_is_instance_type(type) && type->locals_dict != NULL) {
+                        mp_obj_instance_t *self = MP_OBJ_TO_PTR(*sp);
+                        if (mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP) == NULL) {
+                            mp_map_elem_t *elem = vm_site_cache_lookup(&type->locals_dict->map, qst, ip);
+                            if (elem != NULL && MP_OBJ_IS_TYPE(elem->value, &mp_type_fun_bc)) {
+                                sp[1] = sp[0];
+                                sp[0] = elem->value;
+                                sp += 1;
+                                DISPATCH();
+                            }
+                        }
+                    } else if (type->attr == NULL && type->locals_dict != NULL
+                        #if MICROPY_CPYTHON_COMPAT
+                        && qst != MP_QSTR___class__
+                        #endif
+                        && qst != MP_QSTR___next__) {
+                        // Native types without their own attr handler, such as most of
+                        // shared-bindings; this is the lookup mp_load_method_maybe does.
+                        mp_map_elem_t *elem = vm_site_cache_lookup(&type->locals_dict->map, qst, ip);
+                        if (elem != NULL) {
+                            mp_obj_t obj = sp[0];
+                            sp[0] = MP_OBJ_NULL;
+                            sp[1] = MP_OBJ_NULL;
+                            mp_convert_member_lookup(obj, type, elem->value, sp);
+                            sp += 1;
+                            DISPATCH();
+                        }
+                    }
+                    #endif
                     mp_load_method(*sp, qst, sp);
                     sp += 1;
                     DISPATCH();
@@ -420,6 +558,19 @@ dispatch_loop:
                 ENTRY(MP_BC_STORE_ATTR): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    #if MICROPY_OPT_MAP_LOOKUP_SITE_CACHE && !MICROPY_PY_DELATTR_SETATTR
+                    // An attr already in self->members can't be a property or descriptor, see
+                    // the MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE version below.
+                    if (mp_obj_is_instance_type(mp_obj_get_type(sp[0])) && sp[-1] != MP_OBJ_NULL) {
+                        mp_obj_instance_t *self = MP_OBJ_TO_PTR(sp[0]);
+                        mp_map_elem_t *elem = vm_site_cache_lookup(&self->members, qst, ip);
+                        if (elem != NULL) {
+                            elem->value = sp[-1];
+                            sp -= 2;
+                            DISPATCH();
+                        }
+                    }
+                    #endif
                     mp_store_attr(sp[0], qst, sp[-1]);
                     sp -= 2;
                     DISPATCH();
@@ -1253,6 +1404,13 @@ yield:
                     MARK_EXC_IP_SELECTIVE();
                     mp_obj_t rhs = POP();
                     mp_obj_t lhs = TOP();
+                    #if MICROPY_OPT_VM_FAST_PATHS
+                    mp_obj_t res = vm_small_int_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs);
+                    if (res != MP_OBJ_NULL) {
+                        SET_TOP(res);
+                        DISPATCH();
+                    }
+                    #endif
                     SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
                     DISPATCH();
                 }
@@ -1276,6 +1434,13 @@ yield:
                     } else if (ip[-1] < MP_BC_BINARY_OP_MULTI + MP_BINARY_OP_NUM_BYTECODE) {
                         mp_obj_t rhs = POP();
                         mp_obj_t lhs = TOP();
+                        #if MICROPY_OPT_VM_FAST_PATHS
+                        mp_obj_t res = vm_small_int_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs);
+                        if (res != MP_OBJ_NULL) {
+                            SET_TOP(res);
+                            DISPATCH();
+                        }
+                        #endif
                         SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
                         DISPATCH();
                     } else
@@ -1380,52 +1545,9 @@ unwind_loop:
             // set file and line number that the exception occurred at
             // TODO: don't set traceback for exceptions re-raised by END_FINALLY.
             // But consider how to handle nested exceptions.
+            // (the line number is only decoded if the traceback is read)
             if (nlr.ret_val != &mp_const_GeneratorExit_obj) {
-                const byte *ip = code_state->fun_bc->bytecode;
-                ip = mp_decode_uint_skip(ip); // skip n_state
-                ip = mp_decode_uint_skip(ip); // skip n_exc_stack
-                ip++; // skip scope_params
-                ip++; // skip n_pos_args
-                ip++; // skip n_kwonly_args
-                ip++; // skip n_def_pos_args
-                size_t bc = code_state->ip - ip;
-                size_t code_info_size = mp_decode_uint_value(ip);
-                ip = mp_decode_uint_skip(ip); // skip code_info_size
-                bc -= code_info_size;
-                #if MICROPY_PERSISTENT_CODE
-                qstr block_name = ip[0] | (ip[1] << 8);
-                qstr source_file = ip[2] | (ip[3] << 8);
-                ip += 4;
-                #else
-                qstr block_name = mp_decode_uint_value(ip);
-                ip = mp_decode_uint_skip(ip);
-                qstr source_file = mp_decode_uint_value(ip);
-                ip = mp_decode_uint_skip(ip);
-                #endif
-                size_t source_line = 1;
-                size_t c;
-                while ((c = *ip)) {
-                    size_t b, l;
-                    if ((c & 0x80) == 0) {
-                        // 0b0LLBBBBB encoding
-                        b = c & 0x1f;
-                        l = c >> 5;
-                        ip += 1;
-                    } else {
-                        // 0b1LLLBBBB 0bLLLLLLLL encoding (l's LSB in second byte)
-                        b = c & 0xf;
-                        l = ((c << 4) & 0x700) | ip[1];
-                        ip += 2;
-                    }
-                    if (bc >= b) {
-                        bc -= b;
-                        source_line += l;
-                    } else {
-                        // found source line corresponding to bytecode offset
-                        break;
-                    }
-                }
-                mp_obj_exception_add_traceback(MP_OBJ_FROM_PTR(nlr.ret_val), source_file, source_line, block_name);
+                mp_obj_exception_add_traceback_bc(MP_OBJ_FROM_PTR(nlr.ret_val), code_state->fun_bc->bytecode, code_state->ip);
             }
 
             while (currently_in_except_block) {
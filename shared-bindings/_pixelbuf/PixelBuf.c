@@ -35,6 +35,7 @@
 
 #include <string.h>
 
+#include "lib/utils/buffer_helper.h"
 #include "PixelBuf.h"
 #include "shared-bindings/_pixelbuf/types.h"
 #include "../../shared-module/_pixelbuf/PixelBuf.h"
@@ -51,7 +52,7 @@ extern const int32_t colorwheel(float pos);
 //|
 //| :class:`~_pixelbuf.PixelBuf` implements an RGB[W] bytearray abstraction.
 //|
-//| .. class:: PixelBuf(size, buf, byteorder=BGR, bpp=3)
+//| .. class:: PixelBuf(size, buf, byteorder=BGR, brightness=1.0, rawbuf=None, offset=0, dotstar=False, auto_write=False, write_function=None, write_args=None, gamma=1.0)
 //|
 //|   Create a PixelBuf object of the specified size, byteorder, and bits per pixel.
 //|
@@ -75,11 +76,12 @@ extern const int32_t colorwheel(float pos);
 //|   :param ~callable write_function: (optional) Callable to use to send pixels
 //|   :param ~list write_args: (optional) Tuple or list of args to pass to ``write_function``.  The 
 //|          PixelBuf instance is appended after these args.
+//|   :param ~float gamma: Gamma correction exponent applied along with ``brightness`` (default 1.0)
 //|
 STATIC mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     mp_arg_check_num(n_args, kw_args, 2, MP_OBJ_FUN_ARGS_MAX, true);
     enum { ARG_size, ARG_buf, ARG_byteorder, ARG_brightness, ARG_rawbuf, ARG_offset, ARG_dotstar,
-           ARG_auto_write, ARG_write_function, ARG_write_args };
+           ARG_auto_write, ARG_write_function, ARG_write_args, ARG_gamma };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_size, MP_ARG_REQUIRED | MP_ARG_INT },
         { MP_QSTR_buf, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -91,6 +93,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_a
         { MP_QSTR_auto_write, MP_ARG_BOOL, {.u_bool = false} },
         { MP_QSTR_write_function, MP_ARG_OBJ, {.u_obj = mp_const_none} },
         { MP_QSTR_write_args, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_gamma, MP_ARG_OBJ, {.u_obj = mp_const_none} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -127,6 +130,13 @@ STATIC mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_a
         mp_raise_ValueError(translate("write_args must be a list, tuple, or None"));
     }
 
+    mp_float_t gamma = MICROPY_FLOAT_CONST(1.0);
+    if (args[ARG_gamma].u_obj != mp_const_none) {
+        gamma = mp_obj_get_float(args[ARG_gamma].u_obj);
+        if (gamma <= 0)
+            mp_raise_ValueError(translate("gamma must be positive"));
+    }
+
     // Validation complete, allocate and populate object.
     pixelbuf_pixelbuf_obj_t *self = m_new_obj(pixelbuf_pixelbuf_obj_t);
 
@@ -186,6 +196,9 @@ STATIC mp_obj_t pixelbuf_pixelbuf_make_new(const mp_obj_type_t *type, size_t n_a
         else if (self->brightness > 1)
             self->brightness = 1;
     }
+    self->gamma = gamma;
+    self->lut = NULL;
+    pixelbuf_update_lut(self);
     
     if (self->dotstar_mode) { 
         // Initialize the buffer with the dotstar start bytes.
@@ -240,11 +253,12 @@ MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_get_brightness_obj, pixelbuf_pixelbu
 STATIC mp_obj_t pixelbuf_pixelbuf_obj_set_brightness(mp_obj_t self_in, mp_obj_t value) {
     mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
     pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
-    self->brightness = mp_obj_float_get(value);
+    self->brightness = mp_obj_get_float(value);
     if (self->brightness > 1)
         self->brightness = 1;
     else if (self->brightness < 0)
         self->brightness = 0;
+    pixelbuf_update_lut(self);
     if (self->two_buffers)
         pixelbuf_recalculate_brightness(self);
     if (self->auto_write)
@@ -260,16 +274,42 @@ const mp_obj_property_t pixelbuf_pixelbuf_brightness_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
-void pixelbuf_recalculate_brightness(pixelbuf_pixelbuf_obj_t *self) {
-    uint8_t *buf = (uint8_t *)self->buf;
-    uint8_t *rawbuf = (uint8_t *)self->rawbuf;
-    // Compensate for shifted buffer (bpp=3 dotstar)
-    for (uint i = 0; i < self->bytes; i++) {
-        // Don't adjust per-pixel luminance bytes in dotstar mode
-        if (!self->dotstar_mode || (i % 4 != 0)) 
-            buf[i] = rawbuf[i] * self->brightness;
-    }
+//|   .. attribute:: gamma
+//|
+//|     Gamma correction exponent (greater than 0, default 1.0).  Colors are
+//|     scaled by ``(value / 255) ** gamma`` before brightness is applied.
+//|     Like brightness, changing it recomputes buf only when a rawbuf was provided.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_obj_get_gamma(mp_obj_t self_in) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_float(self->gamma);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pixelbuf_pixelbuf_get_gamma_obj, pixelbuf_pixelbuf_obj_get_gamma);
+
+
+STATIC mp_obj_t pixelbuf_pixelbuf_obj_set_gamma(mp_obj_t self_in, mp_obj_t value) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_float_t gamma = mp_obj_get_float(value);
+    if (gamma <= 0)
+        mp_raise_ValueError(translate("gamma must be positive"));
+    self->gamma = gamma;
+    pixelbuf_update_lut(self);
+    if (self->two_buffers)
+        pixelbuf_recalculate_brightness(self);
+    if (self->auto_write)
+        call_write_function(self);
+    return mp_const_none;
 }
+MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_set_gamma_obj, pixelbuf_pixelbuf_obj_set_gamma);
+
+const mp_obj_property_t pixelbuf_pixelbuf_gamma_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&pixelbuf_pixelbuf_get_gamma_obj,
+              (mp_obj_t)&pixelbuf_pixelbuf_set_gamma_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
 
 //|   .. attribute:: auto_write
 //|
@@ -367,6 +407,98 @@ void call_write_function(pixelbuf_pixelbuf_obj_t *self) {
     }
 }
 
+//|   .. method:: fill(color, *, start=0, end=None)
+//|
+//|     Set pixels ``start`` up to ``end`` (default all of them) to ``color``.
+//|     The color is converted once and then copied, so this is much faster
+//|     than assigning each pixel from Python.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_fill(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_color, ARG_start, ARG_end };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_color, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_start, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+    };
+    mp_check_self(MP_OBJ_IS_TYPE(pos_args[0], &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int32_t start = args[ARG_start].u_int;
+    uint32_t length = self->pixels;
+    normalize_buffer_bounds(&start, args[ARG_end].u_int, &length);
+    if (start < 0)
+        mp_raise_IndexError(translate("Range out of bounds"));
+    pixelbuf_fill(self, start, start + length, args[ARG_color].u_obj);
+    if (self->auto_write)
+        call_write_function(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(pixelbuf_pixelbuf_fill_obj, 2, pixelbuf_pixelbuf_fill);
+
+//|   .. method:: rotate(n)
+//|
+//|     Move every pixel ``n`` places towards the end of the strip, wrapping
+//|     the pixels that fall off the end around to the start.  Negative ``n``
+//|     rotates the other way.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_rotate(mp_obj_t self_in, mp_obj_t n) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    pixelbuf_rotate(self, mp_obj_get_int(n), false);
+    if (self->auto_write)
+        call_write_function(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_rotate_obj, pixelbuf_pixelbuf_rotate);
+
+//|   .. method:: shift(n)
+//|
+//|     Like `rotate` but the pixels that fall off the end are dropped and the
+//|     vacated pixels are turned off.
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_shift(mp_obj_t self_in, mp_obj_t n) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    pixelbuf_rotate(self, mp_obj_get_int(n), true);
+    if (self->auto_write)
+        call_write_function(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pixelbuf_pixelbuf_shift_obj, pixelbuf_pixelbuf_shift);
+
+//|   .. method:: blend(a, b, factor)
+//|
+//|     Set the pixels to a crossfade between the PixelBufs ``a`` and ``b``.
+//|     ``factor`` is between 0 (all ``a``) and 1.0 (all ``b``).  ``a`` and
+//|     ``b`` must be the same size and layout as this PixelBuf, and may be
+//|     this PixelBuf itself.  Their raw colors are blended and then this
+//|     PixelBuf's brightness and gamma are applied (when it has a rawbuf).
+//|
+STATIC mp_obj_t pixelbuf_pixelbuf_blend(size_t n_args, const mp_obj_t *args) {
+    mp_check_self(MP_OBJ_IS_TYPE(args[0], &pixelbuf_pixelbuf_type));
+    pixelbuf_pixelbuf_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    if (!MP_OBJ_IS_TYPE(args[1], &pixelbuf_pixelbuf_type) || !MP_OBJ_IS_TYPE(args[2], &pixelbuf_pixelbuf_type))
+        mp_raise_TypeError(translate("blend sources must be PixelBufs"));
+    pixelbuf_pixelbuf_obj_t *a = MP_OBJ_TO_PTR(args[1]);
+    pixelbuf_pixelbuf_obj_t *b = MP_OBJ_TO_PTR(args[2]);
+    if (a->bytes != self->bytes || b->bytes != self->bytes ||
+        a->dotstar_mode != self->dotstar_mode || b->dotstar_mode != self->dotstar_mode)
+        mp_raise_ValueError(translate("blend sources must match this PixelBuf"));
+
+    mp_float_t factor = mp_obj_get_float(args[3]);
+    if (factor < 0)
+        factor = 0;
+    else if (factor > 1)
+        factor = 1;
+    pixelbuf_blend(self, a, b, (uint16_t)(factor * 256 + MICROPY_FLOAT_CONST(0.5)));
+    if (self->auto_write)
+        call_write_function(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pixelbuf_pixelbuf_blend_obj, 4, 4, pixelbuf_pixelbuf_blend);
+
 
 
 //|   .. method:: []
@@ -424,7 +556,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp
                 if (MP_OBJ_IS_TYPE(value, &mp_type_list) || MP_OBJ_IS_TYPE(value, &mp_type_tuple) || MP_OBJ_IS_INT(value)) {
                     pixelbuf_set_pixel(self->buf + (i * self->pixel_step), 
                         self->two_buffers ? self->rawbuf + (i * self->pixel_step) : NULL, 
-                        self->brightness, item, &self->byteorder, self->dotstar_mode);
+                        self->lut, item, &self->byteorder, self->dotstar_mode);
                 }
             }
             if (self->auto_write)
@@ -446,7 +578,7 @@ STATIC mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp
             return pixelbuf_get_pixel(pixelstart, &self->byteorder, self->dotstar_mode);
         } else { // Store
             pixelbuf_set_pixel(self->buf + offset, self->two_buffers ? self->rawbuf + offset : NULL, 
-                self->brightness, value, &self->byteorder, self->dotstar_mode);
+                self->lut, value, &self->byteorder, self->dotstar_mode);
             if (self->auto_write)
                 call_write_function(self);
             return mp_const_none;
@@ -456,10 +588,15 @@ STATIC mp_obj_t pixelbuf_pixelbuf_subscr(mp_obj_t self_in, mp_obj_t index_in, mp
 
 STATIC const mp_rom_map_elem_t pixelbuf_pixelbuf_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_auto_write), MP_ROM_PTR(&pixelbuf_pixelbuf_auto_write_obj)},
+    { MP_ROM_QSTR(MP_QSTR_blend), MP_ROM_PTR(&pixelbuf_pixelbuf_blend_obj)},
     { MP_ROM_QSTR(MP_QSTR_bpp), MP_ROM_PTR(&pixelbuf_pixelbuf_bpp_obj)},
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&pixelbuf_pixelbuf_brightness_obj)},
     { MP_ROM_QSTR(MP_QSTR_buf), MP_ROM_PTR(&pixelbuf_pixelbuf_buf_obj)},
     { MP_ROM_QSTR(MP_QSTR_byteorder), MP_ROM_PTR(&pixelbuf_pixelbuf_byteorder_obj)},
+    { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&pixelbuf_pixelbuf_fill_obj)},
+    { MP_ROM_QSTR(MP_QSTR_gamma), MP_ROM_PTR(&pixelbuf_pixelbuf_gamma_obj)},
+    { MP_ROM_QSTR(MP_QSTR_rotate), MP_ROM_PTR(&pixelbuf_pixelbuf_rotate_obj)},
+    { MP_ROM_QSTR(MP_QSTR_shift), MP_ROM_PTR(&pixelbuf_pixelbuf_shift_obj)},
     { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&pixelbuf_pixelbuf_show_obj)},
 };
 
@@ -35,6 +35,7 @@
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/analogio/AnalogIn.h"
 #include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
 
 //| .. currentmodule:: analogio
 //|
@@ -49,6 +50,19 @@
 //|    adc = analogio.AnalogIn(A1)
 //|    val = adc.value
 //|
+//| Sampling at a fixed rate in the background::
+//|
+//|    import array
+//|    import analogio
+//|    from board import *
+//|
+//|    samples = array.array("H", [0] * 1000)
+//|    with analogio.AnalogIn(A1) as adc:
+//|        adc.start(20000)
+//|        count = 0
+//|        while count < len(samples):
+//|            count += adc.readinto(memoryview(samples)[count:])
+//|
 
 //| .. class:: AnalogIn(pin)
 //|
@@ -125,6 +139,125 @@ const mp_obj_property_t analogio_analogin_value_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. method:: start(sample_rate, *, buffer_length=4096)
+//|
+//|     Starts sampling continuously in the background at ``sample_rate`` samples per second,
+//|     paced by a hardware timer. Up to ``buffer_length`` samples are kept until they are read
+//|     with `readinto`. Samples taken while the buffer is full are lost and counted in
+//|     `overruns`. While sampling, `value` is the most recently buffered sample. Only one pin per
+//|     ADC can be sampled at a time.
+//|
+STATIC mp_obj_t analogio_analogin_obj_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_sample_rate, ARG_buffer_length };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample_rate, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_buffer_length, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 4096} },
+    };
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_analogio_analogin_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (args[ARG_sample_rate].u_int <= 0) {
+        mp_raise_ValueError(translate("Sample rate must be positive"));
+    }
+    if (args[ARG_buffer_length].u_int < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_buffer_length);
+    }
+    common_hal_analogio_analogin_start(self, args[ARG_sample_rate].u_int, args[ARG_buffer_length].u_int);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(analogio_analogin_start_obj, 1, analogio_analogin_obj_start);
+
+//|   .. method:: stop()
+//|
+//|     Stops sampling started by `start`. Samples that haven't been read are discarded.
+//|
+STATIC mp_obj_t analogio_analogin_obj_stop(mp_obj_t self_in) {
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_analogio_analogin_deinited(self));
+    common_hal_analogio_analogin_stop(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogin_stop_obj, analogio_analogin_obj_stop);
+
+//|   .. method:: readinto(destination)
+//|
+//|     Moves samples taken since `start` into destination, an array of type ``'H'``, without
+//|     waiting for more. Samples are 16-bit like `value`.
+//|
+//|     :return: The number of samples read, which is 0 when none are waiting.
+//|
+STATIC mp_obj_t analogio_analogin_obj_readinto(mp_obj_t self_in, mp_obj_t destination) {
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_analogio_analogin_deinited(self));
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(destination, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.typecode != 'H') {
+        mp_raise_ValueError(translate("destination buffer must be an array of type 'H'"));
+    }
+    uint32_t length = bufinfo.len / sizeof(uint16_t);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_analogio_analogin_readinto(self, bufinfo.buf, length));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(analogio_analogin_readinto_obj, analogio_analogin_obj_readinto);
+
+//|   .. attribute:: sampling
+//|
+//|     True while sampling in the background after `start`. (read-only)
+//|
+STATIC mp_obj_t analogio_analogin_obj_get_sampling(mp_obj_t self_in) {
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_analogio_analogin_deinited(self));
+    return mp_obj_new_bool(common_hal_analogio_analogin_get_sampling(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogin_get_sampling_obj, analogio_analogin_obj_get_sampling);
+
+const mp_obj_property_t analogio_analogin_sampling_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&analogio_analogin_get_sampling_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     The actual rate of the background sampling in samples per second. This may differ a
+//|     little from the rate given to `start` due to the timer's resolution. (read-only)
+//|
+STATIC mp_obj_t analogio_analogin_obj_get_sample_rate(mp_obj_t self_in) {
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_analogio_analogin_deinited(self));
+    return mp_obj_new_int_from_uint(common_hal_analogio_analogin_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogin_get_sample_rate_obj, analogio_analogin_obj_get_sample_rate);
+
+const mp_obj_property_t analogio_analogin_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&analogio_analogin_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: overruns
+//|
+//|     The number of times samples were lost since `start` because they weren't read or
+//|     copied out of the DMA buffers in time. (read-only)
+//|
+STATIC mp_obj_t analogio_analogin_obj_get_overruns(mp_obj_t self_in) {
+    analogio_analogin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_analogio_analogin_deinited(self));
+    return mp_obj_new_int_from_uint(common_hal_analogio_analogin_get_overruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogin_get_overruns_obj, analogio_analogin_obj_get_overruns);
+
+const mp_obj_property_t analogio_analogin_overruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&analogio_analogin_get_overruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|   .. attribute:: reference_voltage
 //|
 //|     The maximum voltage measurable (also known as the reference voltage) as a
@@ -145,12 +278,27 @@ const mp_obj_property_t analogio_analogin_reference_voltage_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+// Read value directly, rather than through the locals dict and property.
+STATIC void analogio_analogin_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    if (attr == MP_QSTR_value && dest[0] == MP_OBJ_NULL) {
+        dest[0] = analogio_analogin_obj_get_value(self_in);
+        return;
+    }
+    dest[1] = MP_OBJ_SENTINEL;
+}
+
 STATIC const mp_rom_map_elem_t analogio_analogin_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit),             MP_ROM_PTR(&analogio_analogin_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__),          MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__),           MP_ROM_PTR(&analogio_analogin___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_start),              MP_ROM_PTR(&analogio_analogin_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop),               MP_ROM_PTR(&analogio_analogin_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto),           MP_ROM_PTR(&analogio_analogin_readinto_obj) },
     { MP_ROM_QSTR(MP_QSTR_value),              MP_ROM_PTR(&analogio_analogin_value_obj)},
     { MP_ROM_QSTR(MP_QSTR_reference_voltage),  MP_ROM_PTR(&analogio_analogin_reference_voltage_obj)},
+    { MP_ROM_QSTR(MP_QSTR_sampling),           MP_ROM_PTR(&analogio_analogin_sampling_obj)},
+    { MP_ROM_QSTR(MP_QSTR_sample_rate),        MP_ROM_PTR(&analogio_analogin_sample_rate_obj)},
+    { MP_ROM_QSTR(MP_QSTR_overruns),           MP_ROM_PTR(&analogio_analogin_overruns_obj)},
 };
 
 STATIC MP_DEFINE_CONST_DICT(analogio_analogin_locals_dict, analogio_analogin_locals_dict_table);
@@ -159,5 +307,6 @@ const mp_obj_type_t analogio_analogin_type = {
     { &mp_type_type },
     .name = MP_QSTR_AnalogIn,
     .make_new = analogio_analogin_make_new,
+    .attr = analogio_analogin_attr,
     .locals_dict = (mp_obj_t)&analogio_analogin_locals_dict,
 };
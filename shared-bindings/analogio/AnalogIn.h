@@ -37,5 +37,11 @@ void common_hal_analogio_analogin_deinit(analogio_analogin_obj_t* self);
 bool common_hal_analogio_analogin_deinited(analogio_analogin_obj_t* self);
 uint16_t common_hal_analogio_analogin_get_value(analogio_analogin_obj_t* self);
 float common_hal_analogio_analogin_get_reference_voltage(analogio_analogin_obj_t* self);
+void common_hal_analogio_analogin_start(analogio_analogin_obj_t* self, uint32_t sample_rate, uint32_t buffer_length);
+void common_hal_analogio_analogin_stop(analogio_analogin_obj_t* self);
+bool common_hal_analogio_analogin_get_sampling(analogio_analogin_obj_t* self);
+uint32_t common_hal_analogio_analogin_get_sample_rate(analogio_analogin_obj_t* self);
+uint32_t common_hal_analogio_analogin_get_overruns(analogio_analogin_obj_t* self);
+uint32_t common_hal_analogio_analogin_readinto(analogio_analogin_obj_t* self, uint16_t* output_buffer, uint32_t output_buffer_length);
 
 #endif  // __MICROPY_INCLUDED_SHARED_BINDINGS_ANALOGIO_ANALOGIN_H__
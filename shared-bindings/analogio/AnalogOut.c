@@ -28,6 +28,7 @@
 #include <string.h>
 
 #include "lib/utils/context_manager_helpers.h"
+#include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
 
@@ -129,14 +130,100 @@ const mp_obj_property_t analogio_analogout_value_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. method:: play(buffer, *, sample_rate, loop=False)
+//|
+//|     Write the values in ``buffer`` to the pin one after another, ``sample_rate`` times a
+//|     second, in the background. ``buffer`` is a ``bytearray`` or an ``array.array`` of type
+//|     ``'B'`` or ``'H'``. Values are scaled like `value`, with bytes being the top 8 bits. The
+//|     output holds the last value once a buffer that doesn't loop has played.
+//|
+//|     Playing again while a looping buffer plays at the same ``sample_rate`` replaces it once
+//|     the pass after the current one finishes, without a gap. If a replacement is already
+//|     waiting, this blocks until it starts. Otherwise the current buffer stops straight away.
+//|     ``buffer`` must not be changed in size while it plays. Setting `value` stops playback.
+//|
+//|     Does not block otherwise. Use `playing` to wait for it to finish.
+//|
+//|     :param ~array.array buffer: the values to output
+//|     :param int sample_rate: values output per second
+//|     :param bool loop: repeat the buffer until stopped or replaced
+//|
+STATIC mp_obj_t analogio_analogout_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_sample_rate, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer,      MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED },
+        { MP_QSTR_loop,        MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+    };
+    analogio_analogout_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_analogio_analogout_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
+    uint8_t bytes_per_sample = 1;
+    if (bufinfo.typecode == 'H') {
+        bytes_per_sample = 2;
+    } else if (bufinfo.typecode != 'B' && bufinfo.typecode != BYTEARRAY_TYPECODE) {
+        mp_raise_ValueError(translate("buffer must be a bytearray or array of type 'H' or 'B'"));
+    }
+    uint32_t sample_count = bufinfo.len / bytes_per_sample;
+    if (sample_count == 0) {
+        mp_raise_ValueError(translate("Buffer must be at least length 1"));
+    }
+    mp_int_t sample_rate = args[ARG_sample_rate].u_int;
+    if (sample_rate <= 0) {
+        mp_raise_ValueError(translate("Sample rate must be positive"));
+    }
+
+    common_hal_analogio_analogout_play(self, args[ARG_buffer].u_obj, bufinfo.buf, sample_count,
+                                       bytes_per_sample, sample_rate, args[ARG_loop].u_bool);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(analogio_analogout_play_obj, 1, analogio_analogout_obj_play);
+
+//|   .. method:: stop()
+//|
+//|     Stops playback. The output holds the value it had.
+//|
+STATIC mp_obj_t analogio_analogout_obj_stop(mp_obj_t self_in) {
+    analogio_analogout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_analogio_analogout_deinited(self));
+    common_hal_analogio_analogout_stop(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogout_stop_obj, analogio_analogout_obj_stop);
+
+//|   .. attribute:: playing
+//|
+//|     True when a buffer is being played. (read-only)
+//|
+STATIC mp_obj_t analogio_analogout_obj_get_playing(mp_obj_t self_in) {
+    analogio_analogout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_analogio_analogout_deinited(self));
+    return mp_obj_new_bool(common_hal_analogio_analogout_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogio_analogout_get_playing_obj, analogio_analogout_obj_get_playing);
+
+const mp_obj_property_t analogio_analogout_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&analogio_analogout_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t analogio_analogout_locals_dict_table[] = {
     // instance methods
     { MP_OBJ_NEW_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&analogio_analogout_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__),  MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__),   MP_ROM_PTR(&analogio_analogout___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_play),       MP_ROM_PTR(&analogio_analogout_play_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop),       MP_ROM_PTR(&analogio_analogout_stop_obj) },
 
     // Properties
     { MP_OBJ_NEW_QSTR(MP_QSTR_value), (mp_obj_t)&analogio_analogout_value_obj },
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&analogio_analogout_playing_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(analogio_analogout_locals_dict, analogio_analogout_locals_dict_table);
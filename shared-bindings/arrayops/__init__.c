@@ -0,0 +1,353 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/binary.h"
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "shared-bindings/arrayops/__init__.h"
+#include "supervisor/shared/translate.h"
+
+//| :mod:`arrayops` --- Whole-array arithmetic
+//| ===========================================
+//|
+//| .. module:: arrayops
+//|   :synopsis: Whole-array arithmetic
+//|   :platform: SAMD, nRF
+//|
+//| The `arrayops` module does arithmetic on every element of an `array.array`, `bytearray`
+//| or `memoryview` at once, so sensor and audio buffers can be processed without a Python
+//| loop over the elements. Functions that change an array do so in place. `fir`, `fft` and
+//| `magnitude` cover filtering and spectrum analysis.
+//|
+//| Arrays may hold any of the typecodes ``b``, ``B``, ``h``, ``H``, ``i``, ``I``, ``l``, ``L``
+//| (32-bit only), ``f`` and ``d``. Integer results are clipped to the range of the typecode
+//| instead of wrapping around. Floats written to integer arrays are rounded to the nearest
+//| integer.
+//|
+
+// Fills in a from an array-like object, raising if the typecode isn't supported.
+STATIC void arrayops_get_array(mp_obj_t obj, arrayops_array_t *a, mp_uint_t flags) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(obj, &bufinfo, flags);
+    size_t size = 1;
+    switch (bufinfo.typecode) {
+        case 'b':
+            a->kind = ARRAYOPS_INT8;
+            break;
+        case BYTEARRAY_TYPECODE:
+        case 'B':
+            a->kind = ARRAYOPS_UINT8;
+            break;
+        case 'h':
+            a->kind = ARRAYOPS_INT16;
+            size = 2;
+            break;
+        case 'H':
+            a->kind = ARRAYOPS_UINT16;
+            size = 2;
+            break;
+        case 'i':
+        case 'l':
+            a->kind = ARRAYOPS_INT32;
+            size = 4;
+            break;
+        case 'I':
+        case 'L':
+            a->kind = ARRAYOPS_UINT32;
+            size = 4;
+            break;
+        case 'f':
+            a->kind = ARRAYOPS_FLOAT;
+            size = 4;
+            break;
+        case 'd':
+            a->kind = ARRAYOPS_DOUBLE;
+            size = 8;
+            break;
+        default:
+            mp_raise_ValueError(translate("bad typecode"));
+    }
+    if (mp_binary_get_size('@', bufinfo.typecode, NULL) != size) {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    a->buf = bufinfo.buf;
+    a->len = bufinfo.len / size;
+}
+
+STATIC void arrayops_get_value(mp_obj_t obj, arrayops_value_t *v) {
+    v->is_float = mp_obj_is_float(obj);
+    if (v->is_float) {
+        v->f = mp_obj_get_float(obj);
+    } else {
+        v->i = mp_obj_get_int(obj);
+    }
+}
+
+STATIC mp_obj_t arrayops_new_value(const arrayops_value_t *v) {
+    if (v->is_float) {
+        return mp_obj_new_float(v->f);
+    }
+    return mp_obj_new_int_from_ll(v->i);
+}
+
+STATIC void arrayops_check_same_length(const arrayops_array_t *a, const arrayops_array_t *b) {
+    if (a->len != b->len) {
+        mp_raise_ValueError(translate("arrays must have the same length"));
+    }
+}
+
+// Shared by add() and mul(): the second operand is either a number or an array.
+STATIC mp_obj_t arrayops_binary(mp_obj_t a_in, mp_obj_t b_in, bool mul) {
+    arrayops_array_t a;
+    arrayops_get_array(a_in, &a, MP_BUFFER_WRITE);
+    if (mp_obj_is_float(b_in) || mp_obj_is_integer(b_in)) {
+        arrayops_value_t v;
+        arrayops_get_value(b_in, &v);
+        if (mul) {
+            shared_modules_arrayops_mul(&a, NULL, &v);
+        } else {
+            shared_modules_arrayops_add(&a, NULL, &v);
+        }
+    } else {
+        arrayops_array_t b;
+        arrayops_get_array(b_in, &b, MP_BUFFER_READ);
+        arrayops_check_same_length(&a, &b);
+        if (mul) {
+            shared_modules_arrayops_mul(&a, &b, NULL);
+        } else {
+            shared_modules_arrayops_add(&a, &b, NULL);
+        }
+    }
+    return mp_const_none;
+}
+
+//| .. function:: add(a, b)
+//|
+//|   Add ``b`` to every element of ``a``, in place. ``b`` is a number or an array the same
+//|   length as ``a``.
+//|
+STATIC mp_obj_t arrayops_add(mp_obj_t a_in, mp_obj_t b_in) {
+    return arrayops_binary(a_in, b_in, false);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(arrayops_add_obj, arrayops_add);
+
+//| .. function:: mul(a, b)
+//|
+//|   Multiply every element of ``a`` by ``b``, in place. ``b`` is a number or an array the
+//|   same length as ``a``. For example, ``arrayops.mul(samples, 0.5)`` halves the volume of
+//|   16-bit audio.
+//|
+STATIC mp_obj_t arrayops_mul(mp_obj_t a_in, mp_obj_t b_in) {
+    return arrayops_binary(a_in, b_in, true);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(arrayops_mul_obj, arrayops_mul);
+
+//| .. function:: clip(a, low, high)
+//|
+//|   Limit every element of ``a`` to between ``low`` and ``high``, in place.
+//|
+STATIC mp_obj_t arrayops_clip(mp_obj_t a_in, mp_obj_t low_in, mp_obj_t high_in) {
+    arrayops_array_t a;
+    arrayops_get_array(a_in, &a, MP_BUFFER_WRITE);
+    arrayops_value_t low;
+    arrayops_value_t high;
+    arrayops_get_value(low_in, &low);
+    arrayops_get_value(high_in, &high);
+    shared_modules_arrayops_clip(&a, &low, &high);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(arrayops_clip_obj, arrayops_clip);
+
+//| .. function:: sum(a)
+//|
+//|   Return the sum of the elements of ``a``: an int for integer arrays, a float for float
+//|   arrays. Integer sums don't clip.
+//|
+STATIC mp_obj_t arrayops_sum(mp_obj_t a_in) {
+    arrayops_array_t a;
+    arrayops_get_array(a_in, &a, MP_BUFFER_READ);
+    arrayops_value_t result;
+    shared_modules_arrayops_sum(&a, &result);
+    return arrayops_new_value(&result);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(arrayops_sum_obj, arrayops_sum);
+
+STATIC mp_obj_t arrayops_minmax(mp_obj_t a_in, bool want_max) {
+    arrayops_array_t a;
+    arrayops_get_array(a_in, &a, MP_BUFFER_READ);
+    if (a.len == 0) {
+        mp_raise_ValueError(translate("arg is an empty sequence"));
+    }
+    arrayops_value_t result;
+    shared_modules_arrayops_minmax(&a, want_max, &result);
+    return arrayops_new_value(&result);
+}
+
+//| .. function:: min(a)
+//|
+//|   Return the smallest element of ``a``.
+//|
+STATIC mp_obj_t arrayops_min(mp_obj_t a_in) {
+    return arrayops_minmax(a_in, false);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(arrayops_min_obj, arrayops_min);
+
+//| .. function:: max(a)
+//|
+//|   Return the largest element of ``a``.
+//|
+STATIC mp_obj_t arrayops_max(mp_obj_t a_in) {
+    return arrayops_minmax(a_in, true);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(arrayops_max_obj, arrayops_max);
+
+//| .. function:: dot(a, b)
+//|
+//|   Return the sum of the products of the elements of ``a`` and ``b``, which must be the
+//|   same length. Integer products are summed in 64 bits and saturate rather than wrap.
+//|
+STATIC mp_obj_t arrayops_dot(mp_obj_t a_in, mp_obj_t b_in) {
+    arrayops_array_t a;
+    arrayops_array_t b;
+    arrayops_get_array(a_in, &a, MP_BUFFER_READ);
+    arrayops_get_array(b_in, &b, MP_BUFFER_READ);
+    arrayops_check_same_length(&a, &b);
+    arrayops_value_t result;
+    shared_modules_arrayops_dot(&a, &b, &result);
+    return arrayops_new_value(&result);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(arrayops_dot_obj, arrayops_dot);
+
+//| .. function:: convert(dst, src)
+//|
+//|   Copy ``src`` into ``dst``, converting each element to the typecode of ``dst``. The two
+//|   must be the same length. Values out of range for ``dst`` are clipped.
+//|
+STATIC mp_obj_t arrayops_convert(mp_obj_t dst_in, mp_obj_t src_in) {
+    arrayops_array_t dst;
+    arrayops_array_t src;
+    arrayops_get_array(dst_in, &dst, MP_BUFFER_WRITE);
+    arrayops_get_array(src_in, &src, MP_BUFFER_READ);
+    arrayops_check_same_length(&dst, &src);
+    shared_modules_arrayops_convert(&dst, &src);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(arrayops_convert_obj, arrayops_convert);
+
+//| .. function:: fir(dst, src, taps)
+//|
+//|   Run ``src`` through the FIR filter with coefficients ``taps`` and store the result in
+//|   ``dst``, which must be the same length as ``src`` and may be ``src`` itself. Each output is
+//|   ``taps[0] * src[i] + taps[1] * src[i - 1] + ...``, taking samples before the start of
+//|   ``src`` as zero. ``f`` arrays for ``src`` and ``taps`` are fastest, as is a ``h`` ``src``
+//|   and ``dst`` with ``f`` taps.
+//|
+STATIC mp_obj_t arrayops_fir(mp_obj_t dst_in, mp_obj_t src_in, mp_obj_t taps_in) {
+    arrayops_array_t dst;
+    arrayops_array_t src;
+    arrayops_array_t taps;
+    arrayops_get_array(dst_in, &dst, MP_BUFFER_WRITE);
+    arrayops_get_array(src_in, &src, MP_BUFFER_READ);
+    arrayops_get_array(taps_in, &taps, MP_BUFFER_READ);
+    arrayops_check_same_length(&dst, &src);
+    shared_modules_arrayops_fir(&dst, &src, &taps);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(arrayops_fir_obj, arrayops_fir);
+
+//| .. function:: fft(real, imag, *, inverse=False)
+//|
+//|   Replace the complex values with real parts ``real`` and imaginary parts ``imag`` by their
+//|   discrete Fourier transform, in place. Both must be ``f`` arrays of the same length, and
+//|   the length must be a power of 2. With ``inverse=True`` it does the inverse transform,
+//|   scaled by ``1/len(real)`` so that the two undo each other.
+//|
+STATIC mp_obj_t arrayops_fft(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_real, ARG_imag, ARG_inverse };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_real, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_imag, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_inverse, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    arrayops_array_t re;
+    arrayops_array_t im;
+    arrayops_get_array(args[ARG_real].u_obj, &re, MP_BUFFER_WRITE);
+    arrayops_get_array(args[ARG_imag].u_obj, &im, MP_BUFFER_WRITE);
+    if (re.kind != ARRAYOPS_FLOAT || im.kind != ARRAYOPS_FLOAT) {
+        mp_raise_ValueError(translate("bad typecode"));
+    }
+    arrayops_check_same_length(&re, &im);
+    if ((re.len & (re.len - 1)) != 0) {
+        mp_raise_ValueError(translate("array length must be a power of 2"));
+    }
+    shared_modules_arrayops_fft(re.buf, im.buf, re.len, args[ARG_inverse].u_bool);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(arrayops_fft_obj, 2, arrayops_fft);
+
+//| .. function:: magnitude(dst, real, imag)
+//|
+//|   Store the magnitude ``sqrt(real[i]**2 + imag[i]**2)`` of each complex value in ``dst``,
+//|   for example to get the spectrum after `fft`. All three must be the same length.
+//|
+STATIC mp_obj_t arrayops_magnitude(mp_obj_t dst_in, mp_obj_t re_in, mp_obj_t im_in) {
+    arrayops_array_t dst;
+    arrayops_array_t re;
+    arrayops_array_t im;
+    arrayops_get_array(dst_in, &dst, MP_BUFFER_WRITE);
+    arrayops_get_array(re_in, &re, MP_BUFFER_READ);
+    arrayops_get_array(im_in, &im, MP_BUFFER_READ);
+    arrayops_check_same_length(&dst, &re);
+    arrayops_check_same_length(&dst, &im);
+    shared_modules_arrayops_magnitude(&dst, &re, &im);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(arrayops_magnitude_obj, arrayops_magnitude);
+
+STATIC const mp_rom_map_elem_t arrayops_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_arrayops) },
+    { MP_ROM_QSTR(MP_QSTR_add), MP_ROM_PTR(&arrayops_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mul), MP_ROM_PTR(&arrayops_mul_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clip), MP_ROM_PTR(&arrayops_clip_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sum), MP_ROM_PTR(&arrayops_sum_obj) },
+    { MP_ROM_QSTR(MP_QSTR_min), MP_ROM_PTR(&arrayops_min_obj) },
+    { MP_ROM_QSTR(MP_QSTR_max), MP_ROM_PTR(&arrayops_max_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dot), MP_ROM_PTR(&arrayops_dot_obj) },
+    { MP_ROM_QSTR(MP_QSTR_convert), MP_ROM_PTR(&arrayops_convert_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fir), MP_ROM_PTR(&arrayops_fir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fft), MP_ROM_PTR(&arrayops_fft_obj) },
+    { MP_ROM_QSTR(MP_QSTR_magnitude), MP_ROM_PTR(&arrayops_magnitude_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(arrayops_module_globals, arrayops_module_globals_table);
+
+const mp_obj_module_t arrayops_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&arrayops_module_globals,
+};
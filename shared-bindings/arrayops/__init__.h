@@ -0,0 +1,43 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_ARRAYOPS___INIT___H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_ARRAYOPS___INIT___H
+
+#include "shared-module/arrayops/__init__.h"
+
+void shared_modules_arrayops_add(arrayops_array_t *a, const arrayops_array_t *b, const arrayops_value_t *v);
+void shared_modules_arrayops_mul(arrayops_array_t *a, const arrayops_array_t *b, const arrayops_value_t *v);
+void shared_modules_arrayops_clip(arrayops_array_t *a, const arrayops_value_t *low, const arrayops_value_t *high);
+void shared_modules_arrayops_sum(const arrayops_array_t *a, arrayops_value_t *result);
+void shared_modules_arrayops_minmax(const arrayops_array_t *a, bool want_max, arrayops_value_t *result);
+void shared_modules_arrayops_dot(const arrayops_array_t *a, const arrayops_array_t *b, arrayops_value_t *result);
+void shared_modules_arrayops_convert(arrayops_array_t *dst, const arrayops_array_t *src);
+void shared_modules_arrayops_fir(arrayops_array_t *dst, const arrayops_array_t *src, const arrayops_array_t *taps);
+void shared_modules_arrayops_fft(float *re, float *im, size_t n, bool inverse);
+void shared_modules_arrayops_magnitude(arrayops_array_t *dst, const arrayops_array_t *re, const arrayops_array_t *im);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_ARRAYOPS___INIT___H
@@ -162,6 +162,10 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiobusio_i2sout___exit___obj, 4, 4,
 //|
 //|     The sample itself should consist of 8 bit or 16 bit samples.
 //|
+//|     Latency is set by the sample's buffer size because the next buffer is fetched while the
+//|     current one plays. For low latency, play through an `audioio.Mixer` with a small
+//|     ``buffer_size`` and watch `underruns` and `min_slack`.
+//|
 STATIC mp_obj_t audiobusio_i2sout_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_sample, ARG_loop };
     static const mp_arg_t allowed_args[] = {
@@ -260,6 +264,49 @@ const mp_obj_property_t audiobusio_i2sout_paused_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: underruns
+//|
+//|     The number of times since `play` that the next buffer of the sample wasn't ready in time
+//|     and old audio was output in its place. (read-only)
+//|
+STATIC mp_obj_t audiobusio_i2sout_obj_get_underruns(mp_obj_t self_in) {
+    audiobusio_i2sout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audiobusio_i2sout_deinited(self));
+    return mp_obj_new_int_from_uint(common_hal_audiobusio_i2sout_get_underruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sout_get_underruns_obj, audiobusio_i2sout_obj_get_underruns);
+
+const mp_obj_property_t audiobusio_i2sout_underruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiobusio_i2sout_get_underruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: min_slack
+//|
+//|     The shortest time in seconds, since `play`, between a buffer of the sample being ready and
+//|     the output needing it. None until the output has needed one. Values near zero mean that
+//|     playback is close to underrunning. (read-only)
+//|
+STATIC mp_obj_t audiobusio_i2sout_obj_get_min_slack(mp_obj_t self_in) {
+    audiobusio_i2sout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audiobusio_i2sout_deinited(self));
+    int32_t slack = common_hal_audiobusio_i2sout_get_min_slack_us(self);
+    if (slack < 0) {
+        return mp_const_none;
+    }
+    return mp_obj_new_float(slack / (mp_float_t) 1000000);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sout_get_min_slack_obj, audiobusio_i2sout_obj_get_min_slack);
+
+const mp_obj_property_t audiobusio_i2sout_min_slack_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiobusio_i2sout_get_min_slack_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t audiobusio_i2sout_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audiobusio_i2sout_deinit_obj) },
@@ -273,6 +320,8 @@ STATIC const mp_rom_map_elem_t audiobusio_i2sout_locals_dict_table[] = {
     // Properties
     { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audiobusio_i2sout_playing_obj) },
     { MP_ROM_QSTR(MP_QSTR_paused), MP_ROM_PTR(&audiobusio_i2sout_paused_obj) },
+    { MP_ROM_QSTR(MP_QSTR_underruns), MP_ROM_PTR(&audiobusio_i2sout_underruns_obj) },
+    { MP_ROM_QSTR(MP_QSTR_min_slack), MP_ROM_PTR(&audiobusio_i2sout_min_slack_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(audiobusio_i2sout_locals_dict, audiobusio_i2sout_locals_dict_table);
 
@@ -44,5 +44,8 @@ bool common_hal_audiobusio_i2sout_get_playing(audiobusio_i2sout_obj_t* self);
 void common_hal_audiobusio_i2sout_pause(audiobusio_i2sout_obj_t* self);
 void common_hal_audiobusio_i2sout_resume(audiobusio_i2sout_obj_t* self);
 bool common_hal_audiobusio_i2sout_get_paused(audiobusio_i2sout_obj_t* self);
+uint32_t common_hal_audiobusio_i2sout_get_underruns(audiobusio_i2sout_obj_t* self);
+// Negative until the output has needed a buffer.
+int32_t common_hal_audiobusio_i2sout_get_min_slack_us(audiobusio_i2sout_obj_t* self);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOBUSIO_I2SOUT_H
@@ -174,6 +174,15 @@ STATIC mp_obj_t audiobusio_pdmin_obj___exit__(size_t n_args, const mp_obj_t *arg
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiobusio_pdmin___exit___obj, 4, 4, audiobusio_pdmin_obj___exit__);
 
 
+STATIC void check_destination_type(audiobusio_pdmin_obj_t *self, mp_buffer_info_t *bufinfo) {
+    uint8_t bit_depth = common_hal_audiobusio_pdmin_get_bit_depth(self);
+    if (bufinfo->typecode != 'H' && bit_depth == 16) {
+        mp_raise_ValueError(translate("destination buffer must be an array of type 'H' for bit_depth = 16"));
+    } else if (bufinfo->typecode != 'B' && bufinfo->typecode != BYTEARRAY_TYPECODE && bit_depth == 8) {
+        mp_raise_ValueError(translate("destination buffer must be a bytearray or array of type 'B' for bit_depth = 8"));
+    }
+}
+
 //|   .. method:: record(destination, destination_length)
 //|
 //|     Records destination_length bytes of samples to destination. This is
@@ -201,12 +210,7 @@ STATIC mp_obj_t audiobusio_pdmin_obj_record(mp_obj_t self_obj, mp_obj_t destinat
         if (bufinfo.len / mp_binary_get_size('@', bufinfo.typecode, NULL) < length) {
             mp_raise_ValueError(translate("Destination capacity is smaller than destination_length."));
         }
-        uint8_t bit_depth = common_hal_audiobusio_pdmin_get_bit_depth(self);
-        if (bufinfo.typecode != 'H' && bit_depth == 16) {
-            mp_raise_ValueError(translate("destination buffer must be an array of type 'H' for bit_depth = 16"));
-        } else if (bufinfo.typecode != 'B' && bufinfo.typecode != BYTEARRAY_TYPECODE && bit_depth == 8) {
-            mp_raise_ValueError(translate("destination buffer must be a bytearray or array of type 'B' for bit_depth = 8"));
-        }
+        check_destination_type(self, &bufinfo);
         // length is the buffer length in slots, not bytes.
         uint32_t length_written =
             common_hal_audiobusio_pdmin_record_to_buffer(self, bufinfo.buf, length);
@@ -216,6 +220,99 @@ STATIC mp_obj_t audiobusio_pdmin_obj_record(mp_obj_t self_obj, mp_obj_t destinat
 }
 MP_DEFINE_CONST_FUN_OBJ_3(audiobusio_pdmin_record_obj, audiobusio_pdmin_obj_record);
 
+//|   .. method:: start(*, buffer_length=4096)
+//|
+//|     Starts recording continuously in the background while other code runs. Up to
+//|     ``buffer_length`` samples are kept until they are read with `readinto`. Samples recorded
+//|     while the buffer is full are lost and counted in `overruns`. `record` can't be used until
+//|     `stop` is called.
+//|
+STATIC mp_obj_t audiobusio_pdmin_obj_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer_length };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer_length, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 4096} },
+    };
+    audiobusio_pdmin_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_audiobusio_pdmin_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (args[ARG_buffer_length].u_int < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_buffer_length);
+    }
+    common_hal_audiobusio_pdmin_start(self, args[ARG_buffer_length].u_int);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audiobusio_pdmin_start_obj, 1, audiobusio_pdmin_obj_start);
+
+//|   .. method:: stop()
+//|
+//|     Stops recording started by `start`. Samples that haven't been read are discarded.
+//|
+STATIC mp_obj_t audiobusio_pdmin_obj_stop(mp_obj_t self_in) {
+    audiobusio_pdmin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audiobusio_pdmin_deinited(self));
+    common_hal_audiobusio_pdmin_stop(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_pdmin_stop_obj, audiobusio_pdmin_obj_stop);
+
+//|   .. method:: readinto(destination)
+//|
+//|     Moves samples recorded since `start` into destination without waiting for more. The
+//|     destination must be the same type of buffer as for `record`.
+//|
+//|     :return: The number of samples read, which is 0 when none are waiting.
+//|
+STATIC mp_obj_t audiobusio_pdmin_obj_readinto(mp_obj_t self_in, mp_obj_t destination) {
+    audiobusio_pdmin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audiobusio_pdmin_deinited(self));
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(destination, &bufinfo, MP_BUFFER_WRITE);
+    check_destination_type(self, &bufinfo);
+    uint32_t length = bufinfo.len / mp_binary_get_size('@', bufinfo.typecode, NULL);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audiobusio_pdmin_readinto(self, bufinfo.buf, length));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audiobusio_pdmin_readinto_obj, audiobusio_pdmin_obj_readinto);
+
+//|   .. attribute:: recording
+//|
+//|     True while recording in the background after `start`. (read-only)
+//|
+STATIC mp_obj_t audiobusio_pdmin_obj_get_recording(mp_obj_t self_in) {
+    audiobusio_pdmin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audiobusio_pdmin_deinited(self));
+    return mp_obj_new_bool(common_hal_audiobusio_pdmin_get_recording(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_pdmin_get_recording_obj, audiobusio_pdmin_obj_get_recording);
+
+const mp_obj_property_t audiobusio_pdmin_recording_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiobusio_pdmin_get_recording_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: overruns
+//|
+//|     The number of times samples were lost since `start` because they weren't read or
+//|     processed in time. (read-only)
+//|
+STATIC mp_obj_t audiobusio_pdmin_obj_get_overruns(mp_obj_t self_in) {
+    audiobusio_pdmin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audiobusio_pdmin_deinited(self));
+    return mp_obj_new_int_from_uint(common_hal_audiobusio_pdmin_get_overruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_pdmin_get_overruns_obj, audiobusio_pdmin_obj_get_overruns);
+
+const mp_obj_property_t audiobusio_pdmin_overruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audiobusio_pdmin_get_overruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|   .. attribute:: sample_rate
 //|
 //|     The actual sample_rate of the recording. This may not match the constructed
@@ -241,6 +338,13 @@ STATIC const mp_rom_map_elem_t audiobusio_pdmin_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audiobusio_pdmin___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_record), MP_ROM_PTR(&audiobusio_pdmin_record_obj) },
+    { MP_ROM_QSTR(MP_QSTR_start), MP_ROM_PTR(&audiobusio_pdmin_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&audiobusio_pdmin_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&audiobusio_pdmin_readinto_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_recording), MP_ROM_PTR(&audiobusio_pdmin_recording_obj) },
+    { MP_ROM_QSTR(MP_QSTR_overruns), MP_ROM_PTR(&audiobusio_pdmin_overruns_obj) },
     { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audiobusio_pdmin_sample_rate_obj) }
 };
 STATIC MP_DEFINE_CONST_DICT(audiobusio_pdmin_locals_dict, audiobusio_pdmin_locals_dict_table);
@@ -40,6 +40,14 @@ void common_hal_audiobusio_pdmin_deinit(audiobusio_pdmin_obj_t* self);
 bool common_hal_audiobusio_pdmin_deinited(audiobusio_pdmin_obj_t* self);
 uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t* self,
     uint16_t* buffer, uint32_t length);
+// Continuous recording into a ring of buffer_length samples, filtered in the background.
+void common_hal_audiobusio_pdmin_start(audiobusio_pdmin_obj_t* self, uint32_t buffer_length);
+void common_hal_audiobusio_pdmin_stop(audiobusio_pdmin_obj_t* self);
+bool common_hal_audiobusio_pdmin_get_recording(audiobusio_pdmin_obj_t* self);
+uint32_t common_hal_audiobusio_pdmin_get_overruns(audiobusio_pdmin_obj_t* self);
+// Copies up to length recorded samples without waiting and returns how many were copied.
+uint32_t common_hal_audiobusio_pdmin_readinto(audiobusio_pdmin_obj_t* self,
+    uint16_t* buffer, uint32_t length);
 uint8_t common_hal_audiobusio_pdmin_get_bit_depth(audiobusio_pdmin_obj_t* self);
 uint32_t common_hal_audiobusio_pdmin_get_sample_rate(audiobusio_pdmin_obj_t* self);
 // TODO(tannewt): Add record to file
@@ -0,0 +1,283 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/audioio/BiquadFilter.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audioio
+//|
+//| :class:`BiquadFilter` -- Filters another sample as it plays
+//| ============================================================
+//|
+//| BiquadFilter is a sample that applies a second order filter to another 16 bit sample as it
+//| plays. It can be played directly, passed to a `audioio.Mixer` or wrapped by another effect.
+//|
+//| .. class:: BiquadFilter(sample, *, mode=BiquadFilter.LOWPASS, frequency=1000.0, q=0.707, gain=0.0, buffer_size=1024)
+//|
+//|   Create a filter that plays sample with some frequencies boosted or cut.
+//|
+//|   :param sample: The 16 bit sample to filter
+//|   :param int mode: One of `LOWPASS`, `HIGHPASS`, `BANDPASS`, `NOTCH` or `PEAKING`
+//|   :param float frequency: The cutoff or center frequency in Hertz. Must be below half of the
+//|     sample rate.
+//|   :param float q: How sharp the filter is. 0.707 is a smooth cutoff and higher values ring
+//|     at the frequency.
+//|   :param float gain: Decibels to boost (or cut when negative) by in `PEAKING` mode
+//|   :param int buffer_size: The total size in bytes of the buffers to filter into
+//|
+//|   Muffling a wave file::
+//|
+//|     import audioio
+//|     import board
+//|
+//|     music = audioio.WaveFile(open("cplay-5.1-16bit-16khz.wav", "rb"))
+//|     muffled = audioio.BiquadFilter(music, frequency=800)
+//|     a = audioio.AudioOut(board.A0)
+//|     a.play(muffled)
+//|     while a.playing:
+//|         pass
+//|
+STATIC mp_obj_t audioio_biquadfilter_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_sample, ARG_mode, ARG_frequency, ARG_q, ARG_gain, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_mode, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = BIQUAD_LOWPASS} },
+        { MP_QSTR_frequency, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_q, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_gain, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t mode = args[ARG_mode].u_int;
+    if (mode < BIQUAD_LOWPASS || mode > BIQUAD_PEAKING) {
+        mp_raise_ValueError(translate("Filter settings out of range"));
+    }
+    mp_float_t frequency = 1000.0f;
+    if (args[ARG_frequency].u_obj != mp_const_none) {
+        frequency = mp_obj_get_float(args[ARG_frequency].u_obj);
+    }
+    mp_float_t q = 0.707f;
+    if (args[ARG_q].u_obj != mp_const_none) {
+        q = mp_obj_get_float(args[ARG_q].u_obj);
+    }
+    mp_float_t gain = 0.0f;
+    if (args[ARG_gain].u_obj != mp_const_none) {
+        gain = mp_obj_get_float(args[ARG_gain].u_obj);
+    }
+
+    audioio_biquadfilter_obj_t *self = m_new_obj(audioio_biquadfilter_obj_t);
+    self->base.type = &audioio_biquadfilter_type;
+    common_hal_audioio_biquadfilter_construct(self, args[ARG_sample].u_obj, mode, frequency, q,
+                                              gain, args[ARG_buffer_size].u_int);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the BiquadFilter and releases its buffers.
+//|
+STATIC mp_obj_t audioio_biquadfilter_deinit(mp_obj_t self_in) {
+    audioio_biquadfilter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audioio_biquadfilter_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audioio_biquadfilter_deinit_obj, audioio_biquadfilter_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audioio_biquadfilter_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audioio_biquadfilter_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audioio_biquadfilter___exit___obj, 4, 4, audioio_biquadfilter_obj___exit__);
+
+//|   .. attribute:: frequency
+//|
+//|     The cutoff or center frequency in Hertz. Changes take effect from the next buffer
+//|     filtered so it can be swept while playing.
+//|
+STATIC mp_obj_t audioio_biquadfilter_obj_get_frequency(mp_obj_t self_in) {
+    audioio_biquadfilter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_biquadfilter_deinited(self));
+    return mp_obj_new_float(common_hal_audioio_biquadfilter_get_frequency(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_biquadfilter_get_frequency_obj, audioio_biquadfilter_obj_get_frequency);
+
+STATIC mp_obj_t audioio_biquadfilter_obj_set_frequency(mp_obj_t self_in, mp_obj_t frequency) {
+    audioio_biquadfilter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_biquadfilter_deinited(self));
+    common_hal_audioio_biquadfilter_configure(self, self->mode, mp_obj_get_float(frequency),
+                                              self->q, self->gain);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioio_biquadfilter_set_frequency_obj, audioio_biquadfilter_obj_set_frequency);
+
+const mp_obj_property_t audioio_biquadfilter_frequency_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_biquadfilter_get_frequency_obj,
+              (mp_obj_t)&audioio_biquadfilter_set_frequency_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: q
+//|
+//|     How sharp the filter is.
+//|
+STATIC mp_obj_t audioio_biquadfilter_obj_get_q(mp_obj_t self_in) {
+    audioio_biquadfilter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_biquadfilter_deinited(self));
+    return mp_obj_new_float(common_hal_audioio_biquadfilter_get_q(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_biquadfilter_get_q_obj, audioio_biquadfilter_obj_get_q);
+
+STATIC mp_obj_t audioio_biquadfilter_obj_set_q(mp_obj_t self_in, mp_obj_t q) {
+    audioio_biquadfilter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_biquadfilter_deinited(self));
+    common_hal_audioio_biquadfilter_configure(self, self->mode, self->frequency,
+                                              mp_obj_get_float(q), self->gain);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioio_biquadfilter_set_q_obj, audioio_biquadfilter_obj_set_q);
+
+const mp_obj_property_t audioio_biquadfilter_q_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_biquadfilter_get_q_obj,
+              (mp_obj_t)&audioio_biquadfilter_set_q_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: gain
+//|
+//|     Decibels to boost or cut by in `PEAKING` mode.
+//|
+STATIC mp_obj_t audioio_biquadfilter_obj_get_gain(mp_obj_t self_in) {
+    audioio_biquadfilter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_biquadfilter_deinited(self));
+    return mp_obj_new_float(common_hal_audioio_biquadfilter_get_gain(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_biquadfilter_get_gain_obj, audioio_biquadfilter_obj_get_gain);
+
+STATIC mp_obj_t audioio_biquadfilter_obj_set_gain(mp_obj_t self_in, mp_obj_t gain) {
+    audioio_biquadfilter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_biquadfilter_deinited(self));
+    common_hal_audioio_biquadfilter_configure(self, self->mode, self->frequency, self->q,
+                                              mp_obj_get_float(gain));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioio_biquadfilter_set_gain_obj, audioio_biquadfilter_obj_set_gain);
+
+const mp_obj_property_t audioio_biquadfilter_gain_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_biquadfilter_get_gain_obj,
+              (mp_obj_t)&audioio_biquadfilter_set_gain_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     The sample rate of the filtered sample in Hertz. (read-only)
+//|
+STATIC mp_obj_t audioio_biquadfilter_obj_get_sample_rate(mp_obj_t self_in) {
+    audioio_biquadfilter_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_biquadfilter_deinited(self));
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audioio_biquadfilter_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_biquadfilter_get_sample_rate_obj, audioio_biquadfilter_obj_get_sample_rate);
+
+const mp_obj_property_t audioio_biquadfilter_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_biquadfilter_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. data:: LOWPASS
+//|
+//|     Passes frequencies below `frequency` and cuts those above.
+//|
+//|   .. data:: HIGHPASS
+//|
+//|     Passes frequencies above `frequency` and cuts those below.
+//|
+//|   .. data:: BANDPASS
+//|
+//|     Passes frequencies near `frequency` and cuts the rest.
+//|
+//|   .. data:: NOTCH
+//|
+//|     Cuts frequencies near `frequency` and passes the rest.
+//|
+//|   .. data:: PEAKING
+//|
+//|     Boosts or cuts frequencies near `frequency` by `gain` decibels.
+//|
+STATIC const mp_rom_map_elem_t audioio_biquadfilter_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audioio_biquadfilter_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audioio_biquadfilter___exit___obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&audioio_biquadfilter_frequency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_q), MP_ROM_PTR(&audioio_biquadfilter_q_obj) },
+    { MP_ROM_QSTR(MP_QSTR_gain), MP_ROM_PTR(&audioio_biquadfilter_gain_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audioio_biquadfilter_sample_rate_obj) },
+
+    // Modes
+    { MP_ROM_QSTR(MP_QSTR_LOWPASS), MP_ROM_INT(BIQUAD_LOWPASS) },
+    { MP_ROM_QSTR(MP_QSTR_HIGHPASS), MP_ROM_INT(BIQUAD_HIGHPASS) },
+    { MP_ROM_QSTR(MP_QSTR_BANDPASS), MP_ROM_INT(BIQUAD_BANDPASS) },
+    { MP_ROM_QSTR(MP_QSTR_NOTCH), MP_ROM_INT(BIQUAD_NOTCH) },
+    { MP_ROM_QSTR(MP_QSTR_PEAKING), MP_ROM_INT(BIQUAD_PEAKING) },
+};
+STATIC MP_DEFINE_CONST_DICT(audioio_biquadfilter_locals_dict, audioio_biquadfilter_locals_dict_table);
+
+const mp_obj_type_t audioio_biquadfilter_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_BiquadFilter,
+    .make_new = audioio_biquadfilter_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audioio_biquadfilter_locals_dict,
+};
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_BIQUADFILTER_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_BIQUADFILTER_H
+
+#include "shared-module/audioio/BiquadFilter.h"
+
+extern const mp_obj_type_t audioio_biquadfilter_type;
+
+void common_hal_audioio_biquadfilter_construct(audioio_biquadfilter_obj_t* self,
+                                               mp_obj_t sample,
+                                               audioio_biquadfilter_mode_t mode,
+                                               mp_float_t frequency,
+                                               mp_float_t q,
+                                               mp_float_t gain,
+                                               uint32_t buffer_size);
+
+void common_hal_audioio_biquadfilter_deinit(audioio_biquadfilter_obj_t* self);
+bool common_hal_audioio_biquadfilter_deinited(audioio_biquadfilter_obj_t* self);
+void common_hal_audioio_biquadfilter_configure(audioio_biquadfilter_obj_t* self,
+                                               audioio_biquadfilter_mode_t mode,
+                                               mp_float_t frequency,
+                                               mp_float_t q,
+                                               mp_float_t gain);
+mp_float_t common_hal_audioio_biquadfilter_get_frequency(audioio_biquadfilter_obj_t* self);
+mp_float_t common_hal_audioio_biquadfilter_get_q(audioio_biquadfilter_obj_t* self);
+mp_float_t common_hal_audioio_biquadfilter_get_gain(audioio_biquadfilter_obj_t* self);
+uint32_t common_hal_audioio_biquadfilter_get_sample_rate(audioio_biquadfilter_obj_t* self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_BIQUADFILTER_H
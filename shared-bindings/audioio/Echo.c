@@ -0,0 +1,233 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/audioio/Echo.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audioio
+//|
+//| :class:`Echo` -- Adds echoes to another sample as it plays
+//| ===========================================================
+//|
+//| Echo is a sample that plays another 16 bit sample mixed with delayed, fading copies of
+//| itself. It can be played directly, passed to a `audioio.Mixer` or wrapped by another effect.
+//| Echoes stop when the wrapped sample ends.
+//|
+//| .. class:: Echo(sample, *, delay=0.25, decay=0.5, max_delay=None, buffer_size=1024)
+//|
+//|   Create an echo of sample.
+//|
+//|   :param sample: The 16 bit sample to echo
+//|   :param float delay: Seconds between echoes
+//|   :param float decay: The level of each echo relative to the one before from 0.0 to 1.0
+//|   :param float max_delay: The longest `delay` that can be set later. Defaults to delay. The
+//|     delay line takes two bytes per sample per channel for this long.
+//|   :param int buffer_size: The total size in bytes of the buffers to process into
+//|
+//|   Echoing a filtered wave file::
+//|
+//|     import audioio
+//|     import board
+//|
+//|     music = audioio.WaveFile(open("cplay-5.1-16bit-16khz.wav", "rb"))
+//|     echo = audioio.Echo(audioio.BiquadFilter(music, frequency=2000), delay=0.2, decay=0.4)
+//|     a = audioio.AudioOut(board.A0)
+//|     a.play(echo)
+//|
+STATIC mp_float_t get_decay(mp_obj_t decay_obj) {
+    mp_float_t decay = mp_obj_get_float(decay_obj);
+    if (decay < 0.0f || decay > 1.0f) {
+        mp_raise_ValueError_varg(translate("%q must be in range 0.0 to 1.0"), MP_QSTR_decay);
+    }
+    return decay;
+}
+
+STATIC mp_float_t get_delay(mp_obj_t delay_obj, qstr name) {
+    mp_float_t delay = mp_obj_get_float(delay_obj);
+    if (delay < 0.0f) {
+        mp_raise_ValueError_varg(translate("%q must be >= 0"), name);
+    }
+    return delay;
+}
+
+STATIC mp_obj_t audioio_echo_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_sample, ARG_delay, ARG_decay, ARG_max_delay, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_delay, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_decay, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_max_delay, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t delay = 0.25f;
+    if (args[ARG_delay].u_obj != mp_const_none) {
+        delay = get_delay(args[ARG_delay].u_obj, MP_QSTR_delay);
+    }
+    mp_float_t decay = 0.5f;
+    if (args[ARG_decay].u_obj != mp_const_none) {
+        decay = get_decay(args[ARG_decay].u_obj);
+    }
+    mp_float_t max_delay = delay;
+    if (args[ARG_max_delay].u_obj != mp_const_none) {
+        max_delay = get_delay(args[ARG_max_delay].u_obj, MP_QSTR_max_delay);
+    }
+
+    audioio_echo_obj_t *self = m_new_obj(audioio_echo_obj_t);
+    self->base.type = &audioio_echo_type;
+    common_hal_audioio_echo_construct(self, args[ARG_sample].u_obj, max_delay, delay, decay,
+                                      args[ARG_buffer_size].u_int);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Echo and releases its buffers.
+//|
+STATIC mp_obj_t audioio_echo_deinit(mp_obj_t self_in) {
+    audioio_echo_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audioio_echo_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audioio_echo_deinit_obj, audioio_echo_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audioio_echo_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audioio_echo_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audioio_echo___exit___obj, 4, 4, audioio_echo_obj___exit__);
+
+//|   .. attribute:: delay
+//|
+//|     Seconds between echoes, up to the max_delay given to the constructor.
+//|
+STATIC mp_obj_t audioio_echo_obj_get_delay(mp_obj_t self_in) {
+    audioio_echo_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_echo_deinited(self));
+    return mp_obj_new_float(common_hal_audioio_echo_get_delay(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_echo_get_delay_obj, audioio_echo_obj_get_delay);
+
+STATIC mp_obj_t audioio_echo_obj_set_delay(mp_obj_t self_in, mp_obj_t delay) {
+    audioio_echo_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_echo_deinited(self));
+    common_hal_audioio_echo_set_delay(self, get_delay(delay, MP_QSTR_delay));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioio_echo_set_delay_obj, audioio_echo_obj_set_delay);
+
+const mp_obj_property_t audioio_echo_delay_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_echo_get_delay_obj,
+              (mp_obj_t)&audioio_echo_set_delay_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: decay
+//|
+//|     The level of each echo relative to the one before from 0.0 to 1.0.
+//|
+STATIC mp_obj_t audioio_echo_obj_get_decay(mp_obj_t self_in) {
+    audioio_echo_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_echo_deinited(self));
+    return mp_obj_new_float(common_hal_audioio_echo_get_decay(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_echo_get_decay_obj, audioio_echo_obj_get_decay);
+
+STATIC mp_obj_t audioio_echo_obj_set_decay(mp_obj_t self_in, mp_obj_t decay) {
+    audioio_echo_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_echo_deinited(self));
+    common_hal_audioio_echo_set_decay(self, get_decay(decay));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioio_echo_set_decay_obj, audioio_echo_obj_set_decay);
+
+const mp_obj_property_t audioio_echo_decay_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_echo_get_decay_obj,
+              (mp_obj_t)&audioio_echo_set_decay_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     The sample rate of the echoed sample in Hertz. (read-only)
+//|
+STATIC mp_obj_t audioio_echo_obj_get_sample_rate(mp_obj_t self_in) {
+    audioio_echo_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_echo_deinited(self));
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audioio_echo_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_echo_get_sample_rate_obj, audioio_echo_obj_get_sample_rate);
+
+const mp_obj_property_t audioio_echo_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_echo_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audioio_echo_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audioio_echo_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audioio_echo___exit___obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_delay), MP_ROM_PTR(&audioio_echo_delay_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decay), MP_ROM_PTR(&audioio_echo_decay_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audioio_echo_sample_rate_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audioio_echo_locals_dict, audioio_echo_locals_dict_table);
+
+const mp_obj_type_t audioio_echo_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Echo,
+    .make_new = audioio_echo_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audioio_echo_locals_dict,
+};
@@ -31,7 +31,6 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/audioio/RawSample.h"
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
@@ -145,9 +144,11 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audioio_mixer___exit___obj, 4, 4, aud
 //|     Plays the sample once when loop=False and continuously when loop=True.
 //|     Does not block. Use `playing` to block.
 //|
-//|     Sample must be an `audioio.WaveFile`, `audioio.Mixer` or `audioio.RawSample`.
+//|     Sample must be an `audioio.WaveFile`, `audioio.Mixer`, `audioio.RawSample`,
+//|     `audioio.Synthesizer`, `audioio.BiquadFilter` or `audioio.Echo`.
 //|
-//|     The sample must match the Mixer's encoding settings given in the constructor.
+//|     The sample must match the Mixer's encoding settings given in the constructor except for
+//|     its sample rate. Samples at other rates are converted to the Mixer's rate as they play.
 //|
 STATIC mp_obj_t audioio_mixer_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_sample, ARG_voice, ARG_loop };
@@ -187,6 +188,57 @@ STATIC mp_obj_t audioio_mixer_obj_stop_voice(size_t n_args, const mp_obj_t *pos_
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(audioio_mixer_stop_voice_obj, 1, audioio_mixer_obj_stop_voice);
 
+//|   .. method:: set_level(level, *, voice=0)
+//|
+//|     Sets the volume of the given voice from 0.0 (silent) to 1.0 (as recorded). Takes effect
+//|     from the next buffer mixed so it can be used to duck or fade a voice while it plays. The
+//|     level is kept across calls to `play`.
+//|
+STATIC mp_obj_t audioio_mixer_obj_set_level(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_level, ARG_voice };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_level, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_voice, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+    };
+    audioio_mixer_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_audioio_mixer_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t level = mp_obj_get_float(args[ARG_level].u_obj);
+    if (level < 0.0f || level > 1.0f) {
+        mp_raise_ValueError(translate("Voice level must be in range 0.0 to 1.0"));
+    }
+    common_hal_audioio_mixer_set_level(self, args[ARG_voice].u_int, level);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audioio_mixer_set_level_obj, 1, audioio_mixer_obj_set_level);
+
+//|   .. method:: set_pan(pan, *, voice=0)
+//|
+//|     Sets where the given voice sits between the left (-1.0) and right (1.0) channels. 0.0
+//|     plays it at its full level on both. Has no effect on single channel mixers.
+//|
+STATIC mp_obj_t audioio_mixer_obj_set_pan(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_pan, ARG_voice };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pan, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_voice, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+    };
+    audioio_mixer_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_audioio_mixer_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t pan = mp_obj_get_float(args[ARG_pan].u_obj);
+    if (pan < -1.0f || pan > 1.0f) {
+        mp_raise_ValueError(translate("Voice pan must be in range -1.0 to 1.0"));
+    }
+    common_hal_audioio_mixer_set_pan(self, args[ARG_voice].u_int, pan);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audioio_mixer_set_pan_obj, 1, audioio_mixer_obj_set_pan);
+
 //|   .. attribute:: playing
 //|
 //|     True when any voice is being output. (read-only)
@@ -231,6 +283,8 @@ STATIC const mp_rom_map_elem_t audioio_mixer_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audioio_mixer___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_play), MP_ROM_PTR(&audioio_mixer_play_obj) },
     { MP_ROM_QSTR(MP_QSTR_stop_voice), MP_ROM_PTR(&audioio_mixer_stop_voice_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_level), MP_ROM_PTR(&audioio_mixer_set_level_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_pan), MP_ROM_PTR(&audioio_mixer_set_pan_obj) },
 
     // Properties
     { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audioio_mixer_playing_obj) },
@@ -27,7 +27,6 @@
 #ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_MIXER_H
 #define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_MIXER_H
 
-#include "common-hal/microcontroller/Pin.h"
 #include "shared-module/audioio/Mixer.h"
 #include "shared-bindings/audioio/RawSample.h"
 
@@ -45,6 +44,8 @@ void common_hal_audioio_mixer_deinit(audioio_mixer_obj_t* self);
 bool common_hal_audioio_mixer_deinited(audioio_mixer_obj_t* self);
 void common_hal_audioio_mixer_play(audioio_mixer_obj_t* self, mp_obj_t sample, uint8_t voice, bool loop);
 void common_hal_audioio_mixer_stop_voice(audioio_mixer_obj_t* self, uint8_t voice);
+void common_hal_audioio_mixer_set_level(audioio_mixer_obj_t* self, uint8_t voice, mp_float_t level);
+void common_hal_audioio_mixer_set_pan(audioio_mixer_obj_t* self, uint8_t voice, mp_float_t pan);
 
 bool common_hal_audioio_mixer_get_playing(audioio_mixer_obj_t* self);
 uint32_t common_hal_audioio_mixer_get_sample_rate(audioio_mixer_obj_t* self);
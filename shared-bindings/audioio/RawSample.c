@@ -30,8 +30,7 @@
 #include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
-#include "shared-bindings/microcontroller/Pin.h"
-#include "shared-bindings/audioio/AudioOut.h"
+#include "shared-bindings/audioio/RawSample.h"
 #include "shared-bindings/util.h"
 #include "supervisor/shared/translate.h"
 
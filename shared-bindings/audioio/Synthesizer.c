@@ -0,0 +1,322 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/binary.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/audioio/Synthesizer.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audioio
+//|
+//| :class:`Synthesizer` -- Plays notes from a wavetable
+//| =====================================================
+//|
+//| Synthesizer generates notes as it plays instead of reading them from a buffer. Each voice
+//| steps through one cycle of a waveform at its own frequency and is shaped by an attack,
+//| decay, sustain and release envelope. The output is mono signed 16 bit audio that can be
+//| played directly or through a `audioio.Mixer`.
+//|
+//| .. class:: Synthesizer(*, voice_count=4, sample_rate=22050, buffer_size=512, waveform=None)
+//|
+//|   Create a Synthesizer that can play up to voice_count notes at once.
+//|
+//|   :param int voice_count: The maximum number of notes to play at once
+//|   :param int sample_rate: The sample rate to generate at
+//|   :param int buffer_size: The total size in bytes of the buffers to generate into. Smaller
+//|     buffers respond to notes sooner.
+//|   :param array.array waveform: One cycle of the waveform as signed 16 bit samples. Defaults
+//|     to a sine wave.
+//|
+//|   Playing a chord::
+//|
+//|     import audioio
+//|     import board
+//|     import time
+//|
+//|     synth = audioio.Synthesizer(voice_count=3)
+//|     synth.set_envelope(attack=0.05, release=0.5)
+//|     a = audioio.AudioOut(board.A0)
+//|     a.play(synth)
+//|     for voice, frequency in enumerate((261.63, 329.63, 392.0)):
+//|         synth.press(voice, frequency)
+//|     time.sleep(1)
+//|     for voice in range(3):
+//|         synth.release(voice)
+//|
+STATIC mp_obj_t audioio_synthesizer_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_voice_count, ARG_sample_rate, ARG_buffer_size, ARG_waveform };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_voice_count, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 4} },
+        { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 22050} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 512} },
+        { MP_QSTR_waveform, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t voice_count = args[ARG_voice_count].u_int;
+    if (voice_count < 1 || voice_count > 255) {
+        mp_raise_ValueError(translate("Invalid voice count"));
+    }
+    mp_int_t sample_rate = args[ARG_sample_rate].u_int;
+    if (sample_rate < 1) {
+        mp_raise_ValueError(translate("Sample rate must be positive"));
+    }
+    mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 8) {
+        mp_raise_ValueError(translate("Invalid buffer size"));
+    }
+
+    mp_obj_t waveform_obj = args[ARG_waveform].u_obj;
+    const int16_t* waveform = NULL;
+    uint32_t waveform_length = 0;
+    if (waveform_obj != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(waveform_obj, &bufinfo, MP_BUFFER_READ);
+        waveform_length = bufinfo.len / sizeof(int16_t);
+        if (bufinfo.typecode != 'h' || waveform_length < 2 || waveform_length > 0x10000) {
+            mp_raise_ValueError(translate("waveform must be an array of type 'h' with 2 to 65536 values"));
+        }
+        waveform = bufinfo.buf;
+    }
+
+    audioio_synthesizer_obj_t *self = m_new_obj_var(audioio_synthesizer_obj_t, audioio_synthesizer_voice_t, voice_count);
+    self->base.type = &audioio_synthesizer_type;
+    common_hal_audioio_synthesizer_construct(self, voice_count, buffer_size, sample_rate,
+                                             waveform_obj, waveform, waveform_length);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the Synthesizer and releases its buffers.
+//|
+STATIC mp_obj_t audioio_synthesizer_deinit(mp_obj_t self_in) {
+    audioio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audioio_synthesizer_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audioio_synthesizer_deinit_obj, audioio_synthesizer_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audioio_synthesizer_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audioio_synthesizer_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audioio_synthesizer___exit___obj, 4, 4, audioio_synthesizer_obj___exit__);
+
+STATIC mp_float_t get_frequency(mp_obj_t frequency_obj) {
+    mp_float_t frequency = mp_obj_get_float(frequency_obj);
+    if (frequency < 0.0f) {
+        mp_raise_ValueError_varg(translate("%q must be >= 0"), MP_QSTR_frequency);
+    }
+    return frequency;
+}
+
+//|   .. method:: press(voice, frequency, *, level=1.0)
+//|
+//|     Starts a note on the given voice. The note attacks and decays to its sustain level and
+//|     then holds until `release`. Pressing a voice that is still sounding starts the attack
+//|     again from its current level.
+//|
+//|     :param int voice: The voice to play the note on
+//|     :param float frequency: The note's frequency in Hertz. Frequencies above half the sample
+//|       rate are played at half the sample rate.
+//|     :param float level: The note's volume from 0.0 (silent) to 1.0, such as its velocity
+//|
+STATIC mp_obj_t audioio_synthesizer_obj_press(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_voice, ARG_frequency, ARG_level };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_voice, MP_ARG_INT | MP_ARG_REQUIRED },
+        { MP_QSTR_frequency, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_level, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    audioio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_audioio_synthesizer_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t frequency = get_frequency(args[ARG_frequency].u_obj);
+    mp_float_t level = 1.0f;
+    if (args[ARG_level].u_obj != mp_const_none) {
+        level = mp_obj_get_float(args[ARG_level].u_obj);
+    }
+    if (level < 0.0f || level > 1.0f) {
+        mp_raise_ValueError(translate("Voice level must be in range 0.0 to 1.0"));
+    }
+    common_hal_audioio_synthesizer_press(self, args[ARG_voice].u_int, frequency, level);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audioio_synthesizer_press_obj, 1, audioio_synthesizer_obj_press);
+
+//|   .. method:: release(voice)
+//|
+//|     Releases the note on the given voice so that it fades out over the envelope's release
+//|     time.
+//|
+STATIC mp_obj_t audioio_synthesizer_obj_release(mp_obj_t self_in, mp_obj_t voice_obj) {
+    audioio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_synthesizer_deinited(self));
+    common_hal_audioio_synthesizer_release(self, mp_obj_get_int(voice_obj));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioio_synthesizer_release_obj, audioio_synthesizer_obj_release);
+
+//|   .. method:: set_frequency(voice, frequency)
+//|
+//|     Changes the frequency of the given voice without restarting its note, such as for a pitch
+//|     bend or vibrato. Takes effect from the next buffer generated.
+//|
+STATIC mp_obj_t audioio_synthesizer_obj_set_frequency(mp_obj_t self_in, mp_obj_t voice_obj, mp_obj_t frequency_obj) {
+    audioio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_synthesizer_deinited(self));
+    common_hal_audioio_synthesizer_set_frequency(self, mp_obj_get_int(voice_obj),
+                                                 get_frequency(frequency_obj));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(audioio_synthesizer_set_frequency_obj, audioio_synthesizer_obj_set_frequency);
+
+//|   .. method:: set_envelope(*, attack=0.005, decay=0.0, sustain=1.0, release=0.005)
+//|
+//|     Sets the envelope shared by all voices, including notes that are already playing.
+//|
+//|     :param float attack: Seconds to rise from silence to full volume
+//|     :param float decay: Seconds to fall from full volume to the sustain level
+//|     :param float sustain: Level from 0.0 to 1.0 held until the note is released. Notes with a
+//|       sustain of 0.0 end once they have decayed.
+//|     :param float release: Seconds to fall from full volume to silence after `release`
+//|
+STATIC mp_obj_t audioio_synthesizer_obj_set_envelope(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_attack, ARG_decay, ARG_sustain, ARG_release };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_attack, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_decay, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_sustain, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_release, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    audioio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_audioio_synthesizer_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const mp_float_t defaults[] = { 0.005f, 0.0f, 1.0f, 0.005f };
+    const qstr names[] = { MP_QSTR_attack, MP_QSTR_decay, MP_QSTR_sustain, MP_QSTR_release };
+    mp_float_t values[MP_ARRAY_SIZE(allowed_args)];
+    for (size_t i = 0; i < MP_ARRAY_SIZE(allowed_args); i++) {
+        values[i] = defaults[i];
+        if (args[i].u_obj != mp_const_none) {
+            values[i] = mp_obj_get_float(args[i].u_obj);
+        }
+        if (values[i] < 0.0f) {
+            mp_raise_ValueError_varg(translate("%q must be >= 0"), names[i]);
+        }
+    }
+    if (values[ARG_sustain] > 1.0f) {
+        mp_raise_ValueError_varg(translate("%q must be in range 0.0 to 1.0"), MP_QSTR_sustain);
+    }
+    common_hal_audioio_synthesizer_set_envelope(self, values[ARG_attack], values[ARG_decay],
+                                                values[ARG_sustain], values[ARG_release]);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audioio_synthesizer_set_envelope_obj, 1, audioio_synthesizer_obj_set_envelope);
+
+//|   .. attribute:: playing
+//|
+//|     True when any voice is sounding, including notes that are still being released.
+//|     (read-only)
+//|
+STATIC mp_obj_t audioio_synthesizer_obj_get_playing(mp_obj_t self_in) {
+    audioio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_synthesizer_deinited(self));
+    return mp_obj_new_bool(common_hal_audioio_synthesizer_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_synthesizer_get_playing_obj, audioio_synthesizer_obj_get_playing);
+
+const mp_obj_property_t audioio_synthesizer_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_synthesizer_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: sample_rate
+//|
+//|     32 bit value that dictates how quickly samples are played in Hertz (cycles per second).
+//|
+STATIC mp_obj_t audioio_synthesizer_obj_get_sample_rate(mp_obj_t self_in) {
+    audioio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_synthesizer_deinited(self));
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audioio_synthesizer_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_synthesizer_get_sample_rate_obj, audioio_synthesizer_obj_get_sample_rate);
+
+const mp_obj_property_t audioio_synthesizer_sample_rate_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_synthesizer_get_sample_rate_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audioio_synthesizer_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audioio_synthesizer_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audioio_synthesizer___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_press), MP_ROM_PTR(&audioio_synthesizer_press_obj) },
+    { MP_ROM_QSTR(MP_QSTR_release), MP_ROM_PTR(&audioio_synthesizer_release_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_frequency), MP_ROM_PTR(&audioio_synthesizer_set_frequency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_envelope), MP_ROM_PTR(&audioio_synthesizer_set_envelope_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audioio_synthesizer_playing_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audioio_synthesizer_sample_rate_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audioio_synthesizer_locals_dict, audioio_synthesizer_locals_dict_table);
+
+const mp_obj_type_t audioio_synthesizer_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Synthesizer,
+    .make_new = audioio_synthesizer_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audioio_synthesizer_locals_dict,
+};
@@ -0,0 +1,58 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_SYNTHESIZER_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_SYNTHESIZER_H
+
+#include "shared-module/audioio/Synthesizer.h"
+
+extern const mp_obj_type_t audioio_synthesizer_type;
+
+// waveform may be NULL to use a sine wave.
+void common_hal_audioio_synthesizer_construct(audioio_synthesizer_obj_t* self,
+                                              uint8_t voice_count,
+                                              uint32_t buffer_size,
+                                              uint32_t sample_rate,
+                                              mp_obj_t waveform_obj,
+                                              const int16_t* waveform,
+                                              uint32_t waveform_length);
+
+void common_hal_audioio_synthesizer_deinit(audioio_synthesizer_obj_t* self);
+bool common_hal_audioio_synthesizer_deinited(audioio_synthesizer_obj_t* self);
+void common_hal_audioio_synthesizer_press(audioio_synthesizer_obj_t* self, uint8_t voice,
+                                          mp_float_t frequency, mp_float_t level);
+void common_hal_audioio_synthesizer_release(audioio_synthesizer_obj_t* self, uint8_t voice);
+void common_hal_audioio_synthesizer_set_frequency(audioio_synthesizer_obj_t* self, uint8_t voice,
+                                                  mp_float_t frequency);
+void common_hal_audioio_synthesizer_set_envelope(audioio_synthesizer_obj_t* self,
+                                                 mp_float_t attack, mp_float_t decay,
+                                                 mp_float_t sustain, mp_float_t release);
+
+bool common_hal_audioio_synthesizer_get_playing(audioio_synthesizer_obj_t* self);
+uint32_t common_hal_audioio_synthesizer_get_sample_rate(audioio_synthesizer_obj_t* self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_SYNTHESIZER_H
@@ -0,0 +1,190 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/audioio/VirtualOut.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: audioio
+//|
+//| :class:`VirtualOut` -- Output audio into memory
+//| ================================================
+//|
+//| Stands in for `AudioOut` in the unix port's simulator build, where there is no hardware. It
+//| plays samples the same way but, instead of a DAC taking buffers as it needs them, Python code
+//| pulls the output with `readinto`. This makes it possible to measure and profile mixing and
+//| effects on a desktop.
+//|
+//| .. class:: VirtualOut()
+//|
+//|   Create a VirtualOut object.
+//|
+//|   Render one second of a sample into a file::
+//|
+//|     import audioio
+//|
+//|     out = audioio.VirtualOut()
+//|     buf = bytearray(4096)
+//|     with open("out.raw", "wb") as f:
+//|         out.play(sample, loop=True)
+//|         remaining = sample.sample_rate * 2
+//|         while remaining > 0:
+//|             n = out.readinto(buf)
+//|             f.write(buf[:min(n, remaining)])
+//|             remaining -= n
+//|
+STATIC mp_obj_t audioio_virtualout_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    mp_arg_check_num(n_args, kw_args, 0, 0, false);
+
+    audioio_virtualout_obj_t *self = m_new_obj(audioio_virtualout_obj_t);
+    self->base.type = &audioio_virtualout_type;
+    common_hal_audioio_virtualout_construct(self);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitialises the VirtualOut and stops playback.
+//|
+STATIC mp_obj_t audioio_virtualout_deinit(mp_obj_t self_in) {
+    audioio_virtualout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audioio_virtualout_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(audioio_virtualout_deinit_obj, audioio_virtualout_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t audioio_virtualout_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audioio_virtualout_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audioio_virtualout___exit___obj, 4, 4, audioio_virtualout_obj___exit__);
+
+//|   .. method:: play(sample, *, loop=False)
+//|
+//|     Plays the sample once when loop=False and continuously when loop=True. Nothing is read from
+//|     the sample until `readinto` is called.
+//|
+STATIC mp_obj_t audioio_virtualout_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_sample, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample,    MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_loop,      MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+    };
+    audioio_virtualout_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_audioio_virtualout_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    common_hal_audioio_virtualout_play(self, args[ARG_sample].u_obj, args[ARG_loop].u_bool);
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(audioio_virtualout_play_obj, 1, audioio_virtualout_obj_play);
+
+//|   .. method:: stop()
+//|
+//|     Stops playback.
+//|
+STATIC mp_obj_t audioio_virtualout_obj_stop(mp_obj_t self_in) {
+    audioio_virtualout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_virtualout_deinited(self));
+    common_hal_audioio_virtualout_stop(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_virtualout_stop_obj, audioio_virtualout_obj_stop);
+
+//|   .. method:: readinto(buffer)
+//|
+//|     Fills the buffer with the next output of the playing sample and returns the number of bytes
+//|     written. The output is in the sample's own format, with channels interleaved. Fewer bytes
+//|     than fit in the buffer, down to zero, are only written once playback has finished.
+//|
+STATIC mp_obj_t audioio_virtualout_obj_readinto(mp_obj_t self_in, mp_obj_t buffer) {
+    audioio_virtualout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_virtualout_deinited(self));
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+    uint32_t length = bufinfo.len;
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audioio_virtualout_readinto(self, bufinfo.buf, length));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(audioio_virtualout_readinto_obj, audioio_virtualout_obj_readinto);
+
+//|   .. attribute:: playing
+//|
+//|     True until the sample has been read to the end or playback is stopped. (read-only)
+//|
+STATIC mp_obj_t audioio_virtualout_obj_get_playing(mp_obj_t self_in) {
+    audioio_virtualout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_audioio_virtualout_deinited(self));
+    return mp_obj_new_bool(common_hal_audioio_virtualout_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_virtualout_get_playing_obj, audioio_virtualout_obj_get_playing);
+
+const mp_obj_property_t audioio_virtualout_playing_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&audioio_virtualout_get_playing_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t audioio_virtualout_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audioio_virtualout_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audioio_virtualout___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_play), MP_ROM_PTR(&audioio_virtualout_play_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&audioio_virtualout_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&audioio_virtualout_readinto_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audioio_virtualout_playing_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(audioio_virtualout_locals_dict, audioio_virtualout_locals_dict_table);
+
+const mp_obj_type_t audioio_virtualout_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_VirtualOut,
+    .make_new = audioio_virtualout_make_new,
+    .locals_dict = (mp_obj_dict_t*)&audioio_virtualout_locals_dict,
+};
@@ -0,0 +1,45 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_VIRTUALOUT_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_VIRTUALOUT_H
+
+#include "shared-module/audioio/VirtualOut.h"
+
+extern const mp_obj_type_t audioio_virtualout_type;
+
+void common_hal_audioio_virtualout_construct(audioio_virtualout_obj_t* self);
+void common_hal_audioio_virtualout_deinit(audioio_virtualout_obj_t* self);
+bool common_hal_audioio_virtualout_deinited(audioio_virtualout_obj_t* self);
+void common_hal_audioio_virtualout_play(audioio_virtualout_obj_t* self, mp_obj_t sample, bool loop);
+void common_hal_audioio_virtualout_stop(audioio_virtualout_obj_t* self);
+bool common_hal_audioio_virtualout_get_playing(audioio_virtualout_obj_t* self);
+// Copies up to length bytes of output into buffer and returns how many were copied. Fewer are only
+// copied once the sample has finished.
+uint32_t common_hal_audioio_virtualout_readinto(audioio_virtualout_obj_t* self, uint8_t* buffer,
+                                                uint32_t length);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_VIRTUALOUT_H
@@ -39,13 +39,17 @@
 //| ========================================================
 //|
 //| A .wav file prepped for audio playback. Only mono and stereo files are supported. Samples must
-//| be 8 bit unsigned or 16 bit signed.
+//| be 8 bit unsigned or 16 bit signed PCM, or 4 bit IMA ADPCM. IMA ADPCM files take a quarter of
+//| the space of 16 bit ones and are decoded to 16 bit samples as they play.
 //|
-//| .. class:: WaveFile(filename)
+//| .. class:: WaveFile(filename, *, read_ahead=0)
 //|
 //|   Load a .wav file for playback with `audioio.AudioOut` or `audiobusio.I2SOut`.
 //|
 //|   :param bytes-like file: Already opened wave file
+//|   :param int read_ahead: Number of extra 256 byte buffers to read ahead of playback during
+//|     background tasks. These smooth over times when the filesystem is slow to respond, such as
+//|     while the computer writes to CIRCUITPY.
 //|
 //|   Playing a wave file from flash::
 //|
@@ -67,13 +71,26 @@
 //|       pass
 //|     print("stopped")
 //|
-STATIC mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    mp_arg_check_num(n_args, kw_args, 1, 1, false);
+STATIC mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_file, ARG_read_ahead };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_read_ahead, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t read_ahead = args[ARG_read_ahead].u_int;
+    if (read_ahead < 0) {
+        mp_raise_ValueError_varg(translate("%q must be >= 0"), MP_QSTR_read_ahead);
+    }
+    // The buffer count has to fit in a byte.
+    read_ahead = MIN(read_ahead, UINT8_MAX - 2);
 
     audioio_wavefile_obj_t *self = m_new_obj(audioio_wavefile_obj_t);
     self->base.type = &audioio_wavefile_type;
-    if (MP_OBJ_IS_TYPE(args[0], &mp_type_fileio)) {
-        common_hal_audioio_wavefile_construct(self, MP_OBJ_TO_PTR(args[0]));
+    if (MP_OBJ_IS_TYPE(args[ARG_file].u_obj, &mp_type_vfs_fat_fileio)) {
+        common_hal_audioio_wavefile_construct(self, MP_OBJ_TO_PTR(args[ARG_file].u_obj), read_ahead);
     } else {
         mp_raise_TypeError(translate("file must be a file opened in byte mode"));
     }
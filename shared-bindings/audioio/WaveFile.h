@@ -27,14 +27,13 @@
 #ifndef MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_WAVEFILE_H
 #define MICROPY_INCLUDED_SHARED_BINDINGS_AUDIOIO_WAVEFILE_H
 
-#include "common-hal/audioio/AudioOut.h"
-#include "common-hal/microcontroller/Pin.h"
 #include "extmod/vfs_fat.h"
+#include "shared-module/audioio/WaveFile.h"
 
 extern const mp_obj_type_t audioio_wavefile_type;
 
 void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
-    pyb_file_obj_t* file);
+    pyb_file_obj_t* file, uint8_t read_ahead);
 
 void common_hal_audioio_wavefile_deinit(audioio_wavefile_obj_t* self);
 bool common_hal_audioio_wavefile_deinited(audioio_wavefile_obj_t* self);
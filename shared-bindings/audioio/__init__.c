@@ -29,12 +29,19 @@
 #include "py/obj.h"
 #include "py/runtime.h"
 
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/audioio/__init__.h"
+#if CIRCUITPY_MICROCONTROLLER
 #include "shared-bindings/audioio/AudioOut.h"
+#endif
+#include "shared-bindings/audioio/BiquadFilter.h"
+#include "shared-bindings/audioio/Echo.h"
 #include "shared-bindings/audioio/Mixer.h"
 #include "shared-bindings/audioio/RawSample.h"
+#include "shared-bindings/audioio/Synthesizer.h"
 #include "shared-bindings/audioio/WaveFile.h"
+#if CIRCUITPY_SIMULATOR
+#include "shared-bindings/audioio/VirtualOut.h"
+#endif
 
 //| :mod:`audioio` --- Support for audio input and output
 //| ======================================================
@@ -51,8 +58,12 @@
 //|     :maxdepth: 3
 //|
 //|     AudioOut
+//|     BiquadFilter
+//|     Echo
 //|     Mixer
 //|     RawSample
+//|     Synthesizer
+//|     VirtualOut
 //|     WaveFile
 //|
 //| All classes change hardware state and should be deinitialized when they
@@ -63,9 +74,17 @@
 
 STATIC const mp_rom_map_elem_t audioio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_audioio) },
+    #if CIRCUITPY_MICROCONTROLLER
     { MP_ROM_QSTR(MP_QSTR_AudioOut), MP_ROM_PTR(&audioio_audioout_type) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR_BiquadFilter), MP_ROM_PTR(&audioio_biquadfilter_type) },
+    { MP_ROM_QSTR(MP_QSTR_Echo), MP_ROM_PTR(&audioio_echo_type) },
     { MP_ROM_QSTR(MP_QSTR_Mixer), MP_ROM_PTR(&audioio_mixer_type) },
     { MP_ROM_QSTR(MP_QSTR_RawSample), MP_ROM_PTR(&audioio_rawsample_type) },
+    { MP_ROM_QSTR(MP_QSTR_Synthesizer), MP_ROM_PTR(&audioio_synthesizer_type) },
+    #if CIRCUITPY_SIMULATOR
+    { MP_ROM_QSTR(MP_QSTR_VirtualOut), MP_ROM_PTR(&audioio_virtualout_type) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_WaveFile), MP_ROM_PTR(&audioio_wavefile_type) },
 };
 
@@ -124,7 +124,9 @@ static void check_lock(bitbangio_spi_obj_t *self) {
 //|
 //|     Configures the SPI bus. Only valid when locked.
 //|
-//|     :param int baudrate: the clock rate in Hertz
+//|     :param int baudrate: the clock rate in Hertz. Rates up to 500kHz are paced by delays.
+//|       Higher rates run the clock as fast as the CPU can toggle the pins, which is usually
+//|       well over 1MHz when the port can drive them through its registers.
 //|     :param int polarity: the base state of the clock line (0 or 1)
 //|     :param int phase: the edge of the clock that data is captured. First (0)
 //|       or second (1). Rising or falling depends on clock polarity.
@@ -188,53 +190,86 @@ STATIC mp_obj_t bitbangio_spi_obj_unlock(mp_obj_t self_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(bitbangio_spi_unlock_obj, bitbangio_spi_obj_unlock);
 
-//|   .. method:: SPI.write(buf)
+//|   .. method:: SPI.write(buffer, \*, start=0, end=len(buffer))
 //|
-//|     Write the data contained in ``buf``. Requires the SPI being locked.
+//|     Write the data contained in ``buffer``. Requires the SPI being locked.
 //|     If the buffer is empty, nothing happens.
 //|
-// TODO(tannewt): Add support for start and end kwargs.
-STATIC mp_obj_t bitbangio_spi_write(mp_obj_t self_in, mp_obj_t wr_buf) {
-    bitbangio_spi_obj_t *self = MP_OBJ_TO_PTR(self_in);
+//|     :param bytearray buffer: Write out the data in this buffer
+//|     :param int start: Start of the slice of ``buffer`` to write out: ``buffer[start:end]``
+//|     :param int end: End of the slice; this index is not included
+//|
+STATIC mp_obj_t bitbangio_spi_write(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_start, ARG_end };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer,     MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_start,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end,        MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+    };
+    bitbangio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     raise_error_if_deinited(shared_module_bitbangio_spi_deinited(self));
-    mp_buffer_info_t src;
-    mp_get_buffer_raise(wr_buf, &src, MP_BUFFER_READ);
-    if (src.len == 0) {
+    check_lock(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
+    int32_t start = args[ARG_start].u_int;
+    uint32_t length = bufinfo.len;
+    normalize_buffer_bounds(&start, args[ARG_end].u_int, &length);
+
+    if (length == 0) {
         return mp_const_none;
     }
-    check_lock(self);
-    bool ok = shared_module_bitbangio_spi_write(self, src.buf, src.len);
+
+    bool ok = shared_module_bitbangio_spi_write(self, ((uint8_t*)bufinfo.buf) + start, length);
     if (!ok) {
         mp_raise_OSError(MP_EIO);
     }
     return mp_const_none;
 }
-MP_DEFINE_CONST_FUN_OBJ_2(bitbangio_spi_write_obj, bitbangio_spi_write);
+MP_DEFINE_CONST_FUN_OBJ_KW(bitbangio_spi_write_obj, 2, bitbangio_spi_write);
 
 
-//|   .. method:: SPI.readinto(buf)
+//|   .. method:: SPI.readinto(buffer, \*, start=0, end=len(buffer))
 //|
-//|     Read into the buffer specified by ``buf`` while writing zeroes.
-//|     Requires the SPI being locked.
+//|     Read into ``buffer`` while writing zeroes. Requires the SPI being locked.
 //|     If the number of bytes to read is 0, nothing happens.
 //|
-// TODO(tannewt): Add support for start and end kwargs.
-STATIC mp_obj_t bitbangio_spi_readinto(size_t n_args, const mp_obj_t *args) {
-    bitbangio_spi_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+//|     :param bytearray buffer: Read data into this buffer
+//|     :param int start: Start of the slice of ``buffer`` to read into: ``buffer[start:end]``
+//|     :param int end: End of the slice; this index is not included
+//|
+STATIC mp_obj_t bitbangio_spi_readinto(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_start, ARG_end };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer,     MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_start,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end,        MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+    };
+    bitbangio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     raise_error_if_deinited(shared_module_bitbangio_spi_deinited(self));
+    check_lock(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
-    if (bufinfo.len == 0) {
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
+    int32_t start = args[ARG_start].u_int;
+    uint32_t length = bufinfo.len;
+    normalize_buffer_bounds(&start, args[ARG_end].u_int, &length);
+
+    if (length == 0) {
         return mp_const_none;
     }
-    check_lock(args[0]);
-    bool ok = shared_module_bitbangio_spi_read(self, bufinfo.buf, bufinfo.len);
+
+    bool ok = shared_module_bitbangio_spi_read(self, ((uint8_t*)bufinfo.buf) + start, length);
     if (!ok) {
         mp_raise_OSError(MP_EIO);
     }
     return mp_const_none;
 }
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bitbangio_spi_readinto_obj, 2, 2, bitbangio_spi_readinto);
+MP_DEFINE_CONST_FUN_OBJ_KW(bitbangio_spi_readinto_obj, 2, bitbangio_spi_readinto);
 
 //|   .. method:: SPI.write_readinto(buffer_out, buffer_in, \*, out_start=0, out_end=len(buffer_out), in_start=0, in_end=len(buffer_in))
 //|
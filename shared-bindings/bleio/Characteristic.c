@@ -39,7 +39,7 @@
 //| and writing of the characteristic's value.
 //|
 //|
-//| .. class:: Characteristic(uuid, *, broadcast=False, indicate=False, notify=False, read=False, write=False, write_no_response=False)
+//| .. class:: Characteristic(uuid, *, broadcast=False, indicate=False, notify=False, read=False, write=False, write_no_response=False, max_length=20)
 //|
 //|   Create a new Characteristic object identified by the specified UUID.
 //|
@@ -50,10 +50,12 @@
 //|   :param bool read: Clients may read this characteristic
 //|   :param bool write: Clients may write this characteristic; a response will be sent back
 //|   :param bool write_no_response: Clients may write this characteristic; no response will be sent back
+//|   :param int max_length: Maximum length in bytes of the value, from 1 to 512. Values longer than 20
+//|     bytes can only be notified in one packet when the connection has negotiated a larger MTU.
 //|
 STATIC mp_obj_t bleio_characteristic_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum {
-        ARG_uuid, ARG_broadcast, ARG_indicate, ARG_notify, ARG_read, ARG_write, ARG_write_no_response,
+        ARG_uuid, ARG_broadcast, ARG_indicate, ARG_notify, ARG_read, ARG_write, ARG_write_no_response, ARG_max_length,
     };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_uuid,  MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = mp_const_none} },
@@ -63,6 +65,7 @@ STATIC mp_obj_t bleio_characteristic_make_new(const mp_obj_type_t *type, size_t
         { MP_QSTR_read, MP_ARG_KW_ONLY| MP_ARG_BOOL, {.u_bool = false} },
         { MP_QSTR_write, MP_ARG_KW_ONLY| MP_ARG_BOOL, {.u_bool = false} },
         { MP_QSTR_write_no_response, MP_ARG_KW_ONLY| MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_max_length, MP_ARG_KW_ONLY| MP_ARG_INT, {.u_int = 20} },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -74,6 +77,14 @@ STATIC mp_obj_t bleio_characteristic_make_new(const mp_obj_type_t *type, size_t
         mp_raise_ValueError(translate("Expected a UUID"));
     }
 
+    const mp_int_t max_length = args[ARG_max_length].u_int;
+    if (max_length < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_max_length);
+    }
+    if (max_length > 512) {
+        mp_raise_ValueError_varg(translate("%q must be <= %d"), MP_QSTR_max_length, 512);
+    }
+
     bleio_characteristic_obj_t *self = m_new_obj(bleio_characteristic_obj_t);
     self->base.type = &bleio_characteristic_type;
     self->uuid = MP_OBJ_TO_PTR(uuid);
@@ -87,7 +98,7 @@ STATIC mp_obj_t bleio_characteristic_make_new(const mp_obj_type_t *type, size_t
     properties.write = args[ARG_write].u_bool;
     properties.write_no_response = args[ARG_write_no_response].u_bool;
 
-    common_hal_bleio_characteristic_construct(self, uuid, properties);
+    common_hal_bleio_characteristic_construct(self, uuid, properties, max_length);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -253,10 +264,32 @@ const mp_obj_property_t bleio_characteristic_value_obj = {
                (mp_obj_t)&mp_const_none_obj },
 };
 
+//|   .. method:: queue_notification(value)
+//|
+//|     Queue ``value`` to be sent as a notification and return without waiting for it to go out.
+//|     Queued notifications are handed to the radio as earlier ones complete, so several can be
+//|     sent on each connection event. If no client has enabled notifications the value is just
+//|     stored, as if assigned to `value`.
+//|
+//|     :param value: bytes-like object no longer than the characteristic's ``max_length``
+//|     :return: ``True`` if the value was queued, ``False`` if the queue is full
+//|     :rtype: bool
+//|
+STATIC mp_obj_t bleio_characteristic_queue_notification(mp_obj_t self_in, mp_obj_t value_in) {
+    bleio_characteristic_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(value_in, &bufinfo, MP_BUFFER_READ);
+
+    return mp_obj_new_bool(common_hal_bleio_characteristic_queue_notification(self, &bufinfo));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(bleio_characteristic_queue_notification_obj, bleio_characteristic_queue_notification);
+
 STATIC const mp_rom_map_elem_t bleio_characteristic_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_broadcast),     MP_ROM_PTR(&bleio_characteristic_broadcast_obj) },
     { MP_ROM_QSTR(MP_QSTR_indicate),      MP_ROM_PTR(&bleio_characteristic_indicate_obj) },
     { MP_ROM_QSTR(MP_QSTR_notify),        MP_ROM_PTR(&bleio_characteristic_notify_obj) },
+    { MP_ROM_QSTR(MP_QSTR_queue_notification), MP_ROM_PTR(&bleio_characteristic_queue_notification_obj) },
     { MP_ROM_QSTR(MP_QSTR_read),          MP_ROM_PTR(&bleio_characteristic_read_obj) },
     { MP_ROM_QSTR(MP_QSTR_uuid),          MP_ROM_PTR(&bleio_characteristic_uuid_obj) },
     { MP_ROM_QSTR(MP_QSTR_value),         MP_ROM_PTR(&bleio_characteristic_value_obj) },
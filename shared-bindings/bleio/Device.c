@@ -170,6 +170,7 @@ STATIC mp_obj_t bleio_device_make_new(const mp_obj_type_t *type, size_t n_args,
     self->notif_handler = mp_const_none;
     self->conn_handler = mp_const_none;
     self->conn_handle = 0xFFFF;
+    self->att_mtu = BLE_GATT_ATT_MTU_DEFAULT;
     self->is_peripheral = true;
 
     mp_map_t kw_args;
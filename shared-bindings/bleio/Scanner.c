@@ -24,13 +24,17 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "py/objproperty.h"
 #include "py/runtime.h"
 #include "shared-bindings/bleio/ScanEntry.h"
 #include "shared-bindings/bleio/Scanner.h"
+#include "shared-bindings/bleio/UUID.h"
 
 #define DEFAULT_INTERVAL 100
 #define DEFAULT_WINDOW 100
+#define DEFAULT_BUFFER_SIZE 32
 
 // Work-in-progress: orphaned for now.
 //| :orphan:
@@ -67,11 +71,19 @@
 //|     Allowed values are between 10ms and 10.24 sec.
 //|
 
-//|   .. method:: scan(timeout)
+//|   .. method:: scan(timeout, *, uuid=None, address_prefix=None, minimum_rssi=-128, manufacturer_data_prefix=None, buffer_size=32)
 //|
-//|     Performs a BLE scan.
+//|     Performs a BLE scan. Advertisements are filtered as they arrive and only one entry is
+//|     returned per address, holding the most recent advertisement from it.
 //|
 //|     :param int timeout: the scan timeout in ms
+//|     :param bleio.UUID uuid: only keep advertisements that list this service UUID
+//|     :param bytes address_prefix: only keep addresses starting with these bytes, most significant first
+//|     :param int minimum_rssi: only keep advertisements received at least this strongly
+//|     :param bytes manufacturer_data_prefix: only keep advertisements whose manufacturer specific
+//|       data starts with these bytes, including the two byte company identifier
+//|     :param int buffer_size: number of addresses that can be waiting to be returned. Advertisements
+//|       from new addresses are dropped while it is full.
 //|     :returns: advertising packets found
 //|     :rtype: list of :py:class:`bleio.ScanEntry`
 //|
@@ -89,6 +101,8 @@ STATIC mp_obj_t bleio_scanner_make_new(const mp_obj_type_t *type, size_t n_args,
 
     self->interval = DEFAULT_INTERVAL;
     self->window = DEFAULT_WINDOW;
+    self->records = NULL;
+    self->records_size = 0;
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -116,17 +130,78 @@ const mp_obj_property_t bleio_scanner_interval_obj = {
                (mp_obj_t)&mp_const_none_obj },
 };
 
-STATIC mp_obj_t scanner_scan(mp_obj_t self_in, mp_obj_t timeout_in) {
-    bleio_scanner_obj_t *self = MP_OBJ_TO_PTR(self_in);
-    const mp_int_t timeout = mp_obj_get_int(timeout_in);
+STATIC mp_obj_t scanner_scan(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    bleio_scanner_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    enum { ARG_timeout, ARG_uuid, ARG_address_prefix, ARG_minimum_rssi, ARG_manufacturer_data_prefix, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_timeout, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_uuid, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_address_prefix, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_minimum_rssi, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -128} },
+        { MP_QSTR_manufacturer_data_prefix, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_buffer_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = DEFAULT_BUFFER_SIZE} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    self->uuid_filter_len = 0;
+    const mp_obj_t uuid = args[ARG_uuid].u_obj;
+    if (uuid != mp_const_none) {
+        if (!MP_OBJ_IS_TYPE(uuid, &bleio_uuid_type)) {
+            mp_raise_ValueError(translate("Expected a UUID"));
+        }
+        bleio_uuid_obj_t *uuid_obj = MP_OBJ_TO_PTR(uuid);
+        if (common_hal_bleio_uuid_get_size(uuid_obj) == 16) {
+            const uint32_t uuid16 = common_hal_bleio_uuid_get_uuid16(uuid_obj);
+            self->uuid_filter[0] = uuid16 & 0xff;
+            self->uuid_filter[1] = uuid16 >> 8;
+            self->uuid_filter_len = 2;
+        } else if (common_hal_bleio_uuid_get_uuid128(uuid_obj, self->uuid_filter)) {
+            self->uuid_filter_len = 16;
+        }
+    }
+
+    self->address_prefix_len = 0;
+    if (args[ARG_address_prefix].u_obj != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(args[ARG_address_prefix].u_obj, &bufinfo, MP_BUFFER_READ);
+        if (bufinfo.len > BLEIO_ADDRESS_BYTES) {
+            mp_raise_ValueError_varg(translate("%q length must be <= %d"), MP_QSTR_address_prefix, BLEIO_ADDRESS_BYTES);
+        }
+        memcpy(self->address_prefix, bufinfo.buf, bufinfo.len);
+        self->address_prefix_len = bufinfo.len;
+    }
+
+    self->manufacturer_prefix_len = 0;
+    if (args[ARG_manufacturer_data_prefix].u_obj != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(args[ARG_manufacturer_data_prefix].u_obj, &bufinfo, MP_BUFFER_READ);
+        if (bufinfo.len > BLEIO_SCAN_MANUFACTURER_PREFIX_MAX) {
+            mp_raise_ValueError_varg(translate("%q length must be <= %d"), MP_QSTR_manufacturer_data_prefix,
+                                     BLEIO_SCAN_MANUFACTURER_PREFIX_MAX);
+        }
+        memcpy(self->manufacturer_prefix, bufinfo.buf, bufinfo.len);
+        self->manufacturer_prefix_len = bufinfo.len;
+    }
+
+    self->minimum_rssi = MAX(-128, MIN(127, args[ARG_minimum_rssi].u_int));
+
+    const mp_int_t buffer_size = args[ARG_buffer_size].u_int;
+    if (buffer_size < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_buffer_size);
+    }
+    if (self->records == NULL || self->records_size != buffer_size) {
+        self->records = m_new(bleio_scan_record_t, buffer_size);
+        self->records_size = buffer_size;
+    }
 
     self->adv_reports = mp_obj_new_list(0, NULL);
 
-    common_hal_bleio_scanner_scan(self, timeout);
+    common_hal_bleio_scanner_scan(self, args[ARG_timeout].u_int);
 
     return self->adv_reports;
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_2(bleio_scanner_scan_obj, scanner_scan);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(bleio_scanner_scan_obj, 2, scanner_scan);
 
 STATIC mp_obj_t bleio_scanner_get_window(mp_obj_t self_in) {
     bleio_scanner_obj_t *self = MP_OBJ_TO_PTR(self_in);
@@ -269,6 +269,115 @@ STATIC mp_obj_t busio_i2c_writeto(size_t n_args, const mp_obj_t *pos_args, mp_ma
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(busio_i2c_writeto_obj, 1, busio_i2c_writeto);
 
+// Write out (if any) without a stop and then read into in (if any) after a repeated start.
+STATIC void writeto_then_readfrom(busio_i2c_obj_t *self, uint16_t address,
+        const uint8_t *out, size_t out_len, uint8_t *in, size_t in_len) {
+    uint8_t status = 0;
+    if (out_len > 0 || in_len == 0) {
+        status = common_hal_busio_i2c_write(self, address, out, out_len, in_len == 0);
+    }
+    if (status == 0 && in_len > 0) {
+        status = common_hal_busio_i2c_read(self, address, in, in_len);
+    }
+    if (status != 0) {
+        mp_raise_OSError(status);
+    }
+}
+
+//|   .. method:: I2C.writeto_then_readfrom(address, buffer_out, buffer_in, \*, out_start=0, out_end=len(buffer_out), in_start=0, in_end=len(buffer_in))
+//|
+//|      Write the bytes from ``buffer_out`` to the slave specified by ``address``, generate no stop
+//|      bit, generate a repeated start and read into ``buffer_in``. This is the usual way to read a
+//|      device register and costs one call instead of two.
+//|
+//|      If ``out_start`` or ``out_end`` is provided, then the output buffer will be sliced
+//|      as if ``buffer_out[out_start:out_end]``, and likewise ``in_start`` and ``in_end`` for the
+//|      input buffer. This will not cause an allocation like ``buffer[start:end]`` will so it
+//|      saves memory.
+//|
+//|      :param int address: 7-bit device address
+//|      :param bytearray buffer_out: buffer containing the bytes to write
+//|      :param bytearray buffer_in: buffer to write into
+//|      :param int out_start: Index to start writing from
+//|      :param int out_end: Index to read up to but not include
+//|      :param int in_start: Index to start writing at
+//|      :param int in_end: Index to write up to but not include
+//|
+STATIC mp_obj_t busio_i2c_writeto_then_readfrom(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_address, ARG_buffer_out, ARG_buffer_in, ARG_out_start, ARG_out_end, ARG_in_start, ARG_in_end };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_address,    MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_buffer_out, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_buffer_in,  MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_out_start,  MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_out_end,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+        { MP_QSTR_in_start,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_in_end,     MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+    };
+    busio_i2c_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_busio_i2c_deinited(self));
+    check_lock(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t out_bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer_out].u_obj, &out_bufinfo, MP_BUFFER_READ);
+    int32_t out_start = args[ARG_out_start].u_int;
+    uint32_t out_length = out_bufinfo.len;
+    normalize_buffer_bounds(&out_start, args[ARG_out_end].u_int, &out_length);
+
+    mp_buffer_info_t in_bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer_in].u_obj, &in_bufinfo, MP_BUFFER_WRITE);
+    int32_t in_start = args[ARG_in_start].u_int;
+    uint32_t in_length = in_bufinfo.len;
+    normalize_buffer_bounds(&in_start, args[ARG_in_end].u_int, &in_length);
+    if (in_length == 0) {
+        mp_raise_ValueError(translate("Buffer must be at least length 1"));
+    }
+
+    writeto_then_readfrom(self, args[ARG_address].u_int,
+        ((uint8_t*) out_bufinfo.buf) + out_start, out_length,
+        ((uint8_t*) in_bufinfo.buf) + in_start, in_length);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(busio_i2c_writeto_then_readfrom_obj, 3, busio_i2c_writeto_then_readfrom);
+
+//|   .. method:: I2C.transfer(transactions)
+//|
+//|      Run a sequence of ``(address, buffer_out, buffer_in)`` transactions back to back, each
+//|      like `writeto_then_readfrom`. Either buffer may be ``None`` to only read or only write.
+//|      Polling several registers or sensors this way holds the bus for one call instead of
+//|      one per transaction. Raises ``OSError`` at the first transaction that fails.
+//|
+//|      :param transactions: a list or tuple of ``(address, buffer_out, buffer_in)`` tuples
+//|
+STATIC mp_obj_t busio_i2c_transfer(mp_obj_t self_in, mp_obj_t transactions_in) {
+    busio_i2c_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_busio_i2c_deinited(self));
+    check_lock(self);
+
+    size_t num_transactions;
+    mp_obj_t *transactions;
+    mp_obj_get_array(transactions_in, &num_transactions, &transactions);
+    for (size_t i = 0; i < num_transactions; i++) {
+        mp_obj_t *transaction;
+        mp_obj_get_array_fixed_n(transactions[i], 3, &transaction);
+
+        mp_buffer_info_t out_bufinfo = { .buf = NULL, .len = 0 };
+        if (transaction[1] != mp_const_none) {
+            mp_get_buffer_raise(transaction[1], &out_bufinfo, MP_BUFFER_READ);
+        }
+        mp_buffer_info_t in_bufinfo = { .buf = NULL, .len = 0 };
+        if (transaction[2] != mp_const_none) {
+            mp_get_buffer_raise(transaction[2], &in_bufinfo, MP_BUFFER_WRITE);
+        }
+        writeto_then_readfrom(self, mp_obj_get_int(transaction[0]),
+            out_bufinfo.buf, out_bufinfo.len, in_bufinfo.buf, in_bufinfo.len);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(busio_i2c_transfer_obj, busio_i2c_transfer);
+
 STATIC const mp_rom_map_elem_t busio_i2c_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&busio_i2c_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
@@ -280,6 +389,8 @@ STATIC const mp_rom_map_elem_t busio_i2c_locals_dict_table[] = {
 
     { MP_ROM_QSTR(MP_QSTR_readfrom_into), MP_ROM_PTR(&busio_i2c_readfrom_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_writeto), MP_ROM_PTR(&busio_i2c_writeto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeto_then_readfrom), MP_ROM_PTR(&busio_i2c_writeto_then_readfrom_obj) },
+    { MP_ROM_QSTR(MP_QSTR_transfer), MP_ROM_PTR(&busio_i2c_transfer_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(busio_i2c_locals_dict, busio_i2c_locals_dict_table);
@@ -44,12 +44,19 @@
 //|
 //| Protocol definition is here: https://www.maximintegrated.com/en/app-notes/index.mvp/id/126
 //|
-//| .. class:: OneWire(pin)
+//| .. class:: OneWire(pin, *, tx=None)
 //|
 //|   Create a OneWire object associated with the given pin. The object
 //|   implements the lowest level timing-sensitive bits of the protocol.
 //|
+//|   Without ``tx`` the bus is driven by timing each slot in software with
+//|   interrupts off. With ``tx``, a UART does the timing instead, so interrupts
+//|   stay on and many slots are sent at once. ``pin`` must then be a UART RX pin
+//|   and ``tx`` a UART TX pin that pulls the bus low through a diode or an open
+//|   drain buffer.
+//|
 //|   :param ~microcontroller.Pin pin: Pin connected to the OneWire bus
+//|   :param ~microcontroller.Pin tx: UART TX pin that drives the bus
 //|
 //|   Read a short series of pulses::
 //|
@@ -63,20 +70,27 @@
 //|     print(onewire.read_bit())
 //|
 STATIC mp_obj_t busio_onewire_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_pin };
+    enum { ARG_pin, ARG_tx };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_pin, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_tx, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
     assert_pin(args[ARG_pin].u_obj, false);
     const mcu_pin_obj_t* pin = MP_OBJ_TO_PTR(args[ARG_pin].u_obj);
     assert_pin_free(pin);
+    const mcu_pin_obj_t* tx = NULL;
+    if (args[ARG_tx].u_obj != mp_const_none) {
+        assert_pin(args[ARG_tx].u_obj, false);
+        tx = MP_OBJ_TO_PTR(args[ARG_tx].u_obj);
+        assert_pin_free(tx);
+    }
 
     busio_onewire_obj_t *self = m_new_obj(busio_onewire_obj_t);
     self->base.type = &busio_onewire_type;
 
-    common_hal_busio_onewire_construct(self, pin);
+    common_hal_busio_onewire_construct(self, pin, tx);
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -152,6 +166,60 @@ STATIC mp_obj_t busio_onewire_obj_write_bit(mp_obj_t self_in, mp_obj_t bool_obj)
 }
 MP_DEFINE_CONST_FUN_OBJ_2(busio_onewire_write_bit_obj, busio_onewire_obj_write_bit);
 
+//|   .. method:: write(buffer)
+//|
+//|     Write out the bytes in buffer, least significant bit first.
+//|
+STATIC mp_obj_t busio_onewire_obj_write(mp_obj_t self_in, mp_obj_t buffer) {
+    busio_onewire_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_busio_onewire_deinited(self));
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_READ);
+    common_hal_busio_onewire_write(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(busio_onewire_write_obj, busio_onewire_obj_write);
+
+//|   .. method:: readinto(buffer)
+//|
+//|     Read bytes into buffer, least significant bit first.
+//|
+STATIC mp_obj_t busio_onewire_obj_readinto(mp_obj_t self_in, mp_obj_t buffer) {
+    busio_onewire_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_busio_onewire_deinited(self));
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+    common_hal_busio_onewire_readinto(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(busio_onewire_readinto_obj, busio_onewire_obj_readinto);
+
+//|   .. method:: search()
+//|
+//|     Find the ROM codes of every device on the bus with the Search ROM command.
+//|
+//|     :returns: one 8 byte ``bytearray`` per device, empty when none answer
+//|     :rtype: list
+//|
+STATIC mp_obj_t busio_onewire_obj_search(mp_obj_t self_in) {
+    busio_onewire_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_busio_onewire_deinited(self));
+
+    mp_obj_t roms = mp_obj_new_list(0, NULL);
+    uint8_t rom[8] = {0};
+    uint8_t last_discrepancy = 0;
+    do {
+        if (!common_hal_busio_onewire_search(self, rom, &last_discrepancy)) {
+            break;
+        }
+        mp_obj_list_append(roms, mp_obj_new_bytearray(sizeof(rom), rom));
+    } while (last_discrepancy != 0);
+    return roms;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_onewire_search_obj, busio_onewire_obj_search);
+
 STATIC const mp_rom_map_elem_t busio_onewire_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&busio_onewire_deinit_obj) },
@@ -160,6 +228,9 @@ STATIC const mp_rom_map_elem_t busio_onewire_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&busio_onewire_reset_obj) },
     { MP_ROM_QSTR(MP_QSTR_read_bit), MP_ROM_PTR(&busio_onewire_read_bit_obj) },
     { MP_ROM_QSTR(MP_QSTR_write_bit), MP_ROM_PTR(&busio_onewire_write_bit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&busio_onewire_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&busio_onewire_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_search), MP_ROM_PTR(&busio_onewire_search_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(busio_onewire_locals_dict, busio_onewire_locals_dict_table);
 
@@ -131,6 +131,13 @@ static void check_lock(busio_spi_obj_t *self) {
     }
 }
 
+// Lets a write_async() finish before the bus is used for anything else.
+STATIC void finish_write(busio_spi_obj_t *self) {
+    if (!common_hal_busio_spi_finish_write(self)) {
+        mp_raise_OSError(MP_EIO);
+    }
+}
+
 //|   .. method:: SPI.configure(\*, baudrate=100000, polarity=0, phase=0, bits=8)
 //|
 //|     Configures the SPI bus. The SPI object must be locked.
@@ -164,6 +171,7 @@ STATIC mp_obj_t busio_spi_configure(size_t n_args, const mp_obj_t *pos_args, mp_
     busio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     raise_error_if_deinited(common_hal_busio_spi_deinited(self));
     check_lock(self);
+    finish_write(self);
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
@@ -233,6 +241,7 @@ STATIC mp_obj_t busio_spi_write(size_t n_args, const mp_obj_t *pos_args, mp_map_
     busio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     raise_error_if_deinited(common_hal_busio_spi_deinited(self));
     check_lock(self);
+    finish_write(self);
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
@@ -254,6 +263,61 @@ STATIC mp_obj_t busio_spi_write(size_t n_args, const mp_obj_t *pos_args, mp_map_
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(busio_spi_write_obj, 2, busio_spi_write);
 
+//|   .. method:: SPI.write_async(buffer, \*, start=0, end=len(buffer))
+//|
+//|     Start writing the data contained in ``buffer`` and return while it is sent out in the
+//|     background. The SPI object must be locked. The buffer must not be changed until the write
+//|     is done. Anything else done with the SPI object waits for the write to finish first.
+//|     Short writes and writes the hardware can't do in the background finish before this returns.
+//|
+//|     :param bytearray buffer: Write out the data in this buffer
+//|     :param int start: Start of the slice of ``buffer`` to write out: ``buffer[start:end]``
+//|     :param int end: End of the slice; this index is not included
+//|
+STATIC mp_obj_t busio_spi_write_async(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_start, ARG_end };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer,     MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_start,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end,        MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+    };
+    busio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    raise_error_if_deinited(common_hal_busio_spi_deinited(self));
+    check_lock(self);
+    finish_write(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
+    int32_t start = args[ARG_start].u_int;
+    uint32_t length = bufinfo.len;
+    normalize_buffer_bounds(&start, args[ARG_end].u_int, &length);
+
+    if (length == 0) {
+        return mp_const_none;
+    }
+
+    bool ok = common_hal_busio_spi_start_write_obj(self, args[ARG_buffer].u_obj,
+                                                   ((uint8_t*)bufinfo.buf) + start, length);
+    if (!ok) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(busio_spi_write_async_obj, 2, busio_spi_write_async);
+
+//|   .. method:: SPI.wait()
+//|
+//|     Wait for the write started by `write_async` to finish. Returns right away when there is none.
+//|
+STATIC mp_obj_t busio_spi_obj_wait(mp_obj_t self_in) {
+    busio_spi_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_busio_spi_deinited(self));
+    finish_write(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_spi_wait_obj, busio_spi_obj_wait);
 
 //|   .. method:: SPI.readinto(buffer, \*, start=0, end=len(buffer), write_value=0)
 //|
@@ -277,6 +341,7 @@ STATIC mp_obj_t busio_spi_readinto(size_t n_args, const mp_obj_t *pos_args, mp_m
     busio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     raise_error_if_deinited(common_hal_busio_spi_deinited(self));
     check_lock(self);
+    finish_write(self);
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
@@ -326,6 +391,7 @@ STATIC mp_obj_t busio_spi_write_readinto(size_t n_args, const mp_obj_t *pos_args
     busio_spi_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     raise_error_if_deinited(common_hal_busio_spi_deinited(self));
     check_lock(self);
+    finish_write(self);
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
@@ -379,6 +445,24 @@ const mp_obj_property_t busio_spi_frequency_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: busy
+//|
+//|     True while the data from `write_async` is still being sent. (read-only)
+//|
+STATIC mp_obj_t busio_spi_obj_get_busy(mp_obj_t self_in) {
+    busio_spi_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_busio_spi_deinited(self));
+    return mp_obj_new_bool(common_hal_busio_spi_write_in_progress(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_spi_get_busy_obj, busio_spi_obj_get_busy);
+
+const mp_obj_property_t busio_spi_busy_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&busio_spi_get_busy_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t busio_spi_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&busio_spi_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
@@ -391,6 +475,9 @@ STATIC const mp_rom_map_elem_t busio_spi_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&busio_spi_readinto_obj) },
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&busio_spi_write_obj) },
     { MP_ROM_QSTR(MP_QSTR_write_readinto), MP_ROM_PTR(&busio_spi_write_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write_async), MP_ROM_PTR(&busio_spi_write_async_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait), MP_ROM_PTR(&busio_spi_wait_obj) },
+    { MP_ROM_QSTR(MP_QSTR_busy), MP_ROM_PTR(&busio_spi_busy_obj) },
     { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&busio_spi_frequency_obj) }
 };
 STATIC MP_DEFINE_CONST_DICT(busio_spi_locals_dict, busio_spi_locals_dict_table);
@@ -52,6 +52,20 @@ extern void common_hal_busio_spi_unlock(busio_spi_obj_t *self);
 // Writes out the given data.
 extern bool common_hal_busio_spi_write(busio_spi_obj_t *self, const uint8_t *data, size_t len);
 
+// Starts writing out the given data in the background when possible. The data must stay unchanged
+// until common_hal_busio_spi_finish_write returns.
+extern bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len);
+
+// Waits for the write started by common_hal_busio_spi_start_write to finish.
+extern bool common_hal_busio_spi_finish_write(busio_spi_obj_t *self);
+
+// Like common_hal_busio_spi_start_write but also keeps the Python object that owns the data alive
+// until the write finishes.
+extern bool common_hal_busio_spi_start_write_obj(busio_spi_obj_t *self, mp_obj_t buffer, const uint8_t *data, size_t len);
+
+// Returns true while the write started by common_hal_busio_spi_start_write is still sending data.
+extern bool common_hal_busio_spi_write_in_progress(busio_spi_obj_t *self);
+
 // Reads in len bytes while outputting zeroes.
 extern bool common_hal_busio_spi_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value);
 
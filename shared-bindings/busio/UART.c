@@ -46,7 +46,7 @@
 //| =================================================
 //|
 //|
-//| .. class:: UART(tx, rx, \*, baudrate=9600, bits=8, parity=None, stop=1, timeout=1, receiver_buffer_size=64)
+//| .. class:: UART(tx, rx, \*, baudrate=9600, bits=8, parity=None, stop=1, timeout=1, receiver_buffer_size=64, transmitter_buffer_size=64)
 //|
 //|   A common bidirectional serial protocol that uses an an agreed upon speed
 //|   rather than a shared clock line.
@@ -59,6 +59,11 @@
 //|   :param int stop:  the number of stop bits, 1 or 2.
 //|   :param float timeout:  the timeout in seconds to wait for the first character and between subsequent characters. Raises ``ValueError`` if timeout >100 seconds.
 //|   :param int receiver_buffer_size: the character length of the read buffer (0 to disable). (When a character is 9 bits the buffer will be 2 * receiver_buffer_size bytes.)
+//|     On SAMD the buffer is filled by DMA when a DMA channel is free, so make it large enough to
+//|     hold the characters received between reads at high baudrates.
+//|   :param int transmitter_buffer_size: the character length of the write buffer. ``write()`` returns
+//|     as soon as its data has been queued here, so size it for the largest write that shouldn't
+//|     wait. 0 makes every write wait until it has been sent.
 //|
 //|   *New in CircuitPython 4.0:* ``timeout`` has incompatibly changed units from milliseconds to seconds.
 //|   The new upper limit on ``timeout`` is meant to catch mistaken use of milliseconds.
@@ -76,7 +81,8 @@ STATIC mp_obj_t busio_uart_make_new(const mp_obj_type_t *type, size_t n_args, co
     // https://github.com/adafruit/circuitpython/issues/1056)
     busio_uart_obj_t *self = m_new_ll_obj(busio_uart_obj_t);
     self->base.type = &busio_uart_type;
-    enum { ARG_tx, ARG_rx, ARG_baudrate, ARG_bits, ARG_parity, ARG_stop, ARG_timeout, ARG_receiver_buffer_size};
+    enum { ARG_tx, ARG_rx, ARG_baudrate, ARG_bits, ARG_parity, ARG_stop, ARG_timeout, ARG_receiver_buffer_size,
+           ARG_transmitter_buffer_size };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_tx, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_rx, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -86,6 +92,7 @@ STATIC mp_obj_t busio_uart_make_new(const mp_obj_type_t *type, size_t n_args, co
         { MP_QSTR_stop, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 1} },
         { MP_QSTR_timeout, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(1)} },
         { MP_QSTR_receiver_buffer_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 64} },
+        { MP_QSTR_transmitter_buffer_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 64} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -115,6 +122,13 @@ STATIC mp_obj_t busio_uart_make_new(const mp_obj_type_t *type, size_t n_args, co
         mp_raise_ValueError(translate("stop must be 1 or 2"));
     }
 
+    mp_int_t receiver_buffer_size = args[ARG_receiver_buffer_size].u_int;
+    mp_int_t transmitter_buffer_size = args[ARG_transmitter_buffer_size].u_int;
+    if (receiver_buffer_size < 0 || receiver_buffer_size > 0xffff ||
+        transmitter_buffer_size < 0 || transmitter_buffer_size >= 0xffff) {
+        mp_raise_ValueError(translate("Invalid buffer size"));
+    }
+
     mp_float_t timeout = mp_obj_get_float(args[ARG_timeout].u_obj);
     if (timeout > (mp_float_t)100.0) {
         mp_raise_ValueError(translate("timeout >100 (units are now seconds, not msecs)"));
@@ -122,7 +136,7 @@ STATIC mp_obj_t busio_uart_make_new(const mp_obj_type_t *type, size_t n_args, co
 
     common_hal_busio_uart_construct(self, tx, rx,
                                     args[ARG_baudrate].u_int, bits, parity, stop, timeout,
-                                    args[ARG_receiver_buffer_size].u_int);
+                                    receiver_buffer_size, transmitter_buffer_size);
     return (mp_obj_t)self;
 }
 
@@ -167,9 +181,10 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(busio_uart___exit___obj, 4, 4, busio_
 //|     :return: Data read
 //|     :rtype: bytes or None
 //|
-//|   .. method:: readinto(buf)
+//|   .. method:: readinto(buf, \*, start=0, end=len(buf))
 //|
-//|     Read bytes into the ``buf``. Read at most ``len(buf)`` bytes.
+//|     Read bytes into ``buf[start:end]``, which is filled without allocating a slice.
+//|     Read at most ``end - start`` bytes.
 //|
 //|     :return: number of bytes read and stored into ``buf``
 //|     :rtype: int or None (on a non-blocking error)
@@ -183,9 +198,10 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(busio_uart___exit___obj, 4, 4, busio_
 //|     :return: the line read
 //|     :rtype: int or None
 //|
-//|   .. method:: write(buf)
+//|   .. method:: write(buf, \*, start=0, end=len(buf))
 //|
-//|     Write the buffer of bytes to the bus.
+//|     Write ``buf[start:end]`` to the bus without allocating a slice. Returns once the bytes
+//|     are queued in the write buffer, which may be before they have all been sent. See `out_waiting`.
 //|
 //|     *New in CircuitPython 4.0:* ``buf`` must be bytes, not a string.
 //|
@@ -280,6 +296,43 @@ const mp_obj_property_t busio_uart_in_waiting_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: out_waiting
+//|
+//|     The number of bytes written but not yet sent.
+//|
+STATIC mp_obj_t busio_uart_obj_get_out_waiting(mp_obj_t self_in) {
+    busio_uart_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_busio_uart_deinited(self));
+    return MP_OBJ_NEW_SMALL_INT(common_hal_busio_uart_tx_characters_waiting(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_uart_get_out_waiting_obj, busio_uart_obj_get_out_waiting);
+
+const mp_obj_property_t busio_uart_out_waiting_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&busio_uart_get_out_waiting_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: rx_overruns
+//|
+//|     The number of times received characters were lost because the input buffer was full or
+//|     the hardware couldn't keep up. Ports that can't detect this always return 0.
+//|
+STATIC mp_obj_t busio_uart_obj_get_rx_overruns(mp_obj_t self_in) {
+    busio_uart_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_busio_uart_deinited(self));
+    return mp_obj_new_int_from_uint(common_hal_busio_uart_get_rx_overruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busio_uart_get_rx_overruns_obj, busio_uart_obj_get_rx_overruns);
+
+const mp_obj_property_t busio_uart_rx_overruns_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&busio_uart_get_rx_overruns_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|   .. method:: reset_input_buffer()
 //|
 //|     Discard any unread characters in the input buffer.
@@ -351,6 +404,8 @@ STATIC const mp_rom_map_elem_t busio_uart_locals_dict_table[] = {
     // Properties
     { MP_ROM_QSTR(MP_QSTR_baudrate), MP_ROM_PTR(&busio_uart_baudrate_obj) },
     { MP_ROM_QSTR(MP_QSTR_in_waiting), MP_ROM_PTR(&busio_uart_in_waiting_obj) },
+    { MP_ROM_QSTR(MP_QSTR_out_waiting), MP_ROM_PTR(&busio_uart_out_waiting_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rx_overruns), MP_ROM_PTR(&busio_uart_rx_overruns_obj) },
 
     // Nested Enum-like Classes.
     { MP_ROM_QSTR(MP_QSTR_Parity),       MP_ROM_PTR(&busio_uart_parity_type) },
@@ -351,6 +351,22 @@ const mp_obj_property_t digitalio_digitalio_pull_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+// Handle value directly, rather than through the locals dict and property,
+// so that toggling or reading a pin in a loop stays cheap.
+STATIC void digitalio_digitalinout_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    if (attr == MP_QSTR_value) {
+        if (dest[0] == MP_OBJ_NULL) {
+            dest[0] = digitalio_digitalinout_obj_get_value(self_in);
+            return;
+        } else if (dest[1] != MP_OBJ_NULL) {
+            digitalio_digitalinout_obj_set_value(self_in, dest[1]);
+            dest[0] = MP_OBJ_NULL;
+            return;
+        }
+    }
+    dest[1] = MP_OBJ_SENTINEL;
+}
+
 STATIC const mp_rom_map_elem_t digitalio_digitalinout_locals_dict_table[] = {
     // instance methods
     { MP_ROM_QSTR(MP_QSTR_deinit),             MP_ROM_PTR(&digitalio_digitalinout_deinit_obj) },
@@ -372,6 +388,7 @@ const mp_obj_type_t digitalio_digitalinout_type = {
     { &mp_type_type },
     .name = MP_QSTR_DigitalInOut,
     .make_new = digitalio_digitalinout_make_new,
+    .attr = digitalio_digitalinout_attr,
     .locals_dict = (mp_obj_t)&digitalio_digitalinout_locals_dict,
 };
 
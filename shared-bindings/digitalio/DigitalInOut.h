@@ -40,6 +40,15 @@ typedef enum {
     DIGITALINOUT_PIN_BUSY
 } digitalinout_result_t;
 
+// Port registers that set, clear and read a pin by writing or testing mask, for bit-banging
+// without a function call per edge.
+typedef struct {
+    volatile uint32_t* set;
+    volatile uint32_t* clear;
+    volatile uint32_t* input;
+    uint32_t mask;
+} digitalinout_registers_t;
+
 digitalinout_result_t common_hal_digitalio_digitalinout_construct(digitalio_digitalinout_obj_t* self, const mcu_pin_obj_t* pin);
 void common_hal_digitalio_digitalinout_deinit(digitalio_digitalinout_obj_t* self);
 bool common_hal_digitalio_digitalinout_deinited(digitalio_digitalinout_obj_t* self);
@@ -53,6 +62,8 @@ digitalio_drive_mode_t common_hal_digitalio_digitalinout_get_drive_mode(digitali
 void common_hal_digitalio_digitalinout_set_pull(digitalio_digitalinout_obj_t* self, digitalio_pull_t pull);
 digitalio_pull_t common_hal_digitalio_digitalinout_get_pull(digitalio_digitalinout_obj_t* self);
 void common_hal_digitalio_digitalinout_never_reset(digitalio_digitalinout_obj_t *self);
+// Returns false when the pin can't be driven through fixed port registers.
+bool common_hal_digitalio_digitalinout_get_registers(digitalio_digitalinout_obj_t* self, digitalinout_registers_t* registers);
 digitalio_digitalinout_obj_t *assert_digitalinout(mp_obj_t obj);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_DIGITALINOUT_H
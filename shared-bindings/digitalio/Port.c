@@ -0,0 +1,246 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/binary.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/digitalio/Port.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: digitalio
+//|
+//| :class:`Port` -- a group of pins read and written together
+//| ==========================================================
+//|
+//| A Port treats up to 32 pins as the bits of one integer. It is meant for parallel busses such as
+//| 8 bit LCD interfaces, LED matrix rows and columns or reading a data bus, where setting one
+//| `DigitalInOut` at a time is too slow and lets the pins change one after another.
+//|
+//| .. class:: Port(pins, *, strobe=None)
+//|
+//|   Create a Port from a sequence of pins. ``pins[0]`` is the least significant bit. The pins
+//|   start as inputs with no pull.
+//|
+//|   Pins that are on the same hardware port are changed by a single register write, so they
+//|   switch at the same time. Listing the pins in the order of the hardware port makes reads and
+//|   writes faster still.
+//|
+//|   :param sequence pins: The `microcontroller.Pin` objects that make up the port
+//|   :param ~microcontroller.Pin strobe: Optional pin that `write` pulses low while each value
+//|     is put on the pins, like the write strobe of a parallel LCD. It idles high.
+//|
+STATIC mp_obj_t digitalio_port_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_pins, ARG_strobe };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pins, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_strobe, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t pin_count;
+    mp_obj_t *pin_objs;
+    mp_obj_get_array(args[ARG_pins].u_obj, &pin_count, &pin_objs);
+    if (pin_count == 0) {
+        mp_raise_ValueError_varg(translate("%q must not be empty"), MP_QSTR_pins);
+    }
+    if (pin_count > DIGITALIO_PORT_MAX_PINS) {
+        mp_raise_ValueError_varg(translate("%q length must be <= %d"), MP_QSTR_pins, DIGITALIO_PORT_MAX_PINS);
+    }
+    const mcu_pin_obj_t* pins[DIGITALIO_PORT_MAX_PINS];
+    for (size_t i = 0; i < pin_count; i++) {
+        assert_pin(pin_objs[i], false);
+        pins[i] = MP_OBJ_TO_PTR(pin_objs[i]);
+        assert_pin_free(pins[i]);
+        for (size_t j = 0; j < i; j++) {
+            if (pins[j] == pins[i]) {
+                mp_raise_ValueError(translate("Invalid pins"));
+            }
+        }
+    }
+    const mcu_pin_obj_t* strobe = NULL;
+    if (args[ARG_strobe].u_obj != mp_const_none) {
+        assert_pin(args[ARG_strobe].u_obj, false);
+        strobe = MP_OBJ_TO_PTR(args[ARG_strobe].u_obj);
+        assert_pin_free(strobe);
+        for (size_t i = 0; i < pin_count; i++) {
+            if (pins[i] == strobe) {
+                mp_raise_ValueError(translate("Invalid pins"));
+            }
+        }
+    }
+
+    digitalio_port_obj_t *self = m_new_obj(digitalio_port_obj_t);
+    self->base.type = &digitalio_port_type;
+    common_hal_digitalio_port_construct(self, pins, pin_count, strobe);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Turn off the Port and release its pins for other use.
+//|
+STATIC mp_obj_t digitalio_port_obj_deinit(mp_obj_t self_in) {
+    digitalio_port_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_digitalio_port_deinit(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(digitalio_port_deinit_obj, digitalio_port_obj_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t digitalio_port_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_digitalio_port_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(digitalio_port_obj___exit___obj, 4, 4, digitalio_port_obj___exit__);
+
+//|   .. method:: write(buffer)
+//|
+//|      Put each value of ``buffer`` on the pins in turn, pulsing ``strobe`` low around each one
+//|      if there is a strobe pin. The Port must be an output. ``bytes`` and ``bytearray`` give
+//|      8 bits per value, an ``array`` of 16 or 32 bit integers gives wider values.
+//|
+//|      :param bytearray buffer: Values to write
+//|
+STATIC mp_obj_t digitalio_port_obj_write(mp_obj_t self_in, mp_obj_t buffer) {
+    digitalio_port_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_digitalio_port_deinited(self));
+    if (!common_hal_digitalio_port_is_output(self)) {
+        mp_raise_AttributeError(translate("Cannot set value when direction is input."));
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_READ);
+    size_t itemsize = mp_binary_get_size('@', bufinfo.typecode, NULL);
+    if (itemsize != 1 && itemsize != 2 && itemsize != 4) {
+        mp_raise_ValueError(translate("buffer must be a bytes-like object"));
+    }
+    common_hal_digitalio_port_write(self, bufinfo.buf, bufinfo.len / itemsize, itemsize);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(digitalio_port_write_obj, digitalio_port_obj_write);
+
+//|   .. attribute:: direction
+//|
+//|     The direction of every pin of the port. Switching to output drives all of the pins low,
+//|     switching to input leaves them with no pull.
+//|
+STATIC mp_obj_t digitalio_port_obj_get_direction(mp_obj_t self_in) {
+    digitalio_port_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_digitalio_port_deinited(self));
+    if (common_hal_digitalio_port_is_output(self)) {
+        return (mp_obj_t)&digitalio_direction_output_obj;
+    }
+    return (mp_obj_t)&digitalio_direction_input_obj;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(digitalio_port_get_direction_obj, digitalio_port_obj_get_direction);
+
+STATIC mp_obj_t digitalio_port_obj_set_direction(mp_obj_t self_in, mp_obj_t value) {
+    digitalio_port_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_digitalio_port_deinited(self));
+    if (value == &digitalio_direction_input_obj) {
+        common_hal_digitalio_port_switch_to_input(self);
+    } else if (value == &digitalio_direction_output_obj) {
+        common_hal_digitalio_port_switch_to_output(self, 0);
+    } else {
+        mp_raise_ValueError(translate("Invalid direction."));
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(digitalio_port_set_direction_obj, digitalio_port_obj_set_direction);
+
+const mp_obj_property_t digitalio_port_direction_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&digitalio_port_get_direction_obj,
+              (mp_obj_t)&digitalio_port_set_direction_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: value
+//|
+//|     The pins as an integer, with ``pins[0]`` as bit 0. Bits beyond the last pin are ignored
+//|     when setting.
+//|
+STATIC mp_obj_t digitalio_port_obj_get_value(mp_obj_t self_in) {
+    digitalio_port_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_digitalio_port_deinited(self));
+    return mp_obj_new_int_from_uint(common_hal_digitalio_port_get_value(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(digitalio_port_get_value_obj, digitalio_port_obj_get_value);
+
+STATIC mp_obj_t digitalio_port_obj_set_value(mp_obj_t self_in, mp_obj_t value) {
+    digitalio_port_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_digitalio_port_deinited(self));
+    if (!common_hal_digitalio_port_is_output(self)) {
+        mp_raise_AttributeError(translate("Cannot set value when direction is input."));
+    }
+    common_hal_digitalio_port_set_value(self, mp_obj_get_int_truncated(value));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(digitalio_port_set_value_obj, digitalio_port_obj_set_value);
+
+const mp_obj_property_t digitalio_port_value_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&digitalio_port_get_value_obj,
+              (mp_obj_t)&digitalio_port_set_value_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t digitalio_port_locals_dict_table[] = {
+    // instance methods
+    { MP_ROM_QSTR(MP_QSTR_deinit),    MP_ROM_PTR(&digitalio_port_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__),  MP_ROM_PTR(&digitalio_port_obj___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_write),     MP_ROM_PTR(&digitalio_port_write_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_direction), MP_ROM_PTR(&digitalio_port_direction_obj) },
+    { MP_ROM_QSTR(MP_QSTR_value),     MP_ROM_PTR(&digitalio_port_value_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(digitalio_port_locals_dict, digitalio_port_locals_dict_table);
+
+const mp_obj_type_t digitalio_port_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Port,
+    .make_new = digitalio_port_make_new,
+    .locals_dict = (mp_obj_dict_t*)&digitalio_port_locals_dict,
+};
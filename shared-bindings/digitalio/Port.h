@@ -0,0 +1,46 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORT_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORT_H
+
+#include "shared-module/digitalio/Port.h"
+
+extern const mp_obj_type_t digitalio_port_type;
+
+extern void common_hal_digitalio_port_construct(digitalio_port_obj_t* self,
+    const mcu_pin_obj_t** pins, uint8_t pin_count, const mcu_pin_obj_t* strobe);
+extern void common_hal_digitalio_port_deinit(digitalio_port_obj_t* self);
+extern bool common_hal_digitalio_port_deinited(digitalio_port_obj_t* self);
+extern void common_hal_digitalio_port_switch_to_input(digitalio_port_obj_t* self);
+extern void common_hal_digitalio_port_switch_to_output(digitalio_port_obj_t* self, uint32_t value);
+extern bool common_hal_digitalio_port_is_output(digitalio_port_obj_t* self);
+extern uint32_t common_hal_digitalio_port_get_value(digitalio_port_obj_t* self);
+extern void common_hal_digitalio_port_set_value(digitalio_port_obj_t* self, uint32_t value);
+extern void common_hal_digitalio_port_write(digitalio_port_obj_t* self,
+    const uint8_t* data, size_t len, size_t itemsize);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_DIGITALIO_PORT_H
@@ -34,6 +34,7 @@
 #include "shared-bindings/digitalio/DigitalInOut.h"
 #include "shared-bindings/digitalio/Direction.h"
 #include "shared-bindings/digitalio/DriveMode.h"
+#include "shared-bindings/digitalio/Port.h"
 #include "shared-bindings/digitalio/Pull.h"
 
 #include "py/runtime.h"
@@ -55,6 +56,7 @@
 //|     DigitalInOut
 //|     Direction
 //|     DriveMode
+//|     Port
 //|     Pull
 //|
 //| All classes change hardware state and should be deinitialized when they
@@ -92,6 +94,7 @@
 STATIC const mp_rom_map_elem_t digitalio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_digitalio) },
     { MP_ROM_QSTR(MP_QSTR_DigitalInOut),  MP_ROM_PTR(&digitalio_digitalinout_type) },
+    { MP_ROM_QSTR(MP_QSTR_Port),          MP_ROM_PTR(&digitalio_port_type) },
 
     // Enum-like Classes.
     { MP_ROM_QSTR(MP_QSTR_Direction),          MP_ROM_PTR(&digitalio_direction_type) },
@@ -30,6 +30,7 @@
 
 #include "lib/utils/context_manager_helpers.h"
 #include "py/binary.h"
+#include "py/objtuple.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
 #include "shared-bindings/microcontroller/Pin.h"
@@ -115,23 +116,33 @@ const mp_obj_property_t displayio_bitmap_height_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+STATIC uint32_t validate_value(displayio_bitmap_t *self, mp_int_t value) {
+    uint32_t bits_per_value = common_hal_displayio_bitmap_get_bits_per_value(self);
+    if (value < 0 || (bits_per_value < 32 && (uint32_t) value >> bits_per_value != 0)) {
+        mp_raise_ValueError(translate("pixel value requires too many bits"));
+    }
+    return value;
+}
+
 //|   .. method:: __getitem__(index)
 //|
 //|     Returns the value at the given index. The index can either be an x,y tuple or an int equal
-//|     to ``y * width + x``.
+//|     to ``y * width + x``. A slice of int indices returns a tuple of the values.
 //|
 //|     This allows you to::
 //|
 //|       print(bitmap[0,1])
+//|       first_row = bitmap[0:bitmap.width]
 //|
 //|   .. method:: __setitem__(index, value)
 //|
 //|     Sets the value at the given index. The index can either be an x,y tuple or an int equal
-//|     to ``y * width + x``.
+//|     to ``y * width + x``. A slice of int indices is set from a tuple or list of values.
 //|
 //|     This allows you to::
 //|
 //|       bitmap[0,1] = 3
+//|       bitmap[0:4] = (1, 2, 3, 4)
 //|
 STATIC mp_obj_t bitmap_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t value_obj) {
     if (value_obj == mp_const_none) {
@@ -142,17 +153,61 @@ STATIC mp_obj_t bitmap_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t val
 
     displayio_bitmap_t *self = MP_OBJ_TO_PTR(self_in);
 
+    uint16_t width = common_hal_displayio_bitmap_get_width(self);
+    uint16_t height = common_hal_displayio_bitmap_get_height(self);
     if (MP_OBJ_IS_TYPE(index_obj, &mp_type_slice)) {
-        // TODO(tannewt): Implement subscr after slices support start, stop and step tuples.
-        mp_raise_NotImplementedError(translate("Slices not supported"));
-        return mp_const_none;
+        // TODO(tannewt): Support x,y slices after slices support start, stop and step tuples.
+        mp_bound_slice_t slice;
+        if (!mp_seq_get_fast_slice_indexes(width * height, index_obj, &slice)) {
+            mp_raise_NotImplementedError(translate("Only slices with step=1 (aka None) are supported"));
+        }
+        size_t len = slice.stop - slice.start;
+        mp_obj_t *items = NULL;
+        mp_obj_t result = mp_const_none;
+        if (value_obj == MP_OBJ_SENTINEL) {
+            result = mp_obj_new_tuple(len, NULL);
+            items = ((mp_obj_tuple_t*) MP_OBJ_TO_PTR(result))->items;
+        } else {
+            if (!MP_OBJ_IS_TYPE(value_obj, &mp_type_list) && !MP_OBJ_IS_TYPE(value_obj, &mp_type_tuple)) {
+                mp_raise_ValueError(translate("tuple/list required on RHS"));
+            }
+            size_t num_items;
+            mp_obj_get_array(value_obj, &num_items, &items);
+            if (num_items != len) {
+                mp_raise_ValueError_varg(translate("Unmatched number of items on RHS (expected %d, got %d)."),
+                                         len, num_items);
+            }
+        }
+        // Move values a row segment at a time through a small buffer.
+        uint32_t values[32];
+        size_t i = 0;
+        while (i < len) {
+            uint16_t x = (slice.start + i) % width;
+            uint16_t y = (slice.start + i) / width;
+            uint16_t count = MIN(MIN((size_t) (width - x), len - i), MP_ARRAY_SIZE(values));
+            if (value_obj == MP_OBJ_SENTINEL) {
+                common_hal_displayio_bitmap_get_row(self, x, y, values, count);
+                for (uint16_t j = 0; j < count; j++) {
+                    items[i + j] = MP_OBJ_NEW_SMALL_INT(values[j]);
+                }
+            } else {
+                for (uint16_t j = 0; j < count; j++) {
+                    values[j] = validate_value(self, mp_obj_get_int(items[i + j]));
+                }
+                common_hal_displayio_bitmap_set_row(self, x, y, values, count);
+            }
+            i += count;
+        }
+        return result;
     }
 
     uint16_t x = 0;
     uint16_t y = 0;
     if (MP_OBJ_IS_SMALL_INT(index_obj)) {
         mp_int_t i = MP_OBJ_SMALL_INT_VALUE(index_obj);
-        uint16_t width = common_hal_displayio_bitmap_get_width(self);
+        if (i < 0 || i >= width * height) {
+            mp_raise_IndexError(translate("pixel coordinates out of bounds"));
+        }
         x = i % width;
         y = i / width;
     } else {
@@ -160,7 +215,7 @@ STATIC mp_obj_t bitmap_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t val
         mp_obj_get_array_fixed_n(index_obj, 2, &items);
         x = mp_obj_get_int(items[0]);
         y = mp_obj_get_int(items[1]);
-        if (x >= common_hal_displayio_bitmap_get_width(self) || y >= common_hal_displayio_bitmap_get_height(self)) {
+        if (x >= width || y >= height) {
             mp_raise_IndexError(translate("pixel coordinates out of bounds"));
         }
     }
@@ -178,9 +233,296 @@ STATIC mp_obj_t bitmap_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t val
     return mp_const_none;
 }
 
+//|   .. method:: fill(value)
+//|
+//|     Sets every value in the bitmap to ``value`` with a single native call.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_fill(mp_obj_t self_in, mp_obj_t value_obj) {
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    common_hal_displayio_bitmap_fill(self, validate_value(self, mp_obj_get_int(value_obj)));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(displayio_bitmap_fill_obj, displayio_bitmap_obj_fill);
+
+//|   .. method:: fill_region(x1, y1, x2, y2, value)
+//|
+//|     Sets the values in the rectangle from ``x1``, ``y1`` up to but not including ``x2``, ``y2``
+//|     to ``value``. The rectangle is clipped to the bitmap.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_fill_region(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x1, ARG_y1, ARG_x2, ARG_y2, ARG_value };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_x2, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y2, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_value, MP_ARG_REQUIRED | MP_ARG_INT },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    uint32_t value = validate_value(self, args[ARG_value].u_int);
+    common_hal_displayio_bitmap_fill_region(self, args[ARG_x1].u_int, args[ARG_y1].u_int,
+        args[ARG_x2].u_int, args[ARG_y2].u_int, value);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(displayio_bitmap_fill_region_obj, 1, displayio_bitmap_obj_fill_region);
+
+//|   .. method:: blit(x, y, source, x1=0, y1=0, x2=source.width, y2=source.height, *, skip_index=None)
+//|
+//|     Copies the rectangle of ``source`` from ``x1``, ``y1`` up to but not including ``x2``,
+//|     ``y2`` into this bitmap with its top left corner at ``x``, ``y``. Values equal to
+//|     ``skip_index`` are left unchanged in this bitmap so that it can act as a transparent index.
+//|     The source may be this bitmap and the rectangles may overlap.
+//|
+//|     :param int x: Horizontal position in this bitmap to copy to
+//|     :param int y: Vertical position in this bitmap to copy to
+//|     :param Bitmap source: The bitmap to copy from
+//|     :param int skip_index: Source value to not copy or None to copy everything
+//|
+STATIC mp_obj_t displayio_bitmap_obj_blit(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x, ARG_y, ARG_source, ARG_x1, ARG_y1, ARG_x2, ARG_y2, ARG_skip_index };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_source, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_x1, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_y1, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_x2, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_y2, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_skip_index, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    if (!MP_OBJ_IS_TYPE(args[ARG_source].u_obj, &displayio_bitmap_type)) {
+        mp_raise_TypeError_varg(translate("unsupported %q type"), MP_QSTR_source);
+    }
+    displayio_bitmap_t *source = MP_OBJ_TO_PTR(args[ARG_source].u_obj);
+
+    mp_int_t x2 = common_hal_displayio_bitmap_get_width(source);
+    if (args[ARG_x2].u_obj != mp_const_none) {
+        x2 = mp_obj_get_int(args[ARG_x2].u_obj);
+    }
+    mp_int_t y2 = common_hal_displayio_bitmap_get_height(source);
+    if (args[ARG_y2].u_obj != mp_const_none) {
+        y2 = mp_obj_get_int(args[ARG_y2].u_obj);
+    }
+    bool skip = args[ARG_skip_index].u_obj != mp_const_none;
+    uint32_t skip_index = 0;
+    if (skip) {
+        skip_index = mp_obj_get_int(args[ARG_skip_index].u_obj);
+    }
+
+    common_hal_displayio_bitmap_blit(self, args[ARG_x].u_int, args[ARG_y].u_int, source,
+        args[ARG_x1].u_int, args[ARG_y1].u_int, x2, y2, skip, skip_index);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(displayio_bitmap_blit_obj, 1, displayio_bitmap_obj_blit);
+
+//|   .. method:: draw_line(x1, y1, x2, y2, value)
+//|
+//|     Sets the values on the line from ``x1``, ``y1`` to ``x2``, ``y2``, including both ends, to
+//|     ``value``. The line is clipped to the bitmap.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_draw_line(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x1, ARG_y1, ARG_x2, ARG_y2, ARG_value };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_x2, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y2, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_value, MP_ARG_REQUIRED | MP_ARG_INT },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    uint32_t value = validate_value(self, args[ARG_value].u_int);
+    common_hal_displayio_bitmap_draw_line(self, args[ARG_x1].u_int, args[ARG_y1].u_int,
+        args[ARG_x2].u_int, args[ARG_y2].u_int, value);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(displayio_bitmap_draw_line_obj, 1, displayio_bitmap_obj_draw_line);
+
+//|   .. method:: fill_polygon(points, value)
+//|
+//|     Sets the values inside the polygon to ``value``. ``points`` is a list or tuple of ``(x, y)``
+//|     corners and the last one is connected back to the first. A value is inside when the center
+//|     of its pixel is, using the even-odd rule for polygons that cross themselves. The polygon is
+//|     clipped to the bitmap.
+//|
+//|     This allows you to::
+//|
+//|       bitmap.fill_polygon(((10, 0), (20, 20), (0, 20)), 1)
+//|
+STATIC mp_obj_t displayio_bitmap_obj_fill_polygon(mp_obj_t self_in, mp_obj_t points_obj, mp_obj_t value_obj) {
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(self_in);
+    uint32_t value = validate_value(self, mp_obj_get_int(value_obj));
+
+    size_t count;
+    mp_obj_t* points;
+    mp_obj_get_array(points_obj, &count, &points);
+    int16_t* xs = m_new(int16_t, 2 * count);
+    int16_t* ys = xs + count;
+    for (size_t i = 0; i < count; i++) {
+        mp_obj_t* point;
+        mp_obj_get_array_fixed_n(points[i], 2, &point);
+        xs[i] = mp_obj_get_int(point[0]);
+        ys[i] = mp_obj_get_int(point[1]);
+    }
+    common_hal_displayio_bitmap_fill_polygon(self, xs, ys, count, value);
+    m_del(int16_t, xs, 2 * count);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(displayio_bitmap_fill_polygon_obj, displayio_bitmap_obj_fill_polygon);
+
+//|   .. method:: pixel(x, y, value=None)
+//|
+//|     Returns the value at ``x``, ``y`` or sets it to ``value`` when one is given. Coordinates
+//|     outside the bitmap are ignored and return None.
+//|
+//|   The methods below match those of ``framebuf.FrameBuffer`` so that code drawing into a frame
+//|   buffer can draw straight into a Bitmap instead. Only ``blit`` differs, as described above.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_pixel(size_t n_args, const mp_obj_t *args) {
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t x = mp_obj_get_int(args[1]);
+    mp_int_t y = mp_obj_get_int(args[2]);
+    if (x < 0 || x >= common_hal_displayio_bitmap_get_width(self) ||
+        y < 0 || y >= common_hal_displayio_bitmap_get_height(self)) {
+        return mp_const_none;
+    }
+    if (n_args == 3 || args[3] == mp_const_none) {
+        return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_bitmap_get_pixel(self, x, y));
+    }
+    common_hal_displayio_bitmap_set_pixel(self, x, y, validate_value(self, mp_obj_get_int(args[3])));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_bitmap_pixel_obj, 3, 4, displayio_bitmap_obj_pixel);
+
+// Fills the rectangle with its top left corner at args[0], args[1] that is width wide and height
+// high.
+STATIC void fill_rect(displayio_bitmap_t *self, const mp_obj_t *args, mp_int_t width, mp_int_t height, mp_obj_t value_obj) {
+    mp_int_t x = mp_obj_get_int(args[0]);
+    mp_int_t y = mp_obj_get_int(args[1]);
+    uint32_t value = validate_value(self, mp_obj_get_int(value_obj));
+    common_hal_displayio_bitmap_fill_region(self, x, y, x + width, y + height, value);
+}
+
+//|   .. method:: fill_rect(x, y, width, height, value)
+//|
+//|     Sets the values in the ``width`` by ``height`` rectangle with its top left corner at ``x``,
+//|     ``y`` to ``value``.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_fill_rect(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    fill_rect(MP_OBJ_TO_PTR(args[0]), args + 1, mp_obj_get_int(args[3]), mp_obj_get_int(args[4]), args[5]);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_bitmap_fill_rect_obj, 6, 6, displayio_bitmap_obj_fill_rect);
+
+//|   .. method:: hline(x, y, width, value)
+//|
+//|     Sets the ``width`` values starting at ``x``, ``y`` and going right to ``value``.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_hline(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    fill_rect(MP_OBJ_TO_PTR(args[0]), args + 1, mp_obj_get_int(args[3]), 1, args[4]);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_bitmap_hline_obj, 5, 5, displayio_bitmap_obj_hline);
+
+//|   .. method:: vline(x, y, height, value)
+//|
+//|     Sets the ``height`` values starting at ``x``, ``y`` and going down to ``value``.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_vline(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    fill_rect(MP_OBJ_TO_PTR(args[0]), args + 1, 1, mp_obj_get_int(args[3]), args[4]);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_bitmap_vline_obj, 5, 5, displayio_bitmap_obj_vline);
+
+//|   .. method:: rect(x, y, width, height, value)
+//|
+//|     Sets the values on the outline of the rectangle given like `fill_rect` to ``value``.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_rect(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t x = mp_obj_get_int(args[1]);
+    mp_int_t y = mp_obj_get_int(args[2]);
+    mp_int_t width = mp_obj_get_int(args[3]);
+    mp_int_t height = mp_obj_get_int(args[4]);
+    uint32_t value = validate_value(self, mp_obj_get_int(args[5]));
+    if (width <= 0 || height <= 0) {
+        return mp_const_none;
+    }
+    common_hal_displayio_bitmap_fill_region(self, x, y, x + width, y + 1, value);
+    common_hal_displayio_bitmap_fill_region(self, x, y + height - 1, x + width, y + height, value);
+    common_hal_displayio_bitmap_fill_region(self, x, y + 1, x + 1, y + height - 1, value);
+    common_hal_displayio_bitmap_fill_region(self, x + width - 1, y + 1, x + width, y + height - 1, value);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_bitmap_rect_obj, 6, 6, displayio_bitmap_obj_rect);
+
+//|   .. method:: line(x1, y1, x2, y2, value)
+//|
+//|     The same as `draw_line`.
+//|
+//|   .. method:: scroll(dx, dy)
+//|
+//|     Moves the contents right by ``dx`` and down by ``dy``, which may be negative. The values
+//|     uncovered at the edges are left unchanged.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_scroll(mp_obj_t self_in, mp_obj_t dx_obj, mp_obj_t dy_obj) {
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_displayio_bitmap_scroll(self, mp_obj_get_int(dx_obj), mp_obj_get_int(dy_obj));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(displayio_bitmap_scroll_obj, displayio_bitmap_obj_scroll);
+
+//|   .. method:: text(string, x, y, value=1)
+//|
+//|     Draws ``string`` in the same 8x8 pixel font as ``framebuf`` with its top left corner at
+//|     ``x``, ``y``. The pixels of each character are set to ``value`` and the rest are left
+//|     unchanged. Characters outside of ASCII are drawn as a box.
+//|
+STATIC mp_obj_t displayio_bitmap_obj_text(size_t n_args, const mp_obj_t *args) {
+    displayio_bitmap_t *self = MP_OBJ_TO_PTR(args[0]);
+    size_t len;
+    const char *text = mp_obj_str_get_data(args[1], &len);
+    mp_int_t x = mp_obj_get_int(args[2]);
+    mp_int_t y = mp_obj_get_int(args[3]);
+    uint32_t value = 1;
+    if (n_args > 4) {
+        value = validate_value(self, mp_obj_get_int(args[4]));
+    }
+    common_hal_displayio_bitmap_draw_text(self, x, y, (const uint8_t*) text, len, value);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_bitmap_text_obj, 4, 5, displayio_bitmap_obj_text);
+
 STATIC const mp_rom_map_elem_t displayio_bitmap_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_bitmap_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_bitmap_width_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&displayio_bitmap_fill_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_region), MP_ROM_PTR(&displayio_bitmap_fill_region_obj) },
+    { MP_ROM_QSTR(MP_QSTR_blit), MP_ROM_PTR(&displayio_bitmap_blit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_draw_line), MP_ROM_PTR(&displayio_bitmap_draw_line_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_polygon), MP_ROM_PTR(&displayio_bitmap_fill_polygon_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pixel), MP_ROM_PTR(&displayio_bitmap_pixel_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_rect), MP_ROM_PTR(&displayio_bitmap_fill_rect_obj) },
+    { MP_ROM_QSTR(MP_QSTR_hline), MP_ROM_PTR(&displayio_bitmap_hline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_vline), MP_ROM_PTR(&displayio_bitmap_vline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rect), MP_ROM_PTR(&displayio_bitmap_rect_obj) },
+    { MP_ROM_QSTR(MP_QSTR_line), MP_ROM_PTR(&displayio_bitmap_draw_line_obj) },
+    { MP_ROM_QSTR(MP_QSTR_scroll), MP_ROM_PTR(&displayio_bitmap_scroll_obj) },
+    { MP_ROM_QSTR(MP_QSTR_text), MP_ROM_PTR(&displayio_bitmap_text_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(displayio_bitmap_locals_dict, displayio_bitmap_locals_dict_table);
 
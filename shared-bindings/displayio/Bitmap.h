@@ -34,12 +34,27 @@ extern const mp_obj_type_t displayio_bitmap_type;
 void common_hal_displayio_bitmap_construct(displayio_bitmap_t *self, uint32_t width,
     uint32_t height, uint32_t bits_per_value);
 
-void common_hal_displayio_bitmap_load_row(displayio_bitmap_t *self, uint16_t y, uint8_t* data,
-                                          uint16_t len);
 uint16_t common_hal_displayio_bitmap_get_height(displayio_bitmap_t *self);
 uint16_t common_hal_displayio_bitmap_get_width(displayio_bitmap_t *self);
 uint32_t common_hal_displayio_bitmap_get_bits_per_value(displayio_bitmap_t *self);
 void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *bitmap, int16_t x, int16_t y, uint32_t value);
 uint32_t common_hal_displayio_bitmap_get_pixel(displayio_bitmap_t *bitmap, int16_t x, int16_t y);
+// Reads or writes count consecutive values of row y starting at x with one call.
+void common_hal_displayio_bitmap_get_row(displayio_bitmap_t *bitmap, int16_t x, int16_t y, uint32_t* values, uint16_t count);
+void common_hal_displayio_bitmap_set_row(displayio_bitmap_t *bitmap, int16_t x, int16_t y, const uint32_t* values, uint16_t count);
+// Region operations clip to the bitmap and mark only the changed area dirty. x2 and y2 are
+// exclusive.
+void common_hal_displayio_bitmap_fill(displayio_bitmap_t *bitmap, uint32_t value);
+void common_hal_displayio_bitmap_fill_region(displayio_bitmap_t *bitmap, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t value);
+void common_hal_displayio_bitmap_blit(displayio_bitmap_t *bitmap, int16_t x, int16_t y, displayio_bitmap_t *source,
+    int16_t x1, int16_t y1, int16_t x2, int16_t y2, bool skip, uint32_t skip_index);
+// Lines include both end points. Polygons are filled using the even-odd rule and include the
+// pixels whose centers are inside.
+void common_hal_displayio_bitmap_draw_line(displayio_bitmap_t *bitmap, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t value);
+void common_hal_displayio_bitmap_fill_polygon(displayio_bitmap_t *bitmap, const int16_t* xs, const int16_t* ys, size_t count, uint32_t value);
+// Moves the contents by dx, dy. The values uncovered at the edges are left unchanged.
+void common_hal_displayio_bitmap_scroll(displayio_bitmap_t *bitmap, int16_t dx, int16_t dy);
+// Draws text with the 8x8 framebuf font, setting the glyph pixels to value and leaving the rest.
+void common_hal_displayio_bitmap_draw_text(displayio_bitmap_t *bitmap, int16_t x, int16_t y, const uint8_t* text, size_t len, uint32_t value);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_BITMAP_H
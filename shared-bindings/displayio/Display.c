@@ -33,6 +33,7 @@
 #include "py/objproperty.h"
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Group.h"
+#include "shared-bindings/displayio/RefreshStats.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/util.h"
 #include "shared-module/displayio/__init__.h"
@@ -212,6 +213,10 @@ MP_DEFINE_CONST_FUN_OBJ_1(displayio_display_refresh_soon_obj, displayio_display_
 //|     Waits until the next frame has been transmitted to the display unless the wait count is
 //|     behind the rendered frames. In that case, this will return immediately with the wait count.
 //|
+//|     Position, scale and ``top_left`` changes to Groups and TileGrids are latched and applied
+//|     together at the start of the next frame. Making all of the changes for a frame right after
+//|     this returns ensures they show up in the same frame without tearing.
+//|
 STATIC mp_obj_t displayio_display_obj_wait_for_frame(mp_obj_t self_in) {
     displayio_display_obj_t *self = native_display(self_in);
     return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_display_wait_for_frame(self));
@@ -281,6 +286,107 @@ const mp_obj_property_t displayio_display_auto_brightness_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: refresh_time_slice
+//|
+//|     The longest time, in microseconds, that a refresh renders before letting other background
+//|     tasks such as USB and audio run. Larger refreshes continue where they left off the next
+//|     time background tasks run. 0 renders each refresh in one go.
+//|
+STATIC mp_obj_t displayio_display_obj_get_refresh_time_slice(mp_obj_t self_in) {
+    displayio_display_obj_t *self = native_display(self_in);
+    return mp_obj_new_int_from_uint(common_hal_displayio_display_get_refresh_time_slice(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_display_get_refresh_time_slice_obj, displayio_display_obj_get_refresh_time_slice);
+
+STATIC mp_obj_t displayio_display_obj_set_refresh_time_slice(mp_obj_t self_in, mp_obj_t microseconds_obj) {
+    displayio_display_obj_t *self = native_display(self_in);
+    mp_int_t microseconds = mp_obj_get_int(microseconds_obj);
+    if (microseconds < 0) {
+        mp_raise_ValueError_varg(translate("%q must be >= 0"), MP_QSTR_refresh_time_slice);
+    }
+    common_hal_displayio_display_set_refresh_time_slice(self, microseconds);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(displayio_display_set_refresh_time_slice_obj, displayio_display_obj_set_refresh_time_slice);
+
+const mp_obj_property_t displayio_display_refresh_time_slice_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_display_get_refresh_time_slice_obj,
+              (mp_obj_t)&displayio_display_set_refresh_time_slice_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: hardware_scroll
+//|
+//|     True when TileGrids that scroll vertically across the full height of the display are
+//|     scrolled with the display's ``set_vertical_scroll`` command instead of being redrawn. Only
+//|     the newly revealed rows are sent. Defaults to False.
+//|
+//|     This requires a display with no rotation or mirroring whose scroll area covers exactly
+//|     ``height`` rows of its memory starting at row 0. While scrolled, the memory rows no longer
+//|     line up with the display, so anything else writing to the display directly sees them
+//|     shifted. Setting it to False puts the memory back in place.
+//|
+STATIC mp_obj_t displayio_display_obj_get_hardware_scroll(mp_obj_t self_in) {
+    displayio_display_obj_t *self = native_display(self_in);
+    return mp_obj_new_bool(common_hal_displayio_display_get_hardware_scroll(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_display_get_hardware_scroll_obj, displayio_display_obj_get_hardware_scroll);
+
+STATIC mp_obj_t displayio_display_obj_set_hardware_scroll(mp_obj_t self_in, mp_obj_t hardware_scroll) {
+    displayio_display_obj_t *self = native_display(self_in);
+    if (!common_hal_displayio_display_set_hardware_scroll(self, mp_obj_is_true(hardware_scroll))) {
+        mp_raise_ValueError(translate("Hardware scrolling not supported by this display"));
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(displayio_display_set_hardware_scroll_obj, displayio_display_obj_set_hardware_scroll);
+
+const mp_obj_property_t displayio_display_hardware_scroll_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_display_get_hardware_scroll_obj,
+              (mp_obj_t)&displayio_display_set_hardware_scroll_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: refresh_stats
+//|
+//|     A `RefreshStats` describing what the most recently finished refresh cost. Use it to tune
+//|     layouts and refresh settings. (read only)
+//|
+STATIC mp_obj_t displayio_display_obj_get_refresh_stats(mp_obj_t self_in) {
+    displayio_display_obj_t *self = native_display(self_in);
+    const displayio_refresh_stats_t* stats = common_hal_displayio_display_get_refresh_stats(self);
+    mp_obj_t dirty_area = mp_const_none;
+    if (!displayio_area_empty(&stats->dirty_area)) {
+        mp_obj_t corners[4] = {
+            MP_OBJ_NEW_SMALL_INT(stats->dirty_area.x1),
+            MP_OBJ_NEW_SMALL_INT(stats->dirty_area.y1),
+            MP_OBJ_NEW_SMALL_INT(stats->dirty_area.x2),
+            MP_OBJ_NEW_SMALL_INT(stats->dirty_area.y2)
+        };
+        dirty_area = mp_obj_new_tuple(4, corners);
+    }
+    mp_obj_t fields[7] = {
+        mp_obj_new_int_from_uint(stats->refresh_us),
+        mp_obj_new_int_from_uint(stats->render_us),
+        mp_obj_new_int_from_uint(stats->transmit_us),
+        mp_obj_new_int_from_uint(stats->pixels_rendered),
+        mp_obj_new_int_from_uint(stats->pixels_sent),
+        MP_OBJ_NEW_SMALL_INT(stats->bus_busy),
+        dirty_area
+    };
+    return namedtuple_make_new((const mp_obj_type_t*) &displayio_refresh_stats_type, 7, fields, NULL);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_display_get_refresh_stats_obj, displayio_display_obj_get_refresh_stats);
+
+const mp_obj_property_t displayio_display_refresh_stats_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_display_get_refresh_stats_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 //|   .. attribute:: width
 //|
 //|	Gets the width of the board
@@ -343,6 +449,9 @@ STATIC const mp_rom_map_elem_t displayio_display_locals_dict_table[] = {
 
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&displayio_display_brightness_obj) },
     { MP_ROM_QSTR(MP_QSTR_auto_brightness), MP_ROM_PTR(&displayio_display_auto_brightness_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_time_slice), MP_ROM_PTR(&displayio_display_refresh_time_slice_obj) },
+    { MP_ROM_QSTR(MP_QSTR_hardware_scroll), MP_ROM_PTR(&displayio_display_hardware_scroll_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_stats), MP_ROM_PTR(&displayio_display_refresh_stats_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_display_width_obj) },
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_display_height_obj) },
@@ -58,7 +58,15 @@ bool displayio_display_frame_queued(displayio_display_obj_t* self);
 
 bool displayio_display_refresh_queued(displayio_display_obj_t* self);
 void displayio_display_finish_refresh(displayio_display_obj_t* self);
-void displayio_display_send_pixels(displayio_display_obj_t* self, uint32_t* pixels, uint32_t length);
+void displayio_display_send_pixels(displayio_display_obj_t* self, uint8_t* pixels, uint32_t length);
+
+const displayio_refresh_stats_t* common_hal_displayio_display_get_refresh_stats(displayio_display_obj_t* self);
+
+uint32_t common_hal_displayio_display_get_refresh_time_slice(displayio_display_obj_t* self);
+void common_hal_displayio_display_set_refresh_time_slice(displayio_display_obj_t* self, uint32_t microseconds);
+
+bool common_hal_displayio_display_get_hardware_scroll(displayio_display_obj_t* self);
+bool common_hal_displayio_display_set_hardware_scroll(displayio_display_obj_t* self, bool hardware_scroll);
 
 bool common_hal_displayio_display_get_auto_brightness(displayio_display_obj_t* self);
 void common_hal_displayio_display_set_auto_brightness(displayio_display_obj_t* self, bool auto_brightness);
@@ -42,6 +42,8 @@ void common_hal_displayio_fourwire_deinit(displayio_fourwire_obj_t* self);
 
 bool common_hal_displayio_fourwire_begin_transaction(mp_obj_t self);
 
+// Data, but not commands, may still be sending when this returns. It must stay unchanged until the
+// next send or the end of the transaction.
 void common_hal_displayio_fourwire_send(mp_obj_t self, bool command, uint8_t *data, uint32_t data_length);
 
 void common_hal_displayio_fourwire_end_transaction(mp_obj_t self);
@@ -73,22 +73,36 @@
 //|       while True:
 //|           pass
 //|
-//| .. class:: OnDiskBitmap(file)
+//| .. class:: OnDiskBitmap(file, *, cache_rows=1)
 //|
 //|   Create an OnDiskBitmap object with the given file.
 //|
 //|   :param file file: The open bitmap file
+//|   :param int cache_rows: The number of decoded rows to keep in memory. Each row takes four bytes
+//|     per pixel. Caching more rows reads the file in fewer, larger pieces.
 //|
 STATIC mp_obj_t displayio_ondiskbitmap_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    mp_arg_check_num(n_args, kw_args, 1, 1, false);
-
-    if (!MP_OBJ_IS_TYPE(pos_args[0], &mp_type_fileio)) {
+    enum { ARG_file, ARG_cache_rows };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_cache_rows, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t file = args[ARG_file].u_obj;
+    if (!MP_OBJ_IS_TYPE(file, &mp_type_vfs_fat_fileio)) {
         mp_raise_TypeError(translate("file must be a file opened in byte mode"));
     }
 
+    mp_int_t cache_rows = args[ARG_cache_rows].u_int;
+    if (cache_rows < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_cache_rows);
+    }
+
     displayio_ondiskbitmap_t *self = m_new_obj(displayio_ondiskbitmap_t);
     self->base.type = &displayio_ondiskbitmap_type;
-    common_hal_displayio_ondiskbitmap_construct(self, MP_OBJ_TO_PTR(pos_args[0]));
+    common_hal_displayio_ondiskbitmap_construct(self, MP_OBJ_TO_PTR(file), cache_rows);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -0,0 +1,196 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/RLEBitmap.h"
+
+#include <stdint.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: displayio
+//|
+//| :class:`RLEBitmap` -- A read-only Bitmap stored as runs of values
+//| ==========================================================================
+//|
+//| Stores 8-bit values compactly by keeping each run of equal values on a row as a single
+//| ``(count, value)`` pair. Flat backgrounds and simple art need a small fraction of the memory of a
+//| `Bitmap` of the same size. It can be used as the bitmap of a `TileGrid`.
+//|
+//| .. class:: RLEBitmap(width, height, data)
+//|
+//|   Create an RLEBitmap from run length encoded data. The data is used in place so it may live in
+//|   flash, for example as bytes in a frozen module. It must not change afterwards.
+//|
+//|   Each row is a sequence of two byte runs. The first byte is the number of pixels in the run,
+//|   from 1 to 255, and the second is their value. A row's runs must add up to exactly ``width``
+//|   and never continue onto the next row. Rows follow each other from the top.
+//|
+//|   Here is one way to encode rows of values:
+//|
+//|   .. code-block:: python
+//|
+//|     def encode(rows):
+//|         data = bytearray()
+//|         for row in rows:
+//|             x = 0
+//|             while x < len(row):
+//|                 count = 1
+//|                 while x + count < len(row) and row[x + count] == row[x] and count < 255:
+//|                     count += 1
+//|                 data += bytes((count, row[x]))
+//|                 x += count
+//|         return data
+//|
+//|   :param int width: The number of values wide
+//|   :param int height: The number of values high
+//|   :param buffer data: The runs of every row
+//|
+STATIC mp_obj_t displayio_rlebitmap_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_width, ARG_height, ARG_data };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_height, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_data, MP_ARG_REQUIRED | MP_ARG_OBJ },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t width = args[ARG_width].u_int;
+    if (width < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_width);
+    }
+    mp_int_t height = args[ARG_height].u_int;
+    if (height < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_height);
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_data].u_obj, &bufinfo, MP_BUFFER_READ);
+
+    displayio_rlebitmap_t *self = m_new_obj(displayio_rlebitmap_t);
+    self->base.type = &displayio_rlebitmap_type;
+    common_hal_displayio_rlebitmap_construct(self, width, height, args[ARG_data].u_obj,
+        bufinfo.buf, bufinfo.len);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. attribute:: width
+//|
+//|      Width of the bitmap. (read only)
+//|
+STATIC mp_obj_t displayio_rlebitmap_obj_get_width(mp_obj_t self_in) {
+    displayio_rlebitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_rlebitmap_get_width(self));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_rlebitmap_get_width_obj, displayio_rlebitmap_obj_get_width);
+
+const mp_obj_property_t displayio_rlebitmap_width_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_rlebitmap_get_width_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: height
+//|
+//|      Height of the bitmap. (read only)
+//|
+STATIC mp_obj_t displayio_rlebitmap_obj_get_height(mp_obj_t self_in) {
+    displayio_rlebitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_rlebitmap_get_height(self));
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_rlebitmap_get_height_obj, displayio_rlebitmap_obj_get_height);
+
+const mp_obj_property_t displayio_rlebitmap_height_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_rlebitmap_get_height_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. method:: __getitem__(index)
+//|
+//|     Returns the value at the given index. The index can either be an x,y tuple or an int equal
+//|     to ``y * width + x``.
+//|
+//|     This allows you to::
+//|
+//|       print(bitmap[0,1])
+//|
+STATIC mp_obj_t rlebitmap_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t value_obj) {
+    if (value_obj == mp_const_none) {
+        // delete item
+        mp_raise_AttributeError(translate("Cannot delete values"));
+        return mp_const_none;
+    }
+    if (value_obj != MP_OBJ_SENTINEL) {
+        mp_raise_RuntimeError(translate("Read-only object"));
+    }
+    displayio_rlebitmap_t *self = MP_OBJ_TO_PTR(self_in);
+
+    uint16_t width = common_hal_displayio_rlebitmap_get_width(self);
+    uint16_t height = common_hal_displayio_rlebitmap_get_height(self);
+    uint16_t x = 0;
+    uint16_t y = 0;
+    if (MP_OBJ_IS_SMALL_INT(index_obj)) {
+        mp_int_t i = MP_OBJ_SMALL_INT_VALUE(index_obj);
+        if (i < 0 || i >= width * height) {
+            mp_raise_IndexError(translate("pixel coordinates out of bounds"));
+        }
+        x = i % width;
+        y = i / width;
+    } else {
+        mp_obj_t* items;
+        mp_obj_get_array_fixed_n(index_obj, 2, &items);
+        x = mp_obj_get_int(items[0]);
+        y = mp_obj_get_int(items[1]);
+        if (x >= width || y >= height) {
+            mp_raise_IndexError(translate("pixel coordinates out of bounds"));
+        }
+    }
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_rlebitmap_get_pixel(self, x, y));
+}
+
+STATIC const mp_rom_map_elem_t displayio_rlebitmap_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_rlebitmap_height_obj) },
+    { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_rlebitmap_width_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(displayio_rlebitmap_locals_dict, displayio_rlebitmap_locals_dict_table);
+
+const mp_obj_type_t displayio_rlebitmap_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_RLEBitmap,
+    .make_new = displayio_rlebitmap_make_new,
+    .subscr = rlebitmap_subscr,
+    .locals_dict = (mp_obj_dict_t*)&displayio_rlebitmap_locals_dict,
+};
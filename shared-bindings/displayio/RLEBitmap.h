@@ -0,0 +1,41 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_RLEBITMAP_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_RLEBITMAP_H
+
+#include "shared-module/displayio/RLEBitmap.h"
+
+extern const mp_obj_type_t displayio_rlebitmap_type;
+
+void common_hal_displayio_rlebitmap_construct(displayio_rlebitmap_t *self, uint32_t width,
+    uint32_t height, mp_obj_t data_obj, const uint8_t* data, size_t data_len);
+
+uint32_t common_hal_displayio_rlebitmap_get_pixel(displayio_rlebitmap_t *self, int16_t x, int16_t y);
+uint16_t common_hal_displayio_rlebitmap_get_width(displayio_rlebitmap_t *self);
+uint16_t common_hal_displayio_rlebitmap_get_height(displayio_rlebitmap_t *self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_RLEBITMAP_H
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/RefreshStats.h"
+
+//| .. currentmodule:: displayio
+//|
+//| :class:`RefreshStats` -- What the last refresh of a Display cost
+//| ==========================================================================
+//|
+//| .. class:: RefreshStats(refresh_us, render_us, transmit_us, pixels_rendered, pixels_sent, bus_busy, dirty_area)
+//|
+//|   Named tuple returned by `Display.refresh_stats`. Times are in microseconds.
+//|
+//|   :param int refresh_us: from the start of the refresh until its last pixel was sent, including
+//|     time given to other tasks between time slices
+//|   :param int render_us: time spent rendering pixels
+//|   :param int transmit_us: time spent waiting on and writing to the display bus
+//|   :param int pixels_rendered: number of pixels rendered
+//|   :param int pixels_sent: number of pixels sent. Fewer than rendered when the bus was busy and
+//|     pixels had to be rendered again.
+//|   :param int bus_busy: number of times the display bus was in use so the refresh had to wait
+//|   :param tuple dirty_area: ``(x1, y1, x2, y2)`` bounding box of the areas that were refreshed or
+//|     None when nothing changed
+//|
+const mp_obj_namedtuple_type_t displayio_refresh_stats_type = {
+    .base = {
+        .base = {
+            .type = &mp_type_type
+        },
+        .name = MP_QSTR_RefreshStats,
+        .print = namedtuple_print,
+        .make_new = namedtuple_make_new,
+        .unary_op = mp_obj_tuple_unary_op,
+        .binary_op = mp_obj_tuple_binary_op,
+        .attr = namedtuple_attr,
+        .subscr = mp_obj_tuple_subscr,
+        .getiter = mp_obj_tuple_getiter,
+        .parent = &mp_type_tuple,
+    },
+    .n_fields = 7,
+    .fields = {
+        MP_QSTR_refresh_us,
+        MP_QSTR_render_us,
+        MP_QSTR_transmit_us,
+        MP_QSTR_pixels_rendered,
+        MP_QSTR_pixels_sent,
+        MP_QSTR_bus_busy,
+        MP_QSTR_dirty_area
+    },
+};
@@ -110,8 +110,61 @@ STATIC mp_obj_t displayio_shape_obj_set_boundary(size_t n_args, const mp_obj_t *
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio_shape_set_boundary_obj, 4, 4, displayio_shape_obj_set_boundary);
 
+//|   .. method:: rect(x1, y1, x2, y2)
+//|
+//|     Changes the shape to the filled rectangle from ``x1``, ``y1`` up to but not including
+//|     ``x2``, ``y2``. Every row is set with a single native call so the shape is cheap to resize
+//|     every frame. The rectangle is clipped to the shape. When mirrored, only the top and left
+//|     halves of the rectangle are stored.
+//|
+STATIC mp_obj_t displayio_shape_obj_rect(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x1, ARG_y1, ARG_x2, ARG_y2 };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_x2, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y2, MP_ARG_REQUIRED | MP_ARG_INT },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_shape_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    common_hal_displayio_shape_rect(self, args[ARG_x1].u_int, args[ARG_y1].u_int,
+        args[ARG_x2].u_int, args[ARG_y2].u_int);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(displayio_shape_rect_obj, 1, displayio_shape_obj_rect);
+
+//|   .. method:: circle(x, y, radius)
+//|
+//|     Changes the shape to the filled circle centered on ``x``, ``y``. The circle is clipped to
+//|     the shape. When mirrored, center the circle on the mirror lines so that the stored top left
+//|     quarter reproduces it.
+//|
+STATIC mp_obj_t displayio_shape_obj_circle(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x, ARG_y, ARG_radius };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_radius, MP_ARG_REQUIRED | MP_ARG_INT },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    displayio_shape_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_int_t radius = args[ARG_radius].u_int;
+    if (radius < 0) {
+        mp_raise_ValueError_varg(translate("%q must be >= 0"), MP_QSTR_radius);
+    }
+    common_hal_displayio_shape_circle(self, args[ARG_x].u_int, args[ARG_y].u_int, radius);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(displayio_shape_circle_obj, 1, displayio_shape_obj_circle);
+
 STATIC const mp_rom_map_elem_t displayio_shape_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_set_boundary), MP_ROM_PTR(&displayio_shape_set_boundary_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rect), MP_ROM_PTR(&displayio_shape_rect_obj) },
+    { MP_ROM_QSTR(MP_QSTR_circle), MP_ROM_PTR(&displayio_shape_circle_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(displayio_shape_locals_dict, displayio_shape_locals_dict_table);
 
@@ -36,6 +36,9 @@ void common_hal_displayio_shape_construct(displayio_shape_t *self, uint32_t widt
 
 void common_hal_displayio_shape_set_boundary(displayio_shape_t *self, uint16_t y, uint16_t start_x,
                                              uint16_t end_x);
+// Replace every row's boundary with the given shape. x2 and y2 are exclusive.
+void common_hal_displayio_shape_rect(displayio_shape_t *self, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+void common_hal_displayio_shape_circle(displayio_shape_t *self, int16_t x, int16_t y, uint16_t radius);
 uint32_t common_hal_displayio_shape_get_pixel(void *shape, int16_t x, int16_t y);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_SHAPE_H
@@ -36,6 +36,7 @@
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/displayio/OnDiskBitmap.h"
 #include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/RLEBitmap.h"
 #include "shared-bindings/displayio/Shape.h"
 #include "supervisor/shared/translate.h"
 
@@ -57,7 +58,8 @@
 //|
 //|   tile_width and tile_height match the height of the bitmap by default.
 //|
-//|   :param displayio.Bitmap bitmap: The bitmap storing one or more tiles.
+//|   :param displayio.Bitmap bitmap: The bitmap storing one or more tiles. A `Shape`,
+//|       `OnDiskBitmap` or `RLEBitmap` may be used instead.
 //|   :param displayio.Palette pixel_shader: The pixel shader that produces colors from values
 //|   :param int width: Width of the grid in tiles.
 //|   :param int height: Height of the grid in tiles.
@@ -102,6 +104,11 @@ STATIC mp_obj_t displayio_tilegrid_make_new(const mp_obj_type_t *type, size_t n_
         native = bitmap;
         bitmap_width = bmp->width;
         bitmap_height = bmp->height;
+    } else if (MP_OBJ_IS_TYPE(bitmap, &displayio_rlebitmap_type)) {
+        displayio_rlebitmap_t* bmp = MP_OBJ_TO_PTR(bitmap);
+        native = bitmap;
+        bitmap_width = bmp->width;
+        bitmap_height = bmp->height;
     } else {
         mp_raise_TypeError_varg(translate("unsupported %q type"), MP_QSTR_bitmap);
     }
@@ -286,6 +293,30 @@ STATIC mp_obj_t tilegrid_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t v
     return mp_const_none;
 }
 
+// Handle x and y directly, rather than through the locals dict and
+// properties, since sprites are moved every frame.
+STATIC void displayio_tilegrid_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    if (attr == MP_QSTR_x || attr == MP_QSTR_y) {
+        if (dest[0] == MP_OBJ_NULL) {
+            if (attr == MP_QSTR_x) {
+                dest[0] = displayio_tilegrid_obj_get_x(self_in);
+            } else {
+                dest[0] = displayio_tilegrid_obj_get_y(self_in);
+            }
+            return;
+        } else if (dest[1] != MP_OBJ_NULL) {
+            if (attr == MP_QSTR_x) {
+                displayio_tilegrid_obj_set_x(self_in, dest[1]);
+            } else {
+                displayio_tilegrid_obj_set_y(self_in, dest[1]);
+            }
+            dest[0] = MP_OBJ_NULL;
+            return;
+        }
+    }
+    dest[1] = MP_OBJ_SENTINEL;
+}
+
 STATIC const mp_rom_map_elem_t displayio_tilegrid_locals_dict_table[] = {
     // Properties
     { MP_ROM_QSTR(MP_QSTR_x), MP_ROM_PTR(&displayio_tilegrid_x_obj) },
@@ -299,5 +330,6 @@ const mp_obj_type_t displayio_tilegrid_type = {
     .name = MP_QSTR_TileGrid,
     .make_new = displayio_tilegrid_make_new,
     .subscr = tilegrid_subscr,
+    .attr = displayio_tilegrid_attr,
     .locals_dict = (mp_obj_dict_t*)&displayio_tilegrid_locals_dict,
 };
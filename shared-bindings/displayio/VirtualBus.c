@@ -0,0 +1,145 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/VirtualBus.h"
+
+#include <stdint.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-module/displayio/__init__.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: displayio
+//|
+//| :class:`VirtualBus` -- Display bus that draws into memory
+//| ==========================================================
+//|
+//| Stands in for a display and its bus in the unix port's simulator build, where there is no
+//| hardware. Pixels sent by a `Display` are stored in a framebuffer that can be checked or saved
+//| once a refresh is done. This makes it possible to measure and profile rendering on a desktop.
+//|
+//| It understands the MIPI commands `Display` uses with its default arguments: setting the column
+//| and row address window, writing memory and setting the scroll start. Others are ignored.
+//|
+//| .. class:: VirtualBus(*, width, height)
+//|
+//|   Create a VirtualBus with display memory of the given size. Like the other display buses, it is
+//|   in use until `displayio.release_displays()` is called.
+//|
+//|   :param int width: Width of the display memory in pixels
+//|   :param int height: Height of the display memory in pixels
+//|
+STATIC mp_obj_t displayio_virtualbus_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_width, ARG_height };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED },
+        { MP_QSTR_height, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t width = args[ARG_width].u_int;
+    mp_int_t height = args[ARG_height].u_int;
+    if (width < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_width);
+    }
+    if (height < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_height);
+    }
+    if (width > 0xffff) {
+        mp_raise_ValueError_varg(translate("%q must be <= %d"), MP_QSTR_width, 0xffff);
+    }
+    if (height > 0xffff) {
+        mp_raise_ValueError_varg(translate("%q must be <= %d"), MP_QSTR_height, 0xffff);
+    }
+
+    displayio_virtualbus_obj_t* self = NULL;
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+        if (displays[i].bus_base.type == NULL ||
+            displays[i].bus_base.type == &mp_type_NoneType) {
+            self = &displays[i].virtual_bus;
+            self->base.type = &displayio_virtualbus_type;
+            break;
+        }
+    }
+    if (self == NULL) {
+        mp_raise_RuntimeError(translate("Too many display busses"));
+    }
+
+    common_hal_displayio_virtualbus_construct(self, width, height);
+    return self;
+}
+
+//|   .. attribute:: framebuffer
+//|
+//|     The display memory as a `bytearray`, a row at a time from the top left. Each pixel is two
+//|     bytes in the order the display received them, which is big endian RGB565 for a 16 bit
+//|     `Display`. (read-only)
+//|
+STATIC mp_obj_t displayio_virtualbus_obj_get_framebuffer(mp_obj_t self_in) {
+    displayio_virtualbus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_displayio_virtualbus_get_framebuffer(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_virtualbus_get_framebuffer_obj, displayio_virtualbus_obj_get_framebuffer);
+
+const mp_obj_property_t displayio_virtualbus_framebuffer_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_virtualbus_get_framebuffer_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: scroll_offset
+//|
+//|     The framebuffer row shown at the top of the display. It is only ever non-zero when the
+//|     `Display` scrolls in hardware. (read-only)
+//|
+STATIC mp_obj_t displayio_virtualbus_obj_get_scroll_offset(mp_obj_t self_in) {
+    displayio_virtualbus_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_displayio_virtualbus_get_scroll_offset(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_virtualbus_get_scroll_offset_obj, displayio_virtualbus_obj_get_scroll_offset);
+
+const mp_obj_property_t displayio_virtualbus_scroll_offset_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&displayio_virtualbus_get_scroll_offset_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t displayio_virtualbus_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_framebuffer), MP_ROM_PTR(&displayio_virtualbus_framebuffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_scroll_offset), MP_ROM_PTR(&displayio_virtualbus_scroll_offset_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(displayio_virtualbus_locals_dict, displayio_virtualbus_locals_dict_table);
+
+const mp_obj_type_t displayio_virtualbus_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_VirtualBus,
+    .make_new = displayio_virtualbus_make_new,
+    .locals_dict = (mp_obj_dict_t*)&displayio_virtualbus_locals_dict,
+};
@@ -33,13 +33,20 @@
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/displayio/Display.h"
-#include "shared-bindings/displayio/FourWire.h"
 #include "shared-bindings/displayio/Group.h"
 #include "shared-bindings/displayio/OnDiskBitmap.h"
 #include "shared-bindings/displayio/Palette.h"
-#include "shared-bindings/displayio/ParallelBus.h"
+#include "shared-bindings/displayio/RefreshStats.h"
+#include "shared-bindings/displayio/RLEBitmap.h"
 #include "shared-bindings/displayio/Shape.h"
 #include "shared-bindings/displayio/TileGrid.h"
+#if CIRCUITPY_MICROCONTROLLER
+#include "shared-bindings/displayio/FourWire.h"
+#include "shared-bindings/displayio/ParallelBus.h"
+#endif
+#if CIRCUITPY_SIMULATOR
+#include "shared-bindings/displayio/VirtualBus.h"
+#endif
 
 //| :mod:`displayio` --- Native display driving
 //| =========================================================================
@@ -64,8 +71,11 @@
 //|     OnDiskBitmap
 //|     Palette
 //|     ParallelBus
+//|     RefreshStats
+//|     RLEBitmap
 //|     Shape
 //|     TileGrid
+//|     VirtualBus
 //|
 
 
@@ -92,11 +102,18 @@ STATIC const mp_rom_map_elem_t displayio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_Group), MP_ROM_PTR(&displayio_group_type) },
     { MP_ROM_QSTR(MP_QSTR_OnDiskBitmap), MP_ROM_PTR(&displayio_ondiskbitmap_type) },
     { MP_ROM_QSTR(MP_QSTR_Palette), MP_ROM_PTR(&displayio_palette_type) },
+    { MP_ROM_QSTR(MP_QSTR_RefreshStats), MP_ROM_PTR(&displayio_refresh_stats_type) },
+    { MP_ROM_QSTR(MP_QSTR_RLEBitmap), MP_ROM_PTR(&displayio_rlebitmap_type) },
     { MP_ROM_QSTR(MP_QSTR_Shape), MP_ROM_PTR(&displayio_shape_type) },
     { MP_ROM_QSTR(MP_QSTR_TileGrid), MP_ROM_PTR(&displayio_tilegrid_type) },
 
+    #if CIRCUITPY_MICROCONTROLLER
     { MP_ROM_QSTR(MP_QSTR_FourWire), MP_ROM_PTR(&displayio_fourwire_type) },
     { MP_ROM_QSTR(MP_QSTR_ParallelBus), MP_ROM_PTR(&displayio_parallelbus_type) },
+    #endif
+    #if CIRCUITPY_SIMULATOR
+    { MP_ROM_QSTR(MP_QSTR_VirtualBus), MP_ROM_PTR(&displayio_virtualbus_type) },
+    #endif
 
     { MP_ROM_QSTR(MP_QSTR_release_displays), MP_ROM_PTR(&displayio_release_displays_obj) },
 };
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/fontio/PCFFont.h"
+
+#include <stdint.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: fontio
+//|
+//| :class:`PCFFont` -- A font loaded from a PCF file
+//| =========================================================================================
+//|
+//| A font whose glyphs are read from a PCF file as they are needed. Only the locations of the
+//| font's tables are read when it is created so opening even large fonts is quick. A BDF font can
+//| be converted to PCF with ``bdftopcf``.
+//|
+//| .. class:: PCFFont(file, *, cache_size=32)
+//|
+//|   Create a PCFFont object with the given file. The file must stay open while the font is used.
+//|
+//|   :param file file: The PCF file to read glyphs from, opened in binary mode
+//|   :param int cache_size: The number of recently used glyphs to keep in memory
+//|
+//|   Each glyph has its own `displayio.Bitmap`, so glyphs dropped from the cache stay valid for
+//|   as long as something else, such as a label, refers to them.
+//|
+//|   Usage::
+//|
+//|     import board
+//|     import displayio
+//|     import fontio
+//|
+//|     f = open("/fonts/helvR12.pcf", "rb")
+//|     font = fontio.PCFFont(f)
+//|     glyph = font.get_glyph(ord("A"))
+//|
+STATIC mp_obj_t fontio_pcffont_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_file, ARG_cache_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_cache_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 32} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t file = args[ARG_file].u_obj;
+    if (!MP_OBJ_IS_TYPE(file, &mp_type_fileio)) {
+        mp_raise_TypeError(translate("file must be a file opened in byte mode"));
+    }
+
+    mp_int_t cache_size = args[ARG_cache_size].u_int;
+    if (cache_size < 1 || cache_size > 0xffff) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_cache_size);
+    }
+
+    fontio_pcffont_t *self = m_new_obj(fontio_pcffont_t);
+    self->base.type = &fontio_pcffont_type;
+    common_hal_fontio_pcffont_construct(self, MP_OBJ_TO_PTR(file), cache_size);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: get_bounding_box()
+//|
+//|     Returns the maximum bounds of all glyphs in the font in a tuple of four values: width,
+//|     height, x offset and y offset. The offsets are from the origin to the bottom left corner.
+//|
+STATIC mp_obj_t fontio_pcffont_obj_get_bounding_box(mp_obj_t self_in) {
+    fontio_pcffont_t *self = MP_OBJ_TO_PTR(self_in);
+
+    return common_hal_fontio_pcffont_get_bounding_box(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(fontio_pcffont_get_bounding_box_obj, fontio_pcffont_obj_get_bounding_box);
+
+//|   .. method:: get_glyph(codepoint)
+//|
+//|     Returns a `fontio.Glyph` for the given codepoint or None if no glyph is available. The
+//|     glyph is read from the file unless it is in the cache.
+//|
+STATIC mp_obj_t fontio_pcffont_obj_get_glyph(mp_obj_t self_in, mp_obj_t codepoint_obj) {
+    fontio_pcffont_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_int_t codepoint;
+    if (!mp_obj_get_int_maybe(codepoint_obj, &codepoint)) {
+        mp_raise_ValueError_varg(translate("%q should be an int"), MP_QSTR_codepoint);
+    }
+    return common_hal_fontio_pcffont_get_glyph(self, codepoint);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(fontio_pcffont_get_glyph_obj, fontio_pcffont_obj_get_glyph);
+
+STATIC const mp_rom_map_elem_t fontio_pcffont_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_get_bounding_box), MP_ROM_PTR(&fontio_pcffont_get_bounding_box_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_glyph), MP_ROM_PTR(&fontio_pcffont_get_glyph_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(fontio_pcffont_locals_dict, fontio_pcffont_locals_dict_table);
+
+const mp_obj_type_t fontio_pcffont_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_PCFFont,
+    .make_new = fontio_pcffont_make_new,
+    .locals_dict = (mp_obj_dict_t*)&fontio_pcffont_locals_dict,
+};
@@ -44,17 +44,25 @@
 //| on an incoming pin. Accuracy has shown to be within 10%, if not better. It
 //| is recommended to utilize an average of multiple samples to smooth out readings.
 //|
-//| Frequencies below 1KHz are not currently detectable.
+//| Frequencies below 1KHz are not currently detectable by counting edges. Reciprocal
+//| counting instead times the edges themselves and resolves fractions of a hertz from
+//| about 1Hz to tens of kHz.
 //|
 //| FrequencyIn will not determine pulse width (use ``PulseIn``).
 //|
-//| .. class:: FrequencyIn(pin, capture_period=10)
+//| .. class:: FrequencyIn(pin, capture_period=10, reciprocal=False)
 //|
 //|   Create a FrequencyIn object associated with the given pin.
 //|
 //|   :param ~microcontroller.Pin pin: Pin to read frequency from.
 //|   :param int capture_period: Keyword argument to set the measurement period, in
 //|                              milliseconds. Default is 10ms; range is 1ms - 500ms.
+//|                              With ``reciprocal``, the shortest span of whole periods
+//|                              to average over.
+//|   :param bool reciprocal: Keyword argument to time stamp each rising edge in the
+//|                           background and compute the frequency from the time between
+//|                           them, which ``value`` then returns as a float. Not available
+//|                           on all boards.
 //|
 //|   Read the incoming frequency from a pin::
 //|
@@ -79,10 +87,11 @@ STATIC mp_obj_t frequencyio_frequencyin_make_new(const mp_obj_type_t *type, size
 
     frequencyio_frequencyin_obj_t *self = m_new_obj(frequencyio_frequencyin_obj_t);
     self->base.type = &frequencyio_frequencyin_type;
-    enum { ARG_pin, ARG_capture_period };
+    enum { ARG_pin, ARG_capture_period, ARG_reciprocal };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_pin, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_capture_period, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 10} },
+        { MP_QSTR_reciprocal, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -93,7 +102,7 @@ STATIC mp_obj_t frequencyio_frequencyin_make_new(const mp_obj_type_t *type, size
 
     const uint16_t capture_period = args[ARG_capture_period].u_int;
 
-    common_hal_frequencyio_frequencyin_construct(self, pin, capture_period);
+    common_hal_frequencyio_frequencyin_construct(self, pin, capture_period, args[ARG_reciprocal].u_bool);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -202,12 +211,16 @@ const mp_obj_property_t frequencyio_frequencyin_capture_period_obj = {
 
 //|   .. method:: __get__(index)
 //|
-//|     Returns the value of the last frequency captured.
+//|     Returns the value of the last frequency captured. This is a float when
+//|     ``reciprocal`` is set and falls toward zero once the signal stops.
 //|
 STATIC mp_obj_t frequencyio_frequencyin_obj_get_value(mp_obj_t self_in) {
     frequencyio_frequencyin_obj_t *self = MP_OBJ_TO_PTR(self_in);
     raise_error_if_deinited(common_hal_frequencyio_frequencyin_deinited(self));
 
+    if (common_hal_frequencyio_frequencyin_get_reciprocal(self)) {
+        return mp_obj_new_float(common_hal_frequencyio_frequencyin_get_item(self));
+    }
     //return MP_OBJ_NEW_SMALL_INT(common_hal_frequencyio_frequencyin_get_item(self));
     return mp_obj_new_int_from_float(common_hal_frequencyio_frequencyin_get_item(self));
 }
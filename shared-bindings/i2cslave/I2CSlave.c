@@ -54,25 +54,36 @@ STATIC mp_obj_t mp_obj_new_i2cslave_i2c_slave_request(i2cslave_i2c_slave_obj_t *
 //| :class:`I2CSlave` --- Two wire serial protocol slave
 //| ----------------------------------------------------
 //|
-//| .. class:: I2CSlave(scl, sda, addresses, smbus=False)
+//| .. class:: I2CSlave(scl, sda, addresses, smbus=False, registers=None)
 //|
 //|   I2C is a two-wire protocol for communicating between devices.
 //|   This implements the slave side.
 //|
+//|   When ``registers`` is given the slave behaves like a register mapped
+//|   device and answers the master itself, without :py:meth:`request`. The
+//|   first byte of a write sets the register pointer and any further bytes
+//|   are stored from there on. Reads return bytes from the register pointer
+//|   onwards. The pointer auto-increments and is kept between transfers.
+//|   Only the first 256 bytes are addressable, reads past the end return
+//|   0xff and writes past the end are dropped. Use :py:meth:`written` to
+//|   find out what the master has changed.
+//|
 //|   :param ~microcontroller.Pin scl: The clock pin
 //|   :param ~microcontroller.Pin sda: The data pin
 //|   :param tuple addresses: The I2C addresses to respond to (how many is hw dependent).
 //|   :param bool smbus: Use SMBUS timings if the hardware supports it
+//|   :param bytearray registers: Register contents served to the master. Do not resize it while in use.
 //|
 STATIC mp_obj_t i2cslave_i2c_slave_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     i2cslave_i2c_slave_obj_t *self = m_new_obj(i2cslave_i2c_slave_obj_t);
     self->base.type = &i2cslave_i2c_slave_type;
-    enum { ARG_scl, ARG_sda, ARG_addresses, ARG_smbus };
+    enum { ARG_scl, ARG_sda, ARG_addresses, ARG_smbus, ARG_registers };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_scl, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_sda, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_addresses, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_smbus, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_registers, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -104,7 +115,13 @@ STATIC mp_obj_t i2cslave_i2c_slave_make_new(const mp_obj_type_t *type, size_t n_
         mp_raise_ValueError(translate("addresses is empty"));
     }
 
-    common_hal_i2cslave_i2c_slave_construct(self, scl, sda, addresses, i, args[ARG_smbus].u_bool);
+    mp_buffer_info_t registers = { .buf = NULL, .len = 0 };
+    if (args[ARG_registers].u_obj != mp_const_none) {
+        mp_get_buffer_raise(args[ARG_registers].u_obj, &registers, MP_BUFFER_WRITE);
+    }
+
+    common_hal_i2cslave_i2c_slave_construct(self, scl, sda, addresses, i, args[ARG_smbus].u_bool,
+        registers.buf, registers.len);
     return (mp_obj_t)self;
 }
 
@@ -139,9 +156,30 @@ STATIC mp_obj_t i2cslave_i2c_slave_obj___exit__(size_t n_args, const mp_obj_t *a
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(i2cslave_i2c_slave___exit___obj, 4, 4, i2cslave_i2c_slave_obj___exit__);
 
+//|   .. method:: written()
+//|
+//|      Return the oldest change the master made to ``registers`` as a
+//|      ``(register, length)`` tuple, or None if there is nothing new. Up to
+//|      8 writes are remembered, later ones are dropped until these are read.
+//|
+STATIC mp_obj_t i2cslave_i2c_slave_obj_written(mp_obj_t self_in) {
+    mp_check_self(MP_OBJ_IS_TYPE(self_in, &i2cslave_i2c_slave_type));
+    i2cslave_i2c_slave_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_i2cslave_i2c_slave_deinited(self));
+
+    uint8_t start;
+    size_t length;
+    if (!common_hal_i2cslave_i2c_slave_get_write(self, &start, &length)) {
+        return mp_const_none;
+    }
+    mp_obj_t items[2] = { MP_OBJ_NEW_SMALL_INT(start), MP_OBJ_NEW_SMALL_INT(length) };
+    return mp_obj_new_tuple(2, items);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(i2cslave_i2c_slave_written_obj, i2cslave_i2c_slave_obj_written);
+
 //|   .. method:: request(timeout=-1)
 //|
-//|      Wait for an I2C request from a master.
+//|      Wait for an I2C request from a master. Not used in register mode.
 //|
 //|      :param float timeout: Timeout in seconds. Zero means wait forever, a negative value means check once
 //|      :return: I2C Slave Request or None if timeout=-1 and there's no request
@@ -218,6 +256,7 @@ STATIC const mp_rom_map_elem_t i2cslave_i2c_slave_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&i2cslave_i2c_slave___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_request), MP_ROM_PTR(&i2cslave_i2c_slave_request_obj) },
+    { MP_ROM_QSTR(MP_QSTR_written), MP_ROM_PTR(&i2cslave_i2c_slave_written_obj) },
 
 };
 
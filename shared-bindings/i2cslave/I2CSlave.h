@@ -46,7 +46,8 @@ extern const mp_obj_type_t i2cslave_i2c_slave_type;
 
 extern void common_hal_i2cslave_i2c_slave_construct(i2cslave_i2c_slave_obj_t *self,
         const mcu_pin_obj_t* scl, const mcu_pin_obj_t* sda,
-        uint8_t *addresses, unsigned int num_addresses, bool smbus);
+        uint8_t *addresses, unsigned int num_addresses, bool smbus,
+        uint8_t *registers, size_t registers_len);
 extern void common_hal_i2cslave_i2c_slave_deinit(i2cslave_i2c_slave_obj_t *self);
 extern bool common_hal_i2cslave_i2c_slave_deinited(i2cslave_i2c_slave_obj_t *self);
 
@@ -56,5 +57,7 @@ extern int common_hal_i2cslave_i2c_slave_read_byte(i2cslave_i2c_slave_obj_t *sel
 extern int common_hal_i2cslave_i2c_slave_write_byte(i2cslave_i2c_slave_obj_t *self, uint8_t data);
 extern void common_hal_i2cslave_i2c_slave_ack(i2cslave_i2c_slave_obj_t *self, bool ack);
 extern void common_hal_i2cslave_i2c_slave_close(i2cslave_i2c_slave_obj_t *self);
+extern bool common_hal_i2cslave_i2c_slave_get_write(i2cslave_i2c_slave_obj_t *self,
+        uint8_t *start, size_t *length);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_BUSIO_I2C_SLAVE_H
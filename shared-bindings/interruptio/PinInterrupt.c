@@ -0,0 +1,200 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "py/runtime0.h"
+#include "shared-bindings/digitalio/Pull.h"
+#include "shared-bindings/interruptio/PinInterrupt.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: interruptio
+//|
+//| :class:`PinInterrupt` -- Call a function when a pin changes
+//| ===========================================================
+//|
+//| PinInterrupt calls a Python function after a pin sees an edge, without the main loop polling
+//| the pin.
+//|
+//| .. class:: PinInterrupt(pin, handler, *, rising=True, falling=False, pull=None)
+//|
+//|   Create a PinInterrupt object associated with the given pin. Each matching edge queues
+//|   ``handler(pin_interrupt)``. The handler runs from the VM between bytecodes, or while in
+//|   `time.sleep`, not from the hardware interrupt itself. So it may do anything normal Python
+//|   code can, but it should be short because nothing else runs until it returns.
+//|
+//|   :param ~microcontroller.Pin pin: Pin to watch. It must support hardware interrupts.
+//|   :param handler: Function to call. It is passed this PinInterrupt.
+//|   :param bool rising: Call the handler on rising edges
+//|   :param bool falling: Call the handler on falling edges
+//|   :param ~digitalio.Pull pull: Pull to use on the pin
+//|
+//|   For example::
+//|
+//|     import digitalio
+//|     import interruptio
+//|     import time
+//|     from board import *
+//|
+//|     presses = 0
+//|     def pressed(pin_interrupt):
+//|         global presses
+//|         presses += 1
+//|
+//|     button = interruptio.PinInterrupt(D1, pressed, rising=False, falling=True, pull=digitalio.Pull.UP)
+//|     while True:
+//|         time.sleep(1)
+//|         print(presses)
+//|
+STATIC mp_obj_t interruptio_pininterrupt_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_pin, ARG_handler, ARG_rising, ARG_falling, ARG_pull };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pin, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_handler, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_rising, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_falling, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_pull, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    assert_pin(args[ARG_pin].u_obj, false);
+    const mcu_pin_obj_t* pin = MP_OBJ_TO_PTR(args[ARG_pin].u_obj);
+    assert_pin_free(pin);
+
+    if (!mp_obj_is_callable(args[ARG_handler].u_obj)) {
+        mp_raise_TypeError(translate("object not callable"));
+    }
+    if (!args[ARG_rising].u_bool && !args[ARG_falling].u_bool) {
+        mp_raise_ValueError(translate("rising or falling must be True"));
+    }
+
+    digitalio_pull_t pull = PULL_NONE;
+    if (args[ARG_pull].u_rom_obj == &digitalio_pull_up_obj) {
+        pull = PULL_UP;
+    } else if (args[ARG_pull].u_rom_obj == &digitalio_pull_down_obj) {
+        pull = PULL_DOWN;
+    }
+
+    interruptio_pininterrupt_obj_t *self = m_new_obj(interruptio_pininterrupt_obj_t);
+    self->base.type = &interruptio_pininterrupt_type;
+
+    common_hal_interruptio_pininterrupt_construct(self, pin, args[ARG_handler].u_obj,
+        args[ARG_rising].u_bool, args[ARG_falling].u_bool, pull);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Deinitializes the PinInterrupt and releases any hardware resources for reuse. Handler
+//|      calls that are already queued still run.
+//|
+STATIC mp_obj_t interruptio_pininterrupt_deinit(mp_obj_t self_in) {
+    interruptio_pininterrupt_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_interruptio_pininterrupt_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(interruptio_pininterrupt_deinit_obj, interruptio_pininterrupt_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t interruptio_pininterrupt_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_interruptio_pininterrupt_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(interruptio_pininterrupt___exit___obj, 4, 4, interruptio_pininterrupt_obj___exit__);
+
+//|   .. attribute:: value
+//|
+//|     The current level of the pin. (read-only)
+//|
+STATIC mp_obj_t interruptio_pininterrupt_obj_get_value(mp_obj_t self_in) {
+    interruptio_pininterrupt_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_interruptio_pininterrupt_deinited(self));
+
+    return mp_obj_new_bool(common_hal_interruptio_pininterrupt_get_value(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(interruptio_pininterrupt_get_value_obj, interruptio_pininterrupt_obj_get_value);
+
+const mp_obj_property_t interruptio_pininterrupt_value_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&interruptio_pininterrupt_get_value_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: missed
+//|
+//|     The number of edges whose handler call was dropped because the queue of pending calls was
+//|     full. (read-only)
+//|
+STATIC mp_obj_t interruptio_pininterrupt_obj_get_missed(mp_obj_t self_in) {
+    interruptio_pininterrupt_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_interruptio_pininterrupt_deinited(self));
+
+    return mp_obj_new_int_from_uint(common_hal_interruptio_pininterrupt_get_missed(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(interruptio_pininterrupt_get_missed_obj, interruptio_pininterrupt_obj_get_missed);
+
+const mp_obj_property_t interruptio_pininterrupt_missed_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&interruptio_pininterrupt_get_missed_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t interruptio_pininterrupt_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&interruptio_pininterrupt_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&interruptio_pininterrupt___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_value), MP_ROM_PTR(&interruptio_pininterrupt_value_obj) },
+    { MP_ROM_QSTR(MP_QSTR_missed), MP_ROM_PTR(&interruptio_pininterrupt_missed_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(interruptio_pininterrupt_locals_dict, interruptio_pininterrupt_locals_dict_table);
+
+const mp_obj_type_t interruptio_pininterrupt_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_PinInterrupt,
+    .make_new = interruptio_pininterrupt_make_new,
+    .locals_dict = (mp_obj_dict_t*)&interruptio_pininterrupt_locals_dict,
+};
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "py/runtime0.h"
+#include "shared-bindings/interruptio/TimerInterrupt.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: interruptio
+//|
+//| :class:`TimerInterrupt` -- Call a function periodically
+//| =======================================================
+//|
+//| TimerInterrupt calls a Python function at a fixed interval, counted by the millisecond tick.
+//|
+//| .. class:: TimerInterrupt(interval, handler)
+//|
+//|   Create a TimerInterrupt. Every ``interval`` seconds it queues ``handler(timer_interrupt)``.
+//|   Like `PinInterrupt`, the handler runs from the VM between bytecodes, or while in
+//|   `time.sleep`, not from the tick interrupt itself.
+//|
+//|   :param float interval: Seconds between calls. It is rounded to the nearest millisecond.
+//|   :param handler: Function to call. It is passed this TimerInterrupt.
+//|
+STATIC mp_obj_t interruptio_timerinterrupt_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_interval, ARG_handler };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_interval, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_handler, MP_ARG_REQUIRED | MP_ARG_OBJ },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t interval = mp_obj_get_float(args[ARG_interval].u_obj);
+    if (interval < MICROPY_FLOAT_CONST(0.001) || interval > MICROPY_FLOAT_CONST(1000000.0)) {
+        mp_raise_ValueError(translate("interval must be in range 0.001-1000000"));
+    }
+    if (!mp_obj_is_callable(args[ARG_handler].u_obj)) {
+        mp_raise_TypeError(translate("object not callable"));
+    }
+
+    interruptio_timerinterrupt_obj_t *self = m_new_obj(interruptio_timerinterrupt_obj_t);
+    self->base.type = &interruptio_timerinterrupt_type;
+
+    uint32_t interval_ms = (uint32_t) (interval * 1000 + MICROPY_FLOAT_CONST(0.5));
+    common_hal_interruptio_timerinterrupt_construct(self, interval_ms, args[ARG_handler].u_obj);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Stops the timer and frees it for reuse. Handler calls that are already queued still run.
+//|
+STATIC mp_obj_t interruptio_timerinterrupt_deinit(mp_obj_t self_in) {
+    interruptio_timerinterrupt_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_interruptio_timerinterrupt_deinit(self);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(interruptio_timerinterrupt_deinit_obj, interruptio_timerinterrupt_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the timer when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t interruptio_timerinterrupt_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_interruptio_timerinterrupt_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(interruptio_timerinterrupt___exit___obj, 4, 4, interruptio_timerinterrupt_obj___exit__);
+
+//|   .. attribute:: interval
+//|
+//|     Seconds between calls, after rounding to milliseconds. (read-only)
+//|
+STATIC mp_obj_t interruptio_timerinterrupt_obj_get_interval(mp_obj_t self_in) {
+    interruptio_timerinterrupt_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_interruptio_timerinterrupt_deinited(self));
+
+    return mp_obj_new_float(common_hal_interruptio_timerinterrupt_get_interval_ms(self) / MICROPY_FLOAT_CONST(1000.0));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(interruptio_timerinterrupt_get_interval_obj, interruptio_timerinterrupt_obj_get_interval);
+
+const mp_obj_property_t interruptio_timerinterrupt_interval_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&interruptio_timerinterrupt_get_interval_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: missed
+//|
+//|     The number of intervals whose handler call was dropped because the queue of pending calls
+//|     was full. (read-only)
+//|
+STATIC mp_obj_t interruptio_timerinterrupt_obj_get_missed(mp_obj_t self_in) {
+    interruptio_timerinterrupt_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_interruptio_timerinterrupt_deinited(self));
+
+    return mp_obj_new_int_from_uint(common_hal_interruptio_timerinterrupt_get_missed(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(interruptio_timerinterrupt_get_missed_obj, interruptio_timerinterrupt_obj_get_missed);
+
+const mp_obj_property_t interruptio_timerinterrupt_missed_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&interruptio_timerinterrupt_get_missed_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t interruptio_timerinterrupt_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&interruptio_timerinterrupt_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&interruptio_timerinterrupt___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_interval), MP_ROM_PTR(&interruptio_timerinterrupt_interval_obj) },
+    { MP_ROM_QSTR(MP_QSTR_missed), MP_ROM_PTR(&interruptio_timerinterrupt_missed_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(interruptio_timerinterrupt_locals_dict, interruptio_timerinterrupt_locals_dict_table);
+
+const mp_obj_type_t interruptio_timerinterrupt_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_TimerInterrupt,
+    .make_new = interruptio_timerinterrupt_make_new,
+    .locals_dict = (mp_obj_dict_t*)&interruptio_timerinterrupt_locals_dict,
+};
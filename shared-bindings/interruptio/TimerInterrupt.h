@@ -0,0 +1,41 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_INTERRUPTIO_TIMERINTERRUPT_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_INTERRUPTIO_TIMERINTERRUPT_H
+
+#include "shared-module/interruptio/TimerInterrupt.h"
+
+extern const mp_obj_type_t interruptio_timerinterrupt_type;
+
+extern void common_hal_interruptio_timerinterrupt_construct(interruptio_timerinterrupt_obj_t* self,
+    uint32_t interval_ms, mp_obj_t handler);
+extern void common_hal_interruptio_timerinterrupt_deinit(interruptio_timerinterrupt_obj_t* self);
+extern bool common_hal_interruptio_timerinterrupt_deinited(interruptio_timerinterrupt_obj_t* self);
+extern uint32_t common_hal_interruptio_timerinterrupt_get_interval_ms(interruptio_timerinterrupt_obj_t* self);
+extern uint32_t common_hal_interruptio_timerinterrupt_get_missed(interruptio_timerinterrupt_obj_t* self);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_INTERRUPTIO_TIMERINTERRUPT_H
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/interruptio/__init__.h"
+#include "shared-bindings/interruptio/PinInterrupt.h"
+#include "shared-bindings/interruptio/TimerInterrupt.h"
+
+//| :mod:`interruptio` --- Call Python functions from hardware events
+//| =================================================================
+//|
+//| .. module:: interruptio
+//|   :synopsis: Call Python functions from hardware events
+//|   :platform: SAMD
+//|
+//| The `interruptio` module calls Python functions when a pin changes or a timer expires, so code
+//| doesn't have to poll for short events. The hardware interrupt only queues the call. The
+//| function runs soon after from the VM, at the next bytecode branch or while in `time.sleep`.
+//| Up to eight calls can be queued. Further events are counted in ``missed`` until the queue
+//| drains.
+//|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     PinInterrupt
+//|     TimerInterrupt
+//|
+
+//| .. warning:: This module is only available in some builds. See the
+//|   :ref:`module-support-matrix` for more info.
+//|
+
+//| All classes change hardware state and should be deinitialized when they
+//| are no longer needed if the program continues after use. To do so, either
+//| call :py:meth:`!deinit` or use a context manager. See
+//| :ref:`lifetime-and-contextmanagers` for more info.
+//|
+
+STATIC const mp_rom_map_elem_t interruptio_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_interruptio) },
+    { MP_ROM_QSTR(MP_QSTR_PinInterrupt), MP_ROM_PTR(&interruptio_pininterrupt_type) },
+    { MP_ROM_QSTR(MP_QSTR_TimerInterrupt), MP_ROM_PTR(&interruptio_timerinterrupt_type) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(interruptio_module_globals, interruptio_module_globals_table);
+
+const mp_obj_module_t interruptio_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&interruptio_module_globals,
+};
@@ -0,0 +1,198 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/keypad/Event.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: keypad
+//|
+//| :class:`Event` -- A key press or release
+//| ========================================
+//|
+//| .. class:: Event(key_number=0, pressed=True, *, timestamp=0)
+//|
+//|   Create an Event. Scanners make their own, so this is mostly useful with
+//|   `EventQueue.get_into` to read events without allocating.
+//|
+//|   :param int key_number: The key's number
+//|   :param bool pressed: True for a press, False for a release
+//|   :param int timestamp: When the change was seen, in milliseconds
+//|
+STATIC mp_obj_t keypad_event_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_key_number, ARG_pressed, ARG_timestamp };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_key_number, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_pressed, MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_timestamp, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t key_number = args[ARG_key_number].u_int;
+    if (key_number < 0) {
+        mp_raise_ValueError_varg(translate("%q must be >= 0"), MP_QSTR_key_number);
+    }
+    if (key_number > 0xffff) {
+        mp_raise_ValueError_varg(translate("%q must be <= %d"), MP_QSTR_key_number, 0xffff);
+    }
+
+    keypad_event_obj_t *self = m_new_obj(keypad_event_obj_t);
+    self->base.type = &keypad_event_type;
+    common_hal_keypad_event_construct(self, key_number, args[ARG_pressed].u_bool,
+                                      args[ARG_timestamp].u_int);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. attribute:: key_number
+//|
+//|     The number of the key that changed. (read-only)
+//|
+STATIC mp_obj_t keypad_event_obj_get_key_number(mp_obj_t self_in) {
+    keypad_event_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_keypad_event_get_key_number(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_event_get_key_number_obj, keypad_event_obj_get_key_number);
+
+const mp_obj_property_t keypad_event_key_number_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_event_get_key_number_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: pressed
+//|
+//|     True if the key was pressed. (read-only)
+//|
+STATIC mp_obj_t keypad_event_obj_get_pressed(mp_obj_t self_in) {
+    keypad_event_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_keypad_event_get_pressed(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_event_get_pressed_obj, keypad_event_obj_get_pressed);
+
+const mp_obj_property_t keypad_event_pressed_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_event_get_pressed_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: released
+//|
+//|     True if the key was released. (read-only)
+//|
+STATIC mp_obj_t keypad_event_obj_get_released(mp_obj_t self_in) {
+    keypad_event_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(!common_hal_keypad_event_get_pressed(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_event_get_released_obj, keypad_event_obj_get_released);
+
+const mp_obj_property_t keypad_event_released_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_event_get_released_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: timestamp
+//|
+//|     The millisecond tick count when the change was accepted, on the same clock as
+//|     `time.monotonic`. It wraps around after about 49 days. (read-only)
+//|
+STATIC mp_obj_t keypad_event_obj_get_timestamp(mp_obj_t self_in) {
+    keypad_event_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(common_hal_keypad_event_get_timestamp(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_event_get_timestamp_obj, keypad_event_obj_get_timestamp);
+
+const mp_obj_property_t keypad_event_timestamp_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_event_get_timestamp_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. method:: __eq__(other)
+//|
+//|     Two events are equal when their `key_number` and `pressed` match. The timestamp is
+//|     ignored so an event can be compared with one made to match a key.
+//|
+STATIC mp_obj_t keypad_event_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_in) {
+    if (op != MP_BINARY_OP_EQUAL) {
+        return MP_OBJ_NULL; // op not supported
+    }
+    if (!MP_OBJ_IS_TYPE(rhs_in, &keypad_event_type)) {
+        return mp_const_false;
+    }
+    keypad_event_obj_t *lhs = MP_OBJ_TO_PTR(lhs_in);
+    keypad_event_obj_t *rhs = MP_OBJ_TO_PTR(rhs_in);
+    return mp_obj_new_bool(
+        common_hal_keypad_event_get_key_number(lhs) == common_hal_keypad_event_get_key_number(rhs) &&
+        common_hal_keypad_event_get_pressed(lhs) == common_hal_keypad_event_get_pressed(rhs));
+}
+
+//|   .. method:: __hash__()
+//|
+//|     Hashes the same fields that `__eq__` compares.
+//|
+STATIC mp_obj_t keypad_event_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    keypad_event_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (op) {
+        case MP_UNARY_OP_HASH:
+            return MP_OBJ_NEW_SMALL_INT((common_hal_keypad_event_get_key_number(self) << 1) |
+                                        common_hal_keypad_event_get_pressed(self));
+        default:
+            return MP_OBJ_NULL; // op not supported
+    }
+}
+
+STATIC void keypad_event_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    keypad_event_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "<Event: key_number %d %s>", common_hal_keypad_event_get_key_number(self),
+              common_hal_keypad_event_get_pressed(self) ? "pressed" : "released");
+}
+
+STATIC const mp_rom_map_elem_t keypad_event_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_key_number), MP_ROM_PTR(&keypad_event_key_number_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pressed), MP_ROM_PTR(&keypad_event_pressed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_released), MP_ROM_PTR(&keypad_event_released_obj) },
+    { MP_ROM_QSTR(MP_QSTR_timestamp), MP_ROM_PTR(&keypad_event_timestamp_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(keypad_event_locals_dict, keypad_event_locals_dict_table);
+
+const mp_obj_type_t keypad_event_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Event,
+    .make_new = keypad_event_make_new,
+    .print = keypad_event_print,
+    .unary_op = keypad_event_unary_op,
+    .binary_op = keypad_event_binary_op,
+    .locals_dict = (mp_obj_dict_t*)&keypad_event_locals_dict,
+};
@@ -0,0 +1,139 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/keypad/Event.h"
+#include "shared-bindings/keypad/EventQueue.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: keypad
+//|
+//| :class:`EventQueue` -- Queue of key events
+//| ==========================================
+//|
+//| The events recorded by a scanner, oldest first. EventQueues are made by the scanners and
+//| can't be created directly. When the queue is full, new events are dropped and `overflowed`
+//| is set.
+//|
+
+//|   .. method:: get()
+//|
+//|     Remove the oldest event and return it as a new `Event`, or return ``None`` if the queue
+//|     is empty.
+//|
+STATIC mp_obj_t keypad_eventqueue_obj_get(mp_obj_t self_in) {
+    keypad_eventqueue_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (common_hal_keypad_eventqueue_get_length(self) == 0) {
+        return mp_const_none;
+    }
+    keypad_event_obj_t *event = m_new_obj(keypad_event_obj_t);
+    event->base.type = &keypad_event_type;
+    common_hal_keypad_eventqueue_get_into(self, event);
+    return MP_OBJ_FROM_PTR(event);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_eventqueue_get_obj, keypad_eventqueue_obj_get);
+
+//|   .. method:: get_into(event)
+//|
+//|     Remove the oldest event and store it in ``event``, without allocating. Returns ``True``
+//|     if there was an event and ``False``, leaving ``event`` alone, if the queue was empty.
+//|
+//|     :param Event event: The event to overwrite
+//|
+STATIC mp_obj_t keypad_eventqueue_obj_get_into(mp_obj_t self_in, mp_obj_t event_in) {
+    keypad_eventqueue_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!MP_OBJ_IS_TYPE(event_in, &keypad_event_type)) {
+        mp_raise_TypeError_varg(translate("Expected a %q"), MP_QSTR_Event);
+    }
+    keypad_event_obj_t *event = MP_OBJ_TO_PTR(event_in);
+    return mp_obj_new_bool(common_hal_keypad_eventqueue_get_into(self, event));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(keypad_eventqueue_get_into_obj, keypad_eventqueue_obj_get_into);
+
+//|   .. method:: clear()
+//|
+//|     Remove every queued event and reset `overflowed`.
+//|
+STATIC mp_obj_t keypad_eventqueue_obj_clear(mp_obj_t self_in) {
+    keypad_eventqueue_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_keypad_eventqueue_clear(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_eventqueue_clear_obj, keypad_eventqueue_obj_clear);
+
+//|   .. attribute:: overflowed
+//|
+//|     True if an event was dropped because the queue was full. Cleared by `clear`.
+//|     (read-only)
+//|
+STATIC mp_obj_t keypad_eventqueue_obj_get_overflowed(mp_obj_t self_in) {
+    keypad_eventqueue_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_keypad_eventqueue_get_overflowed(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_eventqueue_get_overflowed_obj, keypad_eventqueue_obj_get_overflowed);
+
+const mp_obj_property_t keypad_eventqueue_overflowed_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_eventqueue_get_overflowed_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. method:: __bool__()
+//|
+//|     True if there are events waiting.
+//|
+//|   .. method:: __len__()
+//|
+//|     The number of events waiting.
+//|
+STATIC mp_obj_t keypad_eventqueue_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    keypad_eventqueue_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    uint16_t len = common_hal_keypad_eventqueue_get_length(self);
+    switch (op) {
+        case MP_UNARY_OP_BOOL: return mp_obj_new_bool(len != 0);
+        case MP_UNARY_OP_LEN: return MP_OBJ_NEW_SMALL_INT(len);
+        default: return MP_OBJ_NULL; // op not supported
+    }
+}
+
+STATIC const mp_rom_map_elem_t keypad_eventqueue_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&keypad_eventqueue_get_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_into), MP_ROM_PTR(&keypad_eventqueue_get_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&keypad_eventqueue_clear_obj) },
+    { MP_ROM_QSTR(MP_QSTR_overflowed), MP_ROM_PTR(&keypad_eventqueue_overflowed_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(keypad_eventqueue_locals_dict, keypad_eventqueue_locals_dict_table);
+
+const mp_obj_type_t keypad_eventqueue_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_EventQueue,
+    .unary_op = keypad_eventqueue_unary_op,
+    .locals_dict = (mp_obj_dict_t*)&keypad_eventqueue_locals_dict,
+};
@@ -0,0 +1,194 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/keypad/__init__.h"
+#include "shared-bindings/keypad/EventQueue.h"
+#include "shared-bindings/keypad/KeyMatrix.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+#define KEYMATRIX_MAX_PINS (32)
+
+//| .. currentmodule:: keypad
+//|
+//| :class:`KeyMatrix` -- Scan a matrix of keys
+//| ===========================================
+//|
+//| .. class:: KeyMatrix(row_pins, column_pins, *, columns_to_anodes=True, interval=0.02, debounce_scans=1, max_events=64)
+//|
+//|   Scan a matrix of keys with a diode per key. One row at a time is driven to its active
+//|   level and the columns are read, so a key's number is ``row * len(column_pins) + column``.
+//|
+//|   :param ~collections.abc.Sequence[microcontroller.Pin] row_pins: The pins for the rows
+//|   :param ~collections.abc.Sequence[microcontroller.Pin] column_pins: The pins for the columns
+//|   :param bool columns_to_anodes: True when the columns connect to the diode anodes, so the
+//|     columns are pulled up and the selected row is driven low. False pulls the columns down and
+//|     drives the selected row high.
+//|   :param float interval: Seconds between scans, rounded to the nearest millisecond
+//|   :param int debounce_scans: How many scans in a row must agree before a change is accepted
+//|   :param int max_events: How many events the `events` queue holds
+//|
+STATIC size_t get_pins(mp_obj_t seq, qstr name, const mcu_pin_obj_t** pins) {
+    size_t pin_count;
+    mp_obj_t *pin_objs;
+    mp_obj_get_array(seq, &pin_count, &pin_objs);
+    if (pin_count == 0) {
+        mp_raise_ValueError_varg(translate("%q must not be empty"), name);
+    }
+    if (pin_count > KEYMATRIX_MAX_PINS) {
+        mp_raise_ValueError_varg(translate("%q length must be <= %d"), name, KEYMATRIX_MAX_PINS);
+    }
+    for (size_t i = 0; i < pin_count; i++) {
+        assert_pin(pin_objs[i], false);
+        pins[i] = MP_OBJ_TO_PTR(pin_objs[i]);
+        assert_pin_free(pins[i]);
+    }
+    return pin_count;
+}
+
+STATIC mp_obj_t keypad_keymatrix_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_row_pins, ARG_column_pins, ARG_columns_to_anodes, ARG_interval, ARG_debounce_scans, ARG_max_events };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_row_pins, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_column_pins, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_columns_to_anodes, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_interval, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_debounce_scans, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 1} },
+        { MP_QSTR_max_events, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 64} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const mcu_pin_obj_t* row_pins[KEYMATRIX_MAX_PINS];
+    const mcu_pin_obj_t* column_pins[KEYMATRIX_MAX_PINS];
+    size_t row_count = get_pins(args[ARG_row_pins].u_obj, MP_QSTR_row_pins, row_pins);
+    size_t column_count = get_pins(args[ARG_column_pins].u_obj, MP_QSTR_column_pins, column_pins);
+    for (size_t i = 0; i < row_count + column_count; i++) {
+        const mcu_pin_obj_t* pin = i < row_count ? row_pins[i] : column_pins[i - row_count];
+        for (size_t j = 0; j < i; j++) {
+            if ((j < row_count ? row_pins[j] : column_pins[j - row_count]) == pin) {
+                mp_raise_ValueError(translate("Invalid pins"));
+            }
+        }
+    }
+
+    uint32_t interval_ms = keypad_validate_interval(args[ARG_interval].u_obj);
+    uint8_t debounce_scans = keypad_validate_debounce_scans(args[ARG_debounce_scans].u_int);
+    uint16_t max_events = keypad_validate_max_events(args[ARG_max_events].u_int);
+
+    keypad_keymatrix_obj_t *self = m_new_obj(keypad_keymatrix_obj_t);
+    self->scanner.base.type = &keypad_keymatrix_type;
+    common_hal_keypad_keymatrix_construct(self, row_pins, row_count, column_pins, column_count,
+        args[ARG_columns_to_anodes].u_bool, interval_ms, debounce_scans, max_events);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Stop scanning and release the pins for other use.
+//|
+STATIC mp_obj_t keypad_keymatrix_obj_deinit(mp_obj_t self_in) {
+    keypad_keymatrix_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_keypad_keymatrix_deinit(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_keymatrix_deinit_obj, keypad_keymatrix_obj_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t keypad_keymatrix_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_keypad_keymatrix_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(keypad_keymatrix_obj___exit___obj, 4, 4, keypad_keymatrix_obj___exit__);
+
+//|   .. attribute:: events
+//|
+//|     The `EventQueue` that key presses and releases are added to. (read-only)
+//|
+STATIC mp_obj_t keypad_keymatrix_obj_get_events(mp_obj_t self_in) {
+    keypad_keymatrix_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_keypad_keymatrix_deinited(self));
+    return MP_OBJ_FROM_PTR(common_hal_keypad_keymatrix_get_events(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_keymatrix_get_events_obj, keypad_keymatrix_obj_get_events);
+
+const mp_obj_property_t keypad_keymatrix_events_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_keymatrix_get_events_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: key_count
+//|
+//|     The number of keys scanned, ``len(row_pins) * len(column_pins)``. (read-only)
+//|
+STATIC mp_obj_t keypad_keymatrix_obj_get_key_count(mp_obj_t self_in) {
+    keypad_keymatrix_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_keypad_keymatrix_deinited(self));
+    return MP_OBJ_NEW_SMALL_INT(common_hal_keypad_keymatrix_get_key_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_keymatrix_get_key_count_obj, keypad_keymatrix_obj_get_key_count);
+
+const mp_obj_property_t keypad_keymatrix_key_count_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_keymatrix_get_key_count_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t keypad_keymatrix_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&keypad_keymatrix_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&keypad_keymatrix_obj___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_events), MP_ROM_PTR(&keypad_keymatrix_events_obj) },
+    { MP_ROM_QSTR(MP_QSTR_key_count), MP_ROM_PTR(&keypad_keymatrix_key_count_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(keypad_keymatrix_locals_dict, keypad_keymatrix_locals_dict_table);
+
+const mp_obj_type_t keypad_keymatrix_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_KeyMatrix,
+    .make_new = keypad_keymatrix_make_new,
+    .locals_dict = (mp_obj_dict_t*)&keypad_keymatrix_locals_dict,
+};
@@ -0,0 +1,206 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "lib/utils/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/busio/SPI.h"
+#include "shared-bindings/keypad/__init__.h"
+#include "shared-bindings/keypad/EventQueue.h"
+#include "shared-bindings/keypad/ShiftRegisterKeys.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/util.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: keypad
+//|
+//| :class:`ShiftRegisterKeys` -- Scan keys through shift registers
+//| ===============================================================
+//|
+//| .. class:: ShiftRegisterKeys(*, latch, key_count, value_when_pressed, clock=None, data=None, spi=None, interval=0.02, debounce_scans=1, max_events=64)
+//|
+//|   Scan keys on a chain of parallel-in, serial-out shift registers such as the 74HC165 or
+//|   CD4021. The registers are loaded by pulsing ``latch`` low and then shifted in, first bit
+//|   first, so the first bit read is key 0.
+//|
+//|   Give either ``spi`` or both ``clock`` and ``data``. With ``spi`` the bits are clocked in by
+//|   the SPI peripheral at its current settings. The bus is only used when it can be locked, so
+//|   it can be shared with other devices, but a scan is skipped while someone else holds it.
+//|
+//|   :param ~microcontroller.Pin latch: The pin that loads the registers
+//|   :param int key_count: The number of keys to read
+//|   :param bool value_when_pressed: The bit value that means a key is pressed
+//|   :param ~microcontroller.Pin clock: The clock pin when bit banging
+//|   :param ~microcontroller.Pin data: The data pin when bit banging
+//|   :param busio.SPI spi: The SPI bus to read the registers with instead
+//|   :param float interval: Seconds between scans, rounded to the nearest millisecond
+//|   :param int debounce_scans: How many scans in a row must agree before a change is accepted
+//|   :param int max_events: How many events the `events` queue holds
+//|
+STATIC mp_obj_t keypad_shiftregisterkeys_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_latch, ARG_key_count, ARG_value_when_pressed, ARG_clock, ARG_data, ARG_spi, ARG_interval, ARG_debounce_scans, ARG_max_events };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_latch, MP_ARG_KW_ONLY | MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_key_count, MP_ARG_KW_ONLY | MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_value_when_pressed, MP_ARG_KW_ONLY | MP_ARG_REQUIRED | MP_ARG_BOOL },
+        { MP_QSTR_clock, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_data, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_spi, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_interval, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_debounce_scans, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 1} },
+        { MP_QSTR_max_events, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 64} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    assert_pin(args[ARG_latch].u_obj, false);
+    const mcu_pin_obj_t* latch = MP_OBJ_TO_PTR(args[ARG_latch].u_obj);
+    assert_pin_free(latch);
+
+    const mcu_pin_obj_t* clock = NULL;
+    const mcu_pin_obj_t* data = NULL;
+    busio_spi_obj_t* spi = NULL;
+    if (args[ARG_spi].u_obj != mp_const_none) {
+        if (args[ARG_clock].u_obj != mp_const_none || args[ARG_data].u_obj != mp_const_none) {
+            mp_raise_ValueError(translate("Invalid pins"));
+        }
+        if (!MP_OBJ_IS_TYPE(args[ARG_spi].u_obj, &busio_spi_type)) {
+            mp_raise_TypeError_varg(translate("Expected a %q"), MP_QSTR_SPI);
+        }
+        spi = MP_OBJ_TO_PTR(args[ARG_spi].u_obj);
+        raise_error_if_deinited(common_hal_busio_spi_deinited(spi));
+    } else {
+        assert_pin(args[ARG_clock].u_obj, false);
+        clock = MP_OBJ_TO_PTR(args[ARG_clock].u_obj);
+        assert_pin_free(clock);
+        assert_pin(args[ARG_data].u_obj, false);
+        data = MP_OBJ_TO_PTR(args[ARG_data].u_obj);
+        assert_pin_free(data);
+        if (clock == latch || data == latch || clock == data) {
+            mp_raise_ValueError(translate("Invalid pins"));
+        }
+    }
+
+    mp_int_t key_count = args[ARG_key_count].u_int;
+    if (key_count < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_key_count);
+    }
+    if (key_count > 0xffff) {
+        mp_raise_ValueError_varg(translate("%q must be <= %d"), MP_QSTR_key_count, 0xffff);
+    }
+    uint32_t interval_ms = keypad_validate_interval(args[ARG_interval].u_obj);
+    uint8_t debounce_scans = keypad_validate_debounce_scans(args[ARG_debounce_scans].u_int);
+    uint16_t max_events = keypad_validate_max_events(args[ARG_max_events].u_int);
+
+    keypad_shiftregisterkeys_obj_t *self = m_new_obj(keypad_shiftregisterkeys_obj_t);
+    self->scanner.base.type = &keypad_shiftregisterkeys_type;
+    common_hal_keypad_shiftregisterkeys_construct(self, latch, clock, data, spi, key_count,
+        args[ARG_value_when_pressed].u_bool, interval_ms, debounce_scans, max_events);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: deinit()
+//|
+//|      Stop scanning and release the pins for other use. An SPI bus is left as it is.
+//|
+STATIC mp_obj_t keypad_shiftregisterkeys_obj_deinit(mp_obj_t self_in) {
+    keypad_shiftregisterkeys_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_keypad_shiftregisterkeys_deinit(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_shiftregisterkeys_deinit_obj, keypad_shiftregisterkeys_obj_deinit);
+
+//|   .. method:: __enter__()
+//|
+//|      No-op used by Context Managers.
+//|
+//  Provided by context manager helper.
+
+//|   .. method:: __exit__()
+//|
+//|      Automatically deinitializes the hardware when exiting a context. See
+//|      :ref:`lifetime-and-contextmanagers` for more info.
+//|
+STATIC mp_obj_t keypad_shiftregisterkeys_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_keypad_shiftregisterkeys_deinit(args[0]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(keypad_shiftregisterkeys_obj___exit___obj, 4, 4, keypad_shiftregisterkeys_obj___exit__);
+
+//|   .. attribute:: events
+//|
+//|     The `EventQueue` that key presses and releases are added to. (read-only)
+//|
+STATIC mp_obj_t keypad_shiftregisterkeys_obj_get_events(mp_obj_t self_in) {
+    keypad_shiftregisterkeys_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_keypad_shiftregisterkeys_deinited(self));
+    return MP_OBJ_FROM_PTR(common_hal_keypad_shiftregisterkeys_get_events(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_shiftregisterkeys_get_events_obj, keypad_shiftregisterkeys_obj_get_events);
+
+const mp_obj_property_t keypad_shiftregisterkeys_events_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_shiftregisterkeys_get_events_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: key_count
+//|
+//|     The number of keys scanned. (read-only)
+//|
+STATIC mp_obj_t keypad_shiftregisterkeys_obj_get_key_count(mp_obj_t self_in) {
+    keypad_shiftregisterkeys_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_keypad_shiftregisterkeys_deinited(self));
+    return MP_OBJ_NEW_SMALL_INT(common_hal_keypad_shiftregisterkeys_get_key_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(keypad_shiftregisterkeys_get_key_count_obj, keypad_shiftregisterkeys_obj_get_key_count);
+
+const mp_obj_property_t keypad_shiftregisterkeys_key_count_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&keypad_shiftregisterkeys_get_key_count_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t keypad_shiftregisterkeys_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&keypad_shiftregisterkeys_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&keypad_shiftregisterkeys_obj___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_events), MP_ROM_PTR(&keypad_shiftregisterkeys_events_obj) },
+    { MP_ROM_QSTR(MP_QSTR_key_count), MP_ROM_PTR(&keypad_shiftregisterkeys_key_count_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(keypad_shiftregisterkeys_locals_dict, keypad_shiftregisterkeys_locals_dict_table);
+
+const mp_obj_type_t keypad_shiftregisterkeys_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_ShiftRegisterKeys,
+    .make_new = keypad_shiftregisterkeys_make_new,
+    .locals_dict = (mp_obj_dict_t*)&keypad_shiftregisterkeys_locals_dict,
+};
@@ -0,0 +1,119 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/keypad/__init__.h"
+#include "shared-bindings/keypad/Event.h"
+#include "shared-bindings/keypad/EventQueue.h"
+#include "shared-bindings/keypad/KeyMatrix.h"
+#include "shared-bindings/keypad/ShiftRegisterKeys.h"
+#include "shared-module/keypad/__init__.h"
+#include "supervisor/shared/translate.h"
+
+//| :mod:`keypad` --- Scan keys in the background
+//| =============================================
+//|
+//| .. module:: keypad
+//|   :synopsis: Scan keys in the background
+//|   :platform: SAMD, nRF
+//|
+//| The `keypad` module scans a key matrix or a chain of parallel-in shift registers in the
+//| background, debounces the readings and queues a timestamped `Event` for every press and
+//| release. Code reads the `EventQueue` when it is ready, so short presses aren't missed while
+//| it is busy elsewhere. Scans run between bytecodes and during `time.sleep`, not from an
+//| interrupt, which lets a shift register share its SPI bus with other devices.
+//|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     Event
+//|     EventQueue
+//|     KeyMatrix
+//|     ShiftRegisterKeys
+//|
+
+//| .. warning:: This module is only available in some builds. See the
+//|   :ref:`module-support-matrix` for more info.
+//|
+
+//| All scanners change hardware state and should be deinitialized when they
+//| are no longer needed if the program continues after use. To do so, either
+//| call :py:meth:`!deinit` or use a context manager. See
+//| :ref:`lifetime-and-contextmanagers` for more info.
+//|
+
+uint32_t keypad_validate_interval(mp_obj_t interval_in) {
+    if (interval_in == mp_const_none) {
+        return KEYPAD_DEFAULT_INTERVAL_MS;
+    }
+    mp_float_t interval = mp_obj_get_float(interval_in);
+    if (interval < MICROPY_FLOAT_CONST(0.001) || interval > MICROPY_FLOAT_CONST(1000000.0)) {
+        mp_raise_ValueError(translate("interval must be in range 0.001-1000000"));
+    }
+    return (uint32_t) (interval * 1000 + MICROPY_FLOAT_CONST(0.5));
+}
+
+uint8_t keypad_validate_debounce_scans(mp_int_t debounce_scans) {
+    if (debounce_scans < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_debounce_scans);
+    }
+    if (debounce_scans > KEYPAD_KEY_COUNT_MASK) {
+        mp_raise_ValueError_varg(translate("%q must be <= %d"), MP_QSTR_debounce_scans,
+                                 KEYPAD_KEY_COUNT_MASK);
+    }
+    return debounce_scans;
+}
+
+uint16_t keypad_validate_max_events(mp_int_t max_events) {
+    if (max_events < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_max_events);
+    }
+    if (max_events > 0xffff) {
+        mp_raise_ValueError_varg(translate("%q must be <= %d"), MP_QSTR_max_events, 0xffff);
+    }
+    return max_events;
+}
+
+STATIC const mp_rom_map_elem_t keypad_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_keypad) },
+    { MP_ROM_QSTR(MP_QSTR_Event), MP_ROM_PTR(&keypad_event_type) },
+    { MP_ROM_QSTR(MP_QSTR_EventQueue), MP_ROM_PTR(&keypad_eventqueue_type) },
+    { MP_ROM_QSTR(MP_QSTR_KeyMatrix), MP_ROM_PTR(&keypad_keymatrix_type) },
+    { MP_ROM_QSTR(MP_QSTR_ShiftRegisterKeys), MP_ROM_PTR(&keypad_shiftregisterkeys_type) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(keypad_module_globals, keypad_module_globals_table);
+
+const mp_obj_module_t keypad_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&keypad_module_globals,
+};
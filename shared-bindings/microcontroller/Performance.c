@@ -0,0 +1,88 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/microcontroller/Performance.h"
+
+//| .. currentmodule:: microcontroller
+//|
+//| :class:`Performance` -- how fast the CPU runs
+//| =============================================
+//|
+//| .. class:: microcontroller.Performance
+//|
+//|     Enum-like class to define how fast the CPU runs. Slower levels use less power. Ports
+//|     that can't change their clock run at the same speed for every level.
+//|
+//|     .. data:: LOW
+//|
+//|       Run slowly to save the most power. Displays refreshing, audio playing and imports
+//|       still get the full speed.
+//|
+//|     .. data:: NORMAL
+//|
+//|       Run at half speed, also boosting for heavy work like `LOW`.
+//|
+//|     .. data:: BOOST
+//|
+//|       Always run at full speed. This is the default.
+//|
+const mp_obj_type_t mcu_performance_type;
+
+const mcu_performance_obj_t mcu_performance_low_obj = {
+    { &mcu_performance_type },
+};
+
+const mcu_performance_obj_t mcu_performance_normal_obj = {
+    { &mcu_performance_type },
+};
+
+const mcu_performance_obj_t mcu_performance_boost_obj = {
+    { &mcu_performance_type },
+};
+
+STATIC const mp_rom_map_elem_t mcu_performance_locals_dict_table[] = {
+    {MP_ROM_QSTR(MP_QSTR_LOW),    MP_ROM_PTR(&mcu_performance_low_obj)},
+    {MP_ROM_QSTR(MP_QSTR_NORMAL), MP_ROM_PTR(&mcu_performance_normal_obj)},
+    {MP_ROM_QSTR(MP_QSTR_BOOST),  MP_ROM_PTR(&mcu_performance_boost_obj)},
+};
+STATIC MP_DEFINE_CONST_DICT(mcu_performance_locals_dict, mcu_performance_locals_dict_table);
+
+STATIC void mcu_performance_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    qstr level = MP_QSTR_BOOST;
+    if (MP_OBJ_TO_PTR(self_in) == MP_ROM_PTR(&mcu_performance_low_obj)) {
+        level = MP_QSTR_LOW;
+    } else if (MP_OBJ_TO_PTR(self_in) == MP_ROM_PTR(&mcu_performance_normal_obj)) {
+        level = MP_QSTR_NORMAL;
+    }
+    mp_printf(print, "%q.%q.%q", MP_QSTR_microcontroller, MP_QSTR_Performance, level);
+}
+
+const mp_obj_type_t mcu_performance_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Performance,
+    .print = mcu_performance_print,
+    .locals_dict = (mp_obj_t)&mcu_performance_locals_dict,
+};
@@ -25,6 +25,7 @@
  */
 
 #include "shared-bindings/microcontroller/__init__.h"
+#include "shared-bindings/microcontroller/Performance.h"
 #include "shared-bindings/microcontroller/Processor.h"
 
 #include <math.h>
@@ -33,6 +34,8 @@
 #include "py/objproperty.h"
 
 #include "py/runtime.h"
+#include "supervisor/shared/performance.h"
+#include "supervisor/shared/translate.h"
 
 //| .. currentmodule:: microcontroller
 //|
@@ -56,7 +59,8 @@
 
 //|     .. attribute:: frequency
 //|
-//|       The CPU operating frequency as an `int`, in Hertz. (read-only)
+//|       The CPU operating frequency as an `int`, in Hertz. It changes with `performance`.
+//|       (read-only)
 //|
 STATIC mp_obj_t mcu_processor_get_frequency(mp_obj_t self) {
     return mp_obj_new_int_from_uint(common_hal_mcu_processor_get_frequency());
@@ -72,6 +76,51 @@ const mp_obj_property_t mcu_processor_frequency_obj = {
     },
 };
 
+//|     .. attribute:: performance
+//|
+//|       How fast the CPU runs as a `microcontroller.Performance`. Below `Performance.BOOST`
+//|       the CPU is slower and uses less power, except that it speeds up on its own while
+//|       displays refresh, audio is decoded and modules are imported. Peripherals keep their
+//|       timing at every level. Resets to `Performance.BOOST` when the VM restarts.
+//|
+STATIC mp_obj_t mcu_processor_get_performance(mp_obj_t self) {
+    switch (supervisor_performance_get_level()) {
+        case PERFORMANCE_LOW:
+            return (mp_obj_t)&mcu_performance_low_obj;
+        case PERFORMANCE_NORMAL:
+            return (mp_obj_t)&mcu_performance_normal_obj;
+        default:
+            return (mp_obj_t)&mcu_performance_boost_obj;
+    }
+}
+
+MP_DEFINE_CONST_FUN_OBJ_1(mcu_processor_get_performance_obj, mcu_processor_get_performance);
+
+STATIC mp_obj_t mcu_processor_set_performance(mp_obj_t self, mp_obj_t level_obj) {
+    mcu_performance_t level;
+    if (level_obj == &mcu_performance_low_obj) {
+        level = PERFORMANCE_LOW;
+    } else if (level_obj == &mcu_performance_normal_obj) {
+        level = PERFORMANCE_NORMAL;
+    } else if (level_obj == &mcu_performance_boost_obj) {
+        level = PERFORMANCE_BOOST;
+    } else {
+        mp_raise_TypeError_varg(translate("Expected a %q"), MP_QSTR_Performance);
+    }
+    supervisor_performance_set_level(level);
+    return mp_const_none;
+}
+
+MP_DEFINE_CONST_FUN_OBJ_2(mcu_processor_set_performance_obj, mcu_processor_set_performance);
+
+const mp_obj_property_t mcu_processor_performance_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&mcu_processor_get_performance_obj,
+              (mp_obj_t)&mcu_processor_set_performance_obj,
+              (mp_obj_t)&mp_const_none_obj,
+    },
+};
+
 //|     .. attribute:: temperature
 //|
 //|       The on-chip temperature, in Celsius, as a float. (read-only)
@@ -115,6 +164,7 @@ const mp_obj_property_t mcu_processor_uid_obj = {
 
 STATIC const mp_rom_map_elem_t mcu_processor_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&mcu_processor_frequency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_performance), MP_ROM_PTR(&mcu_processor_performance_obj) },
     { MP_ROM_QSTR(MP_QSTR_temperature), MP_ROM_PTR(&mcu_processor_temperature_obj) },
     { MP_ROM_QSTR(MP_QSTR_uid), MP_ROM_PTR(&mcu_processor_uid_obj) },
 };
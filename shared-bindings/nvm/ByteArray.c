@@ -37,8 +37,9 @@
 //| ================================================================================
 //|
 //| Non-volatile memory is available as a byte array that persists over reloads
-//| and power cycles. Each assignment causes an erase and write cycle so its recommended to assign
-//| all values to change at once.
+//| and power cycles. Each assignment may cause an erase and write cycle so its recommended to assign
+//| all values to change at once. Some ports hold back writes briefly to combine them, these are
+//| written out before the VM resets.
 //|
 //| Usage::
 //|
@@ -78,6 +78,25 @@ mp_obj_t os_getcwd(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(os_getcwd_obj, os_getcwd);
 
+//| .. function:: ilistdir([dir])
+//|
+//|   Return an iterator over the entries of the current directory, or the given directory, without
+//|   building a list of them first. Each entry is a tuple of ``(name, type, inode[, size])``.
+//|   ``type`` is ``0x4000`` for a directory and ``0x8000`` for a file, ``inode`` is always 0 and
+//|   ``size`` is the file size in bytes, which saves calling `stat` for each entry. Directories
+//|   that other filesystems are mounted on have no ``size``.
+//|
+mp_obj_t os_ilistdir(size_t n_args, const mp_obj_t *args) {
+    const char* path;
+    if (n_args == 1) {
+        path = mp_obj_str_get_str(args[0]);
+    } else {
+        path = mp_obj_str_get_str(common_hal_os_getcwd());
+    }
+    return common_hal_os_ilistdir(path);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(os_ilistdir_obj, 0, 1, os_ilistdir);
+
 //| .. function:: listdir([dir])
 //|
 //|   With no argument, list the current directory.  Otherwise list the given directory.
@@ -210,6 +229,7 @@ STATIC const mp_rom_map_elem_t os_module_globals_table[] = {
 
     { MP_ROM_QSTR(MP_QSTR_chdir), MP_ROM_PTR(&os_chdir_obj) },
     { MP_ROM_QSTR(MP_QSTR_getcwd), MP_ROM_PTR(&os_getcwd_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ilistdir), MP_ROM_PTR(&os_ilistdir_obj) },
     { MP_ROM_QSTR(MP_QSTR_listdir), MP_ROM_PTR(&os_listdir_obj) },
     { MP_ROM_QSTR(MP_QSTR_mkdir), MP_ROM_PTR(&os_mkdir_obj) },
     { MP_ROM_QSTR(MP_QSTR_remove), MP_ROM_PTR(&os_remove_obj) },
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/profiler/__init__.h"
+#include "shared-module/profiler/__init__.h"
+#include "supervisor/shared/translate.h"
+
+//| :mod:`profiler` --- Find where Python code spends its time
+//| ===========================================================
+//|
+//| .. module:: profiler
+//|   :synopsis: Find where Python code spends its time
+//|   :platform: SAMD, nRF
+//|
+//| The `profiler` module samples the line of Python being run from the millisecond tick
+//| interrupt and counts how often each line is seen. Lines that are hit often are where the time
+//| goes. Time spent inside a native function or a C module counts against the line that called
+//| it.
+//|
+//| .. code-block:: python
+//|
+//|   import profiler
+//|
+//|   profiler.start()
+//|   main_loop()
+//|   profiler.stop()
+//|   counts = profiler.stats()
+//|   for line in sorted(counts, key=counts.get, reverse=True)[:10]:
+//|       print(counts[line], line)
+//|
+
+//| .. warning:: This module is only available in some builds. See the
+//|   :ref:`module-support-matrix` for more info.
+//|
+
+//| .. function:: start(interval=0.001)
+//|
+//|   Clear the counts and start sampling every ``interval`` seconds. The interval is rounded to
+//|   the nearest millisecond.
+//|
+STATIC mp_obj_t profiler_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_interval };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_interval, MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t interval = MICROPY_FLOAT_CONST(0.001);
+    if (args[ARG_interval].u_obj != MP_OBJ_NULL) {
+        interval = mp_obj_get_float(args[ARG_interval].u_obj);
+    }
+    if (interval < MICROPY_FLOAT_CONST(0.001) || interval > MICROPY_FLOAT_CONST(1000000.0)) {
+        mp_raise_ValueError(translate("interval must be in range 0.001-1000000"));
+    }
+    shared_module_profiler_start((uint32_t) (interval * 1000 + MICROPY_FLOAT_CONST(0.5)));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(profiler_start_obj, 0, profiler_start);
+
+//| .. function:: stop()
+//|
+//|   Stop sampling. The counts are kept until the next `start`.
+//|
+STATIC mp_obj_t profiler_stop(void) {
+    shared_module_profiler_stop();
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(profiler_stop_obj, profiler_stop);
+
+//| .. function:: stats()
+//|
+//|   Return a dict of sample counts keyed by ``(file, function, line)``. Samples taken while no
+//|   Python code was running, or that didn't fit in the table of 64 lines, are counted under
+//|   ``None``.
+//|
+STATIC mp_obj_t profiler_stats(void) {
+    size_t count;
+    const profiler_line_t* lines = profiler_lines(&count);
+    mp_obj_t stats = mp_obj_new_dict(0);
+    for (size_t i = 0; i < count; i++) {
+        // The tick fills in a slot before counting it, so a counted slot is complete.
+        uint32_t samples = lines[i].count;
+        if (samples == 0) {
+            continue;
+        }
+        mp_obj_t key = mp_const_none;
+        if (i != 0) {
+            mp_obj_t items[3] = {
+                MP_OBJ_NEW_QSTR(lines[i].source_file),
+                MP_OBJ_NEW_QSTR(lines[i].block_name),
+                MP_OBJ_NEW_SMALL_INT(lines[i].line),
+            };
+            key = mp_obj_new_tuple(3, items);
+        }
+        mp_obj_dict_store(stats, key, mp_obj_new_int_from_uint(samples));
+    }
+    return stats;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(profiler_stats_obj, profiler_stats);
+
+STATIC const mp_rom_map_elem_t profiler_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_profiler) },
+    { MP_ROM_QSTR(MP_QSTR_start), MP_ROM_PTR(&profiler_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&profiler_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&profiler_stats_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(profiler_module_globals, profiler_module_globals_table);
+
+const mp_obj_module_t profiler_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&profiler_module_globals,
+};
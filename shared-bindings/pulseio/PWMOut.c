@@ -155,7 +155,9 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pulseio_pwmout___exit___obj, 4, 4, pu
 //|
 //|      16 bit value that dictates how much of one cycle is high (1) versus low
 //|      (0). 0xffff will always be high, 0 will always be low and 0x7fff will
-//|      be half high and then half low.
+//|      be half high and then half low. Where the hardware allows, a new value
+//|      takes effect at the end of the current period. To change several
+//|      outputs together use `pulseio.set_duty_cycles`.
 STATIC mp_obj_t pulseio_pwmout_obj_get_duty_cycle(mp_obj_t self_in) {
     pulseio_pwmout_obj_t *self = MP_OBJ_TO_PTR(self_in);
     raise_error_if_deinited(common_hal_pulseio_pwmout_deinited(self));
@@ -46,6 +46,8 @@ extern pwmout_result_t common_hal_pulseio_pwmout_construct(pulseio_pwmout_obj_t*
 extern void common_hal_pulseio_pwmout_deinit(pulseio_pwmout_obj_t* self);
 extern bool common_hal_pulseio_pwmout_deinited(pulseio_pwmout_obj_t* self);
 extern void common_hal_pulseio_pwmout_set_duty_cycle(pulseio_pwmout_obj_t* self, uint16_t duty);
+extern void common_hal_pulseio_pwmout_set_duty_cycles(pulseio_pwmout_obj_t** pwms,
+    const uint16_t* duty_cycles, size_t count);
 extern uint16_t common_hal_pulseio_pwmout_get_duty_cycle(pulseio_pwmout_obj_t* self);
 extern void common_hal_pulseio_pwmout_set_frequency(pulseio_pwmout_obj_t* self, uint32_t frequency);
 extern uint32_t common_hal_pulseio_pwmout_get_frequency(pulseio_pwmout_obj_t* self);
@@ -114,7 +114,7 @@ STATIC mp_obj_t pulseio_pulseout_obj___exit__(size_t n_args, const mp_obj_t *arg
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pulseio_pulseout___exit___obj, 4, 4, pulseio_pulseout_obj___exit__);
 
-//|   .. method:: send(pulses)
+//|   .. method:: send(pulses, *, loop=False)
 //|
 //|     Pulse alternating on and off durations in microseconds starting with on.
 //|     ``pulses`` must be an `array.array` with data type 'H' for unsigned
@@ -123,21 +123,48 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pulseio_pulseout___exit___obj, 4, 4,
 //|     This method waits until the whole array of pulses has been sent and
 //|     ensures the signal is off afterwards.
 //|
-//|     :param array.array pulses: pulse durations in microseconds
+//|     When ``loop`` is True the pulses repeat until `stop` is called, another
+//|     send is started or the PulseOut is deinitialized, and this method returns
+//|     straight away. The pulses are copied so ``pulses`` may be changed
+//|     afterwards. There must be an even number of pulses so that each
+//|     repetition starts with on. Looping is only available where the port can
+//|     stream pulses without the CPU.
 //|
-STATIC mp_obj_t pulseio_pulseout_obj_send(mp_obj_t self_in, mp_obj_t pulses) {
-    pulseio_pulseout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+//|     :param array.array pulses: pulse durations in microseconds
+//|     :param bool loop: repeat the pulses until stopped
+//|
+STATIC mp_obj_t pulseio_pulseout_obj_send(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_pulses, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pulses, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_loop, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    pulseio_pulseout_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     raise_error_if_deinited(common_hal_pulseio_pulseout_deinited(self));
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(pulses, &bufinfo, MP_BUFFER_READ);
+    mp_get_buffer_raise(args[ARG_pulses].u_obj, &bufinfo, MP_BUFFER_READ);
     if (bufinfo.typecode != 'H') {
         mp_raise_TypeError(translate("Array must contain halfwords (type 'H')"));
     }
-    common_hal_pulseio_pulseout_send(self, (uint16_t *)bufinfo.buf, bufinfo.len / 2);
+    common_hal_pulseio_pulseout_send(self, (uint16_t *)bufinfo.buf, bufinfo.len / 2, args[ARG_loop].u_bool);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(pulseio_pulseout_send_obj, 2, pulseio_pulseout_obj_send);
+
+//|   .. method:: stop()
+//|
+//|     Stop a looping send and turn the signal off. Does nothing otherwise.
+//|
+STATIC mp_obj_t pulseio_pulseout_obj_stop(mp_obj_t self_in) {
+    pulseio_pulseout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_pulseio_pulseout_deinited(self));
+    common_hal_pulseio_pulseout_stop(self);
     return mp_const_none;
 }
-MP_DEFINE_CONST_FUN_OBJ_2(pulseio_pulseout_send_obj, pulseio_pulseout_obj_send);
+MP_DEFINE_CONST_FUN_OBJ_1(pulseio_pulseout_stop_obj, pulseio_pulseout_obj_stop);
 
 STATIC const mp_rom_map_elem_t pulseio_pulseout_locals_dict_table[] = {
     // Methods
@@ -145,6 +172,7 @@ STATIC const mp_rom_map_elem_t pulseio_pulseout_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&pulseio_pulseout___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&pulseio_pulseout_send_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&pulseio_pulseout_stop_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(pulseio_pulseout_locals_dict, pulseio_pulseout_locals_dict_table);
 
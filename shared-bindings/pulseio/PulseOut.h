@@ -38,6 +38,7 @@ extern void common_hal_pulseio_pulseout_construct(pulseio_pulseout_obj_t* self,
 extern void common_hal_pulseio_pulseout_deinit(pulseio_pulseout_obj_t* self);
 extern bool common_hal_pulseio_pulseout_deinited(pulseio_pulseout_obj_t* self);
 extern void common_hal_pulseio_pulseout_send(pulseio_pulseout_obj_t* self,
-    uint16_t* pulses, uint16_t len);
+    uint16_t* pulses, uint16_t len, bool loop);
+extern void common_hal_pulseio_pulseout_stop(pulseio_pulseout_obj_t* self);
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_PULSEIO_PULSEOUT_H
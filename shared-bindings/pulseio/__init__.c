@@ -34,6 +34,7 @@
 #include "shared-bindings/pulseio/PulseIn.h"
 #include "shared-bindings/pulseio/PulseOut.h"
 #include "shared-bindings/pulseio/PWMOut.h"
+#include "shared-bindings/util.h"
 
 //| :mod:`pulseio` --- Support for pulse based protocols
 //| =====================================================
@@ -80,11 +81,54 @@
 //| to do it yourself.
 //|
 
+//| .. function:: set_duty_cycles(pwms, duty_cycles)
+//|
+//|   Set the duty cycles of several `PWMOut` objects in one call. Outputs that
+//|   share a timer switch to their new duty cycles at the same period
+//|   boundary, so related channels such as motor phases or RGB LEDs never
+//|   show a mix of old and new values.
+//|
+//|   :param sequence pwms: The `PWMOut` objects to update
+//|   :param sequence duty_cycles: A 16 bit duty cycle for each of ``pwms``
+//|
+STATIC mp_obj_t pulseio_set_duty_cycles(mp_obj_t pwms_in, mp_obj_t duty_cycles_in) {
+    size_t count;
+    mp_obj_t *pwm_items;
+    mp_obj_get_array(pwms_in, &count, &pwm_items);
+    size_t duty_count;
+    mp_obj_t *duty_items;
+    mp_obj_get_array(duty_cycles_in, &duty_count, &duty_items);
+    if (duty_count != count) {
+        mp_raise_ValueError_varg(translate("Expected tuple of length %d, got %d"), count, duty_count);
+    }
+
+    pulseio_pwmout_obj_t **pwms = m_new(pulseio_pwmout_obj_t*, count);
+    uint16_t *duty_cycles = m_new(uint16_t, count);
+    for (size_t i = 0; i < count; i++) {
+        if (!MP_OBJ_IS_TYPE(pwm_items[i], &pulseio_pwmout_type)) {
+            mp_raise_TypeError_varg(translate("Expected a %q"), MP_QSTR_PWMOut);
+        }
+        pwms[i] = MP_OBJ_TO_PTR(pwm_items[i]);
+        raise_error_if_deinited(common_hal_pulseio_pwmout_deinited(pwms[i]));
+        mp_int_t duty = mp_obj_get_int(duty_items[i]);
+        if (duty < 0 || duty > 0xffff) {
+            mp_raise_ValueError(translate("PWM duty_cycle must be between 0 and 65535 inclusive (16 bit resolution)"));
+        }
+        duty_cycles[i] = duty;
+    }
+    common_hal_pulseio_pwmout_set_duty_cycles(pwms, duty_cycles, count);
+    m_del(pulseio_pwmout_obj_t*, pwms, count);
+    m_del(uint16_t, duty_cycles, count);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pulseio_set_duty_cycles_obj, pulseio_set_duty_cycles);
+
 STATIC const mp_rom_map_elem_t pulseio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_pulseio) },
     { MP_ROM_QSTR(MP_QSTR_PulseIn), MP_ROM_PTR(&pulseio_pulsein_type) },
     { MP_ROM_QSTR(MP_QSTR_PulseOut), MP_ROM_PTR(&pulseio_pulseout_type) },
     { MP_ROM_QSTR(MP_QSTR_PWMOut), MP_ROM_PTR(&pulseio_pwmout_type) },
+    { MP_ROM_QSTR(MP_QSTR_set_duty_cycles), MP_ROM_PTR(&pulseio_set_duty_cycles_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(pulseio_module_globals, pulseio_module_globals_table);
@@ -170,6 +170,42 @@ STATIC mp_obj_t random_uniform(mp_obj_t a_in, mp_obj_t b_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(random_uniform_obj, random_uniform);
 
+//| .. function:: randbytes(n)
+//|
+//|   Returns *n* random bytes.
+//|
+STATIC mp_obj_t random_randbytes(mp_obj_t n_in) {
+    mp_int_t n = mp_obj_get_int(n_in);
+    if (n < 0) {
+        mp_raise_ValueError(NULL);
+    }
+    vstr_t vstr;
+    vstr_init_len(&vstr, n);
+    shared_modules_random_fill_bytes((uint8_t*) vstr.buf, n);
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_randbytes_obj, random_randbytes);
+
+//| .. function:: fill(buffer)
+//|
+//|   Fills *buffer* in place without allocating. An ``array.array`` of type
+//|   ``'f'`` or ``'d'`` gets random floats between 0 and 1.0, as from
+//|   `random()`. Any other buffer, such as a ``bytearray``, gets random bits.
+//|
+STATIC mp_obj_t random_fill(mp_obj_t buffer_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.typecode == 'f') {
+        shared_modules_random_fill_floats(bufinfo.buf, bufinfo.len / sizeof(float));
+    } else if (bufinfo.typecode == 'd') {
+        shared_modules_random_fill_doubles(bufinfo.buf, bufinfo.len / sizeof(double));
+    } else {
+        shared_modules_random_fill_bytes(bufinfo.buf, bufinfo.len);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(random_fill_obj, random_fill);
+
 STATIC const mp_rom_map_elem_t mp_module_random_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_random) },
     { MP_ROM_QSTR(MP_QSTR_seed), MP_ROM_PTR(&random_seed_obj) },
@@ -179,6 +215,8 @@ STATIC const mp_rom_map_elem_t mp_module_random_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_choice), MP_ROM_PTR(&random_choice_obj) },
     { MP_ROM_QSTR(MP_QSTR_random), MP_ROM_PTR(&random_random_obj) },
     { MP_ROM_QSTR(MP_QSTR_uniform), MP_ROM_PTR(&random_uniform_obj) },
+    { MP_ROM_QSTR(MP_QSTR_randbytes), MP_ROM_PTR(&random_randbytes_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&random_fill_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_random_globals, mp_module_random_globals_table);
@@ -34,6 +34,11 @@
 void shared_modules_random_seed(mp_uint_t seed);
 mp_uint_t shared_modules_random_getrandbits(uint8_t n);
 mp_int_t shared_modules_random_randrange(mp_int_t start, mp_int_t stop, mp_int_t step);
+// Fills the buffer with random bits.
+void shared_modules_random_fill_bytes(uint8_t* buffer, size_t len);
+// Fills the buffer with floats in the range [0, 1).
+void shared_modules_random_fill_floats(float* buffer, size_t len);
+void shared_modules_random_fill_doubles(double* buffer, size_t len);
 mp_float_t shared_modules_random_random(void);
 mp_float_t shared_modules_random_uniform(mp_float_t a, mp_float_t b);
 
@@ -148,12 +148,33 @@ const mp_obj_property_t rotaryio_incrementalencoder_position_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: velocity
+//|
+//|     The average change in `position` per second, as a `float`, since `velocity` was last read
+//|     or the encoder was created. (read-only)
+//|
+STATIC mp_obj_t rotaryio_incrementalencoder_obj_get_velocity(mp_obj_t self_in) {
+    rotaryio_incrementalencoder_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    raise_error_if_deinited(common_hal_rotaryio_incrementalencoder_deinited(self));
+
+    return mp_obj_new_float(common_hal_rotaryio_incrementalencoder_get_velocity(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rotaryio_incrementalencoder_get_velocity_obj, rotaryio_incrementalencoder_obj_get_velocity);
+
+const mp_obj_property_t rotaryio_incrementalencoder_velocity_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&rotaryio_incrementalencoder_get_velocity_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t rotaryio_incrementalencoder_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&rotaryio_incrementalencoder_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&rotaryio_incrementalencoder___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_position), MP_ROM_PTR(&rotaryio_incrementalencoder_position_obj) },
+    { MP_ROM_QSTR(MP_QSTR_velocity), MP_ROM_PTR(&rotaryio_incrementalencoder_velocity_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(rotaryio_incrementalencoder_locals_dict, rotaryio_incrementalencoder_locals_dict_table);
 
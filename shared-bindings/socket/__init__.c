@@ -240,6 +240,51 @@ STATIC mp_obj_t socket_send(mp_obj_t self_in, mp_obj_t buf_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(socket_send_obj, socket_send);
 
+//| .. method:: sendfile(file)
+//|
+//|   Send the rest of a file, from its current position, to the connected
+//|   remote address.  The file is read a sector at a time straight into a
+//|   buffer that is handed to the network interface, so no Python objects
+//|   are made along the way.
+//|   Suits sockets of type SOCK_STREAM
+//|   Returns an int of the number of bytes sent.
+//|
+//|   :param file: a file opened in binary mode, or other readable stream
+//|
+
+STATIC mp_obj_t socket_sendfile(mp_obj_t self_in, mp_obj_t file_in) {
+    mod_network_socket_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->nic == MP_OBJ_NULL) {
+        // not connected
+        mp_raise_OSError(MP_EPIPE);
+    }
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(file_in, MP_STREAM_OP_READ);
+    byte buf[512];
+    mp_uint_t total = 0;
+    int _errno;
+    for (;;) {
+        mp_uint_t n = stream_p->read(file_in, buf, sizeof(buf), &_errno);
+        if (n == MP_STREAM_ERROR) {
+            mp_raise_OSError(_errno);
+        }
+        if (n == 0) {
+            break;
+        }
+        // the NIC may take less than it's given when its transmit buffer is
+        // nearly full
+        for (mp_uint_t sent = 0; sent < n;) {
+            mp_int_t ret = self->nic_type->send(self, buf + sent, n - sent, &_errno);
+            if (ret == -1) {
+                mp_raise_OSError(_errno);
+            }
+            sent += ret;
+        }
+        total += n;
+    }
+    return mp_obj_new_int_from_uint(total);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(socket_sendfile_obj, socket_sendfile);
+
 
 // helper function for socket_recv and socket_recv_into to handle common operations of both
 STATIC mp_int_t _socket_recv_into(mod_network_socket_obj_t *sock, byte *buf, mp_int_t len) {
@@ -248,7 +293,7 @@ STATIC mp_int_t _socket_recv_into(mod_network_socket_obj_t *sock, byte *buf, mp_
     if (ret == -1) {
         mp_raise_OSError(_errno);
     }
-    return len;
+    return ret;
 }
 
 
@@ -475,6 +520,7 @@ STATIC const mp_rom_map_elem_t socket_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_accept), MP_ROM_PTR(&socket_accept_obj) },
     { MP_ROM_QSTR(MP_QSTR_connect), MP_ROM_PTR(&socket_connect_obj) },
     { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&socket_send_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sendfile), MP_ROM_PTR(&socket_sendfile_obj) },
     { MP_ROM_QSTR(MP_QSTR_recv), MP_ROM_PTR(&socket_recv_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendto), MP_ROM_PTR(&socket_sendto_obj) },
     { MP_ROM_QSTR(MP_QSTR_recvfrom), MP_ROM_PTR(&socket_recvfrom_obj) },
@@ -495,6 +541,11 @@ mp_uint_t socket_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_t arg, int *
         }
         return 0;
     }
+    if (self->nic == MP_OBJ_NULL) {
+        // not connected
+        *errcode = MP_ENOTCONN;
+        return MP_STREAM_ERROR;
+    }
     return self->nic_type->ioctl(self, request, arg, errcode);
 }
 
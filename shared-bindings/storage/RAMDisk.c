@@ -0,0 +1,140 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/storage/RAMDisk.h"
+
+#include <stdint.h>
+
+#include "extmod/vfs.h"
+#include "py/runtime.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: storage
+//|
+//| :class:`RAMDisk` -- Block device stored in RAM
+//| ==============================================
+//|
+//| A block device backed by memory from the heap. Format it with `VfsFat.mkfs` and mount it with
+//| `storage.mount` to get a scratch filesystem that reads and writes at memory speed without
+//| wearing the flash. It is not shared over USB and writing to it never triggers an auto-reload.
+//| The contents are lost when the disk is freed or the board resets.
+//|
+//| Usage::
+//|
+//|     import storage
+//|     disk = storage.RAMDisk(64 * 1024)
+//|     storage.VfsFat.mkfs(disk)
+//|     storage.mount(storage.VfsFat(disk), "/tmp")
+//|
+//| .. class:: RAMDisk(size)
+//|
+//|   Allocate a RAM backed block device.
+//|
+//|   :param int size: The size of the disk in bytes. It is rounded up to a whole number of 512
+//|     byte blocks. FAT needs at least 50 blocks.
+//|
+STATIC mp_obj_t storage_ramdisk_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_size, MP_ARG_REQUIRED | MP_ARG_INT },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t size = args[ARG_size].u_int;
+    if (size <= 0) {
+        mp_raise_ValueError(translate("size must be greater than 0"));
+    }
+
+    storage_ramdisk_obj_t *self = m_new_obj(storage_ramdisk_obj_t);
+    self->base.type = &storage_ramdisk_type;
+    common_hal_storage_ramdisk_construct(self,
+        (size + STORAGE_RAMDISK_BLOCK_SIZE - 1) / STORAGE_RAMDISK_BLOCK_SIZE);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|   .. method:: readblocks(block_num, buf)
+//|
+//|     Read ``len(buf)`` bytes starting at block ``block_num``. ``len(buf)`` must be a multiple
+//|     of 512. Returns 0 on success.
+//|
+STATIC mp_obj_t storage_ramdisk_readblocks(mp_obj_t self_in, mp_obj_t block_num, mp_obj_t buf) {
+    storage_ramdisk_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_WRITE);
+    mp_uint_t result = common_hal_storage_ramdisk_readblocks(self, bufinfo.buf,
+        mp_obj_get_int(block_num), bufinfo.len / STORAGE_RAMDISK_BLOCK_SIZE);
+    return MP_OBJ_NEW_SMALL_INT(result);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(storage_ramdisk_readblocks_obj, storage_ramdisk_readblocks);
+
+//|   .. method:: writeblocks(block_num, buf)
+//|
+//|     Write ``buf`` starting at block ``block_num``. ``len(buf)`` must be a multiple of 512.
+//|     Returns 0 on success.
+//|
+STATIC mp_obj_t storage_ramdisk_writeblocks(mp_obj_t self_in, mp_obj_t block_num, mp_obj_t buf) {
+    storage_ramdisk_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_READ);
+    mp_uint_t result = common_hal_storage_ramdisk_writeblocks(self, bufinfo.buf,
+        mp_obj_get_int(block_num), bufinfo.len / STORAGE_RAMDISK_BLOCK_SIZE);
+    return MP_OBJ_NEW_SMALL_INT(result);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(storage_ramdisk_writeblocks_obj, storage_ramdisk_writeblocks);
+
+//|   .. method:: ioctl(op, arg)
+//|
+//|     Block device control used by `VfsFat`. Reports the block count and block size.
+//|
+STATIC mp_obj_t storage_ramdisk_ioctl(mp_obj_t self_in, mp_obj_t cmd_in, mp_obj_t arg_in) {
+    storage_ramdisk_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (mp_obj_get_int(cmd_in)) {
+        case BP_IOCTL_SEC_COUNT:
+            return MP_OBJ_NEW_SMALL_INT(common_hal_storage_ramdisk_get_block_count(self));
+        case BP_IOCTL_SEC_SIZE:
+            return MP_OBJ_NEW_SMALL_INT(STORAGE_RAMDISK_BLOCK_SIZE);
+        default:
+            // Nothing to initialize or flush.
+            return MP_OBJ_NEW_SMALL_INT(0);
+    }
+}
+MP_DEFINE_CONST_FUN_OBJ_3(storage_ramdisk_ioctl_obj, storage_ramdisk_ioctl);
+
+STATIC const mp_rom_map_elem_t storage_ramdisk_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&storage_ramdisk_readblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeblocks), MP_ROM_PTR(&storage_ramdisk_writeblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ioctl), MP_ROM_PTR(&storage_ramdisk_ioctl_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(storage_ramdisk_locals_dict, storage_ramdisk_locals_dict_table);
+
+const mp_obj_type_t storage_ramdisk_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_RAMDisk,
+    .make_new = storage_ramdisk_make_new,
+    .locals_dict = (mp_obj_dict_t*)&storage_ramdisk_locals_dict,
+};
@@ -0,0 +1,39 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_BINDINGS_STORAGE_RAMDISK_H
+#define MICROPY_INCLUDED_SHARED_BINDINGS_STORAGE_RAMDISK_H
+
+#include "shared-module/storage/RAMDisk.h"
+
+extern const mp_obj_type_t storage_ramdisk_type;
+
+void common_hal_storage_ramdisk_construct(storage_ramdisk_obj_t* self, uint32_t block_count);
+uint32_t common_hal_storage_ramdisk_get_block_count(storage_ramdisk_obj_t* self);
+mp_uint_t common_hal_storage_ramdisk_readblocks(storage_ramdisk_obj_t* self, uint8_t* dest, uint32_t block_num, uint32_t num_blocks);
+mp_uint_t common_hal_storage_ramdisk_writeblocks(storage_ramdisk_obj_t* self, const uint8_t* src, uint32_t block_num, uint32_t num_blocks);
+
+#endif // MICROPY_INCLUDED_SHARED_BINDINGS_STORAGE_RAMDISK_H
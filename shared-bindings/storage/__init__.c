@@ -33,6 +33,7 @@
 #include "py/objnamedtuple.h"
 #include "py/runtime.h"
 #include "shared-bindings/storage/__init__.h"
+#include "shared-bindings/storage/RAMDisk.h"
 #include "supervisor/shared/translate.h"
 
 //| :mod:`storage` --- storage management
@@ -47,6 +48,13 @@
 //| CircuitPython does not have an OS, so this module provides this functionality
 //| directly.
 //|
+//| Libraries
+//|
+//| .. toctree::
+//|     :maxdepth: 3
+//|
+//|     RAMDisk
+//|
 
 //| .. function:: mount(filesystem, mount_path, \*, readonly=False)
 //|
@@ -171,6 +179,8 @@ STATIC const mp_rom_map_elem_t storage_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_getmount), MP_ROM_PTR(&storage_getmount_obj) },
     { MP_ROM_QSTR(MP_QSTR_erase_filesystem), MP_ROM_PTR(&storage_erase_filesystem_obj) },
 
+    { MP_ROM_QSTR(MP_QSTR_RAMDisk), MP_ROM_PTR(&storage_ramdisk_type) },
+
     //| .. class:: VfsFat(block_device)
     //|
     //|   Create a new VfsFat filesystem around the given block device.
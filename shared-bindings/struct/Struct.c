@@ -0,0 +1,226 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/struct/Struct.h"
+#include "supervisor/shared/translate.h"
+
+//| .. currentmodule:: struct
+//|
+//| :class:`Struct` -- A precompiled format
+//| =======================================
+//|
+//| A Struct parses its format once, so packing and unpacking the same layout over and over
+//| doesn't parse the format string each time. This suits drivers that decode the same
+//| register block many times a second.
+//|
+//| .. class:: Struct(format)
+//|
+//|   Create a Struct for the given format string. It takes the same formats as the
+//|   module-level functions.
+//|
+//|   :param str format: The format, such as ``"<hhh"``.
+//|
+STATIC mp_obj_t struct_struct_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_format };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_format, MP_ARG_REQUIRED | MP_ARG_OBJ },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t format = args[ARG_format].u_obj;
+    size_t max_ops = shared_modules_struct_struct_max_ops(format);
+    struct_struct_obj_t *self = m_new_obj_var(struct_struct_obj_t, struct_struct_op_t, max_ops);
+    self->base.type = &struct_struct_type;
+    shared_modules_struct_struct_construct(self, format);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// Sets *p and *end_p to the part of buffer that starts at offset. Negative offsets count
+// from the end of the buffer.
+STATIC void struct_struct_get_buffer(mp_obj_t buffer, mp_int_t offset, mp_uint_t flags, byte **p, byte **end_p) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, flags);
+    if (offset < 0) {
+        offset = (mp_int_t)bufinfo.len + offset;
+    }
+    if (offset < 0 || (mp_uint_t)offset > bufinfo.len) {
+        mp_raise_RuntimeError(translate("buffer too small"));
+    }
+    *p = (byte *)bufinfo.buf + offset;
+    *end_p = (byte *)bufinfo.buf + bufinfo.len;
+}
+
+//|   .. method:: pack(v1, v2, ...)
+//|
+//|     Pack the values according to the format. Returns a new bytes object.
+//|
+STATIC mp_obj_t struct_struct_pack(size_t n_args, const mp_obj_t *args) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    vstr_t vstr;
+    vstr_init_len(&vstr, self->size);
+    byte *p = (byte *)vstr.buf;
+    memset(p, 0, self->size);
+    shared_modules_struct_struct_pack_into(self, p, p + self->size, n_args - 1, &args[1]);
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_struct_pack_obj, 1, MP_OBJ_FUN_ARGS_MAX, struct_struct_pack);
+
+//|   .. method:: pack_into(buffer, offset, v1, v2, ...)
+//|
+//|     Pack the values according to the format into ``buffer`` starting at ``offset``.
+//|     ``offset`` may be negative to count from the end of the buffer.
+//|
+STATIC mp_obj_t struct_struct_pack_into(size_t n_args, const mp_obj_t *args) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    byte *p;
+    byte *end_p;
+    struct_struct_get_buffer(args[1], mp_obj_get_int(args[2]), MP_BUFFER_WRITE, &p, &end_p);
+    shared_modules_struct_struct_pack_into(self, p, end_p, n_args - 3, &args[3]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_struct_pack_into_obj, 3, MP_OBJ_FUN_ARGS_MAX, struct_struct_pack_into);
+
+//|   .. method:: unpack(data)
+//|
+//|     Unpack ``data``, which must be exactly `size` bytes long. Returns a tuple of the values.
+//|
+STATIC mp_obj_t struct_struct_unpack(mp_obj_t self_in, mp_obj_t data) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    byte *p;
+    byte *end_p;
+    struct_struct_get_buffer(data, 0, MP_BUFFER_READ, &p, &end_p);
+    return MP_OBJ_FROM_PTR(shared_modules_struct_struct_unpack_from(self, p, end_p, true));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(struct_struct_unpack_obj, struct_struct_unpack);
+
+//|   .. method:: unpack_from(data, offset=0)
+//|
+//|     Unpack from ``data`` starting at ``offset``, which may be negative to count from the
+//|     end. ``data`` only needs to be big enough. Returns a tuple of the values.
+//|
+STATIC mp_obj_t struct_struct_unpack_from(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_offset };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_offset, MP_ARG_INT, {.u_int = 0} },
+    };
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    byte *p;
+    byte *end_p;
+    struct_struct_get_buffer(args[ARG_buffer].u_obj, args[ARG_offset].u_int, MP_BUFFER_READ, &p, &end_p);
+    return MP_OBJ_FROM_PTR(shared_modules_struct_struct_unpack_from(self, p, end_p, false));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(struct_struct_unpack_from_obj, 1, struct_struct_unpack_from);
+
+//|   .. method:: unpack_into(out, data, offset=0)
+//|
+//|     Unpack from ``data`` starting at ``offset`` into the existing list or array ``out``,
+//|     instead of allocating a tuple. ``out`` must have room for at least as many values as
+//|     the format produces; any extra entries are left alone. Integer values that fit in a
+//|     small int are stored without allocating, but ``s`` fields still create bytes objects.
+//|
+STATIC mp_obj_t struct_struct_unpack_into(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_out, ARG_buffer, ARG_offset };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_out, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_offset, MP_ARG_INT, {.u_int = 0} },
+    };
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    byte *p;
+    byte *end_p;
+    struct_struct_get_buffer(args[ARG_buffer].u_obj, args[ARG_offset].u_int, MP_BUFFER_READ, &p, &end_p);
+    shared_modules_struct_struct_unpack_into(self, args[ARG_out].u_obj, p, end_p);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(struct_struct_unpack_into_obj, 1, struct_struct_unpack_into);
+
+//|   .. attribute:: format
+//|
+//|     The format string this Struct was created with. (read-only)
+//|
+STATIC mp_obj_t struct_struct_obj_get_format(mp_obj_t self_in) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return self->format;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(struct_struct_get_format_obj, struct_struct_obj_get_format);
+
+const mp_obj_property_t struct_struct_format_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&struct_struct_get_format_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: size
+//|
+//|     The number of bytes the format packs into, as returned by `calcsize`. (read-only)
+//|
+STATIC mp_obj_t struct_struct_obj_get_size(mp_obj_t self_in) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(self->size);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(struct_struct_get_size_obj, struct_struct_obj_get_size);
+
+const mp_obj_property_t struct_struct_size_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&struct_struct_get_size_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+STATIC const mp_rom_map_elem_t struct_struct_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&struct_struct_pack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pack_into), MP_ROM_PTR(&struct_struct_pack_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&struct_struct_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_from), MP_ROM_PTR(&struct_struct_unpack_from_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_into), MP_ROM_PTR(&struct_struct_unpack_into_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_format), MP_ROM_PTR(&struct_struct_format_obj) },
+    { MP_ROM_QSTR(MP_QSTR_size), MP_ROM_PTR(&struct_struct_size_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(struct_struct_locals_dict, struct_struct_locals_dict_table);
+
+const mp_obj_type_t struct_struct_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Struct,
+    .make_new = struct_struct_make_new,
+    .locals_dict = (mp_obj_dict_t*)&struct_struct_locals_dict,
+};
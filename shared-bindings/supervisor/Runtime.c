@@ -102,9 +102,36 @@ const mp_obj_property_t supervisor_serial_bytes_available_obj = {
 };
 
 
+//|     .. attribute:: runtime.usb_msc_throughput
+//|
+//|         Returns a tuple of the bytes per second achieved by the last burst
+//|         of reads and of writes to CIRCUITPY over USB. Each is 0 until there
+//|         has been one. (read-only)
+//|
+STATIC mp_obj_t supervisor_get_usb_msc_throughput(mp_obj_t self){
+    uint32_t read_rate;
+    uint32_t write_rate;
+    common_hal_get_usb_msc_throughput(&read_rate, &write_rate);
+    mp_obj_t rates[2] = {
+        mp_obj_new_int_from_uint(read_rate),
+        mp_obj_new_int_from_uint(write_rate),
+    };
+    return mp_obj_new_tuple(2, rates);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_get_usb_msc_throughput_obj, supervisor_get_usb_msc_throughput);
+
+const mp_obj_property_t supervisor_usb_msc_throughput_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&supervisor_get_usb_msc_throughput_obj,
+              (mp_obj_t)&mp_const_none_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+
 STATIC const mp_rom_map_elem_t supervisor_runtime_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_serial_connected), MP_ROM_PTR(&supervisor_serial_connected_obj) },
     { MP_ROM_QSTR(MP_QSTR_serial_bytes_available), MP_ROM_PTR(&supervisor_serial_bytes_available_obj) },
+    { MP_ROM_QSTR(MP_QSTR_usb_msc_throughput), MP_ROM_PTR(&supervisor_usb_msc_throughput_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(supervisor_runtime_locals_dict, supervisor_runtime_locals_dict_table);
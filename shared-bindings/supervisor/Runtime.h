@@ -37,6 +37,8 @@ bool common_hal_get_serial_connected(void);
 
 bool common_hal_get_serial_bytes_available(void);
 
+void common_hal_get_usb_msc_throughput(uint32_t* read_rate, uint32_t* write_rate);
+
 //TODO: placeholders for future functions
 //bool common_hal_get_repl_active(void);
 //bool common_hal_get_usb_enumerated(void);
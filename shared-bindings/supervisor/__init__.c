@@ -23,6 +23,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <string.h>
+
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "py/reload.h"
@@ -33,6 +35,10 @@
 #include "supervisor/shared/stack.h"
 #include "supervisor/shared/translate.h"
 
+#if CIRCUITPY_STARTUP_PROFILE
+#include "supervisor/shared/profile.h"
+#endif
+
 #include "shared-bindings/supervisor/__init__.h"
 #include "shared-bindings/supervisor/Runtime.h"
 
@@ -124,6 +130,55 @@ STATIC mp_obj_t supervisor_set_next_stack_limit(mp_obj_t size_obj) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(supervisor_set_next_stack_limit_obj, supervisor_set_next_stack_limit);
 
+//| .. method:: set_next_pystack_limit(size)
+//|
+//|   Set the size of the Python stack, which holds the frames of running
+//|   functions, for the next vm run. If its too large, the default will be used.
+//|
+STATIC mp_obj_t supervisor_set_next_pystack_limit(mp_obj_t size_obj) {
+    mp_int_t size = mp_obj_get_int(size_obj);
+
+    if (size < 256) {
+        mp_raise_ValueError(translate("Stack size must be at least 256"));
+    }
+    set_next_pystack_size(size);
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_set_next_pystack_limit_obj, supervisor_set_next_pystack_limit);
+
+#if CIRCUITPY_STARTUP_PROFILE
+//| .. method:: startup_profile()
+//|
+//|   Return how long each stage of starting up took since the last time code.py finished, as a
+//|   list of ``(stage, module, microseconds)`` tuples in the order they finished. ``module`` is
+//|   ``None`` for the supervisor's own phases such as ``"filesystem_init"`` and ``"boot.py"``.
+//|   Each import adds an ``"import"`` entry, which includes the modules it imports in turn,
+//|   preceded by a ``"compile"``, ``"cache_load"`` or ``"load"`` entry when the module came from
+//|   a ``.py`` or ``.mpy`` file. The same list is printed on the serial console after code.py
+//|   finishes. Only available when CircuitPython is built with ``CIRCUITPY_STARTUP_PROFILE=1``.
+//|
+STATIC mp_obj_t supervisor_startup_profile(void) {
+    size_t count;
+    const supervisor_profile_entry_t* entries = supervisor_profile_entries(&count);
+    mp_obj_t profile = mp_obj_new_list(0, NULL);
+    for (size_t i = 0; i < count; i++) {
+        const supervisor_profile_entry_t* entry = &entries[i];
+        mp_obj_t items[3] = {
+            mp_obj_new_str(entry->stage, strlen(entry->stage)),
+            mp_const_none,
+            mp_obj_new_int_from_uint(entry->duration_us),
+        };
+        if (entry->name[0] != '\0') {
+            items[1] = mp_obj_new_str(entry->name, strlen(entry->name));
+        }
+        mp_obj_list_append(profile, mp_obj_new_tuple(3, items));
+    }
+    return profile;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_startup_profile_obj, supervisor_startup_profile);
+#endif
+
 STATIC const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_supervisor) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_enable_autoreload),  MP_ROM_PTR(&supervisor_enable_autoreload_obj) },
@@ -132,6 +187,10 @@ STATIC const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_runtime),  MP_ROM_PTR(&common_hal_supervisor_runtime_obj) },
     { MP_ROM_QSTR(MP_QSTR_reload),  MP_ROM_PTR(&supervisor_reload_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_next_stack_limit),  MP_ROM_PTR(&supervisor_set_next_stack_limit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_next_pystack_limit),  MP_ROM_PTR(&supervisor_set_next_pystack_limit_obj) },
+    #if CIRCUITPY_STARTUP_PROFILE
+    { MP_ROM_QSTR(MP_QSTR_startup_profile),  MP_ROM_PTR(&supervisor_startup_profile_obj) },
+    #endif
 
 };
 
@@ -30,6 +30,7 @@
 
 #include "py/obj.h"
 #include "py/objnamedtuple.h"
+#include "py/smallint.h"
 #include "py/runtime.h"
 #include "lib/timeutils/timeutils.h"
 #include "shared-bindings/rtc/__init__.h"
@@ -82,6 +83,46 @@ STATIC mp_obj_t time_sleep(mp_obj_t seconds_o) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(time_sleep_obj, time_sleep);
 
+#if MICROPY_PY_UTIMEQ
+//| .. method:: ticks_ms()
+//|
+//|   Returns a millisecond counter that wraps around. These are the times `utimeq` orders its
+//|   entries by. Only compare them with `ticks_diff`.
+//|
+//|   :rtype: int
+//|
+STATIC mp_obj_t time_ticks_ms(void) {
+    return MP_OBJ_NEW_SMALL_INT(common_hal_time_monotonic() & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
+}
+MP_DEFINE_CONST_FUN_OBJ_0(time_ticks_ms_obj, time_ticks_ms);
+
+//| .. method:: ticks_add(ticks, delta)
+//|
+//|   Returns the `ticks_ms` value ``delta`` milliseconds after ``ticks``, wrapping as needed.
+//|
+STATIC mp_obj_t time_ticks_add(mp_obj_t ticks_in, mp_obj_t delta_in) {
+    mp_uint_t ticks = mp_obj_get_int(ticks_in);
+    mp_uint_t delta = mp_obj_get_int(delta_in);
+    return MP_OBJ_NEW_SMALL_INT((ticks + delta) & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(time_ticks_add_obj, time_ticks_add);
+
+//| .. method:: ticks_diff(end, start)
+//|
+//|   Returns the signed number of milliseconds from ``start`` to ``end``, allowing for one wrap
+//|   of the counter.
+//|
+STATIC mp_obj_t time_ticks_diff(mp_obj_t end_in, mp_obj_t start_in) {
+    mp_uint_t start = mp_obj_get_int(start_in);
+    mp_uint_t end = mp_obj_get_int(end_in);
+    // Shift the difference forward by half a period, wrap it and shift it back.
+    mp_int_t diff = ((end - start + MICROPY_PY_UTIME_TICKS_PERIOD / 2) & (MICROPY_PY_UTIME_TICKS_PERIOD - 1))
+                   - MICROPY_PY_UTIME_TICKS_PERIOD / 2;
+    return MP_OBJ_NEW_SMALL_INT(diff);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(time_ticks_diff_obj, time_ticks_diff);
+#endif // MICROPY_PY_UTIMEQ
+
 #if MICROPY_PY_COLLECTIONS
 mp_obj_t struct_time_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     if (n_args != 1 || (kw_args != NULL && kw_args->used > 0)) {
@@ -208,13 +249,14 @@ MP_DEFINE_CONST_FUN_OBJ_0(time_time_obj, time_time);
 
 //| .. method:: monotonic_ns()
 //|
-//|   Return the time of the specified clock clk_id in nanoseconds.
+//|   Return the time of the monotonic clock in nanoseconds. Resolution is one microsecond on
+//|   SAMD and nRF, and unlike `monotonic` it never rounds to a float.
 //|
 //|   :return: the current time
 //|   :rtype: int
 //|
 STATIC mp_obj_t time_monotonic_ns(void) {
-    uint64_t time64 = common_hal_time_monotonic() * 1000000llu;
+    uint64_t time64 = common_hal_time_monotonic_ns();
     return mp_obj_new_int_from_ll((long long) time64);
 }
 MP_DEFINE_CONST_FUN_OBJ_0(time_monotonic_ns_obj, time_monotonic_ns);
@@ -284,6 +326,11 @@ STATIC const mp_rom_map_elem_t time_module_globals_table[] = {
 
     { MP_ROM_QSTR(MP_QSTR_monotonic), MP_ROM_PTR(&time_monotonic_obj) },
     { MP_ROM_QSTR(MP_QSTR_sleep), MP_ROM_PTR(&time_sleep_obj) },
+    #if MICROPY_PY_UTIMEQ
+    { MP_ROM_QSTR(MP_QSTR_ticks_ms), MP_ROM_PTR(&time_ticks_ms_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ticks_add), MP_ROM_PTR(&time_ticks_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ticks_diff), MP_ROM_PTR(&time_ticks_diff_obj) },
+    #endif
     #if MICROPY_PY_COLLECTIONS
     { MP_ROM_QSTR(MP_QSTR_struct_time), MP_ROM_PTR(&struct_time_type_obj) },
     #if MICROPY_LONGINT_IMPL != MICROPY_LONGINT_IMPL_NONE
@@ -36,6 +36,8 @@ extern mp_obj_t struct_time_from_tm(timeutils_struct_time_t *tm);
 extern void struct_time_to_tm(mp_obj_t t, timeutils_struct_time_t *tm);
 
 extern uint64_t common_hal_time_monotonic(void);
+// Monotonic time in nanoseconds, at whatever finer resolution the port's clock has.
+extern uint64_t common_hal_time_monotonic_ns(void);
 extern void common_hal_time_delay_ms(uint32_t);
 
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_TIME___INIT___H
@@ -131,6 +131,9 @@ const mp_obj_property_t touchio_touchin_value_obj = {
 //|
 //|     The raw touch measurement as an `int`. (read-only)
 //|
+//|     On ports that scan the pads in the background, this is the latest filtered
+//|     measurement and reading it doesn't wait for a new one.
+//|
 STATIC mp_obj_t touchio_touchin_obj_get_raw_value(mp_obj_t self_in) {
     touchio_touchin_obj_t *self = MP_OBJ_TO_PTR(self_in);
     raise_error_if_deinited(common_hal_touchio_touchin_deinited(self));
@@ -156,6 +159,9 @@ const mp_obj_property_t touchio_touchin_raw_value_obj = {
 //|
 //|     You can adjust `threshold` to make the pin more or less sensitive.
 //|
+//|     On ports that scan the pads in the background, `threshold` also follows slow
+//|     changes in the untouched `raw_value`, keeping the same distance above it.
+//|
 STATIC mp_obj_t touchio_touchin_obj_get_threshold(mp_obj_t self_in) {
     touchio_touchin_obj_t *self = MP_OBJ_TO_PTR(self_in);
     raise_error_if_deinited(common_hal_touchio_touchin_deinited(self));
@@ -25,6 +25,7 @@
  */
 
 #include "py/objproperty.h"
+#include "py/runtime.h"
 #include "shared-bindings/usb_hid/Device.h"
 
 //| .. currentmodule:: usb_hid
@@ -47,7 +48,9 @@
 //|
 //|   .. method:: send_report(buf)
 //|
-//|     Send a HID report.
+//|     Send a HID report. If the host hasn't collected earlier reports yet, the report is queued
+//|     and this returns straight away. A mouse report with the same buttons as the last queued one
+//|     is merged into it by adding up the movement.
 //|
 STATIC mp_obj_t usb_hid_device_send_report(mp_obj_t self_in, mp_obj_t buffer) {
     usb_hid_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
@@ -98,10 +101,69 @@ const mp_obj_property_t usb_hid_device_usage_obj = {
               (mp_obj_t)&mp_const_none_obj},
 };
 
+//|   .. attribute:: queue_length
+//|
+//|     The number of reports that can wait for the host, from 1 to 8. Defaults to 4.
+//|
+STATIC mp_obj_t usb_hid_device_obj_get_queue_length(mp_obj_t self_in) {
+    usb_hid_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_hid_device_get_queue_length(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_hid_device_get_queue_length_obj, usb_hid_device_obj_get_queue_length);
+
+STATIC mp_obj_t usb_hid_device_obj_set_queue_length(mp_obj_t self_in, mp_obj_t queue_length_in) {
+    usb_hid_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    const mp_int_t queue_length = mp_obj_get_int(queue_length_in);
+    if (queue_length < 1) {
+        mp_raise_ValueError_varg(translate("%q must be >= 1"), MP_QSTR_queue_length);
+    }
+    if (queue_length > USB_HID_REPORT_QUEUE_MAX) {
+        mp_raise_ValueError_varg(translate("%q must be <= %d"), MP_QSTR_queue_length, USB_HID_REPORT_QUEUE_MAX);
+    }
+    common_hal_usb_hid_device_set_queue_length(self, queue_length);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(usb_hid_device_set_queue_length_obj, usb_hid_device_obj_set_queue_length);
+
+const mp_obj_property_t usb_hid_device_queue_length_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_hid_device_get_queue_length_obj,
+              (mp_obj_t)&usb_hid_device_set_queue_length_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
+//|   .. attribute:: drop_oldest
+//|
+//|     What `send_report` does when the queue is full. When `True`, the oldest queued report is
+//|     discarded to make room. When `False`, the default, it waits up to two seconds for the host
+//|     and then raises `OSError`.
+//|
+STATIC mp_obj_t usb_hid_device_obj_get_drop_oldest(mp_obj_t self_in) {
+    usb_hid_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_usb_hid_device_get_drop_oldest(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_hid_device_get_drop_oldest_obj, usb_hid_device_obj_get_drop_oldest);
+
+STATIC mp_obj_t usb_hid_device_obj_set_drop_oldest(mp_obj_t self_in, mp_obj_t drop_oldest) {
+    usb_hid_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_usb_hid_device_set_drop_oldest(self, mp_obj_is_true(drop_oldest));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(usb_hid_device_set_drop_oldest_obj, usb_hid_device_obj_set_drop_oldest);
+
+const mp_obj_property_t usb_hid_device_drop_oldest_obj = {
+    .base.type = &mp_type_property,
+    .proxy = {(mp_obj_t)&usb_hid_device_get_drop_oldest_obj,
+              (mp_obj_t)&usb_hid_device_set_drop_oldest_obj,
+              (mp_obj_t)&mp_const_none_obj},
+};
+
 STATIC const mp_rom_map_elem_t usb_hid_device_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_send_report),    MP_ROM_PTR(&usb_hid_device_send_report_obj) },
     { MP_ROM_QSTR(MP_QSTR_usage_page),     MP_ROM_PTR(&usb_hid_device_usage_page_obj)},
     { MP_ROM_QSTR(MP_QSTR_usage),          MP_ROM_PTR(&usb_hid_device_usage_obj)},
+    { MP_ROM_QSTR(MP_QSTR_queue_length),   MP_ROM_PTR(&usb_hid_device_queue_length_obj)},
+    { MP_ROM_QSTR(MP_QSTR_drop_oldest),    MP_ROM_PTR(&usb_hid_device_drop_oldest_obj)},
 };
 
 STATIC MP_DEFINE_CONST_DICT(usb_hid_device_locals_dict, usb_hid_device_locals_dict_table);
@@ -34,5 +34,9 @@ const mp_obj_type_t usb_hid_device_type;
 void common_hal_usb_hid_device_send_report(usb_hid_device_obj_t *self, uint8_t* report, uint8_t len);
 uint8_t common_hal_usb_hid_device_get_usage_page(usb_hid_device_obj_t *self);
 uint8_t common_hal_usb_hid_device_get_usage(usb_hid_device_obj_t *self);
+uint8_t common_hal_usb_hid_device_get_queue_length(usb_hid_device_obj_t *self);
+void common_hal_usb_hid_device_set_queue_length(usb_hid_device_obj_t *self, uint8_t queue_length);
+bool common_hal_usb_hid_device_get_drop_oldest(usb_hid_device_obj_t *self);
+void common_hal_usb_hid_device_set_drop_oldest(usb_hid_device_obj_t *self, bool drop_oldest);
 
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_USB_HID_DEVICE_H
@@ -99,10 +99,36 @@ STATIC mp_uint_t usb_midi_portin_ioctl(mp_obj_t self_in, mp_uint_t request, mp_u
     return ret;
 }
 
+//|   .. method:: read_messages(buf)
+//|
+//|     Read whole MIDI messages as USB-MIDI event packets into ``buf``. Each packet takes four
+//|     bytes: the cable number and code index, then up to three MIDI bytes padded with zeros.
+//|     Running status is expanded and system exclusive messages are split into packets of three
+//|     bytes, so every packet stands on its own. An ``array.array('L')`` holds one packet per
+//|     item.
+//|
+//|     Messages are put back together from the same data that `read` returns so don't mix the
+//|     two.
+//|
+//|     :return: number of packets stored into ``buf``
+//|     :rtype: int
+//|
+STATIC mp_obj_t usb_midi_portin_read_messages(mp_obj_t self_in, mp_obj_t buf_in) {
+    usb_midi_portin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_midi_portin_read_messages(self, bufinfo.buf,
+        bufinfo.len / USB_MIDI_PACKET_SIZE));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(usb_midi_portin_read_messages_obj, usb_midi_portin_read_messages);
+
 STATIC const mp_rom_map_elem_t usb_midi_portin_locals_dict_table[] = {
     // Standard stream methods.
     { MP_OBJ_NEW_QSTR(MP_QSTR_read),     MP_ROM_PTR(&mp_stream_read_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+
+    { MP_OBJ_NEW_QSTR(MP_QSTR_read_messages), MP_ROM_PTR(&usb_midi_portin_read_messages_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(usb_midi_portin_locals_dict, usb_midi_portin_locals_dict_table);
 
@@ -82,9 +82,30 @@ STATIC mp_uint_t usb_midi_portout_ioctl(mp_obj_t self_in, mp_uint_t request, mp_
     return ret;
 }
 
+//|   .. method:: write_messages(buf)
+//|
+//|     Write USB-MIDI event packets, four bytes each, as returned by `PortIn.read_messages`.
+//|     Packets are handed to USB in batches instead of one byte at a time. The cable number is
+//|     ignored.
+//|
+//|     :return: the number of whole packets written
+//|     :rtype: int
+//|
+STATIC mp_obj_t usb_midi_portout_write_messages(mp_obj_t self_in, mp_obj_t buf_in) {
+    usb_midi_portout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_midi_portout_write_messages(self, bufinfo.buf,
+        bufinfo.len / USB_MIDI_PACKET_SIZE));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(usb_midi_portout_write_messages_obj, usb_midi_portout_write_messages);
+
 STATIC const mp_rom_map_elem_t usb_midi_portout_locals_dict_table[] = {
     // Standard stream methods.
     { MP_OBJ_NEW_QSTR(MP_QSTR_write),    MP_ROM_PTR(&mp_stream_write_obj) },
+
+    { MP_OBJ_NEW_QSTR(MP_QSTR_write_messages), MP_ROM_PTR(&usb_midi_portout_write_messages_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(usb_midi_portout_locals_dict, usb_midi_portout_locals_dict_table);
 
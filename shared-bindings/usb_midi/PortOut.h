@@ -27,6 +27,7 @@
 #ifndef MICROPY_INCLUDED_SHARED_BINDINGS_USB_MIDI_PORTOUT_H
 #define MICROPY_INCLUDED_SHARED_BINDINGS_USB_MIDI_PORTOUT_H
 
+#include "shared-module/usb_midi/PortIn.h"
 #include "shared-module/usb_midi/PortOut.h"
 
 extern const mp_obj_type_t usb_midi_portout_type;
@@ -36,5 +37,8 @@ extern size_t common_hal_usb_midi_portout_write(usb_midi_portout_obj_t *self,
                               const uint8_t *data, size_t len, int *errcode);
 
 extern bool common_hal_usb_midi_portout_ready_to_tx(usb_midi_portout_obj_t *self);
+// Write whole USB-MIDI event packets. Returns the number of packets taken.
+extern size_t common_hal_usb_midi_portout_write_messages(usb_midi_portout_obj_t *self,
+                              const uint8_t *packets, size_t packet_count);
 
 #endif  // MICROPY_INCLUDED_SHARED_BINDINGS_USB_MIDI_PORTOUT_H
@@ -50,20 +50,22 @@
 //| :class:`WIZNET5K` -- wrapper for Wiznet 5500 Ethernet interface
 //| ===============================================================
 //|
-//| .. class:: WIZNET5K(spi, cs, rst)
+//| .. class:: WIZNET5K(spi, cs, rst, irq=None)
 //|
 //|   Create a new WIZNET5500 interface using the specified pins
 //|
 //|   :param spi: spi bus to use
 //|   :param cs: pin to use for Chip Select
 //|   :param rst: pin to sue for Reset
+//|   :param irq: optional pin connected to INTn, which lets polling skip
+//|     asking the chip whether anything has happened when nothing has
 //|
 
 STATIC mp_obj_t wiznet5k_make_new(const mp_obj_type_t *type, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     // check arguments
-    mp_arg_check_num(n_args, kw_args, 3, 3, false);
+    mp_arg_check_num(n_args, kw_args, 3, 4, false);
 
-    return wiznet5k_create(args[0], args[1], args[2]);
+    return wiznet5k_create(args[0], args[1], args[2], n_args > 3 ? args[3] : mp_const_none);
 }
 
 //| .. attribute:: connected
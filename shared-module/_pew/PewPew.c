@@ -25,6 +25,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 
 #include "py/mpstate.h"
 #include "py/runtime.h"
@@ -34,12 +35,18 @@
 #include "shared-bindings/digitalio/Pull.h"
 #include "shared-bindings/digitalio/DigitalInOut.h"
 #include "shared-bindings/util.h"
+#include "audio_dma.h"
+#include "hal/include/hal_gpio.h"
+#include "samd/dma.h"
 #include "samd/timers.h"
 #include "supervisor/shared/translate.h"
 #include "timer_handler.h"
 
+#define NO_DMA_CHANNEL 0xff
 
 static uint8_t pewpew_tc_index = 0xff;
+static uint8_t pewpew_row_dma_channel = NO_DMA_CHANNEL;
+static uint8_t pewpew_column_dma_channel = NO_DMA_CHANNEL;
 
 
 void pewpew_interrupt_handler(uint8_t index) {
@@ -57,9 +64,136 @@ void pewpew_interrupt_handler(uint8_t index) {
     tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
 }
 
+static const mcu_pin_obj_t* pin_of(mp_obj_t obj) {
+    digitalio_digitalinout_obj_t *pin = MP_OBJ_TO_PTR(obj);
+    return pin->pin;
+}
+
+static uint32_t pin_mask(mp_obj_t obj) {
+    return 1UL << GPIO_PIN(pin_of(obj)->number);
+}
+
+// Fills toggles with the rows to flip at each step of a refresh cycle, where a step lights one
+// column for one turn, and returns the rows lit in the last step. The first step flips from the
+// last one so the table can loop.
+static uint32_t build_row_toggles(pew_obj_t* pew, uint32_t* toggles) {
+    uint32_t previous = 0;
+    for (uint8_t turn = 0; turn < PEW_TURNS; ++turn) {
+        for (size_t col = 0; col < pew->cols_size; ++col) {
+            uint32_t rows = 0;
+            for (size_t x = 0; x < pew->rows_size; ++x) {
+                if (pew_lit(pew->buffer[col * pew->rows_size + x], turn)) {
+                    rows |= pin_mask(pew->rows[x]);
+                }
+            }
+            toggles[turn * pew->cols_size + col] = rows ^ previous;
+            previous = rows;
+        }
+    }
+    toggles[0] ^= previous;
+    return previous;
+}
+
+static void setup_toggle_descriptor(uint8_t channel, uint32_t* toggles, size_t count,
+                                    volatile uint32_t* destination) {
+    DmacDescriptor* descriptor = dma_descriptor(channel);
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = count;
+    // With SRCINC the source address is the end of the table.
+    descriptor->SRCADDR.reg = (uint32_t) (toggles + count);
+    descriptor->DSTADDR.reg = (uint32_t) destination;
+    descriptor->DESCADDR.reg = (uint32_t) descriptor;
+    descriptor->BTCTRL.bit.VALID = true;
+}
+
+// Sets up the matrix to be refreshed by DMA on every overflow of the timer. The row pins are
+// flipped through OUTTGL and the open drain column pins through DIRTGL, with their OUT bits held
+// low, so other pins on the port are left alone. Returns false if the pins aren't all on one port
+// or two DMA channels aren't free.
+static bool start_dma(pew_obj_t* pew, uint8_t tc_index) {
+    pew->port = GPIO_PORT(pin_of(pew->rows[0])->number);
+    for (size_t i = 0; i < pew->rows_size; ++i) {
+        if (GPIO_PORT(pin_of(pew->rows[i])->number) != pew->port) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < pew->cols_size; ++i) {
+        if (GPIO_PORT(pin_of(pew->cols[i])->number) != pew->port) {
+            return false;
+        }
+    }
+    uint8_t channels[2];
+    uint8_t found = 0;
+    for (uint8_t channel = 0; channel < AUDIO_DMA_CHANNEL_COUNT && found < 2; channel++) {
+        if (!dma_channel_enabled(channel)) {
+            channels[found++] = channel;
+        }
+    }
+    if (found < 2) {
+        return false;
+    }
+
+    size_t steps = PEW_TURNS * pew->cols_size;
+    size_t buffer_size = pew->rows_size * pew->cols_size;
+    pew->row_toggles[0] = m_new(uint32_t, steps);
+    pew->row_toggles[1] = m_new(uint32_t, steps);
+    pew->column_toggles = m_new(uint32_t, pew->cols_size);
+    pew->shown = m_new(uint8_t, buffer_size);
+    pew->active_toggles = 0;
+    pew->swap_pending = false;
+    pew->last_rows[0] = build_row_toggles(pew, pew->row_toggles[0]);
+    memcpy(pew->shown, pew->buffer, buffer_size);
+    uint32_t columns = 0;
+    for (size_t col = 0; col < pew->cols_size; ++col) {
+        size_t previous = (col + pew->cols_size - 1) % pew->cols_size;
+        pew->column_toggles[col] = pin_mask(pew->cols[col]) ^ pin_mask(pew->cols[previous]);
+        columns |= pin_mask(pew->cols[col]);
+    }
+    pew->sampled = 0;
+    pew->sampled_pressed = 0;
+    pew->last_pressed = 0;
+
+    // Start from the end of a cycle: the last column on, showing the rows of the last step.
+    PortGroup* group = &PORT->Group[pew->port];
+    group->OUTCLR.reg = columns;
+    group->DIRSET.reg = pin_mask(pew->cols[pew->cols_size - 1]);
+    group->OUTSET.reg = pew->last_rows[0];
+
+    pewpew_row_dma_channel = channels[0];
+    pewpew_column_dma_channel = channels[1];
+    setup_toggle_descriptor(pewpew_row_dma_channel, pew->row_toggles[0], steps,
+                            &group->OUTTGL.reg);
+    setup_toggle_descriptor(pewpew_column_dma_channel, pew->column_toggles, pew->cols_size,
+                            &group->DIRTGL.reg);
+    // Both channels take one beat per overflow so they stay in step.
+    dma_configure(pewpew_row_dma_channel, TC_OVF_DMA_TRIGGER(tc_index), false);
+    dma_configure(pewpew_column_dma_channel, TC_OVF_DMA_TRIGGER(tc_index), false);
+    dma_enable_channel(pewpew_row_dma_channel);
+    dma_enable_channel(pewpew_column_dma_channel);
+    return true;
+}
+
+static void stop_refresh(void) {
+    if (pewpew_tc_index != 0xff) {
+        tc_reset(tc_insts[pewpew_tc_index]);
+        pewpew_tc_index = 0xff;
+    }
+    if (pewpew_row_dma_channel != NO_DMA_CHANNEL) {
+        dma_disable_channel(pewpew_row_dma_channel);
+        dma_descriptor(pewpew_row_dma_channel)->BTCTRL.bit.VALID = false;
+        dma_disable_channel(pewpew_column_dma_channel);
+        dma_descriptor(pewpew_column_dma_channel)->BTCTRL.bit.VALID = false;
+        pewpew_row_dma_channel = NO_DMA_CHANNEL;
+        pewpew_column_dma_channel = NO_DMA_CHANNEL;
+    }
+}
+
 void pew_init() {
     pew_obj_t* pew = MP_STATE_VM(pew_singleton);
 
+    // The tables of an earlier refresh may be about to be replaced.
+    stop_refresh();
+
     common_hal_digitalio_digitalinout_switch_to_input(pew->buttons, PULL_UP);
 
     for (size_t i = 0; i < pew->rows_size; ++i) {
@@ -72,54 +206,113 @@ void pew_init() {
         common_hal_digitalio_digitalinout_switch_to_output(pin, true,
             DRIVE_MODE_OPEN_DRAIN);
     }
-    if (pewpew_tc_index == 0xff) {
-        // Find a spare timer.
-        uint8_t index = find_free_timer();
-        if (index == 0xff) {
-            mp_raise_RuntimeError(translate("All timers in use"));
-        }
-        Tc *tc = tc_insts[index];
-
-        pewpew_tc_index = index;
-        set_timer_handler(true, index, TC_HANDLER_PEW);
-
-        // We use GCLK0 for SAMD21 and GCLK1 for SAMD51 because they both run
-        // at 48mhz making our math the same across the boards.
-        #ifdef SAMD21
-        turn_on_clocks(true, index, 0);
-        #endif
-        #ifdef SAMD51
-        turn_on_clocks(true, index, 1);
-        #endif
-
-
-        #ifdef SAMD21
-        tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
-                                TC_CTRLA_PRESCALER_DIV64 |
-                                TC_CTRLA_WAVEGEN_MFRQ;
-        #endif
-        #ifdef SAMD51
-        tc_reset(tc);
-        tc_set_enable(tc, false);
-        tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16
-            | TC_CTRLA_PRESCALER_DIV64;
-        tc->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
-        #endif
 
-        tc_set_enable(tc, true);
+    // Find a spare timer.
+    uint8_t index = find_free_timer();
+    if (index == 0xff) {
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+    Tc *tc = tc_insts[index];
+
+    pewpew_tc_index = index;
+
+    // We use GCLK0 for SAMD21 and GCLK1 for SAMD51 because they both run
+    // at 48mhz making our math the same across the boards.
+    #ifdef SAMD21
+    turn_on_clocks(true, index, 0);
+    #endif
+    #ifdef SAMD51
+    turn_on_clocks(true, index, 1);
+    #endif
+
+
+    #ifdef SAMD21
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
+                            TC_CTRLA_PRESCALER_DIV64 |
+                            TC_CTRLA_WAVEGEN_MFRQ;
+    #endif
+    #ifdef SAMD51
+    tc_reset(tc);
+    tc_set_enable(tc, false);
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16
+        | TC_CTRLA_PRESCALER_DIV64;
+    tc->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+    #endif
+
+    if (start_dma(pew, index)) {
+        set_timer_handler(true, index, TC_HANDLER_NO_INTERRUPT);
+        // Set the period before the first overflow triggers the DMA.
         tc->COUNT16.CC[0].reg = 64;
+        tc_set_enable(tc, true);
+        return;
+    }
+
+    set_timer_handler(true, index, TC_HANDLER_PEW);
+    tc_set_enable(tc, true);
+    tc->COUNT16.CC[0].reg = 64;
 
-        // Clear our interrupt in case it was set earlier
-        tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
-        tc->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
-        tc_enable_interrupts(pewpew_tc_index);
+    // Clear our interrupt in case it was set earlier
+    tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+    tc->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
+    tc_enable_interrupts(pewpew_tc_index);
+}
+
+// Reads the buttons for whichever column is lit. Over a few milliseconds every column is read,
+// which counts as one pass of pew_tick().
+static void scan_buttons(pew_obj_t* pew, DmacDescriptor* write_back) {
+    DmacDescriptor* columns = &write_back[pewpew_column_dma_channel];
+    uint16_t remaining = columns->BTCNT.reg;
+    bool pressed = !common_hal_digitalio_digitalinout_get_value(pew->buttons);
+    if (columns->BTCNT.reg != remaining) {
+        // The column changed while the buttons were read.
+        return;
+    }
+    // The lit column is the last one written. Like pew_tick(), credit the reading to the
+    // column after it.
+    size_t lit = (2 * pew->cols_size - 1 - remaining) % pew->cols_size;
+    uint8_t bit = 1 << ((lit + 1) % pew->cols_size);
+    pew->sampled |= bit;
+    if (pressed) {
+        pew->sampled_pressed |= bit;
+    }
+    if (pew->sampled == (uint8_t) ((1 << pew->cols_size) - 1)) {
+        pew->pressed |= pew->last_pressed & pew->sampled_pressed;
+        pew->last_pressed = pew->sampled_pressed;
+        pew->sampled = 0;
+        pew->sampled_pressed = 0;
     }
 }
 
-void pew_reset(void) {
-    if (pewpew_tc_index != 0xff) {
-        tc_reset(tc_insts[pewpew_tc_index]);
-        pewpew_tc_index = 0xff;
+void pew_background(void) {
+    pew_obj_t* pew = MP_STATE_VM(pew_singleton);
+    if (pew == NULL || pewpew_row_dma_channel == NO_DMA_CHANNEL) {
+        return;
+    }
+    DmacDescriptor* write_back = (DmacDescriptor*) DMAC->WRBADDR.reg;
+    size_t steps = PEW_TURNS * pew->cols_size;
+    uint8_t next = 1 - pew->active_toggles;
+    if (pew->swap_pending) {
+        // The DMA fetches the descriptor again at the end of every cycle, so the new table starts
+        // then.
+        if (write_back[pewpew_row_dma_channel].SRCADDR.reg ==
+            (uint32_t) (pew->row_toggles[next] + steps)) {
+            // The new table starts from its own last rows but the old table's are lit. Flips
+            // commute, so make up the difference now.
+            PORT->Group[pew->port].OUTTGL.reg = pew->last_rows[0] ^ pew->last_rows[1];
+            pew->active_toggles = next;
+            pew->swap_pending = false;
+        }
+    } else if (memcmp(pew->shown, pew->buffer, pew->rows_size * pew->cols_size) != 0) {
+        pew->last_rows[next] = build_row_toggles(pew, pew->row_toggles[next]);
+        memcpy(pew->shown, pew->buffer, pew->rows_size * pew->cols_size);
+        dma_descriptor(pewpew_row_dma_channel)->SRCADDR.reg =
+            (uint32_t) (pew->row_toggles[next] + steps);
+        pew->swap_pending = true;
     }
+    scan_buttons(pew, write_back);
+}
+
+void pew_reset(void) {
+    stop_refresh();
     MP_STATE_VM(pew_singleton) = NULL;
 }
@@ -39,10 +39,26 @@ typedef struct {
     uint8_t rows_size;
     uint8_t cols_size;
     uint8_t pressed;
+    // When every matrix pin is on one port, the timer triggers DMA that flips the pins for each
+    // step of a refresh cycle from precomputed tables instead of interrupting.
+    uint32_t* row_toggles[2];
+    uint32_t* column_toggles;
+    // The buffer contents the newest row toggles were built from.
+    uint8_t* shown;
+    // The rows lit in the last step of each row toggle table.
+    uint32_t last_rows[2];
+    uint8_t active_toggles;
+    bool swap_pending;
+    uint8_t port;
+    // Buttons read by pew_background() for each column, and what they read.
+    uint8_t sampled;
+    uint8_t sampled_pressed;
+    uint8_t last_pressed;
 } pew_obj_t;
 
 void pew_init(void);
 void pewpew_interrupt_handler(uint8_t index);
+void pew_background(void);
 void pew_reset(void);
 
 #endif  // MICROPY_INCLUDED_PEW_PEWPEW_H
@@ -33,6 +33,19 @@
 #include "shared-bindings/digitalio/DigitalInOut.h"
 
 
+bool pew_lit(uint8_t color, uint8_t turn) {
+    switch (color & 0x03) {
+        case 3:
+            return true;
+        case 2:
+            return turn == 2 || turn == 5 || turn == 8 || turn == 11;
+        case 1:
+            return turn == 0;
+        default:
+            return false;
+    }
+}
+
 void pew_tick(void) {
     static uint8_t col = 0;
     static uint8_t turn = 0;
@@ -51,7 +64,7 @@ void pew_tick(void) {
         pressed = 0;
         col = 0;
         ++turn;
-        if (turn > 11) {
+        if (turn >= PEW_TURNS) {
             turn = 0;
         }
     }
@@ -62,25 +75,7 @@ void pew_tick(void) {
     for (size_t x = 0; x < pew->rows_size; ++x) {
         pin = MP_OBJ_TO_PTR(pew->rows[x]);
         uint8_t color = pew->buffer[col * (pew->rows_size) + x];
-        bool value = false;
-        switch (color & 0x03) {
-            case 3:
-                value = true;
-                break;
-            case 2:
-                if (turn == 2 || turn == 5 || turn == 8 || turn == 11) {
-                        value = true;
-                }
-                break;
-            case 1:
-                if (turn == 0) {
-                    value = true;
-                }
-                break;
-            case 0:
-                break;
-        }
-        common_hal_digitalio_digitalinout_set_value(pin, value);
+        common_hal_digitalio_digitalinout_set_value(pin, pew_lit(color, turn));
     }
     pin = MP_OBJ_TO_PTR(pew->cols[col]);
     common_hal_digitalio_digitalinout_set_value(pin, false);
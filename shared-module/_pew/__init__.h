@@ -27,6 +27,14 @@
 #ifndef MICROPY_INCLUDED_PEW_H
 #define MICROPY_INCLUDED_PEW_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+// Every column is lit once per turn. Pixels have four brightness levels, lit for none, one, four
+// or all of the turns.
+#define PEW_TURNS (12)
+
+bool pew_lit(uint8_t color, uint8_t turn);
 void pew_tick(void);
 
 #endif  // MICROPY_INCLUDED_PEW_H
@@ -29,6 +29,7 @@
 #include "py/objarray.h"
 #include "py/runtime.h"
 #include "PixelBuf.h"
+#include <math.h>
 #include <string.h>
 
 void pixelbuf_set_pixel_int(uint8_t *buf, mp_int_t value, pixelbuf_byteorder_obj_t *byteorder) {
@@ -43,7 +44,7 @@ void pixelbuf_set_pixel_int(uint8_t *buf, mp_int_t value, pixelbuf_byteorder_obj
     }
 }
 
-void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_t *item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar) {
+void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, const uint8_t *lut, mp_obj_t *item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar) {
     if (MP_OBJ_IS_INT(item)) {
         uint8_t *target = rawbuf ? rawbuf : buf;
         pixelbuf_set_pixel_int(target, mp_obj_get_int_truncated(item), byteorder);
@@ -52,15 +53,11 @@ void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_
             if (rawbuf) 
                 rawbuf[0] = DOTSTAR_LED_START_FULL_BRIGHT;
          }
-        if (rawbuf) {
-            buf[byteorder->byteorder.r] = rawbuf[byteorder->byteorder.r] * brightness;
-            buf[byteorder->byteorder.g] = rawbuf[byteorder->byteorder.g] * brightness;
-            buf[byteorder->byteorder.b] = rawbuf[byteorder->byteorder.b] * brightness;
-        } else {
-            buf[byteorder->byteorder.r] *= brightness;
-            buf[byteorder->byteorder.g] *= brightness;
-            buf[byteorder->byteorder.b] *= brightness;
-        }
+        buf[byteorder->byteorder.r] = PIXELBUF_SCALE(lut, target[byteorder->byteorder.r]);
+        buf[byteorder->byteorder.g] = PIXELBUF_SCALE(lut, target[byteorder->byteorder.g]);
+        buf[byteorder->byteorder.b] = PIXELBUF_SCALE(lut, target[byteorder->byteorder.b]);
+        if (byteorder->bpp == 4 && byteorder->has_white)
+            buf[byteorder->byteorder.w] = PIXELBUF_SCALE(lut, target[byteorder->byteorder.w]);
     } else {
         mp_obj_t *items;
         size_t len;
@@ -68,13 +65,16 @@ void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_
         if (len != byteorder->bpp && !dotstar) 
             mp_raise_ValueError_varg(translate("Expected tuple of length %d, got %d"), byteorder->bpp, len);
 
-        buf[byteorder->byteorder.r] = mp_obj_get_int_truncated(items[PIXEL_R]) * brightness;
-        buf[byteorder->byteorder.g] = mp_obj_get_int_truncated(items[PIXEL_G]) * brightness;
-        buf[byteorder->byteorder.b] = mp_obj_get_int_truncated(items[PIXEL_B]) * brightness;
+        uint8_t r = mp_obj_get_int_truncated(items[PIXEL_R]);
+        uint8_t g = mp_obj_get_int_truncated(items[PIXEL_G]);
+        uint8_t b = mp_obj_get_int_truncated(items[PIXEL_B]);
+        buf[byteorder->byteorder.r] = PIXELBUF_SCALE(lut, r);
+        buf[byteorder->byteorder.g] = PIXELBUF_SCALE(lut, g);
+        buf[byteorder->byteorder.b] = PIXELBUF_SCALE(lut, b);
         if (rawbuf) {
-            rawbuf[byteorder->byteorder.r] = mp_obj_get_int_truncated(items[PIXEL_R]);
-            rawbuf[byteorder->byteorder.g] = mp_obj_get_int_truncated(items[PIXEL_G]);
-            rawbuf[byteorder->byteorder.b] = mp_obj_get_int_truncated(items[PIXEL_B]);
+            rawbuf[byteorder->byteorder.r] = r;
+            rawbuf[byteorder->byteorder.g] = g;
+            rawbuf[byteorder->byteorder.b] = b;
         }
         if (len > 3) {
             if (dotstar) {
@@ -82,9 +82,10 @@ void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_
                 if (rawbuf)
                     rawbuf[byteorder->byteorder.w] = buf[byteorder->byteorder.w];
             } else {
-                buf[byteorder->byteorder.w] = mp_obj_get_int_truncated(items[PIXEL_W]) * brightness;
+                uint8_t w = mp_obj_get_int_truncated(items[PIXEL_W]);
+                buf[byteorder->byteorder.w] = PIXELBUF_SCALE(lut, w);
                 if (rawbuf)
-                    rawbuf[byteorder->byteorder.w] = mp_obj_get_int_truncated(items[PIXEL_W]);
+                    rawbuf[byteorder->byteorder.w] = w;
             }
         } else if (dotstar) {
             buf[byteorder->byteorder.w] = DOTSTAR_LED_START_FULL_BRIGHT;
@@ -118,3 +119,122 @@ mp_obj_t *pixelbuf_get_pixel(uint8_t *buf, pixelbuf_byteorder_obj_t *byteorder,
 
     return mp_obj_new_tuple(byteorder->bpp, elems);
 }
+
+// Rebuild the brightness/gamma table.  Brightness is applied as a Q8 integer
+// multiply so that changing it never touches floats per pixel.  Full brightness
+// with no gamma needs no table at all.
+void pixelbuf_update_lut(pixelbuf_pixelbuf_obj_t *self) {
+    uint16_t scale = (uint16_t)(self->brightness * 256 + MICROPY_FLOAT_CONST(0.5));
+    if (scale >= 256 && self->gamma == MICROPY_FLOAT_CONST(1.0)) {
+        if (self->lut != NULL) {
+            m_del(uint8_t, self->lut, 256);
+            self->lut = NULL;
+        }
+        return;
+    }
+    if (self->lut == NULL) {
+        self->lut = m_new(uint8_t, 256);
+    }
+    for (uint16_t i = 0; i < 256; i++) {
+        uint16_t value = i;
+        if (self->gamma != MICROPY_FLOAT_CONST(1.0)) {
+            value = (uint16_t)(MICROPY_FLOAT_C_FUN(pow)(i / MICROPY_FLOAT_CONST(255.0), self->gamma) * 255 + MICROPY_FLOAT_CONST(0.5));
+        }
+        self->lut[i] = (value * scale) >> 8;
+    }
+}
+
+void pixelbuf_recalculate_brightness(pixelbuf_pixelbuf_obj_t *self) {
+    uint8_t *buf = (uint8_t *)self->buf;
+    uint8_t *rawbuf = (uint8_t *)self->rawbuf;
+    // Compensate for shifted buffer (bpp=3 dotstar)
+    for (uint i = 0; i < self->bytes; i++) {
+        // Don't adjust per-pixel luminance bytes in dotstar mode
+        if (!self->dotstar_mode || (i % 4 != 0)) 
+            buf[i] = PIXELBUF_SCALE(self->lut, rawbuf[i]);
+    }
+}
+
+// Sets the first pixel normally and then copies its bytes over the rest of the range.
+void pixelbuf_fill(pixelbuf_pixelbuf_obj_t *self, size_t start, size_t end, mp_obj_t color) {
+    if (start >= end) {
+        return;
+    }
+    size_t step = self->pixel_step;
+    uint8_t *first = self->buf + start * step;
+    uint8_t *rawfirst = self->two_buffers ? self->rawbuf + start * step : NULL;
+    pixelbuf_set_pixel(first, rawfirst, self->lut, color, &self->byteorder, self->dotstar_mode);
+    for (size_t i = start + 1; i < end; i++) {
+        memcpy(self->buf + i * step, first, step);
+        if (rawfirst) {
+            memcpy(self->rawbuf + i * step, rawfirst, step);
+        }
+    }
+}
+
+STATIC void reverse_pixels(uint8_t *buf, size_t start, size_t end, size_t step) {
+    while (end > start + 1) {
+        end--;
+        uint8_t *a = buf + start * step;
+        uint8_t *b = buf + end * step;
+        for (size_t i = 0; i < step; i++) {
+            uint8_t t = a[i];
+            a[i] = b[i];
+            b[i] = t;
+        }
+        start++;
+    }
+}
+
+STATIC void rotate_pixels(uint8_t *buf, size_t pixels, size_t n, size_t step) {
+    reverse_pixels(buf, 0, pixels, step);
+    reverse_pixels(buf, 0, n, step);
+    reverse_pixels(buf, n, pixels, step);
+}
+
+// Moves every pixel n places towards the end of the strip (negative n moves
+// towards the start).  With shift, pixels that fall off the end are dropped
+// and the vacated ones are turned off instead of wrapping around.
+void pixelbuf_rotate(pixelbuf_pixelbuf_obj_t *self, mp_int_t n, bool shift) {
+    mp_int_t pixels = self->pixels;
+    if (pixels == 0) {
+        return;
+    }
+    if (shift && (n >= pixels || n <= -pixels)) {
+        pixelbuf_fill(self, 0, pixels, MP_OBJ_NEW_SMALL_INT(0));
+        return;
+    }
+    mp_int_t places = n % pixels;
+    if (places < 0) {
+        places += pixels;
+    }
+    if (places != 0) {
+        rotate_pixels(self->buf, pixels, places, self->pixel_step);
+        if (self->two_buffers) {
+            rotate_pixels(self->rawbuf, pixels, places, self->pixel_step);
+        }
+    }
+    if (shift) {
+        if (n > 0) {
+            pixelbuf_fill(self, 0, n, MP_OBJ_NEW_SMALL_INT(0));
+        } else if (n < 0) {
+            pixelbuf_fill(self, pixels + n, pixels, MP_OBJ_NEW_SMALL_INT(0));
+        }
+    }
+}
+
+// Crossfades a into b by factor/256 and stores the result as the raw colors of
+// self.  DotStar start bytes interpolate between two values that both have the
+// top three bits set, so they stay valid.
+void pixelbuf_blend(pixelbuf_pixelbuf_obj_t *self, pixelbuf_pixelbuf_obj_t *a, pixelbuf_pixelbuf_obj_t *b, uint16_t factor) {
+    uint8_t *dest = self->two_buffers ? self->rawbuf : self->buf;
+    const uint8_t *from = a->two_buffers ? a->rawbuf : a->buf;
+    const uint8_t *to = b->two_buffers ? b->rawbuf : b->buf;
+    for (size_t i = 0; i < self->bytes; i++) {
+        int16_t delta = to[i] - from[i];
+        dest[i] = from[i] + ((delta * factor) >> 8);
+    }
+    if (self->two_buffers) {
+        pixelbuf_recalculate_brightness(self);
+    }
+}
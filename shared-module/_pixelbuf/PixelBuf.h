@@ -28,6 +28,7 @@
 #include "py/obj.h"
 #include "py/objarray.h"
 #include "../../shared-bindings/_pixelbuf/types.h"
+#include "../../shared-bindings/_pixelbuf/PixelBuf.h"
 
 #ifndef PIXELBUF_SHARED_MODULE_H
 #define PIXELBUF_SHARED_MODULE_H
@@ -42,9 +43,17 @@
 #define DOTSTAR_GET_BRIGHTNESS(value) ((value & 0b00011111) / 31.0)
 #define DOTSTAR_LED_START_FULL_BRIGHT 0xFF
 
-void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, float brightness, mp_obj_t *item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
+// Scale a raw channel value through a brightness/gamma table.  A NULL table is the identity.
+#define PIXELBUF_SCALE(lut, value) ((lut) == NULL ? (uint8_t)(value) : (lut)[(uint8_t)(value)])
+
+void pixelbuf_set_pixel(uint8_t *buf, uint8_t *rawbuf, const uint8_t *lut, mp_obj_t *item, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
 mp_obj_t *pixelbuf_get_pixel(uint8_t *buf, pixelbuf_byteorder_obj_t *byteorder, bool dotstar);
 mp_obj_t *pixelbuf_get_pixel_array(uint8_t *buf, uint len, pixelbuf_byteorder_obj_t *byteorder, uint8_t step, bool dotstar);
 void pixelbuf_set_pixel_int(uint8_t *buf, mp_int_t value, pixelbuf_byteorder_obj_t *byteorder);
 
+void pixelbuf_update_lut(pixelbuf_pixelbuf_obj_t *self);
+void pixelbuf_fill(pixelbuf_pixelbuf_obj_t *self, size_t start, size_t end, mp_obj_t color);
+void pixelbuf_rotate(pixelbuf_pixelbuf_obj_t *self, mp_int_t n, bool shift);
+void pixelbuf_blend(pixelbuf_pixelbuf_obj_t *self, pixelbuf_pixelbuf_obj_t *a, pixelbuf_pixelbuf_obj_t *b, uint16_t factor);
+
 #endif
@@ -103,3 +103,70 @@ uint16_t get_layer_pixel(layer_obj_t *layer, uint16_t x, uint16_t y) {
     // Convert to 16-bit color using the palette.
     return layer->palette[pixel << 1] | layer->palette[(pixel << 1) + 1] << 8;
 }
+
+// Where each rotation starts reading a row of a tile and how it steps through the graphic for each
+// pixel to the right. Row r of the tile starts at (x + x_per_row * r, y + y_per_row * r).
+typedef struct {
+    int8_t x, y;
+    int8_t x_per_row, y_per_row;
+    int8_t step_x, step_y;
+} tile_walk_t;
+
+STATIC const tile_walk_t tile_walks[8] = {
+    {0, 0, 0, 1, 1, 0}, // 0 degrees
+    {0, 15, 1, 0, 0, -1}, // 90 degrees clockwise
+    {15, 15, 0, -1, -1, 0}, // 180 degrees
+    {15, 0, -1, 0, 0, 1}, // 90 degrees counter-clockwise
+    {15, 0, 0, 1, -1, 0}, // 0 degrees, mirrored
+    {0, 0, 1, 0, 0, 1}, // 90 degrees clockwise, mirrored
+    {0, 15, 0, -1, 1, 0}, // 180 degrees, mirrored
+    {15, 15, -1, 0, 0, -1}, // 90 degrees counter-clockwise, mirrored
+};
+
+// Fill the still transparent pixels of row y from x0 up to x1 with the layer. The frame and
+// rotation are resolved once for each tile the row crosses instead of for every pixel.
+void fill_layer_span(layer_obj_t *layer, int16_t y, int16_t x0, int16_t x1, uint16_t *buffer) {
+    int32_t local_y = y - layer->y;
+    if (local_y < 0 || local_y >= layer->height << 4) {
+        return;
+    }
+    int32_t start = MAX(x0, layer->x);
+    int32_t end = MIN(x1, layer->x + (layer->width << 4));
+    const tile_walk_t *walk = &tile_walks[layer->rotation < 8 ? layer->rotation : 0];
+    uint8_t row_in_tile = local_y & 0x0f;
+    uint8_t tile_row = local_y >> 4;
+
+    int32_t x = start;
+    while (x < end) {
+        int32_t local_x = x - layer->x;
+        uint8_t tx = local_x >> 4;
+        uint8_t frame = layer->frame;
+        if (layer->map) {
+            frame = layer->map[(tile_row * layer->width + tx) >> 1];
+            if (tx & 0x01) {
+                frame &= 0x0f;
+            } else {
+                frame >>= 4;
+            }
+        }
+        const uint8_t *graphic = layer->graphic + (frame << 7);
+
+        uint8_t column = local_x & 0x0f;
+        int8_t gx = walk->x + walk->x_per_row * row_in_tile + walk->step_x * column;
+        int8_t gy = walk->y + walk->y_per_row * row_in_tile + walk->step_y * column;
+        int32_t tile_end = MIN(end, x + 16 - column);
+        for (; x < tile_end; x++, gx += walk->step_x, gy += walk->step_y) {
+            uint16_t *pixel = &buffer[x - x0];
+            if (*pixel != TRANSPARENT) {
+                continue;
+            }
+            uint8_t value = graphic[(gy << 3) + (gx >> 1)];
+            if (gx & 0x01) {
+                value &= 0x0f;
+            } else {
+                value >>= 4;
+            }
+            *pixel = layer->palette[value << 1] | layer->palette[(value << 1) + 1] << 8;
+        }
+    }
+}
@@ -44,5 +44,6 @@ typedef struct {
 } layer_obj_t;
 
 uint16_t get_layer_pixel(layer_obj_t *layer, uint16_t x, uint16_t y);
+void fill_layer_span(layer_obj_t *layer, int16_t y, int16_t x0, int16_t x1, uint16_t *buffer);
 
 #endif  // MICROPY_INCLUDED_SHARED_MODULE__STAGE_LAYER
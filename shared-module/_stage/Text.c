@@ -65,3 +65,44 @@ uint16_t get_text_pixel(text_obj_t *text, uint16_t x, uint16_t y) {
     // Convert to 16-bit color using the palette.
     return text->palette[pixel << 1] | text->palette[(pixel << 1) + 1] << 8;
 }
+
+// Fill the still transparent pixels of row y from x0 up to x1 with the text. Each character's row
+// of the font is read once.
+void fill_text_span(text_obj_t *text, int16_t y, int16_t x0, int16_t x1, uint16_t *buffer) {
+    int32_t local_y = y - text->y;
+    if (local_y < 0 || local_y >= text->height << 3) {
+        return;
+    }
+    int32_t start = MAX(x0, text->x);
+    int32_t end = MIN(x1, text->x + (text->width << 3));
+    const uint8_t *chars = text->chars + (local_y >> 3) * text->width;
+    uint8_t row_in_char = local_y & 0x07;
+
+    int32_t x = start;
+    while (x < end) {
+        int32_t local_x = x - text->x;
+        uint8_t column = local_x & 0x07;
+        int32_t char_end = MIN(end, x + 8 - column);
+        uint8_t c = chars[local_x >> 3];
+        uint8_t color_offset = 0;
+        if (c & 0x80) {
+            color_offset = 4;
+        }
+        c &= 0x7f;
+        if (!c) {
+            x = char_end;
+            continue;
+        }
+        // The eight two bit pixels of the row, lowest bits first.
+        const uint8_t *font_row = text->font + (c << 4) + (row_in_char << 1);
+        uint16_t bits = (font_row[0] | font_row[1] << 8) >> (column << 1);
+        for (; x < char_end; x++, bits >>= 2) {
+            uint16_t *pixel = &buffer[x - x0];
+            if (*pixel != TRANSPARENT) {
+                continue;
+            }
+            uint8_t value = (bits & 0x03) + color_offset;
+            *pixel = text->palette[value << 1] | text->palette[(value << 1) + 1] << 8;
+        }
+    }
+}
@@ -42,5 +42,6 @@ typedef struct {
 } text_obj_t;
 
 uint16_t get_text_pixel(text_obj_t *text, uint16_t x, uint16_t y);
+void fill_text_span(text_obj_t *text, int16_t y, int16_t x0, int16_t x1, uint16_t *buffer);
 
 #endif  // MICROPY_INCLUDED_SHARED_MODULE__STAGE_TEXT
@@ -31,37 +31,58 @@
 #include "shared-bindings/_stage/Text.h"
 
 
+// Composite the pixels of row y from x0 up to x1 into buffer. Each layer only fills the pixels that
+// the layers above it left transparent.
+STATIC void render_span(int16_t y, int16_t x0, int16_t x1, mp_obj_t *layers, size_t layers_size,
+        uint16_t *buffer) {
+    for (int16_t x = x0; x < x1; ++x) {
+        buffer[x - x0] = TRANSPARENT;
+    }
+    for (size_t layer = 0; layer < layers_size; ++layer) {
+        layer_obj_t *obj = MP_OBJ_TO_PTR(layers[layer]);
+        if (obj->base.type == &mp_type_layer) {
+            fill_layer_span(obj, y, x0, x1, buffer);
+        } else if (obj->base.type == &mp_type_text) {
+            fill_text_span((text_obj_t *)obj, y, x0, x1, buffer);
+        }
+    }
+}
+
 void render_stage(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
         mp_obj_t *layers, size_t layers_size,
         uint16_t *buffer, size_t buffer_size,
         displayio_display_obj_t *display) {
 
+    // Split the buffer in two so that one half is rendered while the other is sent in the
+    // background. Sending waits for the previous data to go out so the half being rendered into
+    // is never still in use.
+    size_t half_size = buffer_size / 2;
+    if (half_size == 0) {
+        half_size = buffer_size;
+    }
+    uint16_t *half = buffer;
     size_t index = 0;
     for (uint16_t y = y0; y < y1; ++y) {
-        for (uint16_t x = x0; x < x1; ++x) {
-            for (size_t layer = 0; layer < layers_size; ++layer) {
-                uint16_t c = TRANSPARENT;
-                layer_obj_t *obj = MP_OBJ_TO_PTR(layers[layer]);
-                if (obj->base.type == &mp_type_layer) {
-                    c = get_layer_pixel(obj, x, y);
-                } else if (obj->base.type == &mp_type_text) {
-                    c = get_text_pixel((text_obj_t *)obj, x, y);
+        uint16_t x = x0;
+        while (x < x1) {
+            uint16_t count = MIN((size_t) (x1 - x), half_size - index);
+            render_span(y, x, x + count, layers, layers_size, half + index);
+            index += count;
+            x += count;
+            // The half is full, send it.
+            if (index >= half_size) {
+                display->send(display->bus, false, ((uint8_t*)half), half_size * 2);
+                if (half == buffer && half_size < buffer_size) {
+                    half = buffer + half_size;
+                } else {
+                    half = buffer;
                 }
-                if (c != TRANSPARENT) {
-                    buffer[index] = c;
-                    break;
-                }
-            }
-            index += 1;
-            // The buffer is full, send it.
-            if (index >= buffer_size) {
-                display->send(display->bus, false, ((uint8_t*)buffer), buffer_size * 2);
                 index = 0;
             }
         }
     }
     // Send the remaining data.
     if (index) {
-        display->send(display->bus, false, ((uint8_t*)buffer), index * 2);
+        display->send(display->bus, false, ((uint8_t*)half), index * 2);
     }
 }
@@ -0,0 +1,479 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-bindings/arrayops/__init__.h"
+
+#define IS_FLOAT_KIND(kind) ((kind) >= ARRAYOPS_FLOAT)
+
+// Saturation limits of the integer kinds, indexed by arrayops_kind_t.
+STATIC const int64_t arrayops_int_min[] = { INT8_MIN, 0, INT16_MIN, 0, INT32_MIN, 0 };
+STATIC const int64_t arrayops_int_max[] = { INT8_MAX, UINT8_MAX, INT16_MAX, UINT16_MAX, INT32_MAX, UINT32_MAX };
+
+static inline int64_t arrayops_get_int(const arrayops_array_t *a, size_t i) {
+    switch (a->kind) {
+        case ARRAYOPS_INT8:
+            return ((int8_t *)a->buf)[i];
+        case ARRAYOPS_UINT8:
+            return ((uint8_t *)a->buf)[i];
+        case ARRAYOPS_INT16:
+            return ((int16_t *)a->buf)[i];
+        case ARRAYOPS_UINT16:
+            return ((uint16_t *)a->buf)[i];
+        case ARRAYOPS_INT32:
+            return ((int32_t *)a->buf)[i];
+        case ARRAYOPS_UINT32:
+            return ((uint32_t *)a->buf)[i];
+        default:
+            return 0;
+    }
+}
+
+static inline mp_float_t arrayops_get_float(const arrayops_array_t *a, size_t i) {
+    switch (a->kind) {
+        case ARRAYOPS_FLOAT:
+            return ((float *)a->buf)[i];
+        case ARRAYOPS_DOUBLE:
+            return ((double *)a->buf)[i];
+        default:
+            return arrayops_get_int(a, i);
+    }
+}
+
+static inline int64_t arrayops_clamp(int64_t v, int64_t low, int64_t high) {
+    return v < low ? low : (v > high ? high : v);
+}
+
+static inline void arrayops_set_int(arrayops_array_t *a, size_t i, int64_t v) {
+    v = arrayops_clamp(v, arrayops_int_min[a->kind], arrayops_int_max[a->kind]);
+    switch (a->kind) {
+        case ARRAYOPS_INT8:
+            ((int8_t *)a->buf)[i] = v;
+            break;
+        case ARRAYOPS_UINT8:
+            ((uint8_t *)a->buf)[i] = v;
+            break;
+        case ARRAYOPS_INT16:
+            ((int16_t *)a->buf)[i] = v;
+            break;
+        case ARRAYOPS_UINT16:
+            ((uint16_t *)a->buf)[i] = v;
+            break;
+        case ARRAYOPS_INT32:
+            ((int32_t *)a->buf)[i] = v;
+            break;
+        case ARRAYOPS_UINT32:
+            ((uint32_t *)a->buf)[i] = v;
+            break;
+        default:
+            break;
+    }
+}
+
+// Rounds half away from zero and saturates to the range of an integer kind. NaN becomes 0.
+static inline int64_t arrayops_float_to_int(mp_float_t v, arrayops_kind_t kind) {
+    if (v != v) {
+        return 0;
+    }
+    if (v <= (mp_float_t)arrayops_int_min[kind]) {
+        return arrayops_int_min[kind];
+    }
+    if (v >= (mp_float_t)arrayops_int_max[kind]) {
+        return arrayops_int_max[kind];
+    }
+    return v < 0 ? -(int64_t)(MICROPY_FLOAT_CONST(0.5) - v) : (int64_t)(v + MICROPY_FLOAT_CONST(0.5));
+}
+
+static inline void arrayops_set_float(arrayops_array_t *a, size_t i, mp_float_t v) {
+    switch (a->kind) {
+        case ARRAYOPS_FLOAT:
+            ((float *)a->buf)[i] = v;
+            break;
+        case ARRAYOPS_DOUBLE:
+            ((double *)a->buf)[i] = v;
+            break;
+        default:
+            arrayops_set_int(a, i, arrayops_float_to_int(v, a->kind));
+            break;
+    }
+}
+
+static inline int64_t arrayops_add_sat(int64_t x, int64_t y) {
+    int64_t r;
+    if (__builtin_add_overflow(x, y, &r)) {
+        r = y < 0 ? INT64_MIN : INT64_MAX;
+    }
+    return r;
+}
+
+static inline int64_t arrayops_mul_sat(int64_t x, int64_t y) {
+    int64_t r;
+    if (__builtin_mul_overflow(x, y, &r)) {
+        r = (x < 0) != (y < 0) ? INT64_MIN : INT64_MAX;
+    }
+    return r;
+}
+
+static inline mp_float_t arrayops_value_as_float(const arrayops_value_t *v) {
+    return v->is_float ? v->f : (mp_float_t)v->i;
+}
+
+static inline int16_t arrayops_sat16(int32_t v) {
+    return v < INT16_MIN ? INT16_MIN : (v > INT16_MAX ? INT16_MAX : v);
+}
+
+// Saturating add of two int16 arrays, the common case for mixing audio. Cortex-M4 and up add
+// two samples at a time with one DSP instruction.
+STATIC void arrayops_add_int16(int16_t *a, const int16_t *b, size_t len) {
+    size_t i = 0;
+    #if (defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+    for (; i + 1 < len; i += 2) {
+        uint32_t x, y;
+        memcpy(&x, a + i, sizeof(x));
+        memcpy(&y, b + i, sizeof(y));
+        x = __QADD16(x, y);
+        memcpy(a + i, &x, sizeof(x));
+    }
+    #endif
+    for (; i < len; i++) {
+        a[i] = arrayops_sat16((int32_t)a[i] + b[i]);
+    }
+}
+
+// Dot product of two int16 arrays. Cortex-M4 and up multiply-accumulate two pairs at a time.
+STATIC int64_t arrayops_dot_int16(const int16_t *a, const int16_t *b, size_t len) {
+    int64_t acc = 0;
+    size_t i = 0;
+    #if (defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+    for (; i + 1 < len; i += 2) {
+        uint32_t x, y;
+        memcpy(&x, a + i, sizeof(x));
+        memcpy(&y, b + i, sizeof(y));
+        acc = __SMLALD(x, y, acc);
+    }
+    #endif
+    for (; i < len; i++) {
+        acc += (int32_t)a[i] * b[i];
+    }
+    return acc;
+}
+
+STATIC void arrayops_apply(arrayops_array_t *a, const arrayops_array_t *b, const arrayops_value_t *v, bool mul) {
+    size_t len = a->len;
+    bool use_float = IS_FLOAT_KIND(a->kind) || (b != NULL ? IS_FLOAT_KIND(b->kind) : v->is_float);
+
+    // Typed loops for the common sensor and audio cases. The general loops below handle the rest.
+    if (a->kind == ARRAYOPS_FLOAT && (b == NULL || b->kind == ARRAYOPS_FLOAT)) {
+        float *p = a->buf;
+        if (b == NULL) {
+            float s = arrayops_value_as_float(v);
+            for (size_t i = 0; i < len; i++) {
+                p[i] = mul ? p[i] * s : p[i] + s;
+            }
+        } else {
+            const float *q = b->buf;
+            for (size_t i = 0; i < len; i++) {
+                p[i] = mul ? p[i] * q[i] : p[i] + q[i];
+            }
+        }
+        return;
+    }
+    if (a->kind == ARRAYOPS_INT16) {
+        int16_t *p = a->buf;
+        if (b != NULL && b->kind == ARRAYOPS_INT16 && !mul) {
+            arrayops_add_int16(p, b->buf, len);
+            return;
+        }
+        if (b == NULL && !v->is_float) {
+            // Anything beyond +/-65535 saturates every nonzero result anyway, and clamping the
+            // scalar keeps the products within 32 bits.
+            int32_t s = arrayops_clamp(v->i, -UINT16_MAX, UINT16_MAX);
+            for (size_t i = 0; i < len; i++) {
+                p[i] = arrayops_sat16(mul ? p[i] * s : p[i] + s);
+            }
+            return;
+        }
+        if (b == NULL && mul) {
+            mp_float_t s = v->f;
+            for (size_t i = 0; i < len; i++) {
+                p[i] = arrayops_float_to_int(p[i] * s, ARRAYOPS_INT16);
+            }
+            return;
+        }
+    }
+
+    if (use_float) {
+        mp_float_t s = b == NULL ? arrayops_value_as_float(v) : 0;
+        for (size_t i = 0; i < len; i++) {
+            mp_float_t x = arrayops_get_float(a, i);
+            mp_float_t y = b == NULL ? s : arrayops_get_float(b, i);
+            arrayops_set_float(a, i, mul ? x * y : x + y);
+        }
+    } else {
+        for (size_t i = 0; i < len; i++) {
+            int64_t x = arrayops_get_int(a, i);
+            int64_t y = b == NULL ? v->i : arrayops_get_int(b, i);
+            arrayops_set_int(a, i, mul ? arrayops_mul_sat(x, y) : arrayops_add_sat(x, y));
+        }
+    }
+}
+
+void shared_modules_arrayops_add(arrayops_array_t *a, const arrayops_array_t *b, const arrayops_value_t *v) {
+    arrayops_apply(a, b, v, false);
+}
+
+void shared_modules_arrayops_mul(arrayops_array_t *a, const arrayops_array_t *b, const arrayops_value_t *v) {
+    arrayops_apply(a, b, v, true);
+}
+
+void shared_modules_arrayops_clip(arrayops_array_t *a, const arrayops_value_t *low, const arrayops_value_t *high) {
+    if (IS_FLOAT_KIND(a->kind) || low->is_float || high->is_float) {
+        mp_float_t lo = arrayops_value_as_float(low);
+        mp_float_t hi = arrayops_value_as_float(high);
+        for (size_t i = 0; i < a->len; i++) {
+            mp_float_t x = arrayops_get_float(a, i);
+            arrayops_set_float(a, i, x < lo ? lo : (x > hi ? hi : x));
+        }
+    } else {
+        for (size_t i = 0; i < a->len; i++) {
+            arrayops_set_int(a, i, arrayops_clamp(arrayops_get_int(a, i), low->i, high->i));
+        }
+    }
+}
+
+void shared_modules_arrayops_sum(const arrayops_array_t *a, arrayops_value_t *result) {
+    result->is_float = IS_FLOAT_KIND(a->kind);
+    if (a->kind == ARRAYOPS_FLOAT) {
+        const float *p = a->buf;
+        mp_float_t acc = 0;
+        for (size_t i = 0; i < a->len; i++) {
+            acc += p[i];
+        }
+        result->f = acc;
+    } else if (result->is_float) {
+        mp_float_t acc = 0;
+        for (size_t i = 0; i < a->len; i++) {
+            acc += arrayops_get_float(a, i);
+        }
+        result->f = acc;
+    } else if (a->kind == ARRAYOPS_INT16) {
+        const int16_t *p = a->buf;
+        int64_t acc = 0;
+        for (size_t i = 0; i < a->len; i++) {
+            acc += p[i];
+        }
+        result->i = acc;
+    } else {
+        int64_t acc = 0;
+        for (size_t i = 0; i < a->len; i++) {
+            acc += arrayops_get_int(a, i);
+        }
+        result->i = acc;
+    }
+}
+
+// Assumes a is not empty.
+void shared_modules_arrayops_minmax(const arrayops_array_t *a, bool want_max, arrayops_value_t *result) {
+    result->is_float = IS_FLOAT_KIND(a->kind);
+    if (result->is_float) {
+        mp_float_t best = arrayops_get_float(a, 0);
+        for (size_t i = 1; i < a->len; i++) {
+            mp_float_t x = arrayops_get_float(a, i);
+            if (want_max ? x > best : x < best) {
+                best = x;
+            }
+        }
+        result->f = best;
+    } else {
+        int64_t best = arrayops_get_int(a, 0);
+        for (size_t i = 1; i < a->len; i++) {
+            int64_t x = arrayops_get_int(a, i);
+            if (want_max ? x > best : x < best) {
+                best = x;
+            }
+        }
+        result->i = best;
+    }
+}
+
+// Assumes a and b are the same length.
+void shared_modules_arrayops_dot(const arrayops_array_t *a, const arrayops_array_t *b, arrayops_value_t *result) {
+    result->is_float = IS_FLOAT_KIND(a->kind) || IS_FLOAT_KIND(b->kind);
+    if (a->kind == ARRAYOPS_INT16 && b->kind == ARRAYOPS_INT16) {
+        result->i = arrayops_dot_int16(a->buf, b->buf, a->len);
+    } else if (a->kind == ARRAYOPS_FLOAT && b->kind == ARRAYOPS_FLOAT) {
+        const float *p = a->buf;
+        const float *q = b->buf;
+        mp_float_t acc = 0;
+        for (size_t i = 0; i < a->len; i++) {
+            acc += p[i] * q[i];
+        }
+        result->f = acc;
+    } else if (result->is_float) {
+        mp_float_t acc = 0;
+        for (size_t i = 0; i < a->len; i++) {
+            acc += arrayops_get_float(a, i) * arrayops_get_float(b, i);
+        }
+        result->f = acc;
+    } else {
+        int64_t acc = 0;
+        for (size_t i = 0; i < a->len; i++) {
+            acc = arrayops_add_sat(acc, arrayops_mul_sat(arrayops_get_int(a, i), arrayops_get_int(b, i)));
+        }
+        result->i = acc;
+    }
+}
+
+// Assumes dst and src are the same length. Float to integer conversion rounds and saturates.
+void shared_modules_arrayops_convert(arrayops_array_t *dst, const arrayops_array_t *src) {
+    if (IS_FLOAT_KIND(dst->kind) || IS_FLOAT_KIND(src->kind)) {
+        for (size_t i = 0; i < dst->len; i++) {
+            arrayops_set_float(dst, i, arrayops_get_float(src, i));
+        }
+    } else {
+        for (size_t i = 0; i < dst->len; i++) {
+            arrayops_set_int(dst, i, arrayops_get_int(src, i));
+        }
+    }
+}
+
+// Assumes dst and src are the same length. Outputs are computed from the last one back so that
+// each input is read before dst overwrites it, which lets dst be src.
+void shared_modules_arrayops_fir(arrayops_array_t *dst, const arrayops_array_t *src, const arrayops_array_t *taps) {
+    size_t ntaps = taps->len;
+    if (src->kind == ARRAYOPS_FLOAT && taps->kind == ARRAYOPS_FLOAT) {
+        const float *in = src->buf;
+        const float *h = taps->buf;
+        for (size_t i = dst->len; i-- > 0;) {
+            size_t n = i < ntaps ? i + 1 : ntaps;
+            float acc = 0;
+            for (size_t k = 0; k < n; k++) {
+                acc += h[k] * in[i - k];
+            }
+            arrayops_set_float(dst, i, acc);
+        }
+        return;
+    }
+    if (src->kind == ARRAYOPS_INT16 && dst->kind == ARRAYOPS_INT16 && taps->kind == ARRAYOPS_FLOAT) {
+        const int16_t *in = src->buf;
+        int16_t *out = dst->buf;
+        const float *h = taps->buf;
+        for (size_t i = dst->len; i-- > 0;) {
+            size_t n = i < ntaps ? i + 1 : ntaps;
+            float acc = 0;
+            for (size_t k = 0; k < n; k++) {
+                acc += h[k] * in[i - k];
+            }
+            out[i] = arrayops_float_to_int(acc, ARRAYOPS_INT16);
+        }
+        return;
+    }
+    for (size_t i = dst->len; i-- > 0;) {
+        size_t n = i < ntaps ? i + 1 : ntaps;
+        mp_float_t acc = 0;
+        for (size_t k = 0; k < n; k++) {
+            acc += arrayops_get_float(taps, k) * arrayops_get_float(src, i - k);
+        }
+        arrayops_set_float(dst, i, acc);
+    }
+}
+
+// In place radix-2 FFT of n complex values, n a power of two. It works in single precision
+// throughout so that it stays on the FPU of Cortex-M4F chips.
+void shared_modules_arrayops_fft(float *re, float *im, size_t n, bool inverse) {
+    // Put the inputs in bit reversed order.
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            float t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+            t = im[i];
+            im[i] = im[j];
+            im[j] = t;
+        }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        size_t half = len >> 1;
+        float angle = (inverse ? 2.0f : -2.0f) * 3.14159265358979323846f / len;
+        // The twiddle factor w is rotated by angle as w += w * alpha, which loses much less
+        // precision over a stage than multiplying by cos(angle) + i sin(angle) would.
+        float s = sinf(angle / 2);
+        float alpha_re = -2 * s * s;
+        float alpha_im = sinf(angle);
+        float w_re = 1;
+        float w_im = 0;
+        for (size_t k = 0; k < half; k++) {
+            for (size_t i = k; i < n; i += len) {
+                size_t j = i + half;
+                float t_re = w_re * re[j] - w_im * im[j];
+                float t_im = w_re * im[j] + w_im * re[j];
+                re[j] = re[i] - t_re;
+                im[j] = im[i] - t_im;
+                re[i] += t_re;
+                im[i] += t_im;
+            }
+            float t = w_re;
+            w_re += w_re * alpha_re - w_im * alpha_im;
+            w_im += w_im * alpha_re + t * alpha_im;
+        }
+    }
+
+    if (inverse) {
+        float scale = 1.0f / n;
+        for (size_t i = 0; i < n; i++) {
+            re[i] *= scale;
+            im[i] *= scale;
+        }
+    }
+}
+
+// Assumes dst, re and im are the same length.
+void shared_modules_arrayops_magnitude(arrayops_array_t *dst, const arrayops_array_t *re, const arrayops_array_t *im) {
+    if (dst->kind == ARRAYOPS_FLOAT && re->kind == ARRAYOPS_FLOAT && im->kind == ARRAYOPS_FLOAT) {
+        float *out = dst->buf;
+        const float *p = re->buf;
+        const float *q = im->buf;
+        for (size_t i = 0; i < dst->len; i++) {
+            out[i] = sqrtf(p[i] * p[i] + q[i] * q[i]);
+        }
+        return;
+    }
+    for (size_t i = 0; i < dst->len; i++) {
+        mp_float_t x = arrayops_get_float(re, i);
+        mp_float_t y = arrayops_get_float(im, i);
+        arrayops_set_float(dst, i, MICROPY_FLOAT_C_FUN(sqrt)(x * x + y * y));
+    }
+}
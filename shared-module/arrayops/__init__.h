@@ -0,0 +1,61 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_ARRAYOPS___INIT___H
+#define MICROPY_INCLUDED_SHARED_MODULE_ARRAYOPS___INIT___H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+
+// Element types arrayops works on, independent of which typecode letter named them.
+typedef enum {
+    ARRAYOPS_INT8,
+    ARRAYOPS_UINT8,
+    ARRAYOPS_INT16,
+    ARRAYOPS_UINT16,
+    ARRAYOPS_INT32,
+    ARRAYOPS_UINT32,
+    ARRAYOPS_FLOAT,
+    ARRAYOPS_DOUBLE,
+} arrayops_kind_t;
+
+typedef struct {
+    void *buf;
+    size_t len; // In elements, not bytes.
+    arrayops_kind_t kind;
+} arrayops_array_t;
+
+// A scalar operand or result. Integer arithmetic is done in 64 bits and only
+// switches to floating point when a float is involved.
+typedef struct {
+    bool is_float;
+    int64_t i;
+    mp_float_t f;
+} arrayops_value_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_ARRAYOPS___INIT___H
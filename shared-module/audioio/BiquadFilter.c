@@ -0,0 +1,216 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "shared-bindings/audioio/BiquadFilter.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include "py/runtime.h"
+
+// M_PI is not part of the math.h standard and may not be defined.
+#define MP_PI MICROPY_FLOAT_CONST(3.14159265358979323846)
+
+void common_hal_audioio_biquadfilter_construct(audioio_biquadfilter_obj_t* self,
+                                               mp_obj_t sample,
+                                               audioio_biquadfilter_mode_t mode,
+                                               mp_float_t frequency,
+                                               mp_float_t q,
+                                               mp_float_t gain,
+                                               uint32_t buffer_size) {
+    audiosample_effect_construct(&self->effect, sample, buffer_size);
+    common_hal_audioio_biquadfilter_configure(self, mode, frequency, q, gain);
+    audioio_biquadfilter_reset_buffer(self, false, 0);
+}
+
+void common_hal_audioio_biquadfilter_deinit(audioio_biquadfilter_obj_t* self) {
+    audiosample_effect_deinit(&self->effect);
+}
+
+bool common_hal_audioio_biquadfilter_deinited(audioio_biquadfilter_obj_t* self) {
+    return self->effect.first_buffer == NULL;
+}
+
+static bool to_coefficient(mp_float_t value, int32_t* coefficient) {
+    mp_float_t scaled = value * (1 << BIQUAD_COEFFICIENT_BITS);
+    if (scaled >= (mp_float_t) INT32_MAX || scaled <= (mp_float_t) INT32_MIN) {
+        return false;
+    }
+    *coefficient = (int32_t) scaled;
+    return true;
+}
+
+// Works out the coefficients with the formulas from Robert Bristow-Johnson's Audio EQ Cookbook.
+void common_hal_audioio_biquadfilter_configure(audioio_biquadfilter_obj_t* self,
+                                               audioio_biquadfilter_mode_t mode,
+                                               mp_float_t frequency,
+                                               mp_float_t q,
+                                               mp_float_t gain) {
+    mp_float_t nyquist = self->effect.sample_rate / (mp_float_t) 2;
+    if (frequency <= 0 || frequency >= nyquist || q <= 0) {
+        mp_raise_ValueError(translate("Filter settings out of range"));
+    }
+    mp_float_t w0 = 2 * MP_PI * frequency / self->effect.sample_rate;
+    mp_float_t cos_w0 = MICROPY_FLOAT_C_FUN(cos)(w0);
+    mp_float_t alpha = MICROPY_FLOAT_C_FUN(sin)(w0) / (2 * q);
+    mp_float_t a = MICROPY_FLOAT_C_FUN(pow)(10, gain / 40);
+
+    mp_float_t b[3];
+    mp_float_t a0 = 1 + alpha;
+    mp_float_t a1 = -2 * cos_w0;
+    mp_float_t a2 = 1 - alpha;
+    switch (mode) {
+        case BIQUAD_LOWPASS:
+            b[0] = (1 - cos_w0) / 2;
+            b[1] = 1 - cos_w0;
+            b[2] = (1 - cos_w0) / 2;
+            break;
+        case BIQUAD_HIGHPASS:
+            b[0] = (1 + cos_w0) / 2;
+            b[1] = -(1 + cos_w0);
+            b[2] = (1 + cos_w0) / 2;
+            break;
+        case BIQUAD_BANDPASS:
+            b[0] = alpha;
+            b[1] = 0;
+            b[2] = -alpha;
+            break;
+        case BIQUAD_NOTCH:
+            b[0] = 1;
+            b[1] = -2 * cos_w0;
+            b[2] = 1;
+            break;
+        case BIQUAD_PEAKING:
+        default:
+            b[0] = 1 + alpha * a;
+            b[1] = -2 * cos_w0;
+            b[2] = 1 - alpha * a;
+            a0 = 1 + alpha / a;
+            a2 = 1 - alpha / a;
+            break;
+    }
+
+    int32_t coefficients[5];
+    if (!to_coefficient(b[0] / a0, &coefficients[0]) ||
+        !to_coefficient(b[1] / a0, &coefficients[1]) ||
+        !to_coefficient(b[2] / a0, &coefficients[2]) ||
+        !to_coefficient(a1 / a0, &coefficients[3]) ||
+        !to_coefficient(a2 / a0, &coefficients[4])) {
+        mp_raise_ValueError(translate("Filter settings out of range"));
+    }
+    self->mode = mode;
+    self->frequency = frequency;
+    self->q = q;
+    self->gain = gain;
+    self->b0 = coefficients[0];
+    self->b1 = coefficients[1];
+    self->b2 = coefficients[2];
+    self->a1 = coefficients[3];
+    self->a2 = coefficients[4];
+}
+
+mp_float_t common_hal_audioio_biquadfilter_get_frequency(audioio_biquadfilter_obj_t* self) {
+    return self->frequency;
+}
+
+mp_float_t common_hal_audioio_biquadfilter_get_q(audioio_biquadfilter_obj_t* self) {
+    return self->q;
+}
+
+mp_float_t common_hal_audioio_biquadfilter_get_gain(audioio_biquadfilter_obj_t* self) {
+    return self->gain;
+}
+
+uint32_t common_hal_audioio_biquadfilter_get_sample_rate(audioio_biquadfilter_obj_t* self) {
+    return self->effect.sample_rate;
+}
+
+void audioio_biquadfilter_reset_buffer(audioio_biquadfilter_obj_t* self,
+                                       bool single_channel,
+                                       uint8_t channel) {
+    audiosample_effect_reset_buffer(&self->effect, single_channel, channel);
+    for (uint8_t c = 0; c < 2; c++) {
+        self->x1[c] = 0;
+        self->x2[c] = 0;
+        self->y1[c] = 0;
+        self->y2[c] = 0;
+    }
+}
+
+// Direct form I keeps the history at sample precision so it can't overflow inside the filter.
+static void biquadfilter_process(mp_obj_t self_in, uint16_t* output, const uint16_t* input,
+                                 uint32_t frame_count, uint16_t sign_flip) {
+    audioio_biquadfilter_obj_t* self = MP_OBJ_TO_PTR(self_in);
+    uint8_t channel_count = self->effect.channel_count;
+    int32_t b0 = self->b0;
+    int32_t b1 = self->b1;
+    int32_t b2 = self->b2;
+    int32_t a1 = self->a1;
+    int32_t a2 = self->a2;
+    for (uint8_t c = 0; c < channel_count; c++) {
+        int32_t x1 = self->x1[c];
+        int32_t x2 = self->x2[c];
+        int32_t y1 = self->y1[c];
+        int32_t y2 = self->y2[c];
+        for (uint32_t i = c; i < frame_count * channel_count; i += channel_count) {
+            int32_t x = (int16_t) (input[i] ^ sign_flip);
+            int64_t sum = (int64_t) b0 * x + (int64_t) b1 * x1 + (int64_t) b2 * x2 -
+                          (int64_t) a1 * y1 - (int64_t) a2 * y2;
+            int32_t y = sum >> BIQUAD_COEFFICIENT_BITS;
+            if (y > INT16_MAX) {
+                y = INT16_MAX;
+            } else if (y < INT16_MIN) {
+                y = INT16_MIN;
+            }
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            output[i] = ((uint16_t) y) ^ sign_flip;
+        }
+        self->x1[c] = x1;
+        self->x2[c] = x2;
+        self->y1[c] = y1;
+        self->y2[c] = y2;
+    }
+}
+
+audioio_get_buffer_result_t audioio_biquadfilter_get_buffer(audioio_biquadfilter_obj_t* self,
+                                                            bool single_channel,
+                                                            uint8_t channel,
+                                                            uint8_t** buffer,
+                                                            uint32_t* buffer_length) {
+    return audiosample_effect_get_buffer(&self->effect, single_channel, channel, buffer,
+                                         buffer_length, biquadfilter_process, MP_OBJ_FROM_PTR(self));
+}
+
+void audioio_biquadfilter_get_buffer_structure(audioio_biquadfilter_obj_t* self, bool single_channel,
+                                               bool* single_buffer, bool* samples_signed,
+                                               uint32_t* max_buffer_length, uint8_t* spacing) {
+    audiosample_effect_get_buffer_structure(&self->effect, single_channel, single_buffer,
+                                            samples_signed, max_buffer_length, spacing);
+}
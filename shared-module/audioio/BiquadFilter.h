@@ -0,0 +1,79 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOIO_BIQUADFILTER_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOIO_BIQUADFILTER_H
+
+#include "py/obj.h"
+
+#include "shared-module/audioio/__init__.h"
+
+typedef enum {
+    BIQUAD_LOWPASS,
+    BIQUAD_HIGHPASS,
+    BIQUAD_BANDPASS,
+    BIQUAD_NOTCH,
+    BIQUAD_PEAKING,
+} audioio_biquadfilter_mode_t;
+
+// Coefficients are Q28 so that they can be up to +/-8.
+#define BIQUAD_COEFFICIENT_BITS (28)
+
+typedef struct {
+    mp_obj_base_t base;
+    audiosample_effect_t effect;
+    audioio_biquadfilter_mode_t mode;
+    mp_float_t frequency;
+    mp_float_t q;
+    mp_float_t gain;
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+    // The last two inputs and outputs of each channel.
+    int32_t x1[2];
+    int32_t x2[2];
+    int32_t y1[2];
+    int32_t y2[2];
+} audioio_biquadfilter_obj_t;
+
+
+// These are not available from Python because it may be called in an interrupt.
+void audioio_biquadfilter_reset_buffer(audioio_biquadfilter_obj_t* self,
+                                       bool single_channel,
+                                       uint8_t channel);
+audioio_get_buffer_result_t audioio_biquadfilter_get_buffer(audioio_biquadfilter_obj_t* self,
+                                                            bool single_channel,
+                                                            uint8_t channel,
+                                                            uint8_t** buffer,
+                                                            uint32_t* buffer_length); // length in bytes
+void audioio_biquadfilter_get_buffer_structure(audioio_biquadfilter_obj_t* self, bool single_channel,
+                                               bool* single_buffer, bool* samples_signed,
+                                               uint32_t* max_buffer_length, uint8_t* spacing);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_AUDIOIO_BIQUADFILTER_H
@@ -0,0 +1,146 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "shared-bindings/audioio/Echo.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+
+// In samples, rounded to whole frames of at least one.
+static uint32_t delay_length(audioio_echo_obj_t* self, mp_float_t seconds) {
+    uint32_t frames = (uint32_t) (seconds * self->effect.sample_rate);
+    return MAX(frames, 1) * self->effect.channel_count;
+}
+
+void common_hal_audioio_echo_construct(audioio_echo_obj_t* self,
+                                       mp_obj_t sample,
+                                       mp_float_t max_delay,
+                                       mp_float_t delay,
+                                       mp_float_t decay,
+                                       uint32_t buffer_size) {
+    audiosample_effect_construct(&self->effect, sample, buffer_size);
+    self->max_delay_length = delay_length(self, max_delay);
+    self->delay_line = m_malloc(self->max_delay_length * sizeof(int16_t), false);
+    if (self->delay_line == NULL) {
+        common_hal_audioio_echo_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate delay line"));
+    }
+    self->position = 0;
+    common_hal_audioio_echo_set_delay(self, delay);
+    common_hal_audioio_echo_set_decay(self, decay);
+    audioio_echo_reset_buffer(self, false, 0);
+}
+
+void common_hal_audioio_echo_deinit(audioio_echo_obj_t* self) {
+    audiosample_effect_deinit(&self->effect);
+    self->delay_line = NULL;
+}
+
+bool common_hal_audioio_echo_deinited(audioio_echo_obj_t* self) {
+    return self->effect.first_buffer == NULL;
+}
+
+void common_hal_audioio_echo_set_delay(audioio_echo_obj_t* self, mp_float_t delay) {
+    uint32_t length = delay_length(self, delay);
+    if (length > self->max_delay_length) {
+        mp_raise_ValueError(translate("delay must not be more than max_delay"));
+    }
+    self->delay_length = length;
+    if (self->position >= length) {
+        self->position = 0;
+    }
+}
+
+mp_float_t common_hal_audioio_echo_get_delay(audioio_echo_obj_t* self) {
+    return (mp_float_t) (self->delay_length / self->effect.channel_count) /
+           self->effect.sample_rate;
+}
+
+void common_hal_audioio_echo_set_decay(audioio_echo_obj_t* self, mp_float_t decay) {
+    self->decay = (uint16_t) (decay * 0x8000);
+}
+
+mp_float_t common_hal_audioio_echo_get_decay(audioio_echo_obj_t* self) {
+    return self->decay / (mp_float_t) 0x8000;
+}
+
+uint32_t common_hal_audioio_echo_get_sample_rate(audioio_echo_obj_t* self) {
+    return self->effect.sample_rate;
+}
+
+void audioio_echo_reset_buffer(audioio_echo_obj_t* self,
+                               bool single_channel,
+                               uint8_t channel) {
+    audiosample_effect_reset_buffer(&self->effect, single_channel, channel);
+    memset(self->delay_line, 0, self->max_delay_length * sizeof(int16_t));
+    self->position = 0;
+}
+
+// Feeds the output back into the delay line so that each echo repeats quieter than the last.
+static void echo_process(mp_obj_t self_in, uint16_t* output, const uint16_t* input,
+                         uint32_t frame_count, uint16_t sign_flip) {
+    audioio_echo_obj_t* self = MP_OBJ_TO_PTR(self_in);
+    int16_t* delay_line = self->delay_line;
+    uint32_t length = self->delay_length;
+    uint32_t position = self->position;
+    int32_t decay = self->decay;
+    uint32_t count = frame_count * self->effect.channel_count;
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t sample = (int16_t) (input[i] ^ sign_flip);
+        sample += (delay_line[position] * decay) >> 15;
+        if (sample > INT16_MAX) {
+            sample = INT16_MAX;
+        } else if (sample < INT16_MIN) {
+            sample = INT16_MIN;
+        }
+        delay_line[position] = sample;
+        position++;
+        if (position == length) {
+            position = 0;
+        }
+        output[i] = ((uint16_t) sample) ^ sign_flip;
+    }
+    self->position = position;
+}
+
+audioio_get_buffer_result_t audioio_echo_get_buffer(audioio_echo_obj_t* self,
+                                                    bool single_channel,
+                                                    uint8_t channel,
+                                                    uint8_t** buffer,
+                                                    uint32_t* buffer_length) {
+    return audiosample_effect_get_buffer(&self->effect, single_channel, channel, buffer,
+                                         buffer_length, echo_process, MP_OBJ_FROM_PTR(self));
+}
+
+void audioio_echo_get_buffer_structure(audioio_echo_obj_t* self, bool single_channel,
+                                       bool* single_buffer, bool* samples_signed,
+                                       uint32_t* max_buffer_length, uint8_t* spacing) {
+    audiosample_effect_get_buffer_structure(&self->effect, single_channel, single_buffer,
+                                            samples_signed, max_buffer_length, spacing);
+}
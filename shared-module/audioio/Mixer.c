@@ -27,6 +27,7 @@
 #include "shared-bindings/audioio/Mixer.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "py/runtime.h"
 #include "shared-module/audioio/__init__.h"
@@ -53,6 +54,8 @@ void common_hal_audioio_mixer_construct(audioio_mixer_obj_t* self,
         mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate second buffer"));
     }
 
+    self->resample_buffer = NULL;
+
     self->bits_per_sample = bits_per_sample;
     self->samples_signed = samples_signed;
     self->channel_count = channel_count;
@@ -61,12 +64,18 @@ void common_hal_audioio_mixer_construct(audioio_mixer_obj_t* self,
 
     for (uint8_t i = 0; i < self->voice_count; i++) {
         self->voice[i].sample = NULL;
+        self->voice[i].level = 0x8000;
+        self->voice[i].pan = 0;
+        self->voice[i].gain = 0x7fff7fff;
+        self->voice[i].unity_gain = true;
+        self->voice[i].resample = false;
     }
 }
 
 void common_hal_audioio_mixer_deinit(audioio_mixer_obj_t* self) {
     self->first_buffer = NULL;
     self->second_buffer = NULL;
+    self->resample_buffer = NULL;
 }
 
 bool common_hal_audioio_mixer_deinited(audioio_mixer_obj_t* self) {
@@ -81,9 +90,6 @@ void common_hal_audioio_mixer_play(audioio_mixer_obj_t* self, mp_obj_t sample, u
     if (v >= self->voice_count) {
         mp_raise_ValueError(translate("Voice index too high"));
     }
-    if (audiosample_sample_rate(sample) != self->sample_rate) {
-        mp_raise_ValueError(translate("The sample's sample rate does not match the mixer's"));
-    }
     if (audiosample_channel_count(sample) != self->channel_count) {
         mp_raise_ValueError(translate("The sample's channel count does not match the mixer's"));
     }
@@ -100,20 +106,70 @@ void common_hal_audioio_mixer_play(audioio_mixer_obj_t* self, mp_obj_t sample, u
         mp_raise_ValueError(translate("The sample's signedness does not match the mixer's"));
     }
     audioio_mixer_voice_t* voice = &self->voice[v];
-    voice->sample = sample;
+    uint32_t sample_rate = audiosample_sample_rate(sample);
+    bool resample = sample_rate != self->sample_rate;
+    if (resample && self->resample_buffer == NULL) {
+        self->resample_buffer = m_malloc(self->len, false);
+        if (self->resample_buffer == NULL) {
+            mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate resample buffer"));
+        }
+    }
+    // Stop the voice while it's set up so that it isn't mixed half way through.
+    voice->sample = NULL;
     voice->loop = loop;
+    voice->resample = resample;
+    if (resample) {
+        audiosample_resampler_init(&voice->resampler, sample_rate, self->sample_rate,
+                                   self->bits_per_sample, self->samples_signed,
+                                   self->channel_count);
+    }
 
     audiosample_reset_buffer(sample, false, 0);
     audioio_get_buffer_result_t result = audiosample_get_buffer(sample, false, 0, (uint8_t**) &voice->remaining_buffer, &voice->buffer_length);
     // Track length in terms of words.
     voice->buffer_length /= sizeof(uint32_t);
     voice->more_data = result == GET_BUFFER_MORE_DATA;
+    voice->sample = sample;
 }
 
 void common_hal_audioio_mixer_stop_voice(audioio_mixer_obj_t* self, uint8_t voice) {
     self->voice[voice].sample = NULL;
 }
 
+// Works out the per channel gains from the voice's level and pan. Panning only ever turns the far
+// channel down so that a centered voice plays at its full level.
+static void update_gain(audioio_mixer_obj_t* self, audioio_mixer_voice_t* voice) {
+    uint32_t left = voice->level;
+    uint32_t right = voice->level;
+    if (self->channel_count == 2) {
+        if (voice->pan > 0) {
+            left = left * (0x8000 - voice->pan) >> 15;
+        } else {
+            right = right * (0x8000 + voice->pan) >> 15;
+        }
+    }
+    voice->unity_gain = left == 0x8000 && right == 0x8000;
+    voice->gain = MIN(right, 0x7fff) << 16 | MIN(left, 0x7fff);
+}
+
+void common_hal_audioio_mixer_set_level(audioio_mixer_obj_t* self, uint8_t v, mp_float_t level) {
+    if (v >= self->voice_count) {
+        mp_raise_ValueError(translate("Voice index too high"));
+    }
+    audioio_mixer_voice_t* voice = &self->voice[v];
+    voice->level = (uint16_t) (level * 0x8000);
+    update_gain(self, voice);
+}
+
+void common_hal_audioio_mixer_set_pan(audioio_mixer_obj_t* self, uint8_t v, mp_float_t pan) {
+    if (v >= self->voice_count) {
+        mp_raise_ValueError(translate("Voice index too high"));
+    }
+    audioio_mixer_voice_t* voice = &self->voice[v];
+    voice->pan = (int16_t) (pan * 0x7fff);
+    update_gain(self, voice);
+}
+
 bool common_hal_audioio_mixer_get_playing(audioio_mixer_obj_t* self) {
     for (int32_t v = 0; v < self->voice_count; v++) {
         if (self->voice[v].sample != NULL) {
@@ -131,7 +187,9 @@ void audioio_mixer_reset_buffer(audioio_mixer_obj_t* self,
     }
 }
 
-uint32_t add8signed(uint32_t a, uint32_t b) {
+// Saturating adds of the two or four samples packed into a word. Cortex-M4 and up add every sample
+// of the word in one DSP instruction. Others, like the SAMD21, add them one at a time.
+static inline uint32_t add8signed(uint32_t a, uint32_t b) {
     #if (defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
     return __QADD8(a, b);
     #else
@@ -140,10 +198,10 @@ uint32_t add8signed(uint32_t a, uint32_t b) {
         int8_t ai = a >> (sizeof(int8_t) * 8 * i);
         int8_t bi = b >> (sizeof(int8_t) * 8 * i);
         int32_t intermediate = (int32_t) ai + bi;
-        if (intermediate > CHAR_MAX) {
-            intermediate = CHAR_MAX;
-        } else if (intermediate < CHAR_MIN) {
-            //intermediate = CHAR_MIN;
+        if (intermediate > SCHAR_MAX) {
+            intermediate = SCHAR_MAX;
+        } else if (intermediate < SCHAR_MIN) {
+            intermediate = SCHAR_MIN;
         }
         result |= (((uint32_t) intermediate) & 0xff) << (sizeof(int8_t) * 8 * i);
     }
@@ -151,7 +209,7 @@ uint32_t add8signed(uint32_t a, uint32_t b) {
     #endif
 }
 
-uint32_t add8unsigned(uint32_t a, uint32_t b) {
+static inline uint32_t add8unsigned(uint32_t a, uint32_t b) {
     #if (defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
     // Subtract out the DC offset, add and then shift back.
     a = __USUB8(a, 0x80808080);
@@ -161,19 +219,21 @@ uint32_t add8unsigned(uint32_t a, uint32_t b) {
     #else
     uint32_t result = 0;
     for (int8_t i = 0; i < 4; i++) {
-        int8_t ai = (a >> (sizeof(uint8_t) * 8 * i)) - 128;
-        int8_t bi = (b >> (sizeof(uint8_t) * 8 * i)) - 128;
-        int32_t intermediate = (int32_t) ai + bi;
-        if (intermediate > UCHAR_MAX) {
-            intermediate = UCHAR_MAX;
+        int32_t ai = (int32_t) ((a >> (sizeof(uint8_t) * 8 * i)) & 0xff) - 0x80;
+        int32_t bi = (int32_t) ((b >> (sizeof(uint8_t) * 8 * i)) & 0xff) - 0x80;
+        int32_t intermediate = ai + bi;
+        if (intermediate > SCHAR_MAX) {
+            intermediate = SCHAR_MAX;
+        } else if (intermediate < SCHAR_MIN) {
+            intermediate = SCHAR_MIN;
         }
-        result |= ((uint8_t) intermediate + 128) << (sizeof(uint8_t) * 8 * i);
+        result |= ((uint32_t) (intermediate + 0x80)) << (sizeof(uint8_t) * 8 * i);
     }
     return result;
     #endif
 }
 
-uint32_t add16signed(uint32_t a, uint32_t b) {
+static inline uint32_t add16signed(uint32_t a, uint32_t b) {
     #if (defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
     return __QADD16(a, b);
     #else
@@ -193,7 +253,7 @@ uint32_t add16signed(uint32_t a, uint32_t b) {
     #endif
 }
 
-uint32_t add16unsigned(uint32_t a, uint32_t b) {
+static inline uint32_t add16unsigned(uint32_t a, uint32_t b) {
     #if (defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
     // Subtract out the DC offset, add and then shift back.
     a = __USUB16(a, 0x80008000);
@@ -203,23 +263,123 @@ uint32_t add16unsigned(uint32_t a, uint32_t b) {
     #else
     uint32_t result = 0;
     for (int8_t i = 0; i < 2; i++) {
-        int16_t ai = (a >> (sizeof(uint16_t) * 8 * i)) - 0x8000;
-        int16_t bi = (b >> (sizeof(uint16_t) * 8 * i)) - 0x8000;
-        int32_t intermediate = (int32_t) ai + bi;
-        if (intermediate > USHRT_MAX) {
-            intermediate = USHRT_MAX;
+        int32_t ai = (int32_t) ((a >> (sizeof(uint16_t) * 8 * i)) & 0xffff) - 0x8000;
+        int32_t bi = (int32_t) ((b >> (sizeof(uint16_t) * 8 * i)) & 0xffff) - 0x8000;
+        int32_t intermediate = ai + bi;
+        if (intermediate > SHRT_MAX) {
+            intermediate = SHRT_MAX;
+        } else if (intermediate < SHRT_MIN) {
+            intermediate = SHRT_MIN;
         }
-        result |= ((uint16_t) intermediate + 0x8000) << (sizeof(int16_t) * 8 * i);
+        result |= ((uint32_t) (intermediate + 0x8000)) << (sizeof(uint16_t) * 8 * i);
+    }
+    return result;
+    #endif
+}
+
+// Scales the samples packed into a word by the voice's Q15 gain. Byte and halfword i belong to
+// channel i % 2 so the matching half of the gain is used for each. Cortex-M4 and up scale both
+// halfwords of 16 bit samples with two DSP multiplies.
+static inline uint32_t scale8signed(uint32_t sample, uint32_t gain) {
+    uint32_t result = 0;
+    for (int8_t i = 0; i < 4; i++) {
+        int8_t si = sample >> (sizeof(int8_t) * 8 * i);
+        int32_t gi = (gain >> (sizeof(int16_t) * 8 * (i % 2))) & 0xffff;
+        int32_t scaled = (si * gi) >> 15;
+        result |= (((uint32_t) scaled) & 0xff) << (sizeof(int8_t) * 8 * i);
+    }
+    return result;
+}
+
+static inline uint32_t scale16signed(uint32_t sample, uint32_t gain) {
+    #if (defined (__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+    // Masking off the other half of the gain turns the dual multiply into a single one.
+    int32_t left = ((int32_t) __SMUAD(sample, gain & 0xffff)) >> 15;
+    int32_t right = ((int32_t) __SMUAD(sample, gain & 0xffff0000)) >> 15;
+    return __PKHBT((uint32_t) left, (uint32_t) right, 16);
+    #else
+    uint32_t result = 0;
+    for (int8_t i = 0; i < 2; i++) {
+        int16_t si = sample >> (sizeof(int16_t) * 8 * i);
+        int32_t gi = (gain >> (sizeof(int16_t) * 8 * i)) & 0xffff;
+        int32_t scaled = (si * gi) >> 15;
+        result |= (((uint32_t) scaled) & 0xffff) << (sizeof(int16_t) * 8 * i);
     }
     return result;
     #endif
 }
 
-audioio_get_buffer_result_t audioio_mixer_get_buffer(audioio_mixer_obj_t* self,
-                                                     bool single_channel,
-                                                     uint8_t channel,
-                                                     uint8_t** buffer,
-                                                     uint32_t* buffer_length) {
+// Flipping the top bit of each unsigned sample converts it to signed and back.
+static inline uint32_t scale8unsigned(uint32_t sample, uint32_t gain) {
+    return scale8signed(sample ^ 0x80808080, gain) ^ 0x80808080;
+}
+
+static inline uint32_t scale16unsigned(uint32_t sample, uint32_t gain) {
+    return scale16signed(sample ^ 0x80008000, gain) ^ 0x80008000;
+}
+
+// Kernels for one sample format. copy_scaled starts the mix from a voice that isn't at full
+// volume, mix adds in a voice at full volume and mix_scaled adds in one that isn't. A voice at
+// full volume starts the mix with a plain memcpy.
+typedef struct {
+    void (*copy_scaled)(uint32_t* mix, const uint32_t* samples, uint32_t count, uint32_t gain);
+    void (*mix)(uint32_t* mix, const uint32_t* samples, uint32_t count, uint32_t gain);
+    void (*mix_scaled)(uint32_t* mix, const uint32_t* samples, uint32_t count, uint32_t gain);
+} mixer_kernels_t;
+
+#define MIXER_KERNELS(format) \
+    static void copy_scaled_##format(uint32_t* mix, const uint32_t* samples, uint32_t count, uint32_t gain) { \
+        for (uint32_t i = 0; i < count; i++) { \
+            mix[i] = scale##format(samples[i], gain); \
+        } \
+    } \
+    static void mix_##format(uint32_t* mix, const uint32_t* samples, uint32_t count, uint32_t gain) { \
+        for (uint32_t i = 0; i < count; i++) { \
+            mix[i] = add##format(mix[i], samples[i]); \
+        } \
+    } \
+    static void mix_scaled_##format(uint32_t* mix, const uint32_t* samples, uint32_t count, uint32_t gain) { \
+        for (uint32_t i = 0; i < count; i++) { \
+            mix[i] = add##format(mix[i], scale##format(samples[i], gain)); \
+        } \
+    }
+
+MIXER_KERNELS(8signed)
+MIXER_KERNELS(8unsigned)
+MIXER_KERNELS(16signed)
+MIXER_KERNELS(16unsigned)
+
+#define MIXER_KERNEL_ENTRY(format) { copy_scaled_##format, mix_##format, mix_scaled_##format }
+
+// Indexed by mixer_kernel_index().
+static const mixer_kernels_t mixer_kernels[] = {
+    MIXER_KERNEL_ENTRY(8signed),
+    MIXER_KERNEL_ENTRY(8unsigned),
+    MIXER_KERNEL_ENTRY(16signed),
+    MIXER_KERNEL_ENTRY(16unsigned),
+};
+
+static inline size_t mixer_kernel_index(audioio_mixer_obj_t* self) {
+    return (self->bits_per_sample == 16 ? 2 : 0) + (self->samples_signed ? 0 : 1);
+}
+
+static void fill_silence(audioio_mixer_obj_t* self, uint32_t* mix, uint32_t count) {
+    if (self->samples_signed) {
+        memset(mix, 0, count * sizeof(uint32_t));
+    } else if (self->bits_per_sample == 8) {
+        memset(mix, 0x7f, count * sizeof(uint32_t));
+    } else {
+        for (uint32_t i = 0; i < count; i++) {
+            mix[i] = 0x7fff7fff;
+        }
+    }
+}
+
+MP_RAMFUNC audioio_get_buffer_result_t audioio_mixer_get_buffer(audioio_mixer_obj_t* self,
+                                                                bool single_channel,
+                                                                uint8_t channel,
+                                                                uint8_t** buffer,
+                                                                uint32_t* buffer_length) {
     if (!single_channel) {
         channel = 0;
     }
@@ -241,73 +401,77 @@ audioio_get_buffer_result_t audioio_mixer_get_buffer(audioio_mixer_obj_t* self,
             word_buffer = self->second_buffer;
         }
         self->use_first_buffer = !self->use_first_buffer;
+        uint32_t word_count = self->len / sizeof(uint32_t);
+        // The sample format is fixed so the kernels are picked once per buffer. Each voice is then
+        // mixed a run at a time up to the end of its current sample buffer.
+        const mixer_kernels_t* kernels = &mixer_kernels[mixer_kernel_index(self)];
         bool voices_active = false;
         for (int32_t v = 0; v < self->voice_count; v++) {
             audioio_mixer_voice_t* voice = &self->voice[v];
+            if (voice->sample == NULL) {
+                continue;
+            }
 
-            uint32_t j = 0;
-            bool voice_done = voice->sample == NULL;
-            for (uint32_t i = 0; i < self->len / sizeof(uint32_t); i++) {
-                if (!voice_done && j >= voice->buffer_length) {
+            uint32_t i = 0;
+            while (i < word_count && voice->sample != NULL) {
+                if (voice->buffer_length == 0) {
                     if (!voice->more_data) {
                         if (voice->loop) {
                             audiosample_reset_buffer(voice->sample, false, 0);
                         } else {
                             voice->sample = NULL;
-                            voice_done = true;
+                            break;
                         }
                     }
-                    if (!voice_done) {
-                        // Load another buffer
-                        audioio_get_buffer_result_t result = audiosample_get_buffer(voice->sample, false, 0, (uint8_t**) &voice->remaining_buffer, &voice->buffer_length);
-                        // Track length in terms of words.
-                        voice->buffer_length /= sizeof(uint32_t);
-                        voice->more_data = result == GET_BUFFER_MORE_DATA;
-                        j = 0;
+                    // Load another buffer
+                    audioio_get_buffer_result_t result = audiosample_get_buffer(voice->sample, false, 0, (uint8_t**) &voice->remaining_buffer, &voice->buffer_length);
+                    // Track length in terms of words.
+                    voice->buffer_length /= sizeof(uint32_t);
+                    voice->more_data = result == GET_BUFFER_MORE_DATA;
+                    if (voice->buffer_length == 0) {
+                        // Nothing to play right now. Try again next buffer.
+                        break;
                     }
                 }
-                // First active voice gets copied over verbatim.
-                uint32_t sample_value;
-                if (voice_done) {
-                    // Exit early if another voice already set all samples once.
-                    if (voices_active) {
-                        continue;
-                    }
-                    sample_value = 0;
-                    if (!self->samples_signed) {
-                        if (self->bits_per_sample == 8) {
-                            sample_value = 0x7f7f7f7f;
-                        } else {
-                            sample_value = 0x7fff7fff;
-                        }
-                    }
+                uint32_t count;
+                const uint32_t* samples;
+                if (voice->resample) {
+                    // Resampling uses up the voice's buffer as it goes. It may run out of input
+                    // before filling any output, in which case the next pass loads more.
+                    samples = self->resample_buffer;
+                    count = audiosample_resample(&voice->resampler, &voice->remaining_buffer,
+                                                 &voice->buffer_length, self->resample_buffer,
+                                                 word_count - i);
                 } else {
-                    sample_value = voice->remaining_buffer[j];
+                    samples = voice->remaining_buffer;
+                    count = MIN(word_count - i, voice->buffer_length);
+                    voice->buffer_length -= count;
+                    voice->remaining_buffer += count;
                 }
-
+                // The first voice that plays starts the mix and the rest are added into it.
                 if (!voices_active) {
-                    word_buffer[i] = sample_value;
-                } else {
-                    if (self->bits_per_sample == 8) {
-                        if (self->samples_signed) {
-                            word_buffer[i] = add8signed(word_buffer[i], sample_value);
-                        } else {
-                            word_buffer[i] = add8unsigned(word_buffer[i], sample_value);
-                        }
+                    if (voice->unity_gain) {
+                        memcpy(word_buffer + i, samples, count * sizeof(uint32_t));
                     } else {
-                        if (self->samples_signed) {
-                            word_buffer[i] = add16signed(word_buffer[i], sample_value);
-                        } else {
-                            word_buffer[i] = add16unsigned(word_buffer[i], sample_value);
-                        }
+                        kernels->copy_scaled(word_buffer + i, samples, count, voice->gain);
                     }
+                } else if (voice->unity_gain) {
+                    kernels->mix(word_buffer + i, samples, count, voice->gain);
+                } else {
+                    kernels->mix_scaled(word_buffer + i, samples, count, voice->gain);
                 }
-                j++;
+                i += count;
             }
-            voice->buffer_length -= j;
-            voice->remaining_buffer += j;
 
-            voices_active = true;
+            // The voice that started the mix pads whatever it didn't play with silence so that
+            // later voices always have something to mix into.
+            if (!voices_active) {
+                fill_silence(self, word_buffer + i, word_count - i);
+                voices_active = true;
+            }
+        }
+        if (!voices_active) {
+            fill_silence(self, word_buffer, word_count);
         }
 
         self->read_count += 1;
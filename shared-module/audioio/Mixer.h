@@ -37,12 +37,23 @@ typedef struct {
     bool more_data;
     uint32_t* remaining_buffer;
     uint32_t buffer_length;
+    uint16_t level; // Q15, 0x8000 is full volume
+    int16_t pan; // Q15, -0x7fff is all left and 0x7fff is all right
+    // Right gain in the top half and left gain in the bottom, each Q15 capped at 0x7fff. Mono
+    // mixers use the left gain for both halves.
+    uint32_t gain;
+    bool unity_gain;
+    // Samples at a different rate than the mixer are resampled into the mixer's resample_buffer
+    // before being mixed.
+    bool resample;
+    audiosample_resampler_t resampler;
 } audioio_mixer_voice_t;
 
 typedef struct {
     mp_obj_base_t base;
     uint32_t* first_buffer;
     uint32_t* second_buffer;
+    uint32_t* resample_buffer; // Allocated the first time a voice needs resampling.
     uint32_t len; // in words
     uint8_t bits_per_sample;
     bool use_first_buffer;
@@ -0,0 +1,286 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "shared-bindings/audioio/Synthesizer.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+
+// M_PI is not part of the math.h standard and may not be defined.
+#define MP_PI MICROPY_FLOAT_CONST(3.14159265358979323846)
+
+void common_hal_audioio_synthesizer_construct(audioio_synthesizer_obj_t* self,
+                                              uint8_t voice_count,
+                                              uint32_t buffer_size,
+                                              uint32_t sample_rate,
+                                              mp_obj_t waveform_obj,
+                                              const int16_t* waveform,
+                                              uint32_t waveform_length) {
+    self->len = buffer_size / 2 / sizeof(uint32_t) * sizeof(uint32_t);
+
+    self->first_buffer = m_malloc(self->len, false);
+    if (self->first_buffer == NULL) {
+        common_hal_audioio_synthesizer_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate first buffer"));
+    }
+
+    self->second_buffer = m_malloc(self->len, false);
+    if (self->second_buffer == NULL) {
+        common_hal_audioio_synthesizer_deinit(self);
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate second buffer"));
+    }
+
+    self->sample_rate = sample_rate;
+    self->use_first_buffer = true;
+    self->read_count = 0;
+    self->left_read_count = 0;
+    self->right_read_count = 0;
+
+    for (uint32_t i = 0; i < SYNTHESIZER_SINE_LENGTH; i++) {
+        mp_float_t angle = 2 * MP_PI * i / SYNTHESIZER_SINE_LENGTH;
+        self->sine[i] = (int16_t) (MICROPY_FLOAT_C_FUN(sin)(angle) * 0x7fff);
+    }
+    self->waveform_obj = waveform_obj;
+    if (waveform == NULL) {
+        self->waveform = self->sine;
+        self->waveform_length = SYNTHESIZER_SINE_LENGTH;
+    } else {
+        self->waveform = waveform;
+        self->waveform_length = waveform_length;
+    }
+
+    self->voice_count = voice_count;
+    for (uint8_t i = 0; i < self->voice_count; i++) {
+        self->voice[i].stage = SYNTHESIZER_OFF;
+        self->voice[i].envelope = 0;
+        self->voice[i].phase = 0;
+        self->voice[i].phase_step = 0;
+        self->voice[i].level = 0x8000;
+    }
+    // Short enough to sound immediate and long enough not to click.
+    common_hal_audioio_synthesizer_set_envelope(self, 0.005f, 0.0f, 1.0f, 0.005f);
+}
+
+void common_hal_audioio_synthesizer_deinit(audioio_synthesizer_obj_t* self) {
+    self->first_buffer = NULL;
+    self->second_buffer = NULL;
+    self->waveform_obj = MP_OBJ_NULL;
+}
+
+bool common_hal_audioio_synthesizer_deinited(audioio_synthesizer_obj_t* self) {
+    return self->first_buffer == NULL;
+}
+
+uint32_t common_hal_audioio_synthesizer_get_sample_rate(audioio_synthesizer_obj_t* self) {
+    return self->sample_rate;
+}
+
+static audioio_synthesizer_voice_t* get_voice(audioio_synthesizer_obj_t* self, uint8_t v) {
+    if (v >= self->voice_count) {
+        mp_raise_ValueError(translate("Voice index too high"));
+    }
+    return &self->voice[v];
+}
+
+static uint32_t phase_step(audioio_synthesizer_obj_t* self, mp_float_t frequency) {
+    // Anything above half the sample rate would alias back down.
+    mp_float_t cycles_per_sample = MIN(frequency / self->sample_rate, (mp_float_t) 0.5);
+    return (uint32_t) (cycles_per_sample * (mp_float_t) 4294967296.0);
+}
+
+void common_hal_audioio_synthesizer_press(audioio_synthesizer_obj_t* self, uint8_t v,
+                                          mp_float_t frequency, mp_float_t level) {
+    audioio_synthesizer_voice_t* voice = get_voice(self, v);
+    voice->phase_step = phase_step(self, frequency);
+    voice->level = (uint16_t) (level * 0x8000);
+    // A voice that is still sounding attacks from where it is so that it doesn't click.
+    if (voice->stage == SYNTHESIZER_OFF) {
+        voice->phase = 0;
+        voice->envelope = 0;
+    }
+    voice->stage = SYNTHESIZER_ATTACK;
+}
+
+void common_hal_audioio_synthesizer_release(audioio_synthesizer_obj_t* self, uint8_t v) {
+    audioio_synthesizer_voice_t* voice = get_voice(self, v);
+    if (voice->stage != SYNTHESIZER_OFF) {
+        voice->stage = SYNTHESIZER_RELEASE;
+    }
+}
+
+void common_hal_audioio_synthesizer_set_frequency(audioio_synthesizer_obj_t* self, uint8_t v,
+                                                  mp_float_t frequency) {
+    get_voice(self, v)->phase_step = phase_step(self, frequency);
+}
+
+// The per sample step that covers range in the given number of seconds.
+static int32_t envelope_step(audioio_synthesizer_obj_t* self, mp_float_t seconds, int32_t range) {
+    mp_float_t samples = seconds * self->sample_rate;
+    if (samples < 1) {
+        return range;
+    }
+    return MAX(range / samples, 1);
+}
+
+void common_hal_audioio_synthesizer_set_envelope(audioio_synthesizer_obj_t* self,
+                                                 mp_float_t attack, mp_float_t decay,
+                                                 mp_float_t sustain, mp_float_t release) {
+    self->sustain_level = (int32_t) (sustain * SYNTHESIZER_ENVELOPE_MAX);
+    self->attack_step = envelope_step(self, attack, SYNTHESIZER_ENVELOPE_MAX);
+    self->decay_step = envelope_step(self, decay, SYNTHESIZER_ENVELOPE_MAX - self->sustain_level);
+    self->release_step = envelope_step(self, release, SYNTHESIZER_ENVELOPE_MAX);
+}
+
+bool common_hal_audioio_synthesizer_get_playing(audioio_synthesizer_obj_t* self) {
+    for (int32_t v = 0; v < self->voice_count; v++) {
+        if (self->voice[v].stage != SYNTHESIZER_OFF) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void audioio_synthesizer_reset_buffer(audioio_synthesizer_obj_t* self,
+                                      bool single_channel,
+                                      uint8_t channel) {
+    self->use_first_buffer = true;
+    self->read_count = 0;
+    self->left_read_count = 0;
+    self->right_read_count = 0;
+}
+
+// Moves the voice's envelope on by one sample. Returns false once the voice is silent.
+static inline bool step_envelope(audioio_synthesizer_obj_t* self,
+                                 audioio_synthesizer_voice_t* voice) {
+    switch (voice->stage) {
+        case SYNTHESIZER_ATTACK:
+            if (voice->envelope < SYNTHESIZER_ENVELOPE_MAX - self->attack_step) {
+                voice->envelope += self->attack_step;
+            } else {
+                voice->envelope = SYNTHESIZER_ENVELOPE_MAX;
+                voice->stage = SYNTHESIZER_DECAY;
+            }
+            break;
+        case SYNTHESIZER_DECAY:
+            if (voice->envelope > self->sustain_level + self->decay_step) {
+                voice->envelope -= self->decay_step;
+            } else {
+                voice->envelope = self->sustain_level;
+                voice->stage = voice->envelope > 0 ? SYNTHESIZER_SUSTAIN : SYNTHESIZER_OFF;
+            }
+            break;
+        case SYNTHESIZER_RELEASE:
+            if (voice->envelope > self->release_step) {
+                voice->envelope -= self->release_step;
+            } else {
+                voice->envelope = 0;
+                voice->stage = SYNTHESIZER_OFF;
+            }
+            break;
+        default:
+            break;
+    }
+    return voice->stage != SYNTHESIZER_OFF;
+}
+
+// Adds the voice into the mix, saturating at full scale.
+static void render_voice(audioio_synthesizer_obj_t* self, audioio_synthesizer_voice_t* voice,
+                         int16_t* mix, uint32_t count) {
+    const int16_t* waveform = self->waveform;
+    uint32_t waveform_length = self->waveform_length;
+    for (uint32_t i = 0; i < count && step_envelope(self, voice); i++) {
+        // The waveform may be any length so scale the phase to it rather than masking.
+        uint32_t index = ((voice->phase >> 16) * waveform_length) >> 16;
+        voice->phase += voice->phase_step;
+        int32_t gain = ((voice->envelope >> 15) * voice->level) >> 15;
+        int32_t sample = mix[i] + ((waveform[index] * gain) >> 15);
+        if (sample > SHRT_MAX) {
+            sample = SHRT_MAX;
+        } else if (sample < SHRT_MIN) {
+            sample = SHRT_MIN;
+        }
+        mix[i] = sample;
+    }
+}
+
+audioio_get_buffer_result_t audioio_synthesizer_get_buffer(audioio_synthesizer_obj_t* self,
+                                                           bool single_channel,
+                                                           uint8_t channel,
+                                                           uint8_t** buffer,
+                                                           uint32_t* buffer_length) {
+    if (!single_channel) {
+        channel = 0;
+    }
+
+    uint32_t channel_read_count = self->left_read_count;
+    if (channel == 1) {
+        channel_read_count = self->right_read_count;
+    }
+    *buffer_length = self->len;
+
+    // Both outputs of a mono sample share each rendered buffer.
+    bool need_more_data = self->read_count == channel_read_count;
+    if (need_more_data) {
+        uint32_t* word_buffer = self->use_first_buffer ? self->first_buffer : self->second_buffer;
+        self->use_first_buffer = !self->use_first_buffer;
+        *buffer = (uint8_t*) word_buffer;
+        int16_t* mix = (int16_t*) word_buffer;
+        uint32_t count = self->len / sizeof(int16_t);
+        memset(mix, 0, self->len);
+        for (int32_t v = 0; v < self->voice_count; v++) {
+            audioio_synthesizer_voice_t* voice = &self->voice[v];
+            if (voice->stage != SYNTHESIZER_OFF) {
+                render_voice(self, voice, mix, count);
+            }
+        }
+        self->read_count += 1;
+    } else if (!self->use_first_buffer) {
+        *buffer = (uint8_t*) self->first_buffer;
+    } else {
+        *buffer = (uint8_t*) self->second_buffer;
+    }
+
+    if (channel == 0) {
+        self->left_read_count += 1;
+    } else if (channel == 1) {
+        self->right_read_count += 1;
+    }
+    return GET_BUFFER_MORE_DATA;
+}
+
+void audioio_synthesizer_get_buffer_structure(audioio_synthesizer_obj_t* self, bool single_channel,
+                                              bool* single_buffer, bool* samples_signed,
+                                              uint32_t* max_buffer_length, uint8_t* spacing) {
+    *single_buffer = false;
+    *samples_signed = true;
+    *max_buffer_length = self->len;
+    *spacing = 1;
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_AUDIOIO_SYNTHESIZER_H
+#define MICROPY_INCLUDED_SHARED_MODULE_AUDIOIO_SYNTHESIZER_H
+
+#include "py/obj.h"
+
+#include "shared-module/audioio/__init__.h"
+
+#define SYNTHESIZER_SINE_LENGTH (256)
+// Full scale of an envelope. Leaves room to add a step without overflowing.
+#define SYNTHESIZER_ENVELOPE_MAX (1 << 30)
+
+typedef enum {
+    SYNTHESIZER_OFF,
+    SYNTHESIZER_ATTACK,
+    SYNTHESIZER_DECAY,
+    SYNTHESIZER_SUSTAIN,
+    SYNTHESIZER_RELEASE,
+} audioio_synthesizer_stage_t;
+
+typedef struct {
+    uint32_t phase; // The top 16 bits are the position within the waveform's cycle.
+    uint32_t phase_step;
+    uint16_t level; // Q15, 0x8000 is full volume
+    audioio_synthesizer_stage_t stage;
+    int32_t envelope; // Up to SYNTHESIZER_ENVELOPE_MAX
+} audioio_synthesizer_voice_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    uint32_t* first_buffer;
+    uint32_t* second_buffer;
+    uint32_t len; // in bytes
+    bool use_first_buffer;
+    uint32_t sample_rate;
+
+    uint32_t read_count;
+    uint32_t left_read_count;
+    uint32_t right_read_count;
+
+    // One cycle of signed 16 bit samples. Kept alive by waveform_obj when it comes from Python.
+    const int16_t* waveform;
+    uint32_t waveform_length;
+    mp_obj_t waveform_obj;
+    int16_t sine[SYNTHESIZER_SINE_LENGTH];
+
+    // Per sample envelope changes. Release is timed from full scale.
+    int32_t attack_step;
+    int32_t decay_step;
+    int32_t sustain_level;
+    int32_t release_step;
+
+    uint8_t voice_count;
+    audioio_synthesizer_voice_t voice[];
+} audioio_synthesizer_obj_t;
+
+
+// These are not available from Python because it may be called in an interrupt.
+void audioio_synthesizer_reset_buffer(audioio_synthesizer_obj_t* self,
+                                      bool single_channel,
+                                      uint8_t channel);
+audioio_get_buffer_result_t audioio_synthesizer_get_buffer(audioio_synthesizer_obj_t* self,
+                                                           bool single_channel,
+                                                           uint8_t channel,
+                                                           uint8_t** buffer,
+                                                           uint32_t* buffer_length); // length in bytes
+void audioio_synthesizer_get_buffer_structure(audioio_synthesizer_obj_t* self, bool single_channel,
+                                              bool* single_buffer, bool* samples_signed,
+                                              uint32_t* max_buffer_length, uint8_t* spacing);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_AUDIOIO_SYNTHESIZER_H
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/audioio/VirtualOut.h"
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-module/audioio/__init__.h"
+
+void common_hal_audioio_virtualout_construct(audioio_virtualout_obj_t* self) {
+    self->sample = NULL;
+    self->remaining = NULL;
+    self->remaining_length = 0;
+    self->more_data = false;
+    self->loop = false;
+    self->playing = false;
+    self->deinited = false;
+}
+
+void common_hal_audioio_virtualout_deinit(audioio_virtualout_obj_t* self) {
+    common_hal_audioio_virtualout_stop(self);
+    self->deinited = true;
+}
+
+bool common_hal_audioio_virtualout_deinited(audioio_virtualout_obj_t* self) {
+    return self->deinited;
+}
+
+void common_hal_audioio_virtualout_play(audioio_virtualout_obj_t* self, mp_obj_t sample, bool loop) {
+    audiosample_reset_buffer(sample, false, 0);
+    self->sample = sample;
+    self->remaining = NULL;
+    self->remaining_length = 0;
+    self->more_data = true;
+    self->loop = loop;
+    self->playing = true;
+}
+
+void common_hal_audioio_virtualout_stop(audioio_virtualout_obj_t* self) {
+    self->sample = NULL;
+    self->remaining = NULL;
+    self->remaining_length = 0;
+    self->playing = false;
+}
+
+bool common_hal_audioio_virtualout_get_playing(audioio_virtualout_obj_t* self) {
+    return self->playing;
+}
+
+// Reads interleaved buffers from the sample just as a DMA driven output does, without converting
+// them, so only the sample's own work is measured.
+uint32_t common_hal_audioio_virtualout_readinto(audioio_virtualout_obj_t* self, uint8_t* buffer,
+                                                uint32_t length) {
+    uint32_t copied = 0;
+    while (self->playing && copied < length) {
+        if (self->remaining_length == 0) {
+            if (!self->more_data) {
+                if (!self->loop) {
+                    common_hal_audioio_virtualout_stop(self);
+                    break;
+                }
+                audiosample_reset_buffer(self->sample, false, 0);
+            }
+            // Devices let the sample read ahead from their background tasks between buffers.
+            audiosample_background(self->sample);
+            audioio_get_buffer_result_t result = audiosample_get_buffer(self->sample, false, 0,
+                                                                        &self->remaining,
+                                                                        &self->remaining_length);
+            self->more_data = result == GET_BUFFER_MORE_DATA;
+            // Stop rather than spin on a sample that errored or can't make any output.
+            if (result == GET_BUFFER_ERROR || (self->remaining_length == 0 && !self->more_data)) {
+                common_hal_audioio_virtualout_stop(self);
+                break;
+            }
+        }
+        uint32_t count = MIN(length - copied, self->remaining_length);
+        memcpy(buffer + copied, self->remaining, count);
+        copied += count;
+        self->remaining += count;
+        self->remaining_length -= count;
+    }
+    return copied;
+}
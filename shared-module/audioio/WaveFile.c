@@ -42,11 +42,29 @@ struct wave_format_chunk {
     uint32_t byte_rate;
     uint16_t block_align;
     uint16_t bits_per_sample;
-    uint16_t extra_params; // Assumed to be zero below.
+    uint16_t extra_params; // Assumed to be zero below for PCM.
+    uint16_t samples_per_block; // Only present for IMA ADPCM.
+};
+
+#define WAVE_FORMAT_PCM (0x0001)
+#define WAVE_FORMAT_IMA_ADPCM (0x0011)
+
+// IMA ADPCM tables. Each four bit code moves the step index through step_table.
+STATIC const int8_t adpcm_index_table[8] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+STATIC const uint16_t adpcm_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66,
+    73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
+    449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
+    9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767,
 };
 
 void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
-                                           pyb_file_obj_t* file) {
+                                           pyb_file_obj_t* file, uint8_t read_ahead) {
     // Load the wave
     self->file = file;
     uint8_t chunk_header[16];
@@ -75,7 +93,30 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
     if (bytes_read != format_size) {
     }
 
-    if (format.audio_format != 1 ||
+    self->block = NULL;
+    self->block_align = 0;
+    self->samples_per_block = 0;
+    self->block_samples = 0;
+    self->block_sample_index = 0;
+    if (format.audio_format == WAVE_FORMAT_IMA_ADPCM) {
+        // Each block starts with a four byte header per channel followed by four bit samples. The
+        // header holds the block's first sample.
+        uint16_t header_size = 4 * format.num_channels;
+        if (format.num_channels < 1 ||
+            format.num_channels > 2 ||
+            format.bits_per_sample != 4 ||
+            format.block_align <= header_size ||
+            format.block_align % header_size != 0) {
+            mp_raise_ValueError(translate("Unsupported format"));
+        }
+        self->block_align = format.block_align;
+        self->samples_per_block = (format.block_align - header_size) * 2 / format.num_channels + 1;
+        if (format_size >= 20 && format.samples_per_block < self->samples_per_block) {
+            self->samples_per_block = format.samples_per_block;
+        }
+        // The decoded samples are 16 bit.
+        format.bits_per_sample = 16;
+    } else if (format.audio_format != WAVE_FORMAT_PCM ||
         format.num_channels > 2 ||
         format.bits_per_sample > 16 ||
         (format_size == 18 &&
@@ -88,44 +129,56 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t* self,
     self->channel_count = format.num_channels;
     self->bits_per_sample = format.bits_per_sample;
 
-    // TODO(tannewt): Skip any extra chunks that occur before the data section.
-
-    uint8_t data_tag[4];
-    if (f_read(&self->file->fp, &data_tag, 4, &bytes_read) != FR_OK) {
-        mp_raise_OSError(MP_EIO);
-    }
-    if (bytes_read != 4 ||
-        memcmp((uint8_t *) data_tag, "data", 4) != 0) {
-        mp_raise_ValueError(translate("Data chunk must follow fmt chunk"));
-    }
-
+    // Skip any other chunks, such as the fact chunk IMA ADPCM files have, until the data chunk.
+    // Chunks are padded to an even length.
+    f_lseek(&self->file->fp, 20 + format_size + format_size % 2);
     uint32_t data_length;
-    if (f_read(&self->file->fp, &data_length, 4, &bytes_read) != FR_OK) {
-        mp_raise_OSError(MP_EIO);
-    }
-    if (bytes_read != 4) {
-        mp_raise_ValueError(translate("Invalid file"));
+    while (true) {
+        uint8_t chunk[8];
+        if (f_read(&self->file->fp, chunk, 8, &bytes_read) != FR_OK) {
+            mp_raise_OSError(MP_EIO);
+        }
+        if (bytes_read != 8) {
+            mp_raise_ValueError(translate("Invalid wave file"));
+        }
+        memcpy(&data_length, chunk + 4, 4);
+        if (memcmp(chunk, "data", 4) == 0) {
+            break;
+        }
+        f_lseek(&self->file->fp, self->file->fp.fptr + data_length + data_length % 2);
     }
     self->file_length = data_length;
     self->data_start = self->file->fp.fptr;
 
-    // Try to allocate two buffers, one will be loaded from file and the other
-    // DMAed to DAC.
-    self->buffer = m_malloc(self->len, false);
+    // Try to allocate the buffers. At any time one will be loaded from file and another DMAed to
+    // the DAC. The rest are read ahead.
+    self->buffer_count = 2 + read_ahead;
+    self->next_buffer = 0;
+    self->ready_count = 0;
+    self->read_error = false;
+    self->buffer = m_malloc(self->buffer_count * self->len, false);
     if (self->buffer == NULL) {
         common_hal_audioio_wavefile_deinit(self);
         mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate first buffer"));
     }
-
-    self->second_buffer = m_malloc(self->len, false);
-    if (self->second_buffer == NULL) {
+    self->buffer_length = m_malloc(self->buffer_count * sizeof(uint32_t), false);
+    if (self->buffer_length == NULL) {
         common_hal_audioio_wavefile_deinit(self);
-        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate second buffer"));
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate first buffer"));
+    }
+
+    if (self->block_align != 0) {
+        self->block = m_malloc(self->block_align, false);
+        if (self->block == NULL) {
+            common_hal_audioio_wavefile_deinit(self);
+            mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate decode buffer"));
+        }
     }
 }
 
 void common_hal_audioio_wavefile_deinit(audioio_wavefile_obj_t* self) {
     self->buffer = NULL;
+    self->block = NULL;
 }
 
 bool common_hal_audioio_wavefile_deinited(audioio_wavefile_obj_t* self) {
@@ -170,6 +223,145 @@ void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t* self,
     self->read_count = 0;
     self->left_read_count = 0;
     self->right_read_count = 0;
+    self->block_samples = 0;
+    self->block_sample_index = 0;
+    self->ready_count = 0;
+    self->read_error = false;
+}
+
+STATIC int16_t adpcm_decode_sample(audioio_wavefile_obj_t* self, uint8_t channel, uint8_t code) {
+    uint16_t step = adpcm_step_table[self->step_index[channel]];
+    int32_t diff = step >> 3;
+    if ((code & 1) != 0) {
+        diff += step >> 2;
+    }
+    if ((code & 2) != 0) {
+        diff += step >> 1;
+    }
+    if ((code & 4) != 0) {
+        diff += step;
+    }
+    int32_t predictor = self->predictor[channel];
+    if ((code & 8) != 0) {
+        predictor -= diff;
+    } else {
+        predictor += diff;
+    }
+    if (predictor > INT16_MAX) {
+        predictor = INT16_MAX;
+    } else if (predictor < INT16_MIN) {
+        predictor = INT16_MIN;
+    }
+    self->predictor[channel] = predictor;
+
+    int16_t step_index = self->step_index[channel] + adpcm_index_table[code & 7];
+    if (step_index < 0) {
+        step_index = 0;
+    } else if (step_index > 88) {
+        step_index = 88;
+    }
+    self->step_index[channel] = step_index;
+    return predictor;
+}
+
+// Decodes up to max_frames frames of 16 bit samples into buffer, loading blocks from the file as
+// needed. Returns the number of frames decoded or -1 if the file couldn't be read.
+STATIC int32_t adpcm_decode(audioio_wavefile_obj_t* self, int16_t* buffer, uint32_t max_frames) {
+    uint8_t channels = self->channel_count;
+    uint32_t frames = 0;
+    while (frames < max_frames) {
+        if (self->block_sample_index == self->block_samples) {
+            if (self->bytes_remaining == 0) {
+                break;
+            }
+            uint32_t block_length = MIN(self->block_align, self->bytes_remaining);
+            UINT length_read;
+            if (f_read(&self->file->fp, self->block, block_length, &length_read) != FR_OK) {
+                return -1;
+            }
+            self->bytes_remaining -= block_length;
+            // The last block may be short.
+            uint16_t header_size = 4 * channels;
+            if (length_read <= header_size) {
+                self->block_samples = 0;
+                continue;
+            }
+            self->block_samples = MIN(self->samples_per_block,
+                                      (length_read - header_size) * 2 / channels + 1);
+            self->block_sample_index = 0;
+        }
+
+        uint16_t index = self->block_sample_index;
+        if (index == 0) {
+            // The header holds the first sample itself and the step index to start from.
+            for (uint8_t c = 0; c < channels; c++) {
+                uint8_t* header = self->block + 4 * c;
+                self->predictor[c] = (int16_t) (header[0] | header[1] << 8);
+                self->step_index[c] = MIN(header[2], 88);
+                buffer[frames * channels + c] = self->predictor[c];
+            }
+        } else {
+            // After the headers each channel takes turns with four bytes (eight samples) at a
+            // time. Each byte has its earlier sample in the low nibble.
+            uint16_t j = index - 1;
+            uint32_t offset = 4 * channels + (j / 8) * 4 * channels + (j % 8) / 2;
+            uint8_t shift = (j % 2) * 4;
+            for (uint8_t c = 0; c < channels; c++) {
+                uint8_t code = (self->block[offset + 4 * c] >> shift) & 0xf;
+                buffer[frames * channels + c] = adpcm_decode_sample(self, c, code);
+            }
+        }
+        self->block_sample_index++;
+        frames++;
+    }
+    return frames;
+}
+
+// True once every sample has been loaded into a buffer.
+STATIC bool file_done(audioio_wavefile_obj_t* self) {
+    return self->bytes_remaining == 0 && self->block_sample_index == self->block_samples;
+}
+
+// Loads the next part of the file into the given buffer. Returns false if the file couldn't be read.
+STATIC bool load_buffer(audioio_wavefile_obj_t* self, uint8_t index) {
+    uint8_t* buffer = self->buffer + index * self->len;
+    UINT length_read;
+    if (self->block != NULL) {
+        uint32_t frame_size = self->channel_count * sizeof(int16_t);
+        // We know the buffer is aligned because we allocated it onto the heap ourselves.
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wcast-align"
+        int32_t frames = adpcm_decode(self, (int16_t*) buffer, self->len / frame_size);
+        #pragma GCC diagnostic pop
+        if (frames < 0) {
+            return false;
+        }
+        length_read = frames * frame_size;
+    } else {
+        uint32_t num_bytes_to_load = MIN(self->len, self->bytes_remaining);
+        if (f_read(&self->file->fp, buffer, num_bytes_to_load, &length_read) != FR_OK) {
+            return false;
+        }
+        self->bytes_remaining -= length_read;
+    }
+    // Pad the last buffer to word align it.
+    if (file_done(self) && length_read % sizeof(uint32_t) != 0) {
+        uint32_t pad = length_read % sizeof(uint32_t);
+        length_read += pad;
+        if (self->bits_per_sample == 8) {
+            for (uint32_t i = 0; i < pad; i++) {
+                buffer[length_read / sizeof(uint8_t) - i - 1] = 0x80;
+            }
+        } else if (self->bits_per_sample == 16) {
+            // We know the buffer is aligned because we allocated it onto the heap ourselves.
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Wcast-align"
+            ((int16_t*) buffer)[length_read / sizeof(int16_t) - 1] = 0;
+            #pragma GCC diagnostic pop
+        }
+    }
+    self->buffer_length[index] = length_read;
+    return true;
 }
 
 audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t* self,
@@ -188,61 +380,27 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
 
     bool need_more_data = self->read_count == channel_read_count;
 
-    if (self->bytes_remaining == 0 && need_more_data) {
+    if (self->ready_count == 0 && file_done(self) && need_more_data) {
         *buffer = NULL;
         *buffer_length = 0;
         return GET_BUFFER_DONE;
     }
 
     if (need_more_data) {
-        uint16_t num_bytes_to_load = self->len;
-        if (num_bytes_to_load > self->bytes_remaining) {
-            num_bytes_to_load = self->bytes_remaining;
-        }
-        UINT length_read;
-        if (self->buffer_index % 2 == 1) {
-            *buffer = self->second_buffer;
-        } else {
-            *buffer = self->buffer;
-        }
-        if (f_read(&self->file->fp, *buffer, num_bytes_to_load, &length_read) != FR_OK) {
+        // Use a buffer that was read ahead when there is one. Otherwise read it now.
+        if (self->ready_count > 0) {
+            self->ready_count--;
+        } else if (self->read_error || !load_buffer(self, self->next_buffer)) {
             return GET_BUFFER_ERROR;
         }
-        self->bytes_remaining -= length_read;
-        // Pad the last buffer to word align it.
-        if (self->bytes_remaining == 0 && length_read % sizeof(uint32_t) != 0) {
-            uint32_t pad = length_read % sizeof(uint32_t);
-            length_read += pad;
-            if (self->bits_per_sample == 8) {
-                for (uint32_t i = 0; i < pad; i++) {
-                    ((uint8_t*) (*buffer))[length_read / sizeof(uint8_t) - i - 1] = 0x80;
-                }
-            } else if (self->bits_per_sample == 16) {
-                // We know the buffer is aligned because we allocated it onto the heap ourselves.
-                #pragma GCC diagnostic push
-                #pragma GCC diagnostic ignored "-Wcast-align"
-                ((int16_t*) (*buffer))[length_read / sizeof(int16_t) - 1] = 0;
-                #pragma GCC diagnostic pop
-            }
-        }
-        *buffer_length = length_read;
-        if (self->buffer_index % 2 == 1) {
-            self->second_buffer_length = length_read;
-        } else {
-            self->buffer_length = length_read;
-        }
-        self->buffer_index += 1;
+        self->next_buffer = (self->next_buffer + 1) % self->buffer_count;
         self->read_count += 1;
     }
 
     uint32_t buffers_back = self->read_count - 1 - channel_read_count;
-    if ((self->buffer_index - buffers_back) % 2 == 0) {
-        *buffer = self->second_buffer;
-        *buffer_length = self->second_buffer_length;
-    } else {
-        *buffer = self->buffer;
-        *buffer_length = self->buffer_length;
-    }
+    uint8_t index = (self->next_buffer + self->buffer_count - 1 - buffers_back) % self->buffer_count;
+    *buffer = self->buffer + index * self->len;
+    *buffer_length = self->buffer_length[index];
 
     if (channel == 0) {
         self->left_read_count += 1;
@@ -251,7 +409,23 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
         *buffer = *buffer + self->bits_per_sample / 8;
     }
 
-    return self->bytes_remaining == 0 ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
+    return self->ready_count == 0 && file_done(self) ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
+}
+
+void audioio_wavefile_background(audioio_wavefile_obj_t* self) {
+    // Only one buffer is loaded per call to keep each background task short.
+    if (common_hal_audioio_wavefile_deinited(self) ||
+        self->ready_count + 2 >= self->buffer_count ||
+        self->read_error ||
+        file_done(self)) {
+        return;
+    }
+    uint8_t index = (self->next_buffer + self->ready_count) % self->buffer_count;
+    if (!load_buffer(self, index)) {
+        self->read_error = true;
+        return;
+    }
+    self->ready_count++;
 }
 
 void audioio_wavefile_get_buffer_structure(audioio_wavefile_obj_t* self, bool single_channel,
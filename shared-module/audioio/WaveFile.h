@@ -33,14 +33,17 @@
 
 typedef struct {
     mp_obj_base_t base;
-    uint8_t* buffer;
-    uint32_t buffer_length;
-    uint8_t* second_buffer;
-    uint32_t second_buffer_length;
+    uint8_t* buffer; // buffer_count buffers of len bytes each
+    uint32_t* buffer_length; // Bytes loaded into each buffer
+    // The two most recently returned buffers are in use for playback. Up to buffer_count - 2
+    // following them are read ahead of time by audioio_wavefile_background().
+    uint8_t buffer_count;
+    uint8_t next_buffer; // The next buffer to return
+    uint8_t ready_count; // Buffers loaded ahead starting at next_buffer
+    bool read_error; // Reading ahead failed so the next read should stop playback
     uint32_t file_length; // In bytes
     uint16_t data_start; // Where the data values start
     uint8_t bits_per_sample;
-    uint16_t buffer_index;
     uint32_t bytes_remaining;
 
     uint8_t channel_count;
@@ -52,6 +55,16 @@ typedef struct {
     uint32_t read_count;
     uint32_t left_read_count;
     uint32_t right_read_count;
+
+    // IMA ADPCM files are decoded from a whole block of the file at a time. block is NULL for PCM
+    // files.
+    uint8_t* block;
+    uint16_t block_align; // Bytes per block
+    uint16_t samples_per_block;
+    uint16_t block_samples; // Samples per channel in the block that's loaded
+    uint16_t block_sample_index; // Next sample to decode from the loaded block
+    int16_t predictor[2];
+    uint8_t step_index[2];
 } audioio_wavefile_obj_t;
 
 // These are not available from Python because it may be called in an interrupt.
@@ -63,6 +76,8 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t*
                                                         uint8_t channel,
                                                         uint8_t** buffer,
                                                         uint32_t* buffer_length); // length in bytes
+// Reads ahead into a free buffer, if any. Called from background tasks while the file plays.
+void audioio_wavefile_background(audioio_wavefile_obj_t* self);
 void audioio_wavefile_get_buffer_structure(audioio_wavefile_obj_t* self, bool single_channel,
                                            bool* single_buffer, bool* samples_signed,
                                            uint32_t* max_buffer_length, uint8_t* spacing);
@@ -27,11 +27,18 @@
 #include "shared-module/audioio/__init__.h"
 
 #include "py/obj.h"
+#include "py/runtime.h"
+#include "shared-bindings/audioio/BiquadFilter.h"
+#include "shared-bindings/audioio/Echo.h"
 #include "shared-bindings/audioio/Mixer.h"
 #include "shared-bindings/audioio/RawSample.h"
+#include "shared-bindings/audioio/Synthesizer.h"
 #include "shared-bindings/audioio/WaveFile.h"
+#include "shared-module/audioio/BiquadFilter.h"
+#include "shared-module/audioio/Echo.h"
 #include "shared-module/audioio/Mixer.h"
 #include "shared-module/audioio/RawSample.h"
+#include "shared-module/audioio/Synthesizer.h"
 #include "shared-module/audioio/WaveFile.h"
 
 uint32_t audiosample_sample_rate(mp_obj_t sample_obj) {
@@ -44,6 +51,15 @@ uint32_t audiosample_sample_rate(mp_obj_t sample_obj) {
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_mixer_type)) {
         audioio_mixer_obj_t* mixer = MP_OBJ_TO_PTR(sample_obj);
         return mixer->sample_rate;
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_synthesizer_type)) {
+        audioio_synthesizer_obj_t* synth = MP_OBJ_TO_PTR(sample_obj);
+        return synth->sample_rate;
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_biquadfilter_type)) {
+        audioio_biquadfilter_obj_t* filter = MP_OBJ_TO_PTR(sample_obj);
+        return filter->effect.sample_rate;
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_echo_type)) {
+        audioio_echo_obj_t* echo = MP_OBJ_TO_PTR(sample_obj);
+        return echo->effect.sample_rate;
     }
     return 16000;
 }
@@ -58,6 +74,11 @@ uint8_t audiosample_bits_per_sample(mp_obj_t sample_obj) {
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_mixer_type)) {
         audioio_mixer_obj_t* mixer = MP_OBJ_TO_PTR(sample_obj);
         return mixer->bits_per_sample;
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_synthesizer_type)) {
+        return 16;
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_biquadfilter_type) ||
+               MP_OBJ_IS_TYPE(sample_obj, &audioio_echo_type)) {
+        return 16;
     }
     return 8;
 }
@@ -72,6 +93,14 @@ uint8_t audiosample_channel_count(mp_obj_t sample_obj) {
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_mixer_type)) {
         audioio_mixer_obj_t* mixer = MP_OBJ_TO_PTR(sample_obj);
         return mixer->channel_count;
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_synthesizer_type)) {
+        return 1;
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_biquadfilter_type)) {
+        audioio_biquadfilter_obj_t* filter = MP_OBJ_TO_PTR(sample_obj);
+        return filter->effect.channel_count;
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_echo_type)) {
+        audioio_echo_obj_t* echo = MP_OBJ_TO_PTR(sample_obj);
+        return echo->effect.channel_count;
     }
     return 1;
 }
@@ -86,6 +115,15 @@ void audiosample_reset_buffer(mp_obj_t sample_obj, bool single_channel, uint8_t
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_mixer_type)) {
         audioio_mixer_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         audioio_mixer_reset_buffer(file, single_channel, audio_channel);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_synthesizer_type)) {
+        audioio_synthesizer_obj_t* synth = MP_OBJ_TO_PTR(sample_obj);
+        audioio_synthesizer_reset_buffer(synth, single_channel, audio_channel);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_biquadfilter_type)) {
+        audioio_biquadfilter_obj_t* filter = MP_OBJ_TO_PTR(sample_obj);
+        audioio_biquadfilter_reset_buffer(filter, single_channel, audio_channel);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_echo_type)) {
+        audioio_echo_obj_t* echo = MP_OBJ_TO_PTR(sample_obj);
+        audioio_echo_reset_buffer(echo, single_channel, audio_channel);
     }
 }
 
@@ -102,6 +140,15 @@ audioio_get_buffer_result_t audiosample_get_buffer(mp_obj_t sample_obj,
     } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_mixer_type)) {
         audioio_mixer_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         return audioio_mixer_get_buffer(file, single_channel, channel, buffer, buffer_length);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_synthesizer_type)) {
+        audioio_synthesizer_obj_t* synth = MP_OBJ_TO_PTR(sample_obj);
+        return audioio_synthesizer_get_buffer(synth, single_channel, channel, buffer, buffer_length);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_biquadfilter_type)) {
+        audioio_biquadfilter_obj_t* filter = MP_OBJ_TO_PTR(sample_obj);
+        return audioio_biquadfilter_get_buffer(filter, single_channel, channel, buffer, buffer_length);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_echo_type)) {
+        audioio_echo_obj_t* echo = MP_OBJ_TO_PTR(sample_obj);
+        return audioio_echo_get_buffer(echo, single_channel, channel, buffer, buffer_length);
     }
     return GET_BUFFER_DONE;
 }
@@ -121,5 +168,267 @@ void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel,
         audioio_mixer_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
         audioio_mixer_get_buffer_structure(file, single_channel, single_buffer, samples_signed,
                                               max_buffer_length, spacing);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_synthesizer_type)) {
+        audioio_synthesizer_obj_t* synth = MP_OBJ_TO_PTR(sample_obj);
+        audioio_synthesizer_get_buffer_structure(synth, single_channel, single_buffer,
+                                                 samples_signed, max_buffer_length, spacing);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_biquadfilter_type)) {
+        audioio_biquadfilter_obj_t* filter = MP_OBJ_TO_PTR(sample_obj);
+        audioio_biquadfilter_get_buffer_structure(filter, single_channel, single_buffer,
+                                                  samples_signed, max_buffer_length, spacing);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_echo_type)) {
+        audioio_echo_obj_t* echo = MP_OBJ_TO_PTR(sample_obj);
+        audioio_echo_get_buffer_structure(echo, single_channel, single_buffer, samples_signed,
+                                          max_buffer_length, spacing);
+    }
+}
+
+void audiosample_background(mp_obj_t sample_obj) {
+    if (MP_OBJ_IS_TYPE(sample_obj, &audioio_wavefile_type)) {
+        audioio_wavefile_obj_t* file = MP_OBJ_TO_PTR(sample_obj);
+        audioio_wavefile_background(file);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_mixer_type)) {
+        audioio_mixer_obj_t* mixer = MP_OBJ_TO_PTR(sample_obj);
+        for (uint8_t i = 0; i < mixer->voice_count; i++) {
+            mp_obj_t sample = mixer->voice[i].sample;
+            if (sample != NULL) {
+                audiosample_background(sample);
+            }
+        }
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_biquadfilter_type)) {
+        audioio_biquadfilter_obj_t* filter = MP_OBJ_TO_PTR(sample_obj);
+        audiosample_background(filter->effect.sample);
+    } else if (MP_OBJ_IS_TYPE(sample_obj, &audioio_echo_type)) {
+        audioio_echo_obj_t* echo = MP_OBJ_TO_PTR(sample_obj);
+        audiosample_background(echo->effect.sample);
+    }
+}
+
+void audiosample_resampler_init(audiosample_resampler_t* self, uint32_t input_rate,
+                                uint32_t output_rate, uint8_t bits_per_sample,
+                                bool samples_signed, uint8_t channel_count) {
+    self->step = ((uint64_t) input_rate << 16) / output_rate;
+    // Start two whole frames back so that the first two input frames are read before the first
+    // output frame. The first output frame is then exactly the first input frame.
+    self->phase = 2 << 16;
+    for (uint8_t c = 0; c < 2; c++) {
+        self->previous[c] = 0;
+        self->next[c] = 0;
+    }
+    self->output_word = 0;
+    self->output_offset = 0;
+    self->input_offset = 0;
+    self->bits_per_sample = bits_per_sample;
+    self->samples_signed = samples_signed;
+    self->channel_count = channel_count;
+}
+
+uint32_t audiosample_resample(audiosample_resampler_t* self, uint32_t** input,
+                              uint32_t* input_length, uint32_t* output, uint32_t output_length) {
+    uint8_t bits = self->bits_per_sample;
+    uint8_t channels = self->channel_count;
+    uint8_t frames_per_word = 32 / (bits * channels);
+    uint32_t sample_mask = (1 << bits) - 1;
+    // Flipping the top bit converts between unsigned and signed samples.
+    uint32_t sign_flip = self->samples_signed ? 0 : 1 << (bits - 1);
+    uint8_t sign_shift = 32 - bits;
+
+    uint32_t written = 0;
+    while (written < output_length) {
+        // Read input frames until the output frame lies between previous and next.
+        while (self->phase >= (1 << 16)) {
+            if (*input_length == 0) {
+                return written;
+            }
+            uint32_t word = **input;
+            uint8_t first_bit = self->input_offset * channels * bits;
+            for (uint8_t c = 0; c < channels; c++) {
+                uint32_t sample = ((word >> (first_bit + c * bits)) & sample_mask) ^ sign_flip;
+                self->previous[c] = self->next[c];
+                // Shift up and back down to sign extend.
+                self->next[c] = ((int32_t) (sample << sign_shift)) >> sign_shift;
+            }
+            self->input_offset++;
+            if (self->input_offset == frames_per_word) {
+                self->input_offset = 0;
+                (*input)++;
+                (*input_length)--;
+            }
+            self->phase -= 1 << 16;
+        }
+
+        uint8_t first_bit = self->output_offset * channels * bits;
+        for (uint8_t c = 0; c < channels; c++) {
+            int32_t previous = self->previous[c];
+            // Drop a bit of the phase so that the product fits in 32 bits.
+            int32_t interpolated = previous + (((self->next[c] - previous) * (int32_t) (self->phase >> 1)) >> 15);
+            uint32_t sample = (((uint32_t) interpolated) & sample_mask) ^ sign_flip;
+            self->output_word |= sample << (first_bit + c * bits);
+        }
+        self->phase += self->step;
+        self->output_offset++;
+        if (self->output_offset == frames_per_word) {
+            output[written++] = self->output_word;
+            self->output_word = 0;
+            self->output_offset = 0;
+        }
+    }
+    return written;
+}
+
+void audiosample_effect_construct(audiosample_effect_t* self, mp_obj_t sample,
+                                  uint32_t buffer_size) {
+    if (audiosample_bits_per_sample(sample) != 16) {
+        mp_raise_ValueError(translate("Effects only support 16 bit samples"));
+    }
+    uint8_t channel_count = audiosample_channel_count(sample);
+    if (channel_count > 2) {
+        mp_raise_ValueError(translate("Too many channels in sample."));
+    }
+    bool single_buffer;
+    uint32_t max_buffer_length;
+    uint8_t spacing;
+    audiosample_get_buffer_structure(sample, false, &single_buffer, &self->samples_signed,
+                                     &max_buffer_length, &spacing);
+
+    // Keep a whole number of frames in each buffer.
+    uint32_t frame_size = channel_count * sizeof(uint16_t);
+    self->len = buffer_size / 2 / frame_size * frame_size;
+    if (self->len == 0) {
+        mp_raise_ValueError(translate("Invalid buffer size"));
+    }
+    self->first_buffer = m_malloc(self->len, false);
+    if (self->first_buffer == NULL) {
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate first buffer"));
+    }
+    self->second_buffer = m_malloc(self->len, false);
+    if (self->second_buffer == NULL) {
+        self->first_buffer = NULL;
+        mp_raise_msg(&mp_type_MemoryError, translate("Couldn't allocate second buffer"));
+    }
+
+    self->sample = sample;
+    self->channel_count = channel_count;
+    self->sample_rate = audiosample_sample_rate(sample);
+    audiosample_effect_reset_buffer(self, false, 0);
+}
+
+void audiosample_effect_deinit(audiosample_effect_t* self) {
+    self->first_buffer = NULL;
+    self->second_buffer = NULL;
+    self->sample = MP_OBJ_NULL;
+}
+
+void audiosample_effect_reset_buffer(audiosample_effect_t* self, bool single_channel,
+                                     uint8_t channel) {
+    // Outputs that read each channel separately reset once per channel.
+    if (single_channel && channel == 1) {
+        return;
+    }
+    audiosample_reset_buffer(self->sample, false, 0);
+    self->use_first_buffer = true;
+    self->more_data = true;
+    self->remaining_buffer = NULL;
+    self->remaining_length = 0;
+    self->read_count = 0;
+    self->left_read_count = 0;
+    self->right_read_count = 0;
+}
+
+// Fills buffer with processed source samples until it's full or the source has nothing more for
+// now. Returns the number of samples written.
+static uint32_t fill_effect_buffer(audiosample_effect_t* self, uint16_t* buffer,
+                                   audiosample_effect_process_t process, mp_obj_t effect,
+                                   audioio_get_buffer_result_t* result) {
+    uint32_t capacity = self->len / sizeof(uint16_t);
+    uint16_t sign_flip = self->samples_signed ? 0 : 0x8000;
+    uint32_t written = 0;
+    *result = GET_BUFFER_MORE_DATA;
+    while (written < capacity) {
+        if (self->remaining_length == 0) {
+            if (!self->more_data) {
+                *result = GET_BUFFER_DONE;
+                break;
+            }
+            uint8_t* source;
+            uint32_t source_length;
+            audioio_get_buffer_result_t source_result =
+                audiosample_get_buffer(self->sample, false, 0, &source, &source_length);
+            if (source_result == GET_BUFFER_ERROR) {
+                *result = GET_BUFFER_ERROR;
+                break;
+            }
+            self->more_data = source_result == GET_BUFFER_MORE_DATA;
+            self->remaining_buffer = (const uint16_t*) source;
+            self->remaining_length = source_length / sizeof(uint16_t);
+            self->remaining_length -= self->remaining_length % self->channel_count;
+            if (self->remaining_length == 0 && self->more_data) {
+                // Nothing ready right now. Try again next buffer.
+                break;
+            }
+            continue;
+        }
+        uint32_t count = MIN(capacity - written, self->remaining_length);
+        process(effect, buffer + written, self->remaining_buffer, count / self->channel_count,
+                sign_flip);
+        written += count;
+        self->remaining_buffer += count;
+        self->remaining_length -= count;
+    }
+    return written;
+}
+
+audioio_get_buffer_result_t audiosample_effect_get_buffer(audiosample_effect_t* self,
+                                                          bool single_channel,
+                                                          uint8_t channel,
+                                                          uint8_t** buffer,
+                                                          uint32_t* buffer_length,
+                                                          audiosample_effect_process_t process,
+                                                          mp_obj_t effect) {
+    if (!single_channel) {
+        channel = 0;
+    }
+
+    uint32_t channel_read_count = self->left_read_count;
+    if (channel == 1) {
+        channel_read_count = self->right_read_count;
+    }
+
+    bool need_more_data = self->read_count == channel_read_count;
+    if (need_more_data) {
+        uint16_t* output = self->use_first_buffer ? self->first_buffer : self->second_buffer;
+        self->use_first_buffer = !self->use_first_buffer;
+        *buffer = (uint8_t*) output;
+        self->output_length = fill_effect_buffer(self, output, process, effect,
+                                                 &self->output_result) * sizeof(uint16_t);
+        self->read_count += 1;
+    } else if (!self->use_first_buffer) {
+        *buffer = (uint8_t*) self->first_buffer;
+    } else {
+        *buffer = (uint8_t*) self->second_buffer;
+    }
+    *buffer_length = self->output_length;
+
+    if (channel == 0) {
+        self->left_read_count += 1;
+    } else if (channel == 1) {
+        self->right_read_count += 1;
+        if (self->channel_count == 2) {
+            *buffer = *buffer + sizeof(uint16_t);
+        }
+    }
+    return self->output_result;
+}
+
+void audiosample_effect_get_buffer_structure(audiosample_effect_t* self, bool single_channel,
+                                             bool* single_buffer, bool* samples_signed,
+                                             uint32_t* max_buffer_length, uint8_t* spacing) {
+    *single_buffer = false;
+    *samples_signed = self->samples_signed;
+    *max_buffer_length = self->len;
+    if (single_channel) {
+        *spacing = self->channel_count;
+    } else {
+        *spacing = 1;
     }
 }
@@ -38,6 +38,76 @@ typedef enum {
     GET_BUFFER_ERROR,           // Error while reading data.
 } audioio_get_buffer_result_t;
 
+// Linear interpolation from one sample rate to another. It works a frame (one sample per channel)
+// at a time on samples packed into words the same way as the buffers they come from.
+typedef struct {
+    uint32_t step; // Input frames per output frame in 16.16 fixed point.
+    uint32_t phase; // Position past the previous input frame in 16.16 fixed point.
+    int16_t previous[2]; // Signed input frames either side of phase.
+    int16_t next[2];
+    uint32_t output_word; // Output frames finished before the last call ran out of input.
+    uint8_t output_offset; // Frames in output_word.
+    uint8_t input_offset; // Frames already read from the current input word.
+    uint8_t bits_per_sample;
+    bool samples_signed;
+    uint8_t channel_count;
+} audiosample_resampler_t;
+
+void audiosample_resampler_init(audiosample_resampler_t* self, uint32_t input_rate,
+                                uint32_t output_rate, uint8_t bits_per_sample,
+                                bool samples_signed, uint8_t channel_count);
+// Fills up to output_length words of output from the input words, advancing the input past what
+// it used. Returns the number of words written. Fewer than output_length are only written once all
+// of the input has been used.
+uint32_t audiosample_resample(audiosample_resampler_t* self, uint32_t** input,
+                              uint32_t* input_length, uint32_t* output, uint32_t output_length);
+
+// Effects process another 16 bit sample as it plays. This is the part they share: it pulls from
+// the source sample and double buffers the processed output. Effects write straight from the
+// source's buffers into their own so chaining doesn't copy anything else.
+typedef struct {
+    mp_obj_t sample;
+    uint16_t* first_buffer;
+    uint16_t* second_buffer;
+    uint32_t len; // in bytes
+    bool use_first_buffer;
+    bool more_data;
+    bool samples_signed;
+    uint8_t channel_count;
+    uint32_t sample_rate;
+    const uint16_t* remaining_buffer;
+    uint32_t remaining_length; // in samples
+    // The last buffer made, for the second channel when each channel is read separately.
+    uint32_t output_length;
+    audioio_get_buffer_result_t output_result;
+
+    uint32_t read_count;
+    uint32_t left_read_count;
+    uint32_t right_read_count;
+} audiosample_effect_t;
+
+// Processes frame_count frames of interleaved samples. Samples are signed once XORed with
+// sign_flip, and output should be XORed with it too.
+typedef void (*audiosample_effect_process_t)(mp_obj_t effect, uint16_t* output,
+                                             const uint16_t* input, uint32_t frame_count,
+                                             uint16_t sign_flip);
+
+void audiosample_effect_construct(audiosample_effect_t* self, mp_obj_t sample,
+                                  uint32_t buffer_size);
+void audiosample_effect_deinit(audiosample_effect_t* self);
+void audiosample_effect_reset_buffer(audiosample_effect_t* self, bool single_channel,
+                                     uint8_t channel);
+audioio_get_buffer_result_t audiosample_effect_get_buffer(audiosample_effect_t* self,
+                                                          bool single_channel,
+                                                          uint8_t channel,
+                                                          uint8_t** buffer,
+                                                          uint32_t* buffer_length,
+                                                          audiosample_effect_process_t process,
+                                                          mp_obj_t effect);
+void audiosample_effect_get_buffer_structure(audiosample_effect_t* self, bool single_channel,
+                                             bool* single_buffer, bool* samples_signed,
+                                             uint32_t* max_buffer_length, uint8_t* spacing);
+
 uint32_t audiosample_sample_rate(mp_obj_t sample_obj);
 uint8_t audiosample_bits_per_sample(mp_obj_t sample_obj);
 uint8_t audiosample_channel_count(mp_obj_t sample_obj);
@@ -49,5 +119,8 @@ audioio_get_buffer_result_t audiosample_get_buffer(mp_obj_t sample_obj,
 void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel,
                                       bool* single_buffer, bool* samples_signed,
                                       uint32_t* max_buffer_length, uint8_t* spacing);
+// Gives a playing sample, and any samples it plays in turn, a chance to do work such as reading
+// ahead outside of get_buffer. Ports call it from their background tasks.
+void audiosample_background(mp_obj_t sample_obj);
 
 #endif  // MICROPY_INCLUDED_SHARED_MODULE_AUDIOIO__INIT__H
@@ -36,6 +36,11 @@
 
 #define MAX_BAUDRATE (common_hal_mcu_get_clock_frequency() / 48)
 
+// Above this the microsecond delays can't pace the clock, so it runs unpaced instead.
+#define MAX_PACED_BAUDRATE 500000
+
+static volatile uint32_t dummy_register;
+
 void shared_module_bitbangio_spi_construct(bitbangio_spi_obj_t *self,
         const mcu_pin_obj_t * clock, const mcu_pin_obj_t * mosi,
         const mcu_pin_obj_t * miso) {
@@ -65,6 +70,24 @@ void shared_module_bitbangio_spi_construct(bitbangio_spi_obj_t *self,
     self->delay_half = 5;
     self->polarity = 0;
     self->phase = 0;
+
+    common_hal_digitalio_digitalinout_switch_to_output(&self->clock, false, DRIVE_MODE_PUSH_PULL);
+    if (self->has_mosi) {
+        common_hal_digitalio_digitalinout_switch_to_output(&self->mosi, false, DRIVE_MODE_PUSH_PULL);
+    }
+
+    // Absent pins get dummy registers so the fast loop doesn't have to check for them.
+    self->mosi_registers.set = &dummy_register;
+    self->mosi_registers.clear = &dummy_register;
+    self->miso_registers.input = &dummy_register;
+    self->mosi_registers.mask = 0;
+    self->miso_registers.mask = 0;
+    self->use_registers =
+        common_hal_digitalio_digitalinout_get_registers(&self->clock, &self->clock_registers) &&
+        (!self->has_mosi ||
+         common_hal_digitalio_digitalinout_get_registers(&self->mosi, &self->mosi_registers)) &&
+        (!self->has_miso ||
+         common_hal_digitalio_digitalinout_get_registers(&self->miso, &self->miso_registers));
 }
 
 bool shared_module_bitbangio_spi_deinited(bitbangio_spi_obj_t *self) {
@@ -86,14 +109,89 @@ void shared_module_bitbangio_spi_deinit(bitbangio_spi_obj_t *self) {
 
 void shared_module_bitbangio_spi_configure(bitbangio_spi_obj_t *self,
         uint32_t baudrate, uint8_t polarity, uint8_t phase, uint8_t bits) {
-    self->delay_half = 500000 / baudrate;
-    // round delay_half up so that: actual_baudrate <= requested_baudrate
-    if (500000 % baudrate != 0) {
-        self->delay_half += 1;
+    if (baudrate > MAX_PACED_BAUDRATE) {
+        self->delay_half = 0;
+    } else {
+        self->delay_half = 500000 / baudrate;
+        // round delay_half up so that: actual_baudrate <= requested_baudrate
+        if (500000 % baudrate != 0) {
+            self->delay_half += 1;
+        }
     }
 
     self->polarity = polarity;
     self->phase = phase;
+    common_hal_digitalio_digitalinout_set_value(&self->clock, polarity);
+}
+
+// One bit each way. Phase 0 sets MOSI before the leading clock edge and samples MISO on it. Phase
+// 1 sets MOSI on the leading edge and samples MISO on the trailing one.
+#define TRANSFER_BIT_PHASE0(delay) \
+    if (data_out & 0x80) { *mosi_set = mosi_mask; } else { *mosi_clear = mosi_mask; } \
+    data_out <<= 1; \
+    delay; \
+    *clock_active = clock_mask; \
+    data_in = (data_in << 1) | ((*miso_input & miso_mask) != 0); \
+    delay; \
+    *clock_idle = clock_mask;
+
+#define TRANSFER_BIT_PHASE1(delay) \
+    *clock_active = clock_mask; \
+    if (data_out & 0x80) { *mosi_set = mosi_mask; } else { *mosi_clear = mosi_mask; } \
+    data_out <<= 1; \
+    delay; \
+    *clock_idle = clock_mask; \
+    data_in = (data_in << 1) | ((*miso_input & miso_mask) != 0); \
+    delay;
+
+#define UNROLL_8(x) x x x x x x x x
+
+// Clocks out dout, or zeroes when it is NULL, and stores what is read into din unless it is NULL.
+// Each edge is a single store to the pin's port register.
+STATIC void transfer_registers(bitbangio_spi_obj_t *self, const uint8_t *dout, uint8_t *din, size_t len) {
+    uint32_t delay_half = self->delay_half;
+    uint32_t clock_mask = self->clock_registers.mask;
+    volatile uint32_t *clock_active = self->clock_registers.set;
+    volatile uint32_t *clock_idle = self->clock_registers.clear;
+    if (self->polarity == 1) {
+        clock_active = self->clock_registers.clear;
+        clock_idle = self->clock_registers.set;
+    }
+    uint32_t mosi_mask = self->mosi_registers.mask;
+    volatile uint32_t *mosi_set = self->mosi_registers.set;
+    volatile uint32_t *mosi_clear = self->mosi_registers.clear;
+    uint32_t miso_mask = self->miso_registers.mask;
+    volatile uint32_t *miso_input = self->miso_registers.input;
+
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t data_out = dout == NULL ? 0 : dout[i];
+        uint8_t data_in = 0;
+        if (delay_half == 0) {
+            if (self->phase == 0) {
+                UNROLL_8(TRANSFER_BIT_PHASE0())
+            } else {
+                UNROLL_8(TRANSFER_BIT_PHASE1())
+            }
+        } else {
+            for (int j = 0; j < 8; ++j) {
+                if (self->phase == 0) {
+                    TRANSFER_BIT_PHASE0(common_hal_mcu_delay_us(delay_half))
+                } else {
+                    TRANSFER_BIT_PHASE1(common_hal_mcu_delay_us(delay_half))
+                }
+            }
+        }
+        if (din != NULL) {
+            din[i] = data_in;
+        }
+
+        // Unpaced transfers are quick enough to only poll every so often.
+        #ifdef MICROPY_EVENT_POLL_HOOK
+        if (delay_half != 0 || (i & 0xff) == 0xff) {
+            MICROPY_EVENT_POLL_HOOK;
+        }
+        #endif
+    }
 }
 
 bool shared_module_bitbangio_spi_try_lock(bitbangio_spi_obj_t *self) {
@@ -124,25 +222,10 @@ bool shared_module_bitbangio_spi_write(bitbangio_spi_obj_t *self, const uint8_t
 
     // only MSB transfer is implemented
 
-    // If a port defines MICROPY_PY_MACHINE_SPI_MIN_DELAY, and the configured
-    // delay_half is equal to this value, then the software SPI implementation
-    // will run as fast as possible, limited only by CPU speed and GPIO time.
-    #ifdef MICROPY_PY_MACHINE_SPI_MIN_DELAY
-    if (delay_half <= MICROPY_PY_MACHINE_SPI_MIN_DELAY) {
-        for (size_t i = 0; i < len; ++i) {
-            uint8_t data_out = data[i];
-            for (int j = 0; j < 8; ++j, data_out <<= 1) {
-                common_hal_digitalio_digitalinout_set_value(&self->mosi, (data_out >> 7) & 1);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, 1 - self->polarity);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, self->polarity);
-            }
-            if (dest != NULL) {
-                dest[i] = data_in;
-            }
-        }
+    if (self->use_registers) {
+        transfer_registers(self, data, NULL, len);
         return true;
     }
-    #endif
 
     for (size_t i = 0; i < len; ++i) {
         uint8_t data_out = data[i];
@@ -180,27 +263,10 @@ bool shared_module_bitbangio_spi_read(bitbangio_spi_obj_t *self, uint8_t *data,
 
     // only MSB transfer is implemented
 
-    // If a port defines MICROPY_PY_MACHINE_SPI_MIN_DELAY, and the configured
-    // delay_half is equal to this value, then the software SPI implementation
-    // will run as fast as possible, limited only by CPU speed and GPIO time.
-    #ifdef MICROPY_PY_MACHINE_SPI_MIN_DELAY
-    if (delay_half <= MICROPY_PY_MACHINE_SPI_MIN_DELAY) {
-        // Clock out zeroes while we read.
-        if (self->has_mosi) {
-            common_hal_digitalio_digitalinout_set_value(&self->mosi, false);
-        }
-        for (size_t i = 0; i < len; ++i) {
-            uint8_t data_in = 0;
-            for (int j = 0; j < 8; ++j, data_out <<= 1) {
-                common_hal_digitalio_digitalinout_set_value(&self->clock, 1 - self->polarity);
-                data_in = (data_in << 1) | common_hal_digitalio_digitalinout_get_value(&self->miso);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, self->polarity);
-            }
-            data[i] = data_in;
-        }
+    if (self->use_registers) {
+        transfer_registers(self, NULL, data, len);
         return true;
     }
-    #endif
     if (self->has_mosi) {
         common_hal_digitalio_digitalinout_set_value(&self->mosi, false);
     }
@@ -243,29 +309,10 @@ bool shared_module_bitbangio_spi_transfer(bitbangio_spi_obj_t *self, const uint8
 
     // only MSB transfer is implemented
 
-    // If a port defines MICROPY_PY_MACHINE_SPI_MIN_DELAY, and the configured
-    // delay_half is equal to this value, then the software SPI implementation
-    // will run as fast as possible, limited only by CPU speed and GPIO time.
-    #ifdef MICROPY_PY_MACHINE_SPI_MIN_DELAY
-    if (delay_half <= MICROPY_PY_MACHINE_SPI_MIN_DELAY) {
-        for (size_t i = 0; i < len; ++i) {
-            uint8_t data_out = dout[i];
-            uint8_t data_in = 0;
-            for (int j = 0; j < 8; ++j, data_out <<= 1) {
-                common_hal_digitalio_digitalinout_set_value(&self->mosi, (data_out >> 7) & 1);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, 1 - self->polarity);
-                data_in = (data_in << 1) | common_hal_digitalio_digitalinout_get_value(&self->miso);
-                common_hal_digitalio_digitalinout_set_value(&self->clock, self->polarity);
-            }
-            din[i] = data_in;
-
-            if (dest != NULL) {
-                dest[i] = data_in;
-            }
-        }
+    if (self->use_registers) {
+        transfer_registers(self, dout, din, len);
         return true;
     }
-    #endif
 
     for (size_t i = 0; i < len; ++i) {
         uint8_t data_out = dout[i];
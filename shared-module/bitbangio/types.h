@@ -28,6 +28,7 @@
 #define MICROPY_INCLUDED_SHARED_MODULE_BITBANGIO_TYPES_H
 
 #include "common-hal/digitalio/DigitalInOut.h"
+#include "shared-bindings/digitalio/DigitalInOut.h"
 
 #include "py/obj.h"
 
@@ -50,7 +51,14 @@ typedef struct {
     digitalio_digitalinout_obj_t clock;
     digitalio_digitalinout_obj_t mosi;
     digitalio_digitalinout_obj_t miso;
+    // Resolved at construction when every pin has them. Missing MOSI and MISO point at dummy
+    // registers.
+    digitalinout_registers_t clock_registers;
+    digitalinout_registers_t mosi_registers;
+    digitalinout_registers_t miso_registers;
+    // Zero runs the clock as fast as the CPU can toggle it.
     uint32_t delay_half;
+    bool use_registers:1;
     bool has_miso:1;
     bool has_mosi:1;
     uint8_t polarity:1;
@@ -37,6 +37,8 @@ typedef struct {
     mp_obj_t name;
     bleio_address_obj_t address;
     volatile uint16_t conn_handle;
+    // The ATT MTU agreed with the peer, which bounds the length of a notification.
+    uint16_t att_mtu;
     mp_obj_t service_list;
     mp_obj_t notif_handler;
     mp_obj_t conn_handler;
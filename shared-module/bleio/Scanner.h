@@ -28,12 +28,41 @@
 #define MICROPY_INCLUDED_SHARED_MODULE_BLEIO_SCANNER_H
 
 #include "py/obj.h"
+#include "shared-module/bleio/Address.h"
+
+// Legacy advertising and scan response payloads are at most 31 bytes.
+#define BLEIO_SCAN_DATA_MAX 31
+// Room left for a manufacturer data prefix after the AD length and type bytes.
+#define BLEIO_SCAN_MANUFACTURER_PREFIX_MAX (BLEIO_SCAN_DATA_MAX - 2)
+
+// An advertisement report as stored by the event handler, which must not allocate.
+typedef struct {
+    uint8_t address_type;
+    uint8_t address[BLEIO_ADDRESS_BYTES];
+    int8_t rssi;
+    uint8_t data_len;
+    uint8_t data[BLEIO_SCAN_DATA_MAX];
+} bleio_scan_record_t;
 
 typedef struct {
     mp_obj_base_t base;
     mp_obj_t adv_reports;
     uint16_t interval;
     uint16_t window;
+    // Reports that passed the filters and haven't been turned into ScanEntry objects yet.
+    // Reports from an address already in here replace the earlier one.
+    bleio_scan_record_t *records;
+    uint16_t records_size;
+    volatile uint16_t records_start;
+    volatile uint16_t records_count;
+    // Filters applied before a report is stored. A length of 0 means no filter.
+    int8_t minimum_rssi;
+    uint8_t uuid_filter_len;
+    uint8_t uuid_filter[16];
+    uint8_t address_prefix_len;
+    uint8_t address_prefix[BLEIO_ADDRESS_BYTES];
+    uint8_t manufacturer_prefix_len;
+    uint8_t manufacturer_prefix[BLEIO_SCAN_MANUFACTURER_PREFIX_MAX];
 } bleio_scanner_obj_t;
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_BLEIO_SCANNER_H
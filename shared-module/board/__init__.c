@@ -31,6 +31,7 @@
 #include "shared-bindings/microcontroller/Pin.h"
 #include "supervisor/shared/translate.h"
 #include "mpconfigboard.h"
+#include "py/gc.h"
 #include "py/runtime.h"
 
 #ifdef CIRCUITPY_DISPLAYIO
@@ -91,7 +92,7 @@ mp_obj_t common_hal_board_create_uart(void) {
     const mcu_pin_obj_t* rx = MP_OBJ_TO_PTR(DEFAULT_UART_BUS_RX);
     const mcu_pin_obj_t* tx = MP_OBJ_TO_PTR(DEFAULT_UART_BUS_TX);
 
-    common_hal_busio_uart_construct(self, tx, rx, 9600, 8, PARITY_NONE, 1, 1000, 64);
+    common_hal_busio_uart_construct(self, tx, rx, 9600, 8, PARITY_NONE, 1, 1000, 64, 64);
     MP_STATE_VM(shared_uart_bus) = MP_OBJ_FROM_PTR(self);
     return MP_STATE_VM(shared_uart_bus);
 }
@@ -119,3 +120,12 @@ void reset_board_busses(void) {
     MP_STATE_VM(shared_uart_bus) = NULL;
 #endif
 }
+
+// The board SPI object isn't on the heap so the buffer of a background write has to be marked here.
+void board_gc_collect(void) {
+#if BOARD_SPI
+    if (spi_singleton != NULL) {
+        gc_collect_root((void**)&spi_obj, sizeof(busio_spi_obj_t) / sizeof(mp_uint_t));
+    }
+#endif
+}
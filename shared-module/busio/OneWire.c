@@ -24,17 +24,47 @@
  * THE SOFTWARE.
  */
 
-// Wraps the bitbangio implementation of OneWire for use in busio.
+// Wraps the bitbangio implementation of OneWire for use in busio, or runs the bus from a UART.
+//
+// With a UART each time slot is one character: the start bit pulls the bus low and the rest
+// of the character decides how long it stays low. 0xff at 115200 baud is a short pulse that
+// writes a one or reads a bit, which comes back in the echo as 0xff when the device left the
+// bus high. 0x00 holds the bus low long enough to write a zero. A reset is 0xf0 at 9600 baud,
+// and any device answering with a presence pulse changes the echo. The UART times every slot,
+// so interrupts stay on and many slots go out in one write.
+#include <string.h>
+
 #include "common-hal/microcontroller/Pin.h"
+#include "py/mperrno.h"
+#include "py/runtime.h"
 #include "shared-bindings/bitbangio/OneWire.h"
+#include "shared-bindings/busio/OneWire.h"
+#include "shared-bindings/busio/UART.h"
 #include "shared-module/busio/OneWire.h"
 
+#define SLOT_BAUDRATE (115200)
+#define RESET_BAUDRATE (9600)
+#define SLOT_ONE (0xff)
+#define SLOT_ZERO (0x00)
+#define RESET_PULSE (0xf0)
+// Bytes sent in one batch of slots.
+#define BATCH_BYTES (8)
+
 void common_hal_busio_onewire_construct(busio_onewire_obj_t* self,
-        const mcu_pin_obj_t* pin) {
-    shared_module_bitbangio_onewire_construct(&self->bitbang, pin);
+        const mcu_pin_obj_t* pin, const mcu_pin_obj_t* tx) {
+    self->use_uart = tx != NULL;
+    if (self->use_uart) {
+        common_hal_busio_uart_construct(&self->uart, tx, pin, SLOT_BAUDRATE, 8, PARITY_NONE, 1,
+                                        0.1, 64, 0);
+    } else {
+        shared_module_bitbangio_onewire_construct(&self->bitbang, pin);
+    }
 }
 
 bool common_hal_busio_onewire_deinited(busio_onewire_obj_t* self) {
+    if (self->use_uart) {
+        return common_hal_busio_uart_deinited(&self->uart);
+    }
     return shared_module_bitbangio_onewire_deinited(&self->bitbang);
 }
 
@@ -42,18 +72,132 @@ void common_hal_busio_onewire_deinit(busio_onewire_obj_t* self) {
     if (common_hal_busio_onewire_deinited(self)) {
         return;
     }
-    shared_module_bitbangio_onewire_deinit(&self->bitbang);
+    if (self->use_uart) {
+        common_hal_busio_uart_deinit(&self->uart);
+    } else {
+        shared_module_bitbangio_onewire_deinit(&self->bitbang);
+    }
+}
+
+// Sends the slots and replaces each with what was read back: SLOT_ONE for a high bus and
+// anything else for a low one.
+static void transfer_slots(busio_onewire_obj_t* self, uint8_t* slots, size_t count) {
+    if (!self->use_uart) {
+        for (size_t i = 0; i < count; i++) {
+            if (slots[i] == SLOT_ONE) {
+                slots[i] = shared_module_bitbangio_onewire_read_bit(&self->bitbang) ? SLOT_ONE : SLOT_ZERO;
+            } else {
+                shared_module_bitbangio_onewire_write_bit(&self->bitbang, false);
+            }
+        }
+        return;
+    }
+    int errcode = 0;
+    common_hal_busio_uart_clear_rx_buffer(&self->uart);
+    common_hal_busio_uart_write(&self->uart, slots, count, &errcode);
+    if (errcode == 0 &&
+        common_hal_busio_uart_read(&self->uart, slots, count, &errcode) == count) {
+        return;
+    }
+    // Without an echo the bus wiring is broken.
+    mp_raise_OSError(MP_EIO);
 }
 
 bool common_hal_busio_onewire_reset(busio_onewire_obj_t* self) {
-    return shared_module_bitbangio_onewire_reset(&self->bitbang);
+    if (!self->use_uart) {
+        return shared_module_bitbangio_onewire_reset(&self->bitbang);
+    }
+    uint8_t slot = RESET_PULSE;
+    common_hal_busio_uart_set_baudrate(&self->uart, RESET_BAUDRATE);
+    transfer_slots(self, &slot, 1);
+    common_hal_busio_uart_set_baudrate(&self->uart, SLOT_BAUDRATE);
+    return slot == RESET_PULSE;
 }
 
 bool common_hal_busio_onewire_read_bit(busio_onewire_obj_t* self) {
-    return shared_module_bitbangio_onewire_read_bit(&self->bitbang);
+    uint8_t slot = SLOT_ONE;
+    transfer_slots(self, &slot, 1);
+    return slot == SLOT_ONE;
 }
 
 void common_hal_busio_onewire_write_bit(busio_onewire_obj_t* self,
         bool bit) {
-    shared_module_bitbangio_onewire_write_bit(&self->bitbang, bit);
+    uint8_t slot = bit ? SLOT_ONE : SLOT_ZERO;
+    transfer_slots(self, &slot, 1);
+}
+
+void common_hal_busio_onewire_write(busio_onewire_obj_t* self, const uint8_t* data, size_t len) {
+    uint8_t slots[BATCH_BYTES * 8];
+    while (len > 0) {
+        size_t count = MIN(len, BATCH_BYTES);
+        for (size_t i = 0; i < count * 8; i++) {
+            slots[i] = (data[i / 8] >> (i % 8)) & 1 ? SLOT_ONE : SLOT_ZERO;
+        }
+        transfer_slots(self, slots, count * 8);
+        data += count;
+        len -= count;
+    }
+}
+
+void common_hal_busio_onewire_readinto(busio_onewire_obj_t* self, uint8_t* data, size_t len) {
+    uint8_t slots[BATCH_BYTES * 8];
+    while (len > 0) {
+        size_t count = MIN(len, BATCH_BYTES);
+        memset(slots, SLOT_ONE, count * 8);
+        transfer_slots(self, slots, count * 8);
+        memset(data, 0, count);
+        for (size_t i = 0; i < count * 8; i++) {
+            if (slots[i] == SLOT_ONE) {
+                data[i / 8] |= 1 << (i % 8);
+            }
+        }
+        data += count;
+        len -= count;
+    }
+}
+
+// One pass of the ROM search from Maxim application note 187. rom holds the last ROM found and
+// is replaced by the next one. last_discrepancy is the bit, numbered from one, where the next
+// pass takes the other branch. It starts at zero and is zero again after the last device.
+bool common_hal_busio_onewire_search(busio_onewire_obj_t* self, uint8_t* rom, uint8_t* last_discrepancy) {
+    if (common_hal_busio_onewire_reset(self)) {
+        return false;
+    }
+    uint8_t command = 0xf0;
+    common_hal_busio_onewire_write(self, &command, 1);
+
+    uint8_t last_zero = 0;
+    for (uint8_t bit_number = 1; bit_number <= 64; bit_number++) {
+        // Every device sends its bit and then the complement.
+        uint8_t slots[2] = {SLOT_ONE, SLOT_ONE};
+        transfer_slots(self, slots, 2);
+        bool bit = slots[0] == SLOT_ONE;
+        bool complement = slots[1] == SLOT_ONE;
+        uint8_t index = (bit_number - 1) / 8;
+        uint8_t mask = 1 << ((bit_number - 1) % 8);
+        bool direction;
+        if (bit && complement) {
+            // Nobody answered.
+            return false;
+        } else if (bit != complement) {
+            direction = bit;
+        } else {
+            if (bit_number < *last_discrepancy) {
+                direction = (rom[index] & mask) != 0;
+            } else {
+                direction = bit_number == *last_discrepancy;
+            }
+            if (!direction) {
+                last_zero = bit_number;
+            }
+        }
+        if (direction) {
+            rom[index] |= mask;
+        } else {
+            rom[index] &= ~mask;
+        }
+        common_hal_busio_onewire_write_bit(self, direction);
+    }
+    *last_discrepancy = last_zero;
+    return true;
 }
@@ -27,6 +27,7 @@
 #ifndef MICROPY_INCLUDED_ATMEL_SAMD_SHARED_MODULE_BUSIO_ONEWIRE_H
 #define MICROPY_INCLUDED_ATMEL_SAMD_SHARED_MODULE_BUSIO_ONEWIRE_H
 
+#include "common-hal/busio/UART.h"
 #include "shared-module/bitbangio/types.h"
 
 #include "py/obj.h"
@@ -34,6 +35,9 @@
 typedef struct {
     mp_obj_base_t base;
     bitbangio_onewire_obj_t bitbang;
+    // Used instead of bitbang when a tx pin is given.
+    busio_uart_obj_t uart;
+    bool use_uart;
 } busio_onewire_obj_t;
 
 #endif // MICROPY_INCLUDED_ATMEL_SAMD_SHARED_MODULE_BUSIO_ONEWIRE_H
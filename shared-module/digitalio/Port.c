@@ -0,0 +1,238 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/digitalio/Port.h"
+
+#include "py/runtime.h"
+
+void common_hal_digitalio_port_construct(digitalio_port_obj_t* self,
+    const mcu_pin_obj_t** pins, uint8_t pin_count, const mcu_pin_obj_t* strobe) {
+    self->pin_count = pin_count;
+    self->pins = m_new(digitalio_digitalinout_obj_t, pin_count);
+    self->pin_groups = m_new(uint8_t, pin_count);
+    self->pin_masks = m_new(uint32_t, pin_count);
+    self->group_count = 0;
+    self->use_registers = true;
+    self->output = false;
+
+    // Sort the pins into groups by the registers that drive them.
+    for (uint8_t i = 0; i < pin_count; i++) {
+        digitalio_digitalinout_obj_t* pin = &self->pins[i];
+        pin->base.type = &digitalio_digitalinout_type;
+        common_hal_digitalio_digitalinout_construct(pin, pins[i]);
+
+        digitalinout_registers_t registers;
+        if (!self->use_registers ||
+            !common_hal_digitalio_digitalinout_get_registers(pin, &registers)) {
+            self->use_registers = false;
+            continue;
+        }
+        uint8_t g;
+        for (g = 0; g < self->group_count; g++) {
+            if (self->groups[g].registers.set == registers.set) {
+                break;
+            }
+        }
+        digitalio_port_group_t* group = &self->groups[g];
+        if (g == self->group_count) {
+            if (g == DIGITALIO_PORT_MAX_GROUPS) {
+                self->use_registers = false;
+                continue;
+            }
+            self->group_count++;
+            group->registers = registers;
+            group->registers.mask = 0;
+            group->contiguous = true;
+            group->first_bit = i;
+            group->shift = __builtin_ctz(registers.mask);
+        }
+        uint8_t expected_bit = group->shift + i - group->first_bit;
+        if (expected_bit >= 32 || registers.mask != (1u << expected_bit)) {
+            group->contiguous = false;
+        }
+        group->registers.mask |= registers.mask;
+        self->pin_groups[i] = g;
+        self->pin_masks[i] = registers.mask;
+    }
+
+    self->has_strobe = strobe != NULL;
+    if (self->has_strobe) {
+        self->strobe.base.type = &digitalio_digitalinout_type;
+        common_hal_digitalio_digitalinout_construct(&self->strobe, strobe);
+        common_hal_digitalio_digitalinout_switch_to_output(&self->strobe, true, DRIVE_MODE_PUSH_PULL);
+        if (!common_hal_digitalio_digitalinout_get_registers(&self->strobe, &self->strobe_registers)) {
+            self->use_registers = false;
+        }
+    }
+}
+
+bool common_hal_digitalio_port_deinited(digitalio_port_obj_t* self) {
+    return self->pins == NULL;
+}
+
+void common_hal_digitalio_port_deinit(digitalio_port_obj_t* self) {
+    if (common_hal_digitalio_port_deinited(self)) {
+        return;
+    }
+    for (uint8_t i = 0; i < self->pin_count; i++) {
+        common_hal_digitalio_digitalinout_deinit(&self->pins[i]);
+    }
+    if (self->has_strobe) {
+        common_hal_digitalio_digitalinout_deinit(&self->strobe);
+    }
+    self->pins = NULL;
+}
+
+void common_hal_digitalio_port_switch_to_input(digitalio_port_obj_t* self) {
+    for (uint8_t i = 0; i < self->pin_count; i++) {
+        common_hal_digitalio_digitalinout_switch_to_input(&self->pins[i], PULL_NONE);
+    }
+    self->output = false;
+}
+
+void common_hal_digitalio_port_switch_to_output(digitalio_port_obj_t* self, uint32_t value) {
+    for (uint8_t i = 0; i < self->pin_count; i++) {
+        common_hal_digitalio_digitalinout_switch_to_output(&self->pins[i], (value >> i) & 1,
+            DRIVE_MODE_PUSH_PULL);
+    }
+    self->output = true;
+}
+
+bool common_hal_digitalio_port_is_output(digitalio_port_obj_t* self) {
+    return self->output;
+}
+
+uint32_t common_hal_digitalio_port_get_value(digitalio_port_obj_t* self) {
+    uint32_t value = 0;
+    if (!self->use_registers || self->output) {
+        // Output values are read back from the output latches by digitalio.
+        for (uint8_t i = 0; i < self->pin_count; i++) {
+            if (common_hal_digitalio_digitalinout_get_value(&self->pins[i])) {
+                value |= 1u << i;
+            }
+        }
+        return value;
+    }
+
+    uint32_t inputs[DIGITALIO_PORT_MAX_GROUPS];
+    bool scattered = false;
+    for (uint8_t g = 0; g < self->group_count; g++) {
+        const digitalio_port_group_t* group = &self->groups[g];
+        inputs[g] = *group->registers.input & group->registers.mask;
+        if (group->contiguous) {
+            value |= (inputs[g] >> group->shift) << group->first_bit;
+        } else {
+            scattered = true;
+        }
+    }
+    if (scattered) {
+        for (uint8_t i = 0; i < self->pin_count; i++) {
+            uint8_t g = self->pin_groups[i];
+            if (!self->groups[g].contiguous && (inputs[g] & self->pin_masks[i]) != 0) {
+                value |= 1u << i;
+            }
+        }
+    }
+    return value;
+}
+
+// Changes every pin of a group with one write to its set register and one to its clear register.
+static void set_value_by_registers(digitalio_port_obj_t* self, uint32_t value) {
+    uint32_t bits[DIGITALIO_PORT_MAX_GROUPS];
+    bool scattered = false;
+    for (uint8_t g = 0; g < self->group_count; g++) {
+        const digitalio_port_group_t* group = &self->groups[g];
+        if (group->contiguous) {
+            bits[g] = ((value >> group->first_bit) << group->shift) & group->registers.mask;
+        } else {
+            bits[g] = 0;
+            scattered = true;
+        }
+    }
+    if (scattered) {
+        for (uint8_t i = 0; i < self->pin_count; i++) {
+            if ((value & (1u << i)) != 0 && !self->groups[self->pin_groups[i]].contiguous) {
+                bits[self->pin_groups[i]] |= self->pin_masks[i];
+            }
+        }
+    }
+    for (uint8_t g = 0; g < self->group_count; g++) {
+        const digitalinout_registers_t* registers = &self->groups[g].registers;
+        *registers->set = bits[g];
+        *registers->clear = registers->mask & ~bits[g];
+    }
+}
+
+void common_hal_digitalio_port_set_value(digitalio_port_obj_t* self, uint32_t value) {
+    if (self->use_registers) {
+        set_value_by_registers(self, value);
+        return;
+    }
+    for (uint8_t i = 0; i < self->pin_count; i++) {
+        common_hal_digitalio_digitalinout_set_value(&self->pins[i], (value >> i) & 1);
+    }
+}
+
+static uint32_t get_item(const uint8_t* data, size_t index, size_t itemsize) {
+    if (itemsize == 4) {
+        return ((const uint32_t*) data)[index];
+    } else if (itemsize == 2) {
+        return ((const uint16_t*) data)[index];
+    }
+    return data[index];
+}
+
+void common_hal_digitalio_port_write(digitalio_port_obj_t* self,
+    const uint8_t* data, size_t len, size_t itemsize) {
+    if (!self->use_registers) {
+        for (size_t i = 0; i < len; i++) {
+            if (self->has_strobe) {
+                common_hal_digitalio_digitalinout_set_value(&self->strobe, false);
+            }
+            common_hal_digitalio_port_set_value(self, get_item(data, i, itemsize));
+            if (self->has_strobe) {
+                common_hal_digitalio_digitalinout_set_value(&self->strobe, true);
+            }
+        }
+        return;
+    }
+
+    // Without a strobe pin these point at a dummy register so the loop has no branches.
+    volatile uint32_t dummy_register;
+    volatile uint32_t* strobe_clear = &dummy_register;
+    volatile uint32_t* strobe_set = &dummy_register;
+    uint32_t strobe_mask = 0;
+    if (self->has_strobe) {
+        strobe_clear = self->strobe_registers.clear;
+        strobe_set = self->strobe_registers.set;
+        strobe_mask = self->strobe_registers.mask;
+    }
+    for (size_t i = 0; i < len; i++) {
+        *strobe_clear = strobe_mask;
+        set_value_by_registers(self, get_item(data, i, itemsize));
+        *strobe_set = strobe_mask;
+    }
+}
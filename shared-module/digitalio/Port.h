@@ -0,0 +1,65 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_DIGITALIO_PORT_H
+#define MICROPY_INCLUDED_SHARED_MODULE_DIGITALIO_PORT_H
+
+#include <stdint.h>
+
+#include "common-hal/digitalio/DigitalInOut.h"
+#include "shared-bindings/digitalio/DigitalInOut.h"
+
+#include "py/obj.h"
+
+#define DIGITALIO_PORT_MAX_PINS (32)
+#define DIGITALIO_PORT_MAX_GROUPS (4)
+
+// The pins of a Port that share set, clear and input registers.
+typedef struct {
+    digitalinout_registers_t registers;
+    // When the group's pins are consecutive in both the Port and the hardware port, a value is
+    // shifted straight into place instead of being assembled a pin at a time.
+    bool contiguous;
+    uint8_t first_bit;
+    uint8_t shift;
+} digitalio_port_group_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    digitalio_digitalinout_obj_t* pins;
+    uint8_t* pin_groups;
+    uint32_t* pin_masks;
+    digitalio_port_group_t groups[DIGITALIO_PORT_MAX_GROUPS];
+    digitalio_digitalinout_obj_t strobe;
+    digitalinout_registers_t strobe_registers;
+    uint8_t pin_count;
+    uint8_t group_count;
+    bool has_strobe:1;
+    bool use_registers:1;
+    bool output:1;
+} digitalio_port_obj_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_DIGITALIO_PORT_H
@@ -28,6 +28,7 @@
 
 #include <string.h>
 
+#include "ports/stm32/font_petme128_8x8.h"
 #include "py/runtime.h"
 
 void common_hal_displayio_bitmap_construct(displayio_bitmap_t *self, uint32_t width,
@@ -45,24 +46,12 @@ void common_hal_displayio_bitmap_construct(displayio_bitmap_t *self, uint32_t wi
     self->data = m_malloc(self->stride * height * sizeof(size_t), false);
     self->read_only = false;
     self->bits_per_value = bits_per_value;
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
 
     if (bits_per_value > 8 && bits_per_value != 16 && bits_per_value != 32) {
         mp_raise_NotImplementedError(translate("Invalid bits per value"));
     }
-
-    // Division and modulus can be slow because it has to handle any integer. We know bits_per_value
-    // is a power of two. We divide and mod by bits_per_value to compute the offset into the byte
-    // array. So, we can the offset computation to simplify to a shift for division and mask for mod.
-
-    self->x_shift = 0; // Used to divide the index by the number of pixels per word. Its used in a
-                       // shift which effectively divides by 2 ** x_shift.
-    uint32_t power_of_two = 1;
-    while (power_of_two < align_bits / bits_per_value ) {
-        self->x_shift++;
-        power_of_two <<= 1;
-    }
-    self->x_mask = (1 << self->x_shift) - 1; // Used as a modulus on the x value
-    self->bitmask = (1 << bits_per_value) - 1;
 }
 
 uint16_t common_hal_displayio_bitmap_get_height(displayio_bitmap_t *self) {
@@ -77,50 +66,462 @@ uint32_t common_hal_displayio_bitmap_get_bits_per_value(displayio_bitmap_t *self
     return self->bits_per_value;
 }
 
+// The packed accessors are always inlined with a constant bits_per_value so that the compiler
+// turns the divisions and modulos into shifts and masks specialized for each depth.
+static inline uint32_t get_packed(const size_t* row, uint16_t x, const uint8_t bits_per_value) {
+    const uint8_t values_per_word = sizeof(size_t) * 8 / bits_per_value;
+    uint8_t shift = sizeof(size_t) * 8 - (x % values_per_word + 1) * bits_per_value;
+    return (row[x / values_per_word] >> shift) & ((1u << bits_per_value) - 1);
+}
+
+static inline void set_packed(size_t* row, uint16_t x, uint32_t value, const uint8_t bits_per_value) {
+    const uint8_t values_per_word = sizeof(size_t) * 8 / bits_per_value;
+    const size_t mask = (1u << bits_per_value) - 1;
+    uint8_t shift = sizeof(size_t) * 8 - (x % values_per_word + 1) * bits_per_value;
+    size_t* word = row + x / values_per_word;
+    *word = (*word & ~(mask << shift)) | ((value & mask) << shift);
+}
+
+// Reads consecutive values by shifting them out of the top of each word in turn.
+static inline void get_packed_row(const size_t* row, uint16_t x, uint32_t* values, uint16_t count,
+        const uint8_t bits_per_value) {
+    const uint8_t values_per_word = sizeof(size_t) * 8 / bits_per_value;
+    const size_t* word = row + x / values_per_word;
+    uint8_t left = values_per_word - x % values_per_word;
+    size_t bits = *word << (x % values_per_word * bits_per_value);
+    for (uint16_t i = 0; i < count; i++) {
+        if (left == 0) {
+            word++;
+            bits = *word;
+            left = values_per_word;
+        }
+        values[i] = bits >> (sizeof(size_t) * 8 - bits_per_value);
+        bits <<= bits_per_value;
+        left--;
+    }
+}
+
+static inline void set_packed_row(size_t* row, uint16_t x, const uint32_t* values, uint16_t count,
+        const uint8_t bits_per_value) {
+    for (uint16_t i = 0; i < count; i++) {
+        set_packed(row, x + i, values[i], bits_per_value);
+    }
+}
+
 uint32_t common_hal_displayio_bitmap_get_pixel(displayio_bitmap_t *self, int16_t x, int16_t y) {
     if (x >= self->width || x < 0 || y >= self->height || y < 0) {
         return 0;
     }
-    int32_t row_start = y * self->stride;
-    uint32_t bytes_per_value = self->bits_per_value / 8;
-    if (bytes_per_value < 1) {
-        size_t word = self->data[row_start + (x >> self->x_shift)];
-
-        return (word >> (sizeof(size_t) * 8 - ((x & self->x_mask) + 1) * self->bits_per_value)) & self->bitmask;
-    } else {
-        size_t* row = self->data + row_start;
-        if (bytes_per_value == 1) {
+    size_t* row = self->data + y * self->stride;
+    switch (self->bits_per_value) {
+        case 1:
+            return get_packed(row, x, 1);
+        case 2:
+            return get_packed(row, x, 2);
+        case 4:
+            return get_packed(row, x, 4);
+        case 8:
             return ((uint8_t*) row)[x];
-        } else if (bytes_per_value == 2) {
+        case 16:
             return ((uint16_t*) row)[x];
-        } else if (bytes_per_value == 4) {
+        case 32:
             return ((uint32_t*) row)[x];
-        }
     }
     return 0;
 }
 
+MP_RAMFUNC void common_hal_displayio_bitmap_get_row(displayio_bitmap_t *self, int16_t x, int16_t y,
+        uint32_t* values, uint16_t count) {
+    if (y >= self->height || y < 0 || x < 0 || x + count > self->width) {
+        for (uint16_t i = 0; i < count; i++) {
+            values[i] = common_hal_displayio_bitmap_get_pixel(self, x + i, y);
+        }
+        return;
+    }
+    size_t* row = self->data + y * self->stride;
+    switch (self->bits_per_value) {
+        case 1:
+            get_packed_row(row, x, values, count, 1);
+            break;
+        case 2:
+            get_packed_row(row, x, values, count, 2);
+            break;
+        case 4:
+            get_packed_row(row, x, values, count, 4);
+            break;
+        case 8:
+            for (uint16_t i = 0; i < count; i++) {
+                values[i] = ((uint8_t*) row)[x + i];
+            }
+            break;
+        case 16:
+            for (uint16_t i = 0; i < count; i++) {
+                values[i] = ((uint16_t*) row)[x + i];
+            }
+            break;
+        case 32:
+            memcpy(values, ((uint32_t*) row) + x, count * sizeof(uint32_t));
+            break;
+    }
+}
+
 void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value) {
+    common_hal_displayio_bitmap_set_row(self, x, y, &value, 1);
+}
+
+// Writes values without any bounds, read only or dirty tracking. Callers are responsible for
+// those.
+static void write_row(displayio_bitmap_t *self, int16_t x, int16_t y, const uint32_t* values,
+        uint16_t count) {
+    size_t* row = self->data + y * self->stride;
+    switch (self->bits_per_value) {
+        case 1:
+            set_packed_row(row, x, values, count, 1);
+            break;
+        case 2:
+            set_packed_row(row, x, values, count, 2);
+            break;
+        case 4:
+            set_packed_row(row, x, values, count, 4);
+            break;
+        case 8:
+            for (uint16_t i = 0; i < count; i++) {
+                ((uint8_t*) row)[x + i] = values[i];
+            }
+            break;
+        case 16:
+            for (uint16_t i = 0; i < count; i++) {
+                ((uint16_t*) row)[x + i] = values[i];
+            }
+            break;
+        case 32:
+            memcpy(((uint32_t*) row) + x, values, count * sizeof(uint32_t));
+            break;
+    }
+}
+
+static void mark_dirty(displayio_bitmap_t *self, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
     if (self->read_only) {
         mp_raise_RuntimeError(translate("Read-only object"));
     }
-    int32_t row_start = y * self->stride;
-    uint32_t bytes_per_value = self->bits_per_value / 8;
-    if (bytes_per_value < 1) {
-        uint32_t bit_position = (sizeof(size_t) * 8 - ((x & self->x_mask) + 1) * self->bits_per_value);
-        uint32_t index = row_start + (x >> self->x_shift);
-        uint32_t word = self->data[index];
-        word &= ~(self->bitmask << bit_position);
-        word |= (value & self->bitmask) << bit_position;
-        self->data[index] = word;
-    } else {
-        size_t* row = self->data + row_start;
-        if (bytes_per_value == 1) {
-            ((uint8_t*) row)[x] = value;
-        } else if (bytes_per_value == 2) {
-            ((uint16_t*) row)[x] = value;
-        } else if (bytes_per_value == 4) {
-            ((uint32_t*) row)[x] = value;
+    displayio_area_t area = {x1, y1, x2, y2, NULL};
+    displayio_area_union(&self->dirty_area, &area, &self->dirty_area);
+}
+
+void common_hal_displayio_bitmap_set_row(displayio_bitmap_t *self, int16_t x, int16_t y,
+        const uint32_t* values, uint16_t count) {
+    mark_dirty(self, x, y, x + count, y + 1);
+    write_row(self, x, y, values, count);
+}
+
+// Fills the packed values from x1 up to x2 by setting the partial words at either end one value
+// at a time and the whole words in between to a repeating pattern.
+static inline void fill_packed_row(size_t* row, uint16_t x1, uint16_t x2, uint32_t value,
+        const uint8_t bits_per_value) {
+    const uint8_t values_per_word = sizeof(size_t) * 8 / bits_per_value;
+    while (x1 < x2 && x1 % values_per_word != 0) {
+        set_packed(row, x1++, value, bits_per_value);
+    }
+    size_t pattern = 0;
+    for (uint8_t i = 0; i < values_per_word; i++) {
+        pattern = (pattern << bits_per_value) | value;
+    }
+    while (x1 + values_per_word <= x2) {
+        row[x1 / values_per_word] = pattern;
+        x1 += values_per_word;
+    }
+    while (x1 < x2) {
+        set_packed(row, x1++, value, bits_per_value);
+    }
+}
+
+// Fills row y from x1 up to x2 without any bounds, read only or dirty tracking.
+static void fill_row(displayio_bitmap_t *self, int16_t y, int16_t x1, int16_t x2, uint32_t value) {
+    size_t* row = self->data + y * self->stride;
+    switch (self->bits_per_value) {
+        case 1:
+            fill_packed_row(row, x1, x2, value, 1);
+            break;
+        case 2:
+            fill_packed_row(row, x1, x2, value, 2);
+            break;
+        case 4:
+            fill_packed_row(row, x1, x2, value, 4);
+            break;
+        case 8:
+            memset(((uint8_t*) row) + x1, value, x2 - x1);
+            break;
+        case 16:
+            for (int16_t x = x1; x < x2; x++) {
+                ((uint16_t*) row)[x] = value;
+            }
+            break;
+        case 32:
+            for (int16_t x = x1; x < x2; x++) {
+                ((uint32_t*) row)[x] = value;
+            }
+            break;
+    }
+}
+
+void common_hal_displayio_bitmap_fill_region(displayio_bitmap_t *self, int16_t x1, int16_t y1,
+        int16_t x2, int16_t y2, uint32_t value) {
+    x1 = MAX(x1, 0);
+    y1 = MAX(y1, 0);
+    x2 = MIN(x2, self->width);
+    y2 = MIN(y2, self->height);
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    mark_dirty(self, x1, y1, x2, y2);
+
+    for (int16_t y = y1; y < y2; y++) {
+        fill_row(self, y, x1, x2, value);
+    }
+}
+
+void common_hal_displayio_bitmap_fill(displayio_bitmap_t *self, uint32_t value) {
+    common_hal_displayio_bitmap_fill_region(self, 0, 0, self->width, self->height, value);
+}
+
+void common_hal_displayio_bitmap_blit(displayio_bitmap_t *self, int16_t x, int16_t y,
+        displayio_bitmap_t *source, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+        bool skip, uint32_t skip_index) {
+    // Clip the source rectangle to the source bitmap and then to the destination.
+    if (x1 < 0) {
+        x -= x1;
+        x1 = 0;
+    }
+    if (y1 < 0) {
+        y -= y1;
+        y1 = 0;
+    }
+    x2 = MIN(x2, source->width);
+    y2 = MIN(y2, source->height);
+    if (x < 0) {
+        x1 -= x;
+        x = 0;
+    }
+    if (y < 0) {
+        y1 -= y;
+        y = 0;
+    }
+    x2 = MIN(x2, x1 + self->width - x);
+    y2 = MIN(y2, y1 + self->height - y);
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    int16_t width = x2 - x1;
+    int16_t height = y2 - y1;
+    mark_dirty(self, x, y, x + width, y + height);
+
+    // When blitting within one bitmap, walk in the direction that reads each value before it is
+    // overwritten.
+    bool bottom_up = self == source && y > y1;
+    bool right_to_left = self == source && y == y1 && x > x1;
+
+    if (!skip && self->bits_per_value == source->bits_per_value && self->bits_per_value >= 8) {
+        uint8_t bytes_per_value = self->bits_per_value / 8;
+        for (int16_t i = 0; i < height; i++) {
+            int16_t row_offset = bottom_up ? height - 1 - i : i;
+            uint8_t* dest = (uint8_t*) (self->data + (y + row_offset) * self->stride);
+            const uint8_t* src = (uint8_t*) (source->data + (y1 + row_offset) * source->stride);
+            memmove(dest + x * bytes_per_value, src + x1 * bytes_per_value, width * bytes_per_value);
+        }
+        return;
+    }
+
+    uint32_t values[32];
+    for (int16_t i = 0; i < height; i++) {
+        int16_t row_offset = bottom_up ? height - 1 - i : i;
+        int16_t done = 0;
+        while (done < width) {
+            uint16_t count = MIN(width - done, (int16_t) MP_ARRAY_SIZE(values));
+            int16_t column_offset = right_to_left ? width - done - count : done;
+            common_hal_displayio_bitmap_get_row(source, x1 + column_offset, y1 + row_offset, values, count);
+            if (!skip) {
+                write_row(self, x + column_offset, y + row_offset, values, count);
+            } else {
+                // Write each run of values that aren't skipped.
+                uint16_t start = 0;
+                while (start < count) {
+                    while (start < count && values[start] == skip_index) {
+                        start++;
+                    }
+                    uint16_t end = start;
+                    while (end < count && values[end] != skip_index) {
+                        end++;
+                    }
+                    if (end > start) {
+                        write_row(self, x + column_offset + start, y + row_offset, values + start, end - start);
+                    }
+                    start = end;
+                }
+            }
+            done += count;
+        }
+    }
+}
+
+void common_hal_displayio_bitmap_draw_line(displayio_bitmap_t *self, int16_t x1, int16_t y1,
+        int16_t x2, int16_t y2, uint32_t value) {
+    int16_t left = MAX(MIN(x1, x2), 0);
+    int16_t top = MAX(MIN(y1, y2), 0);
+    int16_t right = MIN(MAX(x1, x2) + 1, self->width);
+    int16_t bottom = MIN(MAX(y1, y2) + 1, self->height);
+    if (left >= right || top >= bottom) {
+        return;
+    }
+    mark_dirty(self, left, top, right, bottom);
+
+    // Bresenham's algorithm, collecting the pixels on each row into a run that is filled at once.
+    int32_t dx = x2 > x1 ? x2 - x1 : x1 - x2;
+    int32_t dy = y2 > y1 ? y1 - y2 : y2 - y1;
+    int8_t step_x = x1 < x2 ? 1 : -1;
+    int8_t step_y = y1 < y2 ? 1 : -1;
+    int32_t error = dx + dy;
+    int16_t x = x1;
+    int16_t y = y1;
+    int16_t run_start = x;
+    while (true) {
+        bool done = x == x2 && y == y2;
+        int32_t error2 = 2 * error;
+        bool move_x = !done && error2 >= dy;
+        bool move_y = !done && error2 <= dx;
+        if (done || move_y) {
+            int16_t run_x1 = MAX(MIN(run_start, x), left);
+            int16_t run_x2 = MIN(MAX(run_start, x) + 1, right);
+            if (y >= top && y < bottom && run_x1 < run_x2) {
+                fill_row(self, y, run_x1, run_x2, value);
+            }
+        }
+        if (done) {
+            break;
+        }
+        if (move_x) {
+            error += dy;
+            x += step_x;
+        }
+        if (move_y) {
+            error += dx;
+            y += step_y;
+            run_start = x;
+        }
+    }
+}
+
+void common_hal_displayio_bitmap_fill_polygon(displayio_bitmap_t *self, const int16_t* xs,
+        const int16_t* ys, size_t count, uint32_t value) {
+    if (count < 3) {
+        return;
+    }
+    int16_t left = xs[0];
+    int16_t right = xs[0];
+    int16_t top = ys[0];
+    int16_t bottom = ys[0];
+    for (size_t i = 1; i < count; i++) {
+        left = MIN(left, xs[i]);
+        right = MAX(right, xs[i]);
+        top = MIN(top, ys[i]);
+        bottom = MAX(bottom, ys[i]);
+    }
+    left = MAX(left, 0);
+    top = MAX(top, 0);
+    right = MIN(right, self->width);
+    bottom = MIN(bottom, self->height);
+    if (left >= right || top >= bottom) {
+        return;
+    }
+    mark_dirty(self, left, top, right, bottom);
+
+    // Fill the pixels whose centers are inside the polygon using the even-odd rule. Each row
+    // finds where the edges cross its center line, in 1/256ths of a pixel, and fills between
+    // pairs of crossings.
+    int32_t* crossings = m_new(int32_t, count);
+    for (int16_t y = top; y < bottom; y++) {
+        size_t crossing_count = 0;
+        for (size_t i = 0; i < count; i++) {
+            size_t j = i + 1 == count ? 0 : i + 1;
+            int32_t ey1 = ys[i];
+            int32_t ey2 = ys[j];
+            if ((y < ey1) == (y < ey2)) {
+                continue;
+            }
+            int64_t numerator = (int64_t) (2 * (y - ey1) + 1) * (xs[j] - xs[i]) * 128;
+            int32_t crossing = xs[i] * 256 + numerator / (ey2 - ey1);
+            // Insert in order. Polygons have few edges so this is cheap.
+            size_t k = crossing_count++;
+            while (k > 0 && crossings[k - 1] > crossing) {
+                crossings[k] = crossings[k - 1];
+                k--;
+            }
+            crossings[k] = crossing;
         }
+        for (size_t i = 0; i + 1 < crossing_count; i += 2) {
+            // Pixel x is filled when its center, x * 256 + 128, is in [start, end).
+            int32_t x1 = MAX((crossings[i] - 128 + 255) >> 8, left);
+            int32_t x2 = MIN((crossings[i + 1] - 128 + 255) >> 8, right);
+            if (x1 < x2) {
+                fill_row(self, y, x1, x2, value);
+            }
+        }
+    }
+    m_del(int32_t, crossings, count);
+}
+
+void common_hal_displayio_bitmap_scroll(displayio_bitmap_t *self, int16_t dx, int16_t dy) {
+    common_hal_displayio_bitmap_blit(self, dx, dy, self, 0, 0, self->width, self->height, false, 0);
+}
+
+void common_hal_displayio_bitmap_draw_text(displayio_bitmap_t *self, int16_t x, int16_t y,
+        const uint8_t* text, size_t len, uint32_t value) {
+    int32_t left = MAX(x, 0);
+    int32_t top = MAX(y, 0);
+    int32_t right = MIN(x + 8 * (int32_t) len, self->width);
+    int32_t bottom = MIN(y + 8, self->height);
+    if (left >= right || top >= bottom) {
+        return;
+    }
+    mark_dirty(self, left, top, right, bottom);
+
+    // Each glyph is eight columns of eight pixels with the top one in the least significant bit.
+    // Go across the whole string a pixel row at a time and fill each run of set pixels at once.
+    for (int32_t row = top; row < bottom; row++) {
+        uint8_t bit = 1 << (row - y);
+        int32_t run_start = -1;
+        for (int32_t column = left; column < right; column++) {
+            int32_t offset = column - x;
+            uint8_t c = text[offset / 8];
+            if (c < 32 || c > 127) {
+                c = 127;
+            }
+            bool set = (font_petme128_8x8[(c - 32) * 8 + offset % 8] & bit) != 0;
+            if (set && run_start < 0) {
+                run_start = column;
+            } else if (!set && run_start >= 0) {
+                fill_row(self, row, run_start, column, value);
+                run_start = -1;
+            }
+        }
+        if (run_start >= 0) {
+            fill_row(self, row, run_start, right, value);
+        }
+    }
+}
+
+displayio_area_t* displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t* tail) {
+    if (displayio_area_empty(&self->dirty_area)) {
+        return tail;
+    }
+    self->dirty_area.next = tail;
+    return &self->dirty_area;
+}
+
+void displayio_bitmap_finish_refresh(displayio_bitmap_t *self) {
+    // Read only bitmaps may live in flash and never change.
+    if (self->read_only) {
+        return;
     }
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
 }
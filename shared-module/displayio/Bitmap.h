@@ -31,6 +31,7 @@
 #include <stdint.h>
 
 #include "py/obj.h"
+#include "shared-module/displayio/area.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -39,10 +40,16 @@ typedef struct {
     size_t* data;
     uint16_t stride; // size_t's
     uint8_t bits_per_value;
-    uint8_t x_shift;
-    size_t x_mask;
-    uint16_t bitmask;
+    displayio_area_t dirty_area; // Stored as bitmap coordinates.
     bool read_only;
 } displayio_bitmap_t;
 
+// Returns where row y is stored. Values are packed bits_per_value apart.
+static inline const void* displayio_bitmap_get_row_data(const displayio_bitmap_t *self, int16_t y) {
+    return self->data + y * self->stride;
+}
+
+displayio_area_t* displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t* tail);
+void displayio_bitmap_finish_refresh(displayio_bitmap_t *self);
+
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_BITMAP_H
@@ -31,12 +31,7 @@ void common_hal_displayio_colorconverter_construct(displayio_colorconverter_t* s
 
 bool common_hal_displayio_colorconverter_convert(displayio_colorconverter_t *self, uint32_t input_color, uint16_t* output_color) {
     // TODO(tannewt): Validate the color input against the input format.
-    uint32_t r5 = (input_color >> 19);
-    uint32_t g6 = (input_color >> 10) & 0x3f;
-    uint32_t b5 = (input_color >> 3) & 0x1f;
-    uint32_t packed = r5 << 11 | g6 << 5 | b5;
-    // swap bytes
-    *output_color = __builtin_bswap16(packed);
+    *output_color = displayio_colorconverter_convert_888_to_565_swapped(input_color);
     return true;
 }
 
@@ -36,6 +36,15 @@ typedef struct {
     mp_obj_base_t base;
 } displayio_colorconverter_t;
 
+// Converts RGB888 straight to RGB565 with the bytes swapped into display order. Inlined because
+// it is called for every pixel drawn through a ColorConverter.
+static inline uint16_t displayio_colorconverter_convert_888_to_565_swapped(uint32_t color) {
+    uint8_t r = color >> 16;
+    uint8_t g = color >> 8;
+    uint8_t b = color;
+    return (r & 0xf8) | g >> 5 | (g & 0x1c) << 11 | (b & 0xf8) << 5;
+}
+
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self);
 void displayio_colorconverter_finish_refresh(displayio_colorconverter_t *self);
 
@@ -27,14 +27,20 @@
 #include "shared-bindings/displayio/Display.h"
 
 #include "py/runtime.h"
+#if CIRCUITPY_MICROCONTROLLER
 #include "shared-bindings/displayio/FourWire.h"
 #include "shared-bindings/displayio/ParallelBus.h"
+#endif
+#if CIRCUITPY_SIMULATOR
+#include "shared-bindings/displayio/VirtualBus.h"
+#endif
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "supervisor/shared/display.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "tick.h"
 
@@ -50,7 +56,16 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
     self->set_column_command = set_column_command;
     self->set_row_command = set_row_command;
     self->write_ram_command = write_ram_command;
+    self->set_vertical_scroll = set_vertical_scroll;
+    self->hardware_scroll = false;
+    self->scroll_offset = 0;
     self->refresh = false;
+    self->refresh_in_progress = false;
+    self->refresh_window_set = false;
+    self->sending = false;
+    self->refresh_time_slice = DISPLAYIO_DEFAULT_REFRESH_TIME_SLICE;
+    memset(&self->refresh_stats, 0, sizeof(self->refresh_stats));
+    memset(&self->last_refresh_stats, 0, sizeof(self->last_refresh_stats));
     self->current_group = NULL;
     self->colstart = colstart;
     self->rowstart = rowstart;
@@ -58,6 +73,7 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
     self->data_as_commands = data_as_commands;
     self->single_byte_bounds = single_byte_bounds;
 
+    #if CIRCUITPY_MICROCONTROLLER
     if (MP_OBJ_IS_TYPE(bus, &displayio_parallelbus_type)) {
         self->begin_transaction = common_hal_displayio_parallelbus_begin_transaction;
         self->send = common_hal_displayio_parallelbus_send;
@@ -66,7 +82,16 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
         self->begin_transaction = common_hal_displayio_fourwire_begin_transaction;
         self->send = common_hal_displayio_fourwire_send;
         self->end_transaction = common_hal_displayio_fourwire_end_transaction;
-    } else {
+    } else
+    #endif
+    #if CIRCUITPY_SIMULATOR
+    if (MP_OBJ_IS_TYPE(bus, &displayio_virtualbus_type)) {
+        self->begin_transaction = common_hal_displayio_virtualbus_begin_transaction;
+        self->send = common_hal_displayio_virtualbus_send;
+        self->end_transaction = common_hal_displayio_virtualbus_end_transaction;
+    } else
+    #endif
+    {
         mp_raise_ValueError(translate("Unsupported display bus type"));
     }
     self->bus = bus;
@@ -114,6 +139,12 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
 
     self->width = width;
     self->height = height;
+    self->area.x1 = 0;
+    self->area.y1 = 0;
+    self->area.x2 = width;
+    self->area.y2 = height;
+    self->area.next = NULL;
+    self->dirty_area_count = 0;
     rotation = rotation % 360;
     self->mirror_x = false;
     self->mirror_y = false;
@@ -132,6 +163,7 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
         }
     }
 
+    #if DISPLAYIO_BACKLIGHT
     // Always set the backlight type in case we're reusing memory.
     self->backlight_inout.base.type = &mp_type_NoneType;
     if (backlight_pin != NULL && common_hal_mcu_pin_is_free(backlight_pin)) {
@@ -148,6 +180,7 @@ void common_hal_displayio_display_construct(displayio_display_obj_t* self,
             }
         }
     }
+    #endif
 }
 
 void common_hal_displayio_display_show(displayio_display_obj_t* self, displayio_group_t* root_group) {
@@ -171,6 +204,56 @@ int32_t common_hal_displayio_display_wait_for_frame(displayio_display_obj_t* sel
     return 0;
 }
 
+static void _send_scroll_offset(displayio_display_obj_t* self) {
+    self->send(self->bus, true, &self->set_vertical_scroll, 1);
+    if (self->single_byte_bounds) {
+        uint8_t data = self->scroll_offset;
+        self->send(self->bus, self->data_as_commands, &data, 1);
+    } else {
+        uint16_t data = __builtin_bswap16(self->scroll_offset);
+        self->send(self->bus, self->data_as_commands, (uint8_t*) &data, 2);
+    }
+}
+
+bool common_hal_displayio_display_get_hardware_scroll(displayio_display_obj_t* self) {
+    return self->hardware_scroll;
+}
+
+bool common_hal_displayio_display_set_hardware_scroll(displayio_display_obj_t* self, bool hardware_scroll) {
+    if (hardware_scroll) {
+        // Displays that scroll memory rows across the display, or whose memory has rows that
+        // aren't shown, would scroll in the wrong direction or by the wrong amount.
+        if (self->set_vertical_scroll == 0 || self->transpose_xy || self->mirror_y || self->rowstart != 0) {
+            return false;
+        }
+    } else if (self->scroll_offset != 0) {
+        // Put memory back where code that writes to the display directly expects it.
+        while (!self->begin_transaction(self->bus)) {
+#ifdef MICROPY_VM_HOOK_LOOP
+            MICROPY_VM_HOOK_LOOP ;
+#endif
+        }
+        self->scroll_offset = 0;
+        _send_scroll_offset(self);
+        self->end_transaction(self->bus);
+        self->refresh = true;
+    }
+    self->hardware_scroll = hardware_scroll;
+    return true;
+}
+
+const displayio_refresh_stats_t* common_hal_displayio_display_get_refresh_stats(displayio_display_obj_t* self) {
+    return &self->last_refresh_stats;
+}
+
+uint32_t common_hal_displayio_display_get_refresh_time_slice(displayio_display_obj_t* self) {
+    return self->refresh_time_slice;
+}
+
+void common_hal_displayio_display_set_refresh_time_slice(displayio_display_obj_t* self, uint32_t microseconds) {
+    self->refresh_time_slice = microseconds;
+}
+
 bool common_hal_displayio_display_get_auto_brightness(displayio_display_obj_t* self) {
     return self->auto_brightness;
 }
@@ -188,6 +271,7 @@ void common_hal_displayio_display_set_auto_brightness(displayio_display_obj_t* s
 }
 
 mp_float_t common_hal_displayio_display_get_brightness(displayio_display_obj_t* self) {
+    #if DISPLAYIO_BACKLIGHT
     if (self->backlight_pwm.base.type == &pulseio_pwmout_type) {
         uint16_t duty_cycle = common_hal_pulseio_pwmout_get_duty_cycle(&self->backlight_pwm);
         return duty_cycle / ((mp_float_t) 0xffff);
@@ -198,12 +282,14 @@ mp_float_t common_hal_displayio_display_get_brightness(displayio_display_obj_t*
             return 0.0;
         }
     }
+    #endif
     return -1.0;
 }
 
 bool common_hal_displayio_display_set_brightness(displayio_display_obj_t* self, mp_float_t brightness) {
     self->updating_backlight = true;
     bool ok = false;
+    #if DISPLAYIO_BACKLIGHT
     if (self->backlight_pwm.base.type == &pulseio_pwmout_type) {
         common_hal_pulseio_pwmout_set_duty_cycle(&self->backlight_pwm, (uint16_t) (0xffff * brightness));
         ok = true;
@@ -211,6 +297,7 @@ bool common_hal_displayio_display_set_brightness(displayio_display_obj_t* self,
         common_hal_digitalio_digitalinout_set_value(&self->backlight_inout, brightness > 0.99);
         ok = true;
     }
+    #endif
     self->updating_backlight = false;
     return ok;
 }
@@ -260,20 +347,124 @@ bool displayio_display_frame_queued(displayio_display_obj_t* self) {
     return (ticks_ms - self->last_refresh) > 32;
 }
 
-bool displayio_display_refresh_queued(displayio_display_obj_t* self) {
-    return self->refresh || (self->current_group != NULL && displayio_group_needs_refresh(self->current_group));
+// Clips the area to the display and merges it into the dirty areas. Areas that overlap are joined.
+// When we run out of slots the area is joined with the dirty area that grows the least.
+static void _add_dirty_area(displayio_display_obj_t* self, const displayio_area_t* area) {
+    displayio_area_t clipped;
+    if (!displayio_area_compute_overlap(&self->area, area, &clipped)) {
+        return;
+    }
+    for (uint8_t i = 0; i < self->dirty_area_count; i++) {
+        displayio_area_t overlap;
+        if (displayio_area_compute_overlap(&self->dirty_areas[i], &clipped, &overlap)) {
+            displayio_area_union(&self->dirty_areas[i], &clipped, &self->dirty_areas[i]);
+            return;
+        }
+    }
+    if (self->dirty_area_count < DISPLAYIO_DIRTY_AREA_LIMIT) {
+        displayio_area_copy(&clipped, &self->dirty_areas[self->dirty_area_count]);
+        self->dirty_area_count++;
+        return;
+    }
+    uint8_t best = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for (uint8_t i = 0; i < self->dirty_area_count; i++) {
+        displayio_area_t joined;
+        displayio_area_union(&self->dirty_areas[i], &clipped, &joined);
+        uint32_t growth = displayio_area_size(&joined) - displayio_area_size(&self->dirty_areas[i]);
+        if (growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    displayio_area_union(&self->dirty_areas[best], &clipped, &self->dirty_areas[best]);
 }
 
-void displayio_display_finish_refresh(displayio_display_obj_t* self) {
+// When a TileGrid scrolls vertically and spans the whole height of the display, scroll the
+// display memory instead of redrawing it. Only the revealed rows and the unaffected columns to
+// either side of the grid are redrawn.
+static void _scroll_in_hardware(displayio_display_obj_t* self, const displayio_transform_t* transform) {
+    displayio_area_t grid_area;
+    int16_t pixels;
+    displayio_tilegrid_t* grid = displayio_group_find_vertical_scroll(self->current_group, transform, &grid_area, &pixels);
+    if (grid == NULL || pixels == 0 || grid_area.y1 > 0 || grid_area.y2 < self->height ||
+        pixels >= self->height || -pixels >= self->height) {
+        return;
+    }
+    displayio_area_t band;
+    if (!displayio_area_compute_overlap(&self->area, &grid_area, &band) ||
+        displayio_group_overlaps(self->current_group, grid, &band)) {
+        return;
+    }
+    if (!self->begin_transaction(self->bus)) {
+        return;
+    }
+    self->scroll_offset = (self->scroll_offset + self->height + pixels) % self->height;
+    _send_scroll_offset(self);
+    self->end_transaction(self->bus);
+    displayio_tilegrid_set_scrolled_in_hardware(grid);
+
+    displayio_area_t revealed = {0, self->height - pixels, self->width, self->height, NULL};
+    if (pixels < 0) {
+        revealed.y1 = 0;
+        revealed.y2 = -pixels;
+    }
+    _add_dirty_area(self, &revealed);
+    // The columns beside the grid moved too. Leave out the revealed rows so that these don't
+    // overlap the strip above and get merged into the whole display.
+    int16_t y1 = 0;
+    int16_t y2 = self->height;
+    if (pixels > 0) {
+        y2 = revealed.y1;
+    } else {
+        y1 = revealed.y2;
+    }
+    if (band.x1 > 0) {
+        displayio_area_t left = {0, y1, band.x1, y2, NULL};
+        _add_dirty_area(self, &left);
+    }
+    if (band.x2 < self->width) {
+        displayio_area_t right = {band.x2, y1, self->width, y2, NULL};
+        _add_dirty_area(self, &right);
+    }
+}
+
+bool displayio_display_refresh_queued(displayio_display_obj_t* self) {
+    self->dirty_area_count = 0;
+    const displayio_area_t* area = NULL;
+    if (self->current_group != NULL) {
+        // Always collect the areas so that layers know where they are drawn after this refresh.
+        displayio_transform_t transform = {0, 0, 1};
+        if (self->hardware_scroll && !self->refresh) {
+            _scroll_in_hardware(self, &transform);
+        }
+        area = displayio_group_get_refresh_areas(self->current_group, &transform, NULL);
+    }
+    if (self->refresh) {
+        _add_dirty_area(self, &self->area);
+    } else {
+        while (area != NULL) {
+            _add_dirty_area(self, area);
+            area = area->next;
+        }
+    }
+    // Everything that changed is captured in dirty_areas now so reset the layers' change tracking
+    // right away. Changes made while this refresh is drawn over several time slices are then
+    // picked up by the next refresh rather than lost.
     if (self->current_group != NULL) {
         displayio_group_finish_refresh(self->current_group);
     }
     self->refresh = false;
+    return self->dirty_area_count > 0;
+}
+
+void displayio_display_finish_refresh(displayio_display_obj_t* self) {
+    self->refresh_in_progress = false;
     self->last_refresh = ticks_ms;
 }
 
-void displayio_display_send_pixels(displayio_display_obj_t* self, uint32_t* pixels, uint32_t length) {
-    self->send(self->bus, false, (uint8_t*) pixels, length * 4);
+void displayio_display_send_pixels(displayio_display_obj_t* self, uint8_t* pixels, uint32_t length) {
+    self->send(self->bus, false, pixels, length);
 }
 
 void displayio_display_update_backlight(displayio_display_obj_t* self) {
@@ -291,10 +482,12 @@ void displayio_display_update_backlight(displayio_display_obj_t* self) {
 }
 
 void release_display(displayio_display_obj_t* self) {
+    #if DISPLAYIO_BACKLIGHT
     if (self->backlight_pwm.base.type == &pulseio_pwmout_type) {
         common_hal_pulseio_pwmout_reset_ok(&self->backlight_pwm);
         common_hal_pulseio_pwmout_deinit(&self->backlight_pwm);
     } else if (self->backlight_inout.base.type == &digitalio_digitalinout_type) {
         common_hal_digitalio_digitalinout_deinit(&self->backlight_inout);
     }
+    #endif
 }
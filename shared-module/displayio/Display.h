@@ -27,9 +27,36 @@
 #ifndef MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_DISPLAY_H
 #define MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_DISPLAY_H
 
-#include "shared-bindings/digitalio/DigitalInOut.h"
 #include "shared-bindings/displayio/Group.h"
+#include "shared-module/displayio/area.h"
+
+// Backlights are dimmed with PWM, or switched on and off when the pin can't do PWM.
+#define DISPLAYIO_BACKLIGHT (CIRCUITPY_DIGITALIO && CIRCUITPY_PULSEIO)
+
+#if DISPLAYIO_BACKLIGHT
+#include "shared-bindings/digitalio/DigitalInOut.h"
 #include "shared-bindings/pulseio/PWMOut.h"
+#endif
+
+// Changed areas are merged into at most this many rectangles per refresh.
+#define DISPLAYIO_DIRTY_AREA_LIMIT (4)
+// Pixels rendered and sent at a time.
+#define DISPLAYIO_BUFFER_SIZE (256)
+
+// Default number of microseconds a refresh may render for before yielding to other background
+// tasks.
+#define DISPLAYIO_DEFAULT_REFRESH_TIME_SLICE (2000)
+
+// What one refresh cost. Times are in microseconds.
+typedef struct {
+    uint32_t refresh_us; // From the start of the refresh until its last pixel was sent.
+    uint32_t render_us;
+    uint32_t transmit_us; // Waiting on and writing to the bus.
+    uint32_t pixels_rendered;
+    uint32_t pixels_sent;
+    uint16_t bus_busy; // Times the bus couldn't be acquired so the refresh had to wait.
+    displayio_area_t dirty_area; // Bounding box of the refreshed areas.
+} displayio_refresh_stats_t;
 
 typedef bool (*display_bus_begin_transaction)(mp_obj_t bus);
 typedef void (*display_bus_send)(mp_obj_t bus, bool command, uint8_t *data, uint32_t data_length);
@@ -44,8 +71,26 @@ typedef struct {
     uint8_t set_column_command;
     uint8_t set_row_command;
     uint8_t write_ram_command;
+    uint8_t set_vertical_scroll;
     displayio_group_t *current_group;
+    displayio_area_t area; // The full display in display coordinates.
+    displayio_area_t dirty_areas[DISPLAYIO_DIRTY_AREA_LIMIT];
+    uint8_t dirty_area_count;
     bool refresh;
+    // A refresh is drawn over one or more time slices. These track where to resume.
+    bool refresh_in_progress;
+    uint8_t refresh_area_index;
+    uint16_t refresh_rows_done; // Display memory rows of the current area already sent.
+    bool refresh_window_set; // The update window covers the rest of the current area.
+    bool sending; // The bus is held while send_buffer is sent in the background.
+    uint32_t refresh_time_slice; // In microseconds. Zero renders each refresh in one go.
+    uint64_t refresh_start_us;
+    displayio_refresh_stats_t refresh_stats; // Accumulated while the refresh is in progress.
+    displayio_refresh_stats_t last_refresh_stats;
+    bool hardware_scroll;
+    // The display memory row shown at the top of the display. Memory rows are rendered this far
+    // ahead, wrapping around, so that hardware scrolling is invisible to the layers.
+    uint16_t scroll_offset;
     uint64_t last_refresh;
     int16_t colstart;
     int16_t rowstart;
@@ -54,16 +99,19 @@ typedef struct {
     display_bus_begin_transaction begin_transaction;
     display_bus_send send;
     display_bus_end_transaction end_transaction;
+    #if DISPLAYIO_BACKLIGHT
     union {
         digitalio_digitalinout_obj_t backlight_inout;
         pulseio_pwmout_obj_t backlight_pwm;
     };
+    #endif
     uint64_t last_backlight_refresh;
     bool auto_brightness:1;
     bool updating_backlight:1;
     bool mirror_x;
     bool mirror_y;
     bool transpose_xy;
+    uint32_t send_buffer[DISPLAYIO_BUFFER_SIZE / 2];
 } displayio_display_obj_t;
 
 void displayio_display_update_backlight(displayio_display_obj_t* self);
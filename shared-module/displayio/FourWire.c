@@ -87,17 +87,25 @@ bool common_hal_displayio_fourwire_begin_transaction(mp_obj_t obj) {
 
 void common_hal_displayio_fourwire_send(mp_obj_t obj, bool command, uint8_t *data, uint32_t data_length) {
     displayio_fourwire_obj_t* self = MP_OBJ_TO_PTR(obj);
+    // Let the previous data finish before changing the command line.
+    common_hal_busio_spi_finish_write(self->bus);
     if (command) {
         common_hal_digitalio_digitalinout_set_value(&self->chip_select, true);
         common_hal_time_delay_ms(1);
         common_hal_digitalio_digitalinout_set_value(&self->chip_select, false);
     }
     common_hal_digitalio_digitalinout_set_value(&self->command, !command);
-    common_hal_busio_spi_write(self->bus, data, data_length);
+    if (command) {
+        common_hal_busio_spi_write(self->bus, data, data_length);
+    } else {
+        // Data is written in the background so the caller can prepare the next chunk meanwhile.
+        common_hal_busio_spi_start_write(self->bus, data, data_length);
+    }
 }
 
 void common_hal_displayio_fourwire_end_transaction(mp_obj_t obj) {
     displayio_fourwire_obj_t* self = MP_OBJ_TO_PTR(obj);
+    common_hal_busio_spi_finish_write(self->bus);
     common_hal_digitalio_digitalinout_set_value(&self->chip_select, true);
     common_hal_busio_spi_unlock(self->bus);
 }
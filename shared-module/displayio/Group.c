@@ -34,31 +34,65 @@ void common_hal_displayio_group_construct(displayio_group_t* self, uint32_t max_
     displayio_group_construct(self, children, max_size, scale, x, y);
 }
 
+// Starts a set of pending changes from the values that are currently drawn.
+static void _begin_pending(displayio_group_t* self) {
+    if (self->pending_changes) {
+        return;
+    }
+    self->pending_x = self->x;
+    self->pending_y = self->y;
+    self->pending_scale = self->scale;
+    self->pending_changes = true;
+}
+
 uint32_t common_hal_displayio_group_get_scale(displayio_group_t* self) {
+    if (self->pending_changes) {
+        return self->pending_scale;
+    }
     return self->scale;
 }
 
 void common_hal_displayio_group_set_scale(displayio_group_t* self, uint32_t scale) {
-    self->needs_refresh = self->scale != scale;
-    self->scale = scale;
+    _begin_pending(self);
+    self->pending_scale = scale;
 }
 
 mp_int_t common_hal_displayio_group_get_x(displayio_group_t* self) {
+    if (self->pending_changes) {
+        return self->pending_x;
+    }
     return self->x;
 }
 
 void common_hal_displayio_group_set_x(displayio_group_t* self, mp_int_t x) {
-    self->needs_refresh = self->x != x;
-    self->x = x;
+    _begin_pending(self);
+    self->pending_x = x;
 }
 
 mp_int_t common_hal_displayio_group_get_y(displayio_group_t* self) {
+    if (self->pending_changes) {
+        return self->pending_y;
+    }
     return self->y;
 }
 
 void common_hal_displayio_group_set_y(displayio_group_t* self, mp_int_t y) {
-    self->needs_refresh = self->y != y;
-    self->y = y;
+    _begin_pending(self);
+    self->pending_y = y;
+}
+
+// Mark where the layer was last drawn as dirty so that it is cleared or redrawn in its new order.
+static void _invalidate_layer(displayio_group_t* self, mp_obj_t native_layer) {
+    displayio_area_t layer_area;
+    bool rendered_last_frame = false;
+    if (MP_OBJ_IS_TYPE(native_layer, &displayio_tilegrid_type)) {
+        rendered_last_frame = displayio_tilegrid_get_previous_area(native_layer, &layer_area);
+    } else if (MP_OBJ_IS_TYPE(native_layer, &displayio_group_type)) {
+        rendered_last_frame = displayio_group_get_previous_area(native_layer, &layer_area);
+    }
+    if (rendered_last_frame) {
+        displayio_area_union(&self->dirty_area, &layer_area, &self->dirty_area);
+    }
 }
 
 void common_hal_displayio_group_insert(displayio_group_t* self, size_t index, mp_obj_t layer) {
@@ -79,19 +113,19 @@ void common_hal_displayio_group_insert(displayio_group_t* self, size_t index, mp
     self->children[index].native = native_layer;
     self->children[index].original = layer;
     self->size++;
-    self->needs_refresh = true;
+    _invalidate_layer(self, native_layer);
 }
 
 mp_obj_t common_hal_displayio_group_pop(displayio_group_t* self, size_t index) {
     self->size--;
     mp_obj_t item = self->children[index].original;
+    _invalidate_layer(self, self->children[index].native);
     // Shift everything left.
     for (size_t i = index; i < self->size; i++) {
         self->children[i] = self->children[i + 1];
     }
     self->children[self->size].native = NULL;
     self->children[self->size].original = NULL;
-    self->needs_refresh = true;
     return item;
 }
 
@@ -111,9 +145,10 @@ void common_hal_displayio_group_set(displayio_group_t* self, size_t index, mp_ob
     if (native_layer == MP_OBJ_NULL) {
         mp_raise_ValueError(translate("Layer must be a Group or TileGrid subclass."));
     }
+    _invalidate_layer(self, self->children[index].native);
     self->children[index].native = native_layer;
     self->children[index].original = layer;
-    self->needs_refresh = true;
+    _invalidate_layer(self, native_layer);
 }
 
 void displayio_group_construct(displayio_group_t* self, displayio_group_child_t* child_array, uint32_t max_size, uint32_t scale, mp_int_t x, mp_int_t y) {
@@ -121,23 +156,28 @@ void displayio_group_construct(displayio_group_t* self, displayio_group_child_t*
     self->y = y;
     self->children = child_array;
     self->max_size = max_size;
-    self->needs_refresh = false;
     self->scale = scale;
+    self->pending_changes = false;
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
 }
 
-bool displayio_group_get_pixel(displayio_group_t *self, int16_t x, int16_t y, uint16_t* pixel) {
-    x -= self->x;
-    y -= self->y;
-    x /= self->scale;
-    y /= self->scale;
+MP_RAMFUNC bool displayio_group_fill_area(displayio_group_t *self, const displayio_transform_t* transform, const displayio_area_t* area, uint32_t* mask, uint16_t* buffer) {
+    displayio_transform_t child_transform;
+    child_transform.x = transform->x + transform->scale * self->x;
+    child_transform.y = transform->y + transform->scale * self->y;
+    child_transform.scale = transform->scale * self->scale;
+
+    // Draw from the top layer down so that pixels covered by higher layers are masked off and
+    // never computed.
     for (int32_t i = self->size - 1; i >= 0 ; i--) {
         mp_obj_t layer = self->children[i].native;
         if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
-            if (displayio_tilegrid_get_pixel(layer, x, y, pixel)) {
+            if (displayio_tilegrid_fill_area(layer, &child_transform, area, mask, buffer)) {
                 return true;
             }
         } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
-            if (displayio_group_get_pixel(layer, x, y, pixel)) {
+            if (displayio_group_fill_area(layer, &child_transform, area, mask, buffer)) {
                 return true;
             }
         }
@@ -145,18 +185,144 @@ bool displayio_group_get_pixel(displayio_group_t *self, int16_t x, int16_t y, ui
     return false;
 }
 
-bool displayio_group_needs_refresh(displayio_group_t *self) {
-    if (self->needs_refresh) {
-        return true;
+// Unlinks the areas from head up to stop that lie within the occluder and returns the new head.
+// Those pixels are covered by an opaque layer above so redrawing them would only draw it again.
+static displayio_area_t* _cull_occluded_areas(displayio_area_t* head, const displayio_area_t* stop, const displayio_area_t* occluder) {
+    while (head != stop && displayio_area_contains(occluder, head)) {
+        head = (displayio_area_t*) head->next;
+    }
+    displayio_area_t* previous = head;
+    while (previous != stop) {
+        const displayio_area_t* area = previous->next;
+        if (area != stop && displayio_area_contains(occluder, area)) {
+            previous->next = area->next;
+        } else {
+            previous = (displayio_area_t*) area;
+        }
+    }
+    return head;
+}
+
+// occluder is the largest opaque area drawn above this group or NULL.
+static displayio_area_t* _get_refresh_areas(displayio_group_t *self, const displayio_transform_t* transform, displayio_area_t* tail, const displayio_area_t* occluder) {
+    // Apply pending changes once for the whole refresh. Children notice that they moved when they
+    // compare where they are now with where they were drawn last.
+    if (self->pending_changes) {
+        self->x = self->pending_x;
+        self->y = self->pending_y;
+        self->scale = self->pending_scale;
+        self->pending_changes = false;
+    }
+
+    displayio_transform_t child_transform;
+    child_transform.x = transform->x + transform->scale * self->x;
+    child_transform.y = transform->y + transform->scale * self->y;
+    child_transform.scale = transform->scale * self->scale;
+
+    if (!displayio_area_empty(&self->dirty_area)) {
+        self->dirty_area.next = tail;
+        tail = &self->dirty_area;
+    }
+    displayio_area_t largest_opaque;
+    if (occluder != NULL) {
+        displayio_area_copy(occluder, &largest_opaque);
+    }
+    for (int32_t i = self->size - 1; i >= 0 ; i--) {
+        mp_obj_t layer = self->children[i].native;
+        if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+            displayio_area_t* child_tail = displayio_tilegrid_get_refresh_areas(layer, &child_transform, tail);
+            if (occluder != NULL) {
+                child_tail = _cull_occluded_areas(child_tail, tail, occluder);
+            }
+            tail = child_tail;
+            // Layers beneath an opaque grid don't need to redraw where it covers them.
+            displayio_area_t opaque;
+            if (displayio_tilegrid_get_opaque_area(layer, &opaque) &&
+                (occluder == NULL || displayio_area_size(&opaque) > displayio_area_size(occluder))) {
+                displayio_area_copy(&opaque, &largest_opaque);
+                occluder = &largest_opaque;
+            }
+        } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
+            tail = _get_refresh_areas(layer, &child_transform, tail, occluder);
+        }
+    }
+    return tail;
+}
+
+displayio_area_t* displayio_group_get_refresh_areas(displayio_group_t *self, const displayio_transform_t* transform, displayio_area_t* tail) {
+    return _get_refresh_areas(self, transform, tail, NULL);
+}
+
+bool displayio_group_get_previous_area(displayio_group_t *self, displayio_area_t* area) {
+    bool first = true;
+    for (int32_t i = self->size - 1; i >= 0 ; i--) {
+        mp_obj_t layer = self->children[i].native;
+        displayio_area_t layer_area;
+        if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+            if (!displayio_tilegrid_get_previous_area(layer, &layer_area)) {
+                continue;
+            }
+        } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
+            if (!displayio_group_get_previous_area(layer, &layer_area)) {
+                continue;
+            }
+        } else {
+            continue;
+        }
+        if (first) {
+            displayio_area_copy(&layer_area, area);
+            first = false;
+        } else {
+            displayio_area_union(area, &layer_area, area);
+        }
     }
+    return !first;
+}
+
+displayio_tilegrid_t* displayio_group_find_vertical_scroll(displayio_group_t *self, const displayio_transform_t* transform, displayio_area_t* area, int16_t* pixels) {
+    if (self->pending_changes) {
+        // Everything in the group moves so there is nothing to gain.
+        return NULL;
+    }
+    displayio_transform_t child_transform;
+    child_transform.x = transform->x + transform->scale * self->x;
+    child_transform.y = transform->y + transform->scale * self->y;
+    child_transform.scale = transform->scale * self->scale;
+
     for (int32_t i = self->size - 1; i >= 0 ; i--) {
         mp_obj_t layer = self->children[i].native;
+        displayio_tilegrid_t* found = NULL;
         if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
-            if (displayio_tilegrid_needs_refresh(layer)) {
+            if (displayio_tilegrid_get_vertical_scroll(layer, &child_transform, area, pixels)) {
+                found = layer;
+            }
+        } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
+            found = displayio_group_find_vertical_scroll(layer, &child_transform, area, pixels);
+        }
+        if (found != NULL) {
+            return found;
+        }
+    }
+    return NULL;
+}
+
+bool displayio_group_overlaps(displayio_group_t *self, const displayio_tilegrid_t* except, const displayio_area_t* area) {
+    displayio_area_t overlap;
+    if (displayio_area_compute_overlap(&self->dirty_area, area, &overlap)) {
+        return true;
+    }
+    for (int32_t i = self->size - 1; i >= 0 ; i--) {
+        mp_obj_t layer = self->children[i].native;
+        displayio_area_t layer_area;
+        if (layer == except) {
+            continue;
+        } else if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
+            if (displayio_tilegrid_get_previous_area(layer, &layer_area) &&
+                displayio_area_compute_overlap(&layer_area, area, &overlap)) {
                 return true;
             }
         } else if (MP_OBJ_IS_TYPE(layer, &displayio_group_type)) {
-            if (displayio_group_needs_refresh(layer)) {
+            if (displayio_group_overlaps(layer, except, area)) {
                 return true;
             }
         }
@@ -165,7 +331,8 @@ bool displayio_group_needs_refresh(displayio_group_t *self) {
 }
 
 void displayio_group_finish_refresh(displayio_group_t *self) {
-    self->needs_refresh = false;
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
     for (int32_t i = self->size - 1; i >= 0 ; i--) {
         mp_obj_t layer = self->children[i].native;
         if (MP_OBJ_IS_TYPE(layer, &displayio_tilegrid_type)) {
@@ -31,6 +31,8 @@
 #include <stdint.h>
 
 #include "py/obj.h"
+#include "shared-module/displayio/area.h"
+#include "shared-module/displayio/TileGrid.h"
 
 typedef struct {
     mp_obj_t native;
@@ -44,13 +46,25 @@ typedef struct {
     uint16_t scale;
     uint16_t size;
     uint16_t max_size;
+    // Position and scale changes are latched here and applied at the start of the next refresh.
+    int16_t pending_x;
+    int16_t pending_y;
+    uint16_t pending_scale;
+    bool pending_changes;
     displayio_group_child_t* children;
-    bool needs_refresh;
+    displayio_area_t dirty_area; // Stored as display coordinates.
 } displayio_group_t;
 
 void displayio_group_construct(displayio_group_t* self, displayio_group_child_t* child_array, uint32_t max_size, uint32_t scale, mp_int_t x, mp_int_t y);
-bool displayio_group_get_pixel(displayio_group_t *group, int16_t x, int16_t y, uint16_t *pixel);
-bool displayio_group_needs_refresh(displayio_group_t *self);
+bool displayio_group_fill_area(displayio_group_t *group, const displayio_transform_t* transform, const displayio_area_t* area, uint32_t* mask, uint16_t* buffer);
+displayio_area_t* displayio_group_get_refresh_areas(displayio_group_t *self, const displayio_transform_t* transform, displayio_area_t* tail);
+bool displayio_group_get_previous_area(displayio_group_t *self, displayio_area_t* area);
+// Returns the top most TileGrid whose only change since the last refresh is a vertical scroll of its
+// tiles, or NULL. See displayio_tilegrid_get_vertical_scroll for area and pixels.
+displayio_tilegrid_t* displayio_group_find_vertical_scroll(displayio_group_t *self, const displayio_transform_t* transform, displayio_area_t* area, int16_t* pixels);
+// Returns true when anything other than except was drawn within area last refresh or is queued to
+// be redrawn there.
+bool displayio_group_overlaps(displayio_group_t *self, const displayio_tilegrid_t* except, const displayio_area_t* area);
 void displayio_group_finish_refresh(displayio_group_t *self);
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_GROUP_H
@@ -35,7 +35,7 @@ static uint32_t read_word(uint16_t* bmp_header, uint16_t index) {
     return bmp_header[index] | bmp_header[index + 1] << 16;
 }
 
-void common_hal_displayio_ondiskbitmap_construct(displayio_ondiskbitmap_t *self, pyb_file_obj_t* file) {
+void common_hal_displayio_ondiskbitmap_construct(displayio_ondiskbitmap_t *self, pyb_file_obj_t* file, uint32_t cache_rows) {
     // Load the wave
     self->file = file;
     uint16_t bmp_header[69];
@@ -115,47 +115,40 @@ void common_hal_displayio_ondiskbitmap_construct(displayio_ondiskbitmap_t *self,
         self->stride = (bit_stride / 8);
     }
 
+    if (cache_rows > self->height) {
+        cache_rows = self->height;
+    }
+    self->cache_rows = cache_rows;
+    self->cache_first_row = -1;
+    self->row_cache = m_malloc(self->width * cache_rows * sizeof(uint32_t), false);
 }
 
 
-uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *self,
-        int16_t x, int16_t y) {
-    if (x < 0 || x >= self->width || y < 0 || y >= self->height) {
-        return 0;
-    }
-
-    uint32_t location;
-    uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel /8) : 1;
-    if (self->bits_per_pixel >= 8){
-        location = self->data_offset + (self->height - y - 1) * self->stride + x * bytes_per_pixel;
-    } else {
-        location = self->data_offset + (self->height - y - 1) * self->stride + x / 8;
-    }
-    // We don't cache here because the underlying FS caches sectors.
-    f_lseek(&self->file->fp, location);
-    UINT bytes_read;
-    uint32_t pixel_data = 0;
-    uint32_t result = f_read(&self->file->fp, &pixel_data, bytes_per_pixel, &bytes_read);
-    if (result == FR_OK) {
-        uint32_t tmp = 0;
-        uint8_t red;
-        uint8_t green;
-        uint8_t blue;
+// Decodes a row in place. The raw row starts at the beginning of the row's cache slot and is
+// never longer than the decoded one so decoding from the last pixel back never overwrites
+// unread data.
+static void decode_row(displayio_ondiskbitmap_t *self, uint32_t* row) {
+    uint8_t* raw = (uint8_t*) row;
+    uint8_t bytes_per_pixel = self->bits_per_pixel / 8;
+    for (int32_t x = self->width - 1; x >= 0; x--) {
+        uint32_t pixel_data = 0;
         if (self->bits_per_pixel == 1) {
-            uint8_t bit_offset = x%8;
-            tmp = ( pixel_data & (0x80 >> (bit_offset))) >> (7 - bit_offset);
-            if (tmp == 1) {
-                return 0x00FFFFFF;
-            } else {
-                return 0x00000000;
+            pixel_data = (raw[x / 8] >> (7 - x % 8)) & 0x1;
+        } else {
+            for (uint8_t i = 0; i < bytes_per_pixel; i++) {
+                pixel_data |= raw[x * bytes_per_pixel + i] << (8 * i);
             }
+        }
+
+        uint32_t color;
+        if (self->bits_per_pixel == 1) {
+            color = pixel_data ? 0x00FFFFFF : 0x00000000;
         } else if (bytes_per_pixel == 1) {
-            blue = ((self->palette_data[pixel_data] & 0xFF) >> 0);
-            red = ((self->palette_data[pixel_data] & 0xFF0000) >> 16);
-            green = ((self->palette_data[pixel_data] & 0xFF00) >> 8);
-            tmp = (red << 16 | green << 8 | blue );
-            return tmp;
+            color = self->palette_data[pixel_data] & 0x00FFFFFF;
         } else if (bytes_per_pixel == 2) {
+            uint8_t red;
+            uint8_t green;
+            uint8_t blue;
             if (self->g_bitmask == 0x07e0) { // 565
                 red =((pixel_data & self->r_bitmask) >>11);
                 green = ((pixel_data & self->g_bitmask) >>5);
@@ -165,15 +158,48 @@ uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *s
                 green = ((pixel_data & self->g_bitmask) >>4);
                 blue = ((pixel_data & self->b_bitmask) >> 0);
             }
-            tmp = (red << 19 | green << 10 | blue << 3);
-            return tmp;
+            color = (red << 19 | green << 10 | blue << 3);
         } else if ((bytes_per_pixel == 4) && (self->bitfield_compressed)) {
-            return pixel_data & 0x00FFFFFF;
+            color = pixel_data & 0x00FFFFFF;
         } else {
-            return pixel_data;
+            color = pixel_data;
         }
+        row[x] = color;
+    }
+}
+
+// Loads the rows starting at first_row with one read per row. Rows that can't be read are black.
+static void load_rows(displayio_ondiskbitmap_t *self, int16_t first_row) {
+    uint16_t rows = self->cache_rows;
+    if (first_row + rows > self->height) {
+        first_row = self->height - rows;
+    }
+    for (uint16_t i = 0; i < rows; i++) {
+        int16_t y = first_row + i;
+        uint32_t* row = self->row_cache + i * self->width;
+        // Rows are stored bottom to top.
+        f_lseek(&self->file->fp, self->data_offset + (self->height - y - 1) * self->stride);
+        UINT bytes_read;
+        if (f_read(&self->file->fp, row, self->stride, &bytes_read) != FR_OK || bytes_read != self->stride) {
+            memset(row, 0, self->width * sizeof(uint32_t));
+            continue;
+        }
+        decode_row(self, row);
+    }
+    self->cache_first_row = first_row;
+}
+
+uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *self,
+        int16_t x, int16_t y) {
+    if (x < 0 || x >= self->width || y < 0 || y >= self->height) {
+        return 0;
+    }
+
+    if (self->cache_first_row < 0 || y < self->cache_first_row ||
+        y >= self->cache_first_row + self->cache_rows) {
+        load_rows(self, y);
     }
-    return 0;
+    return self->row_cache[(y - self->cache_first_row) * self->width + x];
 }
 
 uint16_t common_hal_displayio_ondiskbitmap_get_height(displayio_ondiskbitmap_t *self) {
@@ -47,6 +47,9 @@ typedef struct {
     pyb_file_obj_t* file;
     uint8_t bits_per_pixel;
     uint32_t* palette_data;
+    uint32_t* row_cache; // Decoded colors of cache_rows rows starting at cache_first_row.
+    uint16_t cache_rows;
+    int32_t cache_first_row;
 } displayio_ondiskbitmap_t;
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_ONDISKBITMAP_H
@@ -26,49 +26,45 @@
 
 #include "shared-bindings/displayio/Palette.h"
 
+#include <string.h>
+
+#include "shared-module/displayio/ColorConverter.h"
+
 void common_hal_displayio_palette_construct(displayio_palette_t* self, uint16_t color_count) {
     self->color_count = color_count;
-    self->colors = (uint32_t *) m_malloc(color_count * sizeof(uint16_t), false);
-    uint32_t opaque_byte_count = color_count / 8;
-    if (color_count % 8 > 0) {
-        opaque_byte_count += 1;
-    }
-    self->opaque = (uint32_t *) m_malloc(opaque_byte_count, false);
+    self->colors = (uint16_t *) m_malloc(color_count * sizeof(uint16_t), false);
+    uint32_t opaque_word_count = (color_count + 31) / 32;
+    self->opaque = (uint32_t *) m_malloc(opaque_word_count * sizeof(uint32_t), false);
+    memset(self->opaque, 0, opaque_word_count * sizeof(uint32_t));
+    self->transparent_count = 0;
 }
 
 void common_hal_displayio_palette_make_opaque(displayio_palette_t* self, uint32_t palette_index) {
+    if (palette_index >= self->color_count ||
+        (self->opaque[palette_index / 32] & (0x1 << (palette_index % 32))) == 0) {
+        return;
+    }
     self->opaque[palette_index / 32] &= ~(0x1 << (palette_index % 32));
+    self->transparent_count--;
+    self->needs_refresh = true;
 }
 
 void common_hal_displayio_palette_make_transparent(displayio_palette_t* self, uint32_t palette_index) {
+    if (palette_index >= self->color_count ||
+        (self->opaque[palette_index / 32] & (0x1 << (palette_index % 32))) != 0) {
+        return;
+    }
     self->opaque[palette_index / 32] |= (0x1 << (palette_index % 32));
+    self->transparent_count++;
+    self->needs_refresh = true;
 }
 
 void common_hal_displayio_palette_set_color(displayio_palette_t* self, uint32_t palette_index, uint32_t color) {
-    uint32_t shift = (palette_index % 2) * 16;
-    uint32_t masked = self->colors[palette_index / 2] & ~(0xffff << shift);
-    uint32_t r5 = (color >> 19);
-    uint32_t g6 = (color >> 10) & 0x3f;
-    uint32_t b5 = (color >> 3) & 0x1f;
-    uint32_t packed = r5 << 11 | g6 << 5 | b5;
-    // swap bytes
-    packed = __builtin_bswap16(packed);
-    self->colors[palette_index / 2] = masked | packed << shift;
+    // Convert once here so that drawing is a plain lookup.
+    self->colors[palette_index] = displayio_colorconverter_convert_888_to_565_swapped(color);
     self->needs_refresh = true;
 }
 
-bool displayio_palette_get_color(displayio_palette_t *self, uint32_t palette_index, uint16_t* color) {
-    if (palette_index > self->color_count) {
-        return false;
-    }
-    if ((self->opaque[palette_index / 32] & (0x1 << (palette_index % 32))) != 0) {
-        return false;
-    }
-    *color = (self->colors[palette_index / 2] >> (16 * (palette_index % 2))) & 0xffff;
-
-    return true;
-}
-
 bool displayio_palette_needs_refresh(displayio_palette_t *self) {
     return self->needs_refresh;
 }
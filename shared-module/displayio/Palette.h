@@ -34,13 +34,29 @@
 
 typedef struct {
     mp_obj_base_t base;
+    // One bit per color that is set when the color is transparent.
     uint32_t* opaque;
-    uint32_t* colors;
+    // RGB565 colors with the bytes already swapped into the order they are sent to the display.
+    uint16_t* colors;
     uint32_t color_count;
+    uint32_t transparent_count;
     bool needs_refresh;
 } displayio_palette_t;
 
-bool displayio_palette_get_color(displayio_palette_t *palette, uint32_t palette_index, uint16_t* color);
+// Inlined because it is called for every pixel drawn through a palette. Without any transparent
+// colors it is a single load.
+static inline bool displayio_palette_get_color(displayio_palette_t *self, uint32_t palette_index, uint16_t* color) {
+    if (palette_index >= self->color_count) {
+        return false;
+    }
+    if (self->transparent_count > 0 &&
+        (self->opaque[palette_index / 32] & (0x1 << (palette_index % 32))) != 0) {
+        return false;
+    }
+    *color = self->colors[palette_index];
+    return true;
+}
+
 bool displayio_palette_needs_refresh(displayio_palette_t *self);
 void displayio_palette_finish_refresh(displayio_palette_t *self);
 
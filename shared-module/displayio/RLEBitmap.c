@@ -0,0 +1,102 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/RLEBitmap.h"
+
+#include "py/runtime.h"
+
+void common_hal_displayio_rlebitmap_construct(displayio_rlebitmap_t *self, uint32_t width,
+    uint32_t height, mp_obj_t data_obj, const uint8_t* data, size_t data_len) {
+    self->width = width;
+    self->height = height;
+    self->data_obj = data_obj;
+    self->data = data;
+    self->row_starts = m_malloc(height * sizeof(uint32_t), false);
+    self->max_value = 0;
+
+    // Index the rows up front so that rendering can start decoding anywhere.
+    size_t offset = 0;
+    for (uint32_t y = 0; y < height; y++) {
+        self->row_starts[y] = offset;
+        uint32_t x = 0;
+        while (x < width) {
+            if (offset + 2 > data_len || data[offset] == 0 || x + data[offset] > width) {
+                mp_raise_ValueError(translate("Invalid run length data"));
+            }
+            x += data[offset];
+            if (data[offset + 1] > self->max_value) {
+                self->max_value = data[offset + 1];
+            }
+            offset += 2;
+        }
+    }
+    if (offset != data_len) {
+        mp_raise_ValueError(translate("Invalid run length data"));
+    }
+}
+
+void displayio_rlebitmap_get_row(displayio_rlebitmap_t *self, int16_t x, int16_t y, uint32_t* values, uint16_t count) {
+    const uint8_t* run = self->data + self->row_starts[y];
+    // Skip the runs that end before x.
+    int16_t run_end = run[0];
+    while (run_end <= x) {
+        run += 2;
+        run_end += run[0];
+    }
+    uint16_t i = 0;
+    while (i < count) {
+        uint16_t length = run_end - x;
+        if (length > count - i) {
+            length = count - i;
+        }
+        uint8_t value = run[1];
+        for (uint16_t j = 0; j < length; j++) {
+            values[i++] = value;
+        }
+        x += length;
+        if (i < count) {
+            run += 2;
+            run_end += run[0];
+        }
+    }
+}
+
+uint32_t common_hal_displayio_rlebitmap_get_pixel(displayio_rlebitmap_t *self, int16_t x, int16_t y) {
+    if (x < 0 || x >= self->width || y < 0 || y >= self->height) {
+        return 0;
+    }
+    uint32_t value;
+    displayio_rlebitmap_get_row(self, x, y, &value, 1);
+    return value;
+}
+
+uint16_t common_hal_displayio_rlebitmap_get_width(displayio_rlebitmap_t *self) {
+    return self->width;
+}
+
+uint16_t common_hal_displayio_rlebitmap_get_height(displayio_rlebitmap_t *self) {
+    return self->height;
+}
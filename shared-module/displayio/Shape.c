@@ -48,11 +48,14 @@ void common_hal_displayio_shape_construct(displayio_shape_t *self, uint32_t widt
     }
     self->half_height = height;
 
-    self->data = m_malloc(height * sizeof(uint32_t), false);
+    // Rows 0 through height are stored when mirrored so allocate one more than the count.
+    self->data = m_malloc((height + 1) * sizeof(uint32_t), false);
     for (uint16_t i = 0; i <= height; i++) {
         self->data[2 * i] = 0;
         self->data[2 * i + 1] = width;
     }
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
 }
 
 void common_hal_displayio_shape_set_boundary(displayio_shape_t *self, uint16_t y, uint16_t start_x, uint16_t end_x) {
@@ -68,6 +71,85 @@ void common_hal_displayio_shape_set_boundary(displayio_shape_t *self, uint16_t y
     }
     self->data[2 * y] = start_x;
     self->data[2 * y + 1] = end_x;
+
+    // Redraw the whole row and, when mirrored, the matching row in the bottom half.
+    displayio_area_t row_area = {0, y, self->width, y + 1, NULL};
+    displayio_area_union(&self->dirty_area, &row_area, &self->dirty_area);
+    if (self->mirror_y) {
+        displayio_area_t mirrored_area = {0, self->height - y - 1, self->width, self->height - y, NULL};
+        displayio_area_union(&self->dirty_area, &mirrored_area, &self->dirty_area);
+    }
+}
+
+// Sets the stored row y to cover x1 up to but not including x2 and marks it dirty when it changes.
+// Rows that are empty store a start after their end.
+static void _set_row(displayio_shape_t *self, uint16_t y, int32_t x1, int32_t x2) {
+    int32_t stored_width = self->width;
+    if (self->mirror_x) {
+        stored_width = self->half_width + 1;
+    }
+    x1 = MAX(x1, 0);
+    x2 = MIN(x2, stored_width);
+    uint16_t start_x = 1;
+    uint16_t end_x = 0;
+    if (x1 < x2) {
+        start_x = x1;
+        end_x = x2 - 1;
+    }
+    if (self->data[2 * y] == start_x && self->data[2 * y + 1] == end_x) {
+        return;
+    }
+    self->data[2 * y] = start_x;
+    self->data[2 * y + 1] = end_x;
+
+    displayio_area_t row_area = {0, y, self->width, y + 1, NULL};
+    displayio_area_union(&self->dirty_area, &row_area, &self->dirty_area);
+    if (self->mirror_y) {
+        displayio_area_t mirrored_area = {0, self->height - y - 1, self->width, self->height - y, NULL};
+        displayio_area_union(&self->dirty_area, &mirrored_area, &self->dirty_area);
+    }
+}
+
+static uint16_t _stored_rows(displayio_shape_t *self) {
+    if (self->mirror_y) {
+        return self->half_height + 1;
+    }
+    return self->height;
+}
+
+void common_hal_displayio_shape_rect(displayio_shape_t *self, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    uint16_t rows = _stored_rows(self);
+    for (uint16_t y = 0; y < rows; y++) {
+        if (y >= y1 && y < y2) {
+            _set_row(self, y, x1, x2);
+        } else {
+            _set_row(self, y, 0, 0);
+        }
+    }
+}
+
+void common_hal_displayio_shape_circle(displayio_shape_t *self, int16_t x, int16_t y, uint16_t radius) {
+    // Walk outwards from the center row, narrowing the half width of the row until it fits inside
+    // the circle. This avoids a square root for every row.
+    uint16_t rows = _stored_rows(self);
+    int32_t radius_squared = (int32_t) radius * radius + radius;
+    int32_t half_width = radius;
+    for (int32_t dy = 0; dy <= radius; dy++) {
+        while (half_width * half_width + dy * dy > radius_squared) {
+            half_width--;
+        }
+        if (y - dy >= 0 && y - dy < rows) {
+            _set_row(self, y - dy, x - half_width, x + half_width + 1);
+        }
+        if (dy > 0 && y + dy >= 0 && y + dy < rows) {
+            _set_row(self, y + dy, x - half_width, x + half_width + 1);
+        }
+    }
+    for (int32_t row = 0; row < rows; row++) {
+        if (row < y - radius || row > y + radius) {
+            _set_row(self, row, 0, 0);
+        }
+    }
 }
 
 uint32_t common_hal_displayio_shape_get_pixel(void *obj, int16_t x, int16_t y) {
@@ -88,3 +170,16 @@ uint32_t common_hal_displayio_shape_get_pixel(void *obj, int16_t x, int16_t y) {
     }
     return 1;
 }
+
+displayio_area_t* displayio_shape_get_refresh_areas(displayio_shape_t *self, displayio_area_t* tail) {
+    if (displayio_area_empty(&self->dirty_area)) {
+        return tail;
+    }
+    self->dirty_area.next = tail;
+    return &self->dirty_area;
+}
+
+void displayio_shape_finish_refresh(displayio_shape_t *self) {
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
+}
@@ -31,6 +31,7 @@
 #include <stdint.h>
 
 #include "py/obj.h"
+#include "shared-module/displayio/area.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -41,6 +42,10 @@ typedef struct {
     uint16_t* data;
     bool mirror_x;
     bool mirror_y;
+    displayio_area_t dirty_area; // Stored as shape coordinates.
 } displayio_shape_t;
 
+displayio_area_t* displayio_shape_get_refresh_areas(displayio_shape_t *self, displayio_area_t* tail);
+void displayio_shape_finish_refresh(displayio_shape_t *self);
+
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_SHAPE_H
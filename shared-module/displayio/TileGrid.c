@@ -26,10 +26,13 @@
 
 #include "shared-bindings/displayio/TileGrid.h"
 
+#include <string.h>
+
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/displayio/OnDiskBitmap.h"
 #include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/RLEBitmap.h"
 #include "shared-bindings/displayio/Shape.h"
 
 void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_t bitmap,
@@ -64,23 +67,46 @@ void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_
     self->pixel_shader = pixel_shader;
     self->x = x;
     self->y = y;
+    self->previous_area.x1 = 0;
+    self->previous_area.x2 = 0;
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
+    self->needs_refresh = false;
+    self->pending_changes = false;
 }
 
+// Starts a set of pending changes from the values that are currently drawn.
+static void _begin_pending(displayio_tilegrid_t *self) {
+    if (self->pending_changes) {
+        return;
+    }
+    self->pending_x = self->x;
+    self->pending_y = self->y;
+    self->pending_top_left_x = self->top_left_x;
+    self->pending_top_left_y = self->top_left_y;
+    self->pending_changes = true;
+}
 
 mp_int_t common_hal_displayio_tilegrid_get_x(displayio_tilegrid_t *self) {
+    if (self->pending_changes) {
+        return self->pending_x;
+    }
     return self->x;
 }
 void common_hal_displayio_tilegrid_set_x(displayio_tilegrid_t *self, mp_int_t x) {
-    self->needs_refresh = self->x != x;
-    self->x = x;
+    _begin_pending(self);
+    self->pending_x = x;
 }
 mp_int_t common_hal_displayio_tilegrid_get_y(displayio_tilegrid_t *self) {
+    if (self->pending_changes) {
+        return self->pending_y;
+    }
     return self->y;
 }
 
 void common_hal_displayio_tilegrid_set_y(displayio_tilegrid_t *self, mp_int_t y) {
-    self->needs_refresh = self->y != y;
-    self->y = y;
+    _begin_pending(self);
+    self->pending_y = y;
 }
 
 mp_obj_t common_hal_displayio_tilegrid_get_pixel_shader(displayio_tilegrid_t *self) {
@@ -112,6 +138,24 @@ uint8_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint1
     return tiles[y * self->width_in_tiles + x];
 }
 
+// Marks where the count tiles from x on row y are drawn as dirty. They are offset when the grid is
+// scrolled so the run may wrap around to the left edge.
+static void _mark_tiles_dirty(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t count) {
+    uint16_t column = (x + self->width_in_tiles - self->top_left_x % self->width_in_tiles) % self->width_in_tiles;
+    uint16_t row = (y + self->height_in_tiles - self->top_left_y % self->height_in_tiles) % self->height_in_tiles;
+    displayio_area_t tile_area;
+    tile_area.y1 = row * self->tile_height;
+    tile_area.y2 = tile_area.y1 + self->tile_height;
+    while (count > 0) {
+        uint16_t columns = MIN(count, self->width_in_tiles - column);
+        tile_area.x1 = column * self->tile_width;
+        tile_area.x2 = tile_area.x1 + columns * self->tile_width;
+        displayio_area_union(&self->dirty_area, &tile_area, &self->dirty_area);
+        count -= columns;
+        column = 0;
+    }
+}
+
 void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index) {
     uint8_t* tiles = self->tiles;
     if (self->inline_tiles) {
@@ -121,21 +165,135 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
         return;
     }
     tiles[y * self->width_in_tiles + x] = tile_index;
-    self->needs_refresh = true;
+    _mark_tiles_dirty(self, x, y, 1);
+}
+
+// Returns where the run of count tiles from x on row y is stored, clipping count to the row, or
+// NULL when the run is empty.
+static uint8_t* _get_tile_run(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t* count) {
+    uint8_t* tiles = self->tiles;
+    if (self->inline_tiles) {
+        tiles = (uint8_t*) &self->tiles;
+    }
+    if (tiles == NULL || x >= self->width_in_tiles || y >= self->height_in_tiles) {
+        return NULL;
+    }
+    *count = MIN(*count, self->width_in_tiles - x);
+    return tiles + y * self->width_in_tiles + x;
+}
+
+void displayio_tilegrid_set_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, const uint8_t* tile_indices, uint16_t count) {
+    uint8_t* run = _get_tile_run(self, x, y, &count);
+    if (run == NULL) {
+        return;
+    }
+    // Only mark the part of the run that changed.
+    uint16_t first = 0;
+    while (first < count && run[first] == tile_indices[first]) {
+        first++;
+    }
+    uint16_t end = count;
+    while (end > first && run[end - 1] == tile_indices[end - 1]) {
+        end--;
+    }
+    if (first == end) {
+        return;
+    }
+    memcpy(run + first, tile_indices + first, end - first);
+    _mark_tiles_dirty(self, x + first, y, end - first);
+}
+
+void displayio_tilegrid_fill_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index, uint16_t count) {
+    uint8_t* run = _get_tile_run(self, x, y, &count);
+    if (run == NULL) {
+        return;
+    }
+    uint16_t first = 0;
+    while (first < count && run[first] == tile_index) {
+        first++;
+    }
+    uint16_t end = count;
+    while (end > first && run[end - 1] == tile_index) {
+        end--;
+    }
+    if (first == end) {
+        return;
+    }
+    memset(run + first, tile_index, end - first);
+    _mark_tiles_dirty(self, x + first, y, end - first);
 }
 
 
 void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
-    self->top_left_x = x;
-    self->top_left_y = y;
+    _begin_pending(self);
+    self->pending_top_left_x = x;
+    self->pending_top_left_y = y;
 }
-bool displayio_tilegrid_get_pixel(displayio_tilegrid_t *self, int16_t x, int16_t y, uint16_t* pixel) {
-    x -= self->x;
-    y -= self->y;
-    if (y < 0 || y >= self->total_height || x >= self->total_width || x < 0) {
-        return false;
+
+// Returns how many tile rows the pending top_left scrolls the content up. The shorter direction
+// around the ring of rows is used so negative values scroll down.
+static int16_t _pending_scroll_rows(displayio_tilegrid_t *self) {
+    int16_t rows = (self->pending_top_left_y + self->height_in_tiles - self->top_left_y % self->height_in_tiles) % self->height_in_tiles;
+    if (rows > self->height_in_tiles / 2) {
+        rows -= self->height_in_tiles;
     }
+    return rows;
+}
 
+// Applies the pending changes. Called once at the start of a refresh.
+static void _commit_pending(displayio_tilegrid_t *self) {
+    if (!self->pending_changes) {
+        return;
+    }
+    if (self->scrolled_in_hardware) {
+        // The display already moved everything that was drawn. Only tiles that changed, which were
+        // marked relative to the old top_left, need to move with it.
+        int16_t local_pixels = _pending_scroll_rows(self) * self->tile_height;
+        displayio_area_shift(&self->dirty_area, 0, -local_pixels);
+        displayio_area_t bounds = {0, 0, self->total_width, self->total_height, NULL};
+        if (!displayio_area_compute_overlap(&bounds, &self->dirty_area, &self->dirty_area)) {
+            self->dirty_area.x1 = 0;
+            self->dirty_area.x2 = 0;
+        }
+        self->top_left_y = self->pending_top_left_y;
+        self->scrolled_in_hardware = false;
+    } else if (self->top_left_x != self->pending_top_left_x || self->top_left_y != self->pending_top_left_y) {
+        self->top_left_x = self->pending_top_left_x;
+        self->top_left_y = self->pending_top_left_y;
+        // Every tile moves so redraw everything.
+        self->needs_refresh = true;
+    }
+    self->x = self->pending_x;
+    self->y = self->pending_y;
+    self->pending_changes = false;
+}
+
+// Returns true when none of the count mask bits starting at offset are set.
+static bool _mask_clear(const uint32_t* mask, uint32_t offset, uint16_t count) {
+    uint32_t end = offset + count;
+    while (offset < end) {
+        uint32_t bit = offset % 32;
+        uint32_t bits = MIN(32 - bit, end - offset);
+        uint32_t word_mask = bits == 32 ? 0xffffffff : ((1u << bits) - 1) << bit;
+        if ((mask[offset / 32] & word_mask) != 0) {
+            return false;
+        }
+        offset += bits;
+    }
+    return true;
+}
+
+static void _mask_set(uint32_t* mask, uint32_t offset, uint16_t count) {
+    uint32_t end = offset + count;
+    while (offset < end) {
+        uint32_t bit = offset % 32;
+        uint32_t bits = MIN(32 - bit, end - offset);
+        mask[offset / 32] |= bits == 32 ? 0xffffffff : ((1u << bits) - 1) << bit;
+        offset += bits;
+    }
+}
+
+MP_RAMFUNC bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const displayio_transform_t* transform, const displayio_area_t* area, uint32_t* mask, uint16_t* buffer) {
     uint8_t* tiles = self->tiles;
     if (self->inline_tiles) {
         tiles = (uint8_t*) &self->tiles;
@@ -143,51 +301,326 @@ bool displayio_tilegrid_get_pixel(displayio_tilegrid_t *self, int16_t x, int16_t
     if (tiles == NULL) {
         return false;
     }
-    uint16_t tile_location = ((y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles + (x / self->tile_width + self->top_left_x) % self->width_in_tiles;
-    uint8_t tile = tiles[tile_location];
-    uint16_t tile_x = tile_x = (tile % self->bitmap_width_in_tiles) * self->tile_width + x % self->tile_width;
-    uint16_t tile_y = tile_y = (tile / self->bitmap_width_in_tiles) * self->tile_height + y % self->tile_height;
 
-    uint32_t value = 0;
+    uint16_t scale = transform->scale;
+    displayio_area_t tilegrid_area;
+    tilegrid_area.x1 = transform->x + scale * self->x;
+    tilegrid_area.y1 = transform->y + scale * self->y;
+    tilegrid_area.x2 = tilegrid_area.x1 + scale * self->total_width;
+    tilegrid_area.y2 = tilegrid_area.y1 + scale * self->total_height;
+    displayio_area_t overlap;
+    if (!displayio_area_compute_overlap(area, &tilegrid_area, &overlap)) {
+        return false;
+    }
+    bool full_coverage = displayio_area_equal(area, &overlap);
+
+    // Resolve the source and shader types once rather than for every pixel.
+    displayio_bitmap_t* bitmap = NULL;
+    displayio_rlebitmap_t* rle_bitmap = NULL;
+    uint32_t (*get_value)(void* source, int16_t x, int16_t y) = NULL;
     if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_bitmap_type)) {
-        value = common_hal_displayio_bitmap_get_pixel(self->bitmap, tile_x, tile_y);
+        bitmap = self->bitmap;
+    } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_rlebitmap_type)) {
+        rle_bitmap = self->bitmap;
     } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_shape_type)) {
-        value = common_hal_displayio_shape_get_pixel(self->bitmap, tile_x, tile_y);
+        get_value = common_hal_displayio_shape_get_pixel;
     } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_ondiskbitmap_type)) {
-        value = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, tile_x, tile_y);
+        get_value = (uint32_t (*)(void*, int16_t, int16_t)) common_hal_displayio_ondiskbitmap_get_pixel;
     }
+    bool unshaded = self->pixel_shader == mp_const_none;
+    displayio_palette_t* palette = NULL;
+    if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
+        palette = self->pixel_shader;
+    } else if (!MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type) && !unshaded) {
+        // Unknown shaders draw nothing.
+        return false;
+    }
+
+    // Unscaled 16-bit values without a shader are already display pixels so whole runs are copied.
+    bool copy_runs = bitmap != NULL && unshaded && scale == 1 && bitmap->bits_per_value == 16;
+
+    // Only the first pixel of the overlap is located by dividing. Every other row and tile is
+    // reached by stepping from it because chips like the SAMD21 have no hardware divide.
+    uint16_t first_local_x = (overlap.x1 - tilegrid_area.x1) / scale;
+    uint16_t first_repeat_x = (overlap.x1 - tilegrid_area.x1) % scale;
+    uint16_t first_column_in_tile = first_local_x % self->tile_width;
+    uint16_t first_tile_column = first_local_x / self->tile_width;
+    uint16_t first_grid_column = (first_tile_column + self->top_left_x) % self->width_in_tiles;
+    int16_t first_tile_end = tilegrid_area.x1 + (first_tile_column + 1) * self->tile_width * scale;
+    uint16_t tile_pixel_width = self->tile_width * scale;
+
+    uint16_t local_y = (overlap.y1 - tilegrid_area.y1) / scale;
+    uint16_t repeat_y = (overlap.y1 - tilegrid_area.y1) % scale;
+    uint16_t row_in_tile = local_y % self->tile_height;
+    uint16_t grid_row = (local_y / self->tile_height + self->top_left_y) % self->height_in_tiles;
+
+    uint16_t area_width = displayio_area_width(area);
+    uint32_t row_offset = (overlap.y1 - area->y1) * area_width + (overlap.x1 - area->x1);
+    for (int16_t y = overlap.y1; y < overlap.y2; y++) {
+        uint16_t tile_row = grid_row * self->width_in_tiles;
+        uint16_t grid_column = first_grid_column;
+        uint16_t column_in_tile = first_column_in_tile;
+        uint16_t repeat = first_repeat_x;
+        int16_t tile_end = first_tile_end;
+        uint32_t offset = row_offset;
+
+        int16_t x = overlap.x1;
+        while (x < overlap.x2) {
+            // Look up the tile once for every run of pixels it covers.
+            uint8_t tile = tiles[tile_row + grid_column];
+            uint16_t source_x = (tile % self->bitmap_width_in_tiles) * self->tile_width + column_in_tile;
+            uint16_t source_y = (tile / self->bitmap_width_in_tiles) * self->tile_height + row_in_tile;
+            uint16_t source_end = source_x + self->tile_width - column_in_tile;
+            int16_t run_end = tile_end;
+            if (run_end > overlap.x2) {
+                run_end = overlap.x2;
+            }
+
+            // Step to the next tile in the row.
+            tile_end += tile_pixel_width;
+            column_in_tile = 0;
+            grid_column++;
+            if (grid_column == self->width_in_tiles) {
+                grid_column = 0;
+            }
+
+            if (copy_runs && _mask_clear(mask, offset, run_end - x)) {
+                uint16_t count = run_end - x;
+                const uint16_t* row = displayio_bitmap_get_row_data(bitmap, source_y);
+                memcpy(buffer + offset, row + source_x, count * sizeof(uint16_t));
+                _mask_set(mask, offset, count);
+                offset += count;
+                x = run_end;
+                continue;
+            }
+
+            while (x < run_end) {
+                // Read the source values for the rest of the run a batch at a time.
+                uint32_t values[32];
+                // Runs clipped by the area end may read a few values they don't draw.
+                uint16_t count = source_end - source_x;
+                if (count > MP_ARRAY_SIZE(values)) {
+                    count = MP_ARRAY_SIZE(values);
+                }
+                if (bitmap != NULL) {
+                    common_hal_displayio_bitmap_get_row(bitmap, source_x, source_y, values, count);
+                } else if (rle_bitmap != NULL) {
+                    displayio_rlebitmap_get_row(rle_bitmap, source_x, source_y, values, count);
+                } else {
+                    for (uint16_t i = 0; i < count; i++) {
+                        values[i] = 0;
+                        if (get_value != NULL) {
+                            values[i] = get_value(self->bitmap, source_x + i, source_y);
+                        }
+                    }
+                }
+                source_x += count;
+
+                for (uint16_t i = 0; i < count && x < run_end; i++) {
+                    // Shade each value once no matter how many pixels it is scaled up to.
+                    bool shaded = false;
+                    bool opaque = true;
+                    uint16_t color = 0;
+                    for (; repeat < scale && x < run_end; repeat++, x++, offset++) {
+                        if ((mask[offset / 32] & (1u << (offset % 32))) != 0) {
+                            continue;
+                        }
+                        if (!shaded) {
+                            if (unshaded) {
+                                color = values[i];
+                            } else if (palette != NULL) {
+                                opaque = displayio_palette_get_color(palette, values[i], &color);
+                            } else {
+                                color = displayio_colorconverter_convert_888_to_565_swapped(values[i]);
+                            }
+                            shaded = true;
+                        }
+                        if (opaque) {
+                            buffer[offset] = color;
+                            mask[offset / 32] |= 1u << (offset % 32);
+                        } else {
+                            full_coverage = false;
+                        }
+                    }
+                    repeat = 0;
+                }
+            }
+        }
+
+        // Step to the next row, moving on to the next tile row once every row of the tile has been
+        // repeated scale times.
+        row_offset += area_width;
+        repeat_y++;
+        if (repeat_y == scale) {
+            repeat_y = 0;
+            row_in_tile++;
+            if (row_in_tile == self->tile_height) {
+                row_in_tile = 0;
+                grid_row++;
+                if (grid_row == self->height_in_tiles) {
+                    grid_row = 0;
+                }
+            }
+        }
+    }
+    return full_coverage;
+}
 
-    if (self->pixel_shader == mp_const_none) {
-        *pixel = value;
-        return true;
-    } else if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type) && displayio_palette_get_color(self->pixel_shader, value, pixel)) {
-        return true;
-    } else if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type) && common_hal_displayio_colorconverter_convert(self->pixel_shader, value, pixel)) {
-        return true;
+// Returns the area of a bitmap-like source that changed since the last refresh or NULL.
+static const displayio_area_t* _get_source_dirty_area(mp_obj_t source) {
+    if (MP_OBJ_IS_TYPE(source, &displayio_bitmap_type)) {
+        return displayio_bitmap_get_refresh_areas(source, NULL);
+    } else if (MP_OBJ_IS_TYPE(source, &displayio_shape_type)) {
+        return displayio_shape_get_refresh_areas(source, NULL);
+    }
+    return NULL;
+}
+
+bool displayio_tilegrid_get_vertical_scroll(displayio_tilegrid_t *self, const displayio_transform_t* transform, displayio_area_t* area, int16_t* pixels) {
+    if (!self->pending_changes || self->needs_refresh ||
+        self->pending_x != self->x || self->pending_y != self->y ||
+        self->pending_top_left_x != self->top_left_x || self->pending_top_left_y == self->top_left_y) {
+        return false;
     }
+    if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type) &&
+        displayio_palette_needs_refresh(self->pixel_shader)) {
+        return false;
+    }
+    if (_get_source_dirty_area(self->bitmap) != NULL) {
+        return false;
+    }
+    area->x1 = self->x;
+    area->y1 = self->y;
+    area->x2 = self->x + self->total_width;
+    area->y2 = self->y + self->total_height;
+    displayio_area_scale(area, transform->scale);
+    displayio_area_shift(area, transform->x, transform->y);
+    if (!displayio_area_equal(area, &self->previous_area)) {
+        return false;
+    }
+    *pixels = _pending_scroll_rows(self) * self->tile_height * transform->scale;
+    return true;
+}
 
-    return false;
+void displayio_tilegrid_set_scrolled_in_hardware(displayio_tilegrid_t *self) {
+    self->scrolled_in_hardware = true;
 }
 
-bool displayio_tilegrid_needs_refresh(displayio_tilegrid_t *self) {
-    if (self->needs_refresh) {
-        return true;
-    } else if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
-        return displayio_palette_needs_refresh(self->pixel_shader);
+displayio_area_t* displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *self, const displayio_transform_t* transform, displayio_area_t* tail) {
+    _commit_pending(self);
+
+    self->current_area.x1 = self->x;
+    self->current_area.y1 = self->y;
+    self->current_area.x2 = self->x + self->total_width;
+    self->current_area.y2 = self->y + self->total_height;
+    displayio_area_scale(&self->current_area, transform->scale);
+    displayio_area_shift(&self->current_area, transform->x, transform->y);
+
+    bool shader_changed = false;
+    if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
+        shader_changed = displayio_palette_needs_refresh(self->pixel_shader);
     } else if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type)) {
-        return displayio_colorconverter_needs_refresh(self->pixel_shader);
+        shader_changed = displayio_colorconverter_needs_refresh(self->pixel_shader);
+    }
+
+    const displayio_area_t* source_dirty = _get_source_dirty_area(self->bitmap);
+    if (source_dirty != NULL) {
+        uint8_t* tiles = self->tiles;
+        if (self->inline_tiles) {
+            tiles = (uint8_t*) &self->tiles;
+        }
+        // A single tile maps the source directly onto the grid. With more tiles the source area may
+        // be shown in many places so redraw it all.
+        if (self->width_in_tiles == 1 && self->height_in_tiles == 1 && tiles != NULL) {
+            uint8_t tile = tiles[0];
+            displayio_area_t tile_bounds;
+            tile_bounds.x1 = (tile % self->bitmap_width_in_tiles) * self->tile_width;
+            tile_bounds.y1 = (tile / self->bitmap_width_in_tiles) * self->tile_height;
+            tile_bounds.x2 = tile_bounds.x1 + self->tile_width;
+            tile_bounds.y2 = tile_bounds.y1 + self->tile_height;
+            displayio_area_t changed;
+            if (displayio_area_compute_overlap(&tile_bounds, source_dirty, &changed)) {
+                displayio_area_shift(&changed, -tile_bounds.x1, -tile_bounds.y1);
+                displayio_area_union(&self->dirty_area, &changed, &self->dirty_area);
+            }
+        } else {
+            self->needs_refresh = true;
+        }
     }
 
-    return false;
+    if (self->needs_refresh || shader_changed ||
+        !displayio_area_equal(&self->current_area, &self->previous_area)) {
+        // Redraw where we were and where we are now.
+        if (!displayio_area_empty(&self->previous_area)) {
+            self->previous_area.next = tail;
+            tail = &self->previous_area;
+        }
+        self->current_area.next = tail;
+        return &self->current_area;
+    }
+
+    if (displayio_area_empty(&self->dirty_area)) {
+        return tail;
+    }
+    displayio_area_copy(&self->dirty_area, &self->refresh_area);
+    displayio_area_scale(&self->refresh_area, transform->scale);
+    displayio_area_shift(&self->refresh_area, self->current_area.x1, self->current_area.y1);
+    self->refresh_area.next = tail;
+    return &self->refresh_area;
+}
+
+bool displayio_tilegrid_get_previous_area(displayio_tilegrid_t *self, displayio_area_t* area) {
+    if (displayio_area_empty(&self->previous_area)) {
+        return false;
+    }
+    displayio_area_copy(&self->previous_area, area);
+    return true;
+}
+
+bool displayio_tilegrid_get_opaque_area(displayio_tilegrid_t *self, displayio_area_t* area) {
+    if (self->tiles == NULL && !self->inline_tiles) {
+        return false;
+    }
+    if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
+        // Values past the end of the palette aren't drawn either.
+        uint32_t max_value = 1;
+        if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_bitmap_type)) {
+            displayio_bitmap_t* bitmap = self->bitmap;
+            if (bitmap->bits_per_value >= 32) {
+                return false;
+            }
+            max_value = (1u << bitmap->bits_per_value) - 1;
+        } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_rlebitmap_type)) {
+            displayio_rlebitmap_t* bitmap = self->bitmap;
+            max_value = bitmap->max_value;
+        } else if (!MP_OBJ_IS_TYPE(self->bitmap, &displayio_shape_type)) {
+            return false;
+        }
+        displayio_palette_t* palette = self->pixel_shader;
+        if (palette->transparent_count > 0 || max_value >= palette->color_count) {
+            return false;
+        }
+    } else if (!MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type) &&
+               self->pixel_shader != mp_const_none) {
+        return false;
+    }
+    displayio_area_copy(&self->current_area, area);
+    return !displayio_area_empty(area);
 }
 
 void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
+    displayio_area_copy(&self->current_area, &self->previous_area);
+    self->dirty_area.x1 = 0;
+    self->dirty_area.x2 = 0;
     self->needs_refresh = false;
     if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_palette_type)) {
         displayio_palette_finish_refresh(self->pixel_shader);
     } else if (MP_OBJ_IS_TYPE(self->pixel_shader, &displayio_colorconverter_type)) {
         displayio_colorconverter_finish_refresh(self->pixel_shader);
     }
-    // TODO(tannewt): We could double buffer changes to position and move them over here.
-    // That way they won't change during a refresh and tear.
+    if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_bitmap_type)) {
+        displayio_bitmap_finish_refresh(self->bitmap);
+    } else if (MP_OBJ_IS_TYPE(self->bitmap, &displayio_shape_type)) {
+        displayio_shape_finish_refresh(self->bitmap);
+    }
 }
@@ -31,6 +31,7 @@
 #include <stdint.h>
 
 #include "py/obj.h"
+#include "shared-module/displayio/area.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -47,13 +48,43 @@ typedef struct {
     uint16_t tile_height;
     uint16_t top_left_x;
     uint16_t top_left_y;
+    // Position changes are latched here and applied together at the start of the next refresh so
+    // that a refresh never draws a mix of old and new positions.
+    uint16_t pending_x;
+    uint16_t pending_y;
+    uint16_t pending_top_left_x;
+    uint16_t pending_top_left_y;
     uint8_t* tiles;
-    bool needs_refresh;
+    displayio_area_t previous_area; // Stored as display coordinates.
+    displayio_area_t current_area; // Stored as display coordinates.
+    displayio_area_t dirty_area; // Stored as local pixel coordinates.
+    displayio_area_t refresh_area; // dirty_area converted to display coordinates.
+    bool needs_refresh; // The whole tile grid needs to be redrawn.
     bool inline_tiles;
+    bool pending_changes; // The pending values are valid and differ from the drawn ones.
+    bool scrolled_in_hardware; // The display moves the drawn pixels for the pending top_left.
 } displayio_tilegrid_t;
 
-bool displayio_tilegrid_get_pixel(displayio_tilegrid_t *self, int16_t x, int16_t y, uint16_t *pixel);
-bool displayio_tilegrid_needs_refresh(displayio_tilegrid_t *self);
+// Set a run of tiles on one row with a single update of the dirty area. Runs are clipped to the row
+// and only the tiles that change are redrawn.
+void displayio_tilegrid_set_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, const uint8_t* tile_indices, uint16_t count);
+void displayio_tilegrid_fill_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint8_t tile_index, uint16_t count);
+
+// Fills the pixels of area, which is in display coordinates, that aren't masked yet. Filled pixels
+// are added to the mask. Returns true when every pixel of area was filled.
+bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const displayio_transform_t* transform, const displayio_area_t* area, uint32_t* mask, uint16_t* buffer);
+displayio_area_t* displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *self, const displayio_transform_t* transform, displayio_area_t* tail);
+bool displayio_tilegrid_get_previous_area(displayio_tilegrid_t *self, displayio_area_t* area);
+// Returns true when the grid draws every pixel of where it is drawn this refresh so nothing beneath
+// it shows through. area is set to that area. Only valid after get_refresh_areas.
+bool displayio_tilegrid_get_opaque_area(displayio_tilegrid_t *self, displayio_area_t* area);
+// Returns true when the only change since the last refresh is a vertical scroll of the tiles through
+// top_left. area is set to where the grid is drawn and pixels to how far, in display pixels, its
+// content moves up. Negative pixels move it down.
+bool displayio_tilegrid_get_vertical_scroll(displayio_tilegrid_t *self, const displayio_transform_t* transform, displayio_area_t* area, int16_t* pixels);
+// Called when the display scrolls the grid's pixels itself so that the next refresh only draws the
+// tiles that changed.
+void displayio_tilegrid_set_scrolled_in_hardware(displayio_tilegrid_t *self);
 void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self);
 
 #endif // MICROPY_INCLUDED_SHARED_MODULE_DISPLAYIO_TILEGRID_H
@@ -0,0 +1,158 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/displayio/VirtualBus.h"
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-module/displayio/mipi_constants.h"
+
+void common_hal_displayio_virtualbus_construct(displayio_virtualbus_obj_t* self, uint16_t width,
+        uint16_t height) {
+    size_t length = (size_t) width * height * sizeof(uint16_t);
+    self->pixels = m_malloc(length, true);
+    memset(self->pixels, 0, length);
+    self->framebuffer = mp_obj_new_bytearray_by_ref(length, self->pixels);
+    self->width = width;
+    self->height = height;
+    self->x1 = 0;
+    self->y1 = 0;
+    self->x2 = width - 1;
+    self->y2 = height - 1;
+    self->x = 0;
+    self->y = 0;
+    self->scroll_offset = 0;
+    self->command = 0;
+    self->parameter_count = 0;
+    self->locked = false;
+}
+
+void common_hal_displayio_virtualbus_deinit(displayio_virtualbus_obj_t* self) {
+    self->framebuffer = mp_const_none;
+    self->pixels = NULL;
+}
+
+mp_obj_t common_hal_displayio_virtualbus_get_framebuffer(displayio_virtualbus_obj_t* self) {
+    return self->framebuffer;
+}
+
+uint16_t common_hal_displayio_virtualbus_get_scroll_offset(displayio_virtualbus_obj_t* self) {
+    return self->scroll_offset;
+}
+
+bool common_hal_displayio_virtualbus_begin_transaction(mp_obj_t obj) {
+    displayio_virtualbus_obj_t* self = MP_OBJ_TO_PTR(obj);
+    if (self->locked) {
+        return false;
+    }
+    self->locked = true;
+    return true;
+}
+
+// Copies pixels into the window a row segment at a time. Like a real display, writing wraps to the
+// start of the next row at the right edge of the window and back to the top at the bottom. Pixels
+// outside the display memory are dropped.
+static void _write_pixels(displayio_virtualbus_obj_t* self, const uint8_t* data, uint32_t length) {
+    while (length >= sizeof(uint16_t)) {
+        if (self->y > self->y2) {
+            self->y = self->y1;
+        }
+        uint32_t count = self->x2 + 1 - self->x;
+        if (count > length / sizeof(uint16_t)) {
+            count = length / sizeof(uint16_t);
+        }
+        if (self->y < self->height && self->x < self->width) {
+            uint32_t visible = count;
+            if (self->x + visible > self->width) {
+                visible = self->width - self->x;
+            }
+            memcpy(self->pixels + (self->y * self->width + self->x) * sizeof(uint16_t), data,
+                   visible * sizeof(uint16_t));
+        }
+        data += count * sizeof(uint16_t);
+        length -= count * sizeof(uint16_t);
+        self->x += count;
+        if (self->x > self->x2) {
+            self->x = self->x1;
+            self->y++;
+        }
+    }
+}
+
+// Parameters are 16 bit big endian values, as sent when single_byte_bounds is off.
+static uint16_t _parameter(displayio_virtualbus_obj_t* self, uint8_t index) {
+    return self->parameters[index * 2] << 8 | self->parameters[index * 2 + 1];
+}
+
+static void _receive_parameter(displayio_virtualbus_obj_t* self, uint8_t parameter) {
+    if (self->parameter_count < sizeof(self->parameters)) {
+        self->parameters[self->parameter_count] = parameter;
+    }
+    self->parameter_count++;
+    if (self->command == MIPI_COMMAND_SET_COLUMN_ADDRESS && self->parameter_count == 4) {
+        self->x1 = _parameter(self, 0);
+        self->x2 = MAX(_parameter(self, 1), self->x1);
+    } else if (self->command == MIPI_COMMAND_SET_PAGE_ADDRESS && self->parameter_count == 4) {
+        self->y1 = _parameter(self, 0);
+        self->y2 = MAX(_parameter(self, 1), self->y1);
+    } else if (self->command == MIPI_COMMAND_SET_SCROLL_START && self->parameter_count == 2) {
+        self->scroll_offset = _parameter(self, 0);
+    }
+}
+
+void common_hal_displayio_virtualbus_send(mp_obj_t obj, bool command, uint8_t *data, uint32_t data_length) {
+    displayio_virtualbus_obj_t* self = MP_OBJ_TO_PTR(obj);
+    if (self->pixels == NULL) {
+        return;
+    }
+    if (command) {
+        // Only the window, memory write and scroll commands do anything. Others, such as those in
+        // an init sequence, are ignored along with their parameters.
+        if (data_length == 0) {
+            return;
+        }
+        self->command = data[data_length - 1];
+        self->parameter_count = 0;
+        if (self->command == MIPI_COMMAND_WRITE_MEMORY_START) {
+            self->x = self->x1;
+            self->y = self->y1;
+        }
+        return;
+    }
+    if (self->command == MIPI_COMMAND_WRITE_MEMORY_START) {
+        _write_pixels(self, data, data_length);
+        return;
+    }
+    for (uint32_t i = 0; i < data_length; i++) {
+        _receive_parameter(self, data[i]);
+    }
+}
+
+void common_hal_displayio_virtualbus_end_transaction(mp_obj_t obj) {
+    displayio_virtualbus_obj_t* self = MP_OBJ_TO_PTR(obj);
+    self->locked = false;
+}
@@ -12,20 +12,219 @@
 #include "shared-bindings/displayio/Palette.h"
 #include "supervisor/shared/autoreload.h"
 #include "supervisor/shared/display.h"
+#include "supervisor/shared/performance.h"
 #include "supervisor/memory.h"
 #include "supervisor/usb.h"
 
-primary_display_t displays[CIRCUITPY_DISPLAY_LIMIT];
+#include "tick.h"
 
-static inline void swap(uint16_t* a, uint16_t* b) {
-    uint16_t temp = *a;
-    *a = *b;
-    *b = temp;
-}
+primary_display_t displays[CIRCUITPY_DISPLAY_LIMIT];
 
 // Check for recursive calls to displayio_refresh_displays.
 bool refresh_displays_in_progress = false;
 
+static const displayio_transform_t identity_transform = {0, 0, 1};
+
+static uint64_t _now_us(void) {
+    uint64_t ms;
+    uint32_t us_until_ms;
+    current_tick(&ms, &us_until_ms);
+    return ms * 1000 + (1000 - us_until_ms);
+}
+
+// Side of the square tiles that transposed displays are rendered in. A tile must fit in the
+// transmit buffer.
+#define DISPLAYIO_TRANSPOSE_TILE_SIZE (16)
+
+// Waits for the pixels queued on the display's bus to be sent and releases the bus.
+static void _finish_sending(displayio_display_obj_t* display) {
+    if (display->sending) {
+        uint64_t start_us = _now_us();
+        displayio_display_end_transaction(display);
+        display->sending = false;
+        display->refresh_stats.transmit_us += _now_us() - start_us;
+    }
+}
+
+// Renders and sends the next band of memory rows of an area, given in display coordinates,
+// starting refresh_rows_done memory rows into it. The last chunk is left sending in the background
+// with the bus held so that other displays can render meanwhile. Sets area_done once the band
+// reaches the end of the area. Returns false when the display bus couldn't be acquired.
+static bool refresh_area_band(displayio_display_obj_t* display, const displayio_area_t* area, bool* area_done) {
+    // Mirroring happens in display coordinates and then transposing swaps rows and columns of the
+    // display's memory.
+    int16_t x1 = area->x1;
+    int16_t x2 = area->x2;
+    if (display->mirror_x) {
+        x1 = display->width - area->x2;
+        x2 = display->width - area->x1;
+    }
+    int16_t y1 = area->y1;
+    int16_t y2 = area->y2;
+    if (display->mirror_y) {
+        y1 = display->height - area->y2;
+        y2 = display->height - area->y1;
+    }
+    // r and c are row and column to match the display memory structure.
+    uint16_t c0 = x1;
+    uint16_t c1 = x2;
+    uint16_t r0 = y1;
+    uint16_t r1 = y2;
+    if (display->transpose_xy) {
+        c0 = y1;
+        c1 = y2;
+        r0 = x1;
+        r1 = x2;
+    }
+
+    // When the display is scrolled in hardware, logical row r is stored in memory row
+    // (r + scroll_offset) % height. Rows past wrap_row continue at the start of memory.
+    uint16_t offset = display->scroll_offset;
+    uint16_t wrap_row = r1;
+    if (offset > 0 && display->height - offset < r1) {
+        wrap_row = display->height - offset;
+    }
+
+    // Render whole memory rows at a time when they fit in the buffer and row segments otherwise.
+    uint16_t buffer_size = DISPLAYIO_BUFFER_SIZE;
+    uint16_t columns = c1 - c0;
+    uint16_t rows_per_chunk = 1;
+    if (columns <= buffer_size) {
+        rows_per_chunk = buffer_size / columns;
+    } else {
+        columns = buffer_size;
+    }
+    // Memory rows of a transposed display are logical columns so rendering whole rows reads the
+    // source bitmaps column by column. Instead, render square tiles in logical order and give each
+    // one its own update window. Scrolling in hardware is never enabled for transposed displays so
+    // the windows don't need to wrap.
+    bool tiled = display->transpose_xy && rows_per_chunk < DISPLAYIO_TRANSPOSE_TILE_SIZE;
+    if (tiled) {
+        columns = DISPLAYIO_TRANSPOSE_TILE_SIZE;
+        rows_per_chunk = DISPLAYIO_TRANSPOSE_TILE_SIZE;
+    }
+
+    // Resume where the last band stopped. Bands always end on a row boundary so the rest of the
+    // area is still a rectangle.
+    uint16_t r = r0 + display->refresh_rows_done;
+    uint16_t chunk_rows = rows_per_chunk;
+    if (r < wrap_row && r + chunk_rows > wrap_row) {
+        chunk_rows = wrap_row - r;
+    } else if (r + chunk_rows > r1) {
+        chunk_rows = r1 - r;
+    }
+
+    uint32_t pixels[DISPLAYIO_BUFFER_SIZE / 2];
+    uint32_t mask[DISPLAYIO_BUFFER_SIZE / 32];
+    bool reorder = display->transpose_xy || display->mirror_x || display->mirror_y;
+
+    for (uint16_t c = c0; c < c1; c += columns) {
+        uint16_t chunk_columns = columns;
+        if (c + chunk_columns > c1) {
+            chunk_columns = c1 - c;
+        }
+        // Convert the memory chunk back into a logical area of the groups.
+        displayio_area_t chunk;
+        chunk.x1 = c;
+        chunk.x2 = c + chunk_columns;
+        chunk.y1 = r;
+        chunk.y2 = r + chunk_rows;
+        if (display->transpose_xy) {
+            chunk.x1 = r;
+            chunk.x2 = r + chunk_rows;
+            chunk.y1 = c;
+            chunk.y2 = c + chunk_columns;
+        }
+        if (display->mirror_x) {
+            int16_t x1 = display->width - chunk.x2;
+            chunk.x2 = display->width - chunk.x1;
+            chunk.x1 = x1;
+        }
+        if (display->mirror_y) {
+            int16_t y1 = display->height - chunk.y2;
+            chunk.y2 = display->height - chunk.y1;
+            chunk.y1 = y1;
+        }
+        uint16_t chunk_width = displayio_area_width(&chunk);
+        uint32_t chunk_size = displayio_area_size(&chunk);
+
+        // Render while the previous chunk is still being sent from the display's buffer.
+        uint64_t render_start_us = _now_us();
+        uint16_t* rendered = (uint16_t*) pixels;
+        memset(rendered, 0, chunk_size * sizeof(uint16_t));
+        memset(mask, 0, ((chunk_size + 31) / 32) * sizeof(uint32_t));
+        if (display->current_group != NULL) {
+            displayio_group_fill_area(display->current_group, &identity_transform, &chunk, mask, rendered);
+        }
+        display->refresh_stats.render_us += _now_us() - render_start_us;
+        display->refresh_stats.pixels_rendered += chunk_size;
+
+        // Ending the transaction waits for the previous chunk to finish sending.
+        if (display->sending) {
+            _finish_sending(display);
+            usb_background();
+        }
+        uint64_t transmit_start_us = _now_us();
+        if (!displayio_display_begin_transaction(display)) {
+            // Can't acquire display bus; redo this band next time.
+            display->refresh_window_set = false;
+            display->refresh_stats.bus_busy++;
+            return false;
+        }
+        display->sending = true;
+        if (tiled) {
+            displayio_display_set_region_to_update(display, c, r, c + chunk_columns, r + chunk_rows);
+        } else if (!display->refresh_window_set) {
+            if (r < wrap_row) {
+                displayio_display_set_region_to_update(display, c0, r + offset, c1, wrap_row + offset);
+            } else {
+                displayio_display_set_region_to_update(display, c0, r + offset - display->height, c1, r1 + offset - display->height);
+            }
+            display->refresh_window_set = true;
+        }
+
+        uint64_t copy_start_us = _now_us();
+        display->refresh_stats.transmit_us += copy_start_us - transmit_start_us;
+
+        uint16_t* out = (uint16_t*) display->send_buffer;
+        if (reorder) {
+            // Copy the logical rows into the order the display memory expects.
+            size_t index = 0;
+            for (uint16_t i = 0; i < chunk_rows; i++) {
+                for (uint16_t j = 0; j < chunk_columns; j++) {
+                    uint16_t x = j;
+                    uint16_t y = i;
+                    if (display->transpose_xy) {
+                        x = i;
+                        y = j;
+                    }
+                    if (display->mirror_x) {
+                        x = chunk_width - 1 - x;
+                    }
+                    if (display->mirror_y) {
+                        y = displayio_area_height(&chunk) - 1 - y;
+                    }
+                    out[index++] = rendered[y * chunk_width + x];
+                }
+            }
+        } else {
+            memcpy(out, rendered, chunk_size * sizeof(uint16_t));
+        }
+        uint64_t send_start_us = _now_us();
+        display->refresh_stats.render_us += send_start_us - copy_start_us;
+        displayio_display_send_pixels(display, (uint8_t*) out, chunk_size * sizeof(uint16_t));
+        display->refresh_stats.transmit_us += _now_us() - send_start_us;
+        display->refresh_stats.pixels_sent += chunk_size;
+    }
+
+    display->refresh_rows_done += chunk_rows;
+    *area_done = r + chunk_rows == r1;
+    if (*area_done || r + chunk_rows == wrap_row) {
+        display->refresh_window_set = false;
+    }
+    return true;
+}
+
 void displayio_refresh_displays(void) {
     if (mp_hal_is_interrupted()) {
         return;
@@ -42,6 +241,8 @@ void displayio_refresh_displays(void) {
 
     refresh_displays_in_progress = true;
 
+    // Each display with a refresh to do gets its own time slice starting now.
+    uint64_t start_us = _now_us();
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
         if (displays[i].display.base.type == NULL || displays[i].display.base.type == &mp_type_NoneType) {
             // Skip null display.
@@ -50,110 +251,86 @@ void displayio_refresh_displays(void) {
         displayio_display_obj_t* display = &displays[i].display;
         displayio_display_update_backlight(display);
 
-        // Time to refresh at specified frame rate?
-        if (!displayio_display_frame_queued(display)) {
-            // Too soon. Try next display.
-            continue;
-        }
-        if (displayio_display_refresh_queued(display)) {
-            // We compute the pixels. r and c are row and column to match the display memory
-            // structure. x and y match location within the groups.
-            uint16_t c0 = 0;
-            uint16_t r0 = 0;
-            uint16_t c1 = display->width;
-            uint16_t r1 = display->height;
-            if (display->transpose_xy) {
-                swap(&c1, &r1);
-            }
-
-            if (!displayio_display_begin_transaction(display)) {
-                // Can't acquire display bus; skip updating this display. Try next display.
+        if (!display->refresh_in_progress) {
+            // Time to refresh at specified frame rate?
+            if (!displayio_display_frame_queued(display)) {
+                // Too soon. Try next display.
                 continue;
             }
-            displayio_display_set_region_to_update(display, c0, r0, c1, r1);
-            displayio_display_end_transaction(display);
-
-            uint16_t x0 = 0;
-            uint16_t x1 = display->width - 1;
-            uint16_t startx = 0;
-            int8_t dx = 1;
-            if (display->mirror_x) {
-                dx = -1;
-                startx = x1;
-            }
-            uint16_t y0 = 0;
-            uint16_t y1 = display->height - 1;
-            uint16_t starty = 0;
-            int8_t dy = 1;
-            if (display->mirror_y) {
-                dy = -1;
-                starty = y1;
+            if (!displayio_display_refresh_queued(display)) {
+                displayio_display_finish_refresh(display);
+                continue;
             }
-
-            bool transpose = false;
-            if (display->transpose_xy) {
-                transpose = true;
-                int8_t temp_dx = dx;
-                dx = dy;
-                dy = temp_dx;
-
-                swap(&starty, &startx);
-                swap(&x0, &y0);
-                swap(&x1, &y1);
+            display->refresh_in_progress = true;
+            display->refresh_area_index = 0;
+            display->refresh_rows_done = 0;
+            display->refresh_start_us = start_us;
+            memset(&display->refresh_stats, 0, sizeof(display->refresh_stats));
+            for (uint8_t j = 0; j < display->dirty_area_count; j++) {
+                displayio_area_union(&display->refresh_stats.dirty_area, &display->dirty_areas[j], &display->refresh_stats.dirty_area);
             }
+        }
+    }
 
-            size_t index = 0;
-            uint16_t buffer_size = 256;
-            uint32_t buffer[buffer_size / 2];
-            bool skip_this_display = false;
-
-            for (uint16_t y = starty; y0 <= y && y <= y1; y += dy) {
-                for (uint16_t x = startx; x0 <= x && x <= x1; x += dx) {
-                    uint16_t* pixel = &(((uint16_t*)buffer)[index]);
-                    *pixel = 0;
-
-                    if (display->current_group != NULL) {
-                        if (transpose) {
-                            displayio_group_get_pixel(display->current_group, y, x, pixel);
-                        } else {
-                            displayio_group_get_pixel(display->current_group, x, y, pixel);
-                        }
-                    }
+    // Render at full speed when the CPU has been slowed down to save power.
+    bool boosted = false;
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+        if (displays[i].display.base.type != NULL &&
+            displays[i].display.base.type != &mp_type_NoneType &&
+            displays[i].display.refresh_in_progress) {
+            supervisor_performance_boost();
+            boosted = true;
+            break;
+        }
+    }
 
-                    index += 1;
-                    // The buffer is full, send it.
-                    if (index >= buffer_size) {
-                        if (!displayio_display_begin_transaction(display)) {
-                            // Can't acquire display bus; skip the rest of the data. Try next display.
-                            index = 0;
-                            skip_this_display = true;
-                            break;
-                        }
-                        displayio_display_send_pixels(display, buffer, buffer_size / 2);
-                        displayio_display_end_transaction(display);
-                        // TODO(tannewt): Make refresh displays faster so we don't starve other
-                        // background tasks.
-                        usb_background();
-                        index = 0;
-                    }
-                }
+    // Render one band per display at a time so that while one display's bus is sending, the next
+    // display is rendering. Stop once no display can make progress: each one has either finished,
+    // run out of time or is waiting on a bus that's in use.
+    bool progressed = true;
+    while (progressed) {
+        progressed = false;
+        for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+            if (displays[i].display.base.type == NULL || displays[i].display.base.type == &mp_type_NoneType) {
+                continue;
             }
-
-            if (skip_this_display) {
-                // Go on to next display.
+            displayio_display_obj_t* display = &displays[i].display;
+            if (!display->refresh_in_progress ||
+                (display->refresh_time_slice > 0 && _now_us() - start_us >= display->refresh_time_slice)) {
                 continue;
             }
-            // Send the remaining data.
-            if (index) {
-                if (!displayio_display_begin_transaction(display)) {
-                    // Can't get display bus. Skip the rest of the data. Try next display.
+            if (display->refresh_area_index < display->dirty_area_count) {
+                bool area_done = false;
+                if (!refresh_area_band(display, &display->dirty_areas[display->refresh_area_index], &area_done)) {
+                    // Can't acquire display bus; retry from the same spot.
                     continue;
                 }
-                displayio_display_send_pixels(display, buffer, index * 2);
+                if (area_done) {
+                    display->refresh_area_index++;
+                    display->refresh_rows_done = 0;
+                }
+            }
+            if (display->refresh_area_index == display->dirty_area_count) {
+                _finish_sending(display);
+                displayio_display_finish_refresh(display);
+                display->refresh_stats.refresh_us = _now_us() - display->refresh_start_us;
+                display->last_refresh_stats = display->refresh_stats;
             }
-            displayio_display_end_transaction(display);
+            progressed = true;
         }
-        displayio_display_finish_refresh(display);
+    }
+
+    // Don't hold any bus while other code runs. It may also write to the display, so windows need
+    // to be set again when refreshes resume.
+    for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
+        if (displays[i].display.base.type == NULL || displays[i].display.base.type == &mp_type_NoneType) {
+            continue;
+        }
+        _finish_sending(&displays[i].display);
+        displays[i].display.refresh_window_set = false;
+    }
+    if (boosted) {
+        supervisor_performance_unboost();
     }
 
     // All done.
@@ -162,15 +339,21 @@ void displayio_refresh_displays(void) {
 
 void common_hal_displayio_release_displays(void) {
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
-        mp_const_obj_t bus_type = displays[i].fourwire_bus.base.type;
+        mp_const_obj_t bus_type = displays[i].bus_base.type;
         if (bus_type == NULL) {
             continue;
+        #if CIRCUITPY_MICROCONTROLLER
         } else if (bus_type == &displayio_fourwire_type) {
             common_hal_displayio_fourwire_deinit(&displays[i].fourwire_bus);
         } else if (bus_type == &displayio_parallelbus_type) {
             common_hal_displayio_parallelbus_deinit(&displays[i].parallel_bus);
+        #endif
+        #if CIRCUITPY_SIMULATOR
+        } else if (bus_type == &displayio_virtualbus_type) {
+            common_hal_displayio_virtualbus_deinit(&displays[i].virtual_bus);
+        #endif
         }
-        displays[i].fourwire_bus.base.type = &mp_type_NoneType;
+        displays[i].bus_base.type = &mp_type_NoneType;
     }
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
         release_display(&displays[i].display);
@@ -182,6 +365,7 @@ void common_hal_displayio_release_displays(void) {
 
 void reset_displays(void) {
     #if CIRCUITPY_DISPLAYIO
+    #if CIRCUITPY_MICROCONTROLLER
     // The SPI buses used by FourWires may be allocated on the heap so we need to move them inline.
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
         if (displays[i].fourwire_bus.base.type != &displayio_fourwire_type) {
@@ -209,6 +393,7 @@ void reset_displays(void) {
             }
         }
     }
+    #endif
 
     for (uint8_t i = 0; i < CIRCUITPY_DISPLAY_LIMIT; i++) {
         if (displays[i].display.base.type == NULL) {
@@ -220,3 +405,81 @@ void reset_displays(void) {
     }
     #endif
 }
+
+bool displayio_area_empty(const displayio_area_t* a) {
+    return a->x1 >= a->x2 || a->y1 >= a->y2;
+}
+
+void displayio_area_copy(const displayio_area_t* src, displayio_area_t* dst) {
+    dst->x1 = src->x1;
+    dst->y1 = src->y1;
+    dst->x2 = src->x2;
+    dst->y2 = src->y2;
+}
+
+void displayio_area_union(const displayio_area_t* a,
+                          const displayio_area_t* b,
+                          displayio_area_t* u) {
+    if (displayio_area_empty(a)) {
+        displayio_area_copy(b, u);
+        return;
+    }
+    if (displayio_area_empty(b)) {
+        displayio_area_copy(a, u);
+        return;
+    }
+    u->x1 = MIN(a->x1, b->x1);
+    u->y1 = MIN(a->y1, b->y1);
+    u->x2 = MAX(a->x2, b->x2);
+    u->y2 = MAX(a->y2, b->y2);
+}
+
+bool displayio_area_compute_overlap(const displayio_area_t* a,
+                                    const displayio_area_t* b,
+                                    displayio_area_t* overlap) {
+    overlap->x1 = MAX(a->x1, b->x1);
+    overlap->y1 = MAX(a->y1, b->y1);
+    overlap->x2 = MIN(a->x2, b->x2);
+    overlap->y2 = MIN(a->y2, b->y2);
+    return !displayio_area_empty(overlap);
+}
+
+bool displayio_area_equal(const displayio_area_t* a, const displayio_area_t* b) {
+    return a->x1 == b->x1 &&
+           a->y1 == b->y1 &&
+           a->x2 == b->x2 &&
+           a->y2 == b->y2;
+}
+
+void displayio_area_shift(displayio_area_t* area, int16_t dx, int16_t dy) {
+    area->x1 += dx;
+    area->y1 += dy;
+    area->x2 += dx;
+    area->y2 += dy;
+}
+
+void displayio_area_scale(displayio_area_t* area, uint16_t scale) {
+    area->x1 *= scale;
+    area->y1 *= scale;
+    area->x2 *= scale;
+    area->y2 *= scale;
+}
+
+uint16_t displayio_area_width(const displayio_area_t* area) {
+    return area->x2 - area->x1;
+}
+
+uint16_t displayio_area_height(const displayio_area_t* area) {
+    return area->y2 - area->y1;
+}
+
+uint32_t displayio_area_size(const displayio_area_t* area) {
+    return displayio_area_width(area) * displayio_area_height(area);
+}
+
+bool displayio_area_contains(const displayio_area_t* a, const displayio_area_t* b) {
+    return a->x1 <= b->x1 &&
+           a->y1 <= b->y1 &&
+           a->x2 >= b->x2 &&
+           a->y2 >= b->y2;
+}
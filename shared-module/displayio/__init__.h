@@ -28,14 +28,26 @@
 #define MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO___INIT___H
 
 #include "shared-bindings/displayio/Display.h"
-#include "shared-bindings/displayio/FourWire.h"
 #include "shared-bindings/displayio/Group.h"
+#if CIRCUITPY_MICROCONTROLLER
+#include "shared-bindings/displayio/FourWire.h"
 #include "shared-bindings/displayio/ParallelBus.h"
+#endif
+#if CIRCUITPY_SIMULATOR
+#include "shared-bindings/displayio/VirtualBus.h"
+#endif
 
 typedef struct {
     union {
+        // Every bus starts with its base, so this tells which one is in use.
+        mp_obj_base_t bus_base;
+        #if CIRCUITPY_MICROCONTROLLER
         displayio_fourwire_obj_t fourwire_bus;
         displayio_parallelbus_obj_t parallel_bus;
+        #endif
+        #if CIRCUITPY_SIMULATOR
+        displayio_virtualbus_obj_t virtual_bus;
+        #endif
     };
     displayio_display_obj_t display;
 } primary_display_t;
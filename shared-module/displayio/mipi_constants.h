@@ -32,6 +32,7 @@ enum mipi_command {
     MIPI_COMMAND_SET_COLUMN_ADDRESS = 0x2a,
     MIPI_COMMAND_SET_PAGE_ADDRESS = 0x2b,
     MIPI_COMMAND_WRITE_MEMORY_START = 0x2c,
+    MIPI_COMMAND_SET_SCROLL_START = 0x37,
 };
 
 #endif // MICROPY_INCLUDED_SHARED_BINDINGS_DISPLAYIO_MIPI_CONSTANTS_H
@@ -42,22 +42,42 @@ mp_obj_t common_hal_fontio_builtinfont_get_bounding_box(const fontio_builtinfont
     return mp_obj_new_tuple(2, items);
 }
 
+// Remembers recent lookups of non-ASCII code points, indexed by the low bits of the code point, so
+// that text that repeats them doesn't search the whole mapping every time. Fonts are const so the
+// cache lives here rather than in the font.
+#define GLYPH_CACHE_SIZE (16)
+typedef struct {
+    const fontio_builtinfont_t* font;
+    mp_uint_t codepoint;
+    uint8_t glyph_index;
+} glyph_cache_entry_t;
+STATIC glyph_cache_entry_t glyph_cache[GLYPH_CACHE_SIZE];
+
 uint8_t fontio_builtinfont_get_glyph_index(const fontio_builtinfont_t *self, mp_uint_t codepoint) {
     if (codepoint >= 0x20 && codepoint <= 0x7e) {
         return codepoint - 0x20;
     }
+    glyph_cache_entry_t* entry = &glyph_cache[codepoint % GLYPH_CACHE_SIZE];
+    if (entry->font == self && entry->codepoint == codepoint) {
+        return entry->glyph_index;
+    }
     // Do a linear search of the mapping for unicode.
+    uint8_t glyph_index = 0xff;
     const byte* j = self->unicode_characters;
     uint8_t k = 0;
     while (j < self->unicode_characters + self->unicode_characters_len) {
         unichar potential_c = utf8_get_char(j);
         j = utf8_next_char(j);
         if (codepoint == potential_c) {
-            return 0x7f - 0x20 + k;
+            glyph_index = 0x7f - 0x20 + k;
+            break;
         }
         k++;
     }
-    return 0xff;
+    entry->font = self;
+    entry->codepoint = codepoint;
+    entry->glyph_index = glyph_index;
+    return glyph_index;
 }
 
 mp_obj_t common_hal_fontio_builtinfont_get_glyph(const fontio_builtinfont_t *self, mp_uint_t codepoint) {
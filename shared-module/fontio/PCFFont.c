@@ -0,0 +1,300 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/fontio/PCFFont.h"
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/objnamedtuple.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/fontio/Glyph.h"
+#include "supervisor/shared/translate.h"
+
+// Table types and format bits from the X11 PCF format. Each table starts with its format as a
+// little endian word. Everything after it uses the byte order given by PCF_BYTE_MASK.
+#define PCF_ACCELERATORS (1 << 1)
+#define PCF_METRICS (1 << 2)
+#define PCF_BITMAPS (1 << 3)
+#define PCF_BDF_ENCODINGS (1 << 5)
+#define PCF_BDF_ACCELERATORS (1 << 8)
+
+#define PCF_GLYPH_PAD_MASK (3 << 0)
+#define PCF_BYTE_MASK (1 << 2)
+#define PCF_BIT_MASK (1 << 3)
+#define PCF_SCAN_UNIT_MASK (3 << 4)
+#define PCF_COMPRESSED_METRICS (0x100)
+
+#define PCF_NO_GLYPH (0xffff)
+
+typedef struct {
+    int16_t left_side_bearing;
+    int16_t right_side_bearing;
+    int16_t character_width;
+    int16_t ascent;
+    int16_t descent;
+} pcf_metrics_t;
+
+STATIC void read_at(fontio_pcffont_t *self, uint32_t offset, void* buf, uint32_t len) {
+    UINT bytes_read;
+    if (f_lseek(&self->file->fp, offset) != FR_OK ||
+        f_read(&self->file->fp, buf, len, &bytes_read) != FR_OK) {
+        mp_raise_OSError(MP_EIO);
+    }
+    if (bytes_read != len) {
+        mp_raise_ValueError(translate("Invalid PCF file"));
+    }
+}
+
+STATIC uint32_t decode_u32(const uint8_t* b, uint32_t format) {
+    if ((format & PCF_BYTE_MASK) != 0) {
+        return b[0] << 24 | b[1] << 16 | b[2] << 8 | b[3];
+    }
+    return b[3] << 24 | b[2] << 16 | b[1] << 8 | b[0];
+}
+
+STATIC int16_t decode_i16(const uint8_t* b, uint32_t format) {
+    if ((format & PCF_BYTE_MASK) != 0) {
+        return b[0] << 8 | b[1];
+    }
+    return b[1] << 8 | b[0];
+}
+
+STATIC uint32_t read_u32(fontio_pcffont_t *self, uint32_t offset, uint32_t format) {
+    uint8_t b[4];
+    read_at(self, offset, b, sizeof(b));
+    return decode_u32(b, format);
+}
+
+STATIC void read_uncompressed_metrics(fontio_pcffont_t *self, uint32_t offset, uint32_t format, pcf_metrics_t* metrics) {
+    uint8_t b[10];
+    read_at(self, offset, b, sizeof(b));
+    metrics->left_side_bearing = decode_i16(b, format);
+    metrics->right_side_bearing = decode_i16(b + 2, format);
+    metrics->character_width = decode_i16(b + 4, format);
+    metrics->ascent = decode_i16(b + 6, format);
+    metrics->descent = decode_i16(b + 8, format);
+}
+
+STATIC void read_glyph_metrics(fontio_pcffont_t *self, uint16_t glyph_index, pcf_metrics_t* metrics) {
+    if ((self->metrics_format & PCF_COMPRESSED_METRICS) != 0) {
+        uint8_t b[5];
+        read_at(self, self->metrics_offset + 6 + glyph_index * 5, b, sizeof(b));
+        metrics->left_side_bearing = b[0] - 0x80;
+        metrics->right_side_bearing = b[1] - 0x80;
+        metrics->character_width = b[2] - 0x80;
+        metrics->ascent = b[3] - 0x80;
+        metrics->descent = b[4] - 0x80;
+    } else {
+        read_uncompressed_metrics(self, self->metrics_offset + 8 + glyph_index * 12, self->metrics_format, metrics);
+    }
+}
+
+void common_hal_fontio_pcffont_construct(fontio_pcffont_t *self, pyb_file_obj_t* file, uint16_t cache_size) {
+    self->file = file;
+
+    uint8_t header[8];
+    read_at(self, 0, header, sizeof(header));
+    if (memcmp(header, "\1fcp", 4) != 0) {
+        mp_raise_ValueError(translate("Invalid PCF file"));
+    }
+    // Only remember where the tables we need are. Glyphs are read from them as they are used.
+    uint32_t table_count = decode_u32(header + 4, 0);
+    uint32_t accelerators_offset = 0;
+    uint32_t bdf_accelerators_offset = 0;
+    self->metrics_offset = 0;
+    self->bitmaps_offset = 0;
+    self->encodings_offset = 0;
+    for (uint32_t i = 0; i < table_count; i++) {
+        uint8_t entry[16];
+        read_at(self, 8 + i * sizeof(entry), entry, sizeof(entry));
+        uint32_t type = decode_u32(entry, 0);
+        uint32_t offset = decode_u32(entry + 12, 0);
+        if (type == PCF_ACCELERATORS) {
+            accelerators_offset = offset;
+        } else if (type == PCF_BDF_ACCELERATORS) {
+            bdf_accelerators_offset = offset;
+        } else if (type == PCF_METRICS) {
+            self->metrics_offset = offset;
+        } else if (type == PCF_BITMAPS) {
+            self->bitmaps_offset = offset;
+        } else if (type == PCF_BDF_ENCODINGS) {
+            self->encodings_offset = offset;
+        }
+    }
+    if (bdf_accelerators_offset != 0) {
+        accelerators_offset = bdf_accelerators_offset;
+    }
+    if (accelerators_offset == 0 || self->metrics_offset == 0 || self->bitmaps_offset == 0 ||
+        self->encodings_offset == 0) {
+        mp_raise_ValueError(translate("Invalid PCF file"));
+    }
+
+    self->metrics_format = read_u32(self, self->metrics_offset, 0);
+    self->bitmaps_format = read_u32(self, self->bitmaps_offset, 0);
+    self->encodings_format = read_u32(self, self->encodings_offset, 0);
+    if ((self->bitmaps_format & PCF_SCAN_UNIT_MASK) == (3 << 4)) {
+        mp_raise_ValueError(translate("Invalid PCF file"));
+    }
+
+    self->glyph_count = read_u32(self, self->bitmaps_offset + 4, self->bitmaps_format);
+    // The bitmap data follows the glyph offsets and the four possible total sizes.
+    self->bitmap_data_offset = self->bitmaps_offset + 8 + self->glyph_count * 4 + 16;
+
+    uint8_t encoding[8];
+    read_at(self, self->encodings_offset + 4, encoding, sizeof(encoding));
+    self->min_byte2 = decode_i16(encoding, self->encodings_format);
+    self->max_byte2 = decode_i16(encoding + 2, self->encodings_format);
+    self->min_byte1 = decode_i16(encoding + 4, self->encodings_format);
+    self->max_byte1 = decode_i16(encoding + 6, self->encodings_format);
+
+    // The accelerators hold the minimum and maximum bounds of all glyphs after the format, eight
+    // flag bytes, and the font ascent, descent and max overlap.
+    uint32_t accelerators_format = read_u32(self, accelerators_offset, 0);
+    pcf_metrics_t min_bounds;
+    pcf_metrics_t max_bounds;
+    read_uncompressed_metrics(self, accelerators_offset + 24, accelerators_format, &min_bounds);
+    read_uncompressed_metrics(self, accelerators_offset + 36, accelerators_format, &max_bounds);
+    self->bounding_box_width = max_bounds.right_side_bearing - min_bounds.left_side_bearing;
+    self->bounding_box_height = max_bounds.ascent + max_bounds.descent;
+    self->bounding_box_x = min_bounds.left_side_bearing;
+    self->bounding_box_y = -max_bounds.descent;
+
+    self->cache = m_new0(fontio_pcffont_cache_entry_t, cache_size);
+    self->cache_size = cache_size;
+    self->cache_clock = 0;
+}
+
+mp_obj_t common_hal_fontio_pcffont_get_bounding_box(fontio_pcffont_t *self) {
+    mp_obj_t items[4] = {
+        MP_OBJ_NEW_SMALL_INT(self->bounding_box_width),
+        MP_OBJ_NEW_SMALL_INT(self->bounding_box_height),
+        MP_OBJ_NEW_SMALL_INT(self->bounding_box_x),
+        MP_OBJ_NEW_SMALL_INT(self->bounding_box_y)
+    };
+    return mp_obj_new_tuple(4, items);
+}
+
+STATIC uint16_t get_glyph_index(fontio_pcffont_t *self, mp_uint_t codepoint) {
+    uint16_t byte1 = codepoint >> 8;
+    uint16_t byte2 = codepoint & 0xff;
+    if (codepoint > 0xffff ||
+        byte1 < self->min_byte1 || byte1 > self->max_byte1 ||
+        byte2 < self->min_byte2 || byte2 > self->max_byte2) {
+        return PCF_NO_GLYPH;
+    }
+    uint32_t row_length = self->max_byte2 - self->min_byte2 + 1;
+    uint32_t i = (byte1 - self->min_byte1) * row_length + (byte2 - self->min_byte2);
+    uint8_t b[2];
+    read_at(self, self->encodings_offset + 14 + i * 2, b, sizeof(b));
+    uint16_t glyph_index = decode_i16(b, self->encodings_format);
+    if (glyph_index >= self->glyph_count) {
+        return PCF_NO_GLYPH;
+    }
+    return glyph_index;
+}
+
+STATIC mp_obj_t load_glyph(fontio_pcffont_t *self, mp_uint_t codepoint) {
+    uint16_t glyph_index = get_glyph_index(self, codepoint);
+    if (glyph_index == PCF_NO_GLYPH) {
+        return mp_const_none;
+    }
+    pcf_metrics_t metrics;
+    read_glyph_metrics(self, glyph_index, &metrics);
+    int16_t width = metrics.right_side_bearing - metrics.left_side_bearing;
+    int16_t height = metrics.ascent + metrics.descent;
+    if (width < 0 || height < 0) {
+        mp_raise_ValueError(translate("Invalid PCF file"));
+    }
+
+    // Each glyph gets its own bitmap so that evicting it from the cache never changes text that
+    // is already on screen. Blank glyphs like space still get a single pixel bitmap.
+    displayio_bitmap_t* bitmap = m_new_obj(displayio_bitmap_t);
+    bitmap->base.type = &displayio_bitmap_type;
+    common_hal_displayio_bitmap_construct(bitmap, width > 0 ? width : 1, height > 0 ? height : 1, 1);
+
+    uint32_t format = self->bitmaps_format;
+    uint8_t pad = 1 << (format & PCF_GLYPH_PAD_MASK);
+    uint8_t scan_unit = 1 << ((format & PCF_SCAN_UNIT_MASK) >> 4);
+    uint32_t stride = ((width + 7) / 8 + pad - 1) / pad * pad;
+    uint32_t size = stride * height;
+    if (size > 0) {
+        uint32_t offset = read_u32(self, self->bitmaps_offset + 8 + glyph_index * 4, format);
+        uint8_t* data = m_new(uint8_t, size);
+        read_at(self, self->bitmap_data_offset + offset, data, size);
+        for (int16_t y = 0; y < height; y++) {
+            for (int16_t x = 0; x < width; x++) {
+                uint32_t i = x / 8;
+                // Least significant byte first reverses the bytes within each scan unit.
+                if ((format & PCF_BYTE_MASK) == 0 && scan_unit > 1) {
+                    i = i / scan_unit * scan_unit + (scan_unit - 1 - i % scan_unit);
+                }
+                uint8_t bit = (format & PCF_BIT_MASK) != 0 ? 7 - x % 8 : x % 8;
+                if ((data[y * stride + i] >> bit) & 1) {
+                    common_hal_displayio_bitmap_set_pixel(bitmap, x, y, 1);
+                }
+            }
+        }
+        m_del(uint8_t, data, size);
+    }
+
+    mp_obj_t field_values[8] = {
+        MP_OBJ_FROM_PTR(bitmap),
+        MP_OBJ_NEW_SMALL_INT(0),
+        MP_OBJ_NEW_SMALL_INT(width),
+        MP_OBJ_NEW_SMALL_INT(height),
+        MP_OBJ_NEW_SMALL_INT(metrics.left_side_bearing),
+        MP_OBJ_NEW_SMALL_INT(-metrics.descent),
+        MP_OBJ_NEW_SMALL_INT(metrics.character_width),
+        MP_OBJ_NEW_SMALL_INT(0)
+    };
+    return namedtuple_make_new((const mp_obj_type_t*) &fontio_glyph_type, 8, field_values, NULL);
+}
+
+mp_obj_t common_hal_fontio_pcffont_get_glyph(fontio_pcffont_t *self, mp_uint_t codepoint) {
+    self->cache_clock++;
+    fontio_pcffont_cache_entry_t* oldest = &self->cache[0];
+    for (uint16_t i = 0; i < self->cache_size; i++) {
+        fontio_pcffont_cache_entry_t* entry = &self->cache[i];
+        if (entry->glyph != MP_OBJ_NULL && entry->codepoint == codepoint) {
+            entry->last_used = self->cache_clock;
+            return entry->glyph;
+        }
+        // Empty entries were never used so they are picked first.
+        if (entry->last_used < oldest->last_used) {
+            oldest = entry;
+        }
+    }
+    // Replace the least recently used glyph. Missing glyphs are cached too so that they don't hit
+    // the file every time.
+    mp_obj_t glyph = load_glyph(self, codepoint);
+    oldest->codepoint = codepoint;
+    oldest->glyph = glyph;
+    oldest->last_used = self->cache_clock;
+    return glyph;
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_FONTIO_PCFFONT_H
+#define MICROPY_INCLUDED_SHARED_MODULE_FONTIO_PCFFONT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+
+#include "extmod/vfs_fat.h"
+
+typedef struct {
+    mp_uint_t codepoint;
+    uint32_t last_used;
+    mp_obj_t glyph; // MP_OBJ_NULL when the entry is empty, None when the font has no such glyph.
+} fontio_pcffont_cache_entry_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    pyb_file_obj_t* file;
+    // File offsets of the tables we read glyphs from along with their format words.
+    uint32_t metrics_offset;
+    uint32_t metrics_format;
+    uint32_t bitmaps_offset;
+    uint32_t bitmaps_format;
+    uint32_t bitmap_data_offset;
+    uint32_t encodings_offset;
+    uint32_t encodings_format;
+    uint32_t glyph_count;
+    uint16_t min_byte1;
+    uint16_t max_byte1;
+    uint16_t min_byte2;
+    uint16_t max_byte2;
+    int16_t bounding_box_width;
+    int16_t bounding_box_height;
+    int16_t bounding_box_x;
+    int16_t bounding_box_y;
+    fontio_pcffont_cache_entry_t* cache;
+    uint16_t cache_size;
+    uint32_t cache_clock;
+} fontio_pcffont_t;
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_FONTIO_PCFFONT_H
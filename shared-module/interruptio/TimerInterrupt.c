@@ -0,0 +1,72 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/mpstate.h"
+#include "py/runtime.h"
+#include "shared-bindings/interruptio/TimerInterrupt.h"
+#include "supervisor/shared/translate.h"
+
+void common_hal_interruptio_timerinterrupt_construct(interruptio_timerinterrupt_obj_t* self,
+    uint32_t interval_ms, mp_obj_t handler) {
+    int8_t slot = -1;
+    for (uint8_t i = 0; i < CIRCUITPY_INTERRUPTIO_TIMERS; i++) {
+        if (MP_STATE_VM(timer_interrupts)[i] == NULL) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        mp_raise_RuntimeError(translate("All timers in use"));
+    }
+
+    self->handler = handler;
+    self->interval_ms = interval_ms;
+    self->remaining_ms = interval_ms;
+    self->missed = 0;
+    self->slot = slot;
+    // Publish last so the tick never sees a half set up timer.
+    MP_STATE_VM(timer_interrupts)[slot] = self;
+}
+
+bool common_hal_interruptio_timerinterrupt_deinited(interruptio_timerinterrupt_obj_t* self) {
+    return self->slot < 0;
+}
+
+void common_hal_interruptio_timerinterrupt_deinit(interruptio_timerinterrupt_obj_t* self) {
+    if (common_hal_interruptio_timerinterrupt_deinited(self)) {
+        return;
+    }
+    MP_STATE_VM(timer_interrupts)[self->slot] = NULL;
+    self->slot = -1;
+}
+
+uint32_t common_hal_interruptio_timerinterrupt_get_interval_ms(interruptio_timerinterrupt_obj_t* self) {
+    return self->interval_ms;
+}
+
+uint32_t common_hal_interruptio_timerinterrupt_get_missed(interruptio_timerinterrupt_obj_t* self) {
+    return self->missed;
+}
@@ -0,0 +1,51 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/mpstate.h"
+#include "py/runtime.h"
+#include "shared-bindings/interruptio/TimerInterrupt.h"
+#include "shared-module/interruptio/__init__.h"
+
+// Called from the millisecond tick interrupt.
+void interruptio_tick(void) {
+    for (uint8_t i = 0; i < CIRCUITPY_INTERRUPTIO_TIMERS; i++) {
+        interruptio_timerinterrupt_obj_t* self = MP_STATE_VM(timer_interrupts)[i];
+        if (self == NULL || --self->remaining_ms > 0) {
+            continue;
+        }
+        self->remaining_ms = self->interval_ms;
+        // The handler gets the already allocated TimerInterrupt so nothing is allocated here.
+        if (!mp_sched_schedule(self->handler, MP_OBJ_FROM_PTR(self))) {
+            self->missed += 1;
+        }
+    }
+}
+
+void interruptio_reset(void) {
+    for (uint8_t i = 0; i < CIRCUITPY_INTERRUPTIO_TIMERS; i++) {
+        MP_STATE_VM(timer_interrupts)[i] = NULL;
+    }
+}
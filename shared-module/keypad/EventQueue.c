@@ -0,0 +1,76 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/keypad/EventQueue.h"
+
+#include "py/runtime.h"
+#include "shared-bindings/keypad/Event.h"
+
+void common_hal_keypad_eventqueue_construct(keypad_eventqueue_obj_t* self, uint16_t max_events) {
+    self->entries = m_new(keypad_eventqueue_entry_t, max_events);
+    self->max_events = max_events;
+    self->start = 0;
+    self->length = 0;
+    self->overflowed = false;
+}
+
+bool common_hal_keypad_eventqueue_get_into(keypad_eventqueue_obj_t* self, keypad_event_obj_t* event) {
+    if (self->length == 0) {
+        return false;
+    }
+    keypad_eventqueue_entry_t* entry = &self->entries[self->start];
+    common_hal_keypad_event_construct(event, entry->key_number, entry->pressed, entry->timestamp);
+    self->start = (self->start + 1) % self->max_events;
+    self->length--;
+    return true;
+}
+
+void common_hal_keypad_eventqueue_clear(keypad_eventqueue_obj_t* self) {
+    self->start = 0;
+    self->length = 0;
+    self->overflowed = false;
+}
+
+uint16_t common_hal_keypad_eventqueue_get_length(keypad_eventqueue_obj_t* self) {
+    return self->length;
+}
+
+bool common_hal_keypad_eventqueue_get_overflowed(keypad_eventqueue_obj_t* self) {
+    return self->overflowed;
+}
+
+void keypad_eventqueue_record(keypad_eventqueue_obj_t* self, uint16_t key_number, bool pressed,
+    uint32_t timestamp) {
+    if (self->length == self->max_events) {
+        self->overflowed = true;
+        return;
+    }
+    keypad_eventqueue_entry_t* entry = &self->entries[(self->start + self->length) % self->max_events];
+    entry->key_number = key_number;
+    entry->pressed = pressed;
+    entry->timestamp = timestamp;
+    self->length++;
+}
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_KEYPAD_EVENTQUEUE_H
+#define MICROPY_INCLUDED_SHARED_MODULE_KEYPAD_EVENTQUEUE_H
+
+#include <stdint.h>
+
+#include "py/obj.h"
+
+typedef struct {
+    uint32_t timestamp;
+    uint16_t key_number;
+    bool pressed;
+} keypad_eventqueue_entry_t;
+
+// A ring of events written by the background scan and read from Python. Both run in the VM's
+// thread so no locking is needed.
+typedef struct {
+    mp_obj_base_t base;
+    keypad_eventqueue_entry_t* entries;
+    uint16_t max_events;
+    uint16_t start;
+    uint16_t length;
+    bool overflowed;
+} keypad_eventqueue_obj_t;
+
+// Drops the event and sets overflowed when the queue is full.
+void keypad_eventqueue_record(keypad_eventqueue_obj_t* self, uint16_t key_number, bool pressed,
+    uint32_t timestamp);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_KEYPAD_EVENTQUEUE_H
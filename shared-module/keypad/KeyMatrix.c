@@ -0,0 +1,103 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/keypad/KeyMatrix.h"
+
+#include "py/runtime.h"
+
+// With the columns on the diode anodes, the selected row is driven low and a pressed key pulls
+// its pulled up column low. The other way around everything is inverted.
+static digitalio_pull_t idle_pull(keypad_keymatrix_obj_t* self) {
+    return self->columns_to_anodes ? PULL_UP : PULL_DOWN;
+}
+
+void common_hal_keypad_keymatrix_construct(keypad_keymatrix_obj_t* self,
+    const mcu_pin_obj_t** row_pins, uint8_t row_count,
+    const mcu_pin_obj_t** column_pins, uint8_t column_count, bool columns_to_anodes,
+    uint32_t interval_ms, uint8_t debounce_scans, uint16_t max_events) {
+    keypad_scanner_construct(&self->scanner, row_count * column_count, interval_ms,
+                             debounce_scans, max_events);
+    self->row_count = row_count;
+    self->column_count = column_count;
+    self->columns_to_anodes = columns_to_anodes;
+
+    self->row_pins = m_new(digitalio_digitalinout_obj_t, row_count);
+    for (uint8_t row = 0; row < row_count; row++) {
+        digitalio_digitalinout_obj_t* pin = &self->row_pins[row];
+        pin->base.type = &digitalio_digitalinout_type;
+        common_hal_digitalio_digitalinout_construct(pin, row_pins[row]);
+        common_hal_digitalio_digitalinout_switch_to_input(pin, idle_pull(self));
+    }
+    self->column_pins = m_new(digitalio_digitalinout_obj_t, column_count);
+    for (uint8_t column = 0; column < column_count; column++) {
+        digitalio_digitalinout_obj_t* pin = &self->column_pins[column];
+        pin->base.type = &digitalio_digitalinout_type;
+        common_hal_digitalio_digitalinout_construct(pin, column_pins[column]);
+        common_hal_digitalio_digitalinout_switch_to_input(pin, idle_pull(self));
+    }
+    keypad_scanner_start(&self->scanner);
+}
+
+bool common_hal_keypad_keymatrix_deinited(keypad_keymatrix_obj_t* self) {
+    return keypad_scanner_deinited(&self->scanner);
+}
+
+void common_hal_keypad_keymatrix_deinit(keypad_keymatrix_obj_t* self) {
+    if (common_hal_keypad_keymatrix_deinited(self)) {
+        return;
+    }
+    keypad_scanner_deinit(&self->scanner);
+    for (uint8_t row = 0; row < self->row_count; row++) {
+        common_hal_digitalio_digitalinout_deinit(&self->row_pins[row]);
+    }
+    for (uint8_t column = 0; column < self->column_count; column++) {
+        common_hal_digitalio_digitalinout_deinit(&self->column_pins[column]);
+    }
+}
+
+keypad_eventqueue_obj_t* common_hal_keypad_keymatrix_get_events(keypad_keymatrix_obj_t* self) {
+    return self->scanner.events;
+}
+
+uint16_t common_hal_keypad_keymatrix_get_key_count(keypad_keymatrix_obj_t* self) {
+    return self->scanner.key_count;
+}
+
+void keypad_keymatrix_scan(keypad_keymatrix_obj_t* self, uint32_t now) {
+    bool active = !self->columns_to_anodes;
+    for (uint8_t row = 0; row < self->row_count; row++) {
+        digitalio_digitalinout_obj_t* row_pin = &self->row_pins[row];
+        // Only the selected row is driven so that keys held down in other rows can't short two
+        // driven rows together.
+        common_hal_digitalio_digitalinout_switch_to_output(row_pin, active, DRIVE_MODE_PUSH_PULL);
+        for (uint8_t column = 0; column < self->column_count; column++) {
+            bool pressed =
+                common_hal_digitalio_digitalinout_get_value(&self->column_pins[column]) == active;
+            keypad_scanner_update_key(&self->scanner, row * self->column_count + column, pressed, now);
+        }
+        common_hal_digitalio_digitalinout_switch_to_input(row_pin, idle_pull(self));
+    }
+}
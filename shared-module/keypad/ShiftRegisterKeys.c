@@ -0,0 +1,115 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/keypad/ShiftRegisterKeys.h"
+
+#include "py/runtime.h"
+
+void common_hal_keypad_shiftregisterkeys_construct(keypad_shiftregisterkeys_obj_t* self,
+    const mcu_pin_obj_t* latch, const mcu_pin_obj_t* clock, const mcu_pin_obj_t* data,
+    busio_spi_obj_t* spi, uint16_t key_count, bool value_when_pressed,
+    uint32_t interval_ms, uint8_t debounce_scans, uint16_t max_events) {
+    keypad_scanner_construct(&self->scanner, key_count, interval_ms, debounce_scans, max_events);
+    self->value_when_pressed = value_when_pressed;
+
+    // Parallel loads happen while the latch is low. It idles high, ready to shift.
+    self->latch.base.type = &digitalio_digitalinout_type;
+    common_hal_digitalio_digitalinout_construct(&self->latch, latch);
+    common_hal_digitalio_digitalinout_switch_to_output(&self->latch, true, DRIVE_MODE_PUSH_PULL);
+
+    self->spi = spi;
+    if (spi != NULL) {
+        self->buffer = m_new(uint8_t, (key_count + 7) / 8);
+    } else {
+        self->clock.base.type = &digitalio_digitalinout_type;
+        common_hal_digitalio_digitalinout_construct(&self->clock, clock);
+        common_hal_digitalio_digitalinout_switch_to_output(&self->clock, false, DRIVE_MODE_PUSH_PULL);
+        self->data.base.type = &digitalio_digitalinout_type;
+        common_hal_digitalio_digitalinout_construct(&self->data, data);
+        common_hal_digitalio_digitalinout_switch_to_input(&self->data, PULL_NONE);
+    }
+    keypad_scanner_start(&self->scanner);
+}
+
+bool common_hal_keypad_shiftregisterkeys_deinited(keypad_shiftregisterkeys_obj_t* self) {
+    return keypad_scanner_deinited(&self->scanner);
+}
+
+void common_hal_keypad_shiftregisterkeys_deinit(keypad_shiftregisterkeys_obj_t* self) {
+    if (common_hal_keypad_shiftregisterkeys_deinited(self)) {
+        return;
+    }
+    keypad_scanner_deinit(&self->scanner);
+    common_hal_digitalio_digitalinout_deinit(&self->latch);
+    if (self->spi == NULL) {
+        common_hal_digitalio_digitalinout_deinit(&self->clock);
+        common_hal_digitalio_digitalinout_deinit(&self->data);
+    }
+    self->spi = NULL;
+}
+
+keypad_eventqueue_obj_t* common_hal_keypad_shiftregisterkeys_get_events(keypad_shiftregisterkeys_obj_t* self) {
+    return self->scanner.events;
+}
+
+uint16_t common_hal_keypad_shiftregisterkeys_get_key_count(keypad_shiftregisterkeys_obj_t* self) {
+    return self->scanner.key_count;
+}
+
+void keypad_shiftregisterkeys_scan(keypad_shiftregisterkeys_obj_t* self, uint32_t now) {
+    uint16_t key_count = self->scanner.key_count;
+    // The bus is shared with Python code. Skip this scan rather than wait if it's in use.
+    if (self->spi != NULL &&
+        (common_hal_busio_spi_deinited(self->spi) || !common_hal_busio_spi_try_lock(self->spi))) {
+        return;
+    }
+
+    common_hal_digitalio_digitalinout_set_value(&self->latch, false);
+    common_hal_digitalio_digitalinout_set_value(&self->latch, true);
+
+    if (self->spi != NULL) {
+        // The first key is the first bit out, which is the most significant bit of each byte.
+        bool ok = common_hal_busio_spi_read(self->spi, self->buffer, (key_count + 7) / 8, 0);
+        common_hal_busio_spi_unlock(self->spi);
+        if (!ok) {
+            return;
+        }
+        for (uint16_t key = 0; key < key_count; key++) {
+            bool value = (self->buffer[key / 8] & (0x80 >> (key % 8))) != 0;
+            keypad_scanner_update_key(&self->scanner, key, value == self->value_when_pressed, now);
+        }
+        return;
+    }
+
+    // The first key's value is on data as soon as the registers are loaded. Each rising clock
+    // edge shifts the next one out.
+    for (uint16_t key = 0; key < key_count; key++) {
+        bool value = common_hal_digitalio_digitalinout_get_value(&self->data);
+        keypad_scanner_update_key(&self->scanner, key, value == self->value_when_pressed, now);
+        common_hal_digitalio_digitalinout_set_value(&self->clock, true);
+        common_hal_digitalio_digitalinout_set_value(&self->clock, false);
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-module/keypad/__init__.h"
+
+#include <string.h>
+
+#include "py/mphal.h"
+#include "py/mpstate.h"
+#include "py/runtime.h"
+#include "shared-bindings/keypad/EventQueue.h"
+#include "shared-bindings/keypad/KeyMatrix.h"
+#include "shared-bindings/keypad/ShiftRegisterKeys.h"
+#include "supervisor/shared/translate.h"
+
+void keypad_scanner_construct(keypad_scanner_obj_t* self, uint16_t key_count,
+    uint32_t interval_ms, uint8_t debounce_scans, uint16_t max_events) {
+    int8_t slot = -1;
+    for (uint8_t i = 0; i < CIRCUITPY_KEYPAD_SCANNERS; i++) {
+        if (MP_STATE_VM(keypad_scanners)[i] == NULL) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        mp_raise_RuntimeError(translate("Too many key scanners"));
+    }
+
+    keypad_eventqueue_obj_t* events = m_new_obj(keypad_eventqueue_obj_t);
+    events->base.type = &keypad_eventqueue_type;
+    common_hal_keypad_eventqueue_construct(events, max_events);
+    self->events = events;
+    self->key_states = m_new(uint8_t, key_count);
+    memset(self->key_states, 0, key_count);
+    self->key_count = key_count;
+    self->interval_ms = interval_ms;
+    self->debounce_scans = debounce_scans;
+    self->last_scan_ms = mp_hal_ticks_ms() - interval_ms;
+    self->slot = slot;
+}
+
+void keypad_scanner_start(keypad_scanner_obj_t* self) {
+    MP_STATE_VM(keypad_scanners)[self->slot] = self;
+}
+
+bool keypad_scanner_deinited(keypad_scanner_obj_t* self) {
+    return self->slot < 0;
+}
+
+void keypad_scanner_deinit(keypad_scanner_obj_t* self) {
+    if (keypad_scanner_deinited(self)) {
+        return;
+    }
+    MP_STATE_VM(keypad_scanners)[self->slot] = NULL;
+    self->slot = -1;
+}
+
+void keypad_scanner_update_key(keypad_scanner_obj_t* self, uint16_t key_number, bool pressed,
+    uint32_t now) {
+    uint8_t state = self->key_states[key_number];
+    bool was_pressed = (state & KEYPAD_KEY_PRESSED) != 0;
+    if (pressed == was_pressed) {
+        // A bounce, or nothing happening. Start counting again.
+        self->key_states[key_number] = state & KEYPAD_KEY_PRESSED;
+        return;
+    }
+    uint8_t count = (state & KEYPAD_KEY_COUNT_MASK) + 1;
+    if (count < self->debounce_scans) {
+        self->key_states[key_number] = (state & KEYPAD_KEY_PRESSED) | count;
+        return;
+    }
+    self->key_states[key_number] = pressed ? KEYPAD_KEY_PRESSED : 0;
+    keypad_eventqueue_record(self->events, key_number, pressed, now);
+}
+
+void keypad_background(void) {
+    uint32_t now = mp_hal_ticks_ms();
+    for (uint8_t i = 0; i < CIRCUITPY_KEYPAD_SCANNERS; i++) {
+        keypad_scanner_obj_t* self = MP_STATE_VM(keypad_scanners)[i];
+        if (self == NULL || now - self->last_scan_ms < self->interval_ms) {
+            continue;
+        }
+        // Keep to the interval's cadence unless we've fallen a whole interval behind.
+        self->last_scan_ms += self->interval_ms;
+        if (now - self->last_scan_ms >= self->interval_ms) {
+            self->last_scan_ms = now;
+        }
+        if (MP_OBJ_IS_TYPE(MP_OBJ_FROM_PTR(self), &keypad_keymatrix_type)) {
+            keypad_keymatrix_scan((keypad_keymatrix_obj_t*) self, now);
+        } else if (MP_OBJ_IS_TYPE(MP_OBJ_FROM_PTR(self), &keypad_shiftregisterkeys_type)) {
+            keypad_shiftregisterkeys_scan((keypad_shiftregisterkeys_obj_t*) self, now);
+        }
+    }
+}
+
+void keypad_reset(void) {
+    for (uint8_t i = 0; i < CIRCUITPY_KEYPAD_SCANNERS; i++) {
+        MP_STATE_VM(keypad_scanners)[i] = NULL;
+    }
+}
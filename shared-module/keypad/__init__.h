@@ -0,0 +1,68 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SHARED_MODULE_KEYPAD___INIT___H
+#define MICROPY_INCLUDED_SHARED_MODULE_KEYPAD___INIT___H
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "shared-module/keypad/EventQueue.h"
+
+// Each key's state is the debounced pressed flag in the top bit and, below it, the number of
+// scans in a row that have read the opposite.
+#define KEYPAD_KEY_PRESSED (0x80)
+#define KEYPAD_KEY_COUNT_MASK (0x7f)
+
+// The start of every scanner object. The background task scans each registered scanner once
+// its interval has passed.
+typedef struct {
+    mp_obj_base_t base;
+    keypad_eventqueue_obj_t* events;
+    uint8_t* key_states;
+    uint32_t interval_ms;
+    uint32_t last_scan_ms;
+    uint16_t key_count;
+    uint8_t debounce_scans;
+    int8_t slot; // Index into MP_STATE_VM(keypad_scanners) or -1 when deinited.
+} keypad_scanner_obj_t;
+
+// Reserves a slot and allocates the scanner's state. Call keypad_scanner_start() once the pins
+// are set up to begin scanning.
+void keypad_scanner_construct(keypad_scanner_obj_t* self, uint16_t key_count,
+    uint32_t interval_ms, uint8_t debounce_scans, uint16_t max_events);
+void keypad_scanner_start(keypad_scanner_obj_t* self);
+// Stops scanning. The scanner's own pins are released by its deinit.
+void keypad_scanner_deinit(keypad_scanner_obj_t* self);
+bool keypad_scanner_deinited(keypad_scanner_obj_t* self);
+// Called by scans with every key's current reading.
+void keypad_scanner_update_key(keypad_scanner_obj_t* self, uint16_t key_number, bool pressed,
+    uint32_t now);
+
+void keypad_background(void);
+void keypad_reset(void);
+
+#endif // MICROPY_INCLUDED_SHARED_MODULE_KEYPAD___INIT___H
@@ -105,24 +105,28 @@ mp_obj_t common_hal_os_getcwd(void) {
     return mp_vfs_getcwd();
 }
 
-mp_obj_t common_hal_os_listdir(const char* path) {
+mp_obj_t common_hal_os_ilistdir(const char* path) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_dir_path(path, &path_out);
 
-    mp_vfs_ilistdir_it_t iter;
-    mp_obj_t iter_obj = MP_OBJ_FROM_PTR(&iter);
-
     if (vfs == MP_VFS_ROOT) {
         // list the root directory
-        iter.base.type = &mp_type_polymorph_iter;
-        iter.iternext = mp_vfs_ilistdir_it_iternext;
-        iter.cur.vfs = MP_STATE_VM(vfs_mount_table);
-        iter.is_str = true;
-        iter.is_iter = false;
-    } else {
-        iter_obj = mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 1, &path_out);
+        mp_vfs_ilistdir_it_t *iter = m_new_obj(mp_vfs_ilistdir_it_t);
+        iter->base.type = &mp_type_polymorph_iter;
+        iter->iternext = mp_vfs_ilistdir_it_iternext;
+        iter->cur.vfs = MP_STATE_VM(vfs_mount_table);
+        iter->is_str = true;
+        iter->is_iter = false;
+        return MP_OBJ_FROM_PTR(iter);
     }
 
+    // The filesystem's own iterator reads one entry at a time.
+    return mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 1, &path_out);
+}
+
+mp_obj_t common_hal_os_listdir(const char* path) {
+    mp_obj_t iter_obj = common_hal_os_ilistdir(path);
+
     mp_obj_t dir_list = mp_obj_new_list(0, NULL);
     mp_obj_t next;
     while ((next = mp_iternext(iter_obj)) != MP_OBJ_STOP_ITERATION) {
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "py/bc.h"
+#include "py/mpstate.h"
+#include "shared-bindings/profiler/__init__.h"
+#include "shared-module/profiler/__init__.h"
+
+static profiler_line_t lines[CIRCUITPY_PROFILER_LINES];
+// Zero when stopped.
+static volatile uint32_t interval_ms = 0;
+static uint32_t remaining_ms;
+// The slot found for the last opcode sampled.
+static const byte* last_ip;
+static size_t last_slot;
+
+// Finds the slot for the line being run, the same way the allocation profiler does.
+static size_t line_slot(const mp_code_state_t* code_state) {
+    const byte* ip = code_state->ip;
+    if (ip == last_ip) {
+        return last_slot;
+    }
+    qstr block_name, source_file;
+    size_t line = mp_bytecode_get_source_line(code_state->fun_bc->bytecode, ip, &block_name, &source_file);
+    size_t start = 1 + (source_file * 31 + line) % (CIRCUITPY_PROFILER_LINES - 1);
+    size_t slot = 0;
+    for (size_t i = start;;) {
+        if (lines[i].count == 0) {
+            lines[i].source_file = source_file;
+            lines[i].block_name = block_name;
+            lines[i].line = line;
+            slot = i;
+            break;
+        }
+        if (lines[i].source_file == source_file && lines[i].line == line) {
+            slot = i;
+            break;
+        }
+        if (++i == CIRCUITPY_PROFILER_LINES) {
+            i = 1;
+        }
+        if (i == start) {
+            // The table is full.
+            break;
+        }
+    }
+    last_ip = ip;
+    last_slot = slot;
+    return slot;
+}
+
+// Called from the millisecond tick interrupt. The code state it samples is always live
+// because the VM points current_code_state back at the caller before freeing a frame.
+void profiler_tick(void) {
+    if (interval_ms == 0 || --remaining_ms > 0) {
+        return;
+    }
+    remaining_ms = interval_ms;
+    const mp_code_state_t* code_state = MP_STATE_THREAD(current_code_state);
+    size_t slot = code_state == NULL ? 0 : line_slot(code_state);
+    lines[slot].count += 1;
+}
+
+void shared_module_profiler_start(uint32_t new_interval_ms) {
+    interval_ms = 0;
+    memset(lines, 0, sizeof(lines));
+    last_ip = NULL;
+    remaining_ms = new_interval_ms;
+    interval_ms = new_interval_ms;
+}
+
+void shared_module_profiler_stop(void) {
+    interval_ms = 0;
+}
+
+const profiler_line_t* profiler_lines(size_t* count) {
+    *count = CIRCUITPY_PROFILER_LINES;
+    return lines;
+}
+
+void profiler_reset(void) {
+    // The qstrs in the table belong to the VM that is going away.
+    shared_module_profiler_start(0);
+}
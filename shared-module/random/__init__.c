@@ -121,6 +121,28 @@ STATIC mp_float_t yasmarang_float(void) {
     return u.f - 1;
 }
 
+void shared_modules_random_fill_bytes(uint8_t* buffer, size_t len) {
+    while (len > 0) {
+        uint32_t r = yasmarang();
+        size_t count = MIN(len, sizeof(r));
+        memcpy(buffer, &r, count);
+        buffer += count;
+        len -= count;
+    }
+}
+
+void shared_modules_random_fill_floats(float* buffer, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        buffer[i] = yasmarang_float();
+    }
+}
+
+void shared_modules_random_fill_doubles(double* buffer, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        buffer[i] = yasmarang_float();
+    }
+}
+
 mp_float_t shared_modules_random_random(void) {
     return yasmarang_float();
 }
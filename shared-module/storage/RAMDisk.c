@@ -0,0 +1,59 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "shared-bindings/storage/RAMDisk.h"
+
+#include <string.h>
+
+#include "py/misc.h"
+
+void common_hal_storage_ramdisk_construct(storage_ramdisk_obj_t* self, uint32_t block_count) {
+    self->block_count = block_count;
+    // The disk usually lives as long as its mount so keep it out of the way of short lived
+    // allocations.
+    self->data = m_malloc(block_count * STORAGE_RAMDISK_BLOCK_SIZE, true);
+    memset(self->data, 0, block_count * STORAGE_RAMDISK_BLOCK_SIZE);
+}
+
+uint32_t common_hal_storage_ramdisk_get_block_count(storage_ramdisk_obj_t* self) {
+    return self->block_count;
+}
+
+mp_uint_t common_hal_storage_ramdisk_readblocks(storage_ramdisk_obj_t* self, uint8_t* dest, uint32_t block_num, uint32_t num_blocks) {
+    if (block_num >= self->block_count || num_blocks > self->block_count - block_num) {
+        return 1;
+    }
+    memcpy(dest, self->data + block_num * STORAGE_RAMDISK_BLOCK_SIZE, num_blocks * STORAGE_RAMDISK_BLOCK_SIZE);
+    return 0;
+}
+
+mp_uint_t common_hal_storage_ramdisk_writeblocks(storage_ramdisk_obj_t* self, const uint8_t* src, uint32_t block_num, uint32_t num_blocks) {
+    if (block_num >= self->block_count || num_blocks > self->block_count - block_num) {
+        return 1;
+    }
+    memcpy(self->data + block_num * STORAGE_RAMDISK_BLOCK_SIZE, src, num_blocks * STORAGE_RAMDISK_BLOCK_SIZE);
+    return 0;
+}
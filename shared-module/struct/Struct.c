@@ -0,0 +1,173 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "py/binary.h"
+#include "py/objlist.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+#include "shared-bindings/struct/__init__.h"
+#include "shared-bindings/struct/Struct.h"
+#include "shared-module/struct/__init__.h"
+#include "supervisor/shared/translate.h"
+
+size_t shared_modules_struct_struct_max_ops(mp_obj_t fmt_in) {
+    const char *fmt = mp_obj_str_get_str(fmt_in);
+    get_fmt_type(&fmt);
+    size_t max_ops = 0;
+    for (; *fmt; fmt++) {
+        if (!unichar_isdigit(*fmt)) {
+            max_ops++;
+        }
+    }
+    return max_ops;
+}
+
+void shared_modules_struct_struct_construct(struct_struct_obj_t *self, mp_obj_t fmt_in) {
+    // calcsize validates every format character, so the loop below doesn't have to.
+    self->format = fmt_in;
+    self->size = shared_modules_struct_calcsize(fmt_in);
+
+    const char *fmt = mp_obj_str_get_str(fmt_in);
+    self->fmt_type = get_fmt_type(&fmt);
+    self->num_items = calcsize_items(fmt);
+
+    size_t num_ops = 0;
+    while (*fmt) {
+        mp_uint_t count = 1;
+        if (unichar_isdigit(*fmt)) {
+            count = get_fmt_num(&fmt);
+        }
+        if (*fmt != 's' && num_ops > 0 && self->ops[num_ops - 1].type == *fmt) {
+            self->ops[num_ops - 1].count += count;
+        } else {
+            self->ops[num_ops].count = count;
+            self->ops[num_ops].type = *fmt;
+            num_ops++;
+        }
+        fmt++;
+    }
+    self->num_ops = num_ops;
+}
+
+void shared_modules_struct_struct_pack_into(struct_struct_obj_t *self, byte *p, byte *end_p, size_t n_args, const mp_obj_t *args) {
+    if (p + self->size > end_p) {
+        mp_raise_RuntimeError(translate("buffer too small"));
+    }
+    if (n_args > self->num_items) {
+        // CPython raises struct.error here
+        mp_raise_RuntimeError(translate("too many arguments provided with the given format"));
+    }
+
+    size_t i = 0;
+    for (const struct_struct_op_t *op = self->ops; op < self->ops + self->num_ops && i < n_args; op++) {
+        mp_uint_t count = op->count;
+        if (op->type == 's') {
+            mp_buffer_info_t bufinfo;
+            mp_get_buffer_raise(args[i++], &bufinfo, MP_BUFFER_READ);
+            mp_uint_t to_copy = MIN(count, bufinfo.len);
+            memcpy(p, bufinfo.buf, to_copy);
+            memset(p + to_copy, 0, count - to_copy);
+            p += count;
+        } else if (op->type == 'x') {
+            memset(p, 0, count);
+            p += count;
+        } else {
+            while (count-- && i < n_args) {
+                mp_binary_set_val(self->fmt_type, op->type, args[i++], &p);
+            }
+        }
+    }
+}
+
+// Unpacks into items when it is given, otherwise stores into out by subscript.
+STATIC void struct_struct_unpack_items(struct_struct_obj_t *self, byte *p, mp_obj_t *items, mp_obj_t out) {
+    size_t i = 0;
+    for (const struct_struct_op_t *op = self->ops; op < self->ops + self->num_ops; op++) {
+        mp_uint_t count = op->count;
+        if (op->type == 'x') {
+            p += count;
+            continue;
+        }
+        if (op->type == 's') {
+            // Bytes values are always new objects.
+            mp_obj_t item = mp_obj_new_bytes(p, count);
+            p += count;
+            if (items != NULL) {
+                items[i++] = item;
+            } else {
+                mp_obj_subscr(out, MP_OBJ_NEW_SMALL_INT(i++), item);
+            }
+            continue;
+        }
+        while (count--) {
+            mp_obj_t item = mp_binary_get_val(self->fmt_type, op->type, &p);
+            if (items != NULL) {
+                items[i++] = item;
+            } else {
+                mp_obj_subscr(out, MP_OBJ_NEW_SMALL_INT(i++), item);
+            }
+        }
+    }
+}
+
+STATIC void struct_struct_check_size(struct_struct_obj_t *self, byte *p, byte *end_p, bool exact_size) {
+    // If exact_size, make sure the buffer is exactly the right size.
+    // Otherwise just make sure it's big enough.
+    if (exact_size) {
+        if (p + self->size != end_p) {
+            mp_raise_RuntimeError(translate("buffer size must match format"));
+        }
+    } else {
+        if (p + self->size > end_p) {
+            mp_raise_RuntimeError(translate("buffer too small"));
+        }
+    }
+}
+
+mp_obj_tuple_t *shared_modules_struct_struct_unpack_from(struct_struct_obj_t *self, byte *p, byte *end_p, bool exact_size) {
+    struct_struct_check_size(self, p, end_p, exact_size);
+    mp_obj_tuple_t *res = MP_OBJ_TO_PTR(mp_obj_new_tuple(self->num_items, NULL));
+    struct_struct_unpack_items(self, p, res->items, MP_OBJ_NULL);
+    return res;
+}
+
+void shared_modules_struct_struct_unpack_into(struct_struct_obj_t *self, mp_obj_t out, byte *p, byte *end_p) {
+    struct_struct_check_size(self, p, end_p, false);
+    if (MP_OBJ_IS_TYPE(out, &mp_type_list)) {
+        mp_obj_list_t *list = MP_OBJ_TO_PTR(out);
+        if (list->len < self->num_items) {
+            mp_raise_ValueError(translate("container too small"));
+        }
+        struct_struct_unpack_items(self, p, list->items, MP_OBJ_NULL);
+    } else {
+        if ((mp_uint_t)mp_obj_get_int(mp_obj_len(out)) < self->num_items) {
+            mp_raise_ValueError(translate("container too small"));
+        }
+        struct_struct_unpack_items(self, p, NULL, out);
+    }
+}
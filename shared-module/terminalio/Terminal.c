@@ -46,9 +46,18 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
         // Always handle ASCII.
         if (c < 128) {
             if (c >= 0x20 && c <= 0x7e) {
-                uint8_t tile_index = fontio_builtinfont_get_glyph_index(self->font, c);
-                common_hal_displayio_tilegrid_set_tile(self->tilegrid, self->cursor_x, self->cursor_y, tile_index);
-                self->cursor_x++;
+                // Set the whole run of printable characters on this row at once so the TileGrid's
+                // dirty area is only updated once.
+                uint8_t tiles[32];
+                uint16_t room = MIN(self->tilegrid->width_in_tiles - self->cursor_x, MP_ARRAY_SIZE(tiles));
+                uint16_t count = 0;
+                tiles[count++] = fontio_builtinfont_get_glyph_index(self->font, c);
+                while (count < room && i < data + len && *i >= 0x20 && *i <= 0x7e) {
+                    tiles[count++] = fontio_builtinfont_get_glyph_index(self->font, *i);
+                    i++;
+                }
+                displayio_tilegrid_set_tiles(self->tilegrid, self->cursor_x, self->cursor_y, tiles, count);
+                self->cursor_x += count;
             } else if (c == '\r') {
                 self->cursor_x = 0;
             } else if (c == '\n') {
@@ -62,9 +71,8 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
                 if (i[0] == '[') {
                     if (i[1] == 'K') {
                         // Clear the rest of the line.
-                        for (uint16_t j = self->cursor_x; j < self->tilegrid->width_in_tiles; j++) {
-                            common_hal_displayio_tilegrid_set_tile(self->tilegrid, j, self->cursor_y, 0);
-                        }
+                        displayio_tilegrid_fill_tiles(self->tilegrid, self->cursor_x, self->cursor_y, 0,
+                            self->tilegrid->width_in_tiles - self->cursor_x);
                         i += 2;
                     } else {
                         // Handle commands of the form \x1b[####D
@@ -107,10 +115,8 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
         }
         if (self->cursor_y != start_y) {
             // clear the new row
-            for (uint16_t j = 0; j < self->tilegrid->width_in_tiles; j++) {
-                common_hal_displayio_tilegrid_set_tile(self->tilegrid, j, self->cursor_y, 0);
-                start_y = self->cursor_y;
-            }
+            displayio_tilegrid_fill_tiles(self->tilegrid, 0, self->cursor_y, 0, self->tilegrid->width_in_tiles);
+            start_y = self->cursor_y;
             common_hal_displayio_tilegrid_set_top_left(self->tilegrid, 0, (start_y + self->tilegrid->height_in_tiles + 1) % self->tilegrid->height_in_tiles);
         }
     }
@@ -26,9 +26,11 @@
 
 #include <string.h>
 #include "tick.h"
+#include "genhdr/autogen_usb_descriptor.h"
 #include "py/runtime.h"
 #include "shared-bindings/usb_hid/Device.h"
 #include "shared-module/usb_hid/Device.h"
+#include "supervisor/port.h"
 #include "supervisor/shared/translate.h"
 #include "tusb.h"
 
@@ -40,23 +42,113 @@ uint8_t common_hal_usb_hid_device_get_usage(usb_hid_device_obj_t *self) {
     return self->usage;
 }
 
+STATIC uint8_t *queued_report(usb_hid_device_obj_t *self, size_t i) {
+    return self->report_queue + ((self->queue_start + i) % USB_HID_REPORT_QUEUE_MAX) * self->report_length;
+}
+
+// Mouse reports are buttons, x, y and wheel. When a report is still waiting for the host, the
+// movement in a new one with the same buttons is added to it instead of queueing another.
+STATIC bool coalesce_mouse_report(usb_hid_device_obj_t *self, uint8_t* report) {
+    if (self->usage_page != HID_USAGE_PAGE_DESKTOP || self->usage != HID_USAGE_DESKTOP_MOUSE ||
+        self->report_length != 4 || self->queue_count == 0) {
+        return false;
+    }
+
+    uint8_t *newest = queued_report(self, self->queue_count - 1);
+    if (newest[0] != report[0]) {
+        return false;
+    }
+    int16_t sums[3];
+    for (size_t i = 0; i < 3; i++) {
+        sums[i] = (int8_t) newest[i + 1] + (int8_t) report[i + 1];
+        if (sums[i] < -127 || sums[i] > 127) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < 3; i++) {
+        newest[i + 1] = (int8_t) sums[i];
+    }
+    return true;
+}
+
 void common_hal_usb_hid_device_send_report(usb_hid_device_obj_t *self, uint8_t* report, uint8_t len) {
     if (len != self->report_length) {
         mp_raise_ValueError_varg(translate("Buffer incorrect size. Should be %d bytes."), self->report_length);
     }
 
-    // Wait until interface is ready, timeout = 2 seconds
-    uint64_t end_ticks = ticks_ms + 2000;
-    while ( (ticks_ms < end_ticks) && !tud_hid_generic_ready() ) { }
+    // Send straight away if nothing is waiting.
+    if (self->queue_count == 0 && tud_hid_generic_ready()) {
+        memcpy(self->report_buffer, report, len);
+        if ( !tud_hid_generic_report(self->report_id, self->report_buffer, len) ) {
+            mp_raise_msg(&mp_type_OSError, translate("USB Error"));
+        }
+        return;
+    }
+
+    if (coalesce_mouse_report(self, report)) {
+        return;
+    }
 
-    if ( !tud_hid_generic_ready() ) {
-        mp_raise_msg(&mp_type_OSError,  translate("USB Busy"));
+    if (self->queue_count >= self->queue_length) {
+        if (self->drop_oldest) {
+            self->queue_start = (self->queue_start + 1) % USB_HID_REPORT_QUEUE_MAX;
+            self->queue_count--;
+        } else {
+            // Wait until the host takes a report, timeout = 2 seconds
+            uint64_t end_ticks = ticks_ms + 2000;
+            while (self->queue_count >= self->queue_length && ticks_ms < end_ticks) {
+                #ifdef MICROPY_VM_HOOK_LOOP
+                    MICROPY_VM_HOOK_LOOP
+                #endif
+                port_sleep_until_interrupt();
+            }
+            if (self->queue_count >= self->queue_length) {
+                mp_raise_msg(&mp_type_OSError,  translate("USB Busy"));
+            }
+        }
     }
 
-    memcpy(self->report_buffer, report, len);
+    memcpy(queued_report(self, self->queue_count), report, len);
+    self->queue_count++;
+}
+
+uint8_t common_hal_usb_hid_device_get_queue_length(usb_hid_device_obj_t *self) {
+    return self->queue_length;
+}
+
+void common_hal_usb_hid_device_set_queue_length(usb_hid_device_obj_t *self, uint8_t queue_length) {
+    // Reports already queued beyond the new length stay queued.
+    self->queue_length = queue_length;
+}
+
+bool common_hal_usb_hid_device_get_drop_oldest(usb_hid_device_obj_t *self) {
+    return self->drop_oldest;
+}
+
+void common_hal_usb_hid_device_set_drop_oldest(usb_hid_device_obj_t *self, bool drop_oldest) {
+    self->drop_oldest = drop_oldest;
+}
+
+void usb_hid_background(void) {
+    // All the devices share one endpoint. Take turns so a busy device can't starve the others.
+    static uint8_t next_device = 0;
 
-    if ( !tud_hid_generic_report(self->report_id, self->report_buffer, len) ) {
-        mp_raise_msg(&mp_type_OSError, translate("USB Error"));
+    if (!tud_hid_generic_ready()) {
+        return;
+    }
+    for (size_t i = 0; i < USB_HID_NUM_DEVICES; i++) {
+        const size_t index = (next_device + i) % USB_HID_NUM_DEVICES;
+        usb_hid_device_obj_t *device = &usb_hid_devices[index];
+        if (device->queue_count == 0) {
+            continue;
+        }
+        memcpy(device->report_buffer, queued_report(device, 0), device->report_length);
+        if (tud_hid_generic_report(device->report_id, device->report_buffer, device->report_length)) {
+            device->queue_start = (device->queue_start + 1) % USB_HID_REPORT_QUEUE_MAX;
+            device->queue_count--;
+        }
+        next_device = (index + 1) % USB_HID_NUM_DEVICES;
+        return;
     }
 }
 
@@ -36,18 +36,31 @@
  extern "C" {
 #endif
 
+// Reports that can wait for the host to poll, per device.
+#define USB_HID_REPORT_QUEUE_MAX (8)
+#define USB_HID_REPORT_QUEUE_DEFAULT (4)
+
 typedef struct  {
     mp_obj_base_t base;
     uint8_t* report_buffer;
+    // USB_HID_REPORT_QUEUE_MAX reports of report_length bytes.
+    uint8_t* report_queue;
     uint8_t report_id;
     uint8_t report_length;
     uint8_t usage_page;
     uint8_t usage;
+    uint8_t queue_length;
+    uint8_t queue_start;
+    uint8_t queue_count;
+    bool drop_oldest;
 } usb_hid_device_obj_t;
 
 
 extern usb_hid_device_obj_t usb_hid_devices[];
 
+// Hand the next queued report to the host if the HID endpoint is free.
+void usb_hid_background(void);
+
 #ifdef __cplusplus
  }
 #endif
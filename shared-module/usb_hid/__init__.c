@@ -35,26 +35,32 @@
 
 #ifdef USB_HID_REPORT_ID_KEYBOARD
 static uint8_t keyboard_report_buffer[USB_HID_REPORT_LENGTH_KEYBOARD];
+static uint8_t keyboard_report_queue[USB_HID_REPORT_QUEUE_MAX * USB_HID_REPORT_LENGTH_KEYBOARD];
 #endif
 
 #ifdef USB_HID_REPORT_ID_MOUSE
 static uint8_t mouse_report_buffer[USB_HID_REPORT_LENGTH_MOUSE];
+static uint8_t mouse_report_queue[USB_HID_REPORT_QUEUE_MAX * USB_HID_REPORT_LENGTH_MOUSE];
 #endif
 
 #ifdef USB_HID_REPORT_ID_CONSUMER
 static uint8_t consumer_report_buffer[USB_HID_REPORT_LENGTH_CONSUMER];
+static uint8_t consumer_report_queue[USB_HID_REPORT_QUEUE_MAX * USB_HID_REPORT_LENGTH_CONSUMER];
 #endif
 
 #ifdef USB_HID_REPORT_ID_SYS_CONTROL
 static uint8_t sys_control_report_buffer[USB_HID_REPORT_LENGTH_SYS_CONTROL];
+static uint8_t sys_control_report_queue[USB_HID_REPORT_QUEUE_MAX * USB_HID_REPORT_LENGTH_SYS_CONTROL];
 #endif
 
 #ifdef USB_HID_REPORT_ID_GAMEPAD
 static uint8_t gamepad_report_buffer[USB_HID_REPORT_LENGTH_GAMEPAD];
+static uint8_t gamepad_report_queue[USB_HID_REPORT_QUEUE_MAX * USB_HID_REPORT_LENGTH_GAMEPAD];
 #endif
 
 #ifdef USB_HID_REPORT_ID_DIGITIZER
 static uint8_t digitizer_report_buffer[USB_HID_REPORT_LENGTH_DIGITIZER];
+static uint8_t digitizer_report_queue[USB_HID_REPORT_QUEUE_MAX * USB_HID_REPORT_LENGTH_DIGITIZER];
 #endif
 
 usb_hid_device_obj_t usb_hid_devices[] = {
@@ -62,10 +68,12 @@ usb_hid_device_obj_t usb_hid_devices[] = {
     {
         .base          = { .type = &usb_hid_device_type } ,
         .report_buffer = keyboard_report_buffer           ,
+        .report_queue  = keyboard_report_queue            ,
         .report_id     = USB_HID_REPORT_ID_KEYBOARD       ,
         .report_length = USB_HID_REPORT_LENGTH_KEYBOARD   ,
         .usage_page    = HID_USAGE_PAGE_DESKTOP           ,
         .usage         = HID_USAGE_DESKTOP_KEYBOARD       ,
+        .queue_length  = USB_HID_REPORT_QUEUE_DEFAULT     ,
     },
 #endif
 
@@ -73,10 +81,12 @@ usb_hid_device_obj_t usb_hid_devices[] = {
     {
         .base          = { .type = &usb_hid_device_type } ,
         .report_buffer = mouse_report_buffer              ,
+        .report_queue  = mouse_report_queue               ,
         .report_id     = USB_HID_REPORT_ID_MOUSE          ,
         .report_length = USB_HID_REPORT_LENGTH_MOUSE      ,
         .usage_page    = HID_USAGE_PAGE_DESKTOP           ,
         .usage         = HID_USAGE_DESKTOP_MOUSE          ,
+        .queue_length  = USB_HID_REPORT_QUEUE_DEFAULT     ,
     },
 #endif
 
@@ -84,10 +94,12 @@ usb_hid_device_obj_t usb_hid_devices[] = {
     {
         .base          = { .type = &usb_hid_device_type } ,
         .report_buffer = consumer_report_buffer           ,
+        .report_queue  = consumer_report_queue            ,
         .report_id     = USB_HID_REPORT_ID_CONSUMER       ,
         .report_length = USB_HID_REPORT_LENGTH_CONSUMER   ,
         .usage_page    = HID_USAGE_PAGE_CONSUMER          ,
         .usage         = HID_USAGE_CONSUMER_CONTROL       ,
+        .queue_length  = USB_HID_REPORT_QUEUE_DEFAULT     ,
     },
 #endif
 
@@ -95,10 +107,12 @@ usb_hid_device_obj_t usb_hid_devices[] = {
     {
         .base          = { .type = &usb_hid_device_type }  ,
         .report_buffer = sys_control_report_buffer         ,
+        .report_queue  = sys_control_report_queue          ,
         .report_id     = USB_HID_REPORT_ID_SYS_CONTROL     ,
         .report_length = USB_HID_REPORT_LENGTH_SYS_CONTROL ,
         .usage_page    = HID_USAGE_PAGE_DESKTOP            ,
         .usage         = HID_USAGE_DESKTOP_SYSTEM_CONTROL  ,
+        .queue_length  = USB_HID_REPORT_QUEUE_DEFAULT      ,
     },
 #endif
 
@@ -106,10 +120,12 @@ usb_hid_device_obj_t usb_hid_devices[] = {
     {
         .base          = { .type = &usb_hid_device_type } ,
         .report_buffer = gamepad_report_buffer            ,
+        .report_queue  = gamepad_report_queue             ,
         .report_id     = USB_HID_REPORT_ID_GAMEPAD        ,
         .report_length = USB_HID_REPORT_LENGTH_GAMEPAD    ,
         .usage_page    = HID_USAGE_PAGE_DESKTOP           ,
         .usage         = HID_USAGE_DESKTOP_GAMEPAD        ,
+        .queue_length  = USB_HID_REPORT_QUEUE_DEFAULT     ,
     },
 #endif
 
@@ -117,10 +133,12 @@ usb_hid_device_obj_t usb_hid_devices[] = {
     {
         .base          = { .type = &usb_hid_device_type } ,
         .report_buffer = digitizer_report_buffer          ,
+        .report_queue  = digitizer_report_queue           ,
         .report_id     = USB_HID_REPORT_ID_DIGITIZER      ,
         .report_length = USB_HID_REPORT_LENGTH_DIGITIZER  ,
         .usage_page    = 0x0D                             ,
         .usage         = 0x02                             ,
+        .queue_length  = USB_HID_REPORT_QUEUE_DEFAULT     ,
     },
 #endif
 };
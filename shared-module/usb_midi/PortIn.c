@@ -24,7 +24,9 @@
  * THE SOFTWARE.
  */
 
+#include "shared-bindings/usb_midi/PortIn.h"
 #include "shared-module/usb_midi/PortIn.h"
+#include "py/misc.h"
 #include "supervisor/shared/translate.h"
 #include "tusb.h"
 
@@ -35,3 +37,136 @@ size_t common_hal_usb_midi_portin_read(usb_midi_portin_obj_t *self, uint8_t *dat
 uint32_t common_hal_usb_midi_portin_bytes_available(usb_midi_portin_obj_t *self) {
     return tud_midi_available();
 }
+
+void usb_midi_portin_reset(usb_midi_portin_obj_t *self) {
+    self->running_status = 0;
+    self->message_length = 0;
+    self->message_expected = 0;
+    self->in_sysex = false;
+}
+
+// Total bytes, status included, in a channel or system common message.
+STATIC uint8_t message_size(uint8_t status) {
+    if (status < 0xf0) {
+        const uint8_t kind = status >> 4;
+        return (kind == 0xc || kind == 0xd) ? 2 : 3;
+    }
+    switch (status) {
+        case 0xf1:
+        case 0xf3:
+            return 2;
+        case 0xf2:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+STATIC void store_packet(uint8_t *packet, uint8_t cin, const uint8_t *data, uint8_t len) {
+    // Everything arrives on cable 0.
+    packet[0] = cin;
+    for (size_t i = 0; i < 3; i++) {
+        packet[i + 1] = i < len ? data[i] : 0;
+    }
+}
+
+// Feed one byte of the stream to the parser. Returns true when it completes a packet.
+STATIC bool parse_byte(usb_midi_portin_obj_t *self, uint8_t b, uint8_t *packet) {
+    if (b >= 0xf8) {
+        // Real-time messages may appear anywhere, even in the middle of another message.
+        store_packet(packet, 0xf, &b, 1);
+        return true;
+    }
+
+    if (b == 0xf0) {
+        self->in_sysex = true;
+        self->running_status = 0;
+        self->message[0] = b;
+        self->message_length = 1;
+        return false;
+    }
+    if (self->in_sysex) {
+        if (b < 0x80 || b == 0xf7) {
+            self->message[self->message_length++] = b;
+            if (b == 0xf7) {
+                // CIN 0x5, 0x6 and 0x7 end a sysex with one, two or three bytes.
+                const uint8_t len = self->message_length;
+                self->in_sysex = false;
+                self->message_length = 0;
+                store_packet(packet, 0x4 + len, self->message, len);
+                return true;
+            }
+            if (self->message_length == 3) {
+                self->message_length = 0;
+                store_packet(packet, 0x4, self->message, 3);
+                return true;
+            }
+            return false;
+        }
+        // Any other status byte cuts the sysex short. Drop the rest of it.
+        self->in_sysex = false;
+        self->message_length = 0;
+    }
+
+    if (b >= 0x80) {
+        const uint8_t size = message_size(b);
+        if (b >= 0xf0) {
+            // System common messages cancel running status.
+            self->running_status = 0;
+            if (size == 1) {
+                self->message_length = 0;
+                if (b == 0xf6) {
+                    store_packet(packet, 0x5, &b, 1);
+                    return true;
+                }
+                // Undefined status or a stray end of sysex.
+                return false;
+            }
+        } else {
+            self->running_status = b;
+        }
+        self->message[0] = b;
+        self->message_length = 1;
+        self->message_expected = size;
+        return false;
+    }
+
+    if (self->message_length == 0) {
+        if (self->running_status == 0) {
+            // No status to attach the data to.
+            return false;
+        }
+        self->message[0] = self->running_status;
+        self->message_length = 1;
+        self->message_expected = message_size(self->running_status);
+    }
+    self->message[self->message_length++] = b;
+    if (self->message_length < self->message_expected) {
+        return false;
+    }
+    const uint8_t status = self->message[0];
+    // Channel messages use the status nibble as CIN. System common messages use CIN 0x2 or 0x3
+    // for two or three bytes.
+    const uint8_t cin = status < 0xf0 ? status >> 4 : self->message_expected;
+    store_packet(packet, cin, self->message, self->message_length);
+    self->message_length = 0;
+    return true;
+}
+
+size_t common_hal_usb_midi_portin_read_messages(usb_midi_portin_obj_t *self, uint8_t *packets, size_t packet_count) {
+    uint8_t bytes[64];
+    size_t stored = 0;
+    while (stored < packet_count) {
+        // Each byte completes at most one packet so never take more than there is room for.
+        const uint32_t count = tud_midi_read(bytes, MIN(packet_count - stored, sizeof(bytes)));
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (parse_byte(self, bytes[i], packets + stored * USB_MIDI_PACKET_SIZE)) {
+                stored++;
+            }
+        }
+    }
+    return stored;
+}
@@ -32,8 +32,20 @@
 
 #include "py/obj.h"
 
+// A USB-MIDI event packet is four bytes: the cable number and code index number (CIN), followed by
+// up to three MIDI bytes.
+#define USB_MIDI_PACKET_SIZE (4)
+
 typedef struct  {
     mp_obj_base_t base;
+    // State for turning the incoming byte stream back into event packets.
+    uint8_t running_status;
+    uint8_t message[3];
+    uint8_t message_length;
+    uint8_t message_expected;
+    bool in_sysex;
 } usb_midi_portin_obj_t;
 
+void usb_midi_portin_reset(usb_midi_portin_obj_t *self);
+
 #endif /* SHARED_MODULE_USB_MIDI_PORTIN_H */
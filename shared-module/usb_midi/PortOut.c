@@ -24,6 +24,10 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
+#include "shared-bindings/usb_midi/PortOut.h"
+#include "shared-module/usb_midi/PortIn.h"
 #include "shared-module/usb_midi/PortOut.h"
 #include "supervisor/shared/translate.h"
 #include "tusb.h"
@@ -35,3 +39,45 @@ size_t common_hal_usb_midi_portout_write(usb_midi_portout_obj_t *self, const uin
 bool common_hal_usb_midi_portout_ready_to_tx(usb_midi_portout_obj_t *self) {
     return tud_midi_connected();
 }
+
+// MIDI bytes carried by a packet, indexed by its code index number. 0x0 and 0x1 are reserved.
+STATIC const uint8_t cin_payload_size[16] = {
+    0, 0, 2, 3, 3, 1, 2, 3, 3, 3, 3, 3, 2, 2, 3, 1
+};
+
+// Packets are gathered into this many bytes per tud_midi_write call.
+#define WRITE_CHUNK_SIZE (96)
+
+size_t common_hal_usb_midi_portout_write_messages(usb_midi_portout_obj_t *self, const uint8_t *packets, size_t packet_count) {
+    uint8_t bytes[WRITE_CHUNK_SIZE];
+    size_t sent = 0;
+    while (sent < packet_count) {
+        size_t len = 0;
+        size_t end = sent;
+        for (; end < packet_count; end++) {
+            const uint8_t *packet = packets + end * USB_MIDI_PACKET_SIZE;
+            const uint8_t size = cin_payload_size[packet[0] & 0xf];
+            if (len + size > sizeof(bytes)) {
+                break;
+            }
+            memcpy(bytes + len, packet + 1, size);
+            len += size;
+        }
+
+        const uint32_t written = tud_midi_write(0, bytes, len);
+        if (written < len) {
+            // Only count the packets that made it out whole.
+            size_t done = 0;
+            while (sent < end) {
+                done += cin_payload_size[packets[sent * USB_MIDI_PACKET_SIZE] & 0xf];
+                if (done > written) {
+                    break;
+                }
+                sent++;
+            }
+            break;
+        }
+        sent = end;
+    }
+    return sent;
+}
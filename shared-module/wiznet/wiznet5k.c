@@ -54,6 +54,19 @@
 
 STATIC wiznet5k_obj_t wiznet5k_obj;
 
+// Socket interrupts that show in SIR, so that polling can tell from one read
+// of SIR which sockets have anything to report.  SENDOK is left out because
+// send() waits for and clears it itself.
+#define WIZNET5K_POLL_IMR (Sn_IR_CON | Sn_IR_DISCON | Sn_IR_RECV | Sn_IR_TIMEOUT)
+
+// The W5500 is rated to 33MHz, the port clamps this to the fastest rate it can
+// do.  Older chips are slower.
+#if _WIZCHIP_ == 5500
+#define WIZNET5K_SPI_BAUDRATE (33000000)
+#else
+#define WIZNET5K_SPI_BAUDRATE (10000000)
+#endif
+
 STATIC void wiz_cris_enter(void) {
     wiznet5k_obj.cris_state = MICROPY_BEGIN_ATOMIC_SECTION();
 }
@@ -135,6 +148,7 @@ void wiznet5k_socket_close(mod_network_socket_obj_t *socket) {
     uint8_t sn = (uint8_t)socket->u_param.fileno;
     if (sn < _WIZCHIP_SOCK_NUM_) {
         wiznet5k_obj.socket_used &= ~(1 << sn);
+        wiznet5k_obj.socket_listening &= ~(1 << sn);
         WIZCHIP_EXPORT(close)(sn);
     }
 }
@@ -151,6 +165,8 @@ int wiznet5k_socket_bind(mod_network_socket_obj_t *socket, byte *ip, mp_uint_t p
     // indicate that this socket has been opened
     socket->u_param.domain = 1;
 
+    setSn_IMR(socket->u_param.fileno, WIZNET5K_POLL_IMR);
+
     // success
     return 0;
 }
@@ -162,6 +178,7 @@ int wiznet5k_socket_listen(mod_network_socket_obj_t *socket, mp_int_t backlog, i
         *_errno = -ret;
         return -1;
     }
+    wiznet5k_obj.socket_listening |= 1 << socket->u_param.fileno;
     return 0;
 }
 
@@ -170,6 +187,7 @@ int wiznet5k_socket_accept(mod_network_socket_obj_t *socket, mod_network_socket_
         int sr = getSn_SR((uint8_t)socket->u_param.fileno);
         if (sr == SOCK_ESTABLISHED) {
             socket2->u_param = socket->u_param;
+            wiznet5k_obj.socket_listening &= ~(1 << socket2->u_param.fileno);
             getSn_DIPR((uint8_t)socket2->u_param.fileno, ip);
             *port = getSn_PORT(socket2->u_param.fileno);
 
@@ -301,16 +319,92 @@ int wiznet5k_socket_settimeout(mod_network_socket_obj_t *socket, mp_uint_t timeo
     */
 }
 
+#if _WIZCHIP_ == 5500
+// Work out whether a socket is readable, or has been disconnected, from its
+// interrupt flags.  The RECV flag is only acknowledged once the receive buffer
+// is empty, so a socket with data waiting always has its bit set in SIR and
+// a socket whose bit is clear needs no further reads.
+STATIC int wiznet5k_socket_poll_rd(uint8_t sn) {
+    uint8_t bit = 1 << sn;
+    mp_uint_t now = mp_hal_ticks_ms();
+    if (wiznet5k_obj.has_irq && common_hal_digitalio_digitalinout_get_value(&wiznet5k_obj.irq)) {
+        // INTn is active low and only deasserts once SIR is clear, so there's
+        // nothing to report on any socket and no need to go over SPI.
+        wiznet5k_obj.sir = 0;
+        wiznet5k_obj.sir_ticks_ms = now;
+    } else if (now != wiznet5k_obj.sir_ticks_ms) {
+        wiznet5k_obj.sir = getSIR();
+        wiznet5k_obj.sir_ticks_ms = now;
+    }
+    if ((wiznet5k_obj.sir & bit) == 0) {
+        return 0;
+    }
+
+    int ret = 0;
+    uint8_t ir = getSn_IR(sn);
+    if (ir & Sn_IR_RECV) {
+        if (getSn_RX_RSR(sn) != 0) {
+            ret |= MP_STREAM_POLL_RD;
+        } else {
+            // Everything received has been read.  Check again after
+            // acknowledging in case more arrived in between.
+            setSn_IR(sn, Sn_IR_RECV);
+            ir &= ~Sn_IR_RECV;
+            if (getSn_RX_RSR(sn) != 0) {
+                ret |= MP_STREAM_POLL_RD;
+            }
+        }
+    }
+    if (ir & Sn_IR_CON) {
+        if (wiznet5k_obj.socket_listening & bit) {
+            // a connection is waiting to be accepted
+            ret |= MP_STREAM_POLL_RD;
+        } else {
+            setSn_IR(sn, Sn_IR_CON);
+            ir &= ~Sn_IR_CON;
+        }
+    }
+    if (ir & Sn_IR_DISCON) {
+        ret |= MP_STREAM_POLL_RD | MP_STREAM_POLL_HUP;
+    }
+    if (ir & Sn_IR_TIMEOUT) {
+        ret |= MP_STREAM_POLL_RD | MP_STREAM_POLL_HUP | MP_STREAM_POLL_ERR;
+    }
+    if (ir == 0) {
+        wiznet5k_obj.sir &= ~bit;
+    }
+    return ret;
+}
+#else
+STATIC int wiznet5k_socket_poll_rd(uint8_t sn) {
+    int ret = 0;
+    uint8_t sr = getSn_SR(sn);
+    if (sr == SOCK_CLOSE_WAIT || sr == SOCK_CLOSED) {
+        ret |= MP_STREAM_POLL_RD | MP_STREAM_POLL_HUP;
+    } else if (sr == SOCK_ESTABLISHED && (wiznet5k_obj.socket_listening & (1 << sn))) {
+        // a connection is waiting to be accepted
+        ret |= MP_STREAM_POLL_RD;
+    }
+    if (getSn_RX_RSR(sn) != 0) {
+        ret |= MP_STREAM_POLL_RD;
+    }
+    return ret;
+}
+#endif
+
 int wiznet5k_socket_ioctl(mod_network_socket_obj_t *socket, mp_uint_t request, mp_uint_t arg, int *_errno) {
     if (request == MP_STREAM_POLL) {
-        int ret = 0;
-        if (arg & MP_STREAM_POLL_RD && getSn_RX_RSR(socket->u_param.fileno) != 0) {
-            ret |= MP_STREAM_POLL_RD;
+        uint8_t sn = (uint8_t)socket->u_param.fileno;
+        if (sn >= _WIZCHIP_SOCK_NUM_ || socket->u_param.domain == 0) {
+            // not opened yet, so there's nothing to report
+            return 0;
         }
-        if (arg & MP_STREAM_POLL_WR && getSn_TX_FSR(socket->u_param.fileno) != 0) {
+        int ret = wiznet5k_socket_poll_rd(sn);
+        if (arg & MP_STREAM_POLL_WR && getSn_TX_FSR(sn) != 0) {
             ret |= MP_STREAM_POLL_WR;
         }
-        return ret;
+        // errors and hang-ups are reported even if not asked for
+        return ret & (arg | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP);
     } else {
         *_errno = MP_EINVAL;
         return MP_STREAM_ERROR;
@@ -348,7 +442,7 @@ bool wiznet5k_check_dhcp(void) {
 }
 
 /// Create and return a WIZNET5K object.
-mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in) {
+mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in, mp_obj_t irq_in) {
 
     // init the wiznet5k object
     wiznet5k_obj.base.type = (mp_obj_type_t*)&mod_network_nic_type_wiznet5k;
@@ -356,6 +450,11 @@ mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in) {
     wiznet5k_obj.spi = MP_OBJ_TO_PTR(spi_in);
     common_hal_digitalio_digitalinout_construct(&wiznet5k_obj.cs, cs_in);
     common_hal_digitalio_digitalinout_construct(&wiznet5k_obj.rst, rst_in);
+    wiznet5k_obj.has_irq = irq_in != mp_const_none;
+    if (wiznet5k_obj.has_irq) {
+        common_hal_digitalio_digitalinout_construct(&wiznet5k_obj.irq, irq_in);
+        common_hal_digitalio_digitalinout_switch_to_input(&wiznet5k_obj.irq, PULL_UP);
+    }
     wiznet5k_obj.socket_used = 0;
 
     /*!< SPI configuration */
@@ -363,7 +462,7 @@ mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in) {
     // if so skip configuration?
 
     common_hal_busio_spi_configure(wiznet5k_obj.spi,
-        10000000,  // BAUDRATE 10MHz
+        WIZNET5K_SPI_BAUDRATE,
         1, // HIGH POLARITY
         1, // SECOND PHASE TRANSITION
         8 // 8 BITS
@@ -385,6 +484,11 @@ mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in) {
     uint8_t sn_size[16] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
     ctlwizchip(CW_INIT_WIZCHIP, sn_size);
 
+    #if _WIZCHIP_ == 5500
+    // Let every socket drive INTn; each socket's IMR picks what it reports.
+    setSIMR(0xff);
+    #endif
+
     wiz_NetInfo netinfo = {
         .dhcp = NETINFO_DHCP,
     };
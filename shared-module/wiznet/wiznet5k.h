@@ -38,7 +38,16 @@ typedef struct _wiznet5k_obj_t {
     busio_spi_obj_t *spi;
     digitalio_digitalinout_obj_t cs;
     digitalio_digitalinout_obj_t rst;
+    digitalio_digitalinout_obj_t irq;
+    bool has_irq;
     uint8_t socket_used;
+    uint8_t socket_listening;
+    #if _WIZCHIP_ == 5500
+    // SIR as last read, and when, so that polling several sockets in one go
+    // reads it once
+    uint8_t sir;
+    mp_uint_t sir_ticks_ms;
+    #endif
     bool dhcp_active;
 } wiznet5k_obj_t;
 
@@ -58,7 +67,7 @@ int wiznet5k_socket_settimeout(mod_network_socket_obj_t *socket, mp_uint_t timeo
 int wiznet5k_socket_ioctl(mod_network_socket_obj_t *socket, mp_uint_t request, mp_uint_t arg, int *_errno);
 void wiznet5k_socket_timer_tick(mod_network_socket_obj_t *socket);
 mp_obj_t wiznet5k_socket_disconnect(mp_obj_t self_in);
-mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in);
+mp_obj_t wiznet5k_create(mp_obj_t spi_in, mp_obj_t cs_in, mp_obj_t rst_in, mp_obj_t irq_in);
 
 void wiznet5k_start_dhcp(void);
 void wiznet5k_stop_dhcp(void);
@@ -38,6 +38,8 @@ void filesystem_tick(void);
 void filesystem_init(bool create_allowed, bool force_create);
 void filesystem_flush(void);
 bool filesystem_present(void);
+// The CIRCUITPY filesystem, which is always the last entry in the mount table.
+fs_user_mount_t *filesystem_circuitpy(void);
 void filesystem_set_internal_writable_by_usb(bool usb_writable);
 void filesystem_set_internal_concurrent_write_protection(bool concurrent_write_protection);
 void filesystem_set_writable_by_usb(fs_user_mount_t *vfs, bool usb_writable);
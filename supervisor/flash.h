@@ -50,4 +50,24 @@ void supervisor_flash_init_vfs(struct _fs_user_mount_t *vfs);
 void supervisor_flash_flush(void);
 void supervisor_flash_release_cache(void);
 
+// Start writing cached data back to the flash without waiting for it.
+// supervisor_flash_background() does the work a step at a time.
+void supervisor_flash_start_flush(void);
+void supervisor_flash_background(void);
+
+// Bytes at the end of the external flash kept out of CIRCUITPY for a littlefs
+// filesystem mounted at /data. A multiple of the erase sector size.
+#ifndef CIRCUITPY_DATA_PARTITION_SIZE
+#define CIRCUITPY_DATA_PARTITION_SIZE (0)
+#endif
+
+#if CIRCUITPY_DATA_PARTITION_SIZE > 0
+// The data partition is addressed by erase sector and bypasses the block
+// cache. These return true on success.
+uint32_t supervisor_flash_data_partition_sector_count(void);
+bool supervisor_flash_data_partition_read(uint32_t sector, uint32_t offset, uint8_t* dest, uint32_t length);
+bool supervisor_flash_data_partition_program(uint32_t sector, uint32_t offset, const uint8_t* src, uint32_t length);
+bool supervisor_flash_data_partition_erase(uint32_t sector);
+#endif
+
 #endif  // MICROPY_INCLUDED_SUPERVISOR_FLASH_H
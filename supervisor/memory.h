@@ -47,8 +47,28 @@ supervisor_allocation* allocate_remaining_memory(void);
 
 // Allocate a piece of a given length in bytes. If high_address is true then it should be allocated
 // at a lower address from the top of the stack. Otherwise, addresses will increase starting after
-// statically allocated memory.
-supervisor_allocation* allocate_memory(uint32_t length, bool high_address);
+// statically allocated memory. Space freed by earlier allocations on the same side is reused when
+// it fits. If movable is true then supervisor_move_memory() may move the allocation to close gaps
+// so callers must reload ptr afterwards.
+supervisor_allocation* allocate_memory(uint32_t length, bool high_address, bool movable);
+
+// Allocate the largest piece of freed memory stranded between allocations, if it's at least
+// min_length bytes, so that it can be lent to the VM heap. Returns NULL if there isn't one.
+supervisor_allocation* allocate_largest_hole(uint32_t min_length);
+
+// Allocate word aligned memory outside of the VM heap that never moves, for use as a DMA buffer.
+supervisor_allocation* allocate_dma_memory(uint32_t length);
+
+typedef struct {
+    uint32_t total;        // bytes between static memory and the top of the stack
+    uint32_t used;         // bytes in live allocations
+    uint32_t free;         // bytes between the two stacks
+    uint32_t holes;        // freed bytes stranded inside either stack
+    uint32_t largest_free; // largest single free run in bytes
+    uint16_t count;        // number of live allocations
+} supervisor_memory_stats_t;
+
+void supervisor_memory_stats(supervisor_memory_stats_t* stats);
 
 static inline uint16_t align32_size(uint16_t size) {
     if (size % 4 != 0) {
@@ -57,7 +77,8 @@ static inline uint16_t align32_size(uint16_t size) {
     return size;
 }
 
-// Called after the heap is freed in case the supervisor wants to save some values.
+// Called after the heap is freed in case the supervisor wants to save some values. Movable
+// allocations are compacted towards the ends of memory first.
 void supervisor_move_memory(void);
 
 #endif  // MICROPY_INCLUDED_SUPERVISOR_MEMORY_H
@@ -29,6 +29,7 @@
 
 #include "py/mpconfig.h"
 
+#include "shared-bindings/microcontroller/Performance.h"
 #include "supervisor/shared/safe_mode.h"
 
 // Provided by the linker;
@@ -54,6 +55,14 @@ void reset_board(void);
 // Reset to the bootloader
 void reset_to_bootloader(void);
 
+// Sleep until the next interrupt. The tick interrupt wakes it at least every millisecond so
+// callers can use it in any wait loop that runs background tasks.
+void port_sleep_until_interrupt(void);
+
+// Change the CPU clock for the given level. It may take until the next tick to switch. Use
+// supervisor_performance_set_level instead, which takes automatic boosts into account.
+void port_set_performance(mcu_performance_t level);
+
 // Save and retrieve a word from memory that is preserved over reset. Used for safe mode.
 void port_set_saved_word(uint32_t);
 uint32_t port_get_saved_word(void);
@@ -46,4 +46,7 @@ char serial_read(void);
 bool serial_bytes_available(void);
 bool serial_connected(void);
 
+// Writes out console output that mp_hal_stdout_tx_strn is still holding.
+void mp_hal_stdout_flush(void);
+
 #endif  // MICROPY_INCLUDED_SUPERVISOR_SERIAL_H
@@ -30,6 +30,10 @@
 #include "py/reload.h"
 
 static volatile uint32_t autoreload_delay_ms = 0;
+// How long the current reload has been waiting for the host to finish writing.
+static volatile uint32_t autoreload_pending_ms = 0;
+// Everything written since the current reload started waiting.
+static volatile uint8_t autoreload_changes = 0;
 static bool autoreload_enabled = false;
 static bool autoreload_suspended = false;
 
@@ -39,12 +43,21 @@ inline void autoreload_tick() {
     if (autoreload_delay_ms == 0) {
         return;
     }
-    if (autoreload_delay_ms == 1 && autoreload_enabled &&
-        !autoreload_suspended && !reload_requested) {
-        mp_raise_reload_exception();
-        reload_requested = true;
+    if (autoreload_delay_ms == 1) {
+        // When file contents were written without any directory entry
+        // changing (a save within the two second resolution of FAT
+        // timestamps), we can't tell which file it was, so reload.
+        uint8_t changes = autoreload_changes;
+        bool changed_code = (changes & AUTORELOAD_CHANGED_CODE) != 0 ||
+            (changes & (AUTORELOAD_CHANGED_DATA | AUTORELOAD_CHANGED_OTHER)) == AUTORELOAD_CHANGED_DATA;
+        if (changed_code && autoreload_enabled && !autoreload_suspended && !reload_requested) {
+            mp_raise_reload_exception();
+            reload_requested = true;
+        }
+        autoreload_changes = 0;
     }
     autoreload_delay_ms--;
+    autoreload_pending_ms++;
 }
 
 void autoreload_enable() {
@@ -69,10 +82,27 @@ inline bool autoreload_is_enabled() {
 }
 
 void autoreload_start() {
-    autoreload_delay_ms = CIRCUITPY_AUTORELOAD_DELAY_MS;
+    autoreload_start_for_changes(AUTORELOAD_CHANGED_CODE);
+}
+
+void autoreload_start_for_changes(uint8_t changes) {
+    // Hosts often save a file in several writes with pauses in between. The
+    // longer the writes keep coming, the longer to wait after the last one.
+    uint32_t delay = CIRCUITPY_AUTORELOAD_DELAY_MS;
+    if (autoreload_delay_ms > 0) {
+        delay += autoreload_pending_ms;
+        if (delay > CIRCUITPY_AUTORELOAD_MAX_DELAY_MS) {
+            delay = CIRCUITPY_AUTORELOAD_MAX_DELAY_MS;
+        }
+    } else {
+        autoreload_pending_ms = 0;
+    }
+    autoreload_changes |= changes;
+    autoreload_delay_ms = delay;
 }
 
 void autoreload_stop() {
     autoreload_delay_ms = 0;
+    autoreload_changes = 0;
     reload_requested = false;
 }
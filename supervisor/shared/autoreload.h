@@ -28,12 +28,23 @@
 #define MICROPY_INCLUDED_SUPERVISOR_AUTORELOAD_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+// What a write changed, so that saving other files doesn't restart the code.
+// Any file's directory entry changes when it is saved, so writes of file
+// contents alone only count when no other file's entry changed alongside.
+#define AUTORELOAD_CHANGED_CODE (1 << 0)
+#define AUTORELOAD_CHANGED_OTHER (1 << 1)
+#define AUTORELOAD_CHANGED_DATA (1 << 2)
 
 extern volatile bool reload_requested;
 
 void autoreload_tick(void);
 
 void autoreload_start(void);
+// Restarts the delay after every write but only reloads if the writes made
+// while waiting changed code.
+void autoreload_start_for_changes(uint8_t changes);
 void autoreload_stop(void);
 void autoreload_enable(void);
 void autoreload_disable(void);
@@ -55,7 +55,7 @@ void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
     uint16_t total_tiles = width_in_tiles * height_in_tiles;
 
     // First try to allocate outside the heap. This will fail when the VM is running.
-    tilegrid_tiles = allocate_memory(align32_size(total_tiles), false);
+    tilegrid_tiles = allocate_memory(align32_size(total_tiles), false, true);
     uint8_t* tiles;
     if (tilegrid_tiles == NULL) {
         tiles = m_malloc(total_tiles, true);
@@ -90,14 +90,20 @@ void supervisor_stop_terminal(void) {
 void supervisor_display_move_memory(void) {
     #if CIRCUITPY_DISPLAYIO
     displayio_tilegrid_t* grid = &supervisor_terminal_text_grid;
+    // Our tiles may have been slid over freed supervisor memory.
+    if (tilegrid_tiles != NULL) {
+        grid->tiles = (uint8_t*) tilegrid_tiles->ptr;
+        return;
+    }
     if (MP_STATE_VM(terminal_tilegrid_tiles) == NULL || grid->tiles != MP_STATE_VM(terminal_tilegrid_tiles)) {
         return;
     }
     uint16_t total_tiles = grid->width_in_tiles * grid->height_in_tiles;
 
-    tilegrid_tiles = allocate_memory(align32_size(total_tiles), false);
+    tilegrid_tiles = allocate_memory(align32_size(total_tiles), false, true);
     if (tilegrid_tiles != NULL) {
-        memcpy(tilegrid_tiles->ptr, grid->tiles, total_tiles);
+        // The old heap may overlap the new allocation.
+        memmove(tilegrid_tiles->ptr, grid->tiles, total_tiles);
         grid->tiles = (uint8_t*) tilegrid_tiles->ptr;
     } else {
         grid->tiles = NULL;
@@ -133,23 +139,21 @@ displayio_bitmap_t blinka_bitmap = {
     .data = blinka_bitmap_data,
     .stride = 2,
     .bits_per_value = 4,
-    .x_shift = 3,
-    .x_mask = 0x7,
-    .bitmask = 0xf,
     .read_only = true
 };
 
 uint32_t blinka_transparency[1] = {0x80000000};
 
 // These colors are RGB 565 with the bytes swapped.
-uint32_t blinka_colors[8] = {0x78890000, 0x9F86B8FC, 0xffff0D5A, 0x0000f501,
-                             0x00000000, 0x00000000, 0x00000000, 0x00000000};
+uint16_t blinka_colors[16] = {0x0000, 0x7889, 0xB8FC, 0x9F86, 0x0D5A, 0xffff, 0xf501, 0x0000,
+                              0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000};
 
 displayio_palette_t blinka_palette = {
     .base = {.type = &displayio_palette_type },
     .opaque = blinka_transparency,
     .colors = blinka_colors,
     .color_count = 16,
+    .transparent_count = 1,
     .needs_refresh = false
 };
 
@@ -185,6 +189,5 @@ displayio_group_t circuitpython_splash = {
     .scale = 2,
     .size = 2,
     .max_size = 2,
-    .children = splash_children,
-    .needs_refresh = true
+    .children = splash_children
 };
@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "supervisor/flash.h"
 #include "supervisor/spi_flash_api.h"
 #include "supervisor/shared/external_flash/common_commands.h"
 #include "extmod/vfs.h"
@@ -40,21 +41,59 @@
 #include "supervisor/memory.h"
 #include "supervisor/shared/rgb_led_status.h"
 
+#ifndef CIRCUITPY_EXTERNAL_FLASH_FTL
+#define CIRCUITPY_EXTERNAL_FLASH_FTL (0)
+#endif
+
+#if CIRCUITPY_EXTERNAL_FLASH_FTL
+#include "supervisor/shared/external_flash/ftl.h"
+#endif
+
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
-static uint32_t current_sector;
+// The most sectors to cache in ram when it can be allocated outside the heap.
+// Filesystem updates alternate between the FAT, directory and data sectors so
+// caching a few of them saves erasing and rewriting a sector for each write.
+#ifndef CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (4)
+#endif
+
+// The currently cached sectors in the cache, ram or flash based. Caches in
+// flash or on the heap only use the first.
+static uint32_t current_sector[CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS];
 
 const external_flash_device possible_devices[EXTERNAL_FLASH_DEVICE_COUNT] = {EXTERNAL_FLASH_DEVICES};
 
 static const external_flash_device* flash_device = NULL;
 
-// Track which blocks (up to 32) in the current sector currently live in the
+// Track which blocks (up to 32) in each cached sector currently live in the
 // cache.
-static uint32_t dirty_mask;
+static uint32_t dirty_mask[CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS];
+
+// When each cached sector was last used so that the least recently used one is
+// flushed to make room for another.
+static uint32_t last_used[CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS];
+static uint32_t use_count;
+
+// The number of sectors the current cache holds.
+static uint8_t cache_sectors = 1;
+
+// A flush of a ram cached sector done a page at a time from the background
+// task. The sector stays in the cache, with all of its blocks marked dirty,
+// until the last page is written so that reads are served from ram meanwhile.
+#define NO_BACKGROUND_FLUSH (-1)
+static int8_t background_flush_slot = NO_BACKGROUND_FLUSH;
+static uint8_t background_flush_page;
+// Whether the background task should flush all of the cached sectors.
+static bool background_flush_requested = false;
 
 static supervisor_allocation* supervisor_cache = NULL;
 
+// Whether the flash may still be busy with a program or erase. Reads only need
+// to check the status when it is, which lets memory mapped flash be read
+// without sending a command each time.
+static bool write_in_progress = true;
+
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
     uint8_t read_status_response[1] = {0x00};
@@ -63,11 +102,15 @@ static bool wait_for_flash_ready(void) {
     do {
         ok = spi_flash_read_command(CMD_READ_STATUS, read_status_response, 1);
     } while (ok && (read_status_response[0] & 0x3) != 0);
+    if (ok) {
+        write_in_progress = false;
+    }
     return ok;
 }
 
 // Turn on the write enable bit so we can program and erase the flash.
 static bool write_enable(void) {
+    write_in_progress = true;
     return spi_flash_command(CMD_ENABLE_WRITE);
 }
 
@@ -76,7 +119,7 @@ static bool read_flash(uint32_t address, uint8_t* data, uint32_t data_length) {
     if (flash_device == NULL) {
         return false;
     }
-    if (!wait_for_flash_ready()) {
+    if (write_in_progress && !wait_for_flash_ready()) {
         return false;
     }
     return spi_flash_read_data(address, data, data_length);
@@ -135,7 +178,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -174,6 +217,44 @@ static bool copy_block(uint32_t src_address, uint32_t dest_address) {
     return true;
 }
 
+#if CIRCUITPY_EXTERNAL_FLASH_FTL || CIRCUITPY_DATA_PARTITION_SIZE > 0
+// Unlike write_flash this programs exactly the bytes given, which may start
+// part way through a page.
+static bool program_flash(uint32_t address, const uint8_t* data, uint32_t length) {
+    if (flash_device == NULL) {
+        return false;
+    }
+    while (length > 0) {
+        uint32_t page_length = SPI_FLASH_PAGE_SIZE - address % SPI_FLASH_PAGE_SIZE;
+        if (page_length > length) {
+            page_length = length;
+        }
+        if (!wait_for_flash_ready() || !write_enable() ||
+            !spi_flash_write_data(address, (uint8_t*) data, page_length)) {
+            return false;
+        }
+        address += page_length;
+        data += page_length;
+        length -= page_length;
+    }
+    return true;
+}
+#endif
+
+#if CIRCUITPY_EXTERNAL_FLASH_FTL
+bool external_flash_read(uint32_t address, uint8_t* data, uint32_t length) {
+    return read_flash(address, data, length);
+}
+
+bool external_flash_program(uint32_t address, const uint8_t* data, uint32_t length) {
+    return program_flash(address, data, length);
+}
+
+bool external_flash_erase(uint32_t sector_address) {
+    return erase_sector(sector_address);
+}
+#endif
+
 void supervisor_flash_init(void) {
     if (flash_device != NULL) {
         return;
@@ -252,9 +333,16 @@ void supervisor_flash_init(void) {
 
     wait_for_flash_ready();
 
-    current_sector = NO_SECTOR_LOADED;
-    dirty_mask = 0;
+    for (uint8_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        current_sector[i] = NO_SECTOR_LOADED;
+        dirty_mask[i] = 0;
+    }
     MP_STATE_VM(flash_ram_cache) = NULL;
+
+    #if CIRCUITPY_EXTERNAL_FLASH_FTL
+    // Without room for the block map there is no filesystem to mount.
+    ftl_init(flash_device->total_size - CIRCUITPY_DATA_PARTITION_SIZE);
+    #endif
 }
 
 // The size of each individual block.
@@ -264,15 +352,58 @@ uint32_t supervisor_flash_get_block_size(void) {
 
 // The total number of available blocks.
 uint32_t supervisor_flash_get_block_count(void) {
+    #if CIRCUITPY_EXTERNAL_FLASH_FTL
+    return ftl_block_count();
+    #endif
     // We subtract one erase sector size because we may use it as a staging area
     // for writes.
-    return (flash_device->total_size - SPI_FLASH_ERASE_SIZE) / FILESYSTEM_BLOCK_SIZE;
+    return (flash_device->total_size - SPI_FLASH_ERASE_SIZE - CIRCUITPY_DATA_PARTITION_SIZE) / FILESYSTEM_BLOCK_SIZE;
+}
+
+#if CIRCUITPY_DATA_PARTITION_SIZE > 0
+// The data partition sits just below the scratch sector, or at the very end of
+// the flash when the translation layer manages CIRCUITPY.
+static uint32_t data_partition_address(uint32_t sector, uint32_t offset) {
+    uint32_t end = flash_device->total_size;
+    #if !CIRCUITPY_EXTERNAL_FLASH_FTL
+    end -= SPI_FLASH_ERASE_SIZE;
+    #endif
+    return end - CIRCUITPY_DATA_PARTITION_SIZE + sector * SPI_FLASH_ERASE_SIZE + offset;
+}
+
+uint32_t supervisor_flash_data_partition_sector_count(void) {
+    if (flash_device == NULL) {
+        return 0;
+    }
+    return CIRCUITPY_DATA_PARTITION_SIZE / SPI_FLASH_ERASE_SIZE;
+}
+
+bool supervisor_flash_data_partition_read(uint32_t sector, uint32_t offset, uint8_t* dest, uint32_t length) {
+    if (flash_device == NULL) {
+        return false;
+    }
+    return read_flash(data_partition_address(sector, offset), dest, length);
 }
 
+bool supervisor_flash_data_partition_program(uint32_t sector, uint32_t offset, const uint8_t* src, uint32_t length) {
+    if (flash_device == NULL) {
+        return false;
+    }
+    return program_flash(data_partition_address(sector, offset), src, length);
+}
+
+bool supervisor_flash_data_partition_erase(uint32_t sector) {
+    if (flash_device == NULL) {
+        return false;
+    }
+    return erase_sector(data_partition_address(sector, 0));
+}
+#endif
+
 // Flush the cache that was written to the scratch portion of flash. Only used
 // when ram is tight.
 static bool flush_scratch_flash(void) {
-    if (current_sector == NO_SECTOR_LOADED) {
+    if (current_sector[0] == NO_SECTOR_LOADED) {
         return true;
     }
     // First, copy out any blocks that we haven't touched from the sector we've
@@ -280,9 +411,9 @@ static bool flush_scratch_flash(void) {
     bool copy_to_scratch_ok = true;
     uint32_t scratch_sector = flash_device->total_size - SPI_FLASH_ERASE_SIZE;
     for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((dirty_mask[0] & (1 << i)) == 0) {
             copy_to_scratch_ok = copy_to_scratch_ok &&
-                copy_block(current_sector + i * FILESYSTEM_BLOCK_SIZE,
+                copy_block(current_sector[0] + i * FILESYSTEM_BLOCK_SIZE,
                            scratch_sector + i * FILESYSTEM_BLOCK_SIZE);
         }
     }
@@ -292,39 +423,59 @@ static bool flush_scratch_flash(void) {
         return false;
     }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(current_sector[0]);
     // Finally, copy the new version into it.
     for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
         copy_block(scratch_sector + i * FILESYSTEM_BLOCK_SIZE,
-                   current_sector + i * FILESYSTEM_BLOCK_SIZE);
+                   current_sector[0] + i * FILESYSTEM_BLOCK_SIZE);
     }
     return true;
 }
 
-// Attempts to allocate a new set of page buffers for caching a full sector in
-// ram. Each page is allocated separately so that the GC doesn't need to provide
-// one huge block. We can free it as we write if we want to also.
+// Returns the ram cache of the given page of a block in a cached sector.
+static uint8_t* cached_page(uint8_t slot, uint8_t block_index, uint8_t page) {
+    uint8_t blocks_per_sector = SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE;
+    uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
+    return MP_STATE_VM(flash_ram_cache)[(slot * blocks_per_sector + block_index) * pages_per_block + page];
+}
+
+// Attempts to allocate a new set of page buffers for caching sectors in ram.
+// Outside the heap there is room for as many sectors as fit in half of the
+// free memory, up to CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS. On the heap only
+// one sector is cached and each page is allocated separately so that the GC
+// doesn't need to provide one huge block. We can free it as we write if we
+// want to also.
 static bool allocate_ram_cache(void) {
     uint8_t blocks_per_sector = SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE;
     uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
 
-    uint32_t table_size = blocks_per_sector * pages_per_block * sizeof(uint32_t);
+    uint32_t table_size = blocks_per_sector * pages_per_block * sizeof(uint8_t*);
     // Attempt to allocate outside the heap first.
-    supervisor_cache = allocate_memory(table_size + SPI_FLASH_ERASE_SIZE, false);
+    supervisor_memory_stats_t stats;
+    supervisor_memory_stats(&stats);
+    for (uint8_t sectors = CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; sectors > 0; sectors--) {
+        uint32_t size = sectors * (table_size + SPI_FLASH_ERASE_SIZE);
+        if (sectors > 1 && size > stats.free / 2) {
+            continue;
+        }
+        supervisor_cache = allocate_memory(size, false, false);
+        if (supervisor_cache != NULL) {
+            cache_sectors = sectors;
+            break;
+        }
+    }
     if (supervisor_cache != NULL) {
         MP_STATE_VM(flash_ram_cache) = (uint8_t **) supervisor_cache->ptr;
-        uint8_t* page_start = (uint8_t *) supervisor_cache->ptr + table_size;
+        uint8_t* page_start = (uint8_t *) supervisor_cache->ptr + cache_sectors * table_size;
 
-        for (uint8_t i = 0; i < blocks_per_sector; i++) {
-            for (uint8_t j = 0; j < pages_per_block; j++) {
-                uint32_t offset = i * pages_per_block + j;
-                MP_STATE_VM(flash_ram_cache)[offset] = page_start + offset * SPI_FLASH_PAGE_SIZE;
-            }
+        for (uint32_t offset = 0; offset < cache_sectors * blocks_per_sector * pages_per_block; offset++) {
+            MP_STATE_VM(flash_ram_cache)[offset] = page_start + offset * SPI_FLASH_PAGE_SIZE;
         }
         return true;
     }
 
-    MP_STATE_VM(flash_ram_cache) = m_malloc_maybe(blocks_per_sector * pages_per_block * sizeof(uint32_t), false);
+    cache_sectors = 1;
+    MP_STATE_VM(flash_ram_cache) = m_malloc_maybe(blocks_per_sector * pages_per_block * sizeof(uint8_t*), false);
     if (MP_STATE_VM(flash_ram_cache) == NULL) {
         return false;
     }
@@ -371,28 +522,20 @@ static void release_ram_cache(void) {
         m_free(MP_STATE_VM(flash_ram_cache));
     }
     MP_STATE_VM(flash_ram_cache) = NULL;
+    cache_sectors = 1;
 }
 
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
-        }
-        return true;
-    }
-    // First, copy out any blocks that we haven't touched from the sector
-    // we've cached. If we don't do this we'll erase the data during the sector
-    // erase below.
+// Copy out any blocks that we haven't touched from a sector we've cached in
+// ram. If we don't do this we'll erase the data when the sector is erased.
+static bool fill_ram_sector(uint8_t slot) {
     bool copy_to_ram_ok = true;
     uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
     for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((dirty_mask[slot] & (1 << i)) == 0) {
             for (uint8_t j = 0; j < pages_per_block; j++) {
                 copy_to_ram_ok = read_flash(
-                    current_sector + (i * pages_per_block + j) * SPI_FLASH_PAGE_SIZE,
-                    MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j],
+                    current_sector[slot] + (i * pages_per_block + j) * SPI_FLASH_PAGE_SIZE,
+                    cached_page(slot, i, j),
                     SPI_FLASH_PAGE_SIZE);
                 if (!copy_to_ram_ok) {
                     break;
@@ -403,47 +546,181 @@ static bool flush_ram_cache(bool keep_cache) {
             break;
         }
     }
+    return copy_to_ram_ok;
+}
 
-    if (!copy_to_ram_ok) {
+// Flush one cached sector from ram onto the flash.
+static bool flush_ram_sector(uint8_t slot) {
+    if (current_sector[slot] == NO_SECTOR_LOADED) {
+        return true;
+    }
+    // First, fill in the blocks we haven't touched.
+    if (!fill_ram_sector(slot)) {
         return false;
     }
+    uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(current_sector[slot]);
     // Lastly, write all the data in ram that we've cached.
     for (uint8_t i = 0; i < SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE; i++) {
         for (uint8_t j = 0; j < pages_per_block; j++) {
-            write_flash(current_sector + (i * pages_per_block + j) * SPI_FLASH_PAGE_SIZE,
-                        MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j],
+            write_flash(current_sector[slot] + (i * pages_per_block + j) * SPI_FLASH_PAGE_SIZE,
+                        cached_page(slot, i, j),
                         SPI_FLASH_PAGE_SIZE);
-            if (!keep_cache && supervisor_cache == NULL) {
-                m_free(MP_STATE_VM(flash_ram_cache)[i * pages_per_block + j]);
-            }
         }
     }
+    return true;
+}
+
+// Flush the cached sectors from ram onto the flash. We'll free the cache unless
+// keep_cache is true.
+static bool flush_ram_cache(bool keep_cache) {
+    bool ok = true;
+    for (uint8_t slot = 0; slot < cache_sectors; slot++) {
+        ok = flush_ram_sector(slot) && ok;
+    }
     // We're done with the cache for now so give it back.
     if (!keep_cache) {
+        if (supervisor_cache == NULL) {
+            uint8_t pages = (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE) * (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE);
+            for (uint8_t i = 0; i < pages; i++) {
+                m_free(MP_STATE_VM(flash_ram_cache)[i]);
+            }
+        }
         release_ram_cache();
     }
-    return true;
+    return ok;
+}
+
+static void show_write_activity(bool active) {
+    #ifdef MICROPY_HW_LED_MSC
+        port_pin_set_output_level(MICROPY_HW_LED_MSC, active);
+    #endif
+    if (active) {
+        temp_status_color(ACTIVE_WRITE);
+    } else {
+        clear_temp_status();
+    }
+}
+
+// Returns whether the flash is still busy with a program or erase without
+// waiting for it.
+static bool flash_busy(void) {
+    if (!write_in_progress) {
+        return false;
+    }
+    uint8_t read_status_response[1] = {0x00};
+    if (!spi_flash_read_command(CMD_READ_STATUS, read_status_response, 1) ||
+        (read_status_response[0] & 0x3) != 0) {
+        return true;
+    }
+    write_in_progress = false;
+    return false;
+}
+
+// Take the next step of the background flush once the flash isn't busy. The
+// first step fills in the untouched blocks and starts the erase, and each one
+// after that programs a page.
+static void background_flush_step(void) {
+    if (flash_busy()) {
+        return;
+    }
+    uint8_t slot = background_flush_slot;
+    uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
+    uint8_t pages_per_sector = SPI_FLASH_ERASE_SIZE / SPI_FLASH_PAGE_SIZE;
+    if (background_flush_page == 0xff) {
+        if (!fill_ram_sector(slot)) {
+            // Leave the sector cached and try again later.
+            background_flush_slot = NO_BACKGROUND_FLUSH;
+            show_write_activity(false);
+            return;
+        }
+        dirty_mask[slot] = (1 << (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)) - 1;
+        erase_sector(current_sector[slot]);
+        background_flush_page = 0;
+        return;
+    }
+    uint8_t page = background_flush_page;
+    write_flash(current_sector[slot] + page * SPI_FLASH_PAGE_SIZE,
+                cached_page(slot, page / pages_per_block, page % pages_per_block),
+                SPI_FLASH_PAGE_SIZE);
+    background_flush_page++;
+    if (background_flush_page == pages_per_sector) {
+        current_sector[slot] = NO_SECTOR_LOADED;
+        background_flush_slot = NO_BACKGROUND_FLUSH;
+        show_write_activity(false);
+    }
+}
+
+// Finish any background flush before the flash or the cached sector being
+// flushed are changed.
+static void finish_background_flush(void) {
+    while (background_flush_slot != NO_BACKGROUND_FLUSH) {
+        wait_for_flash_ready();
+        background_flush_step();
+    }
+}
+
+void supervisor_flash_start_flush(void) {
+    #if CIRCUITPY_EXTERNAL_FLASH_FTL
+    // Blocks are written straight through to the flash.
+    return;
+    #endif
+    // Flushing through the scratch sector copies whole blocks at a time so
+    // isn't worth splitting up.
+    if (MP_STATE_VM(flash_ram_cache) == NULL) {
+        supervisor_flash_flush();
+        return;
+    }
+    background_flush_requested = true;
+}
+
+void supervisor_flash_background(void) {
+    #if CIRCUITPY_EXTERNAL_FLASH_FTL
+    ftl_background();
+    return;
+    #endif
+    if (background_flush_slot == NO_BACKGROUND_FLUSH) {
+        if (!background_flush_requested) {
+            return;
+        }
+        background_flush_requested = false;
+        if (MP_STATE_VM(flash_ram_cache) == NULL) {
+            return;
+        }
+        for (uint8_t i = 0; i < cache_sectors; i++) {
+            if (current_sector[i] != NO_SECTOR_LOADED) {
+                // Come back for the rest once this one is done.
+                background_flush_requested = true;
+                background_flush_slot = i;
+                background_flush_page = 0xff;
+                show_write_activity(true);
+                break;
+            }
+        }
+        return;
+    }
+    background_flush_step();
 }
 
 // Delegates to the correct flash flush method depending on the existing cache.
 static void spi_flash_flush_keep_cache(bool keep_cache) {
-    #ifdef MICROPY_HW_LED_MSC
-        port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
+    #if CIRCUITPY_EXTERNAL_FLASH_FTL
+    return;
     #endif
-    temp_status_color(ACTIVE_WRITE);
+    finish_background_flush();
+    background_flush_requested = false;
+    show_write_activity(true);
     // If we've cached to the flash itself flush from there.
     if (MP_STATE_VM(flash_ram_cache) == NULL) {
         flush_scratch_flash();
     } else {
         flush_ram_cache(keep_cache);
     }
-    current_sector = NO_SECTOR_LOADED;
-    clear_temp_status();
-    #ifdef MICROPY_HW_LED_MSC
-        port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
-    #endif
+    for (uint8_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        current_sector[i] = NO_SECTOR_LOADED;
+    }
+    show_write_activity(false);
 }
 
 void supervisor_flash_flush(void) {
@@ -463,7 +740,43 @@ static int32_t convert_block_to_flash_addr(uint32_t block) {
     return -1;
 }
 
+// Returns the cache slot holding the given sector or -1 if it isn't cached.
+static int8_t find_cached_sector(uint32_t sector) {
+    for (uint8_t i = 0; i < cache_sectors; i++) {
+        if (current_sector[i] == sector) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns a free cache slot, flushing the least recently used sector if there
+// isn't one.
+static uint8_t make_room_in_cache(void) {
+    uint8_t lru = 0;
+    for (uint8_t i = 0; i < cache_sectors; i++) {
+        if (current_sector[i] == NO_SECTOR_LOADED) {
+            return i;
+        }
+        if (last_used[i] < last_used[lru]) {
+            lru = i;
+        }
+    }
+    show_write_activity(true);
+    if (MP_STATE_VM(flash_ram_cache) == NULL) {
+        flush_scratch_flash();
+    } else {
+        flush_ram_sector(lru);
+    }
+    current_sector[lru] = NO_SECTOR_LOADED;
+    show_write_activity(false);
+    return lru;
+}
+
 bool external_flash_read_block(uint8_t *dest, uint32_t block) {
+    #if CIRCUITPY_EXTERNAL_FLASH_FTL
+    return ftl_read_block(dest, block);
+    #endif
     int32_t address = convert_block_to_flash_addr(block);
     if (address == -1) {
         // bad block number
@@ -474,13 +787,15 @@ bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE);
     uint8_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
+    // We're reading from a cached sector.
+    int8_t slot = find_cached_sector(this_sector);
+    if (slot >= 0 && (mask & dirty_mask[slot]) > 0) {
+        last_used[slot] = ++use_count;
         if (MP_STATE_VM(flash_ram_cache) != NULL) {
             uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
             for (int i = 0; i < pages_per_block; i++) {
                 memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                       MP_STATE_VM(flash_ram_cache)[block_index * pages_per_block + i],
+                       cached_page(slot, block_index, i),
                        SPI_FLASH_PAGE_SIZE);
             }
             return true;
@@ -493,42 +808,56 @@ bool external_flash_read_block(uint8_t *dest, uint32_t block) {
 }
 
 bool external_flash_write_block(const uint8_t *data, uint32_t block) {
+    #if CIRCUITPY_EXTERNAL_FLASH_FTL
+    return ftl_write_block(data, block);
+    #endif
     // Non-MBR block, copy to cache
     int32_t address = convert_block_to_flash_addr(block);
     if (address == -1) {
         // bad block number
         return false;
     }
+    // The sector being flushed in the background can't change under it.
+    finish_background_flush();
     // Wait for any previous writes to finish.
     wait_for_flash_ready();
     // Mask out the lower bits that designate the address within the sector.
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE);
     uint8_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
+    int8_t slot = find_cached_sector(this_sector);
+    // A block cached in ram can simply be overwritten but one in the scratch
+    // sector can't be written again until the cache is flushed.
+    if (slot >= 0 && MP_STATE_VM(flash_ram_cache) == NULL && (mask & dirty_mask[slot]) > 0) {
+        supervisor_flash_flush();
+        slot = -1;
+    }
+    if (slot < 0) {
         // Check to see if we'd write to an erased page. In that case we
         // can write directly.
         if (page_erased(address)) {
             return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
         }
-        if (current_sector != NO_SECTOR_LOADED) {
-            supervisor_flash_flush();
-        }
-        if (MP_STATE_VM(flash_ram_cache) == NULL && !allocate_ram_cache()) {
-            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
-            wait_for_flash_ready();
+        if (MP_STATE_VM(flash_ram_cache) == NULL) {
+            if (current_sector[0] != NO_SECTOR_LOADED) {
+                supervisor_flash_flush();
+            }
+            if (!allocate_ram_cache()) {
+                erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
+                wait_for_flash_ready();
+            }
         }
-        current_sector = this_sector;
-        dirty_mask = 0;
+        slot = make_room_in_cache();
+        current_sector[slot] = this_sector;
+        dirty_mask[slot] = 0;
     }
-    dirty_mask |= mask;
+    dirty_mask[slot] |= mask;
+    last_used[slot] = ++use_count;
     // Copy the block to the appropriate cache.
     if (MP_STATE_VM(flash_ram_cache) != NULL) {
         uint8_t pages_per_block = FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE;
         for (int i = 0; i < pages_per_block; i++) {
-            memcpy(MP_STATE_VM(flash_ram_cache)[block_index * pages_per_block + i],
+            memcpy(cached_page(slot, block_index, i),
                    data + i * SPI_FLASH_PAGE_SIZE,
                    SPI_FLASH_PAGE_SIZE);
         }
@@ -539,11 +868,52 @@ bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     }
 }
 
+// The most blocks to read from the flash in one transaction. Some DMA
+// controllers count transfers in 16 bits.
+#define MAX_READ_BURST_BLOCKS (32)
+
+// Whether the cache has a newer version of the block at address than the flash.
+static bool block_is_cached(uint32_t address) {
+    uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
+    uint8_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE);
+    int8_t slot = find_cached_sector(this_sector);
+    return slot >= 0 && (dirty_mask[slot] & (1 << block_index)) > 0;
+}
+
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
+    #if CIRCUITPY_EXTERNAL_FLASH_FTL
     for (size_t i = 0; i < num_blocks; i++) {
-        if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
+        if (!ftl_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
+            return 1; // error
+        }
+    }
+    return 0; // success
+    #endif
+    size_t i = 0;
+    while (i < num_blocks) {
+        int32_t address = convert_block_to_flash_addr(block_num + i);
+        if (address == -1) {
+            return 1; // error
+        }
+        if (block_is_cached(address)) {
+            if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
+                return 1; // error
+            }
+            i++;
+            continue;
+        }
+        // Read the run of blocks that aren't cached in one transaction rather
+        // than setting up a read for each.
+        uint32_t burst = 1;
+        while (i + burst < num_blocks && burst < MAX_READ_BURST_BLOCKS &&
+               convert_block_to_flash_addr(block_num + i + burst) != -1 &&
+               !block_is_cached(address + burst * FILESYSTEM_BLOCK_SIZE)) {
+            burst++;
+        }
+        if (!read_flash(address, dest + i * FILESYSTEM_BLOCK_SIZE, burst * FILESYSTEM_BLOCK_SIZE)) {
             return 1; // error
         }
+        i += burst;
     }
     return 0; // success
 }
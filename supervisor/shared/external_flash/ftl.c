@@ -0,0 +1,397 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "supervisor/shared/external_flash/ftl.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "py/misc.h"
+#include "supervisor/memory.h"
+#include "supervisor/shared/external_flash/external_flash.h"
+
+// "CFTL" marks a sector that holds translated blocks.
+#define FTL_MAGIC (0x4c544643)
+
+#define SLOTS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
+// The first slot of every sector is its header.
+#define DATA_SLOTS (SLOTS_PER_SECTOR - 1)
+
+// Sectors held back from the filesystem so that there is always somewhere to
+// copy live blocks to while reclaiming space.
+#define SPARE_SECTORS (8)
+// Writes reclaim space until this many sectors are free. Keeping more than one
+// free means a reset part way through reclaiming can't leave nowhere to copy to.
+#define MIN_FREE_SECTORS (3)
+
+#define UNMAPPED (0xffff)
+#define NO_OPEN_SECTOR (0xffff)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    // The filesystem block held in each data slot. All ones while unused.
+    // Entries are a word each because some QSPI peripherals can only program
+    // whole words.
+    uint32_t block[DATA_SLOTS];
+} ftl_header_t;
+
+enum {
+    SECTOR_STALE,  // Free but needs erasing first.
+    SECTOR_ERASED,
+    SECTOR_OPEN,
+    SECTOR_CLOSED,
+};
+
+static supervisor_allocation* ftl_allocation = NULL;
+// The slot holding each filesystem block, numbered sector * SLOTS_PER_SECTOR + slot.
+static uint16_t* block_map;
+static uint8_t* sector_valid;
+static uint8_t* sector_state;
+
+static uint16_t sector_count;
+static uint32_t block_count = 0;
+static uint16_t free_sectors;
+static uint16_t next_free_search;
+
+static uint16_t open_sector = NO_OPEN_SECTOR;
+static uint8_t open_slot;
+static uint32_t next_sequence;
+
+static bool collecting = false;
+static bool background_reclaim = false;
+
+static uint32_t slot_address(uint16_t physical) {
+    return (uint32_t) physical * FILESYSTEM_BLOCK_SIZE;
+}
+
+static bool erase_sector_safely(uint16_t sector) {
+    // Clear the magic first so that an erase cut short by a reset can't leave
+    // behind a header that still looks valid.
+    uint32_t retired = 0;
+    uint32_t address = sector * SPI_FLASH_ERASE_SIZE;
+    return external_flash_program(address, (uint8_t*) &retired, sizeof(retired)) &&
+           external_flash_erase(address);
+}
+
+static void release_slot(uint16_t physical) {
+    uint16_t sector = physical / SLOTS_PER_SECTOR;
+    sector_valid[sector]--;
+    if (sector_valid[sector] == 0 && sector_state[sector] == SECTOR_CLOSED) {
+        sector_state[sector] = SECTOR_STALE;
+        free_sectors++;
+    }
+}
+
+static void close_open_sector(void) {
+    if (open_sector == NO_OPEN_SECTOR) {
+        return;
+    }
+    sector_state[open_sector] = SECTOR_CLOSED;
+    if (sector_valid[open_sector] == 0) {
+        sector_state[open_sector] = SECTOR_STALE;
+        free_sectors++;
+    }
+    open_sector = NO_OPEN_SECTOR;
+}
+
+// Opens the next free sector after the last one used so that erases rotate
+// through the whole flash.
+static bool open_new_sector(void) {
+    // The last free sector is kept for reclaiming space into.
+    if (free_sectors == 0 || (free_sectors == 1 && !collecting)) {
+        return false;
+    }
+    uint16_t sector = next_free_search;
+    while (sector_state[sector] != SECTOR_STALE && sector_state[sector] != SECTOR_ERASED) {
+        sector = (sector + 1) % sector_count;
+    }
+    next_free_search = (sector + 1) % sector_count;
+    if (sector_state[sector] == SECTOR_STALE) {
+        if (!erase_sector_safely(sector)) {
+            return false;
+        }
+        sector_state[sector] = SECTOR_ERASED;
+    }
+    // The magic goes in last so that a sector is only used once its sequence
+    // number is complete.
+    uint32_t address = sector * SPI_FLASH_ERASE_SIZE;
+    uint32_t magic = FTL_MAGIC;
+    if (!external_flash_program(address + offsetof(ftl_header_t, sequence), (uint8_t*) &next_sequence, sizeof(next_sequence)) ||
+        !external_flash_program(address, (uint8_t*) &magic, sizeof(magic))) {
+        return false;
+    }
+    next_sequence++;
+    free_sectors--;
+    sector_state[sector] = SECTOR_OPEN;
+    sector_valid[sector] = 0;
+    open_sector = sector;
+    open_slot = 1;
+    return true;
+}
+
+static bool reclaim_sector(void);
+
+// Writes data to the next slot of the open sector and then records it in the
+// header. Until the header entry is programmed the old copy stays current.
+static bool append_block(const uint8_t* data, uint16_t block) {
+    if (!collecting) {
+        while (free_sectors < MIN_FREE_SECTORS && reclaim_sector()) {
+        }
+        // Only a failed write leaves no free sector. Save the rest of the
+        // open sector for reclaiming into until there is one again.
+        if (free_sectors == 0) {
+            return false;
+        }
+    }
+    if (open_sector != NO_OPEN_SECTOR && open_slot == SLOTS_PER_SECTOR) {
+        close_open_sector();
+    }
+    if (open_sector == NO_OPEN_SECTOR && !open_new_sector()) {
+        return false;
+    }
+    uint16_t physical = open_sector * SLOTS_PER_SECTOR + open_slot;
+    // Skip the slot even if programming fails because it may be partly written.
+    open_slot++;
+    if (!external_flash_program(slot_address(physical), data, FILESYSTEM_BLOCK_SIZE)) {
+        return false;
+    }
+    uint32_t entry_address = open_sector * SPI_FLASH_ERASE_SIZE + offsetof(ftl_header_t, block) +
+                             (physical % SLOTS_PER_SECTOR - 1) * sizeof(uint32_t);
+    uint32_t entry = block;
+    if (!external_flash_program(entry_address, (uint8_t*) &entry, sizeof(entry))) {
+        return false;
+    }
+    sector_valid[open_sector]++;
+    if (block_map[block] != UNMAPPED) {
+        release_slot(block_map[block]);
+    }
+    block_map[block] = physical;
+    return true;
+}
+
+// Copies the live blocks out of the closed sector with the fewest of them and
+// erases it. Returns false if no sector can give back any space.
+static bool reclaim_sector(void) {
+    // With no free sector left, only a sector that fits in the rest of the
+    // open one can be reclaimed.
+    uint8_t room = DATA_SLOTS;
+    if (free_sectors == 0) {
+        room = open_sector == NO_OPEN_SECTOR ? 0 : SLOTS_PER_SECTOR - open_slot;
+    }
+    uint16_t victim = NO_OPEN_SECTOR;
+    for (uint16_t i = 0; i < sector_count; i++) {
+        if (sector_state[i] == SECTOR_CLOSED && sector_valid[i] <= room &&
+            (victim == NO_OPEN_SECTOR || sector_valid[i] < sector_valid[victim])) {
+            victim = i;
+        }
+    }
+    if (victim == NO_OPEN_SECTOR || sector_valid[victim] == DATA_SLOTS) {
+        return false;
+    }
+    ftl_header_t header;
+    bool ok = external_flash_read(victim * SPI_FLASH_ERASE_SIZE, (uint8_t*) &header, sizeof(header));
+    uint8_t buffer[FILESYSTEM_BLOCK_SIZE];
+    collecting = true;
+    for (uint8_t slot = 1; ok && slot < SLOTS_PER_SECTOR && sector_valid[victim] > 0; slot++) {
+        uint32_t block = header.block[slot - 1];
+        uint16_t physical = victim * SLOTS_PER_SECTOR + slot;
+        if (block >= block_count || block_map[block] != physical) {
+            continue;
+        }
+        ok = external_flash_read(slot_address(physical), buffer, FILESYSTEM_BLOCK_SIZE) &&
+             append_block(buffer, block);
+    }
+    collecting = false;
+    // Moving the last live block marked the sector stale. Erase it now rather
+    // than when it is next opened.
+    if (ok && sector_state[victim] == SECTOR_STALE && erase_sector_safely(victim)) {
+        sector_state[victim] = SECTOR_ERASED;
+    }
+    return ok;
+}
+
+// Whether a slot and its header entry are still erased.
+static bool slot_unused(uint16_t sector, uint8_t slot) {
+    uint32_t entry;
+    uint32_t address = sector * SPI_FLASH_ERASE_SIZE;
+    if (!external_flash_read(address + offsetof(ftl_header_t, block) + (slot - 1) * sizeof(uint32_t),
+                             (uint8_t*) &entry, sizeof(entry)) ||
+        entry != 0xffffffff) {
+        return false;
+    }
+    uint32_t buffer[16];
+    address += slot * FILESYSTEM_BLOCK_SIZE;
+    for (uint32_t offset = 0; offset < FILESYSTEM_BLOCK_SIZE; offset += sizeof(buffer)) {
+        if (!external_flash_read(address + offset, (uint8_t*) buffer, sizeof(buffer))) {
+            return false;
+        }
+        for (uint8_t i = 0; i < MP_ARRAY_SIZE(buffer); i++) {
+            if (buffer[i] != 0xffffffff) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ftl_init(uint32_t flash_size) {
+    if (ftl_allocation != NULL) {
+        return true;
+    }
+    uint32_t sectors = flash_size / SPI_FLASH_ERASE_SIZE;
+    // Slot numbers must fit in the 16 bit map.
+    if (sectors > UNMAPPED / SLOTS_PER_SECTOR) {
+        sectors = UNMAPPED / SLOTS_PER_SECTOR;
+    }
+    if (sectors <= SPARE_SECTORS) {
+        return false;
+    }
+    uint32_t blocks = (sectors - SPARE_SECTORS) * DATA_SLOTS;
+    uint32_t length = blocks * sizeof(uint16_t) + sectors * 2 * sizeof(uint8_t);
+    ftl_allocation = allocate_memory((length + 3) & ~3, false, false);
+    // Sequence numbers are only needed to settle which copy is newest while scanning.
+    supervisor_allocation* sequences = allocate_memory(sectors * sizeof(uint32_t), false, false);
+    if (ftl_allocation == NULL || sequences == NULL) {
+        if (sequences != NULL) {
+            free_memory(sequences);
+        }
+        if (ftl_allocation != NULL) {
+            free_memory(ftl_allocation);
+            ftl_allocation = NULL;
+        }
+        return false;
+    }
+    block_map = (uint16_t*) ftl_allocation->ptr;
+    sector_valid = (uint8_t*) (block_map + blocks);
+    sector_state = sector_valid + sectors;
+    uint32_t* sequence = sequences->ptr;
+    sector_count = sectors;
+    block_count = blocks;
+    memset(block_map, 0xff, blocks * sizeof(uint16_t));
+
+    next_sequence = 1;
+    uint16_t newest = sectors - 1;
+    for (uint16_t i = 0; i < sectors; i++) {
+        ftl_header_t header;
+        sector_valid[i] = 0;
+        sequence[i] = 0;
+        if (!external_flash_read(i * SPI_FLASH_ERASE_SIZE, (uint8_t*) &header, sizeof(header)) ||
+            header.magic != FTL_MAGIC) {
+            // Erasing is left until the sector is needed to keep mounting quick.
+            sector_state[i] = SECTOR_STALE;
+            continue;
+        }
+        sector_state[i] = SECTOR_CLOSED;
+        sequence[i] = header.sequence;
+        if (header.sequence >= next_sequence) {
+            next_sequence = header.sequence + 1;
+            newest = i;
+        }
+        for (uint8_t slot = 1; slot < SLOTS_PER_SECTOR; slot++) {
+            uint32_t block = header.block[slot - 1];
+            if (block >= blocks) {
+                continue;
+            }
+            uint16_t current = block_map[block];
+            if (current != UNMAPPED) {
+                // Later slots in the same sector are newer too.
+                uint16_t current_sector = current / SLOTS_PER_SECTOR;
+                if (sequence[current_sector] > header.sequence) {
+                    continue;
+                }
+                sector_valid[current_sector]--;
+            }
+            block_map[block] = i * SLOTS_PER_SECTOR + slot;
+            sector_valid[i]++;
+        }
+    }
+    free_memory(sequences);
+
+    // Carry on appending to the newest sector after the last slot that was
+    // touched. A slot that was partly programmed is skipped even without a
+    // header entry.
+    open_sector = NO_OPEN_SECTOR;
+    if (sector_state[newest] == SECTOR_CLOSED) {
+        uint8_t slot = SLOTS_PER_SECTOR;
+        while (slot > 1 && slot_unused(newest, slot - 1)) {
+            slot--;
+        }
+        if (slot < SLOTS_PER_SECTOR) {
+            sector_state[newest] = SECTOR_OPEN;
+            open_sector = newest;
+            open_slot = slot;
+        }
+    }
+
+    free_sectors = 0;
+    for (uint16_t i = 0; i < sectors; i++) {
+        if (sector_state[i] == SECTOR_CLOSED && sector_valid[i] == 0) {
+            sector_state[i] = SECTOR_STALE;
+        }
+        if (sector_state[i] == SECTOR_STALE) {
+            free_sectors++;
+        }
+    }
+    // Pick up the rotation where it left off.
+    next_free_search = (newest + 1) % sectors;
+    return true;
+}
+
+uint32_t ftl_block_count(void) {
+    return block_count;
+}
+
+bool ftl_read_block(uint8_t* dest, uint32_t block) {
+    if (block >= block_count) {
+        return false;
+    }
+    if (block_map[block] == UNMAPPED) {
+        // Never written so it reads as erased flash would.
+        memset(dest, 0xff, FILESYSTEM_BLOCK_SIZE);
+        return true;
+    }
+    return external_flash_read(slot_address(block_map[block]), dest, FILESYSTEM_BLOCK_SIZE);
+}
+
+bool ftl_write_block(const uint8_t* data, uint32_t block) {
+    if (block >= block_count) {
+        return false;
+    }
+    background_reclaim = true;
+    return append_block(data, block);
+}
+
+void ftl_background(void) {
+    if (!background_reclaim) {
+        return;
+    }
+    // Keep one more free sector than a write needs so it rarely has to wait
+    // for a sector to be copied and erased.
+    if (free_sectors > MIN_FREE_SECTORS || !reclaim_sector()) {
+        background_reclaim = false;
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MICROPY_INCLUDED_SUPERVISOR_SHARED_EXTERNAL_FLASH_FTL_H
+#define MICROPY_INCLUDED_SUPERVISOR_SHARED_EXTERNAL_FLASH_FTL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// A log structured translation layer between the filesystem blocks and the
+// external flash. Rather than erasing and rewriting a whole sector to change
+// one block, each write is appended to the open sector and the old copy is
+// left to be reclaimed later. This spreads erases across the whole flash and
+// means a block is never in a half written state.
+//
+// Each erase sector starts with a header slot that records which filesystem
+// block each of the remaining slots holds. The header entry is programmed
+// after the data so that a write interrupted by a reset is simply ignored.
+
+// Scans the flash and rebuilds the block map. Returns false if there isn't
+// enough memory for the map.
+bool ftl_init(uint32_t flash_size);
+
+// The number of filesystem blocks available. Zero if ftl_init failed.
+uint32_t ftl_block_count(void);
+
+bool ftl_read_block(uint8_t* dest, uint32_t block);
+bool ftl_write_block(const uint8_t* data, uint32_t block);
+
+// Reclaims sectors full of stale blocks before a write has to wait for it.
+void ftl_background(void);
+
+// Raw flash access provided by external_flash.c.
+bool external_flash_read(uint32_t address, uint8_t* data, uint32_t length);
+bool external_flash_program(uint32_t address, const uint8_t* data, uint32_t length);
+bool external_flash_erase(uint32_t sector_address);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_SHARED_EXTERNAL_FLASH_FTL_H
@@ -131,6 +131,10 @@ bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t data_length)
     return status;
 }
 
+const uint8_t* spi_flash_memory_map(uint32_t address, uint32_t data_length) {
+    return NULL;
+}
+
 void spi_flash_init(void) {
     cs_pin.base.type = &digitalio_digitalinout_type;
     common_hal_digitalio_digitalinout_construct(&cs_pin, SPI_FLASH_CS_PIN);
@@ -34,19 +34,38 @@
 
 #include "supervisor/flash.h"
 
+#if CIRCUITPY_DATA_PARTITION_SIZE > 0
+#include "extmod/vfs_lfs.h"
+#endif
+
 static mp_vfs_mount_t _mp_vfs;
 static fs_user_mount_t _internal_vfs;
 
+#if CIRCUITPY_DATA_PARTITION_SIZE > 0
+static mp_vfs_mount_t _data_mp_vfs;
+static mp_obj_vfs_lfs_t _data_vfs;
+
+static const vfs_lfs_block_device_t data_partition = {
+    .block_size = SPI_FLASH_ERASE_SIZE,
+    .block_count = supervisor_flash_data_partition_sector_count,
+    .read = supervisor_flash_data_partition_read,
+    .program = supervisor_flash_data_partition_program,
+    .erase = supervisor_flash_data_partition_erase,
+};
+#endif
+
 static volatile uint32_t filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
 volatile bool filesystem_flush_requested = false;
 
 void filesystem_background(void) {
     if (filesystem_flush_requested) {
         filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
-        // Flush but keep caches
-        supervisor_flash_flush();
+        // Flush but keep caches, a bit at a time so that the rest of the
+        // background tasks aren't held up.
+        supervisor_flash_start_flush();
         filesystem_flush_requested = false;
     }
+    supervisor_flash_background();
 }
 
 inline void filesystem_tick(void) {
@@ -114,6 +133,24 @@ void filesystem_init(bool create_allowed, bool force_create) {
     // The current directory is used as the boot up directory.
     // It is set to the internal flash filesystem by default.
     MP_STATE_PORT(vfs_cur) = vfs;
+
+    #if CIRCUITPY_DATA_PARTITION_SIZE > 0
+    // littlefs on the data partition isn't shared over USB so only the
+    // supervisor ever writes to it. Paths are matched against mounts in order
+    // so it goes in front of CIRCUITPY at /.
+    if (vfs_lfs_init(&_data_vfs, &data_partition, create_allowed) == LFS_ERR_OK) {
+        mp_vfs_mount_t *data_vfs = &_data_mp_vfs;
+        data_vfs->str = "/data";
+        data_vfs->len = 5;
+        data_vfs->obj = MP_OBJ_FROM_PTR(&_data_vfs);
+        data_vfs->next = vfs;
+        MP_STATE_VM(vfs_mount_table) = data_vfs;
+    }
+    #endif
+}
+
+fs_user_mount_t *filesystem_circuitpy(void) {
+    return &_internal_vfs;
 }
 
 void filesystem_flush(void) {
@@ -27,12 +27,25 @@
 #include "supervisor/memory.h"
 
 #include <stddef.h>
+#include <string.h>
 
 #include "supervisor/shared/display.h"
 
-#define CIRCUITPY_SUPERVISOR_ALLOC_COUNT 8
+// Allocations are made from two stacks: one grows up from the end of static
+// memory and the other grows down from the top of the stack. Memory freed
+// in the middle of either stack is reused by later allocations on the same
+// side that fit, and movable allocations are slid over it by
+// supervisor_move_memory() so that it can be given back to the middle.
+
+#ifndef CIRCUITPY_SUPERVISOR_ALLOC_COUNT
+#define CIRCUITPY_SUPERVISOR_ALLOC_COUNT 12
+#endif
+
+#define ALLOCATION_HIGH (1)
+#define ALLOCATION_MOVABLE (2)
 
 static supervisor_allocation allocations[CIRCUITPY_SUPERVISOR_ALLOC_COUNT];
+static uint8_t allocation_flags[CIRCUITPY_SUPERVISOR_ALLOC_COUNT];
 // We use uint32_t* to ensure word (4 byte) alignment.
 uint32_t* low_address;
 uint32_t* high_address;
@@ -44,6 +57,68 @@ void memory_init(void) {
     high_address = &_estack;
 }
 
+static bool is_high(size_t index) {
+    return (allocation_flags[index] & ALLOCATION_HIGH) != 0;
+}
+
+// Move the edges of the two stacks in as far as the allocations allow.
+static void update_bounds(void) {
+    low_address = &_ebss;
+    high_address = &_estack;
+    for (size_t i = 0; i < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; i++) {
+        supervisor_allocation* alloc = &allocations[i];
+        if (alloc->ptr == NULL) {
+            continue;
+        }
+        if (is_high(i)) {
+            if (alloc->ptr < high_address) {
+                high_address = alloc->ptr;
+            }
+        } else if (alloc->ptr + alloc->length / 4 > low_address) {
+            low_address = alloc->ptr + alloc->length / 4;
+        }
+    }
+}
+
+// Returns the start of the next allocation on the given side at or after
+// ptr, or the end of that side's stack.
+static uint32_t* next_allocation(uint32_t* ptr, bool high) {
+    uint32_t* next = high ? &_estack : low_address;
+    for (size_t i = 0; i < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; i++) {
+        uint32_t* p = allocations[i].ptr;
+        if (p != NULL && is_high(i) == high && p >= ptr && p < next) {
+            next = p;
+        }
+    }
+    return next;
+}
+
+// Find the smallest piece of freed memory inside a stack that fits length.
+static uint32_t* find_hole(uint32_t length, bool high) {
+    uint32_t* best = NULL;
+    uint32_t best_length = 0;
+    uint32_t* start = high ? high_address : &_ebss;
+    for (int32_t i = -1; i < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; i++) {
+        uint32_t* hole = start;
+        if (i >= 0) {
+            if (allocations[i].ptr == NULL || is_high(i) != high) {
+                continue;
+            }
+            hole = allocations[i].ptr + allocations[i].length / 4;
+        }
+        uint32_t hole_length = (next_allocation(hole, high) - hole) * 4;
+        if (hole_length >= length && (best == NULL || hole_length < best_length)) {
+            best = hole;
+            best_length = hole_length;
+        }
+    }
+    if (best != NULL && high) {
+        // Keep to the top of the hole.
+        best += (best_length - length) / 4;
+    }
+    return best;
+}
+
 void free_memory(supervisor_allocation* allocation) {
     int32_t index = 0;
     bool found = false;
@@ -56,48 +131,25 @@ void free_memory(supervisor_allocation* allocation) {
     if (!found) {
         // Bad!
         // TODO(tannewt): Add a way to escape into safe mode on error.
-    }
-    if (allocation->ptr == high_address) {
-        high_address += allocation->length / 4;
-        for (index++; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index++) {
-            if (allocations[index].ptr != NULL) {
-                break;
-            }
-            high_address += allocations[index].length / 4;
-        }
-    } else if (allocation->ptr + allocation->length / 4 == low_address) {
-        low_address = allocation->ptr;
-        for (index--; index >= 0; index--) {
-            if (allocations[index].ptr != NULL) {
-                break;
-            }
-            low_address -= allocations[index].length / 4;
-        }
-    } else {
-        // Freed memory isn't in the middle so skip updating bounds. The memory will be added to the
-        // middle when the memory to the inside is freed.
+        return;
     }
     allocation->ptr = NULL;
+    update_bounds();
 }
 
 supervisor_allocation* allocate_remaining_memory(void) {
     if (low_address == high_address) {
         return NULL;
     }
-    return allocate_memory((high_address - low_address) * 4, false);
+    return allocate_memory((high_address - low_address) * 4, false, false);
 }
 
-supervisor_allocation* allocate_memory(uint32_t length, bool high) {
-    if ((high_address - low_address) * 4 < (int32_t) length || length % 4 != 0) {
+supervisor_allocation* allocate_memory(uint32_t length, bool high, bool movable) {
+    if (length == 0 || length % 4 != 0) {
         return NULL;
     }
     uint8_t index = 0;
-    int8_t direction = 1;
-    if (high) {
-        index = CIRCUITPY_SUPERVISOR_ALLOC_COUNT - 1;
-        direction = -1;
-    }
-    for (; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index += direction) {
+    for (; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index++) {
         if (allocations[index].ptr == NULL) {
             break;
         }
@@ -105,18 +157,131 @@ supervisor_allocation* allocate_memory(uint32_t length, bool high) {
     if (index >= CIRCUITPY_SUPERVISOR_ALLOC_COUNT) {
         return NULL;
     }
-    supervisor_allocation* alloc = &allocations[index];
-    if (high) {
-        high_address -= length / 4;
-        alloc->ptr = high_address;
-    } else {
-        alloc->ptr = low_address;
-        low_address += length / 4;
+    uint32_t* ptr = find_hole(length, high);
+    if (ptr == NULL) {
+        if ((uint32_t) (high_address - low_address) * 4 < length) {
+            return NULL;
+        }
+        ptr = high ? high_address - length / 4 : low_address;
     }
+    supervisor_allocation* alloc = &allocations[index];
+    alloc->ptr = ptr;
     alloc->length = length;
+    allocation_flags[index] = (high ? ALLOCATION_HIGH : 0) | (movable ? ALLOCATION_MOVABLE : 0);
+    update_bounds();
+    return alloc;
+}
+
+supervisor_allocation* allocate_largest_hole(uint32_t min_length) {
+    uint32_t* best = NULL;
+    uint32_t best_length = 0;
+    bool best_high = false;
+    for (int32_t i = -1; i < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; i++) {
+        for (uint8_t high = 0; high < 2; high++) {
+            uint32_t* hole = high ? high_address : &_ebss;
+            if (i >= 0) {
+                if (allocations[i].ptr == NULL || is_high(i) != high) {
+                    continue;
+                }
+                hole = allocations[i].ptr + allocations[i].length / 4;
+            }
+            uint32_t hole_length = (next_allocation(hole, high) - hole) * 4;
+            if (hole_length >= min_length && hole_length > best_length) {
+                best = hole;
+                best_length = hole_length;
+                best_high = high;
+            }
+        }
+    }
+    if (best == NULL) {
+        return NULL;
+    }
+    uint8_t index = 0;
+    for (; index < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; index++) {
+        if (allocations[index].ptr == NULL) {
+            break;
+        }
+    }
+    if (index >= CIRCUITPY_SUPERVISOR_ALLOC_COUNT) {
+        return NULL;
+    }
+    supervisor_allocation* alloc = &allocations[index];
+    alloc->ptr = best;
+    alloc->length = best_length;
+    allocation_flags[index] = best_high ? ALLOCATION_HIGH : 0;
+    update_bounds();
     return alloc;
 }
 
+supervisor_allocation* allocate_dma_memory(uint32_t length) {
+    return allocate_memory((length + 3) & ~3, false, false);
+}
+
+void supervisor_memory_stats(supervisor_memory_stats_t* stats) {
+    stats->total = (&_estack - &_ebss) * 4;
+    stats->used = 0;
+    stats->count = 0;
+    for (size_t i = 0; i < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; i++) {
+        if (allocations[i].ptr != NULL) {
+            stats->used += allocations[i].length;
+            stats->count++;
+        }
+    }
+    stats->free = (high_address - low_address) * 4;
+    stats->holes = stats->total - stats->used - stats->free;
+    stats->largest_free = stats->free;
+    for (int32_t i = -1; i < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; i++) {
+        for (uint8_t high = 0; high < 2; high++) {
+            uint32_t* hole = high ? high_address : &_ebss;
+            if (i >= 0) {
+                if (allocations[i].ptr == NULL || is_high(i) != high) {
+                    continue;
+                }
+                hole = allocations[i].ptr + allocations[i].length / 4;
+            }
+            uint32_t hole_length = (next_allocation(hole, high) - hole) * 4;
+            if (hole_length > stats->largest_free) {
+                stats->largest_free = hole_length;
+            }
+        }
+    }
+}
+
+// Slide the movable allocations on one side over the holes next to them.
+static void compact(bool high) {
+    uint32_t* cursor = high ? &_estack : &_ebss;
+    for (;;) {
+        // Find the nearest allocation to the cursor that hasn't been placed.
+        int32_t next = -1;
+        for (int32_t i = 0; i < CIRCUITPY_SUPERVISOR_ALLOC_COUNT; i++) {
+            uint32_t* p = allocations[i].ptr;
+            if (p == NULL || is_high(i) != high) {
+                continue;
+            }
+            if (high ? (p + allocations[i].length / 4 <= cursor &&
+                        (next < 0 || p > allocations[next].ptr))
+                     : (p >= cursor && (next < 0 || p < allocations[next].ptr))) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+        supervisor_allocation* alloc = &allocations[next];
+        if ((allocation_flags[next] & ALLOCATION_MOVABLE) != 0) {
+            uint32_t* to = high ? cursor - alloc->length / 4 : cursor;
+            if (to != alloc->ptr) {
+                memmove(to, alloc->ptr, alloc->length);
+                alloc->ptr = to;
+            }
+        }
+        cursor = high ? alloc->ptr : alloc->ptr + alloc->length / 4;
+    }
+}
+
 void supervisor_move_memory(void) {
+    compact(false);
+    compact(true);
+    update_bounds();
     supervisor_display_move_memory();
 }
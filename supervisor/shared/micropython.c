@@ -29,10 +29,41 @@
 #include "supervisor/serial.h"
 #include "lib/oofatfs/ff.h"
 #include "py/mpconfig.h"
+#include "supervisor/port.h"
 
 #include "supervisor/shared/status_leds.h"
 
+// Console output is collected here and written to each sink at once, so that the separators,
+// values and newline of one print() don't each go through USB, the terminal and boot_out.txt.
+// It's written out at each newline, when full, before waiting for input and from the
+// background tasks.
+#define STDOUT_BUFFER_SIZE (128)
+static char stdout_buffer[STDOUT_BUFFER_SIZE];
+static size_t stdout_buffered = 0;
+
+static void write_stdout(const char *str, size_t len) {
+    toggle_tx_led();
+
+    #ifdef CIRCUITPY_BOOT_OUTPUT_FILE
+    if (boot_output_file != NULL) {
+        UINT bytes_written = 0;
+        f_write(boot_output_file, str, len, &bytes_written);
+    }
+    #endif
+
+    serial_write_substring(str, len);
+}
+
+void mp_hal_stdout_flush(void) {
+    if (stdout_buffered == 0) {
+        return;
+    }
+    write_stdout(stdout_buffer, stdout_buffered);
+    stdout_buffered = 0;
+}
+
 int mp_hal_stdin_rx_chr(void) {
+    mp_hal_stdout_flush();
     for (;;) {
         #ifdef MICROPY_VM_HOOK_LOOP
             MICROPY_VM_HOOK_LOOP
@@ -41,18 +72,21 @@ int mp_hal_stdin_rx_chr(void) {
             toggle_rx_led();
             return serial_read();
         }
+        port_sleep_until_interrupt();
     }
 }
 
 void mp_hal_stdout_tx_strn(const char *str, size_t len) {
-    toggle_tx_led();
-
-    #ifdef CIRCUITPY_BOOT_OUTPUT_FILE
-    if (boot_output_file != NULL) {
-        UINT bytes_written = 0;
-        f_write(boot_output_file, str, len, &bytes_written);
+    if (stdout_buffered + len > STDOUT_BUFFER_SIZE) {
+        mp_hal_stdout_flush();
+        if (len > STDOUT_BUFFER_SIZE) {
+            write_stdout(str, len);
+            return;
+        }
+    }
+    memcpy(stdout_buffer + stdout_buffered, str, len);
+    stdout_buffered += len;
+    if (memchr(str, '\n', len) != NULL) {
+        mp_hal_stdout_flush();
     }
-    #endif
-
-    serial_write_substring(str, len);
 }
@@ -0,0 +1,63 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "supervisor/shared/performance.h"
+
+#include "supervisor/port.h"
+
+static mcu_performance_t base_level = PERFORMANCE_BOOST;
+static uint8_t boosts = 0;
+
+static void update_performance(void) {
+    port_set_performance(boosts > 0 ? PERFORMANCE_BOOST : base_level);
+}
+
+void supervisor_performance_set_level(mcu_performance_t level) {
+    base_level = level;
+    update_performance();
+}
+
+mcu_performance_t supervisor_performance_get_level(void) {
+    return base_level;
+}
+
+void supervisor_performance_boost(void) {
+    if (boosts++ == 0) {
+        update_performance();
+    }
+}
+
+void supervisor_performance_unboost(void) {
+    if (boosts > 0 && --boosts == 0) {
+        update_performance();
+    }
+}
+
+void supervisor_performance_reset(void) {
+    base_level = PERFORMANCE_BOOST;
+    boosts = 0;
+    update_performance();
+}
@@ -0,0 +1,44 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SUPERVISOR_SHARED_PERFORMANCE_H
+#define MICROPY_INCLUDED_SUPERVISOR_SHARED_PERFORMANCE_H
+
+#include "shared-bindings/microcontroller/Performance.h"
+
+// The level the CPU runs at while nothing is boosting it.
+void supervisor_performance_set_level(mcu_performance_t level);
+mcu_performance_t supervisor_performance_get_level(void);
+
+// Run at full speed between each boost and its matching unboost. Boosts nest. Work that takes
+// less than a tick finishes before the clock changes, so only longer work speeds up.
+void supervisor_performance_boost(void);
+void supervisor_performance_unboost(void);
+
+// Drop any boosts and go back to full speed, which is the default.
+void supervisor_performance_reset(void);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_SHARED_PERFORMANCE_H
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "supervisor/shared/profile.h"
+
+#include "py/obj.h"
+#include "py/mpprint.h"
+#include "shared-bindings/time/__init__.h"
+
+#define SUPERVISOR_PROFILE_MAX_ENTRIES (48)
+
+static supervisor_profile_entry_t entries[SUPERVISOR_PROFILE_MAX_ENTRIES];
+static size_t entry_count = 0;
+// Entries that didn't fit.
+static size_t dropped_count = 0;
+static uint64_t last_mark;
+
+uint64_t supervisor_profile_ticks(void) {
+    return common_hal_time_monotonic_ns();
+}
+
+void supervisor_profile_reset(void) {
+    entry_count = 0;
+    dropped_count = 0;
+    last_mark = supervisor_profile_ticks();
+}
+
+static void add_entry(const char* stage, const char* name, uint64_t start, uint64_t end) {
+    if (entry_count == SUPERVISOR_PROFILE_MAX_ENTRIES) {
+        dropped_count++;
+        return;
+    }
+    supervisor_profile_entry_t* entry = &entries[entry_count++];
+    entry->stage = stage;
+    strncpy(entry->name, name, SUPERVISOR_PROFILE_NAME_LENGTH - 1);
+    entry->name[SUPERVISOR_PROFILE_NAME_LENGTH - 1] = '\0';
+    entry->duration_us = (end - start) / 1000;
+}
+
+void supervisor_profile_mark(const char* stage) {
+    uint64_t now = supervisor_profile_ticks();
+    add_entry(stage, "", last_mark, now);
+    last_mark = now;
+}
+
+void supervisor_profile_add(const char* stage, qstr name, uint64_t start) {
+    add_entry(stage, qstr_str(name), start, supervisor_profile_ticks());
+}
+
+const supervisor_profile_entry_t* supervisor_profile_entries(size_t* count) {
+    *count = entry_count;
+    return entries;
+}
+
+void supervisor_profile_print(void) {
+    for (size_t i = 0; i < entry_count; i++) {
+        const supervisor_profile_entry_t* entry = &entries[i];
+        if (entry->name[0] == '\0') {
+            mp_printf(&mp_plat_print, "%s: %u us\n", entry->stage, (unsigned int) entry->duration_us);
+        } else {
+            mp_printf(&mp_plat_print, "%s %s: %u us\n", entry->stage, entry->name,
+                      (unsigned int) entry->duration_us);
+        }
+    }
+    if (dropped_count > 0) {
+        mp_printf(&mp_plat_print, "%u entries not recorded\n", (unsigned int) dropped_count);
+    }
+}
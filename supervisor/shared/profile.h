@@ -0,0 +1,59 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SUPERVISOR_SHARED_PROFILE_H
+#define MICROPY_INCLUDED_SUPERVISOR_SHARED_PROFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "py/qstr.h"
+
+// Longest module name kept. Names are copied because the qstrs of imported modules don't
+// outlive the VM that imported them.
+#define SUPERVISOR_PROFILE_NAME_LENGTH (24)
+
+typedef struct {
+    const char* stage;
+    char name[SUPERVISOR_PROFILE_NAME_LENGTH];
+    uint32_t duration_us;
+} supervisor_profile_entry_t;
+
+// Clears the recorded entries and starts timing the next phase.
+void supervisor_profile_reset(void);
+
+// Records the time since the last mark (or reset) as the given phase.
+void supervisor_profile_mark(const char* stage);
+
+// Records the time since start, as returned by supervisor_profile_ticks(), as a stage of
+// loading the named module.
+void supervisor_profile_add(const char* stage, qstr name, uint64_t start);
+uint64_t supervisor_profile_ticks(void);
+
+const supervisor_profile_entry_t* supervisor_profile_entries(size_t* count);
+void supervisor_profile_print(void);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_SHARED_PROFILE_H
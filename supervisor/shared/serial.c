@@ -60,7 +60,11 @@ void serial_write_substring(const char* text, uint32_t length) {
     uint32_t count = 0;
     while (count < length && tud_cdc_connected()) {
         count += tud_cdc_write(text + count, length - count);
-        usb_background();
+        // Only wait on USB when the FIFO is full. Whatever is left in it goes out with the next
+        // usb_background() so a run of small writes is sent as full packets.
+        if (count < length) {
+            usb_cdc_tx_service(0);
+        }
     }
 }
 
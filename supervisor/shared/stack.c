@@ -37,6 +37,14 @@ static uint32_t next_stack_size = CIRCUITPY_DEFAULT_STACK_SIZE;
 static uint32_t current_stack_size = 0;
 supervisor_allocation* stack_alloc = NULL;
 
+#if MICROPY_ENABLE_PYSTACK
+static uint32_t next_pystack_size = CIRCUITPY_DEFAULT_PYSTACK_SIZE;
+// The size pystack_alloc was last requested at. The allocation may be the
+// default size instead, or missing, when that didn't fit.
+static uint32_t requested_pystack_size = 0;
+supervisor_allocation* pystack_alloc = NULL;
+#endif
+
 #define EXCEPTION_STACK_SIZE 1024
 
 void allocate_stack(void) {
@@ -45,9 +53,9 @@ void allocate_stack(void) {
 
     mp_uint_t c_size = (uint32_t) &_estack - sp;
 
-    stack_alloc = allocate_memory(c_size + next_stack_size + EXCEPTION_STACK_SIZE, true);
+    stack_alloc = allocate_memory(c_size + next_stack_size + EXCEPTION_STACK_SIZE, true, false);
     if (stack_alloc == NULL) {
-        stack_alloc = allocate_memory(c_size + CIRCUITPY_DEFAULT_STACK_SIZE + EXCEPTION_STACK_SIZE, true);
+        stack_alloc = allocate_memory(c_size + CIRCUITPY_DEFAULT_STACK_SIZE + EXCEPTION_STACK_SIZE, true, false);
         current_stack_size = CIRCUITPY_DEFAULT_STACK_SIZE;
     } else {
         current_stack_size = next_stack_size;
@@ -55,6 +63,18 @@ void allocate_stack(void) {
     *stack_alloc->ptr = STACK_CANARY_VALUE;
 }
 
+#if MICROPY_ENABLE_PYSTACK
+// Python frames and call arguments live here instead of on the C stack or
+// the heap. It's only in use while the VM runs so it never needs to move.
+static void allocate_pystack(void) {
+    requested_pystack_size = next_pystack_size;
+    pystack_alloc = allocate_memory(next_pystack_size, false, false);
+    if (pystack_alloc == NULL) {
+        pystack_alloc = allocate_memory(CIRCUITPY_DEFAULT_PYSTACK_SIZE, false, false);
+    }
+}
+#endif
+
 inline bool stack_ok(void) {
     return stack_alloc == NULL || *stack_alloc->ptr == STACK_CANARY_VALUE;
 }
@@ -67,9 +87,20 @@ inline void assert_heap_ok(void) {
 
 void stack_init(void) {
     allocate_stack();
+    #if MICROPY_ENABLE_PYSTACK
+    allocate_pystack();
+    #endif
 }
 
 void stack_resize(void) {
+    #if MICROPY_ENABLE_PYSTACK
+    if (pystack_alloc == NULL) {
+        allocate_pystack();
+    } else if (next_pystack_size != requested_pystack_size) {
+        free_memory(pystack_alloc);
+        allocate_pystack();
+    }
+    #endif
     if (next_stack_size == current_stack_size) {
         *stack_alloc->ptr = STACK_CANARY_VALUE;
         return;
@@ -86,3 +117,12 @@ void set_next_stack_size(uint32_t size) {
 uint32_t get_current_stack_size(void) {
     return current_stack_size;
 }
+
+void set_next_pystack_size(uint32_t size) {
+    #if MICROPY_ENABLE_PYSTACK
+    // keep the Python stack aligned for mp_pystack_alloc
+    next_pystack_size = size & ~(MICROPY_PYSTACK_ALIGN - 1);
+    #else
+    (void) size;
+    #endif
+}
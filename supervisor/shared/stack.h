@@ -32,11 +32,14 @@
 #include "supervisor/memory.h"
 
 extern supervisor_allocation* stack_alloc;
+// The Python stack, when MICROPY_ENABLE_PYSTACK is set.
+extern supervisor_allocation* pystack_alloc;
 
 void stack_init(void);
 void stack_resize(void);
 void set_next_stack_size(uint32_t size);
 uint32_t get_current_stack_size(void);
+void set_next_pystack_size(uint32_t size);
 bool stack_ok(void);
 
 // Use this after any calls into a library which may use a lot of stack. This will raise a Python
@@ -0,0 +1,219 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <setjmp.h>
+#include <stdint.h>
+
+#include "py/gc.h"
+#include "py/mpstate.h"
+#include "py/mpthread.h"
+#include "py/runtime.h"
+
+#include "supervisor/shared/thread.h"
+
+#if MICROPY_PY_THREAD
+
+#ifndef CIRCUITPY_THREAD_STACK_SIZE
+#define CIRCUITPY_THREAD_STACK_SIZE (4096)
+#endif
+
+// Room left below the stack limit given to the VM so an overflow can still be raised.
+#define THREAD_STACK_MARGIN (256)
+
+typedef enum {
+    THREAD_NEW,
+    THREAD_RUNNING,
+    THREAD_FINISHED,
+} thread_status_t;
+
+typedef struct _thread_t {
+    struct _thread_t* next;
+    mp_state_thread_t* state;
+    void* (*entry)(void*);
+    void* arg;
+    // Threads other than the main one run on a stack allocated from the heap. Marking the
+    // thread marks its stack, which is then scanned like any other allocation.
+    uint32_t* stack;
+    size_t stack_words;
+    // Lowest address in use when the thread was switched out.
+    void* sp;
+    jmp_buf context;
+    thread_status_t status;
+} thread_t;
+
+// The main thread runs on the supervisor stack. It heads the list of threads, so it is also how
+// the collector finds the others.
+STATIC thread_t thread_main = {
+    .state = &mp_state_ctx.thread,
+    .status = THREAD_RUNNING,
+};
+STATIC thread_t* current = &thread_main;
+
+void mp_thread_init(void) {
+    thread_main.next = NULL;
+    current = &thread_main;
+}
+
+void mp_thread_deinit(void) {
+    // Threads still running are dropped along with the heap their stacks are on.
+    mp_thread_init();
+}
+
+mp_state_thread_t* mp_thread_get_state(void) {
+    return current->state;
+}
+
+void mp_thread_set_state(void* state) {
+    current->state = state;
+}
+
+STATIC void thread_switch(void);
+
+STATIC void thread_trampoline(void) {
+    thread_t* self = current;
+    self->entry(self->arg);
+    self->status = THREAD_FINISHED;
+    thread_switch();
+    // A finished thread is never switched back to.
+}
+
+STATIC void NORETURN thread_start_on_stack(uint32_t* stack_end) {
+    __asm volatile (
+        "mov sp, %0\n"
+        "blx %1\n"
+        :
+        : "r" (stack_end), "r" (thread_trampoline)
+        : "memory");
+    for (;;) {}
+}
+
+STATIC void thread_switch(void) {
+    thread_t* prev = current;
+    thread_t* next = prev->next == NULL ? &thread_main : prev->next;
+    if (next == prev) {
+        return;
+    }
+
+    if (prev->status == THREAD_FINISHED) {
+        // We're still on its stack but nothing allocates before the jump below.
+        thread_t* t = &thread_main;
+        while (t->next != prev) {
+            t = t->next;
+        }
+        t->next = prev->next;
+    } else {
+        volatile uint32_t here;
+        prev->sp = (void*) &here;
+        if (setjmp(prev->context) != 0) {
+            // Switched back to.
+            return;
+        }
+    }
+
+    current = next;
+    if (next->status == THREAD_NEW) {
+        next->status = THREAD_RUNNING;
+        thread_start_on_stack(next->stack + next->stack_words);
+    }
+    longjmp(next->context, 1);
+}
+
+void mp_thread_create(void* (*entry)(void*), void* arg, size_t* stack_size) {
+    if (*stack_size == 0) {
+        *stack_size = CIRCUITPY_THREAD_STACK_SIZE;
+    } else if (*stack_size < 2 * THREAD_STACK_MARGIN) {
+        *stack_size = 2 * THREAD_STACK_MARGIN;
+    }
+
+    thread_t* thread = m_new_obj(thread_t);
+    // Keep the stack 8 byte aligned as the ABI requires.
+    thread->stack_words = (*stack_size + 7) / 8 * 2;
+    thread->stack = m_new(uint32_t, thread->stack_words);
+    thread->entry = entry;
+    thread->arg = arg;
+    thread->state = NULL;
+    thread->status = THREAD_NEW;
+    *stack_size -= THREAD_STACK_MARGIN;
+
+    // Append so threads run in the order they were started.
+    thread_t* t = &thread_main;
+    while (t->next != NULL) {
+        t = t->next;
+    }
+    thread->next = NULL;
+    t->next = thread;
+}
+
+void mp_thread_start(void) {
+}
+
+void mp_thread_finish(void) {
+}
+
+void* mp_thread_gc_others(void* main_stack_end) {
+    // Marks every other thread, their stacks and their saved registers.
+    gc_collect_root((void**) &thread_main, sizeof(thread_t) / sizeof(void*));
+    if (current == &thread_main) {
+        return main_stack_end;
+    }
+    gc_collect_root((void**) thread_main.sp, ((uintptr_t) main_stack_end - (uintptr_t) thread_main.sp) / sizeof(void*));
+    return current->stack + current->stack_words;
+}
+
+bool mp_thread_yield(void) {
+    if (thread_main.next == NULL) {
+        return false;
+    }
+    MP_THREAD_GIL_EXIT();
+    MP_THREAD_GIL_ENTER();
+    return true;
+}
+
+void mp_thread_mutex_init(mp_thread_mutex_t* mutex) {
+    mutex->locked = false;
+}
+
+int mp_thread_mutex_lock(mp_thread_mutex_t* mutex, int wait) {
+    // Only another thread can release it so let them run until one does.
+    while (mutex->locked) {
+        if (!wait) {
+            return 0;
+        }
+        thread_switch();
+    }
+    mutex->locked = true;
+    return 1;
+}
+
+void mp_thread_mutex_unlock(mp_thread_mutex_t* mutex) {
+    mutex->locked = false;
+    // Releasing the GIL is when another thread gets to run.
+    if (mutex == &MP_STATE_VM(gil_mutex)) {
+        thread_switch();
+    }
+}
+
+#endif // MICROPY_PY_THREAD
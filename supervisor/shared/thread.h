@@ -0,0 +1,50 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MICROPY_INCLUDED_SUPERVISOR_SHARED_THREAD_H
+#define MICROPY_INCLUDED_SUPERVISOR_SHARED_THREAD_H
+
+#include <stdbool.h>
+
+// This is the mpthreadport.h for the Cortex-M ports. Threads are cooperative: the running thread
+// only changes when the GIL is released, which the VM does every
+// MICROPY_PY_THREAD_GIL_VM_DIVISOR jumps.
+
+typedef struct _mp_thread_mutex_t {
+    volatile bool locked;
+} mp_thread_mutex_t;
+
+void mp_thread_init(void);
+void mp_thread_deinit(void);
+
+// Scans the stacks and saved registers of the threads that aren't running. Returns the end of the
+// running thread's stack, given the end of the main stack.
+void* mp_thread_gc_others(void* main_stack_end);
+
+// Lets the other threads run. Returns false right away if there aren't any.
+bool mp_thread_yield(void);
+
+#endif  // MICROPY_INCLUDED_SUPERVISOR_SHARED_THREAD_H
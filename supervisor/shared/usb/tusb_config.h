@@ -72,7 +72,7 @@
 #define CFG_TUD_DESC_AUTO           0
 
 //------------- CLASS -------------//
-#define CFG_TUD_CDC                 1
+#define CFG_TUD_CDC                 USB_CDC_NUM_INTERFACES
 #define CFG_TUD_MSC                 1
 #define CFG_TUD_HID                 1
 #define CFG_TUD_MIDI                1
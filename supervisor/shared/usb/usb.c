@@ -26,6 +26,7 @@
 
 #include "tick.h"
 #include "shared-bindings/microcontroller/Processor.h"
+#include "shared-module/usb_hid/Device.h"
 #include "shared-module/usb_midi/__init__.h"
 #include "supervisor/port.h"
 #include "supervisor/usb.h"
@@ -79,9 +80,21 @@ void usb_background(void) {
     if (usb_enabled()) {
         tud_task();
         tud_cdc_write_flush();
+#if CIRCUITPY_USB_CDC_DATA
+        tud_cdc_n_write_flush(1);
+#endif
+        usb_msc_background();
+#if CIRCUITPY_USB_HID
+        usb_hid_background();
+#endif
     }
 }
 
+void usb_cdc_tx_service(uint8_t itf) {
+    tud_cdc_n_write_flush(itf);
+    tud_task();
+}
+
 //--------------------------------------------------------------------+
 // tinyusb callbacks
 //--------------------------------------------------------------------+
@@ -107,7 +120,10 @@ void tud_resume_cb(void) {
 // Invoked when cdc when line state changed e.g connected/disconnected
 // Use to reset to DFU when disconnect with 1200 bps
 void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts) {
-    (void) itf; // interface ID, not used
+    // Only the REPL interface resets to the bootloader. usb_cdc.data is left alone.
+    if ( itf != 0 ) {
+        return;
+    }
 
     // DTR = false is counted as disconnected
     if ( !dtr )
@@ -131,7 +147,10 @@ void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts) {
  */
 void tud_cdc_rx_wanted_cb(uint8_t itf, char wanted_char)
 {
-    (void) itf; // not used
+    // Ctrl-C only interrupts from the REPL. It is ordinary data on usb_cdc.data.
+    if ( itf != 0 ) {
+        return;
+    }
 
     // Workaround for using lib/utils/interrupt_char.c
     // Compare mp_interrupt_char with wanted_char and ignore if not matched
@@ -36,11 +36,212 @@
 
 #include "supervisor/filesystem.h"
 #include "supervisor/shared/autoreload.h"
+#include "supervisor/usb.h"
+#include "tick.h"
 
 #define MSC_FLASH_BLOCK_SIZE    512
 
+// Boards with a small MSC buffer are also short on ram so skip reading ahead.
+#ifndef USB_MSC_READ_AHEAD
+#define USB_MSC_READ_AHEAD (CFG_TUD_MSC_BUFSIZE > 512)
+#endif
+
+// Work out which files a write changed so that saving anything other than a
+// .py or .mpy file doesn't reload. The old copy of each directory sector is
+// read into the read ahead buffer, which every write invalidates anyway, so
+// this needs read ahead too.
+#ifndef USB_MSC_RELOAD_ON_CODE_ONLY
+#define USB_MSC_RELOAD_ON_CODE_ONLY (USB_MSC_READ_AHEAD)
+#endif
+
+// A burst of transfers ends once the host has been quiet this long.
+#define MSC_BURST_GAP_MS (100)
+
 static bool ejected[1];
 
+typedef struct {
+    uint64_t start;
+    uint64_t last;
+    uint32_t bytes;
+    // Bytes per second over the last finished burst.
+    uint32_t rate;
+} msc_burst_t;
+
+static msc_burst_t read_burst;
+static msc_burst_t write_burst;
+
+#if USB_MSC_READ_AHEAD
+// The blocks after the last ones read, fetched while the host receives those.
+static uint8_t read_ahead_buffer[CFG_TUD_MSC_BUFSIZE];
+static uint32_t read_ahead_lba;
+static uint32_t read_ahead_count;
+// Blocks to fetch from usb_msc_background(). Zero when there is nothing to do.
+static uint32_t read_ahead_wanted;
+// One past the last block read, to spot the host streaming through a file.
+static uint32_t next_read_lba;
+#endif
+
+// AUTORELOAD_CHANGED_* flags for the current write command.
+static uint8_t write_changes;
+
+#if USB_MSC_RELOAD_ON_CODE_ONLY
+#define DIR_ENTRY_SIZE (32)
+#define DIR_ATTR_LFN (0x0f)
+
+static bool dir_entry_is_free(const uint8_t* entry) {
+    for (size_t i = 0; i < DIR_ENTRY_SIZE; i++) {
+        if (entry[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that every entry in a sector is plausible so that ordinary file data
+// is almost never mistaken for a directory.
+static bool sector_is_directory(const uint8_t* sector) {
+    for (size_t offset = 0; offset < MSC_FLASH_BLOCK_SIZE; offset += DIR_ENTRY_SIZE) {
+        const uint8_t* entry = sector + offset;
+        uint8_t attr = entry[11];
+        if (entry[0] == 0) {
+            if (!dir_entry_is_free(entry)) {
+                return false;
+            }
+        } else if (entry[0] == 0xe5) {
+            // Deleted entries keep their old contents.
+            continue;
+        } else if (attr == DIR_ATTR_LFN) {
+            // Long name entries always have a zero type and start cluster.
+            if (entry[12] != 0 || entry[26] != 0 || entry[27] != 0) {
+                return false;
+            }
+        } else {
+            if ((attr & 0xc0) != 0 || (entry[12] & ~0x18) != 0) {
+                return false;
+            }
+            for (size_t i = 0; i < 11; i++) {
+                uint8_t c = entry[i];
+                if ((c < 0x20 && !(i == 0 && c == 0x05)) || (c >= 'a' && c <= 'z') ||
+                    (c == '.' && entry[0] != '.')) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Text files main.c runs or reads like code. Short names are space padded.
+static const char* const code_txt_names[] = {
+    "CODE    TXT",
+    "MAIN    TXT",
+    "BOOT    TXT",
+    "SETTINGSTXT",
+};
+
+// True for a live short name entry of a .py or .mpy file, or one of the text
+// files above. Hidden files such as the ._code.py files macOS writes are
+// skipped when their long name entry is in the same sector.
+static bool dir_entry_is_code(const uint8_t* sector, size_t offset) {
+    const uint8_t* entry = sector + offset;
+    if (entry[0] == 0 || entry[0] == 0xe5 || (entry[11] & 0x18) != 0 || entry[11] == DIR_ATTR_LFN) {
+        return false;
+    }
+    bool code = memcmp(entry + 8, "PY ", 3) == 0 || memcmp(entry + 8, "MPY", 3) == 0;
+    for (size_t i = 0; !code && i < MP_ARRAY_SIZE(code_txt_names); i++) {
+        code = memcmp(entry, code_txt_names[i], 11) == 0;
+    }
+    if (!code) {
+        return false;
+    }
+    if (offset > 0) {
+        const uint8_t* long_name = entry - DIR_ENTRY_SIZE;
+        if (long_name[11] == DIR_ATTR_LFN && (long_name[0] & 0x3f) == 1 &&
+            long_name[1] == '.' && long_name[2] == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Compares a directory sector before and after a write, ignoring the last
+// access date that some hosts update when they only read a file.
+static uint8_t directory_changes(const uint8_t* old_sector, const uint8_t* new_sector) {
+    bool old_is_directory = sector_is_directory(old_sector);
+    uint8_t changes = 0;
+    for (size_t offset = 0; offset < MSC_FLASH_BLOCK_SIZE; offset += DIR_ENTRY_SIZE) {
+        const uint8_t* old_entry = old_sector + offset;
+        const uint8_t* new_entry = new_sector + offset;
+        if (memcmp(old_entry, new_entry, 18) == 0 &&
+            memcmp(old_entry + 20, new_entry + 20, DIR_ENTRY_SIZE - 20) == 0) {
+            continue;
+        }
+        if (dir_entry_is_code(new_sector, offset) ||
+            (old_is_directory && dir_entry_is_code(old_sector, offset))) {
+            return AUTORELOAD_CHANGED_CODE;
+        }
+        changes = AUTORELOAD_CHANGED_OTHER;
+    }
+    return changes;
+}
+
+// Works out what the blocks about to be written change. Writes to the FAT
+// itself don't count since every save also changes a directory entry.
+static uint8_t write_changes_for_blocks(fs_user_mount_t* vfs, uint32_t lba, const uint8_t* buffer, uint32_t block_count) {
+    FATFS* fatfs = &vfs->fatfs;
+    uint8_t changes = 0;
+    for (uint32_t i = 0; i < block_count; i++) {
+        uint32_t block = lba + i;
+        const uint8_t* new_sector = buffer + i * MSC_FLASH_BLOCK_SIZE;
+        // FAT12 and FAT16 keep the root directory in its own region before the
+        // data. Anywhere else we have to go by what the sector looks like.
+        bool root_region = fatfs->fs_type != FS_FAT32 &&
+            block >= fatfs->dirbase && block < fatfs->database;
+        if (block < fatfs->database && !root_region) {
+            continue;
+        }
+        if (!root_region && !sector_is_directory(new_sector)) {
+            changes |= AUTORELOAD_CHANGED_DATA;
+        } else if (disk_read(vfs, read_ahead_buffer, block, 1) != RES_OK) {
+            changes |= AUTORELOAD_CHANGED_CODE;
+        } else {
+            changes |= directory_changes(read_ahead_buffer, new_sector);
+        }
+    }
+    return changes;
+}
+#endif
+
+static void finish_burst(msc_burst_t* burst, bool force) {
+    if (burst->bytes == 0 || (!force && ticks_ms - burst->last < MSC_BURST_GAP_MS)) {
+        return;
+    }
+    uint32_t duration = burst->last - burst->start;
+    if (duration > 0) {
+        burst->rate = (uint64_t) burst->bytes * 1000 / duration;
+    }
+    burst->bytes = 0;
+}
+
+static void start_transfer(msc_burst_t* burst) {
+    finish_burst(burst, false);
+    if (burst->bytes == 0) {
+        burst->start = ticks_ms;
+    }
+}
+
+static void end_transfer(msc_burst_t* burst, uint32_t bytes) {
+    burst->bytes += bytes;
+    burst->last = ticks_ms;
+}
+
+void usb_msc_throughput(uint32_t* read_rate, uint32_t* write_rate) {
+    finish_burst(&read_burst, false);
+    finish_burst(&write_burst, false);
+    *read_rate = read_burst.rate;
+    *write_rate = write_burst.rate;
+}
+
 // The root FS is always at the end of the list.
 static fs_user_mount_t* get_vfs(int lun) {
     // TODO(tannewt): Return the mount which matches the lun where 0 is the end
@@ -164,7 +365,27 @@ int32_t tud_msc_read10_cb (uint8_t lun, uint32_t lba, uint32_t offset, void* buf
     const uint32_t block_count = bufsize / MSC_FLASH_BLOCK_SIZE;
 
     fs_user_mount_t * vfs = get_vfs(lun);
-    disk_read(vfs, buffer, lba, block_count);
+    start_transfer(&read_burst);
+    #if USB_MSC_READ_AHEAD
+    read_ahead_wanted = 0;
+    if (read_ahead_count >= block_count && read_ahead_lba == lba) {
+        memcpy(buffer, read_ahead_buffer, block_count * MSC_FLASH_BLOCK_SIZE);
+    } else
+    #endif
+    {
+        disk_read(vfs, buffer, lba, block_count);
+    }
+    #if USB_MSC_READ_AHEAD
+    read_ahead_count = 0;
+    // Only read ahead while the host streams through blocks in order and the
+    // VM can't change them in the meantime.
+    if (lba == next_read_lba && !filesystem_is_writable_by_python(vfs)) {
+        read_ahead_lba = lba + block_count;
+        read_ahead_wanted = block_count;
+    }
+    next_read_lba = lba + block_count;
+    #endif
+    end_transfer(&read_burst, block_count * MSC_FLASH_BLOCK_SIZE);
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
 }
@@ -178,7 +399,19 @@ int32_t tud_msc_write10_cb (uint8_t lun, uint32_t lba, uint32_t offset, uint8_t*
     const uint32_t block_count = bufsize / MSC_FLASH_BLOCK_SIZE;
 
     fs_user_mount_t * vfs = get_vfs(lun);
+    #if USB_MSC_READ_AHEAD
+    read_ahead_count = 0;
+    read_ahead_wanted = 0;
+    #endif
+    #if USB_MSC_RELOAD_ON_CODE_ONLY
+    write_changes |= write_changes_for_blocks(vfs, lba, buffer, block_count);
+    #else
+    write_changes = AUTORELOAD_CHANGED_CODE;
+    #endif
+    // The blocks land in the flash cache and are written out in the background.
+    start_transfer(&write_burst);
     disk_write(vfs, buffer, lba, block_count);
+    end_transfer(&write_burst, block_count * MSC_FLASH_BLOCK_SIZE);
     // Since by getting here we assume the mount is read-only to
     // MicroPython let's update the cached FatFs sector if it's the one
     // we just wrote.
@@ -204,5 +437,19 @@ void tud_msc_write10_complete_cb (uint8_t lun) {
     (void) lun;
 
     // This write is complete, start the autoreload clock.
-    autoreload_start();
+    autoreload_start_for_changes(write_changes);
+    write_changes = 0;
+}
+
+void usb_msc_background(void) {
+    #if USB_MSC_READ_AHEAD
+    if (read_ahead_wanted == 0) {
+        return;
+    }
+    fs_user_mount_t* vfs = get_vfs(0);
+    if (vfs != NULL && disk_read(vfs, read_ahead_buffer, read_ahead_lba, read_ahead_wanted) == RES_OK) {
+        read_ahead_count = read_ahead_wanted;
+    }
+    read_ahead_wanted = 0;
+    #endif
 }
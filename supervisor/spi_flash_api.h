@@ -39,6 +39,10 @@ bool spi_flash_write_command(uint8_t command, uint8_t* data, uint32_t length);
 bool spi_flash_sector_command(uint8_t command, uint32_t address);
 bool spi_flash_write_data(uint32_t address, uint8_t* data, uint32_t data_length);
 bool spi_flash_read_data(uint32_t address, uint8_t* data, uint32_t data_length);
+// Returns a pointer through which data_length bytes of flash starting at address can be read
+// directly, or NULL when the flash can't be memory mapped. The pointer is only valid until the
+// next call to one of the other functions here.
+const uint8_t* spi_flash_memory_map(uint32_t address, uint32_t data_length);
 void spi_flash_init(void);
 void spi_flash_init_device(const external_flash_device* device);
 
@@ -46,3 +46,7 @@ void set_next_stack_size(uint32_t size) {
 uint32_t get_current_stack_size(void) {
     return 0;
 }
+
+void set_next_pystack_size(uint32_t size) {
+    (void) size;
+}
@@ -6,12 +6,21 @@ SRC_SUPERVISOR = \
 	supervisor/shared/filesystem.c \
 	supervisor/shared/flash.c \
 	supervisor/shared/micropython.c \
+	supervisor/shared/performance.c \
 	supervisor/shared/rgb_led_status.c \
 	supervisor/shared/safe_mode.c \
 	supervisor/shared/stack.c \
 	supervisor/shared/status_leds.c \
 	supervisor/shared/translate.c
 
+ifeq ($(CIRCUITPY_STARTUP_PROFILE),1)
+	SRC_SUPERVISOR += supervisor/shared/profile.c
+endif
+
+ifeq ($(CIRCUITPY_THREAD),1)
+	SRC_SUPERVISOR += supervisor/shared/thread.c
+endif
+
 ifndef $(NO_USB)
 NO_USB = $(wildcard supervisor/usb.c)
 endif
@@ -36,6 +45,17 @@ ifdef EXTERNAL_FLASH_DEVICES
 				-DEXTERNAL_FLASH_DEVICE_COUNT=$(EXTERNAL_FLASH_DEVICE_COUNT)
 
 	SRC_SUPERVISOR += supervisor/shared/external_flash/external_flash.c
+	ifeq ($(CIRCUITPY_EXTERNAL_FLASH_FTL),1)
+		CFLAGS += -DCIRCUITPY_EXTERNAL_FLASH_FTL=1
+		SRC_SUPERVISOR += supervisor/shared/external_flash/ftl.c
+	endif
+	# Bytes at the end of the flash for a littlefs filesystem at /data that
+	# isn't shared over USB.
+	ifneq ($(CIRCUITPY_DATA_PARTITION_SIZE),)
+		CFLAGS += -DCIRCUITPY_DATA_PARTITION_SIZE=$(CIRCUITPY_DATA_PARTITION_SIZE) -DMICROPY_VFS_LFS=1 \
+				-DLFS_NO_MALLOC -DLFS_NO_DEBUG -DLFS_NO_WARN -DLFS_NO_ERROR -DLFS_NO_ASSERT
+		SRC_SUPERVISOR += lib/littlefs/lfs.c lib/littlefs/lfs_util.c
+	endif
 	ifeq ($(SPI_FLASH_FILESYSTEM),1)
 		SRC_SUPERVISOR += supervisor/shared/external_flash/spi_flash.c
 	else
@@ -79,6 +99,12 @@ else
 					  shared-module/usb_midi/PortOut.c \
 					  $(BUILD)/autogen_usb_descriptor.c
 	CFLAGS += -DUSB_AVAILABLE
+	ifeq ($(CIRCUITPY_USB_CDC_DATA),1)
+		SRC_SUPERVISOR += shared-bindings/usb_cdc/__init__.c \
+						  shared-bindings/usb_cdc/Serial.c \
+						  shared-module/usb_cdc/Serial.c
+		USB_CDC_DATA_ARG = --cdc_data
+	endif
 endif
 
 SUPERVISOR_O = $(addprefix $(BUILD)/, $(SRC_SUPERVISOR:.c=.o)) $(BUILD)/autogen_display_resources.o
@@ -98,6 +124,7 @@ autogen_usb_descriptor.intermediate: ../../tools/gen_usb_descriptor.py Makefile
 		--vid $(USB_VID)\
 		--pid $(USB_PID)\
 		--serial_number_length $(USB_SERIAL_NUMBER_LENGTH)\
+		$(USB_CDC_DATA_ARG)\
 		--output_c_file $(BUILD)/autogen_usb_descriptor.c\
 		--output_h_file $(BUILD)/genhdr/autogen_usb_descriptor.h
 
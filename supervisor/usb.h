@@ -28,6 +28,7 @@
 #define MICROPY_INCLUDED_SUPERVISOR_USB_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // Ports must call this as frequently as they can in order to keep the USB connection
 // alive and responsive.
@@ -41,4 +42,15 @@ void init_usb_hardware(void);
 bool usb_enabled(void);
 void usb_init(void);
 
+// Sends queued output on CDC interface itf and handles finished USB transfers without running
+// the other background tasks. Used when a serial FIFO fills up.
+void usb_cdc_tx_service(uint8_t itf);
+
+// Reads ahead for the mass storage device while the host is busy receiving.
+void usb_msc_background(void);
+
+// Bytes per second seen over the last burst of mass storage reads and writes.
+// Zero until there has been one.
+void usb_msc_throughput(uint32_t* read_rate, uint32_t* write_rate);
+
 #endif // MICROPY_INCLUDED_SUPERVISOR_USB_H
@@ -0,0 +1,82 @@
+# test __slots__
+
+class A:
+    __slots__ = ('x', 'y')
+    def __init__(self, x):
+        self.x = x
+    def sum(self):
+        return self.x + self.y
+
+a = A(1)
+print(a.x)
+try:
+    a.y
+except AttributeError:
+    print('AttributeError')
+a.y = 2
+print(a.sum())
+del a.y
+try:
+    del a.y
+except AttributeError:
+    print('AttributeError')
+try:
+    a.z = 3
+except AttributeError:
+    print('AttributeError')
+
+# a single string names a single slot
+class B:
+    __slots__ = 'v'
+b = B()
+b.v = [1]
+print(b.v)
+
+# a subclass with its own __slots__ extends its base's slots
+class C(A):
+    __slots__ = ['z']
+c = C(10)
+c.y = 20
+c.z = 30
+print(c.sum(), c.z)
+try:
+    c.w = 1
+except AttributeError:
+    print('AttributeError')
+
+# a subclass without __slots__ gets a dict for other attributes
+class D(A):
+    pass
+d = D(5)
+d.y = 6
+d.w = 7
+print(d.sum(), d.w)
+
+# naming __dict__ allows other attributes too
+class E:
+    __slots__ = ('a', '__dict__')
+e = E()
+e.a = 1
+e.b = 2
+print(e.a, e.b)
+
+# slots with a native base
+class L(list):
+    __slots__ = ('tag',)
+l = L([1, 2])
+l.tag = 'tag'
+print(len(l), l.tag)
+
+# properties and class attributes still work alongside slots
+class P:
+    __slots__ = ('_v',)
+    k = 100
+    @property
+    def v(self):
+        return self._v
+    @v.setter
+    def v(self, value):
+        self._v = value
+p = P()
+p.v = 4
+print(p.v, p.k)
@@ -0,0 +1,75 @@
+# test closing over parameters, which don't need a cell unless they're rebound
+
+# parameter that's only read
+def f(a):
+    return lambda x: x + a
+print(f(1)(2))
+
+# parameter rebound after the closure is made
+def f(a):
+    g = lambda: a
+    a = 2
+    return g
+print(f(1)())
+
+# parameter rebound by the closure
+def f(a):
+    def g():
+        nonlocal a
+        a += 1
+        return a
+    g()
+    return a, g()
+print(f(1))
+
+# parameter rebound two scopes down
+def f(a):
+    def g():
+        def h():
+            nonlocal a
+            a = 3
+        h()
+        return a
+    return g(), a
+print(f(1))
+
+# parameter closed over through an intermediate scope
+def f(a, b):
+    def g():
+        return lambda: a + b
+    return g()()
+print(f(1, 2))
+
+# star and keyword parameters
+def f(*a, b, **c):
+    return lambda: (a, b, sorted(c))
+print(f(1, 2, b=3, d=4)())
+
+# generators and comprehensions over a parameter
+def f(k, src):
+    return list(x * k for x in src), [x + k for x in src]
+print(f(2, range(3)))
+
+def gen(src, k):
+    for x in src:
+        yield x * k
+def f(k):
+    return list(gen((y + k for y in range(3)), k))
+print(f(3))
+
+# parameter deleted after the closure is made
+def f(a):
+    g = lambda: a
+    del a
+    try:
+        g()
+    except NameError:
+        print('NameError')
+f(1)
+
+# class body reading a parameter
+def f(a):
+    class C:
+        x = a
+    return C.x
+print(f(5))
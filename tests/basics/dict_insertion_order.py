@@ -0,0 +1,30 @@
+# dicts keep their insertion order through removals and growth
+
+d = {}
+for i in range(20):
+    d['k%d' % i] = i
+for i in range(0, 20, 3):
+    del d['k%d' % i]
+d['k0'] = 100
+print(list(d.items()))
+
+d = {i * 7: i for i in range(100)}
+for i in range(0, 100, 2):
+    d.pop(i * 7)
+d[1] = 1
+print(list(d.keys()), len(d))
+
+# popitem removes the most recently added item
+d = {1: 'a', 2: 'b', 3: 'c'}
+print(d.popitem(), d.popitem(), d)
+
+d = {i: i for i in range(30)}
+del d[29]
+print(d.popitem(), len(d))
+
+# a copy keeps the order
+d = {3: 3, 1: 1, 2: 2}
+del d[1]
+e = d.copy()
+e[1] = 1
+print(e)
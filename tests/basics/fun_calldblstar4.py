@@ -0,0 +1,25 @@
+# test passing keyword arguments to native functions that parse them against
+# a table of allowed args, including names built at runtime
+
+l = [3, 1, 2]
+l.sort(reverse=True)
+print(l)
+l.sort(**{'rev' + 'erse': False, ''.join(['k', 'e', 'y']): lambda x: -x})
+print(l)
+
+print(list(enumerate('ab', start=5)), list(enumerate(iterable='ab')))
+print(list(enumerate(**{'iter' + 'able': 'c', 'start': 2})))
+
+# unknown keywords, one for an arg already given positionally, and a missing arg
+for f, a, k in (
+    (l.sort, (), {'foo': 1}),
+    (l.sort, (), {'a_name_that_is_not_a_qstr' + str(len(l)): 1}),
+    (enumerate, ('a',), {'iterable': 'b'}),
+    (enumerate, (), {'start': 1}),
+    (l.sort, (None,), {}),
+):
+    try:
+        f(*a, **k)
+        print('no error')
+    except TypeError:
+        print('TypeError')
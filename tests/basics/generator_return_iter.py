@@ -0,0 +1,22 @@
+# a generator's return value is discarded when it is consumed by iteration
+
+def gen():
+    yield 1
+    yield 2
+    return 42
+
+for x in gen():
+    print(x)
+print(list(gen()))
+print(tuple(gen()))
+print(sum(gen()))
+print([x * 2 for x in gen()])
+print(list(zip(gen(), gen())))
+
+# but next() and send() still report it
+g = gen()
+print(next(g), g.send(None))
+try:
+    next(g)
+except StopIteration as e:
+    print(e.args)
@@ -0,0 +1,30 @@
+# test multiplication, modular power and string conversion of very large ints,
+# big enough to take the Karatsuba, Montgomery and chunked conversion paths
+
+# balanced and unbalanced products, including all-ones digits and negatives
+a = 7 ** 700
+b = 3 ** 900
+c = (1 << 2000) - 1
+for x, y in ((a, b), (b, a), (a, -b), (c, c), (c, 11 ** 50), (a * a, b), (-c, -a)):
+    p = x * y
+    print(str(p)[:30], str(p)[-30:], len(str(p)), p % 1000000007)
+
+# squares
+print((c * c) == (1 << 4000) - (1 << 2001) + 1)
+print((a * a) == 49 ** 700)
+
+# modular power with odd multi-digit moduli
+m = (1 << 1023) + 1155
+for base in (3, a, -b, m - 1, m + 2):
+    print(pow(base, 65537, m))
+print(pow(a, b, m))
+print(pow(2, (1 << 200) + 1, 10 ** 40 + 7))
+print(pow(a, 12345, m - 1))
+
+# round trips through different bases
+for n in (a, -b, c, 36 ** 300 - 1):
+    for base, conv in ((2, bin), (8, oct), (16, hex)):
+        print(int(conv(n), base) == n, end=" ")
+    print(int(str(n)) == n)
+print(int("z" * 300, 36) == 36 ** 300 - 1)
+print(str(10 ** 400)[:5], len(str(10 ** 400)))
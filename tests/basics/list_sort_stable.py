@@ -0,0 +1,59 @@
+# test that list.sort is stable and handles larger and partly ordered lists
+
+# equal keys keep their order, also when reversed
+l = [(i % 5, i) for i in range(100)]
+l.sort(key=lambda x: x[0])
+print(l[:8], l[-8:])
+l.sort(key=lambda x: x[0], reverse=True)
+print(l[:8], l[-8:])
+
+# the key function is called once per item
+calls = 0
+def key(x):
+    global calls
+    calls += 1
+    return -x
+l = list(range(50))
+l.sort(key=key)
+print(calls, l[:3], l[-3:])
+
+# ascending, descending and mixed runs
+def check(l, **kw):
+    s = list(l)
+    s.sort(**kw)
+    ok = all(not (s[i + 1] < s[i]) for i in range(len(s) - 1))
+    if kw.get("reverse"):
+        ok = all(not (s[i] < s[i + 1]) for i in range(len(s) - 1))
+    print(len(s), ok, sorted(s) == sorted(l))
+
+seed = 1
+def rand():
+    global seed
+    seed = (seed * 1103515245 + 12345) & 0x3fffffff
+    return seed >> 10
+
+check(list(range(300)))
+check(list(range(300, 0, -1)))
+check([7] * 100)
+check(list(range(200)) + [rand() % 50 for i in range(20)])
+check([rand() % 1000 for i in range(500)])
+check([rand() % 1000 for i in range(500)], reverse=True)
+check([(rand() % 10) / 4 for i in range(100)])
+check([rand() % 10 if i % 2 else (rand() % 10) / 4 for i in range(100)])
+check(["s%d" % (rand() % 100) for i in range(100)])
+
+# an exception from a comparison leaves every item in the list
+class A:
+    def __init__(self, x):
+        self.x = x
+    def __lt__(self, other):
+        if self.x == 13 or other.x == 13:
+            raise ValueError
+        return self.x < other.x
+l = [A(rand() % 20) for i in range(100)] + [A(13)]
+xs = [a.x for a in l]
+try:
+    l.sort()
+except ValueError:
+    print("ValueError")
+print(len(l), sorted(a.x for a in l) == sorted(xs))
@@ -0,0 +1,16 @@
+# test formatting where fields are printed straight into the result
+
+# literal text around and between fields
+print("{}".format(1), "a{}".format(1), "{}b".format(1), "a{}b{}c".format(1, 2))
+print("{{}}{{{}}}".format(3), "x}}y{{z".format())
+
+# conversions without a format spec
+print("{!r} {!s} {}".format("a", "b", b"c"), "{0!r}{0}".format([1, "x"]))
+
+# format specs either side of the length parsed without allocating
+print("{:*>+0000000014d}|".format(15), "{:*>+00000000014d}|".format(15), "{:*>+000000000014d}|".format(15))
+print("{:{}{}}|".format(7, ">", 5), "{:*^{}}|".format("mid", 9))
+
+# %-formatting with and without padding
+print("a%sb%rc" % ("x", "y"), "%5s|%-5s|%.1s|%*s|" % ("p", "q", "rs", 3, "t"))
+print(b"%s%s" % (b"a", b"b"), "%%%s%%" % 1)
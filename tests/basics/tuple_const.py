@@ -0,0 +1,25 @@
+# tuples whose items are all constants may be built once by the compiler
+
+def f():
+    return (1, -2, 'str', b'bytes', None, True, False, ..., (3, ('nested',), ()))
+
+print(f())
+print(f() == f())
+
+# mutating an item's copy must not affect later evaluations
+def g():
+    return list((1, 2, 3))
+
+l = g()
+l.append(4)
+print(l, g())
+
+# items that aren't constants are still evaluated each time
+x = 5
+print((1, x), (1, (x,)), (1, [2]), (1, {2: 3}))
+
+# big ints and floats
+print((123456789012345678901234567890, 1.5))
+
+# a single item and an empty tuple
+print((1,), ())
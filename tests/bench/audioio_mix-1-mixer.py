@@ -0,0 +1,23 @@
+# audioio mixing
+# Four looping 16 bit samples mixed together.
+import bench
+bench.require_sim()
+import array
+import audioio
+
+def test(num):
+    mixer = audioio.Mixer(voice_count=4, sample_rate=22050, channel_count=1)
+    samples = []
+    for v in range(4):
+        wave = array.array("h", [(i * (v + 1) * 512) % 65536 - 32768 for i in range(128)])
+        samples.append(audioio.RawSample(wave, sample_rate=22050))
+    out = audioio.VirtualOut()
+    out.play(mixer)
+    for v in range(4):
+        mixer.play(samples[v], voice=v, loop=True)
+    buf = bytearray(4096)
+    for i in range(num // 1000):
+        out.readinto(buf)
+    out.deinit()
+
+bench.run(test)
@@ -0,0 +1,18 @@
+# audioio mixing
+# Four held notes from the Synthesizer.
+import bench
+bench.require_sim()
+import audioio
+
+def test(num):
+    synth = audioio.Synthesizer(voice_count=4, sample_rate=22050)
+    out = audioio.VirtualOut()
+    out.play(synth)
+    for v, frequency in enumerate((261.63, 329.63, 392.0, 523.25)):
+        synth.press(v, frequency)
+    buf = bytearray(4096)
+    for i in range(num // 1000):
+        out.readinto(buf)
+    out.deinit()
+
+bench.run(test)
@@ -1,10 +1,63 @@
-import time
+try:
+    import utime as time
+except ImportError:
+    import time
+import gc
 
 
 ITERS = 20000000
 
+# run-bench-tests --iters scales the work to the build or board being measured.
+try:
+    from bench_iters import ITERS
+except ImportError:
+    pass
+
+# Only builds with MICROPY_MEM_STATS count the bytes they allocate.
+try:
+    import micropython
+    _mem_total = micropython.mem_total
+except (ImportError, AttributeError):
+    _mem_total = None
+
+if hasattr(time, "ticks_us"):
+    _now = time.ticks_us
+    def _seconds(start, end):
+        return time.ticks_diff(end, start) / 1000000
+elif hasattr(time, "monotonic_ns"):
+    _now = time.monotonic_ns
+    def _seconds(start, end):
+        return (end - start) / 1000000000
+else:
+    _now = time.time
+    def _seconds(start, end):
+        return end - start
+
+# Prints the seconds f took and then, when the build counts them, the bytes it allocated.
 def run(f):
-    t = time.time()
+    gc.collect()
+    if _mem_total:
+        alloc = _mem_total()
+    start = _now()
     f(ITERS)
-    t = time.time() - t
-    print(t)
+    end = _now()
+    if _mem_total:
+        alloc = _mem_total() - alloc
+    print(_seconds(start, end))
+    if _mem_total:
+        print("alloc", alloc)
+
+# For work the wall clock can't time, such as display refreshes that are paced to a frame rate.
+# f returns the seconds it spent.
+def run_timed(f):
+    gc.collect()
+    print(f(ITERS))
+
+# The simulated displays and audio outputs only exist in the unix port's sim build.
+def require_sim():
+    try:
+        import displayio
+        displayio.VirtualBus
+    except (ImportError, AttributeError):
+        print("SKIP")
+        raise SystemExit
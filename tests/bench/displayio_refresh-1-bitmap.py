@@ -0,0 +1,32 @@
+# displayio refresh
+# Full screen 16 color Bitmap on a 320x240 display. Reports the time spent refreshing, not
+# waiting for frames.
+import bench
+bench.require_sim()
+import displayio
+
+def test(num):
+    displayio.release_displays()
+    bus = displayio.VirtualBus(width=320, height=240)
+    display = displayio.Display(bus, b"", width=320, height=240)
+    bitmap = displayio.Bitmap(320, 240, 16)
+    palette = displayio.Palette(16)
+    for i in range(16):
+        palette[i] = i * 0x111111
+    for y in range(240):
+        for x in range(0, 320, 4):
+            bitmap[x, y] = (x + y) % 16
+    groups = []
+    for i in range(2):
+        group = displayio.Group()
+        group.append(displayio.TileGrid(bitmap, pixel_shader=palette))
+        groups.append(group)
+    refresh_us = 0
+    for i in range(num // 400000):
+        display.show(groups[i % 2])
+        display.wait_for_frame()
+        refresh_us += display.refresh_stats.refresh_us
+    displayio.release_displays()
+    return refresh_us / 1000000
+
+bench.run_timed(test)
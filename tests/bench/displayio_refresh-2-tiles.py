@@ -0,0 +1,35 @@
+# displayio refresh
+# 320x240 display covered in 16x16 tiles from a tile sheet, the usual layout of game levels.
+import bench
+bench.require_sim()
+import displayio
+
+def test(num):
+    displayio.release_displays()
+    bus = displayio.VirtualBus(width=320, height=240)
+    display = displayio.Display(bus, b"", width=320, height=240)
+    sheet = displayio.Bitmap(64, 64, 16)
+    for y in range(64):
+        for x in range(64):
+            sheet[x, y] = (x ^ y) % 16
+    palette = displayio.Palette(16)
+    for i in range(16):
+        palette[i] = i * 0x111111
+    groups = []
+    for i in range(2):
+        grid = displayio.TileGrid(sheet, pixel_shader=palette, width=20, height=15,
+                                  tile_width=16, tile_height=16)
+        for t in range(20 * 15):
+            grid[t] = (t + i) % 16
+        group = displayio.Group()
+        group.append(grid)
+        groups.append(group)
+    refresh_us = 0
+    for i in range(num // 400000):
+        display.show(groups[i % 2])
+        display.wait_for_frame()
+        refresh_us += display.refresh_stats.refresh_us
+    displayio.release_displays()
+    return refresh_us / 1000000
+
+bench.run_timed(test)
@@ -0,0 +1,70 @@
+# cmdline: -O2
+# test bytecode optimisations at level 2
+from micropython import const
+
+X = const(3)
+Y = const(X * 4)
+
+# unreachable code after return, raise and break
+def f(a):
+    if a:
+        return Y + 1
+    else:
+        return 2
+    print('dead')
+print(f(1), f(0))
+
+def g():
+    raise ValueError
+    print('dead')
+try:
+    g()
+except ValueError:
+    print('ValueError')
+
+# if-break and if-continue, plus jumps to jumps
+def h(n):
+    out = []
+    i = 0
+    while i < n:
+        i += 1
+        if i == 2:
+            continue
+        if i > 5:
+            break
+        if i & 1:
+            out.append(i)
+        else:
+            out.append(-i)
+    return out
+print(h(3), h(10))
+
+# break out of a for loop, which pops the iterator
+for i in range(10):
+    if i == 3: break
+print(i)
+
+# break and continue that unwind a finally
+for i in range(4):
+    try:
+        if i == 1: continue
+        if i == 3: break
+        print('body', i)
+    finally:
+        print('finally', i)
+
+# folded comparisons of constants
+if X > 2:
+    print('big')
+else:
+    print('small')
+print(X < Y < 20, X == 3 != Y, Y <= X)
+while X < 2:
+    print('dead')
+
+# a nested function in unreachable code is still compiled
+def k():
+    return 1
+    def inner():
+        pass
+print(k())
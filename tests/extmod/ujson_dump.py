@@ -17,6 +17,11 @@ s = StringIO()
 json.dump({"a": (2, [3, None])}, s)
 print(s.getvalue())
 
+# output longer than any internal buffering, including one long string
+s = StringIO()
+json.dump([list(range(50)), "x" * 300, {"k": "y" * 100}], s)
+print(s.getvalue() == json.dumps([list(range(50)), "x" * 300, {"k": "y" * 100}]))
+
 # dump to a small-int not allowed
 try:
     json.dump(123, 1)
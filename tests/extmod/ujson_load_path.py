@@ -0,0 +1,47 @@
+# test the path argument of load and loads, which is MicroPython specific
+
+try:
+    from uio import StringIO
+    import ujson as json
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+doc = '{"a": [1, "x\\"]", {"b": [2]}], "current": {"temp": 21.5, "w": [1, [2, 3]]}}'
+print(json.loads(doc, path=("current", "temp")))
+print(json.loads(doc, path=["current", "w", 1]))
+print(json.loads(doc, path=("a", 2)))
+print(json.loads(doc, path=()))
+print(json.loads('[10, 20, 30]', path=(2,)))
+
+# parsing stops at the end of the selected value
+print(json.load(StringIO('{"x": {"y": [true, null]}, "z": oops'), path=("x",)))
+
+# longer than one block read from the stream
+print(json.load(StringIO('{"k": "' + 'z' * 300 + '", "n": -1e3}'), path=("n",)))
+print(len(json.load(StringIO('[' + '1, ' * 100 + '2]'))))
+
+for p in (("missing",), ("a", 3), ("current", "temp", "x")):
+    try:
+        json.loads(doc, path=p)
+    except KeyError as e:
+        print("KeyError", repr(e.args[0]))
+    except IndexError:
+        print("IndexError")
+
+# a truncated or malformed document is a syntax error, as it is without a path
+for s, p in (('', ("a",)), ('"abc', ("a",)), ('x', (0,)), ('[1, 2', (5,)), ('[1, 2', ("a",)),
+        ('[1, 2', (-1,)), ('{"a": 1', ("b",)), ('{"a": "b', ("a", 0))):
+    try:
+        json.loads(s, path=p)
+    except ValueError:
+        print("ValueError")
+    except (KeyError, IndexError, TypeError) as e:
+        print("wrong", type(e).__name__)
+
+# a well formed document that the path doesn't fit
+for s, p in (('[1, 2]', ("a",)), ('[1, 2]', (-1,)), ('"abc"', ("a",))):
+    try:
+        json.loads(s, path=p)
+    except (KeyError, IndexError, TypeError) as e:
+        print(type(e).__name__)
@@ -0,0 +1,25 @@
+# test that repeated short strings from loads() stay distinct where they differ
+try:
+    import ujson as json
+except ImportError:
+    try:
+        import json
+    except ImportError:
+        print("SKIP")
+        raise SystemExit
+
+import gc
+
+# many records with the same keys, and enough distinct short strings to
+# collide in any small cache
+s = '[' + ','.join('{"zkey":"zval%d","n%d":%d}' % (i % 7, i, i) for i in range(100)) + ']'
+for _ in range(3):
+    l = json.loads(s)
+    gc.collect()
+    print(sorted(set(d['zkey'] for d in l)))
+    print(sum(d['n%d' % i] for i, d in enumerate(l)))
+    print(all(len(d) == 2 for d in l))
+
+# long strings and strings with escapes
+print(json.loads('["zval1","zv\\u0061l1","' + 'z' * 40 + '"]'))
+print(json.loads('{"zval1":1,"zv\\u0061l1":2}'))
@@ -0,0 +1,29 @@
+try:
+    import ure as re
+except ImportError:
+    try:
+        import re
+    except ImportError:
+        print("SKIP")
+        raise SystemExit
+
+try:
+    re.finditer
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+for m in re.finditer("[0-9]+", "a1b22c333"):
+    print(m.group(0))
+
+# empty matches are found once at each position
+print([m.group(0) for m in re.finditer("x*", "axxb")])
+
+print([m.group(0) for m in re.finditer("z", "abc")])
+print([m.group(1) for m in re.compile("(a)n").finditer("banana")])
+print([m.group(0) for m in re.compile(b"a").finditer(b"banana")])
+
+# the module-level functions reuse recently compiled patterns
+for i in range(10):
+    print(re.match("p%d" % (i % 6), "p3") is not None, end=" ")
+print()
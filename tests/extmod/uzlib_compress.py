@@ -0,0 +1,41 @@
+try:
+    import uzlib as zlib
+    import uio as io
+    zlib.compress
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+data = [b"", b"a", b"abc" * 3, b"hello world " * 100, bytes(range(256)) * 8]
+
+for d in data:
+    for wbits in (15, 9, -15, -10):
+        c = zlib.compress(d, wbits)
+        print(len(d), wbits, zlib.decompress(c, wbits) == d)
+
+# repetitive data compresses
+print(len(zlib.compress(b"hello world " * 100)) < 100)
+
+# zlib header and adler32 trailer
+c = zlib.compress(b"abc")
+print(c[:2], c[-4:])
+
+# streaming decompression, with reads smaller and larger than the source blocks
+c = zlib.compress(bytes(range(256)) * 8)
+inp = zlib.DecompIO(io.BytesIO(c))
+buf = bytearray()
+while True:
+    b = inp.read(100)
+    if not b:
+        break
+    buf += b
+print(buf == bytes(range(256)) * 8)
+
+# data after the compressed stream is left in the source
+src = io.BytesIO(zlib.compress(b"hello") + b"after")
+print(zlib.DecompIO(src).read(), src.read())
+
+# a smaller window than the header asks for caps the memory used, and is
+# enough for a stream that never refers back further than that
+c = zlib.compress(b"ab" * 1000, 15)
+print(zlib.DecompIO(io.BytesIO(c), 9).read() == b"ab" * 1000)
@@ -0,0 +1,89 @@
+try:
+    import uerrno
+    import uos
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+try:
+    uos.VfsFat
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMFS:
+
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        #print("readblocks(%s, %x(%d))" % (n, id(buf), len(buf)))
+        for i in range(len(buf)):
+            buf[i] = self.data[n * self.SEC_SIZE + i]
+        return 0
+
+    def writeblocks(self, n, buf):
+        #print("writeblocks(%s, %x)" % (n, id(buf)))
+        for i in range(len(buf)):
+            self.data[n * self.SEC_SIZE + i] = buf[i]
+        return 0
+
+    def ioctl(self, op, arg):
+        #print("ioctl(%d, %r)" % (op, arg))
+        if op == 4:  # BP_IOCTL_SEC_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # BP_IOCTL_SEC_SIZE
+            return self.SEC_SIZE
+
+
+try:
+    bdev = RAMFS(50)
+except MemoryError:
+    print("SKIP")
+    raise SystemExit
+
+uos.VfsFat.mkfs(bdev)
+vfs = uos.VfsFat(bdev)
+uos.mount(vfs, '/ramdisk')
+
+# interleave two files so each one is split into several fragments
+with open('/ramdisk/a', 'w') as fa, open('/ramdisk/b', 'w') as fb:
+    for i in range(6):
+        fa.write(chr(ord('a') + i) * 512)
+        fb.write(chr(ord('A') + i) * 512)
+
+# read-only files seek back and forth through the fragments
+with open('/ramdisk/a', 'rb') as f:
+    for pos in (2560, 0, 1535, 3071, 512, 3072):
+        f.seek(pos)
+        print(pos, f.read(2))
+    print(f.seek(-1, 2), f.read())
+
+# writable files can be overwritten in place and still grow
+with open('/ramdisk/b', 'r+b') as f:
+    f.seek(2047)
+    f.write(b'xy')
+    f.seek(0)
+    f.write(b'z')
+    f.seek(3070)
+    f.write(b'1234')
+    f.seek(1)
+    print(f.read(1))
+    print(f.seek(0, 2))
+
+with open('/ramdisk/b', 'rb') as f:
+    print(f.read(1), f.seek(2047), f.read(2), f.seek(3070), f.read())
+
+# seeking past the end of a writable file extends it
+with open('/ramdisk/b', 'r+b') as f:
+    print(f.seek(4000))
+    f.write(b'!')
+    print(f.seek(0, 2))
+    f.seek(3999)
+    print(f.read())
+
+print(uos.stat('/ramdisk/a')[6], uos.stat('/ramdisk/b')[6])
+uos.umount('/ramdisk')
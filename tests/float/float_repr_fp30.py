@@ -0,0 +1,19 @@
+# test that repr gives short decimals back unchanged, including when floats
+# are held in 30 bits
+
+for x in (0.1, 0.3, 1.1, 2.5, 9.81, 100.0, 123.456, 3.14159, 0.001, 1e10, 1e-10, 6.02e23):
+    print(repr(x), repr(-x))
+
+# up to 5 significant digits are always the shortest that read back
+def digits(s):
+    s = s.split('e')[0].replace('.', '').replace('-', '')
+    return s.strip('0')
+
+ok = True
+for i in range(1, 100000, 37):
+    for e in (-20, -7, -3, 0, 2, 9, 20):
+        s = '%de%d' % (i, e)
+        if digits(repr(float(s))) != str(i).strip('0'):
+            print('fail', s, repr(float(s)))
+            ok = False
+print(ok)
@@ -0,0 +1,35 @@
+import hwbench
+import board
+import displayio
+
+try:
+    display = board.DISPLAY
+except AttributeError:
+    hwbench.skip()
+
+FRAMES = 20
+
+bitmap = displayio.Bitmap(display.width, display.height, 2)
+palette = displayio.Palette(2)
+palette[0] = 0x000000
+palette[1] = 0xffffff
+group = displayio.Group()
+group.append(displayio.TileGrid(bitmap, pixel_shader=palette))
+display.show(group)
+display.wait_for_frame()
+
+def full_frames():
+    for i in range(FRAMES):
+        bitmap.fill(i & 1)
+        display.refresh_soon()
+        display.wait_for_frame()
+
+def small_frames():
+    for i in range(FRAMES):
+        bitmap[i, i] = i & 1
+        display.refresh_soon()
+        display.wait_for_frame()
+
+hwbench.rate("displayio_full_refresh", FRAMES, hwbench.timed(full_frames), "fps")
+hwbench.rate("displayio_small_refresh", FRAMES, hwbench.timed(small_frames), "fps")
+display.show(None)
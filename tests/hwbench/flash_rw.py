@@ -0,0 +1,40 @@
+import hwbench
+import os
+
+SIZE = 32 * 1024
+CHUNK = 512
+
+def read_file(path):
+    buf = bytearray(CHUNK)
+    with open(path, "rb") as f:
+        while f.readinto(buf):
+            pass
+
+def write_file(path):
+    buf = bytearray(CHUNK)
+    with open(path, "wb") as f:
+        for i in range(SIZE // CHUNK):
+            f.write(buf)
+
+path = "/_bench_flash.bin"
+try:
+    elapsed = hwbench.timed(write_file, path)
+except OSError:
+    # CIRCUITPY is read-only to code while USB has it mounted. Fall back to
+    # reading the largest file already on the drive.
+    path = None
+    size = 0
+    for name in os.listdir("/"):
+        stat = os.stat("/" + name)
+        if stat[0] & 0x8000 and stat[6] > size:
+            path = "/" + name
+            size = stat[6]
+    if path is None:
+        hwbench.skip()
+    hwbench.throughput("flash_read", size, hwbench.timed(read_file, path))
+else:
+    try:
+        hwbench.throughput("flash_write", SIZE, elapsed)
+        hwbench.throughput("flash_read", SIZE, hwbench.timed(read_file, path))
+    finally:
+        os.remove(path)
@@ -0,0 +1,22 @@
+import hwbench
+import gc
+
+# Fill the heap with a mix of small live and dead objects so collect() has
+# something realistic to mark and sweep.
+keep = []
+for i in range(200):
+    keep.append([i] * 8)
+    [i] * 8
+
+gc.collect()
+worst = 0
+total = 0
+for i in range(10):
+    for j in range(100):
+        bytearray(32)
+    elapsed = hwbench.timed(gc.collect)
+    total += elapsed
+    worst = max(worst, elapsed)
+
+hwbench.report("gc_collect_mean", total / 10 / 1000, "us")
+hwbench.report("gc_collect_max", worst / 1000, "us")
@@ -0,0 +1,37 @@
+import hwbench
+
+try:
+    import uhashlib as hashlib
+except ImportError:
+    try:
+        import hashlib
+    except ImportError:
+        hashlib = None
+try:
+    import ubinascii as binascii
+    binascii.crc32
+except (ImportError, AttributeError):
+    binascii = None
+
+if hashlib is None and binascii is None:
+    hwbench.skip()
+
+SIZE = 16 * 1024
+CHUNK = 512
+
+def sha256(buf):
+    h = hashlib.sha256()
+    for i in range(SIZE // CHUNK):
+        h.update(buf)
+    h.digest()
+
+def crc32(buf):
+    crc = 0
+    for i in range(SIZE // CHUNK):
+        crc = binascii.crc32(buf, crc)
+
+buf = bytes(range(256)) * (CHUNK // 256)
+if hashlib is not None:
+    hwbench.throughput("sha256", SIZE, hwbench.timed(sha256, buf))
+if binascii is not None:
+    hwbench.throughput("crc32", SIZE, hwbench.timed(crc32, buf))
@@ -0,0 +1,42 @@
+# This must be on one line so its skipped when built into tests.
+"""Helpers shared by the on-device benchmarks. Results are printed one per line as "BENCH <name> <value> <unit>" so tools/cpboard.py --bench can collect them."""
+
+import gc
+import time
+
+try:
+    ticks_ns = time.monotonic_ns
+except AttributeError:
+    def ticks_ns():
+        return int(time.monotonic() * 1000000000)
+
+def report(name, value, unit):
+    if isinstance(value, float):
+        value = "{:.3f}".format(value)
+    print("BENCH", name, value, unit)
+
+def skip():
+    print("SKIP")
+    raise SystemExit
+
+def timed(function, *args):
+    """Run function(*args) once and return the elapsed time in nanoseconds."""
+    gc.collect()
+    start = ticks_ns()
+    function(*args)
+    return ticks_ns() - start
+
+def throughput(name, nbytes, elapsed_ns):
+    report(name, nbytes * 1000000000 / 1024 / max(elapsed_ns, 1), "KiB/s")
+
+def rate(name, count, elapsed_ns, unit):
+    report(name, count * 1000000000 / max(elapsed_ns, 1), unit)
+
+def busy_loop(duration_ns):
+    """Count loop iterations for duration_ns. Comparing counts with and without a
+    background load gives the share of the CPU that load takes."""
+    count = 0
+    end = ticks_ns() + duration_ns
+    while ticks_ns() < end:
+        count += 1
+    return count
@@ -0,0 +1,21 @@
+import hwbench
+import board
+
+try:
+    i2c = board.I2C()
+except (AttributeError, RuntimeError):
+    # No board I2C, or no pull ups on the bus.
+    hwbench.skip()
+
+while not i2c.try_lock():
+    pass
+try:
+    hwbench.report("i2c_scan", hwbench.timed(i2c.scan) / 1000, "us")
+    devices = i2c.scan()
+    if devices:
+        SIZE = 256
+        buf = bytearray(SIZE)
+        elapsed = hwbench.timed(i2c.readfrom_into, devices[0], buf)
+        hwbench.throughput("i2c_read", SIZE, elapsed)
+finally:
+    i2c.unlock()
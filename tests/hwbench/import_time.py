@@ -0,0 +1,24 @@
+import hwbench
+import os
+import sys
+
+SOURCE = "\n".join("def f{0}(a, b=1):\n    return [a * b + {0} for _ in range(3)]".format(i) for i in range(40))
+
+hwbench.report("compile_source", hwbench.timed(compile, SOURCE, "bench", "exec") / 1000, "us")
+
+def import_module(name):
+    __import__(name)
+    del sys.modules[name]
+
+# Importing from the filesystem needs a writable drive, which CIRCUITPY is not
+# while USB has it mounted.
+try:
+    with open("/_bench_import.py", "w") as f:
+        f.write(SOURCE)
+except OSError:
+    pass
+else:
+    try:
+        hwbench.report("import_source", hwbench.timed(import_module, "_bench_import") / 1000, "us")
+    finally:
+        os.remove("/_bench_import.py")
@@ -0,0 +1,32 @@
+import hwbench
+import array
+import math
+import audioio
+import board
+
+try:
+    pin = board.A0
+except AttributeError:
+    hwbench.skip()
+
+SAMPLE_RATE = 22050
+LOOP_NS = 500000000
+VOICES = 4
+
+length = SAMPLE_RATE // 440
+sine = array.array("h", [int(math.sin(math.pi * 2 * i / length) * 8000) for i in range(length)])
+sample = audioio.RawSample(sine, sample_rate=SAMPLE_RATE)
+
+idle = hwbench.busy_loop(LOOP_NS)
+hwbench.report("mixer_idle_loops", idle, "loops")
+
+mixer = audioio.Mixer(voice_count=VOICES, sample_rate=SAMPLE_RATE, channel_count=1,
+                      bits_per_sample=16, samples_signed=True)
+with audioio.AudioOut(pin) as audio:
+    audio.play(mixer)
+    for voice in range(VOICES):
+        mixer.play(sample, voice=voice, loop=True)
+        loops = hwbench.busy_loop(LOOP_NS)
+        hwbench.report("mixer_cpu_{}_voices".format(voice + 1), 100 * (idle - loops) / idle, "%")
+    audio.stop()
+mixer.deinit()
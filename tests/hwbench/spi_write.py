@@ -0,0 +1,21 @@
+import hwbench
+import board
+
+try:
+    spi = board.SPI()
+except AttributeError:
+    hwbench.skip()
+
+SIZE = 4096
+buf = bytearray(SIZE)
+
+while not spi.try_lock():
+    pass
+try:
+    for baudrate in (1000000, 8000000, 24000000):
+        spi.configure(baudrate=baudrate)
+        actual = spi.frequency
+        elapsed = hwbench.timed(spi.write, buf)
+        hwbench.throughput("spi_write_{}mhz".format(actual // 1000000), SIZE, elapsed)
+finally:
+    spi.unlock()
@@ -0,0 +1,19 @@
+import hwbench
+import board
+import busio
+
+try:
+    tx, rx = board.TX, board.RX
+except AttributeError:
+    hwbench.skip()
+
+SIZE = 2048
+buf = bytearray(SIZE)
+
+for baudrate in (115200, 1000000):
+    uart = busio.UART(tx, rx, baudrate=baudrate)
+    try:
+        elapsed = hwbench.timed(uart.write, buf)
+        hwbench.throughput("uart_write_{}".format(baudrate), SIZE, elapsed)
+    finally:
+        uart.deinit()
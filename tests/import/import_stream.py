@@ -0,0 +1,5 @@
+# import a module whose top-level statements depend on each other
+import pkg9.mod as m
+print(m.PUBLIC, m.later())
+print(m.value, m.total, m.where, m.caught)
+print(hasattr(m, 'i'))
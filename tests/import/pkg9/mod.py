@@ -0,0 +1,36 @@
+# each top-level statement here may be compiled and run on its own
+from micropython import const
+
+_PRIVATE = const(2)
+PUBLIC = const(_PRIVATE * 3)
+
+def deco(f):
+    return lambda: f() * 10
+
+@deco
+def later():
+    # refers to a global defined by a later statement
+    return value + _PRIVATE
+
+class C:
+    x = PUBLIC
+
+    def m(self):
+        return self.x + 1
+
+value = C().m()
+
+total = 0
+for i in range(4):
+    total += i
+else:
+    total += 100
+
+if __name__ == 'pkg9.mod':
+    where = 'imported'
+
+try:
+    raise ValueError
+except ValueError:
+    caught = True
+"""lonely string"""
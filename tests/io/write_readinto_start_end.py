@@ -0,0 +1,35 @@
+# This tests the CircuitPython-specific start and end keywords of
+# write and readinto, which work on part of a buffer without slicing it
+import uio
+
+try:
+    uio.BytesIO
+except AttributeError:
+    print('SKIP')
+    raise SystemExit
+
+buf = uio.BytesIO()
+
+print(buf.write(b"0123456789", start=2, end=5))
+print(buf.write(b"0123456789", start=-3))
+print(buf.write(b"0123456789", end=-8))
+print(buf.write(b"0123456789", start=8, end=2))
+print(buf.write(b"0123456789", start=100))
+print(buf.write(b"0123456789", 1, 2, start=5))
+print(buf.getvalue())
+
+buf = uio.BytesIO(b"abcdefgh")
+b = bytearray(6)
+print(buf.readinto(b, start=1, end=4), b)
+print(buf.readinto(b, 2, start=4), b)
+print(buf.readinto(b, start=-1), b)
+
+try:
+    buf.write(b"foo", stop=1)
+except TypeError:
+    print("TypeError")
+
+try:
+    buf.write(b"foo", 1, 2, 3)
+except TypeError:
+    print("TypeError")
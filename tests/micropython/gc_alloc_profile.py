@@ -0,0 +1,39 @@
+# test the allocation profiler
+
+import gc
+
+try:
+    gc.alloc_profile
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+class Foo:
+    pass
+
+def f():
+    l = []
+    for i in range(10):
+        l.append(Foo())
+    return l
+
+gc.alloc_profile(True)
+f()
+gc.alloc_profile(False)
+by_type, by_line = gc.alloc_stats()
+
+# each Foo instance is one allocation
+print(by_type[Foo][0])
+print(by_type[list][0])
+
+# the instances are all allocated on one line
+lines = [line for file, line in [k for k in by_line if k is not None]]
+print(17 in lines, 15 in lines)
+print(by_line[(__file__, 17)][0] >= 10)
+
+# nothing is counted while stopped, and starting again clears the counts
+f()
+print(gc.alloc_stats()[0][Foo][0])
+gc.alloc_profile(True)
+gc.alloc_profile(False)
+print(gc.alloc_stats())
@@ -0,0 +1,45 @@
+# test that gc.compact() keeps objects intact while moving them
+import gc
+
+try:
+    gc.compact
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+class A:
+    pass
+
+def check():
+    for i in range(100):
+        assert data[i] == ("t%d" % i, [i, str(i)], {"k": i * 2.5}, b"b%d" % i), i
+
+# interleave objects that are kept with ones that will be freed
+data = {}
+junk = []
+for i in range(100):
+    junk.append(bytearray(32))
+    data[i] = ("t%d" % i, [i, str(i)], {"k": i * 2.5}, b"b%d" % i)
+    junk.append([0] * 8)
+junk = None
+
+a = A()
+a.items = [str(i) for i in range(20)]
+l = [1, 2]
+l.append(l)
+shared = [3]
+pair = (shared, [shared])
+s = "a local string " * 4
+m = memoryview(bytes(s, "ascii"))
+
+gc.compact()
+check()
+print(a.items == [str(i) for i in range(20)])
+print(l[2] is l, pair[0] is pair[1][0])
+print(s == "a local string " * 4, bytes(m) == bytes(s, "ascii"))
+
+# the heap is still usable afterwards
+data[100] = [str(i) for i in range(50)]
+gc.compact()
+check()
+print(len(data[100]), data[100][-1])
@@ -0,0 +1,53 @@
+# test the binary heap snapshot written by gc.dump_heap()
+import gc
+try:
+    import uio as io
+    import ustruct as struct
+except ImportError:
+    import io
+    import struct
+
+try:
+    gc.dump_heap
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+class Foo:
+    pass
+
+keep = [Foo() for i in range(5)]
+
+# the stream can't grow while the snapshot is written, so make room first
+buf = io.BytesIO()
+buf.write(bytes(65536))
+buf.seek(0)
+gc.dump_heap(buf)
+data = buf.getvalue()[:buf.seek(0, 1)]
+
+print(data[:4], data[4])
+word_size = data[5]
+word = "<I" if word_size == 4 else "<Q"
+fields = struct.unpack(word[0] + str(4) + word[1], data[8:8 + 4 * word_size])
+atb_len, ftb_len, long_lived, n_areas = fields
+print(atb_len > 0, n_areas >= 1)
+
+# the snapshot ends with one word for each allocated block
+offset = 8 + (4 + 2 * n_areas) * word_size
+roots_address, n_roots = struct.unpack_from(word[0] + "2" + word[1], data, offset)
+offset += 2 * word_size
+atb = data[offset:offset + atb_len]
+heads = 0
+for b in atb:
+    for j in range(4):
+        if (b >> (2 * j)) & 1:
+            heads += 1
+offset += atb_len + ftb_len + n_roots * word_size
+print(len(data) - offset == heads * word_size)
+
+# a stream that has to allocate can't be written to
+try:
+    gc.dump_heap(io.BytesIO())
+except MemoryError:
+    print("MemoryError")
+print(len([1] * 10))
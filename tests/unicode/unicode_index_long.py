@@ -0,0 +1,35 @@
+# test indexing long strings, which are long enough to be cached
+
+ascii = "".join(chr(65 + i % 26) for i in range(100))
+mixed = "".join(("a", "é", "€", "\U0001f600")[i % 4] + str(i % 10) for i in range(100))
+for s in (ascii, mixed):
+    n = len(s)
+    print(n)
+
+    # forwards and backwards, as a loop over the string would
+    print("".join(s[i] for i in range(n)) == s)
+    print("".join(s[i] for i in range(n - 1, -1, -1)) == "".join(reversed(list(s))))
+    print("".join(s[-i] for i in range(1, n + 1)) == "".join(reversed(list(s))))
+
+    # jumping around
+    for i in (n - 1, 0, n // 2, 3, n - 5, n // 3, -1, -n):
+        print(i, s[i] == list(s)[i])
+
+    # out of range
+    for i in (n, -n - 1):
+        try:
+            s[i]
+        except IndexError:
+            print("IndexError", i)
+
+    # slices clamp to the ends
+    print(s[-n - 10:5] == s[:5], s[n - 5:n + 10] == s[-5:], s[n:] == "")
+    print(s[10:20] == "".join(list(s)[10:20]))
+
+    # offsets converted back to indices
+    print(s.find(s[70:73]), s.find(s[70:73], 60), s.rfind(s[5:8]), s.index(s[-3:]))
+
+# a new str of the same length must not reuse what was cached for another
+a = "é" + "a" * 40
+b = "a" * 39 + "éé"
+print(a[40], len(a), b[40], len(b))
@@ -3,6 +3,11 @@
 
 # To dump ram do this in GDB: dump binary memory ram.bin &_srelocate &_estack
 
+# It also summarises the snapshots written by gc.dump_heap(), which only hold the allocation
+# tables, the root pointers and the type of each object. The map file is optional for those and
+# names the types. gc.dump_heap(f) writes one to a file and gc.dump_heap() prints it over the
+# console as hex, which can be saved as it is.
+
 import binascii
 import struct
 import sys
@@ -36,40 +41,9 @@ READLINE_HIST_SIZE = 8
 
 SKIP_SYMBOLS = [".debug_ranges", ".debug_frame", ".debug_loc", ".comment", ".debug_str", ".debug_line", ".debug_abbrev", ".debug_info", "COMMON"]
 
-@click.command()
-@click.argument("ram_filename")
-@click.argument("bin_filename")
-@click.argument("map_filename")
-@click.option("--print_block_contents", default=False,
-              help="Prints the contents of each allocated block")
-@click.option("--print_unknown_types", default=False,
-              help="Prints the micropython base type if we don't understand it.")
-@click.option("--print_block_state", default=False,
-              help="Prints the heap block states (allocated or free)")
-@click.option("--print_conflicting_symbols", default=False,
-              help="Prints conflicting symbols from the map")
-@click.option("--print-heap-structure/--no-print-heap-structure", default=False,
-              help="Print heap structure")
-@click.option("--output_directory", default="heapvis",
-              help="Destination for rendered output")
-@click.option("--draw-heap-layout/--no-draw-heap-layout", default=True,
-              help="Draw the heap layout")
-@click.option("--draw-heap-ownership/--no-draw-heap-ownership", default=False,
-              help="Draw the ownership graph of blocks on the heap")
-@click.option("--analyze-snapshots", default="last", type=click.Choice(['all', 'last']))
-def do_all_the_things(ram_filename, bin_filename, map_filename, print_block_contents,
-                      print_unknown_types, print_block_state, print_conflicting_symbols,
-                      print_heap_structure, output_directory, draw_heap_layout,
-                      draw_heap_ownership, analyze_snapshots):
-    with open(ram_filename, "rb") as f:
-        ram_dump = f.read()
-
-    with open(bin_filename, "rb") as f:
-        rom = f.read()
-
+def load_symbols(map_filename, print_conflicting_symbols=False):
     symbols = {} # name -> address, size
     symbol_lookup = {} # address -> name
-    manual_symbol_map = {} # autoname -> name
 
     def add_symbol(name, address=None, size=None):
         if "lto_priv" in name:
@@ -131,6 +105,217 @@ def do_all_the_things(ram_filename, bin_filename, map_filename, print_block_cont
                 if len(parts) >= 4 and parts[0].startswith("0x") and parts[2] == "=" and parts[1] != ".":
                     add_symbol(parts[1], parts[0])
 
+    return symbols, symbol_lookup
+
+SNAPSHOT_MAGIC = b"MPHS"
+
+class HeapSnapshot:
+    """The layout of the heap as written by gc_dump_snapshot() in py/gc.c."""
+    def __init__(self, data):
+        version, self.word_size, self.block_size = struct.unpack_from("<BBH", data, 4)
+        if version != 1:
+            raise ValueError("Unsupported heap snapshot version {}".format(version))
+        word_format = "<I" if self.word_size == 4 else "<Q"
+        offset = 8
+
+        def words(count):
+            nonlocal offset
+            fmt = "<{}{}".format(count, word_format[1])
+            values = struct.unpack_from(fmt, data, offset)
+            offset += count * self.word_size
+            return values
+
+        def raw(length):
+            nonlocal offset
+            value = data[offset:offset + length]
+            offset += length
+            return value
+
+        atb_length, ftb_length, self.long_lived_start, area_count = words(4)
+        area_words = words(2 * area_count)
+        # (address of the first block, number of the first block, number of blocks)
+        self.areas = []
+        first_block = 0
+        for i in range(area_count):
+            start, block_count = area_words[2 * i:2 * i + 2]
+            self.areas.append((start, first_block, block_count))
+            first_block += block_count
+        self.roots_address, root_count = words(2)
+        self.atb = raw(atb_length)
+        self.ftb = raw(ftb_length)
+        self.roots = words(root_count)
+
+        self.block_count = atb_length * BLOCKS_PER_ATB
+        # (first block, length in blocks, first word) of each allocation.
+        self.allocations = []
+        self.free_runs = []
+        current = None
+        free_start = None
+        for block in range(self.block_count):
+            state = self.block_state(block)
+            if state == AT_TAIL and current is not None:
+                current[1] += 1
+                continue
+            if current is not None:
+                self.allocations.append(current)
+                current = None
+            if state == AT_FREE:
+                if free_start is None:
+                    free_start = block
+                continue
+            if free_start is not None:
+                self.free_runs.append((free_start, block - free_start))
+                free_start = None
+            if state in (AT_HEAD, AT_MARK):
+                current = [block, 1, None]
+        if current is not None:
+            self.allocations.append(current)
+        if free_start is not None:
+            self.free_runs.append((free_start, self.block_count - free_start))
+
+        first_words = words(len(self.allocations))
+        for allocation, first_word in zip(self.allocations, first_words):
+            allocation[2] = first_word
+        self.heads = {self.block_address(a[0]): a for a in self.allocations}
+
+    def block_state(self, block):
+        return (self.atb[block // BLOCKS_PER_ATB] >> ((block % BLOCKS_PER_ATB) * 2)) & 0x3
+
+    def has_finaliser(self, block):
+        return len(self.ftb) > 0 and (self.ftb[block // BLOCKS_PER_FTB] >> (block % BLOCKS_PER_FTB)) & 1
+
+    def block_address(self, block):
+        for start, first_block, block_count in self.areas:
+            if first_block <= block < first_block + block_count:
+                return start + (block - first_block) * self.block_size
+        raise ValueError("Block {} is outside the heap".format(block))
+
+def read_snapshot(filename):
+    with open(filename, "rb") as f:
+        data = f.read()
+    if not data.startswith(SNAPSHOT_MAGIC):
+        # It may have been printed over the console.
+        try:
+            data = binascii.unhexlify(b"".join(data.split()))
+        except (binascii.Error, ValueError):
+            return None
+        if not data.startswith(SNAPSHOT_MAGIC):
+            return None
+    return HeapSnapshot(data)
+
+def analyze_snapshot(snapshot, symbol_lookup, print_block_state):
+    def type_name(word):
+        name = symbol_lookup.get(word)
+        if name and name.endswith("+0"):
+            return name[:-2]
+        if word in snapshot.heads:
+            # Instances of classes defined in Python point to their type on the heap.
+            return "heap pointer 0x{:08x}".format(word)
+        return "0x{:08x}".format(word)
+
+    block_size = snapshot.block_size
+    used_blocks = sum(a[1] for a in snapshot.allocations)
+    free_blocks = sum(r[1] for r in snapshot.free_runs)
+    print("Heap: {} blocks of {} bytes in {} area(s)".format(snapshot.block_count, block_size, len(snapshot.areas)))
+    print("Used: {} bytes in {} allocations".format(used_blocks * block_size, len(snapshot.allocations)))
+    print("Free: {} bytes in {} runs, the longest {} bytes".format(free_blocks * block_size,
+        len(snapshot.free_runs), max((r[1] for r in snapshot.free_runs), default=0) * block_size))
+
+    long_lived = [a for a in snapshot.allocations if snapshot.block_address(a[0]) >= snapshot.long_lived_start]
+    print("Long lived: {} bytes in {} allocations".format(sum(a[1] for a in long_lived) * block_size, len(long_lived)))
+    with_finaliser = [a for a in snapshot.allocations if snapshot.has_finaliser(a[0])]
+    print("With finalisers: {} allocations".format(len(with_finaliser)))
+
+    # Free runs grouped by powers of two show how fragmented the heap is.
+    print()
+    print("Free runs by length in blocks:")
+    buckets = {}
+    for start, length in snapshot.free_runs:
+        bucket = 1 << (length - 1).bit_length()
+        count, blocks = buckets.get(bucket, (0, 0))
+        buckets[bucket] = (count + 1, blocks + length)
+    for bucket in sorted(buckets):
+        count, blocks = buckets[bucket]
+        print("  <= {:6}: {:6} runs {:8} bytes".format(bucket, count, blocks * block_size))
+
+    print()
+    print("Allocations by type:")
+    by_type = {}
+    for block, length, first_word in snapshot.allocations:
+        name = type_name(first_word)
+        count, blocks = by_type.get(name, (0, 0))
+        by_type[name] = (count + 1, blocks + length)
+    # Buffers that aren't objects start with data, so the rarest first words are lumped together.
+    shown = sorted(by_type.items(), key=lambda item: item[1][1], reverse=True)
+    others = [item for item in shown if item[1][0] == 1 and item[0].startswith("0x")]
+    shown = [item for item in shown if item not in others]
+    if others:
+        shown.append(("(single allocations of other data)", (len(others), sum(item[1][1] for item in others))))
+    for name, (count, blocks) in shown:
+        print("  {:8} bytes {:6} allocations  {}".format(blocks * block_size, count, name))
+
+    print()
+    print("Allocations referenced by the root pointers:")
+    for i, root in enumerate(snapshot.roots):
+        if root not in snapshot.heads:
+            continue
+        address = snapshot.roots_address + i * snapshot.word_size
+        source = symbol_lookup.get(address, "root[{}]".format(i))
+        block, length, first_word = snapshot.heads[root]
+        print("  {} -> 0x{:08x} {} bytes {}".format(source, root, length * block_size, type_name(first_word)))
+
+    if print_block_state:
+        print()
+        for block, length, first_word in snapshot.allocations:
+            print("0x{:08x} {} bytes allocated {}".format(snapshot.block_address(block), length * block_size,
+                type_name(first_word)))
+
+@click.command()
+@click.argument("ram_filename")
+@click.argument("bin_filename", required=False)
+@click.argument("map_filename", required=False)
+@click.option("--print_block_contents", default=False,
+              help="Prints the contents of each allocated block")
+@click.option("--print_unknown_types", default=False,
+              help="Prints the micropython base type if we don't understand it.")
+@click.option("--print_block_state", default=False,
+              help="Prints the heap block states (allocated or free)")
+@click.option("--print_conflicting_symbols", default=False,
+              help="Prints conflicting symbols from the map")
+@click.option("--print-heap-structure/--no-print-heap-structure", default=False,
+              help="Print heap structure")
+@click.option("--output_directory", default="heapvis",
+              help="Destination for rendered output")
+@click.option("--draw-heap-layout/--no-draw-heap-layout", default=True,
+              help="Draw the heap layout")
+@click.option("--draw-heap-ownership/--no-draw-heap-ownership", default=False,
+              help="Draw the ownership graph of blocks on the heap")
+@click.option("--analyze-snapshots", default="last", type=click.Choice(['all', 'last']))
+def do_all_the_things(ram_filename, bin_filename, map_filename, print_block_contents,
+                      print_unknown_types, print_block_state, print_conflicting_symbols,
+                      print_heap_structure, output_directory, draw_heap_layout,
+                      draw_heap_ownership, analyze_snapshots):
+    snapshot = read_snapshot(ram_filename)
+    if snapshot is not None:
+        symbol_lookup = {}
+        if map_filename or bin_filename:
+            # The binary isn't needed, so a single file after the snapshot is the map.
+            symbols, symbol_lookup = load_symbols(map_filename or bin_filename, print_conflicting_symbols)
+        analyze_snapshot(snapshot, symbol_lookup, print_block_state)
+        return
+    if not bin_filename or not map_filename:
+        raise click.UsageError("A dump of ram needs the binary and the map file too.")
+
+    with open(ram_filename, "rb") as f:
+        ram_dump = f.read()
+
+    with open(bin_filename, "rb") as f:
+        rom = f.read()
+
+    manual_symbol_map = {} # autoname -> name
+
+    symbols, symbol_lookup = load_symbols(map_filename, print_conflicting_symbols)
+
     rom_start = symbols["_sfixed"][0]
     ram_start = symbols["_srelocate"][0]
     ram_end = symbols["_estack"][0]
@@ -230,6 +230,11 @@ class Disk:
         if sync:
             self.sync()
 
+    def remove(self, name, sync=True):
+        os.remove(os.path.join(self.path, name))
+        if sync:
+            self.sync()
+
 
 class Firmware:
     def __init__(self, board):
@@ -610,6 +615,65 @@ def upload(args):
         board.open(wait=10)
         print('New version:', os_uname(board).version, flush=True)
 
+def parse_bench(output):
+    results = {}
+    for line in str(output, encoding='utf8').splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[0] == 'BENCH':
+            results[fields[1]] = {'value': float(fields[2]), 'unit': fields[3]}
+    return results
+
+def bench_msc(board, size=256 * 1024):
+    import tempfile
+    with tempfile.NamedTemporaryFile() as f:
+        f.write(os.urandom(size))
+        f.flush()
+        with board.disk as disk:
+            start = time.monotonic()
+            disk.copy(f.name, '_bench_msc.bin')
+            elapsed = time.monotonic() - start
+            disk.remove('_bench_msc.bin')
+    return {'msc_copy': {'value': size / 1024 / elapsed, 'unit': 'KiB/s'}}
+
+def bench(args, board):
+    import json
+    results = {'board': args.board, 'version': os_uname(board).version, 'benchmarks': {}}
+    helpers = set()
+    for filename in args.bench:
+        helper = os.path.join(os.path.dirname(filename), 'hwbench.py')
+        if os.path.exists(helper) and helper not in helpers:
+            with board.disk as disk:
+                disk.copy(helper)
+            helpers.add(helper)
+
+    for filename in args.bench:
+        if os.path.basename(filename) == 'hwbench.py':
+            continue
+        name = os.path.splitext(os.path.basename(filename))[0]
+        print_verbose(args, name + '...', end='')
+        try:
+            output = board.execfile(filename, timeout=args.timeout)
+        except CPboardError as e:
+            results['benchmarks'][name] = {'error': str(e)}
+            print_verbose(args, 'error')
+            continue
+        if output.strip() == b'SKIP':
+            results['benchmarks'][name] = {'skipped': True}
+            print_verbose(args, 'skipped')
+            continue
+        results['benchmarks'][name] = parse_bench(output)
+        print_verbose(args, 'done')
+
+    print_verbose(args, 'msc_copy...', end='')
+    results['benchmarks']['msc_copy'] = bench_msc(board)
+    print_verbose(args, 'done')
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+    else:
+        print(json.dumps(results, indent=2, sort_keys=True))
+
 def print_error_exit(args, e):
     if args.debug:
         return False
@@ -624,6 +688,9 @@ def main():
     cmd_parser.add_argument('-f', '--firmware', help='upload UF2 firmware file')
     cmd_parser.add_argument('-c', '--command', help='program passed in as string')
     cmd_parser.add_argument('--tty', action='store_true', help='print tty')
+    cmd_parser.add_argument('--bench', nargs='+', metavar='FILE', help='run benchmark files and print the results as JSON')
+    cmd_parser.add_argument('-o', '--output', help='write benchmark results to this file')
+    cmd_parser.add_argument('--timeout', type=int, default=60, help='seconds to wait for each benchmark')
     cmd_parser.add_argument('--verbose', '-v', action='count', default=0, help='be verbose')
     cmd_parser.add_argument('-q', '--quiet', action='store_true', help='be quiet')
     cmd_parser.add_argument('--debug', action='store_true', help='raise exceptions')
@@ -662,6 +729,9 @@ def main():
 
     if args.tty:
         print(board.device)
+    elif args.bench:
+        with board as b:
+            bench(args, b)
     elif args.command:
         with board as b:
             print(b.eval(args.command))
@@ -104,13 +104,14 @@ c_file.write("""\
 uint32_t terminal_transparency[1] = {0x00000000};
 
 // These colors are RGB 565 with the bytes swapped.
-uint32_t terminal_colors[1] = {0xffff0000};
+uint16_t terminal_colors[2] = {0x0000, 0xffff};
 
 displayio_palette_t supervisor_terminal_color = {
     .base = {.type = &displayio_palette_type },
     .opaque = terminal_transparency,
     .colors = terminal_colors,
     .color_count = 2,
+    .transparent_count = 0,
     .needs_refresh = false
 };
 """)
@@ -156,9 +157,6 @@ const displayio_bitmap_t supervisor_terminal_font_bitmap = {{
     .data = (size_t*) font_bitmap_data,
     .stride = {},
     .bits_per_value = 1,
-    .x_shift = 5,
-    .x_mask = 0x1f,
-    .bitmask = 0x1,
     .read_only = true
 }};
 """.format(len(all_characters) * tile_x, tile_y, bytes_per_row / 4))
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# This file is part of the MicroPython project, http://micropython.org/
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2019 Scott Shawcroft for Adafruit Industries LLC
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# Turns a profile of where the CPU spends its time into ramfunc_profile.ld, the list of input
+# sections that the atmel-samd and nrf linker scripts place in RAM.
+#
+# Each line of the profile is a sample count followed by a function name, such as the output of
+# `sort | uniq -c` over program counter samples symbolized with addr2line -f. Lines starting
+# with # are ignored. Sizes come from the ELF that was profiled. Functions are taken in order of
+# samples per byte until the budget runs out, because a small function hit often gains the most
+# from leaving flash.
+
+import argparse
+import collections
+import subprocess
+import sys
+
+# Output sections holding code that may be moved. Anything else (such as .data, where
+# MP_RAMFUNC functions live) is already in RAM.
+CODE_SECTIONS = (".text", ".ramfunc_profile")
+
+def read_profile(filename):
+    samples = collections.Counter()
+    with open(filename, "r") as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            count, name = line.split(None, 1)
+            samples[name.strip()] += int(count)
+    return samples
+
+def read_sizes(nm, elf):
+    # sysv format is the only one that includes the section of each symbol.
+    output = subprocess.check_output([nm, "--format=sysv", "--defined-only", elf],
+                                     universal_newlines=True)
+    sizes = collections.Counter()
+    for line in output.splitlines():
+        fields = [field.strip() for field in line.split("|")]
+        if len(fields) != 7 or fields[3] != "FUNC" or fields[6] not in CODE_SECTIONS:
+            continue
+        # Static functions in different files can share a name and a section name.
+        sizes[fields[0]] += int(fields[4], 16)
+    return sizes
+
+def main():
+    parser = argparse.ArgumentParser(description="Pick functions to run from RAM.")
+    parser.add_argument("--budget", type=int, default=8192, help="bytes of RAM to use")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--elf", help="firmware that was profiled")
+    parser.add_argument("profile", nargs="?")
+    args = parser.parse_args()
+
+    print("/* Generated by tools/gen_ramfunc_profile.py. Do not edit. */")
+    if not args.profile:
+        return
+
+    samples = read_profile(args.profile)
+    sizes = read_sizes(args.nm, args.elf)
+
+    candidates = []
+    for name, count in samples.items():
+        if name not in sizes:
+            print("Skipping {}: not a function in flash.".format(name), file=sys.stderr)
+            continue
+        candidates.append((count / max(sizes[name], 1), name))
+    candidates.sort(reverse=True)
+
+    used = 0
+    for _, name in candidates:
+        size = sizes[name]
+        if used + size > args.budget:
+            continue
+        used += size
+        print("*(.text.{})".format(name))
+    print("{} of {} RAM function bytes used.".format(used, args.budget), file=sys.stderr)
+
+if __name__ == "__main__":
+    main()
@@ -19,6 +19,8 @@ parser.add_argument('--pid', type=lambda x: int(x, 16),
                     help='product id')
 parser.add_argument('--serial_number_length', type=int, default=32,
                     help='length needed for the serial number in digits')
+parser.add_argument('--cdc_data', action='store_true',
+                    help='add a second CDC interface for binary data, separate from the REPL')
 parser.add_argument('--output_c_file', type=argparse.FileType('w'), required=True)
 parser.add_argument('--output_h_file', type=argparse.FileType('w'), required=True)
 
@@ -66,55 +68,82 @@ device = standard.DeviceDescriptor(
 # Interface numbers are interface-set local and endpoints are interface local
 # until util.join_interfaces renumbers them.
 
-cdc_union = cdc.Union(
-    description="CDC comm",
-    bMasterInterface=0x00,       # Adjust this after interfaces are renumbered.
-    bSlaveInterface_list=[0x01]) # Adjust this after interfaces are renumbered.
-
-cdc_call_management = cdc.CallManagement(
-    description="CDC comm",
-    bmCapabilities=0x01,
-    bDataInterface=0x01)         # Adjust this after interfaces are renumbered.
-
-cdc_comm_interface = standard.InterfaceDescriptor(
-    description="CDC comm",
-    bInterfaceClass=cdc.CDC_CLASS_COMM,  # Communications Device Class
-    bInterfaceSubClass=cdc.CDC_SUBCLASS_ACM,  # Abstract control model
-    bInterfaceProtocol=cdc.CDC_PROTOCOL_NONE,
-    iInterface=StringIndex.index("CircuitPython CDC control"),
-    subdescriptors=[
-        cdc.Header(
-            description="CDC comm",
-            bcdCDC=0x0110),
-        cdc_call_management,
-        cdc.AbstractControlManagement(
-            description="CDC comm",
-            bmCapabilities=0x02),
-        cdc_union,
-        standard.EndpointDescriptor(
-            description="CDC comm in",
-            bEndpointAddress=0x0 | standard.EndpointDescriptor.DIRECTION_IN,
-            bmAttributes=standard.EndpointDescriptor.TYPE_INTERRUPT,
-            wMaxPacketSize=0x0040,
-            bInterval=0x10)
-    ])
+def make_cdc_interfaces(name):
+    """Return the comm and data interfaces of one CDC function, plus the descriptors that refer to
+    interface numbers and so must be fixed up by fix_cdc_interfaces()."""
+    union = cdc.Union(
+        description="CDC comm",
+        bMasterInterface=0x00,       # Adjust this after interfaces are renumbered.
+        bSlaveInterface_list=[0x01]) # Adjust this after interfaces are renumbered.
+
+    call_management = cdc.CallManagement(
+        description="CDC comm",
+        bmCapabilities=0x01,
+        bDataInterface=0x01)         # Adjust this after interfaces are renumbered.
+
+    comm_interface = standard.InterfaceDescriptor(
+        description="CDC comm",
+        bInterfaceClass=cdc.CDC_CLASS_COMM,  # Communications Device Class
+        bInterfaceSubClass=cdc.CDC_SUBCLASS_ACM,  # Abstract control model
+        bInterfaceProtocol=cdc.CDC_PROTOCOL_NONE,
+        iInterface=StringIndex.index("{} control".format(name)),
+        subdescriptors=[
+            cdc.Header(
+                description="CDC comm",
+                bcdCDC=0x0110),
+            call_management,
+            cdc.AbstractControlManagement(
+                description="CDC comm",
+                bmCapabilities=0x02),
+            union,
+            standard.EndpointDescriptor(
+                description="CDC comm in",
+                bEndpointAddress=0x0 | standard.EndpointDescriptor.DIRECTION_IN,
+                bmAttributes=standard.EndpointDescriptor.TYPE_INTERRUPT,
+                wMaxPacketSize=0x0040,
+                bInterval=0x10)
+        ])
 
-cdc_data_interface = standard.InterfaceDescriptor(
-    description="CDC data",
-    bInterfaceClass=cdc.CDC_CLASS_DATA,
-    iInterface=StringIndex.index("CircuitPython CDC data"),
-    subdescriptors=[
-        standard.EndpointDescriptor(
-            description="CDC data out",
-            bEndpointAddress=0x0 | standard.EndpointDescriptor.DIRECTION_OUT,
-            bmAttributes=standard.EndpointDescriptor.TYPE_BULK),
-        standard.EndpointDescriptor(
-            description="CDC data in",
-            bEndpointAddress=0x0 | standard.EndpointDescriptor.DIRECTION_IN,
-            bmAttributes=standard.EndpointDescriptor.TYPE_BULK),
-    ])
+    data_interface = standard.InterfaceDescriptor(
+        description="CDC data",
+        bInterfaceClass=cdc.CDC_CLASS_DATA,
+        iInterface=StringIndex.index("{} data".format(name)),
+        subdescriptors=[
+            standard.EndpointDescriptor(
+                description="CDC data out",
+                bEndpointAddress=0x0 | standard.EndpointDescriptor.DIRECTION_OUT,
+                bmAttributes=standard.EndpointDescriptor.TYPE_BULK),
+            standard.EndpointDescriptor(
+                description="CDC data in",
+                bEndpointAddress=0x0 | standard.EndpointDescriptor.DIRECTION_IN,
+                bmAttributes=standard.EndpointDescriptor.TYPE_BULK),
+        ])
+
+    return [comm_interface, data_interface], union, call_management
+
+def fix_cdc_interfaces(interfaces, union, call_management):
+    """Fix up the CDC interface cross-references and return the CDC IAD."""
+    comm_interface, data_interface = interfaces
+    union.bMasterInterface = comm_interface.bInterfaceNumber
+    union.bSlaveInterface_list = [data_interface.bInterfaceNumber]
+
+    call_management.bDataInterface = data_interface.bInterfaceNumber
 
-cdc_interfaces = [cdc_comm_interface, cdc_data_interface]
+    return standard.InterfaceAssociationDescriptor(
+        description="CDC IAD",
+        bFirstInterface=comm_interface.bInterfaceNumber,
+        bInterfaceCount=len(interfaces),
+        bFunctionClass=cdc.CDC_CLASS_COMM,  # Communications Device Class
+        bFunctionSubClass=cdc.CDC_SUBCLASS_ACM,  # Abstract control model
+        bFunctionProtocol=cdc.CDC_PROTOCOL_NONE)
+
+cdc_interfaces, cdc_union, cdc_call_management = make_cdc_interfaces("CircuitPython CDC")
+
+# The optional second CDC function carries binary data for usb_cdc.data.
+if args.cdc_data:
+    cdc_data_interfaces, cdc_data_union, cdc_data_call_management = make_cdc_interfaces("CircuitPython CDC2")
+else:
+    cdc_data_interfaces = []
 
 msc_interfaces = [
     standard.InterfaceDescriptor(
@@ -253,22 +282,12 @@ audio_interfaces = [audio_control_interface] + cs_ac_interface.audio_streaming_i
 # This will renumber the endpoints to make them unique across descriptors,
 # and renumber the interfaces in order. But we still need to fix up certain
 # interface cross-references.
-interfaces = util.join_interfaces(cdc_interfaces, msc_interfaces, hid_interfaces, audio_interfaces)
+# The second CDC function goes last so the other interfaces keep their numbers.
+interfaces = util.join_interfaces(cdc_interfaces, msc_interfaces, hid_interfaces, audio_interfaces,
+                                  cdc_data_interfaces)
 
 # Now adjust the CDC interface cross-references.
-
-cdc_union.bMasterInterface = cdc_comm_interface.bInterfaceNumber
-cdc_union.bSlaveInterface_list = [cdc_data_interface.bInterfaceNumber]
-
-cdc_call_management.bDataInterface = cdc_data_interface.bInterfaceNumber
-
-cdc_iad = standard.InterfaceAssociationDescriptor(
-    description="CDC IAD",
-    bFirstInterface=cdc_comm_interface.bInterfaceNumber,
-    bInterfaceCount=len(cdc_interfaces),
-    bFunctionClass=cdc.CDC_CLASS_COMM,  # Communications Device Class
-    bFunctionSubClass=cdc.CDC_SUBCLASS_ACM,  # Abstract control model
-    bFunctionProtocol=cdc.CDC_PROTOCOL_NONE)
+cdc_iad = fix_cdc_interfaces(cdc_interfaces, cdc_union, cdc_call_management)
 
 descriptor_list = []
 descriptor_list.append(cdc_iad)
@@ -284,6 +303,9 @@ descriptor_list.append(audio_control_interface)
 # the Windows 7 Adafruit_usbser.inf file thinks CDC is at Interface 0, so we'll leave it
 # there for backwards compatibility.
 descriptor_list.extend(hid_interfaces)
+if args.cdc_data:
+    descriptor_list.append(fix_cdc_interfaces(cdc_data_interfaces, cdc_data_union, cdc_data_call_management))
+    descriptor_list.extend(cdc_data_interfaces)
 
 configuration = standard.ConfigurationDescriptor(
     description="Composite configuration",
@@ -456,6 +478,12 @@ for name, length in hid_report_lengths_dict.items():
 
 h_file.write("\n")
 
+h_file.write("""\
+// The REPL is CDC interface 0. usb_cdc.data, when present, is interface 1.
+#define USB_CDC_NUM_INTERFACES {num_cdc}
+
+""".format(num_cdc=2 if args.cdc_data else 1))
+
 h_file.write("""\
 #define USB_HID_NUM_DEVICES {num_devices}
 #define USB_HID_MAX_REPORT_LENGTH {max_length}
@@ -57,12 +57,18 @@ class FreezeError(Exception):
         return 'error while freezing %s: %s' % (self.rawcode.source_file, self.msg)
 
 class Config:
-    MPY_VERSION = 3
+    MPY_VERSION = 4
     MICROPY_LONGINT_IMPL_NONE = 0
     MICROPY_LONGINT_IMPL_LONGLONG = 1
     MICROPY_LONGINT_IMPL_MPZ = 2
 config = Config()
 
+def is_small_int(o):
+    if not is_int_type(o):
+        return False
+    half = 1 << (config.mp_small_int_bits - 1)
+    return -half <= o < half
+
 MP_OPCODE_BYTE = 0
 MP_OPCODE_QSTR = 1
 MP_OPCODE_VAR_UINT = 2
@@ -254,6 +260,95 @@ class RawCode:
             rc.freeze('')
         # TODO
 
+    def freeze_constant_obj(self, obj_name, obj, sizes):
+        if obj is Ellipsis:
+            print('#define %s mp_const_ellipsis_obj' % obj_name)
+        elif obj is None or obj is False or obj is True or is_small_int(obj):
+            # referenced directly by print_rom_ref, nothing to define
+            pass
+        elif type(obj) is tuple:
+            # nested items are defined first so the tuple can point to them
+            for j, item in enumerate(obj):
+                self.freeze_constant_obj('%s_%u' % (obj_name, j), item, sizes)
+            print('STATIC const mp_rom_obj_tuple_t %s = {{&mp_type_tuple}, %u, {' % (obj_name, len(obj)))
+            for j, item in enumerate(obj):
+                self.print_rom_ref('%s_%u' % (obj_name, j), item)
+            print('}};')
+            sizes["tuple_overhead"] += 8 + 4 * len(obj)
+        elif is_str_type(obj) or is_bytes_type(obj):
+            if is_str_type(obj):
+                obj = bytes_cons(obj, 'utf8')
+                obj_type = 'mp_type_str'
+            else:
+                obj_type = 'mp_type_bytes'
+            print('STATIC const mp_obj_str_t %s = {{&%s}, %u, %u, (const byte*)"%s"}; // %s'
+                % (obj_name, obj_type, qstrutil.compute_hash(obj, config.MICROPY_QSTR_BYTES_IN_HASH),
+                    len(obj), ''.join(('\\x%02x' % b) for b in obj), obj))
+            sizes["strings"] += len(obj)
+            sizes["string_overhead"] += 16
+
+        elif is_int_type(obj):
+            if config.MICROPY_LONGINT_IMPL == config.MICROPY_LONGINT_IMPL_NONE:
+                # TODO check if we can actually fit this long-int into a small-int
+                raise FreezeError(self, 'target does not support long int')
+            elif config.MICROPY_LONGINT_IMPL == config.MICROPY_LONGINT_IMPL_LONGLONG:
+                # TODO
+                raise FreezeError(self, 'freezing int to long-long is not implemented')
+            elif config.MICROPY_LONGINT_IMPL == config.MICROPY_LONGINT_IMPL_MPZ:
+                neg = 0
+                if obj < 0:
+                    obj = -obj
+                    neg = 1
+                bits_per_dig = config.MPZ_DIG_SIZE
+                digs = []
+                z = obj
+                while z:
+                    digs.append(z & ((1 << bits_per_dig) - 1))
+                    z >>= bits_per_dig
+                ndigs = len(digs)
+                digs = ','.join(('%#x' % d) for d in digs)
+                print('STATIC const mp_obj_int_t %s = {{&mp_type_int}, '
+                    '{.neg=%u, .fixed_dig=1, .alloc=%u, .len=%u, .dig=(uint%u_t[]){%s}}};'
+                    % (obj_name, neg, ndigs, ndigs, bits_per_dig, digs))
+                sizes["number_overhead"] += 16
+        elif type(obj) is float:
+            print('#if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_A || MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_B')
+            print('STATIC const mp_obj_float_t %s = {{&mp_type_float}, %.16g};'
+                % (obj_name, obj))
+            print('#endif')
+            sizes["number_overhead"] += 8
+        elif type(obj) is complex:
+            print('STATIC const mp_obj_complex_t %s = {{&mp_type_complex}, %.16g, %.16g};'
+                % (obj_name, obj.real, obj.imag))
+            sizes["number_overhead"] += 12
+        else:
+            raise FreezeError(self, 'freezing of object %r is not implemented' % (obj,))
+
+    def print_rom_ref(self, obj_name, obj):
+        if obj is None:
+            print('    MP_ROM_PTR(&mp_const_none_obj),')
+        elif obj is False:
+            print('    MP_ROM_PTR(&mp_const_false_obj),')
+        elif obj is True:
+            print('    MP_ROM_PTR(&mp_const_true_obj),')
+        elif is_small_int(obj):
+            print('    MP_ROM_INT(%d),' % obj)
+        elif type(obj) is float:
+            print('#if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_A || MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_B')
+            print('    MP_ROM_PTR(&%s),' % obj_name)
+            print('#elif MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_C')
+            n = struct.unpack('<I', struct.pack('<f', obj))[0]
+            if n & 0x7f800000 != 0x7f800000:
+                # round to nearest, ties to even, as mp_obj_new_float does
+                n += 1 + ((n >> 2) & 1)
+            n = ((n & ~0x3) | 2) + 0x80800000
+            print('    (mp_rom_obj_t)(0x%08x),' % (n,))
+            print('#else')
+            print('#error "MICROPY_OBJ_REPR_D not supported with floats in frozen mpy files"')
+            print('#endif')
+        else:
+            print('    MP_ROM_PTR(&%s),' % obj_name)
+
     def freeze(self, parent_name):
         self.escaped_name = parent_name + self.simple_name.qstr_esc
 
@@ -264,7 +359,7 @@ class RawCode:
             i += 1
         RawCode.escaped_names.add(self.escaped_name)
 
-        sizes = {"bytecode": 0, "strings": 0, "raw_code_overhead": 0, "const_table_overhead": 0, "string_overhead": 0, "number_overhead": 0}
+        sizes = {"bytecode": 0, "strings": 0, "raw_code_overhead": 0, "const_table_overhead": 0, "string_overhead": 0, "number_overhead": 0, "tuple_overhead": 0}
         # emit children first
         for rc in self.raw_codes:
             subsize = rc.freeze(self.escaped_name + '_')
@@ -314,56 +409,7 @@ class RawCode:
         # generate constant objects
         for i, obj in enumerate(self.objs):
             obj_name = 'const_obj_%s_%u' % (self.escaped_name, i)
-            if obj is Ellipsis:
-                print('#define %s mp_const_ellipsis_obj' % obj_name)
-            elif is_str_type(obj) or is_bytes_type(obj):
-                if is_str_type(obj):
-                    obj = bytes_cons(obj, 'utf8')
-                    obj_type = 'mp_type_str'
-                else:
-                    obj_type = 'mp_type_bytes'
-                print('STATIC const mp_obj_str_t %s = {{&%s}, %u, %u, (const byte*)"%s"}; // %s'
-                    % (obj_name, obj_type, qstrutil.compute_hash(obj, config.MICROPY_QSTR_BYTES_IN_HASH),
-                        len(obj), ''.join(('\\x%02x' % b) for b in obj), obj))
-                sizes["strings"] += len(obj)
-                sizes["string_overhead"] += 16
-
-            elif is_int_type(obj):
-                if config.MICROPY_LONGINT_IMPL == config.MICROPY_LONGINT_IMPL_NONE:
-                    # TODO check if we can actually fit this long-int into a small-int
-                    raise FreezeError(self, 'target does not support long int')
-                elif config.MICROPY_LONGINT_IMPL == config.MICROPY_LONGINT_IMPL_LONGLONG:
-                    # TODO
-                    raise FreezeError(self, 'freezing int to long-long is not implemented')
-                elif config.MICROPY_LONGINT_IMPL == config.MICROPY_LONGINT_IMPL_MPZ:
-                    neg = 0
-                    if obj < 0:
-                        obj = -obj
-                        neg = 1
-                    bits_per_dig = config.MPZ_DIG_SIZE
-                    digs = []
-                    z = obj
-                    while z:
-                        digs.append(z & ((1 << bits_per_dig) - 1))
-                        z >>= bits_per_dig
-                    ndigs = len(digs)
-                    digs = ','.join(('%#x' % d) for d in digs)
-                    print('STATIC const mp_obj_int_t %s = {{&mp_type_int}, '
-                        '{.neg=%u, .fixed_dig=1, .alloc=%u, .len=%u, .dig=(uint%u_t[]){%s}}};'
-                        % (obj_name, neg, ndigs, ndigs, bits_per_dig, digs))
-                    sizes["number_overhead"] += 16
-            elif type(obj) is float:
-                print('#if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_A || MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_B')
-                print('STATIC const mp_obj_float_t %s = {{&mp_type_float}, %.16g};'
-                    % (obj_name, obj))
-                print('#endif')
-                sizes["number_overhead"] += 8
-            elif type(obj) is complex:
-                print('STATIC const mp_obj_complex_t %s = {{&mp_type_complex}, %.16g, %.16g};'
-                    % (obj_name, obj.real, obj.imag))
-                sizes["number_overhead"] += 12
-            else:
-                raise FreezeError(self, 'freezing of object %r is not implemented' % (obj,))
+            self.freeze_constant_obj(obj_name, obj, sizes)
 
         # generate constant table, if it has any entries
         const_table_len = len(self.qstrs) + len(self.objs) + len(self.raw_codes)
@@ -375,18 +421,7 @@ class RawCode:
                 print('    MP_ROM_QSTR(%s),' % global_qstrs[qst].qstr_id)
             for i in range(len(self.objs)):
                 sizes["const_table_overhead"] += 4
-                if type(self.objs[i]) is float:
-                    print('#if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_A || MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_B')
-                    print('    MP_ROM_PTR(&const_obj_%s_%u),' % (self.escaped_name, i))
-                    print('#elif MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_C')
-                    n = struct.unpack('<I', struct.pack('<f', self.objs[i]))[0]
-                    n = ((n & ~0x3) | 2) + 0x80800000
-                    print('    (mp_rom_obj_t)(0x%08x),' % (n,))
-                    print('#else')
-                    print('#error "MICROPY_OBJ_REPR_D not supported with floats in frozen mpy files"')
-                    print('#endif')
-                else:
-                    print('    MP_ROM_PTR(&const_obj_%s_%u),' % (self.escaped_name, i))
+                self.print_rom_ref('const_obj_%s_%u' % (self.escaped_name, i), self.objs[i])
             for rc in self.raw_codes:
                 sizes["const_table_overhead"] += 4
                 print('    MP_ROM_PTR(&raw_code_%s),' % rc.escaped_name)
@@ -438,6 +473,14 @@ def read_obj(f):
     obj_type = f.read(1)
     if obj_type == b'e':
         return Ellipsis
+    elif obj_type == b'n':
+        return None
+    elif obj_type == b'F':
+        return False
+    elif obj_type == b'T':
+        return True
+    elif obj_type == b't':
+        return tuple(read_obj(f) for _ in range(read_uint(f)))
     else:
         buf = f.read(read_uint(f))
         if obj_type == b's':
@@ -453,30 +496,37 @@ def read_obj(f):
         else:
             assert 0
 
-def read_qstr_and_pack(f, bytecode, ip):
-    qst = read_qstr(f)
+def read_qstr_table(f):
+    table = []
+    for _ in range(read_uint(f)):
+        f.read(2) # hash, which is recomputed for the target when freezing
+        table.append(read_qstr(f))
+    return table
+
+def link_qstr(qstr_table, bytecode, ip):
+    qst = qstr_table[bytecode[ip] | bytecode[ip + 1] << 8]
     bytecode[ip] = qst & 0xff
     bytecode[ip + 1] = qst >> 8
 
-def read_bytecode_qstrs(file, bytecode, ip):
+def link_bytecode_qstrs(qstr_table, bytecode, ip):
     while ip < len(bytecode):
         f, sz = mp_opcode_format(bytecode, ip)
         if f == 1:
-            read_qstr_and_pack(file, bytecode, ip + 1)
+            link_qstr(qstr_table, bytecode, ip + 1)
         ip += sz
 
-def read_raw_code(f):
+def read_raw_code(f, qstr_table):
     bc_len = read_uint(f)
     bytecode = bytearray(f.read(bc_len))
     ip, ip2, prelude = extract_prelude(bytecode)
-    read_qstr_and_pack(f, bytecode, ip2) # simple_name
-    read_qstr_and_pack(f, bytecode, ip2 + 2) # source_file
-    read_bytecode_qstrs(f, bytecode, ip)
+    link_qstr(qstr_table, bytecode, ip2) # simple_name
+    link_qstr(qstr_table, bytecode, ip2 + 2) # source_file
+    link_bytecode_qstrs(qstr_table, bytecode, ip)
     n_obj = read_uint(f)
     n_raw_code = read_uint(f)
-    qstrs = [read_qstr(f) for _ in range(prelude[3] + prelude[4])]
+    qstrs = [qstr_table[read_uint(f)] for _ in range(prelude[3] + prelude[4])]
     objs = [read_obj(f) for _ in range(n_obj)]
-    raw_codes = [read_raw_code(f) for _ in range(n_raw_code)]
+    raw_codes = [read_raw_code(f, qstr_table) for _ in range(n_raw_code)]
     return RawCode(bytecode, qstrs, objs, raw_codes)
 
 def read_mpy(filename):
@@ -490,7 +540,7 @@ def read_mpy(filename):
         config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE = (feature_flags & 1) != 0
         config.MICROPY_PY_BUILTINS_STR_UNICODE = (feature_flags & 2) != 0
         config.mp_small_int_bits = header[3]
-        return read_raw_code(f)
+        return read_raw_code(f, read_qstr_table(f))
 
 def dump_mpy(raw_codes):
     for rc in raw_codes:
@@ -510,6 +560,7 @@ def freeze_mpy(base_qstrs, raw_codes):
     print('#include "py/mpconfig.h"')
     print('#include "py/objint.h"')
     print('#include "py/objstr.h"')
+    print('#include "py/objtuple.h"')
     print('#include "py/emitglue.h"')
     print()
 